@@ -213,6 +213,10 @@ if(WITH_HETERPS)
   add_definitions(-DPADDLE_WITH_HETERPS)
 endif()
 
+if(WITH_PS_FLAT_SHARD)
+  add_definitions(-DPADDLE_WITH_PS_FLAT_SHARD)
+endif()
+
 if(WITH_BRPC_RDMA)
   add_definitions(-DPADDLE_WITH_BRPC_RDMA)
 endif()
@@ -55,6 +55,12 @@ if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU" AND ${CMAKE_CXX_COMPILER_VERSION}
   set(BRPC_PATCH_COMMAND_GCC13 git apply ${http2_h_patch})
 endif()
 
+if(WITH_BRPC_RDMA)
+  set(BRPC_WITH_RDMA ON)
+else()
+  set(BRPC_WITH_RDMA OFF)
+endif()
+
 # If minimal .a is need, you can set  WITH_DEBUG_SYMBOLS=OFF
 ExternalProject_Add(
   extern_brpc
@@ -77,6 +83,7 @@ ExternalProject_Add(
              -DWITH_GLOG=ON
              -DBUILD_BRPC_TOOLS=ON
              -DBUILD_SHARED_LIBS=ON
+             -DWITH_RDMA=${BRPC_WITH_RDMA}
              ${EXTERNAL_OPTIONAL_ARGS}
   LIST_SEPARATOR |
   CMAKE_CACHE_ARGS
@@ -116,3 +123,7 @@ set(EXTERNAL_BRPC_DEPS
 if(NOT WITH_GFLAGS)
   set(EXTERNAL_BRPC_DEPS ${EXTERNAL_BRPC_DEPS} gflags)
 endif()
+
+if(WITH_BRPC_RDMA)
+  set(EXTERNAL_BRPC_DEPS ${EXTERNAL_BRPC_DEPS} ibverbs)
+endif()
@@ -21,8 +21,11 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <cstdio>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <sstream>
 
 #include "paddle/cinn/backends/cuda_util.h"
 #include "paddle/cinn/backends/nvrtc/header_generator.h"
@@ -34,6 +37,7 @@ PD_DECLARE_string(cinn_nvcc_cmd_path);
 PD_DECLARE_string(nvidia_package_dir);
 PD_DECLARE_bool(nvrtc_compile_to_cubin);
 PD_DECLARE_bool(cinn_nvrtc_cubin_with_fmad);
+PD_DECLARE_string(cinn_compile_cache_dir);
 
 namespace cinn {
 namespace backends {
@@ -65,6 +69,86 @@ static std::vector<std::string> GetNvidiaAllIncludePath(
   return include_paths;
 }
 
+static const char* kCacheMagic = "cinn_nvrtc_cache_v1";
+
+// The versions of nvrtc and the headers which are not a part of the source
+// code but change the compiled result.
+static const std::string& CompileEnvSignature() {
+  static const std::string signature = [] {
+    int major = 0, minor = 0;
+    NVRTC_CALL(nvrtcVersion(&major, &minor));
+    std::hash<std::string> hasher;
+    size_t seed = 0;
+    for (const auto* header : JitSafeHeaderGenerator::GetInstance().headers()) {
+      seed ^= hasher(header) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+    std::ifstream ifs(Context::Global().runtime_include_dir() +
+                      "/cinn_cuda_runtime_source.cuh");
+    std::stringstream runtime_header;
+    runtime_header << ifs.rdbuf();
+    seed ^= hasher(runtime_header.str()) + 0x9e3779b9 + (seed << 6) +
+            (seed >> 2);
+    return "nvrtc-" + std::to_string(major) + "." + std::to_string(minor) +
+           ";headers-" + std::to_string(seed);
+  }();
+  return signature;
+}
+
+static std::string CacheFilePath(const std::string& key, bool cubin) {
+  std::stringstream ss;
+  ss << FLAGS_cinn_compile_cache_dir << "/" << std::hex
+     << std::hash<std::string>()(key) << (cubin ? ".cubin" : ".ptx");
+  return ss.str();
+}
+
+bool Compiler::LoadFromCacheDir(const std::string& key, std::string* data) {
+  std::ifstream ifs(CacheFilePath(key, compile_to_cubin_), std::ios::binary);
+  if (!ifs.is_open()) {
+    return false;
+  }
+  std::string magic;
+  size_t key_size = 0;
+  ifs >> magic >> key_size;
+  ifs.get();
+  if (!ifs.good() || magic != kCacheMagic || key_size != key.size()) {
+    return false;
+  }
+  std::string cached_key(key_size, '\0');
+  ifs.read(&cached_key[0], key_size);
+  // Different compilations may have the same hash value.
+  if (!ifs.good() || cached_key != key) {
+    return false;
+  }
+  std::stringstream ss;
+  ss << ifs.rdbuf();
+  *data = ss.str();
+  return !data->empty();
+}
+
+void Compiler::SaveToCacheDir(const std::string& key, const std::string& data) {
+  mkdir(FLAGS_cinn_compile_cache_dir.c_str(), 0755);
+  std::string path = CacheFilePath(key, compile_to_cubin_);
+  // Writes to a temporary file and renames it, so the other processes never
+  // read a partial file.
+  std::string tmp_path = path + ".tmp." + std::to_string(getpid());
+  {
+    std::ofstream ofs(tmp_path, std::ios::binary);
+    if (!ofs.is_open()) {
+      LOG(WARNING) << "Failed to write the nvrtc cache file " << tmp_path;
+      return;
+    }
+    ofs << kCacheMagic << " " << key.size() << "\n";
+    ofs.write(key.data(), key.size());
+    ofs.write(data.data(), data.size());
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    LOG(WARNING) << "Failed to write the nvrtc cache file " << path;
+    return;
+  }
+  VLOG(4) << "Save the compiled code to " << path;
+}
+
 std::string Compiler::operator()(const std::string& code,
                                  bool include_headers) {
   if (runtime::CanUseNvccCompiler()) {
@@ -172,6 +256,17 @@ std::string Compiler::CompileCudaSource(const std::string& code,
     param_cstrings.push_back(option.c_str());
   }
   VLOG(3) << "compile options: " << utils::Join(compile_options, " ");
+
+  std::string cache_key;
+  if (!FLAGS_cinn_compile_cache_dir.empty()) {
+    cache_key = CompileEnvSignature() + "\n" +
+                utils::Join(compile_options, " ") + "\n" + code;
+    std::string data;
+    if (LoadFromCacheDir(cache_key, &data)) {
+      VLOG(4) << "Load the compiled code from " << FLAGS_cinn_compile_cache_dir;
+      return data;
+    }
+  }
   NVRTC_CALL(nvrtcCreateProgram(&prog,
                                 code.c_str(),
                                 nullptr,
@@ -207,6 +302,9 @@ std::string Compiler::CompileCudaSource(const std::string& code,
   }
 
   NVRTC_CALL(nvrtcDestroyProgram(&prog));
+  if (!cache_key.empty()) {
+    SaveToCacheDir(cache_key, data);
+  }
   return data;
 }
 
@@ -67,6 +67,20 @@ class Compiler {
    */
   std::string CompileCudaSource(const std::string& code, bool include_headers);
 
+  /**
+   * Load the PTX or CUBIN of the same compilation from
+   * FLAGS_cinn_compile_cache_dir.
+   * @param key The source code, compile options and the versions.
+   * @param data The loaded PTX or CUBIN.
+   * @return Whether it is found.
+   */
+  bool LoadFromCacheDir(const std::string& key, std::string* data);
+
+  /**
+   * Save the PTX or CUBIN to FLAGS_cinn_compile_cache_dir.
+   */
+  void SaveToCacheDir(const std::string& key, const std::string& data);
+
   /**
    * whether to compile the source code into cubin, only works with cuda version
    * > 11.1
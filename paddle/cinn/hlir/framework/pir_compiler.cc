@@ -13,6 +13,15 @@
 // limitations under the License.
 
 #include "paddle/cinn/hlir/framework/pir_compiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <thread>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
 #include "paddle/cinn/ir/group_schedule/config/schedule_config_manager.h"
 
 #include "paddle/cinn/hlir/dialect/operator/transforms/lowering_pass/utils.h"
@@ -25,6 +34,8 @@
 
 PD_DECLARE_bool(enable_cinn_compile_cache);
 PD_DECLARE_int64(cinn_compile_thread_num);
+PD_DECLARE_int64(cinn_compile_thread_memory_mb);
+PD_DECLARE_bool(cinn_report_compile_time);
 
 namespace cinn::hlir::framework {
 class CompilationContextMapper {
@@ -56,14 +67,34 @@ class CompilationContextMapper {
   bool is_finalized_{false};
 };
 
+// Returns the number of threads allowed to compile at the same time. It is
+// bounded by the hardware concurrency, FLAGS_cinn_compile_thread_num and the
+// available host memory if FLAGS_cinn_compile_thread_memory_mb is set.
+static size_t GetThreadBudget() {
+  size_t budget = std::max(std::thread::hardware_concurrency(), 1U);
+  if (FLAGS_cinn_compile_thread_num > 0) {
+    budget = std::min(budget,
+                      static_cast<size_t>(FLAGS_cinn_compile_thread_num));
+  }
+#ifdef __linux__
+  if (FLAGS_cinn_compile_thread_memory_mb > 0) {
+    const int64_t avail_mb = static_cast<int64_t>(sysconf(_SC_AVPHYS_PAGES)) *
+                             sysconf(_SC_PAGESIZE) / (1024 * 1024);
+    const size_t memory_bound = static_cast<size_t>(
+        std::max<int64_t>(avail_mb / FLAGS_cinn_compile_thread_memory_mb, 1));
+    VLOG(5) << "Available host memory " << avail_mb
+            << "MB bounds the compilation threads to " << memory_bound;
+    budget = std::min(budget, memory_bound);
+  }
+#endif
+  return budget;
+}
+
 static size_t GetThreadNum(size_t task_size) {
-  size_t thread_size = task_size;
   if (!FLAGS_enable_cinn_compile_cache) {
-    thread_size = 1;
-  } else if (FLAGS_cinn_compile_thread_num > 0) {
-    thread_size = FLAGS_cinn_compile_thread_num;
+    return 1;
   }
-  return thread_size;
+  return std::max<size_t>(std::min(task_size, GetThreadBudget()), 1);
 }
 
 std::vector<pir::CINNKernelInfo> PirCompiler::Build(
@@ -82,9 +113,33 @@ std::vector<pir::CINNKernelInfo> PirCompiler::Build(
     // https://developer.nvidia.com/blog/cuda-pro-tip-always-set-current-device-avoid-multithreading-bugs/
     // for details.
     const auto device_id = runtime::GetArchDevice(target_);
+    // Dispatches the largest groups first so that they do not end up as the
+    // tail of the compilation. The results are still stored by the index of
+    // the group, so the cache is updated in a deterministic order.
+    std::vector<size_t> order(task_size);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+      return group_compilation_contexts[lhs].GetGroup()->ops().size() >
+             group_compilation_contexts[rhs].GetGroup()->ops().size();
+    });
+    // The threads left by the outer loop are used to lower the broadcast
+    // branches of a group, so the total never exceeds the budget.
+    const size_t inner_thread_size =
+        std::max<size_t>(GetThreadBudget() / thread_size, 1);
     auto worker_fn = [&](int index) {
       runtime::SetArchDevice(target_, device_id);
-      compilation_results[index] = Compile(&group_compilation_contexts[index]);
+      const size_t task_index = order[index];
+      const auto start = std::chrono::steady_clock::now();
+      compilation_results[task_index] = Compile(
+          &group_compilation_contexts[task_index], inner_thread_size);
+      if (FLAGS_cinn_report_compile_time) {
+        const auto& group = group_compilation_contexts[task_index].GetGroup();
+        const std::chrono::duration<double, std::milli> cost =
+            std::chrono::steady_clock::now() - start;
+        LOG(INFO) << "[CINN compile time] group " << group->group_id()
+                  << " with " << group->ops().size() << " ops: " << cost.count()
+                  << " ms";
+      }
     };
     utils::parallel_run(worker_fn,
                         utils::SequenceDispatcher(0, task_size),
@@ -97,7 +152,7 @@ std::vector<pir::CINNKernelInfo> PirCompiler::Build(
 }
 
 std::shared_ptr<pir::CompilationResult> PirCompiler::Compile(
-    GroupCompilationContext* ctx) {
+    GroupCompilationContext* ctx, size_t max_thread_num) {
   std::shared_ptr<pir::CompilationResult> compile_result;
   CompilationTask task(ctx);
 
@@ -118,7 +173,8 @@ std::shared_ptr<pir::CompilationResult> PirCompiler::Compile(
         CompilationTask lowering_task(&switch_group_ctxs[index]);
         lowering_task.Lowering();
       };
-      const size_t thread_size = GetThreadNum(task_size);
+      const size_t thread_size =
+          std::min(GetThreadNum(task_size), max_thread_num);
       utils::parallel_run(worker_fn,
                           utils::SequenceDispatcher(0, task_size),
                           /*thread_num=*/thread_size);
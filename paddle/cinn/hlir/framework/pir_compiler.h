@@ -30,7 +30,10 @@ class PirCompiler final {
  private:
   CINN_DISALLOW_COPY_AND_ASSIGN(PirCompiler);
 
-  std::shared_ptr<pir::CompilationResult> Compile(GroupCompilationContext* ctx);
+  // Compiles one group, the broadcast branches of the group are lowered with
+  // at most max_thread_num threads.
+  std::shared_ptr<pir::CompilationResult> Compile(GroupCompilationContext* ctx,
+                                                  size_t max_thread_num);
 
   Target target_;
 };
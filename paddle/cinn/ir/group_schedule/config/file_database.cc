@@ -18,7 +18,10 @@
 #include <google/protobuf/util/json_util.h>
 #include <sys/stat.h>
 #include <cstdlib>
+#include <algorithm>
 #include <fstream>
+#include <mutex>
+#include <unordered_map>
 
 #include "paddle/cinn/utils/multi_threading.h"
 #include "paddle/common/enforce.h"
@@ -62,6 +65,8 @@ bool TileConfigToProto(group_schedule::config::proto::TileData* tile_data,
     tc.set_warp_num(it.second.warp_num);
     tc.set_tree_reduce_num(it.second.tree_reduce_num);
     tc.set_spatial_inner_num(it.second.spatial_inner_num);
+    tc.set_grid_reduce_num(it.second.grid_reduce_num);
+    tc.set_reduce_method(static_cast<int>(it.second.reduce_method.index()));
     *(tile_data->mutable_tile_config()) = tc;
     tile_data->set_priority(priority);
   }
@@ -208,10 +213,22 @@ bool comparepriority(group_schedule::config::proto::TileData tile_data1,
   return tile_data1.priority() > tile_data2.priority();
 }
 
+// The parsed config files shared by all the databases, so that every group
+// compilation does not read and parse the json files again.
+static std::mutex parsed_configs_mutex;
+static std::unordered_map<std::string, TileConfigMap> parsed_configs;
+
 TileConfigMap FileTileConfigDatabase::GetConfigs(
     const common::Target& target, const IterSpaceType& iter_space_type) const {
-  // Step 1: Read from json file and convert json to proto message
   std::string file_path = IterSpaceTypeToDir(target, iter_space_type);
+  {
+    std::lock_guard<std::mutex> lock(parsed_configs_mutex);
+    auto iter = parsed_configs.find(file_path);
+    if (iter != parsed_configs.end()) {
+      return iter->second;
+    }
+  }
+  // Step 1: Read from json file and convert json to proto message
   auto json_lines = ReadLinesFromFile(file_path);
   size_t line_length = json_lines.size();
 
@@ -244,10 +261,17 @@ TileConfigMap FileTileConfigDatabase::GetConfigs(
     tconfig.spatial_inner_num =
         piece_tileconfig.tile_config().spatial_inner_num();
     tconfig.warp_num = piece_tileconfig.tile_config().warp_num();
+    // The records written before grid reduce was tuned have no such field.
+    tconfig.grid_reduce_num =
+        std::max<int64_t>(piece_tileconfig.tile_config().grid_reduce_num(), 1);
+    tconfig.reduce_method =
+        ReduceMethodFromIndex(piece_tileconfig.tile_config().reduce_method());
     tile_config_map[bucket_info] = tconfig;
     // TODO(XiaZichao): Add function to cut one lattice into smaller ones
   }
   // TODO(XiaZichao): update json file using top view of tileconfigMap
+  std::lock_guard<std::mutex> lock(parsed_configs_mutex);
+  parsed_configs[file_path] = tile_config_map;
   return tile_config_map;
 }
 
@@ -258,6 +282,13 @@ void FileTileConfigDatabase::AddConfig(const common::Target& target,
   target_config_data_[bucket_info] = config;
   auto status = FileTileConfigDatabase::ToFile(target, priority);
   if (status == true) {
+    IterSpaceType iter_space_type;
+    for (const auto& dim : bucket_info.space) {
+      iter_space_type.emplace_back(dim.iter_type,
+                                   dim.is_dynamic ? "dynamic" : "static");
+    }
+    std::lock_guard<std::mutex> lock(parsed_configs_mutex);
+    parsed_configs.erase(IterSpaceTypeToDir(target, iter_space_type));
     target_config_data_.clear();
     return;
   } else {
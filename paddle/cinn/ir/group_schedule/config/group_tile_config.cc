@@ -113,6 +113,22 @@ bool BucketInfo::operator==(const BucketInfo& other) const {
   return true;
 }
 
+ReduceMethod ReduceMethodFromIndex(int64_t index) {
+  switch (index) {
+    case 0:
+      return NoneReduceMethod();
+    case 1:
+      return WarpReduceMethod();
+    case 2:
+      return BlockReduceMethod();
+    case 3:
+      return DiscreteReduceMethod();
+    default:
+      PADDLE_THROW(::common::errors::InvalidArgument(
+          "Unknown reduce method index: %d", index));
+  }
+}
+
 std::string BucketInfo::ToString() const {
   std::stringstream ss;
   ss << "BucketInfo: [";
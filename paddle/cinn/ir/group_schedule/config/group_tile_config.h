@@ -116,6 +116,10 @@ struct BucketInfoHash {
   }
 };
 
+// Converts the reduce method from and to its index in ReduceMethod, which is
+// how the tile config database and the config searcher encode it.
+ReduceMethod ReduceMethodFromIndex(int64_t index);
+
 std::shared_ptr<ScheduleConfig::BaseInfo> InitBasicInfo(
     const std::shared_ptr<FusionGroupInfo>& group_info);
 
@@ -13,7 +13,9 @@
 // limitations under the License.
 
 #include "paddle/cinn/ir/group_schedule/dy_shape_group_scheduler.h"
+#include <algorithm>
 #include "paddle/cinn/common/cas.h"
+#include "paddle/cinn/common/ir_util.h"
 #include "paddle/cinn/hlir/framework/pir/trivial_op_impl.h"
 #include "paddle/cinn/ir/group_schedule/config/schedule_config_manager.h"
 #include "paddle/cinn/ir/group_schedule/tactic/align_iter_space_tactic.h"
@@ -23,7 +25,11 @@
 #include "paddle/cinn/ir/group_schedule/tactic/tile_first_general_tactic.h"
 #include "paddle/cinn/ir/ir_analyzer/ir_analyzer.h"
 #include "paddle/cinn/ir/op/ir_operators.h"
+#include "paddle/cinn/utils/string.h"
 #include "paddle/common/enforce.h"
+#include "paddle/common/flags.h"
+
+PD_DECLARE_string(cinn_specialize_dynamic_extents);
 
 namespace cinn {
 namespace ir {
@@ -73,11 +79,105 @@ void DynamicShapeGroupScheduler::InitBuckets() {
       ScheduleConfigManager::Instance();
   std::unordered_map<BucketInfo, ScheduleConfig, BucketInfoHash> configs =
       schedule_config_manager.ExtractConfigs(target_, group_info_);
+  if (!FLAGS_cinn_specialize_dynamic_extents.empty()) {
+    InitSpecializedBuckets(configs);
+  }
   for (std::pair<BucketInfo, ScheduleConfig>&& config : configs) {
     InitBucket(std::move(config.first), std::move(config.second));
   }
 }
 
+void DynamicShapeGroupScheduler::InitSpecializedBuckets(
+    const std::unordered_map<BucketInfo, ScheduleConfig, BucketInfoHash>&
+        configs) {
+  std::unordered_set<std::string> output_names = OutputTensorNames();
+  int priority = 0;
+  for (const auto& [bucket_info, config] : configs) {
+    priority = std::max(priority, bucket_info.bucket_priority + 1);
+  }
+
+  // The specialized kernel is the generic one with the symbolic extent
+  // replaced by the constant, so that the later passes could fully unroll
+  // and vectorize the loops. Only the extents made of a single symbol can be
+  // replaced.
+  auto AddSpecializedBucket = [&](const BucketInfo& bucket_info,
+                                  const ScheduleConfig& config,
+                                  const std::string& iter_type,
+                                  int64_t value) {
+    std::unique_ptr<ir::ScheduleBlockGraph> origin_graph =
+        std::make_unique<ir::ScheduleBlockGraph>(*ir_sch_);
+    ir::ScheduleBlockNode* origin_master = FindGlobalMasterNode(origin_graph);
+    auto [sp_extent, rd_extent] = GetSpatialAndReduceExtent(origin_master);
+    const ir::Expr& extent = iter_type == "S" ? sp_extent : rd_extent;
+    if (!extent.is_var()) {
+      VLOG(4) << "Skip specializing the extent " << extent << " to " << value;
+      return;
+    }
+    SymbolicPredicate predicate =
+        MakeBucketPredicate(bucket_info, origin_master);
+
+    std::vector<ir::Expr> exprs;
+    for (const ir::Expr& expr : ir_sch_->GetModule().GetExprs()) {
+      exprs.emplace_back(analyzer::ReplaceVarWithExpr(
+          expr,
+          {extent.as_var_ref()},
+          {common::make_const(extent.type(), value)}));
+    }
+    std::unique_ptr<ir::IRSchedule> ir_sch =
+        std::make_unique<ir::IRSchedule>(ir::ModuleExpr(exprs),
+                                         -1,
+                                         false,
+                                         utils::ErrorMessageLevel::kGeneral,
+                                         ir_sch_->IsDynamicShape());
+    std::unique_ptr<ir::ScheduleBlockGraph> schedule_block_graph =
+        std::make_unique<ir::ScheduleBlockGraph>(*ir_sch);
+    VLOG(4) << "Specialize " << bucket_info.ToString() << " with predicate "
+            << predicate;
+
+    ScheduleContext schedule_context{
+        output_names, target_, IterativeSpaceInfo(), bucket_info, config};
+    BucketContext bucket_context{std::move(predicate),
+                                 priority,
+                                 std::move(ir_sch),
+                                 std::move(schedule_block_graph),
+                                 std::move(schedule_context)};
+    bucket_contexts_.emplace_back(std::move(bucket_context));
+  };
+
+  // The flag is like "R:1024,4096;S:8192".
+  for (const std::string& item :
+       utils::Split(FLAGS_cinn_specialize_dynamic_extents, ";")) {
+    std::vector<std::string> type_and_values = utils::Split(item, ":");
+    if (type_and_values.size() != 2) {
+      LOG(WARNING) << "Invalid item in FLAGS_cinn_specialize_dynamic_extents: "
+                   << item;
+      continue;
+    }
+    const std::string iter_type = utils::Trim(type_and_values[0]);
+    for (const std::string& value_str : utils::Split(type_and_values[1], ",")) {
+      const int64_t value = std::stoll(value_str);
+      for (const auto& [bucket_info, config] : configs) {
+        auto iter = std::find_if(
+            bucket_info.space.begin(),
+            bucket_info.space.end(),
+            [&](const BucketInfo::Dimension& dim) {
+              return dim.iter_type == iter_type && dim.is_dynamic &&
+                     dim.lower_bound <= value && value <= dim.upper_bound;
+            });
+        if (iter == bucket_info.space.end()) {
+          continue;
+        }
+        BucketInfo specialized_bucket = bucket_info;
+        auto& dim = specialized_bucket.space[iter - bucket_info.space.begin()];
+        dim.lower_bound = value;
+        dim.upper_bound = value;
+        dim.is_dynamic = false;
+        AddSpecializedBucket(specialized_bucket, config, iter_type, value);
+      }
+    }
+  }
+}
+
 void DynamicShapeGroupScheduler::Schedule() {
   VLOG(4) << "bucket_context_.size() = " << bucket_contexts_.size();
   for (BucketContext& bucket_context : bucket_contexts_) {
@@ -167,28 +267,31 @@ ir::ScheduleBlockNode* DynamicShapeGroupScheduler::FindGlobalMasterNode(
   return master;
 }
 
-SymbolicPredicate DynamicShapeGroupScheduler::MakeBucketPredicate(
-    const BucketInfo& bucket_info, ScheduleBlockNode* node) {
-  auto [sp_extent, rd_extent] = [&]() -> std::pair<ir::Expr, ir::Expr> {
-    std::vector<ir::Expr> loops = node->GetLoops();
-    std::set<int> reduce_axis(group_info_->reduce_axis.begin(),
-                              group_info_->reduce_axis.end());
-
-    ir::Expr sp_extent = ir::Expr(1);
-    ir::Expr rd_extent = ir::Expr(1);
-    for (int i = 0; i < loops.size(); ++i) {
-      auto& extent = loops[i].As<ir::For>()->extent;
-      if (reduce_axis.count(i) == 0) {
-        sp_extent = sp_extent * extent;
-      } else {
-        rd_extent = rd_extent * extent;
-      }
+std::pair<ir::Expr, ir::Expr>
+DynamicShapeGroupScheduler::GetSpatialAndReduceExtent(ScheduleBlockNode* node) {
+  std::vector<ir::Expr> loops = node->GetLoops();
+  std::set<int> reduce_axis(group_info_->reduce_axis.begin(),
+                            group_info_->reduce_axis.end());
+
+  ir::Expr sp_extent = ir::Expr(1);
+  ir::Expr rd_extent = ir::Expr(1);
+  for (int i = 0; i < loops.size(); ++i) {
+    auto& extent = loops[i].As<ir::For>()->extent;
+    if (reduce_axis.count(i) == 0) {
+      sp_extent = sp_extent * extent;
+    } else {
+      rd_extent = rd_extent * extent;
     }
+  }
 
-    sp_extent = optim::ArithSimplify(sp_extent);
-    rd_extent = optim::ArithSimplify(rd_extent);
-    return {sp_extent, rd_extent};
-  }();
+  sp_extent = optim::ArithSimplify(sp_extent);
+  rd_extent = optim::ArithSimplify(rd_extent);
+  return {sp_extent, rd_extent};
+}
+
+SymbolicPredicate DynamicShapeGroupScheduler::MakeBucketPredicate(
+    const BucketInfo& bucket_info, ScheduleBlockNode* node) {
+  auto [sp_extent, rd_extent] = GetSpatialAndReduceExtent(node);
 
   auto MakeDimBoundPredicate = [](const ir::Expr& extent,
                                   const BucketInfo::Dimension& dim) {
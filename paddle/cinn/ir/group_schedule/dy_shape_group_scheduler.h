@@ -53,6 +53,15 @@ class DynamicShapeGroupScheduler : public GroupScheduler {
 
   void InitBuckets();
 
+  // Adds the buckets specialized for the concrete extents given by
+  // FLAGS_cinn_specialize_dynamic_extents on top of the generic buckets.
+  void InitSpecializedBuckets(
+      const std::unordered_map<BucketInfo, ScheduleConfig, BucketInfoHash>&
+          configs);
+
+  std::pair<ir::Expr, ir::Expr> GetSpatialAndReduceExtent(
+      ScheduleBlockNode* node);
+
   void ApplyTactics(BucketContext* bucket_context);
 
   ir::ScheduleBlockNode* FindGlobalMasterNode(
@@ -102,6 +102,13 @@ ScoreType WeightedSamplingTrailObjectiveFunc::operator()(
     config.warp_num = candidate[0];
     config.tree_reduce_num = candidate[1];
     config.spatial_inner_num = candidate[2];
+    // The grid reduce number and the reduce method are optional dimensions.
+    if (candidate.size() > 3) {
+      config.grid_reduce_num = candidate[3];
+    }
+    if (candidate.size() > 4) {
+      config.reduce_method = ReduceMethodFromIndex(candidate[4]);
+    }
     tile_config_database->AddConfig(
         cinn::common::DefaultTarget(), bucket_info_, config);
     auto& schedule_config_manager = ScheduleConfigManager::Instance();
@@ -213,6 +220,10 @@ std::pair<ScoreType, CandidateType> ScheduleConfigSearcher::Search(
   CandidateGenerator candidate_generator(candidate_range_, constraints_);
   std::vector<CandidateType> candidates = candidate_generator.Candidates();
   VLOG(6) << "Candidate num = " << candidates.size();
+  PADDLE_ENFORCE_GT(candidates.size(),
+                    0,
+                    ::common::errors::InvalidArgument(
+                        "No candidate satisfies all the constraints."));
   for (const auto& candidate : candidates) {
     ScoreType score = 0;
     for (auto& objective_func_ : objective_funcs_) {
@@ -222,7 +233,7 @@ std::pair<ScoreType, CandidateType> ScheduleConfigSearcher::Search(
     VLOG(6) << "Score = " << score;
     records_[score] = candidate;
   }
-  return is_search_minimum ? *records_.begin() : *(records_.end()--);
+  return is_search_minimum ? *records_.begin() : *records_.rbegin();
 }
 
 }  // namespace search
@@ -0,0 +1,185 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/cinn/ir/group_schedule/search/tile_config_tuner.h"
+
+#include <memory>
+#include <string>
+#include <variant>
+
+#include "paddle/cinn/common/target.h"
+#include "paddle/cinn/utils/string.h"
+#include "paddle/common/enforce.h"
+
+PD_DECLARE_bool(cinn_measure_kernel_time);
+PD_DECLARE_string(tile_config_policy);
+
+namespace cinn {
+namespace ir {
+namespace search {
+
+namespace {
+
+constexpr int kThreadsPerWarp = 32;
+constexpr int kMaxThreadsPerBlock = 1024;
+constexpr int kMaxGridReduceNum = 16;
+
+enum CandidateIndex {
+  kWarpNum = 0,
+  kTreeReduceNum,
+  kSpatialInnerNum,
+  kGridReduceNum,
+  kReduceMethod
+};
+
+bool IsPowerOf2(int64_t x) { return x > 0 && (x & (x - 1)) == 0; }
+
+int64_t IndexOf(const ReduceMethod& method) {
+  return static_cast<int64_t>(method.index());
+}
+
+}  // namespace
+
+std::vector<std::pair<int, int>> TileConfigCandidateRange() {
+  return {{1, kMaxThreadsPerBlock / kThreadsPerWarp},
+          {1, kMaxThreadsPerBlock},
+          {1, 8},
+          {1, kMaxGridReduceNum},
+          {0, static_cast<int>(std::variant_size_v<ReduceMethod>) - 1}};
+}
+
+std::vector<ConstraintFunc> TileConfigConstraints(
+    const BucketInfo& bucket_info) {
+  bool has_reduce = false;
+  int64_t spatial_lower = 1;
+  int64_t reduce_lower = 1;
+  for (const auto& dim : bucket_info.space) {
+    if (dim.iter_type == "R") {
+      has_reduce = true;
+      reduce_lower *= dim.lower_bound;
+    } else {
+      spatial_lower *= dim.lower_bound;
+    }
+  }
+  const bool is_last_reduce =
+      !bucket_info.space.empty() && bucket_info.space.back().iter_type == "R";
+
+  std::vector<ConstraintFunc> constraints;
+  // Thread number of a block.
+  constraints.emplace_back([](const CandidateType& candidate) {
+    const int64_t warp_num = candidate[kWarpNum];
+    return warp_num <= 4 || (warp_num <= 8 && warp_num % 2 == 0) ||
+           warp_num % 4 == 0;
+  });
+  constraints.emplace_back([](const CandidateType& candidate) {
+    const int64_t threads = candidate[kWarpNum] * kThreadsPerWarp;
+    const int64_t tree_reduce_num = candidate[kTreeReduceNum];
+    return IsPowerOf2(tree_reduce_num) && tree_reduce_num <= threads;
+  });
+  // Vectorization of the spatial inner loop.
+  constraints.emplace_back([spatial_lower](const CandidateType& candidate) {
+    const int64_t spatial_inner_num = candidate[kSpatialInnerNum];
+    const int64_t spatial_threads = candidate[kWarpNum] * kThreadsPerWarp /
+                                    candidate[kTreeReduceNum];
+    return IsPowerOf2(spatial_inner_num) &&
+           (spatial_inner_num == 1 ||
+            spatial_threads * spatial_inner_num <= spatial_lower);
+  });
+  // Grid reduce splits the reduce axis into blocks.
+  constraints.emplace_back(
+      [has_reduce, reduce_lower](const CandidateType& candidate) {
+        const int64_t grid_reduce_num = candidate[kGridReduceNum];
+        if (!IsPowerOf2(grid_reduce_num)) {
+          return false;
+        }
+        return grid_reduce_num == 1 ||
+               (has_reduce && candidate[kTreeReduceNum] * grid_reduce_num <=
+                                  reduce_lower);
+      });
+  // The reduce method must match the layout of the iteration space.
+  constraints.emplace_back(
+      [has_reduce, is_last_reduce](const CandidateType& candidate) {
+        const int64_t method = candidate[kReduceMethod];
+        const int64_t tree_reduce_num = candidate[kTreeReduceNum];
+        if (!has_reduce) {
+          return method == IndexOf(NoneReduceMethod()) &&
+                 tree_reduce_num == 1 && candidate[kGridReduceNum] == 1;
+        }
+        if (is_last_reduce) {
+          if (method == IndexOf(WarpReduceMethod())) {
+            return tree_reduce_num == kThreadsPerWarp;
+          }
+          return method == IndexOf(BlockReduceMethod()) &&
+                 tree_reduce_num >= kThreadsPerWarp;
+        }
+        return method == IndexOf(DiscreteReduceMethod()) ||
+               (method == IndexOf(NoneReduceMethod()) &&
+                tree_reduce_num == 1 && candidate[kGridReduceNum] == 1);
+      });
+  return constraints;
+}
+
+std::pair<ScoreType, ScheduleConfig::TileConfig> TuneTileConfig(
+    const std::vector<::pir::Program*>& programs,
+    const BucketInfo& bucket_info,
+    TileConfigDatabase* database,
+    const TileConfigTuneOption& option) {
+  PADDLE_ENFORCE_NOT_NULL(
+      database,
+      ::common::errors::InvalidArgument("The tile config database is null."));
+  PADDLE_ENFORCE_GT(programs.size(),
+                    0,
+                    ::common::errors::InvalidArgument(
+                        "At least one program is required to tune."));
+  // The objective functions replace the configs through the "search" policy
+  // and read the kernel time, so both flags are switched during the tuning.
+  const bool prev_measure_kernel_time = FLAGS_cinn_measure_kernel_time;
+  const std::string prev_policy = FLAGS_tile_config_policy;
+  FLAGS_cinn_measure_kernel_time = true;
+  FLAGS_tile_config_policy = "search";
+
+  std::vector<std::unique_ptr<BaseObjectiveFunc>> objective_funcs;
+  for (auto* program : programs) {
+    objective_funcs.emplace_back(
+        std::make_unique<WeightedSamplingTrailObjectiveFunc>(
+            program,
+            bucket_info,
+            option.sampling_prob,
+            option.max_sampling_times,
+            option.repeats));
+  }
+  ScheduleConfigSearcher searcher(std::move(objective_funcs),
+                                  TileConfigCandidateRange(),
+                                  TileConfigConstraints(bucket_info));
+  auto [score, candidate] = searcher.Search();
+
+  FLAGS_cinn_measure_kernel_time = prev_measure_kernel_time;
+  FLAGS_tile_config_policy = prev_policy;
+
+  ScheduleConfig::TileConfig config;
+  config.warp_num = candidate[kWarpNum];
+  config.tree_reduce_num = candidate[kTreeReduceNum];
+  config.spatial_inner_num = candidate[kSpatialInnerNum];
+  config.grid_reduce_num = candidate[kGridReduceNum];
+  config.reduce_method = ReduceMethodFromIndex(candidate[kReduceMethod]);
+  VLOG(3) << "Best tile config of " << bucket_info.ToString() << ": ["
+          << utils::Join<int64_t>(candidate, ", ") << "], score = " << score;
+  database->AddConfig(
+      common::DefaultTarget(), bucket_info, config, option.priority);
+  return {score, config};
+}
+
+}  // namespace search
+}  // namespace ir
+}  // namespace cinn
@@ -0,0 +1,56 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "paddle/cinn/ir/group_schedule/config/database.h"
+#include "paddle/cinn/ir/group_schedule/search/config_searcher.h"
+
+namespace cinn {
+namespace ir {
+namespace search {
+
+struct TileConfigTuneOption {
+  double sampling_prob = 1.0;
+  int max_sampling_times = 300;
+  int repeats = 3;
+  // The priority of the recorded config in the database.
+  int priority = 0;
+};
+
+// The candidate is {warp_num, tree_reduce_num, spatial_inner_num,
+// grid_reduce_num, reduce_method}, the reduce method is encoded by its index
+// in ReduceMethod.
+std::vector<std::pair<int, int>> TileConfigCandidateRange();
+
+// Returns the constraints that keep the candidates valid for the iteration
+// space of the bucket, e.g. the reduce method must match the layout.
+std::vector<ConstraintFunc> TileConfigConstraints(
+    const BucketInfo& bucket_info);
+
+// Measures every valid candidate on the device with the shapes sampled from
+// the bucket, and records the fastest one into the database, which is read
+// by ScheduleConfigManager with the "optimal" or "hybrid" policy.
+std::pair<ScoreType, ScheduleConfig::TileConfig> TuneTileConfig(
+    const std::vector<::pir::Program*>& programs,
+    const BucketInfo& bucket_info,
+    TileConfigDatabase* database,
+    const TileConfigTuneOption& option = TileConfigTuneOption());
+
+}  // namespace search
+}  // namespace ir
+}  // namespace cinn
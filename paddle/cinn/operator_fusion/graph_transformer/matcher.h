@@ -14,6 +14,9 @@
 
 #pragma once
 #include "paddle/cinn/operator_fusion/pattern_graph.h"
+#include "paddle/common/flags.h"
+
+COMMON_DECLARE_int32(cinn_horizontal_fusion_max_reduce_ops);
 
 namespace cinn::fusion {
 // Matcher
@@ -402,6 +405,28 @@ struct InputOutputMaximumConstrain {
   }
 };
 
+/*
+ * Every reduction fused into a kernel keeps its accumulators in registers and
+ * its block reduce buffer in shared memory, so horizontally fusing too many
+ * sibling reductions lowers the occupancy more than the saved launches gain.
+ */
+struct HorizontalFusionReduceNumConstrain {
+  int CountReduceOps(const PatternNodePtr& node) {
+    int count = 0;
+    for (const auto* op : GetOpsInPattern(node->stmt_pattern())) {
+      if (GetOpPatternKind(op) == hlir::framework::kReduction) ++count;
+    }
+    return count;
+  }
+  bool operator()(const PatternGraph& graph,
+                  const PatternNodePtr& lhs,
+                  const PatternNodePtr& rhs) {
+    const int limit = FLAGS_cinn_horizontal_fusion_max_reduce_ops;
+    if (limit <= 0) return true;
+    return CountReduceOps(lhs) + CountReduceOps(rhs) <= limit;
+  }
+};
+
 struct HorizontalCheckMiddleOutputVar {
   bool DontHaveMiddleVariable(const PatternGraph& graph,
                               const PatternNodePtr& lhs,
@@ -199,6 +199,7 @@ void PatternGraph::HorizontalFusion() {
   GraphTransformer<NodePairPattern,
                    And<HorizontalFusionConstrain,
                        InputOutputMaximumConstrain,
+                       HorizontalFusionReduceNumConstrain,
                        HorizontalCheckMiddleOutputVar>,  // Avoid two many
                                                          // inputs and
                                                          // outputs.
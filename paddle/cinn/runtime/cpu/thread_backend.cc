@@ -47,18 +47,28 @@ int max_concurrency() {
 int cinn_backend_parallel_launch(FCINNParallelLambda flambda,
                                  void* datas,
                                  int num_task) {
-  int num_workers = max_concurrency();
+  // The environment is only read once, launches are on the hot path of every
+  // parallel loop.
+  static const int num_workers = max_concurrency();
   if (num_task == 0) num_task = num_workers;
 #ifdef CINN_USE_OPENMP
-  omp_set_num_threads(num_task);
-#pragma omp parallel num_threads(num_task)
+  // More tasks than workers are distributed over the workers instead of
+  // oversubscribing the cores with one thread per task, and the global
+  // OpenMP thread count of the process is left untouched.
+  int num_threads = std::min(num_task, num_workers);
+#pragma omp parallel num_threads(num_threads)
   {
-    int thread_num = omp_get_thread_num();
-    (*flambda)(thread_num, num_task, datas);
+    for (int task_id = omp_get_thread_num(); task_id < num_task;
+         task_id += omp_get_num_threads()) {
+      (*flambda)(task_id, num_task, datas);
+    }
   }
 #else
-  PADDLE_THROW(::common::errors::Fatal(
-      "CINN host parallel launch need OpenMP! Please check."));
+  // Without OpenMP the tasks run serially, which keeps the generated
+  // parallel loops correct on hosts built without it.
+  for (int task_id = 0; task_id < num_task; ++task_id) {
+    (*flambda)(task_id, num_task, datas);
+  }
 #endif  // CINN_USE_OPENMP
   return 0;
 }
@@ -24,6 +24,9 @@
 #include "paddle/cinn/runtime/cuda/test_util.h"
 #include "paddle/cinn/runtime/cuda/use_extern_funcs.h"
 #include "paddle/common/enforce.h"
+#include "paddle/common/flags.h"
+
+PD_DECLARE_string(cinn_compile_cache_dir);
 
 namespace cinn {
 namespace runtime {
@@ -52,6 +55,35 @@ void saxpy(float a, float *x, float *y, float *out, size_t n)
   ASSERT_TRUE(func);
 }
 
+TEST(CUDAModule, compile_cache_dir) {
+  std::string cache_dir = "./cinn_compile_cache_test";
+  FLAGS_cinn_compile_cache_dir = cache_dir;
+  std::string source_code = R"ROC(
+extern "C" __global__
+void scale(float a, float *x, size_t n)
+{
+  size_t tid = blockIdx.x * blockDim.x + threadIdx.x;
+  if (tid < n) {
+    x[tid] = a * x[tid];
+  }
+}
+)ROC";
+
+  backends::nvrtc::Compiler compiler;
+  auto compiled = compiler(source_code);
+  ASSERT_FALSE(compiled.empty());
+  // The second compilation loads the result of the first one.
+  backends::nvrtc::Compiler cached_compiler;
+  auto cached = cached_compiler(source_code);
+  ASSERT_EQ(compiled, cached);
+  FLAGS_cinn_compile_cache_dir = "";
+
+  CUDAModule module(cached,
+                    compiler.compile_to_cubin() ? CUDAModule::Kind::CUBIN
+                                                : CUDAModule::Kind::PTX);
+  ASSERT_TRUE(module.GetFunction(0, "scale"));
+}
+
 TEST(CUDAModule, float16) {
   using cinn::common::float16;
   using runtime::cuda::util::Vector;
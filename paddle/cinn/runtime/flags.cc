@@ -227,6 +227,25 @@ PD_DEFINE_string(
     StringFromEnv("FLAGS_cinn_dump_group_instruction", ""),
     "Specify the path for dump instruction by group, which is used for debug.");
 
+PD_DEFINE_string(
+    cinn_compile_cache_dir,
+    StringFromEnv("FLAGS_cinn_compile_cache_dir", ""),
+    "Specify the directory to persist the PTX/CUBIN compiled by nvrtc, so "
+    "that the restarted processes skip the compilation of the same source "
+    "code. It is disabled if empty.");
+
+PD_DEFINE_bool(cinn_report_compile_time,
+               BoolFromEnv("FLAGS_cinn_report_compile_time", false),
+               "Whether to log the compile time of every fusion group, which "
+               "is used to find the groups that are slow to compile.");
+
+PD_DEFINE_string(
+    cinn_specialize_dynamic_extents,
+    StringFromEnv("FLAGS_cinn_specialize_dynamic_extents", ""),
+    "The concrete spatial and reduce extents to specialize the dynamic shape "
+    "kernels for, e.g. \"R:1024,4096;S:8192\". Every specialized kernel is "
+    "guarded by the extent at runtime and falls back to the generic one.");
+
 // Todo(CZ): support kernel name check for multiple kernel code gen.
 PD_DEFINE_string(cinn_debug_custom_code_path,
                  StringFromEnv("FLAGS_cinn_debug_custom_code_path", ""),
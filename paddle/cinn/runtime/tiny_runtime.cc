@@ -150,11 +150,13 @@ int cinn_backend_parallel_launch(FCINNParallelLambda flambda,
                                  int num_task) {
   int num_workers = max_num_workers;
   if (num_task == 0) num_task = num_workers;
-  omp_set_num_threads(num_task);
-#pragma omp parallel num_threads(num_task)
+  int num_threads = std::min(num_task, num_workers);
+#pragma omp parallel num_threads(num_threads)
   {
-    int thread_num = omp_get_thread_num();
-    (*flambda)(thread_num, num_task, datas);
+    for (int task_id = omp_get_thread_num(); task_id < num_task;
+         task_id += omp_get_num_threads()) {
+      (*flambda)(task_id, num_task, datas);
+    }
   }
   return 0;
 }
@@ -50,6 +50,20 @@ PHI_DEFINE_EXPORTED_int32(paddle_num_threads,
                           1,
                           "Number of threads for each paddle instance.");
 
+/**
+ * Paddle initialization related FLAG
+ * Name: FLAGS_report_startup_time
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example: FLAGS_report_startup_time=true
+ * Note: If true, the time of the device initialization, the number of the
+ * registered kernels and the third-party libraries loaded so far with their
+ * loading time are logged once the devices are initialized.
+ */
+PHI_DEFINE_EXPORTED_bool(report_startup_time,
+                         false,
+                         "Whether to log the startup time report.");
+
 /**
  * Low Precision Op related FLAG
  * Name: FLAGS_low_precision_op_list
@@ -67,6 +81,21 @@ PHI_DEFINE_EXPORTED_int32(low_precision_op_list,
                           "list printing. It will be return the "
                           "low precision op list of current module.");
 
+/**
+ * AMP related FLAG
+ * Name: FLAGS_amp_cast_cost_check
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example: FLAGS_amp_cast_cost_check=true
+ * Note: Used by auto_mixed_precision_pass. The ops out of the white list run
+ * in float32 when they need fewer casts there than in float16/bfloat16, so
+ * that the cheap ops between them do not flip the dtype back and forth.
+ */
+PHI_DEFINE_EXPORTED_bool(amp_cast_cost_check,
+                         false,
+                         "Whether to run the cheap ops in float32 when it "
+                         "saves casts in auto_mixed_precision_pass.");
+
 /**
  * Operator related FLAG
  * Name: FLAGS_check_nan_inf
@@ -102,6 +131,24 @@ PHI_DEFINE_EXPORTED_int32(
     0,
     "Setting the check and print level when FLAGS_check_nan_inf is set.");
 
+/**
+ * Operator related FLAG
+ * Name: FLAGS_check_nan_inf_lazy
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: Used to debug. When FLAGS_check_nan_inf is set, the float outputs on
+ * GPU only mark a flag on the device, and the flags are read back once at the
+ * end of each run of the executor, or when the tensor checker is disabled. The
+ * ops and vars holding NAN/INF are reported without their statistics, rerun
+ * them with FLAGS_check_nan_inf_lazy=false for the details.
+ */
+PHI_DEFINE_EXPORTED_bool(
+    check_nan_inf_lazy,
+    false,
+    "Whether to read back the NAN/INF checks of the GPU outputs once per "
+    "step instead of once per op when FLAGS_check_nan_inf is set.");
+
 /**
  * Operator related FLAG
  * Name: FLAGS_check_nan_inf
@@ -239,7 +286,9 @@ PHI_DEFINE_EXPORTED_bool(
  * Note: whether to use deterministic algorithm in embedding op.
  *       If it is 1, it will use the optimized deterministic CUDA kernel in
  *       embedding op. If it is 2, it will use the legacy deterministic
- *       CUDA kernel in embedding op.
+ *       CUDA kernel in embedding op. If it is 3, it will sort the ids and
+ *       sum the gradients of each id without atomics, which is faster when
+ *       the ids repeat a lot.
  */
 PHI_DEFINE_EXPORTED_int64(
     embedding_deterministic,
@@ -281,6 +330,38 @@ PHI_DEFINE_EXPORTED_int64(cudnn_exhaustive_search_times,
                           "Exhaustive search times for cuDNN convolution, "
                           "default is -1, not exhaustive search");
 
+/**
+ * CUDNN related FLAG
+ * Name: FLAGS_reuse_dnn_workspace
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example: FLAGS_reuse_dnn_workspace=true
+ * Note: If true, the cuDNN workspace handles of a GPU context share one
+ * workspace, which grows to the largest request of the kernels on its stream
+ * and is kept, instead of every conv kernel allocating and freeing its own.
+ * The workspace is released by paddle.device.cuda.empty_cache().
+ */
+PHI_DEFINE_EXPORTED_bool(reuse_dnn_workspace,
+                         false,
+                         "Whether the cuDNN workspace handles of a GPU "
+                         "context share one workspace, default is false.");
+
+/**
+ * CUFFT related FLAG
+ * Name: FLAGS_fft_plan_batch_bucketing
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example: FLAGS_fft_plan_batch_bucketing=true
+ * Note: If true, the cuFFT plans are made for power-of-two batch sizes only,
+ * and a transform of any other batch size runs as several of them. Inputs of
+ * varying lengths, such as the frames of stft on audio, then reuse a few
+ * plans instead of making a new one for every length.
+ */
+PHI_DEFINE_EXPORTED_bool(fft_plan_batch_bucketing,
+                         false,
+                         "Whether to make the cuFFT plans for power-of-two "
+                         "batch sizes only, default is false.");
+
 #ifdef PADDLE_WITH_HIP
 /**
  * MIOPEN related FLAG
@@ -374,6 +455,21 @@ PHI_DEFINE_EXPORTED_bool(
 PHI_DEFINE_EXPORTED_int32(communicator_send_queue_size,
                           20,
                           "queue size to recv gradient before send");
+/**
+ * Distributed related FLAG
+ * Name: FLAGS_communicator_geo_max_staleness
+ * Since Version: 3.1.0
+ * Value Range: int32, default=0
+ * Example: FLAGS_communicator_geo_max_staleness=40
+ * Note: If greater than 0, the GeoCommunicator merges the sparse ids of every
+ *       batch into a bitmap instead of queueing them, sends as many batches
+ *       at once as it takes the server to answer one send, and blocks the
+ *       trainer once this many batches wait to be sent.
+ */
+PHI_DEFINE_EXPORTED_int32(communicator_geo_max_staleness,
+                          0,
+                          "max batches of sparse ids waiting to be sent in "
+                          "geo mode, 0 to queue the ids of every batch");
 #endif
 
 /**
@@ -483,6 +579,49 @@ PHI_DEFINE_EXPORTED_string(
     "on the same GPU card but may lead to more memory fragmentation "
     "(i.e., maximum batch size of models may be smaller).");
 
+/**
+ * Allocator related FLAG
+ * Name: FLAGS_use_size_class_cache_allocator
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: If True, small allocations of the auto_growth strategy are served by
+ *       per-thread size-class free lists in front of the auto_growth
+ *       allocator, which reduces lock contention in multi-threaded jobs.
+ */
+PHI_DEFINE_EXPORTED_bool(
+    use_size_class_cache_allocator,
+    false,
+    "Whether to cache small allocations of the auto_growth allocator in "
+    "per-thread size-class free lists.");
+
+/**
+ * Allocator related FLAG
+ * Name: FLAGS_size_class_cache_max_size_in_kb
+ * Since Version: 3.1.0
+ * Value Range: uint64, default=1024 (KB)
+ * Example:
+ * Note: Allocations larger than this size bypass the size-class cache.
+ */
+PHI_DEFINE_EXPORTED_uint64(size_class_cache_max_size_in_kb,
+                           1024,
+                           "The largest allocation size in KB served by the "
+                           "size-class cache allocator.");
+
+/**
+ * Allocator related FLAG
+ * Name: FLAGS_size_class_cache_thread_capacity
+ * Since Version: 3.1.0
+ * Value Range: uint64, default=64
+ * Example:
+ * Note: The number of blocks of each size class kept by a thread before
+ *       half of them are returned to the central cache in bulk.
+ */
+PHI_DEFINE_EXPORTED_uint64(size_class_cache_thread_capacity,
+                           64,
+                           "The number of blocks of each size class cached by "
+                           "a thread in the size-class cache allocator.");
+
 /**
  * Memory related FLAG
  * Name: FLAGS_fraction_of_cpu_memory_to_use
@@ -536,6 +675,23 @@ PHI_DEFINE_EXPORTED_double(
     "Default use 50% of CPU memory as the pinned_memory for PaddlePaddle,"
     "reserve the rest for page tables, etc");
 
+/**
+ * Memory related FLAG
+ * Name: FLAGS_mix_vector_async_copy
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example: FLAGS_mix_vector_async_copy=true
+ * Note: If true, the CPU data of a MixVector, such as the LoD offsets, is
+ *       staged in pinned memory and copied to the GPU on the stream of the
+ *       device without waiting for it. The kernels on that stream are
+ *       ordered after the copy. The copies back to the CPU still wait for
+ *       the stream, and are counted as implicit syncs.
+ */
+PHI_DEFINE_EXPORTED_bool(mix_vector_async_copy,
+                         false,
+                         "Whether to copy the MixVector data to the GPU "
+                         "asynchronously through pinned memory.");
+
 // NOTE(zhiqiu): better to share the flags, otherwise we will have too many
 // flags.
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP) || \
@@ -668,6 +824,21 @@ PHI_DEFINE_EXPORTED_bool(
     "If set true, the queue.pop will only get data from queue but not "
     "remove the data from queue for speed testing");
 
+/**
+ * CPU related FLAG
+ * Name: numa_aware_placement
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example: FLAGS_numa_aware_placement=true
+ * Note: Pin the threads of the WorkQueues and the shard pools of the sparse
+ * tables to the NUMA nodes in blocks, and bind the large host allocations of
+ * a pinned thread to its node.
+ */
+PHI_DEFINE_EXPORTED_bool(numa_aware_placement,
+                         false,
+                         "Place the threads and the host memory by the NUMA "
+                         "nodes.");
+
 /**
  * MKLDNN related FLAG
  * Name: use_mkldnn
@@ -724,6 +895,77 @@ PHI_DEFINE_EXPORTED_bool(sort_sum_gradient,
                          "Sum gradients by the reverse order of "
                          "the forward execution sequence.");
 
+/**
+ * Performance related FLAG
+ * Name: FLAGS_eager_backward_thread_num
+ * Since Version: 3.1.0
+ * Value Range: int32, default=0
+ * Example: FLAGS_eager_backward_thread_num=4 would run the ready GradNodes
+ *          of the dygraph backward on 4 threads.
+ * Note: 0 or 1 runs the GradNodes one by one. The threads are created at the
+ *       first parallel backward, so the flag should be set before it. The
+ *       backward with create_graph, paddle.grad and the nodes forced to run
+ *       in sequence always run one by one.
+ */
+PHI_DEFINE_EXPORTED_int32(eager_backward_thread_num,
+                          0,
+                          "The number of threads to run the independent "
+                          "GradNodes of the dygraph backward, 0 or 1 runs "
+                          "them one by one.");
+
+/**
+ * Performance related FLAG
+ * Name: FLAGS_eager_offload_saved_tensor_min_bytes
+ * Since Version: 3.1.0
+ * Value Range: int64, default=0
+ * Example: FLAGS_eager_offload_saved_tensor_min_bytes=1048576 would offload
+ *          the saved tensors of at least 1MB to the pinned host memory.
+ * Note: The dense GPU tensors saved for the backward are copied to the host
+ *       on a side stream and copied back before their GradNodes run, the
+ *       device memory is freed in between. 0 means no offload.
+ */
+PHI_DEFINE_EXPORTED_int64(eager_offload_saved_tensor_min_bytes,
+                          0,
+                          "The saved tensors of the dygraph backward of at "
+                          "least this many bytes are offloaded to the host, "
+                          "0 means no offload.");
+
+PHI_DEFINE_EXPORTED_int32(eager_offload_prefetch_num,
+                          4,
+                          "The number of offloaded saved tensors copied back "
+                          "ahead of the GradNodes using them.");
+
+/**
+ * Performance related FLAG
+ * Name: FLAGS_eager_compress_saved_tensor
+ * Since Version: 3.1.0
+ * Value Range: string, {"", "mask", "all"}, default=""
+ * Example: FLAGS_eager_compress_saved_tensor=mask would save the out of relu
+ *          and the mask of dropout as bit masks for the backward.
+ * Note: The generated GradNodes pick the compression of each saved tensor.
+ *       "mask" only enables the bit masks, which are exact, "all" also
+ *       enables the lossy int8 values with a scale per block.
+ */
+PHI_DEFINE_EXPORTED_string(eager_compress_saved_tensor,
+                           "",
+                           "The compression of the saved tensors of the "
+                           "dygraph backward, can be empty, mask or all.");
+
+/**
+ * Data related FLAG
+ * Name: FLAGS_tensor_stream_checksum_chunk_bytes
+ * Since Version: 3.1.0
+ * Value Range: int64, default=0
+ * Example: FLAGS_tensor_stream_checksum_chunk_bytes=67108864 would save the
+ *          data of each DenseTensor with a CRC-32 per 64MB chunk.
+ * Note: 0 saves the tensors in version 0 without checksums. A damaged chunk
+ *       of a tensor with checksums fails the load instead of loading garbage.
+ */
+PHI_DEFINE_EXPORTED_int64(tensor_stream_checksum_chunk_bytes,
+                          0,
+                          "The size of the chunks of the saved DenseTensor "
+                          "data with a checksum each, 0 means no checksum.");
+
 /**
  * Performance related FLAG
  * Name: max_inplace_grad_add
@@ -848,6 +1090,48 @@ PHI_DEFINE_EXPORTED_bool(
     false,
     "It controls whether to apply IR pass to program when using Fleet APIs");
 
+/**
+ * Distributed related FLAG
+ * Name: FLAGS_eager_reducer_rebuild_groups
+ * Since Version: 3.0.0
+ * Value Range: bool, default=false
+ * Example: FLAGS_eager_reducer_rebuild_groups=true would rebuild the groups
+ *          of EagerReducer by the order in which gradients become ready.
+ * Note: The order is recorded in the first backward and broadcast from rank
+ *       0, so that the groups of later steps are ready one after another.
+ */
+PHI_DEFINE_EXPORTED_bool(eager_reducer_rebuild_groups,
+                         false,
+                         "Whether to rebuild the groups of EagerReducer by "
+                         "the ready order of gradients.");
+
+/**
+ * Distributed related FLAG
+ * Name: FLAGS_eager_reducer_grad_compress
+ * Since Version: 3.0.0
+ * Value Range: string, default=empty
+ * Example: FLAGS_eager_reducer_grad_compress=powersgd would compress the
+ *          dense gradients of EagerReducer by low-rank PowerSGD.
+ * Note: "topk" keeps the largest FLAGS_eager_reducer_topk_ratio of each
+ *       group, "powersgd" approximates each group by a rank
+ *       FLAGS_eager_reducer_powersgd_rank matrix. Both keep the compression
+ *       error as feedback for the next step. Empty means no compression.
+ */
+PHI_DEFINE_EXPORTED_string(eager_reducer_grad_compress,
+                           "",
+                           "The compression of the dense gradients of "
+                           "EagerReducer, can be empty, topk or powersgd.");
+
+PHI_DEFINE_EXPORTED_double(eager_reducer_topk_ratio,
+                           0.01,
+                           "The ratio of the gradients kept by the topk "
+                           "compression of EagerReducer.");
+
+PHI_DEFINE_EXPORTED_int32(eager_reducer_powersgd_rank,
+                          4,
+                          "The rank of the PowerSGD compression of "
+                          "EagerReducer.");
+
 /**
  * Debug related FLAG
  * Name: FLAGS_save_static_runtime_data
@@ -875,6 +1159,63 @@ PHI_DEFINE_EXPORTED_bool(graph_load_in_parallel,
                          "It controls whether load graph node and edge with "
                          "multi threads parallelly.");
 
+/**
+ * Distributed related FLAG
+ * Name: FLAGS_graph_build_csr_sampler
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: Control whether build the contiguous csr neighbor storage of the edge
+ *       shards after the cpu samplers, random_sample_neighbors samples from
+ *       it instead of the nodes when it is built.
+ */
+PHI_DEFINE_EXPORTED_bool(graph_build_csr_sampler,
+                         false,
+                         "It controls whether build the csr neighbor storage "
+                         "of the graph edge shards for sampling.");
+
+/**
+ * Distributed related FLAG
+ * Name: FLAGS_graph_use_alias_sampler
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: Control whether the weighted edges loaded by load_edges are sampled
+ *       by weight with alias tables, instead of uniformly.
+ */
+PHI_DEFINE_EXPORTED_bool(graph_use_alias_sampler,
+                         false,
+                         "It controls whether sample the weighted graph edges "
+                         "by weight with alias tables.");
+
+/**
+ * Distributed related FLAG
+ * Name: FLAGS_graph_use_clock_sample_cache
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: Control whether the neighbor sample cache of GraphTable is the
+ *       sharded CLOCK cache instead of ScaledLRU.
+ */
+PHI_DEFINE_EXPORTED_bool(graph_use_clock_sample_cache,
+                         false,
+                         "It controls whether use the sharded CLOCK cache as "
+                         "the neighbor sample cache.");
+
+/**
+ * Distributed related FLAG
+ * Name: FLAGS_graph_sample_cache_bytes
+ * Since Version: 3.1.0
+ * Value Range: int64, default=0
+ * Example:
+ * Note: The bytes of the sample results the CLOCK neighbor sample cache
+ *       keeps besides its entry limit, 0 means no limit on bytes.
+ */
+PHI_DEFINE_EXPORTED_int64(graph_sample_cache_bytes,
+                          0,
+                          "The bytes limit of the CLOCK neighbor sample "
+                          "cache.");
+
 /**
  * Distributed related FLAG
  * Name: FLAGS_enable_neighbor_list_use_uva
@@ -914,6 +1255,21 @@ PHI_DEFINE_EXPORTED_bool(graph_metapath_split_opt,
                          "It controls whether load graph node and edge with "
                          "multi threads parallelly.");
 
+/**
+ * Distributed related FLAG
+ * Name: FLAGS_graph_prefetch_slot_feature
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: Control whether the gpu graph sage training pulls the slot features
+ *       of the next batch in the background while the current batch trains.
+ */
+PHI_DEFINE_EXPORTED_bool(graph_prefetch_slot_feature,
+                         false,
+                         "It controls whether the slot features of the next "
+                         "sage batch are pulled while the current batch "
+                         "trains.");
+
 /**
  * Distributed related FLAG
  * Name: FLAGS_graph_get_neighbor_id
@@ -1060,6 +1416,21 @@ PHI_DEFINE_EXPORTED_int64(
     -1,
     "It controls how many thread numbers applying compilation cache.");
 
+/*
+ * CINN related FLAG
+ * Name: FLAGS_cinn_compile_thread_memory_mb
+ * Since Version: 3.1.0
+ * Value Range: int64, default=0
+ * Example: FLAGS_cinn_compile_thread_memory_mb=1024 would assume every
+ * compilation thread takes 1GB host memory and bound the number of threads
+ * by the available host memory. 0 means no memory bound.
+ */
+PHI_DEFINE_EXPORTED_int64(
+    cinn_compile_thread_memory_mb,
+    0,
+    "The estimated host memory in MB used by one cinn compilation thread, "
+    "which bounds the number of compilation threads.");
+
 /*
  * CINN related FLAG
  * Name: FLAGS_cinn_specify_input_dynamic_dim
@@ -1100,6 +1471,22 @@ PHI_DEFINE_EXPORTED_bool(new_executor_use_cuda_graph,
                          false,
                          "Use CUDA Graph in new executor");
 
+/*
+ * CUDA Graph related FLAG
+ * Name: FLAGS_new_executor_segmented_cuda_graph
+ * Since Version: 3.0.0
+ * Value Range: bool, default=false
+ * Example: FLAGS_new_executor_segmented_cuda_graph=true would allow the pir
+ * interpreter to capture the regions between its host instructions (control
+ * flow, sync and cpu instructions) to CUDA graphs at the first run and replay
+ * them after, while the host instructions run eagerly. It works with
+ * FLAGS_new_executor_use_cuda_graph in trace mode.
+ */
+PHI_DEFINE_EXPORTED_bool(new_executor_segmented_cuda_graph,
+                         false,
+                         "Capture the static regions between host "
+                         "instructions to CUDA graphs in pir interpreter");
+
 /*
  * CUDA Graph / Allocator related FLAG
  * Name: FLAGS_use_cuda_malloc_async_allocator
@@ -1162,6 +1549,20 @@ PHI_DEFINE_EXPORTED_uint64(executor_log_deps_every_microseconds,
                            0,
                            "Enable new executor log deps every n microseconds");
 
+/*
+ * Executor related FLAG
+ * Name: FLAGS_executor_instruction_profile_every
+ * Since Version: 3.0.0
+ * Value Range: int32, default=0
+ * Example: FLAGS_executor_instruction_profile_every=n (n>0) would sample the
+ * queue wait, host launch and device time of each instruction in one of every
+ * n runs of the pir interpreter, and log the hotspots when it is destroyed.
+ */
+PHI_DEFINE_EXPORTED_int32(executor_instruction_profile_every,
+                          0,
+                          "Sample the latency of the instructions in one of "
+                          "every n runs of the pir interpreter, 0 to disable.");
+
 PD_DEFINE_int32(record_pool_max_size,
                 2000000,
                 "SlotRecordDataset slot record pool max size");
@@ -1177,6 +1578,22 @@ PD_DEFINE_bool(enable_slotrecord_reset_shrink,  // NOLINT
 PD_DEFINE_bool(enable_ins_parser_file,  // NOLINT
                false,
                "enable parser ins file, default false");
+PD_DEFINE_bool(dataset_prefetch_next_file,  // NOLINT
+               false,
+               "open the next file in background while the current one is "
+               "parsed in LoadIntoMemory, default false");
+PHI_DEFINE_EXPORTED_int64(
+    dataset_global_shuffle_buffer_bytes,
+    0,
+    "if positive, GlobalShuffle keeps appending records to the buffer of "
+    "each destination and sends a buffer once it reaches this size, without "
+    "waiting for the replies of every batch, default 0");
+PD_DEFINE_string(dataset_parsed_cache_dir,  // NOLINT
+                 "",
+                 "if not empty, LoadIntoMemory of InMemoryDataFeed saves the "
+                 "parsed records of each file into this directory and loads "
+                 "them from there instead of parsing the file again, "
+                 "default empty");
 PHI_DEFINE_EXPORTED_bool(
     gpugraph_enable_hbm_table_collision_stat,
     false,
@@ -1186,6 +1603,35 @@ PHI_DEFINE_EXPORTED_bool(
     false,
     "Cache the scope of the while op to avoid repeated creation of the scope "
     "for each iteration and improve inference performance.");
+PHI_DEFINE_EXPORTED_bool(
+    freeze_cloned_predictor_scope,
+    false,
+    "Freeze the parameter scope shared by the cloned predictors so that the "
+    "variable lookups from the clones do not take the scope lock.");
+PHI_DEFINE_EXPORTED_bool(
+    predictor_pool_share_trt_engine,
+    false,
+    "Let the PredictorPool clone its TensorRT predictors from the main one, "
+    "so that they share the weights and the TensorRT engines and each only "
+    "owns an execution context, instead of creating them from the config.");
+PHI_DEFINE_EXPORTED_bool(
+    predictor_clone_private_stream,
+    false,
+    "Give each clone of a gpu predictor that does not use an external stream "
+    "its own stream, GPUContext and library handles, so that the clones run "
+    "concurrently instead of serializing on the global GPUContext.");
+PHI_DEFINE_EXPORTED_int64(
+    predictor_batch_feed_max_bytes,
+    0,
+    "If positive, the PaddleTensor feeds of a gpu predictor run which are all "
+    "not larger than this are gathered into one pinned buffer and copied to "
+    "the device by one memcpy, instead of one memcpy for each feed.");
+PHI_DEFINE_EXPORTED_int32(
+    fleet_metric_auc_shards,
+    0,
+    "If positive, the batches added to a fleet BasicAucCalculator are "
+    "accumulated into this many tables, picked by the adding thread, and "
+    "merged when the metric is computed, instead of into one locked table.");
 PHI_DEFINE_EXPORTED_double(gpugraph_hbm_table_load_factor,
                            0.75,
                            "the load factor of hbm table, default 0.75");
@@ -1208,6 +1654,18 @@ PHI_DEFINE_EXPORTED_int32(
     gpugraph_dedup_pull_push_mode,
     0,
     "enable dedup keys while pull push sparse, default 0");
+PHI_DEFINE_EXPORTED_bool(
+    gpups_divide_keys_in_build_thread,
+    false,
+    "divide the keys of the next pass to the devices in the build pull "
+    "thread while the current pass is trained instead of in BeginPass, "
+    "default false");
+PHI_DEFINE_EXPORTED_int64(
+    gpups_prefill_build_values_mb,
+    0,
+    "if positive, the build pull thread also fills the values of the next "
+    "pass for BeginPass while the current pass is trained, as long as they "
+    "fit in this host memory budget in MB, default 0");
 PHI_DEFINE_EXPORTED_bool(gpugraph_load_node_list_into_hbm,
                          true,
                          "enable load_node_list_into_hbm, default true");
@@ -1279,6 +1737,28 @@ PHI_DEFINE_EXPORTED_bool(eager_communication_connection,
                          false,
                          "enable eager to create nccl comm");
 
+/**
+ * ProcessGroupNCCL related FLAG
+ * Name: nccl_hierarchical_allreduce
+ * Since Version: 3.0.0
+ * Value Range: bool, default=false
+ * Example: FLAGS_nccl_hierarchical_allreduce=true would run the all-reduce
+ *          of ProcessGroupNCCL as an intra-node reduce-scatter, an
+ *          inter-node all-reduce and an intra-node all-gather.
+ * Note: Only the all-reduce of no more than
+ *       FLAGS_nccl_hierarchical_allreduce_max_bytes is hierarchical, and
+ *       only if the ranks of every node are contiguous and of the same
+ *       number.
+ */
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+PHI_DEFINE_EXPORTED_bool(nccl_hierarchical_allreduce,
+                         false,
+                         "enable hierarchical all-reduce on multi nodes");
+PHI_DEFINE_EXPORTED_int64(nccl_hierarchical_allreduce_max_bytes,
+                          64 << 20,
+                          "the max bytes of the hierarchical all-reduce");
+#endif
+
 PHI_DEFINE_EXPORTED_int64(
     tcp_max_syn_backlog,
     2048,
@@ -1294,6 +1774,38 @@ PHI_DEFINE_EXPORTED_int64(
  */
 PHI_DEFINE_EXPORTED_bool(use_autotune, false, "Whether enable autotune.");
 
+/**
+ * Autotune related FLAG
+ * Name: FLAGS_autotune_cache_file
+ * Since Version: 3.0.0
+ * Value Range: string, default=""
+ * Example: FLAGS_autotune_cache_file=./autotune_cache.txt
+ * Note: If not empty, the tuned algorithms are loaded from the file when the
+ * autotune is initialized, and exported to the file after the tuning range.
+ * The entries are only loaded on the same device arch and library versions.
+ */
+PHI_DEFINE_EXPORTED_string(autotune_cache_file,
+                           "",
+                           "The file to load and export the autotune cache.");
+
+/**
+ * Autotune related FLAG
+ * Name: FLAGS_layout_autotune_region_gain
+ * Since Version: 3.1.0
+ * Value Range: double, default=0
+ * Example: FLAGS_layout_autotune_region_gain=4
+ * Note: If positive, the eager layout autotune plans the layout per region of
+ * the model from a trace of its first run: a region is only kept in the
+ * desired layout if the elements computed by its convolutions and norms,
+ * times this gain, are at least the elements it transposes. If 0, the layout
+ * is switched greedily op by op.
+ */
+PHI_DEFINE_EXPORTED_double(
+    layout_autotune_region_gain,
+    0.0,
+    "The gain of the desired layout a region must have over its transposes "
+    "to be tuned, 0 to switch the layout greedily.");
+
 /**
  * CINN training related FLAG
  * Name: FLAGS_disable_dyshape_in_train
@@ -1367,6 +1879,22 @@ PHI_DEFINE_EXPORTED_bool(
     true,
     "Whether enable use reuse iters transform in cinn fusion.");
 
+/**
+ * CINN horizontal fusion FLAG
+ * Name: FLAGS_cinn_horizontal_fusion_max_reduce_ops
+ * Since Version: 3.0.0
+ * Value Range: int32, default=16
+ * Example: FLAGS_cinn_horizontal_fusion_max_reduce_ops=8 stops the
+ * horizontal fusion of sibling patterns once the fused kernel would hold more
+ * than 8 reductions, each of which keeps its own accumulators in registers and
+ * its own block reduce buffer in shared memory. A value <= 0 disables the
+ * limit.
+ */
+PHI_DEFINE_EXPORTED_int32(
+    cinn_horizontal_fusion_max_reduce_ops,
+    16,
+    "The maximum number of reductions in a kernel made by horizontal fusion.");
+
 /**
  * CINN AppendIters transform fusion FLAG
  * Name: FLAGS_enable_append_iters_in_fusion
@@ -1479,6 +2007,95 @@ PHI_DEFINE_EXPORTED_bool(trt_ibuilder_cache,
                          false,
                          "Add a persistent ibuilder.");
 
+/**
+ * TensorRT related FLAG
+ * Name: trt_cuda_graph_pool_size
+ * Since Version: 3.1.0
+ * Value Range: int32, default=8
+ * Example:
+ * Note: The maximum number of the cuda graphs kept by one TensorRT engine
+ * when the trt cuda graph is enabled. A graph is captured for every distinct
+ * input shapes and the least recently used one is released beyond the size.
+ */
+PHI_DEFINE_EXPORTED_int32(trt_cuda_graph_pool_size,
+                          8,
+                          "The maximum number of the cuda graphs of one "
+                          "TensorRT engine.");
+
+/**
+ * TensorRT related FLAG
+ * Name: trt_async_engine_build
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: If True, the TensorRT engine which is rebuilt at runtime for the out
+ * of range input shapes is built in background, and the subgraph runs with
+ * the native paddle kernels until the new engine is ready.
+ */
+PHI_DEFINE_EXPORTED_bool(trt_async_engine_build,
+                         false,
+                         "Rebuild the TensorRT engine in background.");
+
+/**
+ * TensorRT related FLAG
+ * Name: trt_min_light_subgraph_size
+ * Since Version: 3.1.0
+ * Value Range: int32, default=0
+ * Example:
+ * Note: The minimum number of ops of a TensorRT subgraph which contains no
+ * compute heavy op (conv, matmul, fc, attention). Such a subgraph only saves
+ * the launch of a few memory bound kernels, which can not pay for the engine
+ * boundary, and is left to the native paddle kernels. 0 means no limit.
+ */
+PHI_DEFINE_EXPORTED_int32(trt_min_light_subgraph_size,
+                          0,
+                          "The minimum size of a TensorRT subgraph without "
+                          "compute heavy ops.");
+
+/**
+ * Custom device related FLAG
+ * Name: custom_device_async_memcpy_d2h
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: If True, the memcpy_d2h kernel of the custom devices does not wait
+ * for the copy, which stays on the device stream so that the following
+ * kernels overlap it. The new executor waits for it by events before the
+ * host ops reading the output, and at the end of every run.
+ */
+PHI_DEFINE_EXPORTED_bool(custom_device_async_memcpy_d2h,
+                         false,
+                         "Do not wait for the memcpy_d2h of custom devices.");
+
+/**
+ * Distributed related FLAG
+ * Name: gloo_allreduce_channels
+ * Since Version: 3.1.0
+ * Value Range: int32, default=1
+ * Example:
+ * Note: The number of gloo contexts, each with its own TCP pairs, which the
+ * chunks of a large all-reduce of the gloo comm context are spread over, so
+ * that the rings of the chunks run in parallel.
+ */
+PHI_DEFINE_EXPORTED_int32(gloo_allreduce_channels,
+                          1,
+                          "The number of gloo contexts a large all-reduce "
+                          "is spread over.");
+
+/**
+ * Distributed related FLAG
+ * Name: gloo_allreduce_chunk_bytes
+ * Since Version: 3.1.0
+ * Value Range: int64, default=4194304
+ * Example:
+ * Note: The bytes of a chunk of an all-reduce spread over the gloo channels.
+ * A tensor smaller than two chunks is all-reduced in one piece.
+ */
+PHI_DEFINE_EXPORTED_int64(gloo_allreduce_chunk_bytes,
+                          4 << 20,
+                          "The bytes of a chunk of a gloo all-reduce spread "
+                          "over the channels.");
+
 /**
  * mmap_allocator related FLAG
  * Name: use_shm_cache
@@ -1570,6 +2187,91 @@ PHI_DEFINE_EXPORTED_bool(
     false,
     "whether PirInterpreter::RecordStreamForGC use cache strategy.");
 
+/**
+ * PirInterpreter scheduling related FLAG
+ * Name: pir_interpreter_critical_path_scheduling
+ * Since Version: 3.0.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: If True, PirInterpreter dispatches ready instructions by the length of
+ * their remaining critical path in the dependency graph, the most critical one
+ * is run first by the current thread and the others are left to be stolen by
+ * idle threads.
+ */
+PHI_DEFINE_EXPORTED_bool(pir_interpreter_critical_path_scheduling,
+                         false,
+                         "whether PirInterpreter schedules ready instructions "
+                         "by their critical path depth.");
+
+/**
+ * PirInterpreter scheduling related FLAG
+ * Name: pir_interpreter_auto_stream_num
+ * Since Version: 3.0.0
+ * Value Range: int32, default=0
+ * Example:
+ * Note: If larger than 1, the async GPU kernels without an execution stream
+ * are assigned to this number of streams by the list scheduling of their
+ * dependencies, with their output numels as the costs at the build and their
+ * profiled device time after the first sampled run of
+ * FLAGS_executor_instruction_profile_every.
+ */
+PHI_DEFINE_EXPORTED_int32(pir_interpreter_auto_stream_num,
+                          0,
+                          "the number of streams PirInterpreter assigns the "
+                          "independent GPU kernels to.");
+
+/**
+ * PirInterpreter memory related FLAG
+ * Name: pir_interpreter_static_memory_plan
+ * Since Version: 3.0.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: If True, the intermediate DenseTensors with static shape are assigned
+ * offsets in one arena according to their liveness, and are reused across
+ * steps instead of being freed by the garbage collector.
+ */
+PHI_DEFINE_EXPORTED_bool(pir_interpreter_static_memory_plan,
+                         false,
+                         "whether PirInterpreter plans the memory of static "
+                         "shape intermediate tensors in one arena.");
+
+/**
+ * PirInterpreter memory related FLAG
+ * Name: pir_interpreter_memory_pressure_window
+ * Since Version: 3.0.0
+ * Value Range: int32, default=0
+ * Example:
+ * Note: If larger than 0, before every this number of GPU instructions in the
+ * execution order, PirInterpreter compares the bytes their static shape
+ * outputs are expected to allocate with the free device memory. When the
+ * device is short of it, the garbages pending in the garbage collector are
+ * freed at once and the idle blocks cached by the allocator are released, so
+ * that the coming allocations do not fail into the retry of the allocator.
+ */
+PHI_DEFINE_EXPORTED_int32(pir_interpreter_memory_pressure_window,
+                          0,
+                          "the number of instructions whose expected "
+                          "allocations PirInterpreter checks against the free "
+                          "device memory at once, 0 means not to check.");
+
+/**
+ * PirInterpreter memory related FLAG
+ * Name: pir_interpreter_dynamic_memory_plan_buckets
+ * Since Version: 3.0.0
+ * Value Range: int32, default=0
+ * Example:
+ * Note: If larger than 0, the intermediate DenseTensors with dynamic shape
+ * record the sizes they allocate in the first run of a shape bucket, which is
+ * the dims of all the data ops, for up to this number of buckets. The reruns
+ * of a recorded bucket assign them offsets in one arena according to the
+ * sizes and their liveness, as FLAGS_pir_interpreter_static_memory_plan does.
+ */
+PHI_DEFINE_EXPORTED_int32(pir_interpreter_dynamic_memory_plan_buckets,
+                          0,
+                          "the max number of shape buckets PirInterpreter "
+                          "plans the memory of dynamic shape intermediate "
+                          "tensors for, 0 means not to plan.");
+
 /**
  * Using PIR API in Python
  * Name: enable_pir_api
@@ -1606,11 +2308,69 @@ PHI_DEFINE_EXPORTED_bool(pir_apply_inplace_pass,
                          "Whether to apply inplace pass on lowering "
                          "::pir::Program to Kernel Dialect");
 
+/**
+ * Pass related FLAG
+ * Name: pir_pass_num_threads
+ * Since Version: 3.0.0
+ * Value Range: int32, default=1
+ * Example:
+ * Note: The threads of pir::PassManager to run the pipeline over the nested
+ * ops isolated from above concurrently, 1 runs them sequentially.
+ */
+PHI_DEFINE_EXPORTED_int32(pir_pass_num_threads,
+                          1,
+                          "The threads of pir::PassManager to run the "
+                          "pipelines over the isolated nested ops.");
+
+/**
+ * Pass related FLAG
+ * Name: pir_fuse_pattern_rewrite_passes
+ * Since Version: 3.0.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: If True, pir::PassManager runs the consecutive pattern rewrite passes
+ * by one incremental rewrite driver over their merged patterns.
+ */
+PHI_DEFINE_EXPORTED_bool(pir_fuse_pattern_rewrite_passes,
+                         false,
+                         "Whether to run the consecutive pattern rewrite "
+                         "passes of pir by one rewrite driver.");
+
+/**
+ * Operation related FLAG
+ * Name: pir_operation_storage_pool
+ * Since Version: 3.0.0
+ * Value Range: bool, default=true
+ * Example:
+ * Note: If True, the storage of the small pir operations is carved from the
+ * slabs and recycled by the free lists instead of malloc. It is read once at
+ * the first operation created.
+ */
+PHI_DEFINE_EXPORTED_bool(pir_operation_storage_pool,
+                         true,
+                         "Whether to allocate the pir operations from the "
+                         "slabs of the operation storage pool.");
+
 PHI_DEFINE_EXPORTED_string(
     ir_inplace_kernel_blacklist,
     "",
     "It controls the ir inplace kernel subset do not use.");
 
+/**
+ * Executor related FLAG
+ * Name: FLAGS_ir_inplace_buffer_reuse
+ * Since Version: 3.0.0
+ * Value Range: bool, default=false
+ * Example: FLAGS_ir_inplace_buffer_reuse=true would let the outputs of the
+ * elementwise ops without inplace version reuse the buffers of their dead
+ * inputs in the inplace_pass.
+ * Note: Only the ops whitelisted in the inplace_pass are considered.
+ */
+PHI_DEFINE_EXPORTED_bool(ir_inplace_buffer_reuse,
+                         false,
+                         "Whether to reuse the buffers of the dead inputs for "
+                         "the elementwise ops without inplace version.");
+
 PHI_DEFINE_EXPORTED_bool(enable_record_memory, false, "Enable memory recorder");
 
 PHI_DEFINE_EXPORTED_bool(
@@ -1683,11 +2443,61 @@ PHI_DEFINE_EXPORTED_bool(enable_async_trace,
 
 PHI_DEFINE_EXPORTED_int32(async_trace_count, 5, "collective async trace count");
 
+/**
+ * ProcessGroupNCCL related FLAG
+ * Name: enable_comm_latency_stats
+ * Since Version: 3.0.0
+ * Value Range: bool, default=false
+ * Example: FLAGS_enable_async_trace=true FLAGS_enable_comm_latency_stats=true
+ *          would collect the latency of the traced collectives.
+ * Note: The latency is measured by timing events around the nccl kernels,
+ *       which are a little more expensive than the events of the trace.
+ */
+PHI_DEFINE_EXPORTED_bool(enable_comm_latency_stats,
+                         false,
+                         "enable the latency stats of collective async trace");
+
 PHI_DEFINE_EXPORTED_bool(
     use_auto_growth_pinned_allocator,
     false,
     "Whether to use the auto_growth CUDA pinned allocator.");
 
+/**
+ * Allocator related FLAG
+ * Name: FLAGS_cuda_pinned_memory_pool_max_size_in_mb
+ * Since Version: 3.1.0
+ * Value Range: uint64, default=0 (no limit)
+ * Example: FLAGS_use_auto_growth_pinned_allocator=true
+ *          FLAGS_cuda_pinned_memory_pool_max_size_in_mb=4096 keeps at most
+ *          4GB of pinned host memory in the auto_growth pinned allocator.
+ * Note: When the limit is reached, the idle chunks of the pool are freed
+ *       before more host memory is pinned.
+ */
+PHI_DEFINE_EXPORTED_uint64(
+    cuda_pinned_memory_pool_max_size_in_mb,
+    0,
+    "The max size in MB of the CUDA pinned memory reserved by the "
+    "auto_growth pinned allocator, 0 means no limit.");
+
+/**
+ * Allocator related FLAG
+ * Name: FLAGS_cuda_managed_memory_prefetch_min_size_in_mb
+ * Since Version: 3.1.0
+ * Value Range: uint64, default=0 (no prefetch)
+ * Example: FLAGS_use_cuda_managed_memory=true
+ *          FLAGS_cuda_managed_memory_prefetch_min_size_in_mb=16 prefetches
+ *          the inputs of 16MB or more, e.g. the embeddings and the optimizer
+ *          states, to the GPU before the instructions using them run.
+ * Note: The managed memory is also advised to stay on its GPU, and to be
+ *       mapped by the GPU once evicted, so that a model larger than the GPU
+ *       memory migrates its large tensors in bulk instead of page by page.
+ */
+PHI_DEFINE_EXPORTED_uint64(
+    cuda_managed_memory_prefetch_min_size_in_mb,
+    0,
+    "The min size in MB of the CUDA managed memory inputs prefetched to the "
+    "GPU before an instruction runs, 0 means no prefetch.");
+
 PHI_DEFINE_EXPORTED_bool(
     sync_after_alloc,
     false,
@@ -1949,6 +2759,64 @@ PHI_DEFINE_EXPORTED_bool(enable_auto_parallel_align_mode,
                          false,
                          "Enable align mode for auto parallel");
 
+/**
+ * Auto parallel related FLAG
+ * Name: enable_reshard_planner
+ * Since Version: 3.0.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: If True, the reshard between two dist attrs on the same nd mesh is
+ * done by the cheapest sequence of one mesh axis reshards found by the
+ * communication cost model, instead of the fixed rule of the nd mesh reshard.
+ */
+PHI_DEFINE_EXPORTED_bool(enable_reshard_planner,
+                         false,
+                         "Plan the nd mesh reshard by the communication cost.");
+
+/**
+ * Auto parallel related FLAG
+ * Name: reshard_planner_mesh_axis_bandwidth
+ * Since Version: 3.0.0
+ * Value Range: string, default=""
+ * Example: "200,25" means the bandwidth of mesh axis 0 is 200 GB/s and the
+ * bandwidth of mesh axis 1 is 25 GB/s.
+ * Note: The bandwidth in GB/s of every mesh axis used by the reshard planner,
+ * the axes not given use 100 GB/s.
+ */
+PHI_DEFINE_EXPORTED_string(reshard_planner_mesh_axis_bandwidth,
+                           "",
+                           "The bandwidth in GB/s of every mesh axis used by "
+                           "the reshard planner.");
+
+/**
+ * Auto parallel related FLAG
+ * Name: reshard_planner_latency_us
+ * Since Version: 3.0.0
+ * Value Range: double, default=10
+ * Example:
+ * Note: The latency in us of one collective used by the reshard planner.
+ */
+PHI_DEFINE_EXPORTED_double(reshard_planner_latency_us,
+                           10,
+                           "The latency in us of one collective used by the "
+                           "reshard planner.");
+
+/**
+ * Auto parallel related FLAG
+ * Name: enable_reshard_cache
+ * Since Version: 3.0.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: If True, resharding an input of a dygraph api to a dist attr reuses
+ * the result of the last reshard of the tensor to the same dist attr, while
+ * the result is still kept by someone, e.g. saved by the forward for the
+ * backward, and neither the tensor nor the result has been changed since.
+ */
+PHI_DEFINE_EXPORTED_bool(enable_reshard_cache,
+                         false,
+                         "Reuse the alive result of the same reshard of an "
+                         "unchanged tensor.");
+
 /**
  * fused_multi_transformer_op related FLAG
  * Name: fused_multi_transformer_op_use_mbfmha
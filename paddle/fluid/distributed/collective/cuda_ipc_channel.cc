@@ -0,0 +1,444 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _WIN32
+
+#include "paddle/fluid/distributed/collective/cuda_ipc_channel.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "glog/logging.h"
+#include "paddle/phi/core/enforce.h"
+#include "paddle/phi/core/memory/memcpy.h"
+#include "paddle/phi/core/platform/cuda_device_guard.h"
+#include "paddle/phi/core/platform/device/gpu/gpu_info.h"
+
+namespace paddle::distributed {
+
+namespace {
+
+constexpr int kMaxSlotDims = 9;
+
+// The handoff of a slot in the shared memory, the sequence numbers of the
+// sends start from 1.
+struct SlotHeader {
+  std::atomic<int64_t> ready_seq{0};
+  std::atomic<int64_t> consumed_seq{0};
+  int32_t dtype{0};
+  int32_t num_dims{0};
+  int64_t dims[kMaxSlotDims];
+};
+
+// The allocation of a received slot, which returns the slot when released.
+class SlotAllocation : public phi::Allocation {
+ public:
+  SlotAllocation(void* ptr,
+                 size_t size,
+                 const phi::Place& place,
+                 std::function<void()> release)
+      : Allocation(ptr, size, place), release_(std::move(release)) {}
+
+  ~SlotAllocation() override { release_(); }
+
+ private:
+  std::function<void()> release_;
+};
+
+std::string ShmName(const std::string& key) {
+  std::string name = "/paddle_ipc_channel_";
+  for (char c : key) {
+    name.push_back(std::isalnum(static_cast<unsigned char>(c)) ? c : '_');
+  }
+  return name;
+}
+
+// Spins until the condition holds, returns false after timeout seconds.
+bool SpinUntil(const std::function<bool()>& condition, int timeout) {
+  auto start = std::chrono::steady_clock::now();
+  while (!condition()) {
+    if (timeout > 0 && std::chrono::steady_clock::now() - start >
+                           std::chrono::seconds(timeout)) {
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+template <typename T>
+void AppendBytes(const T& value, std::vector<uint8_t>* bytes) {
+  auto begin = reinterpret_cast<const uint8_t*>(&value);
+  bytes->insert(bytes->end(), begin, begin + sizeof(T));
+}
+
+template <typename T>
+T ReadBytes(const std::vector<uint8_t>& bytes, size_t* offset) {
+  PADDLE_ENFORCE_LE(
+      *offset + sizeof(T),
+      bytes.size(),
+      common::errors::InvalidArgument(
+          "The IPC handles of CudaIpcChannel are truncated, please make sure "
+          "both ends use the same num_slots."));
+  T value;
+  std::memcpy(&value, bytes.data() + *offset, sizeof(T));
+  *offset += sizeof(T);
+  return value;
+}
+
+gpuEvent_t CreateIpcEvent(gpuIpcEventHandle_t* handle) {
+  gpuEvent_t event;
+  PADDLE_ENFORCE_GPU_SUCCESS(gpuEventCreateWithFlags(
+      &event, gpuEventDisableTiming | gpuEventInterprocess));
+  PADDLE_ENFORCE_GPU_SUCCESS(gpuIpcGetEventHandle(handle, event));
+  return event;
+}
+
+}  // namespace
+
+struct CudaIpcChannel::Impl {
+  ~Impl();
+
+  SlotHeader* Header(int64_t seq) const {
+    return headers + (seq - 1) % num_slots;
+  }
+
+  uint8_t* Slot(int64_t seq) const {
+    return reinterpret_cast<uint8_t*>(buffer) +
+           (seq - 1) % num_slots * slot_bytes;
+  }
+
+  gpuEvent_t& Event(std::vector<gpuEvent_t>* events, int64_t seq) const {
+    return (*events)[(seq - 1) % num_slots];
+  }
+
+  void Release(int64_t seq, gpuStream_t stream);
+
+  std::string key;
+  Role role{Role::kSender};
+  phi::GPUPlace place;
+  size_t slot_bytes{0};
+  int num_slots{1};
+  int timeout{0};
+
+  std::string shm_name;
+  SlotHeader* headers{nullptr};
+  size_t shm_bytes{0};
+  // allocated by the sender and mapped by the receiver
+  void* buffer{nullptr};
+  // recorded by the sender when a slot is written
+  std::vector<gpuEvent_t> ready_events;
+  // recorded by the receiver when a slot is released
+  std::vector<gpuEvent_t> consumed_events;
+  // the sequence number of the next send or recv
+  int64_t next_seq{1};
+};
+
+void CudaIpcChannel::Impl::Release(int64_t seq, gpuStream_t stream) {
+  platform::CUDADeviceGuard guard(place.GetDeviceId());
+  PADDLE_ENFORCE_GPU_SUCCESS(
+      gpuEventRecord(Event(&consumed_events, seq), stream));
+  Header(seq)->consumed_seq.store(seq, std::memory_order_release);
+}
+
+CudaIpcChannel::Impl::~Impl() {
+  platform::CUDADeviceGuard guard(place.GetDeviceId());
+  if (role == Role::kSender && headers) {
+    // the receiver may still read the last slots
+    int64_t last_seq = next_seq - 1;
+    bool consumed = SpinUntil(
+        [&]() {
+          for (int64_t seq = std::max<int64_t>(last_seq - num_slots + 1, 1);
+               seq <= last_seq;
+               ++seq) {
+            if (Header(seq)->consumed_seq.load(std::memory_order_acquire) <
+                seq) {
+              return false;
+            }
+          }
+          return true;
+        },
+        timeout);
+    LOG_IF(WARNING, !consumed)
+        << "CudaIpcChannel " << key
+        << " is destroyed before the receiver releases all the slots.";
+  }
+  for (auto event : ready_events) {
+    gpuEventDestroy(event);
+  }
+  for (auto event : consumed_events) {
+    gpuEventDestroy(event);
+  }
+  if (buffer) {
+    if (role == Role::kSender) {
+      platform::RecordedGpuFree(
+          buffer, slot_bytes * num_slots, place.GetDeviceId());
+    } else {
+      gpuIpcCloseMemHandle(buffer);
+    }
+  }
+  if (headers) {
+    munmap(headers, shm_bytes);
+    if (role == Role::kSender) {
+      shm_unlink(shm_name.c_str());
+    }
+  }
+}
+
+CudaIpcChannel::CudaIpcChannel(
+    const std::string& key,
+    Role role,
+    const phi::GPUPlace& place,
+    size_t slot_bytes,
+    int num_slots,
+    const std::shared_ptr<phi::distributed::Store>& store)
+    : impl_(std::make_shared<Impl>()) {
+  PADDLE_ENFORCE_EQ(
+      slot_bytes > 0 && num_slots > 0,
+      true,
+      common::errors::InvalidArgument(
+          "The slot_bytes and num_slots of CudaIpcChannel should be positive, "
+          "but got %d and %d.",
+          slot_bytes,
+          num_slots));
+  PADDLE_ENFORCE_NOT_NULL(store,
+                          common::errors::InvalidArgument(
+                              "The store of CudaIpcChannel is null."));
+  impl_->key = key;
+  impl_->role = role;
+  impl_->place = place;
+  impl_->slot_bytes = slot_bytes;
+  impl_->num_slots = num_slots;
+  impl_->timeout = store->timeout();
+  impl_->shm_name = ShmName(key);
+  impl_->shm_bytes = sizeof(SlotHeader) * num_slots;
+
+  platform::CUDADeviceGuard guard(place.GetDeviceId());
+  const std::string sender_key = "ipc_channel/" + key + "/sender";
+  const std::string receiver_key = "ipc_channel/" + key + "/receiver";
+  auto map_headers = [this](int fd) {
+    void* addr = mmap(nullptr,
+                      impl_->shm_bytes,
+                      PROT_READ | PROT_WRITE,
+                      MAP_SHARED,
+                      fd,
+                      0);
+    close(fd);
+    PADDLE_ENFORCE_NE(addr,
+                      MAP_FAILED,
+                      common::errors::Unavailable(
+                          "Failed to map the shared memory %s of "
+                          "CudaIpcChannel.",
+                          impl_->shm_name));
+    impl_->headers = static_cast<SlotHeader*>(addr);
+  };
+
+  if (role == Role::kSender) {
+    PADDLE_ENFORCE_GPU_SUCCESS(platform::RecordedGpuMalloc(
+        &impl_->buffer, slot_bytes * num_slots, place.GetDeviceId()));
+    std::vector<uint8_t> handles;
+    gpuIpcMemHandle_t mem_handle;
+    PADDLE_ENFORCE_GPU_SUCCESS(gpuIpcGetMemHandle(&mem_handle, impl_->buffer));
+    AppendBytes(mem_handle, &handles);
+    for (int i = 0; i < num_slots; ++i) {
+      gpuIpcEventHandle_t event_handle;
+      impl_->ready_events.push_back(CreateIpcEvent(&event_handle));
+      AppendBytes(event_handle, &handles);
+    }
+
+    int fd = shm_open(
+        impl_->shm_name.c_str(), O_CREAT | O_RDWR | O_TRUNC, S_IRUSR | S_IWUSR);
+    PADDLE_ENFORCE_GE(fd,
+                      0,
+                      common::errors::Unavailable(
+                          "Failed to create the shared memory %s of "
+                          "CudaIpcChannel.",
+                          impl_->shm_name));
+    PADDLE_ENFORCE_EQ(
+        ftruncate(fd, static_cast<off_t>(impl_->shm_bytes)),
+        0,
+        common::errors::Unavailable(
+            "Failed to resize the shared memory %s of CudaIpcChannel.",
+            impl_->shm_name));
+    map_headers(fd);
+    for (int i = 0; i < num_slots; ++i) {
+      new (impl_->headers + i) SlotHeader();
+    }
+    store->set(sender_key, handles);
+
+    store->wait(receiver_key);
+    handles = store->get(receiver_key);
+    size_t offset = 0;
+    for (int i = 0; i < num_slots; ++i) {
+      auto event_handle = ReadBytes<gpuIpcEventHandle_t>(handles, &offset);
+      gpuEvent_t event;
+      PADDLE_ENFORCE_GPU_SUCCESS(gpuIpcOpenEventHandle(&event, event_handle));
+      impl_->consumed_events.push_back(event);
+    }
+  } else {
+    std::vector<uint8_t> handles;
+    for (int i = 0; i < num_slots; ++i) {
+      gpuIpcEventHandle_t event_handle;
+      impl_->consumed_events.push_back(CreateIpcEvent(&event_handle));
+      AppendBytes(event_handle, &handles);
+    }
+    store->set(receiver_key, handles);
+
+    store->wait(sender_key);
+    handles = store->get(sender_key);
+    size_t offset = 0;
+    auto mem_handle = ReadBytes<gpuIpcMemHandle_t>(handles, &offset);
+    PADDLE_ENFORCE_GPU_SUCCESS(gpuIpcOpenMemHandle(
+        &impl_->buffer, mem_handle, gpuIpcMemLazyEnablePeerAccess));
+    for (int i = 0; i < num_slots; ++i) {
+      auto event_handle = ReadBytes<gpuIpcEventHandle_t>(handles, &offset);
+      gpuEvent_t event;
+      PADDLE_ENFORCE_GPU_SUCCESS(gpuIpcOpenEventHandle(&event, event_handle));
+      impl_->ready_events.push_back(event);
+    }
+
+    // the sender creates the shared memory before it sets its handles
+    int fd = shm_open(impl_->shm_name.c_str(), O_RDWR, S_IRUSR | S_IWUSR);
+    PADDLE_ENFORCE_GE(fd,
+                      0,
+                      common::errors::Unavailable(
+                          "Failed to open the shared memory %s of "
+                          "CudaIpcChannel, please make sure both ends are "
+                          "on the same node.",
+                          impl_->shm_name));
+    map_headers(fd);
+  }
+  VLOG(3) << "CudaIpcChannel " << key << " is created with " << num_slots
+          << " slots of " << slot_bytes << " bytes";
+}
+
+CudaIpcChannel::~CudaIpcChannel() = default;
+
+void CudaIpcChannel::Send(const phi::DenseTensor& tensor, gpuStream_t stream) {
+  auto& impl = *impl_;
+  PADDLE_ENFORCE_EQ(impl.role == Role::kSender,
+                    true,
+                    common::errors::PreconditionNotMet(
+                        "Only the sender of CudaIpcChannel %s could send.",
+                        impl.key));
+  PADDLE_ENFORCE_EQ(tensor.place(),
+                    phi::Place(impl.place),
+                    common::errors::InvalidArgument(
+                        "The tensor sent by CudaIpcChannel should be on %s, "
+                        "but got %s.",
+                        impl.place,
+                        tensor.place()));
+  size_t bytes = tensor.numel() * phi::SizeOf(tensor.dtype());
+  PADDLE_ENFORCE_LE(bytes,
+                    impl.slot_bytes,
+                    common::errors::InvalidArgument(
+                        "The tensor of %d bytes is larger than the slot of "
+                        "CudaIpcChannel (%d bytes).",
+                        bytes,
+                        impl.slot_bytes));
+  PADDLE_ENFORCE_LE(tensor.dims().size(),
+                    kMaxSlotDims,
+                    common::errors::InvalidArgument(
+                        "The tensor sent by CudaIpcChannel should have at "
+                        "most %d dims.",
+                        kMaxSlotDims));
+  platform::CUDADeviceGuard guard(impl.place.GetDeviceId());
+  int64_t seq = impl.next_seq++;
+  SlotHeader* header = impl.Header(seq);
+  if (seq > impl.num_slots) {
+    // wait for the receiver to release the last use of the slot
+    int64_t last_seq = seq - impl.num_slots;
+    bool released = SpinUntil(
+        [&]() {
+          return header->consumed_seq.load(std::memory_order_acquire) >=
+                 last_seq;
+        },
+        impl.timeout);
+    PADDLE_ENFORCE_EQ(
+        released,
+        true,
+        common::errors::ExecutionTimeout(
+            "CudaIpcChannel %s times out waiting for the receiver to release "
+            "a slot.",
+            impl.key));
+    PADDLE_ENFORCE_GPU_SUCCESS(gpuStreamWaitEvent(
+        stream, impl.Event(&impl.consumed_events, seq), 0));
+  }
+
+  memory::Copy(impl.place,
+               impl.Slot(seq),
+               impl.place,
+               tensor.data(),
+               bytes,
+               stream);
+  header->dtype = static_cast<int32_t>(tensor.dtype());
+  header->num_dims = tensor.dims().size();
+  for (int i = 0; i < header->num_dims; ++i) {
+    header->dims[i] = tensor.dims()[i];
+  }
+  PADDLE_ENFORCE_GPU_SUCCESS(
+      gpuEventRecord(impl.Event(&impl.ready_events, seq), stream));
+  header->ready_seq.store(seq, std::memory_order_release);
+}
+
+phi::DenseTensor CudaIpcChannel::Recv(gpuStream_t stream) {
+  auto& impl = *impl_;
+  PADDLE_ENFORCE_EQ(impl.role == Role::kReceiver,
+                    true,
+                    common::errors::PreconditionNotMet(
+                        "Only the receiver of CudaIpcChannel %s could recv.",
+                        impl.key));
+  platform::CUDADeviceGuard guard(impl.place.GetDeviceId());
+  int64_t seq = impl.next_seq++;
+  SlotHeader* header = impl.Header(seq);
+  bool ready = SpinUntil(
+      [&]() {
+        return header->ready_seq.load(std::memory_order_acquire) >= seq;
+      },
+      impl.timeout);
+  PADDLE_ENFORCE_EQ(
+      ready,
+      true,
+      common::errors::ExecutionTimeout(
+          "CudaIpcChannel %s times out waiting for the sender.", impl.key));
+  PADDLE_ENFORCE_GPU_SUCCESS(
+      gpuStreamWaitEvent(stream, impl.Event(&impl.ready_events, seq), 0));
+
+  std::vector<int64_t> dims(header->dims, header->dims + header->num_dims);
+  phi::DenseTensorMeta meta(static_cast<phi::DataType>(header->dtype),
+                            common::make_ddim(dims));
+  size_t bytes = common::product(meta.dims) * phi::SizeOf(meta.dtype);
+  std::shared_ptr<Impl> holder = impl_;
+  auto allocation = std::make_shared<SlotAllocation>(
+      impl.Slot(seq), bytes, impl.place, [holder, seq, stream]() {
+        holder->Release(seq, stream);
+      });
+  return phi::DenseTensor(allocation, meta);
+}
+
+}  // namespace paddle::distributed
+
+#endif
@@ -0,0 +1,66 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _WIN32
+
+#include <memory>
+#include <string>
+
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/distributed/store/store.h"
+#include "paddle/phi/core/platform/device/gpu/gpu_types.h"
+
+namespace paddle {
+namespace distributed {
+
+// A one way channel between two processes on the same node, e.g. the
+// neighbouring pipeline stages, passing the device tensors without NCCL. The
+// sender owns a ring of slots in one device buffer mapped into the receiver
+// by CUDA IPC, and each slot is handed off by an interprocess event and a
+// sequence number in the shared memory of the node. The receiver reads the
+// slots in place, and the sender only blocks the host when the ring is full.
+class CudaIpcChannel {
+ public:
+  enum class Role { kSender, kReceiver };
+
+  // Both ends create the channel with the same key, the store exchanges the
+  // IPC handles and blocks until the other end is created.
+  CudaIpcChannel(const std::string& key,
+                 Role role,
+                 const phi::GPUPlace& place,
+                 size_t slot_bytes,
+                 int num_slots,
+                 const std::shared_ptr<phi::distributed::Store>& store);
+
+  ~CudaIpcChannel();
+
+  // Copies the tensor into the next slot after the kernels on the stream.
+  void Send(const phi::DenseTensor& tensor, gpuStream_t stream);
+
+  // Returns the tensor in the next slot, ready for the kernels on the stream.
+  // The slot goes back to the sender after the kernels enqueued on the stream
+  // before the tensor and its copies are released.
+  phi::DenseTensor Recv(gpuStream_t stream);
+
+ private:
+  struct Impl;
+  std::shared_ptr<Impl> impl_;
+};
+
+}  // namespace distributed
+}  // namespace paddle
+
+#endif
@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #include "paddle/fluid/distributed/collective/process_group_nccl.h"
+
+#include <unistd.h>
+
 #include "paddle/common/flags.h"
 #include "paddle/fluid/distributed/collective/common.h"
 #include "paddle/phi/api/lib/utils/allocator.h"
@@ -37,6 +40,8 @@ COMMON_DECLARE_bool(use_stream_safe_cuda_allocator);
 COMMON_DECLARE_bool(use_cuda_malloc_async_allocator);
 COMMON_DECLARE_bool(enable_async_trace);
 COMMON_DECLARE_bool(eager_communication_connection);
+COMMON_DECLARE_bool(nccl_hierarchical_allreduce);
+COMMON_DECLARE_int64(nccl_hierarchical_allreduce_max_bytes);
 
 // set this flag to `true` and recompile to enable dynamic checks
 constexpr bool FLAGS_enable_nccl_dynamic_check = false;
@@ -273,6 +278,7 @@ std::shared_ptr<ProcessGroup::Task> ProcessGroupNCCL::AllReduce(
   CheckTensorContiguous(in_tensor);
   CheckTensorContiguous(*out_tensor);
 
+  const bool use_hierarchical = UseHierarchicalAllReduce(in_tensor);
   return Collective(
       [&](phi::distributed::NCCLCommContext* comm_context, gpuStream_t stream) {
         VLOG(3) << "[ncclAllReduce] "
@@ -288,6 +294,11 @@ std::shared_ptr<ProcessGroup::Task> ProcessGroupNCCL::AllReduce(
                 << ", use_calc_stream: " << use_calc_stream << ", "
                 << GetGroupMessage();
 
+        if (use_hierarchical) {
+          HierarchicalAllReduce(
+              out_tensor, in_tensor, ToNCCLRedType(opts.reduce_op), stream);
+          return;
+        }
         comm_context->AllReduce(
             out_tensor, in_tensor, ToNCCLRedType(opts.reduce_op), stream);
       },
@@ -297,6 +308,118 @@ std::shared_ptr<ProcessGroup::Task> ProcessGroupNCCL::AllReduce(
       use_calc_stream);
 }
 
+bool ProcessGroupNCCL::UseHierarchicalAllReduce(
+    const phi::DenseTensor& tensor) {
+  if (!FLAGS_nccl_hierarchical_allreduce || is_coalescing_ ||
+      s_group_call_counter > 0) {
+    return false;
+  }
+  if (tensor.numel() * phi::SizeOf(tensor.dtype()) >
+      static_cast<size_t>(FLAGS_nccl_hierarchical_allreduce_max_bytes)) {
+    return false;
+  }
+  if (local_size_ < 0) {
+    CreateHierarchicalCommContext(tensor.place());
+  }
+  return local_size_ > 0 && tensor.numel() % local_size_ == 0;
+}
+
+void ProcessGroupNCCL::CreateHierarchicalCommContext(const Place& place) {
+  local_size_ = 0;
+
+  // exchange the host names through the store to find the ranks per node
+  char hostname[256] = {0};
+  gethostname(hostname, sizeof(hostname) - 1);
+  const std::string host(hostname);
+  const std::string prefix = "nccl_hierarchical/" + std::to_string(gid_);
+  store_->set(prefix + "/host/" + std::to_string(rank_),
+              std::vector<uint8_t>(host.begin(), host.end()));
+  std::vector<std::string> hosts(size_);
+  for (int rank = 0; rank < size_; ++rank) {
+    auto value = store_->get(prefix + "/host/" + std::to_string(rank));
+    hosts[rank] = std::string(value.begin(), value.end());
+  }
+
+  int local_size = 1;
+  while (local_size < size_ && hosts[local_size] == hosts[0]) {
+    ++local_size;
+  }
+  bool supported =
+      local_size > 1 && local_size < size_ && size_ % local_size == 0;
+  for (int rank = 0; supported && rank < size_; ++rank) {
+    int first_rank = rank / local_size * local_size;
+    supported = hosts[rank] == hosts[first_rank] &&
+                (rank == first_rank || rank == 0 ||
+                 hosts[first_rank] != hosts[first_rank - 1]);
+  }
+  if (!supported) {
+    LOG(INFO) << "ProcessGroupNCCL gid " << gid_
+              << " falls back to flat all-reduce, since its ranks are not "
+                 "placed as the same number of contiguous ranks per node";
+    return;
+  }
+
+  const int node_id = rank_ / local_size;
+  const int local_rank = rank_ % local_size;
+  intra_node_comm_key_ = prefix + "/intra/" + std::to_string(node_id);
+  inter_node_comm_key_ = prefix + "/inter/" + std::to_string(local_rank);
+
+  platform::CUDADeviceGuard cuda_guard(place);
+  NCCL_CHECK(phi::dynload::ncclGroupStart());
+  phi::distributed::CommContextManager::CreateNCCLCommContext(
+      store_,
+      intra_node_comm_key_,
+      local_rank,
+      local_size,
+      "",
+      nullptr,
+      nccl_comm_init_option_);
+  NCCL_CHECK(phi::dynload::ncclGroupEnd());
+
+  NCCL_CHECK(phi::dynload::ncclGroupStart());
+  phi::distributed::CommContextManager::CreateNCCLCommContext(
+      store_,
+      inter_node_comm_key_,
+      node_id,
+      size_ / local_size,
+      "",
+      nullptr,
+      nccl_comm_init_option_);
+  NCCL_CHECK(phi::dynload::ncclGroupEnd());
+
+  local_size_ = local_size;
+  local_rank_ = local_rank;
+  LOG(INFO) << "ProcessGroupNCCL gid " << gid_
+            << " enables hierarchical all-reduce with " << size_ / local_size
+            << " nodes and " << local_size << " ranks per node";
+}
+
+void ProcessGroupNCCL::HierarchicalAllReduce(phi::DenseTensor* out_tensor,
+                                             const phi::DenseTensor& in_tensor,
+                                             ncclRedOp_t reduce_type,
+                                             gpuStream_t stream) {
+  const int64_t numel = in_tensor.numel();
+  const int64_t chunk_numel = numel / local_size_;
+  VLOG(3) << "[HierarchicalAllReduce] count: " << numel
+          << ", chunk count: " << chunk_numel << ", local_rank: " << local_rank_
+          << ", local_size: " << local_size_ << ", " << GetGroupMessage();
+
+  phi::DenseTensor flat_in;
+  flat_in.ShareDataWith(in_tensor).Resize({numel});
+  phi::DenseTensor flat_out;
+  flat_out.ShareDataWith(*out_tensor).Resize({numel});
+  // the chunk of this rank lives in place in the output, as required by the
+  // in-place all-gather
+  phi::DenseTensor chunk = flat_out.Slice(local_rank_ * chunk_numel,
+                                          (local_rank_ + 1) * chunk_numel);
+
+  auto* intra_node_comm = GetCommContext(&intra_node_comm_key_);
+  auto* inter_node_comm = GetCommContext(&inter_node_comm_key_);
+  intra_node_comm->ReduceScatter(&chunk, flat_in, reduce_type, stream);
+  inter_node_comm->AllReduce(&chunk, chunk, reduce_type, stream);
+  intra_node_comm->AllGather(&flat_out, chunk, stream);
+}
+
 std::shared_ptr<ProcessGroup::Task> ProcessGroupNCCL::AllToAll(
     phi::DenseTensor* out_tensor,
     const phi::DenseTensor& in_tensor,
@@ -949,6 +1072,7 @@ std::shared_ptr<ProcessGroup::Task> ProcessGroupNCCL::Collective(
                                                          nccl_stream,
                                                          comm_type,
                                                          pg_timeout_);
+    comm_task->SetBytes(tensor.numel() * phi::SizeOf(tensor.dtype()));
     comm_task->StartRecord();
     fn(nccl_comm_ctx, nccl_stream);
     comm_task->EndRecord();
@@ -1071,6 +1195,7 @@ std::shared_ptr<ProcessGroup::Task> ProcessGroupNCCL::Point2Point(
   if (!FLAGS_enable_async_trace) {
     fn(nccl_comm_ctx, nccl_stream, p2p_target_rank);
   } else {
+    comm_task->SetBytes(tensor.numel() * phi::SizeOf(tensor.dtype()));
     comm_task->StartRecord();
     fn(nccl_comm_ctx, nccl_stream, p2p_target_rank);
     comm_task->EndRecord();
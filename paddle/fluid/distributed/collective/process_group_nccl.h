@@ -223,6 +223,15 @@ class ProcessGroupNCCL final : public ProcessGroupWithStream {
   phi::distributed::NCCLCommContext* GetCommContext(
       const std::string* key = nullptr);
 
+  bool UseHierarchicalAllReduce(const phi::DenseTensor& tensor);
+
+  void CreateHierarchicalCommContext(const Place& place);
+
+  void HierarchicalAllReduce(phi::DenseTensor* out_tensor,
+                             const phi::DenseTensor& in_tensor,
+                             ncclRedOp_t reduce_type,
+                             gpuStream_t stream);
+
   void EraseTensorHolders() {
     for (const auto& allocation_stream : allocation_stream_pairs_) {
       auto holder_ptr = allocation_stream.first.lock();
@@ -274,6 +283,13 @@ class ProcessGroupNCCL final : public ProcessGroupWithStream {
   bool is_coalescing_{false};
   std::vector<std::shared_ptr<phi::DenseTensor>> colaescing_tensors_;
   std::vector<std::string> colaescing_place_keys_;
+
+  // For hierarchical all-reduce, -1 means the sub communicators are not
+  // created yet and 0 means the topology is not supported
+  int local_size_{-1};
+  int local_rank_{0};
+  std::string intra_node_comm_key_;
+  std::string inter_node_comm_key_;
 };
 
 }  //  namespace distributed
@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #include "paddle/fluid/distributed/collective/reducer.h"
+
+#include <cmath>
+
 #include "paddle/common/flags.h"
 #include "paddle/fluid/pir/dialect/operator/ir/ir_tensor.h"
 #include "paddle/phi/api/lib/data_transform.h"
@@ -21,6 +24,10 @@
 
 PD_DECLARE_bool(use_stream_safe_cuda_allocator);
 COMMON_DECLARE_string(allocator_strategy);
+COMMON_DECLARE_bool(eager_reducer_rebuild_groups);
+COMMON_DECLARE_string(eager_reducer_grad_compress);
+COMMON_DECLARE_double(eager_reducer_topk_ratio);
+COMMON_DECLARE_int32(eager_reducer_powersgd_rank);
 
 namespace paddle {
 namespace distributed {
@@ -479,6 +486,150 @@ void EagerGroup::SplitTensors(const phi::DeviceContext &context) {
   }
 }
 
+static std::shared_ptr<ProcessGroup::Task> SumAllReduce(
+    const Tensor &tensor, ProcessGroup *process_group) {
+  distributed::AllreduceOptions opts;
+  opts.reduce_op = ReduceOp::SUM;
+  std::vector<phi::DenseTensor> in_out = {
+      *std::dynamic_pointer_cast<phi::DenseTensor>(tensor.impl())};
+  return process_group->AllReduce(in_out, in_out, opts);
+}
+
+static std::shared_ptr<ProcessGroup::Task> AllGatherTensor(
+    const Tensor &src, const Tensor &dst, ProcessGroup *process_group) {
+  std::vector<phi::DenseTensor> in = {
+      *std::dynamic_pointer_cast<phi::DenseTensor>(src.impl())};
+  std::vector<phi::DenseTensor> out = {
+      *std::dynamic_pointer_cast<phi::DenseTensor>(dst.impl())};
+  return process_group->AllGather(in, out);
+}
+
+std::shared_ptr<ProcessGroup::Task> TopKGradCompressor::AllReduce(
+    Tensor *contents, ProcessGroup *process_group) {
+  const int64_t nranks = process_group->GetSize();
+  const auto &place = contents->place();
+  if (!residual_.initialized()) {
+    residual_ = paddle::experimental::full_like(*contents, 0);
+  }
+  Tensor corrected = paddle::experimental::add(*contents, residual_);
+  const int64_t numel = corrected.numel();
+  const int64_t k = std::max<int64_t>(1, numel * ratio_);
+
+  auto indices = std::get<1>(paddle::experimental::topk(
+      paddle::experimental::abs(corrected), k, 0, true, false));
+  auto values = paddle::experimental::gather(corrected, indices);
+  // the dropped part is sent in the next steps
+  residual_ = paddle::experimental::scatter(
+      corrected, indices, paddle::experimental::full_like(values, 0), true);
+
+  // every rank sends k elements, so the index and value pairs are gathered
+  // like the sparse gradients with the same number of rows
+  Tensor all_indices = paddle::experimental::empty(
+      IntArray({k * nranks}), DataType::INT64, place);
+  Tensor all_values = paddle::experimental::empty(
+      IntArray({k * nranks}), values.dtype(), place);
+  AllGatherTensor(indices, all_indices, process_group)->Synchronize();
+  auto task = AllGatherTensor(values, all_values, process_group);
+  task->Synchronize();
+
+  *contents = paddle::experimental::scatter(
+      paddle::experimental::full_like(*contents, 0),
+      all_indices,
+      all_values,
+      false);
+  paddle::experimental::scale_(*contents, 1.0 / nranks, 0.0, false);
+  return task;
+}
+
+std::shared_ptr<ProcessGroup::Task> PowerSGDGradCompressor::AllReduce(
+    Tensor *contents, ProcessGroup *process_group) {
+  const int64_t nranks = process_group->GetSize();
+  const auto &place = contents->place();
+  const auto dtype = contents->dtype();
+  const int64_t numel = contents->numel();
+  const int64_t padded_numel = rows_ * cols_;
+
+  Tensor flat = paddle::experimental::cast(*contents, DataType::FLOAT32);
+  if (padded_numel > numel) {
+    flat = paddle::experimental::concat(
+        {flat,
+         paddle::experimental::full(IntArray({padded_numel - numel}),
+                                    0,
+                                    DataType::FLOAT32,
+                                    place)},
+        0);
+  }
+  Tensor matrix = paddle::experimental::reshape(flat, IntArray({rows_, cols_}));
+  if (!residual_.initialized()) {
+    residual_ = paddle::experimental::full_like(matrix, 0);
+    // all ranks use the same seed to start from the same Q
+    q_ = paddle::experimental::gaussian(
+        IntArray({cols_, rank_}), 0.0, 1.0, 1, DataType::FLOAT32, place);
+  }
+  matrix = paddle::experimental::add(matrix, residual_);
+
+  Tensor p = paddle::experimental::matmul(matrix, q_);
+  SumAllReduce(p, process_group)->Synchronize();
+  p = std::get<0>(paddle::experimental::qr(p, "reduced"));
+  q_ = paddle::experimental::matmul(matrix, p, true, false);
+  auto task = SumAllReduce(q_, process_group);
+  task->Synchronize();
+
+  Tensor approx = paddle::experimental::matmul(p, q_, false, true);
+  paddle::experimental::scale_(approx, 1.0 / nranks, 0.0, false);
+  residual_ = paddle::experimental::subtract(matrix, approx);
+
+  Tensor out = paddle::experimental::reshape(approx, IntArray({padded_numel}));
+  if (padded_numel > numel) {
+    out = paddle::experimental::slice(
+        out, {0}, IntArray({0}), IntArray({numel}), {1}, {});
+  }
+  *contents = paddle::experimental::cast(out, dtype);
+  return task;
+}
+
+std::shared_ptr<GradCompressor> CreateGradCompressor(int64_t numel,
+                                                     int64_t nranks) {
+  if (FLAGS_eager_reducer_grad_compress.empty() || nranks <= 1) {
+    return nullptr;
+  }
+  if (FLAGS_eager_reducer_grad_compress == "topk") {
+    PADDLE_ENFORCE_EQ(
+        FLAGS_eager_reducer_topk_ratio > 0 &&
+            FLAGS_eager_reducer_topk_ratio < 1,
+        true,
+        common::errors::InvalidArgument(
+            "FLAGS_eager_reducer_topk_ratio should be in (0, 1), but it's %f",
+            FLAGS_eager_reducer_topk_ratio));
+    const int64_t k =
+        std::max<int64_t>(1, numel * FLAGS_eager_reducer_topk_ratio);
+    if (k * nranks >= numel) {
+      return nullptr;
+    }
+    return std::make_shared<TopKGradCompressor>(
+        FLAGS_eager_reducer_topk_ratio);
+  }
+  if (FLAGS_eager_reducer_grad_compress == "powersgd") {
+    const int64_t rank = FLAGS_eager_reducer_powersgd_rank;
+    PADDLE_ENFORCE_GT(rank,
+                      0,
+                      common::errors::InvalidArgument(
+                          "FLAGS_eager_reducer_powersgd_rank should be "
+                          "greater than 0, but it's %d",
+                          rank));
+    const auto cols = static_cast<int64_t>(std::ceil(std::sqrt(numel)));
+    const int64_t rows = (numel + cols - 1) / cols;
+    if ((rows + cols) * rank >= numel) {
+      return nullptr;
+    }
+    return std::make_shared<PowerSGDGradCompressor>(rows, cols, rank);
+  }
+  PADDLE_THROW(common::errors::InvalidArgument(
+      "FLAGS_eager_reducer_grad_compress should be empty, topk or powersgd, "
+      "but it's %s",
+      FLAGS_eager_reducer_grad_compress));
+}
+
 EagerReducer::EagerReducer(
     const std::vector<Tensor> tensors,
     const std::vector<std::vector<size_t>> &group_indices,
@@ -576,6 +727,7 @@ void EagerReducer::InitializeGroups(
     } else {
       // process the dense gradient.
       InitializeDenseGroups(tensor_indices_, &group);
+      group.compressor_ = CreateGradCompressor(group.all_length_, nranks_);
     }
 
     // map tensors to this group by VariableLocator
@@ -695,6 +847,11 @@ void EagerReducer::PrepareForBackward(const std::vector<Tensor> &outputs) {
   VLOG(3) << "after forward, then reset count for backward.";
   grad_need_hooks_ = true;
 
+  if (FLAGS_eager_reducer_rebuild_groups && !has_rebuilt_groups_ &&
+      !rebuilt_var_indices_.empty()) {
+    RebuildGroups();
+  }
+
   next_group_ = 0;
   std::for_each(groups_.begin(), groups_.end(), [](EagerGroup &group) {
     group.pending_ = group.tensor_indices_.size();
@@ -785,6 +942,10 @@ void EagerReducer::AddDistHook(size_t var_index) {
 
   local_used_vars_[var_index] = 1;
 
+  if (FLAGS_eager_reducer_rebuild_groups && !has_rebuilt_groups_) {
+    rebuilt_var_indices_.push_back(var_index);
+  }
+
   if (!has_marked_unused_vars_) {
     has_marked_unused_vars_ = true;
     for (const auto unused_index : unused_vars_) {
@@ -990,6 +1151,52 @@ bool EagerReducer::HasGrad(size_t var_index) {
   }
 }
 
+void EagerReducer::RebuildGroups() {
+  has_rebuilt_groups_ = true;
+
+  // the vars which got no grad in the first backward are put at the end
+  std::vector<bool> is_recorded(tensors_.size(), false);
+  for (const auto var_index : rebuilt_var_indices_) {
+    is_recorded[var_index] = true;
+  }
+  for (size_t var_index = 0; var_index < tensors_.size(); ++var_index) {
+    if (!is_recorded[var_index]) {
+      rebuilt_var_indices_.push_back(var_index);
+    }
+  }
+
+  // the ready order may differ between ranks, so all ranks follow rank 0
+  const auto *dev_ctx = phi::DeviceContextPool::Instance().Get(inner_place_);
+  phi::DenseTensor order_tensor;
+  framework::TensorFromVector<int64_t>(
+      rebuilt_var_indices_, *dev_ctx, &order_tensor);
+
+  distributed::BroadcastOptions opts;
+  opts.source_rank = 0;
+  std::vector<phi::DenseTensor> in_out = {order_tensor};
+  process_group_->Broadcast(in_out, in_out, opts)->Synchronize();
+
+  framework::TensorToVector<int64_t>(
+      in_out[0], *dev_ctx, &rebuilt_var_indices_);
+  dev_ctx->Wait();
+
+  std::vector<Tensor> ordered_tensors;
+  ordered_tensors.reserve(tensors_.size());
+  for (const auto var_index : rebuilt_var_indices_) {
+    ordered_tensors.push_back(tensors_[var_index]);
+  }
+  group_indices_ = Eager_AssignGroupBySize(ordered_tensors,
+                                           is_sparse_gradient_,
+                                           group_size_limits_,
+                                           rebuilt_var_indices_);
+  InitializeGroups(group_indices_);
+  rebuilt_var_indices_.clear();
+
+  VLOG(3) << "[Rank " << process_group_->GetRank() << "]: "
+          << "Rebuild " << groups_.size()
+          << " groups by the ready order of gradients.";
+}
+
 void EagerReducer::ProcessUnusedDenseVars() {
   // The calculation stream must be used here to
   // avoid conflicts with communication.
@@ -1097,6 +1304,17 @@ void EagerReducer::FusedAllReduceSchedule(EagerGroup *group,
   // concat tensors
   group->ConcatTensors(inner_place_);
 
+  if (group->compressor_) {
+    group->task = group->compressor_->AllReduce(&group->dense_contents_,
+                                                process_group_.get());
+    if (IsStreamSafeAllocator()) {
+      // the contents are decompressed on the calculation stream
+      auto *default_ctx = phi::DeviceContextPool::Instance().Get(inner_place_);
+      group->SplitTensors(*default_ctx);
+    }
+    return;
+  }
+
   // div nranks
   paddle::experimental::scale_(
       group->dense_contents_, 1.0 / nranks_, 0.0, false);  // NOLINT
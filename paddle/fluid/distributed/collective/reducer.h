@@ -15,6 +15,7 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <vector>
 
 #include "paddle/fluid/distributed/collective/process_group.h"
@@ -44,6 +45,56 @@ std::vector<std::vector<size_t>> Eager_AssignGroupBySize(
     const std::vector<size_t> &group_size_limits,
     const std::vector<int64_t> &tensor_indices = {});
 
+// Replaces the all-reduce of the flattened dense gradient of a group. The
+// state between steps, e.g. the compression error, lives in the compressor,
+// so a compressor is owned by one group.
+class GradCompressor {
+ public:
+  virtual ~GradCompressor() {}
+
+  // Sets contents to the mean of contents over all ranks, returns the task
+  // of the last communication.
+  virtual std::shared_ptr<ProcessGroup::Task> AllReduce(
+      Tensor *contents, ProcessGroup *process_group) = 0;
+};
+
+// Only the largest ratio of the gradient is all-gathered as index and value
+// pairs, the rest is accumulated for the next step.
+class TopKGradCompressor : public GradCompressor {
+ public:
+  explicit TopKGradCompressor(double ratio) : ratio_(ratio) {}
+
+  std::shared_ptr<ProcessGroup::Task> AllReduce(
+      Tensor *contents, ProcessGroup *process_group) override;
+
+ private:
+  double ratio_;
+  Tensor residual_;
+};
+
+// The gradient viewed as a matrix M is approximated by P * Q^T with one
+// power iteration, where Q is kept from the previous step.
+class PowerSGDGradCompressor : public GradCompressor {
+ public:
+  PowerSGDGradCompressor(int64_t rows, int64_t cols, int64_t rank)
+      : rows_(rows), cols_(cols), rank_(rank) {}
+
+  std::shared_ptr<ProcessGroup::Task> AllReduce(
+      Tensor *contents, ProcessGroup *process_group) override;
+
+ private:
+  int64_t rows_;
+  int64_t cols_;
+  int64_t rank_;
+  Tensor residual_;
+  Tensor q_;
+};
+
+// Returns nullptr if FLAGS_eager_reducer_grad_compress is not set or the
+// compression does not reduce the communication of the group.
+std::shared_ptr<GradCompressor> CreateGradCompressor(int64_t numel,
+                                                     int64_t nranks);
+
 class EagerGroup {
  public:
   Tensor dense_contents_;
@@ -69,6 +120,9 @@ class EagerGroup {
   // help to sync
   std::shared_ptr<ProcessGroup::Task> task;
 
+  // not null if the dense gradient is compressed before communication
+  std::shared_ptr<GradCompressor> compressor_;
+
   // context is used to select the stream for concat
   void ConcatTensors(const phi::Place &);
 
@@ -111,6 +165,7 @@ class EagerReducer {
   void FinalizeBackward();
   void TraverseBackwardGraph(const std::vector<Tensor> &outputs);
   void ProcessUnusedDenseVars();
+  void RebuildGroups();
   bool HasGrad(size_t var_index);
 
  private:
@@ -139,6 +194,11 @@ class EagerReducer {
   bool find_unused_vars_once_{true};
   bool groups_need_finalize_{false};
   Tensor global_used_vars_;
+
+  // The order in which gradients become ready in the first backward, used
+  // to rebuild the groups when FLAGS_eager_reducer_rebuild_groups is set
+  std::vector<int64_t> rebuilt_var_indices_;
+  bool has_rebuilt_groups_{false};
 };
 
 }  //  namespace distributed
@@ -0,0 +1,348 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/collective/sharding_engine.h"
+
+namespace paddle {
+namespace distributed {
+
+static phi::DenseTensor *GetDenseTensor(const Tensor &tensor) {
+  return std::dynamic_pointer_cast<phi::DenseTensor>(tensor.impl()).get();
+}
+
+// Flattens the tensors into one buffer padded with zeros.
+static Tensor FlattenTensors(const std::vector<Tensor> &tensors,
+                             int64_t numel,
+                             int64_t padded_numel,
+                             phi::DataType dtype,
+                             const phi::Place &place) {
+  std::vector<Tensor> flat;
+  flat.reserve(tensors.size() + 1);
+  for (const auto &tensor : tensors) {
+    flat.push_back(paddle::experimental::reshape(tensor, IntArray({-1})));
+  }
+  if (padded_numel > numel) {
+    flat.push_back(paddle::experimental::full(
+        IntArray({padded_numel - numel}), 0, dtype, place));
+  }
+  return paddle::experimental::concat(flat, 0);
+}
+
+EagerShardingEngine::EagerShardingEngine(
+    const std::vector<std::vector<Tensor>> &layer_params,
+    std::shared_ptr<ProcessGroup> process_group,
+    size_t prefetch_layers)
+    : process_group_(process_group), prefetch_layers_(prefetch_layers) {
+  PADDLE_ENFORCE_GT(layer_params.size(),
+                    0,
+                    common::errors::InvalidArgument(
+                        "The sharding engine should have a layer at least."));
+  nranks_ = process_group_->GetSize();
+  rank_ = process_group_->GetRank();
+
+  layers_.resize(layer_params.size());
+  for (size_t l = 0; l < layer_params.size(); ++l) {
+    auto &layer = layers_[l];
+    layer.params = layer_params[l];
+    PADDLE_ENFORCE_GT(layer.params.size(),
+                      0,
+                      common::errors::InvalidArgument(
+                          "The layer %d of the sharding engine has no "
+                          "parameter.",
+                          l));
+    if (l == 0) {
+      place_ = layer.params.front().place();
+    }
+    layer.dtype = layer.params.front().dtype();
+
+    int64_t numel = 0;
+    for (const auto &param : layer.params) {
+      PADDLE_ENFORCE_EQ(
+          param.is_dense_tensor() && param.initialized(),
+          true,
+          common::errors::InvalidArgument(
+              "The parameters of the sharding engine should be initialized "
+              "dense tensors, but %s isn't.",
+              param.name()));
+      PADDLE_ENFORCE_EQ(
+          param.dtype() == layer.dtype && param.place() == place_,
+          true,
+          common::errors::InvalidArgument(
+              "The parameters of a layer of the sharding engine should be in "
+              "the same dtype and on the same place, but %s isn't.",
+              param.name()));
+      layer.offsets.push_back(numel);
+      layer.numels.push_back(param.numel());
+      numel += param.numel();
+    }
+    layer.shard_numel = (numel + nranks_ - 1) / nranks_;
+    layer.padded_numel = layer.shard_numel * nranks_;
+
+    // keep a copy of the slice so that the flattened buffer is freed
+    Tensor contents = FlattenTensors(
+        layer.params, numel, layer.padded_numel, layer.dtype, place_);
+    layer.param_shard = paddle::experimental::assign(
+        paddle::experimental::slice(contents,
+                                    {0},
+                                    IntArray({rank_ * layer.shard_numel}),
+                                    IntArray({(rank_ + 1) * layer.shard_numel}),
+                                    {1},
+                                    {}));
+    layer.gathered = true;
+    Release(l);
+
+    for (size_t i = 0; i < layer.params.size(); ++i) {
+      auto *autograd_meta =
+          static_cast<egr::AutogradMeta *>(layer.params[i].get_autograd_meta());
+      PADDLE_ENFORCE_NOT_NULL(
+          autograd_meta,
+          common::errors::InvalidArgument(
+              "The parameter %s of the sharding engine has no autograd meta.",
+              layer.params[i].name()));
+      const auto &accumulation_grad_node =
+          std::dynamic_pointer_cast<egr::GradNodeAccumulation>(
+              autograd_meta->GetMutableGradNode());
+      PADDLE_ENFORCE_NOT_NULL(
+          accumulation_grad_node,
+          common::errors::Fatal("The parameter %s should be a leaf tensor "
+                                "with the grad node GradNodeAccumulation.",
+                                layer.params[i].name()));
+      auto reduce_hook = [=]() -> void { this->MarkGradReady(l, i); };
+      accumulation_grad_node->RegisterReduceHook(
+          std::make_shared<egr::CppVoidHook>(reduce_hook));
+    }
+    layer.pending_grads = layer.params.size();
+  }
+}
+
+void EagerShardingEngine::PreForward(size_t layer) {
+  WaitGathered(layer);
+  for (size_t l = layer + 1;
+       l <= layer + prefetch_layers_ && l < layers_.size();
+       ++l) {
+    Gather(l);
+  }
+}
+
+void EagerShardingEngine::PostForward(size_t layer) {
+  // the last layer is the first one of the backward
+  if (layer + 1 < layers_.size()) {
+    Release(layer);
+  }
+}
+
+void EagerShardingEngine::PreBackward(size_t layer) {
+  WaitGathered(layer);
+  for (size_t step = 1; step <= prefetch_layers_ && step <= layer; ++step) {
+    Gather(layer - step);
+  }
+}
+
+void EagerShardingEngine::FinalizeBackward() {
+  // the layers with unused parameters, which are reduced as zeros
+  for (size_t l = 0; l < layers_.size(); ++l) {
+    auto &layer = layers_[l];
+    if (layer.pending_grads > 0 && layer.pending_grads < layer.params.size()) {
+      ReduceScatter(l);
+    }
+  }
+  for (size_t l = 0; l < layers_.size(); ++l) {
+    auto &layer = layers_[l];
+    if (layer.scatter_task) {
+      layer.scatter_task->Wait();
+      layer.scatter_task.reset();
+      if (layer.grad_shard.initialized()) {
+        layer.grad_shard =
+            paddle::experimental::add(layer.grad_shard, layer.scattered_grads);
+      } else {
+        layer.grad_shard = layer.scattered_grads;
+      }
+      layer.scattered_grads.reset();
+      layer.grad_buffer.reset();
+    }
+    layer.pending_grads = layer.params.size();
+    Release(l);
+  }
+}
+
+void EagerShardingEngine::ReleaseAll() {
+  for (size_t l = 0; l < layers_.size(); ++l) {
+    Release(l);
+  }
+}
+
+const Tensor &EagerShardingEngine::ParamShard(size_t layer) const {
+  PADDLE_ENFORCE_LT(layer,
+                    layers_.size(),
+                    common::errors::OutOfRange(
+                        "The layer %d is out of the %d layers of the "
+                        "sharding engine.",
+                        layer,
+                        layers_.size()));
+  return layers_[layer].param_shard;
+}
+
+const Tensor &EagerShardingEngine::GradShard(size_t layer) const {
+  PADDLE_ENFORCE_LT(layer,
+                    layers_.size(),
+                    common::errors::OutOfRange(
+                        "The layer %d is out of the %d layers of the "
+                        "sharding engine.",
+                        layer,
+                        layers_.size()));
+  return layers_[layer].grad_shard;
+}
+
+void EagerShardingEngine::ClearGradShards() {
+  for (auto &layer : layers_) {
+    layer.grad_shard.reset();
+  }
+}
+
+void EagerShardingEngine::Gather(size_t layer) {
+  auto &sharded = layers_[layer];
+  if (sharded.gathered || sharded.gather_task) {
+    return;
+  }
+  VLOG(3) << "sharding layer [" << layer << "] start all_gather.";
+  sharded.full_params = paddle::experimental::empty(
+      IntArray({sharded.padded_numel}), sharded.dtype, place_);
+  // the communication stream waits the updates of the shard on the
+  // calculation stream, and the gathered buffer could reuse the memory of
+  // the released layers
+  sharded.gather_task =
+      process_group_->AllGather(GetDenseTensor(sharded.full_params),
+                                *GetDenseTensor(sharded.param_shard),
+                                /*offset=*/0,
+                                /*numel=*/-1,
+                                /*sync_op=*/false,
+                                /*use_calc_stream=*/false);
+}
+
+void EagerShardingEngine::WaitGathered(size_t layer) {
+  PADDLE_ENFORCE_LT(layer,
+                    layers_.size(),
+                    common::errors::OutOfRange(
+                        "The layer %d is out of the %d layers of the "
+                        "sharding engine.",
+                        layer,
+                        layers_.size()));
+  auto &sharded = layers_[layer];
+  Gather(layer);
+  if (sharded.gather_task) {
+    sharded.gather_task->Wait();
+    sharded.gather_task.reset();
+  }
+  if (sharded.gathered) {
+    return;
+  }
+  // the parameters share the gathered buffer in place, so the tensors saved
+  // by the autograd for the backward see the gathered data as well
+  auto *full = GetDenseTensor(sharded.full_params);
+  for (size_t i = 0; i < sharded.params.size(); ++i) {
+    auto *param = GetDenseTensor(sharded.params[i]);
+    auto dims = param->dims();
+    param->ShareDataWith(full->Slice(
+        sharded.offsets[i], sharded.offsets[i] + sharded.numels[i]));
+    param->Resize(dims);
+  }
+  sharded.gathered = true;
+}
+
+void EagerShardingEngine::Release(size_t layer) {
+  auto &sharded = layers_[layer];
+  if (sharded.gather_task) {
+    sharded.gather_task->Wait();
+    sharded.gather_task.reset();
+  }
+  if (!sharded.gathered && !sharded.full_params.initialized()) {
+    return;
+  }
+  VLOG(3) << "sharding layer [" << layer << "] release the parameters.";
+  for (auto &param : sharded.params) {
+    GetDenseTensor(param)->clear();
+  }
+  sharded.full_params.reset();
+  sharded.gathered = false;
+}
+
+void EagerShardingEngine::ReduceScatter(size_t layer) {
+  auto &sharded = layers_[layer];
+  VLOG(3) << "sharding layer [" << layer << "] start reduce_scatter.";
+
+  std::vector<Tensor> grads;
+  grads.reserve(sharded.params.size());
+  for (size_t i = 0; i < sharded.params.size(); ++i) {
+    auto *grad = egr::EagerUtils::mutable_grad(sharded.params[i]);
+    if (grad && grad->initialized()) {
+      PADDLE_ENFORCE_EQ(grad->is_dense_tensor() &&
+                            grad->dtype() == sharded.dtype,
+                        true,
+                        common::errors::InvalidArgument(
+                            "The gradient of %s should be a dense tensor in "
+                            "the dtype of the parameter.",
+                            sharded.params[i].name()));
+      grads.push_back(*grad);
+    } else {
+      grads.push_back(paddle::experimental::full(
+          IntArray({sharded.numels[i]}), 0, sharded.dtype, place_));
+    }
+  }
+  int64_t numel = sharded.offsets.back() + sharded.numels.back();
+  sharded.grad_buffer = FlattenTensors(
+      grads, numel, sharded.padded_numel, sharded.dtype, place_);
+  paddle::experimental::scale_(
+      sharded.grad_buffer, 1.0 / nranks_, 0.0, false);  // NOLINT
+
+  // the full gradients are freed, only the shards are kept
+  grads.clear();
+  for (auto &param : sharded.params) {
+    auto *grad = egr::EagerUtils::mutable_grad(param);
+    if (grad) {
+      grad->reset();
+    }
+  }
+
+  sharded.scattered_grads = paddle::experimental::empty(
+      IntArray({sharded.shard_numel}), sharded.dtype, place_);
+  ReduceScatterOptions opts;
+  opts.reduce_op = ReduceOp::SUM;
+  sharded.scatter_task =
+      process_group_->ReduceScatter(GetDenseTensor(sharded.scattered_grads),
+                                    *GetDenseTensor(sharded.grad_buffer),
+                                    opts,
+                                    /*sync_op=*/false,
+                                    /*use_calc_stream=*/false);
+  sharded.pending_grads = 0;
+}
+
+void EagerShardingEngine::MarkGradReady(size_t layer, size_t index) {
+  auto &sharded = layers_[layer];
+  PADDLE_ENFORCE_GT(sharded.pending_grads,
+                    0,
+                    common::errors::PreconditionNotMet(
+                        "The gradient of %s is ready twice in one backward, "
+                        "FinalizeBackward should be called after the "
+                        "backward.",
+                        sharded.params[index].name()));
+  if (--sharded.pending_grads > 0) {
+    return;
+  }
+  // the backward of the layer is done
+  ReduceScatter(layer);
+  Release(layer);
+}
+
+}  //  namespace distributed
+}  //  namespace paddle
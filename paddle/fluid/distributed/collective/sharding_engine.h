@@ -0,0 +1,103 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "paddle/fluid/distributed/collective/process_group.h"
+#include "paddle/fluid/distributed/collective/reducer.h"
+
+namespace paddle {
+namespace distributed {
+
+// The parameters of a layer flattened into one buffer padded to a multiple
+// of the ranks, where each rank keeps its slice of the parameters and of the
+// reduced gradients.
+struct EagerShardedLayer {
+  std::vector<Tensor> params;
+  std::vector<int64_t> offsets;
+  std::vector<int64_t> numels;
+  int64_t padded_numel = 0;
+  int64_t shard_numel = 0;
+  phi::DataType dtype = phi::DataType::UNDEFINED;
+
+  Tensor param_shard;
+  Tensor grad_shard;
+
+  // the gathered parameters, empty if released
+  Tensor full_params;
+  std::shared_ptr<ProcessGroup::Task> gather_task;
+  bool gathered = false;
+
+  // the flattened gradients and their reduced shard in the reduce-scatter
+  std::shared_ptr<ProcessGroup::Task> scatter_task;
+  Tensor grad_buffer;
+  Tensor scattered_grads;
+  size_t pending_grads = 0;
+};
+
+// Shards the parameters, the gradients and so the optimizer states of the
+// layers over the ranks. The parameters of a layer are all-gathered before
+// it runs and released after it, where the gathers of the next layers are
+// issued on the communication stream ahead to overlap the computation. The
+// gradients of a layer are reduce-scattered to the shards in one fused
+// bucket once the backward hooks of all its parameters are called.
+class EagerShardingEngine {
+ public:
+  // The layers are in the order of the forward, and the parameters are
+  // released after being sharded.
+  EagerShardingEngine(const std::vector<std::vector<Tensor>> &layer_params,
+                      std::shared_ptr<ProcessGroup> process_group,
+                      size_t prefetch_layers = 1);
+
+  // Called before and after the forward of a layer.
+  void PreForward(size_t layer);
+  void PostForward(size_t layer);
+
+  // Called before the backward of a layer, the parameters are released after
+  // the backward by the gradient hooks.
+  void PreBackward(size_t layer);
+
+  // Waits the reduce-scatters of the backward and accumulates the gradient
+  // shards, called before the optimizer updates the parameter shards.
+  void FinalizeBackward();
+
+  // Releases the gathered parameters of all the layers, e.g. after an
+  // evaluation which skipped the backward.
+  void ReleaseAll();
+
+  size_t LayerNum() const { return layers_.size(); }
+  const Tensor &ParamShard(size_t layer) const;
+  const Tensor &GradShard(size_t layer) const;
+  void ClearGradShards();
+
+ private:
+  void Gather(size_t layer);
+  void WaitGathered(size_t layer);
+  void Release(size_t layer);
+  void ReduceScatter(size_t layer);
+  void MarkGradReady(size_t layer, size_t index);
+
+  std::vector<EagerShardedLayer> layers_;
+  std::shared_ptr<ProcessGroup> process_group_;
+  size_t prefetch_layers_;
+  int nranks_;
+  int rank_;
+  phi::Place place_;
+};
+
+}  //  namespace distributed
+}  //  namespace paddle
@@ -0,0 +1,56 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <ThreadPool.h>
+
+#include <utility>
+
+#include "bthread/countdown_event.h"
+
+namespace paddle {
+namespace distributed {
+
+// Waits the tasks enqueued on the shard task pools without blocking the
+// worker pthread of a bthread. The calling bthread is suspended until the
+// last task signals, so that its worker serves the other requests meanwhile,
+// and a pthread caller blocks as with the futures.
+class ShardTaskWaiter {
+ public:
+  ShardTaskWaiter() : event_(0) {}
+
+  template <typename F>
+  void Enqueue(::ThreadPool *pool, F &&task) {
+    event_.add_count();
+    pool->enqueue([this, task = std::forward<F>(task)]() mutable {
+      // signals even if the task throws, so the waiter never hangs
+      Signaler signaler{&event_};
+      task();
+    });
+  }
+
+  void Wait() { event_.wait(); }
+
+ private:
+  struct Signaler {
+    bthread::CountdownEvent *event;
+    ~Signaler() { event->signal(); }
+  };
+
+  bthread::CountdownEvent event_;
+};
+
+}  // namespace distributed
+}  // namespace paddle
@@ -33,16 +33,16 @@ std::vector<std::vector<uint64_t>> LayerWiseSampler::sample(
   for (size_t i = 0; i < input_num; i++) {
     auto travel_codes =
         tree_->GetTravelCodes(target_ids[i], start_sample_layer_);
-    auto travel_path = tree_->GetNodes(travel_codes);
+    auto travel_path = tree_->GetNodeIds(travel_codes);
     for (size_t j = 0; j < travel_path.size(); j++) {
       // user
       if (j > 0 && with_hierarchy) {
         auto ancestor_codes =
             tree_->GetAncestorCodes(user_inputs[i], max_layer - j - 1);
-        auto hierarchical_user = tree_->GetNodes(ancestor_codes);
+        auto hierarchical_user = tree_->GetNodeIds(ancestor_codes);
         for (int idx_offset = 0; idx_offset <= layer_counts_[j]; idx_offset++) {
           for (size_t k = 0; k < user_feature_num; k++) {
-            outputs[idx + idx_offset][k] = hierarchical_user[k].id();
+            outputs[idx + idx_offset][k] = hierarchical_user[k];
           }
         }
       } else {
@@ -54,16 +54,16 @@ std::vector<std::vector<uint64_t>> LayerWiseSampler::sample(
       }
 
       // sampler ++
-      outputs[idx][user_feature_num] = travel_path[j].id();
+      outputs[idx][user_feature_num] = travel_path[j];
       outputs[idx][user_feature_num + 1] = 1.0;
       idx += 1;
       for (int idx_offset = 0; idx_offset < layer_counts_[j]; idx_offset++) {
         int sample_res = 0;
         do {
           sample_res = sampler_vec_[j]->Sample();
-        } while (layer_ids_[j][sample_res].id() == travel_path[j].id());
+        } while (layer_ids_[j][sample_res] == travel_path[j]);
         outputs[idx + idx_offset][user_feature_num] =
-            layer_ids_[j][sample_res].id();
+            layer_ids_[j][sample_res];
         outputs[idx + idx_offset][user_feature_num + 1] = 0;
       }
       idx += layer_counts_[j];
@@ -98,21 +98,21 @@ void LayerWiseSampler::sample_from_dataset(
       auto target_id =
           data.uint64_feasigns_[sample_feasign_idx].sign().uint64_feasign_;
       auto travel_codes = tree_->GetTravelCodes(target_id, start_sample_layer_);
-      auto travel_path = tree_->GetNodes(travel_codes);
+      auto travel_path = tree_->GetNodeIds(travel_codes);
       for (unsigned int j = 0; j < travel_path.size(); j++) {
         paddle::framework::Record instance(data);
         instance.uint64_feasigns_[sample_feasign_idx].sign().uint64_feasign_ =
-            travel_path[j].id();
+            travel_path[j];
         sample_results->push_back(instance);
         for (int idx_offset = 0; idx_offset < layer_counts_[j]; idx_offset++) {
           int sample_res = 0;
           do {
             sample_res = sampler_vec_[j]->Sample();
-          } while (layer_ids_[j][sample_res].id() == travel_path[j].id());
+          } while (layer_ids_[j][sample_res] == travel_path[j]);
           paddle::framework::Record instance(data);
           instance.uint64_feasigns_[sample_feasign_idx].sign().uint64_feasign_ =
-              layer_ids_[j][sample_res].id();
-          VLOG(1) << "layer id :" << layer_ids_[j][sample_res].id();
+              layer_ids_[j][sample_res];
+          VLOG(1) << "layer id :" << layer_ids_[j][sample_res];
           // sample_feasign_idx + 1 == label's id
           instance.uint64_feasigns_[sample_feasign_idx + 1]
               .sign()
@@ -106,6 +106,17 @@ std::vector<IndexNode> TreeIndex::GetNodes(const std::vector<uint64_t>& codes) {
   return nodes;
 }
 
+std::vector<uint64_t> TreeIndex::GetNodeIds(
+    const std::vector<uint64_t>& codes) {
+  std::vector<uint64_t> ids;
+  ids.reserve(codes.size());
+  for (auto code : codes) {
+    auto it = data_.find(code);
+    ids.push_back(it != data_.end() ? it->second.id() : fake_node_.id());
+  }
+  return ids;
+}
+
 std::vector<uint64_t> TreeIndex::GetLayerCodes(int level) {
   uint64_t level_num = static_cast<uint64_t>(std::pow(meta_.branch(), level));
   uint64_t level_offset = level_num - 1;
@@ -50,6 +50,8 @@ class TreeIndex : public Index {
   }
 
   std::vector<IndexNode> GetNodes(const std::vector<uint64_t>& codes);
+  // Same as GetNodes, but only returns the ids, without copying the nodes.
+  std::vector<uint64_t> GetNodeIds(const std::vector<uint64_t>& codes);
   std::vector<uint64_t> GetLayerCodes(int level);
   std::vector<uint64_t> GetAncestorCodes(const std::vector<uint64_t>& ids,
                                          int level);
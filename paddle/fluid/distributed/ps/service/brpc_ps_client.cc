@@ -15,10 +15,12 @@
 #include "paddle/fluid/distributed/ps/service/brpc_ps_client.h"
 
 #include <memory>
+#include <numeric>
 #include <sstream>
 #include <string>
 
 #include "paddle/fluid/distributed/ps/service/coordinator_client.h"
+#include "paddle/fluid/distributed/ps/service/sparse_wire_codec.h"
 #include "paddle/fluid/framework/archive.h"
 #include "paddle/utils/string/split.h"
 
@@ -88,6 +90,42 @@ inline size_t get_sparse_shard(uint32_t shard_num,
   return (key % shard_num) / local_shard_num;
 }
 
+// Packs the keys and update values of a push sparse request with the wire
+// codec of the table.
+inline void FillPushSparseData(const SparseWireCodec &codec,
+                               const uint64_t *keys,
+                               const float *const *values,
+                               uint32_t num,
+                               size_t update_dim,
+                               PsRequestMessage *push_request) {
+  uint32_t codec_flags = codec.Flags();
+  push_request->add_params(reinterpret_cast<char *>(&codec_flags),
+                           sizeof(uint32_t));
+  std::vector<uint32_t> order(num);
+  std::iota(order.begin(), order.end(), 0);
+  if (codec.CompressKeys()) {
+    std::stable_sort(
+        order.begin(), order.end(), [keys](uint32_t a, uint32_t b) {
+          return keys[a] < keys[b];
+        });
+  }
+  std::vector<uint64_t> sorted_keys(num);
+  for (uint32_t i = 0; i < num; ++i) {
+    sorted_keys[i] = keys[order[i]];
+  }
+  auto *push_data = push_request->mutable_data();
+  push_data->clear();
+  codec.EncodeKeys(sorted_keys.data(), num, push_data);
+  size_t value_size = codec.ValueSize(update_dim);
+  size_t key_size = push_data->size();
+  push_data->resize(key_size + num * value_size);
+  char *push_data_ptr = &(*push_data)[key_size];
+  for (uint32_t i = 0; i < num; ++i) {
+    codec.EncodeValue(values[order[i]], update_dim, push_data_ptr);
+    push_data_ptr += value_size;
+  }
+}
+
 void DownpourPsClientService::service(
     ::google::protobuf::RpcController *controller,
     const PsRequestMessage *request,
@@ -181,12 +219,13 @@ int32_t BrpcPsClient::CreateClient2ClientConnection(
     server_ip_port.append(":");
     server_ip_port.append(std::to_string(client_list[i].port));
     _client_channels[i].reset(new brpc::Channel());
-    if (_client_channels[i]->Init(server_ip_port.c_str(), "", &options)) {
+    if (InitBrpcChannel(_client_channels[i].get(), server_ip_port, options)) {
       VLOG(0) << "BrpcPSClient connect to Client:" << server_ip_port
               << " Failed! Try again.";
       std::string int_ip_port =
           GetIntTypeEndpoint(client_list[i].ip, client_list[i].port);
-      if (_client_channels[i]->Init(int_ip_port.c_str(), "", &options) != 0) {
+      if (InitBrpcChannel(_client_channels[i].get(), int_ip_port, options) !=
+          0) {
         LOG(ERROR) << "BrpcPSClient connect to Client:" << int_ip_port
                    << " Failed!";
         return -1;
@@ -310,14 +349,14 @@ int32_t BrpcPsClient::Initialize() {
     server_ip_port.append(std::to_string(server_list[i].port));
     for (size_t j = 0; j < _server_channels[i].size(); ++j) {
       _server_channels[i][j].reset(new brpc::Channel());
-      if (_server_channels[i][j]->Init(server_ip_port.c_str(), "", &options) !=
-          0) {
+      if (InitBrpcChannel(
+              _server_channels[i][j].get(), server_ip_port, options) != 0) {
         VLOG(0) << "BrpcPSclient connect to Server:" << server_ip_port
                 << " Failed! Try again.";
         std::string int_ip_port =
             GetIntTypeEndpoint(server_list[i].ip, server_list[i].port);
-        if (_server_channels[i][j]->Init(int_ip_port.c_str(), "", &options) !=
-            0) {
+        if (InitBrpcChannel(
+                _server_channels[i][j].get(), int_ip_port, options) != 0) {
           LOG(ERROR) << "BrpcPSclient connect to Server:" << int_ip_port
                      << " Failed!";
           return -1;
@@ -350,6 +389,7 @@ int32_t BrpcPsClient::Initialize() {
   profiler.register_profiler("pserver_client_pull_sparse");
   profiler.register_profiler("pserver_client_pull_sparse_param");
   profiler.register_profiler("pserver_client_pull_sparse_local");
+  profiler.register_profiler("pserver_client_pull_sparse_multi_table");
   profiler.register_profiler("pserver_client_push_sparse");
   profiler.register_profiler("pserver_client_push_sparse_parse");
   profiler.register_profiler("client_push_sparse_put");
@@ -1037,6 +1077,8 @@ std::future<int32_t> BrpcPsClient::PushSparseRawGradient(
     ids[pserver_idx].push_back(keys[i]);
     value_ptrs[pserver_idx].push_back(update_values[i]);
   }
+  SparseWireCodec codec =
+      SparseWireCodec::ForPush(accessor->GetWireCodecParameter());
 
   for (size_t shard_idx = 0; shard_idx < request_call_num; ++shard_idx) {
     auto kvs = ids[shard_idx];
@@ -1051,15 +1093,24 @@ std::future<int32_t> BrpcPsClient::PushSparseRawGradient(
     push_request->set_table_id(table_id);
     push_request->set_client_id(_client_id);
     push_request->add_params((char *)&kv_size, sizeof(uint32_t));  // NOLINT
-    auto *push_data = push_request->mutable_data();
-    push_data->resize(kv_size * (sizeof(uint64_t) + value_size));
-    char *push_data_ptr = const_cast<char *>(push_data->data());
-    memcpy(push_data_ptr, kvs.data(), kv_size * sizeof(uint64_t));
-    push_data_ptr += kv_size * sizeof(uint64_t);
-
-    for (size_t i = 0; i < kv_size; ++i) {
-      memcpy(push_data_ptr, value_ptr[i], value_size);
-      push_data_ptr += value_size;
+    if (codec.IsRaw()) {
+      auto *push_data = push_request->mutable_data();
+      push_data->resize(kv_size * (sizeof(uint64_t) + value_size));
+      char *push_data_ptr = const_cast<char *>(push_data->data());
+      memcpy(push_data_ptr, kvs.data(), kv_size * sizeof(uint64_t));
+      push_data_ptr += kv_size * sizeof(uint64_t);
+
+      for (size_t i = 0; i < kv_size; ++i) {
+        memcpy(push_data_ptr, value_ptr[i], value_size);
+        push_data_ptr += value_size;
+      }
+    } else {
+      FillPushSparseData(codec,
+                         kvs.data(),
+                         value_ptr.data(),
+                         kv_size,
+                         accessor->GetAccessorInfo().update_dim,
+                         push_request);
     }
     PsService_Stub rpc_stub(GetSparseChannel(shard_idx));
     closure->cntl(shard_idx)->set_request_compress_type(
@@ -1167,11 +1218,17 @@ std::future<int32_t> BrpcPsClient::PullSparse(float **select_values,
   auto *accessor = GetTableAccessor(table_id);
 
   size_t value_size = accessor->GetAccessorInfo().select_size;
+  size_t value_dim = accessor->GetAccessorInfo().select_dim;
+  SparseWireCodec codec =
+      SparseWireCodec::ForPull(accessor->GetWireCodecParameter());
 
   DownpourBrpcClosure *closure = new DownpourBrpcClosure(
-      request_call_num, [shard_sorted_kvs, value_size](void *done) {
+      request_call_num,
+      [shard_sorted_kvs, value_size, value_dim, codec](void *done) {
         int ret = 0;
         auto *closure = reinterpret_cast<DownpourBrpcClosure *>(done);
+        size_t encoded_size = codec.ValueSize(value_dim);
+        std::string encoded_value(encoded_size, '\0');
         for (size_t i = 0; i < shard_sorted_kvs->size(); ++i) {
           if (closure->check_response(i, PS_PULL_SPARSE_TABLE) != 0) {
             ret = -1;
@@ -1189,7 +1246,7 @@ std::future<int32_t> BrpcPsClient::PullSparse(float **select_values,
               memcpy(reinterpret_cast<void *>(kv_pair.second),
                      reinterpret_cast<void *>(last_value_data),
                      value_size);
-            } else {
+            } else if (codec.IsRaw()) {
               last_key = kv_pair.first;
               last_value_data = kv_pair.second;
               if (value_size !=
@@ -1199,6 +1256,18 @@ std::future<int32_t> BrpcPsClient::PullSparse(float **select_values,
                 ret = -1;
                 break;
               }
+            } else {
+              last_key = kv_pair.first;
+              last_value_data = kv_pair.second;
+              if (encoded_size !=
+                  io_buffer_itr.copy_and_forward(&encoded_value[0],
+                                                 encoded_size)) {
+                LOG(WARNING) << "res data is lack or not in format";
+                ret = -1;
+                break;
+              }
+              codec.DecodeValue(
+                  encoded_value.data(), value_dim, last_value_data);
             }
           }
         }
@@ -1224,15 +1293,16 @@ std::future<int32_t> BrpcPsClient::PullSparse(float **select_values,
     auto &request_buffer = closure->cntl(i)->request_attachment();
 
     request_buffer.append(reinterpret_cast<void *>(&is_training), sizeof(bool));
+    std::vector<uint64_t> unique_keys;
     std::vector<uint32_t> keys_counter;
+    unique_keys.reserve(sorted_kv_size);
     keys_counter.reserve(sorted_kv_size);
 
     for (size_t kv_idx = 0; kv_idx < sorted_kv_size; ++kv_idx) {
       ++kv_request_count;
       uint32_t keys = 1;
       last_key = sorted_kvs[kv_idx].first;
-      request_buffer.append(reinterpret_cast<void *>(&last_key),
-                            sizeof(uint64_t));
+      unique_keys.push_back(last_key);
       while (kv_idx < sorted_kv_size - 1 &&
              last_key == sorted_kvs[kv_idx + 1].first) {
         ++kv_idx;
@@ -1241,8 +1311,11 @@ std::future<int32_t> BrpcPsClient::PullSparse(float **select_values,
       keys_counter.push_back(keys);
     }
 
-    request_buffer.append(reinterpret_cast<void *>(keys_counter.data()),
-                          sizeof(uint32_t) * keys_counter.size());
+    std::string request_data;
+    codec.EncodeKeys(unique_keys.data(), unique_keys.size(), &request_data);
+    codec.EncodeCounts(
+        keys_counter.data(), keys_counter.size(), &request_data);
+    request_buffer.append(request_data);
 
     if (kv_request_count == 0) {
       closure->Run();
@@ -1252,6 +1325,11 @@ std::future<int32_t> BrpcPsClient::PullSparse(float **select_values,
       closure->request(i)->set_client_id(_client_id);
       closure->request(i)->add_params((char *)&kv_request_count,  // NOLINT
                                       sizeof(uint32_t));
+      if (!codec.IsRaw()) {
+        uint32_t codec_flags = codec.Flags();
+        closure->request(i)->add_params(
+            reinterpret_cast<char *>(&codec_flags), sizeof(uint32_t));
+      }
       PsService_Stub rpc_stub(GetCmdChannel(i));
       closure->cntl(i)->set_log_id(butil::gettimeofday_ms());
       rpc_stub.service(
@@ -1261,6 +1339,148 @@ std::future<int32_t> BrpcPsClient::PullSparse(float **select_values,
   return fut;
 }
 
+std::future<int32_t> BrpcPsClient::PullSparseMultiTable(
+    const std::vector<PullSparseRequest> &requests, bool is_training) {
+  auto timer =
+      std::make_shared<CostTimer>("pserver_client_pull_sparse_multi_table");
+  size_t request_call_num = _server_channels.size();
+  size_t table_num = requests.size();
+
+  // [server][table] -> kvs of the table on the server
+  auto shard_sorted_kvs = std::make_shared<
+      std::vector<std::vector<std::vector<std::pair<uint64_t, float *>>>>>(
+      request_call_num,
+      std::vector<std::vector<std::pair<uint64_t, float *>>>(table_num));
+  auto value_sizes = std::make_shared<std::vector<size_t>>(table_num);
+
+  const auto &server_param = _config.server_param().downpour_server_param();
+  for (size_t t = 0; t < table_num; ++t) {
+    const auto &request = requests[t];
+    uint64_t shard_num = FLAGS_pserver_sparse_table_shard_num;
+    for (int i = 0; i < server_param.downpour_table_param_size(); ++i) {
+      const auto &table_param = server_param.downpour_table_param(i);
+      if (table_param.table_id() == request.table_id) {
+        shard_num = table_param.shard_num();
+        break;
+      }
+    }
+    for (size_t i = 0; i < request.num; ++i) {
+      size_t shard_id =
+          get_sparse_shard(shard_num, request_call_num, request.keys[i]);
+      shard_sorted_kvs->at(shard_id)[t].push_back(
+          {request.keys[i], request.select_values[i]});
+    }
+    value_sizes->at(t) =
+        GetTableAccessor(request.table_id)->GetAccessorInfo().select_size;
+  }
+
+  DownpourBrpcClosure *closure = new DownpourBrpcClosure(
+      request_call_num, [shard_sorted_kvs, value_sizes](void *done) {
+        int ret = 0;
+        auto *closure = reinterpret_cast<DownpourBrpcClosure *>(done);
+        for (size_t i = 0; i < shard_sorted_kvs->size() && ret == 0; ++i) {
+          if (closure->check_response(i, PS_PULL_SPARSE_MULTI_TABLE) != 0) {
+            ret = -1;
+            break;
+          }
+
+          auto &res_io_buffer = closure->cntl(i)->response_attachment();
+          butil::IOBufBytesIterator io_buffer_itr(res_io_buffer);
+          // the values of the tables follow each other in request order
+          for (size_t t = 0; t < value_sizes->size() && ret == 0; ++t) {
+            size_t value_size = value_sizes->at(t);
+            uint64_t last_key = UINT64_MAX;
+            float *last_value_data = NULL;
+            for (auto &kv_pair : shard_sorted_kvs->at(i)[t]) {
+              if (kv_pair.first == last_key) {
+                memcpy(reinterpret_cast<void *>(kv_pair.second),
+                       reinterpret_cast<void *>(last_value_data),
+                       value_size);
+              } else {
+                last_key = kv_pair.first;
+                last_value_data = kv_pair.second;
+                if (value_size != io_buffer_itr.copy_and_forward(
+                                      reinterpret_cast<void *>(last_value_data),
+                                      value_size)) {
+                  LOG(WARNING) << "res data is lack or not in format";
+                  ret = -1;
+                  break;
+                }
+              }
+            }
+          }
+        }
+        closure->set_promise_value(ret);
+      });
+  closure->add_timer(timer);
+  auto promise = std::make_shared<std::promise<int32_t>>();
+  closure->add_promise(promise);
+  std::future<int> fut = promise->get_future();
+
+  uint32_t request_table_num = table_num;
+  for (size_t i = 0; i < request_call_num; ++i) {
+    auto &request_buffer = closure->cntl(i)->request_attachment();
+    auto *request = closure->request(i);
+    request->add_params(reinterpret_cast<char *>(&request_table_num),
+                        sizeof(uint32_t));
+    uint32_t total_kv_count = 0;
+    for (size_t t = 0; t < table_num; ++t) {
+      auto &sorted_kvs = shard_sorted_kvs->at(i)[t];
+      std::sort(sorted_kvs.begin(),
+                sorted_kvs.end(),
+                [](const std::pair<uint64_t, float *> &k1,
+                   const std::pair<uint64_t, float *> &k2) {
+                  return k1.first < k2.first;
+                });
+
+      uint32_t kv_request_count = 0;
+      size_t sorted_kv_size = sorted_kvs.size();
+      std::vector<uint64_t> unique_keys;
+      std::vector<uint32_t> keys_counter;
+      unique_keys.reserve(sorted_kv_size);
+      keys_counter.reserve(sorted_kv_size);
+      for (size_t kv_idx = 0; kv_idx < sorted_kv_size; ++kv_idx) {
+        ++kv_request_count;
+        uint32_t keys = 1;
+        uint64_t last_key = sorted_kvs[kv_idx].first;
+        unique_keys.push_back(last_key);
+        while (kv_idx < sorted_kv_size - 1 &&
+               last_key == sorted_kvs[kv_idx + 1].first) {
+          ++kv_idx;
+          ++keys;
+        }
+        keys_counter.push_back(keys);
+      }
+
+      request_buffer.append(reinterpret_cast<void *>(&is_training),
+                            sizeof(bool));
+      request_buffer.append(reinterpret_cast<void *>(unique_keys.data()),
+                            sizeof(uint64_t) * unique_keys.size());
+      request_buffer.append(reinterpret_cast<void *>(keys_counter.data()),
+                            sizeof(uint32_t) * keys_counter.size());
+      uint32_t table_id = requests[t].table_id;
+      request->add_params(reinterpret_cast<char *>(&table_id),
+                          sizeof(uint32_t));
+      request->add_params(reinterpret_cast<char *>(&kv_request_count),
+                          sizeof(uint32_t));
+      total_kv_count += kv_request_count;
+    }
+
+    if (total_kv_count == 0) {
+      closure->Run();
+    } else {
+      request->set_cmd_id(PS_PULL_SPARSE_MULTI_TABLE);
+      request->set_table_id(requests[0].table_id);
+      request->set_client_id(_client_id);
+      PsService_Stub rpc_stub(GetCmdChannel(i));
+      closure->cntl(i)->set_log_id(butil::gettimeofday_ms());
+      rpc_stub.service(
+          closure->cntl(i), request, closure->response(i), closure);
+    }
+  }
+  return fut;
+}
+
 // for GEO
 std::future<int32_t> BrpcPsClient::PullSparseParam(float **select_values,
                                                    size_t table_id,
@@ -1856,21 +2076,37 @@ int BrpcPsClient::PushSparseAsyncShardPush(
   push_request->set_client_id(_client_id);
   push_request->add_params(reinterpret_cast<char *>(&merged_kv_count),
                            sizeof(uint32_t));  // NOLINT
-  auto *push_data = push_request->mutable_data();
-  int update_size = accessor->GetAccessorInfo().update_size;
-  push_data->resize(merged_kv_count * (sizeof(uint64_t) + update_size));
-  char *push_data_ptr = const_cast<char *>(push_data->data());
-  memcpy(push_data_ptr,
-         merged_key_list.data(),
-         merged_kv_count * sizeof(uint64_t));
-  push_data_ptr += merged_kv_count * sizeof(uint64_t);
-  for (size_t i = 0; i < merged_kv_count; ++i) {
-    const char *task_data_ptr = merged_value_list[i].data();
-
+  SparseWireCodec codec =
+      SparseWireCodec::ForPush(accessor->GetWireCodecParameter());
+  if (codec.IsRaw()) {
+    auto *push_data = push_request->mutable_data();
+    int update_size = accessor->GetAccessorInfo().update_size;
+    push_data->resize(merged_kv_count * (sizeof(uint64_t) + update_size));
+    char *push_data_ptr = const_cast<char *>(push_data->data());
     memcpy(push_data_ptr,
-           (float *)(task_data_ptr),  // NOLINT
-           update_size);
-    push_data_ptr += update_size;
+           merged_key_list.data(),
+           merged_kv_count * sizeof(uint64_t));
+    push_data_ptr += merged_kv_count * sizeof(uint64_t);
+    for (size_t i = 0; i < merged_kv_count; ++i) {
+      const char *task_data_ptr = merged_value_list[i].data();
+
+      memcpy(push_data_ptr,
+             (float *)(task_data_ptr),  // NOLINT
+             update_size);
+      push_data_ptr += update_size;
+    }
+  } else {
+    std::vector<const float *> merged_value_ptrs(merged_kv_count);
+    for (size_t i = 0; i < merged_kv_count; ++i) {
+      merged_value_ptrs[i] =
+          reinterpret_cast<const float *>(merged_value_list[i].data());
+    }
+    FillPushSparseData(codec,
+                       merged_key_list.data(),
+                       merged_value_ptrs.data(),
+                       merged_kv_count,
+                       accessor->GetAccessorInfo().update_dim,
+                       push_request);
   }
   PsService_Stub rpc_stub(GetSparseChannel(shard_idx));
   closure->cntl(shard_idx)->set_request_compress_type(
@@ -267,6 +267,8 @@ class BrpcPsClient : public PSClient {
                                           const uint64_t *keys,
                                           size_t num,
                                           bool is_training);
+  virtual std::future<int32_t> PullSparseMultiTable(
+      const std::vector<PullSparseRequest> &requests, bool is_training);
   virtual std::future<int32_t> PullSparseParam(float **select_values,
                                                size_t table_id,
                                                const uint64_t *keys,
@@ -14,10 +14,12 @@
 
 #include "paddle/fluid/distributed/ps/service/brpc_ps_server.h"
 
+#include <algorithm>
 #include <thread>  // NOLINT
 
 #include "butil/object_pool.h"
 #include "paddle/fluid/distributed/common/cost_timer.h"
+#include "paddle/fluid/distributed/ps/service/sparse_wire_codec.h"
 #include "paddle/fluid/distributed/ps/table/depends/sparse_utils.h"
 #include "paddle/fluid/distributed/ps/table/table.h"
 #include "paddle/fluid/framework/archive.h"
@@ -37,6 +39,9 @@ PD_DEFINE_int32(pserver_connect_timeout_ms_s2s,
 PD_DEFINE_string(pserver_connection_type_s2s,
                  "pooled",
                  "pserver connection_type[pooled:single]");
+PD_DEFINE_int32(pserver_pull_multi_table_thread_num,
+                8,
+                "pserver threads to pull the tables of a multi table pull");
 
 namespace paddle::distributed {
 
@@ -79,6 +84,7 @@ uint64_t BrpcPsServer::Start(const std::string &ip, uint32_t port) {
   int num_threads = std::thread::hardware_concurrency();
   auto trainers = _environment->GetTrainers();
   options.num_threads = trainers > num_threads ? trainers : num_threads;
+  SetBrpcServerRdmaOptions(&options);
 
   if (_server.Start(ip_port.c_str(), &options) != 0) {
     VLOG(0) << "BrpcPsServer start failed, ip_port= " << ip_port
@@ -122,7 +128,8 @@ int32_t BrpcPsServer::StartS2S() {
     server_ip_port.append(":");
     server_ip_port.append(std::to_string(pserver_list[i].port));
     _pserver_channels[i].reset(new brpc::Channel());
-    if (_pserver_channels[i]->Init(server_ip_port.c_str(), "", &options) != 0) {
+    if (InitBrpcChannel(_pserver_channels[i].get(), server_ip_port, options) !=
+        0) {
       LOG(ERROR) << "pserver connect to pserver:" << server_ip_port
                  << " Failed!";
     }
@@ -196,6 +203,8 @@ int32_t BrpcPsService::Initialize() {
   _service_handler_map[PS_PUSH_DENSE_TABLE] = &BrpcPsService::PushDense;
   _service_handler_map[PS_PULL_SPARSE_TABLE] = &BrpcPsService::PullSparse;
   _service_handler_map[PS_PUSH_SPARSE_TABLE] = &BrpcPsService::PushSparse;
+  _service_handler_map[PS_PULL_SPARSE_MULTI_TABLE] =
+      &BrpcPsService::PullSparseMultiTable;
   _service_handler_map[PS_SAVE_ONE_TABLE] = &BrpcPsService::SaveOneTable;
   _service_handler_map[PS_SAVE_ALL_TABLE] = &BrpcPsService::SaveAllTable;
   _service_handler_map[PS_SHRINK_TABLE] = &BrpcPsService::ShrinkTable;
@@ -227,6 +236,10 @@ int32_t BrpcPsService::Initialize() {
   profiler.register_profiler("pserver_server_push_dense");
   profiler.register_profiler("pserver_server_pull_sparse");
   profiler.register_profiler("pserver_server_push_sparse");
+  profiler.register_profiler("pserver_server_pull_sparse_multi_table");
+
+  _pull_multi_table_pool.reset(
+      new ::ThreadPool(std::max(1, FLAGS_pserver_pull_multi_table_thread_num)));
 
   // shard初始化,server启动后才可从env获取到server_list的shard信息
   InitializeShardInfo();
@@ -527,15 +540,49 @@ int32_t BrpcPsService::PullSparse(Table *table,
       *(reinterpret_cast<const uint32_t *>(request.params(0).c_str()));
   auto dim = table->GetValueAccessor()->GetAccessorInfo().select_dim;
 
-  thread_local std::string req_buffer;
-  req_buffer.reserve(req_buffer_size);
+  // the buffers are per request rather than thread local, since the bthread
+  // may be suspended in the table and resumed on another pthread, while the
+  // other requests run on this one
+  std::string req_buffer(req_buffer_size, '\0');
 
   const void *data = cntl->request_attachment().fetch(
       const_cast<char *>(req_buffer.data()), req_buffer_size);
 
   auto value = PullSparseValue(num, dim);
 
-  value.DeserializeFromBytes(const_cast<void *>(data));
+  SparseWireCodec codec;
+  if (request.params_size() > 1) {
+    codec = SparseWireCodec(
+        *(reinterpret_cast<const uint32_t *>(request.params(1).c_str())));
+  }
+  std::vector<uint64_t> keys;
+  std::vector<uint32_t> frequencies;
+  if (codec.IsRaw()) {
+    value.DeserializeFromBytes(const_cast<void *>(data));
+  } else {
+    /*
+    |---isTraining---|---keys---|---frequencies---|
+    */
+    const char *begin = reinterpret_cast<const char *>(data);
+    const char *end = begin + req_buffer_size;
+    keys.resize(num);
+    frequencies.resize(num);
+    value.is_training_ = *reinterpret_cast<const bool *>(begin);
+    begin += sizeof(bool);
+    size_t len = codec.DecodeKeys(begin, end - begin, num, keys.data());
+    if (num > 0 && len == 0) {
+      set_response_code(response, -1, "pull sparse keys are not in format");
+      return 0;
+    }
+    begin += len;
+    len = codec.DecodeCounts(begin, end - begin, num, frequencies.data());
+    if (num > 0 && len == 0) {
+      set_response_code(response, -1, "pull sparse keys are not in format");
+      return 0;
+    }
+    value.feasigns_ = keys.data();
+    value.frequencies_ = frequencies.data();
+  }
 
   auto res_data = butil::get_object<std::vector<float>>();
   res_data->resize(num * dim);
@@ -546,12 +593,111 @@ int32_t BrpcPsService::PullSparse(Table *table,
   table->Pull(table_context);
   // table->PullSparse(res_data->data(), value);
 
-  cntl->response_attachment().append(reinterpret_cast<char *>(res_data->data()),
-                                     res_data->size() * sizeof(float));
+  if (codec.IsRaw()) {
+    cntl->response_attachment().append(
+        reinterpret_cast<char *>(res_data->data()),
+        res_data->size() * sizeof(float));
+  } else {
+    thread_local std::string res_buffer;
+    size_t value_size = codec.ValueSize(dim);
+    res_buffer.resize(num * value_size);
+    for (uint32_t i = 0; i < num; ++i) {
+      codec.EncodeValue(
+          res_data->data() + i * dim, dim, &res_buffer[i * value_size]);
+    }
+    cntl->response_attachment().append(res_buffer);
+  }
   butil::return_object(res_data);
   return 0;
 }
 
+int32_t BrpcPsService::PullSparseMultiTable(Table *table,
+                                            const PsRequestMessage &request,
+                                            PsResponseMessage &response,
+                                            brpc::Controller *cntl) {
+  phi::RecordEvent record_event("PsService->PullSparseMultiTable",
+                                phi::TracerEventType::Communication,
+                                1);
+  /*
+  params:     |---table_num---|---table_id, num---|...
+  attachment: |---isTraining---|---keys---|---frequencies---|... per table
+  response:   |---values---|... per table
+  */
+  if (request.params_size() < 1) {
+    set_response_code(response,
+                      -1,
+                      "PsRequestMessage.params is required at "
+                      "least 1 for num of tables");
+    return 0;
+  }
+  const uint32_t table_num =
+      *(reinterpret_cast<const uint32_t *>(request.params(0).c_str()));
+  if (static_cast<size_t>(request.params_size()) < 1 + 2 * table_num) {
+    set_response_code(response,
+                      -1,
+                      "PsRequestMessage.params is required at "
+                      "least 2 for table_id and num of each table");
+    return 0;
+  }
+
+  CostTimer timer("pserver_server_pull_sparse_multi_table");
+  auto &req_io_buffer = cntl->request_attachment();
+  auto req_buffer_size = req_io_buffer.size();
+  std::string req_buffer(req_buffer_size, '\0');
+  const char *data = reinterpret_cast<const char *>(
+      req_io_buffer.fetch(const_cast<char *>(req_buffer.data()),
+                          req_buffer_size));
+
+  std::vector<Table *> tables(table_num);
+  std::vector<PullSparseValue> values(table_num);
+  std::vector<std::vector<float>> res_data(table_num);
+  size_t offset = 0;
+  for (uint32_t i = 0; i < table_num; ++i) {
+    const uint32_t table_id = *(reinterpret_cast<const uint32_t *>(
+        request.params(1 + 2 * i).c_str()));
+    const uint32_t num = *(reinterpret_cast<const uint32_t *>(
+        request.params(2 + 2 * i).c_str()));
+    tables[i] = _server->GetTable(table_id);
+    if (tables[i] == nullptr) {
+      std::string err_msg("table not found with table_id:");
+      err_msg.append(std::to_string(table_id));
+      set_response_code(response, -1, err_msg.c_str());
+      return -1;
+    }
+    size_t size = sizeof(bool) + num * (sizeof(uint64_t) + sizeof(uint32_t));
+    if (offset + size > req_buffer_size) {
+      set_response_code(response, -1, "req attachment is not in format");
+      return 0;
+    }
+    auto dim = tables[i]->GetValueAccessor()->GetAccessorInfo().select_dim;
+    values[i] = PullSparseValue(num, dim);
+    values[i].DeserializeFromBytes(const_cast<char *>(data + offset));
+    res_data[i].resize(num * dim);
+    offset += size;
+  }
+
+  std::vector<std::future<int32_t>> tasks;
+  tasks.reserve(table_num);
+  for (uint32_t i = 0; i < table_num; ++i) {
+    tasks.push_back(_pull_multi_table_pool->enqueue([&, i]() -> int32_t {
+      TableContext table_context;
+      table_context.value_type = Sparse;
+      table_context.pull_context.pull_value = values[i];
+      table_context.pull_context.values = res_data[i].data();
+      return tables[i]->Pull(table_context);
+    }));
+  }
+  for (auto &task : tasks) {
+    task.wait();
+  }
+  for (uint32_t i = 0; i < table_num; ++i) {
+    cntl->response_attachment().append(
+        reinterpret_cast<char *>(res_data[i].data()),
+        res_data[i].size() * sizeof(float));
+  }
+  return 0;
+}
+
 int32_t BrpcPsService::PushSparse(Table *table,
                                   const PsRequestMessage &request,
                                   PsResponseMessage &response,
@@ -585,6 +731,32 @@ int32_t BrpcPsService::PushSparse(Table *table,
   table_context.push_context.values =
       (const float *)(push_data.data() + sizeof(uint64_t) * num);
   table_context.num = num;
+  SparseWireCodec codec;
+  if (request.params_size() > 1) {
+    codec = SparseWireCodec(
+        *(reinterpret_cast<const uint32_t *>(request.params(1).c_str())));
+  }
+  // per request, see PullSparse
+  std::vector<uint64_t> keys;
+  std::vector<float> values;
+  if (!codec.IsRaw()) {
+    size_t dim = table->GetValueAccessor()->GetAccessorInfo().update_dim;
+    size_t value_size = codec.ValueSize(dim);
+    keys.resize(num);
+    values.resize(num * dim);
+    size_t len =
+        codec.DecodeKeys(push_data.data(), push_data.size(), num, keys.data());
+    if (len == 0 || push_data.size() - len < num * value_size) {
+      set_response_code(response, -1, "push sparse data is not in format");
+      return 0;
+    }
+    const char *value_data = push_data.data() + len;
+    for (uint32_t i = 0; i < num; ++i) {
+      codec.DecodeValue(value_data + i * value_size, dim, &values[i * dim]);
+    }
+    table_context.push_context.keys = keys.data();
+    table_context.push_context.values = values.data();
+  }
   // const uint64_t *keys = (const uint64_t *)push_data.data();
   // const float *values = (const float *)(push_data.data() + sizeof(uint64_t) *
   // num);
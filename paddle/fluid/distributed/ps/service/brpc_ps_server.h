@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <ThreadPool.h>
+
 #include "brpc/channel.h"
 #include "brpc/controller.h"
 #include "brpc/server.h"
@@ -109,6 +111,10 @@ class BrpcPsService : public PsBaseService {
                      const PsRequestMessage &request,
                      PsResponseMessage &response,  // NOLINT
                      brpc::Controller *cntl);
+  int32_t PullSparseMultiTable(Table *table,
+                               const PsRequestMessage &request,
+                               PsResponseMessage &response,  // NOLINT
+                               brpc::Controller *cntl);
   int32_t PullGeoParam(Table *table,
                        const PsRequestMessage &request,
                        PsResponseMessage &response,  // NOLINT
@@ -202,6 +208,8 @@ class BrpcPsService : public PsBaseService {
   std::unordered_map<int32_t, serviceHandlerFunc> _service_handler_map;
   std::unordered_map<int32_t, serviceHandlerFunc> _msg_handler_map;
   std::vector<float> _ori_values;
+  // pulls the tables of one PullSparseMultiTable request in parallel
+  std::shared_ptr<::ThreadPool> _pull_multi_table_pool;
 };
 
 class DownpourPServerBrpcClosure : public PServerClosure {
@@ -17,9 +17,24 @@ limitations under the License. */
 #include <arpa/inet.h>
 #include <netdb.h>
 
+#include <mutex>
+#include <unordered_map>
+
+#include "paddle/common/flags.h"
 #include "paddle/fluid/framework/convert_utils.h"
 #include "paddle/fluid/platform/enforce.h"
 
+PD_DEFINE_bool(ps_zero_copy_send,
+               false,
+               "Whether to send the cpu tensors of the ps and the heter "
+               "pipeline without copying them into the brpc attachment. Their "
+               "memory must not be written before the send finishes");
+PD_DEFINE_bool(pserver_use_rdma,
+               false,
+               "Whether to use the brpc rdma transport for the ps, graph and "
+               "heter channels and servers, falling back to tcp when rdma is "
+               "not available. Requires building with WITH_BRPC_RDMA");
+
 namespace paddle::framework {
 class Variable;
 }  // namespace paddle::framework
@@ -30,6 +45,121 @@ class DenseTensor;
 
 namespace paddle::distributed {
 
+namespace {
+
+// The allocations of the tensors appended to the IOBufs without copying,
+// released when brpc drops the last reference to their data.
+std::mutex zero_copy_mutex;
+std::unordered_multimap<void*, std::shared_ptr<phi::Allocation>>
+    zero_copy_holders;
+
+void ReleaseZeroCopyHolder(void* data) {
+  std::lock_guard<std::mutex> lock(zero_copy_mutex);
+  auto it = zero_copy_holders.find(data);
+  if (it != zero_copy_holders.end()) {
+    zero_copy_holders.erase(it);
+  }
+}
+
+void DeleteHostBuffer(void* data) { delete[] static_cast<char*>(data); }
+
+// Appends the 8 bytes length and the data of the tensor to the iobuf. The cpu
+// data is referenced by the iobuf when ps_zero_copy_send is on, and the host
+// copy of the gpu data is owned by the iobuf.
+void AppendTensorData(phi::DenseTensor* tensor,
+                      const phi::DeviceContext& ctx,
+                      butil::IOBuf* iobuf) {
+  uint64_t data_len = tensor->numel() * phi::SizeOf(tensor->dtype());
+  iobuf->append(reinterpret_cast<const char*>(&data_len), 8);
+  if (data_len == 0) {
+    return;
+  }
+  if (phi::is_cpu_place(tensor->place())) {
+    // the rdma transport only sends the iobuf blocks of its registered pool
+    // without copying, so the user data would be copied once more
+    if (FLAGS_ps_zero_copy_send && !FLAGS_pserver_use_rdma) {
+      void* data = tensor->data();
+      {
+        std::lock_guard<std::mutex> lock(zero_copy_mutex);
+        zero_copy_holders.emplace(data, tensor->Holder());
+      }
+      iobuf->append_user_data(data, data_len, ReleaseZeroCopyHolder);
+    } else {
+      iobuf->append(reinterpret_cast<const char*>(tensor->data()), data_len);
+    }
+  } else {
+#ifdef PADDLE_WITH_CUDA
+    char* temp_ptr = new char[data_len];  // NOLINT
+    auto stream = reinterpret_cast<const phi::GPUContext&>(ctx).stream();
+    memory::Copy(phi::CPUPlace(),
+                 temp_ptr,
+                 tensor->place(),
+                 tensor->data(),
+                 data_len,
+                 stream);
+    iobuf->append_user_data(temp_ptr, data_len, DeleteHostBuffer);
+#endif
+  }
+}
+
+bool UseBrpcRdma() {
+#ifdef PADDLE_WITH_BRPC_RDMA
+  return FLAGS_pserver_use_rdma;
+#else
+  static std::once_flag warn_once;
+  if (FLAGS_pserver_use_rdma) {
+    std::call_once(warn_once, [] {
+      LOG(WARNING) << "pserver_use_rdma is on, but paddle is not built with "
+                      "WITH_BRPC_RDMA, use tcp instead.";
+    });
+  }
+  return false;
+#endif
+}
+
+// Reads the length and the data of the tensor into its allocation. The gpu
+// data is copied to the device block by block from the received iobuf,
+// without gathering it into a host buffer first.
+void ForwardTensorData(butil::IOBufBytesIterator& io_buffer_itr,  // NOLINT
+                       const phi::DeviceContext& ctx,
+                       phi::DenseTensor* tensor,
+                       void* tensor_data) {
+  const auto place = ctx.GetPlace();
+  uint64_t data_len = 0;
+  io_buffer_itr.copy_and_forward(reinterpret_cast<void*>(&data_len), 8);
+  uint64_t tensor_len = tensor->numel() * phi::SizeOf(tensor->dtype());
+  PADDLE_ENFORCE_EQ(
+      data_len,
+      tensor_len,
+      common::errors::InvalidArgument(
+          "The received data of %d bytes does not match the tensor of %d "
+          "bytes.",
+          data_len,
+          tensor_len));
+  if (phi::is_cpu_place(place)) {
+    io_buffer_itr.copy_and_forward(tensor_data, data_len);
+  } else if (phi::is_gpu_place(place)) {
+#ifdef PADDLE_WITH_CUDA
+    butil::IOBuf data;
+    io_buffer_itr.append_and_forward(&data, data_len);
+    auto stream = reinterpret_cast<const phi::GPUContext&>(ctx).stream();
+    char* dst = static_cast<char*>(tensor_data);
+    for (size_t i = 0; i < data.backing_block_num(); ++i) {
+      butil::StringPiece block = data.backing_block(i);
+      memory::Copy(place,
+                   dst,
+                   phi::CPUPlace(),
+                   block.data(),
+                   block.size(),
+                   stream);
+      dst += block.size();
+    }
+#endif
+  }
+}
+
+}  // namespace
+
 framework::proto::VarType::Type VarMessageToVarType(
     VariableMessage::Type type) {
   switch (type) {
@@ -107,29 +237,7 @@ void SerializeDenseTensor(framework::Variable* var,
     var_msg->add_dims(dim);
   }
   // IO Buffer
-  if (phi::is_cpu_place(tensor->place())) {
-    auto data_len = tensor->numel() * phi::SizeOf(tensor->dtype());
-    iobuf->append(reinterpret_cast<const char*>(&data_len), 8);
-    iobuf->append(reinterpret_cast<const char*>(tensor->data()), data_len);
-  } else {
-#ifdef PADDLE_WITH_CUDA
-    char* temp_ptr =
-        new char[tensor->numel() * phi::SizeOf(tensor->dtype())];  // NOLINT
-    auto stream = reinterpret_cast<const phi::GPUContext&>(ctx).stream();
-    memory::Copy(
-        phi::CPUPlace(),
-        temp_ptr,
-        tensor->place(),
-        tensor->data(),
-        tensor->numel() * framework::SizeOfType(
-                              framework::TransToProtoVarType(tensor->dtype())),
-        stream);
-    auto data_len = tensor->numel() * phi::SizeOf(tensor->dtype());
-    iobuf->append(reinterpret_cast<const char*>(&data_len), 8);
-    iobuf->append(reinterpret_cast<const char*>(temp_ptr), data_len);
-    delete[] temp_ptr;
-#endif
-  }
+  AppendTensorData(tensor, ctx, iobuf);
 }
 
 void SerializeSelectedRows(framework::Variable* var,
@@ -154,29 +262,7 @@ void SerializeSelectedRows(framework::Variable* var,
     var_msg->add_dims(dim);
   }
   // IO Buffer
-  if (phi::is_cpu_place(tensor->place())) {
-    auto data_len = tensor->numel() * phi::SizeOf(tensor->dtype());
-    iobuf->append(reinterpret_cast<const char*>(&data_len), 8);
-    iobuf->append(reinterpret_cast<const char*>(tensor->data()), data_len);
-  } else {
-#ifdef PADDLE_WITH_CUDA
-    char* temp_ptr =
-        new char[tensor->numel() * phi::SizeOf(tensor->dtype())];  // NOLINT
-    auto stream = reinterpret_cast<const phi::GPUContext&>(ctx).stream();
-    memory::Copy(
-        phi::CPUPlace(),
-        temp_ptr,
-        tensor->place(),
-        tensor->data(),
-        tensor->numel() * framework::SizeOfType(
-                              framework::TransToProtoVarType(tensor->dtype())),
-        stream);
-    auto data_len = tensor->numel() * phi::SizeOf(tensor->dtype());
-    iobuf->append(reinterpret_cast<const char*>(&data_len), 8);
-    iobuf->append(reinterpret_cast<const char*>(temp_ptr), data_len);
-    delete[] temp_ptr;
-#endif
-  }
+  AppendTensorData(tensor, ctx, iobuf);
 }
 
 void DeserializeFromMultiVarMsgAndIOBuf(const MultiVarMsg& multi_msg,
@@ -245,27 +331,7 @@ void DeserializeDenseTensor(framework::Variable* var,
       place, phi::TransToPhiDataType(VarMessageToVarType(msg.data_type())));
 
   // IO Buffer
-  if (phi::is_cpu_place(place)) {
-    unsigned long data_len;                                 // NOLINT
-    io_buffer_itr.copy_and_forward((void*)(&data_len), 8);  // NOLINT
-    io_buffer_itr.copy_and_forward(tensor_data, data_len);
-  } else if (phi::is_gpu_place(place)) {
-#ifdef PADDLE_WITH_CUDA
-    unsigned long data_len;  // NOLINT
-    char* temp_ptr =
-        new char[tensor->numel() * phi::SizeOf(tensor->dtype())];  // NOLINT
-    io_buffer_itr.copy_and_forward((void*)(&data_len), 8);         // NOLINT
-    io_buffer_itr.copy_and_forward((void*)temp_ptr, data_len);     // NOLINT
-    auto stream = reinterpret_cast<const phi::GPUContext&>(ctx).stream();
-    memory::Copy(place,
-                 tensor_data,
-                 phi::CPUPlace(),
-                 (void*)temp_ptr,  // NOLINT
-                 tensor->numel() * phi::SizeOf(tensor->dtype()),
-                 stream);
-    delete[] temp_ptr;
-#endif
-  }
+  ForwardTensorData(io_buffer_itr, ctx, tensor, tensor_data);
 }
 
 void DeserializeSelectedRows(
@@ -288,27 +354,7 @@ void DeserializeSelectedRows(
   void* tensor_data = tensor->mutable_data(
       place, phi::TransToPhiDataType(VarMessageToVarType(msg.data_type())));
   // IO Buffer
-  if (phi::is_cpu_place(place)) {
-    unsigned long data_len;                                 // NOLINT
-    io_buffer_itr.copy_and_forward((void*)(&data_len), 8);  // NOLINT
-    io_buffer_itr.copy_and_forward(tensor_data, data_len);
-  } else if (phi::is_gpu_place(place)) {
-#ifdef PADDLE_WITH_CUDA
-    char* temp_ptr =
-        new char[tensor->numel() * phi::SizeOf(tensor->dtype())];  // NOLINT
-    unsigned long data_len;                                        // NOLINT
-    io_buffer_itr.copy_and_forward((void*)(&data_len), 8);         // NOLINT
-    io_buffer_itr.copy_and_forward(temp_ptr, data_len);
-    auto stream = reinterpret_cast<const phi::GPUContext&>(ctx).stream();
-    memory::Copy(place,
-                 tensor_data,
-                 phi::CPUPlace(),
-                 temp_ptr,
-                 tensor->numel() * phi::SizeOf(tensor->dtype()),
-                 stream);
-    delete[] temp_ptr;
-#endif
-  }
+  ForwardTensorData(io_buffer_itr, ctx, tensor, tensor_data);
 }
 
 std::string GetIntTypeEndpoint(const std::string& ip, const uint32_t& port) {
@@ -338,4 +384,29 @@ std::string GetIntTypeEndpoint(const std::string& ip, const uint32_t& port) {
   return int_ip_port;
 }
 
+int InitBrpcChannel(brpc::Channel* channel,
+                    const std::string& endpoint,
+                    const brpc::ChannelOptions& options) {
+  // brpc only runs baidu_std over rdma, and not over short connections
+  if (UseBrpcRdma() && options.protocol == brpc::PROTOCOL_BAIDU_STD &&
+      options.connection_type != brpc::CONNECTION_TYPE_SHORT &&
+      !options.has_ssl_options()) {
+    brpc::ChannelOptions rdma_options = options;
+    rdma_options.use_rdma = true;
+    if (channel->Init(endpoint.c_str(), "", &rdma_options) == 0) {
+      VLOG(1) << "brpc channel to " << endpoint << " uses rdma";
+      return 0;
+    }
+    LOG(WARNING) << "Failed to init the rdma channel to " << endpoint
+                 << ", fall back to tcp.";
+  }
+  return channel->Init(endpoint.c_str(), "", &options);
+}
+
+void SetBrpcServerRdmaOptions(brpc::ServerOptions* options) {
+  if (UseBrpcRdma() && !options->has_ssl_options()) {
+    options->use_rdma = true;
+  }
+}
+
 }  // namespace paddle::distributed
@@ -21,6 +21,7 @@ limitations under the License. */
 #include <vector>
 
 #include "brpc/channel.h"
+#include "brpc/server.h"
 #include "paddle/fluid/distributed/ps/service/sendrecv.pb.h"
 #include "paddle/fluid/framework/data_type.h"
 #include "paddle/fluid/framework/lod_tensor.h"
@@ -94,5 +95,16 @@ void DeserializeSelectedRows(framework::Variable* var,
 
 std::string GetIntTypeEndpoint(const std::string& ip, const uint32_t& port);
 
+// Initializes the channel over the brpc rdma transport when pserver_use_rdma
+// is on and the options allow it, and over tcp otherwise or when the rdma
+// channel can not be initialized. Returns 0 on success, as Channel::Init.
+int InitBrpcChannel(brpc::Channel* channel,
+                    const std::string& endpoint,
+                    const brpc::ChannelOptions& options);
+
+// Turns on the rdma transport of the server when pserver_use_rdma is on and
+// the options allow it. The server keeps accepting the tcp clients.
+void SetBrpcServerRdmaOptions(brpc::ServerOptions* options);
+
 }  // namespace distributed
 }  // namespace paddle
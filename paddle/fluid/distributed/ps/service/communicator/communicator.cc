@@ -1063,6 +1063,105 @@ void SyncCommunicator::BarrierRecv() {
   VLOG(4) << "BarrierRecv with SyncCommunicator";
 }
 
+void GeoSparseIdBuffer::Reserve(int64_t height) {
+  std::call_once(reserve_flag_, [this, height]() {
+    int64_t rows = (height + split_num_ - 1) / split_num_;
+    int64_t word_num = (rows + kWordBits - 1) / kWordBits;
+    int64_t dirty_word_num = (word_num + kWordBits - 1) / kWordBits;
+    words_.reset(new std::atomic<uint64_t>[word_num]);
+    dirty_words_.reset(new std::atomic<uint64_t>[dirty_word_num]);
+    for (int64_t i = 0; i < word_num; ++i) {
+      words_[i].store(0, std::memory_order_relaxed);
+    }
+    for (int64_t i = 0; i < dirty_word_num; ++i) {
+      dirty_words_[i].store(0, std::memory_order_relaxed);
+    }
+    word_num_.store(word_num, std::memory_order_release);
+  });
+}
+
+void GeoSparseIdBuffer::Add(int64_t id) {
+  int64_t row = id / split_num_;
+  int64_t word = row / kWordBits;
+  PADDLE_ENFORCE_LT(word,
+                    word_num_.load(std::memory_order_acquire),
+                    common::errors::OutOfRange(
+                        "The sparse id %d is out of the table.", id));
+  uint64_t bit = uint64_t(1) << (row % kWordBits);
+  // the word is marked dirty after its bit is set, so that Take either
+  // gets the bit now or finds the word dirty next time
+  uint64_t old = words_[word].fetch_or(bit, std::memory_order_acq_rel);
+  if (old == 0) {
+    dirty_words_[word / kWordBits].fetch_or(
+        uint64_t(1) << (word % kWordBits), std::memory_order_acq_rel);
+  }
+}
+
+void GeoSparseIdBuffer::AddBatch() {
+  int64_t now = static_cast<int64_t>(GetCurrentUS());
+  int64_t last = last_batch_us_.exchange(now, std::memory_order_relaxed);
+  if (last != 0) {
+    int64_t interval = batch_interval_us_.load(std::memory_order_relaxed);
+    batch_interval_us_.store(
+        interval == 0 ? now - last : (interval * 7 + (now - last)) / 8,
+        std::memory_order_relaxed);
+  }
+  pending_batches_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void GeoSparseIdBuffer::WaitForStaleness(int64_t max_staleness,
+                                         const bool &running) {
+  if (PendingBatches() <= max_staleness) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (running && PendingBatches() > max_staleness) {
+    cv_.wait_for(lock, std::chrono::milliseconds(10));
+  }
+}
+
+std::vector<int64_t> GeoSparseIdBuffer::Take() {
+  std::vector<int64_t> ids;
+  int64_t word_num = word_num_.load(std::memory_order_acquire);
+  int64_t dirty_word_num = (word_num + kWordBits - 1) / kWordBits;
+  for (int64_t i = 0; i < dirty_word_num; ++i) {
+    uint64_t dirty = dirty_words_[i].exchange(0, std::memory_order_acq_rel);
+    while (dirty != 0) {
+      int64_t word = i * kWordBits + __builtin_ctzll(dirty);
+      dirty &= dirty - 1;
+      uint64_t bits = words_[word].exchange(0, std::memory_order_acq_rel);
+      while (bits != 0) {
+        int64_t row = word * kWordBits + __builtin_ctzll(bits);
+        bits &= bits - 1;
+        ids.push_back(row * split_num_ + split_idx_);
+      }
+    }
+  }
+  pending_batches_.store(0, std::memory_order_release);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+  }
+  cv_.notify_all();
+  return ids;
+}
+
+void GeoSparseIdBuffer::ReportSendLatency(int64_t latency_us) {
+  int64_t latency = send_latency_us_.load(std::memory_order_relaxed);
+  send_latency_us_.store(
+      latency == 0 ? latency_us : (latency * 7 + latency_us) / 8,
+      std::memory_order_relaxed);
+}
+
+int64_t GeoSparseIdBuffer::TargetMergeNum(int64_t max_merge_num) const {
+  int64_t interval = batch_interval_us_.load(std::memory_order_relaxed);
+  int64_t latency = send_latency_us_.load(std::memory_order_relaxed);
+  if (interval <= 0 || latency <= 0) {
+    return max_merge_num;
+  }
+  return std::max<int64_t>(
+      1, std::min<int64_t>(max_merge_num, (latency + interval - 1) / interval));
+}
+
 void GeoCommunicator::Send(
     const std::vector<std::string> &var_names,
     const framework::Scope &scope) {  // last op in program
@@ -1091,6 +1190,27 @@ void GeoCommunicator::Send(
                         "Only need to send Sparse Grad in Geo mode."));
   auto &rows = var->Get<phi::SelectedRows>().rows();
 
+  if (!sparse_id_buffers_.empty()) {
+    auto &splited_varnames = send_varname_to_ctx_[table_name].splited_varnames;
+    auto &param =
+        recv_scope_->FindVar(GradToParam(table_name))->Get<phi::DenseTensor>();
+    for (auto &splited_varname : splited_varnames) {
+      sparse_id_buffers_.at(splited_varname)->Reserve(param.dims()[0]);
+    }
+    for (auto row : rows) {
+      sparse_id_buffers_.at(splited_varnames[row % splited_var_nums])
+          ->Add(row);
+    }
+    for (auto &splited_varname : splited_varnames) {
+      auto &buffer = sparse_id_buffers_.at(splited_varname);
+      buffer->AddBatch();
+      buffer->WaitForStaleness(FLAGS_communicator_geo_max_staleness, running_);
+    }
+    VLOG(2) << "run send op finish. use time "
+            << (GetCurrentUS() - before_send);
+    return;
+  }
+
   // insert ids which has not been record
   // VLOG(0) << "fl-ps > table_name: " << table_name << " splited_var_nums: " <<
   // splited_var_nums << " rows size: " << rows.size();
@@ -1142,6 +1262,14 @@ void GeoCommunicator::InitImpl(const RpcCtxMap &send_varname_to_ctx,
     } else {
       it++;
     }
+    int64_t split_num = ctx.splited_varnames.size();
+    for (int64_t split_idx = 0; split_idx < split_num; ++split_idx) {
+      auto &splited_var = ctx.splited_varnames[split_idx];
+      if (FLAGS_communicator_geo_max_staleness > 0) {
+        sparse_id_buffers_[splited_var] =
+            std::make_shared<GeoSparseIdBuffer>(split_num, split_idx);
+      }
+    }
     for (auto &splited_var : ctx.splited_varnames) {  // embedding_0.w_0.block0
       parallel_task_nums_ += 1;
       sparse_id_queues_.insert(
@@ -1337,6 +1465,23 @@ std::vector<int64_t> GeoCommunicator::MergeSparseIds(
   phi::RecordEvent record_event("GeoCommunicator->MergeSparseIds",
                                 phi::TracerEventType::Communication,
                                 1);
+  auto buffer_it = sparse_id_buffers_.find(send_varname);
+  if (buffer_it != sparse_id_buffers_.end()) {
+    // wait for as many batches as arrive during one send, so that the next
+    // send starts about when this one returns
+    auto &buffer = buffer_it->second;
+    int64_t target = buffer->TargetMergeNum(std::min<int64_t>(
+        max_merge_var_num_, FLAGS_communicator_geo_max_staleness));
+    size_t wait_times = 0;
+    while (running_ && buffer->PendingBatches() < target &&
+           wait_times < static_cast<size_t>(send_wait_times_)) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      wait_times++;
+    }
+    VLOG(3) << "Merge " << buffer->PendingBatches() << " batches of "
+            << send_varname << ", target " << target;
+    return buffer->Take();
+  }
   size_t merge_num = 0, wait_times = 0;
   std::unordered_set<int64_t> sparse_ids;
   while (merge_num <
@@ -1531,8 +1676,14 @@ void GeoCommunicator::MainThread() {
                 ctx.splited_varnames[ep_idx];  // embedding_0.w_0.block0
                                                // embedding_1.w_0.block0
             auto sparse_ids = MergeSparseIds(splited_varname);
+            auto before_send = GetCurrentUS();
             SendSparse(splited_varname, sparse_ids, table_id, ep_idx);
             RecvSparse(splited_varname, table_id, ep_idx);
+            auto buffer_it = sparse_id_buffers_.find(splited_varname);
+            if (buffer_it != sparse_id_buffers_.end() && !sparse_ids.empty()) {
+              buffer_it->second->ReportSendLatency(
+                  static_cast<int64_t>(GetCurrentUS() - before_send));
+            }
           };
           tasks.emplace_back(
               send_threadpool_->enqueue(std::move(send_recv_task)));
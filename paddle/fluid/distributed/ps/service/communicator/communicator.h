@@ -18,9 +18,11 @@ limitations under the License. */
 #include <stdint.h>
 
 #include <atomic>
+#include <condition_variable>  // NOLINT
 #include <deque>
 #include <map>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <numeric>
 #include <set>
 #include <string>
@@ -53,6 +55,7 @@ struct CommContext;
 }  // namespace paddle
 
 COMMON_DECLARE_bool(communicator_is_sgd_optimizer);
+COMMON_DECLARE_int32(communicator_geo_max_staleness);
 
 namespace paddle {
 namespace distributed {
@@ -592,6 +595,65 @@ class SyncCommunicator : public HalfAsyncCommunicator {
   std::vector<std::string> pserver_endpoints_{};
 };
 
+// GeoSparseIdBuffer merges the sparse ids which GeoCommunicator::Send records
+// for one split of a table until they are sent. The ids are the bits of an
+// atomic bitmap of the rows of the split, so that recording is lock-free and
+// the memory is bounded by the table height however many batches pile up.
+//
+// It also counts the batches waiting to be sent, which the trainer waits on
+// to bound the staleness, and keeps the running averages of the interval
+// between two batches and of the latency of a send, which give how many
+// batches to merge into one send.
+class GeoSparseIdBuffer {
+ public:
+  GeoSparseIdBuffer(int64_t split_num, int64_t split_idx)
+      : split_num_(split_num), split_idx_(split_idx) {}
+
+  // allocates the bitmap once, the height is the rows of the whole table
+  void Reserve(int64_t height);
+
+  // id % split_num must be split_idx
+  void Add(int64_t id);
+
+  // called by Send after the ids of a batch are added
+  void AddBatch();
+
+  int64_t PendingBatches() const {
+    return pending_batches_.load(std::memory_order_acquire);
+  }
+
+  // blocks while more than max_staleness batches wait to be sent
+  void WaitForStaleness(int64_t max_staleness, const bool &running);
+
+  // takes the recorded ids and the pending batches
+  std::vector<int64_t> Take();
+
+  void ReportSendLatency(int64_t latency_us);
+
+  // the batches which arrive during one send, in [1, max_merge_num]
+  int64_t TargetMergeNum(int64_t max_merge_num) const;
+
+ private:
+  static constexpr int64_t kWordBits = 64;
+
+  const int64_t split_num_;
+  const int64_t split_idx_;
+  std::once_flag reserve_flag_;
+  std::atomic<int64_t> word_num_{0};
+  std::unique_ptr<std::atomic<uint64_t>[]> words_;
+  // a bit per word of words_ which may be nonzero, so that Take does not
+  // scan the whole bitmap
+  std::unique_ptr<std::atomic<uint64_t>[]> dirty_words_;
+
+  std::atomic<int64_t> pending_batches_{0};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+
+  std::atomic<int64_t> last_batch_us_{0};
+  std::atomic<int64_t> batch_interval_us_{0};
+  std::atomic<int64_t> send_latency_us_{0};
+};
+
 class GeoCommunicator : public AsyncCommunicator {
  public:
   GeoCommunicator() : AsyncCommunicator() {}
@@ -661,6 +723,9 @@ class GeoCommunicator : public AsyncCommunicator {
       std::string,
       ::paddle::framework::Channel<std::shared_ptr<std::vector<int64_t>>>>
       sparse_id_queues_;
+  // replaces sparse_id_queues_ if FLAGS_communicator_geo_max_staleness > 0
+  std::unordered_map<std::string, std::shared_ptr<GeoSparseIdBuffer>>
+      sparse_id_buffers_;
 };
 
 class FLCommunicator : public GeoCommunicator {
@@ -76,6 +76,7 @@ uint64_t GraphBrpcServer::Start(const std::string &ip, uint32_t port) {
   int num_threads = std::thread::hardware_concurrency();
   auto trainers = _environment->GetTrainers();
   options.num_threads = trainers > num_threads ? trainers : num_threads;
+  SetBrpcServerRdmaOptions(&options);
 
   if (_server.Start(ip_port.c_str(), &options) != 0) {
     LOG(ERROR) << "GraphBrpcServer start failed, ip_port=" << ip_port;
@@ -104,12 +105,14 @@ int32_t GraphBrpcServer::build_peer2peer_connection(int rank) {
     server_ip_port.append(":");
     server_ip_port.append(std::to_string(server_list[i].port));
     _pserver_channels[i].reset(new brpc::Channel());
-    if (_pserver_channels[i]->Init(server_ip_port.c_str(), "", &options) != 0) {
+    if (InitBrpcChannel(_pserver_channels[i].get(), server_ip_port, options) !=
+        0) {
       VLOG(0) << "GraphServer connect to Server:" << server_ip_port
               << " Failed! Try again.";
       std::string int_ip_port =
           GetIntTypeEndpoint(server_list[i].ip, server_list[i].port);
-      if (_pserver_channels[i]->Init(int_ip_port.c_str(), "", &options) != 0) {
+      if (InitBrpcChannel(_pserver_channels[i].get(), int_ip_port, options) !=
+          0) {
         LOG(ERROR) << "GraphServer connect to Server:" << int_ip_port
                    << " Failed!";
         return -1;
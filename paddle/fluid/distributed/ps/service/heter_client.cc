@@ -81,13 +81,13 @@ void HeterClient::CreateClient2XpuConnection() {
   xpu_channels_.resize(xpu_list_.size());
   for (size_t i = 0; i < xpu_list_.size(); ++i) {
     xpu_channels_[i].reset(new brpc::Channel());
-    if (xpu_channels_[i]->Init(xpu_list_[i].c_str(), "", &options) != 0) {
+    if (InitBrpcChannel(xpu_channels_[i].get(), xpu_list_[i], options) != 0) {
       VLOG(0) << "HeterClient channel init fail. Try Again";
       auto ip_port = paddle::string::Split(xpu_list_[i], ':');
       std::string ip = ip_port[0];
       int port = std::stoi(ip_port[1]);
       std::string int_ip_port = GetIntTypeEndpoint(ip, port);
-      if (xpu_channels_[i]->Init(int_ip_port.c_str(), "", &options) != 0) {
+      if (InitBrpcChannel(xpu_channels_[i].get(), int_ip_port, options) != 0) {
         LOG(ERROR) << "BrpcPsServer start failed, ip_port= " << int_ip_port;
       }
     }
@@ -95,15 +95,16 @@ void HeterClient::CreateClient2XpuConnection() {
   previous_xpu_channels_.resize(previous_xpu_list_.size());
   for (size_t i = 0; i < previous_xpu_list_.size(); ++i) {
     previous_xpu_channels_[i].reset(new brpc::Channel());
-    if (previous_xpu_channels_[i]->Init(
-            previous_xpu_list_[i].c_str(), "", &options) != 0) {
+    if (InitBrpcChannel(previous_xpu_channels_[i].get(),
+                        previous_xpu_list_[i],
+                        options) != 0) {
       VLOG(0) << "HeterClient channel init fail. Try Again";
       auto ip_port = paddle::string::Split(previous_xpu_list_[i], ':');
       std::string ip = ip_port[0];
       int port = std::stoi(ip_port[1]);
       std::string int_ip_port = GetIntTypeEndpoint(ip, port);
-      if (previous_xpu_channels_[i]->Init(int_ip_port.c_str(), "", &options) !=
-          0) {
+      if (InitBrpcChannel(
+              previous_xpu_channels_[i].get(), int_ip_port, options) != 0) {
         LOG(ERROR) << "BrpcPsServer start failed, ip_port= " << int_ip_port;
       }
     }
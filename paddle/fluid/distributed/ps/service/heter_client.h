@@ -113,15 +113,15 @@ class HeterClient {
     (*client_channels).resize(node_list.size());
     for (size_t i = 0; i < node_list.size(); ++i) {
       (*client_channels)[i].reset(new brpc::Channel());
-      if ((*client_channels)[i]->Init(node_list[i].c_str(), "", &options) !=
-          0) {
+      if (InitBrpcChannel(
+              (*client_channels)[i].get(), node_list[i], options) != 0) {
         VLOG(0) << "client channel init failed! try again";
         auto ip_port = ::paddle::string::Split(node_list[i], ':');
         std::string ip = ip_port[0];
         int port = std::stoi(ip_port[1]);
         std::string int_ip_port = GetIntTypeEndpoint(ip, port);
-        if ((*client_channels)[i]->Init(int_ip_port.c_str(), "", &options) !=
-            0) {
+        if (InitBrpcChannel(
+                (*client_channels)[i].get(), int_ip_port, options) != 0) {
           LOG(ERROR) << "client channel init failed! peer ip_port = "
                      << int_ip_port;
         }
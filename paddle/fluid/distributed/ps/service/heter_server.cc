@@ -34,6 +34,7 @@ void HeterServer::StartHeterService(bool need_encrypt) {
     options.mutable_ssl_options()->default_cert.certificate = "/cert.pem";
     options.mutable_ssl_options()->default_cert.private_key = "/key.pem";
   }
+  SetBrpcServerRdmaOptions(&options);
   if (server_.Start(endpoint_.c_str(), &options) != 0) {
     VLOG(0) << "HeterServer start fail. Try again.";
     auto ip_port = ::paddle::string::Split(endpoint_, ':');
@@ -69,6 +70,7 @@ void HeterServer::StartHeterInterService(bool need_encrypt) {
     options.mutable_ssl_options()->default_cert.certificate = "/cert.pem";
     options.mutable_ssl_options()->default_cert.private_key = "/key.pem";
   }
+  SetBrpcServerRdmaOptions(&options);
   if (server_inter_.Start(endpoint_inter_.c_str(), &options) != 0) {
     VLOG(4) << "switch inter server start fail. Try again.";
     auto ip_port = ::paddle::string::Split(endpoint_inter_, ':');
@@ -61,6 +61,15 @@ class PSClientClosure : public google::protobuf::Closure {
   std::vector<std::shared_ptr<std::promise<int32_t>>> _promises;
 };
 
+// One table of a PullSparseMultiTable request, the buffers are the same as
+// those of PullSparse.
+struct PullSparseRequest {
+  size_t table_id;
+  float **select_values;
+  const uint64_t *keys;
+  size_t num;
+};
+
 class PSClient {
  public:
   PSClient() {}
@@ -137,6 +146,29 @@ class PSClient {
                                           size_t num,
                                           bool is_training) = 0;
 
+  // 一次请求pull多个表, 每个server只发送一个请求
+  // 默认实现逐表调用PullSparse
+  virtual std::future<int32_t> PullSparseMultiTable(
+      const std::vector<PullSparseRequest> &requests, bool is_training) {
+    auto futures = std::make_shared<std::vector<std::future<int32_t>>>();
+    for (auto &request : requests) {
+      futures->push_back(PullSparse(request.select_values,
+                                    request.table_id,
+                                    request.keys,
+                                    request.num,
+                                    is_training));
+    }
+    return std::async(std::launch::deferred, [futures]() {
+      int32_t ret = 0;
+      for (auto &fut : *futures) {
+        if (fut.get() != 0) {
+          ret = -1;
+        }
+      }
+      return ret;
+    });
+  }
+
   virtual std::future<int32_t> PullSparseParam(float **select_values UNUSED,
                                                size_t table_id UNUSED,
                                                const uint64_t *keys UNUSED,
@@ -193,6 +225,17 @@ class PSClient {
     promise.set_value(-1);
     return fut;
   }
+  // 预取下一个pass的key，仅作为提示，未实现时直接返回
+  virtual std::future<int32_t> PrefetchSparse(const int shard_id UNUSED,
+                                              size_t table_id UNUSED,
+                                              const uint64_t *keys UNUSED,
+                                              size_t num UNUSED,
+                                              uint16_t pass_id UNUSED) {
+    std::promise<int32_t> promise;
+    std::future<int> fut = promise.get_future();
+    promise.set_value(0);
+    return fut;
+  }
 
   // 确保所有积攒中的请求都发起发送
   virtual std::future<int32_t> Flush() = 0;
@@ -285,6 +285,16 @@ int32_t PsLocalClient::Initialize() {
   return done();
 }
 
+::std::future<int32_t> PsLocalClient::PrefetchSparse(const int shard_id,
+                                                     size_t table_id,
+                                                     const uint64_t* keys,
+                                                     size_t num,
+                                                     uint16_t pass_id) {
+  auto* table_ptr = GetTable(table_id);
+  table_ptr->Prefetch(shard_id, keys, num, pass_id);
+  return done();
+}
+
 ::std::future<int32_t> PsLocalClient::PushSparseRawGradient(
     size_t table_id,
     const uint64_t* keys,
@@ -95,6 +95,12 @@ class PsLocalClient : public PSClient {
                                                 uint16_t pass_id,
                                                 size_t threshold);
 
+  virtual ::std::future<int32_t> PrefetchSparse(const int shard_id,
+                                                size_t table_id,
+                                                const uint64_t* keys,
+                                                size_t num,
+                                                uint16_t pass_id);
+
   virtual ::std::future<int32_t> PushSparse(size_t table_id,
                                             const uint64_t* keys,
                                             const float** update_values,
@@ -0,0 +1,244 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/ps/service/sparse_wire_codec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "paddle/phi/common/float16.h"
+
+namespace paddle {
+namespace distributed {
+
+namespace {
+// |---raw_dim(24bit)---|---value_codec(7bit)---|---compress_keys(1bit)---|
+constexpr uint32_t kCompressKeysBit = 1;
+constexpr uint32_t kValueCodecShift = 1;
+constexpr uint32_t kValueCodecMask = 0x7f;
+constexpr uint32_t kRawDimShift = 8;
+}  // namespace
+
+SparseWireCodec::SparseWireCodec(uint32_t flags) {
+  compress_keys_ = (flags & kCompressKeysBit) != 0;
+  uint32_t value_codec = (flags >> kValueCodecShift) & kValueCodecMask;
+  if (SparseValueCodec_IsValid(static_cast<int>(value_codec))) {
+    value_codec_ = static_cast<SparseValueCodec>(value_codec);
+  }
+  raw_dim_ = flags >> kRawDimShift;
+}
+
+SparseWireCodec SparseWireCodec::ForPull(
+    const SparseWireCodecParameter& param) {
+  SparseWireCodec codec;
+  codec.compress_keys_ = param.compress_keys();
+  codec.value_codec_ = param.pull_value_codec();
+  codec.raw_dim_ = param.pull_raw_dim();
+  return codec;
+}
+
+SparseWireCodec SparseWireCodec::ForPush(
+    const SparseWireCodecParameter& param) {
+  SparseWireCodec codec;
+  codec.compress_keys_ = param.compress_keys();
+  codec.value_codec_ = param.push_value_codec();
+  codec.raw_dim_ = param.push_raw_dim();
+  return codec;
+}
+
+uint32_t SparseWireCodec::Flags() const {
+  return (compress_keys_ ? kCompressKeysBit : 0) |
+         (static_cast<uint32_t>(value_codec_) << kValueCodecShift) |
+         (raw_dim_ << kRawDimShift);
+}
+
+void SparseWireCodec::AppendVarint(uint64_t x, std::string* out) {
+  while (x >= 0x80) {
+    out->push_back(static_cast<char>((x & 0x7f) | 0x80));
+    x >>= 7;
+  }
+  out->push_back(static_cast<char>(x));
+}
+
+size_t SparseWireCodec::ReadVarint(const char* data,
+                                   size_t size,
+                                   uint64_t* x) {
+  uint64_t result = 0;
+  for (size_t i = 0; i < size && i < 10; ++i) {
+    uint64_t byte = static_cast<uint8_t>(data[i]);
+    result |= (byte & 0x7f) << (7 * i);
+    if ((byte & 0x80) == 0) {
+      *x = result;
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+void SparseWireCodec::EncodeKeys(const uint64_t* keys,
+                                 size_t num,
+                                 std::string* out) const {
+  if (!compress_keys_) {
+    out->append(reinterpret_cast<const char*>(keys), num * sizeof(uint64_t));
+    return;
+  }
+  out->reserve(out->size() + num * 2);
+  uint64_t last_key = 0;
+  for (size_t i = 0; i < num; ++i) {
+    AppendVarint(keys[i] - last_key, out);
+    last_key = keys[i];
+  }
+}
+
+size_t SparseWireCodec::DecodeKeys(const char* data,
+                                   size_t size,
+                                   size_t num,
+                                   uint64_t* keys) const {
+  if (!compress_keys_) {
+    if (size < num * sizeof(uint64_t)) {
+      return 0;
+    }
+    memcpy(keys, data, num * sizeof(uint64_t));
+    return num * sizeof(uint64_t);
+  }
+  size_t pos = 0;
+  uint64_t last_key = 0;
+  for (size_t i = 0; i < num; ++i) {
+    uint64_t delta = 0;
+    size_t len = ReadVarint(data + pos, size - pos, &delta);
+    if (len == 0) {
+      return 0;
+    }
+    pos += len;
+    last_key += delta;
+    keys[i] = last_key;
+  }
+  return pos;
+}
+
+void SparseWireCodec::EncodeCounts(const uint32_t* counts,
+                                   size_t num,
+                                   std::string* out) const {
+  if (!compress_keys_) {
+    out->append(reinterpret_cast<const char*>(counts), num * sizeof(uint32_t));
+    return;
+  }
+  for (size_t i = 0; i < num; ++i) {
+    AppendVarint(counts[i], out);
+  }
+}
+
+size_t SparseWireCodec::DecodeCounts(const char* data,
+                                     size_t size,
+                                     size_t num,
+                                     uint32_t* counts) const {
+  if (!compress_keys_) {
+    if (size < num * sizeof(uint32_t)) {
+      return 0;
+    }
+    memcpy(counts, data, num * sizeof(uint32_t));
+    return num * sizeof(uint32_t);
+  }
+  size_t pos = 0;
+  for (size_t i = 0; i < num; ++i) {
+    uint64_t count = 0;
+    size_t len = ReadVarint(data + pos, size - pos, &count);
+    if (len == 0) {
+      return 0;
+    }
+    pos += len;
+    counts[i] = static_cast<uint32_t>(count);
+  }
+  return pos;
+}
+
+size_t SparseWireCodec::ValueSize(size_t dim) const {
+  size_t raw_dim = std::min<size_t>(raw_dim_, dim);
+  size_t packed_dim = dim - raw_dim;
+  switch (value_codec_) {
+    case SparseValueCodec::VALUE_FP16:
+      return raw_dim * sizeof(float) + packed_dim * sizeof(uint16_t);
+    case SparseValueCodec::VALUE_INT8:
+      return raw_dim * sizeof(float) +
+             (packed_dim == 0 ? 0 : sizeof(float) + packed_dim);
+    default:
+      return dim * sizeof(float);
+  }
+}
+
+void SparseWireCodec::EncodeValue(const float* value,
+                                  size_t dim,
+                                  char* out) const {
+  size_t raw_dim = value_codec_ == SparseValueCodec::VALUE_RAW
+                       ? dim
+                       : std::min<size_t>(raw_dim_, dim);
+  memcpy(out, value, raw_dim * sizeof(float));
+  out += raw_dim * sizeof(float);
+  if (raw_dim == dim) {
+    return;
+  }
+  if (value_codec_ == SparseValueCodec::VALUE_FP16) {
+    for (size_t i = raw_dim; i < dim; ++i) {
+      uint16_t x = phi::dtype::float16(value[i]).x;
+      memcpy(out, &x, sizeof(uint16_t));
+      out += sizeof(uint16_t);
+    }
+    return;
+  }
+  // int8: value = int8 * scale, with the largest abs value at 127
+  float max_abs = 0;
+  for (size_t i = raw_dim; i < dim; ++i) {
+    max_abs = std::max(max_abs, std::fabs(value[i]));
+  }
+  float scale = max_abs / 127;
+  memcpy(out, &scale, sizeof(float));
+  out += sizeof(float);
+  for (size_t i = raw_dim; i < dim; ++i) {
+    float q = scale == 0 ? 0 : std::round(value[i] / scale);
+    *out++ = static_cast<char>(
+        static_cast<int8_t>(std::min(127.0f, std::max(-127.0f, q))));
+  }
+}
+
+void SparseWireCodec::DecodeValue(const char* data,
+                                  size_t dim,
+                                  float* value) const {
+  size_t raw_dim = value_codec_ == SparseValueCodec::VALUE_RAW
+                       ? dim
+                       : std::min<size_t>(raw_dim_, dim);
+  memcpy(value, data, raw_dim * sizeof(float));
+  data += raw_dim * sizeof(float);
+  if (raw_dim == dim) {
+    return;
+  }
+  if (value_codec_ == SparseValueCodec::VALUE_FP16) {
+    for (size_t i = raw_dim; i < dim; ++i) {
+      phi::dtype::float16 x;
+      memcpy(&x.x, data, sizeof(uint16_t));
+      value[i] = static_cast<float>(x);
+      data += sizeof(uint16_t);
+    }
+    return;
+  }
+  float scale = 0;
+  memcpy(&scale, data, sizeof(float));
+  data += sizeof(float);
+  for (size_t i = raw_dim; i < dim; ++i) {
+    value[i] = static_cast<int8_t>(*data++) * scale;
+  }
+}
+
+}  // namespace distributed
+}  // namespace paddle
@@ -0,0 +1,81 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "paddle/fluid/distributed/the_one_ps.pb.h"
+
+namespace paddle {
+namespace distributed {
+
+/*
+The packing of the keys and values of one pull or push sparse request. The
+client sends Flags() as the second param of the request, so that the server
+decodes the request and encodes the pull response the same way, and a request
+without it is the raw format.
+
+Keys:   raw uint64, or varints of the deltas of the sorted keys
+Values: every value keeps its first raw_dim dims in fp32, the others are
+        |---fp32---| raw
+        |---fp16---| fp16
+        |---scale(fp32)---|---int8---| int8
+*/
+class SparseWireCodec {
+ public:
+  SparseWireCodec() {}
+  explicit SparseWireCodec(uint32_t flags);
+
+  static SparseWireCodec ForPull(const SparseWireCodecParameter& param);
+  static SparseWireCodec ForPush(const SparseWireCodecParameter& param);
+
+  uint32_t Flags() const;
+  bool IsRaw() const {
+    return !compress_keys_ && value_codec_ == SparseValueCodec::VALUE_RAW;
+  }
+  bool CompressKeys() const { return compress_keys_; }
+
+  // the keys must be sorted if the keys are compressed
+  void EncodeKeys(const uint64_t* keys, size_t num, std::string* out) const;
+  // returns the bytes read, 0 if data is not num keys
+  size_t DecodeKeys(const char* data,
+                    size_t size,
+                    size_t num,
+                    uint64_t* keys) const;
+  // uint32 counters, as varints if the keys are compressed
+  void EncodeCounts(const uint32_t* counts, size_t num, std::string* out) const;
+  size_t DecodeCounts(const char* data,
+                      size_t size,
+                      size_t num,
+                      uint32_t* counts) const;
+
+  size_t ValueSize(size_t dim) const;
+  void EncodeValue(const float* value, size_t dim, char* out) const;
+  void DecodeValue(const char* data, size_t dim, float* value) const;
+
+  static void AppendVarint(uint64_t x, std::string* out);
+  // returns the bytes read, 0 if data ends before the varint does
+  static size_t ReadVarint(const char* data, size_t size, uint64_t* x);
+
+ private:
+  bool compress_keys_ = false;
+  SparseValueCodec value_codec_ = SparseValueCodec::VALUE_RAW;
+  uint32_t raw_dim_ = 0;
+};
+
+}  // namespace distributed
+}  // namespace paddle
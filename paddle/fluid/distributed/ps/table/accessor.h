@@ -91,6 +91,9 @@ class ValueAccessor {
   virtual int Initialize() = 0;
 
   virtual AccessorInfo GetAccessorInfo() { return _accessor_info; }
+  const SparseWireCodecParameter& GetWireCodecParameter() const {
+    return _config.wire_codec_param();
+  }
 
   virtual bool NeedExtendMF(float* value UNUSED) { return false; }
   virtual bool HasMF(size_t size UNUSED) { return false; }
@@ -42,6 +42,10 @@ COMMON_DECLARE_int32(gpugraph_storage_mode);
 COMMON_DECLARE_uint64(gpugraph_slot_feasign_max_num);
 COMMON_DECLARE_bool(graph_metapath_split_opt);
 COMMON_DECLARE_double(graph_neighbor_size_percent);
+COMMON_DECLARE_bool(graph_build_csr_sampler);
+COMMON_DECLARE_bool(graph_use_alias_sampler);
+COMMON_DECLARE_bool(graph_use_clock_sample_cache);
+COMMON_DECLARE_int64(graph_sample_cache_bytes);
 
 PHI_DEFINE_EXPORTED_bool(graph_edges_split_only_by_src_id,
                          false,
@@ -1777,6 +1781,7 @@ void GraphShard::clear() {
   }
   bucket.clear();
   node_location.clear();
+  csr.clear();
 }
 
 GraphShard::~GraphShard() { clear(); }
@@ -1784,6 +1789,8 @@ GraphShard::~GraphShard() { clear(); }
 void GraphShard::delete_node(uint64_t id) {
   auto iter = node_location.find(id);
   if (iter == node_location.end()) return;
+  // the rows of the csr follow the positions in the bucket
+  csr.clear();
   int pos = iter->second;
   delete bucket[pos];
   if (pos != static_cast<int>(bucket.size()) - 1) {
@@ -2499,6 +2506,27 @@ int32_t GraphTable::build_sampler(int idx, std::string sample_type) {
       item->build_sampler(sample_type);
     }
   }
+  // the csr samples uniformly like the random sampler
+  if (FLAGS_graph_build_csr_sampler && sample_type == "random") {
+    build_csr(idx);
+  }
+  return 0;
+}
+
+int32_t GraphTable::build_csr(int idx) {
+  // load_edges may run in the shard task pools, so the shards are built in
+  // the load pool whose tasks never wait for other tasks.
+  std::vector<std::future<int>> tasks;
+  auto &shards = edge_shards[idx];
+  for (size_t i = 0; i < shards.size(); i++) {
+    tasks.push_back(load_node_edge_task_pool->enqueue([&shards, i]() -> int {
+      shards[i]->build_csr();
+      return 0;
+    }));
+  }
+  for (auto &t : tasks) {
+    t.get();
+  }
   return 0;
 }
 
@@ -2652,14 +2680,19 @@ std::pair<uint64_t, uint64_t> GraphTable::load_edges(
     // this optimization is only performed in load_edges function.
     VLOG(0) << "run in gpugraph mode!";
   } else {
-    std::string sample_type = "random";
-    VLOG(0) << "build sampler ... ";
+    std::string sample_type =
+        is_weighted_ && FLAGS_graph_use_alias_sampler ? "alias" : "random";
+    VLOG(0) << "build " << sample_type << " sampler ... ";
     for (auto &shard : edge_shards[idx]) {
       auto bucket = shard->get_bucket();
       for (auto item : bucket) {
         item->build_sampler(sample_type);
       }
     }
+    if (FLAGS_graph_build_csr_sampler && sample_type == "random") {
+      VLOG(0) << "build csr ... ";
+      build_csr(idx);
+    }
   }
 
   return {count, valid_count};
@@ -2704,6 +2737,14 @@ Node *GraphTable::find_node(GraphTableType table_type, int idx, uint64_t id) {
   Node *node = search_shards[index]->find_node(id);
   return node;
 }
+GraphShard *GraphTable::find_edge_shard(int idx, uint64_t id) {
+  size_t shard_id = id % shard_num;
+  if (shard_id >= shard_end || shard_id < shard_start) {
+    return nullptr;
+  }
+  return edge_shards[idx][shard_id - shard_start];
+}
+
 uint32_t GraphTable::get_thread_pool_index(uint64_t node_id) {
   return node_id % shard_num % shard_num_per_server % task_pool_size_;
 }
@@ -2794,6 +2835,22 @@ int32_t GraphTable::random_sample_nodes(GraphTableType table_type,
   memcpy(pointer, res.data(), actual_size);
   return 0;
 }
+int32_t GraphTable::make_neighbor_sample_cache(size_t size_limit,
+                                               size_t ttl) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (use_cache == false) {
+    if (FLAGS_graph_use_clock_sample_cache) {
+      clock_cache.reset(new ClockSampleCache<SampleKey, SampleResult>(
+          task_pool_size_, size_limit, ttl, FLAGS_graph_sample_cache_bytes));
+    } else {
+      scaled_lru.reset(new ScaledLRU<SampleKey, SampleResult>(
+          task_pool_size_, size_limit, ttl));
+    }
+    use_cache = true;
+  }
+  return 0;
+}
+
 int32_t GraphTable::random_sample_neighbors(
     int idx,
     uint64_t *node_ids,
@@ -2821,11 +2878,15 @@ int32_t GraphTable::random_sample_neighbors(
       LRUResponse response = LRUResponse::blocked;
       if (use_cache) {
         response =
-            scaled_lru->query(i, id_list[i].data(), id_list[i].size(), r);
+            clock_cache != nullptr
+                ? clock_cache->query(
+                      i, id_list[i].data(), id_list[i].size(), r)
+                : scaled_lru->query(i, id_list[i].data(), id_list[i].size(), r);
       }
       size_t index = 0;
       std::vector<SampleResult> sample_res;
       std::vector<SampleKey> sample_keys;
+      std::vector<int> sample_idx;
       auto &rng = _shards_task_rng_pool[i];
       for (size_t k = 0; k < id_list[i].size(); k++) {
         if (index < r.size() &&
@@ -2836,9 +2897,37 @@ int32_t GraphTable::random_sample_neighbors(
           index++;
         } else {
           node_id = id_list[i][k].node_key;
-          Node *node = find_node(GraphTableType::EDGE_TABLE, idx, node_id);
           int idy = seq_id[i][k];
           int &actual_size = actual_sizes[idy];
+          GraphShard *shard = find_edge_shard(idx, node_id);
+          int row = shard == nullptr ? -1 : shard->find_csr_row(node_id);
+          if (row >= 0) {
+            const GraphCSR &csr = shard->get_csr();
+            csr.sample_k(row, sample_size, rng, &sample_idx);
+            actual_size = sample_idx.size() *
+                          (need_weight ? (Node::id_size + Node::weight_size)
+                                       : Node::id_size);
+            char *buffer_addr = new char[actual_size];
+            if (response == LRUResponse::ok) {
+              sample_keys.emplace_back(idx, node_id, sample_size, need_weight);
+              sample_res.emplace_back(actual_size, buffer_addr);
+              buffers[idy] = sample_res.back().buffer;
+            } else {
+              buffers[idy].reset(buffer_addr, char_del);
+            }
+            for (int x : sample_idx) {
+              uint64_t id = csr.get_neighbor_id(row, x);
+              memcpy(buffer_addr, &id, Node::id_size);
+              buffer_addr += Node::id_size;
+              if (need_weight) {
+                float weight = csr.get_neighbor_weight(row, x);
+                memcpy(buffer_addr, &weight, Node::weight_size);
+                buffer_addr += Node::weight_size;
+              }
+            }
+            continue;
+          }
+          Node *node = find_node(GraphTableType::EDGE_TABLE, idx, node_id);
           if (node == nullptr) {
 #ifdef PADDLE_WITH_HETERPS
             if (search_level == 2) {
@@ -2857,7 +2946,8 @@ int32_t GraphTable::random_sample_neighbors(
             continue;
           }
           std::shared_ptr<char> &buffer = buffers[idy];
-          std::vector<int> res = node->sample_k(sample_size, rng);
+          std::vector<int> &res = sample_idx;
+          node->sample_k_into(sample_size, rng, &res);
           actual_size =
               res.size() * (need_weight ? (Node::id_size + Node::weight_size)
                                         : Node::id_size);
@@ -2889,8 +2979,13 @@ int32_t GraphTable::random_sample_neighbors(
         }
       }
       if (!sample_res.empty()) {
-        scaled_lru->insert(
-            i, sample_keys.data(), sample_res.data(), sample_keys.size());
+        if (clock_cache != nullptr) {
+          clock_cache->insert(
+              i, sample_keys.data(), sample_res.data(), sample_keys.size());
+        } else {
+          scaled_lru->insert(
+              i, sample_keys.data(), sample_res.data(), sample_keys.size());
+        }
       }
       return 0;
     }));
@@ -42,6 +42,7 @@
 #include "paddle/fluid/distributed/ps/table/accessor.h"
 #include "paddle/fluid/distributed/ps/table/common_table.h"
 #include "paddle/fluid/distributed/ps/table/graph/class_macro.h"
+#include "paddle/fluid/distributed/ps/table/graph/graph_csr.h"
 #include "paddle/fluid/distributed/ps/table/graph/graph_node.h"
 #include "paddle/fluid/distributed/ps/thirdparty/round_robin.h"
 #include "paddle/phi/core/utils/rw_lock.h"
@@ -133,6 +134,21 @@ class GraphShard {
   std::unordered_map<uint64_t, int> &get_node_location() {
     return node_location;
   }
+  // The csr is a snapshot of the bucket, it has to be rebuilt after the
+  // neighbors are changed and is dropped when nodes are deleted.
+  void build_csr() { csr.build(bucket); }
+  void clear_csr() { csr.clear(); }
+  const GraphCSR &get_csr() { return csr; }
+  // Returns the csr row of the node, or -1 if it is not in the csr.
+  int find_csr_row(uint64_t id) {
+    if (csr.empty()) return -1;
+    auto iter = node_location.find(id);
+    if (iter == node_location.end() ||
+        iter->second >= static_cast<int>(csr.row_num())) {
+      return -1;
+    }
+    return iter->second;
+  }
 
   void shrink_to_fit() {
     bucket.shrink_to_fit();
@@ -159,6 +175,7 @@ class GraphShard {
  public:
   std::unordered_map<uint64_t, int> node_location;
   std::vector<Node *> bucket;
+  GraphCSR csr;
 };
 
 enum LRUResponse { ok = 0, blocked = 1, err = 2 };
@@ -363,7 +380,8 @@ class ScaledLRU {
       while (true) {
         {
           std::unique_lock<std::mutex> lock(mutex_);
-          cv_.wait_for(lock, std::chrono::milliseconds(20000));
+          cv_.wait_for(
+              lock, std::chrono::milliseconds(20000), [this] { return stop; });
           if (stop) {
             return;
           }
@@ -373,12 +391,15 @@ class ScaledLRU {
         status.wait();
       }
     });
-    shrink_job.detach();
   }
   ~ScaledLRU() {
-    std::unique_lock<std::mutex> lock(mutex_);
-    stop = true;
-    cv_.notify_one();
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      stop = true;
+      cv_.notify_one();
+    }
+    // the shrink job uses the members, so it is joined before they go
+    shrink_job.join();
   }
   LRUResponse query(size_t index,
                     K *keys,
@@ -441,6 +462,205 @@ class ScaledLRU {
   std::shared_ptr<::ThreadPool> thread_pool;
   friend class RandomSampleLRU<K, V>;
 };
+
+// The bytes a cached value is charged for besides its entry.
+template <typename V>
+struct SampleCacheCharge {
+  size_t operator()(const V &data UNUSED) const { return 0; }
+};
+
+template <>
+struct SampleCacheCharge<SampleResult> {
+  size_t operator()(const SampleResult &data) const {
+    return data.actual_size;
+  }
+};
+
+// ClockSampleCache is a sharded cache of sample results with the query and
+// insert API of ScaledLRU. Every shard has its own lock and evicts with the
+// CLOCK algorithm: a hit only sets the reference bit of the entry instead of
+// moving it in a list, and the hand evicts the first entry whose bit is
+// clear. The shards are bounded by entries and by the bytes of the values,
+// so no global lock or background shrink is needed.
+//
+// As in ScaledLRU, an entry is dropped after it is hit ttl times, so that
+// the cached samples of a node are refreshed.
+template <typename K, typename V, typename Charge = SampleCacheCharge<V>>
+class ClockSampleCache {
+ public:
+  // size_limit is the number of entries and byte_limit the bytes of the
+  // values of all the shards, byte_limit = 0 means no limit on bytes.
+  ClockSampleCache(size_t shard_num,
+                   size_t size_limit,
+                   size_t ttl,
+                   size_t byte_limit = 0)
+      : ttl_(ttl), shards_(shard_num) {
+    size_t entry_limit = std::max<size_t>(1, size_limit / shard_num);
+    for (auto &shard : shards_) {
+      shard.entry_limit = entry_limit;
+      shard.byte_limit = byte_limit / shard_num;
+      shard.key_map.reserve(entry_limit);
+      shard.slots.reserve(entry_limit);
+    }
+  }
+
+  ClockSampleCache(const ClockSampleCache &) = delete;
+  ClockSampleCache &operator=(const ClockSampleCache &) = delete;
+
+  // Appends the cached keys with their values to res in the order of keys.
+  LRUResponse query(size_t index,
+                    K *keys,
+                    size_t length,
+                    std::vector<std::pair<K, V>> &res) {  // NOLINT
+    Shard &shard = shards_[index];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    size_t hit = 0;
+    for (size_t i = 0; i < length; i++) {
+      auto iter = shard.key_map.find(keys[i]);
+      if (iter == shard.key_map.end()) continue;
+      hit++;
+      Entry &entry = iter->second;
+      res.emplace_back(keys[i], entry.data);
+      if (--entry.ttl == 0) {
+        shard.erase(iter);
+      } else {
+        entry.referenced = true;
+      }
+    }
+    shard.query_count += length;
+    shard.hit_count += hit;
+    return LRUResponse::ok;
+  }
+
+  LRUResponse insert(size_t index, K *keys, V *data, size_t length) {
+    Shard &shard = shards_[index];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    size_t evicted = 0;
+    for (size_t i = 0; i < length; i++) {
+      size_t charge = charge_(data[i]);
+      auto iter = shard.key_map.find(keys[i]);
+      if (iter != shard.key_map.end()) {
+        shard.bytes -= iter->second.charge;
+        shard.erase(iter);
+      }
+      if (shard.byte_limit != 0 && charge > shard.byte_limit) continue;
+      while (!shard.key_map.empty() &&
+             (shard.key_map.size() >= shard.entry_limit ||
+              (shard.byte_limit != 0 &&
+               shard.bytes + charge > shard.byte_limit))) {
+        shard.evict();
+        evicted++;
+      }
+      auto res = shard.key_map.emplace(keys[i], Entry(data[i], ttl_, charge));
+      Entry &entry = res.first->second;
+      entry.slot = shard.take_slot(&res.first->first);
+      shard.bytes += charge;
+    }
+    shard.evict_count += evicted;
+    return LRUResponse::ok;
+  }
+
+  size_t get_ttl() { return ttl_; }
+
+  size_t size() {
+    return sum([](const Shard &shard) { return shard.key_map.size(); });
+  }
+  size_t query_count() {
+    return sum([](const Shard &shard) { return shard.query_count; });
+  }
+  size_t hit_count() {
+    return sum([](const Shard &shard) { return shard.hit_count; });
+  }
+  size_t evict_count() {
+    return sum([](const Shard &shard) { return shard.evict_count; });
+  }
+  double hit_rate() {
+    size_t query = query_count();
+    return query == 0 ? 0 : 1.0 * hit_count() / query;
+  }
+
+ private:
+  struct Entry {
+    Entry(const V &_data, size_t _ttl, size_t _charge)
+        : data(_data), ttl(_ttl), charge(_charge) {}
+    V data;
+    size_t ttl;
+    size_t charge;
+    size_t slot = 0;
+    bool referenced = false;
+  };
+
+  struct Shard {
+    using Iterator = typename std::unordered_map<K, Entry>::iterator;
+
+    void erase(Iterator iter) {
+      slots[iter->second.slot] = nullptr;
+      free_slots.push_back(iter->second.slot);
+      key_map.erase(iter);
+    }
+
+    // Moves the hand to the first entry whose reference bit is clear and
+    // evicts it, clearing the bits it passes.
+    void evict() {
+      while (true) {
+        if (hand >= slots.size()) hand = 0;
+        const K *key = slots[hand];
+        if (key != nullptr) {
+          auto iter = key_map.find(*key);
+          if (!iter->second.referenced) {
+            bytes -= iter->second.charge;
+            erase(iter);
+            hand++;
+            return;
+          }
+          iter->second.referenced = false;
+        }
+        hand++;
+      }
+    }
+
+    size_t take_slot(const K *key) {
+      size_t slot = 0;
+      if (!free_slots.empty()) {
+        slot = free_slots.back();
+        free_slots.pop_back();
+        slots[slot] = key;
+      } else {
+        slot = slots.size();
+        slots.push_back(key);
+      }
+      return slot;
+    }
+
+    std::mutex mutex;
+    // the keys point into key_map, whose nodes do not move on rehash
+    std::unordered_map<K, Entry> key_map;
+    std::vector<const K *> slots;
+    std::vector<size_t> free_slots;
+    size_t hand = 0;
+    size_t bytes = 0;
+    size_t entry_limit = 0;
+    size_t byte_limit = 0;
+    size_t query_count = 0;
+    size_t hit_count = 0;
+    size_t evict_count = 0;
+  };
+
+  template <typename Func>
+  size_t sum(Func &&func) {
+    size_t total = 0;
+    for (auto &shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      total += func(shard);
+    }
+    return total;
+  }
+
+  size_t ttl_;
+  Charge charge_;
+  std::vector<Shard> shards_;
+};
+
 enum GraphTableType { EDGE_TABLE, FEATURE_TABLE, NODE_TABLE };
 class GraphTable : public Table {
   class GraphNodeRank {
@@ -637,6 +857,7 @@ class GraphTable : public Table {
 
   int32_t get_server_index_by_id(uint64_t id);
   Node *find_node(GraphTableType table_type, int idx, uint64_t id);
+  GraphShard *find_edge_shard(int idx, uint64_t id);
   Node *find_node(GraphTableType table_type, uint64_t id);
   // query all ids rank
   void query_all_ids_rank(const size_t &total,
@@ -704,17 +925,7 @@ class GraphTable : public Table {
   void release_graph();
   void release_graph_edge();
   void release_graph_node();
-  virtual int32_t make_neighbor_sample_cache(size_t size_limit, size_t ttl) {
-    {
-      std::unique_lock<std::mutex> lock(mutex_);
-      if (use_cache == false) {
-        scaled_lru.reset(new ScaledLRU<SampleKey, SampleResult>(
-            task_pool_size_, size_limit, ttl));
-        use_cache = true;
-      }
-    }
-    return 0;
-  }
+  virtual int32_t make_neighbor_sample_cache(size_t size_limit, size_t ttl);
   virtual void load_node_weight(int type_id, int idx, std::string path);
 #ifdef PADDLE_WITH_HETERPS
   virtual void make_partitions(int idx, int64_t gb_size, int device_len);
@@ -770,6 +981,9 @@ class GraphTable : public Table {
 #endif
   virtual int32_t add_comm_edge(int idx, uint64_t src_id, uint64_t dst_id);
   virtual int32_t build_sampler(int idx, std::string sample_type = "random");
+  // Builds the contiguous neighbor storage of the edge shards, which
+  // random_sample_neighbors samples from instead of the nodes.
+  virtual int32_t build_csr(int idx);
   void set_slot_feature_separator(const std::string &ch);
   void set_feature_separator(const std::string &ch);
 
@@ -827,6 +1041,7 @@ class GraphTable : public Table {
   std::vector<std::shared_ptr<std::mt19937_64>> _shards_task_rng_pool;
   std::shared_ptr<::ThreadPool> load_node_edge_task_pool;
   std::shared_ptr<ScaledLRU<SampleKey, SampleResult>> scaled_lru;
+  std::shared_ptr<ClockSampleCache<SampleKey, SampleResult>> clock_cache;
   std::unordered_set<uint64_t> extra_nodes;
   std::unordered_map<uint64_t, size_t> extra_nodes_to_thread_index;
   bool use_cache, use_duplicate_nodes;
@@ -14,13 +14,150 @@
 
 #include "paddle/fluid/distributed/ps/table/ctr_accessor.h"
 
+#ifdef __F16C__
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 #include "glog/logging.h"
 #include "paddle/common/flags.h"
+#include "paddle/fluid/distributed/ps/table/sparse_sgd_rule_kernel.h"
 #include "paddle/fluid/platform/enforce.h"
+#include "paddle/phi/common/float16.h"
 #include "paddle/utils/string/string_helper.h"
 
 namespace paddle::distributed {
 
+int CtrCommonAccessor::EmbedxStorageDim(SparseValueStorage storage, int dim) {
+  switch (storage) {
+    case SparseValueStorage::STORAGE_FP16:
+    case SparseValueStorage::STORAGE_BF16:
+      return (dim + 1) / 2;
+    case SparseValueStorage::STORAGE_INT8:
+      // the scale, then the int8 of each dim
+      return dim == 0 ? 0 : 1 + (dim + 3) / 4;
+    default:
+      return dim;
+  }
+}
+
+// The loops below are branch free so that the compiler vectorizes them, and
+// fp16 takes the 8 dims at a time f16c conversions when the cpu has them.
+void CtrCommonAccessor::PackEmbedx(SparseValueStorage storage,
+                                   const float* w,
+                                   int dim,
+                                   float* packed) {
+  switch (storage) {
+    case SparseValueStorage::STORAGE_FP16: {
+      auto* h = reinterpret_cast<uint16_t*>(packed);
+      int i = 0;
+#ifdef __F16C__
+      for (; i + 8 <= dim; i += 8) {
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(h + i),
+            _mm256_cvtps_ph(_mm256_loadu_ps(w + i), _MM_FROUND_TO_NEAREST_INT));
+      }
+#endif
+      for (; i < dim; ++i) {
+        h[i] = phi::dtype::float16(w[i]).x;
+      }
+      if (dim % 2 != 0) {
+        h[dim] = 0;
+      }
+      return;
+    }
+    case SparseValueStorage::STORAGE_BF16: {
+      auto* h = reinterpret_cast<uint16_t*>(packed);
+      for (int i = 0; i < dim; ++i) {
+        uint32_t bits = 0;
+        memcpy(&bits, w + i, sizeof(bits));
+        // round to the nearest even
+        bits += 0x7fff + ((bits >> 16) & 1);
+        h[i] = static_cast<uint16_t>(bits >> 16);
+      }
+      if (dim % 2 != 0) {
+        h[dim] = 0;
+      }
+      return;
+    }
+    case SparseValueStorage::STORAGE_INT8: {
+      if (dim == 0) {
+        return;
+      }
+      // w = int8 * scale, with the largest abs value at 127
+      float max_abs = 0;
+      for (int i = 0; i < dim; ++i) {
+        max_abs = std::max(max_abs, std::fabs(w[i]));
+      }
+      float scale = max_abs / 127;
+      float inv_scale = scale == 0 ? 0 : 1 / scale;
+      packed[0] = scale;
+      auto* q = reinterpret_cast<int8_t*>(packed + 1);
+      for (int i = 0; i < dim; ++i) {
+        float x = std::min(127.0f, std::max(-127.0f, w[i] * inv_scale));
+        q[i] = static_cast<int8_t>(std::nearbyint(x));
+      }
+      for (int i = dim; i < (dim + 3) / 4 * 4; ++i) {
+        q[i] = 0;
+      }
+      return;
+    }
+    default:
+      memcpy(packed, w, dim * sizeof(float));
+      return;
+  }
+}
+
+void CtrCommonAccessor::UnpackEmbedx(SparseValueStorage storage,
+                                     const float* packed,
+                                     int dim,
+                                     float* w) {
+  switch (storage) {
+    case SparseValueStorage::STORAGE_FP16: {
+      const auto* h = reinterpret_cast<const uint16_t*>(packed);
+      int i = 0;
+#ifdef __F16C__
+      for (; i + 8 <= dim; i += 8) {
+        _mm256_storeu_ps(w + i,
+                         _mm256_cvtph_ps(_mm_loadu_si128(
+                             reinterpret_cast<const __m128i*>(h + i))));
+      }
+#endif
+      for (; i < dim; ++i) {
+        phi::dtype::float16 x;
+        x.x = h[i];
+        w[i] = static_cast<float>(x);
+      }
+      return;
+    }
+    case SparseValueStorage::STORAGE_BF16: {
+      const auto* h = reinterpret_cast<const uint16_t*>(packed);
+      for (int i = 0; i < dim; ++i) {
+        uint32_t bits = static_cast<uint32_t>(h[i]) << 16;
+        memcpy(w + i, &bits, sizeof(bits));
+      }
+      return;
+    }
+    case SparseValueStorage::STORAGE_INT8: {
+      if (dim == 0) {
+        return;
+      }
+      float scale = packed[0];
+      const auto* q = reinterpret_cast<const int8_t*>(packed + 1);
+      for (int i = 0; i < dim; ++i) {
+        w[i] = q[i] * scale;
+      }
+      return;
+    }
+    default:
+      memcpy(w, packed, dim * sizeof(float));
+      return;
+  }
+}
+
 int CtrCommonAccessor::Initialize() {
   auto name = _config.embed_sgd_param().name();
   _embed_sgd_rule = CREATE_PSCORE_CLASS(SparseValueSGDRule, name);
@@ -32,7 +169,9 @@ int CtrCommonAccessor::Initialize() {
                                _config.embedx_dim());
 
   common_feature_value.embed_sgd_dim = _embed_sgd_rule->Dim();
-  common_feature_value.embedx_dim = _config.embedx_dim();
+  _embedx_storage = _config.ctr_accessor_param().embedx_storage();
+  common_feature_value.embedx_dim =
+      EmbedxStorageDim(_embedx_storage, _config.embedx_dim());
   common_feature_value.embedx_sgd_dim = _embedx_sgd_rule->Dim();
   _show_click_decay_rate = _config.ctr_accessor_param().show_click_decay_rate();
   _ssd_unseenday_threshold =
@@ -55,8 +194,9 @@ void CtrCommonAccessor::InitAccessorInfo() {
   _accessor_info.select_size = _accessor_info.select_dim * sizeof(float);
   _accessor_info.update_dim = 4 + embedx_dim;
   _accessor_info.update_size = _accessor_info.update_dim * sizeof(float);
-  _accessor_info.mf_size =
-      (embedx_dim + common_feature_value.embedx_sgd_dim) * sizeof(float);
+  _accessor_info.mf_size = (common_feature_value.embedx_dim +
+                            common_feature_value.embedx_sgd_dim) *
+                           sizeof(float);
 }
 
 bool CtrCommonAccessor::Shrink(float* value) {
@@ -180,9 +320,20 @@ int32_t CtrCommonAccessor::Create(float** values, size_t num) {
     _embed_sgd_rule->InitValue(value + common_feature_value.EmbedWIndex(),
                                value + common_feature_value.EmbedG2SumIndex(),
                                zero_init);
-    _embedx_sgd_rule->InitValue(value + common_feature_value.EmbedxWIndex(),
-                                value + common_feature_value.EmbedxG2SumIndex(),
-                                false);
+    if (_embedx_storage == SparseValueStorage::STORAGE_FP32) {
+      _embedx_sgd_rule->InitValue(
+          value + common_feature_value.EmbedxWIndex(),
+          value + common_feature_value.EmbedxG2SumIndex(),
+          false);
+    } else {
+      float embedx_w[_config.embedx_dim()];  // NOLINT
+      _embedx_sgd_rule->InitValue(
+          embedx_w, value + common_feature_value.EmbedxG2SumIndex(), false);
+      PackEmbedx(_embedx_storage,
+                 embedx_w,
+                 _config.embedx_dim(),
+                 value + common_feature_value.EmbedxWIndex());
+    }
   }
   return 0;
 }
@@ -213,9 +364,10 @@ int32_t CtrCommonAccessor::Select(float** select_values,
         value[common_feature_value.ClickIndex()];
     select_value[CtrCommonPullValue::EmbedWIndex()] =
         value[common_feature_value.EmbedWIndex()];
-    memcpy(select_value + CtrCommonPullValue::EmbedxWIndex(),
-           value + common_feature_value.EmbedxWIndex(),
-           embedx_dim * sizeof(float));
+    UnpackEmbedx(_embedx_storage,
+                 value + common_feature_value.EmbedxWIndex(),
+                 embedx_dim,
+                 select_value + CtrCommonPullValue::EmbedxWIndex());
   }
   return 0;
 }
@@ -228,14 +380,14 @@ int32_t CtrCommonAccessor::Merge(float** update_values,
                                  size_t num) {
   auto embedx_dim = _config.embedx_dim();
   int total_dim = CtrCommonPushValue::Dim(embedx_dim);
+  // the slot is the first dim and is not merged
+  const auto& kernel = GetSparseSGDKernel();
   for (size_t value_item = 0; value_item < num; ++value_item) {
     float* update_value = update_values[value_item];
     const float* other_update_value = other_update_values[value_item];
-    for (int i = 0; i < total_dim; ++i) {
-      if (i != CtrCommonPushValue::SlotIndex()) {
-        update_value[i] += other_update_value[i];
-      }
-    }
+    kernel.add(total_dim - CtrCommonPushValue::SlotIndex() - 1,
+               update_value + CtrCommonPushValue::SlotIndex() + 1,
+               other_update_value + CtrCommonPushValue::SlotIndex() + 1);
   }
   return 0;
 }
@@ -270,11 +422,30 @@ int32_t CtrCommonAccessor::Update(float** update_values,
         update_value + common_feature_value.EmbedG2SumIndex(),
         push_value + CtrCommonPushValue::EmbedGIndex(),
         push_show);
-    _embedx_sgd_rule->UpdateValue(
-        update_value + common_feature_value.EmbedxWIndex(),
-        update_value + common_feature_value.EmbedxG2SumIndex(),
-        push_value + CtrCommonPushValue::EmbedxGIndex(),
-        push_show);
+    if (_embedx_storage == SparseValueStorage::STORAGE_FP32) {
+      _embedx_sgd_rule->UpdateValue(
+          update_value + common_feature_value.EmbedxWIndex(),
+          update_value + common_feature_value.EmbedxG2SumIndex(),
+          push_value + CtrCommonPushValue::EmbedxGIndex(),
+          push_show);
+    } else {
+      // the sgd rule updates embedx_w in fp32 with the fp32 states
+      auto embedx_dim = _config.embedx_dim();
+      float embedx_w[embedx_dim];  // NOLINT
+      UnpackEmbedx(_embedx_storage,
+                   update_value + common_feature_value.EmbedxWIndex(),
+                   embedx_dim,
+                   embedx_w);
+      _embedx_sgd_rule->UpdateValue(
+          embedx_w,
+          update_value + common_feature_value.EmbedxG2SumIndex(),
+          push_value + CtrCommonPushValue::EmbedxGIndex(),
+          push_show);
+      PackEmbedx(_embedx_storage,
+                 embedx_w,
+                 embedx_dim,
+                 update_value + common_feature_value.EmbedxWIndex());
+    }
   }
   return 0;
 }
@@ -324,7 +495,25 @@ std::string CtrCommonAccessor::ParseToString(const float* v, int param) {
   auto score = ShowClickScore(show, click);
   if (score >= _config.embedx_threshold() &&
       param > common_feature_value.EmbedxWIndex()) {
-    for (auto i = common_feature_value.EmbedxWIndex();
+    if (_embedx_storage != SparseValueStorage::STORAGE_FP32) {
+      // the saved embedx_w is in fp32 whatever the storage
+      auto embedx_dim = _config.embedx_dim();
+      float embedx_w[embedx_dim];  // NOLINT
+      UnpackEmbedx(_embedx_storage,
+                   v + common_feature_value.EmbedxWIndex(),
+                   embedx_dim,
+                   embedx_w);
+      for (uint32_t i = 0; i < embedx_dim; ++i) {
+        os << " " << embedx_w[i];
+      }
+    } else {
+      for (auto i = common_feature_value.EmbedxWIndex();
+           i < common_feature_value.EmbedxG2SumIndex();
+           ++i) {
+        os << " " << v[i];
+      }
+    }
+    for (auto i = common_feature_value.EmbedxG2SumIndex();
          i < common_feature_value.Dim();
          ++i) {
       os << " " << v[i];
@@ -334,6 +523,28 @@ std::string CtrCommonAccessor::ParseToString(const float* v, int param) {
 }
 
 int CtrCommonAccessor::ParseFromString(const std::string& str, float* value) {
+  if (_embedx_storage != SparseValueStorage::STORAGE_FP32) {
+    // parse the fp32 value, then pack its embedx_w
+    auto embedx_dim = _config.embedx_dim();
+    int w_index = common_feature_value.EmbedxWIndex();
+    int g2sum_index = common_feature_value.EmbedxG2SumIndex();
+    int sgd_dim = common_feature_value.embedx_sgd_dim;
+    float parsed[w_index + embedx_dim + sgd_dim];  // NOLINT
+    _embedx_sgd_rule->InitValue(parsed + w_index,
+                                parsed + w_index + embedx_dim);
+    auto ret = paddle::string::str_to_float(str.data(), parsed);
+    PADDLE_ENFORCE_GE(
+        ret,
+        6UL,
+        common::errors::InvalidArgument(
+            "Invalid return value. Expect more than 6. But received %d.", ret));
+    memcpy(value, parsed, w_index * sizeof(float));
+    PackEmbedx(_embedx_storage, parsed + w_index, embedx_dim, value + w_index);
+    memcpy(value + g2sum_index,
+           parsed + w_index + embedx_dim,
+           sgd_dim * sizeof(float));
+    return ret > w_index ? common_feature_value.Dim() : ret;
+  }
   _embedx_sgd_rule->InitValue(value + common_feature_value.EmbedxWIndex(),
                               value + common_feature_value.EmbedxG2SumIndex());
   auto ret = paddle::string::str_to_float(str.data(), value);
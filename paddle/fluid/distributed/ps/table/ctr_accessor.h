@@ -40,6 +40,8 @@ class CtrCommonAccessor : public ValueAccessor {
        std::vector<float> embed_g2sum;
        std::vector<float> embedx_w;
        std::<vector>float embedx_g2sum;
+       embedx_w is packed to embedx_dim floats if embedx_storage is not fp32,
+       see EmbedxStorageDim.
        */
 
     int Dim() { return 6 + embed_sgd_dim + embedx_sgd_dim + embedx_dim; }
@@ -196,11 +198,22 @@ class CtrCommonAccessor : public ValueAccessor {
   float _show_click_decay_rate;
   int32_t _ssd_unseenday_threshold;
   bool _show_scale = false;
+  SparseValueStorage _embedx_storage = SparseValueStorage::STORAGE_FP32;
 
  public:  // TODO(zhaocaibei123): it should be private, but we make it public
           // for unit test
   CtrCommonFeatureValue common_feature_value;
   float ShowClickScore(float show, float click);
+  // The floats embedx_w of dim dims takes in the value.
+  static int EmbedxStorageDim(SparseValueStorage storage, int dim);
+  static void PackEmbedx(SparseValueStorage storage,
+                         const float* w,
+                         int dim,
+                         float* packed);
+  static void UnpackEmbedx(SparseValueStorage storage,
+                           const float* packed,
+                           int dim,
+                           float* w);
   SparseValueSGDRule* _embed_sgd_rule;
   SparseValueSGDRule* _embedx_sgd_rule;
 };
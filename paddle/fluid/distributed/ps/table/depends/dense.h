@@ -24,6 +24,7 @@
 
 #include "paddle/common/flags.h"
 #include "paddle/fluid/distributed/common/utils.h"
+#include "paddle/fluid/distributed/ps/table/sparse_sgd_rule_kernel.h"
 
 namespace paddle {
 namespace distributed {
@@ -35,6 +36,9 @@ class DenseOptimizer {
   DenseOptimizer() {}
   explicit DenseOptimizer(const CommonAccessorParameter& accessor,
                           std::vector<std::vector<float>>* values) {}
+  // Called once per push before the blocks of the push are updated in
+  // parallel, for the state shared by all the blocks.
+  virtual void PrepareUpdate() {}
   virtual void Update(const float* update_values,
                       size_t num,
                       int begin,
@@ -62,9 +66,7 @@ class DSUM : public DenseOptimizer {
               size_t num,
               int begin,
               int end) override {
-    auto update_numel = end - begin;
-    GetBlas<float>().VADD(
-        update_numel, update_values + begin, param + begin, param + begin);
+    GetSparseSGDKernel().add(end - begin, param + begin, update_values + begin);
   }
 
   float* param;
@@ -90,15 +92,9 @@ class DSGD : public DenseOptimizer {
               size_t num,
               int begin,
               int end) override {
-    auto update_numel = end - begin;
-    std::vector<float> grads;
-    grads.resize(update_numel);
-
-    auto blas = GetBlas<float>();
     float lr = *(global_learning_rate_) * (*learning_rate);
-    blas.VCOPY(update_numel, update_values + begin, grads.data());
-    blas.SCAL(update_numel, lr, grads.data());
-    blas.VSUB(update_numel, param + begin, grads.data(), param + begin);
+    GetSparseSGDKernel().sub_scaled(
+        end - begin, param + begin, update_values + begin, lr);
   }
 
   float* learning_rate;
@@ -106,7 +102,6 @@ class DSGD : public DenseOptimizer {
 };
 
 // adam optimizer for dense tensor
-// TODO(zhaocaibei123): add CHECK(memory_dense_table.task_pool_size_) == 1
 class DAdam : public DenseOptimizer {
  public:
   explicit DAdam(const CommonAccessorParameter& accessor,
@@ -139,46 +134,31 @@ class DAdam : public DenseOptimizer {
     epsilon = 1.0e-8;
   }
 
-  // make sure memory_dense_table.task_pool_size_ == 1;
-  // otherwise, task_pool_size_ times beta1_pow/beta2_pow multiplication
-  void Update(const float* update_values,
-              size_t num,
-              int begin,
-              int end) override {
-    auto update_numel = end - begin;
-    std::vector<float> grad, grad2, tmp;
-    grad.resize(update_numel);
-    grad2.resize(update_numel);
-    tmp.resize(update_numel);
-
-    auto blas = GetBlas<float>();
-    blas.VCOPY(update_numel, update_values + begin, grad.data());
-    blas.VCOPY(update_numel, update_values + begin, grad2.data());
-
-    blas.SCAL(update_numel, 1 - beta1, grad.data());
-    blas.VSQUARE(update_numel, grad2.data(), grad2.data());
-    blas.SCAL(update_numel, 1 - beta2, grad2.data());
-
-    blas.SCAL(update_numel, beta1, moment1 + begin);
-    blas.VADD(update_numel, moment1 + begin, grad.data(), moment1 + begin);
-    blas.SCAL(update_numel, beta2, moment2 + begin);
-    blas.VADD(update_numel, moment2 + begin, grad2.data(), moment2 + begin);
-
+  // the beta pows advance once per push, however many blocks it has
+  void PrepareUpdate() override {
     beta1_pow[0] = beta1_pow[0] * beta1;
     beta2_pow[0] = beta2_pow[0] * beta2;
 
-    float lr_ = *(global_learning_rate_)*learning_rate[0];
-    lr_ *= sqrt(1 - beta2_pow[0]) / (1 - beta1_pow[0]);
-
-    float* tmp_ = tmp.data();
-    float eps_ = epsilon * sqrt(1 - beta2_pow[0]);
-
-    SQRT<float>(update_numel, moment2 + begin, tmp_);
-    ADD<float>(update_numel, tmp_, eps_, tmp_);
+    step_lr_ = *(global_learning_rate_)*learning_rate[0];
+    step_lr_ *= sqrt(1 - beta2_pow[0]) / (1 - beta1_pow[0]);
+    step_eps_ = epsilon * sqrt(1 - beta2_pow[0]);
+  }
 
-    blas.VDIV(update_numel, moment1 + begin, tmp_, tmp_);
-    blas.SCAL(update_numel, lr_, tmp_);
-    blas.VSUB(update_numel, param + begin, tmp_, param + begin);
+  void Update(const float* update_values,
+              size_t num,
+              int begin,
+              int end) override {
+    GetSparseSGDKernel().adam(end - begin,
+                              param + begin,
+                              moment1 + begin,
+                              moment2 + begin,
+                              update_values + begin,
+                              step_lr_,
+                              beta1,
+                              beta2,
+                              step_eps_,
+                              -INFINITY,
+                              INFINITY);
   }
 
   float* learning_rate;
@@ -193,6 +173,9 @@ class DAdam : public DenseOptimizer {
   float beta1;
   float beta2;
   float epsilon;
+
+  float step_lr_ = 0;
+  float step_eps_ = 0;
 };
 
 // adam optimizer for dense tensor
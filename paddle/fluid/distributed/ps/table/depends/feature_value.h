@@ -14,12 +14,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <vector>
 
 #include <mct/hash-map.hpp>
 
 #include "paddle/common/flags.h"
 #include "paddle/fluid/distributed/common/chunk_allocator.h"
+#include "paddle/fluid/distributed/ps/table/depends/feature_value_arena.h"
 
 namespace paddle {
 namespace distributed {
@@ -28,17 +30,65 @@ static const int CTR_SPARSE_SHARD_BUCKET_NUM_BITS = 6;
 static const size_t CTR_SPARSE_SHARD_BUCKET_NUM =
     static_cast<size_t>(1) << CTR_SPARSE_SHARD_BUCKET_NUM_BITS;
 
+// The floats of a feature, in the size class slabs of FeatureValueArena.
 class FixedFeatureValue {
  public:
   FixedFeatureValue() {}
-  ~FixedFeatureValue() {}
-  float* data() { return _data.data(); }
-  size_t size() { return _data.size(); }
-  void resize(size_t size) { _data.resize(size); }
-  void shrink_to_fit() { _data.shrink_to_fit(); }
+  FixedFeatureValue(const FixedFeatureValue& other) {
+    resize(other._size);
+    std::copy(other._data, other._data + other._size, _data);
+  }
+  FixedFeatureValue(FixedFeatureValue&& other) noexcept
+      : _data(other._data), _size(other._size), _capacity(other._capacity) {
+    other._data = nullptr;
+    other._size = 0;
+    other._capacity = 0;
+  }
+  FixedFeatureValue& operator=(const FixedFeatureValue& other) {
+    if (this != &other) {
+      _size = 0;
+      resize(other._size);
+      std::copy(other._data, other._data + other._size, _data);
+    }
+    return *this;
+  }
+  ~FixedFeatureValue() {
+    FeatureValueArena::Instance().Release(_data, _capacity);
+  }
+  float* data() { return _data; }
+  size_t size() { return _size; }
+  // Keeps the floats, and zeros the new ones, as std::vector does.
+  void resize(size_t size) {
+    if (size > _capacity) {
+      Reallocate(FeatureValueArena::RoundUp(size));
+    }
+    if (size > _size) {
+      std::fill(_data + _size, _data + size, 0.0f);
+    }
+    _size = static_cast<uint32_t>(size);
+  }
+  void shrink_to_fit() {
+    size_t capacity = FeatureValueArena::RoundUp(_size);
+    if (capacity != _capacity) {
+      Reallocate(capacity);
+    }
+  }
 
  private:
-  std::vector<float> _data;
+  void Reallocate(size_t capacity) {
+    auto& arena = FeatureValueArena::Instance();
+    float* data = capacity > 0 ? arena.Acquire(capacity) : nullptr;
+    if (_size > 0 && data != nullptr) {
+      std::copy(_data, _data + std::min<size_t>(_size, capacity), data);
+    }
+    arena.Release(_data, _capacity);
+    _data = data;
+    _capacity = static_cast<uint32_t>(capacity);
+  }
+
+  float* _data = nullptr;
+  uint32_t _size = 0;
+  uint32_t _capacity = 0;
 };
 
 template <class KEY, class VALUE>
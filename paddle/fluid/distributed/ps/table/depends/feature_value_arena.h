@@ -0,0 +1,149 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "paddle/fluid/platform/enforce.h"
+
+namespace paddle {
+namespace distributed {
+
+// The float arrays of the feature values, carved out of slabs of one size
+// class each. An array pays no allocator header, and a value grows in place
+// up to the capacity of its class, which suits the values of the dymf
+// accessors whose size depends on the mf dim of the feature. The arrays
+// beyond the largest class come from malloc. The slabs are kept for reuse
+// and never returned to the system.
+class FeatureValueArena {
+ public:
+  static FeatureValueArena& Instance() {
+    // never destroyed, so that the values released at exit still find it
+    static FeatureValueArena* arena = new FeatureValueArena();
+    return *arena;
+  }
+
+  // The capacity of the class of the arrays of size floats.
+  static size_t RoundUp(size_t size) {
+    if (size <= 64) {
+      return (size + 3) / 4 * 4;
+    } else if (size <= 256) {
+      return (size + 15) / 16 * 16;
+    } else if (size <= 1024) {
+      return (size + 63) / 64 * 64;
+    }
+    return size;
+  }
+
+  float* Acquire(size_t capacity) {
+    int size_class = ClassIndex(capacity);
+    if (size_class < 0) {
+      return static_cast<float*>(Malloc(capacity * sizeof(float)));
+    }
+    Stripe& stripe = _stripes[StripeIndex()];
+    std::lock_guard<std::mutex> guard(stripe.mutex);
+    FreeSlot*& free_list = stripe.free_lists[size_class];
+    if (free_list == nullptr) {
+      free_list = NewSlab(capacity);
+    }
+    FreeSlot* slot = free_list;
+    free_list = slot->next;
+    return reinterpret_cast<float*>(slot);
+  }
+
+  void Release(float* data, size_t capacity) {
+    if (data == nullptr) {
+      return;
+    }
+    int size_class = ClassIndex(capacity);
+    if (size_class < 0) {
+      free(data);
+      return;
+    }
+    // any stripe may take the slot, so it goes to the one of this thread
+    Stripe& stripe = _stripes[StripeIndex()];
+    std::lock_guard<std::mutex> guard(stripe.mutex);
+    FreeSlot* slot = reinterpret_cast<FreeSlot*>(data);
+    slot->next = stripe.free_lists[size_class];
+    stripe.free_lists[size_class] = slot;
+  }
+
+ private:
+  // 16 classes of 4 floats up to 64, 12 of 16 floats up to 256 and 12 of 64
+  // floats up to 1024
+  static constexpr int kNumClasses = 40;
+  static constexpr int kNumStripes = 16;
+  static constexpr size_t kSlabBytes = 256 * 1024;
+
+  struct FreeSlot {
+    FreeSlot* next;
+  };
+  struct alignas(64) Stripe {
+    std::mutex mutex;
+    FreeSlot* free_lists[kNumClasses] = {};
+  };
+
+  FeatureValueArena() = default;
+
+  static int ClassIndex(size_t capacity) {
+    if (capacity == 0 || capacity > 1024) {
+      return -1;
+    } else if (capacity <= 64) {
+      return static_cast<int>(capacity / 4) - 1;
+    } else if (capacity <= 256) {
+      return 15 + static_cast<int>((capacity - 64) / 16);
+    }
+    return 27 + static_cast<int>((capacity - 256) / 64);
+  }
+
+  static size_t StripeIndex() {
+    static thread_local size_t index =
+        std::hash<std::thread::id>()(std::this_thread::get_id()) % kNumStripes;
+    return index;
+  }
+
+  static void* Malloc(size_t bytes) {
+    void* ptr = malloc(bytes);
+    PADDLE_ENFORCE_NOT_NULL(
+        ptr,
+        common::errors::ResourceExhausted(
+            "Fail to alloc memory of %ld size for the feature values.",
+            bytes));
+    return ptr;
+  }
+
+  // Carves a new slab into the slots of the class, and returns their list.
+  static FreeSlot* NewSlab(size_t capacity) {
+    size_t slot_bytes = capacity * sizeof(float);
+    size_t num_slots = std::max<size_t>(kSlabBytes / slot_bytes, 64);
+    char* slab = static_cast<char*>(Malloc(num_slots * slot_bytes));
+    FreeSlot* free_list = nullptr;
+    for (size_t i = num_slots; i > 0; --i) {
+      FreeSlot* slot = reinterpret_cast<FreeSlot*>(slab + (i - 1) * slot_bytes);
+      slot->next = free_list;
+      free_list = slot;
+    }
+    return free_list;
+  }
+
+  Stripe _stripes[kNumStripes];
+};
+
+}  // namespace distributed
+}  // namespace paddle
@@ -0,0 +1,422 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "paddle/fluid/distributed/common/chunk_allocator.h"
+#include "paddle/fluid/distributed/ps/table/depends/feature_value.h"
+
+namespace paddle {
+namespace distributed {
+
+// Control bytes of a FlatHashBucket slot. A full slot stores the low 7 bits
+// of the hash, so that a probe compares 16 slots with a few instructions and
+// only touches the slots whose hash matches.
+static constexpr int8_t FLAT_HASH_CTRL_EMPTY = -128;
+static constexpr int8_t FLAT_HASH_CTRL_DELETED = -2;
+static constexpr size_t FLAT_HASH_GROUP_WIDTH = 16;
+
+struct FlatHashGroup {
+  explicit FlatHashGroup(const int8_t* ctrl) {
+#if defined(__SSE2__)
+    _ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+    memcpy(_ctrl, ctrl, FLAT_HASH_GROUP_WIDTH);
+#endif
+  }
+
+  // bit i is set if the slot i of the group is full and has the hash h2
+  uint32_t Match(int8_t h2) const {
+#if defined(__SSE2__)
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _ctrl));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < FLAT_HASH_GROUP_WIDTH; ++i) {
+      mask |= static_cast<uint32_t>(_ctrl[i] == h2) << i;
+    }
+    return mask;
+#endif
+  }
+
+  uint32_t MatchEmpty() const { return Match(FLAT_HASH_CTRL_EMPTY); }
+
+  // the full slots are the only ones with the sign bit cleared
+  uint32_t MatchEmptyOrDeleted() const {
+#if defined(__SSE2__)
+    return _mm_movemask_epi8(_ctrl);
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < FLAT_HASH_GROUP_WIDTH; ++i) {
+      mask |= static_cast<uint32_t>(_ctrl[i] < 0) << i;
+    }
+    return mask;
+#endif
+  }
+
+ private:
+#if defined(__SSE2__)
+  __m128i _ctrl;
+#else
+  int8_t _ctrl[FLAT_HASH_GROUP_WIDTH];
+#endif
+};
+
+// std::hash of integers is the identity, the keys are mixed so that both the
+// bucket (high bits) and the h2 byte (low bits) are well distributed.
+template <class KEY>
+struct FlatHashMix {
+  size_t operator()(const KEY& key) const {
+    uint64_t h = static_cast<uint64_t>(std::hash<KEY>()(key));
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return static_cast<size_t>(h);
+  }
+};
+
+// An open addressing hash map from KEY to an opaque pointer, the slots are
+// probed group by group (Swiss table style). Capacity is a multiple of the
+// group width, so a group never wraps around the end of the table.
+template <class KEY, class HASH = FlatHashMix<KEY>>
+class FlatHashBucket {
+ public:
+  struct Slot {
+    KEY key;
+    void* value;
+  };
+
+  FlatHashBucket() = default;
+  FlatHashBucket(const FlatHashBucket&) = delete;
+  FlatHashBucket& operator=(const FlatHashBucket&) = delete;
+
+  size_t size() const { return _size; }
+  size_t capacity() const { return _capacity; }
+  Slot& slot(size_t index) { return _slots[index]; }
+  const Slot& slot(size_t index) const { return _slots[index]; }
+  void max_load_factor(float x) { _max_load_factor = x; }
+
+  // Returns the index of the key, or capacity() if not found.
+  size_t find(const KEY& key, size_t hash) const {
+    if (_capacity == 0) {
+      return _capacity;
+    }
+    int8_t h2 = H2(hash);
+    size_t group_mask = _capacity / FLAT_HASH_GROUP_WIDTH - 1;
+    size_t group = H1(hash) & group_mask;
+    for (size_t step = 1;; ++step) {
+      size_t offset = group * FLAT_HASH_GROUP_WIDTH;
+      FlatHashGroup g(_ctrl.get() + offset);
+      for (uint32_t mask = g.Match(h2); mask != 0; mask &= mask - 1) {
+        size_t index = offset + __builtin_ctz(mask);
+        if (_slots[index].key == key) {
+          return index;
+        }
+      }
+      if (g.MatchEmpty() != 0 || step > group_mask) {
+        return _capacity;
+      }
+      // triangular probing visits every group of a power of 2 table
+      group = (group + step) & group_mask;
+    }
+  }
+
+  // Returns the index of the key and whether it is newly inserted, the value
+  // of a new slot is nullptr.
+  std::pair<size_t, bool> insert(const KEY& key, size_t hash) {
+    size_t index = find(key, hash);
+    if (index != _capacity) {
+      return {index, false};
+    }
+    if (_size + _deleted + 1 > MaxLoad(_capacity)) {
+      Rehash();
+    }
+    index = FindNonFull(hash);
+    if (_ctrl[index] == FLAT_HASH_CTRL_DELETED) {
+      --_deleted;
+    }
+    _ctrl[index] = H2(hash);
+    _slots[index].key = key;
+    _slots[index].value = nullptr;
+    ++_size;
+    return {index, true};
+  }
+
+  void erase(size_t index) {
+    // a probe stops at a group with an empty slot, so the slot can be reused
+    // directly unless the group was full
+    size_t offset = index / FLAT_HASH_GROUP_WIDTH * FLAT_HASH_GROUP_WIDTH;
+    if (FlatHashGroup(_ctrl.get() + offset).MatchEmpty() != 0) {
+      _ctrl[index] = FLAT_HASH_CTRL_EMPTY;
+    } else {
+      _ctrl[index] = FLAT_HASH_CTRL_DELETED;
+      ++_deleted;
+    }
+    _slots[index].key = KEY();
+    --_size;
+  }
+
+  // Returns the first full slot at or after index, or capacity() if none.
+  size_t next_full(size_t index) const {
+    while (index < _capacity && _ctrl[index] < 0) {
+      ++index;
+    }
+    return index;
+  }
+
+  void clear() {
+    _ctrl.reset();
+    _slots.reset();
+    _capacity = 0;
+    _size = 0;
+    _deleted = 0;
+  }
+
+ private:
+  static size_t H1(size_t hash) { return hash >> 7; }
+  static int8_t H2(size_t hash) { return static_cast<int8_t>(hash & 0x7f); }
+
+  size_t MaxLoad(size_t capacity) const {
+    return static_cast<size_t>(capacity * _max_load_factor);
+  }
+
+  size_t FindNonFull(size_t hash) const {
+    size_t group_mask = _capacity / FLAT_HASH_GROUP_WIDTH - 1;
+    size_t group = H1(hash) & group_mask;
+    for (size_t step = 1;; ++step) {
+      size_t offset = group * FLAT_HASH_GROUP_WIDTH;
+      uint32_t mask = FlatHashGroup(_ctrl.get() + offset).MatchEmptyOrDeleted();
+      if (mask != 0) {
+        return offset + __builtin_ctz(mask);
+      }
+      group = (group + step) & group_mask;
+    }
+  }
+
+  void Rehash() {
+    size_t capacity = _capacity == 0 ? FLAT_HASH_GROUP_WIDTH : _capacity;
+    // only drop the tombstones if they take a large part of the table
+    if (_size + 1 > MaxLoad(capacity) / 2) {
+      capacity = _capacity == 0 ? capacity : _capacity * 2;
+    }
+    std::unique_ptr<int8_t[]> old_ctrl = std::move(_ctrl);
+    std::unique_ptr<Slot[]> old_slots = std::move(_slots);
+    size_t old_capacity = _capacity;
+
+    _ctrl.reset(new int8_t[capacity]);
+    memset(_ctrl.get(), FLAT_HASH_CTRL_EMPTY, capacity);
+    _slots.reset(new Slot[capacity]);
+    _capacity = capacity;
+    _deleted = 0;
+    for (size_t i = 0; i < old_capacity; ++i) {
+      if (old_ctrl[i] >= 0) {
+        size_t hash = _hasher(old_slots[i].key);
+        size_t index = FindNonFull(hash);
+        _ctrl[index] = H2(hash);
+        _slots[index] = std::move(old_slots[i]);
+      }
+    }
+  }
+
+  std::unique_ptr<int8_t[]> _ctrl;
+  std::unique_ptr<Slot[]> _slots;
+  size_t _capacity = 0;
+  size_t _size = 0;
+  size_t _deleted = 0;
+  float _max_load_factor = 0.875;
+  HASH _hasher;
+};
+
+// A drop-in replacement of SparseTableShard, which keeps the keys in flat
+// open addressing buckets instead of mct::closed_hash_map. The values stay in
+// the chunks of ChunkAllocator, so the pointers returned by value_ptr() are
+// stable across rehashes as before.
+template <class KEY, class VALUE>
+struct alignas(64) FlatSparseTableShard {
+ public:
+  typedef FlatHashBucket<KEY> bucket_type;
+  struct iterator {
+    size_t index;
+    size_t bucket;
+    bucket_type* buckets;
+    friend bool operator==(const iterator& a, const iterator& b) {
+      return a.index == b.index && a.bucket == b.bucket;
+    }
+    friend bool operator!=(const iterator& a, const iterator& b) {
+      return !(a == b);
+    }
+    const KEY& key() const { return buckets[bucket].slot(index).key; }
+    VALUE& value() const { return *value_ptr(); }
+    VALUE* value_ptr() const {
+      return static_cast<VALUE*>(buckets[bucket].slot(index).value);
+    }
+    iterator& operator++() {
+      index = buckets[bucket].next_full(index + 1);
+      while (index == buckets[bucket].capacity() &&
+             bucket + 1 < CTR_SPARSE_SHARD_BUCKET_NUM) {
+        index = buckets[++bucket].next_full(0);
+      }
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator ret = *this;
+      ++*this;
+      return ret;
+    }
+  };
+  struct local_iterator {
+    size_t index;
+    bucket_type* bucket;
+    friend bool operator==(const local_iterator& a, const local_iterator& b) {
+      return a.index == b.index;
+    }
+    friend bool operator!=(const local_iterator& a, const local_iterator& b) {
+      return a.index != b.index;
+    }
+    const KEY& key() const { return bucket->slot(index).key; }
+    VALUE& value() const {
+      return *static_cast<VALUE*>(bucket->slot(index).value);
+    }
+    local_iterator& operator++() {
+      index = bucket->next_full(index + 1);
+      return *this;
+    }
+    local_iterator operator++(int) {
+      local_iterator ret = *this;
+      ++*this;
+      return ret;
+    }
+  };
+
+  ~FlatSparseTableShard() { clear(); }
+  bool empty() { return _alloc.size() == 0; }
+  size_t size() { return _alloc.size(); }
+  void set_max_load_factor(float x) {
+    for (size_t bucket = 0; bucket < CTR_SPARSE_SHARD_BUCKET_NUM; bucket++) {
+      _buckets[bucket].max_load_factor(x);
+    }
+  }
+  size_t bucket_count() { return CTR_SPARSE_SHARD_BUCKET_NUM; }
+  size_t bucket_size(size_t bucket) { return _buckets[bucket].size(); }
+  void clear() {
+    for (size_t bucket = 0; bucket < CTR_SPARSE_SHARD_BUCKET_NUM; bucket++) {
+      bucket_type& data = _buckets[bucket];
+      for (size_t i = data.next_full(0); i < data.capacity();
+           i = data.next_full(i + 1)) {
+        _alloc.release(static_cast<VALUE*>(data.slot(i).value));
+      }
+      data.clear();
+    }
+  }
+  iterator begin() {
+    size_t bucket = 0;
+    size_t index = _buckets[0].next_full(0);
+    while (index == _buckets[bucket].capacity() &&
+           bucket + 1 < CTR_SPARSE_SHARD_BUCKET_NUM) {
+      index = _buckets[++bucket].next_full(0);
+    }
+    return {index, bucket, _buckets};
+  }
+  iterator end() {
+    return {_buckets[CTR_SPARSE_SHARD_BUCKET_NUM - 1].capacity(),
+            CTR_SPARSE_SHARD_BUCKET_NUM - 1,
+            _buckets};
+  }
+  local_iterator begin(size_t bucket) {
+    return {_buckets[bucket].next_full(0), &_buckets[bucket]};
+  }
+  local_iterator end(size_t bucket) {
+    return {_buckets[bucket].capacity(), &_buckets[bucket]};
+  }
+  iterator find(const KEY& key) {
+    size_t hash = _hasher(key);
+    size_t bucket = compute_bucket(hash);
+    size_t index = _buckets[bucket].find(key, hash);
+    if (index == _buckets[bucket].capacity()) {
+      return end();
+    }
+    return {index, bucket, _buckets};
+  }
+  VALUE& operator[](const KEY& key) { return emplace(key).first.value(); }
+  std::pair<iterator, bool> insert(const KEY& key, const VALUE& val) {
+    return emplace(key, val);
+  }
+  std::pair<iterator, bool> insert(const KEY& key, VALUE&& val) {
+    return emplace(key, std::move(val));
+  }
+  template <class... ARGS>
+  std::pair<iterator, bool> emplace(const KEY& key, ARGS&&... args) {
+    size_t hash = _hasher(key);
+    size_t bucket = compute_bucket(hash);
+    auto res = _buckets[bucket].insert(key, hash);
+
+    if (res.second) {
+      _buckets[bucket].slot(res.first).value =
+          _alloc.acquire(std::forward<ARGS>(args)...);
+    }
+
+    return {{res.first, bucket, _buckets}, res.second};
+  }
+  iterator erase(iterator it) {
+    quick_erase(it);
+    // erasing never moves the other slots
+    return ++it;
+  }
+  void quick_erase(iterator it) {
+    _alloc.release(it.value_ptr());
+    _buckets[it.bucket].erase(it.index);
+  }
+  local_iterator erase(size_t bucket, local_iterator it) {
+    quick_erase(bucket, it);
+    return ++it;
+  }
+  void quick_erase(size_t bucket, local_iterator it) {
+    _alloc.release(&it.value());
+    _buckets[bucket].erase(it.index);
+  }
+  size_t erase(const KEY& key) {
+    auto it = find(key);
+    if (it == end()) {
+      return 0;
+    }
+    quick_erase(it);
+    return 1;
+  }
+  size_t compute_bucket(size_t hash) {
+    if (CTR_SPARSE_SHARD_BUCKET_NUM == 1) {
+      return 0;
+    } else {
+      return hash >> (sizeof(size_t) * 8 - CTR_SPARSE_SHARD_BUCKET_NUM_BITS);
+    }
+  }
+
+ private:
+  bucket_type _buckets[CTR_SPARSE_SHARD_BUCKET_NUM];
+  ChunkAllocator<VALUE> _alloc;
+  FlatHashMix<KEY> _hasher;
+};
+
+}  // namespace distributed
+}  // namespace paddle
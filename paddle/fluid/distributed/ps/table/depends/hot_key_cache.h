@@ -0,0 +1,81 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace paddle {
+namespace distributed {
+
+// A read-mostly copy of the selected pull values of the hottest keys. It is
+// rebuilt as a whole and published atomically, so that readers never take a
+// lock and never wait for the shard task pool.
+class HotKeyCache {
+ public:
+  class Snapshot {
+   public:
+    explicit Snapshot(size_t select_size) : _select_size(select_size) {}
+
+    void Add(uint64_t key, const float* select_value) {
+      _index.emplace(key, _values.size());
+      _values.insert(_values.end(), select_value, select_value + _select_size);
+    }
+
+    void Merge(Snapshot&& other) {
+      size_t base = _values.size();
+      for (auto& item : other._index) {
+        _index.emplace(item.first, base + item.second);
+      }
+      _values.insert(_values.end(), other._values.begin(), other._values.end());
+    }
+
+    // Copies the cached value of key to out and returns true on hit.
+    bool Get(uint64_t key, float* out) const {
+      auto itr = _index.find(key);
+      if (itr == _index.end()) {
+        return false;
+      }
+      memcpy(out, _values.data() + itr->second, _select_size * sizeof(float));
+      return true;
+    }
+
+    size_t Size() const { return _index.size(); }
+
+   private:
+    size_t _select_size;
+    std::unordered_map<uint64_t, size_t> _index;
+    std::vector<float> _values;
+  };
+
+  std::shared_ptr<const Snapshot> Get() const {
+    return std::atomic_load(&_snapshot);
+  }
+
+  void Publish(std::shared_ptr<const Snapshot> snapshot) {
+    std::atomic_store(&_snapshot, std::move(snapshot));
+  }
+
+  void Invalidate() { Publish(nullptr); }
+
+ private:
+  std::shared_ptr<const Snapshot> _snapshot;
+};
+
+}  // namespace distributed
+}  // namespace paddle
@@ -0,0 +1,93 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/ps/table/graph/graph_csr.h"
+
+#include <numeric>
+#include <unordered_map>
+
+namespace paddle::distributed {
+
+// A row whose degree is at most this times the sample size is sampled with
+// a Fisher-Yates shuffle on a local index array, which is cheaper than the
+// replace map of RandomSampler when most of the row is taken.
+static const int kDenseSampleRatio = 4;
+
+void GraphCSR::build(const std::vector<Node *> &bucket) {
+  clear();
+  offsets.resize(bucket.size() + 1);
+  offsets[0] = 0;
+  for (size_t i = 0; i < bucket.size(); i++) {
+    offsets[i + 1] = offsets[i] + bucket[i]->get_neighbor_size();
+  }
+  ids.resize(offsets.back());
+  weights.resize(offsets.back());
+  for (size_t i = 0; i < bucket.size(); i++) {
+    Node *node = bucket[i];
+    uint64_t start = offsets[i];
+    for (uint64_t j = 0; j < offsets[i + 1] - start; j++) {
+      ids[start + j] = node->get_neighbor_id(j);
+#if defined(PADDLE_WITH_HETERPS) && defined(PADDLE_WITH_PSCORE)
+      weights[start + j] = node->get_neighbor_weight(j);
+#else
+      weights[start + j] = 1.0;
+#endif
+    }
+  }
+}
+
+void GraphCSR::clear() {
+  std::vector<uint64_t>().swap(offsets);
+  std::vector<uint64_t>().swap(ids);
+  std::vector<float>().swap(weights);
+}
+
+void GraphCSR::sample_k(size_t row,
+                        int k,
+                        const std::shared_ptr<std::mt19937_64> &rng,
+                        std::vector<int> *res) const {
+  int n = degree(row);
+  res->clear();
+  if (k >= n) {
+    res->resize(n);
+    std::iota(res->begin(), res->end(), 0);
+    return;
+  }
+  res->reserve(k);
+  if (n <= k * kDenseSampleRatio) {
+    // Swapping in a real array picks exactly what the replace map picks.
+    std::vector<int> index(n);
+    std::iota(index.begin(), index.end(), 0);
+    while (k--) {
+      std::uniform_int_distribution<int> distrib(0, n - 1);
+      int rand_int = distrib(*rng);
+      res->push_back(index[rand_int]);
+      index[rand_int] = index[n - 1];
+      --n;
+    }
+    return;
+  }
+  std::unordered_map<int, int> replace_map;
+  while (k--) {
+    std::uniform_int_distribution<int> distrib(0, n - 1);
+    int rand_int = distrib(*rng);
+    auto iter = replace_map.find(rand_int);
+    res->push_back(iter == replace_map.end() ? rand_int : iter->second);
+    iter = replace_map.find(n - 1);
+    replace_map[rand_int] = iter == replace_map.end() ? n - 1 : iter->second;
+    --n;
+  }
+}
+
+}  // namespace paddle::distributed
@@ -0,0 +1,59 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "paddle/fluid/distributed/ps/table/graph/graph_node.h"
+
+namespace paddle {
+namespace distributed {
+
+// GraphCSR is an immutable compressed sparse row copy of the neighbors of
+// the nodes in a shard bucket. Row i holds the neighbors of bucket[i], and
+// the ids and weights of all the rows are stored contiguously, so sampling
+// a row touches two flat arrays instead of a Node, its sampler and its edge
+// blob.
+class GraphCSR {
+ public:
+  GraphCSR() {}
+  void build(const std::vector<Node *> &bucket);
+  void clear();
+  bool empty() const { return offsets.empty(); }
+  size_t row_num() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+  size_t degree(size_t row) const { return offsets[row + 1] - offsets[row]; }
+  uint64_t get_neighbor_id(size_t row, int idx) const {
+    return ids[offsets[row] + idx];
+  }
+  float get_neighbor_weight(size_t row, int idx) const {
+    return weights[offsets[row] + idx];
+  }
+  // Samples k neighbors of the row uniformly without replacement, returning
+  // the same indices as RandomSampler::sample_k for the same rng state.
+  void sample_k(size_t row,
+                int k,
+                const std::shared_ptr<std::mt19937_64> &rng,
+                std::vector<int> *res) const;
+
+ protected:
+  std::vector<uint64_t> offsets;
+  std::vector<uint64_t> ids;
+  std::vector<float> weights;
+};
+
+}  // namespace distributed
+}  // namespace paddle
@@ -48,6 +48,11 @@ class Node {
       int k UNUSED, const std::shared_ptr<std::mt19937_64> rng UNUSED) {
     return std::vector<int>();
   }
+  virtual void sample_k_into(int k UNUSED,
+                             const std::shared_ptr<std::mt19937_64> rng UNUSED,
+                             std::vector<int> *res) {
+    res->clear();
+  }
   virtual uint64_t get_neighbor_id(int idx UNUSED) { return 0; }
 #ifdef PADDLE_WITH_CUDA
   virtual half get_neighbor_weight(int idx UNUSED) { return 1.; }
@@ -104,6 +109,11 @@ class GraphNode : public Node {
       int k, const std::shared_ptr<std::mt19937_64> rng) {
     return sampler->sample_k(k, rng);
   }
+  virtual void sample_k_into(int k,
+                             const std::shared_ptr<std::mt19937_64> rng,
+                             std::vector<int> *res) {
+    sampler->sample_k_into(k, rng, res);
+  }
   virtual uint64_t get_neighbor_id(int idx) { return edges->get_id(idx); }
 #ifdef PADDLE_WITH_CUDA
   virtual half get_neighbor_weight(int idx) { return edges->get_weight(idx); }
@@ -14,9 +14,12 @@
 
 #include "paddle/fluid/distributed/ps/table/graph/graph_weighted_sampler.h"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <numeric>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "paddle/phi/core/generator.h"
 namespace paddle::distributed {
@@ -165,4 +168,127 @@ int WeightedSampler::sample(
   subtract_count_map[this]++;
   return return_idx;
 }
+
+// The number of rejected draws per sample after which AliasSampler stops
+// using the table and draws from the remaining weights directly.
+static const int kAliasMaxRejectRatio = 8;
+// Samples up to this size look for the drawn edges in the result itself.
+static const int kAliasLinearSearchSize = 64;
+
+void AliasSampler::build(GraphEdgeBlob *edges) {
+  this->edges = edges;
+  int n = edges->size();
+  alias.assign(n, 0);
+  prob.assign(n, 0);
+  if (n == 0) return;
+  std::vector<double> scaled(n);
+  double total = 0;
+  for (int i = 0; i < n; i++) {
+    scaled[i] = std::max(static_cast<double>(edges->get_weight(i)), 0.0);
+    total += scaled[i];
+  }
+  for (int i = 0; i < n; i++) {
+    // edges without any weight are sampled uniformly
+    scaled[i] = total > 0 ? scaled[i] * n / total : 1.0;
+  }
+  std::vector<int> small, large;
+  for (int i = 0; i < n; i++) {
+    (scaled[i] < 1.0 ? small : large).push_back(i);
+  }
+  while (!small.empty() && !large.empty()) {
+    int s = small.back(), l = large.back();
+    small.pop_back();
+    prob[s] = static_cast<uint16_t>(std::min(scaled[s] * 65536.0, 65535.0));
+    alias[s] = l;
+    scaled[l] -= 1.0 - scaled[s];
+    if (scaled[l] < 1.0) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // the rest are full up to rounding errors
+  for (int i : large) {
+    prob[i] = 65535;
+    alias[i] = i;
+  }
+  for (int i : small) {
+    prob[i] = 65535;
+    alias[i] = i;
+  }
+}
+
+std::vector<int> AliasSampler::sample_k(
+    int k, const std::shared_ptr<std::mt19937_64> rng) {
+  std::vector<int> sample_result;
+  sample_k_into(k, rng, &sample_result);
+  return sample_result;
+}
+
+void AliasSampler::sample_k_into(int k,
+                                 const std::shared_ptr<std::mt19937_64> rng,
+                                 std::vector<int> *res) {
+  int n = alias.size();
+  res->clear();
+  if (k >= n) {
+    res->resize(n);
+    std::iota(res->begin(), res->end(), 0);
+    return;
+  }
+  res->reserve(k);
+  std::unordered_set<int> drawn;
+  bool linear = k <= kAliasLinearSearchSize;
+  std::uniform_int_distribution<int> column(0, n - 1);
+  std::uniform_int_distribution<int> coin(0, 65535);
+  int rejected = 0;
+  while (static_cast<int>(res->size()) < k) {
+    int c = column(*rng);
+    int x = coin(*rng) < prob[c] ? c : static_cast<int>(alias[c]);
+    bool seen = linear ? std::find(res->begin(), res->end(), x) != res->end()
+                       : !drawn.insert(x).second;
+    if (!seen) {
+      res->push_back(x);
+    } else if (++rejected > kAliasMaxRejectRatio * k) {
+      sample_remaining(k, rng, res);
+      return;
+    }
+  }
+}
+
+void AliasSampler::sample_remaining(
+    int k,
+    const std::shared_ptr<std::mt19937_64> &rng,
+    std::vector<int> *res) {
+  int n = alias.size();
+  std::vector<double> weights(n);
+  for (int i = 0; i < n; i++) {
+    weights[i] = std::max(static_cast<double>(edges->get_weight(i)), 0.0);
+  }
+  for (int x : *res) {
+    weights[x] = -1;
+  }
+  while (static_cast<int>(res->size()) < k) {
+    double total = 0;
+    int remaining = 0;
+    for (int i = 0; i < n; i++) {
+      if (weights[i] >= 0) {
+        total += weights[i];
+        remaining++;
+      }
+    }
+    // the remaining edges without any weight are drawn uniformly
+    std::uniform_real_distribution<double> distrib(0,
+                                                   total > 0 ? total : 1.0);
+    double query_weight = distrib(*rng) * (total > 0 ? 1.0 : remaining);
+    int x = -1;
+    for (int i = 0; i < n; i++) {
+      if (weights[i] < 0) continue;
+      x = i;
+      double w = total > 0 ? weights[i] : 1.0;
+      if (query_weight < w) break;
+      query_weight -= w;
+    }
+    res->push_back(x);
+    weights[x] = -1;
+  }
+}
 }  // namespace paddle::distributed
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include <cstdint>
 #include <ctime>
 #include <memory>
 #include <random>
@@ -29,6 +30,12 @@ class Sampler {
   virtual void build(GraphEdgeBlob *edges) = 0;
   virtual std::vector<int> sample_k(
       int k, const std::shared_ptr<std::mt19937_64> rng) = 0;
+  // Same as sample_k but writes to res, so the caller can reuse the buffer.
+  virtual void sample_k_into(int k,
+                             const std::shared_ptr<std::mt19937_64> rng,
+                             std::vector<int> *res) {
+    *res = sample_k(k, rng);
+  }
 };
 
 class RandomSampler : public Sampler {
@@ -62,5 +69,30 @@ class WeightedSampler : public Sampler {
       std::unordered_map<WeightedSampler *, int> &subtract_count_map,  // NOLINT
       float &subtract);                                                // NOLINT
 };
+
+// AliasSampler samples the edges by weight without replacement like
+// WeightedSampler, but draws from an alias table in O(1) and rejects the
+// edges drawn before. The table takes 6 bytes per edge, the probabilities
+// are quantized to 1/65536.
+class AliasSampler : public Sampler {
+ public:
+  virtual ~AliasSampler() {}
+  virtual void build(GraphEdgeBlob *edges);
+  virtual std::vector<int> sample_k(int k,
+                                    const std::shared_ptr<std::mt19937_64> rng);
+  virtual void sample_k_into(int k,
+                             const std::shared_ptr<std::mt19937_64> rng,
+                             std::vector<int> *res);
+  GraphEdgeBlob *edges;
+
+ private:
+  // Draws the rest of the k edges exactly from the remaining weights, used
+  // when the heavy edges are taken and the table keeps hitting them.
+  void sample_remaining(int k,
+                        const std::shared_ptr<std::mt19937_64> &rng,
+                        std::vector<int> *res);
+  std::vector<uint32_t> alias;
+  std::vector<uint16_t> prob;
+};
 }  // namespace distributed
 }  // namespace paddle
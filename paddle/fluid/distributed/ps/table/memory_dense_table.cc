@@ -14,12 +14,23 @@
 
 #include "paddle/fluid/distributed/ps/table/memory_dense_table.h"
 
+#include <thread>
+
 #include "paddle/fluid/platform/enforce.h"
 
 namespace paddle::distributed {
 
 int FLAGS_pslib_table_save_max_retry_dense = 3;
 
+namespace {
+
+// the floats of a cache line
+constexpr int kCacheLineFloats = 64 / sizeof(float);
+// the copies of a block a pull tries before it takes one written meanwhile
+constexpr int kMaxPullRetries = 16;
+
+}  // namespace
+
 void MemoryDenseTable::CreateInitializer(const std::string &attr,
                                          const std::string &name) {
   auto slices = string::split_string<std::string>(attr, "&");
@@ -95,9 +106,30 @@ int32_t MemoryDenseTable::InitializeValue() {
           << " fixed_len_params_dim: " << fixed_len_params_dim_;
 
   pull_reservoir_ = ReservoirValue<float>(param_dim_);
+  InitializeBlocks();
   return 0;
 }
 
+void MemoryDenseTable::InitializeBlocks() {
+  blocks_ = bucket(param_dim_, task_pool_size_);
+  // The blocks start on the cache lines of the param, so that the pools do
+  // not write the same lines. The large arrays of the table come from mmap
+  // with the same offset, so the lines of the other arrays line up too.
+  auto addr = values_.empty()
+                  ? 0
+                  : reinterpret_cast<uintptr_t>(values_[param_idx_].data());
+  int offset = static_cast<int>((64 - addr % 64) % 64 / sizeof(float));
+  for (size_t i = 1; i + 1 < blocks_.size(); ++i) {
+    int line = (blocks_[i] - offset + kCacheLineFloats - 1) /
+               kCacheLineFloats * kCacheLineFloats;
+    blocks_[i] = std::min(std::max(line + offset, blocks_[i - 1]), param_dim_);
+  }
+  block_versions_.reset(new std::atomic<uint64_t>[task_pool_size_]);
+  for (int i = 0; i < task_pool_size_; ++i) {
+    block_versions_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
 int32_t MemoryDenseTable::InitializeOptimizer() {
   auto common = _config.common();
   auto name = common.name();
@@ -154,8 +186,29 @@ int32_t MemoryDenseTable::Push(TableContext &context) {
 }
 
 int32_t MemoryDenseTable::PullDense(float *pull_values, size_t num) {
-  std::copy(
-      values_[param_idx_].begin(), values_[param_idx_].end(), pull_values);
+  const float *param = values_[param_idx_].data();
+  for (int block = 0; block < task_pool_size_; ++block) {
+    auto begin = blocks_[block];
+    auto end = blocks_[block + 1];
+    auto &version = block_versions_[block];
+    for (int retry = 0;; ++retry) {
+      uint64_t before = version.load(std::memory_order_acquire);
+      if (before % 2 == 1 && retry < kMaxPullRetries) {
+        std::this_thread::yield();
+        continue;
+      }
+      std::copy(param + begin, param + end, pull_values + begin);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (version.load(std::memory_order_relaxed) == before) {
+        break;
+      }
+      if (retry >= kMaxPullRetries) {
+        VLOG(3) << "pull dense block " << block
+                << " is written during the copy";
+        break;
+      }
+    }
+  }
   return 0;
 }
 
@@ -165,7 +218,14 @@ int32_t MemoryDenseTable::PushDenseParam(const float *values, size_t num) {
       param_dim_,
       common::errors::InvalidArgument(
           "update dense param numel expected %d, but got %d", param_dim_, num));
+  std::lock_guard<std::mutex> guard(push_mutex_);
+  for (int block = 0; block < task_pool_size_; ++block) {
+    block_versions_[block].fetch_add(1, std::memory_order_acq_rel);
+  }
   std::copy_n(values, param_dim_, values_[param_idx_].begin());
+  for (int block = 0; block < task_pool_size_; ++block) {
+    block_versions_[block].fetch_add(1, std::memory_order_release);
+  }
   return 0;
 }
 
@@ -197,15 +257,19 @@ int32_t MemoryDenseTable::_PushDense(const float *values, size_t num) {
       common::errors::InvalidArgument(
           "update dense numel expected %d, but got %d", param_dim_, num));
 
-  std::vector<int> buckets = bucket(param_dim_, task_pool_size_);
+  std::lock_guard<std::mutex> guard(push_mutex_);
+  optimizer_->PrepareUpdate();
   std::vector<std::future<int>> tasks(task_pool_size_);
 
   for (int shard_id = 0; shard_id < task_pool_size_; ++shard_id) {
     tasks[shard_id] = _shards_task_pool[shard_id]->enqueue(
-        [this, shard_id, &buckets, &values]() -> int {
-          auto begin = buckets[shard_id];
-          auto end = buckets[shard_id + 1];
+        [this, shard_id, &values]() -> int {
+          auto begin = blocks_[shard_id];
+          auto end = blocks_[shard_id + 1];
+          auto &version = block_versions_[shard_id];
+          version.fetch_add(1, std::memory_order_acq_rel);
           optimizer_->Update(values, param_dim_, begin, end);
+          version.fetch_add(1, std::memory_order_release);
           return 0;
         });
   }
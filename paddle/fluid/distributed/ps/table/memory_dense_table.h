@@ -18,6 +18,9 @@
 #include <assert.h>
 #include <pthread.h>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
 
 #include "Eigen/Dense"
@@ -66,6 +69,8 @@ class MemoryDenseTable : public Table {
 
  protected:
   int32_t _PushDense(const float* values, size_t num);
+  // Splits the param into the blocks of the shard task pools.
+  void InitializeBlocks();
 
  private:
   const int task_pool_size_ = 10;
@@ -81,6 +86,14 @@ class MemoryDenseTable : public Table {
   int total_dim_ = 0;
   int fixed_len_params_dim_ = 0;    // used for save/load
   std::vector<int> param_col_ids_;  // used for save/load
+  // The bounds of the blocks of the param, one per shard task pool, and the
+  // seqlock versions of the blocks, odd while a block is written, so that a
+  // pull copies each block unchanged without waiting for the pushes.
+  std::vector<int> blocks_;
+  std::unique_ptr<std::atomic<uint64_t>[]> block_versions_;
+  // one push at a time, since the optimizers prepare the state of a push for
+  // all its blocks
+  std::mutex push_mutex_;
 };
 
 }  // namespace distributed
@@ -13,11 +13,13 @@
 // limitations under the License.
 
 #include <omp.h>
+#include <chrono>  // NOLINT
 #include <sstream>
 
 #include "glog/logging.h"
 #include "paddle/fluid/distributed/common/cost_timer.h"
 #include "paddle/fluid/distributed/common/local_random.h"
+#include "paddle/fluid/distributed/common/shard_task_waiter.h"
 #include "paddle/fluid/distributed/common/topk_calculator.h"
 #include "paddle/fluid/distributed/ps/table/memory_sparse_table.h"
 #include "paddle/fluid/framework/archive.h"
@@ -25,6 +27,9 @@
 
 // #include "boost/lexical_cast.hpp"
 #include "paddle/fluid/platform/enforce.h"
+#include "paddle/phi/core/os_info.h"
+
+COMMON_DECLARE_bool(numa_aware_placement);
 
 PD_DEFINE_bool(pserver_print_missed_key_num_every_push,
                false,
@@ -38,9 +43,39 @@ PD_DEFINE_bool(pserver_enable_create_feasign_randomly,
 PD_DEFINE_int32(pserver_table_save_max_retry,
                 3,
                 "pserver_table_save_max_retry");
+PD_DEFINE_int32(pserver_hot_key_cache_size,
+                0,
+                "max number of the hottest keys (by show) whose select values "
+                "are replicated out of the shards to serve pulls without the "
+                "shard task pool, 0 means disabled");
+PD_DEFINE_int32(pserver_hot_key_cache_refresh_push_num,
+                100,
+                "the hot key cache is rebuilt after this number of pushes and "
+                "on flush, which bounds the staleness of the cached values");
+PD_DEFINE_bool(pserver_enable_delta_save,
+               false,
+               "track the keys changed since the last checkpoint, so that the "
+               "sparse table can be saved as a delta by save_param 6 and 7");
+PD_DEFINE_bool(pserver_enable_background_shrink,
+               false,
+               "shrink the sparse table in a background thread one bucket at "
+               "a time between the pulls and pushes, so that shrink returns "
+               "at once instead of blocking on a scan of the table");
+PD_DEFINE_int32(pserver_background_shrink_interval_us,
+                100,
+                "the pause between the buckets swept by the background "
+                "shrink, which bounds its share of the shard task pools");
 
 namespace paddle::distributed {
 
+namespace {
+// A delta file is a header of the magic, the version and the row number, the
+// rows of the key, the value size and the values, where the size of a deleted
+// key is 0, and the magic again to detect a truncated file.
+constexpr uint32_t kDeltaFileMagic = 0x44505350;  // "PSPD"
+constexpr uint32_t kDeltaFileVersion = 1;
+}  // namespace
+
 int32_t MemorySparseTable::Initialize() {
   auto &profiler = CostProfiler::instance();
   profiler.register_profiler("pserver_sparse_update_all");
@@ -50,10 +85,38 @@ int32_t MemorySparseTable::Initialize() {
   for (auto &shards_task : _shards_task_pool) {
     shards_task.reset(new ::ThreadPool(1));
   }
+  if (FLAGS_numa_aware_placement && phi::GetNumaNodeCount() > 1) {
+    // a shard is always handled by the thread of its pool, so the values it
+    // creates are on the node of the thread
+    const int num_nodes = phi::GetNumaNodeCount();
+    std::vector<std::future<bool>> tasks(_shards_task_pool.size());
+    for (size_t i = 0; i < _shards_task_pool.size(); ++i) {
+      int node = static_cast<int>(i * num_nodes / _shards_task_pool.size());
+      tasks[i] = _shards_task_pool[i]->enqueue(
+          [node]() { return phi::BindCurrentThreadToNumaNode(node); });
+    }
+    for (size_t i = 0; i < tasks.size(); ++i) {
+      if (!tasks[i].get()) {
+        LOG(WARNING) << "Fail to bind the shard task pool " << i
+                     << " to a NUMA node";
+      }
+    }
+  }
   VLOG(0) << "initialize MemorySparseTable succ";
   return 0;
 }
 
+MemorySparseTable::~MemorySparseTable() {
+  if (_shrink_thread.joinable()) {
+    {
+      std::lock_guard<std::mutex> guard(_shrink_mutex);
+      _shrink_stop = true;
+    }
+    _shrink_cv.notify_all();
+    _shrink_thread.join();
+  }
+}
+
 int32_t MemorySparseTable::InitializeValue() {
   _sparse_table_shard_num = static_cast<int>(_config.shard_num());
   _avg_local_shard_num =
@@ -77,6 +140,10 @@ int32_t MemorySparseTable::InitializeValue() {
           << " _use_gpu_graph:" << _use_gpu_graph;
 
   _local_shards.reset(new shard_type[_real_local_shard_num]);
+  _enable_delta_save = FLAGS_pserver_enable_delta_save;
+  if (_enable_delta_save) {
+    _dirty_keys.resize(_real_local_shard_num);
+  }
 
   if (_config.enable_revert()) {
     // calculate merged shard number based on config param;
@@ -122,6 +189,8 @@ int32_t MemorySparseTable::InitializeValue() {
 
 int32_t MemorySparseTable::Load(const std::string &path,
                                 const std::string &param) {
+  std::lock_guard<std::mutex> shrink_guard(_shrink_slice_mutex);
+  _hot_key_cache.Invalidate();
   std::string table_path = TableDir(path);
   auto file_list = _afs_client.list(table_path);
 
@@ -145,6 +214,13 @@ int32_t MemorySparseTable::Load(const std::string &path,
   if (load_param == 5) {
     return LoadPatch(file_list, load_param);
   }
+  if (load_param == 6) {
+    return LoadDelta(file_list);
+  }
+  // the later deltas are relative to the loaded checkpoint
+  for (auto &dirty_keys : _dirty_keys) {
+    dirty_keys.clear();
+  }
 
   size_t file_start_idx = _shard_idx * _avg_local_shard_num;
 
@@ -330,6 +406,88 @@ int32_t MemorySparseTable::LoadPatch(const std::vector<std::string> &file_list,
   return 0;
 }
 
+int32_t MemorySparseTable::LoadDelta(
+    const std::vector<std::string> &file_list) {
+  size_t file_start_idx = _shard_idx * _avg_local_shard_num;
+  if (file_start_idx >= file_list.size()) {
+    return 0;
+  }
+  size_t feature_value_size =
+      _value_accessor->GetAccessorInfo().size / sizeof(float);
+  int thread_num = _real_local_shard_num < 15 ? _real_local_shard_num : 15;
+
+  omp_set_num_threads(thread_num);
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < _real_local_shard_num; ++i) {
+    FsChannelConfig channel_config = {};
+    channel_config.path = file_list[file_start_idx + i];
+    auto &shard = _local_shards[i];
+    bool is_read_failed = false;
+    int retry_num = 0;
+    int err_no = 0;
+    uint64_t row_size = 0;
+    uint64_t delete_size = 0;
+    do {
+      is_read_failed = false;
+      err_no = 0;
+      delete_size = 0;
+      auto read_channel = _afs_client.open_r(channel_config, 0, &err_no);
+      auto read_bytes = [&read_channel](void *data, size_t size) {
+        return read_channel->read(static_cast<char *>(data), size) ==
+               static_cast<int>(size);
+      };
+      uint32_t header[2] = {0, 0};
+      uint32_t footer = 0;
+      // the rows are assigned or erased, so a retry can apply them again
+      bool is_valid = read_bytes(header, sizeof(header)) &&
+                      header[0] == kDeltaFileMagic &&
+                      header[1] == kDeltaFileVersion &&
+                      read_bytes(&row_size, sizeof(row_size));
+      for (uint64_t row = 0; is_valid && row < row_size; ++row) {
+        uint64_t key = 0;
+        uint32_t value_size = 0;
+        is_valid = read_bytes(&key, sizeof(key)) &&
+                   read_bytes(&value_size, sizeof(value_size)) &&
+                   value_size <= feature_value_size;
+        if (!is_valid) {
+          break;
+        }
+        if (value_size == 0) {
+          shard.erase(key);
+          ++delete_size;
+        } else {
+          auto &value = shard[key];
+          value.resize(value_size);
+          is_valid = read_bytes(value.data(), value_size * sizeof(float));
+        }
+        // the restored rows are saved again by a compacted delta only
+        if (_enable_delta_save) {
+          _dirty_keys[i][key] = 0;
+        }
+      }
+      is_valid = is_valid && read_bytes(&footer, sizeof(footer)) &&
+                 footer == kDeltaFileMagic;
+      read_channel->close();
+      if (!is_valid || err_no == -1) {
+        ++retry_num;
+        is_read_failed = true;
+        LOG(ERROR) << "MemorySparseTable load delta failed, retry it! path:"
+                   << channel_config.path << " , retry_num=" << retry_num;
+      }
+      if (retry_num > FLAGS_pserver_table_save_max_retry) {
+        LOG(ERROR) << "MemorySparseTable load delta failed reach max limit!";
+        exit(-1);
+      }
+    } while (is_read_failed);
+    VLOG(0) << "Table>> load delta done. ALL[" << row_size << "] DELETE["
+            << delete_size << "]";
+  }
+  LOG(INFO) << "MemorySparseTable load delta success, path from "
+            << file_list[file_start_idx] << " to "
+            << file_list[file_start_idx + _real_local_shard_num - 1];
+  return 0;
+}
+
 void MemorySparseTable::Revert() {
   for (int i = 0; i < _real_local_shard_num; ++i) {
     _local_shards_new[i].clear();
@@ -351,6 +509,7 @@ int32_t MemorySparseTable::Save(const std::string &dirname,
     }
   }
 #endif
+  std::lock_guard<std::mutex> shrink_guard(_shrink_slice_mutex);
   if (_real_local_shard_num == 0) {
     _local_show_threshold = -1;
     return 0;
@@ -369,6 +528,17 @@ int32_t MemorySparseTable::Save(const std::string &dirname,
     return 0;
   }
 
+  // delta checkpoint
+  if (save_param == 6 || save_param == 7) {
+    return SaveDelta(dirname, save_param);
+  }
+  // the later deltas are relative to this checkpoint
+  if (save_param == 0) {
+    for (auto &dirty_keys : _dirty_keys) {
+      dirty_keys.clear();
+    }
+  }
+
   // cache model
   int64_t tk_size = LocalSize() * _config.sparse_table_cache_rate();
   TopkCalculator tk(_real_local_shard_num, tk_size);
@@ -483,6 +653,7 @@ int32_t MemorySparseTable::Save(const std::string &dirname,
 #if defined(PADDLE_WITH_HETERPS) && defined(PADDLE_WITH_PSCORE)
 int32_t MemorySparseTable::Save_v2(const std::string &dirname,
                                    const std::string &param) {
+  std::lock_guard<std::mutex> shrink_guard(_shrink_slice_mutex);
   if (_real_local_shard_num == 0) {
     _local_show_threshold = -1;
     return 0;
@@ -780,6 +951,7 @@ int64_t MemorySparseTable::CacheShuffle(
     ::paddle::framework::Channel<std::pair<uint64_t, std::string>>
         &shuffled_channel,
     const std::vector<Table *> &table_ptrs) {
+  std::lock_guard<std::mutex> shrink_guard(_shrink_slice_mutex);
   LOG(INFO) << "cache shuffle with cache threshold: " << cache_threshold;
   int save_param = atoi(param.c_str());  // batch_model:0  xbox:1
   if (!_config.enable_sparse_table_cache() || cache_threshold < 0) {
@@ -884,11 +1056,102 @@ int64_t MemorySparseTable::CacheShuffle(
   return 0;
 }
 
+int32_t MemorySparseTable::SaveDelta(const std::string &dirname,
+                                     int save_param) {
+  if (!_enable_delta_save) {
+    LOG(ERROR) << "MemorySparseTable save delta needs "
+               << "FLAGS_pserver_enable_delta_save, path: " << dirname;
+    return -1;
+  }
+  // an incremental delta has the rows of the current generation, and a
+  // compacted delta has all the rows since the last full checkpoint
+  const bool is_compacted = save_param == 7;
+  const uint32_t generation = _delta_generation;
+  std::string table_path = TableDir(dirname);
+  _afs_client.remove(::paddle::string::format_string(
+      "%s/part-%03d-*", table_path.c_str(), _shard_idx));
+  std::atomic<uint64_t> row_size_all{0};
+
+  size_t file_start_idx = _avg_local_shard_num * _shard_idx;
+  int thread_num = _real_local_shard_num < 20 ? _real_local_shard_num : 20;
+  omp_set_num_threads(thread_num);
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < _real_local_shard_num; ++i) {
+    FsChannelConfig channel_config = {};
+    channel_config.path = ::paddle::string::format_string("%s/part-%03d-%05d",
+                                                          table_path.c_str(),
+                                                          _shard_idx,
+                                                          file_start_idx + i);
+    auto &shard = _local_shards[i];
+    auto &dirty_keys = _dirty_keys[i];
+    uint64_t row_size = 0;
+    for (auto &dirty : dirty_keys) {
+      if (is_compacted || dirty.second >= generation) {
+        ++row_size;
+      }
+    }
+    bool is_write_failed = false;
+    int retry_num = 0;
+    int err_no = 0;
+    do {
+      err_no = 0;
+      auto write_channel =
+          _afs_client.open_w(channel_config, 1024 * 1024 * 40, &err_no);
+      auto write_bytes = [&write_channel](const void *data, size_t size) {
+        return write_channel->write(static_cast<const char *>(data), size) ==
+               0;
+      };
+      const uint32_t header[2] = {kDeltaFileMagic, kDeltaFileVersion};
+      is_write_failed = !write_bytes(header, sizeof(header)) ||
+                        !write_bytes(&row_size, sizeof(row_size));
+      for (auto dirty = dirty_keys.begin();
+           !is_write_failed && dirty != dirty_keys.end();
+           ++dirty) {
+        if (!is_compacted && dirty->second < generation) {
+          continue;
+        }
+        // the keys erased by shrink are saved with no values
+        const uint64_t key = dirty->first;
+        auto it = shard.find(key);
+        const uint32_t value_size =
+            it == shard.end() ? 0 : static_cast<uint32_t>(it.value().size());
+        is_write_failed =
+            !write_bytes(&key, sizeof(key)) ||
+            !write_bytes(&value_size, sizeof(value_size)) ||
+            (value_size > 0 &&
+             !write_bytes(it.value().data(), value_size * sizeof(float)));
+      }
+      is_write_failed = is_write_failed ||
+                        !write_bytes(&kDeltaFileMagic, sizeof(kDeltaFileMagic));
+      write_channel->close();
+      if (is_write_failed || err_no == -1) {
+        ++retry_num;
+        is_write_failed = true;
+        LOG(ERROR) << "MemorySparseTable save delta failed, retry it! path:"
+                   << channel_config.path << " , retry_num=" << retry_num;
+        _afs_client.remove(channel_config.path);
+      }
+      if (retry_num > FLAGS_pserver_table_save_max_retry) {
+        LOG(ERROR) << "MemorySparseTable save delta failed reach max limit!";
+        exit(-1);
+      }
+    } while (is_write_failed);
+    row_size_all += row_size;
+    LOG(INFO) << "MemorySparseTable save delta success, path: "
+              << channel_config.path << " row_size: " << row_size;
+  }
+  ++_delta_generation;
+  VLOG(0) << "MemorySparseTable save delta done, generation: " << generation
+          << " compacted: " << is_compacted << " row_size: " << row_size_all;
+  return 0;
+}
+
 int32_t MemorySparseTable::SaveCache(
     const std::string &path,
     const std::string &param,
     ::paddle::framework::Channel<std::pair<uint64_t, std::string>>
         &shuffled_channel) {
+  std::lock_guard<std::mutex> shrink_guard(_shrink_slice_mutex);
   if (_shard_idx >= _config.sparse_table_cache_file_num()) {
     return 0;
   }
@@ -1013,7 +1276,7 @@ int32_t MemorySparseTable::Push(TableContext &context) {
 int32_t MemorySparseTable::PullSparse(float *pull_values,
                                       const PullSparseValue &pull_value) {
   CostTimer timer("pserver_sparse_select_all");
-  std::vector<std::future<int>> tasks(_real_local_shard_num);
+  ShardTaskWaiter waiter;
 
   const size_t value_size =
       _value_accessor->GetAccessorInfo().size / sizeof(float);
@@ -1026,64 +1289,73 @@ int32_t MemorySparseTable::PullSparse(float *pull_values,
   std::vector<std::vector<std::pair<uint64_t, int>>> task_keys(
       _real_local_shard_num);
   size_t num = pull_value.numel_;
+  // the hot keys are served from the replicated cache directly, so that they
+  // do not pile up on the task pool of a single shard
+  auto hot_keys = _hot_key_cache.Get();
   for (size_t i = 0; i < num; ++i) {
+    if (hot_keys != nullptr &&
+        hot_keys->Get(pull_value.feasigns_[i],
+                      pull_values + select_value_size * i)) {
+      continue;
+    }
     int shard_id = (pull_value.feasigns_[i] % _sparse_table_shard_num) %
                    _avg_local_shard_num;
     task_keys[shard_id].push_back({pull_value.feasigns_[i], i});
   }
   for (int shard_id = 0; shard_id < _real_local_shard_num; ++shard_id) {
-    tasks[shard_id] =
-        _shards_task_pool[shard_id % _shards_task_pool.size()]->enqueue(
-            [this,
-             shard_id,
-             &task_keys,
-             value_size,
-             pull_values,
-             mf_value_size,
-             select_value_size]() -> int {
-              auto &local_shard = _local_shards[shard_id];
-              float data_buffer[value_size];  // NOLINT
-              float *data_buffer_ptr = data_buffer;
+    if (task_keys[shard_id].empty()) {
+      continue;
+    }
+    waiter.Enqueue(
+        _shards_task_pool[shard_id % _shards_task_pool.size()].get(),
+        [this,
+         shard_id,
+         &task_keys,
+         value_size,
+         pull_values,
+         mf_value_size,
+         select_value_size]() -> int {
+          auto &local_shard = _local_shards[shard_id];
+          float data_buffer[value_size];  // NOLINT
+          float *data_buffer_ptr = data_buffer;
 
-              auto &keys = task_keys[shard_id];
-              for (auto &item : keys) {
-                uint64_t key = item.first;
-                auto itr = local_shard.find(key);
-                size_t data_size = value_size - mf_value_size;
-                if (itr == local_shard.end()) {
-                  // ++missed_keys;
-                  if (FLAGS_pserver_create_value_when_push) {
-                    memset(data_buffer, 0, sizeof(float) * data_size);
-                  } else {
-                    auto &feature_value = local_shard[key];
-                    feature_value.resize(data_size);
-                    float *data_ptr = feature_value.data();
-                    _value_accessor->Create(&data_buffer_ptr, 1);
-                    memcpy(
-                        data_ptr, data_buffer_ptr, data_size * sizeof(float));
-                  }
-                } else {
-                  data_size = itr.value().size();
-                  memcpy(data_buffer_ptr,
-                         itr.value().data(),
-                         data_size * sizeof(float));
-                }
-                for (size_t mf_idx = data_size; mf_idx < value_size; ++mf_idx) {
-                  data_buffer[mf_idx] = 0.0;
-                }
-                auto offset = item.second;
-                float *select_data = pull_values + select_value_size * offset;
-                _value_accessor->Select(
-                    &select_data, (const float **)&data_buffer_ptr, 1);
+          auto &keys = task_keys[shard_id];
+          for (auto &item : keys) {
+            uint64_t key = item.first;
+            auto itr = local_shard.find(key);
+            size_t data_size = value_size - mf_value_size;
+            if (itr == local_shard.end()) {
+              // ++missed_keys;
+              if (FLAGS_pserver_create_value_when_push) {
+                memset(data_buffer, 0, sizeof(float) * data_size);
+              } else {
+                auto &feature_value = local_shard[key];
+                feature_value.resize(data_size);
+                float *data_ptr = feature_value.data();
+                _value_accessor->Create(&data_buffer_ptr, 1);
+                memcpy(data_ptr, data_buffer_ptr, data_size * sizeof(float));
+                MarkDirty(shard_id, key);
               }
+            } else {
+              data_size = itr.value().size();
+              memcpy(data_buffer_ptr,
+                     itr.value().data(),
+                     data_size * sizeof(float));
+            }
+            for (size_t mf_idx = data_size; mf_idx < value_size; ++mf_idx) {
+              data_buffer[mf_idx] = 0.0;
+            }
+            auto offset = item.second;
+            float *select_data = pull_values + select_value_size * offset;
+            _value_accessor->Select(
+                &select_data, (const float **)&data_buffer_ptr, 1);
+          }
 
-              return 0;
-            });
+          return 0;
+        });
   }
 
-  for (auto &task : tasks) {
-    task.wait();
-  }
+  waiter.Wait();
   return 0;
 }
 
@@ -1097,7 +1369,7 @@ int32_t MemorySparseTable::PullSparsePtr(int shard_id,  // fake num
   size_t mf_value_size =
       _value_accessor->GetAccessorInfo().mf_size / sizeof(float);
 
-  std::vector<std::future<int>> tasks(_real_local_shard_num);
+  ShardTaskWaiter waiter;
   std::vector<std::vector<std::pair<uint64_t, int>>> task_keys(
       _real_local_shard_num);
   for (size_t i = 0; i < num; ++i) {
@@ -1106,43 +1378,42 @@ int32_t MemorySparseTable::PullSparsePtr(int shard_id,  // fake num
   }
   // std::atomic<uint32_t> missed_keys{0};
   for (int shard_id = 0; shard_id < _real_local_shard_num; ++shard_id) {
-    tasks[shard_id] =
-        _shards_task_pool[shard_id % _shards_task_pool.size()]->enqueue(
-            [this,
-             shard_id,
-             &task_keys,
-             pull_values,
-             value_size,
-             mf_value_size]() -> int {
-              auto &keys = task_keys[shard_id];
-              auto &local_shard = _local_shards[shard_id];
-              float data_buffer[value_size];  // NOLINT
-              float *data_buffer_ptr = data_buffer;
-              for (auto &item : keys) {
-                uint64_t key = item.first;
-                auto itr = local_shard.find(key);
-                size_t data_size = value_size - mf_value_size;
-                FixedFeatureValue *ret = NULL;
-                if (itr == local_shard.end()) {
-                  // ++missed_keys;
-                  auto &feature_value = local_shard[key];
-                  feature_value.resize(data_size);
-                  float *data_ptr = feature_value.data();
-                  _value_accessor->Create(&data_buffer_ptr, 1);
-                  memcpy(data_ptr, data_buffer_ptr, data_size * sizeof(float));
-                  ret = &feature_value;
-                } else {
-                  ret = itr.value_ptr();
-                }
-                int pull_data_idx = item.second;
-                pull_values[pull_data_idx] = reinterpret_cast<char *>(ret);
-              }
-              return 0;
-            });
-  }
-  for (auto &task : tasks) {
-    task.wait();
+    waiter.Enqueue(
+        _shards_task_pool[shard_id % _shards_task_pool.size()].get(),
+        [this,
+         shard_id,
+         &task_keys,
+         pull_values,
+         value_size,
+         mf_value_size]() -> int {
+          auto &keys = task_keys[shard_id];
+          auto &local_shard = _local_shards[shard_id];
+          float data_buffer[value_size];  // NOLINT
+          float *data_buffer_ptr = data_buffer;
+          for (auto &item : keys) {
+            uint64_t key = item.first;
+            auto itr = local_shard.find(key);
+            size_t data_size = value_size - mf_value_size;
+            FixedFeatureValue *ret = NULL;
+            if (itr == local_shard.end()) {
+              // ++missed_keys;
+              auto &feature_value = local_shard[key];
+              feature_value.resize(data_size);
+              float *data_ptr = feature_value.data();
+              _value_accessor->Create(&data_buffer_ptr, 1);
+              memcpy(data_ptr, data_buffer_ptr, data_size * sizeof(float));
+              MarkDirty(shard_id, key);
+              ret = &feature_value;
+            } else {
+              ret = itr.value_ptr();
+            }
+            int pull_data_idx = item.second;
+            pull_values[pull_data_idx] = reinterpret_cast<char *>(ret);
+          }
+          return 0;
+        });
   }
+  waiter.Wait();
   return 0;
 }
 
@@ -1150,7 +1421,7 @@ int32_t MemorySparseTable::PushSparse(const uint64_t *keys,
                                       const float *values,
                                       size_t num) {
   CostTimer timer("pserver_sparse_update_all");
-  std::vector<std::future<int>> tasks(_real_local_shard_num);
+  ShardTaskWaiter waiter;
   std::vector<std::vector<std::pair<uint64_t, int>>> task_keys(
       _real_local_shard_num);
   for (size_t i = 0; i < num; ++i) {
@@ -1166,7 +1437,8 @@ int32_t MemorySparseTable::PushSparse(const uint64_t *keys,
       _value_accessor->GetAccessorInfo().update_size / sizeof(float);
 
   for (int shard_id = 0; shard_id < _real_local_shard_num; ++shard_id) {
-    tasks[shard_id] = _shards_task_pool[shard_id % _task_pool_size]->enqueue(
+    waiter.Enqueue(
+        _shards_task_pool[shard_id % _task_pool_size].get(),
         [this,
          shard_id,
          value_col,
@@ -1218,6 +1490,7 @@ int32_t MemorySparseTable::PushSparse(const uint64_t *keys,
               }
               memcpy(value_data, data_buffer_ptr, value_size * sizeof(float));
             }
+            MarkDirty(shard_id, key);
             if (_config.enable_revert()) {
               FixedFeatureValue *feature_value_new = &(local_shard_new[key]);
               auto new_size = feature_value.size();
@@ -1231,8 +1504,11 @@ int32_t MemorySparseTable::PushSparse(const uint64_t *keys,
         });
   }
 
-  for (auto &task : tasks) {
-    task.wait();
+  waiter.Wait();
+  if (FLAGS_pserver_hot_key_cache_size > 0 &&
+      ++_push_num_since_refresh >=
+          FLAGS_pserver_hot_key_cache_refresh_push_num) {
+    RefreshHotKeyCache();
   }
   return 0;
 }
@@ -1240,7 +1516,7 @@ int32_t MemorySparseTable::PushSparse(const uint64_t *keys,
 int32_t MemorySparseTable::PushSparse(const uint64_t *keys,
                                       const float **values,
                                       size_t num) {
-  std::vector<std::future<int>> tasks(_real_local_shard_num);
+  ShardTaskWaiter waiter;
   std::vector<std::vector<std::pair<uint64_t, int>>> task_keys(
       _real_local_shard_num);
   for (size_t i = 0; i < num; ++i) {
@@ -1253,7 +1529,8 @@ int32_t MemorySparseTable::PushSparse(const uint64_t *keys,
       _value_accessor->GetAccessorInfo().mf_size / sizeof(float);
 
   for (int shard_id = 0; shard_id < _real_local_shard_num; ++shard_id) {
-    tasks[shard_id] = _shards_task_pool[shard_id % _task_pool_size]->enqueue(
+    waiter.Enqueue(
+        _shards_task_pool[shard_id % _task_pool_size].get(),
         [this, shard_id, value_col, mf_value_col, values, &task_keys]() -> int {
           auto &keys = task_keys[shard_id];
           auto &local_shard = _local_shards[shard_id];
@@ -1294,21 +1571,129 @@ int32_t MemorySparseTable::PushSparse(const uint64_t *keys,
               }
               memcpy(value_data, data_buffer_ptr, value_size * sizeof(float));
             }
+            MarkDirty(shard_id, key);
           }
           return 0;
         });
   }
 
-  for (auto &task : tasks) {
-    task.wait();
+  waiter.Wait();
+  if (FLAGS_pserver_hot_key_cache_size > 0 &&
+      ++_push_num_since_refresh >=
+          FLAGS_pserver_hot_key_cache_refresh_push_num) {
+    RefreshHotKeyCache();
   }
   return 0;
 }
 
-int32_t MemorySparseTable::Flush() { return 0; }
+int32_t MemorySparseTable::Flush() {
+  RefreshHotKeyCache();
+  return 0;
+}
+
+void MemorySparseTable::RefreshHotKeyCache() {
+  if (FLAGS_pserver_hot_key_cache_size <= 0 || _real_local_shard_num <= 0) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(_hot_key_cache_mutex, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    return;
+  }
+  _push_num_since_refresh = 0;
+
+  const size_t value_size =
+      _value_accessor->GetAccessorInfo().size / sizeof(float);
+  size_t mf_value_size =
+      _value_accessor->GetAccessorInfo().mf_size / sizeof(float);
+  size_t select_value_size =
+      _value_accessor->GetAccessorInfo().select_size / sizeof(float);
+  size_t shard_cache_size = std::max<size_t>(
+      FLAGS_pserver_hot_key_cache_size / _real_local_shard_num, 1);
+
+  std::vector<HotKeyCache::Snapshot> shard_hot_keys(
+      _real_local_shard_num, HotKeyCache::Snapshot(select_value_size));
+  std::vector<std::future<int>> tasks(_real_local_shard_num);
+  // the shards are scanned on their own task pool, so that the values are
+  // not modified by the pushes during the scan
+  for (int shard_id = 0; shard_id < _real_local_shard_num; ++shard_id) {
+    tasks[shard_id] =
+        _shards_task_pool[shard_id % _shards_task_pool.size()]->enqueue(
+            [this,
+             shard_id,
+             &shard_hot_keys,
+             shard_cache_size,
+             value_size,
+             mf_value_size,
+             select_value_size]() -> int {
+              auto &local_shard = _local_shards[shard_id];
+              TopkCalculator tk(1, shard_cache_size);
+              for (auto it = local_shard.begin(); it != local_shard.end();
+                   ++it) {
+                tk.push(0,
+                        _value_accessor->GetField(it.value().data(), "show"));
+              }
+              double threshold = tk.top();
+
+              float data_buffer[value_size];  // NOLINT
+              float *data_buffer_ptr = data_buffer;
+              std::vector<float> select_buffer(select_value_size);
+              float *select_data = select_buffer.data();
+              auto &hot_keys = shard_hot_keys[shard_id];
+              for (auto it = local_shard.begin(); it != local_shard.end();
+                   ++it) {
+                if (hot_keys.Size() >= shard_cache_size) {
+                  break;
+                }
+                auto &feature_value = it.value();
+                float show =
+                    _value_accessor->GetField(feature_value.data(), "show");
+                if (show <= 0 || show < threshold) {
+                  continue;
+                }
+                size_t data_size = feature_value.size();
+                memcpy(data_buffer_ptr,
+                       feature_value.data(),
+                       data_size * sizeof(float));
+                for (size_t mf_idx = data_size; mf_idx < value_size; ++mf_idx) {
+                  data_buffer[mf_idx] = 0.0;
+                }
+                _value_accessor->Select(
+                    &select_data, (const float **)&data_buffer_ptr, 1);
+                hot_keys.Add(it.key(), select_data);
+              }
+              return 0;
+            });
+  }
+  for (auto &task : tasks) {
+    task.wait();
+  }
+
+  auto snapshot = std::make_shared<HotKeyCache::Snapshot>(select_value_size);
+  for (auto &hot_keys : shard_hot_keys) {
+    snapshot->Merge(std::move(hot_keys));
+  }
+  VLOG(3) << "MemorySparseTable refresh hot key cache, size: "
+          << snapshot->Size();
+  _hot_key_cache.Publish(std::move(snapshot));
+}
 
 int32_t MemorySparseTable::Shrink(const std::string &param) {
+  if (FLAGS_pserver_enable_background_shrink) {
+    int64_t pending_passes = 0;
+    {
+      std::lock_guard<std::mutex> guard(_shrink_mutex);
+      if (!_shrink_thread.joinable()) {
+        _shrink_thread = std::thread([this]() { BackgroundShrink(); });
+      }
+      pending_passes = ++_shrink_stat.pending_passes;
+    }
+    _shrink_cv.notify_all();
+    VLOG(0) << "MemorySparseTable::Shrink in background, pending passes: "
+            << pending_passes;
+    return 0;
+  }
   VLOG(0) << "MemorySparseTable::Shrink";
+  _hot_key_cache.Invalidate();
   std::atomic<uint32_t> shrink_size_all{0};
   int thread_num = _real_local_shard_num;
   omp_set_num_threads(thread_num);
@@ -1319,6 +1704,7 @@ int32_t MemorySparseTable::Shrink(const std::string &param) {
     auto &shard = _local_shards[shard_id];
     for (auto it = shard.begin(); it != shard.end();) {
       if (_value_accessor->Shrink(it.value().data())) {
+        MarkDirty(shard_id, it.key());
         it = shard.erase(it);
         ++feasign_size;
       } else {
@@ -1332,6 +1718,86 @@ int32_t MemorySparseTable::Shrink(const std::string &param) {
   return 0;
 }
 
+size_t MemorySparseTable::ShrinkBucket(int shard_id, size_t bucket) {
+  size_t shrink_size = 0;
+  auto &shard = _local_shards[shard_id];
+  for (auto it = shard.begin(bucket); it != shard.end(bucket);) {
+    if (_value_accessor->Shrink(it.value().data())) {
+      MarkDirty(shard_id, it.key());
+      it = shard.erase(bucket, it);
+      ++shrink_size;
+    } else {
+      ++it;
+    }
+  }
+  return shrink_size;
+}
+
+void MemorySparseTable::BackgroundShrink() {
+  const int64_t total_buckets =
+      static_cast<int64_t>(_real_local_shard_num) * CTR_SPARSE_SHARD_BUCKET_NUM;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(_shrink_mutex);
+      _shrink_cv.wait(lock, [this]() {
+        return _shrink_stop || _shrink_stat.pending_passes > 0;
+      });
+      if (_shrink_stop) {
+        return;
+      }
+      --_shrink_stat.pending_passes;
+      _shrink_stat.swept_buckets = 0;
+      _shrink_stat.total_buckets = total_buckets;
+      _shrink_stat.shrink_size = 0;
+    }
+    // the evicted keys must not be served from the cache
+    _hot_key_cache.Invalidate();
+    // a bucket is swept by the task pool of its shard, so it never runs
+    // together with the pulls and pushes of the shard, which run between
+    // the buckets instead
+    for (int shard_id = 0; shard_id < _real_local_shard_num; ++shard_id) {
+      for (size_t bucket = 0; bucket < CTR_SPARSE_SHARD_BUCKET_NUM; ++bucket) {
+        size_t shrink_size = 0;
+        {
+          std::lock_guard<std::mutex> slice_guard(_shrink_slice_mutex);
+          shrink_size =
+              _shards_task_pool[shard_id % _shards_task_pool.size()]
+                  ->enqueue([this, shard_id, bucket]() -> size_t {
+                    return ShrinkBucket(shard_id, bucket);
+                  })
+                  .get();
+        }
+        {
+          std::lock_guard<std::mutex> guard(_shrink_mutex);
+          if (_shrink_stop) {
+            return;
+          }
+          ++_shrink_stat.swept_buckets;
+          _shrink_stat.shrink_size += shrink_size;
+          _shrink_stat.total_shrink_size += shrink_size;
+        }
+        if (FLAGS_pserver_background_shrink_interval_us > 0) {
+          std::this_thread::sleep_for(std::chrono::microseconds(
+              FLAGS_pserver_background_shrink_interval_us));
+        }
+      }
+    }
+    _hot_key_cache.Invalidate();
+    std::lock_guard<std::mutex> guard(_shrink_mutex);
+    ++_shrink_stat.finished_passes;
+    VLOG(0) << "MemorySparseTable background shrink pass "
+            << _shrink_stat.finished_passes
+            << " success, shrink size:" << _shrink_stat.shrink_size
+            << ", pending passes: " << _shrink_stat.pending_passes;
+  }
+}
+
+MemorySparseTable::BackgroundShrinkStat
+MemorySparseTable::GetBackgroundShrinkStat() {
+  std::lock_guard<std::mutex> guard(_shrink_mutex);
+  return _shrink_stat;
+}
+
 void MemorySparseTable::Clear() { VLOG(0) << "clear coming soon"; }
 
 }  // namespace paddle::distributed
@@ -18,9 +18,12 @@
 #include <assert.h>
 #include <pthread.h>
 
+#include <atomic>
+#include <condition_variable>  // NOLINT
 #include <memory>
 #include <mutex>  // NOLINT
 #include <string>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -29,6 +32,8 @@
 #include "paddle/fluid/distributed/ps/table/accessor.h"
 #include "paddle/fluid/distributed/ps/table/common_table.h"
 #include "paddle/fluid/distributed/ps/table/depends/feature_value.h"
+#include "paddle/fluid/distributed/ps/table/depends/flat_feature_value.h"
+#include "paddle/fluid/distributed/ps/table/depends/hot_key_cache.h"
 #include "paddle/utils/string/string_helper.h"
 
 #define PSERVER_SAVE_SUFFIX ".shard"
@@ -38,9 +43,13 @@ namespace distributed {
 
 class MemorySparseTable : public Table {
  public:
+#ifdef PADDLE_WITH_PS_FLAT_SHARD
+  typedef FlatSparseTableShard<uint64_t, FixedFeatureValue> shard_type;
+#else
   typedef SparseTableShard<uint64_t, FixedFeatureValue> shard_type;
+#endif
   MemorySparseTable() {}
-  virtual ~MemorySparseTable() {}
+  virtual ~MemorySparseTable();
 
   // unused method end
   static int32_t sparse_local_shard_num(uint32_t shard_num,
@@ -104,9 +113,24 @@ class MemorySparseTable : public Table {
   int32_t PushSparse(const uint64_t* keys, const float** values, size_t num);
 
   int32_t Flush() override;
+  // With FLAGS_pserver_enable_background_shrink, queues a pass of the
+  // background shrink and returns at once, the passes run one after another.
   int32_t Shrink(const std::string& param) override;
   void Clear() override;
 
+  struct BackgroundShrinkStat {
+    int64_t finished_passes = 0;
+    int64_t pending_passes = 0;
+    // the buckets the running or the last pass has swept, of all the buckets
+    // of the local shards
+    int64_t swept_buckets = 0;
+    int64_t total_buckets = 0;
+    // the keys evicted by the running or the last pass, and by all passes
+    int64_t shrink_size = 0;
+    int64_t total_shrink_size = 0;
+  };
+  BackgroundShrinkStat GetBackgroundShrinkStat();
+
   void* GetShard(size_t shard_idx) override {
     return &_local_shards[shard_idx];
   }
@@ -118,6 +142,26 @@ class MemorySparseTable : public Table {
   virtual int32_t SavePatch(const std::string& path, int save_param);
   virtual int32_t LoadPatch(const std::vector<std::string>& file_list,
                             int save_param);
+  // Writes the rows changed since the last delta (save_param 6) or since the
+  // last full checkpoint (save_param 7, which compacts the older deltas) in
+  // one binary file per shard, and loads them over a restored base.
+  virtual int32_t SaveDelta(const std::string& path, int save_param);
+  virtual int32_t LoadDelta(const std::vector<std::string>& file_list);
+  // Records the key as changed in the shard, called by the task pool of the
+  // shard so the dirty keys of a shard are not shared between the threads.
+  void MarkDirty(int shard_id, uint64_t key) {
+    if (_enable_delta_save) {
+      _dirty_keys[shard_id][key] = _delta_generation;
+    }
+  }
+  // Rebuilds the hot key cache from the show of the local values, it's a
+  // no-op if the cache is disabled or another refresh is in progress.
+  void RefreshHotKeyCache();
+  // Shrinks the values of a bucket of the shard on the task pool of the
+  // shard, returns the number of the evicted keys.
+  size_t ShrinkBucket(int shard_id, size_t bucket);
+  // The loop of _shrink_thread, which runs the queued passes.
+  void BackgroundShrink();
 
   int _task_pool_size = 24;
   int _avg_local_shard_num;
@@ -137,6 +181,29 @@ class MemorySparseTable : public Table {
   std::unique_ptr<shard_type[]> _local_shards_patch_model;
   std::thread _save_patch_model_thread;
   bool _use_gpu_graph = false;
+
+  // replicated select values of the hottest keys, see PullSparse
+  HotKeyCache _hot_key_cache;
+  std::mutex _hot_key_cache_mutex;
+  std::atomic<int64_t> _push_num_since_refresh{0};
+
+  // for delta checkpoint, the dirty keys of each shard since the last full
+  // checkpoint, mapped to the delta generation they were changed in. The
+  // erased keys stay dirty and are saved as deleted.
+  bool _enable_delta_save = false;
+  uint32_t _delta_generation = 1;
+  std::vector<std::unordered_map<uint64_t, uint32_t>> _dirty_keys;
+
+  // for background shrink, _shrink_mutex guards the stat and the stop flag.
+  // _shrink_slice_mutex is held while a bucket is swept, and by the loads and
+  // saves which walk the shards out of their task pools, so that those pause
+  // the background shrink between two buckets.
+  std::thread _shrink_thread;
+  std::mutex _shrink_mutex;
+  std::condition_variable _shrink_cv;
+  bool _shrink_stop = false;
+  BackgroundShrinkStat _shrink_stat;
+  std::mutex _shrink_slice_mutex;
 };
 
 }  // namespace distributed
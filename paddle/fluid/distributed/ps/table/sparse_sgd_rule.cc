@@ -15,6 +15,7 @@
 #include "paddle/fluid/distributed/ps/table/sparse_sgd_rule.h"
 
 #include "glog/logging.h"
+#include "paddle/fluid/distributed/ps/table/sparse_sgd_rule_kernel.h"
 
 #include "paddle/common/flags.h"
 
@@ -98,15 +99,15 @@ void SparseAdaGradSGDRule::UpdateValueWork(float *w,
                                            const float *grad,
                                            float scale) {
   float &g2sum = sgd[G2SumIndex()];
-  double add_g2sum = 0;
-
-  for (size_t i = 0; i < _embedding_dim; i++) {
-    double scaled_grad = grad[i] / scale;
-    w[i] -= learning_rate_ * scaled_grad *
-            sqrt(_initial_g2sum / (_initial_g2sum + g2sum));
-    BoundValue(w[i]);
-    add_g2sum += scaled_grad * scaled_grad;
-  }
+  double add_g2sum = GetSparseSGDKernel().adagrad(
+      _embedding_dim,
+      w,
+      grad,
+      scale,
+      learning_rate_,
+      sqrt(_initial_g2sum / (_initial_g2sum + g2sum)),
+      _min_bound,
+      _max_bound);
 
   g2sum += add_g2sum / _embedding_dim;
 }
@@ -156,14 +157,15 @@ void StdAdaGradSGDRule::UpdateValueWork(float *w,
                                         float *sgd,
                                         const float *grad,
                                         float scale) {
-  for (size_t i = 0; i < _embedding_dim; i++) {
-    float &g2sum = sgd[G2SumIndex() + i];
-    double scaled_grad = grad[i] / scale;
-    w[i] -= learning_rate_ * scaled_grad *
-            sqrt(_initial_g2sum / (_initial_g2sum + g2sum));
-    BoundValue(w[i]);
-    g2sum += scaled_grad * scaled_grad;
-  }
+  GetSparseSGDKernel().std_adagrad(_embedding_dim,
+                                   w,
+                                   sgd + G2SumIndex(),
+                                   grad,
+                                   scale,
+                                   learning_rate_,
+                                   _initial_g2sum,
+                                   _min_bound,
+                                   _max_bound);
 }
 
 void StdAdaGradSGDRule::InitValueWork(float *value,
@@ -223,14 +225,17 @@ void SparseAdamSGDRule::UpdateValueWork(float *w,
   float beta2_pow_ = *beta2_pow;
 
   lr *= sqrt(1 - beta2_pow_) / (1 - beta1_pow_);
-  for (size_t i = 0; i < _embedding_dim; i++) {
-    // Calculation
-    gsum[i] = _beta1_decay_rate * gsum[i] + (1 - _beta1_decay_rate) * g[i];
-    g2sum[i] =
-        _beta2_decay_rate * g2sum[i] + (1 - _beta2_decay_rate) * g[i] * g[i];
-    w[i] = w[i] - lr * (gsum[i] / (sqrt(g2sum[i]) + _ada_epsilon));
-    BoundValue(w[i]);
-  }
+  GetSparseSGDKernel().adam(_embedding_dim,
+                            w,
+                            gsum,
+                            g2sum,
+                            g,
+                            lr,
+                            _beta1_decay_rate,
+                            _beta2_decay_rate,
+                            _ada_epsilon,
+                            _min_bound,
+                            _max_bound);
   // update beta_pow_decay
   (*beta1_pow) *= _beta1_decay_rate;
   (*beta2_pow) *= _beta2_decay_rate;
@@ -0,0 +1,58 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// This file is built with the avx512 flags when the compiler supports them,
+// and the kernel is only used after checking the cpu.
+
+#include "paddle/fluid/distributed/ps/table/sparse_sgd_rule_kernel.h"
+
+#ifdef __AVX512F__
+#include <immintrin.h>
+#endif
+
+namespace paddle::distributed {
+
+#ifdef __AVX512F__
+namespace {
+
+struct Avx512Vec {
+  using Reg = __m512;
+  static constexpr size_t kBlock = 16;
+  static Reg Load(const float *p) { return _mm512_loadu_ps(p); }
+  static void Store(float *p, Reg x) { _mm512_storeu_ps(p, x); }
+  static Reg Set1(float x) { return _mm512_set1_ps(x); }
+  static Reg Add(Reg x, Reg y) { return _mm512_add_ps(x, y); }
+  static Reg Sub(Reg x, Reg y) { return _mm512_sub_ps(x, y); }
+  static Reg Mul(Reg x, Reg y) { return _mm512_mul_ps(x, y); }
+  static Reg Div(Reg x, Reg y) { return _mm512_div_ps(x, y); }
+  static Reg Sqrt(Reg x) { return _mm512_sqrt_ps(x); }
+  // max returns the second operand if either is NaN
+  static Reg Bound(Reg x, Reg lo, Reg hi) {
+    return _mm512_min_ps(_mm512_max_ps(x, lo), hi);
+  }
+  static float Sum(Reg x) { return _mm512_reduce_add_ps(x); }
+};
+
+}  // namespace
+
+const SparseSGDKernel *GetAvx512SparseSGDKernel() {
+  static const SparseSGDKernel kernel =
+      SparseSGDKernelImpl<Avx512Vec>::Make("avx512");
+  return &kernel;
+}
+#else
+const SparseSGDKernel *GetAvx512SparseSGDKernel() { return nullptr; }
+#endif
+
+}  // namespace paddle::distributed
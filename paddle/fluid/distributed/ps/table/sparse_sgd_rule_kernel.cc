@@ -0,0 +1,198 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/ps/table/sparse_sgd_rule_kernel.h"
+
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include "glog/logging.h"
+#include "paddle/common/flags.h"
+#include "paddle/phi/backends/cpu/cpu_info.h"
+
+PD_DEFINE_bool(enable_sparse_sgd_simd,
+               true,
+               "use the SIMD kernels of the cpu in the sparse sgd rules and "
+               "accessors");
+
+namespace paddle::distributed {
+
+namespace {
+
+float BoundPlain(float w, float min_bound, float max_bound) {
+  if (!(w >= min_bound)) return min_bound;
+  if (!(w <= max_bound)) return max_bound;
+  return w;
+}
+
+double AdaGradPlain(size_t n,
+                    float *w,
+                    const float *grad,
+                    float scale,
+                    float learning_rate,
+                    double ratio,
+                    float min_bound,
+                    float max_bound) {
+  double add_g2sum = 0;
+  for (size_t i = 0; i < n; i++) {
+    double scaled_grad = grad[i] / scale;
+    w[i] -= learning_rate * scaled_grad * ratio;
+    w[i] = BoundPlain(w[i], min_bound, max_bound);
+    add_g2sum += scaled_grad * scaled_grad;
+  }
+  return add_g2sum;
+}
+
+void StdAdaGradPlain(size_t n,
+                     float *w,
+                     float *g2sum,
+                     const float *grad,
+                     float scale,
+                     float learning_rate,
+                     float initial_g2sum,
+                     float min_bound,
+                     float max_bound) {
+  for (size_t i = 0; i < n; i++) {
+    double scaled_grad = grad[i] / scale;
+    w[i] -= learning_rate * scaled_grad *
+            sqrt(initial_g2sum / (initial_g2sum + g2sum[i]));
+    w[i] = BoundPlain(w[i], min_bound, max_bound);
+    g2sum[i] += scaled_grad * scaled_grad;
+  }
+}
+
+void AdamPlain(size_t n,
+               float *w,
+               float *gsum,
+               float *g2sum,
+               const float *grad,
+               float learning_rate,
+               float beta1_decay_rate,
+               float beta2_decay_rate,
+               float ada_epsilon,
+               float min_bound,
+               float max_bound) {
+  for (size_t i = 0; i < n; i++) {
+    gsum[i] = beta1_decay_rate * gsum[i] + (1 - beta1_decay_rate) * grad[i];
+    g2sum[i] = beta2_decay_rate * g2sum[i] +
+               (1 - beta2_decay_rate) * grad[i] * grad[i];
+    w[i] = w[i] - learning_rate * (gsum[i] / (sqrt(g2sum[i]) + ada_epsilon));
+    w[i] = BoundPlain(w[i], min_bound, max_bound);
+  }
+}
+
+void AddPlain(size_t n, float *x, const float *y) {
+  for (size_t i = 0; i < n; i++) {
+    x[i] += y[i];
+  }
+}
+
+void SubScaledPlain(size_t n, float *x, const float *y, float a) {
+  for (size_t i = 0; i < n; i++) {
+    x[i] -= a * y[i];
+  }
+}
+
+#ifdef __AVX__
+struct AvxVec {
+  using Reg = __m256;
+  static constexpr size_t kBlock = 8;
+  static Reg Load(const float *p) { return _mm256_loadu_ps(p); }
+  static void Store(float *p, Reg x) { _mm256_storeu_ps(p, x); }
+  static Reg Set1(float x) { return _mm256_set1_ps(x); }
+  static Reg Add(Reg x, Reg y) { return _mm256_add_ps(x, y); }
+  static Reg Sub(Reg x, Reg y) { return _mm256_sub_ps(x, y); }
+  static Reg Mul(Reg x, Reg y) { return _mm256_mul_ps(x, y); }
+  static Reg Div(Reg x, Reg y) { return _mm256_div_ps(x, y); }
+  static Reg Sqrt(Reg x) { return _mm256_sqrt_ps(x); }
+  // max returns the second operand if either is NaN
+  static Reg Bound(Reg x, Reg lo, Reg hi) {
+    return _mm256_min_ps(_mm256_max_ps(x, lo), hi);
+  }
+  static float Sum(Reg x) {
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(x),
+                            _mm256_extractf128_ps(x, 1));
+    sum = _mm_hadd_ps(sum, sum);
+    sum = _mm_hadd_ps(sum, sum);
+    return _mm_cvtss_f32(sum);
+  }
+};
+#endif
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+struct NeonVec {
+  using Reg = float32x4_t;
+  static constexpr size_t kBlock = 4;
+  static Reg Load(const float *p) { return vld1q_f32(p); }
+  static void Store(float *p, Reg x) { vst1q_f32(p, x); }
+  static Reg Set1(float x) { return vdupq_n_f32(x); }
+  static Reg Add(Reg x, Reg y) { return vaddq_f32(x, y); }
+  static Reg Sub(Reg x, Reg y) { return vsubq_f32(x, y); }
+  static Reg Mul(Reg x, Reg y) { return vmulq_f32(x, y); }
+  static Reg Div(Reg x, Reg y) { return vdivq_f32(x, y); }
+  static Reg Sqrt(Reg x) { return vsqrtq_f32(x); }
+  // maxnm returns the number if one operand is NaN
+  static Reg Bound(Reg x, Reg lo, Reg hi) {
+    return vminnmq_f32(vmaxnmq_f32(x, lo), hi);
+  }
+  static float Sum(Reg x) { return vaddvq_f32(x); }
+};
+#endif
+
+SparseSGDKernel MakeSparseSGDKernel() {
+  SparseSGDKernel plain;
+  plain.adagrad = &AdaGradPlain;
+  plain.std_adagrad = &StdAdaGradPlain;
+  plain.adam = &AdamPlain;
+  plain.add = &AddPlain;
+  plain.sub_scaled = &SubScaledPlain;
+  plain.name = "plain";
+  if (!FLAGS_enable_sparse_sgd_simd) {
+    return plain;
+  }
+  namespace cpu = phi::backends::cpu;
+  // the avx512 kernel is not even built before the cpu is checked
+  if (cpu::MayIUse(cpu::avx512f)) {
+    const SparseSGDKernel *avx512 = GetAvx512SparseSGDKernel();
+    if (avx512 != nullptr) {
+      return *avx512;
+    }
+  }
+#ifdef __AVX__
+  if (cpu::MayIUse(cpu::avx)) {
+    return SparseSGDKernelImpl<AvxVec>::Make("avx");
+  }
+#endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+  return SparseSGDKernelImpl<NeonVec>::Make("neon");
+#endif
+  return plain;
+}
+
+}  // namespace
+
+const SparseSGDKernel &GetSparseSGDKernel() {
+  static const SparseSGDKernel kernel = [] {
+    SparseSGDKernel kernel = MakeSparseSGDKernel();
+    VLOG(1) << "sparse sgd rules use the " << kernel.name << " kernel";
+    return kernel;
+  }();
+  return kernel;
+}
+
+}  // namespace paddle::distributed
@@ -0,0 +1,229 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <math.h>
+
+#include <cstddef>
+
+namespace paddle {
+namespace distributed {
+
+// The per dim loops of the sparse sgd rules and accessors. GetSparseSGDKernel
+// picks the SIMD version the cpu supports once, and the plain version is the
+// original scalar code.
+struct SparseSGDKernel {
+  // w[i] -= learning_rate * grad[i] / scale * ratio, returns the sum of
+  // (grad[i] / scale)^2.
+  double (*adagrad)(size_t n,
+                    float *w,
+                    const float *grad,
+                    float scale,
+                    float learning_rate,
+                    double ratio,
+                    float min_bound,
+                    float max_bound);
+  // adagrad with a g2sum per dim.
+  void (*std_adagrad)(size_t n,
+                      float *w,
+                      float *g2sum,
+                      const float *grad,
+                      float scale,
+                      float learning_rate,
+                      float initial_g2sum,
+                      float min_bound,
+                      float max_bound);
+  // adam with the bias correction already in learning_rate.
+  void (*adam)(size_t n,
+               float *w,
+               float *gsum,
+               float *g2sum,
+               const float *grad,
+               float learning_rate,
+               float beta1_decay_rate,
+               float beta2_decay_rate,
+               float ada_epsilon,
+               float min_bound,
+               float max_bound);
+  // x[i] += y[i]
+  void (*add)(size_t n, float *x, const float *y);
+  // x[i] -= a * y[i]
+  void (*sub_scaled)(size_t n, float *x, const float *y, float a);
+  const char *name;
+};
+
+const SparseSGDKernel &GetSparseSGDKernel();
+
+// The avx512 kernel lives in a translation unit built with the avx512 flags,
+// nullptr if the compiler does not support them.
+const SparseSGDKernel *GetAvx512SparseSGDKernel();
+
+// The SIMD kernels on top of the register type of an instruction set. V
+// provides Reg, kBlock, Load, Store, Set1, Add, Sub, Mul, Div, Sqrt, Bound
+// and Sum. Bound clips to [lo, hi] and takes a NaN to lo like BoundValue.
+//
+// Only instantiate it with a V local to the translation unit, so that the
+// code built for one instruction set can not be picked for another.
+template <typename V>
+struct SparseSGDKernelImpl {
+  using Reg = typename V::Reg;
+
+  static float BoundScalar(float w, float min_bound, float max_bound) {
+    if (!(w >= min_bound)) return min_bound;
+    if (!(w <= max_bound)) return max_bound;
+    return w;
+  }
+
+  static double AdaGrad(size_t n,
+                        float *w,
+                        const float *grad,
+                        float scale,
+                        float learning_rate,
+                        double ratio,
+                        float min_bound,
+                        float max_bound) {
+    const size_t end = n - n % V::kBlock;
+    Reg r = V::Set1(static_cast<float>(learning_rate * ratio));
+    Reg s = V::Set1(scale);
+    Reg lo = V::Set1(min_bound);
+    Reg hi = V::Set1(max_bound);
+    Reg g2 = V::Set1(0);
+    for (size_t i = 0; i < end; i += V::kBlock) {
+      Reg g = V::Div(V::Load(grad + i), s);
+      Reg x = V::Sub(V::Load(w + i), V::Mul(r, g));
+      V::Store(w + i, V::Bound(x, lo, hi));
+      g2 = V::Add(g2, V::Mul(g, g));
+    }
+    double add_g2sum = V::Sum(g2);
+    for (size_t i = end; i < n; i++) {
+      double scaled_grad = grad[i] / scale;
+      w[i] = BoundScalar(w[i] - learning_rate * scaled_grad * ratio,
+                         min_bound,
+                         max_bound);
+      add_g2sum += scaled_grad * scaled_grad;
+    }
+    return add_g2sum;
+  }
+
+  static void StdAdaGrad(size_t n,
+                         float *w,
+                         float *g2sum,
+                         const float *grad,
+                         float scale,
+                         float learning_rate,
+                         float initial_g2sum,
+                         float min_bound,
+                         float max_bound) {
+    const size_t end = n - n % V::kBlock;
+    Reg lr = V::Set1(learning_rate);
+    Reg init = V::Set1(initial_g2sum);
+    Reg s = V::Set1(scale);
+    Reg lo = V::Set1(min_bound);
+    Reg hi = V::Set1(max_bound);
+    for (size_t i = 0; i < end; i += V::kBlock) {
+      Reg g = V::Div(V::Load(grad + i), s);
+      Reg sum = V::Load(g2sum + i);
+      Reg ratio = V::Sqrt(V::Div(init, V::Add(init, sum)));
+      Reg x = V::Sub(V::Load(w + i), V::Mul(V::Mul(lr, g), ratio));
+      V::Store(w + i, V::Bound(x, lo, hi));
+      V::Store(g2sum + i, V::Add(sum, V::Mul(g, g)));
+    }
+    for (size_t i = end; i < n; i++) {
+      double scaled_grad = grad[i] / scale;
+      w[i] = BoundScalar(
+          w[i] - learning_rate * scaled_grad *
+                     sqrt(initial_g2sum / (initial_g2sum + g2sum[i])),
+          min_bound,
+          max_bound);
+      g2sum[i] += scaled_grad * scaled_grad;
+    }
+  }
+
+  static void Adam(size_t n,
+                   float *w,
+                   float *gsum,
+                   float *g2sum,
+                   const float *grad,
+                   float learning_rate,
+                   float beta1_decay_rate,
+                   float beta2_decay_rate,
+                   float ada_epsilon,
+                   float min_bound,
+                   float max_bound) {
+    const size_t end = n - n % V::kBlock;
+    Reg lr = V::Set1(learning_rate);
+    Reg b1 = V::Set1(beta1_decay_rate);
+    Reg b1c = V::Set1(1 - beta1_decay_rate);
+    Reg b2 = V::Set1(beta2_decay_rate);
+    Reg b2c = V::Set1(1 - beta2_decay_rate);
+    Reg eps = V::Set1(ada_epsilon);
+    Reg lo = V::Set1(min_bound);
+    Reg hi = V::Set1(max_bound);
+    for (size_t i = 0; i < end; i += V::kBlock) {
+      Reg g = V::Load(grad + i);
+      Reg m = V::Add(V::Mul(b1, V::Load(gsum + i)), V::Mul(b1c, g));
+      Reg v =
+          V::Add(V::Mul(b2, V::Load(g2sum + i)), V::Mul(V::Mul(b2c, g), g));
+      Reg x = V::Sub(V::Load(w + i),
+                     V::Mul(lr, V::Div(m, V::Add(V::Sqrt(v), eps))));
+      V::Store(gsum + i, m);
+      V::Store(g2sum + i, v);
+      V::Store(w + i, V::Bound(x, lo, hi));
+    }
+    for (size_t i = end; i < n; i++) {
+      gsum[i] = beta1_decay_rate * gsum[i] + (1 - beta1_decay_rate) * grad[i];
+      g2sum[i] = beta2_decay_rate * g2sum[i] +
+                 (1 - beta2_decay_rate) * grad[i] * grad[i];
+      w[i] = BoundScalar(
+          w[i] - learning_rate * (gsum[i] / (sqrt(g2sum[i]) + ada_epsilon)),
+          min_bound,
+          max_bound);
+    }
+  }
+
+  static void Add(size_t n, float *x, const float *y) {
+    const size_t end = n - n % V::kBlock;
+    for (size_t i = 0; i < end; i += V::kBlock) {
+      V::Store(x + i, V::Add(V::Load(x + i), V::Load(y + i)));
+    }
+    for (size_t i = end; i < n; i++) {
+      x[i] += y[i];
+    }
+  }
+
+  static void SubScaled(size_t n, float *x, const float *y, float a) {
+    const size_t end = n - n % V::kBlock;
+    Reg r = V::Set1(a);
+    for (size_t i = 0; i < end; i += V::kBlock) {
+      V::Store(x + i, V::Sub(V::Load(x + i), V::Mul(r, V::Load(y + i))));
+    }
+    for (size_t i = end; i < n; i++) {
+      x[i] -= a * y[i];
+    }
+  }
+
+  static SparseSGDKernel Make(const char *name) {
+    SparseSGDKernel kernel;
+    kernel.adagrad = &AdaGrad;
+    kernel.std_adagrad = &StdAdaGrad;
+    kernel.adam = &Adam;
+    kernel.add = &Add;
+    kernel.sub_scaled = &SubScaled;
+    kernel.name = name;
+    return kernel;
+  }
+};
+
+}  // namespace distributed
+}  // namespace paddle
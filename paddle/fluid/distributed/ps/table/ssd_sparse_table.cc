@@ -25,6 +25,19 @@ PD_DECLARE_bool(pserver_create_value_when_push);
 PD_DECLARE_bool(pserver_enable_create_feasign_randomly);
 PD_DEFINE_bool(pserver_open_strict_check, false, "pserver_open_strict_check");
 PD_DEFINE_int32(pserver_load_batch_size, 5000, "load batch size for ssd");
+PD_DEFINE_bool(pserver_ssd_prefetch,
+               false,
+               "load the keys of the coming pass from ssd in the background");
+PD_DEFINE_int32(pserver_ssd_prefetch_thread_num,
+                4,
+                "thread num to read rocksdb for the prefetch");
+PD_DEFINE_int32(pserver_ssd_prefetch_batch_size,
+                1024,
+                "key num of a rocksdb MultiGet in the prefetch");
+PD_DEFINE_int64(pserver_ssd_prefetch_max_mem_feasign_num,
+                0,
+                "the prefetch stops loading keys into memory once the memory "
+                "shards hold this number of feasigns, 0 means no limit");
 PHI_DEFINE_EXPORTED_string(rocksdb_path,
                            "database",
                            "path of sparse table rocksdb file");
@@ -530,6 +543,7 @@ int32_t SSDSparseTable::PushSparse(const uint64_t* keys,
 }
 
 int32_t SSDSparseTable::Shrink(const std::string& param) {
+  WaitPrefetch();
   int thread_num = _real_local_shard_num < 20 ? _real_local_shard_num : 20;
   omp_set_num_threads(thread_num);
 #pragma omp parallel for schedule(dynamic)
@@ -603,6 +617,7 @@ int64_t SSDSparseTable::LocalSize() {
 
 int32_t SSDSparseTable::Save(const std::string& path,
                              const std::string& param) {
+  WaitPrefetch();
 #if defined(PADDLE_WITH_HETERPS) && defined(PADDLE_WITH_PSCORE)
   // gpu graph mode
   if (_use_gpu_graph) {
@@ -2580,6 +2595,7 @@ int32_t SSDSparseTable::SaveCache(
 
 int32_t SSDSparseTable::Load(const std::string& path,
                              const std::string& param) {
+  WaitPrefetch();
   VLOG(0) << "LOAD FLAGS_rocksdb_path:" << FLAGS_rocksdb_path;
   std::string table_path = TableDir(path);
   auto file_list = _afs_client.list(::paddle::string::format_string(
@@ -3051,6 +3067,8 @@ std::pair<int64_t, int64_t> SSDSparseTable::PrintTableStat() {
 
 int32_t SSDSparseTable::CacheTable(uint16_t pass_id) {
   std::lock_guard<std::mutex> guard(_table_mutex);
+  // the prefetched values must not overwrite the newer values cached below
+  WaitPrefetch();
   VLOG(0) << "cache_table, pass_id:" << pass_id;
   std::atomic<uint32_t> count{0};
   std::vector<std::future<int>> tasks;
@@ -3108,13 +3126,13 @@ int32_t SSDSparseTable::CacheTable(uint16_t pass_id) {
 
           auto& shard = _local_shards[shard_id];
           if (1) {
-            using DataType = shard_type::map_type::iterator;
+            using DataType = std::pair<uint64_t, FixedFeatureValue*>;
             std::vector<DataType> datas;
             datas.reserve(shard.size() * 0.8);
             for (auto it = shard.begin(); it != shard.end(); ++it) {
               if (!_value_accessor->SaveMemCache(
                       it.value().data(), 0, show_threshold, pass_id)) {
-                datas.emplace_back(it.it);
+                datas.emplace_back(it.key(), it.value_ptr());
               }
             }
             count.fetch_add(datas.size(), std::memory_order_relaxed);
@@ -3125,7 +3143,7 @@ int32_t SSDSparseTable::CacheTable(uint16_t pass_id) {
               std::sort(datas.begin(),
                         datas.end(),
                         [](const DataType& a, const DataType& b) {
-                          return a->first < b->first;
+                          return a.first < b.first;
                         });
               VLOG(0) << "sort shard " << shard_id << ": "
                       << butil::gettimeofday_ms() - show_begin
@@ -3150,9 +3168,8 @@ int32_t SSDSparseTable::CacheTable(uint16_t pass_id) {
 
               uint64_t show_begin = butil::gettimeofday_ms();
               for (auto& data : datas) {
-                uint64_t tmp_key = data->first;
-                FixedFeatureValue& tmp_value =
-                    *((FixedFeatureValue*)(void*)(data->second));  // NOLINT
+                uint64_t tmp_key = data.first;
+                FixedFeatureValue& tmp_value = *data.second;
                 status = sst_writer.Put(
                     rocksdb::Slice(reinterpret_cast<char*>(&(tmp_key)),
                                    sizeof(uint64_t)),
@@ -3203,4 +3220,125 @@ int32_t SSDSparseTable::CacheTable(uint16_t pass_id) {
   return 0;
 }
 
+int32_t SSDSparseTable::Prefetch(int shard_id,
+                                 const uint64_t* keys,
+                                 size_t num,
+                                 uint16_t pass_id) {
+  if (!FLAGS_pserver_ssd_prefetch || num == 0) {
+    return 0;
+  }
+  PADDLE_ENFORCE_LT(shard_id,
+                    _real_local_shard_num,
+                    common::errors::InvalidArgument(
+                        "The shard id (%d) of prefetch must be less than the "
+                        "local shard num (%d).",
+                        shard_id,
+                        _real_local_shard_num));
+  // the caller may reuse the keys once this returns
+  auto pass_keys = std::make_shared<std::vector<uint64_t>>(keys, keys + num);
+  std::lock_guard<std::mutex> table_guard(_table_mutex);
+  std::lock_guard<std::mutex> guard(_prefetch_mutex);
+  if (_prefetch_pool == nullptr) {
+    _prefetch_pool.reset(new ::ThreadPool(
+        std::max(FLAGS_pserver_ssd_prefetch_thread_num, 1)));
+  }
+  _prefetch_tasks.emplace_back(
+      _prefetch_pool->enqueue([this, shard_id, pass_keys, pass_id]() {
+        return PrefetchShard(shard_id, pass_keys.get(), pass_id);
+      }));
+  return 0;
+}
+
+void SSDSparseTable::WaitPrefetch() {
+  std::vector<std::future<int32_t>> tasks;
+  {
+    std::lock_guard<std::mutex> guard(_prefetch_mutex);
+    tasks.swap(_prefetch_tasks);
+  }
+  for (auto& task : tasks) {
+    task.wait();
+  }
+}
+
+int32_t SSDSparseTable::PrefetchShard(int shard_id,
+                                      std::vector<uint64_t>* keys,
+                                      uint16_t pass_id) {
+  uint64_t start_ms = butil::gettimeofday_ms();
+  // MultiGet is given sorted keys
+  std::sort(keys->begin(), keys->end());
+  keys->erase(std::unique(keys->begin(), keys->end()), keys->end());
+
+  size_t batch_size =
+      std::max(FLAGS_pserver_ssd_prefetch_batch_size, static_cast<int32_t>(1));
+  size_t shard_mem_limit = static_cast<size_t>(
+      std::max(FLAGS_pserver_ssd_prefetch_max_mem_feasign_num,
+               static_cast<int64_t>(0)) /
+      _real_local_shard_num);
+  std::atomic<size_t> loaded_num{0};
+  std::vector<std::future<int>> tasks;
+  for (size_t begin = 0; begin < keys->size(); begin += batch_size) {
+    size_t end = std::min(begin + batch_size, keys->size());
+    auto item = std::make_shared<RocksDBItem>();
+    for (size_t i = begin; i < end; ++i) {
+      item->batch_keys.emplace_back(reinterpret_cast<const char*>(&(*keys)[i]),
+                                    sizeof(uint64_t));
+    }
+    item->batch_values.resize(item->batch_keys.size());
+    item->status.resize(item->batch_keys.size());
+    _db->multi_get(shard_id,
+                   item->batch_keys.size(),
+                   item->batch_keys.data(),
+                   item->batch_values.data(),
+                   item->status.data());
+    // the memory shard is only modified on its own task pool
+    tasks.push_back(
+        _shards_task_pool[shard_id % _shards_task_pool.size()]->enqueue(
+            [this,
+             shard_id,
+             item,
+             shard_mem_limit,
+             pass_id,
+             &loaded_num]() -> int {
+              auto& local_shard = _local_shards[shard_id];
+              for (size_t idx = 0; idx < item->status.size(); ++idx) {
+                if (!item->status[idx].ok()) {
+                  continue;
+                }
+                if (shard_mem_limit > 0 &&
+                    local_shard.size() >= shard_mem_limit) {
+                  break;
+                }
+                uint64_t key = *(reinterpret_cast<const uint64_t*>(
+                    item->batch_keys[idx].data()));
+                // already pulled into memory after the MultiGet
+                if (local_shard.find(key) != local_shard.end()) {
+                  continue;
+                }
+                int data_size = item->batch_values[idx].size() / sizeof(float);
+                auto& feature_value = local_shard[key];
+                feature_value.resize(data_size);
+                memcpy(const_cast<float*>(feature_value.data()),
+                       ::paddle::string::str_to_float(
+                           item->batch_values[idx].data()),
+                       data_size * sizeof(float));
+                _db->del_data(
+                    shard_id, reinterpret_cast<char*>(&key), sizeof(uint64_t));
+#if defined(PADDLE_WITH_PSLIB) || defined(PADDLE_WITH_HETERPS)
+                _value_accessor->UpdatePassId(feature_value.data(), pass_id);
+#endif
+                ++loaded_num;
+              }
+              return 0;
+            }));
+  }
+  for (auto& task : tasks) {
+    task.wait();
+  }
+  VLOG(1) << "SSDSparseTable prefetch shard " << shard_id << ", pass_id "
+          << pass_id << ", keys: " << keys->size()
+          << ", loaded from ssd: " << loaded_num.load()
+          << ", cost: " << butil::gettimeofday_ms() - start_ms << " ms";
+  return 0;
+}
+
 }  // namespace paddle::distributed
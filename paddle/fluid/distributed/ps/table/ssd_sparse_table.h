@@ -62,9 +62,9 @@ class MemRegion {
 
 class SSDSparseTable : public MemorySparseTable {
  public:
-  typedef SparseTableShard<uint64_t, FixedFeatureValue> shard_type;
+  typedef MemorySparseTable::shard_type shard_type;
   SSDSparseTable() {}
-  virtual ~SSDSparseTable() {}
+  virtual ~SSDSparseTable() { WaitPrefetch(); }
 
   int32_t Initialize() override;
   int32_t InitializeShard() override;
@@ -132,9 +132,23 @@ class SSDSparseTable : public MemorySparseTable {
 
   int32_t CacheTable(uint16_t pass_id) override;
 
+  // Loads the keys of the coming pass from rocksdb into the memory shard
+  // asynchronously with batched MultiGet, so that PullSparsePtr of the pass
+  // does not read rocksdb key by key.
+  int32_t Prefetch(int shard_id,
+                   const uint64_t* keys,
+                   size_t num,
+                   uint16_t pass_id) override;
+  // Blocks until all the pending prefetches are done.
+  void WaitPrefetch();
+
   void SetDayId(int day_id) override;
 
  private:
+  int32_t PrefetchShard(int shard_id,
+                        std::vector<uint64_t>* keys,
+                        uint16_t pass_id);
+
   RocksDBHandler* _db;
   int64_t _cache_tk_size;
   double _local_show_threshold{0.0};
@@ -145,6 +159,10 @@ class SSDSparseTable : public MemorySparseTable {
   paddle::framework::AfsWrapper _afs_wrapper;  // afs api wrapper
 #endif
   bool _use_afs_api = false;
+
+  std::shared_ptr<::ThreadPool> _prefetch_pool;
+  std::mutex _prefetch_mutex;
+  std::vector<std::future<int32_t>> _prefetch_tasks;
 };
 
 }  // namespace distributed
@@ -158,6 +158,14 @@ class Table {
   virtual void *GetShard(size_t shard_idx) = 0;
   virtual std::pair<int64_t, int64_t> PrintTableStat() { return {0, 0}; }
   virtual int32_t CacheTable(uint16_t pass_id UNUSED) { return 0; }
+  // Hints the keys of the local shard which will be pulled in the coming
+  // pass, the table may load them into memory in the background.
+  virtual int32_t Prefetch(int shard_id UNUSED,
+                           const uint64_t *keys UNUSED,
+                           size_t num UNUSED,
+                           uint16_t pass_id UNUSED) {
+    return 0;
+  }
 
   // for patch model
   virtual void Revert() {}
@@ -0,0 +1,65 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/rpc/cpp_rpc_handler.h"
+
+#include "paddle/fluid/platform/enforce.h"
+
+namespace paddle::distributed {
+
+CppRpcHandlerRegistry &CppRpcHandlerRegistry::Instance() {
+  static CppRpcHandlerRegistry registry;
+  return registry;
+}
+
+void CppRpcHandlerRegistry::Register(const std::string &name,
+                                     CppRpcHandler handler) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  PADDLE_ENFORCE_EQ(
+      handlers_.emplace(name, std::move(handler)).second,
+      true,
+      common::errors::AlreadyExists("Rpc handler %s is registered.", name));
+}
+
+void CppRpcHandlerRegistry::RegisterStream(const std::string &name,
+                                           CppRpcStreamHandler handler) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  PADDLE_ENFORCE_EQ(stream_handlers_.emplace(name, std::move(handler)).second,
+                    true,
+                    common::errors::AlreadyExists(
+                        "Rpc stream handler %s is registered.", name));
+}
+
+CppRpcHandler CppRpcHandlerRegistry::Get(const std::string &name) const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = handlers_.find(name);
+  PADDLE_ENFORCE_NE(
+      it,
+      handlers_.end(),
+      common::errors::NotFound("Rpc handler %s is not registered.", name));
+  return it->second;
+}
+
+CppRpcStreamHandler CppRpcHandlerRegistry::GetStream(
+    const std::string &name) const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = stream_handlers_.find(name);
+  PADDLE_ENFORCE_NE(it,
+                    stream_handlers_.end(),
+                    common::errors::NotFound(
+                        "Rpc stream handler %s is not registered.", name));
+  return it->second;
+}
+
+}  // namespace paddle::distributed
@@ -0,0 +1,58 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "paddle/common/macros.h"
+
+namespace paddle {
+namespace distributed {
+
+// Handles the message of a request and returns the message of the response.
+using CppRpcHandler = std::function<std::string(const std::string &)>;
+// Handles the message of a request and writes the messages of the response
+// one by one, the stream is closed after the handler returns.
+using CppRpcStreamHandler = std::function<void(
+    const std::string &, const std::function<void(const std::string &)> &)>;
+
+// The handlers called in C++ by their names without the GIL, in place of
+// the pickled Python callables. The handlers should be registered on the
+// worker before the requests arrive and are called concurrently.
+class CppRpcHandlerRegistry {
+ public:
+  static CppRpcHandlerRegistry &Instance();
+
+  void Register(const std::string &name, CppRpcHandler handler);
+  void RegisterStream(const std::string &name, CppRpcStreamHandler handler);
+
+  // Throws if the handler is not registered.
+  CppRpcHandler Get(const std::string &name) const;
+  CppRpcStreamHandler GetStream(const std::string &name) const;
+
+ private:
+  CppRpcHandlerRegistry() = default;
+  DISABLE_COPY_AND_ASSIGN(CppRpcHandlerRegistry);
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, CppRpcHandler> handlers_;
+  std::unordered_map<std::string, CppRpcStreamHandler> stream_handlers_;
+};
+
+}  // namespace distributed
+}  // namespace paddle
@@ -15,6 +15,7 @@
 #include "paddle/fluid/distributed/rpc/rpc_agent.h"
 
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -103,26 +104,166 @@ void OnRpcDone::Run() {
           << " latency=" << cntl_.latency_us() << "us";
 }
 
-std::future<std::string> RpcAgent::InvokeRpc(const std::string &py_func,
-                                             const std::string &to,
-                                             int timeout_ms = kTimeoutMs) {
+std::vector<std::future<std::string>> OnRpcBatchDone::GetFutures() {
+  std::vector<std::future<std::string>> futures;
+  futures.reserve(promises_.size());
+  for (auto &promise : promises_) {
+    futures.push_back(promise.get_future());
+  }
+  return futures;
+}
+
+void OnRpcBatchDone::Run() {
+  // delete this after Run
+  std::unique_ptr<OnRpcBatchDone> self_guard(this);
+  const int size = static_cast<int>(promises_.size());
+  std::string batch_error;
+  if (cntl_.Failed()) {
+    batch_error = cntl_.ErrorText();
+  } else if (response_.responses_size() != size) {
+    batch_error = "The responses of the batch are incomplete.";
+  }
+  for (size_t i = 0; i < promises_.size(); ++i) {
+    if (!batch_error.empty() || response_.responses(i).has_error()) {
+      std::string error = batch_error.empty() ? response_.responses(i).error()
+                                              : batch_error;
+      promises_[i].set_exception(
+          std::make_exception_ptr(std::runtime_error(error)));
+    } else {
+      promises_[i].set_value(response_.responses(i).message());
+    }
+  }
+  VLOG(2) << "Received " << promises_.size() << " responses from "
+          << cntl_.remote_side() << " to " << cntl_.local_side()
+          << " latency=" << cntl_.latency_us() << "us";
+}
+
+int RpcStreamReader::on_received_messages(brpc::StreamId id,
+                                          butil::IOBuf *const messages[],
+                                          size_t size) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    for (size_t i = 0; i < size; ++i) {
+      messages_.push_back(messages[i]->to_string());
+    }
+  }
+  cv_.notify_all();
+  return 0;
+}
+
+void RpcStreamReader::on_closed(brpc::StreamId id) {
+  // release the reference of the stream after the reader is closed
+  std::shared_ptr<RpcStreamReader> self = std::move(self_);
+  Close("");
+}
+
+void RpcStreamReader::Close(const std::string &error) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    closed_ = true;
+    if (error_.empty()) {
+      error_ = error;
+    }
+  }
+  cv_.notify_all();
+}
+
+bool RpcStreamReader::Next(std::string *message) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this] { return !messages_.empty() || closed_; });
+  if (!messages_.empty()) {
+    *message = std::move(messages_.front());
+    messages_.pop_front();
+    return true;
+  }
+  PADDLE_ENFORCE_EQ(
+      error_.empty(),
+      true,
+      common::errors::Unavailable("The rpc stream failed: %s", error_));
+  return false;
+}
+
+std::shared_ptr<brpc::Channel> RpcAgent::GetChannel(
+    const std::string &to) const {
   auto it = name_to_infos_.find(to);
   PADDLE_ENFORCE_NE(it,
                     name_to_infos_.end(),
                     common::errors::OutOfRange("Worker %s doesn't exist!", to));
-  uint32_t id = it->second.id_;
-  auto channel = channels_[id];
+  return channels_[it->second.id_];
+}
+
+std::future<std::string> RpcAgent::InvokeRpc(const std::string &py_func,
+                                             const std::string &to,
+                                             int timeout_ms = kTimeoutMs,
+                                             const std::string &handler) {
+  auto channel = GetChannel(to);
   // `done` must be allocated on the heap because its life cycle is after
   // calling done.Run().
   OnRpcDone *done = new OnRpcDone;
   done->cntl_.set_timeout_ms(timeout_ms);
   done->request_.set_message(py_func);
+  if (!handler.empty()) {
+    done->request_.set_handler(handler);
+  }
   std::future<std::string> fut = done->GetFuture();
   RpcBaseService_Stub stub(channel.get());
   stub.InvokeRpc(&done->cntl_, &done->request_, &done->response_, done);
   return fut;
 }
 
+std::vector<std::future<std::string>> RpcAgent::InvokeRpcBatch(
+    const std::vector<std::string> &msgs,
+    const std::string &to,
+    int timeout_ms,
+    const std::string &handler) {
+  auto channel = GetChannel(to);
+  OnRpcBatchDone *done = new OnRpcBatchDone(msgs.size());
+  done->cntl_.set_timeout_ms(timeout_ms);
+  for (const auto &msg : msgs) {
+    RpcRequest *request = done->request_.add_requests();
+    request->set_message(msg);
+    if (!handler.empty()) {
+      request->set_handler(handler);
+    }
+  }
+  auto futures = done->GetFutures();
+  RpcBaseService_Stub stub(channel.get());
+  stub.InvokeRpcBatch(&done->cntl_, &done->request_, &done->response_, done);
+  return futures;
+}
+
+std::shared_ptr<RpcStreamReader> RpcAgent::InvokeRpcStream(
+    const std::string &msg,
+    const std::string &to,
+    int timeout_ms,
+    const std::string &handler) {
+  auto channel = GetChannel(to);
+  auto reader = std::make_shared<RpcStreamReader>();
+  brpc::Controller cntl;
+  cntl.set_timeout_ms(timeout_ms);
+  brpc::StreamId stream_id;
+  brpc::StreamOptions stream_options;
+  stream_options.handler = reader.get();
+  PADDLE_ENFORCE_EQ(brpc::StreamCreate(&stream_id, cntl, &stream_options),
+                    0,
+                    common::errors::Fatal("Fail to create rpc stream to %s.",
+                                          to));
+  reader->self_ = reader;
+
+  RpcRequest request;
+  request.set_message(msg);
+  request.set_handler(handler);
+  RpcResponse response;
+  RpcBaseService_Stub stub(channel.get());
+  // the messages arrive after the response
+  stub.InvokeRpcStream(&cntl, &request, &response, nullptr);
+  if (cntl.Failed() || response.has_error()) {
+    reader->Close(cntl.Failed() ? cntl.ErrorText() : response.error());
+    brpc::StreamClose(stream_id);
+  }
+  return reader;
+}
+
 std::shared_ptr<RpcAgent> RpcAgent::RpcAgentInstance() {
   PADDLE_ENFORCE_NE(rpc_agent_instance_,
                     nullptr,
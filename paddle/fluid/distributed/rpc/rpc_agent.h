@@ -14,14 +14,18 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "brpc/channel.h"
 #include "brpc/server.h"
+#include "brpc/stream.h"
 #include "paddle/common/macros.h"
 #include "paddle/fluid/distributed/rpc/python_rpc_handler.h"
 #include "paddle/fluid/distributed/rpc/rpc.pb.h"
@@ -59,6 +63,43 @@ class OnRpcDone : public google::protobuf::Closure {
   std::shared_ptr<std::promise<std::string>> promise_;
 };
 
+class OnRpcBatchDone : public google::protobuf::Closure {
+ public:
+  explicit OnRpcBatchDone(size_t size) : promises_(size) {}
+  // process callback of response, a failed call fails its future only
+  void Run();
+  std::vector<std::future<std::string>> GetFutures();
+  RpcBatchResponse response_;
+  RpcBatchRequest request_;
+  brpc::Controller cntl_;
+  std::vector<std::promise<std::string>> promises_;
+};
+
+// Receives the messages of a stream response in order for one reader.
+class RpcStreamReader : public brpc::StreamInputHandler {
+ public:
+  int on_received_messages(brpc::StreamId id,
+                           butil::IOBuf *const messages[],
+                           size_t size) override;
+  void on_idle_timeout(brpc::StreamId id) override {}
+  void on_closed(brpc::StreamId id) override;
+
+  // Blocks until the next message, returns false after the last one.
+  bool Next(std::string *message);
+
+ private:
+  friend class RpcAgent;
+  void Close(const std::string &error);
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::string> messages_;
+  bool closed_ = false;
+  std::string error_;
+  // the stream refers to the reader until it is closed
+  std::shared_ptr<RpcStreamReader> self_;
+};
+
 class RpcAgent {
  public:
   static std::shared_ptr<RpcAgent> RpcAgentInstance();
@@ -91,11 +132,31 @@ class RpcAgent {
   int StartClient();
   int Stop();
 
+  // The message is a pickled Python callable, or the message of the C++
+  // handler registered on the worker by the name.
   std::future<std::string> InvokeRpc(const std::string &msg,
                                      const std::string &to,
-                                     int timeout_ms);
+                                     int timeout_ms,
+                                     const std::string &handler = "");
+
+  // Coalesces the calls to one worker into one request, the futures are set
+  // when the whole batch returns.
+  std::vector<std::future<std::string>> InvokeRpcBatch(
+      const std::vector<std::string> &msgs,
+      const std::string &to,
+      int timeout_ms,
+      const std::string &handler = "");
+
+  // Calls the C++ stream handler registered on the worker, the messages it
+  // writes are read from the returned reader as they arrive.
+  std::shared_ptr<RpcStreamReader> InvokeRpcStream(const std::string &msg,
+                                                   const std::string &to,
+                                                   int timeout_ms,
+                                                   const std::string &handler);
 
  private:
+  std::shared_ptr<brpc::Channel> GetChannel(const std::string &to) const;
+
   DISABLE_COPY_AND_ASSIGN(RpcAgent);
   static std::shared_ptr<RpcAgent> rpc_agent_instance_;
   brpc::Server server_;
@@ -16,10 +16,14 @@
 
 #include <brpc/server.h>
 
+#include <memory>
 #include <string>
 
+#include "brpc/stream.h"
+#include "paddle/fluid/distributed/rpc/cpp_rpc_handler.h"
 #include "paddle/fluid/distributed/rpc/python_rpc_handler.h"
 #include "paddle/fluid/distributed/rpc/rpc.pb.h"
+#include "paddle/fluid/platform/enforce.h"
 
 namespace paddle {
 namespace distributed {
@@ -41,15 +45,116 @@ class RpcService : public RpcBaseService {
             << "] from " << cntl->remote_side() << " to " << cntl->local_side()
             << ": "
             << " (attached=" << cntl->request_attachment() << ")";
-    std::string py_func_str = request->message();
+    if (request->has_handler()) {
+      // C++ handlers are called without the GIL
+      auto handler = CppRpcHandlerRegistry::Instance().Get(request->handler());
+      response->set_message(handler(request->message()));
+      return;
+    }
     std::shared_ptr<PythonRpcHandler> python_handler =
         PythonRpcHandler::GetInstance();
     // acquire gil, because native Python objects are used
     py::gil_scoped_acquire ag;
-    py::object py_func_obj = python_handler->Deserialize(py_func_str);
+    response->set_message(RunPythonRequest(python_handler.get(), *request));
+  }
+
+  virtual void InvokeRpcBatch(google::protobuf::RpcController *cntl_base,
+                              const RpcBatchRequest *request,
+                              RpcBatchResponse *response,
+                              google::protobuf::Closure *done) {
+    brpc::ClosureGuard done_guard(done);
+
+    brpc::Controller *cntl = static_cast<brpc::Controller *>(cntl_base);
+    VLOG(2) << "InvokeRpcBatch API: Received " << request->requests_size()
+            << " requests[log_id=" << cntl->log_id() << "] from "
+            << cntl->remote_side() << " to " << cntl->local_side();
+    std::shared_ptr<PythonRpcHandler> python_handler;
+    // the GIL is taken once for the Python callables of the batch
+    std::unique_ptr<py::gil_scoped_acquire> ag;
+    for (const auto &call : request->requests()) {
+      RpcResponse *call_response = response->add_responses();
+      try {
+        if (call.has_handler()) {
+          ag.reset();
+          auto handler = CppRpcHandlerRegistry::Instance().Get(call.handler());
+          call_response->set_message(handler(call.message()));
+          continue;
+        }
+        if (!ag) {
+          if (!python_handler) {
+            python_handler = PythonRpcHandler::GetInstance();
+          }
+          ag = std::make_unique<py::gil_scoped_acquire>();
+        }
+        call_response->set_message(
+            RunPythonRequest(python_handler.get(), call));
+      } catch (const std::exception &e) {
+        // a failed call doesn't fail the other calls of the batch
+        call_response->set_message("");
+        call_response->set_error(e.what());
+      }
+    }
+  }
+
+  virtual void InvokeRpcStream(google::protobuf::RpcController *cntl_base,
+                               const RpcRequest *request,
+                               RpcResponse *response,
+                               google::protobuf::Closure *done) {
+    brpc::ClosureGuard done_guard(done);
+
+    brpc::Controller *cntl = static_cast<brpc::Controller *>(cntl_base);
+    VLOG(2) << "InvokeRpcStream API: Received request[log_id="
+            << cntl->log_id() << "] from " << cntl->remote_side() << " to "
+            << cntl->local_side();
+    response->set_message("");
+    brpc::StreamId stream_id;
+    brpc::StreamOptions stream_options;
+    if (brpc::StreamAccept(&stream_id, *cntl, &stream_options) != 0) {
+      cntl->SetFailed("Fail to accept the stream of the request");
+      return;
+    }
+    CppRpcStreamHandler handler;
+    try {
+      handler = CppRpcHandlerRegistry::Instance().GetStream(request->handler());
+    } catch (const std::exception &e) {
+      response->set_error(e.what());
+      brpc::StreamClose(stream_id);
+      return;
+    }
+    // the stream is connected after the response is sent, and the messages
+    // are written in this bthread
+    std::string name = request->handler();
+    std::string message = request->message();
+    done_guard.reset(nullptr);
+    auto write = [stream_id](const std::string &chunk) {
+      butil::IOBuf buf;
+      buf.append(chunk);
+      int ret = brpc::StreamWrite(stream_id, buf);
+      while (ret == EAGAIN) {
+        // wait the receiver to consume the messages
+        brpc::StreamWait(stream_id, nullptr);
+        ret = brpc::StreamWrite(stream_id, buf);
+      }
+      PADDLE_ENFORCE_EQ(ret,
+                        0,
+                        common::errors::Unavailable(
+                            "Fail to write the rpc stream, error: %d.", ret));
+    };
+    try {
+      handler(message, write);
+    } catch (const std::exception &e) {
+      LOG(WARNING) << "Rpc stream handler " << name
+                   << " failed: " << e.what();
+    }
+    brpc::StreamClose(stream_id);
+  }
+
+ private:
+  static std::string RunPythonRequest(PythonRpcHandler *python_handler,
+                                      const RpcRequest &request) {
+    py::object py_func_obj = python_handler->Deserialize(request.message());
     py::object res = python_handler->RunPythonFunc(py_func_obj);
-    std::string res_str = python_handler->Serialize(res);
-    response->set_message(res_str);
+    return python_handler->Serialize(res);
   }
 };
 }  // namespace distributed
@@ -301,6 +301,23 @@ void RunBrpcPushSparse() {
     EXPECT_FLOAT_EQ(fea_temp_values[idx], fea_values[idx] - 1.0);
   }
 
+  // pull the same table twice in one request
+  std::vector<float> fea_multi_values(100);
+  std::vector<float*> fea_multi_value_ptr(10);
+  for (size_t idx = 0; idx < fea_keys.size(); ++idx) {
+    fea_multi_value_ptr[idx] = fea_multi_values.data() + idx * 10;
+  }
+  std::vector<paddle::distributed::PullSparseRequest> pull_requests(2);
+  pull_requests[0] = {0, fea_multi_value_ptr.data(), fea_keys.data(), 4};
+  pull_requests[1] = {
+      0, fea_multi_value_ptr.data() + 4, fea_keys.data() + 4, 6};
+  auto pull_multi_status =
+      worker_ptr_->PullSparseMultiTable(pull_requests, true);
+  pull_multi_status.wait();
+  for (int64_t idx = 0; idx < tensor->numel(); ++idx) {
+    EXPECT_FLOAT_EQ(fea_multi_values[idx], fea_temp_values[idx]);
+  }
+
   LOG(INFO) << "Run stop_server";
   worker_ptr_->StopServer();
   LOG(INFO) << "Run finalize_worker";
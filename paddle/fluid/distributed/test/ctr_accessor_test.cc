@@ -15,7 +15,9 @@ limitations under the License. */
 #include "paddle/fluid/distributed/ps/table/ctr_accessor.h"
 
 #include <cmath>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "paddle/fluid/distributed/common/registerer.h"
@@ -314,4 +316,85 @@ TEST(downpour_feature_value_accessor_test, test_string_related) {
     ASSERT_FLOAT_EQ(value[i], 0);
   }
 }
+
+TEST(downpour_feature_value_accessor_test, test_embedx_storage) {
+  const int item_size = 10;
+  for (auto storage : {SparseValueStorage::STORAGE_FP16,
+                       SparseValueStorage::STORAGE_BF16,
+                       SparseValueStorage::STORAGE_INT8}) {
+    TableAccessorParameter parameter = gen_param();
+    parameter.set_embedx_threshold(0);
+    CtrCommonAccessor* fp32_acc = new CtrCommonAccessor();
+    ASSERT_EQ(fp32_acc->Configure(parameter), 0);
+    ASSERT_EQ(fp32_acc->Initialize(), 0);
+    parameter.mutable_ctr_accessor_param()->set_embedx_storage(storage);
+    CtrCommonAccessor* acc = new CtrCommonAccessor();
+    ASSERT_EQ(acc->Configure(parameter), 0);
+    ASSERT_EQ(acc->Initialize(), 0);
+    ASSERT_LT(acc->GetAccessorInfo().dim, fp32_acc->GetAccessorInfo().dim);
+    ASSERT_EQ(acc->GetAccessorInfo().select_dim,
+              fp32_acc->GetAccessorInfo().select_dim);
+    ASSERT_EQ(acc->GetAccessorInfo().update_dim,
+              fp32_acc->GetAccessorInfo().update_dim);
+
+    // the fp32 values start from the unpacked values
+    int w_index = acc->common_feature_value.EmbedxWIndex();
+    std::vector<float> values(item_size * acc->GetAccessorInfo().dim);
+    std::vector<float> fp32_values(item_size * fp32_acc->GetAccessorInfo().dim);
+    std::vector<float*> value(item_size);
+    std::vector<float*> fp32_value(item_size);
+    for (auto i = 0u; i < item_size; ++i) {
+      value[i] = values.data() + i * acc->GetAccessorInfo().dim;
+      fp32_value[i] = fp32_values.data() + i * fp32_acc->GetAccessorInfo().dim;
+    }
+    ASSERT_EQ(acc->Create(value.data(), item_size), 0);
+    for (auto i = 0u; i < item_size; ++i) {
+      memcpy(fp32_value[i], value[i], w_index * sizeof(float));
+      CtrCommonAccessor::UnpackEmbedx(storage,
+                                      value[i] + w_index,
+                                      parameter.embedx_dim(),
+                                      fp32_value[i] + w_index);
+    }
+
+    std::vector<std::vector<float>> push(item_size);
+    std::vector<const float*> grad(item_size);
+    for (auto i = 0u; i < item_size; ++i) {
+      push[i].assign(acc->GetAccessorInfo().update_dim,
+                     static_cast<float>(i) + 1.0);
+      grad[i] = push[i].data();
+    }
+    acc->Update(value.data(), grad.data(), item_size);
+    fp32_acc->Update(fp32_value.data(), grad.data(), item_size);
+
+    size_t select_dim = acc->GetAccessorInfo().select_dim;
+    std::vector<float> select(select_dim);
+    std::vector<float> fp32_select(select_dim);
+    std::vector<float> parsed(acc->GetAccessorInfo().dim);
+    std::vector<float> parsed_select(select_dim);
+    for (auto i = 0u; i < item_size; ++i) {
+      float* select_ptr = select.data();
+      float* fp32_select_ptr = fp32_select.data();
+      const float* value_ptr = value[i];
+      const float* fp32_value_ptr = fp32_value[i];
+      acc->Select(&select_ptr, &value_ptr, 1);
+      fp32_acc->Select(&fp32_select_ptr, &fp32_value_ptr, 1);
+      for (auto j = 0u; j < select_dim; ++j) {
+        ASSERT_NEAR(select[j], fp32_select[j], 1e-2);
+      }
+
+      // the saved value is in fp32 and loads back to the same value
+      auto str = acc->ParseToString(value[i], acc->GetAccessorInfo().dim);
+      ASSERT_EQ(acc->ParseFromString(str, parsed.data()),
+                static_cast<int>(acc->GetAccessorInfo().dim));
+      float* parsed_select_ptr = parsed_select.data();
+      const float* parsed_ptr = parsed.data();
+      acc->Select(&parsed_select_ptr, &parsed_ptr, 1);
+      for (auto j = 0u; j < select_dim; ++j) {
+        ASSERT_NEAR(parsed_select[j], select[j], 1e-4);
+      }
+    }
+    delete acc;
+    delete fp32_acc;
+  }
+}
 }  // namespace paddle::distributed
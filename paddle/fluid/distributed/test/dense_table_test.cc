@@ -226,4 +226,83 @@ TEST(MemoryDenseTable, SGD) {
   }
 }
 
+// MemoryDenseTable + Adam over all the blocks of the shard task pools
+TEST(MemoryDenseTable, AdamBlocks) {
+  int fea_dim = 1000;
+  int trainers = 2;
+
+  TableParameter table_config;
+  table_config.set_table_class("MemoryDenseTable");
+  FsClientParameter fs_config;
+  Table *table = new MemoryDenseTable();
+  TableAccessorParameter *accessor_config = table_config.mutable_accessor();
+  accessor_config->set_accessor_class("CommMergeAccessor");
+  CommonAccessorParameter *common_config = table_config.mutable_common();
+  common_config->set_name("adam");
+  common_config->set_table_name("adam_blocks_test_table");
+  common_config->set_trainer_num(trainers);
+  common_config->add_params("Param");
+  common_config->add_dims(fea_dim);
+  common_config->add_initializers("gaussian_random&0&0.0&1.0");
+  common_config->add_params("LearningRate");
+  common_config->add_dims(1);
+  common_config->add_initializers("fill_constant&0.01");
+  common_config->add_params("Moment1");
+  common_config->add_dims(fea_dim);
+  common_config->add_initializers("fill_constant&0.0");
+  common_config->add_params("Moment2");
+  common_config->add_dims(fea_dim);
+  common_config->add_initializers("fill_constant&0.0");
+  common_config->add_params("Beta1Pow");
+  common_config->add_dims(1);
+  common_config->add_initializers("fill_constant&1.0");
+  common_config->add_params("Beta2Pow");
+  common_config->add_dims(1);
+  common_config->add_initializers("fill_constant&1.0");
+  auto ret = table->Initialize(table_config, fs_config);
+  ASSERT_EQ(ret, 0);
+
+  std::vector<float> param(fea_dim);
+  TableContext init_context;
+  init_context.value_type = Dense;
+  init_context.pull_context.values = param.data();
+  init_context.num = fea_dim;
+  table->Pull(init_context);
+
+  std::vector<float> grad(fea_dim);
+  for (int k = 0; k < fea_dim; k++) {
+    grad[k] = 0.001 * k - 0.5;
+  }
+  // the beta pows advance once per push, not once per block
+  std::vector<double> mom1(fea_dim, 0.0), mom2(fea_dim, 0.0);
+  double beta1_pow = 1.0, beta2_pow = 1.0;
+  for (int i = 0; i < trainers; i++) {
+    TableContext table_context;
+    table_context.value_type = Dense;
+    table_context.push_context.values = grad.data();
+    table_context.num = fea_dim;
+    table->Push(table_context);
+
+    beta1_pow *= 0.9;
+    beta2_pow *= 0.999;
+    double lr = 0.01 * sqrt(1 - beta2_pow) / (1 - beta1_pow);
+    double eps = 1.0e-8 * sqrt(1 - beta2_pow);
+    for (int k = 0; k < fea_dim; k++) {
+      mom1[k] = 0.9 * mom1[k] + 0.1 * grad[k];
+      mom2[k] = 0.999 * mom2[k] + 0.001 * grad[k] * grad[k];
+      param[k] -= lr * mom1[k] / (sqrt(mom2[k]) + eps);
+    }
+  }
+
+  std::vector<float> pull_values(fea_dim);
+  TableContext table_context;
+  table_context.value_type = Dense;
+  table_context.pull_context.values = pull_values.data();
+  table_context.num = fea_dim;
+  table->Pull(table_context);
+  for (int k = 0; k < fea_dim; k++) {
+    ASSERT_NEAR(param[k], pull_values[k], 1e-4);
+  }
+}
+
 }  // namespace paddle::distributed
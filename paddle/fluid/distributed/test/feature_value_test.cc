@@ -45,4 +45,36 @@ TEST(BENCHMARK, LargeScaleKV) {
   ASSERT_FLOAT_EQ(value_data[3], 0.3);
 }
 
+TEST(FixedFeatureValue, ResizeAcrossSizeClasses) {
+  FixedFeatureValue feature_value;
+  feature_value.resize(9);
+  for (size_t i = 0; i < feature_value.size(); ++i) {
+    feature_value.data()[i] = static_cast<float>(i);
+  }
+  // in place within the class of 12 floats
+  float* data = feature_value.data();
+  feature_value.resize(12);
+  ASSERT_EQ(feature_value.data(), data);
+
+  // the mf of a dymf feature moves it into larger classes, and on to malloc
+  for (size_t size : {17, 100, 300, 2000}) {
+    feature_value.resize(size);
+    ASSERT_EQ(feature_value.size(), size);
+    for (size_t i = 0; i < 9; ++i) {
+      ASSERT_FLOAT_EQ(feature_value.data()[i], static_cast<float>(i));
+    }
+    for (size_t i = 9; i < size; ++i) {
+      ASSERT_FLOAT_EQ(feature_value.data()[i], 0.0);
+    }
+  }
+
+  feature_value.resize(5);
+  feature_value.shrink_to_fit();
+  FixedFeatureValue copied = feature_value;
+  ASSERT_EQ(copied.size(), 5UL);
+  for (size_t i = 0; i < 5; ++i) {
+    ASSERT_FLOAT_EQ(copied.data()[i], static_cast<float>(i));
+  }
+}
+
 }  // namespace paddle::distributed
@@ -0,0 +1,114 @@
+/* Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include "paddle/fluid/distributed/ps/table/depends/flat_feature_value.h"
+
+#include <chrono>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "glog/logging.h"
+#include "gtest/gtest.h"
+
+namespace paddle::distributed {
+
+TEST(FlatSparseTableShard, Basic) {
+  typedef FlatSparseTableShard<uint64_t, FixedFeatureValue> shard_type;
+  shard_type shard;
+  std::unordered_map<uint64_t, float> expected;
+  std::mt19937_64 rng(0);
+  for (int i = 0; i < 200000; ++i) {
+    uint64_t key = rng() % 20000;
+    if (rng() % 3 != 0) {
+      auto& feature_value = shard[key];
+      feature_value.resize(1);
+      feature_value.data()[0] = static_cast<float>(i);
+      expected[key] = static_cast<float>(i);
+    } else {
+      ASSERT_EQ(shard.erase(key), expected.erase(key));
+    }
+  }
+  ASSERT_EQ(shard.size(), expected.size());
+  for (auto& item : expected) {
+    auto itr = shard.find(item.first);
+    ASSERT_TRUE(itr != shard.end());
+    ASSERT_FLOAT_EQ(itr.value().data()[0], item.second);
+  }
+
+  size_t num = 0;
+  for (auto it = shard.begin(); it != shard.end();) {
+    ASSERT_EQ(expected.count(it.key()), 1UL);
+    if (it.key() % 2 == 0) {
+      it = shard.erase(it);
+    } else {
+      ++it;
+      ++num;
+    }
+  }
+  ASSERT_EQ(shard.size(), num);
+
+  size_t bucket_num = 0;
+  for (size_t bucket = 0; bucket < shard.bucket_count(); ++bucket) {
+    for (auto it = shard.begin(bucket); it != shard.end(bucket); ++it) {
+      ASSERT_EQ(it.key() % 2, 1UL);
+      ++bucket_num;
+    }
+  }
+  ASSERT_EQ(bucket_num, num);
+
+  shard.clear();
+  ASSERT_TRUE(shard.empty());
+  ASSERT_TRUE(shard.find(1) == shard.end());
+}
+
+template <class SHARD>
+double PullCostMs(const std::vector<uint64_t>& keys, size_t pull_round) {
+  SHARD shard;
+  for (auto key : keys) {
+    shard[key].resize(8);
+  }
+  std::mt19937_64 rng(0);
+  std::vector<uint64_t> pull_keys(keys.size());
+  for (auto& key : pull_keys) {
+    key = keys[rng() % keys.size()];
+  }
+  auto start = std::chrono::steady_clock::now();
+  float sum = 0;
+  for (size_t round = 0; round < pull_round; ++round) {
+    for (auto key : pull_keys) {
+      sum += shard.find(key).value().data()[0];
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  EXPECT_FLOAT_EQ(sum, 0);
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+TEST(BENCHMARK, FlatSparseTableShard) {
+  std::mt19937_64 rng(0);
+  std::vector<uint64_t> keys(1000000);
+  for (auto& key : keys) {
+    key = rng();
+  }
+  double flat_cost =
+      PullCostMs<FlatSparseTableShard<uint64_t, FixedFeatureValue>>(keys, 3);
+  double bucket_cost =
+      PullCostMs<SparseTableShard<uint64_t, FixedFeatureValue>>(keys, 3);
+  LOG(INFO) << "pull " << keys.size() * 3
+            << " keys, FlatSparseTableShard: " << flat_cost
+            << " ms, SparseTableShard: " << bucket_cost << " ms";
+}
+
+}  // namespace paddle::distributed
@@ -25,6 +25,9 @@ limitations under the License. */
 #include "paddle/fluid/distributed/ps/table/table.h"
 #include "paddle/fluid/distributed/the_one_ps.pb.h"
 
+PD_DECLARE_bool(pserver_enable_background_shrink);
+PD_DECLARE_int32(pserver_background_shrink_interval_us);
+
 namespace paddle::distributed {
 
 TEST(MemorySparseTable, SGD) {
@@ -151,4 +154,65 @@ TEST(MemorySparseTable, SGD) {
   }
 }
 
+TEST(MemorySparseTable, BackgroundShrink) {
+  int emb_dim = 8;
+  TableParameter table_config;
+  table_config.set_table_class("MemorySparseTable");
+  table_config.set_shard_num(10);
+  FsClientParameter fs_config;
+  MemorySparseTable *table = new MemorySparseTable();
+  table->SetShard(0, 1);
+
+  TableAccessorParameter *accessor_config = table_config.mutable_accessor();
+  accessor_config->set_accessor_class("CtrCommonAccessor");
+  accessor_config->set_fea_dim(11);
+  accessor_config->set_embedx_dim(emb_dim);
+  accessor_config->mutable_ctr_accessor_param()->set_nonclk_coeff(0.2);
+  accessor_config->mutable_ctr_accessor_param()->set_click_coeff(1);
+  accessor_config->mutable_ctr_accessor_param()->set_delete_threshold(0.8);
+  for (auto *sgd_param : {accessor_config->mutable_embed_sgd_param(),
+                          accessor_config->mutable_embedx_sgd_param()}) {
+    sgd_param->set_name("SparseNaiveSGDRule");
+    auto *naive_param = sgd_param->mutable_naive();
+    naive_param->set_learning_rate(0.1);
+    naive_param->set_initial_range(0.3);
+    naive_param->add_weight_bounds(-10.0);
+    naive_param->add_weight_bounds(10.0);
+  }
+  ASSERT_EQ(static_cast<Table *>(table)->Initialize(table_config, fs_config),
+            0);
+
+  // the keys without show are evicted by the shrink
+  std::vector<uint64_t> keys = {0, 1, 2, 3, 4};
+  std::vector<float> push_values(keys.size() * (emb_dim + 4), 0);
+  for (size_t i = 2; i < keys.size(); ++i) {
+    push_values[i * (emb_dim + 4) + 1] = 10;
+  }
+  TableContext table_context;
+  table_context.value_type = Sparse;
+  table_context.push_context.keys = keys.data();
+  table_context.push_context.values = push_values.data();
+  table_context.num = keys.size();
+  table->Push(table_context);
+  ASSERT_EQ(table->LocalSize(), 5);
+
+  FLAGS_pserver_enable_background_shrink = true;
+  FLAGS_pserver_background_shrink_interval_us = 0;
+  ASSERT_EQ(table->Shrink(""), 0);
+  for (int i = 0; i < 1000; ++i) {
+    if (table->GetBackgroundShrinkStat().finished_passes > 0) {
+      break;
+    }
+    usleep(10000);
+  }
+  auto stat = table->GetBackgroundShrinkStat();
+  FLAGS_pserver_enable_background_shrink = false;
+  ASSERT_EQ(stat.finished_passes, 1);
+  ASSERT_EQ(stat.pending_passes, 0);
+  ASSERT_EQ(stat.swept_buckets, stat.total_buckets);
+  ASSERT_EQ(stat.shrink_size, 2);
+  ASSERT_EQ(table->LocalSize(), 3);
+  delete table;
+}
+
 }  // namespace paddle::distributed
@@ -0,0 +1,621 @@
+/* Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+// The load test of the sparse tables of the parameter server. The clients
+// pull and push batches of keys drawn from a zipfian distribution, and the
+// QPS, the latency percentiles, the cpu time per request and the memory per
+// key are reported.
+//
+// The table is driven in process with --role=table, through a local
+// BrpcPsServer with --role=local, or across hosts with --role=server on the
+// servers and --role=client on the trainers, e.g.
+//
+//   ps_benchmark --role=server --servers=10.0.0.1:8200,10.0.0.2:8200 --rank=0
+//   ps_benchmark --role=client --servers=10.0.0.1:8200,10.0.0.2:8200 \
+//       --stop_servers=true
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "google/protobuf/text_format.h"
+#include "paddle/common/flags.h"
+#include "paddle/fluid/distributed/ps/service/brpc_ps_client.h"
+#include "paddle/fluid/distributed/ps/service/brpc_ps_server.h"
+#include "paddle/fluid/distributed/ps/service/env.h"
+#include "paddle/fluid/distributed/ps/table/table.h"
+#include "paddle/fluid/distributed/the_one_ps.pb.h"
+#include "paddle/fluid/framework/program_desc.h"
+#include "paddle/utils/string/split.h"
+
+PD_DEFINE_string(role, "local", "table|local|server|client.");
+PD_DEFINE_string(servers,
+                 "127.0.0.1:8200",
+                 "Comma separated ip:port of the servers.");
+PD_DEFINE_int32(rank, 0, "Rank of this server among --servers.");
+PD_DEFINE_int32(server_threads, 12, "Threads of the server service.");
+PD_DEFINE_bool(stop_servers,
+               true,
+               "Whether the client stops the servers when it finishes.");
+PD_DEFINE_string(table_class,
+                 "MemorySparseTable",
+                 "MemorySparseTable|SSDSparseTable.");
+PD_DEFINE_string(accessor_class,
+                 "CtrCommonAccessor",
+                 "CtrCommonAccessor|CtrDymfAccessor|CtrDoubleAccessor|"
+                 "SparseAccessor.");
+PD_DEFINE_string(sgd_rule,
+                 "SparseAdaGradSGDRule",
+                 "SGD rule of the embed and the embedx.");
+PD_DEFINE_int32(embedx_dim, 8, "Dim of the embedx.");
+PD_DEFINE_int32(shard_num, 64, "Shards of the table.");
+PD_DEFINE_string(table_config,
+                 "",
+                 "TableParameter in text format which is merged into the "
+                 "config built from the flags, e.g. to set the wire codec.");
+PD_DEFINE_string(op, "both", "pull|push|both.");
+PD_DEFINE_int32(client_threads, 4, "Threads sending the requests.");
+PD_DEFINE_int32(requests, 1000, "Measured requests of each thread.");
+PD_DEFINE_int32(warmup_requests, 100, "Warmup requests of each thread.");
+PD_DEFINE_int32(batch_keys, 4096, "Keys drawn for each request.");
+PD_DEFINE_int64(key_space, 10000000, "Number of distinct keys.");
+PD_DEFINE_double(zipf_s,
+                 1.05,
+                 "Exponent of the zipfian distribution of the keys, 0 means "
+                 "uniform.");
+PD_DEFINE_bool(dedup,
+               true,
+               "Whether the keys of a request are made unique as the "
+               "trainers merge them before pulling.");
+PD_DEFINE_string(result_file, "", "Path of a csv file to append results to.");
+
+namespace paddle {
+namespace distributed {
+
+// Rejection-inversion sampling of the zipfian distribution over [1, n] by
+// Hormann and Derflinger, which needs no table of the n probabilities.
+class ZipfGenerator {
+ public:
+  ZipfGenerator(int64_t n, double s) : n_(n), s_(s) {
+    if (s_ > 0) {
+      h_integral_x1_ = HIntegral(1.5) - 1.0;
+      h_integral_n_ = HIntegral(static_cast<double>(n_) + 0.5);
+      threshold_ = 2.0 - HIntegralInverse(HIntegral(2.5) - H(2.0));
+    }
+  }
+
+  int64_t operator()(std::mt19937_64* rng) {
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    if (s_ <= 0) {
+      return 1 + static_cast<int64_t>(dist(*rng) * n_) % n_;
+    }
+    while (true) {
+      double u = h_integral_n_ + dist(*rng) * (h_integral_x1_ - h_integral_n_);
+      double x = HIntegralInverse(u);
+      int64_t k = static_cast<int64_t>(x + 0.5);
+      k = std::min(std::max(k, static_cast<int64_t>(1)), n_);
+      if (k - x <= threshold_ ||
+          u >= HIntegral(static_cast<double>(k) + 0.5) -
+                   H(static_cast<double>(k))) {
+        return k;
+      }
+    }
+  }
+
+ private:
+  double H(double x) const { return std::exp(-s_ * std::log(x)); }
+
+  double HIntegral(double x) const {
+    double log_x = std::log(x);
+    return Helper2((1.0 - s_) * log_x) * log_x;
+  }
+
+  double HIntegralInverse(double x) const {
+    double t = std::max(x * (1.0 - s_), -1.0);
+    return std::exp(Helper1(t) * x);
+  }
+
+  // log1p(x) / x and expm1(x) / x, which are stable around 0.
+  static double Helper1(double x) {
+    if (std::abs(x) > 1e-8) return std::log1p(x) / x;
+    return 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+  }
+  static double Helper2(double x) {
+    if (std::abs(x) > 1e-8) return std::expm1(x) / x;
+    return 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
+  }
+
+  int64_t n_;
+  double s_;
+  double h_integral_x1_{0};
+  double h_integral_n_{0};
+  double threshold_{0};
+};
+
+// The hot ranks are scattered over the shards and the servers, a multiply by
+// an odd constant is a bijection of the keys.
+inline uint64_t RankToKey(int64_t rank) {
+  return static_cast<uint64_t>(rank) * 0x9E3779B97F4A7C15ULL;
+}
+
+void GetTableParameter(TableParameter* table) {
+  table->set_table_id(0);
+  table->set_table_class(FLAGS_table_class);
+  table->set_shard_num(FLAGS_shard_num);
+  TableAccessorParameter* accessor = table->mutable_accessor();
+  accessor->set_accessor_class(FLAGS_accessor_class);
+  accessor->set_embedx_dim(FLAGS_embedx_dim);
+  accessor->set_fea_dim(FLAGS_embedx_dim + 3);
+  accessor->set_embedx_threshold(0);
+  auto* ctr = accessor->mutable_ctr_accessor_param();
+  ctr->set_nonclk_coeff(0.1);
+  ctr->set_click_coeff(1);
+  ctr->set_base_threshold(0.5);
+  ctr->set_delta_threshold(0.2);
+  ctr->set_delta_keep_days(16);
+  ctr->set_show_click_decay_rate(0.98);
+  for (auto* sgd : {accessor->mutable_embed_sgd_param(),
+                    accessor->mutable_embedx_sgd_param()}) {
+    sgd->set_name(FLAGS_sgd_rule);
+    sgd->mutable_naive()->set_learning_rate(0.05);
+    sgd->mutable_naive()->set_initial_range(1e-4);
+    sgd->mutable_naive()->add_weight_bounds(-10.0);
+    sgd->mutable_naive()->add_weight_bounds(10.0);
+    sgd->mutable_adagrad()->set_learning_rate(0.05);
+    sgd->mutable_adagrad()->set_initial_g2sum(3.0);
+    sgd->mutable_adagrad()->set_initial_range(1e-4);
+    sgd->mutable_adagrad()->add_weight_bounds(-10.0);
+    sgd->mutable_adagrad()->add_weight_bounds(10.0);
+    sgd->mutable_adam()->set_learning_rate(0.001);
+    sgd->mutable_adam()->set_initial_range(1e-4);
+    sgd->mutable_adam()->add_weight_bounds(-10.0);
+    sgd->mutable_adam()->add_weight_bounds(10.0);
+  }
+  if (!FLAGS_table_config.empty()) {
+    std::ifstream file(FLAGS_table_config);
+    std::string text((std::istreambuf_iterator<char>(file)),
+                     std::istreambuf_iterator<char>());
+    PADDLE_ENFORCE_EQ(
+        google::protobuf::TextFormat::MergeFromString(text, table),
+        true,
+        common::errors::InvalidArgument("Failed to parse the table config %s.",
+                                        FLAGS_table_config));
+  }
+}
+
+void GetServiceParameter(ServerParameter* server) {
+  auto* downpour = server->mutable_downpour_server_param();
+  auto* service = downpour->mutable_service_param();
+  service->set_service_class("BrpcPsService");
+  service->set_server_class("BrpcPsServer");
+  service->set_client_class("BrpcPsClient");
+  service->set_start_server_port(0);
+  service->set_server_thread_num(FLAGS_server_threads);
+  GetTableParameter(downpour->add_downpour_table_param());
+}
+
+PSParameter GetServerProto() {
+  PSParameter proto;
+  GetServiceParameter(proto.mutable_server_param());
+  return proto;
+}
+
+PSParameter GetWorkerProto() {
+  PSParameter proto;
+  GetTableParameter(proto.mutable_worker_param()
+                        ->mutable_downpour_worker_param()
+                        ->add_downpour_table_param());
+  GetServiceParameter(proto.mutable_server_param());
+  return proto;
+}
+
+std::vector<std::string> GetHostSigns() {
+  std::vector<std::string> signs;
+  auto endpoints = paddle::string::Split(FLAGS_servers, ',');
+  for (size_t i = 0; i < endpoints.size(); ++i) {
+    auto ip_port = paddle::string::Split(endpoints[i], ':');
+    PADDLE_ENFORCE_EQ(ip_port.size(),
+                      2UL,
+                      common::errors::InvalidArgument(
+                          "The server should be ip:port, but got %s.",
+                          endpoints[i]));
+    signs.push_back(PSHost(ip_port[0], std::stoi(ip_port[1]), i)
+                        .SerializeToString());
+  }
+  return signs;
+}
+
+// The resident memory of the process in bytes.
+int64_t ResidentBytes() {
+  std::ifstream statm("/proc/self/statm");
+  int64_t size = 0, resident = 0;
+  statm >> size >> resident;
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+// The user and the system cpu time of the process in seconds.
+double CpuSeconds() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1e-6 +
+         usage.ru_stime.tv_sec + usage.ru_stime.tv_usec * 1e-6;
+}
+
+// Sends the pulls and the pushes of one request, either to a table in this
+// process or through a BrpcPsClient.
+class Driver {
+ public:
+  virtual ~Driver() {}
+  virtual size_t SelectDim() = 0;
+  virtual size_t UpdateDim() = 0;
+  virtual void Pull(std::vector<uint64_t>* keys, float* values) = 0;
+  virtual void Push(const std::vector<uint64_t>& keys, const float* grads) = 0;
+  // The number of keys in the tables of this process, 0 when they are remote.
+  virtual int64_t LocalKeys() = 0;
+};
+
+class TableDriver : public Driver {
+ public:
+  TableDriver() {
+    TableParameter config;
+    GetTableParameter(&config);
+    table_.reset(CREATE_PSCORE_CLASS(Table, config.table_class()));
+    PADDLE_ENFORCE_NOT_NULL(
+        table_,
+        common::errors::InvalidArgument("Unknown table class %s.",
+                                        config.table_class()));
+    table_->SetShard(0, 1);
+    FsClientParameter fs_config;
+    PADDLE_ENFORCE_EQ(table_->Initialize(config, fs_config),
+                      0,
+                      common::errors::InvalidArgument(
+                          "Failed to initialize the table."));
+  }
+
+  size_t SelectDim() override {
+    return table_->GetValueAccessor()->GetAccessorInfo().select_size /
+           sizeof(float);
+  }
+  size_t UpdateDim() override {
+    return table_->GetValueAccessor()->GetAccessorInfo().update_size /
+           sizeof(float);
+  }
+
+  void Pull(std::vector<uint64_t>* keys, float* values) override {
+    std::vector<uint32_t> fres(keys->size(), 1);
+    TableContext context;
+    context.value_type = Sparse;
+    context.pull_context.pull_value =
+        PullSparseValue(*keys, fres, static_cast<int>(SelectDim()));
+    context.pull_context.values = values;
+    table_->Pull(context);
+  }
+
+  void Push(const std::vector<uint64_t>& keys, const float* grads) override {
+    TableContext context;
+    context.value_type = Sparse;
+    context.push_context.keys = keys.data();
+    context.push_context.values = grads;
+    context.num = keys.size();
+    table_->Push(context);
+  }
+
+  int64_t LocalKeys() override { return table_->PrintTableStat().first; }
+
+ private:
+  std::unique_ptr<Table> table_;
+};
+
+class BrpcDriver : public Driver {
+ public:
+  BrpcDriver(PSServer* local_server, const std::vector<std::string>& signs)
+      : local_server_(local_server), signs_(signs) {
+    PSParameter proto = GetWorkerProto();
+    env_.SetPsServers(&signs_, signs_.size());
+    client_.reset(PSClientFactory::Create(proto));
+    std::map<uint64_t, std::vector<Region>> dense_regions;
+    dense_regions[0] = {};
+    client_->Configure(proto, dense_regions, env_, 0);
+    accessor_ = client_->GetTableAccessor(0);
+  }
+
+  ~BrpcDriver() override {
+    if (FLAGS_stop_servers || local_server_ != nullptr) {
+      client_->StopServer();
+    }
+    client_->FinalizeWorker();
+  }
+
+  size_t SelectDim() override {
+    return accessor_->GetAccessorInfo().select_size / sizeof(float);
+  }
+  size_t UpdateDim() override {
+    return accessor_->GetAccessorInfo().update_size / sizeof(float);
+  }
+
+  void Pull(std::vector<uint64_t>* keys, float* values) override {
+    size_t dim = SelectDim();
+    std::vector<float*> ptrs(keys->size());
+    for (size_t i = 0; i < keys->size(); ++i) {
+      ptrs[i] = values + i * dim;
+    }
+    client_->PullSparse(ptrs.data(), 0, keys->data(), keys->size(), true)
+        .wait();
+  }
+
+  void Push(const std::vector<uint64_t>& keys, const float* grads) override {
+    size_t dim = UpdateDim();
+    std::vector<const float*> ptrs(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+      ptrs[i] = grads + i * dim;
+    }
+    auto* closure = new DownpourBrpcClosure(1, [](void* done) {
+      auto* closure = reinterpret_cast<DownpourBrpcClosure*>(done);
+      closure->set_promise_value(
+          closure->check_response(0, PS_PUSH_SPARSE_TABLE));
+    });
+    client_
+        ->PushSparseRawGradient(
+            0, keys.data(), ptrs.data(), keys.size(), closure)
+        .wait();
+  }
+
+  int64_t LocalKeys() override {
+    if (local_server_ == nullptr) {
+      return 0;
+    }
+    auto* table = local_server_->GetTable(0);
+    return table == nullptr ? 0 : table->PrintTableStat().first;
+  }
+
+ private:
+  PSServer* local_server_;
+  std::vector<std::string> signs_;
+  PaddlePSEnvironment env_;
+  std::unique_ptr<PSClient> client_;
+  ValueAccessor* accessor_;
+};
+
+double Percentile(const std::vector<double>& sorted, double p) {
+  if (sorted.empty()) return 0;
+  size_t idx = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+  return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+void Report(const std::string& op,
+            std::vector<double>* latencies,
+            size_t keys,
+            double seconds,
+            double cpu_seconds,
+            int64_t local_keys,
+            int64_t memory_bytes) {
+  if (latencies->empty()) return;
+  std::sort(latencies->begin(), latencies->end());
+  double qps = latencies->size() / seconds;
+  double cpu_us = cpu_seconds * 1e6 / latencies->size();
+  double bytes_per_key =
+      local_keys > 0 ? static_cast<double>(memory_bytes) / local_keys : -1;
+  double p50 = Percentile(*latencies, 0.50);
+  double p95 = Percentile(*latencies, 0.95);
+  double p99 = Percentile(*latencies, 0.99);
+  printf(
+      "%-6s %-18s %-18s qps %10.1f keys/s %12.0f p50 %8.3fms p95 %8.3fms "
+      "p99 %8.3fms cpu/req %9.1fus bytes/key %8.1f\n",
+      op.c_str(),
+      FLAGS_table_class.c_str(),
+      FLAGS_accessor_class.c_str(),
+      qps,
+      keys / seconds,
+      p50,
+      p95,
+      p99,
+      cpu_us,
+      bytes_per_key);
+  if (!FLAGS_result_file.empty()) {
+    std::ofstream out(FLAGS_result_file, std::ios::app);
+    out << FLAGS_role << "," << op << "," << FLAGS_table_class << ","
+        << FLAGS_accessor_class << "," << FLAGS_client_threads << ","
+        << FLAGS_batch_keys << "," << FLAGS_zipf_s << "," << qps << ","
+        << keys / seconds << "," << p50 << "," << p95 << "," << p99 << ","
+        << cpu_us << "," << bytes_per_key << "\n";
+  }
+}
+
+void RunLoad(Driver* driver) {
+  const bool pull = FLAGS_op != "push";
+  const bool push = FLAGS_op != "pull";
+  const size_t select_dim = driver->SelectDim();
+  const size_t update_dim = driver->UpdateDim();
+  ZipfGenerator zipf(FLAGS_key_space, FLAGS_zipf_s);
+
+  std::vector<std::vector<double>> pull_latencies(FLAGS_client_threads);
+  std::vector<std::vector<double>> push_latencies(FLAGS_client_threads);
+  std::atomic<size_t> pull_keys{0}, push_keys{0};
+  std::atomic<int> ready{0};
+  std::atomic<bool> go{false};
+  int64_t memory_before = ResidentBytes();
+  int64_t keys_before = driver->LocalKeys();
+
+  auto worker = [&](int tid) {
+    std::mt19937_64 rng(tid + 1);
+    std::vector<uint64_t> keys;
+    std::vector<float> values;
+    std::vector<float> grads;
+    auto run = [&](bool measure) {
+      keys.resize(FLAGS_batch_keys);
+      for (auto& key : keys) {
+        key = RankToKey(zipf(&rng));
+      }
+      if (FLAGS_dedup) {
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+      }
+      if (pull) {
+        values.resize(keys.size() * select_dim);
+        auto start = std::chrono::steady_clock::now();
+        driver->Pull(&keys, values.data());
+        auto end = std::chrono::steady_clock::now();
+        if (measure) {
+          pull_latencies[tid].push_back(
+              std::chrono::duration<double, std::milli>(end - start).count());
+          pull_keys += keys.size();
+        }
+      }
+      if (push) {
+        // slot, show, click and the gradients, with the mf dim of the
+        // CtrDymfAccessor before the gradients.
+        grads.resize(keys.size() * update_dim);
+        std::uniform_real_distribution<float> dist(-1e-3f, 1e-3f);
+        for (size_t i = 0; i < keys.size(); ++i) {
+          float* grad = grads.data() + i * update_dim;
+          for (size_t j = 0; j < update_dim; ++j) grad[j] = dist(rng);
+          grad[0] = 0;
+          grad[1] = 1;
+          grad[2] = (rng() % 10 == 0) ? 1 : 0;
+          if (FLAGS_accessor_class == "CtrDymfAccessor") {
+            grad[3] = FLAGS_embedx_dim;
+          }
+        }
+        auto start = std::chrono::steady_clock::now();
+        driver->Push(keys, grads.data());
+        auto end = std::chrono::steady_clock::now();
+        if (measure) {
+          push_latencies[tid].push_back(
+              std::chrono::duration<double, std::milli>(end - start).count());
+          push_keys += keys.size();
+        }
+      }
+    };
+    for (int i = 0; i < FLAGS_warmup_requests; ++i) run(false);
+    ++ready;
+    while (!go) std::this_thread::yield();
+    for (int i = 0; i < FLAGS_requests; ++i) run(true);
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < FLAGS_client_threads; ++i) {
+    threads.emplace_back(worker, i);
+  }
+  while (ready < FLAGS_client_threads) std::this_thread::yield();
+  double cpu_start = CpuSeconds();
+  auto start = std::chrono::steady_clock::now();
+  go = true;
+  for (auto& t : threads) t.join();
+  auto end = std::chrono::steady_clock::now();
+  double cpu_seconds = CpuSeconds() - cpu_start;
+  double seconds = std::chrono::duration<double>(end - start).count();
+
+  // The memory per key covers the keys created by the warmup and the run.
+  int64_t local_keys = driver->LocalKeys() - keys_before;
+  int64_t memory_bytes = ResidentBytes() - memory_before;
+  std::vector<double> pulls, pushes;
+  for (auto& l : pull_latencies) pulls.insert(pulls.end(), l.begin(), l.end());
+  for (auto& l : push_latencies) {
+    pushes.insert(pushes.end(), l.begin(), l.end());
+  }
+  // The cpu time is split by the number of requests of either op, a request
+  // of --op=both is a pull and a push.
+  size_t requests = std::max(pulls.size(), pushes.size());
+  Report("pull",
+         &pulls,
+         pull_keys,
+         seconds,
+         pull && push ? cpu_seconds / 2 : cpu_seconds,
+         local_keys,
+         memory_bytes);
+  Report("push",
+         &pushes,
+         push_keys,
+         seconds,
+         pull && push ? cpu_seconds / 2 : cpu_seconds,
+         local_keys,
+         memory_bytes);
+  LOG(INFO) << "Sent " << requests << " requests in " << seconds << "s, "
+            << local_keys << " keys are created in this process.";
+}
+
+std::shared_ptr<PSServer> CreateServer(const std::vector<std::string>& signs,
+                                       PaddlePSEnvironment* env) {
+  PSParameter proto = GetServerProto();
+  env->SetPsServers(&signs, signs.size());
+  std::shared_ptr<PSServer> server(PSServerFactory::Create(proto));
+  std::vector<framework::ProgramDesc> empty_vec(1);
+  server->Configure(proto, *env, FLAGS_rank, empty_vec);
+  return server;
+}
+
+int Main() {
+  setenv("http_proxy", "", 1);
+  setenv("https_proxy", "", 1);
+  if (FLAGS_role == "table") {
+    TableDriver driver;
+    RunLoad(&driver);
+    return 0;
+  }
+
+  std::vector<std::string> signs = GetHostSigns();
+  PSHost host;
+  host.ParseFromString(signs.at(FLAGS_rank));
+  if (FLAGS_role == "server") {
+    PaddlePSEnvironment env;
+    auto server = CreateServer(signs, &env);
+    // Returns once a client stops the servers.
+    server->Start(host.ip, host.port);
+    return 0;
+  }
+  if (FLAGS_role == "client") {
+    BrpcDriver driver(nullptr, signs);
+    RunLoad(&driver);
+    return 0;
+  }
+  PADDLE_ENFORCE_EQ(FLAGS_role,
+                    "local",
+                    common::errors::InvalidArgument(
+                        "The role should be table, local, server or client, "
+                        "but got %s.",
+                        FLAGS_role));
+  PADDLE_ENFORCE_EQ(signs.size(),
+                    1UL,
+                    common::errors::InvalidArgument(
+                        "The local role runs a single server."));
+  PaddlePSEnvironment env;
+  auto server = CreateServer(signs, &env);
+  std::thread server_thread([&]() { server->Start(host.ip, host.port); });
+  sleep(1);
+  {
+    BrpcDriver driver(server.get(), signs);
+    RunLoad(&driver);
+  }
+  server_thread.join();
+  return 0;
+}
+
+}  // namespace distributed
+}  // namespace paddle
+
+int main(int argc, char** argv) {
+  paddle::flags::ParseCommandLineFlags(&argc, &argv);
+  return paddle::distributed::Main();
+}
@@ -0,0 +1,215 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/fluid/distributed/ps/table/common_graph_table.h"
+
+namespace distributed = paddle::distributed;
+
+using SampleCache =
+    distributed::ClockSampleCache<distributed::SampleKey,
+                                  distributed::SampleResult>;
+
+distributed::SampleResult MakeResult(size_t size) {
+  return distributed::SampleResult(size, new char[size]);
+}
+
+TEST(ClockSampleCache, QueryInsertTtl) {
+  SampleCache cache(1, 4, 3);
+  distributed::SampleKey key(0, 7, 10, false);
+  distributed::SampleResult result = MakeResult(16);
+  std::vector<std::pair<distributed::SampleKey, distributed::SampleResult>> r;
+  cache.query(0, &key, 1, r);
+  ASSERT_EQ(r.size(), 0UL);
+
+  cache.insert(0, &key, &result, 1);
+  for (size_t i = 0; i < cache.get_ttl(); i++) {
+    cache.query(0, &key, 1, r);
+    ASSERT_EQ(r.size(), 1UL);
+    ASSERT_EQ(r[0].second.buffer.get(), result.buffer.get());
+    r.clear();
+  }
+  // dropped after ttl hits
+  cache.query(0, &key, 1, r);
+  ASSERT_EQ(r.size(), 0UL);
+  ASSERT_EQ(cache.size(), 0UL);
+  ASSERT_EQ(cache.query_count(), 5UL);
+  ASSERT_EQ(cache.hit_count(), 3UL);
+}
+
+TEST(ClockSampleCache, ClockEviction) {
+  SampleCache cache(1, 4, 100);
+  std::vector<distributed::SampleKey> keys;
+  std::vector<distributed::SampleResult> results;
+  for (uint64_t i = 0; i < 5; i++) {
+    keys.emplace_back(0, i, 10, false);
+    results.push_back(MakeResult(8));
+  }
+  cache.insert(0, keys.data(), results.data(), 4);
+  // the hit keys survive one round of the hand
+  std::vector<std::pair<distributed::SampleKey, distributed::SampleResult>> r;
+  cache.query(0, keys.data(), 2, r);
+  cache.insert(0, &keys[4], &results[4], 1);
+  ASSERT_EQ(cache.size(), 4UL);
+  ASSERT_EQ(cache.evict_count(), 1UL);
+  r.clear();
+  cache.query(0, keys.data(), 5, r);
+  ASSERT_EQ(r.size(), 4UL);
+  EXPECT_EQ(r[0].first.node_key, 0UL);
+  EXPECT_EQ(r[1].first.node_key, 1UL);
+  EXPECT_EQ(r[2].first.node_key, 3UL);
+  EXPECT_EQ(r[3].first.node_key, 4UL);
+}
+
+TEST(ClockSampleCache, ByteLimit) {
+  SampleCache cache(1, 100, 100, 64);
+  std::vector<distributed::SampleKey> keys;
+  std::vector<distributed::SampleResult> results;
+  for (uint64_t i = 0; i < 8; i++) {
+    keys.emplace_back(0, i, 10, false);
+    results.push_back(MakeResult(16));
+  }
+  cache.insert(0, keys.data(), results.data(), keys.size());
+  ASSERT_EQ(cache.size(), 4UL);
+  // a value larger than the shard is not cached
+  distributed::SampleKey big_key(0, 100, 10, false);
+  distributed::SampleResult big_result = MakeResult(128);
+  cache.insert(0, &big_key, &big_result, 1);
+  std::vector<std::pair<distributed::SampleKey, distributed::SampleResult>> r;
+  cache.query(0, &big_key, 1, r);
+  ASSERT_EQ(r.size(), 0UL);
+}
+
+// Replays a trace of sampled node ids on ScaledLRU and ClockSampleCache from
+// as many threads as shards, as GraphTable::random_sample_neighbors does.
+// The trace is read from SAMPLE_CACHE_TRACE if it is set, one node id per
+// line, and is a zipf distribution of node ids otherwise.
+std::vector<uint64_t> LoadTrace() {
+  std::vector<uint64_t> trace;
+  const char *path = std::getenv("SAMPLE_CACHE_TRACE");
+  if (path != nullptr) {
+    std::ifstream file(path);
+    uint64_t id;
+    while (file >> id) {
+      trace.push_back(id);
+    }
+    return trace;
+  }
+  const int node_num = 100000;
+  std::vector<double> weights(node_num);
+  for (int i = 0; i < node_num; i++) {
+    weights[i] = 1.0 / (i + 1);
+  }
+  std::discrete_distribution<int> distrib(weights.begin(), weights.end());
+  std::mt19937_64 rng(0);
+  trace.resize(400000);
+  for (auto &id : trace) {
+    id = distrib(rng);
+  }
+  return trace;
+}
+
+struct ReplayStat {
+  double seconds;
+  double hit_rate;
+  size_t blocked;
+};
+
+template <typename Cache>
+ReplayStat Replay(Cache *cache,
+                  const std::vector<uint64_t> &trace,
+                  size_t thread_num,
+                  size_t batch_size) {
+  std::atomic<size_t> query_count{0}, hit_count{0}, blocked{0};
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < thread_num; t++) {
+    threads.emplace_back([&, t]() {
+      std::vector<distributed::SampleKey> keys, miss_keys;
+      std::vector<distributed::SampleResult> miss_results;
+      std::vector<std::pair<distributed::SampleKey, distributed::SampleResult>>
+          r;
+      for (size_t begin = 0; begin < trace.size(); begin += batch_size) {
+        keys.clear();
+        for (size_t i = begin; i < begin + batch_size && i < trace.size();
+             i++) {
+          if (trace[i] % thread_num == t) {
+            keys.emplace_back(0, trace[i], 10, false);
+          }
+        }
+        r.clear();
+        if (cache->query(t, keys.data(), keys.size(), r) !=
+            distributed::LRUResponse::ok) {
+          // the batch is sampled without the cache
+          blocked++;
+          continue;
+        }
+        query_count += keys.size();
+        hit_count += r.size();
+        miss_keys.clear();
+        miss_results.clear();
+        size_t index = 0;
+        for (auto &key : keys) {
+          if (index < r.size() && r[index].first.node_key == key.node_key) {
+            index++;
+          } else {
+            miss_keys.push_back(key);
+            miss_results.push_back(MakeResult(80));
+          }
+        }
+        cache->insert(
+            t, miss_keys.data(), miss_results.data(), miss_keys.size());
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ReplayStat stat;
+  stat.seconds = std::chrono::duration<double>(
+                     std::chrono::steady_clock::now() - start)
+                     .count();
+  stat.hit_rate = query_count == 0 ? 0 : 1.0 * hit_count / query_count;
+  stat.blocked = blocked;
+  return stat;
+}
+
+TEST(ClockSampleCache, ReplayTrace) {
+  std::vector<uint64_t> trace = LoadTrace();
+  const size_t size_limit = 20000, ttl = 5, batch_size = 512;
+  for (size_t thread_num : {1, 4, 16}) {
+    distributed::ScaledLRU<distributed::SampleKey, distributed::SampleResult>
+        lru(thread_num, size_limit, ttl);
+    ReplayStat lru_stat = Replay(&lru, trace, thread_num, batch_size);
+    SampleCache clock(thread_num, size_limit, ttl);
+    ReplayStat clock_stat = Replay(&clock, trace, thread_num, batch_size);
+    EXPECT_EQ(clock_stat.blocked, 0UL);
+    EXPECT_GT(clock_stat.hit_rate, 0);
+    EXPECT_LE(clock.size(), size_limit);
+    LOG(INFO) << "threads " << thread_num << ": ScaledLRU "
+              << lru_stat.seconds << "s, hit rate " << lru_stat.hit_rate
+              << ", blocked batches " << lru_stat.blocked
+              << "; ClockSampleCache " << clock_stat.seconds
+              << "s, hit rate " << clock_stat.hit_rate << ", evicted "
+              << clock.evict_count();
+  }
+}
@@ -16,8 +16,10 @@ limitations under the License. */
 
 #include <cmath>
 #include <iostream>
+#include <random>
 
 #include "gtest/gtest.h"
+#include "paddle/fluid/distributed/ps/table/sparse_sgd_rule_kernel.h"
 #include "paddle/fluid/distributed/the_one_ps.pb.h"
 
 namespace paddle::distributed {
@@ -204,4 +206,45 @@ TEST(downpour_sparse_adam_test, test_init_and_update) {
     ASSERT_FLOAT_EQ(value[i], label[i]) << "i is " << i;
   }
 }
+
+TEST(sparse_sgd_kernel_test, match_scalar) {
+  // a dim which is not a multiple of the SIMD width checks the tails
+  const size_t kDim = 37;
+  const SparseSGDKernel& kernel = GetSparseSGDKernel();
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> distrib(-1, 1);
+  float w[kDim], g2sum[kDim], grad[kDim];  // NOLINT
+  float label_w[kDim], label_g2sum[kDim];  // NOLINT
+  for (size_t i = 0; i < kDim; ++i) {
+    w[i] = label_w[i] = distrib(rng);
+    g2sum[i] = label_g2sum[i] = std::fabs(distrib(rng));
+    grad[i] = distrib(rng) * 10;
+  }
+
+  kernel.std_adagrad(kDim, w, g2sum, grad, 2, 0.05, 0.1, -0.5, 0.5);
+  for (size_t i = 0; i < kDim; ++i) {
+    double scaled_grad = grad[i] / 2;
+    label_w[i] -= 0.05 * scaled_grad * sqrt(0.1 / (0.1 + label_g2sum[i]));
+    label_w[i] = std::min(std::max(label_w[i], -0.5f), 0.5f);
+    label_g2sum[i] += scaled_grad * scaled_grad;
+    ASSERT_NEAR(w[i], label_w[i], 1e-6) << "i is " << i;
+    ASSERT_NEAR(g2sum[i], label_g2sum[i], 1e-4) << "i is " << i;
+  }
+
+  double label_add_g2sum = 0;
+  double add_g2sum = kernel.adagrad(kDim, w, grad, 2, 0.05, 0.5, -0.5, 0.5);
+  for (size_t i = 0; i < kDim; ++i) {
+    double scaled_grad = grad[i] / 2;
+    label_w[i] -= 0.05 * scaled_grad * 0.5;
+    label_w[i] = std::min(std::max(label_w[i], -0.5f), 0.5f);
+    label_add_g2sum += scaled_grad * scaled_grad;
+    ASSERT_NEAR(w[i], label_w[i], 1e-6) << "i is " << i;
+  }
+  ASSERT_NEAR(add_g2sum, label_add_g2sum, 1e-3);
+
+  kernel.add(kDim, w, grad);
+  for (size_t i = 0; i < kDim; ++i) {
+    ASSERT_FLOAT_EQ(w[i], label_w[i] + grad[i]);
+  }
+}
 }  // namespace paddle::distributed
@@ -0,0 +1,105 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/ps/service/sparse_wire_codec.h"
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace paddle::distributed {
+
+TEST(SparseWireCodec, Flags) {
+  SparseWireCodecParameter param;
+  ASSERT_TRUE(SparseWireCodec::ForPull(param).IsRaw());
+  ASSERT_TRUE(SparseWireCodec::ForPush(param).IsRaw());
+  param.set_compress_keys(true);
+  param.set_pull_value_codec(SparseValueCodec::VALUE_INT8);
+  param.set_pull_raw_dim(2);
+  SparseWireCodec codec = SparseWireCodec::ForPull(param);
+  SparseWireCodec decoded(codec.Flags());
+  ASSERT_FALSE(decoded.IsRaw());
+  ASSERT_TRUE(decoded.CompressKeys());
+  ASSERT_EQ(decoded.Flags(), codec.Flags());
+  ASSERT_EQ(decoded.ValueSize(10), 2 * sizeof(float) + sizeof(float) + 8);
+}
+
+TEST(SparseWireCodec, Keys) {
+  std::vector<uint64_t> keys = {0, 1, 1, 300, 70000, UINT64_MAX - 1};
+  std::vector<uint32_t> counts = {1, 2, 1, 1000, 1, 7};
+  for (bool compress_keys : {false, true}) {
+    SparseWireCodecParameter param;
+    param.set_compress_keys(compress_keys);
+    SparseWireCodec codec = SparseWireCodec::ForPull(param);
+    std::string data;
+    codec.EncodeKeys(keys.data(), keys.size(), &data);
+    codec.EncodeCounts(counts.data(), counts.size(), &data);
+    if (compress_keys) {
+      ASSERT_LT(data.size(), keys.size() * sizeof(uint64_t));
+    }
+    std::vector<uint64_t> decoded_keys(keys.size());
+    std::vector<uint32_t> decoded_counts(counts.size());
+    size_t len = codec.DecodeKeys(
+        data.data(), data.size(), keys.size(), decoded_keys.data());
+    ASSERT_GT(len, 0UL);
+    ASSERT_GT(codec.DecodeCounts(data.data() + len,
+                                 data.size() - len,
+                                 counts.size(),
+                                 decoded_counts.data()),
+              0UL);
+    ASSERT_EQ(decoded_keys, keys);
+    ASSERT_EQ(decoded_counts, counts);
+    // a truncated request is rejected
+    ASSERT_EQ(codec.DecodeKeys(data.data(), 3, keys.size(), &decoded_keys[0]),
+              0UL);
+  }
+}
+
+TEST(SparseWireCodec, Values) {
+  const size_t dim = 11;
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> distrib(-1, 1);
+  std::vector<float> value(dim);
+  for (auto &x : value) {
+    x = distrib(rng);
+  }
+  value[0] = 123456;  // the raw dims keep large counts
+  for (auto value_codec : {SparseValueCodec::VALUE_RAW,
+                           SparseValueCodec::VALUE_FP16,
+                           SparseValueCodec::VALUE_INT8}) {
+    SparseWireCodecParameter param;
+    param.set_push_value_codec(value_codec);
+    param.set_push_raw_dim(3);
+    SparseWireCodec codec = SparseWireCodec::ForPush(param);
+    std::string data(codec.ValueSize(dim), '\0');
+    codec.EncodeValue(value.data(), dim, &data[0]);
+    std::vector<float> decoded(dim);
+    codec.DecodeValue(data.data(), dim, decoded.data());
+    float tolerance = value_codec == SparseValueCodec::VALUE_RAW    ? 0
+                      : value_codec == SparseValueCodec::VALUE_FP16 ? 1e-3
+                                                                    : 1e-2;
+    for (size_t i = 0; i < dim; ++i) {
+      if (i < 3) {
+        ASSERT_EQ(decoded[i], value[i]);
+      } else {
+        ASSERT_NEAR(decoded[i], value[i], tolerance) << "i is " << i;
+      }
+    }
+  }
+}
+
+}  // namespace paddle::distributed
@@ -134,6 +134,17 @@ type_promote_inplace_white_list = {
     "remainder_": ["x", "y"],
 }
 
+# The saved tensors stored compressed by TensorWrapper when
+# FLAGS_eager_compress_saved_tensor enables the mode, by forward op and saved
+# tensor. kBitMask only keeps whether each value is positive, so it is for the
+# grads reading nothing else, kInt8 is lossy.
+saved_tensor_compress_map = {
+    "relu": {"out": "kBitMask"},
+    "dropout": {"mask": "kBitMask"},
+    "gelu": {"x": "kInt8"},
+    "silu": {"x": "kInt8", "out": "kInt8"},
+}
+
 # ops support casting int tensor into float32 to do forward calculation
 type_autocast_op_list = {
     "acos": ["x"],
@@ -2413,9 +2424,21 @@ class DygraphNodeGenerator(DygraphFunctionGeneratorBase):
             no_need_buffer = "true" if tname in no_need_buffers else "false"
             tensor_wrapper_name = GetSavedName(tname)
             if IsPlainTensorType(ttype):
+                compress = saved_tensor_compress_map.get(
+                    forward_op_name, {}
+                ).get(tname)
+                tensor_wrapper_args = no_need_buffer
+                if compress is not None:
+                    tensor_wrapper_args += (
+                        f", egr::SavedTensorCompress::{compress}"
+                    )
                 set_tensor_wrapper_methods_str += (
                     SET_PLAIN_TENSOR_WRAPPER_TEMPLATE.format(
-                        tname, tname, tensor_wrapper_name, tname, no_need_buffer
+                        tname,
+                        tname,
+                        tensor_wrapper_name,
+                        tname,
+                        tensor_wrapper_args,
                     )
                 )
 
@@ -14,11 +14,17 @@
 
 #include "paddle/fluid/eager/backward.h"
 
+#include <condition_variable>
+#include <mutex>
+
 #include "paddle/fluid/eager/general_grad.h"
+#include "paddle/fluid/eager/saved_tensor_offload.h"
+#include "paddle/fluid/framework/new_executor/workqueue/workqueue.h"
 #include "paddle/phi/core/memory/stats.h"
 #include "paddle/phi/kernels/autotune/switch_autotune.h"
 
 COMMON_DECLARE_int32(call_stack_level);
+COMMON_DECLARE_int32(eager_backward_thread_num);
 namespace egr {
 
 std::unordered_map<GradNodeBase*, int> getInDegreeMap(
@@ -101,6 +107,236 @@ void DuplicateCheck(const std::vector<paddle::Tensor>& inputs, bool is_input) {
   }
 }
 
+paddle::framework::WorkQueue* BackwardWorkQueue() {
+  static std::unique_ptr<paddle::framework::WorkQueue> work_queue =
+      paddle::framework::CreateMultiThreadedWorkQueue(
+          paddle::framework::WorkQueueOptions(
+              "EagerBackward",
+              FLAGS_eager_backward_thread_num,
+              /*allow_spinning=*/true,
+              /*track_task=*/false));
+  return work_queue.get();
+}
+
+// Runs the GradNodes of one backward on the BackwardWorkQueue, each one as
+// soon as its in-degree drops to 0 like the sequential loop of RunBackward,
+// so that the independent branches of the grad graph run at the same time.
+// GradNodeAccumulation nodes still run one by one on the calling thread, as
+// the hooks of the leaf tensors behind them, e.g. the reducer, are not
+// thread-safe.
+class ParallelBackwardRunner {
+ public:
+  ParallelBackwardRunner(
+      std::unordered_map<GradNodeBase*, int>* node_in_degree_map,
+      std::unordered_map<GradNodeBase*, std::unique_ptr<GradTensorHolder>>*
+          node_input_buffers_dict,
+      bool retain_graph,
+      const phi::Place& place)
+      : node_in_degree_map_(node_in_degree_map),
+        node_input_buffers_dict_(node_input_buffers_dict),
+        retain_graph_(retain_graph),
+        place_(place),
+        tracer_(egr::Controller::Instance().GetCurrentTracer()),
+        has_grad_(egr::Controller::Instance().HasGrad()) {}
+
+  void Run(const std::deque<GradNodeBase*>& start_nodes) {
+    for (GradNodeBase* node : start_nodes) {
+      Schedule(node);
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      cv_.wait(lock, [this] {
+        return pending_ == 0 || !accumulation_nodes_.empty();
+      });
+      if (accumulation_nodes_.empty()) {
+        break;
+      }
+      GradNodeBase* node = accumulation_nodes_.front();
+      accumulation_nodes_.pop_front();
+      if (error_) {
+        --pending_;
+        continue;
+      }
+      lock.unlock();
+      Execute(node);
+      lock.lock();
+    }
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+  }
+
+ private:
+  void Schedule(GradNodeBase* node) {
+    bool is_accumulation =
+        dynamic_cast<egr::GradNodeAccumulation*>(node) != nullptr;
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      // the pending nodes finish, but nothing new starts after an error
+      if (error_) {
+        return;
+      }
+      ++pending_;
+      if (is_accumulation) {
+        accumulation_nodes_.push_back(node);
+        cv_.notify_one();
+        return;
+      }
+    }
+    BackwardWorkQueue()->AddTask([this, node] {
+      // the tracer is thread local, and the kernels of the node look it up
+      egr::Controller::Instance().SetCurrentTracer(tracer_);
+      egr::Controller::Instance().SetHasGrad(has_grad_);
+      Execute(node);
+    });
+  }
+
+  void Execute(GradNodeBase* node) {
+    VLOG(3) << "Preparing GradNode:" << node->name() << " addr:" << node;
+    try {
+      RunNode(node);
+    } catch (::common::enforce::EnforceNotMet& ex) {
+      if (FLAGS_call_stack_level == 3) {
+        paddle::framework::InsertCallStackInfoDygraph(
+            node->name(), {node->GetForwardTrace()}, &ex);
+      }
+      LOG(WARNING) << "While running Node (" << node->name()
+                   << ") raises an EnforceNotMet exception";
+      SetError(std::make_exception_ptr(ex));
+    } catch (...) {
+      LOG(WARNING) << "While running Node (" << node->name()
+                   << ") raises an exception";
+      SetError(std::current_exception());
+    }
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (--pending_ == 0) {
+      cv_.notify_one();
+    }
+  }
+
+  void SetError(std::exception_ptr error) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (!error_) {
+      error_ = error;
+    }
+  }
+
+  void RunNode(GradNodeBase* node) {
+    std::unique_ptr<GradTensorHolder> node_input_buffer;
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      auto node_input_buffer_iter = node_input_buffers_dict_->find(node);
+      PADDLE_ENFORCE_NE(
+          node_input_buffer_iter,
+          node_input_buffers_dict_->end(),
+          common::errors::Fatal(
+              "Unable to find next node in the GradTensorHolder \n"
+              "Trying to run Node without configuring its GradTensorHolder."));
+      node_input_buffer = std::move(node_input_buffer_iter->second);
+      node_input_buffers_dict_->erase(node_input_buffer_iter);
+    }
+
+    EnforceGradNodeHasInput(node);
+
+    phi::RecordEvent grad_node_record_event(
+        "Global_" + std::string((*node).name()),
+        phi::TracerEventType::Operator,
+        1);
+
+    paddle::small_vector<std::vector<paddle::Tensor>, kSlotSmallVectorSize>
+        grad_output_tensors = (*node)(node_input_buffer->Buffers(),
+                                      /*create_graph=*/false,
+                                      /*is_new_grad=*/false);
+
+    if (!retain_graph_) {
+      node->ClearTensorWrappers();
+    }
+
+    const paddle::small_vector<std::vector<GradSlotMeta>,
+                               kSlotSmallVectorSize>& metas =
+        node->OutputMeta();
+    PADDLE_ENFORCE(
+        metas.size() == grad_output_tensors.size() || metas.empty(),
+        common::errors::Fatal(
+            "Number of edges should be either empty ( for leaf node "
+            ") or the same as number of output grad tensors, but we "
+            "got edges size is: %d, grad_output size is: %d",
+            metas.size(),
+            grad_output_tensors.size()));
+
+    for (size_t i = 0; i < metas.size(); i++) {
+      for (size_t j = 0; j < metas[i].size(); j++) {
+        const Edge& edge = metas[i][j].GetEdge();
+        if (!edge.IsInitialized()) {
+          continue;
+        }
+        auto edge_rank = edge.GetEdgeRankInfo();
+        auto next_node_shared = edge.GetMutableGradNode();
+        if (!next_node_shared || !next_node_shared.get() ||
+            grad_output_tensors[i].empty()) {
+          continue;
+        }
+        PADDLE_ENFORCE_LT(
+            j,
+            grad_output_tensors[i].size(),
+            common::errors::Fatal(
+                "Rank of grad_output_tensors should be less than "
+                "grad_output_tensors[i].size(), which is: %d. This error may "
+                "indicate autoprune or autograd api error. ",
+                grad_output_tensors.size()));
+        auto* next_node = next_node_shared.get();
+
+        GradTensorHolder* next_input_buffer = nullptr;
+        {
+          std::lock_guard<std::mutex> guard(mutex_);
+          auto& holder = (*node_input_buffers_dict_)[next_node];
+          if (!holder) {
+            holder = std::make_unique<GradTensorHolder>(next_node->InputMeta());
+          }
+          next_input_buffer = holder.get();
+        }
+        // the producers of the same node add to it at the same time
+        next_input_buffer->add(edge_rank.first,
+                               edge_rank.second,
+                               grad_output_tensors[i][j],
+                               /*create_graph=*/false);
+
+        bool ready = false;
+        {
+          std::lock_guard<std::mutex> guard(mutex_);
+          int& in_degree = (*node_in_degree_map_)[next_node];
+          in_degree--;
+          PADDLE_ENFORCE(
+              in_degree >= 0,
+              common::errors::Fatal(
+                  "Detected in-degree value smaller than zero. For Node: %s"
+                  "Node's in-degree cannot be negative.",
+                  next_node->name()));
+          ready = in_degree == 0;
+        }
+        if (ready) {
+          Schedule(next_node);
+        }
+      }
+    }
+    paddle::memory::LogDeviceMemoryStats(place_, std::string((*node).name()));
+  }
+
+  std::unordered_map<GradNodeBase*, int>* node_in_degree_map_;
+  std::unordered_map<GradNodeBase*, std::unique_ptr<GradTensorHolder>>*
+      node_input_buffers_dict_;
+  bool retain_graph_;
+  phi::Place place_;
+  std::shared_ptr<paddle::imperative::Tracer> tracer_;
+  bool has_grad_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  int64_t pending_ = 0;
+  std::deque<GradNodeBase*> accumulation_nodes_;
+  std::exception_ptr error_;
+};
+
 GeneralGrad* GeneralGrad::general_grad_ = new GeneralGrad();
 
 std::vector<paddle::Tensor> RunBackward(
@@ -245,6 +481,27 @@ std::vector<paddle::Tensor> RunBackward(
 
   VLOG(5) << "Startup_ops's size is " << queue.size();
 
+  // The first GradNodes use the tensors saved last
+  if (SavedTensorOffload::IsEnable()) {
+    SavedTensorOffload::Instance().PrefetchLatest();
+  }
+
+  // The parallel backward starts from the nodes nothing else points to, and
+  // leaves the general grad, create_graph and forced orders to the loop below
+  bool run_parallel = FLAGS_eager_backward_thread_num > 1 && !is_general_grad &&
+                      !create_graph && force_sequential_nodes_queue.empty();
+  for (GradNodeBase* node : queue) {
+    run_parallel = run_parallel && node_in_degree_map[node] == 0;
+  }
+  if (run_parallel) {
+    VLOG(3) << "Run backward on " << FLAGS_eager_backward_thread_num
+            << " threads";
+    ParallelBackwardRunner(
+        &node_in_degree_map, &node_input_buffers_dict, retain_graph, place)
+        .Run(queue);
+    queue.clear();
+  }
+
   /* --- Topological Visit --- */
   // 1. Pop queue
   // 2. Run node
@@ -33,6 +33,23 @@ inline bool NeedTransLayout(
   return false;
 }
 
+// The key of the layout region a heavily op opens, from the name of its
+// parameter. The temporary tensors get new names in every iteration, so the
+// ops without a parameter are not planned.
+inline std::string LayoutRegionKey(
+    const std::string& op_name,
+    const paddle::small_vector<std::vector<paddle::Tensor>,
+                               kSlotSmallVectorSize>& tensors_vector) {
+  if (tensors_vector.size() < 2 || tensors_vector[1].empty()) {
+    return "";
+  }
+  const auto& name = tensors_vector[1][0].name();
+  if (name.empty() || name.rfind("eager_tmp", 0) == 0) {
+    return "";
+  }
+  return op_name + "/" + name;
+}
+
 inline std::shared_ptr<EagerLayoutTransformer> EagerLayoutAutotune(
     const std::string& op_name,
     const paddle::small_vector<std::vector<paddle::Tensor>,
@@ -144,8 +161,17 @@ inline std::shared_ptr<EagerLayoutTransformer> EagerLayoutAutotune(
     }
   }
 
-  if (paddle::imperative::LayoutAutoTune::Instance().IsHeavilyLayoutSensitive(
-          op_name)) {
+  auto& layout_autotune = paddle::imperative::LayoutAutoTune::Instance();
+  if (layout_autotune.IsHeavilyLayoutSensitive(op_name)) {
+    // an input out of the desired layout opens a region in it, which the
+    // plan may keep in the default layout instead
+    if (tensors_vector[0][0].layout() != DesiredLayout() &&
+        !layout_autotune.PlanRegion(LayoutRegionKey(op_name, tensors_vector))) {
+      VLOG(4) << "LayoutAutoTune plans " << op_name << " in "
+              << tensors_vector[0][0].layout();
+      return transposer;
+    }
+    layout_autotune.RecordTunedOp(tensors_vector[0][0].numel());
     return std::make_shared<EagerHeavilyLayoutSensitiveOpTransformer>(op_name,
                                                                       attr);
   }
@@ -26,6 +26,7 @@ inline paddle::Tensor EagerTraceTransposeOp(const phi::DataLayout layout,
   if (in.shape().size() != 4) {
     return in;
   }
+  paddle::imperative::LayoutAutoTune::Instance().RecordTranspose(in.numel());
   std::vector<int> axis;
   if (layout == phi::DataLayout::NHWC) {
     axis = {0, 2, 3, 1};
@@ -112,6 +112,7 @@ void GradTensorHolder::add(size_t slot_id,
                            size_t rank,
                            const paddle::Tensor& t,
                            bool create_graph) {
+  std::lock_guard<std::mutex> guard(add_mutex_);
   if (!t.has_allocation()) {
     if (t.defined() && t.is_dist_tensor() &&
         phi::distributed::NeedComputationClipForPP(t.impl())) {
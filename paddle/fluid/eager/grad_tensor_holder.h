@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "paddle/fluid/eager/grad_node_info.h"
 
 namespace egr {
@@ -37,15 +39,19 @@ class GradTensorHolder {
     }
   }
 
-  GradTensorHolder(const GradTensorHolder& other) = default;
+  GradTensorHolder(const GradTensorHolder& other) : buffer_(other.buffer_) {}
 
   explicit GradTensorHolder(paddle::small_vector<std::vector<paddle::Tensor>,
                                                  kSlotSmallVectorSize>&& inputs)
       : buffer_(std::move(inputs)) {}
 
-  GradTensorHolder& operator=(const GradTensorHolder& other) = default;
+  GradTensorHolder& operator=(const GradTensorHolder& other) {
+    buffer_ = other.buffer_;
+    return *this;
+  }
 
-  // Create new tensor and copy tensor->impl
+  // Create new tensor and copy tensor->impl. It is thread-safe, since the
+  // parallel backward may add the grads of several pending nodes at once.
   void add(size_t slot_id,
            size_t rank,
            const paddle::Tensor& t,
@@ -69,6 +75,7 @@ class GradTensorHolder {
  private:
   paddle::small_vector<std::vector<paddle::Tensor>, kSlotSmallVectorSize>
       buffer_;
+  std::mutex add_mutex_;
 };
 
 }  // namespace egr
@@ -0,0 +1,158 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/eager/saved_tensor_compress.h"
+
+#include <string>
+#include <type_traits>
+
+#include "glog/logging.h"
+#include "paddle/common/flags.h"
+#include "paddle/phi/backends/context_pool.h"
+#include "paddle/phi/kernels/funcs/activation_compress_functor.h"
+
+COMMON_DECLARE_string(eager_compress_saved_tensor);
+
+namespace egr {
+
+namespace {
+
+// Runs Func<Context, T> by the place and dtype, false if they are not
+// supported by the mode.
+template <template <typename, typename> class Func, typename... Args>
+bool VisitPlaceAndType(SavedTensorCompress mode,
+                       const phi::Place& place,
+                       phi::DataType dtype,
+                       Args&&... args) {
+  auto visit = [&](const auto& ctx) {
+    using Context = std::decay_t<decltype(ctx)>;
+    bool is_float = dtype == phi::DataType::FLOAT32 ||
+                    dtype == phi::DataType::FLOAT16 ||
+                    dtype == phi::DataType::BFLOAT16;
+    // the int8 values only make sense for floats
+    if (!is_float && mode != SavedTensorCompress::kBitMask) {
+      return false;
+    }
+    switch (dtype) {
+      case phi::DataType::FLOAT32:
+        Func<Context, float>()(ctx, std::forward<Args>(args)...);
+        return true;
+      case phi::DataType::FLOAT16:
+        Func<Context, phi::dtype::float16>()(ctx, std::forward<Args>(args)...);
+        return true;
+      case phi::DataType::BFLOAT16:
+        Func<Context, phi::dtype::bfloat16>()(ctx,
+                                              std::forward<Args>(args)...);
+        return true;
+      case phi::DataType::FLOAT64:
+        Func<Context, double>()(ctx, std::forward<Args>(args)...);
+        return true;
+      case phi::DataType::UINT8:
+        Func<Context, uint8_t>()(ctx, std::forward<Args>(args)...);
+        return true;
+      case phi::DataType::BOOL:
+        Func<Context, bool>()(ctx, std::forward<Args>(args)...);
+        return true;
+      default:
+        return false;
+    }
+  };
+  auto& pool = phi::DeviceContextPool::Instance();
+  if (phi::is_cpu_place(place)) {
+    return visit(*static_cast<phi::CPUContext*>(pool.Get(place)));
+  }
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (phi::is_gpu_place(place)) {
+    return visit(*static_cast<phi::GPUContext*>(pool.Get(place)));
+  }
+#endif
+  return false;
+}
+
+template <typename Context, typename T>
+struct CompressFunc {
+  void operator()(const Context& ctx,
+                  const phi::DenseTensor& tensor,
+                  CompressedTensor* compressed) {
+    if (compressed->mode == SavedTensorCompress::kBitMask) {
+      phi::funcs::PackBitMaskFunctor<Context, T>()(
+          ctx, tensor, &compressed->data);
+    } else {
+      phi::funcs::BlockQuantInt8Functor<Context, T>()(
+          ctx, tensor, &compressed->data, &compressed->scale);
+    }
+  }
+};
+
+template <typename Context, typename T>
+struct DecompressFunc {
+  void operator()(const Context& ctx,
+                  const CompressedTensor& compressed,
+                  phi::DenseTensor* tensor) {
+    if (compressed.mode == SavedTensorCompress::kBitMask) {
+      phi::funcs::UnpackBitMaskFunctor<Context, T>()(
+          ctx, compressed.data, tensor);
+    } else {
+      phi::funcs::BlockDequantInt8Functor<Context, T>()(
+          ctx, compressed.data, compressed.scale, tensor);
+    }
+  }
+};
+
+}  // namespace
+
+bool IsSavedTensorCompressEnable(SavedTensorCompress mode) {
+  const std::string& flag = FLAGS_eager_compress_saved_tensor;
+  switch (mode) {
+    case SavedTensorCompress::kBitMask:
+      return flag == "mask" || flag == "all";
+    case SavedTensorCompress::kInt8:
+      return flag == "all";
+    default:
+      return false;
+  }
+}
+
+std::shared_ptr<CompressedTensor> CompressSavedTensor(
+    const phi::DenseTensor& tensor, SavedTensorCompress mode) {
+  if (mode == SavedTensorCompress::kNone || !tensor.has_allocation() ||
+      !tensor.meta().is_contiguous() || tensor.numel() == 0) {
+    return nullptr;
+  }
+  auto compressed = std::make_shared<CompressedTensor>();
+  compressed->mode = mode;
+  if (!VisitPlaceAndType<CompressFunc>(
+          mode, tensor.place(), tensor.dtype(), tensor, compressed.get())) {
+    return nullptr;
+  }
+  VLOG(6) << "Compress saved tensor of " << tensor.numel() << " values to "
+          << compressed->data.numel() << " bytes";
+  return compressed;
+}
+
+std::shared_ptr<phi::DenseTensor> DecompressSavedTensor(
+    const CompressedTensor& compressed, const phi::DenseTensorMeta& meta) {
+  phi::DenseTensorMeta out_meta = meta;
+  out_meta.offset = 0;
+  auto tensor = std::make_shared<phi::DenseTensor>();
+  tensor->set_meta(out_meta);
+  VisitPlaceAndType<DecompressFunc>(compressed.mode,
+                                    compressed.data.place(),
+                                    meta.dtype,
+                                    compressed,
+                                    tensor.get());
+  return tensor;
+}
+
+}  // namespace egr
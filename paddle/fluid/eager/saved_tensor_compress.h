@@ -0,0 +1,52 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+
+#include "paddle/phi/core/dense_tensor.h"
+
+namespace egr {
+
+/**
+ * The compressed forms of a tensor saved by TensorWrapper. The generated
+ * GradNodes pick one per op type and saved tensor, and
+ * FLAGS_eager_compress_saved_tensor enables them:
+ *
+ * kBitMask: one bit per value for whether it is positive, and 1 or 0 back.
+ *           It is exact for the grads reading only that, e.g. relu of its
+ *           out and dropout of its mask. It is enabled by "mask" and "all".
+ * kInt8:    int8 values with a float scale per 256 values. It is lossy and
+ *           is enabled by "all".
+ **/
+enum class SavedTensorCompress { kNone = 0, kBitMask, kInt8 };
+
+struct CompressedTensor {
+  SavedTensorCompress mode = SavedTensorCompress::kNone;
+  phi::DenseTensor data;
+  phi::DenseTensor scale;
+};
+
+bool IsSavedTensorCompressEnable(SavedTensorCompress mode);
+
+// nullptr if the tensor is not compressed, e.g. for its place or dtype.
+std::shared_ptr<CompressedTensor> CompressSavedTensor(
+    const phi::DenseTensor& tensor, SavedTensorCompress mode);
+
+// A new tensor of meta with the values of compressed.
+std::shared_ptr<phi::DenseTensor> DecompressSavedTensor(
+    const CompressedTensor& compressed, const phi::DenseTensorMeta& meta);
+
+}  // namespace egr
@@ -0,0 +1,231 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/eager/saved_tensor_offload.h"
+
+#include <unordered_map>
+
+#include "glog/logging.h"
+#include "paddle/common/flags.h"
+#include "paddle/phi/core/enforce.h"
+#include "paddle/phi/core/memory/malloc.h"
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+#include "paddle/phi/backends/context_pool.h"
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/backends/gpu/gpu_info.h"
+#include "paddle/phi/core/platform/cuda_device_guard.h"
+#include "paddle/phi/core/platform/device/gpu/gpu_resource_pool.h"
+#endif
+
+COMMON_DECLARE_int64(eager_offload_saved_tensor_min_bytes);
+COMMON_DECLARE_int32(eager_offload_prefetch_num);
+
+namespace egr {
+
+struct OffloadedTensor {
+  ~OffloadedTensor() { SavedTensorOffload::Instance().Erase(this); }
+
+  uint64_t id = 0;
+  phi::Place place;
+  size_t size = 0;
+  // pinned memory from the pinned allocator of the AllocatorFacade
+  std::shared_ptr<phi::Allocation> host_holder;
+  // set once the copy back starts
+  std::shared_ptr<phi::Allocation> device_holder;
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  // recorded after the last copy on the side stream
+  std::shared_ptr<paddle::platform::CudaEventObject> copy_event;
+#endif
+};
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+namespace {
+
+void RecordEvent(gpuEvent_t event, gpuStream_t stream) {
+#ifdef PADDLE_WITH_HIP
+  PADDLE_ENFORCE_GPU_SUCCESS(hipEventRecord(event, stream));
+#else
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaEventRecord(event, stream));
+#endif
+}
+
+void StreamWaitEvent(gpuStream_t stream, gpuEvent_t event) {
+#ifdef PADDLE_WITH_HIP
+  PADDLE_ENFORCE_GPU_SUCCESS(hipStreamWaitEvent(stream, event, 0));
+#else
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamWaitEvent(stream, event, 0));
+#endif
+}
+
+void SynchronizeEvent(gpuEvent_t event) {
+#ifdef PADDLE_WITH_HIP
+  PADDLE_ENFORCE_GPU_SUCCESS(hipEventSynchronize(event));
+#else
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaEventSynchronize(event));
+#endif
+}
+
+gpuStream_t ComputeStream(const phi::Place& place) {
+  return static_cast<phi::GPUContext*>(
+             phi::DeviceContextPool::Instance().Get(place))
+      ->stream();
+}
+
+// one side stream per device, only used with the mutex of
+// SavedTensorOffload held
+gpuStream_t SideStream(int device) {
+  static std::unordered_map<
+      int,
+      std::shared_ptr<paddle::platform::CudaStreamObject>>
+      streams;
+  auto& stream = streams[device];
+  if (!stream) {
+    stream = paddle::platform::CudaStreamResourcePool::Instance().New(device);
+  }
+  return stream.get();
+}
+
+// the later work on the side stream waits for the work already on the
+// compute stream
+void SideStreamWaitCompute(int device, gpuStream_t compute, gpuStream_t side) {
+  auto event = paddle::platform::CudaEventResourcePool::Instance().New(device);
+  RecordEvent(event.get(), compute);
+  StreamWaitEvent(side, event.get());
+}
+
+}  // namespace
+#endif
+
+SavedTensorOffload& SavedTensorOffload::Instance() {
+  // never destroyed, since the GradNodes may outlive the static objects
+  static SavedTensorOffload* instance = new SavedTensorOffload();
+  return *instance;
+}
+
+bool SavedTensorOffload::IsEnable() {
+  return FLAGS_eager_offload_saved_tensor_min_bytes > 0;
+}
+
+std::shared_ptr<OffloadedTensor> SavedTensorOffload::Offload(
+    const phi::DenseTensor& tensor) {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (!IsEnable() || !tensor.has_allocation() ||
+      !phi::is_gpu_place(tensor.place()) || !tensor.meta().is_contiguous()) {
+    return nullptr;
+  }
+  size_t size = tensor.numel() * phi::SizeOf(tensor.dtype());
+  if (size < static_cast<size_t>(FLAGS_eager_offload_saved_tensor_min_bytes)) {
+    return nullptr;
+  }
+  const phi::Place& place = tensor.place();
+  paddle::platform::CUDADeviceGuard guard(place.device);
+  std::lock_guard<std::mutex> lock(mutex_);
+  gpuStream_t side_stream = SideStream(place.device);
+  // the device memory is freed only after the D2H copy, which needs the
+  // stream safe allocator
+  if (!paddle::memory::RecordStream(tensor.Holder(), side_stream)) {
+    return nullptr;
+  }
+  SideStreamWaitCompute(place.device, ComputeStream(place), side_stream);
+
+  auto offloaded = std::make_shared<OffloadedTensor>();
+  offloaded->id = next_id_++;
+  offloaded->place = place;
+  offloaded->size = size;
+  offloaded->host_holder =
+      paddle::memory::AllocShared(phi::GPUPinnedPlace(), size);
+  phi::backends::gpu::GpuMemcpyAsync(offloaded->host_holder->ptr(),
+                                     tensor.data(),
+                                     size,
+                                     phi::gpuMemcpyDeviceToHost,
+                                     side_stream);
+  offloaded->copy_event =
+      paddle::platform::CudaEventResourcePool::Instance().New(place.device);
+  RecordEvent(offloaded->copy_event.get(), side_stream);
+  host_tensors_[offloaded->id] = offloaded.get();
+  VLOG(6) << "Offload saved tensor " << offloaded->id << " of " << size
+          << " bytes";
+  return offloaded;
+#else
+  return nullptr;
+#endif
+}
+
+void SavedTensorOffload::CopyBack(OffloadedTensor* tensor) {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  const phi::Place& place = tensor->place;
+  paddle::platform::CUDADeviceGuard guard(place.device);
+  gpuStream_t side_stream = SideStream(place.device);
+  // the new allocation belongs to the compute stream, which may still use
+  // its previous owner
+  tensor->device_holder = paddle::memory::AllocShared(place, tensor->size);
+  SideStreamWaitCompute(place.device, ComputeStream(place), side_stream);
+  phi::backends::gpu::GpuMemcpyAsync(tensor->device_holder->ptr(),
+                                     tensor->host_holder->ptr(),
+                                     tensor->size,
+                                     phi::gpuMemcpyHostToDevice,
+                                     side_stream);
+  paddle::memory::RecordStream(tensor->device_holder, side_stream);
+  RecordEvent(tensor->copy_event.get(), side_stream);
+  host_tensors_.erase(tensor->id);
+  VLOG(6) << "Copy back saved tensor " << tensor->id;
+#endif
+}
+
+std::shared_ptr<phi::Allocation> SavedTensorOffload::Load(
+    OffloadedTensor* tensor) {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!tensor->device_holder) {
+    CopyBack(tensor);
+  }
+  // the tensors saved just before this one are used next
+  auto iter = host_tensors_.lower_bound(tensor->id);
+  for (int i = 0;
+       i < FLAGS_eager_offload_prefetch_num && iter != host_tensors_.begin();
+       i++) {
+    CopyBack((--iter)->second);
+    iter = host_tensors_.lower_bound(tensor->id);
+  }
+  paddle::platform::CUDADeviceGuard guard(tensor->place.device);
+  StreamWaitEvent(ComputeStream(tensor->place), tensor->copy_event.get());
+  return tensor->device_holder;
+#else
+  PADDLE_THROW(common::errors::Unavailable(
+      "The saved tensors are offloaded only with the GPU."));
+#endif
+}
+
+void SavedTensorOffload::PrefetchLatest() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (int i = 0;
+       i < FLAGS_eager_offload_prefetch_num && !host_tensors_.empty();
+       i++) {
+    CopyBack(host_tensors_.rbegin()->second);
+  }
+}
+
+void SavedTensorOffload::Erase(OffloadedTensor* tensor) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  host_tensors_.erase(tensor->id);
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  // the pinned memory goes back to the pool, after the copies using it
+  if (tensor->copy_event) {
+    paddle::platform::CUDADeviceGuard guard(tensor->place.device);
+    SynchronizeEvent(tensor->copy_event.get());
+  }
+#endif
+}
+
+}  // namespace egr
@@ -0,0 +1,72 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "paddle/phi/core/dense_tensor.h"
+
+namespace egr {
+
+struct OffloadedTensor;
+
+/**
+ * SavedTensorOffload moves the large tensors saved by TensorWrapper to
+ * pinned host memory, so that the activations of the forward do not stay on
+ * the device until their GradNodes run.
+ *
+ * The copies run on a side stream of each device: the D2H copy right after
+ * the tensor is saved, and the H2D copy ahead of use. The backward uses the
+ * saved tensors roughly in the reverse order they were saved, so each load
+ * also prefetches the FLAGS_eager_offload_prefetch_num tensors saved just
+ * before it, and RunBackward prefetches the latest ones when it starts.
+ *
+ * It is enabled by FLAGS_eager_offload_saved_tensor_min_bytes > 0, for the
+ * contiguous dense tensors on GPU of at least that many bytes.
+ **/
+class SavedTensorOffload {
+ public:
+  static SavedTensorOffload& Instance();
+
+  static bool IsEnable();
+
+  // Starts to copy the tensor to the host, nullptr if it is not offloaded.
+  std::shared_ptr<OffloadedTensor> Offload(const phi::DenseTensor& tensor);
+
+  // The device allocation of the tensor, ready for the kernels on the stream
+  // of its place.
+  std::shared_ptr<phi::Allocation> Load(OffloadedTensor* tensor);
+
+  void PrefetchLatest();
+
+  // Called when the offloaded tensor is destroyed.
+  void Erase(OffloadedTensor* tensor);
+
+ private:
+  SavedTensorOffload() = default;
+
+  // Starts the H2D copy of the tensor, with mutex_ held.
+  void CopyBack(OffloadedTensor* tensor);
+
+  std::mutex mutex_;
+  uint64_t next_id_ = 0;
+  // the tensors still on the host by the order they were saved
+  std::map<uint64_t, OffloadedTensor*> host_tensors_;
+};
+
+}  // namespace egr
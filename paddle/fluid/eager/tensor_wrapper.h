@@ -27,6 +27,8 @@
 #pragma once
 #include "paddle/fluid/eager/autograd_meta.h"
 #include "paddle/fluid/eager/grad_node_info.h"
+#include "paddle/fluid/eager/saved_tensor_compress.h"
+#include "paddle/fluid/eager/saved_tensor_offload.h"
 #include "paddle/fluid/eager/utils.h"
 #include "paddle/phi/api/lib/utils/allocator.h"
 #ifndef PADDLE_NO_PYTHON
@@ -39,8 +41,10 @@ namespace egr {
 class TensorWrapper {
  public:
   TensorWrapper() = default;
-  explicit TensorWrapper(const paddle::Tensor& tensor,
-                         bool no_need_buffer = false) {
+  explicit TensorWrapper(
+      const paddle::Tensor& tensor,
+      bool no_need_buffer = false,
+      SavedTensorCompress compress = SavedTensorCompress::kNone) {
     // set inplace_version_snapshot_ according to tensor's current inplace
     // version.
     if (tensor.has_allocation() && tensor.is_dense_tensor()) {
@@ -122,7 +126,35 @@ class TensorWrapper {
         packed_value_ = (*pack_hook)(tensor);
       } else {
 #endif
-        intermediate_tensor_.set_impl(tensor.impl());
+        if (compress != SavedTensorCompress::kNone &&
+            IsSavedTensorCompressEnable(compress) &&
+            tensor.is_dense_tensor()) {
+          phi::DenseTensor* dense_tensor =
+              static_cast<phi::DenseTensor*>(tensor.impl().get());
+          compressed_tensor_ = CompressSavedTensor(*dense_tensor, compress);
+          if (compressed_tensor_) {
+            intermediate_tensor_.set_impl(std::make_shared<phi::DenseTensor>(
+                std::make_shared<phi::Allocation>(nullptr, 0, tensor.place()),
+                dense_tensor->meta()));
+          }
+        }
+        if (!compressed_tensor_ && SavedTensorOffload::IsEnable() &&
+            tensor.is_dense_tensor()) {
+          phi::DenseTensor* dense_tensor =
+              static_cast<phi::DenseTensor*>(tensor.impl().get());
+          offloaded_tensor_ =
+              SavedTensorOffload::Instance().Offload(*dense_tensor);
+          if (offloaded_tensor_) {
+            phi::DenseTensorMeta meta = dense_tensor->meta();
+            meta.offset = 0;
+            intermediate_tensor_.set_impl(std::make_shared<phi::DenseTensor>(
+                std::make_shared<phi::Allocation>(nullptr, 0, tensor.place()),
+                meta));
+          }
+        }
+        if (!compressed_tensor_ && !offloaded_tensor_) {
+          intermediate_tensor_.set_impl(tensor.impl());
+        }
 #ifndef PADDLE_NO_PYTHON
       }
 #endif
@@ -185,12 +217,32 @@ class TensorWrapper {
       }
     } else {
 #endif
-      check_inplace_version();
+      if (compressed_tensor_) {
+        // the values are taken at the save like the offloaded ones, and are
+        // decompressed below
+        VLOG(7) << "Recover the compressed tensor";
+      } else if (offloaded_tensor_) {
+        // the copy on the host is taken right after the save, so it is not
+        // changed by the later inplace ops
+        static_cast<phi::DenseTensor*>(intermediate_tensor_.impl().get())
+            ->ResetHolder(SavedTensorOffload::Instance().Load(
+                offloaded_tensor_.get()));
+      } else {
+        check_inplace_version();
+      }
 #ifndef PADDLE_NO_PYTHON
     }
 #endif
 
     paddle::Tensor recovered_tensor = intermediate_tensor_;
+    if (compressed_tensor_) {
+      // a new tensor each time, so that the values are not kept on the
+      // device by a retained graph
+      recovered_tensor.set_impl(DecompressSavedTensor(
+          *compressed_tensor_,
+          static_cast<phi::DenseTensor*>(intermediate_tensor_.impl().get())
+              ->meta()));
+    }
 
     std::shared_ptr<GradNodeBase> new_grad_node = weak_grad_node_.lock();
     if (new_grad_node) {
@@ -216,7 +268,11 @@ class TensorWrapper {
 
   paddle::Tensor get_intermediate_tensor() { return intermediate_tensor_; }
 
-  void clear() { intermediate_tensor_.reset(); }
+  void clear() {
+    intermediate_tensor_.reset();
+    offloaded_tensor_.reset();
+    compressed_tensor_.reset();
+  }
 
  private:
   void check_inplace_version() {
@@ -270,6 +326,8 @@ class TensorWrapper {
   paddle::Tensor intermediate_tensor_;
   std::weak_ptr<egr::GradNodeBase> weak_grad_node_;
   uint32_t inplace_version_snapshot_ = 0;
+  std::shared_ptr<OffloadedTensor> offloaded_tensor_;
+  std::shared_ptr<CompressedTensor> compressed_tensor_;
 #ifndef PADDLE_NO_PYTHON
   std::shared_ptr<egr::PyObjectHolderBase> packed_value_;
   std::shared_ptr<egr::UnPackHookBase> unpack_hook_;
@@ -161,6 +161,27 @@ static void CheckOutputVarStatus(const paddle::framework::Variable &src_var,
   }
 }
 
+static void ShareTensorIntoVar(const Tensor &tensor,
+                               paddle::framework::Variable *var) {
+  CheckInputVarStatus(tensor);
+  // share tensor
+  auto tensor_base = tensor.impl();
+  if (phi::DenseTensor::classof(tensor_base.get())) {
+    auto *dst_tensor = var->GetMutable<phi::DenseTensor>();
+    auto t = std::dynamic_pointer_cast<phi::DenseTensor>(tensor_base);
+    *dst_tensor = *t;
+  } else if (phi::SelectedRows::classof(tensor_base.get())) {
+    auto *dst_tensor = var->GetMutable<phi::SelectedRows>();
+    auto t = std::dynamic_pointer_cast<phi::SelectedRows>(tensor_base);
+    *dst_tensor = *t;
+  } else if (paddle::framework::VariableRefArray::classof(tensor_base.get())) {
+    auto *dst_tensor = var->GetMutable<paddle::framework::VariableRefArray>();
+    auto t = std::dynamic_pointer_cast<paddle::framework::VariableRefArray>(
+        tensor_base);
+    *dst_tensor = *t;
+  }
+}
+
 static void ShareTensorsIntoScopeWithName(
     const std::vector<Tensor> &tensors,
     const std::vector<std::string> &tensor_names,
@@ -172,25 +193,7 @@ static void ShareTensorsIntoScopeWithName(
         name == paddle::framework::kEmptyVarName) {
       continue;
     }
-    auto *var = scope->Var(name);
-    CheckInputVarStatus(tensors[i]);
-    // share tensor
-    auto tensor_base = tensors[i].impl();
-    if (phi::DenseTensor::classof(tensor_base.get())) {
-      auto *dst_tensor = var->GetMutable<phi::DenseTensor>();
-      auto t = std::dynamic_pointer_cast<phi::DenseTensor>(tensor_base);
-      *dst_tensor = *t;
-    } else if (phi::SelectedRows::classof(tensor_base.get())) {
-      auto *dst_tensor = var->GetMutable<phi::SelectedRows>();
-      auto t = std::dynamic_pointer_cast<phi::SelectedRows>(tensor_base);
-      *dst_tensor = *t;
-    } else if (paddle::framework::VariableRefArray::classof(
-                   tensor_base.get())) {
-      auto *dst_tensor = var->GetMutable<paddle::framework::VariableRefArray>();
-      auto t = std::dynamic_pointer_cast<paddle::framework::VariableRefArray>(
-          tensor_base);
-      *dst_tensor = *t;
-    }
+    ShareTensorIntoVar(tensors[i], scope->Var(name));
   }
 }
 
@@ -216,6 +219,48 @@ static void ShareTensorsIntoScopeByValue(
   ShareTensorsIntoScopeWithName(tensors, names, scope);
 }
 
+static void ShareTensorFromVar(const paddle::framework::Variable &var,
+                               const std::string &name,
+                               Tensor *tensor) {
+  CheckOutputVarStatus(var, *tensor);
+  // share tensor
+  if (var.IsType<phi::DenseTensor>()) {
+    auto &src_tensor = var.Get<phi::DenseTensor>();
+    auto *dst_tensor = const_cast<phi::DenseTensor *>(
+        dynamic_cast<const phi::DenseTensor *>(tensor->impl().get()));
+    VLOG(2) << "actually do sharing " << name << " from scope";
+    *dst_tensor = src_tensor;
+  } else if (var.IsType<phi::SelectedRows>()) {
+    auto &src_tensor = var.Get<phi::SelectedRows>();
+    auto *dst_tensor = const_cast<phi::SelectedRows *>(
+        dynamic_cast<const phi::SelectedRows *>(tensor->impl().get()));
+    *dst_tensor = src_tensor;
+  } else if (var.IsType<paddle::framework::VariableRefArray>()) {
+    auto &src_tensor = var.Get<paddle::framework::VariableRefArray>();
+    auto *dst_tensor = const_cast<paddle::framework::VariableRefArray *>(
+        dynamic_cast<const paddle::framework::VariableRefArray *>(
+            tensor->impl().get()));
+    *dst_tensor = src_tensor;
+  } else {
+    PADDLE_THROW(common::errors::InvalidArgument(
+        "The RunProgram(Grad)Op only support output "
+        "variable of type DenseTensor, SelectedRows or VariableRefArray",
+        name));
+  }
+}
+
+static paddle::framework::Variable *FindOutputVar(
+    const std::string &name, paddle::framework::Scope *scope) {
+  auto *var = scope->FindVar(name);
+  PADDLE_ENFORCE_NOT_NULL(
+      var,
+      common::errors::NotFound("The output tensor %s is not in "
+                               "RunProgram(Grad)Op'"
+                               "s internal scope.",
+                               name));
+  return var;
+}
+
 static void ShareTensorsFromScopeByValue(
     const std::vector<Tensor *> &tensors,
     const std::vector<::pir::Value> &values,
@@ -230,37 +275,61 @@ static void ShareTensorsFromScopeByValue(
       // skip stop_gradient.
       continue;
     }
-    auto *var = scope->FindVar(name);
-    PADDLE_ENFORCE_NOT_NULL(
-        var,
-        common::errors::NotFound("The output tensor %s is not in "
-                                 "RunProgram(Grad)Op'"
-                                 "s internal scope.",
-                                 name));
-    CheckOutputVarStatus(*var, *tensors[i]);
-    // share tensor
-    if (var->IsType<phi::DenseTensor>()) {
-      auto &src_tensor = var->Get<phi::DenseTensor>();
-      auto *dst_tensor = const_cast<phi::DenseTensor *>(
-          dynamic_cast<const phi::DenseTensor *>(tensors[i]->impl().get()));
-      VLOG(2) << "actually do sharing " << name << " from scope";
-      *dst_tensor = src_tensor;
-    } else if (var->IsType<phi::SelectedRows>()) {
-      auto &src_tensor = var->Get<phi::SelectedRows>();
-      auto *dst_tensor = const_cast<phi::SelectedRows *>(
-          dynamic_cast<const phi::SelectedRows *>(tensors[i]->impl().get()));
-      *dst_tensor = src_tensor;
-    } else if (var->IsType<paddle::framework::VariableRefArray>()) {
-      auto &src_tensor = var->Get<paddle::framework::VariableRefArray>();
-      auto *dst_tensor = const_cast<paddle::framework::VariableRefArray *>(
-          dynamic_cast<const paddle::framework::VariableRefArray *>(
-              tensors[i]->impl().get()));
-      *dst_tensor = src_tensor;
-    } else {
-      PADDLE_THROW(common::errors::InvalidArgument(
-          "The RunProgram(Grad)Op only support output "
-          "variable of type DenseTensor, SelectedRows or VariableRefArray",
-          name));
+    ShareTensorFromVar(*FindOutputVar(name, scope), name, tensors[i]);
+  }
+}
+
+// Returns the variables of the values in the scope, resolved once for the
+// attribute key of the cached interpretercore, so that the later runs skip
+// the name analysis and the lookups in the scope. The variables are created
+// for the inputs and looked up for the outputs, and they are null for the
+// values which are skipped by ShareTensorsIntoScopeByValue and
+// ShareTensorsFromScopeByValue.
+static const std::vector<paddle::framework::Variable *> &GetCachedVarsByValue(
+    paddle::framework::InterpreterCoreInfo::CacheValue *cached_value,
+    const std::string &key,
+    const std::vector<::pir::Value> &values,
+    paddle::framework::Scope *scope,
+    bool is_output) {
+  if (cached_value->value_vars_scope_ != scope) {
+    cached_value->value_vars_.clear();
+    cached_value->value_vars_scope_ = scope;
+  }
+  auto &vars = cached_value->value_vars_[key];
+  if (vars.size() == values.size()) {
+    return vars;
+  }
+  auto names = GetNameFromValue(values);
+  vars.assign(values.size(), nullptr);
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (is_output) {
+      if (values[i].impl() != nullptr) {
+        vars[i] = FindOutputVar(names[i], scope);
+      }
+    } else if (names[i] != paddle::framework::kFakeVarName &&
+               names[i] != paddle::framework::kEmptyVarName) {
+      vars[i] = scope->Var(names[i]);
+    }
+  }
+  return vars;
+}
+
+static void ShareTensorsIntoVars(
+    const std::vector<Tensor> &tensors,
+    const std::vector<paddle::framework::Variable *> &vars) {
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    if (vars[i] != nullptr) {
+      ShareTensorIntoVar(tensors[i], vars[i]);
+    }
+  }
+}
+
+static void ShareTensorsFromVars(
+    const std::vector<Tensor *> &tensors,
+    const std::vector<paddle::framework::Variable *> &vars) {
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    if (vars[i] != nullptr) {
+      ShareTensorFromVar(*vars[i], tensors[i]->name(), tensors[i]);
     }
   }
 }
@@ -498,9 +567,20 @@ inline void PirRunProgramAPI(
                                           /*in_pir_mode=*/true);
     interpreter_core = cached_value.core_;
     // Step 2. update scope for cache interpretercore
-    details::ShareTensorsIntoScopeByValue(x, input_values, global_inner_scope);
-    details::ShareTensorsIntoScopeByValue(
-        params, param_values, global_inner_scope);
+    details::ShareTensorsIntoVars(
+        x,
+        details::GetCachedVarsByValue(&cached_value,
+                                      "fx",
+                                      input_values,
+                                      global_inner_scope,
+                                      /*is_output=*/false));
+    details::ShareTensorsIntoVars(
+        params,
+        details::GetCachedVarsByValue(&cached_value,
+                                      "fp",
+                                      param_values,
+                                      global_inner_scope,
+                                      /*is_output=*/false));
     // TODO(xiongkun): new ir how to build scope.
     // if (interpreter_core->GetVariableScope()->GetMutableScope() !=
     // global_inner_scope) {
@@ -522,8 +602,18 @@ inline void PirRunProgramAPI(
     phi::RecordEvent record_event(
         "fetch_and_gc", phi::TracerEventType::UserDefined, 1);
     // Get Output, and Middle Outputs
-    details::ShareTensorsFromScopeByValue(
-        out, output_values, global_inner_scope);
+    auto &cached_value = cache.GetMutable(program_id,
+                                          global_inner_scope,
+                                          place_hash_key,
+                                          /*is_grad=*/false,
+                                          /*in_pir_mode=*/true);
+    details::ShareTensorsFromVars(
+        out,
+        details::GetCachedVarsByValue(&cached_value,
+                                      "fo",
+                                      output_values,
+                                      global_inner_scope,
+                                      /*is_output=*/true));
 
     VLOG(3) << paddle::framework::GenScopeTreeDebugInfo(out_scope_vec->front());
 
@@ -977,11 +1067,29 @@ inline void PirRunProgramGradAPI(
 
   details::Trans2ContiguousTensorsInplace(out_grad);
 
+  auto &cache = paddle::framework::InterpreterCoreInfoCache::Instance();
   // share x, param, middles, output_grads, out into scope.
-  details::ShareTensorsIntoScopeByValue(
-      out_grad, output_grad_values, global_inner_scope);
+  if (cache.Has(program_id,
+                global_inner_scope,
+                place_hash_key,
+                /*is_grad=*/true,
+                /*in_pir_mode=*/true)) {
+    details::ShareTensorsIntoVars(
+        out_grad,
+        details::GetCachedVarsByValue(&cache.GetMutable(program_id,
+                                                        global_inner_scope,
+                                                        place_hash_key,
+                                                        /*is_grad=*/true,
+                                                        /*in_pir_mode=*/true),
+                                      "bo_g",
+                                      output_grad_values,
+                                      global_inner_scope,
+                                      /*is_output=*/false));
+  } else {
+    details::ShareTensorsIntoScopeByValue(
+        out_grad, output_grad_values, global_inner_scope);
+  }
 
-  auto &cache = paddle::framework::InterpreterCoreInfoCache::Instance();
   std::shared_ptr<paddle::framework::InterpreterCore> interpreter_core =
       nullptr;
   if (!cache.Has(program_id,
@@ -1076,10 +1184,25 @@ inline void PirRunProgramGradAPI(
     phi::RecordEvent record_event(
         "fetch_and_gc", phi::TracerEventType::UserDefined, 1);
     // Step 4. get outputs
-    details::ShareTensorsFromScopeByValue(
-        x_grad, x_grad_values, global_inner_scope);
-    details::ShareTensorsFromScopeByValue(
-        params_grad, p_grad_values, global_inner_scope);
+    auto &cached_value = cache.GetMutable(program_id,
+                                          global_inner_scope,
+                                          place_hash_key,
+                                          /*is_grad=*/true,
+                                          /*in_pir_mode=*/true);
+    details::ShareTensorsFromVars(
+        x_grad,
+        details::GetCachedVarsByValue(&cached_value,
+                                      "bx_g",
+                                      x_grad_values,
+                                      global_inner_scope,
+                                      /*is_output=*/true));
+    details::ShareTensorsFromVars(
+        params_grad,
+        details::GetCachedVarsByValue(&cached_value,
+                                      "bp_g",
+                                      p_grad_values,
+                                      global_inner_scope,
+                                      /*is_output=*/true));
     VLOG(4) << "after backward gc all vars";
     global_inner_scope->SetCanReused(true);
     details::GcScope(global_inner_scope);
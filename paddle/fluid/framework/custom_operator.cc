@@ -62,7 +62,7 @@ static void RunKernelFunc(
     const paddle::KernelFunc& func,
     const std::vector<std::string>& inputs,
     const std::vector<std::string>& outputs,
-    const std::vector<std::string>& attrs,
+    const std::vector<detail::CustomOpAttr>& attrs,
     const std::unordered_map<std::string, std::string>& inplace_map) {
   VLOG(3) << "Custom Operator: Start run KernelFunc.";
   // prepare CustomOpKernelContext
@@ -151,37 +151,46 @@ static void RunKernelFunc(
     }
   }
 
-  for (auto& attr_str : attrs) {
-    auto attr_name_and_type = paddle::ParseAttrStr(attr_str);
-    auto attr_name = attr_name_and_type[0];
-    auto attr_type_str = attr_name_and_type[1];
-    if (attr_type_str == "bool") {
-      kernel_ctx.EmplaceBackAttr(ctx.Attr<bool>(attr_name));
-    } else if (attr_type_str == "int") {
-      kernel_ctx.EmplaceBackAttr(ctx.Attr<int>(attr_name));
-    } else if (attr_type_str == "float") {
-      kernel_ctx.EmplaceBackAttr(ctx.Attr<float>(attr_name));
-    } else if (attr_type_str == "int64_t") {
-      kernel_ctx.EmplaceBackAttr(ctx.Attr<int64_t>(attr_name));
-    } else if (attr_type_str == "std::string") {
-      kernel_ctx.EmplaceBackAttr(ctx.Attr<std::string>(attr_name));
-    } else if (attr_type_str == "std::vector<int>") {
-      kernel_ctx.EmplaceBackAttr(ctx.Attr<std::vector<int>>(attr_name));
-    } else if (attr_type_str == "std::vector<float>") {
-      kernel_ctx.EmplaceBackAttr(ctx.Attr<std::vector<float>>(attr_name));
-    } else if (attr_type_str == "std::vector<int64_t>") {
-      kernel_ctx.EmplaceBackAttr(ctx.Attr<std::vector<int64_t>>(attr_name));
-    } else if (attr_type_str == "std::vector<std::string>") {
-      kernel_ctx.EmplaceBackAttr(ctx.Attr<std::vector<std::string>>(attr_name));
-    } else {
-      PADDLE_THROW(common::errors::Unimplemented(
-          "Unsupported `%s` type value as custom attribute now. "
-          "Supported data types include `bool`, `int`, `float`, `double`, "
-          "`int64_t`, `std::string`, `std::vector<int>`, "
-          "`std::vector<float>`, `std::vector<int64_t>`, "
-          "`std::vector<std::string>`, Please check whether "
-          "the attribute data type and data type string are matched.",
-          attr_type_str));
+  for (auto& attr : attrs) {
+    const auto& attr_name = attr.name;
+    switch (attr.type) {
+      case detail::CustomOpAttr::Type::kBool:
+        kernel_ctx.EmplaceBackAttr(ctx.Attr<bool>(attr_name));
+        break;
+      case detail::CustomOpAttr::Type::kInt:
+        kernel_ctx.EmplaceBackAttr(ctx.Attr<int>(attr_name));
+        break;
+      case detail::CustomOpAttr::Type::kFloat:
+        kernel_ctx.EmplaceBackAttr(ctx.Attr<float>(attr_name));
+        break;
+      case detail::CustomOpAttr::Type::kInt64:
+        kernel_ctx.EmplaceBackAttr(ctx.Attr<int64_t>(attr_name));
+        break;
+      case detail::CustomOpAttr::Type::kString:
+        kernel_ctx.EmplaceBackAttr(ctx.Attr<std::string>(attr_name));
+        break;
+      case detail::CustomOpAttr::Type::kIntVec:
+        kernel_ctx.EmplaceBackAttr(ctx.Attr<std::vector<int>>(attr_name));
+        break;
+      case detail::CustomOpAttr::Type::kFloatVec:
+        kernel_ctx.EmplaceBackAttr(ctx.Attr<std::vector<float>>(attr_name));
+        break;
+      case detail::CustomOpAttr::Type::kInt64Vec:
+        kernel_ctx.EmplaceBackAttr(ctx.Attr<std::vector<int64_t>>(attr_name));
+        break;
+      case detail::CustomOpAttr::Type::kStringVec:
+        kernel_ctx.EmplaceBackAttr(
+            ctx.Attr<std::vector<std::string>>(attr_name));
+        break;
+      default:
+        PADDLE_THROW(common::errors::Unimplemented(
+            "Unsupported `%s` type value as custom attribute now. "
+            "Supported data types include `bool`, `int`, `float`, `double`, "
+            "`int64_t`, `std::string`, `std::vector<int>`, "
+            "`std::vector<float>`, `std::vector<int64_t>`, "
+            "`std::vector<std::string>`, Please check whether "
+            "the attribute data type and data type string are matched.",
+            attr.type_str));
     }
   }
 
@@ -419,7 +428,7 @@ static void RunInferShapeFunc(
     const paddle::InferShapeFunc& func,
     const std::vector<std::string>& inputs,
     const std::vector<std::string>& outputs,
-    const std::vector<std::string>& attrs,
+    const std::vector<detail::CustomOpAttr>& attrs,
     const std::unordered_map<std::string, std::string>& inplace_map,
     const std::unordered_map<std::string, std::string>& inplace_reverse_map) {
   std::vector<std::vector<int64_t>> input_shapes;
@@ -467,42 +476,50 @@ static void RunInferShapeFunc(
   }
 
   std::vector<paddle::any> custom_attrs;
-  for (auto& attr_str : attrs) {
-    auto attr_name_and_type = paddle::ParseAttrStr(attr_str);
-    auto attr_name = attr_name_and_type[0];
-    auto attr_type_str = attr_name_and_type[1];
-    if (attr_type_str == "bool") {
-      custom_attrs.emplace_back(ctx->Attrs().Get<bool>(attr_name));
-    } else if (attr_type_str == "int") {
-      custom_attrs.emplace_back(ctx->Attrs().Get<int>(attr_name));
-    } else if (attr_type_str == "float") {
-      custom_attrs.emplace_back(ctx->Attrs().Get<float>(attr_name));
-    } else if (attr_type_str == "int64_t") {
-      custom_attrs.emplace_back(ctx->Attrs().Get<int64_t>(attr_name));
-    } else if (attr_type_str == "std::string") {
-      custom_attrs.emplace_back(ctx->Attrs().Get<std::string>(attr_name));
-    } else if (attr_type_str == "std::vector<int>") {
-      custom_attrs.emplace_back(ctx->Attrs().Get<std::vector<int>>(attr_name));
-    } else if (attr_type_str == "std::vector<float>") {
-      custom_attrs.emplace_back(
-          ctx->Attrs().Get<std::vector<float>>(attr_name));
-    } else if (attr_type_str == "std::vector<int64_t>") {
-      // NOTE(chenweihang): InferShape can't support std::vector<int64_t>
-      // attr type, because the input type is std::vector<int64_t>, only
-      // can use one rule to parse std::vector<int64_t> parameter
-      continue;
-    } else if (attr_type_str == "std::vector<std::string>") {
-      custom_attrs.emplace_back(
-          ctx->Attrs().Get<std::vector<std::string>>(attr_name));
-    } else {
-      PADDLE_THROW(common::errors::Unimplemented(
-          "Unsupported `%s` type value as custom attribute now. "
-          "Supported data types include `bool`, `int`, `float`, "
-          "`int64_t`, `std::string`, `std::vector<int>`, "
-          "`std::vector<float>`, `std::vector<int64_t>`, "
-          "`std::vector<std::string>`, Please check whether the attribute data "
-          "type and data type string are matched.",
-          attr_type_str));
+  for (auto& attr : attrs) {
+    const auto& attr_name = attr.name;
+    switch (attr.type) {
+      case detail::CustomOpAttr::Type::kBool:
+        custom_attrs.emplace_back(ctx->Attrs().Get<bool>(attr_name));
+        break;
+      case detail::CustomOpAttr::Type::kInt:
+        custom_attrs.emplace_back(ctx->Attrs().Get<int>(attr_name));
+        break;
+      case detail::CustomOpAttr::Type::kFloat:
+        custom_attrs.emplace_back(ctx->Attrs().Get<float>(attr_name));
+        break;
+      case detail::CustomOpAttr::Type::kInt64:
+        custom_attrs.emplace_back(ctx->Attrs().Get<int64_t>(attr_name));
+        break;
+      case detail::CustomOpAttr::Type::kString:
+        custom_attrs.emplace_back(ctx->Attrs().Get<std::string>(attr_name));
+        break;
+      case detail::CustomOpAttr::Type::kIntVec:
+        custom_attrs.emplace_back(
+            ctx->Attrs().Get<std::vector<int>>(attr_name));
+        break;
+      case detail::CustomOpAttr::Type::kFloatVec:
+        custom_attrs.emplace_back(
+            ctx->Attrs().Get<std::vector<float>>(attr_name));
+        break;
+      case detail::CustomOpAttr::Type::kInt64Vec:
+        // NOTE(chenweihang): InferShape can't support std::vector<int64_t>
+        // attr type, because the input type is std::vector<int64_t>, only
+        // can use one rule to parse std::vector<int64_t> parameter
+        break;
+      case detail::CustomOpAttr::Type::kStringVec:
+        custom_attrs.emplace_back(
+            ctx->Attrs().Get<std::vector<std::string>>(attr_name));
+        break;
+      default:
+        PADDLE_THROW(common::errors::Unimplemented(
+            "Unsupported `%s` type value as custom attribute now. "
+            "Supported data types include `bool`, `int`, `float`, "
+            "`int64_t`, `std::string`, `std::vector<int>`, "
+            "`std::vector<float>`, `std::vector<int64_t>`, "
+            "`std::vector<std::string>`, Please check whether the attribute "
+            "data type and data type string are matched.",
+            attr.type_str));
     }
   }
 
@@ -671,7 +688,7 @@ static void RunInferDtypeFunc(
     const paddle::InferDtypeFunc& func,
     const std::vector<std::string>& inputs,
     const std::vector<std::string>& outputs,
-    const std::vector<std::string>& attrs,
+    const std::vector<detail::CustomOpAttr>& attrs,
     const std::unordered_map<std::string, std::string>& inplace_map,
     const std::unordered_map<std::string, std::string>& inplace_reverse_map) {
   std::vector<DataType> input_dtypes;
@@ -714,45 +731,54 @@ static void RunInferDtypeFunc(
   }
 
   std::vector<paddle::any> custom_attrs;
-  for (auto& attr_str : attrs) {
-    auto attr_name_and_type = paddle::ParseAttrStr(attr_str);
-    auto attr_name = attr_name_and_type[0];
-    auto attr_type_str = attr_name_and_type[1];
-    if (attr_type_str == "bool") {
-      custom_attrs.emplace_back(
-          PADDLE_GET_CONST(bool, ctx->GetAttr(attr_name)));
-    } else if (attr_type_str == "int") {
-      custom_attrs.emplace_back(PADDLE_GET_CONST(int, ctx->GetAttr(attr_name)));
-    } else if (attr_type_str == "float") {
-      custom_attrs.emplace_back(
-          PADDLE_GET_CONST(float, ctx->GetAttr(attr_name)));
-    } else if (attr_type_str == "int64_t") {
-      custom_attrs.emplace_back(
-          PADDLE_GET_CONST(int64_t, ctx->GetAttr(attr_name)));
-    } else if (attr_type_str == "std::string") {
-      custom_attrs.emplace_back(
-          PADDLE_GET_CONST(std::string, ctx->GetAttr(attr_name)));
-    } else if (attr_type_str == "std::vector<int>") {
-      custom_attrs.emplace_back(
-          PADDLE_GET_CONST(std::vector<int>, ctx->GetAttr(attr_name)));
-    } else if (attr_type_str == "std::vector<float>") {
-      custom_attrs.emplace_back(
-          PADDLE_GET_CONST(std::vector<float>, ctx->GetAttr(attr_name)));
-    } else if (attr_type_str == "std::vector<int64_t>") {
-      custom_attrs.emplace_back(
-          PADDLE_GET_CONST(std::vector<int64_t>, ctx->GetAttr(attr_name)));
-    } else if (attr_type_str == "std::vector<std::string>") {
-      custom_attrs.emplace_back(
-          PADDLE_GET_CONST(std::vector<std::string>, ctx->GetAttr(attr_name)));
-    } else {
-      PADDLE_THROW(common::errors::Unimplemented(
-          "Unsupported `%s` type value as custom attribute now. "
-          "Supported data types include `bool`, `int`, `float`, "
-          "`int64_t`, `std::string`, `std::vector<int>`, "
-          "`std::vector<float>`, `std::vector<int64_t>`, "
-          "`std::vector<std::string>`, Please check whether the attribute data "
-          "type and data type string are matched.",
-          attr_type_str));
+  for (auto& attr : attrs) {
+    const auto& attr_name = attr.name;
+    switch (attr.type) {
+      case detail::CustomOpAttr::Type::kBool:
+        custom_attrs.emplace_back(
+            PADDLE_GET_CONST(bool, ctx->GetAttr(attr_name)));
+        break;
+      case detail::CustomOpAttr::Type::kInt:
+        custom_attrs.emplace_back(
+            PADDLE_GET_CONST(int, ctx->GetAttr(attr_name)));
+        break;
+      case detail::CustomOpAttr::Type::kFloat:
+        custom_attrs.emplace_back(
+            PADDLE_GET_CONST(float, ctx->GetAttr(attr_name)));
+        break;
+      case detail::CustomOpAttr::Type::kInt64:
+        custom_attrs.emplace_back(
+            PADDLE_GET_CONST(int64_t, ctx->GetAttr(attr_name)));
+        break;
+      case detail::CustomOpAttr::Type::kString:
+        custom_attrs.emplace_back(
+            PADDLE_GET_CONST(std::string, ctx->GetAttr(attr_name)));
+        break;
+      case detail::CustomOpAttr::Type::kIntVec:
+        custom_attrs.emplace_back(
+            PADDLE_GET_CONST(std::vector<int>, ctx->GetAttr(attr_name)));
+        break;
+      case detail::CustomOpAttr::Type::kFloatVec:
+        custom_attrs.emplace_back(
+            PADDLE_GET_CONST(std::vector<float>, ctx->GetAttr(attr_name)));
+        break;
+      case detail::CustomOpAttr::Type::kInt64Vec:
+        custom_attrs.emplace_back(
+            PADDLE_GET_CONST(std::vector<int64_t>, ctx->GetAttr(attr_name)));
+        break;
+      case detail::CustomOpAttr::Type::kStringVec:
+        custom_attrs.emplace_back(PADDLE_GET_CONST(std::vector<std::string>,
+                                                   ctx->GetAttr(attr_name)));
+        break;
+      default:
+        PADDLE_THROW(common::errors::Unimplemented(
+            "Unsupported `%s` type value as custom attribute now. "
+            "Supported data types include `bool`, `int`, `float`, "
+            "`int64_t`, `std::string`, `std::vector<int>`, "
+            "`std::vector<float>`, `std::vector<int64_t>`, "
+            "`std::vector<std::string>`, Please check whether the attribute "
+            "data type and data type string are matched.",
+            attr.type_str));
     }
   }
 
@@ -905,7 +931,7 @@ static void RegisterOperatorKernel(
     const paddle::KernelFunc& kernel_func,
     const std::vector<std::string>& inputs,
     const std::vector<std::string>& outputs,
-    const std::vector<std::string>& attrs,
+    const std::vector<detail::CustomOpAttr>& attrs,
     const std::unordered_map<std::string, std::string>& inplace_map,
     void* dso_handle) {
   VLOG(3) << "Custom Operator: op name in kernel: " << name;
@@ -971,6 +997,7 @@ void RegisterOperatorWithMetaInfo(const std::vector<OpMetaInfo>& op_meta_infos,
   auto& op_inputs = OpMetaInfoHelper::GetInputs(base_op_meta);
   auto& op_outputs = OpMetaInfoHelper::GetOutputs(base_op_meta);
   auto& op_attrs = OpMetaInfoHelper::GetAttrs(base_op_meta);
+  auto op_custom_attrs = detail::ParseCustomOpAttrs(op_attrs);
   auto& op_inplace_map = OpMetaInfoHelper::GetInplaceMap(base_op_meta);
   auto& op_inplace_reverse_map =
       OpMetaInfoHelper::GetInplaceReverseMap(base_op_meta);
@@ -1032,7 +1059,7 @@ void RegisterOperatorWithMetaInfo(const std::vector<OpMetaInfo>& op_meta_infos,
   } else {
     info.infer_shape_ = [op_inputs,  // NOLINT
                          op_outputs,
-                         op_attrs,
+                         op_custom_attrs,
                          op_inplace_map,
                          op_inplace_reverse_map,
                          infer_shape_func](InferShapeContext* ctx) {
@@ -1040,7 +1067,7 @@ void RegisterOperatorWithMetaInfo(const std::vector<OpMetaInfo>& op_meta_infos,
                         infer_shape_func,
                         op_inputs,
                         op_outputs,
-                        op_attrs,
+                        op_custom_attrs,
                         op_inplace_map,
                         op_inplace_reverse_map);
     };
@@ -1056,7 +1083,7 @@ void RegisterOperatorWithMetaInfo(const std::vector<OpMetaInfo>& op_meta_infos,
   } else {
     info.infer_var_type_ = [op_inputs,  // NOLINT
                             op_outputs,
-                            op_attrs,
+                            op_custom_attrs,
                             op_inplace_map,
                             op_inplace_reverse_map,
                             infer_dtype_func](InferVarTypeContext* ctx) {
@@ -1064,7 +1091,7 @@ void RegisterOperatorWithMetaInfo(const std::vector<OpMetaInfo>& op_meta_infos,
                         infer_dtype_func,
                         op_inputs,
                         op_outputs,
-                        op_attrs,
+                        op_custom_attrs,
                         op_inplace_map,
                         op_inplace_reverse_map);
     };
@@ -1075,7 +1102,7 @@ void RegisterOperatorWithMetaInfo(const std::vector<OpMetaInfo>& op_meta_infos,
                          kernel_fn,
                          op_inputs,
                          op_outputs,
-                         op_attrs,
+                         op_custom_attrs,
                          op_inplace_map,
                          dso_handle);
 
@@ -1088,6 +1115,7 @@ void RegisterOperatorWithMetaInfo(const std::vector<OpMetaInfo>& op_meta_infos,
     auto& grad_op_inputs = OpMetaInfoHelper::GetInputs(cur_grad_op);
     auto& grad_op_outputs = OpMetaInfoHelper::GetOutputs(cur_grad_op);
     auto& grad_op_attrs = OpMetaInfoHelper::GetAttrs(cur_grad_op);
+    auto grad_op_custom_attrs = detail::ParseCustomOpAttrs(grad_op_attrs);
     auto& grad_op_inplace_map = OpMetaInfoHelper::GetInplaceMap(cur_grad_op);
     auto& grad_op_inplace_reverse_map =
         OpMetaInfoHelper::GetInplaceReverseMap(cur_grad_op);
@@ -1217,7 +1245,7 @@ void RegisterOperatorWithMetaInfo(const std::vector<OpMetaInfo>& op_meta_infos,
     } else {
       grad_info.infer_shape_ = [grad_op_inputs,  // NOLINT
                                 grad_op_outputs,
-                                grad_op_attrs,
+                                grad_op_custom_attrs,
                                 grad_op_inplace_map,
                                 grad_op_inplace_reverse_map,
                                 grad_infer_shape_fn](InferShapeContext* ctx) {
@@ -1225,7 +1253,7 @@ void RegisterOperatorWithMetaInfo(const std::vector<OpMetaInfo>& op_meta_infos,
                           grad_infer_shape_fn,
                           grad_op_inputs,
                           grad_op_outputs,
-                          grad_op_attrs,
+                          grad_op_custom_attrs,
                           grad_op_inplace_map,
                           grad_op_inplace_reverse_map);
       };
@@ -1236,7 +1264,7 @@ void RegisterOperatorWithMetaInfo(const std::vector<OpMetaInfo>& op_meta_infos,
       grad_info.infer_var_type_ =
           [grad_op_inputs,  // NOLINT
            grad_op_outputs,
-           grad_op_attrs,
+           grad_op_custom_attrs,
            grad_op_inplace_map,
            grad_op_inplace_reverse_map,
            grad_infer_dtype_fn](InferVarTypeContext* ctx) {
@@ -1244,7 +1272,7 @@ void RegisterOperatorWithMetaInfo(const std::vector<OpMetaInfo>& op_meta_infos,
                               grad_infer_dtype_fn,
                               grad_op_inputs,
                               grad_op_outputs,
-                              grad_op_attrs,
+                              grad_op_custom_attrs,
                               grad_op_inplace_map,
                               grad_op_inplace_reverse_map);
           };
@@ -1255,7 +1283,7 @@ void RegisterOperatorWithMetaInfo(const std::vector<OpMetaInfo>& op_meta_infos,
                            grad_kernel_fn,
                            grad_op_inputs,
                            grad_op_outputs,
-                           grad_op_attrs,
+                           grad_op_custom_attrs,
                            grad_op_inplace_map,
                            dso_handle);
 
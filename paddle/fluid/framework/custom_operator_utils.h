@@ -15,6 +15,8 @@ limitations under the License. */
 #pragma once
 
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "paddle/fluid/framework/operator.h"
 #include "paddle/fluid/pir/dialect/distributed/ir/dist_tools.h"
@@ -192,6 +194,61 @@ inline static bool HasGradOp(const std::string& fwd_pir_op_name) {
     return vec_op_meta.size() > 1UL;
   }
 }
+
+// The attribute of a custom op, parsed from its `<name>:<type>` string once
+// when the op is registered, so that running the op only switches on the type.
+struct CustomOpAttr {
+  enum class Type {
+    kBool,
+    kInt,
+    kFloat,
+    kDouble,
+    kInt64,
+    kString,
+    kIntVec,
+    kFloatVec,
+    kInt64Vec,
+    kStringVec,
+  };
+
+  std::string name;
+  std::string type_str;
+  Type type;
+};
+
+inline static std::vector<CustomOpAttr> ParseCustomOpAttrs(
+    const std::vector<std::string>& attrs) {
+  static const std::unordered_map<std::string, CustomOpAttr::Type> types = {
+      {"bool", CustomOpAttr::Type::kBool},
+      {"int", CustomOpAttr::Type::kInt},
+      {"float", CustomOpAttr::Type::kFloat},
+      {"double", CustomOpAttr::Type::kDouble},
+      {"int64_t", CustomOpAttr::Type::kInt64},
+      {"std::string", CustomOpAttr::Type::kString},
+      {"std::vector<int>", CustomOpAttr::Type::kIntVec},
+      {"std::vector<float>", CustomOpAttr::Type::kFloatVec},
+      {"std::vector<int64_t>", CustomOpAttr::Type::kInt64Vec},
+      {"std::vector<std::string>", CustomOpAttr::Type::kStringVec}};
+  std::vector<CustomOpAttr> custom_attrs;
+  custom_attrs.reserve(attrs.size());
+  for (const auto& attr : attrs) {
+    auto attr_name_and_type = paddle::ParseAttrStr(attr);
+    auto it = types.find(attr_name_and_type[1]);
+    if (it == types.end()) {
+      PADDLE_THROW(common::errors::Unimplemented(
+          "Unsupported `%s` type value as custom attribute now. "
+          "Supported data types include `bool`, `int`, `float`, `double`, "
+          "`int64_t`, `std::string`, `std::vector<int>`, "
+          "`std::vector<float>`, `std::vector<int64_t>`, "
+          "`std::vector<std::string>`, Please check whether "
+          "the attribute data type and data type string are matched.",
+          attr_name_and_type[1]));
+    }
+    custom_attrs.push_back(
+        {attr_name_and_type[0], attr_name_and_type[1], it->second});
+  }
+  return custom_attrs;
+}
 }  // namespace detail
 
 static void CheckDefaultInferShapeDtype(
@@ -21,10 +21,16 @@ limitations under the License. */
 
 #include "paddle/fluid/framework/fleet/ps_gpu_wrapper.h"
 #ifdef _LINUX
+#include <fcntl.h>
 #include <stdio_ext.h>
+#include <unistd.h>
+#include <algorithm>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #endif
+extern "C" {
+#include <xxhash.h>
+}
 #include "io/fs.h"
 #include "paddle/common/enforce.h"
 #include "paddle/phi/core/platform/monitor.h"
@@ -32,6 +38,8 @@ limitations under the License. */
 
 USE_INT_STAT(STAT_total_feasign_num_in_mem);
 COMMON_DECLARE_bool(enable_ins_parser_file);
+COMMON_DECLARE_bool(dataset_prefetch_next_file);
+COMMON_DECLARE_string(dataset_parsed_cache_dir);
 namespace paddle::framework {
 
 DLManager& global_dlmanager_pool() {
@@ -245,6 +253,41 @@ bool DataFeed::PickOneFile(std::string* filename) {
   return true;
 }
 
+DataFeed::OpenedFile DataFeed::PickAndOpenFile() {
+  OpenedFile file;
+  file.picked = PickOneFile(&file.filename);
+  if (file.picked) {
+    int err_no = 0;
+    file.fp = fs_open_read(file.filename, &err_no, pipe_command_, true);
+  }
+  return file;
+}
+
+bool DataFeed::PickAndOpenOneFile(std::string* filename,
+                                  std::shared_ptr<FILE>* fp) {
+  OpenedFile file;
+  if (next_file_.valid()) {
+    platform::Timer timeline;
+    timeline.Start();
+    file = next_file_.get();
+    timeline.Pause();
+    VLOG(3) << "Wait for the prefetched file " << file.filename << " for "
+            << timeline.ElapsedSec() << " seconds";
+  } else {
+    file = PickAndOpenFile();
+  }
+  if (!file.picked) {
+    return false;
+  }
+  if (FLAGS_dataset_prefetch_next_file) {
+    next_file_ =
+        std::async(std::launch::async, [this] { return PickAndOpenFile(); });
+  }
+  *filename = std::move(file.filename);
+  *fp = std::move(file.fp);
+  return true;
+}
+
 void DataFeed::CheckInit() {
   PADDLE_ENFORCE_EQ(
       finish_init_,
@@ -561,46 +604,200 @@ void InMemoryDataFeed<T>::LoadIntoMemory() {
   }
   VLOG(3) << "LoadIntoMemory() begin, thread_id=" << thread_id_;
   std::string filename;
-  while (this->PickOneFile(&filename)) {
-    VLOG(3) << "PickOneFile, filename=" << filename
-            << ", thread_id=" << thread_id_;
 #ifdef PADDLE_WITH_BOX_PS
-    if (BoxWrapper::GetInstance()->UseAfsApi()) {
-      this->fp_ = BoxWrapper::GetInstance()->afs_manager->GetFile(
-          filename, this->pipe_command_);
-    } else {
-#endif
-      int err_no = 0;
-      this->fp_ = fs_open_read(filename, &err_no, this->pipe_command_, true);
-#ifdef PADDLE_WITH_BOX_PS
-    }
+  const bool use_afs_api = BoxWrapper::GetInstance()->UseAfsApi();
+#else
+  const bool use_afs_api = false;
 #endif
-    PADDLE_ENFORCE_EQ(this->fp_ != nullptr,
-                      true,
-                      common::errors::InvalidArgument(
-                          "This fp should not be null, please check!"));
-    __fsetlocking(&*(this->fp_), FSETLOCKING_BYCALLER);
-    paddle::framework::ChannelWriter<T> writer(input_channel_);
-    T instance;
+  // the cache is looked up before the file is opened, so it does not go
+  // through the prefetch of PickAndOpenOneFile
+  const bool use_cache =
+      !use_afs_api && !FLAGS_dataset_parsed_cache_dir.empty();
+  uint64_t total_ins_num = 0;
+  platform::Timer total_timeline;
+  total_timeline.Start();
+  while (use_afs_api || use_cache
+             ? this->PickOneFile(&filename)
+             : this->PickAndOpenOneFile(&filename, &this->fp_)) {
+    VLOG(3) << "PickOneFile, filename=" << filename
+            << ", thread_id=" << thread_id_;
     platform::Timer timeline;
     timeline.Start();
-    while (ParseOneInstanceFromPipe(&instance)) {
-      writer << std::move(instance);
-      instance = T();
+    uint64_t ins_num = 0;
+    std::string cache_path;
+    if (use_cache) {
+      cache_path = ParsedCachePath(filename);
+    }
+    if (!use_cache || !LoadParsedCache(cache_path, &ins_num)) {
+#ifdef PADDLE_WITH_BOX_PS
+      if (use_afs_api) {
+        this->fp_ = BoxWrapper::GetInstance()->afs_manager->GetFile(
+            filename, this->pipe_command_);
+      }
+#endif
+      if (use_cache) {
+        int err_no = 0;
+        this->fp_ = fs_open_read(filename, &err_no, this->pipe_command_, true);
+      }
+      PADDLE_ENFORCE_EQ(this->fp_ != nullptr,
+                        true,
+                        common::errors::InvalidArgument(
+                            "This fp should not be null, please check!"));
+      __fsetlocking(&*(this->fp_), FSETLOCKING_BYCALLER);
+      paddle::framework::ChannelWriter<T> writer(input_channel_);
+      BinaryArchive ar;
+      T instance;
+      while (ParseOneInstanceFromPipe(&instance)) {
+        if (use_cache) {
+          // the archive operators of Record only keep what global shuffle
+          // needs, the rest of the parsed fields are appended here
+          ar << instance << instance.content_ << instance.search_id
+             << instance.rank << instance.cmatch << instance.uid_;
+        }
+        writer << std::move(instance);
+        instance = T();
+        ++ins_num;
+      }
+      writer.Flush();
+      if (use_cache) {
+        SaveParsedCache(cache_path, &ar, ins_num);
+      }
     }
+    total_ins_num += ins_num;
     STAT_ADD(STAT_total_feasign_num_in_mem, fea_num_);
     {
       std::lock_guard<std::mutex> flock(*mutex_for_fea_num_);
       *total_fea_num_ += fea_num_;
       fea_num_ = 0;
     }
-    writer.Flush();
     timeline.Pause();
     VLOG(3) << "LoadIntoMemory() read all lines, file=" << filename
             << ", cost time=" << timeline.ElapsedSec()
-            << " seconds, thread_id=" << thread_id_;
+            << " seconds, instances=" << ins_num << ", throughput="
+            << ins_num / std::max(timeline.ElapsedSec(), 1e-6)
+            << " ins/s, thread_id=" << thread_id_;
+  }
+  total_timeline.Pause();
+  VLOG(3) << "LoadIntoMemory() end, thread_id=" << thread_id_
+          << ", instances=" << total_ins_num << ", throughput="
+          << total_ins_num / std::max(total_timeline.ElapsedSec(), 1e-6)
+          << " ins/s";
+#endif
+}
+
+namespace {
+
+constexpr uint32_t kParsedCacheMagic = 0x43504450;  // "PDPC"
+constexpr uint32_t kParsedCacheVersion = 1;
+
+struct ParsedCacheHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t ins_num;
+  uint64_t payload_bytes;
+  uint64_t checksum;
+};
+
+}  // namespace
+
+template <typename T>
+std::string InMemoryDataFeed<T>::ParsedCachePath(const std::string& filename) {
+  std::string key = filename + "\n" + this->pipe_command_;
+  for (const auto& slot : this->use_slots_) {
+    key += "\n" + slot;
+  }
+  char name[32];
+  snprintf(name,
+           sizeof(name),
+           "%016llx.pcache",
+           static_cast<unsigned long long>(  // NOLINT
+               XXH64(key.data(), key.length(), 0)));
+  return FLAGS_dataset_parsed_cache_dir + "/" + name;
+}
+
+template <typename T>
+bool InMemoryDataFeed<T>::LoadParsedCache(const std::string& path,
+                                          uint64_t* ins_num) {
+#ifdef _LINUX
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 ||
+      static_cast<size_t>(st.st_size) < sizeof(ParsedCacheHeader)) {
+    close(fd);
+    return false;
+  }
+  size_t size = static_cast<size_t>(st.st_size);
+  void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    return false;
+  }
+  madvise(addr, size, MADV_SEQUENTIAL);
+  ParsedCacheHeader header;
+  memcpy(&header, addr, sizeof(header));
+  char* payload = static_cast<char*>(addr) + sizeof(header);
+  if (header.magic != kParsedCacheMagic ||
+      header.version != kParsedCacheVersion ||
+      header.payload_bytes != size - sizeof(header) ||
+      header.checksum != XXH64(payload, header.payload_bytes, 0)) {
+    LOG(WARNING) << "Ignore the invalid parsed cache " << path;
+    munmap(addr, size);
+    return false;
+  }
+
+  BinaryArchive ar;
+  ar.SetReadBuffer(payload, header.payload_bytes, [](char*) {});
+  paddle::framework::ChannelWriter<T> writer(input_channel_);
+  T instance;
+  for (uint64_t i = 0; i < header.ins_num; ++i) {
+    ar >> instance >> instance.content_ >> instance.search_id >>
+        instance.rank >> instance.cmatch >> instance.uid_;
+    fea_num_ += instance.uint64_feasigns_.size();
+    writer << std::move(instance);
+    instance = T();
+  }
+  writer.Flush();
+  munmap(addr, size);
+  *ins_num = header.ins_num;
+  VLOG(3) << "Load " << header.ins_num << " instances from parsed cache "
+          << path;
+  return true;
+#else
+  return false;
+#endif
+}
+
+template <typename T>
+void InMemoryDataFeed<T>::SaveParsedCache(const std::string& path,
+                                          BinaryArchive* ar,
+                                          uint64_t ins_num) {
+#ifdef _LINUX
+  ParsedCacheHeader header;
+  header.magic = kParsedCacheMagic;
+  header.version = kParsedCacheVersion;
+  header.ins_num = ins_num;
+  header.payload_bytes = ar->Length();
+  header.checksum = XXH64(ar->Buffer(), ar->Length(), 0);
+
+  // Write to a temporary file first, so that the readers never see a
+  // partial cache.
+  std::string tmp_path = path + ".tmp." + std::to_string(getpid()) + "." +
+                         std::to_string(thread_id_);
+  FILE* fp = fopen(tmp_path.c_str(), "wb");
+  if (fp == nullptr) {
+    LOG(WARNING) << "Failed to create the parsed cache " << tmp_path;
+    return;
+  }
+  bool ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+            fwrite(ar->Buffer(), 1, ar->Length(), fp) == ar->Length();
+  ok = fclose(fp) == 0 && ok;
+  if (!ok || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    LOG(WARNING) << "Failed to write the parsed cache " << path;
+    std::remove(tmp_path.c_str());
   }
-  VLOG(3) << "LoadIntoMemory() end, thread_id=" << thread_id_;
 #endif
 }
 
@@ -2419,8 +2616,12 @@ void SlotRecordInMemoryDataFeed::LoadIntoMemoryByCommand() {
   std::string filename;
   BufferedLineFileReader line_reader;
   line_reader.set_sample_rate(sample_rate_);
+  platform::Timer total_timeline;
+  total_timeline.Start();
+  double total_mb = 0;
 
-  while (this->PickOneFile(&filename)) {
+  std::shared_ptr<FILE> fp;
+  while (this->PickAndOpenOneFile(&filename, &fp)) {
     VLOG(3) << "PickOneFile, filename=" << filename
             << ", thread_id=" << thread_id_;
     int lines = 0;
@@ -2431,8 +2632,13 @@ void SlotRecordInMemoryDataFeed::LoadIntoMemoryByCommand() {
     int offset = 0;
 
     do {
-      int err_no = 0;
-      this->fp_ = fs_open_read(filename, &err_no, this->pipe_command_, true);
+      // The first try reads the file opened by PickAndOpenOneFile.
+      if (fp != nullptr) {
+        this->fp_ = std::move(fp);
+      } else {
+        int err_no = 0;
+        this->fp_ = fs_open_read(filename, &err_no, this->pipe_command_, true);
+      }
       PADDLE_ENFORCE_EQ(this->fp_ != nullptr,
                         true,
                         common::errors::InvalidArgument(
@@ -2471,14 +2677,20 @@ void SlotRecordInMemoryDataFeed::LoadIntoMemoryByCommand() {
     record_vec.clear();
     record_vec.shrink_to_fit();
     timeline.Pause();
+    const double file_mb = line_reader.file_size() / 1024.0 / 1024.0;
+    total_mb += file_mb;
     VLOG(3) << "LoadIntoMemory() read all lines, file=" << filename
             << ", lines=" << lines
             << ", sample lines=" << line_reader.get_sample_line()
             << ", cost time=" << timeline.ElapsedSec()
-            << " seconds, thread_id=" << thread_id_;
+            << " seconds, throughput="
+            << file_mb / std::max(timeline.ElapsedSec(), 1e-6)
+            << "MB/s, thread_id=" << thread_id_;
   }
+  total_timeline.Pause();
   VLOG(3) << "LoadIntoMemory() end, thread_id=" << thread_id_
-          << ", total size: " << line_reader.file_size();
+          << ", total size: " << total_mb << "MB, throughput="
+          << total_mb / std::max(total_timeline.ElapsedSec(), 1e-6) << "MB/s";
 #endif
 }
 
@@ -2618,6 +2830,49 @@ void SlotRecordInMemoryDataFeed::AssignFeedVar(const Scope& scope) {
 #endif
 }
 
+// Computes the LoD offsets of a slot over the records, an uint64 slot
+// without value is padded with one 0. Returns the total value number.
+template <typename T>
+static int CountSlotValues(const SlotRecord* ins_vec,
+                           int num,
+                           SlotValues<T> SlotRecordObject::*values,
+                           int slot_value_idx,
+                           bool pad_empty,
+                           std::vector<size_t>* slot_offset) {
+  slot_offset->clear();
+  slot_offset->reserve(num + 1);
+  slot_offset->push_back(0);
+  size_t total_instance = 0;
+  for (int i = 0; i < num; ++i) {
+    auto& offsets = (ins_vec[i]->*values).slot_offsets;
+    size_t fea_num = offsets[slot_value_idx + 1] - offsets[slot_value_idx];
+    total_instance += (fea_num == 0 && pad_empty) ? 1 : fea_num;
+    slot_offset->push_back(total_instance);
+  }
+  return static_cast<int>(total_instance);
+}
+
+// Copies the values of a slot of the records into dst, which holds the
+// total value number given by CountSlotValues.
+template <typename T>
+static void GatherSlotValues(const SlotRecord* ins_vec,
+                             int num,
+                             SlotValues<T> SlotRecordObject::*values,
+                             int slot_value_idx,
+                             bool pad_empty,
+                             T* dst) {
+  for (int i = 0; i < num; ++i) {
+    size_t fea_num = 0;
+    T* slot_values = (ins_vec[i]->*values).get_values(slot_value_idx, &fea_num);
+    if (fea_num > 0) {
+      memcpy(dst, slot_values, sizeof(T) * fea_num);
+      dst += fea_num;
+    } else if (pad_empty) {
+      *dst++ = 0;
+    }
+  }
+}
+
 void SlotRecordInMemoryDataFeed::PutToFeedVec(const SlotRecord* ins_vec,
                                               int num) {
   // set ins id
@@ -2631,70 +2886,67 @@ void SlotRecordInMemoryDataFeed::PutToFeedVec(const SlotRecord* ins_vec,
 #if defined(PADDLE_WITH_CUDA) && defined(PADDLE_WITH_HETERPS)
   // do nothing
 #else
+  bool is_cpu_place = phi::is_cpu_place(this->place_);
   for (int j = 0; j < use_slot_size_; ++j) {
     auto& feed = feed_vec_[j];
     if (feed == nullptr) {
       continue;
     }
 
+    // The offsets are computed first, so that the values are gathered once
+    // into a buffer of the final size. On CPU the buffer is the tensor.
     auto& slot_offset = offset_[j];
-    slot_offset.clear();
-    slot_offset.reserve(num + 1);
-    slot_offset.push_back(0);
-
     int total_instance = 0;
     auto& info = used_slots_info_[j];
-    // fill slot value with default value 0
     if (info.type[0] == 'f') {  // float
-      auto& batch_fea = batch_float_feasigns_[j];
-      batch_fea.clear();
-
-      for (int i = 0; i < num; ++i) {
-        auto r = ins_vec[i];
-        size_t fea_num = 0;
-        float* slot_values =
-            r->slot_float_feasigns_.get_values(info.slot_value_idx, &fea_num);
-        batch_fea.resize(total_instance + fea_num);
-        memcpy(
-            &batch_fea[total_instance], slot_values, sizeof(float) * fea_num);
-        total_instance += static_cast<int>(fea_num);
-        slot_offset.push_back(total_instance);
-      }
-
-      float* feasign = batch_fea.data();
+      total_instance = CountSlotValues(ins_vec,
+                                       num,
+                                       &SlotRecordObject::slot_float_feasigns_,
+                                       info.slot_value_idx,
+                                       false,
+                                       &slot_offset);
       float* tensor_ptr =
           feed->mutable_data<float>({total_instance, 1}, this->place_);
-      CopyToFeedTensor(tensor_ptr, feasign, total_instance * sizeof(float));
-
-    } else if (info.type[0] == 'u') {  // uint64
-      auto& batch_fea = batch_uint64_feasigns_[j];
-      batch_fea.clear();
-
-      for (int i = 0; i < num; ++i) {
-        auto r = ins_vec[i];
-        size_t fea_num = 0;
-        uint64_t* slot_values =
-            r->slot_uint64_feasigns_.get_values(info.slot_value_idx, &fea_num);
-        if (fea_num > 0) {
-          batch_fea.resize(total_instance + fea_num);
-          memcpy(&batch_fea[total_instance],
-                 slot_values,
-                 sizeof(uint64_t) * fea_num);
-          total_instance += static_cast<int>(fea_num);
-        }
-        if (fea_num == 0) {
-          batch_fea.resize(total_instance + fea_num);
-          batch_fea[total_instance] = 0;
-          total_instance += 1;
-        }
-        slot_offset.push_back(total_instance);
+      float* feasign = tensor_ptr;
+      if (!is_cpu_place) {
+        auto& batch_fea = batch_float_feasigns_[j];
+        batch_fea.resize(total_instance);
+        feasign = batch_fea.data();
+      }
+      GatherSlotValues(ins_vec,
+                       num,
+                       &SlotRecordObject::slot_float_feasigns_,
+                       info.slot_value_idx,
+                       false,
+                       feasign);
+      if (!is_cpu_place) {
+        CopyToFeedTensor(tensor_ptr, feasign, total_instance * sizeof(float));
       }
-
+    } else if (info.type[0] == 'u') {  // uint64
+      total_instance = CountSlotValues(ins_vec,
+                                       num,
+                                       &SlotRecordObject::slot_uint64_feasigns_,
+                                       info.slot_value_idx,
+                                       true,
+                                       &slot_offset);
       // no uint64_t type in paddlepaddle
-      uint64_t* feasign = batch_fea.data();
       int64_t* tensor_ptr =
           feed->mutable_data<int64_t>({total_instance, 1}, this->place_);
-      CopyToFeedTensor(tensor_ptr, feasign, total_instance * sizeof(int64_t));
+      uint64_t* feasign = reinterpret_cast<uint64_t*>(tensor_ptr);
+      if (!is_cpu_place) {
+        auto& batch_fea = batch_uint64_feasigns_[j];
+        batch_fea.resize(total_instance);
+        feasign = batch_fea.data();
+      }
+      GatherSlotValues(ins_vec,
+                       num,
+                       &SlotRecordObject::slot_uint64_feasigns_,
+                       info.slot_value_idx,
+                       true,
+                       feasign);
+      if (!is_cpu_place) {
+        CopyToFeedTensor(tensor_ptr, feasign, total_instance * sizeof(int64_t));
+      }
     }
 
     if (info.dense) {
@@ -44,6 +44,7 @@ COMMON_DECLARE_double(gpugraph_hbm_table_load_factor);
 COMMON_DECLARE_bool(enable_graph_multi_node_sampling);
 COMMON_DECLARE_bool(query_dest_rank_by_multi_node);
 COMMON_DECLARE_string(graph_edges_split_mode);
+COMMON_DECLARE_bool(graph_prefetch_slot_feature);
 
 namespace paddle {
 namespace framework {
@@ -1334,6 +1335,12 @@ int GraphDataGenerator::GenerateBatch() {
   if (!conf_.gpu_graph_training) return 1;
   if (!conf_.sage_mode) {
     ins_buf_pair_len_[0] -= total_instance / 2;
+  } else if (FLAGS_graph_prefetch_slot_feature && conf_.accumulate_num == 1 &&
+             uint_slot_num_ > 0 && sage_batch_count_ < sage_batch_num_) {
+    // the next batch pulls its features while this one trains
+    PrefetchSlotFeature(reinterpret_cast<uint64_t *>(
+                            final_sage_nodes_vec_[sage_batch_count_]->ptr()),
+                        uniq_instance_vec_[sage_batch_count_]);
   }
   return 1;
 }
@@ -1685,6 +1692,43 @@ void FillOneStep(
   *cur_sampleidx2row = 1 - *cur_sampleidx2row;
 }
 
+void GraphDataGenerator::PrefetchSlotFeature(uint64_t *d_nodes,
+                                             size_t key_num) {
+  WaitSlotFeaturePrefetch();
+  prefetch_slot_feature_ = GraphSlotFeatureInfo();
+  if (key_num == 0) {
+    return;
+  }
+  // the buffers are not shared with the batch being trained
+  size_t temp_bytes = (key_num + 1) * sizeof(uint32_t);
+  prefetch_slot_feature_.size_list = memory::AllocShared(place_, temp_bytes);
+  prefetch_slot_feature_.size_list_prefix_sum =
+      memory::AllocShared(place_, temp_bytes);
+  slot_feature_prefetch_ =
+      std::async(std::launch::async, [this, d_nodes, key_num]() {
+        platform::CUDADeviceGuard guard(conf_.gpuid);
+        auto gpu_graph_ptr = GraphGpuWrapper::GetInstance();
+        auto &info = prefetch_slot_feature_;
+        info.fea_num =
+            gpu_graph_ptr->get_feature_info_of_nodes(conf_.gpuid,
+                                                     d_nodes,
+                                                     key_num,
+                                                     info.size_list,
+                                                     info.size_list_prefix_sum,
+                                                     info.feature_list,
+                                                     info.slot_list,
+                                                     conf_.sage_mode);
+        info.d_nodes = d_nodes;
+        info.key_num = key_num;
+      });
+}
+
+void GraphDataGenerator::WaitSlotFeaturePrefetch() {
+  if (slot_feature_prefetch_.valid()) {
+    slot_feature_prefetch_.get();
+  }
+}
+
 int GraphDataGenerator::FillSlotFeature(uint64_t *d_walk,
                                         size_t key_num,
                                         int tensor_pair_idx,
@@ -1694,25 +1738,38 @@ int GraphDataGenerator::FillSlotFeature(uint64_t *d_walk,
   std::shared_ptr<phi::Allocation> d_feature_list;
   std::shared_ptr<phi::Allocation> d_slot_list;
 
-  size_t temp_bytes = (key_num + 1) * sizeof(uint32_t);
-  if (d_feature_size_list_buf_ == NULL ||
-      d_feature_size_list_buf_->size() < temp_bytes) {
-    d_feature_size_list_buf_ = memory::AllocShared(this->place_, temp_bytes);
-  }
-  if (d_feature_size_prefixsum_buf_ == NULL ||
-      d_feature_size_prefixsum_buf_->size() < temp_bytes) {
-    d_feature_size_prefixsum_buf_ =
-        memory::AllocShared(this->place_, temp_bytes);
+  int fea_num = 0;
+  WaitSlotFeaturePrefetch();
+  if (prefetch_slot_feature_.d_nodes == d_walk &&
+      prefetch_slot_feature_.key_num == key_num) {
+    // pulled while the last batch trained
+    fea_num = prefetch_slot_feature_.fea_num;
+    d_feature_size_list_buf_ = prefetch_slot_feature_.size_list;
+    d_feature_size_prefixsum_buf_ = prefetch_slot_feature_.size_list_prefix_sum;
+    d_feature_list = prefetch_slot_feature_.feature_list;
+    d_slot_list = prefetch_slot_feature_.slot_list;
+    prefetch_slot_feature_ = GraphSlotFeatureInfo();
+  } else {
+    size_t temp_bytes = (key_num + 1) * sizeof(uint32_t);
+    if (d_feature_size_list_buf_ == NULL ||
+        d_feature_size_list_buf_->size() < temp_bytes) {
+      d_feature_size_list_buf_ = memory::AllocShared(this->place_, temp_bytes);
+    }
+    if (d_feature_size_prefixsum_buf_ == NULL ||
+        d_feature_size_prefixsum_buf_->size() < temp_bytes) {
+      d_feature_size_prefixsum_buf_ =
+          memory::AllocShared(this->place_, temp_bytes);
+    }
+    fea_num =
+        gpu_graph_ptr->get_feature_info_of_nodes(conf_.gpuid,
+                                                 d_walk,
+                                                 key_num,
+                                                 d_feature_size_list_buf_,
+                                                 d_feature_size_prefixsum_buf_,
+                                                 d_feature_list,
+                                                 d_slot_list,
+                                                 conf_.sage_mode);
   }
-  int fea_num =
-      gpu_graph_ptr->get_feature_info_of_nodes(conf_.gpuid,
-                                               d_walk,
-                                               key_num,
-                                               d_feature_size_list_buf_,
-                                               d_feature_size_prefixsum_buf_,
-                                               d_feature_list,
-                                               d_slot_list,
-                                               conf_.sage_mode);
   // num of slot feature
   int slot_num = conf_.slot_num - float_slot_num_;
   int conf_slot_num = slot_num;
@@ -3841,6 +3898,9 @@ int FillWalkBufMultiPath(
 }
 
 void GraphDataGenerator::DoWalkandSage() {
+  // the batches of the last pass, and the prefetch of their features, go
+  WaitSlotFeaturePrefetch();
+  prefetch_slot_feature_ = GraphSlotFeatureInfo();
   if (FLAGS_graph_edges_split_mode == "fennel" ||
       FLAGS_query_dest_rank_by_multi_node) {
     auto gpu_graph_ptr = GraphGpuWrapper::GetInstance();
@@ -4258,6 +4318,8 @@ void GraphDataGenerator::DoSageForInfer() {
 
 void GraphDataGenerator::clear_gpu_mem() {
   platform::CUDADeviceGuard guard(conf_.gpuid);
+  WaitSlotFeaturePrefetch();
+  prefetch_slot_feature_ = GraphSlotFeatureInfo();
 }
 
 int dynamic_adjust_total_row_for_infer(int local_reach_end,
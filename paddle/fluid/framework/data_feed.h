@@ -984,6 +984,18 @@ struct GraphDataGeneratorConfig {
   std::set<int> infer_node_type_index_set;
 };
 
+// The slot feature info of the nodes of a batch, pulled from the gpu graph
+// table before the batch is generated.
+struct GraphSlotFeatureInfo {
+  uint64_t* d_nodes = nullptr;
+  size_t key_num = 0;
+  int fea_num = 0;
+  std::shared_ptr<phi::Allocation> size_list;
+  std::shared_ptr<phi::Allocation> size_list_prefix_sum;
+  std::shared_ptr<phi::Allocation> feature_list;
+  std::shared_ptr<phi::Allocation> slot_list;
+};
+
 class GraphDataGenerator {
  public:
   GraphDataGenerator() {}
@@ -1053,6 +1065,10 @@ class GraphDataGenerator {
   int get_pass_end() { return pass_end_; }
   void clear_gpu_mem();
   int dynamic_adjust_batch_num_for_sage();
+  // Pulls the slot feature info of the nodes on a background thread, to be
+  // taken by the FillSlotFeature of the same nodes.
+  void PrefetchSlotFeature(uint64_t* d_nodes, size_t key_num);
+  void WaitSlotFeaturePrefetch();
 
  protected:
   bool DoWalkForInfer();
@@ -1139,6 +1155,8 @@ class GraphDataGenerator {
   std::vector<size_t> infer_node_end_;
   std::string infer_node_type_;
   phi::DenseTensor multi_node_sync_stat_;
+  GraphSlotFeatureInfo prefetch_slot_feature_;
+  std::future<void> slot_feature_prefetch_;
 };
 
 class DataFeed {
@@ -1432,6 +1450,11 @@ class DataFeed {
   // This function is used to pick one file from the global filelist(thread
   // safe).
   virtual bool PickOneFile(std::string* filename);
+  // Picks one file and opens it for reading. With
+  // FLAGS_dataset_prefetch_next_file, the next file is picked and opened in
+  // background while the current one is parsed, so that forking the pipe
+  // command and connecting to the remote file system overlap with parsing.
+  bool PickAndOpenOneFile(std::string* filename, std::shared_ptr<FILE>* fp);
   virtual void CopyToFeedTensor(void* dst, const void* src, size_t size);
 
   std::vector<std::string> filelist_;
@@ -1441,6 +1464,14 @@ class DataFeed {
   uint64_t* total_fea_num_ = nullptr;
   uint64_t fea_num_ = 0;
 
+  struct OpenedFile {
+    bool picked = false;
+    std::string filename;
+    std::shared_ptr<FILE> fp;
+  };
+  OpenedFile PickAndOpenFile();
+  std::future<OpenedFile> next_file_;
+
   // the alias of used slots, and its order is determined by
   // data_feed_desc(proto object)
   std::vector<std::string> use_slots_;
@@ -1575,6 +1606,15 @@ class InMemoryDataFeed : public DataFeed {
   virtual void PutToFeedVec(const std::vector<T>& ins_vec) = 0;
   virtual void PutToFeedVec(const T* ins_vec, int num) = 0;
 
+  // The parsed records of a file are cached in FLAGS_dataset_parsed_cache_dir
+  // as a header followed by the serialized records. The cache is keyed by the
+  // file name, the pipe command and the used slots.
+  std::string ParsedCachePath(const std::string& filename);
+  bool LoadParsedCache(const std::string& path, uint64_t* ins_num);
+  void SaveParsedCache(const std::string& path,
+                       BinaryArchive* ar,
+                       uint64_t ins_num);
+
   std::vector<std::vector<float>> batch_float_feasigns_;
   std::vector<std::vector<uint64_t>> batch_uint64_feasigns_;
   std::vector<std::vector<size_t>> offset_;
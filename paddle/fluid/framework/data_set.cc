@@ -42,6 +42,7 @@ COMMON_DECLARE_bool(graph_get_neighbor_id);
 COMMON_DECLARE_int32(gpugraph_storage_mode);
 COMMON_DECLARE_string(graph_edges_split_mode);
 COMMON_DECLARE_bool(query_dest_rank_by_multi_node);
+COMMON_DECLARE_int64(dataset_global_shuffle_buffer_bytes);
 
 namespace paddle::framework {
 
@@ -906,6 +907,10 @@ void MultiSlotDataset::GlobalShuffle(int thread_num) {
 #endif
     // auto fleet_ptr = framework::FleetWrapper::GetInstance();
     std::vector<Record> data;
+    if (FLAGS_dataset_global_shuffle_buffer_bytes > 0) {
+      this->BufferedGlobalShuffle(get_client_id);
+      return;
+    }
     while (this->input_channel_->Read(data)) {
       std::vector<paddle::framework::BinaryArchive> ars(this->trainer_num_);
       for (auto& t : data) {
@@ -963,6 +968,69 @@ void MultiSlotDataset::GlobalShuffle(int thread_num) {
           << timeline.ElapsedSec() << " seconds";
 }
 
+void MultiSlotDataset::BufferedGlobalShuffle(
+    const std::function<size_t(const Record&)>& get_client_id) {
+#ifdef PADDLE_WITH_PSCORE
+  auto fleet_ptr = distributed::FleetWrapper::GetInstance();
+#else
+  auto fleet_ptr = framework::FleetWrapper::GetInstance();
+#endif
+  // Records are appended to the buffer of their destination across batches,
+  // so each message is one large contiguous buffer. Sending does not wait
+  // for the replies, only the number of messages in flight is bounded.
+  const size_t buffer_bytes =
+      static_cast<size_t>(FLAGS_dataset_global_shuffle_buffer_bytes);
+  const size_t max_in_flight = static_cast<size_t>(trainer_num_);
+  std::vector<paddle::framework::BinaryArchive> ars(trainer_num_);
+  std::deque<std::future<int32_t>> in_flight;
+  int64_t sent_bytes = 0;
+  int64_t sent_msgs = 0;
+  auto send = [&](int client_id) {
+    auto& ar = ars[client_id];
+    if (ar.Length() == 0) {
+      return;
+    }
+    if (in_flight.size() >= max_in_flight) {
+      in_flight.front().wait();
+      in_flight.pop_front();
+    }
+    std::string msg(ar.Buffer(), ar.Length());
+    sent_bytes += static_cast<int64_t>(msg.length());
+    ++sent_msgs;
+    in_flight.push_back(fleet_ptr->SendClientToClientMsg(0, client_id, msg));
+    ar.Clear();
+  };
+
+  std::vector<Record> data;
+  while (input_channel_->Read(data)) {
+    for (auto& t : data) {
+      auto client_id = get_client_id(t);
+      ars[client_id] << t;
+      if (ars[client_id].Length() >= buffer_bytes) {
+        send(static_cast<int>(client_id));
+      }
+    }
+    data.clear();
+    if (fleet_send_sleep_seconds_ != 0) {
+      sleep(fleet_send_sleep_seconds_);
+    }
+  }
+  std::vector<int> send_index(trainer_num_);
+  for (int i = 0; i < trainer_num_; ++i) {
+    send_index[i] = i;
+  }
+  std::shuffle(
+      send_index.begin(), send_index.end(), fleet_ptr->LocalRandomEngine());
+  for (int i : send_index) {
+    send(i);
+  }
+  for (auto& t : in_flight) {
+    t.wait();
+  }
+  VLOG(3) << "BufferedGlobalShuffle sent " << sent_msgs << " messages, "
+          << sent_bytes << " bytes";
+}
+
 template <typename T>
 void DatasetImpl<T>::DynamicAdjustChannelNum(int channel_num,
                                              bool discard_remaining_ins) {
@@ -16,7 +16,9 @@
 
 #include <ThreadPool.h>
 
+#include <deque>
 #include <fstream>
+#include <functional>
 #include <memory>
 #include <mutex>  // NOLINT
 #include <set>
@@ -423,6 +425,10 @@ class MultiSlotDataset : public DatasetImpl<Record> {
   virtual int ReceiveFromClient(int msg_type,
                                 int client_id,
                                 const std::string& msg);
+  // global shuffle of one thread with per destination send buffers, used
+  // when FLAGS_dataset_global_shuffle_buffer_bytes is positive
+  void BufferedGlobalShuffle(
+      const std::function<size_t(const Record&)>& get_client_id);
 };
 class SlotRecordDataset : public DatasetImpl<SlotRecord> {
  public:
@@ -40,6 +40,10 @@ void CheckOpHasNanOrInf(const framework::OperatorBase& op,
                         const framework::Scope& scope,
                         const phi::Place& place);
 
+// Reads back the flags of the checks done with FLAGS_check_nan_inf_lazy on
+// all the devices, and reports the ops and vars holding NAN or INF.
+void FlushLazyNanInfCheck();
+
 template <typename VarType>
 void CheckOpHasNanOrInfInDygraph(const std::string& op_type,
                                  const imperative::NameVarMap<VarType>& op_outs,
@@ -14,6 +14,9 @@
 
 #include "paddle/fluid/framework/details/nan_inf_utils_detail.h"
 
+#include <map>
+#include <mutex>
+
 #include "paddle/fluid/framework/details/nan_inf_utils.h"
 #include "paddle/fluid/framework/op_proto_maker.h"
 #include "paddle/fluid/framework/scope.h"
@@ -21,7 +24,12 @@
 
 #include "paddle/common/flags.h"
 #include "paddle/fluid/framework/convert_utils.h"
+#include "paddle/phi/common/memory_utils.h"
 #include "paddle/phi/kernels/funcs/eigen/extensions.h"
+#include "paddle/utils/string/string_helper.h"
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+#include "paddle/phi/backends/gpu/gpu_info.h"
+#endif
 
 namespace paddle::framework::details {
 struct DebugTools {
@@ -50,6 +58,96 @@ void SetNanInfStackLimit(const int& stack_limit) {
 
 int GetNanInfStackLimit() { return debug_nan_inf.stack_limit; }
 
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+// The tensors checked lazily on one device since the last flush, the i-th
+// of which sets the i-th flag.
+struct LazyNanInfChecks {
+  const phi::GPUContext* ctx = nullptr;
+  phi::Allocator::AllocationPtr flags;
+  std::vector<std::string> names;
+};
+
+// The checks are flushed early once a device has so many of them.
+static constexpr size_t kMaxLazyNanInfChecks = 65536;
+static std::mutex lazy_nan_inf_mutex;
+static std::map<int, LazyNanInfChecks> lazy_nan_inf_checks;
+
+// Holds lazy_nan_inf_mutex.
+static void ReadLazyNanInfChecks(LazyNanInfChecks* checks,
+                                 std::vector<std::string>* found) {
+  size_t num = checks->names.size();
+  if (num == 0) return;
+  std::vector<int> flags(num);
+  phi::memory_utils::Copy(phi::CPUPlace(),
+                          flags.data(),
+                          checks->ctx->GetPlace(),
+                          checks->flags->ptr(),
+                          num * sizeof(int),
+                          checks->ctx->stream());
+  checks->ctx->Wait();
+  for (size_t i = 0; i < num; ++i) {
+    if (flags[i] != 0) {
+      found->push_back(checks->names[i]);
+    }
+  }
+  phi::backends::gpu::GpuMemsetAsync(
+      checks->flags->ptr(), 0, num * sizeof(int), checks->ctx->stream());
+  checks->names.clear();
+}
+
+static void ReportLazyNanInfChecks(const std::vector<std::string>& found) {
+  if (found.empty()) return;
+  std::string names = paddle::string::join_strings(found, ", ");
+  if (FLAGS_check_nan_inf_level == 0) {
+    PADDLE_THROW(common::errors::PreconditionNotMet(
+        "There are NAN or INF in the outputs [%s]. Please rerun with "
+        "FLAGS_check_nan_inf_lazy=false to print the details of them.",
+        names));
+  }
+  LOG(WARNING) << "There are NAN or INF in the outputs [" << names << "].";
+}
+
+int* RecordLazyNanInfCheck(const std::string& op_type,
+                           const std::string& var_name,
+                           const phi::GPUContext& ctx) {
+  std::vector<std::string> found;
+  int* flag = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(lazy_nan_inf_mutex);
+    auto& checks = lazy_nan_inf_checks[ctx.GetPlace().GetDeviceId()];
+    if (checks.flags == nullptr) {
+      checks.ctx = &ctx;
+      checks.flags = phi::memory_utils::Alloc(
+          ctx.GetPlace(), kMaxLazyNanInfChecks * sizeof(int));
+      phi::backends::gpu::GpuMemsetAsync(checks.flags->ptr(),
+                                         0,
+                                         kMaxLazyNanInfChecks * sizeof(int),
+                                         ctx.stream());
+    }
+    if (checks.names.size() == kMaxLazyNanInfChecks) {
+      ReadLazyNanInfChecks(&checks, &found);
+    }
+    flag = reinterpret_cast<int*>(checks.flags->ptr()) + checks.names.size();
+    checks.names.push_back(op_type + ":" + var_name);
+  }
+  ReportLazyNanInfChecks(found);
+  return flag;
+}
+#endif
+
+void FlushLazyNanInfCheck() {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  std::vector<std::string> found;
+  {
+    std::lock_guard<std::mutex> guard(lazy_nan_inf_mutex);
+    for (auto& item : lazy_nan_inf_checks) {
+      ReadLazyNanInfChecks(&item.second, &found);
+    }
+  }
+  ReportLazyNanInfChecks(found);
+#endif
+}
+
 static std::once_flag white_list_init_flag;
 
 static int op_role_nan_inf_white_list = 0;
@@ -24,6 +24,7 @@
 #include "paddle/phi/kernels/funcs/eigen/extensions.h"
 
 COMMON_DECLARE_int32(check_nan_inf_level);
+COMMON_DECLARE_bool(check_nan_inf_lazy);
 
 namespace paddle {
 namespace framework {
@@ -37,6 +38,14 @@ void SetNanInfStackLimit(const int& stack_limit);
 
 int GetNanInfStackLimit();
 
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+// Records a tensor checked by FLAGS_check_nan_inf_lazy, and returns its flag
+// on the device.
+int* RecordLazyNanInfCheck(const std::string& op_type,
+                           const std::string& var_name,
+                           const phi::GPUContext& ctx);
+#endif
+
 template <typename Context>
 struct TensorCheckerVisitor {
   TensorCheckerVisitor(const std::string& o,
@@ -60,6 +69,20 @@ struct TensorCheckerVisitor {
     auto* dev_ctx = reinterpret_cast<Context*>(
         phi::DeviceContextPool::Instance().Get(tensor.place()));
 
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    if constexpr (std::is_same<Context, phi::GPUContext>::value &&
+                  (std::is_same<T, float>::value ||
+                   std::is_same<T, double>::value ||
+                   std::is_same<T, ::phi::dtype::float16>::value ||
+                   std::is_same<T, ::phi::dtype::bfloat16>::value)) {
+      if (FLAGS_check_nan_inf_lazy) {
+        int* flag = RecordLazyNanInfCheck(op_type, var_name, *dev_ctx);
+        phi::MarkNanInf<T, Context>(*dev_ctx, tensor, flag);
+        return;
+      }
+    }
+#endif
+
     phi::DenseTensor stats;
     phi::DenseTensor values;
     auto file_path = GetNanPath();
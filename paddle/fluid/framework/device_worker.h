@@ -15,6 +15,8 @@ limitations under the License. */
 #pragma once
 
 #include <atomic>
+#include <chrono>  // NOLINT
+#include <deque>
 #include <fstream>
 #include <map>
 #include <memory>
@@ -744,6 +746,7 @@ class SectionWorker : public DeviceWorker {
   void SetPipelineStageNum(int num) { num_pipeline_stages_ = num; }
   void SetPipelineStage(int stage) { pipeline_stage_ = stage; }
   void SetScheduleMode(int mode) { schedule_mode_ = mode; }
+  void SetModelChunkNum(int num) { num_model_chunks_ = num; }
   void SetMicrobatchScopes(const std::vector<Scope*>& scope) {
     microbatch_scopes_ = scope;
   }
@@ -764,6 +767,7 @@ class SectionWorker : public DeviceWorker {
       std::unordered_map<const OperatorBase*, std::vector<std::string>>&);
   void RunFThenB(std::unique_ptr<GarbageCollector>&);
   void Run1F1B(std::unique_ptr<GarbageCollector>&);
+  void RunInterleaved1F1B(std::unique_ptr<GarbageCollector>&);
 
  protected:
   int section_id_;
@@ -771,7 +775,10 @@ class SectionWorker : public DeviceWorker {
   int num_microbatches_;
   int num_pipeline_stages_;
   int pipeline_stage_;
-  int schedule_mode_;  // 0 for F-then-B and 1 for 1F1B
+  // 0 for F-then-B, 1 for 1F1B and 2 for interleaved 1F1B
+  int schedule_mode_;
+  // the model chunks, i.e. the virtual stages, of the interleaved 1F1B
+  int num_model_chunks_ = 1;
   std::vector<Scope*> microbatch_scopes_;
   const Scope* minibatch_scope_;
 
@@ -784,6 +791,10 @@ class SectionWorker : public DeviceWorker {
   std::vector<OperatorBase*> forward_ops_;
   std::vector<OperatorBase*> backward_ops_;
   std::vector<OperatorBase*> optimizer_ops_;
+  // the forward and backward ops of each model chunk, by their chunk_id attr
+  std::vector<std::vector<OperatorBase*>> chunk_forward_and_lr_ops_;
+  std::vector<std::vector<OperatorBase*>> chunk_forward_ops_;
+  std::vector<std::vector<OperatorBase*>> chunk_backward_ops_;
   std::shared_ptr<framework::ProgramDesc> program_;
   std::unordered_map<const OperatorBase*, std::vector<std::string>>
       unused_vars_;
@@ -840,6 +851,10 @@ class HeterSectionWorker : public DeviceWorker {
   void RunBackward(int micro_id);
   void RunListen();
   void MiniBatchBarrier();
+  // Keeps a window of micro-batches of the first stage in flight, and runs
+  // the backward of one of them once it comes back.
+  void RunInFlightWindow();
+  void UpdatePipelineDepth(double local_seconds, double remote_seconds);
   void Run();
   void BatchPostProcess();
   void SetDebug(bool debug) { debug_ = debug; }
@@ -880,6 +895,14 @@ class HeterSectionWorker : public DeviceWorker {
   platform::Timer timeline_;
   double total_time_ = 0.0;
   double read_time_ = 0.0;
+  // The micro-batches in flight of the first stage, and the moving averages
+  // of the seconds of a micro-batch in this stage and in the later stages.
+  int pipeline_depth_ = 0;
+  std::deque<int> free_micro_ids_;
+  std::vector<double> micro_forward_seconds_;
+  std::vector<std::chrono::steady_clock::time_point> micro_send_time_;
+  double local_latency_ = 0.0;
+  double remote_latency_ = 0.0;
 };
 #endif
 
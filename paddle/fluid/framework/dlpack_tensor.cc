@@ -17,6 +17,11 @@
 #include "paddle/fluid/framework/data_type.h"
 #include "paddle/phi/common/place.h"
 #include "paddle/phi/core/utils/visit_place.h"
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/backends/gpu/gpu_info.h"
+#include "paddle/phi/core/platform/device_context.h"
+#endif
 
 namespace paddle {
 namespace framework {
@@ -181,6 +186,62 @@ DLManagedTensor *toDLPack(const phi::DenseTensor &src) {
   return &(pdDLMTensor->tensor);
 }
 
+void DLPackStreamWait(const phi::DenseTensor &src,
+                      int64_t consumer_stream,
+                      int64_t producer_stream) {
+  if (consumer_stream == -1 ||
+      src.place().GetType() != phi::AllocationType::GPU) {
+    return;
+  }
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  gpuStream_t producer =
+      producer_stream != 0
+          ? reinterpret_cast<gpuStream_t>(producer_stream)  // NOLINT
+          : static_cast<phi::GPUContext *>(
+                phi::DeviceContextPool::Instance().Get(src.place()))
+                ->stream();
+  gpuStream_t consumer = nullptr;
+#ifdef PADDLE_WITH_HIP
+  consumer = reinterpret_cast<gpuStream_t>(consumer_stream);  // NOLINT
+#else
+  PADDLE_ENFORCE_NE(consumer_stream,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The stream 0 is ambiguous for CUDA in the DLPack "
+                        "protocol, use 1 for the legacy default stream or 2 "
+                        "for the per-thread default stream."));
+  if (consumer_stream == 1) {
+    consumer = cudaStreamLegacy;
+  } else if (consumer_stream == 2) {
+    consumer = cudaStreamPerThread;
+  } else {
+    consumer = reinterpret_cast<gpuStream_t>(consumer_stream);  // NOLINT
+  }
+#endif
+  if (consumer == producer) {
+    return;
+  }
+
+  // producer-->event-->consumer, the event can be destroyed once the wait is
+  // queued since the consumer keeps the recorded work.
+  phi::backends::gpu::GPUDeviceGuard guard(src.place().GetDeviceId());
+  gpuEvent_t event = nullptr;
+#ifdef PADDLE_WITH_HIP
+  PADDLE_ENFORCE_GPU_SUCCESS(
+      hipEventCreateWithFlags(&event, hipEventDisableTiming));
+  PADDLE_ENFORCE_GPU_SUCCESS(hipEventRecord(event, producer));
+  PADDLE_ENFORCE_GPU_SUCCESS(hipStreamWaitEvent(consumer, event, 0));
+  PADDLE_ENFORCE_GPU_SUCCESS(hipEventDestroy(event));
+#else
+  PADDLE_ENFORCE_GPU_SUCCESS(
+      cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaEventRecord(event, producer));
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamWaitEvent(consumer, event, 0));
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaEventDestroy(event));
+#endif
+#endif
+}
+
 DLPackTensor::DLPackTensor(const phi::DenseTensor &tensor, LaneType lanes)
     : t_{}, shape_{} {
   // init data, data buffer
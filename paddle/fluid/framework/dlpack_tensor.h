@@ -47,5 +47,15 @@ class DLPackTensor {
 
 DLManagedTensor* toDLPack(const phi::DenseTensor& src);
 
+// Orders the consumer stream of the DLPack stream exchange after the work
+// queued on the producer stream of src with an event, so the consumer needs
+// no device synchronization. The consumer stream follows the __dlpack__
+// protocol: -1 skips the ordering, 1 and 2 are the legacy and per-thread
+// default streams of CUDA, and the other values are the stream pointers.
+// The producer stream 0 is the stream of the device context of src.
+TEST_API void DLPackStreamWait(const phi::DenseTensor& src,
+                               int64_t consumer_stream,
+                               int64_t producer_stream = 0);
+
 }  // namespace framework
 }  // namespace paddle
@@ -64,6 +64,11 @@ class InterpreterCoreInfo {
     std::shared_ptr<InterpreterCore> core_{nullptr};
     std::set<std::string> skip_eager_delete_vars_;
     std::unique_ptr<::pir::Program> ir_prog_{nullptr};
+    // The variables of the inputs and outputs of run_program in
+    // value_vars_scope_, keyed by the attribute holding their values, so
+    // that the cached runs bind the eager tensors without looking up names.
+    const Scope* value_vars_scope_{nullptr};
+    std::unordered_map<std::string, std::vector<Variable*>> value_vars_;
   };
 
   bool IsAvailable(bool is_grad) {
@@ -27,6 +27,8 @@ limitations under the License. */
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>              // NOLINT
+#include <condition_variable>  // NOLINT
 #include <ctime>
 #include <deque>
 #include <map>
@@ -34,6 +36,8 @@ limitations under the License. */
 #include <mutex>  // NOLINT
 #include <set>
 #include <string>
+#include <thread>  // NOLINT
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -140,11 +144,27 @@ class BasicAucCalculator {
   std::mutex _table_mutex;
 };
 
+// The bytes read from AFS, the seconds spent in the AFS reads, and the
+// seconds the consumer waited for the readahead.
+struct AfsReadStats {
+  double bytes = 0;
+  double read_seconds = 0;
+  double stall_seconds = 0;
+};
+
 class AfsStreamFile {
  public:
   explicit AfsStreamFile(afs::AfsFileSystem* afsfile)
       : afsfile_(afsfile), reader_(nullptr) {}
   virtual ~AfsStreamFile() {
+    if (readahead_thread_.joinable()) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+      }
+      cond_.notify_all();
+      readahead_thread_.join();
+    }
     if (reader_ != NULL) {
       afsfile_->CloseReader(reader_);
       reader_ = NULL;
@@ -161,14 +181,113 @@ class AfsStreamFile {
                           "OpenReader for file[%s] failed.", path));
     return 0;
   }
+  // Reads the stream on a thread into two buffers of buffer_size bytes, so
+  // that the next AFS read overlaps the consumption of the last one.
+  void StartReadahead(int buffer_size) {
+    if (readahead_thread_.joinable()) {
+      return;
+    }
+    for (auto& buffer : buffers_) {
+      buffer.data.resize(buffer_size);
+    }
+    readahead_thread_ = std::thread([this]() { ReadaheadLoop(); });
+  }
   virtual int Read(char* buf, int len) {
-    int ret = reader_->Read(buf, len);
-    return ret;
+    if (!readahead_thread_.joinable()) {
+      auto begin = std::chrono::steady_clock::now();
+      int ret = reader_->Read(buf, len);
+      stats_.read_seconds += SecondsSince(begin);
+      stats_.bytes += ret > 0 ? ret : 0;
+      return ret;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (num_ready_ == 0 && !eof_) {
+      auto begin = std::chrono::steady_clock::now();
+      cond_.wait(lock, [this] { return num_ready_ > 0 || eof_; });
+      stats_.stall_seconds += SecondsSince(begin);
+    }
+    if (num_ready_ == 0) {
+      return last_ret_;
+    }
+    Buffer& buffer = buffers_[read_index_];
+    int size = std::min(len, buffer.size - buffer.offset);
+    memcpy(buf, buffer.data.data() + buffer.offset, size);
+    buffer.offset += size;
+    if (buffer.offset == buffer.size) {
+      read_index_ ^= 1;
+      --num_ready_;
+      cond_.notify_all();
+    }
+    return size;
+  }
+  AfsReadStats GetStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
   }
 
  private:
+  struct Buffer {
+    std::vector<char> data;
+    int size = 0;
+    int offset = 0;
+  };
+
+  static double SecondsSince(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         begin)
+        .count();
+  }
+
+  void ReadaheadLoop() {
+    int write_index = 0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this] { return num_ready_ < 2 || stop_; });
+        if (stop_) {
+          return;
+        }
+      }
+      // Only this thread touches the buffer which is not ready.
+      Buffer& buffer = buffers_[write_index];
+      auto begin = std::chrono::steady_clock::now();
+      int ret = reader_->Read(buffer.data.data(),
+                              static_cast<int>(buffer.data.size()));
+      double seconds = SecondsSince(begin);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.read_seconds += seconds;
+        if (ret <= 0) {
+          eof_ = true;
+          last_ret_ = ret;
+        } else {
+          stats_.bytes += ret;
+          buffer.size = ret;
+          buffer.offset = 0;
+          ++num_ready_;
+        }
+      }
+      cond_.notify_all();
+      if (ret <= 0) {
+        return;
+      }
+      write_index ^= 1;
+    }
+  }
+
   afs::AfsFileSystem* afsfile_;
   afs::Reader* reader_;
+
+  std::thread readahead_thread_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  Buffer buffers_[2];
+  int read_index_ = 0;
+  int num_ready_ = 0;
+  int last_ret_ = 0;
+  bool eof_ = false;
+  bool stop_ = false;
+  AfsReadStats stats_;
 };
 
 class AfsManager {
@@ -203,15 +322,65 @@ class AfsManager {
       _afshandler = nullptr;
     }
   }
-  static void ReadFromAfs(const std::string& path,
-                          FILE* wfp,
-                          afs::AfsFileSystem* _afshandler) {
-    AfsStreamFile* read_stream = new AfsStreamFile(_afshandler);
-    int ret = read_stream->Open(path.c_str());
-    PADDLE_ENFORCE_EQ(ret,
-                      0,
-                      common::errors::PreconditionNotMet(
-                          "Called AFSAPI Open file %s Failed.", path.c_str()));
+  // Opens the files on a thread and starts their readahead, e.g. for the
+  // files of the next pass while the current pass is still trained. GetFile
+  // takes the opened streams.
+  void PreOpen(const std::vector<std::string>& paths) {
+    std::vector<std::string> filenames;
+    {
+      std::lock_guard<std::mutex> lock(preopen_mutex_);
+      for (auto& path : paths) {
+        std::string filename = AfsFileName(path);
+        if (preopened_.count(filename) == 0 &&
+            preopening_.insert(filename).second) {
+          filenames.push_back(filename);
+        }
+      }
+    }
+    std::thread preopen_thread([this, filenames]() {
+      for (auto& filename : filenames) {
+        std::unique_ptr<AfsStreamFile> stream(new AfsStreamFile(_afshandler));
+        bool opened = false;
+        try {
+          opened = stream->Open(filename.c_str()) == 0;
+        } catch (const std::exception& e) {
+          // GetFile opens it again and reports the error.
+          LOG(WARNING) << "Pre-open " << filename << " failed: " << e.what();
+        }
+        if (opened) {
+          stream->StartReadahead(BUF_SIZE);
+        } else {
+          stream.reset();
+        }
+        {
+          std::lock_guard<std::mutex> lock(preopen_mutex_);
+          preopening_.erase(filename);
+          if (stream) {
+            preopened_[filename] = std::move(stream);
+          }
+        }
+        preopen_cond_.notify_all();
+      }
+    });
+    preopen_thread.detach();
+  }
+  // The read stats of all the streams finished so far.
+  AfsReadStats GetReadStats() {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return read_stats_;
+  }
+  void ReadFromAfs(const std::string& path, FILE* wfp) {
+    std::unique_ptr<AfsStreamFile> read_stream = TakePreopened(path);
+    if (!read_stream) {
+      read_stream.reset(new AfsStreamFile(_afshandler));
+      int ret = read_stream->Open(path.c_str());
+      PADDLE_ENFORCE_EQ(ret,
+                        0,
+                        common::errors::PreconditionNotMet(
+                            "Called AFSAPI Open file %s Failed.",
+                            path.c_str()));
+      read_stream->StartReadahead(BUF_SIZE);
+    }
     char* _buff = static_cast<char*>(calloc(BUF_SIZE + 2, sizeof(char)));
     int size = 0;
     while ((size = read_stream->Read(_buff, BUF_SIZE)) > 0) {
@@ -219,8 +388,16 @@ class AfsManager {
     }
     fflush(wfp);
     fclose(wfp);
-    delete _buff;
-    delete read_stream;
+    free(_buff);
+
+    AfsReadStats stats = read_stream->GetStats();
+    VLOG(3) << "Read " << path << ": " << stats.bytes << " bytes, "
+            << (stats.read_seconds > 0 ? stats.bytes / stats.read_seconds : 0)
+            << " bytes/s, stalled " << stats.stall_seconds << "s";
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    read_stats_.bytes += stats.bytes;
+    read_stats_.read_seconds += stats.read_seconds;
+    read_stats_.stall_seconds += stats.stall_seconds;
   }
   int PopenBidirectionalInternal(const char* command,
                                  FILE*& fp_read,   // NOLINT
@@ -323,12 +500,8 @@ class AfsManager {
                       0,
                       common::errors::PreconditionNotMet(
                           "Called PopenBidirectionalInternal Failed"));
-    std::string filename(path);
-    if (strncmp(filename.c_str(), "afs:", 4) == 0) {
-      filename = filename.substr(4);
-    }
     std::thread read_thread(
-        &AfsManager::ReadFromAfs, filename, wfp, _afshandler);
+        &AfsManager::ReadFromAfs, this, AfsFileName(path), wfp);
     read_thread.detach();
     return {rfp, [pid, cmd](FILE* rfp) {
               int wstatus = -1;
@@ -353,8 +526,34 @@ class AfsManager {
   }
 
  private:
+  static std::string AfsFileName(const std::string& path) {
+    if (strncmp(path.c_str(), "afs:", 4) == 0) {
+      return path.substr(4);
+    }
+    return path;
+  }
+  // Waits for the pre-opening of the file if it is in flight.
+  std::unique_ptr<AfsStreamFile> TakePreopened(const std::string& filename) {
+    std::unique_lock<std::mutex> lock(preopen_mutex_);
+    preopen_cond_.wait(
+        lock, [&] { return preopening_.count(filename) == 0; });
+    auto it = preopened_.find(filename);
+    if (it == preopened_.end()) {
+      return nullptr;
+    }
+    std::unique_ptr<AfsStreamFile> stream = std::move(it->second);
+    preopened_.erase(it);
+    return stream;
+  }
+
   afs::AfsFileSystem* _afshandler;
   std::mutex g_flock;
+  std::mutex preopen_mutex_;
+  std::condition_variable preopen_cond_;
+  std::unordered_set<std::string> preopening_;
+  std::unordered_map<std::string, std::unique_ptr<AfsStreamFile>> preopened_;
+  std::mutex stats_mutex_;
+  AfsReadStats read_stats_;
 };
 
 class BoxWrapper {
@@ -547,6 +746,27 @@ class BoxWrapper {
 
   bool UseAfsApi() const { return use_afs_api_; }
 
+  // Opens the AFS files, e.g. of the next pass, ahead of their loading.
+  void PreOpenAfsFiles(const std::vector<std::string>& paths) {
+    if (use_afs_api_) {
+      afs_manager->PreOpen(paths);
+    }
+  }
+
+  std::map<std::string, double> GetAfsReadStats() const {
+    std::map<std::string, double> ret;
+    if (!use_afs_api_) {
+      return ret;
+    }
+    AfsReadStats stats = afs_manager->GetReadStats();
+    ret["bytes"] = stats.bytes;
+    ret["read_seconds"] = stats.read_seconds;
+    ret["stall_seconds"] = stats.stall_seconds;
+    ret["bytes_per_second"] =
+        stats.read_seconds > 0 ? stats.bytes / stats.read_seconds : 0;
+    return ret;
+  }
+
   const std::unordered_set<std::string>& GetOmittedSlot() const {
     return slot_name_omitted_in_feedpass_;
   }
@@ -20,6 +20,7 @@ limitations under the License. */
 
 #include <algorithm>
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -106,6 +107,12 @@ class HeterContext {
   void* sub_graph_float_feas = NULL;
   uint32_t shard_num_ = 37;
   uint16_t pass_id_ = 0;
+  // whether the keys are already divided to the devices by the build thread
+  bool divided_ = false;
+  // the values of device_dim_ptr_ filled by the build thread, and the sorted
+  // indices of the values which are dumped by an unended pass after that
+  std::vector<std::vector<std::shared_ptr<char>>> prefill_values_;
+  std::vector<std::vector<std::vector<size_t>>> prefill_dirty_;
   uint64_t size() {
     uint64_t total_size = 0;
     for (auto& keys : feature_keys_) {
@@ -152,6 +159,9 @@ class HeterContext {
   }
 
   void Reset() {
+    divided_ = false;
+    prefill_values_.clear();
+    prefill_dirty_.clear();
     if (!multi_mf_dim_) {
       for (size_t i = 0; i < feature_keys_.size(); ++i) {
         feature_keys_[i].clear();
@@ -277,6 +277,14 @@ class GpuPsGraphTable
                              const uint64_t *d_nodes,
                              uint32_t *d_ranks,
                              int node_len);
+  // The ranks of the nodes of the hard split, (node / gpu_num) % node_num,
+  // computed on the device.
+  void get_shard_rank_of_nodes(int gpu_id,
+                               const uint64_t *d_nodes,
+                               uint32_t *d_ranks,
+                               int node_len,
+                               int node_num,
+                               const cudaStream_t &stream);
 
   NodeQueryResult query_node_list(int gpu_id,
                                   int idx,
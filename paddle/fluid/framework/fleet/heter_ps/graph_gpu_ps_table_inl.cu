@@ -4106,6 +4106,20 @@ int GpuPsGraphTable::get_rank_info_of_nodes(int gpu_id,
   return 0;
 }
 
+void GpuPsGraphTable::get_shard_rank_of_nodes(int gpu_id,
+                                              const uint64_t* d_nodes,
+                                              uint32_t* d_ranks,
+                                              int node_len,
+                                              int node_num,
+                                              const cudaStream_t& stream) {
+  if (node_len == 0) {
+    return;
+  }
+  platform::CUDADeviceGuard guard(resource_->dev_id(gpu_id));
+  heter_comm_kernel_->calc_node_shard_index(
+      d_nodes, node_len, d_ranks, gpu_num, node_num, stream);
+}
+
 int GpuPsGraphTable::get_float_feature_info_of_nodes(
     int gpu_id,
     uint64_t* d_nodes,
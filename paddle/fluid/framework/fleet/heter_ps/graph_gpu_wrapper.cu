@@ -1049,13 +1049,19 @@ void GraphGpuWrapper::seek_keys_rank(int gpu_id,
   phi::GPUPlace place = phi::GPUPlace(gpu_id);
   auto stream = get_local_stream(gpu_id);
 
+  GpuPsGraphTable *g = reinterpret_cast<GpuPsGraphTable *>(graph_table);
   if (FLAGS_graph_edges_split_mode == "fennel") {
     if (FLAGS_multi_node_sample_use_gpu_table) {
       // fennel下，FLAGS_multi_node_sample_use_gpu_table为True
-      GpuPsGraphTable *g = reinterpret_cast<GpuPsGraphTable *>(graph_table);
       g->get_rank_info_of_nodes(gpu_id, d_in_keys, d_out_ranks, len);
       return;
     }
+  } else {
+    // 硬拆下，在gpu上取余得到，免去keys在host上的来回拷贝
+    g->get_shard_rank_of_nodes(
+        gpu_id, d_in_keys, d_out_ranks, len, node_size_, stream);
+    CUDA_CHECK(cudaStreamSynchronize(stream));
+    return;
   }
 
   std::vector<uint64_t> h_keys(len);
@@ -1067,21 +1073,8 @@ void GraphGpuWrapper::seek_keys_rank(int gpu_id,
                              stream));
   CUDA_CHECK(cudaStreamSynchronize(stream));
 
-  if (FLAGS_graph_edges_split_mode == "fennel") {
-    // fennel下，但 FLAGS_multi_node_sample_use_gpu_table为False
-    reinterpret_cast<GpuPsGraphTable *>(graph_table)
-        ->cpu_graph_table_->query_all_ids_rank(
-            len, h_keys.data(), h_ranks.data());
-  } else {
-    // 硬拆下，cpu上进行取余得到
-    auto gpu_num =
-        reinterpret_cast<GpuPsGraphTable *>(graph_table)->get_device_num();
-    for (size_t i = 0; i < len; ++i) {
-      bool hit = false;
-      auto &k = h_keys[i];
-      h_ranks[i] = (k / gpu_num) % node_size_;
-    }
-  }
+  // fennel下，但 FLAGS_multi_node_sample_use_gpu_table为False
+  g->cpu_graph_table_->query_all_ids_rank(len, h_keys.data(), h_ranks.data());
 
   CUDA_CHECK(cudaMemcpyAsync(d_out_ranks,
                              h_ranks.data(),
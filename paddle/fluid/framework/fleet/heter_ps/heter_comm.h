@@ -183,14 +183,45 @@ class HeterComm {
 
 #endif
 
+  // Whether the data from send_id to receive_id is relayed by the transfer
+  // device of send_id. The routing table is built by init_topo() from the
+  // detected peer links, the two groups of four devices are assumed when it
+  // is not available.
   bool need_transfer(int send_id, int receive_id) {
+    if (!transfer_devid_.empty()) {
+      return need_transfer_[send_id][receive_id];
+    }
     return ((send_id / 4 != receive_id / 4) &&
             (send_id + 4) % device_num_ != receive_id);
   }
 
   // void dump_to_cpu(int index);
 
-  int get_transfer_devid(int send_id) { return (send_id + 4) % device_num_; }
+  int get_transfer_devid(int send_id) {
+    if (!transfer_devid_.empty()) {
+      return transfer_devid_[send_id];
+    }
+    return (send_id + 4) % device_num_;
+  }
+
+  // whether any device relays the data of its partner
+  bool has_transfer_dev() {
+    if (transfer_devid_.empty()) {
+      return device_num_ > 4;
+    }
+    for (size_t i = 0; i < transfer_devid_.size(); ++i) {
+      if (transfer_devid_[i] != -1 &&
+          transfer_devid_[i] != static_cast<int>(i)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // the bytes of keys and values sent on path_[i][j] by walk_to_dest
+  const std::vector<std::vector<uint64_t>>& path_bytes() const {
+    return path_bytes_;
+  }
 
   void end_pass();
 #if defined(PADDLE_WITH_CUDA)
@@ -454,6 +485,7 @@ class HeterComm {
   };
 
   void init_path();
+  void init_topo();
 
   template <typename StreamType>
   void sync_stream(const StreamType& stream) {
@@ -777,6 +809,10 @@ class HeterComm {
   std::vector<PtrTable*> ptr_tables_;
   std::shared_ptr<HeterPsResource> resource_;
   std::vector<std::vector<Path>> path_;
+  std::vector<std::vector<uint64_t>> path_bytes_;
+  // routing table indexed by device id, empty if the topology is unknown
+  std::vector<int> transfer_devid_;
+  std::vector<std::vector<bool>> need_transfer_;
   float load_factor_{0.75};
   int block_size_{256};
   std::unique_ptr<HeterCommKernel> heter_comm_kernel_;
@@ -14,8 +14,10 @@ limitations under the License. */
 #pragma once
 #ifdef PADDLE_WITH_HETERPS
 #include <algorithm>
+#include <climits>
 #include <memory>
 #include <queue>
+#include <string>
 #include <utility>
 #include <vector>
 #include "paddle/fluid/framework/fleet/heter_ps/feature_value.h"
@@ -204,6 +206,97 @@ HeterComm<KeyType, ValType, GradType, GPUAccessor>::HeterComm(
   init_path();
 }
 
+template <typename KeyType,
+          typename ValType,
+          typename GradType,
+          typename GPUAccessor>
+void HeterComm<KeyType, ValType, GradType, GPUAccessor>::init_topo() {
+#if defined(PADDLE_WITH_CUDA)
+  // A pair of devices is directly connected when peer access is supported
+  // and its performance rank is the best one of the sender, e.g. NVLink or
+  // NVSwitch instead of PCIe.
+  int total_device = resource_->total_device();
+  int max_dev_id = 0;
+  for (int i = 0; i < total_device; ++i) {
+    max_dev_id = std::max(max_dev_id, resource_->dev_id(i));
+  }
+  std::vector<std::vector<bool>> direct(max_dev_id + 1,
+                                        std::vector<bool>(max_dev_id + 1));
+  for (int i = 0; i < total_device; ++i) {
+    int from = resource_->dev_id(i);
+    std::vector<int> ranks(total_device, -1);
+    int best_rank = INT_MAX;
+    for (int j = 0; j < total_device; ++j) {
+      int to = resource_->dev_id(j);
+      if (from == to) {
+        continue;
+      }
+      int can_access = 0;
+      PADDLE_ENFORCE_GPU_SUCCESS(
+          cudaDeviceCanAccessPeer(&can_access, from, to));
+      if (!can_access) {
+        continue;
+      }
+      PADDLE_ENFORCE_GPU_SUCCESS(cudaDeviceGetP2PAttribute(
+          &ranks[j], cudaDevP2PAttrPerformanceRank, from, to));
+      best_rank = std::min(best_rank, ranks[j]);
+    }
+    direct[from][from] = true;
+    for (int j = 0; j < total_device; ++j) {
+      direct[from][resource_->dev_id(j)] |= ranks[j] == best_rank;
+    }
+  }
+
+  // Every device relays for exactly one partner, which is what the staging
+  // buffers of the multi node exchange expect. The devices are paired
+  // greedily by the number of slow destinations the partner covers.
+  transfer_devid_.assign(max_dev_id + 1, -1);
+  need_transfer_.assign(max_dev_id + 1, std::vector<bool>(max_dev_id + 1));
+  auto covered = [&](int from, int relay) {
+    int count = 0;
+    for (int j = 0; j < total_device; ++j) {
+      int to = resource_->dev_id(j);
+      count += !direct[from][to] && direct[relay][to];
+    }
+    return count;
+  };
+  for (int i = 0; i < total_device; ++i) {
+    int from = resource_->dev_id(i);
+    if (transfer_devid_[from] != -1) {
+      continue;
+    }
+    int partner = from;
+    int best = 0;
+    for (int j = 0; j < total_device; ++j) {
+      int relay = resource_->dev_id(j);
+      if (relay == from || transfer_devid_[relay] != -1 ||
+          !direct[from][relay] || !direct[relay][from]) {
+        continue;
+      }
+      int count = covered(from, relay) + covered(relay, from);
+      if (count > best) {
+        best = count;
+        partner = relay;
+      }
+    }
+    transfer_devid_[from] = partner;
+    transfer_devid_[partner] = from;
+  }
+  for (int i = 0; i < total_device; ++i) {
+    int from = resource_->dev_id(i);
+    int relay = transfer_devid_[from];
+    for (int j = 0; j < total_device; ++j) {
+      int to = resource_->dev_id(j);
+      need_transfer_[from][to] =
+          !direct[from][to] && relay != to && direct[relay][to];
+      VLOG(1) << "route " << from << " -> " << to << ": "
+              << (need_transfer_[from][to] ? "via " + std::to_string(relay)
+                                           : std::string("direct"));
+    }
+  }
+#endif
+}
+
 template <typename KeyType,
           typename ValType,
           typename GradType,
@@ -211,6 +304,7 @@ template <typename KeyType,
 void HeterComm<KeyType, ValType, GradType, GPUAccessor>::init_path() {
   int total_device = resource_->total_device();
   path_.resize(total_device);
+  path_bytes_.assign(total_device, std::vector<uint64_t>(total_device, 0));
   if (!topo_aware_) {
     VLOG(0) << "init path without topo aware";
     for (int i = 0; i < total_device; ++i) {
@@ -228,6 +322,7 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::init_path() {
     }
   } else {
     VLOG(0) << "init path with topo aware";
+    init_topo();
     for (int i = 0; i < total_device; ++i) {
       path_[i].resize(total_device);
       for (int j = 0; j < total_device; ++j) {
@@ -554,6 +649,8 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::walk_to_dest(
     }
     auto &nodes = path_[start_index][i].nodes_;
     auto &node = nodes[0];
+    path_bytes_[start_index][i] +=
+        node.key_bytes_len + (src_val ? node.val_bytes_len : 0);
     MemcpyPeerAsync(node.key_storage,
                     reinterpret_cast<char *>(src_key + h_left[i]),
                     node.key_bytes_len,
@@ -619,6 +716,8 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::walk_to_dest(
     }
     auto &nodes = path_[start_index][i].nodes_;
     auto &node = nodes[0];
+    path_bytes_[start_index][i] +=
+        node.key_bytes_len + (src_val ? node.val_bytes_len : 0);
     MemcpyPeerAsync(node.key_storage,
                     reinterpret_cast<char *>(src_key + h_left[i]),
                     node.key_bytes_len,
@@ -2704,7 +2803,7 @@ HeterComm<KeyType, ValType, GradType, GPUAccessor>::gather_inner_keys_by_copy(
   size_t trans_need_size =
       std::max(shard_recv_offset, static_cast<size_t>(fea_size));
   int trans_id = -1;
-  if (topo_aware_ && device_num_ > 4) {
+  if (topo_aware_ && has_transfer_dev()) {
     trans_id = get_transfer_devid(gpu_id);
     storage_[trans_id].h_trans_size = max_part_size;
     // barrier wait all set trans length [0-4, 1-5, 3-7, 2-6]
@@ -3279,7 +3378,7 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::
 
   auto &res = my_cache.inner_res;
   int trans_id = -1;
-  if (topo_aware_ && device_num_ > 4) {
+  if (topo_aware_ && has_transfer_dev()) {
     trans_id = get_transfer_devid(gpu_id);
   }
   my_cache.inner_barrier_.Resume();
@@ -3699,7 +3798,7 @@ size_t HeterComm<KeyType, ValType, GradType, GPUAccessor>::
 
   size_t trans_need_size = std::max(shard_recv_offset, push_size);
   int trans_id = -1;
-  if (topo_aware_ && device_num_ > 4) {
+  if (topo_aware_ && has_transfer_dev()) {
     trans_id = get_transfer_devid(gpu_id);
     storage_[trans_id].h_trans_size = max_part_size;
     // barrier wait all set trans length [0-4, 1-5, 3-7, 2-6]
@@ -18,8 +18,11 @@
 #include <memory>
 #include <numeric>
 
+#include "paddle/common/flags.h"
 #include "paddle/fluid/framework/lod_tensor.h"
 
+COMMON_DECLARE_int32(fleet_metric_auc_shards);
+
 #if defined(PADDLE_WITH_PSLIB) || defined(PADDLE_WITH_PSCORE)
 namespace paddle {
 namespace framework {
@@ -33,6 +36,10 @@ void BasicAucCalculator::init(int table_size) {
   for (auto& item : _table) {
     item = std::vector<double>();
   }
+  _shards.clear();
+  for (int i = 0; i < FLAGS_fleet_metric_auc_shards; ++i) {
+    _shards.emplace_back(std::make_unique<AucShard>());
+  }
 
   // reset
   reset();
@@ -46,6 +53,42 @@ void BasicAucCalculator::reset() {
   _local_abserr = 0;
   _local_sqrerr = 0;
   _local_pred = 0;
+  for (auto& shard : _shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    // The shard tables are allocated by their first batch.
+    for (auto& item : shard->table) {
+      item.clear();
+    }
+    shard->abserr = 0;
+    shard->sqrerr = 0;
+    shard->pred = 0;
+  }
+}
+
+BasicAucCalculator::AucShard* BasicAucCalculator::thread_shard() {
+  size_t idx = std::hash<std::thread::id>()(std::this_thread::get_id()) %
+               _shards.size();
+  return _shards[idx].get();
+}
+
+void BasicAucCalculator::merge_shards() {
+  std::lock_guard<std::mutex> table_lock(_table_mutex);
+  for (auto& shard : _shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    if (shard->table[0].empty()) continue;
+    for (int label = 0; label < 2; ++label) {
+      for (int i = 0; i < _table_size; ++i) {
+        _table[label][i] += shard->table[label][i];
+      }
+      shard->table[label].clear();
+    }
+    _local_abserr += shard->abserr;
+    _local_sqrerr += shard->sqrerr;
+    _local_pred += shard->pred;
+    shard->abserr = 0;
+    shard->sqrerr = 0;
+    shard->pred = 0;
+  }
 }
 
 void BasicAucCalculator::add_data(const float* d_pred,
@@ -58,6 +101,24 @@ void BasicAucCalculator::add_data(const float* d_pred,
   h_label.resize(batch_size);
   memcpy(h_pred.data(), d_pred, sizeof(float) * batch_size);
   memcpy(h_label.data(), d_label, sizeof(int64_t) * batch_size);
+  if (!_shards.empty()) {
+    auto* shard = thread_shard();
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    if (shard->table[0].empty()) {
+      for (auto& item : shard->table) {
+        item.assign(_table_size, 0.0);
+      }
+    }
+    for (int i = 0; i < batch_size; ++i) {
+      add_to_table(h_pred[i],
+                   h_label[i],
+                   shard->table,
+                   &shard->abserr,
+                   &shard->sqrerr,
+                   &shard->pred);
+    }
+    return;
+  }
   std::lock_guard<std::mutex> lock(_table_mutex);
   for (int i = 0; i < batch_size; ++i) {
     add_unlock_data(h_pred[i], h_label[i]);
@@ -65,6 +126,16 @@ void BasicAucCalculator::add_data(const float* d_pred,
 }
 
 void BasicAucCalculator::add_unlock_data(double pred, int label) {
+  add_to_table(
+      pred, label, _table, &_local_abserr, &_local_sqrerr, &_local_pred);
+}
+
+void BasicAucCalculator::add_to_table(double pred,
+                                      int label,
+                                      std::vector<double>* table,
+                                      double* abserr,
+                                      double* sqrerr,
+                                      double* local_pred) {
   PADDLE_ENFORCE_GE(
       pred,
       0.0,
@@ -89,10 +160,10 @@ void BasicAucCalculator::add_unlock_data(double pred, int label) {
       _table_size,
       common::errors::PreconditionNotMet(
           "pos must be less than table_size, but its value is: %d", pos));
-  _local_abserr += fabs(pred - label);
-  _local_sqrerr += (pred - label) * (pred - label);
-  _local_pred += pred;
-  ++_table[label][pos];
+  *abserr += fabs(pred - label);
+  *sqrerr += (pred - label) * (pred - label);
+  *local_pred += pred;
+  ++table[label][pos];
 }
 
 // add mask data
@@ -112,6 +183,26 @@ void BasicAucCalculator::add_mask_data(const float* d_pred,
   memcpy(h_label.data(), d_label, sizeof(int64_t) * batch_size);
   memcpy(h_mask.data(), d_mask, sizeof(int64_t) * batch_size);
 
+  if (!_shards.empty()) {
+    auto* shard = thread_shard();
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    if (shard->table[0].empty()) {
+      for (auto& item : shard->table) {
+        item.assign(_table_size, 0.0);
+      }
+    }
+    for (int i = 0; i < batch_size; ++i) {
+      if (h_mask[i]) {
+        add_to_table(h_pred[i],
+                     h_label[i],
+                     shard->table,
+                     &shard->abserr,
+                     &shard->sqrerr,
+                     &shard->pred);
+      }
+    }
+    return;
+  }
   std::lock_guard<std::mutex> lock(_table_mutex);
   for (int i = 0; i < batch_size; ++i) {
     if (h_mask[i]) {
@@ -121,6 +212,7 @@ void BasicAucCalculator::add_mask_data(const float* d_pred,
 }
 
 void BasicAucCalculator::compute() {
+  merge_shards();
 #if defined(PADDLE_WITH_GLOO)
   double area = 0;
   double fp = 0;
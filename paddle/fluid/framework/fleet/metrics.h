@@ -22,6 +22,7 @@ limitations under the License. */
 #include <memory>
 #include <random>
 #include <string>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -104,6 +105,23 @@ class BasicAucCalculator {
 
  private:
   void calculate_bucket_error();
+  // The tables of the adding threads, see FLAGS_fleet_metric_auc_shards.
+  struct AucShard {
+    std::mutex mutex;
+    std::vector<double> table[2];
+    double abserr = 0;
+    double sqrerr = 0;
+    double pred = 0;
+  };
+  AucShard* thread_shard();
+  // Folds the shards into the table.
+  void merge_shards();
+  void add_to_table(double pred,
+                    int label,
+                    std::vector<double>* table,
+                    double* abserr,
+                    double* sqrerr,
+                    double* local_pred);
 
  protected:
   double _local_abserr = 0;
@@ -129,6 +147,7 @@ class BasicAucCalculator {
   static constexpr double kRelativeErrorBound = 0.05;
   static constexpr double kMaxSpan = 0.01;
   std::mutex _table_mutex;
+  std::vector<std::unique_ptr<AucShard>> _shards;
 };
 
 class Metric {
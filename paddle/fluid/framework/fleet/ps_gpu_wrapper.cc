@@ -45,6 +45,8 @@ limitations under the License. */
 #include "paddle/common/flags.h"
 
 COMMON_DECLARE_int32(gpugraph_dedup_pull_push_mode);
+COMMON_DECLARE_bool(gpups_divide_keys_in_build_thread);
+COMMON_DECLARE_int64(gpups_prefill_build_values_mb);
 COMMON_DECLARE_int32(gpugraph_storage_mode);
 COMMON_DECLARE_bool(query_dest_rank_by_multi_node);
 COMMON_DECLARE_string(graph_edges_split_mode);
@@ -1666,6 +1668,114 @@ void PSGPUWrapper::divide_to_device(std::shared_ptr<HeterContext> gpu_task) {
           << " seconds.";
 }
 
+void PSGPUWrapper::BuildFillValue(VirtualAccessor* accessor_wrapper_ptr,
+                                  char* gpu_val,
+                                  void* cpu_val,
+                                  int mf_dim) {
+#ifdef PADDLE_WITH_PSCORE
+  accessor_wrapper_ptr->BuildFill(
+      gpu_val, cpu_val, cpu_table_accessor_, mf_dim);
+#endif
+#ifdef PADDLE_WITH_PSLIB
+  accessor_wrapper_ptr->BuildFill(reinterpret_cast<float*>(gpu_val),
+                                  cpu_val,
+                                  cpu_table_accessor_,
+                                  mf_dim,
+                                  accessor_class_);
+#endif
+}
+
+void PSGPUWrapper::PrefillBuildValues(std::shared_ptr<HeterContext> gpu_task) {
+  int device_num = heter_devices_.size();
+  auto accessor_wrapper_ptr =
+      GlobalAccessorFactory::GetInstance().GetAccessorWrapper();
+  size_t total_bytes = 0;
+  for (int i = 0; i < device_num; i++) {
+    for (int j = 0; j < multi_mf_dim_; j++) {
+      total_bytes += gpu_task->device_dim_ptr_[i][j].size() *
+                     accessor_wrapper_ptr->GetFeatureValueSize(
+                         this->index_dim_vec_[j]);
+    }
+  }
+  size_t budget = static_cast<size_t>(FLAGS_gpups_prefill_build_values_mb)
+                  << 20;
+  if (total_bytes > budget) {
+    VLOG(0) << "passid=" << gpu_task->pass_id_ << ", skip prefill "
+            << total_bytes << " bytes of build values over the budget";
+    return;
+  }
+  platform::Timer timeline;
+  timeline.Start();
+  gpu_task->prefill_values_.assign(
+      device_num, std::vector<std::shared_ptr<char>>(multi_mf_dim_));
+  gpu_task->prefill_dirty_.assign(
+      device_num, std::vector<std::vector<size_t>>(multi_mf_dim_));
+
+  auto find_dirty_func = [this, &gpu_task](int i, int j) {
+    std::unordered_set<const void*> dumped;
+    for (auto& task : unended_tasks_) {
+      auto& ptrs = task->device_dim_ptr_[i][j];
+      dumped.insert(ptrs.begin(), ptrs.end());
+    }
+    if (dumped.empty()) {
+      return;
+    }
+    auto& ptrs = gpu_task->device_dim_ptr_[i][j];
+    auto& dirty = gpu_task->prefill_dirty_[i][j];
+    for (size_t k = 0; k < ptrs.size(); ++k) {
+      if (dumped.count(ptrs[k]) != 0) {
+        dirty.push_back(k);
+      }
+    }
+  };
+
+  auto prefill_func = [this, &gpu_task, &accessor_wrapper_ptr](int i, int j) {
+    auto& ptrs = gpu_task->device_dim_ptr_[i][j];
+    int mf_dim = this->index_dim_vec_[j];
+    size_t feature_value_size =
+        accessor_wrapper_ptr->GetFeatureValueSize(mf_dim);
+    std::shared_ptr<char> values(new char[feature_value_size * ptrs.size()],
+                                 [](char* p) { delete[] p; });
+    for (size_t k = 0; k < ptrs.size(); ++k) {
+      BuildFillValue(accessor_wrapper_ptr,
+                     values.get() + k * feature_value_size,
+                     ptrs[k],
+                     mf_dim);
+    }
+    gpu_task->prefill_values_[i][j] = values;
+  };
+
+  std::vector<std::future<void>> task_futures;
+  {
+    // The passes which are not ended yet dump their values at EndPass, so
+    // the values shared with them are filled again in BuildGPUTask. The
+    // lock keeps these tasks from being reused while they are read.
+    std::lock_guard<std::mutex> lock(pass_mutex_);
+    for (int i = 0; i < device_num; i++) {
+      for (int j = 0; j < multi_mf_dim_; j++) {
+        task_futures.emplace_back(
+            cpu_work_pool_[i]->enqueue(find_dirty_func, i, j));
+      }
+    }
+    for (auto& f : task_futures) {
+      f.wait();
+    }
+  }
+  task_futures.clear();
+  for (int i = 0; i < device_num; i++) {
+    for (int j = 0; j < multi_mf_dim_; j++) {
+      task_futures.emplace_back(cpu_work_pool_[i]->enqueue(prefill_func, i, j));
+    }
+  }
+  for (auto& f : task_futures) {
+    f.wait();
+  }
+  timeline.Pause();
+  VLOG(0) << "passid=" << gpu_task->pass_id_ << ", prefill " << total_bytes
+          << " bytes of build values cost " << timeline.ElapsedSec()
+          << " seconds.";
+}
+
 void PSGPUWrapper::PrepareGPUTask(std::shared_ptr<HeterContext> gpu_task) {
   platform::Timer timeline;
   int device_num = heter_devices_.size();
@@ -1834,34 +1944,40 @@ void PSGPUWrapper::BuildGPUTask(std::shared_ptr<HeterContext> gpu_task) {
             size_t real_len =
                 (len - start) > once_gpu_copy ? once_gpu_copy : (len - start);
             size_t end = start + real_len;
-            std::shared_ptr<char> build_values(
-                new char[feature_value_size * real_len],
-                [](char* p) { delete[] p; });
-            char* test_build_values = build_values.get();
-            for (size_t k = start; k < end; k++) {
-#ifdef PADDLE_WITH_PSCORE
-              void* val = reinterpret_cast<float*>(
-                  test_build_values + (k - start) * feature_value_size);
-              accessor_wrapper_ptr->BuildFill(
-                  val, device_dim_ptrs[k], cpu_table_accessor_, mf_dim);
-#endif
-#ifdef PADDLE_WITH_PSLIB
-              float* val = reinterpret_cast<float*>(
-                  test_build_values + (k - start) * feature_value_size);
-              accessor_wrapper_ptr->BuildFill(val,
-                                              device_dim_ptrs[k],
-                                              cpu_table_accessor_,
-                                              mf_dim,
-                                              accessor_class_);
-#endif
+            std::shared_ptr<char> build_values;
+            size_t build_start = 0;
+            if (!gpu_task->prefill_values_.empty()) {
+              // only the values dumped after the prefill are filled again
+              build_values = gpu_task->prefill_values_[i][j];
+              build_start = start;
+              auto& dirty = gpu_task->prefill_dirty_[i][j];
+              for (auto it =
+                       std::lower_bound(dirty.begin(), dirty.end(), start);
+                   it != dirty.end() && *it < end;
+                   ++it) {
+                BuildFillValue(accessor_wrapper_ptr,
+                               build_values.get() + *it * feature_value_size,
+                               device_dim_ptrs[*it],
+                               mf_dim);
+              }
+            } else {
+              build_values.reset(new char[feature_value_size * real_len],
+                                 [](char* p) { delete[] p; });
+              for (size_t k = start; k < end; k++) {
+                BuildFillValue(
+                    accessor_wrapper_ptr,
+                    build_values.get() + (k - start) * feature_value_size,
+                    device_dim_ptrs[k],
+                    mf_dim);
+              }
             }
             task_info task;
             task.build_values = build_values;
             task.offset = start;
             task.device_id = i;
             task.multi_mf_dim = j;
-            task.start = 0;
-            task.end = static_cast<int>(real_len);
+            task.start = static_cast<int>(build_start);
+            task.end = static_cast<int>(build_start + real_len);
             cpu_reday_channels_[i]->Put(task);
             // step
             start = start + (once_gpu_copy * cpu_device_thread_num_);
@@ -2084,6 +2200,17 @@ void PSGPUWrapper::AddSparseKeys() {
   VLOG(1) << "passid=" << gpu_task->pass_id_
           << ", thread PreBuildTask end, cost time: " << timer.ElapsedSec()
           << " s";
+#ifdef PADDLE_WITH_PSCORE
+  // the table may load the keys of this pass from ssd while the previous
+  // pass is still being pulled, the keys are copied before returning
+  for (int i = 0; i < thread_keys_shard_num_; ++i) {
+    for (int j = 0; j < multi_mf_dim_; ++j) {
+      auto& keys = gpu_task->feature_dim_keys_[i][j];
+      fleet_ptr_->worker_ptr_->PrefetchSparse(
+          i, table_id_, keys.data(), keys.size(), gpu_task->pass_id_);
+    }
+  }
+#endif
   buildcpu_ready_channel_->Put(gpu_task);
 }
 
@@ -2101,6 +2228,21 @@ void PSGPUWrapper::build_pull_thread() {
     }
     // build cpu ps data process
     BuildPull(gpu_task);
+    // MergePull waits for the other nodes in BeginPass, the keys can only be
+    // divided here when it has nothing to merge
+    bool prefill = FLAGS_gpups_prefill_build_values_mb > 0;
+    if ((FLAGS_gpups_divide_keys_in_build_thread || prefill) &&
+        multi_mf_dim_ && !(multi_node_ && gpu_graph_mode_)) {
+      divide_to_device(gpu_task);
+      gpu_task->divided_ = true;
+      if (prefill) {
+        PrefillBuildValues(gpu_task);
+      }
+    }
+    if (prefill) {
+      std::lock_guard<std::mutex> lock(pass_mutex_);
+      unended_tasks_.push_back(gpu_task);
+    }
     timer.Pause();
     VLOG(0) << "passid=" << gpu_task->pass_id_
             << ", thread BuildPull end, cost time: " << timer.ElapsedSec()
@@ -2121,12 +2263,14 @@ void PSGPUWrapper::build_task() {
   VLOG(1) << "passid=" << gpu_task->pass_id_ << ", PrepareGPUTask start.";
   platform::Timer timer;
   timer.Start();
-  // merge pull
-  MergePull(gpu_task);
-  if (multi_mf_dim_) {
-    divide_to_device(gpu_task);
-  } else {
-    PrepareGPUTask(gpu_task);
+  if (!gpu_task->divided_) {
+    // merge pull
+    MergePull(gpu_task);
+    if (multi_mf_dim_) {
+      divide_to_device(gpu_task);
+    } else {
+      PrepareGPUTask(gpu_task);
+    }
   }
   BuildGPUTask(gpu_task);
   timer.Pause();
@@ -2189,6 +2333,15 @@ void PSGPUWrapper::EndPass() {
           << ", EndPass HbmToSparseTable cost time: " << stagetime.ElapsedSec()
           << "s";
 
+  {
+    // the task can not be reused while a prefill reads its values
+    std::lock_guard<std::mutex> lock(pass_mutex_);
+    auto it = std::find(
+        unended_tasks_.begin(), unended_tasks_.end(), current_task_);
+    if (it != unended_tasks_.end()) {
+      unended_tasks_.erase(it);
+    }
+  }
   gpu_task_pool_.Push(current_task_);
   current_task_ = nullptr;
   // fleet_ptr->pslib_ptr_->_worker_ptr->release_table_mutex(this->table_id_);
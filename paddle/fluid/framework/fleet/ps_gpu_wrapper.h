@@ -18,6 +18,7 @@ limitations under the License. */
 #include <stdlib.h>
 #include <atomic>
 #include <ctime>
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -310,6 +311,12 @@ class PSGPUWrapper {
                 int* key2slot);
 
   void divide_to_device(std::shared_ptr<HeterContext> gpu_task);
+  void PrefillBuildValues(std::shared_ptr<HeterContext> gpu_task);
+  // fill the gpu value of a key from its cpu value
+  void BuildFillValue(VirtualAccessor* accessor_wrapper_ptr,
+                      char* gpu_val,
+                      void* cpu_val,
+                      int mf_dim);
   void add_slot_feature(std::shared_ptr<HeterContext> gpu_task);
   void BuildGPUTask(std::shared_ptr<HeterContext> gpu_task);
   void PreBuildTask(std::shared_ptr<HeterContext> gpu_task,
@@ -1194,6 +1201,10 @@ class PSGPUWrapper {
   std::vector<std::shared_ptr<paddle::framework::ChannelObject<task_info>>>
       cpu_reday_channels_;
   std::shared_ptr<HeterContext> current_task_ = nullptr;
+  // the tasks handed to BeginPass whose EndPass is not done, guarded by
+  // pass_mutex_, only tracked when the build values are prefilled
+  std::deque<std::shared_ptr<HeterContext>> unended_tasks_;
+  std::mutex pass_mutex_;
   std::thread buildpull_threads_;
   bool running_ = false;
   std::vector<std::shared_ptr<::ThreadPool>> pull_thread_pool_;
@@ -10,8 +10,11 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #if defined(PADDLE_WITH_PSCORE)
+#include <algorithm>
 #include <cfloat>
+#include <cmath>
 
+#include "paddle/common/flags.h"
 #include "paddle/fluid/distributed/ps/service/heter_server.h"
 #include "paddle/fluid/framework/convert_utils.h"
 #include "paddle/fluid/framework/device_worker.h"
@@ -20,6 +23,13 @@ limitations under the License. */
 #include "paddle/phi/core/platform/cpu_helper.h"
 #include "paddle/phi/core/platform/device_context.h"
 
+PD_DEFINE_bool(heter_pipeline_adaptive_depth,
+               false,
+               "Whether the first stage of the heter pipeline keeps a window "
+               "of micro-batches in flight, sized from the measured latencies "
+               "of the stages, instead of running all the micro-batches of a "
+               "mini-batch and waiting for all of them");
+
 namespace paddle::framework {
 
 void SetMicroId(paddle::framework::Scope* scope,
@@ -224,6 +234,85 @@ void HeterSectionWorker::MiniBatchBarrier() {
   micro_ids_.clear();
 }
 
+void HeterSectionWorker::RunInFlightWindow() {
+  if (pipeline_depth_ == 0) {
+    pipeline_depth_ = num_microbatches_;
+    for (int i = 0; i < num_microbatches_; ++i) {
+      free_micro_ids_.push_back(i);
+    }
+    micro_forward_seconds_.resize(num_microbatches_);
+    micro_send_time_.resize(num_microbatches_);
+  }
+  // forward new micro-batches until the window is full
+  while (!epoch_finish_ && !free_micro_ids_.empty() &&
+         static_cast<int>(micro_ids_.size()) < pipeline_depth_) {
+    int micro_id = free_micro_ids_.front();
+    auto begin = std::chrono::steady_clock::now();
+    RunForward(micro_id);
+    if (epoch_finish_) {
+      break;
+    }
+    free_micro_ids_.pop_front();
+    micro_ids_.push_back(micro_id);
+    micro_send_time_[micro_id] = std::chrono::steady_clock::now();
+    micro_forward_seconds_[micro_id] =
+        std::chrono::duration<double>(micro_send_time_[micro_id] - begin)
+            .count();
+  }
+  if (micro_ids_.empty()) {
+    return;
+  }
+
+  auto task = (*thread_queue_).Pop();
+  auto arrive = std::chrono::steady_clock::now();
+  auto micro_id = task.second;
+  PADDLE_ENFORCE_EQ(task.first.find("backward") != std::string::npos,
+                    true,
+                    common::errors::InvalidArgument(
+                        "cpu trainers only receive backward data"));
+  auto it = std::find(micro_ids_.begin(), micro_ids_.end(), micro_id);
+  PADDLE_ENFORCE_EQ(it != micro_ids_.end(),
+                    true,
+                    common::errors::InvalidArgument(
+                        "micro-batch %d is not in flight", micro_id));
+  RunBackward(micro_id);
+  micro_ids_.erase(it);
+  free_micro_ids_.push_back(micro_id);
+  batch_num_++;
+  BatchPostProcess();
+
+  auto end = std::chrono::steady_clock::now();
+  UpdatePipelineDepth(
+      micro_forward_seconds_[micro_id] +
+          std::chrono::duration<double>(end - arrive).count(),
+      std::chrono::duration<double>(arrive - micro_send_time_[micro_id])
+          .count());
+}
+
+void HeterSectionWorker::UpdatePipelineDepth(double local_seconds,
+                                             double remote_seconds) {
+  constexpr double kDecay = 0.8;
+  if (local_latency_ == 0.0) {
+    local_latency_ = local_seconds;
+    remote_latency_ = remote_seconds;
+  } else {
+    local_latency_ = kDecay * local_latency_ + (1 - kDecay) * local_seconds;
+    remote_latency_ = kDecay * remote_latency_ + (1 - kDecay) * remote_seconds;
+  }
+  // The later stages stay busy when the window covers the round trip of a
+  // micro-batch, in units of the time this stage spends on one.
+  double round_trip = local_latency_ + remote_latency_;
+  int depth = static_cast<int>(
+      std::ceil(round_trip / std::max(local_latency_, 1e-6)));
+  depth = std::min(std::max(depth, 1), num_microbatches_);
+  if (depth != pipeline_depth_) {
+    VLOG(3) << "thread " << thread_id_ << " pipeline depth " << pipeline_depth_
+            << " -> " << depth << ", local latency " << local_latency_
+            << "s, remote latency " << remote_latency_ << "s";
+    pipeline_depth_ = depth;
+  }
+}
+
 void HeterSectionWorker::RunListen() {
   VLOG(4) << ">>> run listen_op";
   listen_op_->Run(*root_scope_, place_);
@@ -378,7 +467,11 @@ void HeterSectionWorker::Run() {
   }
   bool is_first_stage = (pipeline_stage_ == 0);
   bool is_last_stage = (pipeline_stage_ + 1 == num_pipeline_stages_);
-  if (is_first_stage) {  // for cpu trainer
+  if (is_first_stage && FLAGS_heter_pipeline_adaptive_depth) {
+    while (!epoch_finish_ || !micro_ids_.empty()) {
+      RunInFlightWindow();
+    }
+  } else if (is_first_stage) {  // for cpu trainer
     while (!epoch_finish_) {
       // forward
       for (int i = 0; i < num_microbatches_; i++) {
@@ -457,6 +550,14 @@ void HeterSectionWorker::BatchPostProcess() {
                 "mean read time: %fs\n",
                 read_time_ / batch_num_);  // NOLINT
         fprintf(stderr, "IO percent: %f\n", read_time_ / total_time_ * 100);
+        if (FLAGS_heter_pipeline_adaptive_depth) {
+          fprintf(stderr,
+                  "pipeline depth: %d, local latency: %fs, remote latency: "
+                  "%fs\n",
+                  pipeline_depth_,
+                  local_latency_,
+                  remote_latency_);
+        }
       }
       fprintf(stderr,
               "%6.2f instances/s\n",
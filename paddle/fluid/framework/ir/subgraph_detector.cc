@@ -422,6 +422,7 @@ void SubGraphFuser::ReplaceNodesWithSubGraphs() {
   auto subgraphs = SubgraphDetector(graph_, node_inside_subgraph_teller_)();
   for (auto &subgraph : subgraphs) {
     if (subgraph.size() <= static_cast<size_t>(min_subgraph_size_)) continue;
+    if (subgraph_filter_ && !subgraph_filter_(subgraph)) continue;
 
     bool continue_run = true;
 
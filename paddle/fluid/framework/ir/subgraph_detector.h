@@ -14,6 +14,7 @@ limitations under the License. */
 
 #pragma once
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -67,6 +68,8 @@ class SubgraphDetector {
 class SubGraphFuser {
  public:
   using NodeInsideSubgraphTeller = SubgraphDetector::NodeInsideSubgraphTeller;
+  // Tells whether a detected sub-graph is worth to be replaced.
+  using SubgraphFilter = std::function<bool(const std::vector<Node *> &)>;
 
   SubGraphFuser(Graph *graph,
                 const NodeInsideSubgraphTeller &teller,
@@ -82,6 +85,11 @@ class SubGraphFuser {
   // The main method which run all the logic.
   void operator()();
 
+  // Skips the sub-graphs rejected by the filter, on top of the size limit.
+  void SetSubgraphFilter(const SubgraphFilter &filter) {
+    subgraph_filter_ = filter;
+  }
+
  protected:
   // Remove the nodes inside sub-graphs and replace with the SubGraphNode.
   void ReplaceNodesWithSubGraphs();
@@ -92,6 +100,7 @@ class SubGraphFuser {
   int min_subgraph_size_;
   std::vector<std::string> trt_exclude_var_names_;
   const std::string name_;
+  SubgraphFilter subgraph_filter_;
 };
 
 struct NodeWrapper {
@@ -14,11 +14,13 @@
 
 #include "paddle/fluid/framework/naive_executor.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 
+#include "paddle/common/flags.h"
 #include "paddle/fluid/framework/op_registry.h"
 #include "paddle/fluid/framework/scope.h"
 #include "paddle/fluid/framework/variable_helper.h"
@@ -37,6 +39,10 @@
 #include "paddle/phi/core/platform/device/gpu/cuda/cuda_profiler.h"
 #endif
 
+#ifdef PADDLE_WITH_TENSORRT
+COMMON_DECLARE_bool(predictor_pool_share_trt_engine);
+#endif
+
 namespace paddle::framework {
 void NaiveExecutor::Prepare(Scope *scope,
                             const ProgramDesc &program_desc,
@@ -324,10 +330,17 @@ void NaiveExecutor::ResetTrtOps(int num) {
                          .Get(engine_name);
       }
       if (trt_engine && trt_engine->with_dynamic_shape()) {
+        int profile_num = num;
+        if (FLAGS_predictor_pool_share_trt_engine) {
+          // The clones share the engine, so it is only rebuilt when it runs
+          // out of optimization profiles, and then with twice as many.
+          if (trt_engine->GetProfileNum() >= num) continue;
+          profile_num = std::max(num, 2 * trt_engine->GetProfileNum());
+        }
         LOG(INFO) << "rebuild trt engine, this may cost a lot of time!";
         trt_engine->ResetContext();
         trt_engine->ClearTensorMap();
-        trt_engine->SetProfileNum(num);
+        trt_engine->SetProfileNum(profile_num);
         auto *anc = scope_->parent();
         while (anc && anc->parent()) {
           anc = anc->parent();
@@ -13,6 +13,9 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #include "paddle/fluid/framework/new_executor/collect_shape_manager.h"
+
+#include <algorithm>
+
 #include "paddle/phi/core/platform/device_context.h"
 #include "paddle/phi/kernels/funcs/data_type_transform.h"
 
@@ -23,12 +26,65 @@ CollectShapeManager &CollectShapeManager::Instance() {
   return instance;
 }
 
+void ShapeRange::Update(const std::vector<int32_t> &shape) {
+  if (num_shapes == 0) {
+    min_shape = shape;
+    max_shape = shape;
+    dim_counters.resize(shape.size());
+  } else if (shape.size() != min_shape.size()) {
+    VLOG(3) << "Skip the shape of rank " << shape.size()
+            << " of the value of rank " << min_shape.size();
+    return;
+  }
+  if (first_shapes.size() < 3) {
+    first_shapes.push_back(shape);
+  }
+  ++num_shapes;
+  for (size_t d = 0; d < shape.size(); ++d) {
+    min_shape[d] = std::min(min_shape[d], shape[d]);
+    max_shape[d] = std::max(max_shape[d], shape[d]);
+    dim_counters[d][shape[d]] += 1;
+  }
+}
+
+void ShapeRange::GetMinMaxOpt(std::vector<int32_t> *min,
+                              std::vector<int32_t> *max,
+                              std::vector<int32_t> *opt) const {
+  *min = min_shape;
+  *max = max_shape;
+  opt->resize(min_shape.size());
+  // Applicable to scenarios where min/opt/max are specified;
+  if (num_shapes == 3) {
+    for (size_t d = 0; d < min_shape.size(); ++d) {
+      std::vector<int32_t> dim_values;
+      for (const auto &shape : first_shapes) {
+        dim_values.push_back(shape[d]);
+      }
+      std::sort(dim_values.begin(), dim_values.end());
+      (*opt)[d] = dim_values[1];
+    }
+    return;
+  }
+  // suitable for scenarios where shape is automatically collected.
+  for (size_t d = 0; d < min_shape.size(); ++d) {
+    int32_t max_freq = 0;
+    for (auto &it : dim_counters[d]) {
+      if (it.second > max_freq) {
+        max_freq = it.second;
+        (*opt)[d] = it.first;
+      }
+    }
+  }
+}
+
 void CollectShapeManager::CollectShapeInfo(
     framework::InstructionBase *instr,
     framework::ValueExecutionInfo *value_exe_info,
     framework::Scope *scope) {
-  std::lock_guard<std::mutex> lock(info_mutex_);
-  is_shape_range_info_ready_ = false;
+  // The shapes are read without the lock, which is only held to update the
+  // ranges.
+  std::vector<std::pair<pir::Value, std::vector<int32_t>>> shapes;
+  std::vector<std::pair<pir::Value, std::vector<int32_t>>> shape_tensors;
   for (auto &input : instr->Inputs()) {
     auto var_name = value_exe_info->GetVarName(input.first);
     auto *var = scope->FindVar(var_name);
@@ -39,22 +95,13 @@ void CollectShapeManager::CollectShapeInfo(
     }
     paddle::platform::DeviceContextPool &pool =
         paddle::platform::DeviceContextPool::Instance();
-#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
-    auto *dev_ctx = pool.Get(phi::GPUPlace());
-    auto stream = static_cast<phi::GPUContext *>(dev_ctx)->stream();
-#ifdef PADDLE_WITH_HIP
-    hipStreamSynchronize(stream);
-#else
-    cudaStreamSynchronize(stream);
-#endif
-#endif
 
     phi::DDim dim = tensor.dims();
     std::vector<int32_t> shape(dim.size());
     for (int i = 0; i < static_cast<int>(shape.size()); ++i)
       shape[i] = static_cast<int32_t>(dim[i]);
     if (!shape.empty()) {
-      shape_info_[input.first].emplace_back(shape);
+      shapes.emplace_back(input.first, shape);
     } else if (tensor.numel() > 0) {
       // This must be a zero dimension tensor.
       PADDLE_ENFORCE_EQ(tensor.numel(),
@@ -63,7 +110,7 @@ void CollectShapeManager::CollectShapeInfo(
                             "This tensor must have one element, but got %ld.",
                             tensor.numel()));
       std::vector<int32_t> zero_shape(1, 1);
-      shape_info_[input.first].emplace_back(zero_shape);
+      shapes.emplace_back(input.first, zero_shape);
     }
 
     // We need collect value range for shape tensor for Paddle-TRT's use.
@@ -93,28 +140,40 @@ void CollectShapeManager::CollectShapeInfo(
                              int32_tensor.numel() * sizeof(int));
       } else if (phi::is_gpu_place(tensor.place())) {
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
-        auto *dev_ctx = pool.Get(tensor.place());
+        // Only the data of the shape tensors needs the stream to be synced,
+        // the shapes are known on the host.
+        auto *dev_ctx = reinterpret_cast<phi::GPUContext *>(
+            pool.Get(tensor.place()));
         auto &int32_tensor = tensor;
         if (tensor.dtype() == phi::DataType::INT64) {
-          int32_tensor = phi::funcs::TransDataType(
-              reinterpret_cast<const phi::GPUContext &>(*dev_ctx),
-              tensor,
-              DataType::INT32);
+          int32_tensor =
+              phi::funcs::TransDataType(*dev_ctx, tensor, DataType::INT32);
         }
         paddle::memory::Copy(phi::CPUPlace(),
                              int32_host.data(),
                              int32_tensor.place(),
                              int32_tensor.data<int>(),
                              int32_tensor.numel() * sizeof(int),
-                             nullptr);
+                             dev_ctx->stream());
+        dev_ctx->Wait();
 #endif
       }
-      shape_tensor_info_[input.first].emplace_back(int32_host);
+      shape_tensors.emplace_back(input.first, int32_host);
     }
   }
+
+  std::lock_guard<std::mutex> lock(info_mutex_);
+  is_shape_range_info_ready_ = false;
+  for (auto &it : shapes) {
+    shape_ranges_[it.first].Update(it.second);
+  }
+  for (auto &it : shape_tensors) {
+    shape_tensor_ranges_[it.first].Update(it.second);
+  }
 }
 
 void CollectShapeManager::StatisticShapeRangeInfo() {
+  std::lock_guard<std::mutex> lock(info_mutex_);
   if (is_shape_range_info_ready_) {
     return;
   }
@@ -122,67 +181,21 @@ void CollectShapeManager::StatisticShapeRangeInfo() {
       [](std::map<pir::Value, std::vector<int32_t>> &min_data,
          decltype(min_data) max_data,
          decltype(min_data) opt_data,
-         decltype(shape_info_) shape_data) {
-        for (auto const &it : shape_data) {
-          auto val = it.first;
-          auto shapes = it.second;
-
-          std::vector<int32_t> min_shape(shapes[0].begin(), shapes[0].end());
-          std::vector<int32_t> max_shape(shapes[0].begin(), shapes[0].end());
-          std::vector<int32_t> opt_shape(shapes[0].begin(), shapes[0].end());
-          // Applicable to scenarios where min/opt/max are specified;
-          if (shapes.size() == 3) {
-            for (size_t d = 0; d < shapes[0].size(); ++d) {
-              std::vector<int32_t> dim_values;
-              for (const auto &shape : shapes) {
-                dim_values.push_back(shape[d]);
-              }
-              std::sort(dim_values.begin(), dim_values.end());
-              min_shape[d] = dim_values[0];
-              opt_shape[d] = dim_values[1];
-              max_shape[d] = dim_values[2];
-            }
-            min_data[val] = min_shape;
-            max_data[val] = max_shape;
-            opt_data[val] = opt_shape;
-          } else {
-            // suitable for scenarios where shape is automatically collected.
-            auto ShapeMaxFreq =
-                [](const std::map<int32_t, int32_t> &m) -> int32_t {
-              std::vector<std::pair<int32_t, int32_t>> counter;
-              for (auto &it : m) counter.emplace_back(it);
-              std::sort(counter.begin(),
-                        counter.end(),
-                        [](std::pair<int32_t, int32_t> &a,
-                           std::pair<int32_t, int32_t> &b) {
-                          return a.second > b.second;
-                        });
-              return counter[0].first;
-            };
-
-            for (size_t d = 0; d < shapes[0].size(); ++d) {
-              std::map<int32_t, int32_t> counter;
-              for (auto &shape : shapes) {
-                counter[shape[d]] += 1;
-                if (shape[d] < min_shape[d]) min_shape[d] = shape[d];
-                if (shape[d] > max_shape[d]) max_shape[d] = shape[d];
-              }
-              opt_shape[d] = ShapeMaxFreq(counter);
-            }
-            min_data[val] = min_shape;
-            max_data[val] = max_shape;
-            opt_data[val] = opt_shape;
-          }
+         const std::map<pir::Value, ShapeRange> &ranges) {
+        for (auto const &it : ranges) {
+          it.second.GetMinMaxOpt(
+              &min_data[it.first], &max_data[it.first], &opt_data[it.first]);
         }
       };
-  extract_min_max_opt(min_shapes_, max_shapes_, opt_shapes_, shape_info_);
+  extract_min_max_opt(min_shapes_, max_shapes_, opt_shapes_, shape_ranges_);
   extract_min_max_opt(
-      min_values_, max_values_, opt_values_, shape_tensor_info_);
+      min_values_, max_values_, opt_values_, shape_tensor_ranges_);
   is_shape_range_info_ready_ = true;
 }
 
 std::vector<int32_t> CollectShapeManager::GetValueShapeRangeInfo(
     pir::Value op_val, bool is_shape_tensor, ShapeMode shape_mode) {
+  std::lock_guard<std::mutex> lock(info_mutex_);
   PADDLE_ENFORCE_EQ(is_shape_range_info_ready_,
                     true,
                     ::common::errors::PreconditionNotMet(
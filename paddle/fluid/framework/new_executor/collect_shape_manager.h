@@ -14,6 +14,8 @@ limitations under the License. */
 
 #pragma once
 
+#include <map>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -31,6 +33,26 @@ enum class ShapeMode {
   kMAX,
 };
 
+// The range of the shapes, or of the data of a shape tensor, that a value has
+// had so far. It is updated in place instead of keeping all the shapes, so
+// that the collection can keep running for any number of steps.
+struct ShapeRange {
+  // The first three shapes, for the min, opt and max shapes given by exactly
+  // three runs.
+  std::vector<std::vector<int32_t>> first_shapes;
+  size_t num_shapes = 0;
+  std::vector<int32_t> min_shape;
+  std::vector<int32_t> max_shape;
+  // The number of times each size of each dim is seen, the most frequent one
+  // is the opt size of the dim.
+  std::vector<std::map<int32_t, int32_t>> dim_counters;
+
+  void Update(const std::vector<int32_t>& shape);
+  void GetMinMaxOpt(std::vector<int32_t>* min,
+                    std::vector<int32_t>* max,
+                    std::vector<int32_t>* opt) const;
+};
+
 // CollectShapeManager can get all shape of value when run executor and this
 // information will be used for TensorRTEngine
 class CollectShapeManager {
@@ -56,8 +78,9 @@ class CollectShapeManager {
                                               ShapeMode shape_mode);
 
   void ClearShapeInfo() {
-    shape_info_.clear();
-    shape_tensor_info_.clear();
+    std::lock_guard<std::mutex> lock(info_mutex_);
+    shape_ranges_.clear();
+    shape_tensor_ranges_.clear();
     min_shapes_.clear();
     max_shapes_.clear();
     opt_shapes_.clear();
@@ -71,8 +94,8 @@ class CollectShapeManager {
  private:
   CollectShapeManager() {}
   std::unordered_map<pir::Value, pir::Value> op_value2kernel_value_;
-  std::map<pir::Value, std::vector<std::vector<int32_t>>> shape_info_;
-  std::map<pir::Value, std::vector<std::vector<int32_t>>> shape_tensor_info_;
+  std::map<pir::Value, ShapeRange> shape_ranges_;
+  std::map<pir::Value, ShapeRange> shape_tensor_ranges_;
   std::map<pir::Value, std::vector<int32_t>> min_shapes_;
   std::map<pir::Value, std::vector<int32_t>> max_shapes_;
   std::map<pir::Value, std::vector<int32_t>> opt_shapes_;
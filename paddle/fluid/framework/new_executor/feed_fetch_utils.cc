@@ -52,7 +52,7 @@ void SplitFeedTensors(const std::vector<std::string>& feed_names,
                       const int64_t micro_batch_num,
                       Scope* scope,
                       std::vector<std::vector<phi::DenseTensor>>* out) {
-  std::vector<phi::DenseTensor> feed_tensors;
+  std::vector<Variable*> feed_vars;
   for (size_t i = 0; i < feed_names.size(); ++i) {
     auto feed_name = feed_names[i];
     auto feed_var = scope->GetVar(feed_name);
@@ -60,6 +60,18 @@ void SplitFeedTensors(const std::vector<std::string>& feed_names,
         feed_var,
         common::errors::NotFound("Variable %s should not be nullptr.",
                                  feed_names[i]));
+    feed_vars.push_back(feed_var);
+  }
+  SplitFeedTensors(feed_names, feed_vars, micro_batch_num, out);
+}
+
+void SplitFeedTensors(const std::vector<std::string>& feed_names,
+                      const std::vector<Variable*>& feed_vars,
+                      const int64_t micro_batch_num,
+                      std::vector<std::vector<phi::DenseTensor>>* out) {
+  std::vector<phi::DenseTensor> feed_tensors;
+  feed_tensors.reserve(feed_vars.size());
+  for (auto* feed_var : feed_vars) {
     feed_tensors.push_back(feed_var->Get<phi::DenseTensor>());
   }
 
@@ -96,6 +108,20 @@ void FetchTensors(const std::vector<std::string>& job_fetch_names,
                   const int64_t micro_batch_id,
                   Scope* scope,
                   FetchUnmergedList* fetch_list) {
+  std::vector<std::pair<int, Variable*>> job_fetch_vars;
+  for (auto& var_name : job_fetch_names) {
+    int col = find(fetch_var_names.begin(), fetch_var_names.end(), var_name) -
+              fetch_var_names.begin();
+    job_fetch_vars.emplace_back(col, scope->FindVar(var_name));
+  }
+  FetchTensors(
+      job_fetch_vars, fetch_var_names.size(), micro_batch_id, fetch_list);
+}
+
+void FetchTensors(const std::vector<std::pair<int, Variable*>>& job_fetch_vars,
+                  const size_t fetch_var_num,
+                  const int64_t micro_batch_id,
+                  FetchUnmergedList* fetch_list) {
   PADDLE_ENFORCE_GT(fetch_list->size(),
                     micro_batch_id,
                     common::errors::Unavailable(
@@ -104,11 +130,8 @@ void FetchTensors(const std::vector<std::string>& job_fetch_names,
                         fetch_list->size(),
                         micro_batch_id));
 
-  fetch_list->at(micro_batch_id).resize(fetch_var_names.size());
-  for (auto& var_name : job_fetch_names) {
-    int col = find(fetch_var_names.begin(), fetch_var_names.end(), var_name) -
-              fetch_var_names.begin();
-    auto* var = scope->FindVar(var_name);
+  fetch_list->at(micro_batch_id).resize(fetch_var_num);
+  for (const auto& [col, var] : job_fetch_vars) {
     if (var->IsType<phi::DenseTensor>()) {
       auto& src = var->Get<phi::DenseTensor>();
       auto* dst =
@@ -117,7 +140,7 @@ void FetchTensors(const std::vector<std::string>& job_fetch_names,
         TensorCopy(src, phi::CPUPlace(), dst);
         dst->set_lod(src.lod());
       } else {
-        VLOG(6) << "Found " << var_name
+        VLOG(6) << "Found the fetch var of col " << col
                 << " is not initialized and skip TensorCopy.";
       }
     } else if (var->IsType<phi::TensorArray>()) {
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <map>
+#include <utility>
 #include <vector>
 
 #include "paddle/fluid/framework/new_executor/interpreter/plan.h"
@@ -32,12 +33,25 @@ void SplitFeedTensors(const std::vector<std::string>& feed_names,
                       Scope* scope,
                       std::vector<std::vector<phi::DenseTensor>>* out);
 
+// Same as above with the feed variables resolved by the caller.
+void SplitFeedTensors(const std::vector<std::string>& feed_names,
+                      const std::vector<Variable*>& feed_vars,
+                      const int64_t micro_batch_num,
+                      std::vector<std::vector<phi::DenseTensor>>* out);
+
 void FetchTensors(const std::vector<std::string>& job_fetch_names,
                   const std::vector<std::string>& fetch_var_names,
                   const int64_t micro_batch_id,
                   Scope* scope,
                   FetchUnmergedList* fetch_list);
 
+// Same as above with the (col, variable) pairs of the job resolved by the
+// caller, fetch_var_num is the size of fetch_var_names.
+void FetchTensors(const std::vector<std::pair<int, Variable*>>& job_fetch_vars,
+                  const size_t fetch_var_num,
+                  const int64_t micro_batch_id,
+                  FetchUnmergedList* fetch_list);
+
 void MergeFetchTensors(const FetchUnmergedList& fetch_list,
                        const int64_t micro_batch_num,
                        FetchList* out);
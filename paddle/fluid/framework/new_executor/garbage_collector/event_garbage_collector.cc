@@ -207,4 +207,11 @@ void InterpreterCoreEventGarbageCollector::FreeGarbages() {
   events_.clear();
 }
 
+void InterpreterCoreEventGarbageCollector::Flush() {
+  std::lock_guard<memory::SpinLock> guard(spinlock_);
+  if (!garbages_->empty()) {
+    FreeGarbages();
+  }
+}
+
 }  // namespace paddle::framework
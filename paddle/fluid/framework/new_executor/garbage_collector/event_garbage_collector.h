@@ -36,6 +36,8 @@ class InterpreterCoreEventGarbageCollector
 
   void Add(Variable* var, const InstructionBase* instruction) override;
 
+  void Flush() override;
+
  private:
   void Add(Variable* var,
            platform::DeviceEvent* event,
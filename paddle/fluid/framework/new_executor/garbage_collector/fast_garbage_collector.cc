@@ -99,5 +99,15 @@ void InterpreterCoreFastGarbageCollector::Add(Garbage garbage) {
   }
 }
 
+void InterpreterCoreFastGarbageCollector::Flush() {
+  std::unique_ptr<GarbageQueue> pending_delete_garbages;
+  {  // lock guard
+    std::lock_guard<memory::SpinLock> guard(spinlock_);
+    cur_memory_size_ = 0;
+    pending_delete_garbages = std::move(garbages_);
+    garbages_ = std::make_unique<GarbageQueue>();
+  }
+}
+
 }  // namespace framework
 }  // namespace paddle
@@ -25,6 +25,8 @@ class InterpreterCoreFastGarbageCollector
 
   void Add(Variable* var, const InstructionBase* instr) override;
 
+  void Flush() override;
+
  private:
   void Add(Variable* var);
   void Add(Garbage garbage);
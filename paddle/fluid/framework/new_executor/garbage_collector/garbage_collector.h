@@ -40,6 +40,10 @@ class InterpreterCoreGarbageCollector {
 
   virtual void Add(Variable* var, const InstructionBase* instruction) = 0;
 
+  // Frees the garbages held to reach the eager deletion threshold now, e.g.
+  // when the device is short of memory.
+  virtual void Flush() {}
+
   DISABLE_COPY_AND_ASSIGN(InterpreterCoreGarbageCollector);
 
  protected:
@@ -131,4 +131,20 @@ void InterpreterCoreNoEventGarbageCollector::Add(
   }
 }
 
+void InterpreterCoreNoEventGarbageCollector::Flush() {
+  std::lock_guard<memory::SpinLock> guard(spinlock_);
+  if (garbages_->empty()) {
+    return;
+  }
+  cur_memory_size_ = 0;
+  queue_->AddTask(
+      [container = std::move(*garbages_), dev_ctxs = std::move(ctxs_)]() {
+        for (auto& ctx : dev_ctxs) {
+          ctx->Wait();
+        }
+      });
+  ctxs_.clear();
+  garbages_->clear();
+}
+
 }  // namespace paddle::framework
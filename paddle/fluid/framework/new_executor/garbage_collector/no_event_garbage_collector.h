@@ -30,6 +30,8 @@ class InterpreterCoreNoEventGarbageCollector
 
   void Add(Variable* var, const InstructionBase* instr) override;
 
+  void Flush() override;
+
  private:
   void Add(Variable* var, const phi::DeviceContext* ctx);
   void Add(Garbage garbage, const phi::DeviceContext* ctx);
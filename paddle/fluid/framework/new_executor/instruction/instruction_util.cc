@@ -143,6 +143,8 @@ phi::DeviceContext* ParseDeviceContext(pir::Operation* op,
       } else if (op_name.compare(paddle::dialect::MpAllreduceSum_Op::name()) ==
                      0 ||
                  op_name.compare(paddle::dialect::AllReduce_Op::name()) == 0 ||
+                 op_name ==
+                     paddle::dialect::FusedAllreduceResidualRmsNormOp::name() ||
                  op_name.compare(paddle::dialect::CIdentity_Op::name()) == 0 ||
                  op_name.compare(paddle::dialect::CConcatOp::name()) == 0 ||
                  op_name.compare(paddle::dialect::Broadcast_Op::name()) == 0) {
@@ -160,6 +162,8 @@ phi::DeviceContext* ParseDeviceContext(pir::Operation* op,
         if (op_name.compare(paddle::dialect::ReduceScatterOp::name()) == 0 ||
             op_name.compare(paddle::dialect::AllReduceOp::name()) == 0 ||
             op_name.compare(paddle::dialect::AllReduce_Op::name()) == 0 ||
+            op_name ==
+                paddle::dialect::FusedAllreduceResidualRmsNormOp::name() ||
             op_name.compare(paddle::dialect::Broadcast_Op::name()) == 0 ||
             op_name.compare(paddle::dialect::BroadcastOp::name()) == 0 ||
             op_name.compare(paddle::dialect::AllGatherOp::name()) == 0 ||
@@ -552,6 +556,39 @@ void HandleForInplaceOp(pir::Operation* op,
   }
 }
 
+// NOTE: The ops marked with "reuse_buffer" by the inplace_pass have no inplace
+// version, the output shares the buffer of the dead input before the kernel
+// runs just like the inplace ops.
+void HandleForBufferReuseOp(pir::Operation* op,
+                            const ValueExecutionInfo* value_exe_info,
+                            InstructionBase* instr) {
+  auto slots =
+      op->attributes().at("reuse_buffer").dyn_cast<pir::ArrayAttribute>();
+  PADDLE_ENFORCE_EQ(
+      slots.size(),
+      2UL,
+      common::errors::InvalidArgument(
+          "The reuse_buffer attribute should hold the output slot and the "
+          "input slot, but received %d elements.",
+          slots.size()));
+  pir::Value value =
+      op->result(slots.at(0).dyn_cast<pir::Int32Attribute>().data());
+  pir::Value reuse_value =
+      op->operand_source(slots.at(1).dyn_cast<pir::Int32Attribute>().data());
+  PADDLE_ENFORCE_NE(value_exe_info->GetVarName(reuse_value),
+                    "",
+                    common::errors::InvalidArgument(
+                        "The input var name of buffer reuse op is empty."));
+  PADDLE_ENFORCE_NE(value_exe_info->GetVarName(value),
+                    "",
+                    common::errors::InvalidArgument(
+                        "The output var name of buffer reuse op is empty."));
+  VLOG(4) << "buffer reuse: " << value_exe_info->GetVarName(value) << " -> "
+          << value_exe_info->GetVarName(reuse_value);
+  instr->AddInplace(value_exe_info->GetVarByValue(reuse_value),
+                    value_exe_info->GetVarByValue(value));
+}
+
 void ShareVarBuffer(const Variable* src_var, Variable* dst_var) {
   if (src_var->IsType<phi::DenseTensor>()) {
     auto& src_tensor = src_var->Get<phi::DenseTensor>();
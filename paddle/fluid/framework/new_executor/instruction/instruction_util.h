@@ -67,6 +67,10 @@ void HandleForInplaceOp(pir::Operation* op,
                         const ValueExecutionInfo* value_exe_info,
                         InstructionBase* instr);
 
+void HandleForBufferReuseOp(pir::Operation* op,
+                            const ValueExecutionInfo* value_exe_info,
+                            InstructionBase* instr);
+
 void ShareVarBuffer(const Variable* src_var, Variable* dst_var);
 }  // namespace framework
 }  // namespace paddle
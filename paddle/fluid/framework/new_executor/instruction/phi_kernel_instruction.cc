@@ -164,11 +164,17 @@ PhiKernelInstruction::PhiKernelInstruction(
       op, *value_exec_info_, yaml_info_parser, &kernel_context_);
 
   kernel_context_.SetDeviceContext(dev_ctx);
+  // The context is built once and run many times, so the vector inputs and
+  // outputs of the kernel keep their vectors across the runs.
+  kernel_context_.SetReuseRangeBuffers(true);
   VLOG(6) << "finish process kernel context";
   if (op->attributes().count("is_inplace") != 0 &&
       op->attributes().at("is_inplace").dyn_cast<pir::BoolAttribute>().data()) {
     HandleForInplaceOp(op, value_exec_info_, this);
   }
+  if (op->attributes().count("reuse_buffer") != 0) {
+    HandleForBufferReuseOp(op, value_exec_info_, this);
+  }
   InitInputsOutputsIds(op, *value_exec_info);
   VLOG(6) << "finish process inputs outputs index";
 
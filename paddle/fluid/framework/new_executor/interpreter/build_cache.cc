@@ -0,0 +1,209 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/new_executor/interpreter/build_cache.h"
+
+#include <xxhash.h>
+
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <thread>
+
+#include "paddle/common/flags.h"
+#include "paddle/fluid/framework/new_executor/instruction/instruction_base.h"
+#include "paddle/phi/common/port.h"
+#include "paddle/pir/include/core/block.h"
+#include "paddle/pir/include/core/ir_printer.h"
+
+PHI_DEFINE_EXPORTED_string(
+    pir_interpreter_build_cache_dir,
+    "",
+    "The directory to persist the instruction dependency analysis of "
+    "PirInterpreter. Empty means the build cache is disabled.");
+
+COMMON_DECLARE_bool(new_executor_sequential_run);
+COMMON_DECLARE_bool(add_dependency_for_communication_op);
+
+namespace paddle::framework::interpreter {
+
+namespace {
+
+constexpr uint64_t kBuildCacheMagic = 0x3130304342524950;  // "PIRBC001"
+
+template <typename T>
+void WritePod(std::ostream* os, const T& value) {
+  os->write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadPod(std::istream* is, T* value) {
+  is->read(reinterpret_cast<char*>(value), sizeof(T));
+  return static_cast<bool>(*is);
+}
+
+}  // namespace
+
+bool PirBuildCache::IsEnabled() {
+  return !FLAGS_pir_interpreter_build_cache_dir.empty();
+}
+
+std::string PirBuildCache::CachePath(const std::string& key) {
+  return FLAGS_pir_interpreter_build_cache_dir + "/" + key + ".pir_deps";
+}
+
+std::string PirBuildCache::CacheKey(
+    const ::pir::Block& block,
+    const std::vector<InstructionBase*>& instructions,
+    const phi::Place& place) {
+  std::stringstream ss;
+  ::pir::IrPrinter printer(ss);
+  printer.PrintBlock(block);
+  for (auto* instr : instructions) {
+    ss << instr->Name() << ";";
+  }
+  ss << place.DebugString() << ";" << FLAGS_new_executor_sequential_run << ";"
+     << FLAGS_add_dependency_for_communication_op;
+  std::string str = ss.str();
+  // non-cryptographic is enough
+  return std::to_string(XXH64(str.c_str(), str.size(), 1));
+}
+
+bool PirBuildCache::LoadDependency(const std::string& key,
+                                   size_t instr_num,
+                                   DependencyInfo* dependency_info) {
+  std::string path = CachePath(key);
+  std::ifstream fin(path, std::ios::binary);
+  if (!fin.is_open()) {
+    VLOG(4) << "Build cache miss: " << path;
+    return false;
+  }
+
+  uint64_t magic = 0, num = 0, map_size = 0;
+  if (!ReadPod(&fin, &magic) || magic != kBuildCacheMagic ||
+      !ReadPod(&fin, &num) || num != instr_num || !ReadPod(&fin, &map_size)) {
+    LOG(WARNING) << "Ignore invalid build cache file " << path;
+    return false;
+  }
+
+  auto op_downstream_map =
+      std::make_shared<std::map<size_t, std::set<size_t>>>();
+  for (uint64_t i = 0; i < map_size; ++i) {
+    uint64_t op_idx = 0, downstream_num = 0;
+    if (!ReadPod(&fin, &op_idx) || !ReadPod(&fin, &downstream_num) ||
+        op_idx >= instr_num) {
+      LOG(WARNING) << "Ignore invalid build cache file " << path;
+      return false;
+    }
+    std::set<size_t>& downstream = (*op_downstream_map)[op_idx];
+    for (uint64_t j = 0; j < downstream_num; ++j) {
+      uint64_t next_op_idx = 0;
+      if (!ReadPod(&fin, &next_op_idx) || next_op_idx >= instr_num) {
+        LOG(WARNING) << "Ignore invalid build cache file " << path;
+        return false;
+      }
+      downstream.insert(next_op_idx);
+    }
+  }
+
+  // op_happens_before is stored as a bitmap in row-major order
+  auto op_happens_before = std::make_shared<std::vector<std::vector<bool>>>(
+      instr_num, std::vector<bool>(instr_num, false));
+  uint64_t word = 0;
+  size_t bit_idx = 0;
+  for (size_t i = 0; i < instr_num; ++i) {
+    for (size_t j = 0; j < instr_num; ++j, ++bit_idx) {
+      if (bit_idx % 64 == 0 && !ReadPod(&fin, &word)) {
+        LOG(WARNING) << "Ignore invalid build cache file " << path;
+        return false;
+      }
+      (*op_happens_before)[i][j] = (word >> (bit_idx % 64)) & 1;
+    }
+  }
+
+  dependency_info->op_downstream_map = op_downstream_map;
+  dependency_info->op_happens_before = op_happens_before;
+  VLOG(4) << "Build cache hit: " << path;
+  return true;
+}
+
+void PirBuildCache::SaveDependency(const std::string& key,
+                                   const DependencyInfo& dependency_info) {
+  const auto& op_downstream_map = *dependency_info.op_downstream_map;
+  const auto& op_happens_before = *dependency_info.op_happens_before;
+
+  std::string path = CachePath(key);
+  std::string tmp_path =
+      path + ".tmp" +
+      std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+  try {
+    MkDirRecursively(FLAGS_pir_interpreter_build_cache_dir.c_str());
+  } catch (std::exception& ex) {
+    LOG(WARNING) << "Failed to create build cache directory "
+                 << FLAGS_pir_interpreter_build_cache_dir << ": " << ex.what();
+    return;
+  }
+
+  {
+    std::ofstream fout(tmp_path, std::ios::binary);
+    if (!fout.is_open()) {
+      LOG(WARNING) << "Failed to open build cache file " << tmp_path;
+      return;
+    }
+    WritePod(&fout, kBuildCacheMagic);
+    WritePod(&fout, static_cast<uint64_t>(op_happens_before.size()));
+    WritePod(&fout, static_cast<uint64_t>(op_downstream_map.size()));
+    for (const auto& item : op_downstream_map) {
+      WritePod(&fout, static_cast<uint64_t>(item.first));
+      WritePod(&fout, static_cast<uint64_t>(item.second.size()));
+      for (size_t next_op_idx : item.second) {
+        WritePod(&fout, static_cast<uint64_t>(next_op_idx));
+      }
+    }
+
+    uint64_t word = 0;
+    size_t bit_idx = 0;
+    for (const auto& row : op_happens_before) {
+      for (bool happens_before : row) {
+        if (happens_before) {
+          word |= (uint64_t(1) << (bit_idx % 64));
+        }
+        if (++bit_idx % 64 == 0) {
+          WritePod(&fout, word);
+          word = 0;
+        }
+      }
+    }
+    if (bit_idx % 64 != 0) {
+      WritePod(&fout, word);
+    }
+    if (!fout) {
+      LOG(WARNING) << "Failed to write build cache file " << tmp_path;
+      fout.close();
+      std::remove(tmp_path.c_str());
+      return;
+    }
+  }
+
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    LOG(WARNING) << "Failed to rename build cache file " << tmp_path << " to "
+                 << path;
+    std::remove(tmp_path.c_str());
+    return;
+  }
+  VLOG(4) << "Save build cache: " << path;
+}
+
+}  // namespace paddle::framework::interpreter
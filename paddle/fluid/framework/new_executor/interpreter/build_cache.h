@@ -0,0 +1,74 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "paddle/phi/common/place.h"
+
+namespace pir {
+class Block;
+}  // namespace pir
+
+namespace paddle {
+namespace framework {
+class InstructionBase;
+namespace interpreter {
+
+// PirBuildCache persists the instruction dependency analysis of
+// PirInterpreter on disk, so that another process (or a later run of the same
+// process) building the same program on the same place can skip
+// PirDependencyBuilder::Build, whose cost is quadratic in the number of
+// instructions. The cache is enabled by FLAGS_pir_interpreter_build_cache_dir.
+//
+// A cache entry is one file named by the cache key. It is written to a
+// temporary file first and then renamed, so concurrent writers sharing the
+// same directory never observe a partially written entry.
+class PirBuildCache {
+ public:
+  struct DependencyInfo {
+    std::shared_ptr<std::map<size_t, std::set<size_t>>> op_downstream_map;
+    std::shared_ptr<std::vector<std::vector<bool>>> op_happens_before;
+  };
+
+  static bool IsEnabled();
+
+  // The key is computed from the textual form of the block, the name sequence
+  // of the instructions built from it, the place and the FLAGS affecting the
+  // dependency analysis.
+  static std::string CacheKey(
+      const ::pir::Block& block,
+      const std::vector<InstructionBase*>& instructions,
+      const phi::Place& place);
+
+  // Return false if there is no valid entry for the key.
+  static bool LoadDependency(const std::string& key,
+                             size_t instr_num,
+                             DependencyInfo* dependency_info);
+
+  static void SaveDependency(const std::string& key,
+                             const DependencyInfo& dependency_info);
+
+ private:
+  static std::string CachePath(const std::string& key);
+};
+
+}  // namespace interpreter
+}  // namespace framework
+}  // namespace paddle
@@ -773,6 +773,17 @@ void PirDependencyBuilder::ShareDependencyFrom(
   is_build_ = true;
 }
 
+void PirDependencyBuilder::LoadDependency(
+    std::vector<paddle::framework::InstructionBase*> instructions,
+    std::shared_ptr<std::map<size_t, std::set<size_t>>> op_downstream_map,
+    std::shared_ptr<std::vector<std::vector<bool>>> op_happens_before) {
+  instructions_ = instructions;
+  op_num_ = instructions_.size();
+  op_downstream_map_ = op_downstream_map;
+  op_happens_before_ = op_happens_before;
+  is_build_ = true;
+}
+
 void DependencyBuilderSimplify::GetAllbehind() {
   auto update_op_happen_before = [this](size_t prior_op_idx,
                                         size_t posterior_op_idx) {
@@ -124,6 +124,12 @@ class PirDependencyBuilder : public DependencyBuilder {
 
   void ShareDependencyFrom(const PirDependencyBuilder& src);
 
+  // Use the dependency loaded from PirBuildCache instead of building it.
+  void LoadDependency(
+      std::vector<paddle::framework::InstructionBase*> instructions,
+      std::shared_ptr<std::map<size_t, std::set<size_t>>> op_downstream_map,
+      std::shared_ptr<std::vector<std::vector<bool>>> op_happens_before);
+
   bool IsSameDeviceContext(size_t op1, size_t op2) const {
     return &((instructions_)[op1]->DeviceContext()) ==
            &((instructions_)[op2]->DeviceContext());
@@ -0,0 +1,112 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/new_executor/interpreter/static_memory_planner.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "glog/logging.h"
+#include "paddle/common/enforce.h"
+
+namespace paddle::framework::interpreter {
+
+namespace {
+
+size_t AlignUp(size_t size, size_t alignment) {
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+// Whether the lifetime of lhs ends before the lifetime of rhs begins.
+bool DiesBefore(const StaticMemoryRequest& lhs,
+                const StaticMemoryRequest& rhs,
+                const std::function<bool(size_t, size_t)>& op_happens_before) {
+  if (lhs.last_live_ops.empty()) {
+    return lhs.def_op != rhs.def_op &&
+           op_happens_before(lhs.def_op, rhs.def_op);
+  }
+  for (size_t last_live_op : lhs.last_live_ops) {
+    if (last_live_op == rhs.def_op ||
+        !op_happens_before(last_live_op, rhs.def_op)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+StaticMemoryPlan PlanStaticMemory(
+    const std::vector<StaticMemoryRequest>& requests,
+    const std::function<bool(size_t, size_t)>& op_happens_before,
+    size_t alignment) {
+  PADDLE_ENFORCE_GT(alignment,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The alignment of static memory plan should be "
+                        "greater than 0, but received %d.",
+                        alignment));
+  std::vector<size_t> order(requests.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&requests](size_t lhs, size_t rhs) {
+    if (requests[lhs].size != requests[rhs].size) {
+      return requests[lhs].size > requests[rhs].size;
+    }
+    return requests[lhs].var_id < requests[rhs].var_id;
+  });
+
+  StaticMemoryPlan plan;
+  // placed request index -> [begin, end) in the arena
+  std::vector<std::pair<size_t, std::pair<size_t, size_t>>> placed;
+  placed.reserve(requests.size());
+  for (size_t idx : order) {
+    const StaticMemoryRequest& request = requests[idx];
+    size_t size = AlignUp(std::max<size_t>(request.size, 1), alignment);
+
+    std::vector<std::pair<size_t, size_t>> occupied;
+    for (auto& item : placed) {
+      const StaticMemoryRequest& other = requests[item.first];
+      if (!DiesBefore(request, other, op_happens_before) &&
+          !DiesBefore(other, request, op_happens_before)) {
+        occupied.push_back(item.second);
+      }
+    }
+    std::sort(occupied.begin(), occupied.end());
+
+    size_t offset = 0;
+    for (auto& range : occupied) {
+      if (range.first >= offset + size) {
+        break;
+      }
+      offset = std::max(offset, range.second);
+    }
+
+    placed.emplace_back(idx, std::make_pair(offset, offset + size));
+    plan.offsets[request.var_id] = offset;
+    plan.arena_size = std::max(plan.arena_size, offset + size);
+  }
+
+  size_t total_size = 0;
+  for (auto& request : requests) {
+    total_size += AlignUp(std::max<size_t>(request.size, 1), alignment);
+  }
+  VLOG(4) << "Static memory plan: " << requests.size() << " blocks, "
+          << total_size << " bytes in total, arena size " << plan.arena_size
+          << " bytes.";
+  return plan;
+}
+
+}  // namespace paddle::framework::interpreter
@@ -0,0 +1,57 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace paddle {
+namespace framework {
+namespace interpreter {
+
+// A memory block requested by an intermediate variable whose size is known
+// before running.
+struct StaticMemoryRequest {
+  size_t var_id;
+  size_t size;
+  // the only instruction that writes the variable
+  size_t def_op;
+  // the instructions that access the variable last, see
+  // PirInterpreter::CalculateLastLiveOps
+  std::set<size_t> last_live_ops;
+};
+
+struct StaticMemoryPlan {
+  size_t arena_size{0};
+  // var_id -> offset in the arena
+  std::unordered_map<size_t, size_t> offsets;
+};
+
+// Assign every request an offset in one arena. Two requests may overlap in the
+// arena only if all the last live ops of one happen before the def op of the
+// other, which is ensured by the instruction dependencies no matter how the
+// instructions are scheduled by threads and streams. Requests are placed from
+// the largest to the smallest, each one at the lowest aligned offset that does
+// not overlap any placed request conflicting with it.
+StaticMemoryPlan PlanStaticMemory(
+    const std::vector<StaticMemoryRequest>& requests,
+    const std::function<bool(size_t, size_t)>& op_happens_before,
+    size_t alignment);
+
+}  // namespace interpreter
+}  // namespace framework
+}  // namespace paddle
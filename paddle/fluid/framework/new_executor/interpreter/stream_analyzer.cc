@@ -14,12 +14,21 @@
 
 #include "paddle/fluid/framework/new_executor/interpreter/stream_analyzer.h"
 
+#include <algorithm>
+#include <functional>
 #include <future>
+#include <limits>
+#include <sstream>
 #include <unordered_set>
 
 #include "paddle/fluid/framework/new_executor/instruction/instruction_base.h"
 #include "paddle/fluid/framework/new_executor/interpreter/interpreter_util.h"
+#include "paddle/fluid/pir/dialect/kernel/ir/kernel_attribute.h"
+#include "paddle/fluid/pir/dialect/kernel/ir/kernel_dialect.h"
+#include "paddle/fluid/pir/dialect/kernel/ir/kernel_type.h"
 #include "paddle/phi/core/platform/device_context.h"
+#include "paddle/pir/include/core/block.h"
+#include "paddle/pir/include/core/builtin_attribute.h"
 #if defined(PADDLE_WITH_NCCL) || defined(PADDLE_WITH_RCCL)
 #include "paddle/common/flags.h"
 #include "paddle/phi/core/distributed/comm_context_manager.h"
@@ -838,6 +847,173 @@ void PirStreamAnalyzer::ShrinkEventInfo(
   shrink_event_info<PirDependencyBuilder>(dependency_builder, event_info_map);
 }
 
+// the prefix of the execution streams assigned by AssignAutoStreams, which can
+// be reassigned while the other execution streams are set by the users
+constexpr const char* kAutoStreamPrefix = "AutoStream";
+
+void PirStreamAnalyzer::AssignAutoStreams(
+    const pir::Block* block,
+    int num_streams,
+    const std::unordered_map<const pir::Operation*, double>& op_costs) const {
+  if (num_streams <= 1 || !phi::is_gpu_place(place_)) {
+    return;
+  }
+
+  auto IsCandidate = [](pir::Operation* op) {
+    if (op->dialect()->name() != paddle::dialect::KernelDialect::name() ||
+        op->num_regions() > 0) {
+      return false;
+    }
+    const auto& attrs = op->attributes();
+    if (attrs.count("op_name") == 0 || attrs.count("kernel_key") == 0 ||
+        attrs.count("ring_id") != 0) {
+      return false;
+    }
+    auto kernel_key =
+        attrs.at("kernel_key").dyn_cast<dialect::KernelAttribute>().data();
+    if (phi::TransToPhiPlace(kernel_key.backend()).GetType() !=
+        phi::AllocationType::GPU) {
+      return false;
+    }
+    // the copies and the sync kernels keep their streams
+    auto op_name = attrs.at("op_name").dyn_cast<pir::StrAttribute>().AsString();
+    if (op_name.find("memcpy") != std::string::npos ||
+        op_name == "pd_op.coalesce_tensor") {
+      return false;
+    }
+    if (attrs.count("execution_stream") == 0) {
+      return true;
+    }
+    auto stream =
+        attrs.at("execution_stream").dyn_cast<pir::StrAttribute>().AsString();
+    return stream == kDefaultStream || stream.rfind(kAutoStreamPrefix, 0) == 0;
+  };
+
+  std::vector<pir::Operation*> ops;
+  std::unordered_map<const pir::Operation*, size_t> op_index;
+  for (auto& op : *block) {
+    if (IsCandidate(&op)) {
+      op_index[&op] = ops.size();
+      ops.push_back(&op);
+    }
+  }
+  if (ops.size() < 2) {
+    return;
+  }
+
+  // the profiled time, or else the numel of the outputs
+  std::vector<double> costs(ops.size(), 0.);
+  double profiled_sum = 0.;
+  size_t profiled_num = 0;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    auto it = op_costs.find(ops[i]);
+    if (it != op_costs.end() && it->second > 0.) {
+      costs[i] = it->second;
+      profiled_sum += it->second;
+      ++profiled_num;
+    }
+  }
+  for (size_t i = 0; i < ops.size(); ++i) {
+    if (costs[i] > 0.) continue;
+    if (profiled_num > 0) {
+      costs[i] = profiled_sum / static_cast<double>(profiled_num);
+      continue;
+    }
+    double numel = 0.;
+    for (uint32_t j = 0; j < ops[i]->num_results(); ++j) {
+      auto type = ops[i]
+                      ->result(j)
+                      .type()
+                      .dyn_cast<paddle::dialect::AllocatedDenseTensorType>();
+      if (!type) continue;
+      double result_numel = 1.;
+      for (int k = 0; k < type.dims().size(); ++k) {
+        result_numel *=
+            static_cast<double>(std::max<int64_t>(type.dims()[k], 1));
+      }
+      numel += result_numel;
+    }
+    costs[i] = std::max(numel, 1.);
+  }
+  double mean_cost = 0.;
+  for (auto cost : costs) {
+    mean_cost += cost;
+  }
+  mean_cost /= static_cast<double>(costs.size());
+  // the latency of waiting an event of another stream
+  const double event_cost = 0.05 * mean_cost;
+
+  // the producers of an op, looking through the builtin ops like combine
+  std::function<void(pir::Value, std::vector<size_t>*)> CollectProducers =
+      [&](pir::Value value, std::vector<size_t>* producers) {
+        if (!value) return;
+        auto* def = value.defining_op();
+        if (def == nullptr) return;
+        auto it = op_index.find(def);
+        if (it != op_index.end()) {
+          producers->push_back(it->second);
+        } else if (def->dialect()->name() == "builtin") {
+          for (uint32_t i = 0; i < def->num_operands(); ++i) {
+            CollectProducers(def->operand_source(i), producers);
+          }
+        }
+      };
+
+  std::vector<double> stream_free(num_streams, 0.);
+  std::vector<double> finish(ops.size(), 0.);
+  std::vector<int> assigned(ops.size(), 0);
+  std::vector<size_t> stream_op_num(num_streams, 0);
+  for (size_t i = 0; i < ops.size(); ++i) {
+    std::vector<size_t> producers;
+    for (uint32_t j = 0; j < ops[i]->num_operands(); ++j) {
+      CollectProducers(ops[i]->operand_source(j), &producers);
+    }
+
+    int best_stream = 0;
+    double best_finish = std::numeric_limits<double>::max();
+    size_t best_events = std::numeric_limits<size_t>::max();
+    for (int s = 0; s < num_streams; ++s) {
+      double start = stream_free[s];
+      size_t events = 0;
+      for (auto p : producers) {
+        bool cross = assigned[p] != s;
+        start = std::max(start, finish[p] + (cross ? event_cost : 0.));
+        events += cross ? 1 : 0;
+      }
+      double end = start + costs[i];
+      // the ties go to the stream with less events
+      if (end < best_finish - 1e-6 * mean_cost ||
+          (end <= best_finish + 1e-6 * mean_cost && events < best_events)) {
+        best_stream = s;
+        best_finish = end;
+        best_events = events;
+      }
+    }
+    assigned[i] = best_stream;
+    finish[i] = best_finish;
+    stream_free[best_stream] = best_finish;
+    ++stream_op_num[best_stream];
+  }
+
+  auto* ctx = pir::IrContext::Instance();
+  for (size_t i = 0; i < ops.size(); ++i) {
+    std::string stream =
+        assigned[i] == 0 ? std::string(kDefaultStream)
+                         : kAutoStreamPrefix + std::to_string(assigned[i]);
+    ops[i]->set_attribute("execution_stream",
+                          pir::StrAttribute::get(ctx, stream));
+  }
+  if (VLOG_IS_ON(4)) {
+    std::stringstream ss;
+    for (int s = 0; s < num_streams; ++s) {
+      ss << stream_op_num[s] << " ";
+    }
+    VLOG(4) << "Assign " << ops.size() << " kernels to " << num_streams
+            << " streams: " << ss.str() << ", makespan "
+            << *std::max_element(stream_free.begin(), stream_free.end());
+  }
+}
+
 platform::DeviceType PirStreamAnalyzer::GetWaiterType(
     const paddle::framework::InstructionBase* instr) const {
   if (instr->KernelType() == OpFuncType::kCpuSync) {
@@ -22,6 +22,11 @@
 #include "paddle/phi/core/platform/device_context.h"
 #include "paddle/phi/core/platform/device_event.h"
 
+namespace pir {
+class Block;
+class Operation;
+}  // namespace pir
+
 namespace paddle {
 namespace framework {
 namespace interpreter {
@@ -144,6 +149,17 @@ class PirStreamAnalyzer {
 
   void ShareEventInfoFrom(const PirStreamAnalyzer& src);
 
+  // Assigns the async GPU kernels of the block to num_streams streams by the
+  // list scheduling of their data dependencies, where a kernel runs on the
+  // stream it finishes earliest on and prefers the streams of its producers
+  // to save the events. The kernels off the default stream are marked by
+  // their execution_stream. The cost of a kernel is its profiled time in
+  // op_costs if any, or else the numel of its outputs.
+  void AssignAutoStreams(
+      const pir::Block* block,
+      int num_streams,
+      const std::unordered_map<const pir::Operation*, double>& op_costs) const;
+
   void SetForceEventsToWaitInfo(
       std::unordered_map<std::string, std::shared_ptr<EventInter>>*
           program_force_events_to_wait) {
@@ -43,6 +43,7 @@ PD_DECLARE_bool(new_executor_use_inplace);
 PD_DECLARE_bool(new_executor_use_local_scope);
 
 COMMON_DECLARE_bool(check_nan_inf);
+COMMON_DECLARE_bool(check_nan_inf_lazy);
 COMMON_DECLARE_bool(benchmark);
 COMMON_DECLARE_uint64(executor_log_deps_every_microseconds);
 COMMON_DECLARE_bool(new_executor_use_cuda_graph);
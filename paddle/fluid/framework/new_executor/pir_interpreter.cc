@@ -14,18 +14,24 @@
 
 #include "paddle/fluid/framework/new_executor/pir_interpreter.h"
 
+#include <algorithm>
 #include <chrono>
 #include <unordered_set>
 
 #include "paddle/common/flags.h"
 
 #include "paddle/fluid/framework/details/nan_inf_utils.h"
+#include "paddle/fluid/framework/new_executor/interpreter/build_cache.h"
 #include "paddle/fluid/framework/new_executor/interpreter/interpreter_util.h"
 #include "paddle/fluid/framework/new_executor/interpreter/static_build.h"
+#include "paddle/fluid/framework/new_executor/interpreter/static_memory_planner.h"
 #include "paddle/fluid/framework/operator.h"
 #include "paddle/fluid/platform/profiler/supplement_tracing.h"
 #include "paddle/phi/common/place.h"
 #include "paddle/phi/core/kernel_context.h"
+#include "paddle/phi/core/memory/allocation_recorder.h"
+#include "paddle/phi/core/memory/malloc.h"
+#include "paddle/phi/core/memory/memcpy.h"
 #include "paddle/phi/core/os_info.h"
 #include "paddle/phi/core/platform/device/gpu/gpu_info.h"
 #include "paddle/phi/core/platform/profiler/event_tracing.h"
@@ -90,6 +96,15 @@ COMMON_DECLARE_bool(enable_pir_in_executor_trace_run);
 COMMON_DECLARE_bool(enable_collect_shape);
 COMMON_DECLARE_int32(low_precision_op_list);
 COMMON_DECLARE_bool(pir_interpreter_record_stream_for_gc_cache);
+COMMON_DECLARE_bool(pir_interpreter_critical_path_scheduling);
+COMMON_DECLARE_int32(pir_interpreter_auto_stream_num);
+COMMON_DECLARE_bool(pir_interpreter_static_memory_plan);
+COMMON_DECLARE_int32(pir_interpreter_memory_pressure_window);
+COMMON_DECLARE_int32(pir_interpreter_dynamic_memory_plan_buckets);
+COMMON_DECLARE_int32(executor_instruction_profile_every);
+COMMON_DECLARE_bool(new_executor_segmented_cuda_graph);
+COMMON_DECLARE_bool(use_cuda_managed_memory);
+COMMON_DECLARE_uint64(cuda_managed_memory_prefetch_min_size_in_mb);
 
 #define CREATE_INSTR(instr_name)                                   \
   vec_instruction_base_.emplace_back(std::make_unique<instr_name>( \
@@ -97,6 +112,44 @@ COMMON_DECLARE_bool(pir_interpreter_record_stream_for_gc_cache);
 
 namespace paddle::framework {
 
+#ifdef PADDLE_WITH_CUDA
+// Migrates the large inputs of a GPU instruction to its GPU in bulk, on its
+// stream, instead of letting its kernels fault them in page by page.
+static void PrefetchManagedMemoryInputs(
+    const InstructionBase* instr, const ValueExecutionInfo* value_exe_info) {
+  const auto& dev_ctx =
+      reinterpret_cast<const phi::GPUContext&>(instr->DeviceContext());
+  int device = dev_ctx.GetPlace().GetDeviceId();
+  static const std::vector<bool> supported = [] {
+    std::vector<bool> supported;
+    for (int i = 0; i < platform::GetGPUDeviceCount(); ++i) {
+      supported.push_back(
+          platform::IsGPUManagedMemoryOversubscriptionSupported(i));
+    }
+    return supported;
+  }();
+  if (!supported.at(device)) {
+    return;
+  }
+  size_t min_size = FLAGS_cuda_managed_memory_prefetch_min_size_in_mb << 20;
+  for (const auto& pair : instr->Inputs()) {
+    for (int var_id : pair.second) {
+      auto* var = value_exe_info->GetVarList()[var_id];
+      if (var == nullptr || !var->IsType<phi::DenseTensor>()) {
+        continue;
+      }
+      const auto& holder = var->Get<phi::DenseTensor>().Holder();
+      if (holder == nullptr || !phi::is_gpu_place(holder->place()) ||
+          holder->size() < min_size) {
+        continue;
+      }
+      PADDLE_ENFORCE_GPU_SUCCESS(cudaMemPrefetchAsync(
+          holder->ptr(), holder->size(), device, dev_ctx.stream()));
+    }
+  }
+}
+#endif
+
 void RecordLowPrecisionOp(const InstructionBase* instr_node) {
   if (FLAGS_low_precision_op_list) {
     std::string op_name = instr_node->Name();
@@ -197,6 +250,12 @@ PirInterpreter::PirInterpreter(const phi::Place& place,
     SchedulingPriority rhs_scheduling_priority =
         vec_instruction_base_[rhs]->GetSchedulingPriority();
     if (lhs_scheduling_priority == rhs_scheduling_priority) {
+      // NOTE: instructions with a longer remaining critical path run first
+      // when critical path scheduling is enabled.
+      if (!critical_path_depth_.empty() &&
+          critical_path_depth_[lhs] != critical_path_depth_[rhs]) {
+        return critical_path_depth_[lhs] < critical_path_depth_[rhs];
+      }
       return lhs > rhs;
     }
     return lhs_scheduling_priority > rhs_scheduling_priority;
@@ -288,6 +347,12 @@ PirInterpreter::PirInterpreter(
     SchedulingPriority rhs_scheduling_priority =
         vec_instruction_base_[rhs]->GetSchedulingPriority();
     if (lhs_scheduling_priority == rhs_scheduling_priority) {
+      // NOTE: instructions with a longer remaining critical path run first
+      // when critical path scheduling is enabled.
+      if (!critical_path_depth_.empty() &&
+          critical_path_depth_[lhs] != critical_path_depth_[rhs]) {
+        return critical_path_depth_[lhs] < critical_path_depth_[rhs];
+      }
       return lhs > rhs;
     }
     return lhs_scheduling_priority > rhs_scheduling_priority;
@@ -306,6 +371,13 @@ PirInterpreter::~PirInterpreter() {
   gc_.reset(nullptr);
   async_work_queue_.reset();
   VLOG(4) << "~PirInterpreter(): " << this << " on " << place_;
+  if (instruction_profiler_ && instruction_profiler_->num_sampled_runs() > 0) {
+    std::vector<std::string> names;
+    for (auto& instr : vec_instruction_base_) {
+      names.push_back(instr->Name());
+    }
+    LOG(INFO) << instruction_profiler_->Report(names, /*top_k=*/20);
+  }
 
 #ifdef PADDLE_WITH_DNNL
   // Clear mkl-dnn cache,
@@ -479,6 +551,196 @@ void PirInterpreter::CheckCUDAGraphBeforeRun(
 #endif
 }
 
+bool PirInterpreter::UseSegmentedCUDAGraph() {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  // the graphs are captured by the caller if it is capturing already
+  if (!FLAGS_new_executor_use_cuda_graph ||
+      !FLAGS_new_executor_segmented_cuda_graph ||
+      !phi::is_gpu_place(place_) || platform::IsCUDAGraphCapturing()) {
+    return false;
+  }
+  if (!cuda_graph_segments_built_) {
+    BuildCUDAGraphSegments();
+    cuda_graph_segments_built_ = true;
+  }
+  return !cuda_graph_segments_.empty();
+#else
+  return false;
+#endif
+}
+
+bool PirInterpreter::IsCUDAGraphHostInstruction(InstructionBase* instr) const {
+  // the control flow decides on host, and the sync and cpu instructions would
+  // not be run by the replay
+  if (instr->KernelType() != OpFuncType::kGpuAsync) {
+    return true;
+  }
+  return dynamic_cast<IfInstruction*>(instr) != nullptr ||
+         dynamic_cast<WhileInstruction*>(instr) != nullptr ||
+         dynamic_cast<PyLayerInstruction*>(instr) != nullptr ||
+         dynamic_cast<AssertInstruction*>(instr) != nullptr ||
+         dynamic_cast<HasElementsInstruction*>(instr) != nullptr ||
+         dynamic_cast<SelectInputInstruction*>(instr) != nullptr ||
+         dynamic_cast<SelectOutputInstruction*>(instr) != nullptr ||
+         dynamic_cast<TuplePushInstruction*>(instr) != nullptr ||
+         dynamic_cast<TuplePopInstruction*>(instr) != nullptr ||
+         dynamic_cast<YieldInstruction*>(instr) != nullptr;
+}
+
+void PirInterpreter::BuildCUDAGraphSegments() {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  cuda_graph_segments_.clear();
+  // the graphs are captured on the default stream, so that they are ordered
+  // with the host instructions without the events of the stream analyzer
+  auto* default_dev_ctx = phi::DeviceContextPool::Instance().Get(place_);
+  for (auto& instr : vec_instruction_base_) {
+    if (!IsCUDAGraphHostInstruction(instr.get()) &&
+        &instr->DeviceContext() != default_dev_ctx) {
+      VLOG(4) << "Skip segmented cuda graph since " << instr->Name()
+              << " is not run on the default stream";
+      return;
+    }
+  }
+
+  size_t begin = 0;
+  for (size_t idx = 0; idx <= trace_execute_order_.size(); ++idx) {
+    if (idx < trace_execute_order_.size() &&
+        !IsCUDAGraphHostInstruction(
+            vec_instruction_base_.at(trace_execute_order_[idx]).get())) {
+      continue;
+    }
+    if (idx > begin) {
+      CUDAGraphSegment segment;
+      segment.begin = begin;
+      segment.end = idx;
+      cuda_graph_segments_.emplace_back(std::move(segment));
+    }
+    begin = idx + 1;
+  }
+  VLOG(4) << "Build " << cuda_graph_segments_.size()
+          << " cuda graph segments for " << trace_execute_order_.size()
+          << " instructions";
+#endif
+}
+
+void PirInterpreter::TraceRunCUDAGraphSegments() {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  auto RunTrace = [this](size_t begin, size_t end) {
+    for (size_t idx = begin; idx < end; ++idx) {
+      auto instr_id = trace_execute_order_[idx];
+      InstructionBase* instr_node = vec_instruction_base_.at(instr_id).get();
+      VLOG(6) << "Run InstructionBase " << instr_node->Name() << "["
+              << instr_id << "], op id: " << instr_node->Operation()->id();
+      RunInstructionBase(instr_node);
+      if (UNLIKELY(exception_holder_.IsCaught())) {
+        return false;
+      }
+    }
+    return true;
+  };
+  auto GetTensor = [this](int var_id) -> const phi::DenseTensor* {
+    auto* var = value_exe_info_->GetVarList().at(var_id);
+    if (var == nullptr || !var->IsType<phi::DenseTensor>() ||
+        !var->Get<phi::DenseTensor>().IsInitialized()) {
+      return nullptr;
+    }
+    return &var->Get<phi::DenseTensor>();
+  };
+  auto* dev_ctx = static_cast<phi::GPUContext*>(
+      phi::DeviceContextPool::Instance().Get(place_));
+
+  size_t idx = 0;
+  for (auto& segment : cuda_graph_segments_) {
+    if (!RunTrace(idx, segment.begin)) {
+      return;
+    }
+    idx = segment.end;
+
+    if (segment.graph == nullptr) {
+      std::unordered_set<int> written;
+      std::unordered_set<int> visited;
+      for (size_t i = segment.begin; i < segment.end; ++i) {
+        auto* instr = vec_instruction_base_.at(trace_execute_order_[i]).get();
+        for (auto& item : instr->Inputs()) {
+          for (auto var_id : item.second) {
+            auto* tensor = GetTensor(var_id);
+            if (tensor != nullptr && !written.count(var_id) &&
+                visited.insert(var_id).second) {
+              segment.inputs.emplace_back(var_id, *tensor);
+            }
+          }
+        }
+        for (auto& item : instr->Outputs()) {
+          written.insert(item.second.begin(), item.second.end());
+        }
+      }
+
+#ifdef PADDLE_WITH_HIP
+      platform::BeginCUDAGraphCapture(
+          place_, hipStreamCaptureModeThreadLocal, cuda_graph_pool_id_);
+#else
+      platform::BeginCUDAGraphCapture(
+          place_, cudaStreamCaptureModeThreadLocal, cuda_graph_pool_id_);
+#endif
+      bool finished = RunTrace(segment.begin, segment.end);
+      segment.graph = platform::EndCUDAGraphCapture();
+      if (!finished) {
+        segment.graph.reset();
+        segment.inputs.clear();
+        return;
+      }
+      cuda_graph_pool_id_ = segment.graph->PoolID();
+
+      // the tensors still held after the segment are used after it
+      for (auto var_id : written) {
+        auto* tensor = GetTensor(var_id);
+        if (tensor != nullptr) {
+          segment.outputs.emplace_back(var_id, *tensor);
+        }
+      }
+    } else {
+      for (auto& input : segment.inputs) {
+        auto* tensor = GetTensor(input.first);
+        if (tensor == nullptr || tensor->IsSharedBufferWith(input.second)) {
+          continue;
+        }
+        PADDLE_ENFORCE_EQ(
+            tensor->dims() == input.second.dims() &&
+                tensor->dtype() == input.second.dtype(),
+            true,
+            common::errors::PreconditionNotMet(
+                "The input %s of the captured cuda graph segment is changed "
+                "from [%s] of %s to [%s] of %s, which can not be replayed.",
+                value_exe_info_->GetNameById(input.first),
+                input.second.dims(),
+                input.second.dtype(),
+                tensor->dims(),
+                tensor->dtype()));
+        memory::Copy(place_,
+                     input.second.data(),
+                     tensor->place(),
+                     tensor->data(),
+                     tensor->numel() * phi::SizeOf(tensor->dtype()),
+                     dev_ctx->stream());
+      }
+    }
+
+    VLOG(6) << "Replay cuda graph segment [" << segment.begin << ", "
+            << segment.end << ")";
+    segment.graph->Replay();
+    for (auto& output : segment.outputs) {
+      auto* tensor = value_exe_info_->GetVarList()
+                         .at(output.first)
+                         ->GetMutable<phi::DenseTensor>();
+      if (!tensor->IsSharedBufferWith(output.second)) {
+        tensor->ShareDataWith(output.second);
+      }
+    }
+  }
+  RunTrace(idx, trace_execute_order_.size());
+#endif
+}
+
 void PirInterpreter::ClearDenseTensorArrayInLocalScope() {
   auto vars = local_scope_->LocalVars();
   for (auto var : vars) {
@@ -810,6 +1072,12 @@ void PirInterpreter::AnalyzeForceSyncOps() {
 void PirInterpreter::BuildInstruction() {
   VLOG(6) << "Build Instructions for pir ... ";
   vec_instruction_base_.clear();
+  ir_stream_analyzer_.AssignAutoStreams(
+      ir_block_, FLAGS_pir_interpreter_auto_stream_num, auto_stream_op_costs_);
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  cuda_graph_segments_.clear();
+  cuda_graph_segments_built_ = false;
+#endif
   size_t op_idx = 0;
   for (auto& op : *ir_block_) {
     VLOG(6) << "Build Instruction for op: " << op_idx;
@@ -1101,7 +1369,32 @@ void PirInterpreter::BuildInstructionDependences() {
   for (auto& instr : vec_instruction_base_) {
     instructions_ptr.push_back(instr.get());
   }
+  std::string build_cache_key;
+  if (!is_shared_results_build_ && interpreter::PirBuildCache::IsEnabled()) {
+    build_cache_key = interpreter::PirBuildCache::CacheKey(
+        *ir_block_, instructions_ptr, place_);
+    interpreter::PirBuildCache::DependencyInfo dependency_info;
+    if (interpreter::PirBuildCache::LoadDependency(
+            build_cache_key, instr_num, &dependency_info)) {
+      ir_dependency_builder_.LoadDependency(instructions_ptr,
+                                            dependency_info.op_downstream_map,
+                                            dependency_info.op_happens_before);
+      build_cache_key.clear();
+    }
+  }
   auto downstream_map = ir_dependency_builder_.Build(instructions_ptr);
+  if (!build_cache_key.empty()) {
+    interpreter::PirBuildCache::DependencyInfo dependency_info;
+    std::tie(dependency_info.op_downstream_map,
+             dependency_info.op_happens_before) =
+        ir_dependency_builder_.GetDependency();
+    interpreter::PirBuildCache::SaveDependency(build_cache_key,
+                                               dependency_info);
+  }
+
+  if (FLAGS_pir_interpreter_critical_path_scheduling) {
+    AnalyseCriticalPathDepth(downstream_map);
+  }
 
   for (size_t instr_id = 0; instr_id < instr_num; ++instr_id) {
     InstructionBase* cur_instr = vec_instruction_base_[instr_id].get();
@@ -1121,6 +1414,27 @@ void PirInterpreter::BuildInstructionDependences() {
             cur_instr->AddNextInstrInDifferentThread(next_instr_id);
           }
         }
+      } else if (!critical_path_depth_.empty()) {
+        // Keep the downstream instruction with the longest remaining path in
+        // the current thread, the others are left to be stolen by idle
+        // threads.
+        size_t same_thread_instr_id = instr_num;
+        for (size_t next_instr_id : next_instr_ids) {
+          if (vec_instruction_base_[next_instr_id]->KernelType() !=
+                  OpFuncType::kGpuAsync &&
+              (same_thread_instr_id == instr_num ||
+               critical_path_depth_[next_instr_id] >
+                   critical_path_depth_[same_thread_instr_id])) {
+            same_thread_instr_id = next_instr_id;
+          }
+        }
+        for (size_t next_instr_id : next_instr_ids) {
+          if (next_instr_id == same_thread_instr_id) {
+            cur_instr->AddNextInstrInSameThread(next_instr_id);
+          } else {
+            cur_instr->AddNextInstrInDifferentThread(next_instr_id);
+          }
+        }
       } else {
         bool has_instr_in_same_thread = false;
         for (size_t next_instr_id : next_instr_ids) {
@@ -1144,6 +1458,55 @@ void PirInterpreter::BuildInstructionDependences() {
   }
 }
 
+void PirInterpreter::AnalyseCriticalPathDepth(
+    const std::map<size_t, std::set<size_t>>& op_downstream_map) {
+  // critical_path_depth_[i] is the number of instructions on the longest path
+  // from the i-th instruction to the end of the program (including itself).
+  // Downstream instructions always have larger ids, so a reverse traversal
+  // visits every instruction after all of its downstream instructions.
+  size_t instr_num = vec_instruction_base_.size();
+  critical_path_depth_.assign(instr_num, 1);
+  for (size_t instr_id = instr_num; instr_id-- > 0;) {
+    auto iter = op_downstream_map.find(instr_id);
+    if (iter == op_downstream_map.end()) {
+      continue;
+    }
+    for (size_t next_instr_id : iter->second) {
+      PADDLE_ENFORCE_GT(
+          next_instr_id,
+          instr_id,
+          common::errors::PreconditionNotMet(
+              "The downstream instruction id (%d) should be greater than the "
+              "upstream instruction id (%d).",
+              next_instr_id,
+              instr_id));
+      critical_path_depth_[instr_id] =
+          std::max(critical_path_depth_[instr_id],
+                   critical_path_depth_[next_instr_id] + 1);
+    }
+  }
+  VLOG(4) << "Critical path length of the program: "
+          << (instr_num == 0 ? 0
+                             : *std::max_element(critical_path_depth_.begin(),
+                                                 critical_path_depth_.end()));
+}
+
+void PirInterpreter::DispatchReadyInstructions(
+    std::vector<size_t>* ready_instr_ids) {
+  // Sort in ascending priority. Tasks added by a worker thread are pushed to
+  // the front of its own RunQueue, so the most critical instruction is popped
+  // first by the current thread, while the less critical ones stay at the back
+  // of the queue where idle threads steal from.
+  std::sort(ready_instr_ids->begin(),
+            ready_instr_ids->end(),
+            ir_instruction_scheduling_priority_less);
+  for (size_t instr_id : *ready_instr_ids) {
+    async_work_queue_->AddTask(
+        vec_instruction_base_[instr_id]->KernelType(),
+        [this, instr_id]() { RunInstructionBaseAsync(instr_id); });
+  }
+}
+
 void PirInterpreter::RecordMemcpyD2H(InstructionBase* instr_node) {
   // NOTE(zhiqiu): hot fix for jit input var
   if (instr_node->Name() == "pd_op.memcpy_d2h") {
@@ -1317,6 +1680,13 @@ void PirInterpreter::CheckGC(InstructionBase* instr) {
     VLOG(4) << "GC:" << value_exe_info_->GetNameById(static_cast<int>(var_id))
             << ", id:" << var_id << ", ref:" << refs_[var_id]->DynamicRef();
     bool is_ready = refs_[var_id]->CheckAndDecrease();
+    // the memory of statically planned var is reused across steps
+    if (!static_planned_vars_.empty() && static_planned_vars_[var_id]) {
+      continue;
+    }
+    if (!dynamic_planned_vars_.empty() && dynamic_planned_vars_[var_id]) {
+      continue;
+    }
     // ignore all persistable var while GCphi
     if (parameter_var_names_.count(
             value_exe_info_->GetNameById(static_cast<int>(var_id)))) {
@@ -1456,6 +1826,447 @@ void PirInterpreter::CalculateLastLiveOps() {
   VLOG(4) << "done CalculateLastLiveOps";
 }
 
+void PirInterpreter::PlanStaticMemory() {
+  static_planned_vars_.clear();
+  static_memory_sizes_.clear();
+  static_memory_holders_.clear();
+  static_memory_arena_.reset();
+  dynamic_memory_candidates_.clear();
+  dynamic_memory_data_vars_.clear();
+  dynamic_memory_plans_.clear();
+  dynamic_memory_bucket_.clear();
+  dynamic_planned_vars_.clear();
+  dynamic_bound_vars_.clear();
+  dynamic_memory_arena_.reset();
+
+  // NOTE: the variables of sub blocks are managed by their own interpreters,
+  // the lifetime of a variable used by control flow op can not be described
+  // by the dependency of the current block.
+  for (auto& instr : vec_instruction_base_) {
+    if (instr->Operation() && instr->Operation()->num_regions() > 0) {
+      VLOG(4) << "Skip static memory plan since the program contains "
+              << instr->Name();
+      return;
+    }
+  }
+
+  const std::unordered_set<std::string> skip_op_names = {
+      "pd_op.feed",
+      "pd_op.data",
+      "pd_op.fetch",
+      "pd_op.shadow_feed",
+      "pd_op.shadow_feed_tensors",
+      "pd_op.share_data_",
+      "builtin.shadow_output",
+      "cf.yield"};
+
+  size_t var_num = value_exe_info_->GetVarList().size();
+  std::vector<int> writer_num(var_num, 0);
+  std::vector<size_t> writer(var_num, 0);
+  std::vector<bool> can_plan(var_num, true);
+  for (size_t op_idx = 0; op_idx < vec_instruction_base_.size(); ++op_idx) {
+    InstructionBase* instr = vec_instruction_base_[op_idx].get();
+    bool skip_instr = skip_op_names.count(instr->Name()) > 0;
+    for (auto& item : instr->Outputs()) {
+      for (int var_id : item.second) {
+        ++writer_num[var_id];
+        writer[var_id] = op_idx;
+        can_plan[var_id] = can_plan[var_id] && !skip_instr;
+      }
+    }
+    for (auto& item : instr->Inputs()) {
+      for (int var_id : item.second) {
+        // the var both written and read by one op is inplaced by var
+        bool is_inplace = writer_num[var_id] > 0 && writer[var_id] == op_idx;
+        can_plan[var_id] = can_plan[var_id] && !skip_instr && !is_inplace;
+      }
+    }
+    // the var pairs of inplace and view ops share one holder
+    for (auto& pair : instr->InplaceInfo()) {
+      can_plan[value_exe_info_->GetVarId(pair.first)] = false;
+      can_plan[value_exe_info_->GetVarId(pair.second)] = false;
+    }
+  }
+
+  // the multiple values mapping to one var are inplace values, and the values
+  // used by the ops out of instructions (such as shadow_output) escape from
+  // the interpreter
+  std::vector<int> value_num(var_num, 0);
+  std::vector<pir::Value> var_values(var_num);
+  for (auto& kv : value_exe_info_->GetValue2VarName()) {
+    int var_id = value_exe_info_->GetVarId(kv.first);
+    if (var_id < 0) {
+      continue;
+    }
+    ++value_num[var_id];
+    var_values[var_id] = kv.first;
+    for (auto it = kv.first.use_begin(); it != kv.first.use_end(); ++it) {
+      if (skip_op_names.count(it->owner()->name())) {
+        can_plan[var_id] = false;
+      }
+    }
+  }
+
+  std::vector<interpreter::StaticMemoryRequest> requests;
+  for (size_t var_id = 0; var_id < var_num; ++var_id) {
+    if (!can_plan[var_id] || writer_num[var_id] != 1 ||
+        value_num[var_id] != 1 || last_live_ops_[var_id].empty()) {
+      continue;
+    }
+    const std::string& var_name =
+        value_exe_info_->GetNameById(static_cast<int>(var_id));
+    if (parameter_var_names_.count(var_name) ||
+        execution_config_.skip_gc_vars.count(var_name) ||
+        JitInputVars().count(var_name) ||
+        std::find(fetch_var_names_.begin(), fetch_var_names_.end(), var_name) !=
+            fetch_var_names_.end()) {
+      continue;
+    }
+    Variable* var = value_exe_info_->GetVarList()[var_id];
+    pir::Value value = var_values[var_id];
+    if (!var->IsType<phi::DenseTensor>() || !value.type() ||
+        !value.type().isa<paddle::dialect::AllocatedDenseTensorType>()) {
+      continue;
+    }
+    auto type =
+        value.type().dyn_cast<paddle::dialect::AllocatedDenseTensorType>();
+    phi::DataType dtype = paddle::dialect::TransToPhiDataType(type.dtype());
+    if (type.place() != place_ || dtype == phi::DataType::UNDEFINED) {
+      continue;
+    }
+    if (common::contain_unknown_dim(type.dims())) {
+      if (FLAGS_pir_interpreter_dynamic_memory_plan_buckets > 0) {
+        dynamic_memory_candidates_.push_back(
+            {var_id, 0, writer[var_id], last_live_ops_[var_id]});
+      }
+      continue;
+    }
+    if (!FLAGS_pir_interpreter_static_memory_plan) {
+      continue;
+    }
+    requests.push_back(
+        {var_id,
+         static_cast<size_t>(common::product(type.dims())) * phi::SizeOf(dtype),
+         writer[var_id],
+         last_live_ops_[var_id]});
+  }
+
+  // the bucket is known before running only if the inputs are fed to the data
+  // ops, the feed ops read them while running
+  for (size_t op_idx = 0; op_idx < vec_instruction_base_.size(); ++op_idx) {
+    InstructionBase* instr = vec_instruction_base_[op_idx].get();
+    if (instr->Name() == "pd_op.feed") {
+      VLOG(4) << "Skip dynamic memory plan since the program contains "
+              << instr->Name();
+      dynamic_memory_candidates_.clear();
+      dynamic_memory_data_vars_.clear();
+      break;
+    }
+    if (instr->Name() == "pd_op.data") {
+      for (auto& item : instr->Outputs()) {
+        for (int var_id : item.second) {
+          dynamic_memory_data_vars_.push_back(var_id);
+        }
+      }
+    }
+  }
+  dynamic_planned_vars_.assign(var_num, false);
+  VLOG(2) << "Dynamic memory plan candidates: "
+          << dynamic_memory_candidates_.size();
+
+  if (requests.empty()) {
+    return;
+  }
+
+  static_memory_plan_ = interpreter::PlanStaticMemory(
+      requests,
+      [this](size_t prior_op_idx, size_t posterior_op_idx) {
+        return ir_dependency_builder_.OpHappensBefore(prior_op_idx,
+                                                      posterior_op_idx);
+      },
+      kStaticMemoryPlanAlignment);
+  static_planned_vars_.assign(var_num, false);
+  for (auto& request : requests) {
+    static_planned_vars_[request.var_id] = true;
+    static_memory_sizes_[request.var_id] = request.size;
+  }
+  VLOG(2) << "Static memory plan of " << requests.size()
+          << " vars, arena size: " << static_memory_plan_.arena_size;
+}
+
+void PirInterpreter::PlanMemoryPressureChecks() {
+  memory_pressure_checks_.clear();
+  if (!phi::is_gpu_place(place_)) {
+    return;
+  }
+  // The outputs with static shape are what the instructions are expected to
+  // allocate, except for the vars in the static memory arena.
+  std::vector<size_t> alloc_bytes(vec_instruction_base_.size(), 0);
+  for (size_t op_idx = 0; op_idx < vec_instruction_base_.size(); ++op_idx) {
+    for (auto& item : vec_instruction_base_[op_idx]->Outputs()) {
+      pir::Value value = item.first;
+      if (!value || !value.type() ||
+          !value.type().isa<paddle::dialect::AllocatedDenseTensorType>()) {
+        continue;
+      }
+      bool planned = false;
+      for (int var_id : item.second) {
+        planned = planned ||
+                  (static_cast<size_t>(var_id) < static_planned_vars_.size() &&
+                   static_planned_vars_[var_id]);
+      }
+      auto type =
+          value.type().dyn_cast<paddle::dialect::AllocatedDenseTensorType>();
+      if (planned || type.place() != place_ ||
+          common::contain_unknown_dim(type.dims())) {
+        continue;
+      }
+      phi::DataType dtype = paddle::dialect::TransToPhiDataType(type.dtype());
+      if (dtype == phi::DataType::UNDEFINED) {
+        continue;
+      }
+      alloc_bytes[op_idx] += static_cast<size_t>(common::product(type.dims())) *
+                             phi::SizeOf(dtype);
+    }
+  }
+
+  const size_t window =
+      static_cast<size_t>(FLAGS_pir_interpreter_memory_pressure_window);
+  for (size_t begin = 0; begin < trace_execute_order_.size(); begin += window) {
+    size_t end = std::min(begin + window, trace_execute_order_.size());
+    size_t bytes = 0;
+    for (size_t idx = begin; idx < end; ++idx) {
+      bytes += alloc_bytes[trace_execute_order_[idx]];
+    }
+    if (bytes > 0) {
+      memory_pressure_checks_[trace_execute_order_[begin]] = bytes;
+    }
+  }
+  VLOG(2) << "Check the memory pressure before "
+          << memory_pressure_checks_.size() << " windows of " << window
+          << " instructions";
+}
+
+void PirInterpreter::CheckMemoryPressure(size_t instr_id) {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  auto iter = memory_pressure_checks_.find(instr_id);
+  if (iter == memory_pressure_checks_.end()) {
+    return;
+  }
+  size_t available = 0, total = 0;
+  platform::GpuMemoryUsage(&available, &total);
+  if (available >= iter->second) {
+    return;
+  }
+  VLOG(4) << "The window beginning with instruction " << instr_id
+          << " expects to allocate " << iter->second << " bytes but only "
+          << available << " bytes are free on the device, free the pending "
+          << "garbages and release the idle cached blocks";
+  if (gc_) {
+    gc_->Flush();
+  }
+  memory::Release(place_);
+#endif
+}
+
+void PirInterpreter::BindStaticMemoryPlan() {
+  if (static_planned_vars_.empty()) {
+    return;
+  }
+  if (static_memory_arena_ == nullptr) {
+    static_memory_arena_ =
+        memory::AllocShared(place_, static_memory_plan_.arena_size);
+    auto arena = static_memory_arena_;
+    for (auto& item : static_memory_plan_.offsets) {
+      void* ptr = reinterpret_cast<uint8_t*>(arena->ptr()) + item.second;
+      // the deleter holds the arena, so that the arena is alive as long as any
+      // tensor holds its memory
+      static_memory_holders_[item.first] = std::shared_ptr<phi::Allocation>(
+          new phi::Allocation(
+              ptr, static_memory_sizes_.at(item.first), arena->place()),
+          [arena](phi::Allocation* allocation) { delete allocation; });
+    }
+  }
+
+  for (auto& item : static_memory_holders_) {
+    size_t var_id = item.first;
+    if (!static_planned_vars_[var_id]) {
+      continue;
+    }
+    auto* tensor =
+        value_exe_info_->GetVarList()[var_id]->GetMutable<phi::DenseTensor>();
+    if (tensor->Holder() == item.second) {
+      continue;
+    }
+    if (tensor->initialized() &&
+        tensor->numel() * static_cast<int64_t>(phi::SizeOf(tensor->dtype())) +
+                static_cast<int64_t>(tensor->meta().offset) >
+            static_cast<int64_t>(item.second->size())) {
+      // The kernel produced a larger tensor than the static shape, give the
+      // var back to the garbage collector.
+      VLOG(4) << "Remove var "
+              << value_exe_info_->GetNameById(static_cast<int>(var_id))
+              << " from static memory plan";
+      static_planned_vars_[var_id] = false;
+      continue;
+    }
+    tensor->ResetHolder(item.second);
+  }
+}
+
+std::string PirInterpreter::DynamicMemoryBucket() const {
+  std::string bucket;
+  for (size_t var_id : dynamic_memory_data_vars_) {
+    Variable* var = value_exe_info_->GetVarList()[var_id];
+    if (var->IsType<phi::DenseTensor>()) {
+      bucket += var->Get<phi::DenseTensor>().dims().to_str();
+    }
+    bucket += ";";
+  }
+  return bucket;
+}
+
+void PirInterpreter::BindDynamicMemoryPlan() {
+  recording_dynamic_memory_ = false;
+  if (dynamic_memory_candidates_.empty()) {
+    return;
+  }
+  const auto& var_list = value_exe_info_->GetVarList();
+  // The vars bound to the arena by the last run must give the memory up,
+  // since the arena may be planned for the other vars of this bucket.
+  auto unbind = [&]() {
+    for (size_t var_id : dynamic_bound_vars_) {
+      var_list[var_id]->GetMutable<phi::DenseTensor>()->clear();
+      dynamic_planned_vars_[var_id] = false;
+    }
+    dynamic_bound_vars_.clear();
+  };
+
+  std::string bucket = DynamicMemoryBucket();
+  auto iter = dynamic_memory_plans_.find(bucket);
+  if (bucket != dynamic_memory_bucket_ || iter == dynamic_memory_plans_.end()) {
+    unbind();
+  }
+  dynamic_memory_bucket_ = bucket;
+  if (iter == dynamic_memory_plans_.end()) {
+    size_t max_buckets =
+        static_cast<size_t>(FLAGS_pir_interpreter_dynamic_memory_plan_buckets);
+    if (dynamic_memory_plans_.size() < max_buckets) {
+      VLOG(4) << "Record the dynamic memory of bucket " << bucket;
+      recording_dynamic_memory_ = true;
+      dynamic_memory_record_.assign(var_list.size(), 0);
+    }
+    return;
+  }
+
+  DynamicMemoryPlan& plan = iter->second;
+  if (plan.plan.offsets.empty()) {
+    return;
+  }
+  if (dynamic_memory_arena_ == nullptr ||
+      dynamic_memory_arena_->size() < plan.plan.arena_size) {
+    unbind();
+    dynamic_memory_arena_.reset();
+    dynamic_memory_arena_ = memory::AllocShared(place_, plan.plan.arena_size);
+  }
+  auto arena = dynamic_memory_arena_;
+  std::vector<size_t> removed_vars;
+  for (auto& item : plan.plan.offsets) {
+    size_t var_id = item.first;
+    size_t size = plan.sizes.at(var_id);
+    void* ptr = reinterpret_cast<uint8_t*>(arena->ptr()) + item.second;
+    auto* tensor = var_list[var_id]->GetMutable<phi::DenseTensor>();
+    if (dynamic_planned_vars_[var_id]) {
+      if (tensor->Holder() && tensor->Holder()->ptr() == ptr) {
+        continue;
+      }
+      if (tensor->initialized() &&
+          tensor->numel() * static_cast<int64_t>(phi::SizeOf(tensor->dtype())) +
+                  static_cast<int64_t>(tensor->meta().offset) >
+              static_cast<int64_t>(size)) {
+        // The kernel produced a larger tensor than the recorded one, give the
+        // var back to the garbage collector.
+        removed_vars.push_back(var_id);
+        continue;
+      }
+    }
+    tensor->clear();
+    // the deleter holds the arena, so that the arena is alive as long as any
+    // tensor holds its memory
+    tensor->ResetHolder(std::shared_ptr<phi::Allocation>(
+        new phi::Allocation(ptr, size, arena->place()),
+        [arena](phi::Allocation* allocation) { delete allocation; }));
+    if (!dynamic_planned_vars_[var_id]) {
+      dynamic_planned_vars_[var_id] = true;
+      dynamic_bound_vars_.push_back(var_id);
+    }
+  }
+  for (size_t var_id : removed_vars) {
+    VLOG(4) << "Remove var "
+            << value_exe_info_->GetNameById(static_cast<int>(var_id))
+            << " from dynamic memory plan of bucket " << bucket;
+    plan.plan.offsets.erase(var_id);
+    dynamic_planned_vars_[var_id] = false;
+    dynamic_bound_vars_.erase(std::find(
+        dynamic_bound_vars_.begin(), dynamic_bound_vars_.end(), var_id));
+  }
+}
+
+void PirInterpreter::RecordDynamicMemory(InstructionBase* instr) {
+  for (auto& item : instr->Outputs()) {
+    for (int var_id : item.second) {
+      if (var_id < 0 ||
+          static_cast<size_t>(var_id) >= dynamic_memory_record_.size()) {
+        continue;
+      }
+      Variable* var = value_exe_info_->GetVarList()[var_id];
+      if (!var->IsType<phi::DenseTensor>() ||
+          !var->Get<phi::DenseTensor>().initialized()) {
+        continue;
+      }
+      const auto& tensor = var->Get<phi::DenseTensor>();
+      size_t bytes = static_cast<size_t>(tensor.numel()) *
+                         phi::SizeOf(tensor.dtype()) +
+                     tensor.meta().offset;
+      dynamic_memory_record_[var_id] =
+          std::max(dynamic_memory_record_[var_id], bytes);
+    }
+  }
+}
+
+void PirInterpreter::FinishDynamicMemoryRecord() {
+  if (!recording_dynamic_memory_) {
+    return;
+  }
+  recording_dynamic_memory_ = false;
+  std::vector<interpreter::StaticMemoryRequest> requests;
+  for (auto& candidate : dynamic_memory_candidates_) {
+    size_t size = dynamic_memory_record_[candidate.var_id];
+    if (size > 0) {
+      requests.push_back(candidate);
+      requests.back().size = size;
+    }
+  }
+  DynamicMemoryPlan plan;
+  if (!requests.empty()) {
+    plan.plan = interpreter::PlanStaticMemory(
+        requests,
+        [this](size_t prior_op_idx, size_t posterior_op_idx) {
+          return ir_dependency_builder_.OpHappensBefore(prior_op_idx,
+                                                        posterior_op_idx);
+        },
+        kStaticMemoryPlanAlignment);
+  }
+  for (auto& request : requests) {
+    plan.sizes[request.var_id] = request.size;
+  }
+  VLOG(2) << "Dynamic memory plan of " << requests.size()
+          << " vars for bucket " << dynamic_memory_bucket_
+          << ", arena size: " << plan.plan.arena_size;
+  dynamic_memory_plans_[dynamic_memory_bucket_] = std::move(plan);
+  dynamic_memory_record_.clear();
+}
+
 void PirInterpreter::ConstructEventForJitInput() {
   for (size_t i = 0; i < dependency_count_->size(); ++i) {
     if ((*dependency_count_)[i] == 0) {
@@ -1489,14 +2300,20 @@ paddle::framework::FetchList PirInterpreter::Run(
 
   auto FeedInput = [&] {
     VLOG(4) << "Feed inputs";
+    if (feed_names != cached_feed_names_) {
+      feed_vars_.clear();
+      for (const auto& feed_name : feed_names) {
+        auto* feed_var = InnerScope()->FindVar(feed_name);
+        PADDLE_ENFORCE_NOT_NULL(
+            feed_var,
+            common::errors::NotFound("Variable %s should not be nullptr.",
+                                     feed_name));
+        feed_vars_.push_back(feed_var);
+      }
+      cached_feed_names_ = feed_names;
+    }
     for (size_t i = 0; i < feed_names.size(); ++i) {
-      auto* feed_var = InnerScope()->FindVar(feed_names[i]);
-      PADDLE_ENFORCE_NOT_NULL(
-          feed_var,
-          common::errors::NotFound("Variable %s should not be nullptr.",
-                                   feed_names[i]));
-
-      auto feed_tensor = feed_var->GetMutable<phi::DenseTensor>();
+      auto feed_tensor = feed_vars_[i]->GetMutable<phi::DenseTensor>();
       feed_tensor->ShareDataWith(feed_tensors[i]);
       feed_tensor->set_lod(feed_tensors[i].lod());
     }
@@ -1504,6 +2321,8 @@ paddle::framework::FetchList PirInterpreter::Run(
 
   SetDeviceId(place_);
   CheckCUDAGraphBeforeRun(feed_names);
+  // rebuild to reassign the streams by the profiled time
+  switch_stream = UpdateAutoStreamCosts() || switch_stream;
 
 #ifdef PADDLE_WITH_DNNL
   platform::AttachPointerHashToMKLDNNKey(this, place_);
@@ -1555,15 +2374,14 @@ paddle::framework::FetchList PirInterpreter::Run(
     ClearDenseTensorArrayInLocalScope();
   }
 
+  if (FLAGS_check_nan_inf && FLAGS_check_nan_inf_lazy) {
+    framework::details::FlushLazyNanInfCheck();
+  }
+
   // return Fetch Tensors
-  Scope* inner_scope = InnerScope();
   framework::FetchList fetch_res;
   if (need_fetch) {
-    for (auto& var_name : fetch_var_names_) {
-      auto* var = inner_scope->FindVar(var_name);
-      VLOG(4) << "fetch " << var_name << "[" << var << "]";
-      fetch_res.push_back(var->Get<phi::DenseTensor>());
-    }
+    fetch_res = FetchResults();
   }
 
   VLOG(4) << "get fetch list size: " << fetch_res.size();
@@ -1584,6 +2402,8 @@ FetchList PirInterpreter::Run(const std::vector<std::string>& feed_names,
 
   SetDeviceId(place_);
   CheckCUDAGraphBeforeRun(feed_names);
+  // rebuild to reassign the streams by the profiled time
+  switch_stream = UpdateAutoStreamCosts() || switch_stream;
 
 #ifdef PADDLE_WITH_DNNL
   platform::AttachPointerHashToMKLDNNKey(this, place_);
@@ -1634,18 +2454,33 @@ FetchList PirInterpreter::Run(const std::vector<std::string>& feed_names,
     ClearDenseTensorArrayInLocalScope();
   }
 
+  if (FLAGS_check_nan_inf && FLAGS_check_nan_inf_lazy) {
+    framework::details::FlushLazyNanInfCheck();
+  }
+
   framework::FetchList fetch_res;
   if (need_fetch) {
     // return Fetch Tensors
-    Scope* inner_scope = InnerScope();
+    fetch_res = FetchResults();
+    VLOG(4) << "get fetch list size: " << fetch_res.size();
+  }
+  return fetch_res;
+}
 
+FetchList PirInterpreter::FetchResults() {
+  if (fetch_vars_.size() != fetch_var_names_.size()) {
+    Scope* inner_scope = InnerScope();
+    fetch_vars_.clear();
     for (auto& var_name : fetch_var_names_) {
-      auto* var = inner_scope->FindVar(var_name);
-      VLOG(4) << "fetch " << var_name << "[" << var << "]";
-      fetch_res.push_back(var->Get<phi::DenseTensor>());
+      fetch_vars_.push_back(inner_scope->FindVar(var_name));
     }
+  }
 
-    VLOG(4) << "get fetch list size: " << fetch_res.size();
+  FetchList fetch_res;
+  fetch_res.reserve(fetch_vars_.size());
+  for (size_t i = 0; i < fetch_vars_.size(); ++i) {
+    VLOG(4) << "fetch " << fetch_var_names_[i] << "[" << fetch_vars_[i] << "]";
+    fetch_res.push_back(fetch_vars_[i]->Get<phi::DenseTensor>());
   }
   return fetch_res;
 }
@@ -1655,11 +2490,15 @@ void PirInterpreter::TraceRunImpl() {
   if (!gc_) {
     gc_ = CreateInterpreterCoreGarbageCollector(place_, vec_instruction_base_);
   }
+  BindStaticMemoryPlan();
+  BindDynamicMemoryPlan();
+  BeginInstructionProfile();
 
   interpreter::ResetAtomicGuard guard(&deps_, &refs_);
   VLOG(4) << "Tracing Instruction List";
 
   TraceRunInstructionList(vec_instruction_base_);
+  FinishDynamicMemoryRecord();
   VLOG(4) << "Done TraceRunInstructionList";
 #ifdef PADDLE_WITH_CUSTOM_DEVICE
   if (phi::is_custom_place(place_)) {
@@ -1673,12 +2512,16 @@ void PirInterpreter::MultiThreadRunImpl() {
   if (!gc_) {
     gc_ = CreateInterpreterCoreGarbageCollector(place_, vec_instruction_base_);
   }
+  BindStaticMemoryPlan();
+  BindDynamicMemoryPlan();
+  BeginInstructionProfile();
 
   interpreter::ResetAtomicGuard guard(&deps_, &refs_);
   VLOG(4) << "Multi Thread Run Instruction List";
 
   async_work_queue_ = GetWorkQueue();
   MultiThreadRunInstructionList(vec_instruction_base_);
+  FinishDynamicMemoryRecord();
   VLOG(4) << "Done MultiThreadRunInstructionList";
 #ifdef PADDLE_WITH_CUSTOM_DEVICE
   if (phi::is_custom_place(place_)) {
@@ -1687,6 +2530,37 @@ void PirInterpreter::MultiThreadRunImpl() {
 #endif
 }
 
+bool PirInterpreter::UpdateAutoStreamCosts() {
+  if (FLAGS_pir_interpreter_auto_stream_num <= 1 || auto_stream_profiled_ ||
+      !is_build_ || !instruction_profiler_ ||
+      instruction_profiler_->num_sampled_runs() == 0) {
+    return false;
+  }
+  auto device_ms = instruction_profiler_->AverageDeviceMs();
+  for (size_t i = 0; i < device_ms.size() && i < vec_instruction_base_.size();
+       ++i) {
+    if (device_ms[i] > 0.) {
+      auto_stream_op_costs_[vec_instruction_base_[i]->Operation()] =
+          device_ms[i];
+    }
+  }
+  auto_stream_profiled_ = true;
+  VLOG(4) << "Reassign the streams by the profiled time of "
+          << auto_stream_op_costs_.size() << " instructions";
+  return !auto_stream_op_costs_.empty();
+}
+
+void PirInterpreter::BeginInstructionProfile() {
+  if (FLAGS_executor_instruction_profile_every <= 0) {
+    return;
+  }
+  if (!instruction_profiler_) {
+    instruction_profiler_ = std::make_unique<interpreter::InstructionProfiler>(
+        vec_instruction_base_.size(), FLAGS_executor_instruction_profile_every);
+  }
+  instruction_profiler_->BeginRun();
+}
+
 void PirInterpreter::TraceRunInstructionList(
     const std::vector<std::unique_ptr<InstructionBase>>& vec_instr) {
   unfinished_op_number_ = vec_instr.size();
@@ -1718,17 +2592,21 @@ void PirInterpreter::TraceRunInstructionList(
     }
   }
 
-  for (size_t idx = 0; idx < trace_execute_order_.size(); idx++) {
-    auto instr_id = trace_execute_order_[idx];
-    InstructionBase* instr_node = vec_instruction_base_.at(instr_id).get();
+  if (UseSegmentedCUDAGraph()) {
+    TraceRunCUDAGraphSegments();
+  } else {
+    for (size_t idx = 0; idx < trace_execute_order_.size(); idx++) {
+      auto instr_id = trace_execute_order_[idx];
+      InstructionBase* instr_node = vec_instruction_base_.at(instr_id).get();
 
-    VLOG(6) << "Run InstructionBase " << instr_node->Name() << "[" << instr_id
-            << "], op id: " << instr_node->Operation()->id();
-    RunInstructionBase(instr_node);
+      VLOG(6) << "Run InstructionBase " << instr_node->Name() << "["
+              << instr_id << "], op id: " << instr_node->Operation()->id();
+      RunInstructionBase(instr_node);
 
-    if (UNLIKELY(exception_holder_.IsCaught())) {
-      VLOG(4) << "Exception caught";
-      break;
+      if (UNLIKELY(exception_holder_.IsCaught())) {
+        VLOG(4) << "Exception caught";
+        break;
+      }
     }
   }
 
@@ -1768,18 +2646,27 @@ void PirInterpreter::MultiThreadRunInstructionList(
     }
   }
 
+  std::vector<size_t> ready_instr_ids;
   for (size_t i = 0; i < dependency_count_->size(); ++i) {
     if ((*dependency_count_)[i] == 0) {
       // NOTE(zhiqiu): hot fix for jit input var
       RecordMemcpyD2H(vec_instr.at(i).get());
+      if (instruction_profiler_ && instruction_profiler_->sampling()) {
+        instruction_profiler_->RecordReady(i);
+      }
       if (FLAGS_new_executor_serial_run) {
         RunInstructionBaseAsync(i);
+      } else if (!critical_path_depth_.empty()) {
+        ready_instr_ids.push_back(i);
       } else {
         async_work_queue_->AddTask(vec_instr.at(i)->KernelType(),
                                    [this, i] { RunInstructionBaseAsync(i); });
       }
     }
   }
+  if (!ready_instr_ids.empty()) {
+    DispatchReadyInstructions(&ready_instr_ids);
+  }
 
   // For debug hang in main_thread_blocker_.WaitEvent(),
   // launch async task to log deps every
@@ -1881,14 +2768,31 @@ void PirInterpreter::RunNextInstructions(InstructionBase* instr,
   auto IsReady = [this](size_t next_id) {
     VLOG(4) << "op_id: " << next_id
             << ", remain deps: " << deps_[next_id]->DynamicDep();
-    return deps_[next_id]->CheckAndDecrease();
+    bool is_ready = deps_[next_id]->CheckAndDecrease();
+    if (is_ready && instruction_profiler_ &&
+        instruction_profiler_->sampling()) {
+      instruction_profiler_->RecordReady(next_id);
+    }
+    return is_ready;
   };
 
-  for (size_t next_instr_id : instr->NextInstrsInDifferenceThread()) {
-    if (IsReady(next_instr_id)) {
-      async_work_queue_->AddTask(
-          vec_instruction_base_[next_instr_id]->KernelType(),
-          [this, next_instr_id]() { RunInstructionBaseAsync(next_instr_id); });
+  if (!critical_path_depth_.empty()) {
+    std::vector<size_t> ready_instr_ids;
+    for (size_t next_instr_id : instr->NextInstrsInDifferenceThread()) {
+      if (IsReady(next_instr_id)) {
+        ready_instr_ids.push_back(next_instr_id);
+      }
+    }
+    DispatchReadyInstructions(&ready_instr_ids);
+  } else {
+    for (size_t next_instr_id : instr->NextInstrsInDifferenceThread()) {
+      if (IsReady(next_instr_id)) {
+        async_work_queue_->AddTask(
+            vec_instruction_base_[next_instr_id]->KernelType(),
+            [this, next_instr_id]() {
+              RunInstructionBaseAsync(next_instr_id);
+            });
+      }
     }
   }
 
@@ -1908,6 +2812,13 @@ void PirInterpreter::RunInstructionBase(InstructionBase* instr_node) {
 
   try {
     instr_node->WaitEvent(cur_place);
+#ifdef PADDLE_WITH_CUDA
+    if (FLAGS_use_cuda_managed_memory &&
+        FLAGS_cuda_managed_memory_prefetch_min_size_in_mb > 0 &&
+        instr_node->KernelType() == OpFuncType::kGpuAsync) {
+      PrefetchManagedMemoryInputs(instr_node, value_exe_info_.get());
+    }
+#endif
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
     if (enable_job_schedule_profiler_) {
       std::string op_name = instr_node->Name();
@@ -1922,6 +2833,10 @@ void PirInterpreter::RunInstructionBase(InstructionBase* instr_node) {
 
     RecordLowPrecisionOp(instr_node);
 
+    if (!memory_pressure_checks_.empty()) {
+      CheckMemoryPressure(instr_node->Id());
+    }
+
     VLOG(2) << "\nbegin: " << __func__ << " OP id:" << instr_node->Id()
             << " name:" << instr_node->Name() << " type:"
             << (instr_node->KernelType() == OpFuncType::kCpuSync
@@ -1948,7 +2863,21 @@ void PirInterpreter::RunInstructionBase(InstructionBase* instr_node) {
       {
         phi::RecordEvent record(
             "InstrRun", phi::TracerEventType::UserDefined, 10);
-        instr_node->Run();
+        memory::AllocationSiteGuard site_guard(instr_node->Name());
+        if (UNLIKELY(instruction_profiler_ &&
+                     instruction_profiler_->sampling())) {
+          instruction_profiler_->RecordLaunchBegin(
+              instr_node->Id(), instr_node->DeviceContext());
+          instr_node->Run();
+          instruction_profiler_->RecordLaunchEnd(instr_node->Id(),
+                                                 instr_node->DeviceContext());
+        } else {
+          instr_node->Run();
+        }
+      }
+
+      if (UNLIKELY(recording_dynamic_memory_)) {
+        RecordDynamicMemory(instr_node);
       }
 
       if (instr_node->IsSyncAfterLaunch()) {
@@ -2043,6 +2972,12 @@ void PirInterpreter::PreAnalysis() {
   CalculateLastLiveOps();
   VLOG(4) << "Done CalculateLastLiveOps";
 
+  if (FLAGS_pir_interpreter_static_memory_plan ||
+      FLAGS_pir_interpreter_dynamic_memory_plan_buckets > 0) {
+    PlanStaticMemory();
+    VLOG(4) << "Done PlanStaticMemory";
+  }
+
   if (VLOG_IS_ON(2)) {
     std::vector<std::string> instr_debug_info = DebugInfo();
     for (auto& item : instr_debug_info) {
@@ -2054,6 +2989,11 @@ void PirInterpreter::PreAnalysis() {
                               ir_instruction_scheduling_priority_less);
   VLOG(4) << "Done AnalyseExecuteOrderForTrace";
 
+  if (FLAGS_pir_interpreter_memory_pressure_window > 0) {
+    PlanMemoryPressureChecks();
+    VLOG(4) << "Done PlanMemoryPressureChecks";
+  }
+
   AnalyzeForceSyncOps();
   VLOG(4) << "Done AnalyzeForceSyncOps";
 
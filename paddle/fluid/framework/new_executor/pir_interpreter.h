@@ -15,10 +15,12 @@
 #pragma once
 #include <memory>
 #include "paddle/fluid/framework/new_executor/instruction/instruction_base.h"
+#include "paddle/fluid/framework/new_executor/interpreter/static_memory_planner.h"
 #include "paddle/fluid/framework/new_executor/interpreter_base_impl.h"
 #include "paddle/pir/include/core/value.h"
 
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+#include "paddle/phi/core/platform/cuda_graph_with_memory_pool.h"
 #include "paddle/phi/kernels/autotune/gpu_timer.h"
 #endif
 
@@ -140,10 +142,26 @@ class PirInterpreter : public InterpreterBaseImpl {
   // gc
   void ClearDenseTensorArrayInLocalScope();
 
+  // static memory plan
+  void PlanStaticMemory();
+  void BindStaticMemoryPlan();
+  std::string DynamicMemoryBucket() const;
+  void BindDynamicMemoryPlan();
+  void RecordDynamicMemory(InstructionBase* instr);
+  void FinishDynamicMemoryRecord();
+  void PlanMemoryPressureChecks();
+  void CheckMemoryPressure(size_t instr_id);
+
   // cuda graph
   void CheckCUDAGraphBeforeRun(const std::vector<std::string>& feed_names);
   void PrepareForCUDAGraphCapture();
 
+  // segmented cuda graph
+  bool UseSegmentedCUDAGraph();
+  bool IsCUDAGraphHostInstruction(InstructionBase* instr) const;
+  void BuildCUDAGraphSegments();
+  void TraceRunCUDAGraphSegments();
+
   void Build(const std::vector<std::string>& feed_names,
              std::vector<paddle::framework::OpFuncNode>* op_func_nodes,
              bool switch_stream = false) override;
@@ -236,11 +254,26 @@ class PirInterpreter : public InterpreterBaseImpl {
   void MultiThreadRunInstructionList(
       const std::vector<std::unique_ptr<InstructionBase>>& vec_instr);
 
+  void BeginInstructionProfile();
+
+  // Returns whether the streams should be reassigned by the profiled time
+  // of the instructions, see FLAGS_pir_interpreter_auto_stream_num.
+  bool UpdateAutoStreamCosts();
+
+  // Collects the fetch variables resolved at the first call.
+  FetchList FetchResults();
+
   void RunInstructionBaseAsync(size_t instr_id);
 
   void RunNextInstructions(InstructionBase* instr,
                            SchedulingQueue* reserved_next_ops);
 
+  // scheduling by critical path
+  void AnalyseCriticalPathDepth(
+      const std::map<size_t, std::set<size_t>>& op_downstream_map);
+
+  void DispatchReadyInstructions(std::vector<size_t>* ready_instr_ids);
+
   void RunInstructionBase(InstructionBase* instr_node);
 
   void RecordMemcpyD2H(InstructionBase* instr_node);
@@ -259,6 +292,11 @@ class PirInterpreter : public InterpreterBaseImpl {
 
   InstructionSchedulingPriorityLess ir_instruction_scheduling_priority_less;
 
+  // critical_path_depth_[i] is the length of the longest path from the i-th
+  // instruction to the end of the program, only analysed when
+  // FLAGS_pir_interpreter_critical_path_scheduling is set.
+  std::vector<size_t> critical_path_depth_;
+
   const ::pir::Block* ir_block_{nullptr};
 
   std::unordered_map<::pir::Block*, PirInterpreter*> sub_blocks_;  // Not owned
@@ -270,21 +308,93 @@ class PirInterpreter : public InterpreterBaseImpl {
 
   std::vector<int> var_ref_count_;
 
+  // Note: intermediate vars with static shape are bound to one arena when
+  // FLAGS_pir_interpreter_static_memory_plan is set, and are skipped by gc.
+  static constexpr size_t kStaticMemoryPlanAlignment = 256;
+  std::vector<bool> static_planned_vars_;
+  std::unordered_map<size_t, size_t> static_memory_sizes_;
+  std::unordered_map<size_t, std::shared_ptr<phi::Allocation>>
+      static_memory_holders_;
+  std::shared_ptr<phi::Allocation> static_memory_arena_;
+  interpreter::StaticMemoryPlan static_memory_plan_;
+
+  // Note: intermediate vars with dynamic shape are planned per shape bucket
+  // when FLAGS_pir_interpreter_dynamic_memory_plan_buckets is set. The first
+  // run of a bucket records the sizes they allocate, and the reruns bind them
+  // to one arena shared by all the buckets.
+  struct DynamicMemoryPlan {
+    interpreter::StaticMemoryPlan plan;
+    std::unordered_map<size_t, size_t> sizes;
+  };
+  // the requests without size
+  std::vector<interpreter::StaticMemoryRequest> dynamic_memory_candidates_;
+  // the output vars of the data ops, whose dims make the bucket
+  std::vector<size_t> dynamic_memory_data_vars_;
+  std::unordered_map<std::string, DynamicMemoryPlan> dynamic_memory_plans_;
+  // the bucket of the current run
+  std::string dynamic_memory_bucket_;
+  bool recording_dynamic_memory_{false};
+  // var_id -> the bytes allocated in the recording run
+  std::vector<size_t> dynamic_memory_record_;
+  std::vector<bool> dynamic_planned_vars_;
+  std::vector<size_t> dynamic_bound_vars_;
+  std::shared_ptr<phi::Allocation> dynamic_memory_arena_;
+
+  // instr id -> the bytes expected to be allocated by the window of
+  // instructions beginning with it in the execution order, see
+  // FLAGS_pir_interpreter_memory_pressure_window
+  std::unordered_map<size_t, size_t> memory_pressure_checks_;
+
   interpreter::PirDependencyBuilder ir_dependency_builder_;
 
   interpreter::PirStreamAnalyzer ir_stream_analyzer_;
 
   std::vector<std::string> fetch_var_names_;
 
+  // Note: the feed and fetch variables are resolved from the inner scope at
+  // the first run, and reused by the later runs with the same feed names.
+  std::vector<std::string> cached_feed_names_;
+  std::vector<Variable*> feed_vars_;
+  std::vector<Variable*> fetch_vars_;
+
   // Note(zhangbo): set_parameter_op's input and parameter_op's output
   // belongs to a parameter and cannot GC.
   std::unordered_set<std::string> parameter_var_names_;
 
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
   std::unique_ptr<phi::CalculateStreamTimer> calculate_stream_timer_;
+
+  // Note: the instructions of the trace between two host instructions are
+  // captured to a CUDA graph at the first run when
+  // FLAGS_new_executor_segmented_cuda_graph is set, and the graph is replayed
+  // in the later runs while the host instructions run eagerly.
+  struct CUDAGraphSegment {
+    // [begin, end) of trace_execute_order_
+    size_t begin;
+    size_t end;
+    std::unique_ptr<platform::CUDAGraph> graph;
+    // the tensors read by the segment but written before it, whose data are
+    // copied to the captured memory if they are moved, e.g. by the outputs
+    // of the control flow
+    std::vector<std::pair<int, phi::DenseTensor>> inputs;
+    // the tensors written by the segment and alive after it, which are bound
+    // back to the captured memory after the replay
+    std::vector<std::pair<int, phi::DenseTensor>> outputs;
+  };
+  bool cuda_graph_segments_built_{false};
+  std::vector<CUDAGraphSegment> cuda_graph_segments_;
+  int64_t cuda_graph_pool_id_{platform::CUDAGraph::kInvalidPoolID};
 #endif
   size_t last_calculate_instr_id_;
   bool enable_job_schedule_profiler_;
+
+  // sample the latency of the instructions by
+  // FLAGS_executor_instruction_profile_every
+  std::unique_ptr<interpreter::InstructionProfiler> instruction_profiler_;
+
+  // the profiled device time of the kernels to assign the streams by
+  std::unordered_map<const ::pir::Operation*, double> auto_stream_op_costs_;
+  bool auto_stream_profiled_{false};
 };
 
 }  // namespace framework
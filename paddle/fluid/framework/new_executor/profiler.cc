@@ -0,0 +1,223 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/new_executor/profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/core/enforce.h"
+#endif
+
+namespace paddle {
+namespace framework {
+namespace interpreter {
+
+namespace {
+
+int64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+struct InstructionProfiler::Impl {
+  struct Record {
+    int64_t ready_ns{0};
+    int64_t launch_ns{0};
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    gpuEvent_t start{nullptr};
+    gpuEvent_t end{nullptr};
+    bool pending{false};
+#endif
+  };
+
+  struct Stats {
+    int64_t count{0};
+    double queue_ms{0.};
+    double host_ms{0.};
+    double device_ms{0.};
+  };
+
+  explicit Impl(size_t num_instrs) : records(num_instrs), stats(num_instrs) {}
+
+  std::vector<Record> records;
+  std::vector<Stats> stats;
+};
+
+InstructionProfiler::InstructionProfiler(size_t num_instrs,
+                                         int64_t sample_every)
+    : impl_(new Impl(num_instrs)),
+      sample_every_(std::max<int64_t>(sample_every, 1)) {}
+
+InstructionProfiler::~InstructionProfiler() {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  for (auto& record : impl_->records) {
+#ifdef PADDLE_WITH_HIP
+    if (record.start) hipEventDestroy(record.start);
+    if (record.end) hipEventDestroy(record.end);
+#else
+    if (record.start) cudaEventDestroy(record.start);
+    if (record.end) cudaEventDestroy(record.end);
+#endif
+  }
+#endif
+}
+
+bool InstructionProfiler::BeginRun() {
+  ResolveDeviceTime();
+  sampling_ = num_runs_++ % sample_every_ == 0;
+  if (sampling_) {
+    ++num_sampled_runs_;
+    for (auto& record : impl_->records) {
+      record.ready_ns = 0;
+    }
+  }
+  return sampling_;
+}
+
+void InstructionProfiler::RecordReady(size_t instr_id) {
+  impl_->records[instr_id].ready_ns = NowNs();
+}
+
+void InstructionProfiler::RecordLaunchBegin(size_t instr_id,
+                                            const phi::DeviceContext& dev_ctx) {
+  auto& record = impl_->records[instr_id];
+  record.launch_ns = NowNs();
+  if (record.ready_ns > 0) {
+    impl_->stats[instr_id].queue_ms +=
+        static_cast<double>(record.launch_ns - record.ready_ns) / 1e6;
+  }
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (phi::is_gpu_place(dev_ctx.GetPlace())) {
+    auto stream = static_cast<const phi::GPUContext&>(dev_ctx).stream();
+#ifdef PADDLE_WITH_HIP
+    if (!record.start) {
+      PADDLE_ENFORCE_GPU_SUCCESS(hipEventCreate(&record.start));
+      PADDLE_ENFORCE_GPU_SUCCESS(hipEventCreate(&record.end));
+    }
+    PADDLE_ENFORCE_GPU_SUCCESS(hipEventRecord(record.start, stream));
+#else
+    if (!record.start) {
+      PADDLE_ENFORCE_GPU_SUCCESS(cudaEventCreate(&record.start));
+      PADDLE_ENFORCE_GPU_SUCCESS(cudaEventCreate(&record.end));
+    }
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaEventRecord(record.start, stream));
+#endif
+  }
+#endif
+}
+
+void InstructionProfiler::RecordLaunchEnd(size_t instr_id,
+                                          const phi::DeviceContext& dev_ctx) {
+  auto& record = impl_->records[instr_id];
+  auto& stats = impl_->stats[instr_id];
+  ++stats.count;
+  stats.host_ms += static_cast<double>(NowNs() - record.launch_ns) / 1e6;
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (phi::is_gpu_place(dev_ctx.GetPlace()) && record.start) {
+    auto stream = static_cast<const phi::GPUContext&>(dev_ctx).stream();
+#ifdef PADDLE_WITH_HIP
+    PADDLE_ENFORCE_GPU_SUCCESS(hipEventRecord(record.end, stream));
+#else
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaEventRecord(record.end, stream));
+#endif
+    record.pending = true;
+  }
+#endif
+}
+
+void InstructionProfiler::ResolveDeviceTime() {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  // the events are long done when the next run begins, so the waits are short
+  for (size_t i = 0; i < impl_->records.size(); ++i) {
+    auto& record = impl_->records[i];
+    if (!record.pending) continue;
+    float ms = 0.f;
+#ifdef PADDLE_WITH_HIP
+    PADDLE_ENFORCE_GPU_SUCCESS(hipEventSynchronize(record.end));
+    PADDLE_ENFORCE_GPU_SUCCESS(
+        hipEventElapsedTime(&ms, record.start, record.end));
+#else
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaEventSynchronize(record.end));
+    PADDLE_ENFORCE_GPU_SUCCESS(
+        cudaEventElapsedTime(&ms, record.start, record.end));
+#endif
+    impl_->stats[i].device_ms += ms;
+    record.pending = false;
+  }
+#endif
+}
+
+std::vector<double> InstructionProfiler::AverageDeviceMs() {
+  ResolveDeviceTime();
+  std::vector<double> result(impl_->stats.size(), 0.);
+  for (size_t i = 0; i < impl_->stats.size(); ++i) {
+    const auto& s = impl_->stats[i];
+    if (s.count > 0) {
+      result[i] = s.device_ms / static_cast<double>(s.count);
+    }
+  }
+  return result;
+}
+
+std::string InstructionProfiler::Report(const std::vector<std::string>& names,
+                                        size_t top_k) {
+  ResolveDeviceTime();
+  const auto& stats = impl_->stats;
+  std::vector<size_t> ids(stats.size());
+  std::iota(ids.begin(), ids.end(), 0);
+  auto TimeOf = [&stats](size_t id) {
+    return stats[id].host_ms + stats[id].device_ms;
+  };
+  std::stable_sort(ids.begin(), ids.end(), [&](size_t lhs, size_t rhs) {
+    return TimeOf(lhs) > TimeOf(rhs);
+  });
+  double total = 0.;
+  for (size_t id : ids) {
+    total += TimeOf(id);
+  }
+
+  std::ostringstream os;
+  os << "Instruction hotspots of " << num_sampled_runs_ << " sampled runs in "
+     << num_runs_ << " runs, the average ms of each run:\n";
+  os << std::left << std::setw(8) << "id" << std::setw(40) << "name"
+     << std::right << std::setw(12) << "queue" << std::setw(12) << "host"
+     << std::setw(12) << "device" << std::setw(10) << "ratio" << "\n";
+  os << std::fixed << std::setprecision(4);
+  for (size_t i = 0; i < ids.size() && i < top_k; ++i) {
+    size_t id = ids[i];
+    const auto& s = stats[id];
+    if (s.count == 0) break;
+    double runs = static_cast<double>(s.count);
+    os << std::left << std::setw(8) << id << std::setw(40)
+       << (id < names.size() ? names[id] : std::string()) << std::right
+       << std::setw(12) << s.queue_ms / runs << std::setw(12)
+       << s.host_ms / runs << std::setw(12) << s.device_ms / runs
+       << std::setw(9) << (total > 0. ? TimeOf(id) / total * 100. : 0.)
+       << "%\n";
+  }
+  return os.str();
+}
+
+}  // namespace interpreter
+}  // namespace framework
+}  // namespace paddle
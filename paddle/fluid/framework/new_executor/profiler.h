@@ -13,8 +13,13 @@
 // limitations under the License.
 
 #pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "paddle/fluid/framework/tensor.h"
 #include "paddle/fluid/framework/variable.h"
+#include "paddle/phi/core/device_context.h"
 #include "paddle/phi/core/platform/device/gpu/gpu_info.h"
 #include "paddle/phi/core/platform/timer.h"
 
@@ -55,6 +60,51 @@ class ProfilerGuard {
   platform::Timer timer_;
 };
 
+// Sample the latencies of the instructions one in every sample_every runs:
+// the wait from ready to run in the work queues, the host time to launch the
+// kernels, and the device time of the kernels by the events on their streams.
+// They are aggregated by the instruction id into the hotspot report. The
+// instructions of a sampled run are recorded concurrently, each by the thread
+// running it.
+class InstructionProfiler {
+ public:
+  InstructionProfiler(size_t num_instrs, int64_t sample_every);
+
+  ~InstructionProfiler();
+
+  // Return whether the run is sampled, called before each run.
+  bool BeginRun();
+
+  bool sampling() const { return sampling_; }
+
+  // The instruction is ready, i.e. its dependencies are done.
+  void RecordReady(size_t instr_id);
+
+  void RecordLaunchBegin(size_t instr_id, const phi::DeviceContext& dev_ctx);
+
+  void RecordLaunchEnd(size_t instr_id, const phi::DeviceContext& dev_ctx);
+
+  int64_t num_sampled_runs() const { return num_sampled_runs_; }
+
+  // The top_k instructions by their host and device time of the sampled runs.
+  std::string Report(const std::vector<std::string>& names, size_t top_k);
+
+  // The average device time in ms of each instruction in the sampled runs,
+  // which is 0 for the instructions never sampled.
+  std::vector<double> AverageDeviceMs();
+
+ private:
+  // Read the device time of the last sampled run.
+  void ResolveDeviceTime();
+
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+  int64_t sample_every_;
+  int64_t num_runs_{0};
+  int64_t num_sampled_runs_{0};
+  bool sampling_{false};
+};
+
 }  // namespace interpreter
 }  // namespace framework
 }  // namespace paddle
@@ -197,6 +197,10 @@ FetchList ProgramInterpreter::Run(const std::vector<std::string>& feed_names,
     ClearDenseTensorArrayInLocalScope();
   }
 
+  if (FLAGS_check_nan_inf && FLAGS_check_nan_inf_lazy) {
+    framework::details::FlushLazyNanInfCheck();
+  }
+
   // NOTE (liuchenghao): we need to reset "is_in_op_profiling_mode_" to false.
   // This is because ProgramInterpreter::Run(...) has two implementations, only
   // this implementation correctly updates its state, if user switches to
@@ -283,6 +287,10 @@ FetchList ProgramInterpreter::Run(
     ClearDenseTensorArrayInLocalScope();
   }
 
+  if (FLAGS_check_nan_inf && FLAGS_check_nan_inf_lazy) {
+    framework::details::FlushLazyNanInfCheck();
+  }
+
   if (need_fetch) {
     // return Fetch Tensors
     Scope* inner_scope =
@@ -193,7 +193,35 @@ paddle::framework::FetchList StandaloneExecutor::Run(
 
   std::vector<std::vector<phi::DenseTensor>> splited_feeds;
   if (FLAGS_enable_pir_in_executor) {
-    SplitFeedTensors(feed_names, plan_.MicroBatchNum(), scope_, &splited_feeds);
+    if (feed_names != cached_feed_names_) {
+      feed_vars_.clear();
+      for (const auto& feed_name : feed_names) {
+        auto* feed_var = scope_->GetVar(feed_name);
+        PADDLE_ENFORCE_NOT_NULL(
+            feed_var,
+            common::errors::NotFound("Variable %s should not be nullptr.",
+                                     feed_name));
+        feed_vars_.push_back(feed_var);
+      }
+      cached_feed_names_ = feed_names;
+    }
+    SplitFeedTensors(
+        feed_names, feed_vars_, plan_.MicroBatchNum(), &splited_feeds);
+
+    if (job_fetch_vars_.size() != jobs.size()) {
+      job_fetch_vars_.resize(jobs.size());
+      for (size_t job_idx = 0; job_idx < jobs.size(); ++job_idx) {
+        const auto& job = jobs[job_idx];
+        Scope* scope = micro_batch_scopes_[job->MicroBatchId()];
+        for (auto& var_name : job->FetchVarNames()) {
+          int col = std::find(fetch_var_names_.begin(),
+                              fetch_var_names_.end(),
+                              var_name) -
+                    fetch_var_names_.begin();
+          job_fetch_vars_[job_idx].emplace_back(col, scope->FindVar(var_name));
+        }
+      }
+    }
   }
 
   fetch_list_.resize(plan_.MicroBatchNum());
@@ -222,10 +250,9 @@ paddle::framework::FetchList StandaloneExecutor::Run(
                                       /*enable_job_schedule_profiler = */
                                       enable_job_schedule_profiler);
 
-      FetchTensors(job->FetchVarNames(),
-                   fetch_var_names_,
+      FetchTensors(job_fetch_vars_[job_idx],
+                   fetch_var_names_.size(),
                    job->MicroBatchId(),
-                   micro_batch_scopes_[job->MicroBatchId()],
                    &fetch_list_);
     } else {
       if (jobs.size() > 1 && job_type != "forward") {
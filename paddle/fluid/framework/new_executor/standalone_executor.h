@@ -16,6 +16,7 @@
 #include <map>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "paddle/fluid/framework/lod_tensor.h"
@@ -58,6 +59,13 @@ class StandaloneExecutor {
   std::vector<std::string> fetch_var_names_;
   FetchUnmergedList fetch_list_;
 
+  // Note: the feed variables and the (col, variable) fetch pairs of each job
+  // are resolved from the scopes once, and reused by the later runs with the
+  // same feed names to skip the scope lookups.
+  std::vector<std::string> cached_feed_names_;
+  std::vector<Variable*> feed_vars_;
+  std::vector<std::vector<std::pair<int, Variable*>>> job_fetch_vars_;
+
   std::vector<std::unordered_map<std::string, std::shared_ptr<EventInter>>>
       vec_force_events_to_wait_;
 };
@@ -33,6 +33,7 @@ class ThreadPoolTempl {
                   int num_threads,
                   bool allow_spinning,
                   bool always_spinning,
+                  bool numa_aware = false,
                   Environment env = Environment())
       : env_(env),
         allow_spinning_(allow_spinning),
@@ -58,8 +59,29 @@ class ThreadPoolTempl {
       all_coprimes_.emplace_back(i);
       ComputeCoprimes(i, &(all_coprimes_.back()));
     }
+    // the threads are pinned to the NUMA nodes in blocks, and steal the
+    // tasks of the threads on the same node first
+    thread_numa_nodes_.assign(num_threads_, -1);
+    const int num_nodes = numa_aware ? phi::GetNumaNodeCount() : 1;
+    if (num_nodes > 1) {
+      for (int i = 0; i < num_threads_; i++) {
+        thread_numa_nodes_[i] = i * num_nodes / num_threads_;
+      }
+    }
+    for (int i = 0; i < num_threads_; i++) {
+      int start = i;
+      int limit = i + 1;
+      while (start > 0 &&
+             thread_numa_nodes_[start - 1] == thread_numa_nodes_[i]) {
+        --start;
+      }
+      while (limit < num_threads_ &&
+             thread_numa_nodes_[limit] == thread_numa_nodes_[i]) {
+        ++limit;
+      }
+      SetStealPartition(i, EncodePartition(start, limit));
+    }
     for (int i = 0; i < num_threads_; i++) {
-      SetStealPartition(i, EncodePartition(0, num_threads_));
       thread_data_[i].thread.reset(
           env_.CreateThread([this, i]() { WorkerLoop(i); }));
     }
@@ -244,12 +266,19 @@ class ThreadPoolTempl {
   const int num_threads_;
   std::vector<ThreadData> thread_data_;
   std::string name_;
+  // -1 if the thread is not pinned
+  std::vector<int> thread_numa_nodes_;
 
   // Main worker thread loop.
   void WorkerLoop(int thread_id) {
     std::string thr_name = name_ + "_thread_" + std::to_string(thread_id);
     VLOG(1) << thr_name << " started ";
     phi::SetCurrentThreadName(thr_name);
+    if (thread_numa_nodes_[thread_id] >= 0 &&
+        !phi::BindCurrentThreadToNumaNode(thread_numa_nodes_[thread_id])) {
+      LOG(WARNING) << thr_name << " failed to bind to NUMA node "
+                   << thread_numa_nodes_[thread_id];
+    }
     PerThread* pt = GetPerThread();
     pt->pool = this;
     pt->rand = GlobalThreadIdHash();
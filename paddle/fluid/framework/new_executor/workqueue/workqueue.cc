@@ -6,11 +6,14 @@
 
 #include "paddle/fluid/framework/new_executor/workqueue/workqueue.h"
 
+#include "paddle/common/flags.h"
 #include "paddle/fluid/framework/new_executor/workqueue/nonblocking_threadpool.h"
 #include "paddle/fluid/framework/new_executor/workqueue/workqueue_utils.h"
 #include "paddle/fluid/platform/enforce.h"
 #include "paddle/phi/core/platform/profiler/event_tracing.h"
 
+COMMON_DECLARE_bool(numa_aware_placement);
+
 namespace paddle::framework {
 
 void WorkQueueOptions::Validate() const {
@@ -46,10 +49,12 @@ class WorkQueueImpl : public WorkQueue {
       destruct_notifier_ =
           options.events_waiter->RegisterEvent(kQueueDestructEvent);
     }
-    queue_ = new NonblockingThreadPool(options_.name,
-                                       static_cast<int>(options_.num_threads),
-                                       options_.allow_spinning,
-                                       options_.always_spinning);
+    queue_ = new NonblockingThreadPool(
+        options_.name,
+        static_cast<int>(options_.num_threads),
+        options_.allow_spinning,
+        options_.always_spinning,
+        options_.numa_aware || FLAGS_numa_aware_placement);
   }
 
   ~WorkQueueImpl() override {
@@ -137,11 +142,12 @@ WorkQueueGroupImpl::WorkQueueGroupImpl(
       destruct_notifier_ =
           options.events_waiter->RegisterEvent(kQueueDestructEvent);
     }
-    queues_[idx] = new (&queues_storage_[idx])
-        NonblockingThreadPool(options.name,
-                              static_cast<int>(options.num_threads),
-                              options.allow_spinning,
-                              options.always_spinning);
+    queues_[idx] = new (&queues_storage_[idx]) NonblockingThreadPool(
+        options.name,
+        static_cast<int>(options.num_threads),
+        options.allow_spinning,
+        options.always_spinning,
+        options.numa_aware || FLAGS_numa_aware_placement);
   }
 }
 
@@ -102,6 +102,9 @@ struct WorkQueueOptions {
   // false and set events_waiter.
   bool detached{true};
   EventsWaiter* events_waiter{nullptr};  // not owned
+  // Worker threads are pinned to the NUMA nodes in blocks if this flag or
+  // FLAGS_numa_aware_placement is set.
+  bool numa_aware{false};
 };
 
 class WorkQueue {
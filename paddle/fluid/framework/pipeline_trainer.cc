@@ -26,6 +26,7 @@ void PipelineTrainer::Initialize(const TrainerDesc& trainer_desc,
   const int num_pipeline_stages_ = section_params.num_pipeline_stages();
   const int pipeline_stage_ = section_params.pipeline_stage();
   const int schedule_mode_ = section_params.schedule_mode();
+  const int num_model_chunks_ = section_params.num_model_chunks();
   num_microbatches_ = section_params.num_microbatches();
   VLOG(3) << "Number of microbatches per minibatch: " << num_microbatches_;
   trainer_desc_ = trainer_desc;
@@ -45,6 +46,7 @@ void PipelineTrainer::Initialize(const TrainerDesc& trainer_desc,
   this_worker->SetPipelineStageNum(num_pipeline_stages_);
   this_worker->SetPipelineStage(pipeline_stage_);
   this_worker->SetScheduleMode(schedule_mode_);
+  this_worker->SetModelChunkNum(num_model_chunks_);
   this_worker->Initialize(trainer_desc);
 }
 
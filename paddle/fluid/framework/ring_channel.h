@@ -0,0 +1,319 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <memory>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "paddle/fluid/platform/enforce.h"
+
+namespace paddle {
+namespace framework {
+
+// RingChannelObject is a bounded lock-free multi-producer multi-consumer
+// channel with the blocking Read/Write API of ChannelObject. Every Read or
+// Write claims as many consecutive slots of the ring as possible with one
+// compare-and-swap, so a block of records costs a single atomic operation
+// instead of one locked deque operation per record.
+//
+// Unlike ChannelObject, the capacity is fixed at construction (rounded up to
+// a power of two), and a blocked reader or writer backs off by spinning,
+// yielding and then sleeping instead of waiting on a condition variable.
+template <class T>
+class RingChannelObject {
+ public:
+  explicit RingChannelObject(size_t capacity = 65536) {
+    size_t size = 2;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    mask_ = size - 1;
+    cells_.reset(new Cell[size]);
+    for (size_t i = 0; i < size; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    enqueue_pos_.store(0, std::memory_order_relaxed);
+    dequeue_pos_.store(0, std::memory_order_relaxed);
+  }
+
+  RingChannelObject(const RingChannelObject&) = delete;
+  RingChannelObject& operator=(const RingChannelObject&) = delete;
+
+  size_t Capacity() const { return mask_ + 1; }
+
+  size_t BlockSize() const { return block_size_; }
+
+  void SetBlockSize(size_t x) {
+    PADDLE_ENFORCE_GE(
+        x,
+        1,
+        common::errors::InvalidArgument(
+            "The block size must be greater than or equal to 1, but got %d.",
+            x));
+    block_size_ = x;
+  }
+
+  bool Closed() const { return closed_.load(std::memory_order_acquire); }
+
+  // open channel, then data can be write() to channel
+  void Open() { closed_.store(false, std::memory_order_release); }
+
+  // close channel, then no more data can be write() to channel
+  void Close() { closed_.store(true, std::memory_order_release); }
+
+  // The number of records in the channel, which could be out of date as soon
+  // as it is returned.
+  size_t Size() const {
+    size_t enqueue_pos = enqueue_pos_.load(std::memory_order_acquire);
+    size_t dequeue_pos = dequeue_pos_.load(std::memory_order_acquire);
+    return enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+  }
+
+  bool Empty() const { return Size() == 0; }
+
+  void Clear() {
+    T val;
+    while (TryRead(1, &val) != 0) {
+    }
+  }
+
+  // blocking operation
+  bool Get(T& val) { return Read(1, &val) != 0; }  // NOLINT
+
+  // blocking operation
+  // returns less than n only if the channel is closed and empty
+  size_t Read(size_t n, T* p) { return ReadImpl(n, p, false); }
+
+  // blocking operation, returns as soon as some records are read
+  size_t ReadOnce(std::vector<T>& p, size_t size) {  // NOLINT
+    p.resize(size);
+    size_t finished = ReadImpl(size, p.data(), true);
+    p.resize(finished);
+    return finished;
+  }
+
+  // read data of block size from channel to vector
+  size_t Read(std::vector<T>& p) {  // NOLINT
+    p.resize(block_size_);
+    size_t finished = Read(p.size(), p.data());
+    p.resize(finished);
+    return finished;
+  }
+
+  size_t ReadAll(std::vector<T>& p) {  // NOLINT
+    p.clear();
+    size_t finished = 0;
+    size_t n = 0;
+    do {
+      n = block_size_;
+      p.resize(finished + n);
+      n = Read(n, &p[finished]);
+      finished += n;
+    } while (n != 0);
+    p.resize(finished);
+    return finished;
+  }
+
+  // non-blocking operation, returns the number of records read
+  size_t TryRead(size_t n, T* p) {
+    return Dequeue(n, [p](T* val, size_t i) { p[i] = std::move(*val); });
+  }
+
+  // blocking operation
+  bool Put(T&& val) { return WriteMove(1, &val) != 0; }
+
+  // blocking operation
+  bool Put(const T& val) { return Write(1, &val) != 0; }
+
+  // blocking operation
+  // returns value less than n if the channel is closed
+  size_t Write(size_t n, const T* p) {
+    return WriteImpl(n, [p](T* val, size_t i) { *val = p[i]; });
+  }
+
+  // WriteMove() will clear original contents of input array
+  size_t WriteMove(size_t n, T* p) {
+    return WriteImpl(n, [p](T* val, size_t i) { *val = std::move(p[i]); });
+  }
+
+  // write data from vector to channel
+  size_t Write(const std::vector<T>& p) { return Write(p.size(), p.data()); }
+
+  // write data from vector to channel
+  size_t Write(std::vector<T>&& p) { return WriteMove(p.size(), p.data()); }
+
+ private:
+  static constexpr size_t kCacheLineSize = 64;
+
+  struct alignas(kCacheLineSize) Cell {
+    // The position this cell is waiting for: equals to the position when it
+    // is free, and the position plus one when it holds a record.
+    std::atomic<size_t> sequence;
+    T data;
+  };
+
+  // Spins first, then yields and finally sleeps, so that many blocked
+  // threads do not burn all the cores.
+  class Backoff {
+   public:
+    void Wait() {
+      if (count_ < kSpinCount) {
+        ++count_;
+      } else if (count_ < kYieldCount) {
+        ++count_;
+        std::this_thread::yield();
+      } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+      }
+    }
+    void Reset() { count_ = 0; }
+
+   private:
+    static constexpr int kSpinCount = 16;
+    static constexpr int kYieldCount = 64;
+    int count_ = 0;
+  };
+
+  // Claims at most n consecutive free cells with one compare-and-swap and
+  // fills them. Returns 0 if the ring is full.
+  template <class Assign>
+  size_t Enqueue(size_t n, Assign&& assign) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      size_t k = 0;
+      while (k < n && k <= mask_ &&
+             cells_[(pos + k) & mask_].sequence.load(
+                 std::memory_order_acquire) == pos + k) {
+        ++k;
+      }
+      if (k == 0) {
+        size_t seq =
+            cells_[pos & mask_].sequence.load(std::memory_order_acquire);
+        if (static_cast<int64_t>(seq - pos) < 0) {
+          return 0;
+        }
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (enqueue_pos_.compare_exchange_weak(
+              pos, pos + k, std::memory_order_relaxed)) {
+        for (size_t i = 0; i < k; ++i) {
+          Cell& cell = cells_[(pos + i) & mask_];
+          assign(&cell.data, i);
+          cell.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        return k;
+      }
+    }
+  }
+
+  // Claims at most n consecutive filled cells with one compare-and-swap and
+  // takes their records. Returns 0 if the ring is empty.
+  template <class Take>
+  size_t Dequeue(size_t n, Take&& take) {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      size_t k = 0;
+      while (k < n && k <= mask_ &&
+             cells_[(pos + k) & mask_].sequence.load(
+                 std::memory_order_acquire) == pos + k + 1) {
+        ++k;
+      }
+      if (k == 0) {
+        size_t seq =
+            cells_[pos & mask_].sequence.load(std::memory_order_acquire);
+        if (static_cast<int64_t>(seq - (pos + 1)) < 0) {
+          return 0;
+        }
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (dequeue_pos_.compare_exchange_weak(
+              pos, pos + k, std::memory_order_relaxed)) {
+        for (size_t i = 0; i < k; ++i) {
+          Cell& cell = cells_[(pos + i) & mask_];
+          take(&cell.data, i);
+          cell.sequence.store(pos + i + mask_ + 1, std::memory_order_release);
+        }
+        return k;
+      }
+    }
+  }
+
+  template <class Assign>
+  size_t WriteImpl(size_t n, Assign&& assign) {
+    size_t finished = 0;
+    Backoff backoff;
+    while (finished < n && !Closed()) {
+      size_t m = Enqueue(n - finished, [&](T* val, size_t i) {
+        assign(val, finished + i);
+      });
+      if (m == 0) {
+        backoff.Wait();
+      } else {
+        finished += m;
+        backoff.Reset();
+      }
+    }
+    return finished;
+  }
+
+  size_t ReadImpl(size_t n, T* p, bool once) {
+    size_t finished = 0;
+    Backoff backoff;
+    while (finished < n) {
+      size_t m = TryRead(n - finished, p + finished);
+      if (m != 0) {
+        finished += m;
+        backoff.Reset();
+        if (once) {
+          break;
+        }
+        continue;
+      }
+      // The writers which claimed cells before the channel is closed are
+      // still waited for.
+      if (Closed() && dequeue_pos_.load(std::memory_order_acquire) >=
+                          enqueue_pos_.load(std::memory_order_acquire)) {
+        break;
+      }
+      backoff.Wait();
+    }
+    return finished;
+  }
+
+  size_t mask_;
+  std::unique_ptr<Cell[]> cells_;
+  alignas(kCacheLineSize) std::atomic<size_t> enqueue_pos_;
+  alignas(kCacheLineSize) std::atomic<size_t> dequeue_pos_;
+  alignas(kCacheLineSize) std::atomic<bool> closed_{false};
+  size_t block_size_ = 1024;
+};
+
+template <class T>
+using RingChannel = std::shared_ptr<RingChannelObject<T>>;
+
+template <class T>
+RingChannel<T> MakeRingChannel(size_t capacity = 65536) {
+  return std::make_shared<RingChannelObject<T>>(capacity);
+}
+
+}  // namespace framework
+}  // namespace paddle
@@ -46,6 +46,11 @@ std::unique_ptr<Scope> Scope::NewTmpScope() const {
 Variable* Scope::Var(const std::string& name) {
   // NOTE(xiongkun03): add {} here to unlock. With {}, scope
   // will do callback after unlock.
+  if (IsFrozen()) {
+    Variable* ret = FindVarLocally(name);
+    if (ret == nullptr) EnforceNotFrozen(name);
+    return ret;
+  }
   Variable* ret = nullptr;
   {
     SCOPE_VARS_WRITER_LOCK
@@ -55,6 +60,7 @@ Variable* Scope::Var(const std::string& name) {
 }
 
 Variable* Scope::Var(std::string* name) {
+  EnforceNotFrozen("a scope-unique variable");
   Variable* ret = nullptr;
   std::string new_name;
   {
@@ -70,6 +76,9 @@ Variable* Scope::Var(std::string* name) {
 }
 
 Variable* Scope::FindVar(const std::string& name) const {
+  if (IsFrozen()) {
+    return FindVarInternal(name);
+  }
   SCOPE_VARS_READER_LOCK
   return FindVarInternal(name);
 }
@@ -82,6 +91,9 @@ Variable* Scope::GetVar(const std::string& name) const {
 }
 
 Variable* Scope::FindLocalVar(const std::string& name) const {
+  if (IsFrozen()) {
+    return FindVarLocally(name);
+  }
   SCOPE_VARS_READER_LOCK
   return FindVarLocally(name);
 }
@@ -164,6 +176,8 @@ void Scope::DeleteScope(Scope* scope) const {
 }
 
 void Scope::EraseVars(const std::vector<std::string>& var_names) {
+  if (var_names.empty()) return;
+  EnforceNotFrozen(var_names.front());
   {
     std::set<std::string> var_set(var_names.begin(), var_names.end());
     SCOPE_VARS_WRITER_LOCK
@@ -179,6 +193,7 @@ void Scope::EraseVars(const std::vector<std::string>& var_names) {
 
 void Scope::Rename(const std::string& origin_name,
                    const std::string& new_name) const {
+  EnforceNotFrozen(origin_name);
   {
     SCOPE_VARS_WRITER_LOCK
     RenameInternal(origin_name, new_name);
@@ -186,6 +201,7 @@ void Scope::Rename(const std::string& origin_name,
 }
 
 std::string Scope::Rename(const std::string& origin_name) const {
+  EnforceNotFrozen(origin_name);
   auto new_name = string::Sprintf("%p.%d", this, vars_.size());
   {
     SCOPE_VARS_WRITER_LOCK
@@ -254,7 +270,18 @@ Variable* Scope::FindVarLocally(const std::string& name) const {
   return nullptr;
 }
 
+void Scope::EnforceNotFrozen(const std::string& name) const {
+  PADDLE_ENFORCE_EQ(
+      IsFrozen(),
+      false,
+      common::errors::PreconditionNotMet(
+          "Cannot modify %s of the scope %p, since the scope is frozen.",
+          name,
+          this));
+}
+
 void Scope::EraseVarsExcept(const std::unordered_set<Variable*>& vars) {
+  EnforceNotFrozen("the variables not in the given set");
   SCOPE_VARS_WRITER_LOCK
   for (auto iter = vars_.begin(); iter != vars_.end();) {
     if (vars.count(iter->second.get()) != 0) {
@@ -18,6 +18,7 @@ extern "C" {
 #include <xxhash.h>
 }
 
+#include <atomic>
 #include <list>
 #include <memory>
 #include <string>
@@ -129,6 +130,16 @@ class TEST_API Scope {
 
   void SetCanReused(bool can_reused) { can_reused_ = can_reused; }
 
+  /// Make the variables of the scope read-only, so that the lookups of them
+  /// skip the lock, e.g. the parameter scope shared by the cloned predictors.
+  /// Creating, erasing or renaming a variable of a frozen scope is an error,
+  /// and no lookup may run concurrently with Unfreeze.
+  void Freeze() { frozen_.store(true, std::memory_order_release); }
+
+  void Unfreeze() { frozen_.store(false, std::memory_order_release); }
+
+  bool IsFrozen() const { return frozen_.load(std::memory_order_acquire); }
+
  protected:
   struct KeyHasher {
     std::size_t operator()(const std::string& key) const {
@@ -162,6 +173,9 @@ class TEST_API Scope {
   // Called by FindVarInternal and Var.
   Variable* FindVarLocally(const std::string& name) const;
 
+  // Called by the methods modifying the variables.
+  void EnforceNotFrozen(const std::string& name) const;
+
   // Scope in `kids_` are owned by this class.
   mutable std::list<Scope*> kids_;
   const Scope* parent_{nullptr};
@@ -169,6 +183,8 @@ class TEST_API Scope {
   // only for dygraph_to_static
   bool can_reused_{false};
 
+  std::atomic<bool> frozen_{false};
+
   DISABLE_COPY_AND_ASSIGN(Scope);
 
  private:
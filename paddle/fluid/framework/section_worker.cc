@@ -10,6 +10,7 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #if defined(PADDLE_WITH_NCCL) || defined(PADDLE_WITH_RCCL)
+#include <algorithm>
 #include <cfloat>
 
 #include "paddle/fluid/framework/device_worker.h"
@@ -57,8 +58,43 @@ void SectionWorker::Initialize(const TrainerDesc &desc) {
     }
   }
 
-  // if not 1F1B scheduler
-  if (schedule_mode_ != 1) return;
+  if (schedule_mode_ == 2) {
+    // group the ops of each model chunk, the ops without a chunk_id are in
+    // the first chunk
+    PADDLE_ENFORCE_GT(num_model_chunks_,
+                      0,
+                      common::errors::InvalidArgument(
+                          "The number of model chunks (%d) should be "
+                          "positive.",
+                          num_model_chunks_));
+    chunk_forward_and_lr_ops_.resize(num_model_chunks_);
+    chunk_forward_ops_.resize(num_model_chunks_);
+    chunk_backward_ops_.resize(num_model_chunks_);
+    auto chunk_of = [this](OperatorBase *op) {
+      int chunk_id = op->HasAttr("chunk_id") ? op->Attr<int>("chunk_id") : 0;
+      PADDLE_ENFORCE_EQ(
+          chunk_id >= 0 && chunk_id < num_model_chunks_,
+          true,
+          common::errors::InvalidArgument(
+              "The chunk_id (%d) of op %s should be in [0, %d).",
+              chunk_id,
+              op->Type(),
+              num_model_chunks_));
+      return chunk_id;
+    };
+    for (auto *op : forward_and_lr_ops_) {
+      chunk_forward_and_lr_ops_[chunk_of(op)].push_back(op);
+    }
+    for (auto *op : forward_ops_) {
+      chunk_forward_ops_[chunk_of(op)].push_back(op);
+    }
+    for (auto *op : backward_ops_) {
+      chunk_backward_ops_[chunk_of(op)].push_back(op);
+    }
+  }
+
+  // if F-then-B scheduler
+  if (schedule_mode_ == 0) return;
 
   bool is_first_stage = (pipeline_stage_ == 0);
   int BACKWARD = static_cast<int>(OpRole::kBackward);
@@ -220,6 +256,97 @@ void SectionWorker::Run1F1B(std::unique_ptr<GarbageCollector> &gc) {
   }
 }
 
+void SectionWorker::RunInterleaved1F1B(std::unique_ptr<GarbageCollector> &gc) {
+  // Interleaved 1F1B scheduler, where each stage holds num_model_chunks_
+  // chunks of the model and a micro-batch goes through the stages once for
+  // each chunk. The micro-batches go in groups of num_pipeline_stages_,
+  // every group runs chunk by chunk, which cuts the bubble of the startup
+  // and the cooldown phases by num_model_chunks_.
+  const int num_chunks = num_model_chunks_;
+  const int num_stages = num_pipeline_stages_;
+  PADDLE_ENFORCE_EQ(
+      num_microbatches_ % num_stages,
+      0,
+      common::errors::InvalidArgument(
+          "To use pipeline with interleaved 1F1B scheduler, please make sure "
+          "number of microbatches (%d) is divisible by the number of stages "
+          "(%d).",
+          num_microbatches_,
+          num_stages));
+  const int total_steps = num_microbatches_ * num_chunks;
+  const int startup_steps =
+      std::min(total_steps,
+               (num_stages - pipeline_stage_ - 1) * 2 +
+                   (num_chunks - 1) * num_stages);
+  VLOG(3) << "startup_steps:" << startup_steps << ", num_stages: " << num_stages
+          << ", stage:" << pipeline_stage_ << ", num_chunks:" << num_chunks;
+
+  auto micro_id_of = [&](int step) {
+    return step / (num_stages * num_chunks) * num_stages + step % num_stages;
+  };
+  // the backward steps run the chunks in the reverse order
+  auto chunk_id_of = [&](int step, bool forward) {
+    int chunk_id = step / num_stages % num_chunks;
+    return forward ? chunk_id : num_chunks - chunk_id - 1;
+  };
+  auto run = [&](const std::vector<OperatorBase *> &ops,
+                 int micro_id,
+                 int chunk_id,
+                 const char *phase) {
+    for (auto *op : ops) {
+      VLOG(3) << phase << ": running op " << op->Type() << " for micro-batch "
+              << micro_id << " of chunk " << chunk_id;
+      op->Run(*microbatch_scopes_[micro_id], place_);
+      if (gc) {
+        DeleteUnusedTensors(
+            *microbatch_scopes_[micro_id], op, unused_vars_, gc.get());
+      }
+    }
+  };
+  auto run_forward = [&](int step) {
+    int micro_id = micro_id_of(step);
+    int chunk_id = chunk_id_of(step, true);
+    run(micro_id == 0 ? chunk_forward_and_lr_ops_[chunk_id]
+                      : chunk_forward_ops_[chunk_id],
+        micro_id,
+        chunk_id,
+        "Forward");
+  };
+  auto run_backward = [&](int step) {
+    int chunk_id = chunk_id_of(step, false);
+    run(chunk_backward_ops_[chunk_id], micro_id_of(step), chunk_id, "Backward");
+  };
+
+  int fw_step = 0;
+  int bw_step = 0;
+  // startup phase
+  while (fw_step < startup_steps) {
+    run_forward(fw_step++);
+  }
+  // 1f1b phase
+  while (fw_step < total_steps) {
+    run_forward(fw_step++);
+    run_backward(bw_step++);
+    VLOG(2) << "micro steps fw_step:" << fw_step << ", bw_step:" << bw_step;
+  }
+  // backward phase
+  while (bw_step < total_steps) {
+    run_backward(bw_step++);
+  }
+
+  VLOG(2) << "run update";
+  RunUpdate(gc, unused_vars_);
+
+  if (gc) {
+    // the backward send vars of a micro-batch are used by all its chunks,
+    // delete them after the sync backward send comm at update
+    for (int i = 0; i < num_microbatches_; ++i) {
+      DeleteUnusedTensors(
+          *microbatch_scopes_[i], backward_send_vars_, gc.get());
+    }
+  }
+}
+
 void SectionWorker::TrainFiles() {
   VLOG(5) << "begin section_worker TrainFiles";
   VLOG(2) << "mini batch steps:" << batch_id_;
@@ -239,6 +366,8 @@ void SectionWorker::TrainFiles() {
 
   if (schedule_mode_ == 0) {  // NOLINT
     RunFThenB(gc);
+  } else if (schedule_mode_ == 2) {
+    RunInterleaved1F1B(gc);
   } else {
     Run1F1B(gc);
   }
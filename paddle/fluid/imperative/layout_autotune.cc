@@ -15,11 +15,15 @@
 #include "paddle/fluid/imperative/layout_autotune.h"
 
 #include "paddle/common/errors.h"
+#include "paddle/common/flags.h"
 #include "paddle/fluid/eager/api/utils/global_utils.h"
 #include "paddle/fluid/framework/op_info.h"
 #include "paddle/fluid/imperative/layout_transformer.h"
 #include "paddle/phi/backends/gpu/gpu_info.h"
 #include "paddle/phi/core/enforce.h"
+
+COMMON_DECLARE_double(layout_autotune_region_gain);
+
 namespace paddle::imperative {
 
 LayoutAutoTune::LayoutAutoTune() {
@@ -87,6 +91,39 @@ LayoutAutoTune::LayoutAutoTune() {
           << lightly_layout_sensitive_ops_.size();
 }
 
+bool LayoutAutoTune::PlanRegion(const std::string& key) {
+  if (FLAGS_layout_autotune_region_gain <= 0 || key.empty()) {
+    return true;
+  }
+  auto it = regions_.find(key);
+  if (it == regions_.end()) {
+    tracing_region_ = &regions_[key];
+    return true;
+  }
+  // the regions are traced once, and replayed with the plan afterwards
+  tracing_region_ = nullptr;
+  const auto& region = it->second;
+  bool tune = static_cast<double>(region.tuned_numel) *
+                  FLAGS_layout_autotune_region_gain >=
+              static_cast<double>(region.transposed_numel);
+  VLOG(4) << "Layout region of " << key << " tunes " << region.tuned_numel
+          << " elements with " << region.transposed_numel
+          << " elements transposed, " << (tune ? "tune it" : "skip it");
+  return tune;
+}
+
+void LayoutAutoTune::RecordTunedOp(int64_t numel) {
+  if (tracing_region_ != nullptr) {
+    tracing_region_->tuned_numel += numel;
+  }
+}
+
+void LayoutAutoTune::RecordTranspose(int64_t numel) {
+  if (tracing_region_ != nullptr) {
+    tracing_region_->transposed_numel += numel;
+  }
+}
+
 template <typename VarType>
 paddle::imperative::NameVarMap<VarType> DealHeavilyLayoutSensitive(
     const std::string& op_type,
@@ -16,6 +16,8 @@
 #include <glog/logging.h>
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "paddle/common/layout.h"
@@ -55,8 +57,18 @@ class LayoutAutoTune {
 
   void SetDefaultLayout(const DataLayout& layout) { default_layout_ = layout; }
 
- private:
-  LayoutAutoTune();
+  // The global layout planning (FLAGS_layout_autotune_region_gain > 0). A
+  // heavily layout sensitive op which moves its input into the desired layout
+  // opens a region of the model run in it. The first time the op is met,
+  // the elements transposed and the elements computed by the heavily layout
+  // sensitive ops in the region are traced; the next times, the region is
+  // only tuned if its gain outweighs its transposes. The op is identified by
+  // the key, the name of its parameter, and an empty key is never planned.
+  bool PlanRegion(const std::string& key);
+
+  void RecordTunedOp(int64_t numel);
+
+  void RecordTranspose(int64_t numel);
 
   std::unordered_set<std::string> layout_agnostic_ops_{};
 
@@ -70,6 +82,16 @@ class LayoutAutoTune {
 
   // Default Layout in this model
   DataLayout default_layout_{DataLayout::UNDEFINED};
+
+  struct LayoutRegion {
+    int64_t tuned_numel{0};
+    int64_t transposed_numel{0};
+  };
+
+  std::unordered_map<std::string, LayoutRegion> regions_;
+
+  // The region being traced, none once the traced regions are met again.
+  LayoutRegion* tracing_region_{nullptr};
 };
 
 // LayoutAutotuneGuard is used for RAII.
@@ -20,6 +20,7 @@
 #include <string>
 #include <unordered_set>
 
+#include "paddle/common/flags.h"
 #include "paddle/fluid/framework/block_desc.h"
 #include "paddle/fluid/framework/ir/graph_helper.h"
 #include "paddle/fluid/framework/ir/graph_pattern_detector.h"
@@ -38,9 +39,52 @@
 #include "paddle/phi/common/backend.h"
 #include "paddle/phi/common/data_type.h"
 
+COMMON_DECLARE_int32(trt_min_light_subgraph_size);
+
 namespace paddle::inference::analysis {
 namespace {
 
+bool IsComputeHeavyOp(const std::string &op_type) {
+  static const std::unordered_set<std::string> heavy_ops = {
+      "conv2d",
+      "conv2d_transpose",
+      "conv3d",
+      "conv3d_transpose",
+      "depthwise_conv2d",
+      "depthwise_conv2d_transpose",
+      "fused_conv2d_add_act",
+      "matmul",
+      "matmul_v2",
+      "mul",
+      "fc",
+      "multihead_matmul",
+      "multihead_matmul_roformer",
+      "fused_multihead_attention",
+      "flash_multihead_matmul",
+      "cross_multihead_matmul",
+      "qk_multihead_matmul",
+      "fused_embedding_eltwise_layernorm",
+      "fused_token_prune",
+  };
+  return heavy_ops.count(op_type) > 0;
+}
+
+// A subgraph made of memory bound ops only is worth an engine when it is long
+// enough to amortize the copies and the synchronization at its boundary.
+bool IsProfitableSubgraph(const std::vector<framework::ir::Node *> &subgraph) {
+  if (FLAGS_trt_min_light_subgraph_size <= 0) return true;
+  for (auto *node : subgraph) {
+    if (node->IsOp() && IsComputeHeavyOp(node->Op()->Type())) return true;
+  }
+  if (subgraph.size() >=
+      static_cast<size_t>(FLAGS_trt_min_light_subgraph_size)) {
+    return true;
+  }
+  VLOG(3) << "Leave a TensorRT subgraph of " << subgraph.size()
+          << " ops without compute heavy op to paddle.";
+  return false;
+}
+
 // if in mixed model precision, we should make all tensorrt_engine's output
 // floats dtype to float32 dtype.
 void OutputProcess(framework::ir::Graph *graph,
@@ -118,6 +162,42 @@ bool AllNodesLowerToTrtPostProcess(framework::ir::Graph *graph) {
   }
   return all_nodes_offload_to_trt;
 }
+
+// The calibration table of an engine only depends on the ops it runs, so it
+// is keyed by the ops of the renamed subgraph. Unlike the engine key, it does
+// not change with the nodes and the parameters of the rest of the graph, and
+// the tables calibrated before stay valid when the graph is partitioned into
+// other engines.
+std::string GenerateCalibrationKey(const framework::BlockDesc &block_desc,
+                                   const std::string &precision,
+                                   bool use_cuda_graph) {
+  std::string calibration_hash_key = "";
+  for (auto *op : block_desc.AllOps()) {
+    calibration_hash_key += op->Type();
+    for (const auto &input : op->Inputs()) {
+      calibration_hash_key += "#" + input.first + ":";
+      for (const auto &name : input.second) {
+        calibration_hash_key += name + ",";
+      }
+    }
+    for (const auto &output : op->Outputs()) {
+      calibration_hash_key += "#" + output.first + ":";
+      for (const auto &name : output.second) {
+        calibration_hash_key += name + ",";
+      }
+    }
+    calibration_hash_key += ";";
+  }
+  calibration_hash_key += precision;
+  calibration_hash_key += "#";
+  calibration_hash_key += std::to_string(use_cuda_graph);
+
+  auto calibration_key =
+      std::to_string(std::hash<std::string>()(calibration_hash_key));
+  VLOG(2) << "TRT calibration hash key: " << calibration_hash_key;
+  VLOG(2) << "TRT calibration key: " << calibration_key;
+  return calibration_key;
+}
 }  // namespace
 
 using framework::ir::Node;
@@ -187,6 +267,7 @@ void analysis::TensorRtSubgraphPass::ApplyImpl(
       Get<int>("min_subgraph_size") /*min subgraph size*/,
       Get<std::vector<std::string>>("trt_exclude_var_names"),
       "tensorrt_engine");
+  fuser.SetSubgraphFilter(IsProfitableSubgraph);
   fuser();
 
   std::vector<std::string> graph_param_names =
@@ -738,14 +819,10 @@ std::string TensorRtSubgraphPass::CreateTensorRTOp(
                         std::to_string(static_cast<int>(precision_mode)),
                         use_cuda_graph,
                         false);
-  auto calibration_engine_key =
-      GenerateEngineKey(input_names_with_id,
-                        output_names_with_id,
-                        std::to_string(0),
-                        std::to_string(max_batch_size),
-                        std::to_string(static_cast<int>(precision_mode)),
-                        use_cuda_graph,
-                        true);
+  auto calibration_engine_key = GenerateCalibrationKey(
+      block_desc,
+      std::to_string(static_cast<int>(precision_mode)),
+      use_cuda_graph);
   auto predictor_id = Get<int>("predictor_id");
 
   // Get "" when there is no cached calibration table data.
@@ -755,6 +832,19 @@ std::string TensorRtSubgraphPass::CreateTensorRTOp(
         GetTrtCalibTableData(Get<std::string>("model_opt_cache_dir"),
                              calibration_engine_key,
                              enable_int8);
+    if (calibration_data.empty()) {
+      // The tables saved before were keyed like the engines.
+      calibration_data = GetTrtCalibTableData(
+          Get<std::string>("model_opt_cache_dir"),
+          GenerateEngineKey(input_names_with_id,
+                            output_names_with_id,
+                            std::to_string(0),
+                            std::to_string(max_batch_size),
+                            std::to_string(static_cast<int>(precision_mode)),
+                            use_cuda_graph,
+                            true),
+          enable_int8);
+    }
   }
   op_desc->SetAttr("calibration_data", calibration_data);
   op_desc->SetAttr("enable_int8", enable_int8);
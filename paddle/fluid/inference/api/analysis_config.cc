@@ -532,6 +532,8 @@ AnalysisConfig::AnalysisConfig(const AnalysisConfig &other) {
   CP_MEMBER(trt_allow_build_at_runtime_);
   CP_MEMBER(collect_shape_range_info_);
   CP_MEMBER(shape_range_info_path_);
+  CP_MEMBER(collect_activation_amax_);
+  CP_MEMBER(activation_amax_path_);
   CP_MEMBER(trt_use_inspector_);
   CP_MEMBER(trt_inspector_serialize_);
   CP_MEMBER(trt_use_explicit_quantization_);
@@ -575,6 +577,7 @@ AnalysisConfig::AnalysisConfig(const AnalysisConfig &other) {
   CP_MEMBER(specify_input_name_);
 
   CP_MEMBER(use_optimized_model_);
+  CP_MEMBER(params_mmap_enabled_);
 
   CP_MEMBER(cpu_math_library_num_threads_);
 
@@ -777,8 +780,10 @@ void AnalysisConfig::EnableTensorRtEngine(int64_t workspace_size,
   trt_use_calib_mode_ = use_calib_mode;
   trt_use_cuda_graph_ = use_cuda_graph;
   if (use_cuda_graph) {
-    LOG_FIRST_N(INFO, 1) << "You have enabled Trt Cuda Graph, you must ensure "
-                            "that the input Shape remains unchanged.";
+    LOG_FIRST_N(INFO, 1) << "You have enabled Trt Cuda Graph, a graph is "
+                            "captured for every distinct input shape, the "
+                            "number of the graphs is limited by "
+                            "FLAGS_trt_cuda_graph_pool_size.";
   }
 
   Update();
@@ -1161,6 +1166,7 @@ std::string AnalysisConfig::SerializeInfoCache() {
   ss << ir_debug_;
 
   ss << use_optimized_model_;
+  ss << params_mmap_enabled_;
 
   ss << specify_input_name_;
   ss << cpu_math_library_num_threads_;
@@ -1461,11 +1467,15 @@ std::string AnalysisConfig::Summary() {
   os.InsertRow({"ir_debug", ir_debug_ ? "true" : "false"});
   os.InsertRow(
       {"use_optimized_model", use_optimized_model_ ? "true" : "false"});
+  os.InsertRow(
+      {"params_mmap_enabled", params_mmap_enabled_ ? "true" : "false"});
   os.InsertRow({"memory_optim", enable_memory_optim_ ? "true" : "false"});
   os.InsertRow({"enable_profile", with_profile_ ? "true" : "false"});
   os.InsertRow({"enable_log", with_glog_info_ ? "true" : "false"});
   os.InsertRow({"collect_shape_range_info",
                 collect_shape_range_info_ ? shape_range_info_path_ : "false"});
+  os.InsertRow({"collect_activation_amax",
+                collect_activation_amax_ ? activation_amax_path_ : "false"});
 
   return os.PrintTable();
 }
@@ -1493,6 +1503,28 @@ bool AnalysisConfig::shape_range_info_collected() const {
   return collect_shape_range_info_;
 }
 
+void AnalysisConfig::CollectActivationAmax(
+    const std::string &activation_amax_path) {
+  LOG(INFO) << "In CollectActivationAmax mode, we will disable optimizations "
+               "and record the absolute maximum of all the float tensors in "
+               "the compute graph.";
+  collect_activation_amax_ = true;
+  PADDLE_ENFORCE_EQ(activation_amax_path.empty(),
+                    false,
+                    common::errors::InvalidArgument(
+                        "The activation_amax_path should not be empty, please "
+                        "re-check the argument."));
+  activation_amax_path_ = activation_amax_path;
+}
+
+const std::string &AnalysisConfig::activation_amax_path() const {
+  return activation_amax_path_;
+}
+
+bool AnalysisConfig::activation_amax_collected() const {
+  return collect_activation_amax_;
+}
+
 void AnalysisConfig::EnableTunedTensorRtDynamicShape(
     const std::string &shape_range_info_path, bool allow_build_at_runtime) {
   shape_range_info_path_ = shape_range_info_path;
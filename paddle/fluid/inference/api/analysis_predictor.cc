@@ -17,6 +17,7 @@
 #include <glog/logging.h>
 
 #include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
@@ -38,6 +39,7 @@
 #include "paddle/fluid/framework/op_proto_maker.h"
 #include "paddle/fluid/framework/operator.h"
 #include "paddle/fluid/framework/scope.h"
+#include "paddle/fluid/framework/tensor_util.h"
 #include "paddle/fluid/framework/transfer_scope_cache.h"
 #include "paddle/fluid/framework/var_type_traits.h"
 #include "paddle/fluid/framework/version.h"
@@ -62,6 +64,7 @@
 #include "paddle/phi/common/backend.h"
 #include "paddle/phi/common/data_type.h"
 #include "paddle/phi/common/place.h"
+#include "paddle/phi/core/memory/malloc.h"
 #include "paddle/phi/core/memory/memcpy.h"
 #include "paddle/phi/core/platform/cpu_helper.h"
 #include "paddle/phi/core/platform/device/gpu/gpu_info.h"
@@ -135,6 +138,10 @@
 
 COMMON_DECLARE_bool(pir_apply_inplace_pass);
 COMMON_DECLARE_bool(enable_auto_layout_pass);
+COMMON_DECLARE_bool(freeze_cloned_predictor_scope);
+COMMON_DECLARE_bool(predictor_pool_share_trt_engine);
+COMMON_DECLARE_bool(predictor_clone_private_stream);
+COMMON_DECLARE_int64(predictor_batch_feed_max_bytes);
 namespace paddle {
 namespace {
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
@@ -381,7 +388,8 @@ AnalysisPredictor::AnalysisPredictor(const AnalysisConfig &config)
       shape_info_(),
       shape_tensor_value_(),
       device_contexts_() {
-  if (config_.shape_range_info_collected()) {
+  if (config_.shape_range_info_collected() ||
+      config_.activation_amax_collected()) {
     config_.SwitchIrOptim(false);
   }
   if (config_.new_executor_enabled()) {
@@ -524,6 +532,12 @@ bool AnalysisPredictor::Init(
   if (config_.use_gpu_ && config_.use_external_stream_) {
     private_context_ = true;
   }
+  // A clone without an external stream gets a stream owned by its resource,
+  // which InitResourceManager creates from the null predictor_stream_.
+  if (config_.use_gpu_ && status_is_cloned_ &&
+      FLAGS_predictor_clone_private_stream) {
+    private_context_ = true;
+  }
   if (private_context_) {
     if (!status_is_cloned_) {
       predictor_stream_ = config_.GetExecStream();
@@ -1018,6 +1032,21 @@ void AnalysisPredictor::OptimizeInferencePirProgram() {
       }
     }
 
+    // Prepack the weights: the weight transforms inserted by the passes
+    // above, e.g. weight_quantize of weight_only_linear and the filters
+    // folded with batch_norm, run once here and their results replace them
+    // as persistable params, which are saved with the optimized model.
+    std::vector<std::unique_ptr<::pir::Pass>> prepack_passes;
+    prepack_passes.push_back(::pir::CreateConstantFoldingPass());
+    prepack_passes.push_back(::pir::CreateDeadCodeEliminationPass());
+    for (auto &prepack_pass : prepack_passes) {
+      if (std::find(config_.deleted_passes_.begin(),
+                    config_.deleted_passes_.end(),
+                    prepack_pass->name()) == config_.deleted_passes_.end()) {
+        pass_pm.AddPass(std::move(prepack_pass));
+      }
+    }
+
     // set attr
     for (const auto &pass : pass_pm.passes()) {
       pass->SetNotOwned(pir::Pass::kParamScopeAttr, sub_scope_);
@@ -1319,6 +1348,12 @@ bool AnalysisPredictor::SaveOrLoadPirParameters(bool for_save) {
             tensor_out.end(), local_tensor_out.begin(), local_tensor_out.end());
       }
 
+    } else if (config_.params_mmap_enabled()) {
+      pir::LoadCombineFunctionWithMmap(config_.params_file(),
+                                       filter_param_names,
+                                       &tensor_out,
+                                       false,
+                                       place_);
     } else {
       pir::LoadCombineFunction(config_.params_file(),
                                filter_param_names,
@@ -1603,6 +1638,9 @@ bool AnalysisPredictor::Run(const std::vector<PaddleTensor> &inputs,
   if (config_.shape_range_info_collected()) {
     HookCollectShapeRangeInfo();
   }
+  if (config_.activation_amax_collected()) {
+    HookCollectActivationAmax();
+  }
 
   if (config_.new_executor_enabled()) {  // NOLINT
     executor_->RunInterpreterCore();
@@ -1682,6 +1720,9 @@ bool AnalysisPredictor::Run(const std::vector<paddle::Tensor> &inputs,
   if (config_.shape_range_info_collected()) {
     HookCollectShapeRangeInfo();
   }
+  if (config_.activation_amax_collected()) {
+    HookCollectActivationAmax();
+  }
 #ifdef PADDLE_WITH_XPU
   InferXPUContext *infer_xpu_ctx = nullptr;
   if (config_.use_xpu_) {
@@ -1760,10 +1801,11 @@ bool AnalysisPredictor::SetFeed(const std::vector<PaddleTensor> &inputs,
 
   // Cache the inputs memory for better concurrency performance.
   feed_tensors_.resize(inputs.size());
+  bool batch_copied = BatchCopyFeeds(inputs);
 
   for (size_t i = 0; i < inputs.size(); ++i) {
     phi::DenseTensor *input = &feed_tensors_[i];
-    if (!PaddleTensorToDenseTensor(inputs[i], input, place_)) {
+    if (!batch_copied && !PaddleTensorToDenseTensor(inputs[i], input, place_)) {
       return false;
     }
     int idx = -1;
@@ -1784,6 +1826,88 @@ bool AnalysisPredictor::SetFeed(const std::vector<PaddleTensor> &inputs,
   return true;
 }
 
+bool AnalysisPredictor::BatchCopyFeeds(
+    const std::vector<PaddleTensor> &inputs) {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (FLAGS_predictor_batch_feed_max_bytes <= 0 || !phi::is_gpu_place(place_) ||
+      inputs.size() < 2) {
+    return false;
+  }
+  constexpr size_t kFeedAlignment = 256;
+  std::vector<phi::DataType> dtypes(inputs.size());
+  std::vector<size_t> offsets(inputs.size());
+  size_t total_bytes = 0;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const auto &pt = inputs[i];
+    switch (pt.dtype) {
+      case PaddleDType::INT64:
+        dtypes[i] = phi::DataType::INT64;
+        break;
+      case PaddleDType::FLOAT32:
+        dtypes[i] = phi::DataType::FLOAT32;
+        break;
+      case PaddleDType::INT32:
+        dtypes[i] = phi::DataType::INT32;
+        break;
+      case PaddleDType::FLOAT16:
+        dtypes[i] = phi::DataType::FLOAT16;
+        break;
+      case PaddleDType::BFLOAT16:
+        dtypes[i] = phi::DataType::BFLOAT16;
+        break;
+      default:
+        return false;
+    }
+    // Leave the feeds which are empty, large or malformed to the per-feed
+    // copy, which also reports the errors.
+    size_t bytes = pt.data.length();
+    int64_t numel = common::product(common::make_ddim(pt.shape));
+    if (bytes == 0 || pt.data.data() == nullptr ||
+        bytes > static_cast<size_t>(FLAGS_predictor_batch_feed_max_bytes) ||
+        bytes != static_cast<size_t>(numel) * phi::SizeOf(dtypes[i])) {
+      return false;
+    }
+    offsets[i] = total_bytes;
+    total_bytes +=
+        (bytes + kFeedAlignment - 1) / kFeedAlignment * kFeedAlignment;
+  }
+
+  if (!feed_host_buffer_ || feed_host_buffer_->size() < total_bytes) {
+    feed_host_buffer_ = memory::AllocShared(phi::GPUPinnedPlace(), total_bytes);
+    feed_device_buffer_ = memory::AllocShared(place_, total_bytes);
+  }
+  auto *host_ptr = static_cast<uint8_t *>(feed_host_buffer_->ptr());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    std::memcpy(
+        host_ptr + offsets[i], inputs[i].data.data(), inputs[i].data.length());
+  }
+  phi::DeviceContextPool &pool = phi::DeviceContextPool::Instance();
+  auto *dev_ctx = static_cast<const phi::GPUContext *>(pool.Get(place_));
+  memory::Copy(place_,
+               feed_device_buffer_->ptr(),
+               phi::GPUPinnedPlace(),
+               host_ptr,
+               total_bytes,
+               dev_ctx->stream());
+
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    phi::DenseTensorMeta meta(dtypes[i],
+                              common::make_ddim(inputs[i].shape),
+                              phi::DataLayout::NCHW,
+                              offsets[i]);
+    feed_tensors_[i] = phi::DenseTensor(feed_device_buffer_, meta);
+    phi::LegacyLoD lod;
+    for (auto &level : inputs[i].lod) {
+      lod.emplace_back(level);
+    }
+    feed_tensors_[i].set_lod(lod);
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
 bool AnalysisPredictor::SetFeed(const std::vector<paddle::Tensor> &inputs,
                                 framework::Scope *scope) {
   VLOG(3) << "Predictor::set_feed";
@@ -2612,6 +2736,9 @@ bool AnalysisPredictor::ZeroCopyRun(bool switch_stream) {
   if (config_.shape_range_info_collected()) {
     HookCollectShapeRangeInfo();
   }
+  if (config_.activation_amax_collected()) {
+    HookCollectActivationAmax();
+  }
 #ifdef PADDLE_WITH_XPU
   InferXPUContext *infer_xpu_ctx = nullptr;
   if (config_.use_xpu_) {
@@ -2643,6 +2770,7 @@ bool AnalysisPredictor::ZeroCopyRun(bool switch_stream) {
     executor_->Run();
   }
   inference::DisplayMemoryInfo(place_, "after run");
+  bool bound_written = bound_outputs_.empty() || WriteBoundOutputs();
 
 #ifdef PADDLE_WITH_XPU
   if (config_.use_xpu_ && infer_xpu_ctx != nullptr &&
@@ -2682,7 +2810,7 @@ bool AnalysisPredictor::ZeroCopyRun(bool switch_stream) {
   // https://software.intel.com/en-us/mkl-developer-reference-c-mkl-free-buffers
   phi::dynload::MKL_Free_Buffers();
 #endif
-  return true;
+  return bound_written;
 }
 
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
@@ -2737,18 +2865,6 @@ void AnalysisPredictor::HookCollectShapeRangeInfo() {
                   const std::string &input_name,
                   const paddle::Tensor &input_tensor) -> void {
     phi::DeviceContextPool &pool = phi::DeviceContextPool::Instance();
-    if (config_.use_gpu()) {
-#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
-      auto *dev_ctx = pool.Get(place_);
-      auto stream = static_cast<phi::GPUContext *>(dev_ctx)->stream();
-#ifdef PADDLE_WITH_HIP
-      hipStreamSynchronize(stream);
-#else
-      cudaStreamSynchronize(stream);
-#endif
-#endif
-    }
-
     if (!input_tensor.is_dense_tensor()) return;
     auto tensor =
         std::dynamic_pointer_cast<phi::DenseTensor>(input_tensor.impl()).get();
@@ -2796,20 +2912,22 @@ void AnalysisPredictor::HookCollectShapeRangeInfo() {
                              int32_tensor.numel() * sizeof(int));
       } else if (phi::is_gpu_place(tensor->place())) {
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
-        auto *dev_ctx = pool.Get(tensor->place());
+        // Only the data of the shape tensors needs the stream to be synced,
+        // the shapes are known on the host.
+        auto *dev_ctx =
+            static_cast<phi::GPUContext *>(pool.Get(tensor->place()));
         auto &int32_tensor = *tensor;
         if (tensor->dtype() == phi::DataType::INT64) {
-          int32_tensor = phi::funcs::TransDataType(
-              reinterpret_cast<const phi::GPUContext &>(*dev_ctx),
-              *tensor,
-              DataType::INT32);
+          int32_tensor =
+              phi::funcs::TransDataType(*dev_ctx, *tensor, DataType::INT32);
         }
         paddle::memory::Copy(phi::CPUPlace(),
                              int32_host.data(),
                              int32_tensor.place(),
                              int32_tensor.data<int>(),
                              int32_tensor.numel() * sizeof(int),
-                             nullptr);
+                             dev_ctx->stream());
+        dev_ctx->Wait();
 #endif
       }
       shape_tensor_value_[input_name].emplace_back(int32_host);
@@ -2818,6 +2936,47 @@ void AnalysisPredictor::HookCollectShapeRangeInfo() {
   RegisterInputHook(hook);
 }
 
+void AnalysisPredictor::HookCollectActivationAmax() {
+  auto hook = [&](const std::string &op_type,
+                  const std::string &input_name,
+                  const paddle::Tensor &input_tensor) -> void {
+    if (!input_tensor.is_dense_tensor()) return;
+    auto tensor =
+        std::dynamic_pointer_cast<phi::DenseTensor>(input_tensor.impl()).get();
+    if (!tensor->IsInitialized() || tensor->numel() == 0) return;
+    auto dtype = tensor->dtype();
+    if (dtype != phi::DataType::FLOAT32 && dtype != phi::DataType::FLOAT16 &&
+        dtype != phi::DataType::BFLOAT16) {
+      return;
+    }
+
+    // The amax is only collected in a short warmup, so the tensor is simply
+    // copied to host, which also waits for the kernels writing it.
+    phi::DenseTensor cpu_tensor;
+    framework::TensorCopySync(*tensor, phi::CPUPlace(), &cpu_tensor);
+    if (dtype != phi::DataType::FLOAT32) {
+      phi::DeviceContextPool &pool = phi::DeviceContextPool::Instance();
+      auto *cpu_ctx = pool.Get(phi::CPUPlace());
+      cpu_tensor = phi::funcs::TransDataType(
+          reinterpret_cast<const phi::CPUContext &>(*cpu_ctx),
+          cpu_tensor,
+          DataType::FLOAT32);
+    }
+    const float *data = cpu_tensor.data<float>();
+    float amax = 0.f;
+    for (int64_t i = 0; i < cpu_tensor.numel(); ++i) {
+      amax = std::max(amax, std::abs(data[i]));
+    }
+    auto it = activation_amax_.find(input_name);
+    if (it == activation_amax_.end()) {
+      activation_amax_.emplace(input_name, amax);
+    } else {
+      it->second = std::max(it->second, amax);
+    }
+  };
+  RegisterInputHook(hook);
+}
+
 bool AnalysisPredictor::ExpRunWithRuntimeConfig(void *config) {
 #ifdef PADDLE_WITH_XPU
   auto xpu_runtime_config =
@@ -3147,6 +3306,10 @@ AnalysisPredictor::~AnalysisPredictor() {  // NOLINT
   if (config_.shape_range_info_collected()) {
     StatisticShapeRangeInfo();
   }
+  if (config_.activation_amax_collected()) {
+    inference::SerializeActivationAmax(config_.activation_amax_path(),
+                                       activation_amax_);
+  }
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
   if (predictor_stream_ != nullptr) {
     ResourceManager::Instance().DestroyGPUResource(predictor_stream_);
@@ -3184,6 +3347,10 @@ std::unique_ptr<PaddlePredictor> AnalysisPredictor::Clone(void *stream) {
   }
   x->predictor_stream_ = stream;
   x->Init(scope_, inference_program_);
+  if (FLAGS_freeze_cloned_predictor_scope) {
+    // The parameters of the clones are all in the shared scope_ after Init
+    scope_->Freeze();
+  }
 #ifdef PADDLE_WITH_TENSORRT
   x->executor_->ResetTrtOps(++AnalysisPredictor::clone_num_);
 #endif
@@ -3289,6 +3456,81 @@ void AnalysisPredictor::RegisterInputHook(const InputTensorHookFunc &hookfunc) {
   }
 }
 
+bool AnalysisPredictor::BindOutput(const std::string &name,
+                                   void *data,
+                                   size_t size,
+                                   PaddlePlace place,
+                                   std::function<void(void *)> deleter) {
+  if (data == nullptr) {
+    bound_outputs_.erase(name);
+    return true;
+  }
+  auto names = GetOutputNames();
+  if (std::find(names.begin(), names.end(), name) == names.end()) {
+    LOG(ERROR) << "The output " << name << " to bind is not found.";
+    return false;
+  }
+  phi::Place data_place;
+  if (place == PaddlePlace::kCPU) {
+    data_place = phi::CPUPlace();
+  } else if (!phi::is_cpu_place(place_)) {
+    data_place = place_;
+  } else {
+    LOG(ERROR) << "The buffer of the output " << name
+               << " should be on cpu for a predictor on cpu.";
+    return false;
+  }
+  std::shared_ptr<phi::Allocation> holder(
+      new phi::Allocation(data, size, data_place),
+      [deleter](phi::Allocation *allocation) {
+        if (deleter) {
+          deleter(allocation->ptr());
+        }
+        delete allocation;
+      });
+  // the op of the output allocates in the holder if it is large enough
+  auto *var = executor_->GetScope()->FindVar(name);
+  if (var != nullptr) {
+    phi::DenseTensorMeta meta(phi::DataType::UINT8,
+                              common::make_ddim({static_cast<int64_t>(size)}));
+    *var->GetMutable<phi::DenseTensor>() = phi::DenseTensor(holder, meta);
+  }
+  bound_outputs_[name] = std::move(holder);
+  return true;
+}
+
+bool AnalysisPredictor::WriteBoundOutputs() {
+  auto *scope = executor_->GetScope();
+  for (auto &item : bound_outputs_) {
+    auto *var = scope->FindVar(item.first);
+    if (var == nullptr || !var->IsType<phi::DenseTensor>()) {
+      continue;
+    }
+    auto *tensor = var->GetMutable<phi::DenseTensor>();
+    if (!tensor->initialized()) {
+      continue;
+    }
+    const auto &holder = item.second;
+    if (tensor->Holder() == holder && tensor->meta().offset == 0) {
+      continue;
+    }
+    size_t bytes = tensor->numel() * phi::SizeOf(tensor->dtype());
+    if (bytes > holder->size()) {
+      LOG(ERROR) << "The output " << item.first << " of " << bytes
+                 << " bytes is larger than its bound buffer of "
+                 << holder->size() << " bytes.";
+      return false;
+    }
+    VLOG(3) << "Copy the output " << item.first << " to its bound buffer.";
+    phi::DenseTensorMeta meta = tensor->meta();
+    meta.offset = 0;
+    phi::DenseTensor bound(holder, meta);
+    framework::TensorCopySync(*tensor, holder->place(), &bound);
+    *tensor = bound;
+  }
+  return true;
+}
+
 template <>
 std::unique_ptr<PaddlePredictor> CreatePaddlePredictor<AnalysisConfig>(
     const AnalysisConfig &config) {
@@ -3595,6 +3837,14 @@ void Predictor::RegisterInputHook(const InputTensorHookFunc &hookfunc) {
   predictor_->RegisterInputHook(hookfunc);
 }
 
+bool Predictor::BindOutput(const std::string &name,
+                           void *data,
+                           size_t size,
+                           PlaceType place,
+                           std::function<void(void *)> deleter) {
+  return predictor_->BindOutput(name, data, size, place, std::move(deleter));
+}
+
 void *Predictor::GetExecStream() const { return predictor_->GetExecStream(); }
 
 int GetNumBytesOfDataType(DataType dtype) {
@@ -3607,6 +3857,15 @@ int GetNumBytesOfDataType(DataType dtype) {
       return sizeof(int32_t);
     case DataType::UINT8:
       return sizeof(uint8_t);
+    case DataType::INT8:
+      return sizeof(int8_t);
+    case DataType::FLOAT16:
+    case DataType::BFLOAT16:
+      return 2;
+    case DataType::BOOL:
+      return sizeof(bool);
+    case DataType::FLOAT64:
+      return sizeof(double);
     default:
       assert(false);
       return -1;
@@ -3676,7 +3935,8 @@ PredictorPool::PredictorPool(const Config &config, size_t size) : preds_() {
   Config copy_config(config);
   main_pred_ = std::make_unique<Predictor>(config);
   for (size_t i = 0; i < size - 1; i++) {
-    if (config.tensorrt_engine_enabled()) {
+    if (config.tensorrt_engine_enabled() &&
+        !FLAGS_predictor_pool_share_trt_engine) {
       Config config_tmp(copy_config);
       preds_.emplace_back(new Predictor(config_tmp));
     } else {
@@ -325,6 +325,16 @@ class AnalysisPredictor : public PaddlePredictor {
   /// \brief Same as RegisterOutputHook
   void RegisterInputHook(const InputTensorHookFunc &hookfunc) override;
 
+  ///
+  /// \brief Bind a buffer of the caller as the output, see
+  /// PaddlePredictor::BindOutput.
+  ///
+  bool BindOutput(const std::string &name,
+                  void *data,
+                  size_t size,
+                  PaddlePlace place,
+                  std::function<void(void *)> deleter) override;
+
   ///
   /// \brief Initialize onednn quantizer and execute onednn quantization pass
   ///
@@ -398,6 +408,15 @@ class AnalysisPredictor : public PaddlePredictor {
   bool SetFeed(const std::vector<PaddleTensor> &input_datas,
                framework::Scope *scope);
 
+  ///
+  /// \brief Copy the small gpu feeds to device by one memcpy, through a
+  /// pinned staging buffer, see FLAGS_predictor_batch_feed_max_bytes.
+  ///
+  /// \param[in] input_datas input tensors
+  /// \return Whether the feeds are copied, if not, they are copied one by one
+  ///
+  bool BatchCopyFeeds(const std::vector<PaddleTensor> &input_datas);
+
   ///
   /// \brief Prepare input data, only used in Run()
   ///
@@ -471,6 +490,14 @@ class AnalysisPredictor : public PaddlePredictor {
   ///
   void MkldnnPostReset();
 
+  ///
+  /// \brief Write the outputs bound by BindOutput to their buffers, for the
+  /// ones the ops did not allocate in the buffers.
+  ///
+  /// \return Whether all the bound buffers are large enough.
+  ///
+  bool WriteBoundOutputs();
+
 #ifdef PADDLE_WITH_TENSORRT
   ///
   /// \brief save calibration table
@@ -503,6 +530,7 @@ class AnalysisPredictor : public PaddlePredictor {
  private:
   void StatisticShapeRangeInfo();
   void HookCollectShapeRangeInfo();
+  void HookCollectActivationAmax();
   void InitPlace();
   void InitDeviceContexts();
   void InitResourceManager(void *stream);
@@ -536,6 +564,9 @@ class AnalysisPredictor : public PaddlePredictor {
   // Memory buffer for feed inputs. The temporary DenseTensor will cause serious
   // concurrency problems, wrong results and memory leak, so cache them.
   std::vector<phi::DenseTensor> feed_tensors_;
+  // The staging buffers of BatchCopyFeeds, feed_tensors_ alias the device one.
+  std::shared_ptr<phi::Allocation> feed_host_buffer_;
+  std::shared_ptr<phi::Allocation> feed_device_buffer_;
   details::TensorArrayBatchCleaner tensor_array_batch_cleaner_;
   // A mutex help to make Clone thread safe.
   std::mutex clone_mutex_;
@@ -549,11 +580,14 @@ class AnalysisPredictor : public PaddlePredictor {
   std::once_flag register_output_hook_flag_;
   std::vector<OutputTensorHookFunc> output_hookfuncs_;
   std::vector<InputTensorHookFunc> input_hookfuncs_;
+  // The buffers of the callers bound as the outputs by BindOutput.
+  std::map<std::string, std::shared_ptr<phi::Allocation>> bound_outputs_;
   // Some status here that help to determine the status inside the predictor.
   bool status_is_cloned_{false};
 
   std::map<std::string, std::vector<std::vector<int32_t>>> shape_info_;
   std::map<std::string, std::vector<std::vector<int32_t>>> shape_tensor_value_;
+  std::map<std::string, float> activation_amax_;
 
   bool private_context_{false};
   void *predictor_stream_{nullptr};
@@ -0,0 +1,560 @@
+/* Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+/*
+ * This file contains an end-to-end benchmark of a predictor. It sweeps the
+ * number of concurrent predictors and the batch size, and reports the QPS,
+ * the latency percentiles and the GPU utilization and memory of each point.
+ *
+ * ./inference_benchmark --modeldir=mobilenet --threads=1,2,4 \
+ *     --batch_sizes=1,8,32 --use_gpu --use_trt --trt_precision=fp16
+ */
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils.h"  // NOLINT
+
+DEFINE_string(modeldir, "", "Directory of the inference model.");
+DEFINE_string(model_file, "", "Path of the model file, overrides modeldir.");
+DEFINE_string(params_file, "", "Path of the params file.");
+DEFINE_string(data,
+              "",
+              "Path of the data to replay instead of random inputs; each "
+              "line is one sample of the only input, format is "
+              "'<space split floats as data>\t<space split ints as shape'");
+DEFINE_string(shapes,
+              "",
+              "Shapes of the inputs, e.g. 'x:-1x3x224x224;y:-1x1', where -1 "
+              "is the batch size. Defaults to the shapes of the model.");
+DEFINE_string(batch_sizes, "1", "Comma separated batch sizes to sweep.");
+DEFINE_string(threads, "1", "Comma separated numbers of threads to sweep.");
+DEFINE_int32(warmup, 10, "Warmup runs of each thread at each point.");
+DEFINE_int32(repeat, 100, "Measured runs of each thread at each point.");
+DEFINE_int32(int_range, 100, "Random integer inputs are in [0, int_range).");
+DEFINE_string(output, "", "Path of a csv file to write the results to.");
+DEFINE_bool(use_gpu, false, "Whether use gpu.");
+DEFINE_int32(gpu_id, 0, "Id of the gpu to run on.");
+DEFINE_int32(gpu_memory_mb, 100, "Initial size of the gpu memory pool.");
+DEFINE_bool(use_trt, false, "Whether use TensorRT.");
+DEFINE_string(trt_precision, "fp32", "Precision of TensorRT: fp32|fp16|int8.");
+DEFINE_int32(trt_min_subgraph_size, 3, "Min subgraph size of TensorRT.");
+DEFINE_bool(use_cinn, false, "Whether use the CINN compiler.");
+DEFINE_bool(use_mkldnn, false, "Whether use oneDNN on cpu.");
+DEFINE_bool(ir_optim, true, "Whether use the IR optimization.");
+DEFINE_bool(memory_optim, true, "Whether use the memory optimization.");
+DEFINE_int32(cpu_threads, 1, "Math library threads of each predictor.");
+DEFINE_int32(sample_interval_ms,
+             100,
+             "Interval to sample the gpu utilization and memory with "
+             "nvidia-smi, 0 to disable the sampling.");
+
+namespace paddle {
+namespace demo {
+
+using paddle_infer::Config;
+using paddle_infer::DataType;
+using paddle_infer::Predictor;
+
+std::vector<int> SplitInts(const std::string& str, char sep) {
+  std::vector<int> values;
+  std::stringstream ss(str);
+  std::string item;
+  while (std::getline(ss, item, sep)) {
+    if (!item.empty()) {
+      values.push_back(std::stoi(item));
+    }
+  }
+  return values;
+}
+
+struct InputSpec {
+  std::string name;
+  DataType dtype{DataType::FLOAT32};
+  // -1 at the first dim is replaced by the batch size.
+  std::vector<int> shape;
+
+  std::vector<int> Shape(int batch_size) const {
+    std::vector<int> result = shape;
+    if (!result.empty() && result[0] == -1) {
+      result[0] = batch_size;
+    }
+    return result;
+  }
+};
+
+size_t SizeOf(DataType dtype) {
+  switch (dtype) {
+    case DataType::FLOAT64:
+    case DataType::INT64:
+      return 8;
+    case DataType::FLOAT32:
+    case DataType::INT32:
+      return 4;
+    case DataType::FLOAT16:
+    case DataType::BFLOAT16:
+      return 2;
+    default:
+      return 1;
+  }
+}
+
+// The inputs are read from a cpu only predictor without IR optimization, so
+// that the TensorRT dynamic shapes can be set before the measured ones are
+// created.
+std::vector<InputSpec> GetInputSpecs(const Config& base) {
+  Config config;
+  if (base.prog_file().empty()) {
+    config.SetModel(base.model_dir());
+  } else {
+    config.SetModel(base.prog_file(), base.params_file());
+  }
+  config.SwitchIrOptim(false);
+  auto predictor = paddle_infer::CreatePredictor(config);
+  auto shapes = predictor->GetInputTensorShape();
+  auto dtypes = predictor->GetInputTypes();
+
+  std::map<std::string, std::vector<int>> user_shapes;
+  std::stringstream ss(FLAGS_shapes);
+  std::string item;
+  while (std::getline(ss, item, ';')) {
+    size_t pos = item.rfind(':');
+    CHECK(pos != std::string::npos) << "Invalid shape " << item;
+    user_shapes[item.substr(0, pos)] = SplitInts(item.substr(pos + 1), 'x');
+  }
+
+  std::vector<InputSpec> specs;
+  for (const auto& name : predictor->GetInputNames()) {
+    InputSpec spec;
+    spec.name = name;
+    spec.dtype = dtypes[name];
+    if (user_shapes.count(name)) {
+      spec.shape = user_shapes[name];
+    } else {
+      spec.shape.assign(shapes[name].begin(), shapes[name].end());
+    }
+    for (size_t i = 1; i < spec.shape.size(); ++i) {
+      CHECK_GT(spec.shape[i], 0) << "The shape of " << name
+                                 << " is dynamic, please set it by --shapes.";
+    }
+    specs.push_back(spec);
+  }
+  return specs;
+}
+
+Config MakeConfig(const std::vector<InputSpec>& specs,
+                  const std::vector<int>& batch_sizes) {
+  Config config;
+  if (FLAGS_model_file.empty()) {
+    config.SetModel(FLAGS_modeldir);
+  } else {
+    config.SetModel(FLAGS_model_file, FLAGS_params_file);
+  }
+  if (specs.empty()) {
+    return config;
+  }
+
+  if (FLAGS_use_gpu) {
+    config.EnableUseGpu(FLAGS_gpu_memory_mb, FLAGS_gpu_id);
+    if (FLAGS_use_trt) {
+      auto precision = paddle_infer::PrecisionType::kFloat32;
+      if (FLAGS_trt_precision == "fp16") {
+        precision = paddle_infer::PrecisionType::kHalf;
+      } else if (FLAGS_trt_precision == "int8") {
+        precision = paddle_infer::PrecisionType::kInt8;
+      }
+      int max_batch_size =
+          *std::max_element(batch_sizes.begin(), batch_sizes.end());
+      int min_batch_size =
+          *std::min_element(batch_sizes.begin(), batch_sizes.end());
+      config.EnableTensorRtEngine(1 << 30,
+                                  max_batch_size,
+                                  FLAGS_trt_min_subgraph_size,
+                                  precision,
+                                  false,
+                                  false);
+      std::map<std::string, std::vector<int>> min_shapes, max_shapes;
+      for (const auto& spec : specs) {
+        min_shapes[spec.name] = spec.Shape(min_batch_size);
+        max_shapes[spec.name] = spec.Shape(max_batch_size);
+      }
+      config.SetTRTDynamicShapeInfo(min_shapes, max_shapes, max_shapes);
+    }
+  } else {
+    config.DisableGpu();
+    config.SetCpuMathLibraryNumThreads(FLAGS_cpu_threads);
+    if (FLAGS_use_mkldnn) {
+      config.EnableMKLDNN();
+    }
+  }
+  if (FLAGS_use_cinn) {
+    config.EnableCINN();
+  }
+  config.SwitchIrOptim(FLAGS_ir_optim);
+  config.EnableMemoryOptim(FLAGS_memory_optim);
+  return config;
+}
+
+// The inputs of one run, as the raw bytes of each input.
+struct Batch {
+  std::vector<std::vector<int>> shapes;
+  std::vector<std::vector<char>> data;
+};
+
+Batch MakeBatch(const std::vector<InputSpec>& specs,
+                const std::vector<Record>& records,
+                int batch_size,
+                int seed) {
+  Batch batch;
+  std::mt19937 rng(seed);
+  for (const auto& spec : specs) {
+    std::vector<int> shape = spec.Shape(batch_size);
+    size_t numel = 1;
+    for (int d : shape) {
+      numel *= d;
+    }
+    std::vector<char> data(numel * SizeOf(spec.dtype));
+    if (!records.empty()) {
+      // Replays batch_size consecutive samples of the data.
+      auto* dst = reinterpret_cast<float*>(data.data());
+      size_t sample_numel = numel / batch_size;
+      for (int i = 0; i < batch_size; ++i) {
+        const auto& record = records[(seed + i) % records.size()];
+        CHECK_EQ(record.data.size(), sample_numel)
+            << "The sample does not match the shape of " << spec.name;
+        std::copy(record.data.begin(),
+                  record.data.end(),
+                  dst + static_cast<size_t>(i) * sample_numel);
+      }
+    } else if (spec.dtype == DataType::FLOAT32) {
+      std::uniform_real_distribution<float> dist(0.f, 1.f);
+      auto* dst = reinterpret_cast<float*>(data.data());
+      for (size_t i = 0; i < numel; ++i) dst[i] = dist(rng);
+    } else if (spec.dtype == DataType::INT64) {
+      std::uniform_int_distribution<int64_t> dist(0, FLAGS_int_range - 1);
+      auto* dst = reinterpret_cast<int64_t*>(data.data());
+      for (size_t i = 0; i < numel; ++i) dst[i] = dist(rng);
+    } else if (spec.dtype == DataType::INT32) {
+      std::uniform_int_distribution<int32_t> dist(0, FLAGS_int_range - 1);
+      auto* dst = reinterpret_cast<int32_t*>(data.data());
+      for (size_t i = 0; i < numel; ++i) dst[i] = dist(rng);
+    } else {
+      // Zeros are valid for the other types, e.g. the masks.
+      std::fill(data.begin(), data.end(), 0);
+    }
+    batch.shapes.push_back(shape);
+    batch.data.push_back(std::move(data));
+  }
+  return batch;
+}
+
+void Feed(Predictor* predictor,
+          const std::vector<InputSpec>& specs,
+          const Batch& batch) {
+  for (size_t i = 0; i < specs.size(); ++i) {
+    auto tensor = predictor->GetInputHandle(specs[i].name);
+    tensor->Reshape(batch.shapes[i]);
+    const char* data = batch.data[i].data();
+    switch (specs[i].dtype) {
+      case DataType::FLOAT32:
+        tensor->CopyFromCpu(reinterpret_cast<const float*>(data));
+        break;
+      case DataType::FLOAT64:
+        tensor->CopyFromCpu(reinterpret_cast<const double*>(data));
+        break;
+      case DataType::INT64:
+        tensor->CopyFromCpu(reinterpret_cast<const int64_t*>(data));
+        break;
+      case DataType::INT32:
+        tensor->CopyFromCpu(reinterpret_cast<const int32_t*>(data));
+        break;
+      case DataType::UINT8:
+        tensor->CopyFromCpu(reinterpret_cast<const uint8_t*>(data));
+        break;
+      case DataType::INT8:
+        tensor->CopyFromCpu(reinterpret_cast<const int8_t*>(data));
+        break;
+      case DataType::BOOL:
+        tensor->CopyFromCpu(reinterpret_cast<const bool*>(data));
+        break;
+      case DataType::FLOAT16:
+        tensor->CopyFromCpu(reinterpret_cast<const phi::dtype::float16*>(
+            data));
+        break;
+      case DataType::BFLOAT16:
+        tensor->CopyFromCpu(reinterpret_cast<const phi::dtype::bfloat16*>(
+            data));
+        break;
+      default:
+        LOG(FATAL) << "Unsupported dtype of input " << specs[i].name;
+    }
+  }
+}
+
+// Copies the outputs back as a serving would, so that the latency covers the
+// whole request.
+void Fetch(Predictor* predictor, std::vector<char>* buffer) {
+  for (const auto& name : predictor->GetOutputNames()) {
+    auto tensor = predictor->GetOutputHandle(name);
+    size_t numel = 1;
+    for (int d : tensor->shape()) {
+      numel *= d;
+    }
+    buffer->resize(std::max(buffer->size(), numel * 8));
+    switch (tensor->type()) {
+      case DataType::FLOAT32:
+        tensor->CopyToCpu(reinterpret_cast<float*>(buffer->data()));
+        break;
+      case DataType::INT64:
+        tensor->CopyToCpu(reinterpret_cast<int64_t*>(buffer->data()));
+        break;
+      case DataType::INT32:
+        tensor->CopyToCpu(reinterpret_cast<int32_t*>(buffer->data()));
+        break;
+      case DataType::FLOAT16:
+        tensor->CopyToCpu(
+            reinterpret_cast<phi::dtype::float16*>(buffer->data()));
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+// Samples the utilization and the used memory of the gpu with nvidia-smi,
+// which needs no library beyond the driver.
+class GpuSampler {
+ public:
+  void Start() {
+    if (!FLAGS_use_gpu || FLAGS_sample_interval_ms <= 0) {
+      return;
+    }
+    stop_ = false;
+    thread_ = std::thread([this]() {
+      std::string cmd =
+          "nvidia-smi --query-gpu=utilization.gpu,memory.used "
+          "--format=csv,noheader,nounits -i " +
+          std::to_string(FLAGS_gpu_id);
+      while (!stop_) {
+        FILE* pipe = popen(cmd.c_str(), "r");
+        if (pipe == nullptr) {
+          return;
+        }
+        double util = 0, memory = 0;
+        if (fscanf(pipe, "%lf, %lf", &util, &memory) == 2) {
+          util_sum_ += util;
+          max_memory_mb_ = std::max(max_memory_mb_, memory);
+          ++samples_;
+        }
+        pclose(pipe);
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(FLAGS_sample_interval_ms));
+      }
+    });
+  }
+
+  void Stop() {
+    stop_ = true;
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  // -1 when nothing was sampled.
+  double MeanUtil() const { return samples_ ? util_sum_ / samples_ : -1; }
+  double MaxMemoryMB() const { return samples_ ? max_memory_mb_ : -1; }
+
+ private:
+  std::thread thread_;
+  std::atomic<bool> stop_{true};
+  double util_sum_{0};
+  double max_memory_mb_{0};
+  int samples_{0};
+};
+
+struct Result {
+  int threads;
+  int batch_size;
+  double qps;
+  double p50_ms;
+  double p95_ms;
+  double p99_ms;
+  double gpu_util;
+  double gpu_memory_mb;
+};
+
+double Percentile(const std::vector<double>& sorted, double p) {
+  size_t idx = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+  return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+Result RunPoint(paddle_infer::services::PredictorPool* pool,
+                const std::vector<InputSpec>& specs,
+                const std::vector<Record>& records,
+                int threads,
+                int batch_size) {
+  std::vector<Batch> batches;
+  for (int t = 0; t < threads; ++t) {
+    batches.push_back(MakeBatch(specs, records, batch_size, t * batch_size));
+  }
+  std::vector<std::vector<double>> latencies(threads);
+  std::atomic<int> ready{0};
+  std::atomic<bool> go{false};
+  GpuSampler sampler;
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t]() {
+      Predictor* predictor = pool->Retrieve(t);
+      std::vector<char> buffer;
+      for (int i = 0; i < FLAGS_warmup; ++i) {
+        Feed(predictor, specs, batches[t]);
+        CHECK(predictor->Run());
+        Fetch(predictor, &buffer);
+      }
+      // All the threads start measuring together, so that every measured run
+      // shares the device with the same number of threads.
+      ++ready;
+      while (!go) {
+        std::this_thread::yield();
+      }
+      latencies[t].reserve(FLAGS_repeat);
+      for (int i = 0; i < FLAGS_repeat; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        Feed(predictor, specs, batches[t]);
+        CHECK(predictor->Run());
+        Fetch(predictor, &buffer);
+        auto end = std::chrono::steady_clock::now();
+        latencies[t].push_back(
+            std::chrono::duration<double, std::milli>(end - start).count());
+      }
+    });
+  }
+  while (ready < threads) {
+    std::this_thread::yield();
+  }
+  sampler.Start();
+  auto start = std::chrono::steady_clock::now();
+  go = true;
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  auto end = std::chrono::steady_clock::now();
+  sampler.Stop();
+
+  std::vector<double> all;
+  for (const auto& l : latencies) {
+    all.insert(all.end(), l.begin(), l.end());
+  }
+  std::sort(all.begin(), all.end());
+  double seconds = std::chrono::duration<double>(end - start).count();
+
+  Result result;
+  result.threads = threads;
+  result.batch_size = batch_size;
+  result.qps = static_cast<double>(all.size()) * batch_size / seconds;
+  result.p50_ms = Percentile(all, 0.50);
+  result.p95_ms = Percentile(all, 0.95);
+  result.p99_ms = Percentile(all, 0.99);
+  result.gpu_util = sampler.MeanUtil();
+  result.gpu_memory_mb = sampler.MaxMemoryMB();
+  return result;
+}
+
+void Main() {
+  std::vector<int> batch_sizes = SplitInts(FLAGS_batch_sizes, ',');
+  std::vector<int> threads = SplitInts(FLAGS_threads, ',');
+  CHECK(!batch_sizes.empty() && !threads.empty());
+  CHECK_GT(FLAGS_repeat, 0);
+
+  std::vector<InputSpec> specs =
+      GetInputSpecs(MakeConfig(std::vector<InputSpec>(), batch_sizes));
+  std::vector<Record> records;
+  if (!FLAGS_data.empty()) {
+    CHECK_EQ(specs.size(), 1UL) << "Replaying data needs a single input.";
+    CHECK(specs[0].dtype == DataType::FLOAT32)
+        << "Replaying data needs a float32 input.";
+    std::ifstream file(FLAGS_data);
+    std::string line;
+    while (std::getline(file, line)) {
+      records.push_back(ProcessALine(line));
+    }
+    CHECK(!records.empty()) << "No record in " << FLAGS_data;
+  }
+
+  // One pool of the largest concurrency serves the whole sweep, the first
+  // predictor is created and the others are cloned from it.
+  Config config = MakeConfig(specs, batch_sizes);
+  size_t pool_size = *std::max_element(threads.begin(), threads.end());
+  paddle_infer::services::PredictorPool pool(config, pool_size);
+
+  std::vector<Result> results;
+  printf("%8s %8s %12s %10s %10s %10s %9s %12s\n",
+         "threads",
+         "batch",
+         "qps",
+         "p50(ms)",
+         "p95(ms)",
+         "p99(ms)",
+         "gpu(%)",
+         "gpu_mem(MB)");
+  for (int t : threads) {
+    for (int b : batch_sizes) {
+      Result r = RunPoint(&pool, specs, records, t, b);
+      printf("%8d %8d %12.2f %10.3f %10.3f %10.3f %9.1f %12.0f\n",
+             r.threads,
+             r.batch_size,
+             r.qps,
+             r.p50_ms,
+             r.p95_ms,
+             r.p99_ms,
+             r.gpu_util,
+             r.gpu_memory_mb);
+      results.push_back(r);
+    }
+  }
+
+  if (!FLAGS_output.empty()) {
+    std::ofstream out(FLAGS_output);
+    out << "threads,batch_size,qps,p50_ms,p95_ms,p99_ms,gpu_util,"
+           "gpu_memory_mb\n";
+    for (const auto& r : results) {
+      out << r.threads << "," << r.batch_size << "," << r.qps << ","
+          << r.p50_ms << "," << r.p95_ms << "," << r.p99_ms << ","
+          << r.gpu_util << "," << r.gpu_memory_mb << "\n";
+    }
+  }
+}
+
+}  // namespace demo
+}  // namespace paddle
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  paddle::demo::Main();
+  return 0;
+}
@@ -329,41 +329,48 @@ void Tensor::ShareExternalData(const T *data,
                                const std::vector<int> &shape,
                                PlaceType place,
                                DataLayout layout) {
+  ShareExternalData(const_cast<T *>(data), shape, place, nullptr, layout);
+}
+
+template <typename T>
+void Tensor::ShareExternalData(T *data,
+                               const std::vector<int> &shape,
+                               PlaceType place,
+                               std::function<void(void *)> deleter,
+                               DataLayout layout) {
   EAGER_GET_TENSOR(phi::DenseTensor)
   size_t size =
       std::accumulate(shape.begin(), shape.end(), 1, std::multiplies<int>()) *
       sizeof(T);
   phi::DenseTensorMeta meta(
       DataTypeInfo<T>().TYPE, common::make_ddim(shape), LayoutConvert(layout));
+  phi::Place data_place;
   if (place == PlaceType::kCPU) {
-    phi::DenseTensor dtensor(std::make_shared<phi::Allocation>(
-                                 const_cast<T *>(data), size, phi::CPUPlace()),
-                             meta);
-    *tensor = std::move(dtensor);
+    data_place = phi::CPUPlace();
   } else if (place == PlaceType::kGPU) {
-    phi::DenseTensor dtensor(
-        std::make_shared<phi::Allocation>(
-            const_cast<T *>(data), size, phi::GPUPlace(device_)),
-        meta);
-    *tensor = std::move(dtensor);
+    data_place = phi::GPUPlace(device_);
   } else if (place == PlaceType::kXPU) {
-    phi::DenseTensor dtensor(
-        std::make_shared<phi::Allocation>(
-            const_cast<T *>(data), size, phi::XPUPlace(device_)),
-        meta);
-    *tensor = std::move(dtensor);
+    data_place = phi::XPUPlace(device_);
   } else if (place == PlaceType::kCUSTOM) {
-    phi::DenseTensor dtensor(std::make_shared<phi::Allocation>(
-                                 const_cast<T *>(data),
-                                 size,
-                                 phi::CustomPlace(device_type_, device_)),
-                             meta);
-    *tensor = std::move(dtensor);
+    data_place = phi::CustomPlace(device_type_, device_);
   } else {
     PADDLE_THROW(common::errors::InvalidArgument(
         "PlaceType must be one of [PlaceType::kCPU, PlaceType::kGPU, "
         "PlaceType::kXPU]."));
   }
+  std::shared_ptr<phi::Allocation> holder;
+  if (deleter) {
+    // the deleter runs once the last tensor sharing the data is released
+    holder = std::shared_ptr<phi::Allocation>(
+        new phi::Allocation(data, size, data_place),
+        [deleter](phi::Allocation *allocation) {
+          deleter(allocation->ptr());
+          delete allocation;
+        });
+  } else {
+    holder = std::make_shared<phi::Allocation>(data, size, data_place);
+  }
+  *tensor = phi::DenseTensor(holder, meta);
 }
 
 void Tensor::CopyStringsFromCpu(const paddle_infer::Strings *data) {
@@ -560,6 +567,60 @@ template PD_INFER_DECL void Tensor::ShareExternalData<bool>(
     const std::vector<int> &shape,
     PlaceType place,
     DataLayout layout);
+template PD_INFER_DECL void Tensor::ShareExternalData<double>(
+    double *data,
+    const std::vector<int> &shape,
+    PlaceType place,
+    std::function<void(void *)> deleter,
+    DataLayout layout);
+template PD_INFER_DECL void Tensor::ShareExternalData<float>(
+    float *data,
+    const std::vector<int> &shape,
+    PlaceType place,
+    std::function<void(void *)> deleter,
+    DataLayout layout);
+template PD_INFER_DECL void Tensor::ShareExternalData<int64_t>(
+    int64_t *data,
+    const std::vector<int> &shape,
+    PlaceType place,
+    std::function<void(void *)> deleter,
+    DataLayout layout);
+template PD_INFER_DECL void Tensor::ShareExternalData<int32_t>(
+    int32_t *data,
+    const std::vector<int> &shape,
+    PlaceType place,
+    std::function<void(void *)> deleter,
+    DataLayout layout);
+template PD_INFER_DECL void Tensor::ShareExternalData<uint8_t>(
+    uint8_t *data,
+    const std::vector<int> &shape,
+    PlaceType place,
+    std::function<void(void *)> deleter,
+    DataLayout layout);
+template PD_INFER_DECL void Tensor::ShareExternalData<int8_t>(
+    int8_t *data,
+    const std::vector<int> &shape,
+    PlaceType place,
+    std::function<void(void *)> deleter,
+    DataLayout layout);
+template PD_INFER_DECL void Tensor::ShareExternalData<float16>(
+    float16 *data,
+    const std::vector<int> &shape,
+    PlaceType place,
+    std::function<void(void *)> deleter,
+    DataLayout layout);
+template PD_INFER_DECL void Tensor::ShareExternalData<bfloat16>(
+    bfloat16 *data,
+    const std::vector<int> &shape,
+    PlaceType place,
+    std::function<void(void *)> deleter,
+    DataLayout layout);
+template PD_INFER_DECL void Tensor::ShareExternalData<bool>(
+    bool *data,
+    const std::vector<int> &shape,
+    PlaceType place,
+    std::function<void(void *)> deleter,
+    DataLayout layout);
 
 template PD_INFER_DECL void Tensor::CopyToCpu<double>(double *data) const;
 template PD_INFER_DECL void Tensor::CopyToCpu<float>(float *data) const;
@@ -0,0 +1,351 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "paddle/fluid/inference/api/paddle_inference_api.h"
+#include "paddle/phi/core/enforce.h"
+
+namespace paddle_infer::services {
+
+namespace {
+
+struct Sequence {
+  int64_t id;
+  GenerationLoop::Request request;
+  // the prompt and the generated tokens
+  std::vector<int64_t> tokens;
+  int num_generated{0};
+  // the tokens in the cache, 0 until the sequence is prefilled
+  int num_cached{0};
+};
+
+template <typename T>
+void CopyInput(Predictor* predictor,
+               const std::string& name,
+               const std::vector<int>& shape,
+               const std::vector<T>& data) {
+  auto input = predictor->GetInputHandle(name);
+  input->Reshape(shape);
+  input->CopyFromCpu(data.data());
+}
+
+}  // namespace
+
+struct GenerationLoop::Impl {
+  // Reserve the block of the next token of each running sequence. If the
+  // cache is short, the latest sequences are preempted to the front of the
+  // queue, and release their blocks for the older ones.
+  void ReserveRunning() {
+    std::vector<int> order;
+    for (int i = 0; i < options.max_batch_size; ++i) {
+      if (slots[i]) {
+        order.push_back(i);
+      }
+    }
+    std::sort(order.begin(), order.end(), [this](int lhs, int rhs) {
+      return slots[lhs]->id < slots[rhs]->id;
+    });
+    while (!order.empty()) {
+      const int i = order.front();
+      if (cache->Reserve(slots[i]->id,
+                         static_cast<int>(slots[i]->tokens.size()))) {
+        order.erase(order.begin());
+        continue;
+      }
+      const int latest = order.back();
+      order.pop_back();
+      Preempt(latest);
+    }
+  }
+
+  void Preempt(int slot) {
+    std::unique_ptr<Sequence> seq = std::move(slots[slot]);
+    VLOG(3) << "GenerationLoop preempts the sequence " << seq->id << " of "
+            << seq->tokens.size() << " tokens";
+    cache->Release(seq->id);
+    seq->num_cached = 0;
+    std::lock_guard<std::mutex> lock(mutex);
+    queue.push_front(std::move(seq));
+  }
+
+  // Admit the requests of the queue into the free slots by their order.
+  void Admit() {
+    for (int i = 0; i < options.max_batch_size; ++i) {
+      if (slots[i]) {
+        continue;
+      }
+      std::unique_ptr<Sequence> seq;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.empty()) {
+          return;
+        }
+        if (!cache->Reserve(queue.front()->id,
+                            static_cast<int>(queue.front()->tokens.size()))) {
+          return;
+        }
+        seq = std::move(queue.front());
+        queue.pop_front();
+      }
+      slots[i] = std::move(seq);
+    }
+  }
+
+  // The head of the queue can not be admitted even if the cache is free.
+  void DropFront() {
+    std::unique_ptr<Sequence> seq;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (queue.empty()) {
+        return;
+      }
+      seq = std::move(queue.front());
+      queue.pop_front();
+    }
+    LOG(WARNING) << "The sequence " << seq->id << " of "
+                 << seq->tokens.size()
+                 << " tokens can not fit the PagedKVCache, it is dropped.";
+    if (seq->request.on_token) {
+      seq->request.on_token(-1, true);
+    }
+  }
+
+  size_t NumRunning() const {
+    return std::count_if(
+        slots.begin(), slots.end(), [](const std::unique_ptr<Sequence>& seq) {
+          return seq != nullptr;
+        });
+  }
+
+  std::vector<int64_t> NextTokens() const {
+    auto output = predictor->GetOutputHandle(options.output_name);
+    auto shape = output->shape();
+    int64_t numel = 1;
+    for (int dim : shape) {
+      numel *= dim;
+    }
+    const int64_t batch_size = options.max_batch_size;
+    PADDLE_ENFORCE_EQ(
+        !shape.empty() && shape[0] == batch_size && numel >= batch_size,
+        true,
+        common::errors::InvalidArgument(
+            "The output %s of GenerationLoop should have a row for each of "
+            "the %d slots.",
+            options.output_name,
+            batch_size));
+    std::vector<int64_t> tokens(batch_size);
+    if (output->type() == DataType::INT64) {
+      PADDLE_ENFORCE_EQ(numel,
+                        batch_size,
+                        common::errors::InvalidArgument(
+                            "The int64 output %s of GenerationLoop should be "
+                            "one token for each slot, but got %d tokens.",
+                            options.output_name,
+                            numel));
+      output->CopyToCpu(tokens.data());
+    } else if (output->type() == DataType::FLOAT32) {
+      std::vector<float> logits(numel);
+      output->CopyToCpu(logits.data());
+      const int64_t vocab = numel / batch_size;
+      for (int64_t i = 0; i < batch_size; ++i) {
+        auto row = logits.begin() + i * vocab;
+        tokens[i] = std::max_element(row, row + vocab) - row;
+      }
+    } else {
+      PADDLE_THROW(common::errors::InvalidArgument(
+          "The output %s of GenerationLoop should be the int64 tokens or the "
+          "float32 logits.",
+          options.output_name));
+    }
+    return tokens;
+  }
+
+  Predictor* predictor;
+  PagedKVCache* cache;
+  Options options;
+  // the sequences of the slots, nullptr for the free ones
+  std::vector<std::unique_ptr<Sequence>> slots;
+
+  // the inputs of the batch, kept across the steps
+  std::vector<int64_t> input_ids;
+  std::vector<int> seq_lens_this_time;
+  std::vector<int> seq_lens_encoder;
+  std::vector<int> seq_lens_decoder;
+  std::vector<int64_t> seq_ids;
+
+  mutable std::mutex mutex;
+  std::deque<std::unique_ptr<Sequence>> queue;
+  int64_t next_id{0};
+};
+
+GenerationLoop::GenerationLoop(Predictor* predictor,
+                               PagedKVCache* cache,
+                               const Options& options)
+    : impl_(new Impl) {
+  PADDLE_ENFORCE_NOT_NULL(
+      predictor,
+      common::errors::InvalidArgument(
+          "The predictor of GenerationLoop should not be null."));
+  PADDLE_ENFORCE_NOT_NULL(
+      cache,
+      common::errors::InvalidArgument(
+          "The cache of GenerationLoop should not be null."));
+  PADDLE_ENFORCE_EQ(options.max_batch_size > 0 && options.max_seq_len > 1,
+                    true,
+                    common::errors::InvalidArgument(
+                        "GenerationLoop should have a positive max_batch_size "
+                        "and a max_seq_len larger than 1."));
+  impl_->predictor = predictor;
+  impl_->cache = cache;
+  impl_->options = options;
+  impl_->slots.resize(options.max_batch_size);
+  impl_->seq_lens_this_time.resize(options.max_batch_size);
+  impl_->seq_lens_encoder.resize(options.max_batch_size);
+  impl_->seq_lens_decoder.resize(options.max_batch_size);
+  impl_->seq_ids.resize(options.max_batch_size);
+}
+
+GenerationLoop::~GenerationLoop() {
+  for (auto& seq : impl_->slots) {
+    if (seq) {
+      impl_->cache->Release(seq->id);
+    }
+  }
+}
+
+int64_t GenerationLoop::Submit(Request request) {
+  if (request.prompt.empty() ||
+      static_cast<int>(request.prompt.size()) >= impl_->options.max_seq_len) {
+    return -1;
+  }
+  auto seq = std::make_unique<Sequence>();
+  seq->tokens = request.prompt;
+  seq->request = std::move(request);
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  seq->id = impl_->next_id++;
+  int64_t id = seq->id;
+  impl_->queue.push_back(std::move(seq));
+  return id;
+}
+
+size_t GenerationLoop::Step() {
+  auto& slots = impl_->slots;
+  const auto& options = impl_->options;
+  impl_->ReserveRunning();
+  impl_->Admit();
+  if (impl_->NumRunning() == 0) {
+    impl_->DropFront();
+    return NumPending();
+  }
+
+  const int batch_size = options.max_batch_size;
+  int max_tokens = 1;
+  for (int i = 0; i < batch_size; ++i) {
+    if (slots[i]) {
+      max_tokens = std::max(
+          max_tokens,
+          static_cast<int>(slots[i]->tokens.size()) - slots[i]->num_cached);
+    }
+  }
+  impl_->input_ids.assign(static_cast<size_t>(batch_size) * max_tokens, 0);
+  for (int i = 0; i < batch_size; ++i) {
+    const Sequence* seq = slots[i].get();
+    if (!seq) {
+      impl_->seq_lens_this_time[i] = 0;
+      impl_->seq_lens_encoder[i] = 0;
+      impl_->seq_lens_decoder[i] = 0;
+      impl_->seq_ids[i] = -1;
+      continue;
+    }
+    const int this_time = static_cast<int>(seq->tokens.size()) -
+                          seq->num_cached;
+    std::copy(seq->tokens.begin() + seq->num_cached,
+              seq->tokens.end(),
+              impl_->input_ids.begin() + i * max_tokens);
+    impl_->seq_lens_this_time[i] = this_time;
+    impl_->seq_lens_encoder[i] = seq->num_cached == 0 ? this_time : 0;
+    impl_->seq_lens_decoder[i] = seq->num_cached;
+    impl_->seq_ids[i] = seq->id;
+  }
+
+  Predictor* predictor = impl_->predictor;
+  CopyInput(predictor,
+            options.input_ids_name,
+            {batch_size, max_tokens},
+            impl_->input_ids);
+  CopyInput(predictor,
+            options.seq_lens_this_time_name,
+            {batch_size, 1},
+            impl_->seq_lens_this_time);
+  CopyInput(predictor,
+            options.seq_lens_encoder_name,
+            {batch_size, 1},
+            impl_->seq_lens_encoder);
+  CopyInput(predictor,
+            options.seq_lens_decoder_name,
+            {batch_size, 1},
+            impl_->seq_lens_decoder);
+  impl_->cache->BindTo(predictor,
+                       impl_->seq_ids,
+                       options.key_cache_prefix,
+                       options.value_cache_prefix,
+                       options.block_tables_name);
+  PADDLE_ENFORCE_EQ(predictor->Run(),
+                    true,
+                    common::errors::PreconditionNotMet(
+                        "The predictor of GenerationLoop fails to run."));
+
+  auto next_tokens = impl_->NextTokens();
+  for (int i = 0; i < batch_size; ++i) {
+    Sequence* seq = slots[i].get();
+    if (!seq) {
+      continue;
+    }
+    const int64_t token = next_tokens[i];
+    seq->num_cached = static_cast<int>(seq->tokens.size());
+    seq->tokens.push_back(token);
+    ++seq->num_generated;
+    const bool finished =
+        token == seq->request.eos_token_id ||
+        seq->num_generated >= seq->request.max_new_tokens ||
+        static_cast<int>(seq->tokens.size()) >= options.max_seq_len;
+    if (seq->request.on_token) {
+      seq->request.on_token(token, finished);
+    }
+    if (finished) {
+      impl_->cache->Release(seq->id);
+      slots[i].reset();
+    }
+  }
+  return impl_->NumRunning() + NumPending();
+}
+
+size_t GenerationLoop::NumRunning() const { return impl_->NumRunning(); }
+
+size_t GenerationLoop::NumPending() const {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  return impl_->queue.size();
+}
+
+}  // namespace paddle_infer::services
@@ -74,7 +74,9 @@ void* InferXPUContext::Alloc(phi::TensorBase* tensor,
         swap(*holder, *swap_holder);
         swap_holder_is_l3 = true;
       }
+      if (!swap_holder_is_l3) l3_hit_bytes_ += size;
     }
+    l3_total_bytes_ += size;
     return DeviceContext::Alloc(
         tensor, dtype, requested_size, pinned, fake_alloc);
   } else {
@@ -270,6 +272,17 @@ void InferXPUContext::L3CacheAutotune() {
       }
     }
   } else {
+    if (l3_total_bytes_ > 0) {
+      VLOG(3) << "XPU L3 hit bytes of the last run: " << l3_hit_bytes_
+              << " / " << l3_total_bytes_ << " ("
+              << 100.0 * static_cast<double>(l3_hit_bytes_) /
+                     static_cast<double>(l3_total_bytes_)
+              << " %)";
+    }
+    last_l3_hit_bytes_ = l3_hit_bytes_;
+    last_l3_total_bytes_ = l3_total_bytes_;
+    l3_hit_bytes_ = 0;
+    l3_total_bytes_ = 0;
     for (auto& holders : holder_map_) {
       auto* holder = holders.first;
       auto& holder_pair = holders.second;
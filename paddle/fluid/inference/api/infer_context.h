@@ -83,6 +83,11 @@ class InferXPUContext : public phi::XPUContext {
 
   void SetOutHolder(phi::Allocation* holder);
 
+  // The bytes of the tensors allocated in L3 by the autotuned plan, and of
+  // all the tensors allocated, in the last run.
+  size_t l3_hit_bytes() const { return last_l3_hit_bytes_; }
+  size_t l3_total_bytes() const { return last_l3_total_bytes_; }
+
  private:
   size_t l3_size_{0};
   void* l3_ptr_{nullptr};
@@ -97,6 +102,10 @@ class InferXPUContext : public phi::XPUContext {
 
   mutable std::unordered_set<phi::Allocation*> output_holder_set_;
   phi::XPUL3Planner l3_plan_;
+  mutable size_t l3_hit_bytes_{0};
+  mutable size_t l3_total_bytes_{0};
+  size_t last_l3_hit_bytes_{0};
+  size_t last_l3_total_bytes_{0};
 };
 #endif
 }  // namespace paddle
@@ -100,6 +100,7 @@ bool ONNXRuntimePredictor::InitBinding() {
   Ort::MemoryInfo memory_info(
       device_name, OrtDeviceAllocator, place_.GetDeviceId(), OrtMemTypeDefault);
   Ort::Allocator allocator(*session_, memory_info);
+  output_allocator_ = std::make_unique<Ort::Allocator>(*session_, memory_info);
 
   size_t n_inputs = session_->GetInputCount();
   framework::proto::VarType::Type proto_type =
@@ -129,11 +130,22 @@ bool ONNXRuntimePredictor::InitBinding() {
         type_info.GetTensorTypeAndShapeInfo().GetElementType();
     output_desc_.emplace_back(ONNXDesc{output_name, shape, data_type});
 
-    Ort::MemoryInfo out_memory_info(device_name,
-                                    OrtDeviceAllocator,
-                                    place_.GetDeviceId(),
-                                    OrtMemTypeDefault);
-    binding_->BindOutput(output_name, out_memory_info);
+    bool is_static = !shape.empty() &&
+                     std::all_of(shape.begin(), shape.end(), [](int64_t d) {
+                       return d > 0;
+                     });
+    if (is_static) {
+      Ort::Value value = Ort::Value::CreateTensor(
+          *output_allocator_, shape.data(), shape.size(), data_type);
+      binding_->BindOutput(output_name, value);
+    } else {
+      Ort::MemoryInfo out_memory_info(device_name,
+                                      OrtDeviceAllocator,
+                                      place_.GetDeviceId(),
+                                      OrtMemTypeDefault);
+      binding_->BindOutput(output_name, out_memory_info);
+    }
+    output_prebound_.push_back(is_static);
 
     allocator.Free(output_name);
   }
@@ -336,20 +348,29 @@ bool ONNXRuntimePredictor::Run(const std::vector<PaddleTensor> &inputs,
 bool ONNXRuntimePredictor::ZeroCopyRun(bool switch_stream) {
   try {
     const char *device_name = phi::is_cpu_place(place_) ? "Cpu" : "Cuda";
-    std::vector<Ort::Value> inputs;
-    inputs.reserve(input_desc_.size());
-    for (auto desc : input_desc_) {
-      inputs.push_back(GetOrtValue(desc, device_name));
-      binding_->BindInput(desc.name.c_str(), inputs.back());
+    bound_input_ptrs_.resize(input_desc_.size(), nullptr);
+    bound_input_shapes_.resize(input_desc_.size());
+    for (size_t i = 0; i < input_desc_.size(); ++i) {
+      const auto &desc = input_desc_[i];
+      auto *tensor = scope_->FindVar(desc.name)->GetMutable<phi::DenseTensor>();
+      std::vector<int64_t> shape = common::vectorize<int64_t>(tensor->dims());
+      if (bound_input_ptrs_[i] == tensor->data() &&
+          bound_input_shapes_[i] == shape) {
+        continue;
+      }
+      binding_->BindInput(desc.name.c_str(), GetOrtValue(desc, device_name));
+      bound_input_ptrs_[i] = tensor->data();
+      bound_input_shapes_[i] = std::move(shape);
     }
-    for (auto output : output_desc_) {
+    for (size_t i = 0; i < output_desc_.size(); ++i) {
+      if (output_prebound_[i]) continue;
       Ort::MemoryInfo out_memory_info(device_name,
                                       OrtDeviceAllocator,
                                       place_.GetDeviceId(),
                                       OrtMemTypeDefault);
-      binding_->BindOutput(output.name.c_str(), out_memory_info);
+      binding_->BindOutput(output_desc_[i].name.c_str(), out_memory_info);
     }
-    session_->Run({}, *(binding_.get()));
+    session_->Run(run_options_, *(binding_.get()));
   } catch (const std::exception &e) {
     LOG(ERROR) << e.what();
     return false;
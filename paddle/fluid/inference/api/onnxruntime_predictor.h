@@ -228,6 +228,8 @@ class ONNXRuntimePredictor : public PaddlePredictor {
   // ONNXRuntime
   std::shared_ptr<Ort::Env> env_;
   std::shared_ptr<Ort::Session> session_{nullptr};
+  // Allocates the prebound outputs, it outlives the binding holding them.
+  std::unique_ptr<Ort::Allocator> output_allocator_;
   std::shared_ptr<Ort::IoBinding> binding_;
 
   AnalysisConfig config_;
@@ -235,6 +237,15 @@ class ONNXRuntimePredictor : public PaddlePredictor {
   phi::Place place_;
   std::vector<ONNXDesc> input_desc_;
   std::vector<ONNXDesc> output_desc_;
+  // The buffers and the shapes of the inputs bound in the last run, an input
+  // is only bound again when they change.
+  std::vector<const void *> bound_input_ptrs_;
+  std::vector<std::vector<int64_t>> bound_input_shapes_;
+  // The outputs of static shapes are allocated once and stay bound, the
+  // others are allocated by ONNXRuntime in every run.
+  std::vector<bool> output_prebound_;
+  // Each predictor, so each clone sharing the session, has its own options.
+  Ort::RunOptions run_options_;
   int predictor_id_;
 
 // Some more detailed tests, they are made the friends of the predictor, so that
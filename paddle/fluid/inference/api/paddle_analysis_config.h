@@ -602,8 +602,9 @@ struct PD_INFER_DECL AnalysisConfig {
   /// \param use_calib_mode Use TRT int8 calibration(post training
   /// quantization).
   /// \param use_cuda_graph Use CudaGraph to reduce the time consumption of
-  /// enqueue. Note that this option can only be enabled when your input is
-  /// constant (including the batch dimension).
+  /// enqueue. A graph is captured for every distinct input shape and input
+  /// address, so the inputs should come from the same reused buffers, and the
+  /// number of the graphs is limited by FLAGS_trt_cuda_graph_pool_size.
   ///
   ///
   void EnableTensorRtEngine(int64_t workspace_size = 1 << 30,
@@ -738,6 +739,30 @@ struct PD_INFER_DECL AnalysisConfig {
   ///
   bool shape_range_info_collected() const;
 
+  ///
+  /// \brief Collect the absolute maximum (amax) of all the float tensors in
+  /// compute graph, during a short warmup run. The per-tensor scales of the
+  /// low precision inference such as FP8 (E4M3) are derived from them, with
+  /// no calibration dataset needed.
+  ///
+  /// \param activation_amax_path the path to save the amax info.
+  ///
+  void CollectActivationAmax(const std::string& activation_amax_path);
+
+  ///
+  /// \brief the amax info path in CollectActivationAmax mode.
+  ///
+  /// \return the amax info path.
+  ///
+  const std::string& activation_amax_path() const;
+
+  ///
+  /// \brief A boolean state telling whether to collect amax info.
+  ///
+  /// \return bool Whether to collect amax info.
+  ///
+  bool activation_amax_collected() const;
+
   ///
   /// \brief Prevent ops running in Paddle-TRT
   /// NOTE: just experimental, not an official stable API, easy to be broken.
@@ -856,6 +881,23 @@ struct PD_INFER_DECL AnalysisConfig {
   ///
   void UseOptimizedModel(bool x = true) { use_optimized_model_ = x; }
 
+  ///
+  /// \brief Control whether to load the combined params file by memory
+  /// mapping it. CPU parameters alias the mapping instead of being copied,
+  /// so predictors in different processes loading the same file share one
+  /// copy in the page cache. Only effective for new IR.
+  ///
+  /// \param x whether to memory map the params file.
+  ///
+  void EnableParamsMmap(bool x = true) { params_mmap_enabled_ = x; }
+
+  ///
+  /// \brief A boolean state telling whether the params file is memory mapped.
+  ///
+  /// \return bool Whether the params file is memory mapped.
+  ///
+  bool params_mmap_enabled() const { return params_mmap_enabled_; }
+
   ///
   /// \brief Control whether to debug IR graph analysis phase.
   /// This will generate DOT files for visualizing the computation graph after
@@ -1237,6 +1279,12 @@ struct PD_INFER_DECL AnalysisConfig {
   bool collect_shape_range_info_{false};
   std::string shape_range_info_path_;
 
+  // In CollectActivationAmax mode, we will record the absolute maximum of
+  // all the float tensors in the compute graph and save them in
+  // activation_amax_path_;
+  bool collect_activation_amax_{false};
+  std::string activation_amax_path_;
+
   // memory reuse related.
   bool enable_memory_optim_{false};
   bool trt_engine_memory_sharing_{true};
@@ -1258,6 +1306,8 @@ struct PD_INFER_DECL AnalysisConfig {
 
   bool use_optimized_model_{false};
 
+  bool params_mmap_enabled_{false};
+
   bool use_new_executor_{false};
 
   bool specify_input_name_{false};
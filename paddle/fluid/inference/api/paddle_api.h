@@ -328,6 +328,27 @@ class PD_INFER_DECL PaddlePredictor {
   /// \brief Same as RegisterOutputHook
   virtual void RegisterInputHook(const InputTensorHookFunc& hookfunc) {}
 
+  ///
+  /// \brief Bind a buffer of the caller as the output before the runs. The
+  /// output is written in the buffer, without copy if the op of the output
+  /// allocates it in the buffer, and copied to the buffer otherwise.
+  ///
+  /// \param name The name of the output.
+  /// \param data The buffer, nullptr to unbind the output.
+  /// \param size The bytes of the buffer.
+  /// \param place The place of the buffer.
+  /// \param deleter The function to free the buffer once it is unbound, can
+  /// be nullptr if the caller owns it.
+  /// \return Whether the output is bound.
+  ///
+  virtual bool BindOutput(const std::string& name,
+                          void* data,
+                          size_t size,
+                          paddle_infer::PlaceType place,
+                          std::function<void(void*)> deleter) {
+    return false;
+  }
+
   /// \brief Clone an existing predictor
   /// When using clone, the same network will be created,
   /// and the parameters between them are shared.
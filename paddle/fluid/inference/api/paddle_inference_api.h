@@ -22,6 +22,7 @@ limitations under the License. */
 #pragma once
 
 #include <cassert>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -202,6 +203,26 @@ class PD_INFER_DECL Predictor {
   /// The same as RegisterOutputHook.
   void RegisterInputHook(const InputTensorHookFunc& hookfunc);
 
+  ///
+  /// \brief Bind a buffer of the caller as the output before Run, so that the
+  /// result is written in the buffer in place when the op of the output can
+  /// allocate it there, and copied to the buffer otherwise. The output handle
+  /// points to the buffer after Run.
+  ///
+  /// \param name The name of the output.
+  /// \param data The buffer, nullptr to unbind the output.
+  /// \param size The bytes of the buffer.
+  /// \param place The place of the buffer.
+  /// \param deleter The function to free the buffer once it is unbound, can
+  /// be nullptr if the caller owns it.
+  /// \return Whether the output is bound.
+  ///
+  bool BindOutput(const std::string& name,
+                  void* data,
+                  size_t size,
+                  PlaceType place,
+                  std::function<void(void*)> deleter = nullptr);
+
   ///
   /// \brief Get the execution stream on devices with a concept of stream,
   /// otherwise returns nullptr.
@@ -272,6 +293,412 @@ class PD_INFER_DECL PredictorPool {
   std::shared_ptr<Predictor> main_pred_;
   std::vector<std::unique_ptr<Predictor>> preds_;
 };
+
+///
+/// \class PredictorBatcher
+///
+/// \brief PredictorBatcher is a dynamic batching server built on top of
+/// PredictorPool. Requests passed to Run() from different threads are
+/// queued, the requests arriving within a timeout are concatenated along the
+/// batch dimension (dim 0) up to a max batch size, and run as a single
+/// request. The outputs are split along dim 0 and scattered back to the
+/// callers.
+///
+/// All inputs of a request must have the same batch size, and every output
+/// of the model must have dim 0 equal to the batch size of the inputs.
+/// Requests whose non-batch dims or data types differ from the head of the
+/// queue are run in a later batch.
+///
+/// Usage:
+///
+/// \code{.cpp}
+/// paddle_infer::services::PredictorBatcher batcher(config, 16, 2000, 2);
+/// // called from many threads
+/// std::vector<paddle::Tensor> outputs;
+/// batcher.Run(inputs, &outputs);
+/// \endcode
+///
+class PD_INFER_DECL PredictorBatcher {
+ public:
+  PredictorBatcher() = delete;
+  PredictorBatcher(const PredictorBatcher&) = delete;
+  PredictorBatcher& operator=(const PredictorBatcher&) = delete;
+
+  ///
+  /// \brief Construct the batcher.
+  ///
+  /// \param[in] config The config of the predictors.
+  /// \param[in] max_batch_size The max batch size of a merged request.
+  /// \param[in] batch_timeout_us The max time in microseconds to wait for more
+  /// requests after the first request of a batch arrives.
+  /// \param[in] num_predictors The number of predictors running batches
+  /// concurrently.
+  ///
+  PredictorBatcher(const Config& config,
+                   size_t max_batch_size,
+                   int64_t batch_timeout_us,
+                   size_t num_predictors = 1);
+
+  ~PredictorBatcher();
+
+  ///
+  /// \brief Run a request, blocks until its batch is finished. thread safe.
+  ///
+  /// \param[in] inputs An list of Tensor as the input to the network.
+  /// \param[out] outputs Pointer to the tensor list, which holds the output
+  /// Tensor
+  ///
+  /// \return Whether the run is successful
+  ///
+  bool Run(const std::vector<paddle::Tensor>& inputs,
+           std::vector<paddle::Tensor>* outputs);
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+///
+/// \class PredictorPipeline
+///
+/// \brief PredictorPipeline chains the predictors of a multi-stage model,
+/// e.g. detector -> crop -> classifier, and runs the stages as a pipeline
+/// across the requests. Each stage has a thread of its own, so while a stage
+/// runs a request the previous stage runs the next one. The outputs of a
+/// stage are bound as the inputs of the next stage without copy, and on GPU
+/// the stream of the next stage waits for the stream of the stage by an
+/// event instead of a host synchronization.
+///
+/// A stage runs the requests on its predictors in turn. The outputs of a
+/// predictor are overwritten when it runs again, so a predictor is reused
+/// only after the next stage has run the request of its outputs. A stage
+/// needs two predictors, e.g. a predictor and its Predictor::Clone, to run
+/// ahead of the next stage. To overlap on GPU, create the predictors of the
+/// stages with their own streams by Config::SetExecStream, all on the same
+/// device. The outputs of the last stage are copied to the outputs of the
+/// request.
+///
+/// Usage:
+///
+/// \code{.cpp}
+/// paddle_infer::services::PredictorPipeline pipeline(
+///     {{{detector.get(), detector_clone.get()}, nullptr},
+///      {{classifier.get()}, crop}});
+/// // called from many threads
+/// std::vector<paddle::Tensor> outputs;
+/// pipeline.Run(inputs, &outputs);
+/// \endcode
+///
+class PD_INFER_DECL PredictorPipeline {
+ public:
+  struct Stage {
+    /// The predictors of the stage, not owned.
+    std::vector<Predictor*> predictors;
+    ///
+    /// Makes the inputs of the stage from the outputs of the previous stage,
+    /// returns false to fail the request. The outputs are complete when it
+    /// is called, so they can be read on the host. If it is empty, the
+    /// outputs of the previous stage are the inputs of the stage, bound by
+    /// name if the names are the input names of the stage and by position
+    /// otherwise. It is not called for the first stage.
+    ///
+    std::function<bool(const std::vector<paddle::Tensor>& prev_outputs,
+                       std::vector<paddle::Tensor>* inputs)>
+        connect;
+  };
+
+  PredictorPipeline() = delete;
+  PredictorPipeline(const PredictorPipeline&) = delete;
+  PredictorPipeline& operator=(const PredictorPipeline&) = delete;
+
+  ///
+  /// \brief Construct the pipeline.
+  ///
+  /// \param[in] stages The stages in order.
+  /// \param[in] device_id The GPU the predictors of GPU run on.
+  ///
+  explicit PredictorPipeline(const std::vector<Stage>& stages,
+                             int device_id = 0);
+
+  ~PredictorPipeline();
+
+  ///
+  /// \brief Run a request through the stages, blocks until the last stage
+  /// is finished. thread safe.
+  ///
+  /// \param[in] inputs An list of Tensor as the input to the first stage,
+  /// which must not be modified until the request is finished.
+  /// \param[out] outputs Pointer to the tensor list, which holds the output
+  /// Tensor of the last stage
+  ///
+  /// \return Whether the run is successful
+  ///
+  bool Run(const std::vector<paddle::Tensor>& inputs,
+           std::vector<paddle::Tensor>* outputs);
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+///
+/// \class PagedKVCache
+///
+/// \brief PagedKVCache is the paged KV cache of the models decoding with
+/// block_multihead_attention. The key and value caches of each layer are one
+/// pool of fixed-size blocks, [num_blocks, num_kv_heads, block_size,
+/// head_dim], allocated once from the allocator of the place. Each sequence
+/// owns the blocks of its tokens only, so the concurrent sequences are
+/// bounded by the tokens in use rather than by the max length.
+///
+/// Usage:
+///
+/// \code{.cpp}
+/// paddle_infer::services::PagedKVCache cache(
+///     32, 1024, 64, 8, 128, DataType::FLOAT16, PlaceType::kGPU);
+/// // before each step, for the tokens of each sequence after the step
+/// cache.Reserve(seq_id, num_tokens);
+/// cache.BindTo(predictor, seq_ids);
+/// predictor->Run();
+/// // once the sequence finishes
+/// cache.Release(seq_id);
+/// \endcode
+///
+class PD_INFER_DECL PagedKVCache {
+ public:
+  PagedKVCache() = delete;
+  PagedKVCache(const PagedKVCache&) = delete;
+  PagedKVCache& operator=(const PagedKVCache&) = delete;
+
+  PagedKVCache(int num_layers,
+               int num_blocks,
+               int block_size,
+               int num_kv_heads,
+               int head_dim,
+               DataType dtype,
+               PlaceType place,
+               int device_id = 0);
+
+  ~PagedKVCache();
+
+  ///
+  /// \brief Reserve the blocks of the sequence to hold num_tokens tokens in
+  /// total, the sequence is added if it is new. thread safe.
+  ///
+  /// \return False if the pool has not enough free blocks, in which case no
+  /// block is reserved.
+  ///
+  bool Reserve(int64_t seq_id, int num_tokens);
+
+  /// \brief Release the blocks of the sequence. thread safe.
+  void Release(int64_t seq_id);
+
+  ///
+  /// \brief Keep the blocks of the first num_tokens tokens of the sequence
+  /// and release the rest, e.g. to roll back the rejected draft tokens.
+  /// thread safe.
+  ///
+  void Truncate(int64_t seq_id, int num_tokens);
+
+  int NumFreeBlocks() const;
+
+  ///
+  /// \brief The block tables of the sequences, [seq_ids.size(),
+  /// max_blocks_per_seq] padded with -1, where max_blocks_per_seq is the
+  /// most blocks of the sequences. A negative seq id is a row of -1, i.e. an
+  /// empty slot of the batch.
+  ///
+  std::vector<int> BlockTables(const std::vector<int64_t>& seq_ids,
+                               int* max_blocks_per_seq) const;
+
+  ///
+  /// \brief Share the caches of the layers with the inputs
+  /// key_cache_prefix + i and value_cache_prefix + i of the predictor
+  /// without copy, and copy the block tables of the sequences to the input
+  /// block_tables_name.
+  ///
+  void BindTo(Predictor* predictor,
+              const std::vector<int64_t>& seq_ids,
+              const std::string& key_cache_prefix = "key_caches_",
+              const std::string& value_cache_prefix = "value_caches_",
+              const std::string& block_tables_name = "block_tables") const;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+///
+/// \class GenerationLoop
+///
+/// \brief GenerationLoop runs the decoding steps of a model with
+/// block_multihead_attention by continuous batching. The batch has a fixed
+/// number of slots, the input tensors of the batch keep their shapes across
+/// the steps. At each step boundary the requests in the queue are admitted
+/// into the free slots, the prompts are prefilled in the same step as the
+/// decoding of the running sequences, and the finished sequences leave their
+/// slots and release their blocks of the PagedKVCache. A running sequence is
+/// preempted back to the queue, to be prefilled again with its tokens so
+/// far, when the cache has no block for its next token.
+///
+/// The model takes the inputs of the names in GenerationLoop::Options:
+/// input_ids int64 [max_batch_size, max tokens of the step] padded with 0,
+/// seq_lens_this_time, seq_lens_encoder and seq_lens_decoder int32
+/// [max_batch_size, 1], which are 0 for an empty slot, the block tables and
+/// the caches of PagedKVCache::BindTo. The output is either the next token
+/// of each slot, int64 [max_batch_size] or [max_batch_size, 1], or the
+/// float32 logits of the last token of each slot [max_batch_size, vocab],
+/// which are decoded greedily.
+///
+/// Usage:
+///
+/// \code{.cpp}
+/// paddle_infer::services::GenerationLoop loop(predictor, &cache, options);
+/// loop.Submit({prompt, 128, eos_token_id,
+///              [](int64_t token, bool finished) { ... }});
+/// while (loop.Step()) {
+/// }
+/// \endcode
+///
+class PD_INFER_DECL GenerationLoop {
+ public:
+  struct Options {
+    int max_batch_size{8};
+    /// The max tokens of a sequence, including the prompt.
+    int max_seq_len{2048};
+    std::string input_ids_name{"input_ids"};
+    std::string seq_lens_this_time_name{"seq_lens_this_time"};
+    std::string seq_lens_encoder_name{"seq_lens_encoder"};
+    std::string seq_lens_decoder_name{"seq_lens_decoder"};
+    std::string key_cache_prefix{"key_caches_"};
+    std::string value_cache_prefix{"value_caches_"};
+    std::string block_tables_name{"block_tables"};
+    std::string output_name{"next_tokens"};
+  };
+
+  struct Request {
+    std::vector<int64_t> prompt;
+    int max_new_tokens{128};
+    /// The sequence finishes at this token, -1 for none.
+    int64_t eos_token_id{-1};
+    /// Called by Step() with each generated token, finished is true for the
+    /// last one. It is called with -1 if the sequence can not fit the cache.
+    std::function<void(int64_t token, bool finished)> on_token;
+  };
+
+  GenerationLoop() = delete;
+  GenerationLoop(const GenerationLoop&) = delete;
+  GenerationLoop& operator=(const GenerationLoop&) = delete;
+
+  ///
+  /// \brief Construct the loop. The predictor and the cache are not owned,
+  /// and must not be used by others while the loop is running.
+  ///
+  GenerationLoop(Predictor* predictor,
+                 PagedKVCache* cache,
+                 const Options& options);
+
+  ~GenerationLoop();
+
+  ///
+  /// \brief Queue a request, which is admitted at a later step. thread safe.
+  ///
+  /// \return The id of the sequence, or -1 if the prompt is empty or not
+  /// shorter than max_seq_len.
+  ///
+  int64_t Submit(Request request);
+
+  ///
+  /// \brief Run one step of the batch: admit, run the predictor, and evict
+  /// the finished sequences.
+  ///
+  /// \return The number of the running and queued sequences after the step.
+  ///
+  size_t Step();
+
+  /// \brief The number of the sequences in the slots of the batch.
+  size_t NumRunning() const;
+
+  /// \brief The number of the requests waiting in the queue. thread safe.
+  size_t NumPending() const;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+///
+/// \class SpeculativeDecoder
+///
+/// \brief SpeculativeDecoder generates a sequence by a small draft model and
+/// a large target model in one process. Each round the draft model proposes
+/// num_draft_tokens tokens one by one, and the target model verifies all of
+/// them in one run. The longest prefix of the draft tokens equal to the
+/// greedy tokens of the target is accepted, followed by the token of the
+/// target at the first difference, so each round yields one to
+/// num_draft_tokens + 1 tokens, the same as the greedy decoding of the
+/// target. The caches of the rejected tokens are rolled back by
+/// PagedKVCache::Truncate.
+///
+/// The models take the inputs of GenerationLoop::Options for a batch of one
+/// sequence, where a run of more than one token has seq_lens_encoder equal to
+/// seq_lens_this_time and seq_lens_decoder the tokens already in the cache.
+/// The output has a row for each input token of the run, either the int64
+/// next tokens or the float32 logits. To share the stream, create both
+/// predictors by configs with Config::SetExecStream of the same stream, the
+/// memory of both comes from the allocator of the place.
+///
+/// Usage:
+///
+/// \code{.cpp}
+/// paddle_infer::services::SpeculativeDecoder decoder(
+///     draft, &draft_cache, target, &target_cache, options, 4);
+/// decoder.Generate(prompt, 128, eos_token_id,
+///                  [](int64_t token, bool finished) { ... });
+/// \endcode
+///
+class PD_INFER_DECL SpeculativeDecoder {
+ public:
+  SpeculativeDecoder() = delete;
+  SpeculativeDecoder(const SpeculativeDecoder&) = delete;
+  SpeculativeDecoder& operator=(const SpeculativeDecoder&) = delete;
+
+  ///
+  /// \brief Construct the decoder. The predictors and the caches are not
+  /// owned. The names and max_seq_len of options are used.
+  ///
+  SpeculativeDecoder(Predictor* draft,
+                     PagedKVCache* draft_cache,
+                     Predictor* target,
+                     PagedKVCache* target_cache,
+                     const GenerationLoop::Options& options,
+                     int num_draft_tokens);
+
+  ~SpeculativeDecoder();
+
+  ///
+  /// \brief Generate the tokens after the prompt, on_token is called with each
+  /// of them, finished is true for the last one.
+  ///
+  /// \return The number of the generated tokens, or -1 if the prompt is empty
+  /// or not shorter than max_seq_len, max_new_tokens is not positive, or the
+  /// caches are short of blocks.
+  ///
+  int Generate(const std::vector<int64_t>& prompt,
+               int max_new_tokens,
+               int64_t eos_token_id,
+               const std::function<void(int64_t, bool)>& on_token);
+
+  ///
+  /// \brief The draft tokens accepted by the target over the draft tokens
+  /// proposed, since the construction.
+  ///
+  double AcceptanceRate() const;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
 }  // namespace services
 
 }  // namespace paddle_infer
@@ -602,6 +602,7 @@ const std::vector<std::string> kPirGpuPasses{
     "matmul_add_act_fuse_pass",
     "fc_elementwise_layernorm_fuse_pass",
     "add_norm_fuse_pass",
+    "fuse_allreduce_residual_rms_norm_pass",
     "group_norm_silu_fuse_pass",
     "matmul_scale_fuse_pass",
     "matmul_transpose_fuse_pass",
@@ -681,6 +682,7 @@ const std::vector<std::string> kPirMkldnnBf16Passes{
 const std::vector<std::string> kPirCpuPasses{
     "add_shadow_output_after_dead_parameter_pass",
     "delete_quant_dequant_linear_op_pass",
-    "delete_weight_dequant_linear_op_pass"};
+    "delete_weight_dequant_linear_op_pass",
+    "weight_only_linear_cpu_pass"};
 
 }  // namespace paddle
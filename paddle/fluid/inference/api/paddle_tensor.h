@@ -129,6 +129,22 @@ class PD_INFER_DECL Tensor {
                          PlaceType place,
                          DataLayout layout = DataLayout::kNCHW);
 
+  /// \brief Share the data with tensor data, and take the ownership of it.
+  /// The deleter is called with data once the predictor no longer uses it,
+  /// so a buffer of the caller can be the input without copy and without
+  /// being kept alive by the caller until the run ends.
+  /// \param data The pointer of the data, from which the tensor will share.
+  /// \param shape The shape of data.
+  /// \param place The place of data.
+  /// \param deleter The function to free data.
+  /// \param layout The layout of data. Only NCHW is supported now.
+  template <typename T>
+  void ShareExternalData(T* data,
+                         const std::vector<int>& shape,
+                         PlaceType place,
+                         std::function<void(void*)> deleter,
+                         DataLayout layout = DataLayout::kNCHW);
+
   /// \brief Experimental interface.
   /// It's usually used to set the input tensor data with Strings data type.
   /// \param data The pointer of the data, from which the tensor will copy.
@@ -0,0 +1,255 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "paddle/fluid/inference/api/paddle_inference_api.h"
+#include "paddle/phi/common/float16.h"
+#include "paddle/phi/core/enforce.h"
+#include "paddle/phi/core/memory/malloc.h"
+
+namespace paddle_infer::services {
+
+namespace {
+
+phi::Place ToPlace(PlaceType place, int device_id) {
+  switch (place) {
+    case PlaceType::kCPU:
+      return phi::CPUPlace();
+    case PlaceType::kGPU:
+      return phi::GPUPlace(device_id);
+    case PlaceType::kXPU:
+      return phi::XPUPlace(device_id);
+    default:
+      PADDLE_THROW(common::errors::InvalidArgument(
+          "The place of PagedKVCache must be one of [PlaceType::kCPU, "
+          "PlaceType::kGPU, PlaceType::kXPU]."));
+  }
+}
+
+void ShareCache(Tensor* tensor,
+                void* data,
+                const std::vector<int>& shape,
+                DataType dtype,
+                PlaceType place) {
+  switch (dtype) {
+    case DataType::FLOAT32:
+      tensor->ShareExternalData(static_cast<float*>(data), shape, place);
+      break;
+    case DataType::FLOAT16:
+      tensor->ShareExternalData(
+          static_cast<phi::dtype::float16*>(data), shape, place);
+      break;
+    case DataType::BFLOAT16:
+      tensor->ShareExternalData(
+          static_cast<phi::dtype::bfloat16*>(data), shape, place);
+      break;
+    case DataType::INT8:
+      tensor->ShareExternalData(static_cast<int8_t*>(data), shape, place);
+      break;
+    case DataType::UINT8:
+      tensor->ShareExternalData(static_cast<uint8_t*>(data), shape, place);
+      break;
+    default:
+      PADDLE_THROW(common::errors::InvalidArgument(
+          "The dtype of PagedKVCache must be one of float32, float16, "
+          "bfloat16, int8 and uint8."));
+  }
+}
+
+}  // namespace
+
+struct PagedKVCache::Impl {
+  int BlocksOf(int num_tokens) const {
+    return (num_tokens + block_size - 1) / block_size;
+  }
+
+  int num_layers;
+  int num_blocks;
+  int block_size;
+  int num_kv_heads;
+  int head_dim;
+  DataType dtype;
+  PlaceType place;
+  std::vector<std::shared_ptr<phi::Allocation>> key_caches;
+  std::vector<std::shared_ptr<phi::Allocation>> value_caches;
+
+  mutable std::mutex mutex;
+  // the free blocks, the lower ones at the back to be used first
+  std::vector<int> free_blocks;
+  // the blocks of each sequence by the order of its tokens
+  std::unordered_map<int64_t, std::vector<int>> seqs;
+};
+
+PagedKVCache::PagedKVCache(int num_layers,
+                           int num_blocks,
+                           int block_size,
+                           int num_kv_heads,
+                           int head_dim,
+                           DataType dtype,
+                           PlaceType place,
+                           int device_id)
+    : impl_(new Impl) {
+  PADDLE_ENFORCE_EQ(num_layers > 0 && num_blocks > 0 && block_size > 0 &&
+                        num_kv_heads > 0 && head_dim > 0,
+                    true,
+                    common::errors::InvalidArgument(
+                        "The sizes of PagedKVCache must be positive."));
+  impl_->num_layers = num_layers;
+  impl_->num_blocks = num_blocks;
+  impl_->block_size = block_size;
+  impl_->num_kv_heads = num_kv_heads;
+  impl_->head_dim = head_dim;
+  impl_->dtype = dtype;
+  impl_->place = place;
+
+  size_t bytes = static_cast<size_t>(num_blocks) * num_kv_heads * block_size *
+                 head_dim * GetNumBytesOfDataType(dtype);
+  phi::Place cache_place = ToPlace(place, device_id);
+  for (int i = 0; i < num_layers; ++i) {
+    impl_->key_caches.push_back(
+        paddle::memory::AllocShared(cache_place, bytes));
+    impl_->value_caches.push_back(
+        paddle::memory::AllocShared(cache_place, bytes));
+  }
+  impl_->free_blocks.reserve(num_blocks);
+  for (int i = num_blocks - 1; i >= 0; --i) {
+    impl_->free_blocks.push_back(i);
+  }
+  VLOG(3) << "PagedKVCache allocates " << num_layers << " layers of "
+          << num_blocks << " blocks, " << 2 * bytes * num_layers << " bytes";
+}
+
+PagedKVCache::~PagedKVCache() = default;
+
+bool PagedKVCache::Reserve(int64_t seq_id, int num_tokens) {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  auto& blocks = impl_->seqs[seq_id];
+  int needed = impl_->BlocksOf(num_tokens) - static_cast<int>(blocks.size());
+  if (needed > static_cast<int>(impl_->free_blocks.size())) {
+    if (blocks.empty()) {
+      impl_->seqs.erase(seq_id);
+    }
+    return false;
+  }
+  for (int i = 0; i < needed; ++i) {
+    blocks.push_back(impl_->free_blocks.back());
+    impl_->free_blocks.pop_back();
+  }
+  return true;
+}
+
+void PagedKVCache::Release(int64_t seq_id) {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  auto iter = impl_->seqs.find(seq_id);
+  if (iter == impl_->seqs.end()) {
+    return;
+  }
+  auto& blocks = iter->second;
+  impl_->free_blocks.insert(
+      impl_->free_blocks.end(), blocks.rbegin(), blocks.rend());
+  impl_->seqs.erase(iter);
+}
+
+void PagedKVCache::Truncate(int64_t seq_id, int num_tokens) {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  auto iter = impl_->seqs.find(seq_id);
+  if (iter == impl_->seqs.end()) {
+    return;
+  }
+  auto& blocks = iter->second;
+  int kept = std::max(impl_->BlocksOf(num_tokens), 0);
+  while (static_cast<int>(blocks.size()) > kept) {
+    impl_->free_blocks.push_back(blocks.back());
+    blocks.pop_back();
+  }
+}
+
+int PagedKVCache::NumFreeBlocks() const {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  return static_cast<int>(impl_->free_blocks.size());
+}
+
+std::vector<int> PagedKVCache::BlockTables(const std::vector<int64_t>& seq_ids,
+                                           int* max_blocks_per_seq) const {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  std::vector<const std::vector<int>*> seqs;
+  int max_blocks = 1;
+  static const std::vector<int> kEmptySlot;
+  for (int64_t seq_id : seq_ids) {
+    if (seq_id < 0) {
+      seqs.push_back(&kEmptySlot);
+      continue;
+    }
+    auto iter = impl_->seqs.find(seq_id);
+    PADDLE_ENFORCE_EQ(
+        iter != impl_->seqs.end(),
+        true,
+        common::errors::NotFound(
+            "The sequence %d has no block in PagedKVCache.", seq_id));
+    seqs.push_back(&iter->second);
+    max_blocks =
+        std::max(max_blocks, static_cast<int>(iter->second.size()));
+  }
+  std::vector<int> tables(seqs.size() * max_blocks, -1);
+  for (size_t i = 0; i < seqs.size(); ++i) {
+    std::copy(seqs[i]->begin(),
+              seqs[i]->end(),
+              tables.begin() + i * max_blocks);
+  }
+  *max_blocks_per_seq = max_blocks;
+  return tables;
+}
+
+void PagedKVCache::BindTo(Predictor* predictor,
+                          const std::vector<int64_t>& seq_ids,
+                          const std::string& key_cache_prefix,
+                          const std::string& value_cache_prefix,
+                          const std::string& block_tables_name) const {
+  std::vector<int> cache_shape = {impl_->num_blocks,
+                                  impl_->num_kv_heads,
+                                  impl_->block_size,
+                                  impl_->head_dim};
+  for (int i = 0; i < impl_->num_layers; ++i) {
+    auto key_cache = predictor->GetInputHandle(key_cache_prefix +
+                                               std::to_string(i));
+    ShareCache(key_cache.get(),
+               impl_->key_caches[i]->ptr(),
+               cache_shape,
+               impl_->dtype,
+               impl_->place);
+    auto value_cache = predictor->GetInputHandle(value_cache_prefix +
+                                                 std::to_string(i));
+    ShareCache(value_cache.get(),
+               impl_->value_caches[i]->ptr(),
+               cache_shape,
+               impl_->dtype,
+               impl_->place);
+  }
+  int max_blocks_per_seq = 0;
+  auto tables = BlockTables(seq_ids, &max_blocks_per_seq);
+  auto block_tables = predictor->GetInputHandle(block_tables_name);
+  block_tables->Reshape(
+      {static_cast<int>(seq_ids.size()), max_blocks_per_seq});
+  block_tables->CopyFromCpu(tables.data());
+}
+
+}  // namespace paddle_infer::services
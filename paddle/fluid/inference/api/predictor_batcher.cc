@@ -0,0 +1,383 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "paddle/fluid/inference/api/paddle_inference_api.h"
+#include "paddle/phi/backends/context_pool.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/enforce.h"
+#include "paddle/phi/core/memory/memcpy.h"
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+#include "paddle/phi/core/platform/device/gpu/gpu_info.h"
+#endif
+
+namespace paddle_infer::services {
+
+namespace {
+
+phi::DenseTensor* GetDenseTensor(const paddle::Tensor& tensor) {
+  return static_cast<phi::DenseTensor*>(tensor.impl().get());
+}
+
+// Only the copies on GPU are issued to the stream of the predictor, the
+// others are synchronous.
+void* CopyStream(const phi::Place& place,
+                 void* exec_stream,
+                 bool* stream_used) {
+  if (phi::is_gpu_place(place) && exec_stream != nullptr) {
+    *stream_used = true;
+    return exec_stream;
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+struct PredictorBatcher::Impl {
+  struct Request {
+    const std::vector<paddle::Tensor>* inputs;
+    std::vector<paddle::Tensor>* outputs;
+    // -1 means the request can not be merged with others
+    int64_t batch_size;
+    std::promise<bool> done;
+  };
+
+  Impl(const Config& config,
+       size_t max_batch_size,
+       int64_t batch_timeout_us,
+       size_t num_predictors)
+      : pool(config, num_predictors),
+        max_batch_size(max_batch_size),
+        batch_timeout(batch_timeout_us) {
+    for (size_t i = 0; i < num_predictors; ++i) {
+      workers.emplace_back(
+          [this, predictor = pool.Retrieve(i)] { Loop(predictor); });
+    }
+  }
+
+  ~Impl() {
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      stop = true;
+    }
+    cv.notify_all();
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+
+  static int64_t GetBatchSize(const std::vector<paddle::Tensor>& inputs) {
+    if (inputs.empty()) {
+      return -1;
+    }
+    int64_t batch_size = -1;
+    for (const auto& input : inputs) {
+      if (!input.defined() || !input.is_dense_tensor() ||
+          !GetDenseTensor(input)->lod().empty()) {
+        return -1;
+      }
+      auto shape = input.shape();
+      if (shape.empty() || (batch_size != -1 && shape[0] != batch_size)) {
+        return -1;
+      }
+      batch_size = shape[0];
+    }
+    return batch_size;
+  }
+
+  // Whether the inputs of two requests can be concatenated along dim 0.
+  static bool CanMerge(const Request& lhs, const Request& rhs) {
+    if (lhs.batch_size == -1 || rhs.batch_size == -1 ||
+        lhs.inputs->size() != rhs.inputs->size()) {
+      return false;
+    }
+    for (size_t i = 0; i < lhs.inputs->size(); ++i) {
+      const auto& x = lhs.inputs->at(i);
+      const auto& y = rhs.inputs->at(i);
+      if (x.name() != y.name() || x.dtype() != y.dtype() ||
+          x.place() != y.place()) {
+        return false;
+      }
+      auto x_shape = x.shape();
+      auto y_shape = y.shape();
+      if (x_shape.size() != y_shape.size() ||
+          !std::equal(
+              x_shape.begin() + 1, x_shape.end(), y_shape.begin() + 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // The batch size of the requests which can be merged with the head of the
+  // queue, must be called with the mutex held.
+  size_t PendingBatchSize() const {
+    const Request* head = queue.front();
+    if (head->batch_size == -1) {
+      return max_batch_size;
+    }
+    size_t total = 0;
+    for (const Request* request : queue) {
+      if (request == head || CanMerge(*head, *request)) {
+        total += request->batch_size;
+      }
+    }
+    return total;
+  }
+
+  // Blocks until a batch is ready, returns an empty batch if the batcher is
+  // stopped and all requests are done.
+  std::vector<Request*> NextBatch() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      cv.wait(lock, [this] { return stop || !queue.empty(); });
+      if (queue.empty()) {
+        return {};
+      }
+      auto deadline = std::chrono::steady_clock::now() + batch_timeout;
+      while (!stop && !queue.empty() && PendingBatchSize() < max_batch_size) {
+        if (cv.wait_until(lock, deadline) == std::cv_status::timeout) {
+          break;
+        }
+      }
+      // another worker may have taken the requests while waiting
+      if (queue.empty()) {
+        continue;
+      }
+
+      std::vector<Request*> batch{queue.front()};
+      queue.pop_front();
+      size_t total = std::max<int64_t>(batch[0]->batch_size, 0);
+      for (auto iter = queue.begin(); iter != queue.end();) {
+        if (CanMerge(*batch[0], **iter) &&
+            total + static_cast<size_t>((*iter)->batch_size) <=
+                max_batch_size) {
+          total += (*iter)->batch_size;
+          batch.push_back(*iter);
+          iter = queue.erase(iter);
+        } else {
+          ++iter;
+        }
+      }
+      return batch;
+    }
+  }
+
+  std::vector<paddle::Tensor> Concat(const std::vector<Request*>& batch,
+                                     void* exec_stream,
+                                     bool* stream_used) {
+    int64_t total = 0;
+    for (const Request* request : batch) {
+      total += request->batch_size;
+    }
+    std::vector<paddle::Tensor> merged_inputs;
+    const auto& first_inputs = *batch[0]->inputs;
+    for (size_t i = 0; i < first_inputs.size(); ++i) {
+      const auto& first = first_inputs[i];
+      auto shape = first.shape();
+      shape[0] = total;
+      auto place = first.place();
+      auto merged = std::make_shared<phi::DenseTensor>();
+      merged->Resize(common::make_ddim(shape));
+      phi::DeviceContextPool::Instance().Get(place)->Alloc(merged.get(),
+                                                           first.dtype());
+      auto* dst = static_cast<uint8_t*>(merged->data());
+      for (const Request* request : batch) {
+        auto* src = GetDenseTensor(request->inputs->at(i));
+        size_t size = src->numel() * phi::SizeOf(src->dtype());
+        paddle::memory::Copy(place,
+                             dst,
+                             place,
+                             src->data(),
+                             size,
+                             CopyStream(place, exec_stream, stream_used));
+        dst += size;
+      }
+      merged_inputs.emplace_back(merged, first.name());
+    }
+    return merged_inputs;
+  }
+
+  // Splits the outputs along dim 0, returns false if an output is not
+  // batched along dim 0.
+  bool Scatter(const std::vector<paddle::Tensor>& merged_outputs,
+               const std::vector<Request*>& batch,
+               void* exec_stream,
+               bool* stream_used) {
+    int64_t total = 0;
+    for (const Request* request : batch) {
+      total += request->batch_size;
+    }
+    for (const auto& output : merged_outputs) {
+      auto shape = output.shape();
+      if (!output.is_dense_tensor() || shape.empty() || shape[0] != total) {
+        LOG(WARNING) << "The output " << output.name()
+                     << " is not batched along dim 0, run the requests of "
+                        "the batch separately.";
+        return false;
+      }
+    }
+
+    for (Request* request : batch) {
+      request->outputs->clear();
+    }
+    for (const auto& output : merged_outputs) {
+      auto* src_tensor = GetDenseTensor(output);
+      auto place = src_tensor->place();
+      size_t row_size = total == 0 ? 0
+                                   : src_tensor->numel() / total *
+                                         phi::SizeOf(output.dtype());
+      auto* src = static_cast<const uint8_t*>(src_tensor->data());
+      auto shape = output.shape();
+      for (Request* request : batch) {
+        shape[0] = request->batch_size;
+        auto tensor = std::make_shared<phi::DenseTensor>();
+        tensor->Resize(common::make_ddim(shape));
+        phi::DeviceContextPool::Instance().Get(place)->Alloc(tensor.get(),
+                                                             output.dtype());
+        size_t size = row_size * request->batch_size;
+        paddle::memory::Copy(place,
+                             tensor->data(),
+                             place,
+                             src,
+                             size,
+                             CopyStream(place, exec_stream, stream_used));
+        src += size;
+        request->outputs->emplace_back(tensor, output.name());
+      }
+    }
+    return true;
+  }
+
+  static void RunSeparately(Predictor* predictor, Request* request) {
+    try {
+      request->outputs->clear();
+      request->done.set_value(
+          predictor->Run(*request->inputs, request->outputs));
+    } catch (...) {
+      request->done.set_exception(std::current_exception());
+    }
+  }
+
+  void RunBatch(Predictor* predictor, const std::vector<Request*>& batch) {
+    if (batch.size() == 1) {
+      RunSeparately(predictor, batch[0]);
+      return;
+    }
+    VLOG(4) << "Run a batch of " << batch.size() << " requests";
+
+    bool success = false;
+    try {
+      void* exec_stream = predictor->GetExecStream();
+      bool stream_used = false;
+      auto merged_inputs = Concat(batch, exec_stream, &stream_used);
+      std::vector<paddle::Tensor> merged_outputs;
+      success = predictor->Run(merged_inputs, &merged_outputs) &&
+                Scatter(merged_outputs, batch, exec_stream, &stream_used);
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+      // the merged tensors are released only after the copies are done
+      if (stream_used) {
+        paddle::platform::GpuStreamSync(static_cast<gpuStream_t>(exec_stream));
+      }
+#endif
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Run the merged batch failed: " << e.what()
+                   << ", run the requests of the batch separately.";
+      success = false;
+    }
+
+    for (Request* request : batch) {
+      if (success) {
+        request->done.set_value(true);
+      } else {
+        RunSeparately(predictor, request);
+      }
+    }
+  }
+
+  void Loop(Predictor* predictor) {
+    while (true) {
+      auto batch = NextBatch();
+      if (batch.empty()) {
+        return;
+      }
+      RunBatch(predictor, batch);
+    }
+  }
+
+  PredictorPool pool;
+  size_t max_batch_size;
+  std::chrono::microseconds batch_timeout;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<Request*> queue;
+  bool stop{false};
+
+  std::vector<std::thread> workers;
+};
+
+PredictorBatcher::PredictorBatcher(const Config& config,
+                                   size_t max_batch_size,
+                                   int64_t batch_timeout_us,
+                                   size_t num_predictors) {
+  PADDLE_ENFORCE_GE(
+      max_batch_size,
+      1UL,
+      common::errors::InvalidArgument(
+          "The max batch size should be greater than 0, but it's (%d)",
+          max_batch_size));
+  PADDLE_ENFORCE_GE(
+      batch_timeout_us,
+      0,
+      common::errors::InvalidArgument(
+          "The batch timeout should not be negative, but it's (%d)",
+          batch_timeout_us));
+  impl_ = std::make_unique<Impl>(
+      config, max_batch_size, batch_timeout_us, num_predictors);
+}
+
+PredictorBatcher::~PredictorBatcher() = default;
+
+bool PredictorBatcher::Run(const std::vector<paddle::Tensor>& inputs,
+                           std::vector<paddle::Tensor>* outputs) {
+  PADDLE_ENFORCE_NOT_NULL(
+      outputs,
+      common::errors::InvalidArgument("The outputs should not be nullptr."));
+  Impl::Request request;
+  request.inputs = &inputs;
+  request.outputs = outputs;
+  request.batch_size = Impl::GetBatchSize(inputs);
+  auto done = request.done.get_future();
+  {
+    std::lock_guard<std::mutex> guard(impl_->mutex);
+    impl_->queue.push_back(&request);
+  }
+  impl_->cv.notify_all();
+  return done.get();
+}
+
+}  // namespace paddle_infer::services
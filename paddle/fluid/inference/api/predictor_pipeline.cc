@@ -0,0 +1,354 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <glog/logging.h>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "paddle/fluid/inference/api/paddle_inference_api.h"
+#include "paddle/phi/backends/context_pool.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/enforce.h"
+#include "paddle/phi/core/memory/memcpy.h"
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+#include "paddle/phi/api/profiler/event.h"
+#include "paddle/phi/backends/gpu/gpu_info.h"
+#include "paddle/phi/core/platform/device/gpu/gpu_info.h"
+#endif
+
+namespace paddle_infer::services {
+
+namespace {
+
+phi::DenseTensor* GetDenseTensor(const paddle::Tensor& tensor) {
+  return static_cast<phi::DenseTensor*>(tensor.impl().get());
+}
+
+}  // namespace
+
+struct PredictorPipeline::Impl {
+  struct Request {
+    // The inputs of the stage to run next.
+    std::vector<paddle::Tensor> tensors;
+    std::vector<paddle::Tensor>* outputs;
+    // The predictor of the previous stage whose outputs are the tensors, -1
+    // for the inputs of the request.
+    int producer{-1};
+    std::promise<bool> done;
+  };
+
+  struct Replica {
+    Predictor* predictor;
+    // nullptr if the predictor does not run on GPU
+    void* stream{nullptr};
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    // Recorded on the stream after the run.
+    std::unique_ptr<phi::CudaEvent> produced;
+    // Recorded on the stream of the next stage after the run of the next
+    // stage on the outputs is issued.
+    std::unique_ptr<phi::CudaEvent> consumed;
+    bool consumed_recorded{false};
+#endif
+  };
+
+  struct StageState {
+    Stage stage;
+    std::vector<Replica> replicas;
+    std::deque<int> free_replicas;
+    std::deque<std::unique_ptr<Request>> queue;
+    bool exited{false};
+  };
+
+  Impl(const std::vector<Stage>& stages, int device_id) {
+    for (const auto& stage : stages) {
+      auto state = std::make_unique<StageState>();
+      state->stage = stage;
+      for (Predictor* predictor : stage.predictors) {
+        Replica replica;
+        replica.predictor = predictor;
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+        replica.stream = predictor->GetExecStream();
+        if (replica.stream != nullptr) {
+          phi::backends::gpu::GPUDeviceGuard guard(device_id);
+          replica.produced = std::make_unique<phi::CudaEvent>();
+          replica.consumed = std::make_unique<phi::CudaEvent>();
+        }
+#endif
+        state->free_replicas.push_back(state->replicas.size());
+        state->replicas.push_back(std::move(replica));
+      }
+      this->stages.push_back(std::move(state));
+    }
+    for (size_t i = 0; i < this->stages.size(); ++i) {
+      workers.emplace_back([this, i] { Loop(i); });
+    }
+  }
+
+  ~Impl() {
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      stop = true;
+    }
+    cv.notify_all();
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  static void StreamWaitEvent(void* stream, phi::CudaEvent* event) {
+#ifdef PADDLE_WITH_HIP
+    PADDLE_ENFORCE_GPU_SUCCESS(hipStreamWaitEvent(
+        static_cast<gpuStream_t>(stream), event->GetRawCudaEvent(), 0));
+#else
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamWaitEvent(
+        static_cast<gpuStream_t>(stream), event->GetRawCudaEvent(), 0));
+#endif
+  }
+#endif
+
+  // Orders the run on stream after the outputs of the producer, on the host
+  // if the outputs are read by connect.
+  static void WaitProduced(Replica* producer, void* stream, bool on_host) {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    if (producer->stream == nullptr) {
+      return;
+    }
+    if (on_host || stream == nullptr) {
+      producer->produced->Synchronize();
+    } else if (stream != producer->stream) {
+      StreamWaitEvent(stream, producer->produced.get());
+    }
+#endif
+  }
+
+  // Gives the replica back to its stage once the run on its outputs is
+  // issued on consumer_stream, nullptr if there is no such run.
+  void Release(size_t stage_idx, int replica_idx, void* consumer_stream) {
+    auto& state = *stages[stage_idx];
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    auto& replica = state.replicas[replica_idx];
+    replica.consumed_recorded = false;
+    if (replica.stream != nullptr && consumer_stream != nullptr &&
+        consumer_stream != replica.stream) {
+      replica.consumed->Record(static_cast<gpuStream_t>(consumer_stream));
+      replica.consumed_recorded = true;
+    }
+#endif
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      state.free_replicas.push_back(replica_idx);
+    }
+    cv.notify_all();
+  }
+
+  bool RunReplica(size_t stage_idx,
+                  Replica* replica,
+                  Request* request,
+                  std::vector<paddle::Tensor>* outputs) {
+    const auto& stage = stages[stage_idx]->stage;
+    bool has_connect = stage_idx > 0 && static_cast<bool>(stage.connect);
+    if (stage_idx > 0) {
+      WaitProduced(&stages[stage_idx - 1]->replicas[request->producer],
+                   replica->stream,
+                   has_connect);
+    }
+    std::vector<paddle::Tensor> inputs;
+    if (has_connect) {
+      if (!stage.connect(request->tensors, &inputs)) {
+        LOG(WARNING) << "The connect of stage " << stage_idx << " failed.";
+        return false;
+      }
+    } else {
+      inputs = request->tensors;
+    }
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    // the outputs of the last run are read by the next stage
+    if (replica->consumed_recorded) {
+      StreamWaitEvent(replica->stream, replica->consumed.get());
+    }
+#endif
+    if (!replica->predictor->Run(inputs, outputs)) {
+      return false;
+    }
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    if (replica->stream != nullptr) {
+      replica->produced->Record(static_cast<gpuStream_t>(replica->stream));
+    }
+#endif
+    return true;
+  }
+
+  // Copies the outputs of the last stage to the outputs of the request, as
+  // the predictor overwrites its outputs in the next run.
+  static void CopyOutputs(const Replica& replica,
+                          const std::vector<paddle::Tensor>& outputs,
+                          std::vector<paddle::Tensor>* dst) {
+    dst->clear();
+    for (const auto& output : outputs) {
+      auto* src = GetDenseTensor(output);
+      auto place = src->place();
+      auto tensor = std::make_shared<phi::DenseTensor>();
+      tensor->Resize(src->dims());
+      tensor->set_lod(src->lod());
+      phi::DeviceContextPool::Instance().Get(place)->Alloc(tensor.get(),
+                                                           src->dtype());
+      size_t size = src->numel() * phi::SizeOf(src->dtype());
+      if (size > 0) {
+        paddle::memory::Copy(place,
+                             tensor->data(),
+                             place,
+                             src->data(),
+                             size,
+                             phi::is_gpu_place(place) ? replica.stream
+                                                      : nullptr);
+      }
+      dst->emplace_back(tensor, output.name());
+    }
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    if (replica.stream != nullptr) {
+      paddle::platform::GpuStreamSync(static_cast<gpuStream_t>(replica.stream));
+    }
+#endif
+  }
+
+  void RunStage(size_t stage_idx,
+                int replica_idx,
+                std::unique_ptr<Request> request) {
+    auto* replica = &stages[stage_idx]->replicas[replica_idx];
+    bool is_last = stage_idx + 1 == stages.size();
+    std::vector<paddle::Tensor> outputs;
+    bool success = false;
+    std::exception_ptr error;
+    try {
+      success = RunReplica(stage_idx, replica, request.get(), &outputs);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    if (stage_idx > 0) {
+      Release(stage_idx - 1, request->producer, replica->stream);
+    }
+
+    if (success && !is_last) {
+      request->tensors = std::move(outputs);
+      request->producer = replica_idx;
+      {
+        std::lock_guard<std::mutex> guard(mutex);
+        stages[stage_idx + 1]->queue.push_back(std::move(request));
+      }
+      cv.notify_all();
+      return;
+    }
+
+    if (success) {
+      try {
+        CopyOutputs(*replica, outputs, request->outputs);
+      } catch (...) {
+        error = std::current_exception();
+      }
+    }
+    Release(stage_idx, replica_idx, nullptr);
+    if (error) {
+      request->done.set_exception(error);
+    } else {
+      request->done.set_value(success);
+    }
+  }
+
+  void Loop(size_t stage_idx) {
+    auto& state = *stages[stage_idx];
+    while (true) {
+      std::unique_ptr<Request> request;
+      int replica_idx = -1;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        // the requests of the previous stage are drained before exit
+        cv.wait(lock, [&] {
+          bool prev_exited = stage_idx == 0 || stages[stage_idx - 1]->exited;
+          return (stop && prev_exited && state.queue.empty()) ||
+                 (!state.queue.empty() && !state.free_replicas.empty());
+        });
+        if (state.queue.empty()) {
+          state.exited = true;
+          break;
+        }
+        request = std::move(state.queue.front());
+        state.queue.pop_front();
+        replica_idx = state.free_replicas.front();
+        state.free_replicas.pop_front();
+      }
+      RunStage(stage_idx, replica_idx, std::move(request));
+    }
+    cv.notify_all();
+  }
+
+  std::vector<std::unique_ptr<StageState>> stages;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool stop{false};
+
+  std::vector<std::thread> workers;
+};
+
+PredictorPipeline::PredictorPipeline(const std::vector<Stage>& stages,
+                                     int device_id) {
+  PADDLE_ENFORCE_GE(stages.size(),
+                    1UL,
+                    common::errors::InvalidArgument(
+                        "The pipeline should have at least one stage."));
+  for (size_t i = 0; i < stages.size(); ++i) {
+    PADDLE_ENFORCE_GE(
+        stages[i].predictors.size(),
+        1UL,
+        common::errors::InvalidArgument(
+            "The stage %d of the pipeline should have predictors.", i));
+    for (Predictor* predictor : stages[i].predictors) {
+      PADDLE_ENFORCE_NOT_NULL(
+          predictor,
+          common::errors::InvalidArgument(
+              "The predictors of stage %d should not be nullptr.", i));
+    }
+  }
+  impl_ = std::make_unique<Impl>(stages, device_id);
+}
+
+PredictorPipeline::~PredictorPipeline() = default;
+
+bool PredictorPipeline::Run(const std::vector<paddle::Tensor>& inputs,
+                            std::vector<paddle::Tensor>* outputs) {
+  PADDLE_ENFORCE_NOT_NULL(
+      outputs,
+      common::errors::InvalidArgument("The outputs should not be nullptr."));
+  auto request = std::make_unique<Impl::Request>();
+  request->tensors = inputs;
+  request->outputs = outputs;
+  auto done = request->done.get_future();
+  {
+    std::lock_guard<std::mutex> guard(impl_->mutex);
+    impl_->stages[0]->queue.push_back(std::move(request));
+  }
+  impl_->cv.notify_all();
+  return done.get();
+}
+
+}  // namespace paddle_infer::services
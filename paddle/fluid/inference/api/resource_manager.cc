@@ -199,8 +199,10 @@ void GPUContextResource::InitGpuProperties() {
 }
 
 void GPUContextResource::InitGpuEigenDevice() {
+  // Allocate the eigen scratch buffers on the stream of this resource, so
+  // that they are not synchronized with the other streams on the device.
   auto* allocator = paddle::memory::allocation::AllocatorFacade::Instance()
-                        .GetAllocator(place_)
+                        .GetAllocator(place_, stream_)
                         .get();
   eigen_stream_ = std::make_unique<internal::EigenGpuStreamDevice>();
   eigen_stream_->Reinitialize(stream_, allocator, place_);
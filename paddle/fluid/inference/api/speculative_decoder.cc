@@ -0,0 +1,251 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "paddle/fluid/inference/api/paddle_inference_api.h"
+#include "paddle/phi/core/enforce.h"
+
+namespace paddle_infer::services {
+
+struct SpeculativeDecoder::Impl {
+  // Run the tokens from begin, the first begin tokens are in the cache.
+  // Returns the greedy next token of each input token, or empty if the cache
+  // is short of blocks.
+  std::vector<int64_t> Run(Predictor* predictor,
+                           PagedKVCache* cache,
+                           int64_t seq_id,
+                           const std::vector<int64_t>& tokens,
+                           int begin) const {
+    const int num_tokens = static_cast<int>(tokens.size());
+    const int this_time = num_tokens - begin;
+    if (!cache->Reserve(seq_id, num_tokens)) {
+      return {};
+    }
+    std::vector<int64_t> input_ids(tokens.begin() + begin, tokens.end());
+    int seq_lens_this_time = this_time;
+    int seq_lens_encoder = begin == 0 || this_time > 1 ? this_time : 0;
+    int seq_lens_decoder = begin;
+
+    auto input = predictor->GetInputHandle(options.input_ids_name);
+    input->Reshape({1, this_time});
+    input->CopyFromCpu(input_ids.data());
+    input = predictor->GetInputHandle(options.seq_lens_this_time_name);
+    input->Reshape({1, 1});
+    input->CopyFromCpu(&seq_lens_this_time);
+    input = predictor->GetInputHandle(options.seq_lens_encoder_name);
+    input->Reshape({1, 1});
+    input->CopyFromCpu(&seq_lens_encoder);
+    input = predictor->GetInputHandle(options.seq_lens_decoder_name);
+    input->Reshape({1, 1});
+    input->CopyFromCpu(&seq_lens_decoder);
+    cache->BindTo(predictor,
+                  {seq_id},
+                  options.key_cache_prefix,
+                  options.value_cache_prefix,
+                  options.block_tables_name);
+    PADDLE_ENFORCE_EQ(predictor->Run(),
+                      true,
+                      common::errors::PreconditionNotMet(
+                          "The predictor of SpeculativeDecoder fails to run."));
+
+    auto output = predictor->GetOutputHandle(options.output_name);
+    auto shape = output->shape();
+    int64_t numel = 1;
+    for (int dim : shape) {
+      numel *= dim;
+    }
+    PADDLE_ENFORCE_EQ(
+        !shape.empty() && shape[0] == this_time,
+        true,
+        common::errors::InvalidArgument(
+            "The output %s of SpeculativeDecoder should have a row for each "
+            "of the %d input tokens.",
+            options.output_name,
+            this_time));
+    std::vector<int64_t> next_tokens(this_time);
+    if (output->type() == DataType::INT64) {
+      PADDLE_ENFORCE_EQ(numel,
+                        this_time,
+                        common::errors::InvalidArgument(
+                            "The int64 output %s of SpeculativeDecoder should "
+                            "be one token for each input token, but got %d "
+                            "tokens.",
+                            options.output_name,
+                            numel));
+      output->CopyToCpu(next_tokens.data());
+    } else if (output->type() == DataType::FLOAT32) {
+      std::vector<float> logits(numel);
+      output->CopyToCpu(logits.data());
+      const int64_t vocab = numel / this_time;
+      for (int i = 0; i < this_time; ++i) {
+        auto row = logits.begin() + i * vocab;
+        next_tokens[i] = std::max_element(row, row + vocab) - row;
+      }
+    } else {
+      PADDLE_THROW(common::errors::InvalidArgument(
+          "The output %s of SpeculativeDecoder should be the int64 tokens or "
+          "the float32 logits.",
+          options.output_name));
+    }
+    return next_tokens;
+  }
+
+  Predictor* draft;
+  PagedKVCache* draft_cache;
+  Predictor* target;
+  PagedKVCache* target_cache;
+  GenerationLoop::Options options;
+  int num_draft_tokens;
+
+  int64_t next_id{0};
+  int64_t num_proposed{0};
+  int64_t num_accepted{0};
+};
+
+SpeculativeDecoder::SpeculativeDecoder(Predictor* draft,
+                                       PagedKVCache* draft_cache,
+                                       Predictor* target,
+                                       PagedKVCache* target_cache,
+                                       const GenerationLoop::Options& options,
+                                       int num_draft_tokens)
+    : impl_(new Impl) {
+  PADDLE_ENFORCE_EQ(
+      draft && draft_cache && target && target_cache,
+      true,
+      common::errors::InvalidArgument(
+          "The predictors and caches of SpeculativeDecoder should not be "
+          "null."));
+  PADDLE_ENFORCE_GT(num_draft_tokens,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The num_draft_tokens of SpeculativeDecoder should be "
+                        "positive, but got %d.",
+                        num_draft_tokens));
+  impl_->draft = draft;
+  impl_->draft_cache = draft_cache;
+  impl_->target = target;
+  impl_->target_cache = target_cache;
+  impl_->options = options;
+  impl_->num_draft_tokens = num_draft_tokens;
+}
+
+SpeculativeDecoder::~SpeculativeDecoder() = default;
+
+int SpeculativeDecoder::Generate(
+    const std::vector<int64_t>& prompt,
+    int max_new_tokens,
+    int64_t eos_token_id,
+    const std::function<void(int64_t, bool)>& on_token) {
+  const int max_seq_len = impl_->options.max_seq_len;
+  if (prompt.empty() || static_cast<int>(prompt.size()) >= max_seq_len ||
+      max_new_tokens <= 0) {
+    return -1;
+  }
+  const int64_t seq_id = impl_->next_id++;
+  auto release = [&]() {
+    impl_->draft_cache->Release(seq_id);
+    impl_->target_cache->Release(seq_id);
+  };
+
+  int num_generated = 0;
+  bool finished = false;
+  auto emit = [&](int64_t token, std::vector<int64_t>* tokens) {
+    tokens->push_back(token);
+    ++num_generated;
+    finished = token == eos_token_id || num_generated >= max_new_tokens ||
+               static_cast<int>(tokens->size()) >= max_seq_len;
+    if (on_token) {
+      on_token(token, finished);
+    }
+  };
+
+  // the target prefills the prompt for the first token
+  std::vector<int64_t> tokens = prompt;
+  auto verified = impl_->Run(
+      impl_->target, impl_->target_cache, seq_id, tokens, /*begin=*/0);
+  if (verified.empty()) {
+    release();
+    return -1;
+  }
+  int target_cached = static_cast<int>(tokens.size());
+  int draft_cached = 0;
+  emit(verified.back(), &tokens);
+
+  while (!finished) {
+    const int len = static_cast<int>(tokens.size());
+    // no more draft tokens than the ones left to generate
+    const int k = std::min({impl_->num_draft_tokens,
+                            max_new_tokens - num_generated - 1,
+                            max_seq_len - len - 1});
+    std::vector<int64_t> proposal = tokens;
+    for (int i = 0; i < k; ++i) {
+      auto drafted = impl_->Run(
+          impl_->draft, impl_->draft_cache, seq_id, proposal, draft_cached);
+      if (drafted.empty()) {
+        release();
+        return -1;
+      }
+      draft_cached = static_cast<int>(proposal.size());
+      proposal.push_back(drafted.back());
+    }
+
+    // the target runs the last token and the draft tokens at once, its row i
+    // is the token after the draft token i - 1
+    verified = impl_->Run(
+        impl_->target, impl_->target_cache, seq_id, proposal, target_cached);
+    if (verified.empty()) {
+      release();
+      return -1;
+    }
+    int accepted = 0;
+    while (accepted < k && verified[accepted] == proposal[len + accepted]) {
+      ++accepted;
+    }
+    impl_->num_proposed += k;
+    impl_->num_accepted += accepted;
+    VLOG(4) << "SpeculativeDecoder accepts " << accepted << " of " << k
+            << " draft tokens";
+
+    // roll back the caches of the rejected tokens
+    target_cached = len + accepted;
+    impl_->target_cache->Truncate(seq_id, target_cached);
+    draft_cached = std::min(draft_cached, len + accepted);
+    impl_->draft_cache->Truncate(seq_id, draft_cached);
+
+    for (int i = 0; i < accepted && !finished; ++i) {
+      emit(proposal[len + i], &tokens);
+    }
+    if (!finished) {
+      emit(verified[accepted], &tokens);
+    }
+  }
+  release();
+  return num_generated;
+}
+
+double SpeculativeDecoder::AcceptanceRate() const {
+  if (impl_->num_proposed == 0) {
+    return 0.;
+  }
+  return static_cast<double>(impl_->num_accepted) / impl_->num_proposed;
+}
+
+}  // namespace paddle_infer::services
@@ -14,6 +14,10 @@
 
 #include "paddle/fluid/inference/capi_exp/pd_predictor.h"
 
+#include <functional>
+#include <numeric>
+#include <vector>
+
 #include "paddle/fluid/inference/api/paddle_inference_api.h"
 #include "paddle/fluid/inference/capi_exp/pd_config.h"
 #include "paddle/fluid/inference/capi_exp/pd_types.h"
@@ -143,6 +147,119 @@ PD_Bool PD_PredictorRun(__pd_keep PD_Predictor* pd_predictor) {
   return predictor->Run();  // NOLINT
 }
 
+PD_Bool PD_PredictorRunWithBuffers(__pd_keep PD_Predictor* pd_predictor,
+                                   size_t input_num,
+                                   const void* const* input_data,
+                                   const PD_DataType* input_dtypes,
+                                   const size_t* input_ranks,
+                                   const int32_t* const* input_shapes,
+                                   size_t output_num,
+                                   void* const* output_data,
+                                   const size_t* output_bytes,
+                                   size_t* output_numels) {
+  CHECK_AND_CONVERT_PD_PREDICTOR;
+  auto& input_handles = pd_predictor->input_handles;
+  auto& output_handles = pd_predictor->output_handles;
+  if (input_handles.empty() && output_handles.empty()) {
+    for (const auto& name : predictor->GetInputNames()) {
+      input_handles.emplace_back(predictor->GetInputHandle(name));
+    }
+    for (const auto& name : predictor->GetOutputNames()) {
+      output_handles.emplace_back(predictor->GetOutputHandle(name));
+    }
+  }
+  PADDLE_ENFORCE_EQ(
+      input_num,
+      input_handles.size(),
+      common::errors::InvalidArgument(
+          "The predictor has %d inputs, but received %d input buffers.",
+          input_handles.size(),
+          input_num));
+  PADDLE_ENFORCE_EQ(
+      output_num,
+      output_handles.size(),
+      common::errors::InvalidArgument(
+          "The predictor has %d outputs, but received %d output buffers.",
+          output_handles.size(),
+          output_num));
+
+  std::vector<int> shape;
+  for (size_t i = 0; i < input_num; ++i) {
+    shape.assign(input_shapes[i], input_shapes[i] + input_ranks[i]);
+    auto& tensor = input_handles[i];
+    const auto place = paddle_infer::PlaceType::kCPU;
+    switch (input_dtypes[i]) {
+      case PD_DATA_FLOAT32:
+        tensor->ShareExternalData(
+            static_cast<const float*>(input_data[i]), shape, place);
+        break;
+      case PD_DATA_INT32:
+        tensor->ShareExternalData(
+            static_cast<const int32_t*>(input_data[i]), shape, place);
+        break;
+      case PD_DATA_INT64:
+        tensor->ShareExternalData(
+            static_cast<const int64_t*>(input_data[i]), shape, place);
+        break;
+      case PD_DATA_UINT8:
+        tensor->ShareExternalData(
+            static_cast<const uint8_t*>(input_data[i]), shape, place);
+        break;
+      case PD_DATA_INT8:
+        tensor->ShareExternalData(
+            static_cast<const int8_t*>(input_data[i]), shape, place);
+        break;
+      default:
+        PADDLE_THROW(common::errors::Unimplemented(
+            "Unsupported data type %d of the input %d.",
+            static_cast<int>(input_dtypes[i]),
+            i));
+    }
+  }
+
+  if (!predictor->Run()) return FALSE;
+
+  for (size_t i = 0; i < output_num; ++i) {
+    auto& tensor = output_handles[i];
+    std::vector<int> out_shape = tensor->shape();
+    size_t numel = std::accumulate(
+        out_shape.begin(), out_shape.end(), size_t{1}, std::multiplies<>());
+    size_t bytes = numel * paddle_infer::GetNumBytesOfDataType(tensor->type());
+    PADDLE_ENFORCE_LE(
+        bytes,
+        output_bytes[i],
+        common::errors::InvalidArgument(
+            "The output %d needs %d bytes, but its buffer only has %d bytes.",
+            i,
+            bytes,
+            output_bytes[i]));
+    switch (tensor->type()) {
+      case paddle_infer::DataType::FLOAT32:
+        tensor->CopyToCpu(static_cast<float*>(output_data[i]));
+        break;
+      case paddle_infer::DataType::INT32:
+        tensor->CopyToCpu(static_cast<int32_t*>(output_data[i]));
+        break;
+      case paddle_infer::DataType::INT64:
+        tensor->CopyToCpu(static_cast<int64_t*>(output_data[i]));
+        break;
+      case paddle_infer::DataType::UINT8:
+        tensor->CopyToCpu(static_cast<uint8_t*>(output_data[i]));
+        break;
+      case paddle_infer::DataType::INT8:
+        tensor->CopyToCpu(static_cast<int8_t*>(output_data[i]));
+        break;
+      default:
+        PADDLE_THROW(common::errors::Unimplemented(
+            "Unsupported data type of the output %d.", i));
+    }
+    if (output_numels != nullptr) {
+      output_numels[i] = numel;
+    }
+  }
+  return TRUE;
+}
+
 void PD_PredictorClearIntermediateTensor(__pd_keep PD_Predictor* pd_predictor) {
   CHECK_AND_CONVERT_PD_PREDICTOR;
   predictor->ClearIntermediateTensor();
@@ -131,6 +131,40 @@ PADDLE_CAPI_EXPORT extern __pd_give PD_Tensor* PD_PredictorGetOutputHandle(
 PADDLE_CAPI_EXPORT extern PD_Bool PD_PredictorRun(
     __pd_keep PD_Predictor* pd_predictor);
 
+///
+/// \brief Run the prediction engine on the cpu buffers of the caller. The
+/// inputs share the buffers without copy, the outputs are copied to the
+/// buffers of the caller, and the tensor handles are created at the first
+/// call and reused by the later ones.
+///
+/// \param[in] pd_predictor predictor
+/// \param[in] input_num the number of inputs, which are in the order of
+/// PD_PredictorGetInputNames
+/// \param[in] input_data the buffers of the inputs, used until the function
+/// returns
+/// \param[in] input_dtypes the data types of the inputs
+/// \param[in] input_ranks the ranks of the inputs
+/// \param[in] input_shapes the shapes of the inputs
+/// \param[in] output_num the number of outputs, which are in the order of
+/// PD_PredictorGetOutputNames
+/// \param[out] output_data the buffers of the outputs
+/// \param[in] output_bytes the sizes in bytes of the output buffers
+/// \param[out] output_numels the numbers of elements of the outputs, ignored
+/// if it is NULL
+/// \return Whether the function executed successfully
+///
+PADDLE_CAPI_EXPORT extern PD_Bool PD_PredictorRunWithBuffers(
+    __pd_keep PD_Predictor* pd_predictor,
+    size_t input_num,
+    const void* const* input_data,
+    const PD_DataType* input_dtypes,
+    const size_t* input_ranks,
+    const int32_t* const* input_shapes,
+    size_t output_num,
+    void* const* output_data,
+    const size_t* output_bytes,
+    size_t* output_numels);
+
 /// \brief Clear the intermediate tensors of the predictor
 ///
 /// \param[in] pd_predictor predictor
@@ -16,6 +16,8 @@
 
 #include <cstdint>
 #include <cstdio>
+#include <memory>
+#include <vector>
 
 #include "paddle/fluid/inference/api/paddle_inference_api.h"
 #include "paddle/fluid/inference/capi_exp/pd_common.h"
@@ -26,4 +28,8 @@ typedef struct PD_Tensor {
 
 typedef struct PD_Predictor {
   std::shared_ptr<paddle_infer::Predictor> predictor;
+  // The handles cached by PD_PredictorRunWithBuffers, in the order of the
+  // input and output names, destroyed before the predictor.
+  std::vector<std::unique_ptr<paddle_infer::Tensor>> input_handles;
+  std::vector<std::unique_ptr<paddle_infer::Tensor>> output_handles;
 } PD_Predictor;
@@ -31,8 +31,8 @@ ov::Shape OpenVINOEngine::GetOuputShape(const std::string& output_name,
                                         int64_t index) {
   auto ov_output_shape =
       HaveOutputTensorName(output_name)
-          ? infer_request_.get_tensor(output_name).get_shape()
-          : infer_request_.get_output_tensor(index).get_shape();
+          ? infer_request().get_tensor(output_name).get_shape()
+          : infer_request().get_output_tensor(index).get_shape();
   return ov_output_shape;
 }
 
@@ -41,8 +41,8 @@ phi::DataType OpenVINOEngine::GetOuputType(const std::string& output_name,
                                            ov::element::Type ov_paddle_type) {
   auto output_ov_type =
       HaveOutputTensorName(output_name)
-          ? infer_request_.get_tensor(output_name).get_element_type()
-          : infer_request_.get_output_tensor(index).get_element_type();
+          ? infer_request().get_tensor(output_name).get_element_type()
+          : infer_request().get_output_tensor(index).get_element_type();
   PADDLE_ENFORCE_EQ(
       output_ov_type == ov_paddle_type,
       true,
@@ -60,14 +60,26 @@ void OpenVINOEngine::CopyOuputDataByName(const std::string& output_name,
                                          int64_t index,
                                          void* pd_data) {
   auto ov_tensor = HaveOutputTensorName(output_name)
-                       ? infer_request_.get_tensor(output_name)
-                       : infer_request_.get_output_tensor(index);
+                       ? infer_request().get_tensor(output_name)
+                       : infer_request().get_output_tensor(index);
   std::memcpy(pd_data, ov_tensor.data(), ov_tensor.get_byte_size());
 }
 
+ov::InferRequest OpenVINOEngine::infer_request() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = infer_requests_.find(std::this_thread::get_id());
+  if (it == infer_requests_.end()) {
+    it = infer_requests_
+             .emplace(std::this_thread::get_id(),
+                      complied_model_.create_infer_request())
+             .first;
+  }
+  return it->second;
+}
+
 void OpenVINOEngine::Execute() {
   try {
-    infer_request_.infer();
+    infer_request().infer();
   } catch (const std::exception& exp) {
     LOG(ERROR) << exp.what();
   }
@@ -105,13 +117,16 @@ void OpenVINOEngine::BuildEngine() {
   core_ = ov::Core();
   core_.set_property(
       ov::inference_num_threads(params_.cpu_math_library_num_threads));
-  core_.set_property(ov::cache_dir(params_.model_opt_cache_dir));
+  // The compiled blob is loaded from the cache dir when the model is seen
+  // again, which skips the compilation.
+  if (!params_.model_opt_cache_dir.empty()) {
+    core_.set_property(ov::cache_dir(params_.model_opt_cache_dir));
+  }
   core_.set_property(ov::hint::inference_precision(
       PhiType2OVType(static_cast<phi::DataType>(params_.inference_precision))));
   model_ =
       core_.read_model(params_.model_program_path, params_.model_params_path);
   complied_model_ = core_.compile_model(model_, "CPU");
-  infer_request_ = complied_model_.create_infer_request();
 }
 
 }  // namespace paddle::inference::openvino
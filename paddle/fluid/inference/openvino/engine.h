@@ -19,6 +19,7 @@ limitations under the License. */
 #include <memory>
 #include <mutex>  // NOLINT
 #include <string>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -173,7 +174,9 @@ class OpenVINOEngine {
 
   ov::Model* model() { return model_.get(); }
   ov::CompiledModel compiled_model() { return complied_model_; }
-  ov::InferRequest infer_request() { return infer_request_; }
+  // Every thread running the engine, e.g. every cloned predictor, gets its own
+  // infer request of the shared compiled model.
+  ov::InferRequest infer_request();
   ov::Shape GetOuputShape(const std::string& name, int64_t index);
   phi::DataType GetOuputType(const std::string& name,
                              int64_t index,
@@ -192,7 +195,7 @@ class OpenVINOEngine {
   ov::Core core_;
   std::shared_ptr<ov::Model> model_;
   ov::CompiledModel complied_model_;
-  ov::InferRequest infer_request_;
+  std::unordered_map<std::thread::id, ov::InferRequest> infer_requests_;
   std::mutex mutex_;
 
  public:
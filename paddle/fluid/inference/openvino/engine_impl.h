@@ -54,12 +54,14 @@ void OpenVINOEngine::BindingInput(const std::string& input_name,
   }
 
   try {
-    auto requestTensor = infer_request_.get_tensor(input_name);
-    requestTensor.set_shape(data_shape);
-    auto input_shape = requestTensor.get_shape();
-    std::memcpy(
-        requestTensor.data(), static_cast<void*>(data), data_num * sizeof(T));
-    infer_request_.set_tensor(input_name, requestTensor);
+    // Wrap the paddle buffer without a copy, it outlives the infer call.
+    ov::Tensor input_tensor(ov_type, data_shape, static_cast<void*>(data));
+    auto request = infer_request();
+    if (HaveInputTensorName(input_name)) {
+      request.set_tensor(input_name, input_tensor);
+    } else {
+      request.set_input_tensor(index, input_tensor);
+    }
   } catch (const std::exception& exp) {
     LOG(ERROR) << exp.what();
   }
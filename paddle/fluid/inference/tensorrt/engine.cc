@@ -15,6 +15,7 @@ limitations under the License. */
 #include "paddle/fluid/inference/tensorrt/engine.h"
 #include <NvInfer.h>
 #include <glog/logging.h>
+#include <algorithm>
 #include <string>
 
 #include "NvInferRuntimeCommon.h"
@@ -134,7 +135,20 @@ void TensorRTEngine::Execute(int batch_size,
   }
 
   // TODO(wilber): Is cudaGraph has conflict with memory sharing?
-  if (startup_with_cudagraph_ && !cudagraph_inited_) {
+  if (startup_with_cudagraph_) {
+    if (!cuda_graph_pool_) {
+      cuda_graph_pool_ = std::make_unique<TrtCudaGraphPool>(
+          std::max(FLAGS_trt_cuda_graph_pool_size, 1));
+    }
+    auto key = CudaGraphKey(infer_context, *buffers);
+    auto *cuda_graph = cuda_graph_pool_->Get(key);
+    if (cuda_graph != nullptr) {
+      VLOG(1) << "cuda_graph init success, so we will use cuda graph launch "
+                 "the entire graph.";
+      cuda_graph->Launch(stream);
+      return;
+    }
+
     // Avoid capturing initialization calls by executing the enqueue function at
     // least once before starting CUDA graph capture.
     const auto ret = Enqueue(infer_context, buffers, batch_size, stream);
@@ -144,40 +158,60 @@ void TensorRTEngine::Execute(int batch_size,
         common::errors::PreconditionNotMet("Trt CudaGraph test run failed."));
     cudaStreamSynchronize(stream);
 
-    cuda_graph_.BeginCapture(stream);
+    auto new_cuda_graph = std::make_unique<TrtCudaGraph>();
+    new_cuda_graph->BeginCapture(stream);
     // The built TRT engine may contain operations that are not permitted under
     // CUDA graph capture mode. When the stream is capturing, the call may
     // return false if the current CUDA graph capture fails.
     if (Enqueue(infer_context, buffers, batch_size, stream)) {
-      cuda_graph_.EndCapture(stream);
-      cudagraph_inited_ = true;
-    } else {
-      cuda_graph_.EndCaptureOnError(stream);
-      // Ensure any CUDA error has been cleaned up.
-      PADDLE_ENFORCE_GPU_SUCCESS(cudaGetLastError());
-      LOG(WARNING) << "The built TensorRT engine contains operations that are "
-                      "not permitted under "
-                      "CUDA graph capture mode. The specified UseCudaGraph "
-                      "flag has been ignored. The inference will be "
-                      "launched without using CUDA graph launch.";
-      cudagraph_inited_ = false;
+      new_cuda_graph->EndCapture(stream);
+      VLOG(1) << "Captured a cuda graph of the TensorRT engine, the pool has "
+              << cuda_graph_pool_->size() + 1 << " graph(s).";
+      cuda_graph_pool_->Put(key, std::move(new_cuda_graph));
+      // The enqueue during the capture does not run, the outputs are
+      // computed by the warm up one.
+      return;
     }
+    new_cuda_graph->EndCaptureOnError(stream);
+    // Ensure any CUDA error has been cleaned up.
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaGetLastError());
+    LOG(WARNING) << "The built TensorRT engine contains operations that are "
+                    "not permitted under "
+                    "CUDA graph capture mode. The specified UseCudaGraph "
+                    "flag has been ignored. The inference will be "
+                    "launched without using CUDA graph launch.";
+    cuda_graph_pool_.reset();
     startup_with_cudagraph_ = false;
   }
 
   Enqueue(infer_context, buffers, batch_size, stream);
 }
 
+TrtCudaGraphPool::Key TensorRTEngine::CudaGraphKey(
+    nvinfer1::IExecutionContext *context,
+    const std::vector<void *> &buffers) const {
+  TrtCudaGraphPool::Key key;
+  key.push_back(reinterpret_cast<int64_t>(context));
+  for (size_t j = 0; j < buffers.size(); ++j) {
+    key.push_back(reinterpret_cast<int64_t>(buffers[j]));
+#if IS_TRT_VERSION_GE(8500)
+    auto dims = context->getTensorShape(
+        context->getEngine().getIOTensorName(static_cast<int>(j)));
+#else
+    auto dims = context->getBindingDimensions(static_cast<int>(j));
+#endif
+    key.push_back(dims.nbDims);
+    for (int i = 0; i < dims.nbDims; ++i) {
+      key.push_back(dims.d[i]);
+    }
+  }
+  return key;
+}
+
 bool TensorRTEngine::Enqueue(nvinfer1::IExecutionContext *context,
                              std::vector<void *> *buffers,
                              int batch_size,
                              cudaStream_t stream) {
-  if (cudagraph_inited_) {
-    VLOG(1) << "cuda_graph init success, so we will use cuda graph launch the "
-               "entire graph.";
-    return cuda_graph_.Launch(stream);
-  }
-
 #if IS_TRT_VERSION_GE(8500)
   for (size_t j = 0; j < buffers->size(); ++j) {
     auto name = context->getEngine().getIOTensorName(j);
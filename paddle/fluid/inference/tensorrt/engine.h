@@ -15,6 +15,7 @@ limitations under the License. */
 #pragma once
 
 #include <cstdint>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>  // NOLINT
@@ -40,6 +41,7 @@ limitations under the License. */
 #include "paddle/phi/core/stream.h"
 
 COMMON_DECLARE_bool(trt_ibuilder_cache);
+COMMON_DECLARE_int32(trt_cuda_graph_pool_size);
 
 namespace paddle {
 namespace inference {
@@ -109,6 +111,54 @@ class TrtCudaGraph {
   cudaGraphExec_t cuda_graph_exec_{};
 };
 
+// The captured cuda graphs of one engine. The graph bakes the shapes and the
+// addresses of the bindings in, so it is keyed by both of them and only
+// replayed for the exact same inputs. The least recently used graph is
+// released when the size of the pool exceeds the capacity.
+class TrtCudaGraphPool {
+ public:
+  using Key = std::vector<int64_t>;
+
+  explicit TrtCudaGraphPool(size_t capacity) : capacity_(capacity) {}
+
+  TrtCudaGraph* Get(const Key& key) {
+    auto iter = index_.find(key);
+    if (iter == index_.end()) {
+      return nullptr;
+    }
+    graphs_.splice(graphs_.begin(), graphs_, iter->second);
+    return iter->second->second.get();
+  }
+
+  void Put(const Key& key, std::unique_ptr<TrtCudaGraph> graph) {
+    graphs_.emplace_front(key, std::move(graph));
+    index_[key] = graphs_.begin();
+    while (graphs_.size() > capacity_) {
+      index_.erase(graphs_.back().first);
+      graphs_.pop_back();
+    }
+  }
+
+  size_t size() const { return graphs_.size(); }
+
+ private:
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      size_t seed = key.size();
+      for (auto v : key) {
+        seed ^= std::hash<int64_t>()(v) + 0x9e3779b9 + (seed << 6) +
+                (seed >> 2);
+      }
+      return seed;
+    }
+  };
+  using Entry = std::pair<Key, std::unique_ptr<TrtCudaGraph>>;
+
+  size_t capacity_;
+  std::list<Entry> graphs_;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+};
+
 /*
  * TensorRT Engine.
  *
@@ -527,6 +577,7 @@ class TensorRTEngine {
 #endif
 
   void SetProfileNum(int num) { max_profile_num_ = num; }
+  int GetProfileNum() const { return max_profile_num_; }
 
   void SetScope(const framework::Scope* scope) { scope_ = scope; }
 
@@ -595,8 +646,9 @@ class TensorRTEngine {
   std::unordered_map<nvinfer1::ITensor*, float> quant_dynamic_range_;
 
   // cudagraph related
-  TrtCudaGraph cuda_graph_;
-  bool cudagraph_inited_{false};
+  TrtCudaGraphPool::Key CudaGraphKey(nvinfer1::IExecutionContext* context,
+                                     const std::vector<void*>& buffers) const;
+  std::unique_ptr<TrtCudaGraphPool> cuda_graph_pool_;
   bool startup_with_cudagraph_{false};
 
   // Used for convert weight into Itensor
@@ -332,4 +332,17 @@ TEST_F(TensorRTEngineTest, test_pool2d) {
   ASSERT_EQ(y_cpu[1], 5.0);
 }
 
+TEST(TrtCudaGraphPool, LRU) {
+  TrtCudaGraphPool pool(2);
+  pool.Put({1, 2}, std::make_unique<TrtCudaGraph>());
+  pool.Put({1, 3}, std::make_unique<TrtCudaGraph>());
+  ASSERT_NE(pool.Get({1, 2}), nullptr);
+  // {1, 3} is the least recently used one.
+  pool.Put({1, 4}, std::make_unique<TrtCudaGraph>());
+  ASSERT_EQ(pool.size(), 2UL);
+  ASSERT_NE(pool.Get({1, 2}), nullptr);
+  ASSERT_EQ(pool.Get({1, 3}), nullptr);
+  ASSERT_NE(pool.Get({1, 4}), nullptr);
+}
+
 }  // namespace paddle::inference::tensorrt
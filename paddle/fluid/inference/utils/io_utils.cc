@@ -345,5 +345,34 @@ void UpdateShapeRangeInfo(
   inference::SerializeShapeRangeInfo(path, shape_range_infos);
 }
 
+void SerializeActivationAmax(const std::string &path,
+                             const std::map<std::string, float> &amax) {
+  std::ofstream fout(path);
+  PADDLE_ENFORCE_EQ(
+      fout.is_open(),
+      true,
+      common::errors::Unavailable("Cannot open %s to write", path));
+  fout.precision(9);
+  for (auto const &it : amax) {
+    fout << it.first << " " << it.second << "\n";
+  }
+  fout.close();
+}
+
+void DeserializeActivationAmax(const std::string &path,
+                               std::map<std::string, float> *amax) {
+  std::ifstream fin(path);
+  PADDLE_ENFORCE_EQ(
+      fin.is_open(),
+      true,
+      common::errors::NotFound("File [%s] is not found.", path));
+  std::string name;
+  float value;
+  while (fin >> name >> value) {
+    (*amax)[name] = value;
+  }
+  fin.close();
+}
+
 }  // namespace inference
 }  // namespace paddle
@@ -70,5 +70,11 @@ TEST_API void UpdateShapeRangeInfo(
     const std::map<std::string, std::vector<int32_t>>& opt_value,
     const std::vector<std::string>& names,
     const std::vector<std::string>& tensor_names);
+
+// The absolute maximum of the tensors, one "name amax" pair per line.
+TEST_API void SerializeActivationAmax(const std::string& path,
+                                      const std::map<std::string, float>& amax);
+TEST_API void DeserializeActivationAmax(const std::string& path,
+                                        std::map<std::string, float>* amax);
 }  // namespace inference
 }  // namespace paddle
@@ -16,6 +16,7 @@
 #include "paddle/fluid/jit/engine/interpreter_engine.h"
 
 #include "paddle/fluid/framework/new_executor/interpretercore.h"
+#include "paddle/fluid/pir/dialect/kernel/ir/kernel_dialect.h"
 #include "paddle/fluid/pir/transforms/pd_op_to_kernel_pass.h"
 #include "paddle/phi/core/enforce.h"
 #include "paddle/pir/include/core/program.h"
@@ -24,6 +25,17 @@
 namespace paddle {
 namespace jit {
 
+namespace {
+bool IsLoweredToKernel(const pir::Program &program) {
+  for (auto &op : *program.block()) {
+    if (op.dialect()->name() == paddle::dialect::KernelDialect::name()) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
 PirInterpreterEngine::PirInterpreterEngine(
     const std::shared_ptr<PirFunctionInfo> &info,
     const std::shared_ptr<VariableMap> &params_dict,
@@ -35,6 +47,11 @@ PirInterpreterEngine::PirInterpreterEngine(
                     common::errors::PreconditionNotMet(
                         "There is no operator in ProgramDesc."));
   utils::ShareParamsIntoScope(info_->ParamNames(), params_dict_, &scope_);
+  // Lower the program once here instead of at every call, the clones reuse
+  // the lowered program.
+  if (!IsLoweredToKernel(*prog_)) {
+    prog_ = paddle::dialect::PdOpLowerToKernelPass(prog_.get(), place_);
+  }
   CreateInterpreterCore();
 }
 
@@ -60,7 +77,6 @@ std::vector<Tensor> PirInterpreterEngine::operator()(
 
 std::vector<DenseTensor> PirInterpreterEngine::operator()(
     const std::vector<DenseTensor> &inputs) {
-  prog_ = paddle::dialect::PdOpLowerToKernelPass(prog_.get(), place_);
   utils::ShareIntoScope(info_->InputArgNames(), inputs, &scope_);
 
   // the latter can be moved to python side.
@@ -15,7 +15,9 @@
 #pragma once
 
 #ifdef PADDLE_WITH_CUDA
+#include <chrono>  // NOLINT
 #include <cstdint>
+#include <future>  // NOLINT
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -24,6 +26,7 @@
 #include <vector>
 
 #include "paddle/common/errors.h"
+#include "paddle/common/flags.h"
 #include "paddle/fluid/framework/data_device_transform.h"
 #include "paddle/fluid/framework/executor.h"
 #include "paddle/fluid/framework/op_registry.h"
@@ -44,6 +47,8 @@
 #include "paddle/phi/kernels/funcs/data_type_transform.h"
 #include "paddle/utils/string/string_helper.h"
 
+COMMON_DECLARE_bool(trt_async_engine_build);
+
 namespace paddle {
 namespace inference {
 namespace tensorrt {
@@ -175,6 +180,11 @@ class TensorRTEngineOp : public framework::OperatorBase {
   std::string model_opt_cache_dir_;
   bool use_static_engine_;
   phi::DataType precision_mode_;
+  // The rebuilding of the engine in background, the sub block runs natively
+  // until it finishes.
+  mutable std::future<void> rebuild_future_;
+  mutable const framework::Scope *native_parent_scope_{nullptr};
+  mutable framework::Scope *native_scope_{nullptr};
 
  public:
   TensorRTEngineOp(const std::string &type,
@@ -236,6 +246,12 @@ class TensorRTEngineOp : public framework::OperatorBase {
     }
   }
 
+  ~TensorRTEngineOp() override {
+    if (rebuild_future_.valid()) {
+      rebuild_future_.wait();
+    }
+  }
+
   void PrepareTRTEngine(const framework::Scope &scope,
                         TensorRTEngine *engine) const {
     LOG(INFO) << "Prepare TRT engine (Optimize model structure, Select OP "
@@ -264,12 +280,72 @@ class TensorRTEngineOp : public framework::OperatorBase {
     executor.RunPreparedContext(ctx.get(), &current_scope, false, true, true);
   }
 
+  // Runs the sub block while the engine is rebuilt in background, the local
+  // scope is reused to avoid creating a new one for every run.
+  void RunNativeFallback(const framework::Scope &scope,
+                         const phi::Place &dev_place) const {
+    if (native_parent_scope_ != &scope) {
+      native_parent_scope_ = &scope;
+      native_scope_ = &scope.NewScope();
+    }
+    framework::Executor executor(dev_place);
+    auto *block = Attr<framework::BlockDesc *>("sub_block");
+    auto ctx = executor.Prepare(*block->Program(), block->ID());
+    executor.RunPreparedContext(ctx.get(), native_scope_, false, true, true);
+  }
+
+  void RebuildTRTEngine(const framework::Scope &scope,
+                        TensorRTEngine *trt_engine,
+                        const std::vector<std::string> &shape_changed_name,
+                        const std::vector<std::string> &tensor_changed_name)
+      const {
+    PrepareTRTEngine(scope, trt_engine);
+    // update shape_range_info_pbtxt
+    if (!shape_range_info_path_.empty()) {
+      inference::UpdateShapeRangeInfo(shape_range_info_path_,
+                                      trt_engine->min_input_shape(),
+                                      trt_engine->max_input_shape(),
+                                      trt_engine->optim_input_shape(),
+                                      trt_engine->min_shape_tensor(),
+                                      trt_engine->max_shape_tensor(),
+                                      trt_engine->optim_shape_tensor(),
+                                      shape_changed_name,
+                                      tensor_changed_name);
+    }
+
+    if (use_static_engine_) {
+      nvinfer1::IHostMemory *serialized_engine_data = trt_engine->Serialize();
+      std::string trt_engine_serialized_data =
+          std::string((const char *)serialized_engine_data->data(),
+                      serialized_engine_data->size());
+      inference::analysis::SaveTrtEngineSerializedDataToFile(
+          inference::analysis::GetTrtEngineSerializedPath(model_opt_cache_dir_,
+                                                          engine_key_),
+          trt_engine_serialized_data);
+      LOG(INFO) << "Save TRT Optimized Info to "
+                << inference::analysis::GetTrtEngineSerializedPath(
+                       model_opt_cache_dir_, engine_key_);
+    }
+  }
+
   void RunImpl(const framework::Scope &scope,
                const phi::Place &dev_place) const override {
     if (calibration_mode_ == true) {
       RunCalibration(scope, dev_place);
       return;
     }
+    if (rebuild_future_.valid()) {
+      if (rebuild_future_.wait_for(std::chrono::seconds(0)) !=
+          std::future_status::ready) {
+        VLOG(4) << "The TRT engine is being rebuilt, run the sub block.";
+        RunNativeFallback(scope, dev_place);
+        return;
+      }
+      // Rethrows the error of the rebuilding if any.
+      rebuild_future_.get();
+      LOG(INFO) << "The TRT engine has been rebuilt in background, switch to "
+                   "it.";
+    }
     auto *trt_engine = GetEngine(scope, dev_place);
     if (trt_engine->with_dynamic_shape()) {
       // get runtime input shapes and shape tensors.
@@ -399,34 +475,23 @@ class TensorRTEngineOp : public framework::OperatorBase {
           if (anc == nullptr) {
             anc = &scope;
           }
-          PrepareTRTEngine(*anc, trt_engine);
-          // update shape_range_info_pbtxt
-          if (!shape_range_info_path_.empty()) {
-            inference::UpdateShapeRangeInfo(shape_range_info_path_,
-                                            trt_engine->min_input_shape(),
-                                            trt_engine->max_input_shape(),
-                                            trt_engine->optim_input_shape(),
-                                            trt_engine->min_shape_tensor(),
-                                            trt_engine->max_shape_tensor(),
-                                            trt_engine->optim_shape_tensor(),
-                                            shape_changed_name,
-                                            tensor_changed_name);
-          }
-
-          if (use_static_engine_) {
-            nvinfer1::IHostMemory *serialized_engine_data =
-                trt_engine->Serialize();
-            std::string trt_engine_serialized_data =
-                std::string((const char *)serialized_engine_data->data(),
-                            serialized_engine_data->size());
-            inference::analysis::SaveTrtEngineSerializedDataToFile(
-                inference::analysis::GetTrtEngineSerializedPath(
-                    model_opt_cache_dir_, engine_key_),
-                trt_engine_serialized_data);
-            LOG(INFO) << "Save TRT Optimized Info to "
-                      << inference::analysis::GetTrtEngineSerializedPath(
-                             model_opt_cache_dir_, engine_key_);
+          if (FLAGS_trt_async_engine_build) {
+            LOG(INFO) << "Rebuild the trt engine in background, the sub block "
+                         "runs natively in the meantime.";
+            auto rebuild = [this,
+                            anc,
+                            trt_engine,
+                            shape_changed_name,
+                            tensor_changed_name]() {
+              RebuildTRTEngine(
+                  *anc, trt_engine, shape_changed_name, tensor_changed_name);
+            };
+            rebuild_future_ = std::async(std::launch::async, rebuild);
+            RunNativeFallback(scope, dev_place);
+            return;
           }
+          RebuildTRTEngine(
+              *anc, trt_engine, shape_changed_name, tensor_changed_name);
         }
       }
     }
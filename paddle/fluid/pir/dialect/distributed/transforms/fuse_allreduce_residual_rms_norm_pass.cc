@@ -0,0 +1,144 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/pir/dialect/distributed/transforms/fuse_allreduce_residual_rms_norm_pass.h"
+
+#include <string>
+
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/drr/include/drr_pattern_base.h"
+#include "paddle/fluid/pir/utils/general_functions.h"
+#include "paddle/phi/common/reduce_type.h"
+
+#include "paddle/pir/include/pass/pass.h"
+#include "paddle/pir/include/pass/pass_registry.h"
+
+namespace {
+// all_reduce(x) + rms_norm(residual) -> fused_allreduce_residual_rms_norm
+//
+//      x
+//      |
+// all_reduce      residual    w
+//      |-------------|--------|
+//   rms_norm
+//      |-------------|
+//     out      residual_out
+class FusedAllReduceResidualRmsNormPattern
+    : public paddle::drr::DrrPatternBase {
+ private:
+  const std::string all_reduce_name_;
+  const bool has_reduce_type_;
+
+ public:
+  FusedAllReduceResidualRmsNormPattern(const std::string &all_reduce_name,
+                                       bool has_reduce_type)
+      : all_reduce_name_(all_reduce_name),
+        has_reduce_type_(has_reduce_type) {}
+
+  std::string name() const override {
+    return "FusedAllReduceResidualRmsNormPattern";
+  }
+
+  void operator()(paddle::drr::DrrPatternContext *ctx) const override {
+    paddle::drr::SourcePattern pat = ctx->SourcePattern();
+
+    const auto &all_reduce =
+        has_reduce_type_
+            ? pat.Op(all_reduce_name_,
+                     {{"ring_id", pat.Attr("ring_id")},
+                      {"reduce_type", pat.Attr("reduce_type")}})
+            : pat.Op(all_reduce_name_, {{"ring_id", pat.Attr("ring_id")}});
+    const auto &rms_norm =
+        pat.Op(paddle::dialect::RmsNormOp::name(),
+               {
+                   {"epsilon", pat.Attr("epsilon")},
+                   {"begin_norm_axis", pat.Attr("begin_norm_axis")},
+                   {"quant_scale", pat.Attr("quant_scale")},
+               });
+
+    pat.Tensor("reduced") = all_reduce(pat.Tensor("x"));
+    rms_norm({&pat.Tensor("reduced"),
+              &pat.InputNoneTensor(),
+              &pat.Tensor("residual"),
+              &pat.Tensor("w"),
+              &pat.InputNoneTensor()},
+             {&pat.Tensor("out"),
+              &pat.Tensor("residual_out"),
+              &pat.Tensor("inv_var")});
+
+    pat.AddConstraint([this](const paddle::drr::MatchContext &match_ctx) {
+      if (this->has_reduce_type_ &&
+          match_ctx.Attr<int>("reduce_type") !=
+              static_cast<int>(phi::ReduceType::kRedSum)) {
+        return false;
+      }
+      if (match_ctx.Attr<float>("quant_scale") > 0.0f) {
+        return false;
+      }
+      if (match_ctx.Tensor("reduced").use_count() != 1 ||
+          match_ctx.Tensor("inv_var").use_count() != 0) {
+        return false;
+      }
+      auto x_type = pir::GetDataTypeFromValue(match_ctx.Tensor("x"));
+      return x_type.isa<pir::Float32Type>() || x_type.isa<pir::Float16Type>() ||
+             x_type.isa<pir::BFloat16Type>();
+    });
+
+    paddle::drr::ResultPattern res = pat.ResultPattern();
+    const auto &fused_op =
+        res.Op(paddle::dialect::FusedAllreduceResidualRmsNormOp::name(),
+               {{"ring_id", pat.Attr("ring_id")},
+                {"epsilon", pat.Attr("epsilon")},
+                {"begin_norm_axis", pat.Attr("begin_norm_axis")},
+                {"chunk_rows", res.Int32Attr(0)}});
+    fused_op({&res.Tensor("x"),
+              &res.Tensor("residual"),
+              &res.Tensor("w"),
+              &res.InputNoneTensor()},
+             {&res.Tensor("out"), &res.Tensor("residual_out")});
+  }
+};
+
+class FuseAllreduceResidualRmsNormPass : public pir::PatternRewritePass {
+ public:
+  FuseAllreduceResidualRmsNormPass()
+      : pir::PatternRewritePass("fuse_allreduce_residual_rms_norm_pass", 2) {}
+
+  pir::RewritePatternSet InitializePatterns(pir::IrContext *context) override {
+    pir::RewritePatternSet ps(context);
+    ps.Add(paddle::drr::Create<FusedAllReduceResidualRmsNormPattern>(
+        context, paddle::dialect::AllReduceOp::name(), true));
+    ps.Add(paddle::drr::Create<FusedAllReduceResidualRmsNormPattern>(
+        context, paddle::dialect::AllReduce_Op::name(), true));
+    ps.Add(paddle::drr::Create<FusedAllReduceResidualRmsNormPattern>(
+        context, paddle::dialect::MpAllreduceSumOp::name(), false));
+    ps.Add(paddle::drr::Create<FusedAllReduceResidualRmsNormPattern>(
+        context, paddle::dialect::MpAllreduceSum_Op::name(), false));
+
+    return ps;
+  }
+};
+
+}  // namespace
+
+namespace pir {
+
+std::unique_ptr<Pass> CreateFuseAllreduceResidualRmsNormPass() {
+  return std::make_unique<FuseAllreduceResidualRmsNormPass>();
+}
+
+}  // namespace pir
+
+REGISTER_IR_PASS(fuse_allreduce_residual_rms_norm_pass,
+                 FuseAllreduceResidualRmsNormPass);
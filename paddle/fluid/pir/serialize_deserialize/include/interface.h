@@ -13,7 +13,9 @@
 // limitations under the License.
 #pragma once
 
+#include <future>
 #include <string>
+#include <vector>
 #include "paddle/phi/core/dense_tensor.h"
 #include "paddle/pir/include/core/dll_decl.h"
 #include "paddle/pir/include/core/program.h"
@@ -32,6 +34,9 @@ namespace pir {
  * @param[in] trainable    (Optional parameter, default to true) If true,
  * operation has opresult_attrs for training like stop_gradient,persistable;
  * Otherwise, it may only has opinfo attrs.
+ * @param[in] binary       (Optional parameter, default to false) If true, the
+ * program is saved as the MessagePack of its json, which is smaller and faster
+ * to load, and readable is ignored.
  *
  * @return void。
  *
@@ -43,7 +48,8 @@ void IR_API WriteModule(const pir::Program& program,
                         uint64_t pir_version,
                         bool overwrite,
                         bool readable = false,
-                        bool trainable = true);
+                        bool trainable = true,
+                        bool binary = false);
 
 /**
  * @brief Gets a PIR program from the specified file path.
@@ -59,7 +65,8 @@ void IR_API WriteModule(const pir::Program& program,
  * funtune.
  *
  * @note If 'pir_version' is larger than the version of file, will trigger
- * version compatibility modification rule.
+ * version compatibility modification rule. Both the json and the binary
+ * programs are read, the file is memory-mapped where supported.
  */
 bool IR_API ReadModule(const std::string& file_path,
                        pir::Program* program,
@@ -111,6 +118,35 @@ void IR_API SaveCombineFunction(const std::vector<const phi::DenseTensor*>& x,
                                 bool save_as_fp16,
                                 bool save_to_memory);
 
+/**
+ * @brief Save the given tensor list into a combined file like
+ * SaveCombineFunction, without blocking on the file. The tensors are copied
+ * into a staging snapshot (pinned memory for the gpu ones) before returning,
+ * so they can be updated right after. The snapshot is serialized by several
+ * threads and written to the file in the background.
+ *
+ * @param[in] x                 The tensor list to be saved.
+ * @param[in] names             The names of the tensors.
+ * @param[in] file_path         The path of the file to be written.
+ * @param[in] overwrite         If the file already exists, this flag determines
+ *                              whether to overwrite the existing file.
+ * @param[in] save_as_fp16      If the flag is true, the tensor will be saved as
+ * fp16 type.
+ * @param[in] num_threads       The threads to serialize the snapshot, 0 for
+ * the hardware concurrency.
+ *
+ * @return std::future<void>. It is ready when the file is written, and
+ * rethrows the error of writing.
+ *
+ */
+std::future<void> IR_API
+SaveCombineFunctionAsync(const std::vector<const phi::DenseTensor*>& x,
+                         const std::vector<std::string>& names,
+                         const std::string& file_path,
+                         bool overwrite,
+                         bool save_as_fp16,
+                         size_t num_threads = 0);
+
 /**
  * @brief Save the given tensor into a single file at the specified file path
  * with its name.
@@ -132,6 +168,30 @@ void IR_API LoadFunction(const std::string& file_path,
                          phi::DenseTensor* out,
                          phi::Place place = phi::Place());
 
+/**
+ * @brief Load a box of the tensor saved by SaveFunction, e.g. the part of a
+ * saved shard which overlaps the shard of the current placement. Only the byte
+ * ranges of the box are read, by the runs contiguous in the file.
+ *
+ * @param[in] file_path         The path of the file to be read.
+ * @param[in] storage_shape     The shape of the saved tensor.
+ * @param[in] slice_offset      The offset of the box in the saved tensor.
+ * @param[in] slice_shape       The shape of the box.
+ * @param[in] load_as_fp16      If the flag is true, the tensor will be loaded
+ * as fp16 type.
+ * @param[out] out              The tensor to be loaded.
+ *
+ * @return void。
+ *
+ */
+void IR_API LoadSliceFunction(const std::string& file_path,
+                              const std::vector<int64_t>& storage_shape,
+                              const std::vector<int64_t>& slice_offset,
+                              const std::vector<int64_t>& slice_shape,
+                              bool load_as_fp16,
+                              phi::DenseTensor* out,
+                              phi::Place place = phi::Place());
+
 /**
  * @brief Save the given tensor into a single file at the specified file path
  * with its name.
@@ -150,4 +210,26 @@ void IR_API LoadCombineFunction(const std::string& file_path,
                                 std::vector<phi::DenseTensor*>* out,
                                 bool load_as_fp16,
                                 phi::Place place = phi::Place());
+
+/**
+ * @brief Load the tensors saved by SaveCombineFunction from a memory mapped
+ * file. The file is mapped copy-on-write, CPU tensors aligned to their
+ * element size alias the mapping instead of being copied, so processes
+ * loading the same file share its page cache. Falls back to
+ * LoadCombineFunction on Windows.
+ *
+ * @param[in] file_path         The path of the file to be read.
+ * @param[in] names             The names of the tensors.
+ * @param[out] out              The tensor to be loaded.
+ * @param[in] load_as_fp16      If the flag is true, the tensor will be loaded
+ * as fp16 type.
+ *
+ * @return void。
+ *
+ */
+void IR_API LoadCombineFunctionWithMmap(const std::string& file_path,
+                                        const std::vector<std::string>& names,
+                                        std::vector<phi::DenseTensor*>* out,
+                                        bool load_as_fp16,
+                                        phi::Place place = phi::Place());
 }  // namespace pir
@@ -14,6 +14,16 @@
 
 #include "paddle/fluid/pir/serialize_deserialize/include/interface.h"
 #include <stdio.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
 #include "paddle/common/enforce.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/ir_deserialize.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/ir_serialize.h"
@@ -26,12 +36,71 @@ namespace pir {
 #define PIRVERSION "version"
 #define TRAINABLE "trainable"
 #define PIR "pir"
+
+namespace {
+// The binary program is the MessagePack of the json program after the magic.
+constexpr char kBinaryMagic[] = {'P', 'I', 'R', 'B'};
+
+// The content of the file, mapped into the memory if possible.
+class FileContent {
+ public:
+  explicit FileContent(const std::string& file_path) {
+#ifndef _WIN32
+    int fd = open(file_path.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd >= 0 && fstat(fd, &st) == 0 && st.st_size > 0) {
+      void* addr = mmap(nullptr,
+                        static_cast<size_t>(st.st_size),
+                        PROT_READ,
+                        MAP_PRIVATE,
+                        fd,
+                        0);
+      if (addr != MAP_FAILED) {
+        madvise(addr, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(addr);
+        size_ = static_cast<size_t>(st.st_size);
+        mapped_ = true;
+      }
+    }
+    if (fd >= 0) close(fd);
+    if (mapped_) return;
+#endif
+    std::ifstream f(file_path, std::ios::binary);
+    PADDLE_ENFORCE_EQ(static_cast<bool>(f),
+                      true,
+                      common::errors::Unavailable(
+                          "Cannot open %s to load the program.", file_path));
+    buffer_.assign(std::istreambuf_iterator<char>(f),
+                   std::istreambuf_iterator<char>());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+  }
+
+  ~FileContent() {
+#ifndef _WIN32
+    if (mapped_) munmap(const_cast<char*>(data_), size_);
+#endif
+  }
+
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  const char* data_{nullptr};
+  size_t size_{0};
+  bool mapped_{false};
+  std::vector<char> buffer_;
+};
+
+}  // namespace
+
 void WriteModule(const pir::Program& program,
                  const std::string& file_path,
                  uint64_t pir_version,
                  bool overwrite,
                  bool readable,
-                 bool trainable) {
+                 bool trainable,
+                 bool binary) {
   PADDLE_ENFORCE_EQ(
       FileExists(file_path) && !overwrite,
       false,
@@ -49,28 +118,40 @@ void WriteModule(const pir::Program& program,
   ProgramWriter writer(pir_version, trainable);
   // write program
   total[PROGRAM] = writer.GetProgramJson(&program);
-  std::string total_str;
-  if (readable) {
-    total_str = total.dump(4);
-  } else {
-    total_str = total.dump();
-  }
-
   MkDirRecursively(DirName(file_path).c_str());
   std::ofstream fout(file_path, std::ios::binary);
   PADDLE_ENFORCE_EQ(static_cast<bool>(fout),
                     true,
                     common::errors::Unavailable(
                         "Cannot open %s to save variables.", file_path));
-  fout << total_str;
+  if (binary) {
+    std::vector<uint8_t> total_bytes = Json::to_msgpack(total);
+    fout.write(kBinaryMagic, sizeof(kBinaryMagic));
+    fout.write(reinterpret_cast<const char*>(total_bytes.data()),
+               static_cast<std::streamsize>(total_bytes.size()));
+  } else if (readable) {
+    fout << total.dump(4);
+  } else {
+    fout << total.dump();
+  }
   fout.close();
 }
 
 bool ReadModule(const std::string& file_path,
                 pir::Program* program,
                 int64_t pir_version) {
-  std::ifstream f(file_path);
-  Json data = Json::parse(f);
+  Json data;
+  {
+    FileContent content(file_path);
+    const char* begin = content.data();
+    const char* end = begin + content.size();
+    if (content.size() >= sizeof(kBinaryMagic) &&
+        std::memcmp(begin, kBinaryMagic, sizeof(kBinaryMagic)) == 0) {
+      data = Json::from_msgpack(begin + sizeof(kBinaryMagic), end);
+    } else {
+      data = Json::parse(begin, end);
+    }
+  }
   if (pir_version < 0) {
     pir_version = DEVELOP_VERSION;
     VLOG(6) << "pir_version is null, get pir_version: " << pir_version;
@@ -10,14 +10,25 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <memory>
 #include <numeric>
+#include <sstream>
+#include <thread>
 
 #include "glog/logging.h"
 #include "paddle/fluid/framework/lod_tensor.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/interface.h"
 #include "paddle/phi/common/port.h"
+#include "paddle/phi/core/tensor_utils.h"
+#include "paddle/phi/core/utils/data_type.h"
 #include "paddle/phi/kernels/funcs/data_type_transform.h"
+#ifndef _WIN32
+#include "paddle/phi/core/memory/allocation/mmap_allocator.h"
+#endif
 
 namespace pir {
 
@@ -147,6 +158,97 @@ void SaveCombineFunction(const std::vector<const phi::DenseTensor*>& x,
   VLOG(6) << "save combine done ";
 }
 
+std::future<void> SaveCombineFunctionAsync(
+    const std::vector<const phi::DenseTensor*>& x,
+    const std::vector<std::string>& names,
+    const std::string& file_path,
+    bool overwrite,
+    bool save_as_fp16,
+    size_t num_threads) {
+  PADDLE_ENFORCE_EQ(
+      FileExists(file_path) && !overwrite,
+      false,
+      common::errors::PreconditionNotMet(
+          "%s exists!, cannot save to it when overwrite is set to false.",
+          file_path,
+          overwrite));
+  PADDLE_ENFORCE_GT(x.size(),
+                    0UL,
+                    common::errors::InvalidArgument(
+                        "The number of variables to be saved is %d, expect "
+                        "it to be greater than 0.",
+                        x.size()));
+
+  // snapshot the tensors, the copies from the device are waited once
+  auto snapshot = std::make_shared<std::vector<phi::DenseTensor>>(x.size());
+  std::vector<const phi::DeviceContext*> dev_ctxs;
+  for (size_t i = 0; i < x.size(); i++) {
+    auto& tensor = *(x[i]);
+    PADDLE_ENFORCE_EQ(
+        tensor.IsInitialized(),
+        true,
+        common::errors::InvalidArgument(
+            "The Tensor with Index (%d) to be saved is not initialized.", i));
+    const phi::DeviceContext* dev_ctx = GetDeviceContext(tensor);
+    auto out_dtype = save_as_fp16 ? phi::DataType::FLOAT16 : tensor.dtype();
+    phi::DenseTensor src = tensor.dtype() != out_dtype
+                               ? CastTensorType(dev_ctx, tensor, out_dtype)
+                               : tensor;
+    phi::Place staging = phi::CPUPlace();
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    if (phi::is_gpu_place(src.place())) staging = phi::GPUPinnedPlace();
+#endif
+    phi::Copy(*dev_ctx, src, staging, false, &(*snapshot)[i]);
+    if (std::find(dev_ctxs.begin(), dev_ctxs.end(), dev_ctx) ==
+        dev_ctxs.end()) {
+      dev_ctxs.push_back(dev_ctx);
+    }
+  }
+  for (auto* dev_ctx : dev_ctxs) {
+    dev_ctx->Wait();
+  }
+
+  if (num_threads == 0) {
+    num_threads = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+  num_threads = std::min(num_threads, x.size());
+  return std::async(std::launch::async, [=]() {
+    // each thread serializes a chunk of the consecutive tensors, and the
+    // chunks are written by their order
+    size_t chunk = (snapshot->size() + num_threads - 1) / num_threads;
+    std::vector<std::future<std::string>> chunks;
+    for (size_t begin = 0; begin < snapshot->size(); begin += chunk) {
+      size_t end = std::min(begin + chunk, snapshot->size());
+      chunks.push_back(std::async(std::launch::async, [snapshot, begin, end]() {
+        std::ostringstream os;
+        for (size_t i = begin; i < end; i++) {
+          phi::SerializeToStream(os, (*snapshot)[i]);
+          (*snapshot)[i] = phi::DenseTensor();
+        }
+        return os.str();
+      }));
+    }
+
+    MkDirRecursively(DirName(file_path).c_str());
+    VLOG(6) << "async save func save path: " << file_path;
+    std::ofstream fout(file_path, std::ios::binary);
+    PADDLE_ENFORCE_EQ(static_cast<bool>(fout),
+                      true,
+                      common::errors::Unavailable(
+                          "Cannot open %s to save variables.", file_path));
+    for (auto& serialized : chunks) {
+      std::string bytes = serialized.get();
+      fout.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    fout.close();
+    PADDLE_ENFORCE_EQ(static_cast<bool>(fout),
+                      true,
+                      common::errors::Unavailable(
+                          "Failed to write the variables to %s.", file_path));
+    VLOG(6) << "async save combine done ";
+  });
+}
+
 void LoadFunction(const std::string& file_path,
                   int64_t seek,
                   const std::vector<int64_t>& shape,
@@ -183,6 +285,102 @@ void LoadFunction(const std::string& file_path,
   }
 }
 
+void LoadSliceFunction(const std::string& file_path,
+                       const std::vector<int64_t>& storage_shape,
+                       const std::vector<int64_t>& slice_offset,
+                       const std::vector<int64_t>& slice_shape,
+                       bool load_as_fp16,
+                       phi::DenseTensor* out,
+                       phi::Place place) {
+  const size_t rank = storage_shape.size();
+  PADDLE_ENFORCE_EQ(
+      rank > 0 && slice_offset.size() == rank && slice_shape.size() == rank,
+      true,
+      common::errors::InvalidArgument(
+          "The slice to be loaded should have the rank of the saved tensor."));
+  for (size_t i = 0; i < rank; i++) {
+    PADDLE_ENFORCE_EQ(
+        slice_offset[i] >= 0 && slice_shape[i] > 0 &&
+            slice_offset[i] + slice_shape[i] <= storage_shape[i],
+        true,
+        common::errors::InvalidArgument(
+            "The slice [%d, %d) of axis %d is out of the saved shape %d.",
+            slice_offset[i],
+            slice_offset[i] + slice_shape[i],
+            i,
+            storage_shape[i]));
+  }
+  PADDLE_ENFORCE_NOT_NULL(out,
+                          common::errors::InvalidArgument(
+                              "The variable to be loaded cannot be found."));
+  std::ifstream fin(file_path, std::ios::binary);
+  PADDLE_ENFORCE_EQ(static_cast<bool>(fin),
+                    true,
+                    common::errors::Unavailable(
+                        "Load operator fail to open file %s, please check "
+                        "whether the model file is complete or damaged.",
+                        file_path));
+
+  // the axes after contiguous_axis are whole, so the elements of the box from
+  // contiguous_axis are a run in the file
+  std::vector<int64_t> strides(rank, 1);
+  for (size_t i = rank - 1; i > 0; i--) {
+    strides[i - 1] = strides[i] * storage_shape[i];
+  }
+  size_t contiguous_axis = rank - 1;
+  while (contiguous_axis > 0 && slice_offset[contiguous_axis] == 0 &&
+         slice_shape[contiguous_axis] == storage_shape[contiguous_axis]) {
+    contiguous_axis--;
+  }
+  const int64_t run = slice_shape[contiguous_axis] * strides[contiguous_axis];
+  int64_t num_runs = 1;
+  for (size_t i = 0; i < contiguous_axis; i++) {
+    num_runs *= slice_shape[i];
+  }
+
+  const phi::DeviceContext& cpu_ctx =
+      *phi::DeviceContextPool::Instance().Get(phi::CPUPlace());
+  phi::DenseTensor cpu_out;
+  char* dst = nullptr;
+  size_t run_bytes = 0;
+  std::vector<int64_t> index(contiguous_axis, 0);
+  for (int64_t r = 0; r < num_runs; r++) {
+    int64_t seek = slice_offset[contiguous_axis] * strides[contiguous_axis];
+    for (size_t i = 0; i < contiguous_axis; i++) {
+      seek += (slice_offset[i] + index[i]) * strides[i];
+    }
+    phi::DenseTensor piece;
+    fin.clear();
+    fin.seekg(0);
+    phi::DeserializeFromStream(
+        fin, &piece, cpu_ctx, static_cast<size_t>(seek), {run});
+    if (dst == nullptr) {
+      cpu_out.Resize(common::make_ddim(slice_shape));
+      run_bytes = run * phi::SizeOf(piece.dtype());
+      dst = static_cast<char*>(cpu_ctx.Alloc(&cpu_out, piece.dtype()));
+    }
+    std::memcpy(dst + r * run_bytes, piece.data(), run_bytes);
+    // the next index of the axes before contiguous_axis
+    for (size_t i = contiguous_axis; i > 0; i--) {
+      if (++index[i - 1] < slice_shape[i - 1]) break;
+      index[i - 1] = 0;
+    }
+  }
+
+  const phi::DeviceContext* dev_ctx = GetDeviceContext(*out, place);
+  if (phi::is_cpu_place(dev_ctx->GetPlace())) {
+    *out = cpu_out;
+  } else {
+    phi::Copy(*dev_ctx, cpu_out, dev_ctx->GetPlace(), true, out);
+  }
+  auto in_dtype = out->dtype();
+  auto out_dtype = load_as_fp16 ? phi::DataType::FLOAT16 : in_dtype;
+  if (in_dtype != out_dtype) {
+    auto cast_in = *out;
+    *out = CastTensorType(dev_ctx, cast_in, out_dtype);
+  }
+}
+
 void LoadCombineFunction(const std::string& file_path,
                          const std::vector<std::string>& names,
                          std::vector<phi::DenseTensor*>* out,
@@ -222,4 +420,150 @@ void LoadCombineFunction(const std::string& file_path,
                         "load_combine_op, please use load_op instead."));
 }
 
+#ifndef _WIN32
+namespace {
+
+// Reads the fields written by SerializeToStream from a memory mapped file.
+class MappedFileReader {
+ public:
+  MappedFileReader(const char* data, size_t size, const std::string& file_path)
+      : data_(data), size_(size), file_path_(file_path) {}
+
+  template <typename T>
+  T Read() {
+    T value;
+    std::memcpy(&value, Skip(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  const char* Skip(size_t size) {
+    PADDLE_ENFORCE_LE(size,
+                      size_ - offset_,
+                      common::errors::Unavailable(
+                          "Load operator fail to read file %s, please check "
+                          "whether the model file is complete or damaged.",
+                          file_path_));
+    const char* ptr = data_ + offset_;
+    offset_ += size;
+    return ptr;
+  }
+
+  bool Eof() const { return offset_ == size_; }
+
+ private:
+  const char* data_;
+  size_t size_;
+  size_t offset_{0};
+  const std::string& file_path_;
+};
+
+}  // namespace
+#endif
+
+void LoadCombineFunctionWithMmap(const std::string& file_path,
+                                 const std::vector<std::string>& names,
+                                 std::vector<phi::DenseTensor*>* out,
+                                 bool load_as_fp16,
+                                 phi::Place place) {
+#ifdef _WIN32
+  LoadCombineFunction(file_path, names, out, load_as_fp16, place);
+#else
+  PADDLE_ENFORCE_GT(out->size(),
+                    0UL,
+                    common::errors::InvalidArgument(
+                        "The number of variables to be saved is %d, expect "
+                        "it to be greater than 0.",
+                        out->size()));
+  std::shared_ptr<phi::Allocation> mapping =
+      paddle::memory::allocation::AllocateMemoryMapFileAllocation(file_path);
+  MappedFileReader reader(
+      static_cast<const char*>(mapping->ptr()), mapping->size(), file_path);
+  const phi::DeviceContext* dev_ctx = GetDeviceContext(*(out->at(0)), place);
+  const phi::DeviceContext* cpu_ctx =
+      phi::DeviceContextPool::Instance().Get(phi::CPUPlace());
+  size_t mapped_num = 0;
+  for (size_t i = 0; i < names.size(); i++) {
+    auto tensor = out->at(i);
+    // the version and LoD of DenseTensor
+    PADDLE_ENFORCE_EQ(
+        reader.Read<uint32_t>(),
+        0U,
+        common::errors::InvalidArgument(
+            "Deserialize to tensor failed, maybe the loaded file is "
+            "not a paddle model(expected file format: 0)."));
+    uint64_t lod_level = reader.Read<uint64_t>();
+    auto& lod = *tensor->mutable_lod();
+    lod.resize(lod_level);
+    for (uint64_t j = 0; j < lod_level; ++j) {
+      uint64_t size = reader.Read<uint64_t>();
+      std::vector<size_t> tmp(size / sizeof(size_t));
+      std::memcpy(tmp.data(), reader.Skip(size), size);
+      lod[j] = tmp;
+    }
+
+    // the version and desc of Tensor
+    PADDLE_ENFORCE_EQ(reader.Read<uint32_t>(),
+                      0U,
+                      common::errors::InvalidArgument(
+                          "tensor version is not supported, Only version 0 is "
+                          "supported"));
+    int32_t desc_size = reader.Read<int32_t>();
+    PADDLE_ENFORCE_GE(desc_size,
+                      0,
+                      common::errors::InvalidArgument(
+                          "phi::DenseTensor desc size should >= 0"));
+    paddle::framework::proto::VarType::TensorDesc desc;
+    PADDLE_ENFORCE_EQ(
+        desc.ParseFromArray(reader.Skip(desc_size), desc_size),
+        true,
+        common::errors::InvalidArgument("Cannot parse tensor desc"));
+    std::vector<int64_t> dims(desc.dims().begin(), desc.dims().end());
+    auto dtype = phi::TransToPhiDataType(desc.data_type());
+
+    // The data of a CPU tensor aliases the mapping if it is aligned to its
+    // element size, otherwise it is copied. Tensors on other places are copied
+    // from the mapping directly.
+    phi::DenseTensor cpu_tensor;
+    phi::DenseTensor* target =
+        phi::is_cpu_place(dev_ctx->GetPlace()) ? tensor : &cpu_tensor;
+    target->Resize(common::make_ddim(dims));
+    size_t size = target->numel() * phi::SizeOf(dtype);
+    const char* data = reader.Skip(size);
+    bool aligned = reinterpret_cast<uintptr_t>(data) % phi::SizeOf(dtype) == 0;
+    if (size > 0 && aligned) {
+      target->ResetHolderWithType(
+          std::shared_ptr<phi::Allocation>(
+              new phi::Allocation(
+                  const_cast<char*>(data), size, phi::CPUPlace()),
+              [mapping](phi::Allocation* allocation) { delete allocation; }),
+          dtype);
+      ++mapped_num;
+    } else {
+      void* buf = cpu_ctx->Alloc(target, dtype);
+      std::memcpy(buf, data, size);
+    }
+    if (target != tensor) {
+      phi::Copy(*dev_ctx, cpu_tensor, dev_ctx->GetPlace(), false, tensor);
+      if (phi::is_custom_place(dev_ctx->GetPlace())) {
+        dev_ctx->Wait();
+      }
+    }
+
+    auto in_dtype = tensor->dtype();
+    auto out_dtype = load_as_fp16 ? phi::DataType::FLOAT16 : in_dtype;
+    if (in_dtype != out_dtype) {
+      auto cast_in = *tensor;
+      *tensor = CastTensorType(dev_ctx, cast_in, out_dtype);
+    }
+  }
+  PADDLE_ENFORCE_EQ(reader.Eof(),
+                    true,
+                    common::errors::Unavailable(
+                        "Not allowed to load partial data via "
+                        "load_combine_op, please use load_op instead."));
+  VLOG(4) << "Load " << names.size() << " tensors from memory mapped file "
+          << file_path << ", " << mapped_num << " of them alias the mapping.";
+#endif
+}
+
 }  // namespace pir
@@ -21,6 +21,7 @@
 
 #include "paddle/common/enforce.h"
 #include "paddle/common/errors.h"
+#include "paddle/common/flags.h"
 
 #include "paddle/fluid/framework/convert_utils.h"
 #include "paddle/fluid/framework/operator.h"
@@ -53,6 +54,8 @@
 #include "paddle/pir/include/pattern_rewrite/pattern_match.h"
 #include "paddle/pir/include/pattern_rewrite/pattern_rewrite_driver.h"
 
+COMMON_DECLARE_bool(amp_cast_cost_check);
+
 namespace {
 
 class AutoMixedPrecisionPass : public pir::Pass {
@@ -289,6 +292,91 @@ class AutoMixedPrecisionPass : public pir::Pass {
     } while (precision_updated);
   }
 
+  // Whether the producer or consumer of a float value takes part in the cost
+  // of the casts, and the precision it runs in.
+  bool GetNeighborPrecision(pir::Operation* neighbor, bool* low) const {
+    if (neighbor == nullptr || op_should_not_handle_.count(neighbor)) {
+      return false;
+    }
+    if (IsBuiltinOp(neighbor)) {
+      // The parameters are kept in float32, the other builtin ops follow
+      // their own operands.
+      if (!neighbor->isa<pir::ParameterOp>()) return false;
+      *low = false;
+      return true;
+    }
+    *low = OpRunLowPrecision(neighbor);
+    return true;
+  }
+
+  // Counts the casts around op when it runs in low precision and when it
+  // runs in float32. Every float operand and use of a float result whose
+  // other end runs in the other precision needs one cast.
+  void CountCasts(pir::Operation* op, int* low_casts, int* high_casts) const {
+    *low_casts = 0;
+    *high_casts = 0;
+    bool low = false;
+    for (size_t i = 0; i < op->num_operands(); ++i) {
+      auto operand = op->operand(i);
+      if (!op->operand_source(i) || !IsOperandHasDenseTensorType(operand) ||
+          !IsDenseTensorTypeFloat(
+              operand.type().dyn_cast<paddle::dialect::DenseTensorType>())) {
+        continue;
+      }
+      if (GetNeighborPrecision(op->operand_source(i).defining_op(), &low)) {
+        *(low ? high_casts : low_casts) += 1;
+      }
+    }
+    for (size_t i = 0; i < op->num_results(); ++i) {
+      auto result = op->result(i);
+      if (!result.type() ||
+          !result.type().isa<paddle::dialect::DenseTensorType>() ||
+          !IsDenseTensorTypeFloat(
+              result.type().dyn_cast<paddle::dialect::DenseTensorType>())) {
+        continue;
+      }
+      for (auto it = result.use_begin(); it != result.use_end(); ++it) {
+        if (GetNeighborPrecision(it->owner(), &low)) {
+          *(low ? high_casts : low_casts) += 1;
+        }
+      }
+    }
+  }
+
+  // The ops of the white list run in low precision whatever the casts cost,
+  // the other ops are cheap, so that one of them runs in float32 when it
+  // needs fewer casts there. The ops moved to float32 change the casts of
+  // their neighbors, so the choice is propagated until nothing changes.
+  void ReduceCastOps(pir::Block* block) {
+    bool precision_updated = false;
+    do {
+      precision_updated = false;
+      for (auto& op_item : *block) {
+        auto op = &op_item;
+        if (!OpRunLowPrecision(op) || op_should_not_handle_.count(op) ||
+            IsBuiltinOp(op) || op->num_regions() > 0 ||
+            op->isa<paddle::dialect::FeedOp>() ||
+            op->isa<paddle::dialect::FetchOp>() ||
+            op->isa<paddle::dialect::CastOp>()) {
+          continue;
+        }
+        auto op_name = op->name();
+        if (white_list_.count(op_name.substr(op_name.find(".") + 1))) {
+          continue;
+        }
+        int low_casts = 0;
+        int high_casts = 0;
+        CountCasts(op, &low_casts, &high_casts);
+        if (low_casts > high_casts) {
+          VLOG(4) << "Run " << op_name << " in float32 to save "
+                  << low_casts - high_casts << " casts";
+          op_run_low_precision_.erase(op);
+          precision_updated = true;
+        }
+      }
+    } while (precision_updated);
+  }
+
   void RewriteOp(pir::Operation* op,
                  pir::Builder& builder) {  // NOLINT
     if (IsBuiltinOp(op)) {
@@ -800,6 +888,10 @@ class AutoMixedPrecisionPass : public pir::Pass {
   void SubBlockRun(pir::Block* block) {
     GetOpPrecision(block);
     UpdateOpPrecision(block);
+    if (FLAGS_amp_cast_cost_check) {
+      ReduceCastOps(block);
+      UpdateOpPrecision(block);
+    }
     pir::Builder builder = pir::Builder(context_, block);
     ProcessBlock(block, builder);
     cached_cast_ops_.clear();
@@ -38,6 +38,7 @@
 #include "paddle/pir/include/pass/pass_registry.h"
 
 COMMON_DECLARE_string(ir_inplace_kernel_blacklist);
+COMMON_DECLARE_bool(ir_inplace_buffer_reuse);
 
 namespace {
 
@@ -54,6 +55,36 @@ std::unordered_set<std::string> RelaxShapeCheckOps = {
     paddle::dialect::AddGradOp::name(),
 };
 
+// NOTE: The elementwise ops below have no inplace version, but each element of
+// their outputs only reads the elements of the inputs at the same position, so
+// the output can reuse the buffer of a dead input with the same numel and
+// dtype. The candidate (out_slot, in_slot) pairs are tried in order.
+std::unordered_map<std::string, std::vector<std::pair<uint32_t, uint32_t>>>
+    BufferReuseOps = {
+        {"pd_op.gelu", {{0, 0}}},
+        {"pd_op.silu", {{0, 0}}},
+        {"pd_op.swish", {{0, 0}}},
+        {"pd_op.hardswish", {{0, 0}}},
+        {"pd_op.mish", {{0, 0}}},
+        {"pd_op.softsign", {{0, 0}}},
+        {"pd_op.logsigmoid", {{0, 0}}},
+        {"pd_op.relu6", {{0, 0}}},
+        {"pd_op.softplus", {{0, 0}}},
+        {"pd_op.hardsigmoid", {{0, 0}}},
+        {"pd_op.sign", {{0, 0}}},
+        {"pd_op.softshrink", {{0, 0}}},
+        {"pd_op.hardshrink", {{0, 0}}},
+        {"pd_op.tanh_shrink", {{0, 0}}},
+        {"pd_op.celu", {{0, 0}}},
+        {"pd_op.selu", {{0, 0}}},
+        {"pd_op.stanh", {{0, 0}}},
+        {"pd_op.maximum", {{0, 0}, {0, 1}}},
+        {"pd_op.minimum", {{0, 0}, {0, 1}}},
+        {"pd_op.fmax", {{0, 0}, {0, 1}}},
+        {"pd_op.fmin", {{0, 0}, {0, 1}}},
+        {"pd_op.elementwise_pow", {{0, 0}, {0, 1}}},
+};
+
 // NOTE(zhangbo): Which kind of value can be deleted?
 // (1) Value's type needs to be AllocatedDenseTensorType or
 // AllocatedSelectedRowsType; (2) Value's is not persistable.
@@ -351,7 +382,9 @@ GetEagerDeletionValues(const pir::Block& block,
 
 std::unordered_map<pir::Operation*, std::string> GetInplaceOps(
     const pir::Block& block,
-    const std::set<std::string>& no_need_buffer_values) {
+    const std::set<std::string>& no_need_buffer_values,
+    std::unordered_map<pir::Operation*, std::pair<uint32_t, uint32_t>>*
+        reuse_ops) {
   const auto eager_dels = GetEagerDeletionValues(block, no_need_buffer_values);
 
   auto is_no_need_buffer = [&no_need_buffer_values](pir::Operation* op,
@@ -441,6 +474,19 @@ std::unordered_map<pir::Operation*, std::string> GetInplaceOps(
       continue;
     }
 
+    if (upper_op_attrs.count("reuse_buffer") != 0) {
+      VLOG(6) << upper_op_name << " already reuses the buffer of its input.";
+      auto slots =
+          upper_op_attrs.at("reuse_buffer").dyn_cast<pir::ArrayAttribute>();
+      auto out_slot = slots.at(0).dyn_cast<pir::Int32Attribute>().data();
+      auto in_slot = slots.at(1).dyn_cast<pir::Int32Attribute>().data();
+      inplace_map[op.result(out_slot)] = op.operand_source(in_slot);
+      for (auto& result : op.results()) {
+        visited_values.insert(result);
+      }
+      continue;
+    }
+
     pir::OpInfo upper_inplace_op_info =
         pir::IrContext::Instance()->GetRegisteredOpInfo(upper_op_name + "_");
 
@@ -462,6 +508,40 @@ std::unordered_map<pir::Operation*, std::string> GetInplaceOps(
       }
       continue;
     }
+
+    if (FLAGS_ir_inplace_buffer_reuse && eager_dels.count(&op) != 0 &&
+        !upper_inplace_op_info && BufferReuseOps.count(upper_op_name)) {
+      const auto used_external_values = GetUsedExternalValue(block);
+      auto is_external = [&used_external_values](pir::Value value) {
+        return std::find(used_external_values.begin(),
+                         used_external_values.end(),
+                         value) != used_external_values.end();
+      };
+      for (auto [out_slot, in_slot] : BufferReuseOps.at(upper_op_name)) {
+        if ((in_slot < op.num_operands()) && (out_slot < op.num_results()) &&
+            CanDoInplace(eager_dels.at(&op),
+                         op.operand_source(in_slot),
+                         op.result(out_slot),
+                         upper_op_name) &&
+            (visited_values.count(op.result(out_slot)) == 0) &&
+            CanBeDeleted(op.result(out_slot)) &&
+            IsLastUser(
+                op.operand_source(in_slot), use_count_map, inplace_map) &&
+            !is_external(op.operand_source(in_slot)) &&
+            !is_external(op.result(out_slot))) {
+          (*reuse_ops)[&op] = {out_slot, in_slot};
+          inplace_map[op.result(out_slot)] = op.operand_source(in_slot);
+          VLOG(6) << upper_op_name << " result " << out_slot
+                  << " will reuse the buffer of operand " << in_slot;
+          break;
+        }
+      }
+      for (auto& result : op.results()) {
+        visited_values.insert(result);
+      }
+      continue;
+    }
+
     if (eager_dels.count(&op) == 0 || (!upper_inplace_op_info) ||
         upper_op_name == "pd_op.transpose") {
       // NOTE(wanghuancoder): pd_op.transpose is not an
@@ -568,7 +648,10 @@ class InplacePass : public pir::Pass {
     for (size_t i = 0; i < op->num_regions(); ++i) {
       auto& region = op->region(i);
       for (auto& block : region) {
-        auto inplace_ops = GetInplaceOps(block, no_need_buffer_values_);
+        std::unordered_map<pir::Operation*, std::pair<uint32_t, uint32_t>>
+            reuse_ops;
+        auto inplace_ops =
+            GetInplaceOps(block, no_need_buffer_values_, &reuse_ops);
 
         for (const auto& kv : inplace_ops) {
           VLOG(6) << "Do inplace for: "
@@ -592,6 +675,19 @@ class InplacePass : public pir::Pass {
               pir::BoolAttribute::get(pir::IrContext::Instance(), true));
           num_rewrites_++;
         }
+
+        // The ops without inplace version keep their names, the executor
+        // shares the buffer of the input to the output before the kernel runs.
+        for (const auto& [reuse_op, slots] : reuse_ops) {
+          pir::IrContext* ctx = pir::IrContext::Instance();
+          reuse_op->set_attribute(
+              "reuse_buffer",
+              pir::ArrayAttribute::get(
+                  ctx,
+                  {pir::Int32Attribute::get(ctx, slots.first),
+                   pir::Int32Attribute::get(ctx, slots.second)}));
+          num_rewrites_++;
+        }
       }
     }
     AddStatistics(num_rewrites_);
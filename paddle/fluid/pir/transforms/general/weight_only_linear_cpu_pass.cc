@@ -0,0 +1,223 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/pir/transforms/general/weight_only_linear_cpu_pass.h"
+
+#include <utility>
+
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/drr/include/drr_pattern_base.h"
+#include "paddle/fluid/pir/utils/general_functions.h"
+#include "paddle/phi/common/place.h"
+
+#include "paddle/pir/include/pass/pass.h"
+#include "paddle/pir/include/pass/pass_registry.h"
+
+namespace {
+
+// The arch of the weight layout of the cpu weight-only kernels.
+constexpr int kCpuArch = 0;
+
+// matmul(x, weight_dequantize(quanted_w, w_scale)) [+ bias], or
+// matmul(x, w) [+ bias] of the persistable w when algo_ is set, is replaced
+// by weight_only_linear on cpu.
+class WeightOnlyLinearCpuPattern : public paddle::drr::DrrPatternBase {
+ private:
+  bool with_bias_;
+  bool reverse_add_;
+  // quantizes the float weight with it, or matches the dequantized weight
+  // if empty
+  std::string algo_;
+
+ public:
+  WeightOnlyLinearCpuPattern(bool with_bias,
+                             bool reverse_add,
+                             std::string algo)
+      : with_bias_(with_bias),
+        reverse_add_(reverse_add),
+        algo_(std::move(algo)) {}
+
+  std::string name() const override { return "WeightOnlyLinearCpuPattern"; }
+
+  uint32_t benefit() const override { return with_bias_ ? 2 : 1; }
+
+  void operator()(paddle::drr::DrrPatternContext *ctx) const override {
+    //
+    // Source Pattern.
+    //
+    paddle::drr::SourcePattern src = ctx->SourcePattern();
+    if (algo_.empty()) {
+      const auto &weight_dequantize =
+          src.Op(paddle::dialect::WeightDequantizeOp::name(),
+                 {{"algo", src.Attr("algo")},
+                  {"out_dtype", src.Attr("out_dtype")},
+                  {"group_size", src.Attr("group_size")}});
+      src.Tensor("w") =
+          weight_dequantize(src.Tensor("quanted_w"), src.Tensor("w_scale"));
+    }
+    const auto &matmul =
+        src.Op(paddle::dialect::MatmulOp::name(),
+               {{"transpose_x", src.Attr("matmul_transpose_x")},
+                {"transpose_y", src.Attr("matmul_transpose_y")}});
+    src.Tensor("matmul_out") = matmul(src.Tensor("x"), src.Tensor("w"));
+    if (with_bias_) {
+      const auto &add = src.Op(paddle::dialect::AddOp::name());
+      src.Tensor("add_out") =
+          reverse_add_ ? add(src.Tensor("matmul_out"), src.Tensor("bias"))
+                       : add(src.Tensor("bias"), src.Tensor("matmul_out"));
+    }
+
+    //
+    // Constraints.
+    //
+    src.AddConstraint([algo = algo_, with_bias = with_bias_](
+                          const paddle::drr::MatchContext &match_ctx) {
+      if (match_ctx.Attr<bool>("matmul_transpose_x") ||
+          match_ctx.Attr<bool>("matmul_transpose_y")) {
+        return false;
+      }
+      if (algo.empty()) {
+        auto dequant_algo = match_ctx.Attr<std::string>("algo");
+        if (dequant_algo != "weight_only_int8" &&
+            dequant_algo != "weight_only_int4") {
+          return false;
+        }
+      } else {
+        if (!pir::ValueIsPersistable(match_ctx.Tensor("w"))) {
+          return false;
+        }
+        auto w_dtype = pir::GetDataTypeFromValue(match_ctx.Tensor("w"));
+        if (!w_dtype.isa<pir::Float32Type>() &&
+            !w_dtype.isa<pir::Float16Type>() &&
+            !w_dtype.isa<pir::BFloat16Type>()) {
+          return false;
+        }
+      }
+
+      auto w_dims = pir::GetShapeFromValue(match_ctx.Tensor("w"));
+      auto x_dims = pir::GetShapeFromValue(match_ctx.Tensor("x"));
+      if (!(w_dims.size() == 2 && x_dims.size() >= 2)) {
+        return false;
+      }
+      if (w_dims.at(0) % 64 != 0 || w_dims.at(1) % 16 != 0) return false;
+      if (x_dims.at(x_dims.size() - 1) != w_dims.at(0)) return false;
+      if (with_bias) {
+        auto bias_dims = pir::GetShapeFromValue(match_ctx.Tensor("bias"));
+        if (bias_dims.size() != 1 || bias_dims.at(0) != w_dims.at(1)) {
+          return false;
+        }
+      }
+      return true;
+    });
+
+    //
+    // Result Pattern.
+    //
+    paddle::drr::ResultPattern res = src.ResultPattern();
+    if (!algo_.empty()) {
+      const auto &weight_quantize =
+          res.Op(paddle::dialect::WeightQuantizeOp::name(),
+                 {{"algo", res.StrAttr(algo_)},
+                  {"arch", res.Int32Attr(kCpuArch)},
+                  {"group_size", res.Int32Attr(-1)}});
+      weight_quantize({&res.Tensor("w")},
+                      {&res.Tensor("quanted_w"), &res.Tensor("w_scale")});
+    }
+    const auto &weight_dtype = res.ComputeAttr(
+        [algo = algo_](
+            const paddle::drr::MatchContext &match_ctx) -> std::string {
+          auto weight_algo =
+              algo.empty() ? match_ctx.Attr<std::string>("algo") : algo;
+          return weight_algo == "weight_only_int4" ? "int4" : "int8";
+        });
+    const auto &group_size = res.ComputeAttr(
+        [algo = algo_](const paddle::drr::MatchContext &match_ctx) -> int {
+          return algo.empty() ? match_ctx.Attr<int>("group_size") : -1;
+        });
+    const auto &weight_only_linear =
+        res.Op(paddle::dialect::WeightOnlyLinearOp::name(),
+               {{"weight_dtype", weight_dtype},
+                {"arch", res.Int32Attr(kCpuArch)},
+                {"group_size", group_size}});
+    weight_only_linear(
+        {&res.Tensor("x"),
+         &res.Tensor("quanted_w"),
+         with_bias_ ? &res.Tensor("bias") : &res.InputNoneTensor(),
+         &res.Tensor("w_scale")},
+        {&res.Tensor(with_bias_ ? "add_out" : "matmul_out")});
+  }
+};
+
+class WeightOnlyLinearCpuPass : public pir::PatternRewritePass {
+ public:
+  WeightOnlyLinearCpuPass()
+      : pir::PatternRewritePass("weight_only_linear_cpu_pass", 2) {}
+
+  pir::RewritePatternSet InitializePatterns(pir::IrContext *context) override {
+    // The float weights are quantized only if the algo is set, since it
+    // changes the precision.
+    std::string algo;
+    if (Has("weight_only_algo")) {
+      algo = Get<std::string>("weight_only_algo");
+      PADDLE_ENFORCE_EQ(
+          algo == "weight_only_int8" || algo == "weight_only_int4",
+          true,
+          common::errors::InvalidArgument(
+              "weight_only_linear_cpu_pass only support weight_only_int8 or "
+              "weight_only_int4, but get %s.",
+              algo));
+    }
+
+    pir::RewritePatternSet ps(context);
+    auto add_patterns = [&](const std::string &pattern_algo) {
+      ps.Add(paddle::drr::Create<WeightOnlyLinearCpuPattern>(
+          context, true, true, pattern_algo));
+      ps.Add(paddle::drr::Create<WeightOnlyLinearCpuPattern>(
+          context, true, false, pattern_algo));
+      ps.Add(paddle::drr::Create<WeightOnlyLinearCpuPattern>(
+          context, false, false, pattern_algo));
+    };
+    add_patterns("");
+    if (!algo.empty()) {
+      add_patterns(algo);
+    }
+    return ps;
+  }
+
+  pir::GreedyRewriteConfig InitializeConfig() override {
+    pir::GreedyRewriteConfig config;
+    // the patterns with bias run before the ones without it
+    config.use_top_down_traversal = false;
+    config.max_iterations = 10;
+    return config;
+  }
+
+  bool CanApplyOn(pir::Operation *op) const override {
+    if (Has(pir::Pass::kPlaceAttr) &&
+        !phi::is_cpu_place(Get<phi::Place>(pir::Pass::kPlaceAttr))) {
+      return false;
+    }
+    return op->num_regions() > 0;
+  }
+};
+
+}  // namespace
+
+namespace pir {
+std::unique_ptr<Pass> CreateWeightOnlyLinearCpuPass() {
+  return std::make_unique<WeightOnlyLinearCpuPass>();
+}
+}  // namespace pir
+
+REGISTER_IR_PASS(weight_only_linear_cpu_pass, WeightOnlyLinearCpuPass);
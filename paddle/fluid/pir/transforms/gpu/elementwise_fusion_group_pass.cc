@@ -0,0 +1,348 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/pir/transforms/gpu/elementwise_fusion_group_pass.h"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "paddle/fluid/framework/ir/fusion_group/code_generator.h"
+#include "paddle/fluid/framework/ir/fusion_group/operation.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_type.h"
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/dialect/operator/utils/utils.h"
+#include "paddle/phi/backends/device_code.h"
+#include "paddle/phi/backends/gpu/gpu_info.h"
+#include "paddle/phi/core/utils/data_type.h"
+
+#include "paddle/pir/include/core/builder.h"
+#include "paddle/pir/include/core/builtin_op.h"
+#include "paddle/pir/include/core/ir_context.h"
+#include "paddle/pir/include/core/operation.h"
+#include "paddle/pir/include/core/program.h"
+#include "paddle/pir/include/core/region.h"
+#include "paddle/pir/include/core/value.h"
+#include "paddle/pir/include/pass/pass.h"
+#include "paddle/pir/include/pass/pass_registry.h"
+
+namespace {
+
+namespace fusion_group = paddle::framework::ir::fusion_group;
+
+// The pd_op elementwise operations and their names in the OperationMap of
+// fusion_group.
+const std::unordered_map<std::string, std::string>& SupportedOps() {
+  static const std::unordered_map<std::string, std::string> ops = {
+      {paddle::dialect::AddOp::name(), "elementwise_add"},
+      {paddle::dialect::SubtractOp::name(), "elementwise_sub"},
+      {paddle::dialect::MultiplyOp::name(), "elementwise_mul"},
+      {paddle::dialect::DivideOp::name(), "elementwise_div"},
+      {paddle::dialect::MinimumOp::name(), "elementwise_min"},
+      {paddle::dialect::MaximumOp::name(), "elementwise_max"},
+      {paddle::dialect::ReluOp::name(), "relu"},
+      {paddle::dialect::SigmoidOp::name(), "sigmoid"},
+      {paddle::dialect::TanhOp::name(), "tanh"},
+      {paddle::dialect::SqrtOp::name(), "sqrt"},
+      {paddle::dialect::SquareOp::name(), "square"},
+  };
+  return ops;
+}
+
+std::string CudaType(phi::DataType dtype) {
+  switch (dtype) {
+    case phi::DataType::FLOAT32:
+      return "float";
+    case phi::DataType::FLOAT64:
+      return "double";
+    case phi::DataType::FLOAT16:
+      return "__half";
+    default:
+      return "";
+  }
+}
+
+// The generated kernel is 1-D and indexes all its arguments with the same
+// offset, so all the values of a group have the same static shape and dtype.
+struct TensorSignature {
+  common::DDim dims;
+  phi::DataType dtype{phi::DataType::UNDEFINED};
+
+  bool operator==(const TensorSignature& other) const {
+    return dims == other.dims && dtype == other.dtype;
+  }
+};
+
+bool GetSignature(pir::Value value, TensorSignature* signature) {
+  if (!value || !value.type() ||
+      !value.type().isa<paddle::dialect::DenseTensorType>()) {
+    return false;
+  }
+  auto type = value.type().dyn_cast<paddle::dialect::DenseTensorType>();
+  if (common::contain_unknown_dim(type.dims()) || type.dims().size() == 0) {
+    return false;
+  }
+  signature->dims = type.dims();
+  signature->dtype = paddle::dialect::TransToPhiDataType(type.dtype());
+  return !CudaType(signature->dtype).empty();
+}
+
+bool IsFusible(pir::Operation* op, TensorSignature* signature) {
+  if (SupportedOps().count(op->name()) == 0 || op->num_results() != 1 ||
+      !GetSignature(op->result(0), signature)) {
+    return false;
+  }
+  for (size_t i = 0; i < op->num_operands(); ++i) {
+    TensorSignature operand;
+    if (!GetSignature(op->operand_source(i), &operand) ||
+        !(operand == *signature)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The kernels compiled in this process, keyed by their generated code, so
+// that the repeated layers of a model share one compilation. The code which
+// failed to compile is kept too, so that it is not compiled again.
+class CompiledCodeCache {
+ public:
+  static CompiledCodeCache& Instance() {
+    static CompiledCodeCache cache;
+    return cache;
+  }
+
+  // Returns the name of the compiled kernel, or an empty string when the code
+  // could not be compiled.
+  std::string GetOrCompile(
+      const phi::GPUPlace& place,
+      const std::vector<fusion_group::OperationExpression>& expressions) {
+    fusion_group::CodeGenerator code_generator;
+    std::string key = std::to_string(place.GetDeviceId()) + "\n" +
+                      code_generator.Generate("fused_kernel", expressions);
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = func_names_.find(key);
+    if (it != func_names_.end()) {
+      VLOG(4) << "Reuse the compiled kernel " << it->second;
+      return it->second;
+    }
+
+    phi::DeviceCodePool& pool = phi::DeviceCodePool::Init({place});
+    std::string func_name =
+        "fused_elementwise_pir_" + std::to_string(pool.size(place));
+    std::string code_str = code_generator.Generate(func_name, expressions);
+    VLOG(4) << code_str;
+    std::unique_ptr<phi::GPUDeviceCode> device_code(
+        new phi::GPUDeviceCode(place, func_name, code_str));
+    if (device_code->Compile()) {
+      pool.Set(std::move(device_code));
+    } else {
+      LOG(WARNING) << "Failed to compile " << func_name
+                   << ", the elementwise group is not fused.";
+      func_name.clear();
+    }
+    func_names_[key] = func_name;
+    return func_name;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::string> func_names_;
+};
+
+class ElementwiseFusionGroupPass : public pir::Pass {
+ public:
+  ElementwiseFusionGroupPass()
+      : pir::Pass("elementwise_fusion_group_pass", 2) {}
+
+  bool Initialize(pir::IrContext* context) override {
+    fusion_group::OperationMap::Init();
+    return true;
+  }
+
+  void Run(pir::Operation* op) override {
+    place_ = phi::GPUPlace(phi::backends::gpu::GetCurrentDeviceId());
+    int num_groups = 0;
+    for (size_t i = 0; i < op->num_regions(); ++i) {
+      for (auto& block : op->region(i)) {
+        num_groups += FuseBlock(&block);
+      }
+    }
+    AddStatistics(num_groups);
+  }
+
+  bool CanApplyOn(pir::Operation* op) const override {
+    return op->isa<pir::ModuleOp>() && op->num_regions() > 0;
+  }
+
+ private:
+  // Groups the ops of the block in their order. A fusible op joins the open
+  // group when it uses a value of the group, and the group is closed once
+  // another op uses one of its values, so that the fused op can take the
+  // place of the last op of the group.
+  int FuseBlock(pir::Block* block) {
+    std::vector<std::vector<pir::Operation*>> groups;
+    std::vector<pir::Operation*> group;
+    std::unordered_set<pir::Operation*> group_set;
+    TensorSignature group_signature;
+    auto close_group = [&]() {
+      if (group.size() >= 2) {
+        groups.push_back(group);
+      }
+      group.clear();
+      group_set.clear();
+    };
+
+    for (auto& op : *block) {
+      bool uses_group = false;
+      for (size_t i = 0; i < op.num_operands(); ++i) {
+        pir::Value operand = op.operand_source(i);
+        if (operand && operand.defining_op() &&
+            group_set.count(operand.defining_op())) {
+          uses_group = true;
+        }
+      }
+      TensorSignature signature;
+      if (!IsFusible(&op, &signature)) {
+        if (uses_group) {
+          close_group();
+        }
+        continue;
+      }
+      if (!uses_group || !(signature == group_signature)) {
+        close_group();
+        group_signature = signature;
+      }
+      group.push_back(&op);
+      group_set.insert(&op);
+    }
+    close_group();
+
+    int num_fused = 0;
+    for (auto& ops : groups) {
+      num_fused += FuseGroup(ops) ? 1 : 0;
+    }
+    return num_fused;
+  }
+
+  bool FuseGroup(const std::vector<pir::Operation*>& ops) {
+    std::unordered_set<pir::Operation*> op_set(ops.begin(), ops.end());
+    std::unordered_map<pir::Value, int> var_ids;
+    std::vector<pir::Value> inputs;
+    std::vector<pir::Value> outputs;
+
+    // The inputs take the first ids and the outputs follow in the program
+    // order, which is the order of the arguments of the generated kernel.
+    for (auto* op : ops) {
+      for (size_t i = 0; i < op->num_operands(); ++i) {
+        pir::Value operand = op->operand_source(i);
+        if (op_set.count(operand.defining_op()) == 0 &&
+            var_ids.count(operand) == 0) {
+          var_ids[operand] = static_cast<int>(inputs.size());
+          inputs.push_back(operand);
+        }
+      }
+    }
+    std::vector<fusion_group::OperationExpression> expressions;
+    for (auto* op : ops) {
+      pir::Value result = op->result(0);
+      int id = static_cast<int>(var_ids.size());
+      var_ids[result] = id;
+
+      bool used_outside = false;
+      for (auto it = result.use_begin(); it != result.use_end(); ++it) {
+        if (op_set.count(it->owner()) == 0) {
+          used_outside = true;
+        }
+      }
+      std::vector<int> intermediate_ids;
+      if (used_outside) {
+        outputs.push_back(result);
+      } else {
+        intermediate_ids.push_back(id);
+      }
+
+      std::vector<int> input_ids;
+      for (size_t i = 0; i < op->num_operands(); ++i) {
+        input_ids.push_back(var_ids.at(op->operand_source(i)));
+      }
+      TensorSignature signature;
+      GetSignature(result, &signature);
+      std::string dtype = CudaType(signature.dtype);
+      expressions.emplace_back(SupportedOps().at(op->name()),
+                               input_ids,
+                               std::vector<int>{id},
+                               dtype,
+                               dtype,
+                               intermediate_ids);
+    }
+    if (outputs.empty()) {
+      return false;
+    }
+
+    std::string func_name =
+        CompiledCodeCache::Instance().GetOrCompile(place_, expressions);
+    if (func_name.empty()) {
+      return false;
+    }
+
+    auto to_proto_dtypes = [](const std::vector<pir::Value>& values) {
+      std::vector<int> dtypes;
+      for (auto value : values) {
+        TensorSignature signature;
+        GetSignature(value, &signature);
+        dtypes.push_back(
+            static_cast<int>(phi::TransToProtoVarType(signature.dtype)));
+      }
+      return dtypes;
+    };
+
+    pir::Builder builder(pir::IrContext::Instance(), ops.back()->GetParent());
+    builder.set_insertion_point(ops.back());
+    auto combine_op = builder.Build<pir::CombineOp>(inputs);
+    auto fusion_group_op =
+        builder.Build<paddle::dialect::FusionGroupOp>(combine_op.out(),
+                                                      to_proto_dtypes(outputs),
+                                                      to_proto_dtypes(inputs),
+                                                      func_name,
+                                                      0);
+    auto split_op = builder.Build<pir::SplitOp>(fusion_group_op.result(0));
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      outputs[i].ReplaceAllUsesWith(split_op.result(i));
+    }
+    for (auto it = ops.rbegin(); it != ops.rend(); ++it) {
+      (*it)->Erase();
+    }
+    VLOG(4) << "elementwise_fusion_group_pass fused " << ops.size()
+            << " ops into " << func_name;
+    return true;
+  }
+
+  phi::GPUPlace place_;
+};
+
+}  // namespace
+
+namespace pir {
+
+std::unique_ptr<Pass> CreateElementwiseFusionGroupPass() {
+  return std::make_unique<ElementwiseFusionGroupPass>();
+}
+
+}  // namespace pir
+
+REGISTER_IR_PASS(elementwise_fusion_group_pass, ElementwiseFusionGroupPass);
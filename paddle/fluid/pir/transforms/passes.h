@@ -22,8 +22,10 @@ USE_PIR_PASS(transpose_flatten_concat_fuse_pass);
 USE_PIR_PASS(fused_gemm_epilogue_pass);
 USE_PIR_PASS(fused_dropout_add_pass);
 USE_PIR_PASS(fused_weight_only_linear_pass);
+USE_PIR_PASS(weight_only_linear_cpu_pass);
 USE_PIR_PASS(fused_linear_param_grad_add_pass);
 USE_PIR_PASS(fuse_allreduce_split_to_reducescatter_pass);
+USE_PIR_PASS(fuse_allreduce_residual_rms_norm_pass);
 USE_PIR_PASS(inplace_pass);
 USE_PIR_PASS(replace_fetch_with_shadow_output_pass);
 USE_PIR_PASS(identity_op_clean_pass);
@@ -104,6 +106,10 @@ USE_PIR_PASS(conv2d_add_xpu_fuse_pass);
 USE_PIR_PASS(fc_xpu_fuse_pass);
 #endif
 
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+USE_PIR_PASS(elementwise_fusion_group_pass);
+#endif
+
 #ifdef PADDLE_WITH_CINN
 USE_PIR_PASS(convert_MEA_to_FA);
 #endif
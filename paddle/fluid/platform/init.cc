@@ -11,11 +11,14 @@ distributed under the License is distributed on an "AS IS" BASIS,
 WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License. */
+#include <chrono>
 #include <csignal>
 #include <fstream>
 #include <string>
 
 #include "paddle/phi/backends/cpu/cpu_info.h"
+#include "paddle/phi/backends/dynload/dynamic_loader.h"
+#include "paddle/phi/core/kernel_factory.h"
 #include "paddle/phi/core/platform/cpu_helper.h"
 #include "paddle/utils/string/split.h"
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
@@ -68,6 +71,7 @@ limitations under the License. */
 #endif
 
 COMMON_DECLARE_int32(paddle_num_threads);
+COMMON_DECLARE_bool(report_startup_time);
 COMMON_DECLARE_int32(multiple_of_cupti_buffer_size);
 
 namespace paddle::framework {
@@ -160,10 +164,26 @@ void LoadCustomDevice(const std::string &library_dir) {
 }
 #endif
 
+static void ReportStartupTime(double init_devices_ms) {
+  size_t num_kernels = 0;
+  const auto &kernels = phi::KernelFactory::Instance().kernels();
+  for (const auto &kernel : kernels) {
+    num_kernels += kernel.second.size();
+  }
+  LOG(INFO) << "[Startup] InitDevices: " << init_devices_ms << " ms, "
+            << kernels.size() << " ops with " << num_kernels
+            << " registered kernels";
+  for (const auto &record : phi::dynload::GetDsoLoadRecords()) {
+    LOG(INFO) << "[Startup] Load " << record.name << ": " << record.elapsed_ms
+              << " ms" << (record.loaded ? "" : " (not found)");
+  }
+}
+
 static std::once_flag init_devices_flag;
 
 void InitDevices() {
   std::call_once(init_devices_flag, []() {
+    auto start = std::chrono::steady_clock::now();
     // set name at the entry point of Paddle
     phi::SetCurrentThreadName("MainThread");
 // CUPTI attribute should be set before any CUDA context is created (see CUPTI
@@ -199,6 +219,11 @@ void InitDevices() {
     }
 #endif
     InitDevices(devices);
+    if (FLAGS_report_startup_time) {
+      std::chrono::duration<double, std::milli> elapsed =
+          std::chrono::steady_clock::now() - start;
+      ReportStartupTime(elapsed.count());
+    }
   });
 }
 
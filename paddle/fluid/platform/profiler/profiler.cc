@@ -180,4 +180,74 @@ std::unique_ptr<ProfilerResult> Profiler::Stop() {
   return std::unique_ptr<ProfilerResult>(profiler_result_ptr);
 }
 
+SamplingProfiler::SamplingProfiler(const SamplingProfilerOptions& options)
+    : options_(options) {
+  PADDLE_ENFORCE_GT(options_.sample_every,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The sample_every of SamplingProfiler should be "
+                        "positive."));
+  PADDLE_ENFORCE_EQ(
+      options_.format == "json" || options_.format == "pb",
+      true,
+      common::errors::InvalidArgument(
+          "The format of SamplingProfiler should be json or pb, but got %s.",
+          options_.format));
+}
+
+SamplingProfiler::~SamplingProfiler() {
+  if (profiler_) {
+    profiler_->Stop();
+  }
+}
+
+bool SamplingProfiler::StepBegin() {
+  if (num_steps_++ % options_.sample_every != 0) {
+    return false;
+  }
+  profiler_ = Profiler::Create(options_.profiler_options);
+  if (!profiler_) {
+    VLOG(3) << "SamplingProfiler skips the step " << num_steps_ - 1
+            << " for another profiler is alive";
+    return false;
+  }
+  profiler_->Prepare();
+  profiler_->Start();
+  return true;
+}
+
+void SamplingProfiler::StepEnd() {
+  if (!profiler_) {
+    return;
+  }
+  std::unique_ptr<ProfilerResult> result = profiler_->Stop();
+  profiler_.reset();
+  ++num_sampled_steps_;
+  if (!options_.output_dir.empty()) {
+    std::string file_name = options_.output_dir + "/sample_" +
+                            std::to_string(num_steps_ - 1) + "." +
+                            options_.format;
+    result->Save(file_name, options_.format);
+    VLOG(3) << "SamplingProfiler saves a sample to " << file_name;
+  }
+  if (options_.max_samples == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (samples_.size() == options_.max_samples) {
+    samples_.pop_front();
+  }
+  samples_.push_back(std::move(result));
+}
+
+std::vector<std::unique_ptr<ProfilerResult>> SamplingProfiler::TakeSamples() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<std::unique_ptr<ProfilerResult>> samples;
+  for (auto& sample : samples_) {
+    samples.push_back(std::move(sample));
+  }
+  samples_.clear();
+  return samples;
+}
+
 }  // namespace paddle::platform
@@ -17,9 +17,13 @@
 #include <atomic>
 #include <bitset>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <list>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include "paddle/common/macros.h"
 #include "paddle/fluid/platform/profiler/event_node.h"
@@ -98,5 +102,53 @@ class Profiler {
   CpuUtilization cpu_utilization_;
 };
 
+struct SamplingProfilerOptions {
+  ProfilerOptions profiler_options;
+  // trace one of every sample_every steps
+  uint32_t sample_every = 100;
+  // keep the results of the latest max_samples sampled steps in memory
+  size_t max_samples = 4;
+  // save each sampled step to output_dir/sample_<step>.<format> if not empty,
+  // the format is json for chrome tracing or pb
+  std::string output_dir;
+  std::string format = "json";
+};
+
+// Always-on profiling of the serving by sampling: the tracers only run in one
+// of every sample_every steps, the other steps cost a counter. The results of
+// the sampled steps are kept in a bounded ring and optionally saved to files.
+// StepBegin and StepEnd are called by the thread driving the steps, while
+// TakeSamples can be called by any thread.
+class SamplingProfiler {
+ public:
+  explicit SamplingProfiler(const SamplingProfilerOptions& options);
+
+  DISABLE_COPY_AND_ASSIGN(SamplingProfiler);
+
+  ~SamplingProfiler();
+
+  // Return whether the step is sampled. A step is skipped if another profiler
+  // is alive.
+  bool StepBegin();
+
+  void StepEnd();
+
+  uint64_t num_steps() const { return num_steps_; }
+
+  uint64_t num_sampled_steps() const { return num_sampled_steps_; }
+
+  // Take the kept results, the oldest first.
+  std::vector<std::unique_ptr<ProfilerResult>> TakeSamples();
+
+ private:
+  SamplingProfilerOptions options_;
+  uint64_t num_steps_ = 0;
+  uint64_t num_sampled_steps_ = 0;
+  std::unique_ptr<Profiler> profiler_;
+
+  std::mutex mutex_;
+  std::deque<std::unique_ptr<ProfilerResult>> samples_;
+};
+
 }  // namespace platform
 }  // namespace paddle
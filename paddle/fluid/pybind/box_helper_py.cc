@@ -106,6 +106,12 @@ void BindBoxWrapper(py::module* m) {
       .def("init_afs_api",
            &framework::BoxWrapper::InitAfsAPI,
            py::call_guard<py::gil_scoped_release>())
+      .def("preopen_afs_files",
+           &framework::BoxWrapper::PreOpenAfsFiles,
+           py::call_guard<py::gil_scoped_release>())
+      .def("get_afs_read_stats",
+           &framework::BoxWrapper::GetAfsReadStats,
+           py::call_guard<py::gil_scoped_release>())
       .def("finalize",
            &framework::BoxWrapper::Finalize,
            py::call_guard<py::gil_scoped_release>());
@@ -119,7 +119,56 @@ void BindTCPStore(py::module *m) {
                         py::call_guard<py::gil_scoped_release>())
                    .def("wait",
                         &phi::distributed::Store::wait,
-                        py::call_guard<py::gil_scoped_release>());
+                        py::call_guard<py::gil_scoped_release>())
+                   .def(
+                       "multi_get",
+                       [](phi::distributed::Store &self,
+                          const std::vector<std::string> &keys) {
+                         auto values = self.multi_get(keys);
+                         py::gil_scoped_acquire acquire;
+                         std::vector<py::bytes> res;
+                         for (auto &value : values) {
+                           res.emplace_back(
+                               std::string(value.begin(), value.end()));
+                         }
+                         return res;
+                       },
+                       py::arg("keys"),
+                       py::call_guard<py::gil_scoped_release>())
+                   .def(
+                       "multi_set",
+                       [](phi::distributed::Store &self,
+                          const std::vector<std::string> &keys,
+                          const std::vector<std::string> &values) {
+                         std::vector<std::vector<uint8_t>> data;
+                         for (auto &value : values) {
+                           data.emplace_back(value.begin(), value.end());
+                         }
+                         self.multi_set(keys, data);
+                       },
+                       py::arg("keys"),
+                       py::arg("values"),
+                       py::call_guard<py::gil_scoped_release>())
+                   .def(
+                       "compare_set",
+                       [](phi::distributed::Store &self,
+                          const std::string &key,
+                          const std::string &expected,
+                          const std::string &desired) -> py::bytes {
+                         auto data = self.compare_set(
+                             key,
+                             std::vector<uint8_t>(expected.begin(),
+                                                  expected.end()),
+                             std::vector<uint8_t>(desired.begin(),
+                                                  desired.end()));
+                         std::string s(data.begin(), data.end());
+                         py::gil_scoped_acquire acquire;
+                         return py::bytes(s);
+                       },
+                       py::arg("key"),
+                       py::arg("expected"),
+                       py::arg("desired"),
+                       py::call_guard<py::gil_scoped_release>());
 
   py::class_<TCPStore, std::shared_ptr<TCPStore>>(*m, "TCPStore", Store)
       .def(py::init([](std::string hostname,
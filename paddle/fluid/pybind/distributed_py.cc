@@ -23,6 +23,7 @@ limitations under the License. */
 
 #include "paddle/fluid/distributed/collective/process_group.h"
 #include "paddle/fluid/distributed/collective/reducer.h"
+#include "paddle/fluid/distributed/collective/sharding_engine.h"
 #include "paddle/fluid/framework/lod_tensor.h"
 #include "paddle/fluid/framework/tensor.h"
 #include "paddle/fluid/imperative/layer.h"
@@ -35,6 +36,7 @@ limitations under the License. */
 #if defined(PADDLE_WITH_NCCL) || defined(PADDLE_WITH_RCCL)
 #include "paddle/fluid/distributed/collective/async_load.h"
 #include "paddle/fluid/distributed/collective/process_group_nccl.h"
+#include "paddle/phi/core/distributed/comm_task_manager.h"
 #endif
 
 #if defined(PADDLE_WITH_MPI)
@@ -75,6 +77,18 @@ std::shared_ptr<distributed::EagerReducer> CreateEagerReducer(
                                                      find_unused_parameters);
 }
 
+std::shared_ptr<distributed::EagerShardingEngine> CreateEagerShardingEngine(
+    py::handle py_layer_params,
+    std::shared_ptr<distributed::ProcessGroup> process_group,
+    size_t prefetch_layers) {
+  std::vector<std::vector<Tensor>> layer_params;
+  for (auto py_params : py_layer_params) {
+    layer_params.push_back(CastPyArg2VectorOfTensor(py_params.ptr(), 0));
+  }
+  return std::make_shared<distributed::EagerShardingEngine>(
+      layer_params, process_group, prefetch_layers);
+}
+
 #if defined(PADDLE_WITH_GLOO)
 using ProcessGroupGloo = paddle::distributed::ProcessGroupGloo;
 using GlooStore = paddle::distributed::ProcessGroupGloo::GlooStore;
@@ -418,6 +432,39 @@ void BindDistributed(py::module *m) {
               py::arg("in_sizes"),
               py::arg("sync_op"))
 
+          .def(
+              "all_to_all_single_with_splits",
+              [](distributed::ProcessGroup &self,
+                 py::handle py_out_tensor,
+                 py::handle py_in_tensor,
+                 const std::vector<int64_t> &in_sizes,
+                 bool sync_op) {
+                auto out_tensor = CastPyArg2Tensor(py_out_tensor.ptr(), 0);
+                auto in_tensor = CastPyArg2Tensor(py_in_tensor.ptr(), 0);
+                py::gil_scoped_release release;
+
+                auto p_out_tensor = std::dynamic_pointer_cast<phi::DenseTensor>(
+                    out_tensor.impl());
+                auto *out_dense = p_out_tensor.get();
+
+                auto p_in_tensor = std::dynamic_pointer_cast<phi::DenseTensor>(
+                    in_tensor.impl());
+                auto in_dense = *p_in_tensor;
+
+                std::vector<int64_t> out_sizes;
+                auto task = self.AllToAllWithSplits(out_dense,
+                                                    in_dense,
+                                                    in_sizes,
+                                                    &out_sizes,
+                                                    sync_op,
+                                                    /*use_calc_stream*/ false);
+                return std::make_tuple(task, out_sizes);
+              },
+              py::arg("out"),
+              py::arg("in"),
+              py::arg("in_sizes"),
+              py::arg("sync_op"))
+
           .def(
               "reduce",
               [](distributed::ProcessGroup &self,
@@ -1279,6 +1326,27 @@ void BindDistributed(py::module *m) {
       .def_static("group_start", distributed::ProcessGroupNCCL::GroupStart)
       .def_static("group_end", distributed::ProcessGroupNCCL::GroupEnd);
 
+  m->def(
+      "get_comm_latency_stats",
+      []() {
+        return phi::distributed::CommTaskManager::GetInstance()
+            .GetLatencyStats();
+      },
+      py::call_guard<py::gil_scoped_release>());
+  m->def(
+      "get_comm_straggler_report",
+      []() {
+        return phi::distributed::CommTaskManager::GetInstance()
+            .GetStragglerReport();
+      },
+      py::call_guard<py::gil_scoped_release>());
+  m->def(
+      "reset_comm_latency_stats",
+      []() {
+        phi::distributed::CommTaskManager::GetInstance().ResetLatencyStats();
+      },
+      py::call_guard<py::gil_scoped_release>());
+
   py::class_<distributed::AsyncLoad::Task,
              std::shared_ptr<distributed::AsyncLoad::Task>>(*m, "AsyncLoadTask")
       .def("is_completed",
@@ -1486,6 +1554,49 @@ void BindDistributed(py::module *m) {
           },
           py::arg("tensors"));
 
+  py::class_<distributed::EagerShardingEngine,
+             std::shared_ptr<distributed::EagerShardingEngine>>(
+      *m, "EagerShardingEngine", R"DOC()DOC")
+      .def(py::init(&CreateEagerShardingEngine),
+           py::arg("layer_params"),
+           py::arg("process_group"),
+           py::arg("prefetch_layers") = 1)
+      .def("pre_forward",
+           &distributed::EagerShardingEngine::PreForward,
+           py::arg("layer"),
+           py::call_guard<py::gil_scoped_release>())
+      .def("post_forward",
+           &distributed::EagerShardingEngine::PostForward,
+           py::arg("layer"),
+           py::call_guard<py::gil_scoped_release>())
+      .def("pre_backward",
+           &distributed::EagerShardingEngine::PreBackward,
+           py::arg("layer"),
+           py::call_guard<py::gil_scoped_release>())
+      .def("finalize_backward",
+           &distributed::EagerShardingEngine::FinalizeBackward,
+           py::call_guard<py::gil_scoped_release>())
+      .def("release_all",
+           &distributed::EagerShardingEngine::ReleaseAll,
+           py::call_guard<py::gil_scoped_release>())
+      .def("clear_grad_shards",
+           &distributed::EagerShardingEngine::ClearGradShards)
+      .def("layer_num", &distributed::EagerShardingEngine::LayerNum)
+      .def(
+          "param_shard",
+          [](distributed::EagerShardingEngine &self, size_t layer) {
+            return py::reinterpret_steal<py::object>(
+                ToPyObject(self.ParamShard(layer)));
+          },
+          py::arg("layer"))
+      .def(
+          "grad_shard",
+          [](distributed::EagerShardingEngine &self, size_t layer) {
+            return py::reinterpret_steal<py::object>(
+                ToPyObject(self.GradShard(layer)));
+          },
+          py::arg("layer"));
+
   py::class_<distributed::ProcessGroupIdMap,
              std::shared_ptr<distributed::ProcessGroupIdMap>>(
       *m, "ProcessGroupIdMap")
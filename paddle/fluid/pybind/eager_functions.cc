@@ -476,7 +476,7 @@ static PyObject* eager_api__get_custom_operator_inplace_reverse_idx(
     PyObject* self, PyObject* args, PyObject* kwargs) {
   EAGER_TRY
   std::string op_type = CastPyArg2AttrString(PyTuple_GET_ITEM(args, 0), 0);
-  auto meta_info_map = egr::Controller::Instance().GetOpMetaInfoMap();
+  const auto& meta_info_map = egr::Controller::Instance().GetOpMetaInfoMap();
   PADDLE_ENFORCE_NE(meta_info_map.find(op_type),
                     meta_info_map.end(),
                     common::errors::NotFound(
@@ -548,7 +548,7 @@ PyObject* eager_api_run_custom_op(PyObject* self,
   std::string op_type = CastPyArg2AttrString(PyTuple_GET_ITEM(args, 0), 0);
   VLOG(7) << "Get things from python for Custom Op: " << op_type;
   paddle::CustomOpKernelContext ctx;
-  auto meta_info_map = egr::Controller::Instance().GetOpMetaInfoMap();
+  const auto& meta_info_map = egr::Controller::Instance().GetOpMetaInfoMap();
   PADDLE_ENFORCE_NE(meta_info_map.find(op_type),
                     meta_info_map.end(),
                     common::errors::NotFound(
@@ -628,50 +628,64 @@ PyObject* eager_api_run_custom_op(PyObject* self,
 
   // Parse op_type and inputs first, so that use 1 + inputs.size() + i
   int attr_start_idx = static_cast<int>(1 + inputs.size());
-  for (size_t i = 0; i < attrs.size(); ++i) {
-    const auto& attr = attrs.at(i);
-    std::vector<std::string> attr_name_and_type = paddle::ParseAttrStr(attr);
-    auto attr_type_str = attr_name_and_type[1];
-    VLOG(7) << "Custom operator add attrs " << attr_name_and_type[0]
-            << " to CustomOpKernelContext. Attribute type = " << attr_type_str;
+  // The attribute strings of each op are parsed on its first run only, the
+  // GIL guards the cache.
+  using CustomOpAttr = paddle::framework::detail::CustomOpAttr;
+  static std::unordered_map<std::string, std::vector<CustomOpAttr>>
+      custom_attrs_cache;
+  auto custom_attrs_iter = custom_attrs_cache.find(op_type);
+  if (custom_attrs_iter == custom_attrs_cache.end()) {
+    custom_attrs_iter =
+        custom_attrs_cache
+            .emplace(op_type,
+                     paddle::framework::detail::ParseCustomOpAttrs(attrs))
+            .first;
+  }
+  const auto& custom_attrs = custom_attrs_iter->second;
+  for (size_t i = 0; i < custom_attrs.size(); ++i) {
+    const auto& attr = custom_attrs.at(i);
+    VLOG(7) << "Custom operator add attrs " << attr.name
+            << " to CustomOpKernelContext. Attribute type = " << attr.type_str;
     PyObject* obj = PyTuple_GET_ITEM(args, attr_start_idx + i);
-    if (attr_type_str == "bool") {
-      ctx.EmplaceBackAttr(
-          CastPyArg2AttrBoolean(obj, attr_start_idx + i));  // NOLINT
-    } else if (attr_type_str == "int") {
-      ctx.EmplaceBackAttr(
-          CastPyArg2AttrInt(obj, attr_start_idx + i));  // NOLINT
-    } else if (attr_type_str == "float") {
-      ctx.EmplaceBackAttr(
-          CastPyArg2AttrFloat(obj, attr_start_idx + i));  // NOLINT
-    } else if (attr_type_str == "double") {
-      ctx.EmplaceBackAttr(
-          CastPyArg2AttrDouble(obj, attr_start_idx + i));  // NOLINT
-    } else if (attr_type_str == "int64_t") {
-      ctx.EmplaceBackAttr(
-          CastPyArg2Long(obj, op_type, attr_start_idx + i));  // NOLINT
-    } else if (attr_type_str == "std::string") {
-      ctx.EmplaceBackAttr(
-          CastPyArg2AttrString(obj, attr_start_idx + i));  // NOLINT
-    } else if (attr_type_str == "std::vector<int>") {      // NOLINT
-      ctx.EmplaceBackAttr(CastPyArg2VectorOfInt(obj, attr_start_idx + i));
-    } else if (attr_type_str == "std::vector<float>") {
-      ctx.EmplaceBackAttr(CastPyArg2VectorOfFloat(obj, attr_start_idx + i));
-    } else if (attr_type_str == "std::vector<int64_t>") {
-      ctx.EmplaceBackAttr(
-          CastPyArg2Longs(obj, op_type, attr_start_idx + i));  // NOLINT
-    } else if (attr_type_str == "std::vector<std::string>") {
-      ctx.EmplaceBackAttr(
-          CastPyArg2VectorOfString(obj, attr_start_idx + i));  // NOLINT
-    } else {
-      PADDLE_THROW(common::errors::Unimplemented(
-          "Unsupported `%s` type value as custom attribute now. "
-          "Supported data types include `bool`, `int`, `float`, "
-          "`int64_t`, `std::string`, `std::vector<int>`, "
-          "`std::vector<float>`, `std::vector<int64_t>`, "
-          "`std::vector<std::string>`, Please check whether "
-          "the attribute data type and data type string are matched.",
-          attr_type_str));
+    switch (attr.type) {
+      case CustomOpAttr::Type::kBool:
+        ctx.EmplaceBackAttr(
+            CastPyArg2AttrBoolean(obj, attr_start_idx + i));  // NOLINT
+        break;
+      case CustomOpAttr::Type::kInt:
+        ctx.EmplaceBackAttr(
+            CastPyArg2AttrInt(obj, attr_start_idx + i));  // NOLINT
+        break;
+      case CustomOpAttr::Type::kFloat:
+        ctx.EmplaceBackAttr(
+            CastPyArg2AttrFloat(obj, attr_start_idx + i));  // NOLINT
+        break;
+      case CustomOpAttr::Type::kDouble:
+        ctx.EmplaceBackAttr(
+            CastPyArg2AttrDouble(obj, attr_start_idx + i));  // NOLINT
+        break;
+      case CustomOpAttr::Type::kInt64:
+        ctx.EmplaceBackAttr(
+            CastPyArg2Long(obj, op_type, attr_start_idx + i));  // NOLINT
+        break;
+      case CustomOpAttr::Type::kString:
+        ctx.EmplaceBackAttr(
+            CastPyArg2AttrString(obj, attr_start_idx + i));  // NOLINT
+        break;
+      case CustomOpAttr::Type::kIntVec:
+        ctx.EmplaceBackAttr(CastPyArg2VectorOfInt(obj, attr_start_idx + i));
+        break;
+      case CustomOpAttr::Type::kFloatVec:
+        ctx.EmplaceBackAttr(CastPyArg2VectorOfFloat(obj, attr_start_idx + i));
+        break;
+      case CustomOpAttr::Type::kInt64Vec:
+        ctx.EmplaceBackAttr(
+            CastPyArg2Longs(obj, op_type, attr_start_idx + i));  // NOLINT
+        break;
+      case CustomOpAttr::Type::kStringVec:
+        ctx.EmplaceBackAttr(
+            CastPyArg2VectorOfString(obj, attr_start_idx + i));  // NOLINT
+        break;
     }
   }
 
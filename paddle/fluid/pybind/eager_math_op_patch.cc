@@ -237,8 +237,9 @@ void TypePromotionForZeroDimTensor(std::string func,
 }
 
 static PyObject* tensor__add__method(TensorObject* self,
-                                     PyObject* args,
-                                     PyObject* kwargs) {
+                                     PyObject* const* args,
+                                     Py_ssize_t nargs,
+                                     PyObject* kwnames) {
   phi::RecordEvent pythonc_record_event("__add__ or __radd_ pybind_patch_func",
                                         phi::TracerEventType::UserDefined,
                                         1);
@@ -254,7 +255,7 @@ static PyObject* tensor__add__method(TensorObject* self,
 
   paddle::Tensor ret;
   paddle::Tensor self_tensor = self->tensor;
-  PyObject* other_obj = PyTuple_GET_ITEM(args, 0);
+  PyObject* other_obj = args[0];
 
   // 1. scalar exists cases
   if (PyFloat_Check(other_obj) || PyCheckInteger(other_obj) ||
@@ -335,8 +336,9 @@ static PyObject* tensor__add__method(TensorObject* self,
 }
 
 static PyObject* tensor__sub__method(TensorObject* self,
-                                     PyObject* args,
-                                     PyObject* kwargs) {
+                                     PyObject* const* args,
+                                     Py_ssize_t nargs,
+                                     PyObject* kwnames) {
   phi::RecordEvent pythonc_record_event(
       "__sub__ pybind_patch_func", phi::TracerEventType::UserDefined, 1);
 
@@ -352,7 +354,7 @@ static PyObject* tensor__sub__method(TensorObject* self,
   paddle::Tensor ret;
 
   paddle::Tensor self_tensor = self->tensor;
-  PyObject* other_obj = PyTuple_GET_ITEM(args, 0);
+  PyObject* other_obj = args[0];
   // 1. scalar exists cases
   if (PyFloat_Check(other_obj) || PyCheckInteger(other_obj) ||
       IsNumpyType(other_obj)) {
@@ -431,8 +433,9 @@ static PyObject* tensor__sub__method(TensorObject* self,
 }
 
 static PyObject* tensor__rsub__method(TensorObject* self,
-                                      PyObject* args,
-                                      PyObject* kwargs) {
+                                      PyObject* const* args,
+                                      Py_ssize_t nargs,
+                                      PyObject* kwnames) {
   phi::RecordEvent pythonc_record_event(
       "__rsub__ pybind_patch_func", phi::TracerEventType::UserDefined, 1);
 
@@ -447,7 +450,7 @@ static PyObject* tensor__rsub__method(TensorObject* self,
 
   paddle::Tensor ret;
   paddle::Tensor self_tensor = self->tensor;
-  PyObject* other_obj = PyTuple_GET_ITEM(args, 0);
+  PyObject* other_obj = args[0];
 
   // 1. scalar exists cases
   if (PyFloat_Check(other_obj) || PyCheckInteger(other_obj) ||
@@ -526,8 +529,9 @@ static PyObject* tensor__rsub__method(TensorObject* self,
 }
 
 static PyObject* tensor__mul__method(TensorObject* self,
-                                     PyObject* args,
-                                     PyObject* kwargs) {
+                                     PyObject* const* args,
+                                     Py_ssize_t nargs,
+                                     PyObject* kwnames) {
   phi::RecordEvent pythonc_record_event(
       "__mul__ pybind_patch_func", phi::TracerEventType::UserDefined, 1);
 
@@ -543,7 +547,7 @@ static PyObject* tensor__mul__method(TensorObject* self,
   paddle::Tensor ret;
 
   paddle::Tensor self_tensor = self->tensor;
-  PyObject* other_obj = PyTuple_GET_ITEM(args, 0);
+  PyObject* other_obj = args[0];
 
   // 1. scalar exists cases
   if (PyFloat_Check(other_obj) || PyCheckInteger(other_obj) ||
@@ -630,8 +634,9 @@ static PyObject* tensor__mul__method(TensorObject* self,
 }
 
 static PyObject* tensor__div__method(TensorObject* self,
-                                     PyObject* args,
-                                     PyObject* kwargs) {
+                                     PyObject* const* args,
+                                     Py_ssize_t nargs,
+                                     PyObject* kwnames) {
   phi::RecordEvent pythonc_record_event(
       "__div__ pybind_patch_func", phi::TracerEventType::UserDefined, 1);
 
@@ -648,7 +653,7 @@ static PyObject* tensor__div__method(TensorObject* self,
   paddle::Tensor ret;
 
   paddle::Tensor self_tensor = self->tensor;
-  PyObject* other_obj = PyTuple_GET_ITEM(args, 0);
+  PyObject* other_obj = args[0];
 
   // 1. scalar exists cases
   if (PyFloat_Check(other_obj) || PyCheckInteger(other_obj) ||
@@ -725,8 +730,9 @@ static PyObject* tensor__div__method(TensorObject* self,
 }
 
 static PyObject* tensor__rdiv__method(TensorObject* self,
-                                      PyObject* args,
-                                      PyObject* kwargs) {
+                                      PyObject* const* args,
+                                      Py_ssize_t nargs,
+                                      PyObject* kwnames) {
   phi::RecordEvent pythonc_record_event(
       "__rdiv__ pybind_patch_func", phi::TracerEventType::UserDefined, 1);
   EAGER_TRY
@@ -742,7 +748,7 @@ static PyObject* tensor__rdiv__method(TensorObject* self,
   paddle::Tensor ret;
 
   paddle::Tensor self_tensor = self->tensor;
-  PyObject* other_obj = PyTuple_GET_ITEM(args, 0);
+  PyObject* other_obj = args[0];
 
   // 1. scalar exists cases
   // there is no scalar_div function for __rdiv__ and __rtruediv__
@@ -813,8 +819,9 @@ static PyObject* tensor__rdiv__method(TensorObject* self,
 }
 
 static PyObject* tensor__gt__method(TensorObject* self,
-                                    PyObject* args,
-                                    PyObject* kwargs) {
+                                    PyObject* const* args,
+                                    Py_ssize_t nargs,
+                                    PyObject* kwnames) {
   phi::RecordEvent pythonc_record_event(
       "__gt__ pybind_patch_func", phi::TracerEventType::UserDefined, 1);
 
@@ -829,7 +836,7 @@ static PyObject* tensor__gt__method(TensorObject* self,
 
   paddle::Tensor ret;
   paddle::Tensor self_tensor = self->tensor;
-  PyObject* other_obj = PyTuple_GET_ITEM(args, 0);
+  PyObject* other_obj = args[0];
 
   // 1. scalar exists cases
   // there is no scalar function for __gt__ now
@@ -906,8 +913,9 @@ static PyObject* tensor__gt__method(TensorObject* self,
 }
 
 static PyObject* tensor__ge__method(TensorObject* self,
-                                    PyObject* args,
-                                    PyObject* kwargs) {
+                                    PyObject* const* args,
+                                    Py_ssize_t nargs,
+                                    PyObject* kwnames) {
   phi::RecordEvent pythonc_record_event(
       "__ge__ pybind_patch_func", phi::TracerEventType::UserDefined, 1);
 
@@ -922,7 +930,7 @@ static PyObject* tensor__ge__method(TensorObject* self,
 
   paddle::Tensor ret;
   paddle::Tensor self_tensor = self->tensor;
-  PyObject* other_obj = PyTuple_GET_ITEM(args, 0);
+  PyObject* other_obj = args[0];
 
   // 1. scalar exists cases
   // there is no scalar function for __ge__ now
@@ -999,8 +1007,9 @@ static PyObject* tensor__ge__method(TensorObject* self,
 }
 
 static PyObject* tensor__mod__method(TensorObject* self,
-                                     PyObject* args,
-                                     PyObject* kwargs) {
+                                     PyObject* const* args,
+                                     Py_ssize_t nargs,
+                                     PyObject* kwnames) {
   phi::RecordEvent pythonc_record_event(
       "__mod__ pybind_patch_func", phi::TracerEventType::UserDefined, 1);
   EAGER_TRY
@@ -1016,7 +1025,7 @@ static PyObject* tensor__mod__method(TensorObject* self,
   paddle::Tensor ret;
 
   paddle::Tensor self_tensor = self->tensor;
-  PyObject* other_obj = PyTuple_GET_ITEM(args, 0);
+  PyObject* other_obj = args[0];
 
   // 1. scalar exists cases
   // there is no scalar_mod function for __mod__ now
@@ -1092,8 +1101,9 @@ static PyObject* tensor__mod__method(TensorObject* self,
 }
 
 static PyObject* tensor__rmod__method(TensorObject* self,
-                                      PyObject* args,
-                                      PyObject* kwargs) {
+                                      PyObject* const* args,
+                                      Py_ssize_t nargs,
+                                      PyObject* kwnames) {
   phi::RecordEvent pythonc_record_event(
       "__rmod__ pybind_patch_func", phi::TracerEventType::UserDefined, 1);
   EAGER_TRY
@@ -1109,7 +1119,7 @@ static PyObject* tensor__rmod__method(TensorObject* self,
   paddle::Tensor ret;
 
   paddle::Tensor self_tensor = self->tensor;
-  PyObject* other_obj = PyTuple_GET_ITEM(args, 0);
+  PyObject* other_obj = args[0];
 
   // 1. scalar exists cases
   // there is no scalar_mod function for __rmod__ now
@@ -1185,8 +1195,9 @@ static PyObject* tensor__rmod__method(TensorObject* self,
 }
 
 static PyObject* tensor__matmul__method(TensorObject* self,
-                                        PyObject* args,
-                                        PyObject* kwargs) {
+                                        PyObject* const* args,
+                                        Py_ssize_t nargs,
+                                        PyObject* kwnames) {
   phi::RecordEvent pythonc_record_event(
       "__matmul__ pybind_patch_func", phi::TracerEventType::UserDefined, 1);
   EAGER_TRY
@@ -1202,7 +1213,7 @@ static PyObject* tensor__matmul__method(TensorObject* self,
   paddle::Tensor ret;
   paddle::Tensor self_tensor = self->tensor;
 
-  PyObject* other_obj = PyTuple_GET_ITEM(args, 0);
+  PyObject* other_obj = args[0];
 
   // 1. scalar exists cases
   // there is no scalar_matmul function for __matmul__ now
@@ -1312,8 +1323,9 @@ static PyObject* tensor__matmul__method(TensorObject* self,
 }
 
 static PyObject* tensor__rmatmul__method(TensorObject* self,
-                                         PyObject* args,
-                                         PyObject* kwargs) {
+                                         PyObject* const* args,
+                                         Py_ssize_t nargs,
+                                         PyObject* kwnames) {
   phi::RecordEvent pythonc_record_event(
       "__rmatmul__ pybind_patch_func", phi::TracerEventType::UserDefined, 1);
   EAGER_TRY
@@ -1329,7 +1341,7 @@ static PyObject* tensor__rmatmul__method(TensorObject* self,
   paddle::Tensor ret;
   paddle::Tensor self_tensor = self->tensor;
 
-  PyObject* other_obj = PyTuple_GET_ITEM(args, 0);
+  PyObject* other_obj = args[0];
 
   // 1. scalar exists cases
   // there is no scalar_matmul function for __rmatmul__ now
@@ -1439,8 +1451,9 @@ static PyObject* tensor__rmatmul__method(TensorObject* self,
 }
 
 static PyObject* tensor__lt__method(TensorObject* self,
-                                    PyObject* args,
-                                    PyObject* kwargs) {
+                                    PyObject* const* args,
+                                    Py_ssize_t nargs,
+                                    PyObject* kwnames) {
   phi::RecordEvent pythonc_record_event(
       "__lt__ pybind_patch_func", phi::TracerEventType::UserDefined, 1);
 
@@ -1455,7 +1468,7 @@ static PyObject* tensor__lt__method(TensorObject* self,
 
   paddle::Tensor ret;
   paddle::Tensor self_tensor = self->tensor;
-  PyObject* other_obj = PyTuple_GET_ITEM(args, 0);
+  PyObject* other_obj = args[0];
 
   // 1. scalar exists cases
   // there is no scalar function for __lt__ now
@@ -1532,8 +1545,9 @@ static PyObject* tensor__lt__method(TensorObject* self,
 }
 
 static PyObject* tensor__le__method(TensorObject* self,
-                                    PyObject* args,
-                                    PyObject* kwargs) {
+                                    PyObject* const* args,
+                                    Py_ssize_t nargs,
+                                    PyObject* kwnames) {
   phi::RecordEvent pythonc_record_event(
       "__le__ pybind_patch_func", phi::TracerEventType::UserDefined, 1);
 
@@ -1548,7 +1562,7 @@ static PyObject* tensor__le__method(TensorObject* self,
 
   paddle::Tensor ret;
   paddle::Tensor self_tensor = self->tensor;
-  PyObject* other_obj = PyTuple_GET_ITEM(args, 0);
+  PyObject* other_obj = args[0];
 
   // 1. scalar exists cases
   // there is no scalar function for __le__ now
@@ -1625,8 +1639,9 @@ static PyObject* tensor__le__method(TensorObject* self,
 }
 
 static PyObject* tensor__floordiv__method(TensorObject* self,
-                                          PyObject* args,
-                                          PyObject* kwargs) {
+                                          PyObject* const* args,
+                                          Py_ssize_t nargs,
+                                          PyObject* kwnames) {
   phi::RecordEvent pythonc_record_event(
       "floordiv pybind_patch_func", phi::TracerEventType::UserDefined, 1);
   EAGER_TRY
@@ -1641,7 +1656,7 @@ static PyObject* tensor__floordiv__method(TensorObject* self,
   paddle::Tensor ret;
   paddle::Tensor self_tensor = self->tensor;
 
-  PyObject* other_obj = PyTuple_GET_ITEM(args, 0);
+  PyObject* other_obj = args[0];
 
   // 1. scalar exists cases or not
   // there is no scalar case for floordiv, but also need to cast self_tensor
@@ -1717,8 +1732,9 @@ static PyObject* tensor__floordiv__method(TensorObject* self,
 }
 
 static PyObject* tensor__rfloordiv__method(TensorObject* self,
-                                           PyObject* args,
-                                           PyObject* kwargs) {
+                                           PyObject* const* args,
+                                           Py_ssize_t nargs,
+                                           PyObject* kwnames) {
   phi::RecordEvent pythonc_record_event(
       "__rfloordiv__ pybind_patch_func", phi::TracerEventType::UserDefined, 1);
   EAGER_TRY
@@ -1733,7 +1749,7 @@ static PyObject* tensor__rfloordiv__method(TensorObject* self,
   paddle::Tensor ret;
   paddle::Tensor self_tensor = self->tensor;
 
-  PyObject* other_obj = PyTuple_GET_ITEM(args, 0);
+  PyObject* other_obj = args[0];
 
   // 1. scalar exists cases or not
   // there is no scalar case for rfloordiv, but also need to cast self_tensor
@@ -1809,8 +1825,9 @@ static PyObject* tensor__rfloordiv__method(TensorObject* self,
 }
 
 static PyObject* tensor__pow__method(TensorObject* self,
-                                     PyObject* args,
-                                     PyObject* kwargs) {
+                                     PyObject* const* args,
+                                     Py_ssize_t nargs,
+                                     PyObject* kwnames) {
   phi::RecordEvent pythonc_record_event(
       "pow pybind_patch_func", phi::TracerEventType::UserDefined, 1);
 
@@ -1826,7 +1843,7 @@ static PyObject* tensor__pow__method(TensorObject* self,
   paddle::Tensor ret;
   paddle::Tensor self_tensor = self->tensor;
 
-  PyObject* other_obj = PyTuple_GET_ITEM(args, 0);
+  PyObject* other_obj = args[0];
 
   // 1. scalar exists cases
   if (PyFloat_Check(other_obj) || PyCheckInteger(other_obj) ||
@@ -1906,8 +1923,9 @@ static PyObject* tensor__pow__method(TensorObject* self,
 }
 
 static PyObject* tensor__rpow__method(TensorObject* self,
-                                      PyObject* args,
-                                      PyObject* kwargs) {
+                                      PyObject* const* args,
+                                      Py_ssize_t nargs,
+                                      PyObject* kwnames) {
   phi::RecordEvent pythonc_record_event(
       "__rpow__ pybind_patch_func", phi::TracerEventType::UserDefined, 1);
 
@@ -1923,7 +1941,7 @@ static PyObject* tensor__rpow__method(TensorObject* self,
   paddle::Tensor ret;
   paddle::Tensor self_tensor = self->tensor;
 
-  PyObject* other_obj = PyTuple_GET_ITEM(args, 0);
+  PyObject* other_obj = args[0];
 
   // 1. scalar exists cases or not
   // there is no scalar case for rpow, but also need to cast self_tensor in
@@ -2001,8 +2019,9 @@ static PyObject* tensor__rpow__method(TensorObject* self,
 }
 
 static PyObject* tensor__ne__method(TensorObject* self,
-                                    PyObject* args,
-                                    PyObject* kwargs) {
+                                    PyObject* const* args,
+                                    Py_ssize_t nargs,
+                                    PyObject* kwnames) {
   phi::RecordEvent pythonc_record_event(
       "__ne__ pybind_patch_func", phi::TracerEventType::UserDefined, 1);
 
@@ -2017,7 +2036,7 @@ static PyObject* tensor__ne__method(TensorObject* self,
 
   paddle::Tensor ret;
   paddle::Tensor self_tensor = self->tensor;
-  PyObject* other_obj = PyTuple_GET_ITEM(args, 0);
+  PyObject* other_obj = args[0];
 
   // 1. scalar exists cases
   // there is no scalar function for __ne__ now
@@ -2094,8 +2113,9 @@ static PyObject* tensor__ne__method(TensorObject* self,
 }
 
 static PyObject* tensor__eq__method(TensorObject* self,
-                                    PyObject* args,
-                                    PyObject* kwargs) {
+                                    PyObject* const* args,
+                                    Py_ssize_t nargs,
+                                    PyObject* kwnames) {
   phi::RecordEvent pythonc_record_event(
       "__eq__ pybind_patch_func", phi::TracerEventType::UserDefined, 1);
 
@@ -2110,7 +2130,7 @@ static PyObject* tensor__eq__method(TensorObject* self,
 
   paddle::Tensor ret;
   paddle::Tensor self_tensor = self->tensor;
-  PyObject* other_obj = PyTuple_GET_ITEM(args, 0);
+  PyObject* other_obj = args[0];
 
   // 1. scalar exists cases
   // there is no scalar function for __eq__ now
@@ -2186,102 +2206,104 @@ static PyObject* tensor__eq__method(TensorObject* self,
   EAGER_CATCH_AND_THROW_RETURN_NULL
 }
 
+// The operators take METH_FASTCALL, so that no argument tuple is built for
+// each call of them in the training loops.
 PyMethodDef math_op_patch_methods[] = {  // NOLINT
     {"__add__",
      (PyCFunction)(void (*)())tensor__add__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__radd__",
      (PyCFunction)(void (*)())tensor__add__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__sub__",
      (PyCFunction)(void (*)())tensor__sub__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__rsub__",
      (PyCFunction)(void (*)())tensor__rsub__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__mul__",
      (PyCFunction)(void (*)())tensor__mul__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__rmul__",
      (PyCFunction)(void (*)())tensor__mul__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__div__",
      (PyCFunction)(void (*)())tensor__div__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__truediv__",
      (PyCFunction)(void (*)())tensor__div__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__rdiv__",
      (PyCFunction)(void (*)())tensor__rdiv__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__rtruediv__",
      (PyCFunction)(void (*)())tensor__rdiv__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__floordiv__",
      (PyCFunction)(void (*)())tensor__floordiv__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__rfloordiv__",
      (PyCFunction)(void (*)())tensor__rfloordiv__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__pow__",
      (PyCFunction)(void (*)())tensor__pow__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__rpow__",
      (PyCFunction)(void (*)())tensor__rpow__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__mod__",
      (PyCFunction)(void (*)())tensor__mod__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__rmod__",
      (PyCFunction)(void (*)())tensor__rmod__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__matmul__",
      (PyCFunction)(void (*)())tensor__matmul__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__rmatmul__",
      (PyCFunction)(void (*)())tensor__rmatmul__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__gt__",
      (PyCFunction)(void (*)())tensor__gt__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__ge__",
      (PyCFunction)(void (*)())tensor__ge__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__lt__",
      (PyCFunction)(void (*)())tensor__lt__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__le__",
      (PyCFunction)(void (*)())tensor__le__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__eq__",
      (PyCFunction)(void (*)())tensor__eq__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {"__ne__",
      (PyCFunction)(void (*)())tensor__ne__method,
-     METH_VARARGS | METH_KEYWORDS,
+     METH_FASTCALL | METH_KEYWORDS,
      nullptr},
     {nullptr, nullptr, 0, nullptr}};
 
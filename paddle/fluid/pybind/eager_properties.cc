@@ -581,6 +581,22 @@ PyObject* tensor_properties_get_shape(TensorObject* self, void* closure) {
   if (!self->tensor.defined()) {
     return ToPyObject(value);
   }
+  // Fast path: the dims are converted without the temporary vectors unless
+  // the layout autotune swaps them.
+  if (!egr::IsVariableCompatTensor(self->tensor)) {
+    const auto& ddim = self->tensor.dims();
+    auto& layout_autotune = paddle::imperative::LayoutAutoTune::Instance();
+    auto desired_layout = layout_autotune.GetDesiredLayout();
+    if (desired_layout == layout_autotune.GetDefaultLayout() ||
+        ddim.size() != 4 || self->tensor.layout() != desired_layout) {
+      int rank = ddim.size() < 0 ? 0 : ddim.size();
+      PyObject* result = PyList_New(rank);
+      for (int i = 0; i < rank; ++i) {
+        PyList_SET_ITEM(result, i, PyLong_FromLongLong(ddim[i]));
+      }
+      return result;
+    }
+  }
   if (egr::IsVariableCompatTensor(self->tensor)) {
     auto* var_tensor = static_cast<const egr::VariableCompatTensor*>(
         self->tensor.impl().get());
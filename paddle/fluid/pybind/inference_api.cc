@@ -865,6 +865,10 @@ void BindAnalysisConfig(py::module *m) {
       .def("use_optimized_model",
            &AnalysisConfig::UseOptimizedModel,
            py::arg("x") = true)
+      .def("enable_params_mmap",
+           &AnalysisConfig::EnableParamsMmap,
+           py::arg("x") = true)
+      .def("params_mmap_enabled", &AnalysisConfig::params_mmap_enabled)
       .def("enable_memory_optim",
            &AnalysisConfig::EnableMemoryOptim,
            py::arg("x") = true)
@@ -43,6 +43,7 @@ limitations under the License. */
 #include "paddle/fluid/framework/data_layout.h"
 #include "paddle/fluid/framework/data_type_transform.h"
 #include "paddle/fluid/framework/dense_tensor_array.h"
+#include "paddle/fluid/framework/details/nan_inf_utils.h"
 #include "paddle/fluid/framework/details/nan_inf_utils_detail.h"
 #include "paddle/fluid/framework/executor.h"
 #include "paddle/fluid/framework/executor_cache.h"
@@ -79,6 +80,8 @@ limitations under the License. */
 #include "paddle/phi/common/int_array.h"
 #include "paddle/phi/core/framework/reader.h"
 #include "paddle/phi/core/memory/allocation/allocator_strategy.h"
+#include "paddle/phi/core/memory/allocation_recorder.h"
+#include "paddle/phi/core/mixed_vector.h"
 #include "paddle/phi/core/raw_tensor.h"
 #include "paddle/phi/core/tensor_meta.h"
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
@@ -138,6 +141,7 @@ limitations under the License. */
 #include "paddle/phi/core/platform/profiler.h"
 #include "paddle/phi/core/platform/profiler/event_tracing.h"
 #include "paddle/phi/kernels/funcs/common_infer_shape_functions.h"
+#include "paddle/phi/kernels/funcs/fft.h"
 #include "paddle/utils/none.h"
 
 #ifdef PADDLE_WITH_DISTRIBUTE
@@ -2573,6 +2577,37 @@ All parameter, weight, gradient are variables in Paddle.
   m.def("host_memory_stat_peak_value", memory::HostMemoryStatPeakValue);
   m.def("host_memory_stat_reset_peak_value",
         memory::HostMemoryStatResetPeakValue);
+  m.def(
+      "enable_allocation_recorder",
+      [](size_t max_events, bool record_python_stack) {
+        auto &recorder = memory::AllocationRecorder::Instance();
+        if (record_python_stack) {
+          // only the allocations of the thread holding the GIL, i.e. the
+          // eager mode, have the python stack
+          recorder.SetStackProvider([]() -> std::string {
+            if (!PyGILState_Check()) {
+              return "";
+            }
+            std::string stack;
+            for (auto &line : py::module::import("traceback")
+                                  .attr("format_stack")()
+                                  .cast<std::vector<std::string>>()) {
+              stack += line;
+            }
+            return stack;
+          });
+        } else {
+          recorder.SetStackProvider(nullptr);
+        }
+        recorder.Enable(max_events);
+      },
+      py::arg("max_events") = 1 << 16,
+      py::arg("record_python_stack") = false);
+  m.def("disable_allocation_recorder",
+        [] { memory::AllocationRecorder::Instance().Disable(); });
+  m.def("allocation_peak_report", [](const phi::Place &place) {
+    return memory::AllocationRecorder::Instance().PeakReport(place);
+  });
   m.def(
       "run_cmd",
       [](const std::string &cmd,
@@ -3312,6 +3347,14 @@ All parameter, weight, gradient are variables in Paddle.
   m.def("update_autotune_status",
         [] { return phi::autotune::AutoTuneStatus::Instance().Update(); });
 
+  m.def("export_autotune_cache", [](const std::string &path) {
+    return phi::autotune::AutoTuneCache::Instance().Export(path);
+  });
+
+  m.def("import_autotune_cache", [](const std::string &path) {
+    return phi::autotune::AutoTuneCache::Instance().Import(path);
+  });
+
   m.def("autotune_status", [] {
     py::dict res;
     phi::autotune::AutoTuneCache::Instance().UpdateStatus();
@@ -3322,6 +3365,22 @@ All parameter, weight, gradient are variables in Paddle.
     return res;
   });
 
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  m.def("fft_plan_cache_stats", [](int64_t device_id) {
+    py::dict res;
+    auto stats = phi::funcs::GetFFTPlanCacheStats(device_id);
+    res["size"] = stats.size;
+    res["max_size"] = stats.max_size;
+    res["hits"] = stats.hits;
+    res["misses"] = stats.misses;
+    res["evictions"] = stats.evictions;
+    return res;
+  });
+#endif
+
+  m.def("get_mix_vector_sync_count", &phi::GetMixVectorSyncCount);
+  m.def("reset_mix_vector_sync_count", &phi::ResetMixVectorSyncCount);
+
   m.def("enable_layout_autotune",
         [] { return egr::Controller::Instance().EnableLayoutAutoTune(); });
 
@@ -3338,6 +3397,10 @@ All parameter, weight, gradient are variables in Paddle.
   m.def("set_nan_inf_debug_path",
         &paddle::framework::details::SetNanInfDebugPath);
 
+  // Add the api to report the lazy nan inf checks
+  m.def("flush_nan_inf_check",
+        &paddle::framework::details::FlushLazyNanInfCheck);
+
   // Add check op lost
   m.def("set_checked_op_list",
         [](const std::string &op_list) { egr::SetCheckOpList(op_list); });
@@ -3485,8 +3548,11 @@ All parameter, weight, gradient are variables in Paddle.
 #if defined(PADDLE_WITH_RPC)
   BindWorkerInfo(&m);
   BindFuture(&m);
+  BindRpcStreamReader(&m);
   InitAndSetAgentInstance(&m);
   InvokeRpc(&m);
+  InvokeRpcBatch(&m);
+  InvokeRpcStream(&m);
   StartWorker(&m);
   StartClient(&m);
   StopWorker(&m);
@@ -20,6 +20,7 @@
 namespace py = pybind11;
 using paddle::distributed::FutureWrapper;
 using paddle::distributed::RpcAgent;
+using paddle::distributed::RpcStreamReader;
 using paddle::distributed::WorkerInfo;
 namespace paddle::pybind {
 
@@ -40,6 +41,23 @@ void BindFuture(py::module* m) {
            &FutureWrapper::wait,
            py::call_guard<py::gil_scoped_release>());
 }
+void BindRpcStreamReader(py::module* m) {
+  py::class_<RpcStreamReader, std::shared_ptr<RpcStreamReader>>(
+      *m, "RpcStreamReader")
+      .def("__iter__", [](py::object self) { return self; })
+      .def("__next__", [](RpcStreamReader& self) {
+        std::string message;
+        bool has_next = false;
+        {
+          py::gil_scoped_release release;
+          has_next = self.Next(&message);
+        }
+        if (!has_next) {
+          throw py::stop_iteration();
+        }
+        return py::bytes(message);
+      });
+}
 void InitAndSetAgentInstance(py::module* m) {
   m->def(
       "init_and_set_agent_instance",
@@ -64,6 +82,56 @@ void InvokeRpc(py::module* m) {
       py::arg("py_func"),
       py::arg("timeout_ms"));
 }
+void InvokeRpcBatch(py::module* m) {
+  m->def(
+      "invoke_rpc_batch",
+      [](const std::string& name,
+         const std::vector<std::string>& py_funcs,
+         int timeout_ms) {
+        auto instance = RpcAgent::RpcAgentInstance();
+        std::vector<std::shared_ptr<FutureWrapper>> futures;
+        for (auto& fut : instance->InvokeRpcBatch(py_funcs, name, timeout_ms)) {
+          futures.push_back(std::make_shared<FutureWrapper>(std::move(fut)));
+        }
+        return futures;
+      },
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("to"),
+      py::arg("py_funcs"),
+      py::arg("timeout_ms"));
+  m->def(
+      "invoke_cpp_rpc",
+      [](const std::string& name,
+         const std::string& handler,
+         const std::string& message,
+         int timeout_ms) {
+        auto instance = RpcAgent::RpcAgentInstance();
+        return std::make_shared<FutureWrapper>(
+            instance->InvokeRpc(message, name, timeout_ms, handler),
+            /*raw=*/true);
+      },
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("to"),
+      py::arg("handler"),
+      py::arg("message"),
+      py::arg("timeout_ms"));
+}
+void InvokeRpcStream(py::module* m) {
+  m->def(
+      "invoke_rpc_stream",
+      [](const std::string& name,
+         const std::string& handler,
+         const std::string& message,
+         int timeout_ms) {
+        auto instance = RpcAgent::RpcAgentInstance();
+        return instance->InvokeRpcStream(message, name, timeout_ms, handler);
+      },
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("to"),
+      py::arg("handler"),
+      py::arg("message"),
+      py::arg("timeout_ms"));
+}
 void StartWorker(py::module* m) {
   m->def(
       "rpc_start_worker",
@@ -24,8 +24,11 @@ namespace pybind {
 
 void BindWorkerInfo(py::module* m);
 void BindFuture(py::module* m);
+void BindRpcStreamReader(py::module* m);
 void InitAndSetAgentInstance(py::module* m);
 void InvokeRpc(py::module* m);
+void InvokeRpcBatch(py::module* m);
+void InvokeRpcStream(py::module* m);
 void StartWorker(py::module* m);
 void StartClient(py::module* m);
 void StopWorker(py::module* m);
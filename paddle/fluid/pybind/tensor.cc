@@ -429,7 +429,10 @@ void BindTensor(pybind11::module &m) {  // NOLINT
            )DOC")
       .def(
           "_to_dlpack",
-          [](phi::DenseTensor &self) {
+          [](phi::DenseTensor &self,
+             int64_t consumer_stream,
+             int64_t producer_stream) {
+            framework::DLPackStreamWait(self, consumer_stream, producer_stream);
             DLManagedTensor *dlMTensor = framework::toDLPack(self);
             auto capsule = pybind11::capsule(
                 static_cast<void *>(dlMTensor), "dltensor", [](PyObject *data) {
@@ -442,7 +445,9 @@ void BindTensor(pybind11::module &m) {  // NOLINT
                   dlMTensor->deleter(dlMTensor);
                 });
             return capsule;
-          })
+          },
+          py::arg("consumer_stream") = -1,
+          py::arg("producer_stream") = 0)
       .def("_set_float_element", TensorSetElement<float>)
       .def("_get_float_element", TensorGetElement<float>)
       .def("_set_double_element", TensorSetElement<double>)
@@ -321,6 +321,10 @@ class BaseAPI:
         infer_meta = infer_meta_config
         if 'param' not in infer_meta_config:
             infer_meta['param'] = None
+        # `cache : true` marks an InferMeta that only depends on the metas of
+        # its tensor inputs, so its result can be reused for the same metas.
+        if 'cache' not in infer_meta_config:
+            infer_meta['cache'] = False
 
         return infer_meta
 
@@ -592,7 +596,39 @@ PADDLE_API {self.get_return_type(inplace_flag=True)} {api_func_name}({self.get_d
 
         return kernel_select_code
 
-    def gene_infer_meta(self, kernel_output_names, code_indent) -> str:
+    def use_infer_meta_cache(self, kernel_dispatch, inplace_flag):
+        if not self.infer_meta.get('cache', False) or inplace_flag:
+            return False
+        infer_meta_params = (
+            self.infer_meta['param']
+            if self.infer_meta['param'] is not None
+            else self.inputs['names'] + self.attrs['names']
+        )
+        for param in infer_meta_params:
+            if (
+                param not in self.inputs['names']
+                or self.inputs['input_info'][param] != "const Tensor&"
+            ):
+                raise ValueError(
+                    f"{self.api} : The infer_meta with cache can only take dense tensor inputs, but got {param}."
+                )
+        if (
+            len(self.outputs['types']) != 1
+            or self.outputs['types'][0] != 'Tensor'
+        ):
+            raise ValueError(
+                f"{self.api} : The infer_meta with cache can only have one Tensor output."
+            )
+        if kernel_dispatch:
+            return all(
+                tensor_type == 'dense'
+                for tensor_type in kernel_dispatch[0] + kernel_dispatch[1]
+            )
+        return True
+
+    def gene_infer_meta(
+        self, kernel_output_names, code_indent, use_cache=False
+    ) -> str:
         input_names = self.inputs['names']
         attr_names = self.attrs['names']
         infer_meta = self.infer_meta
@@ -714,6 +750,20 @@ PADDLE_API {self.get_return_type(inplace_flag=True)} {api_func_name}({self.get_d
                     )
 
         param_code = param_code[:-2]
+        if use_cache:
+            out_name = kernel_output_names[0]
+            cache_inputs = ", ".join(
+                f"{PREFIX_TENSOR_NAME}{param}.get()"
+                for param in infer_meta_params
+            )
+            return f"""
+{code_indent}  thread_local InferMetaCache infer_meta_cache;
+{code_indent}  if (!infer_meta_cache.Lookup({{{cache_inputs}}}, kernel_result.is_stride_kernel, {out_name})) {{
+{meta_tensor_code}
+{code_indent}    phi::{infer_meta['func']}({param_code});
+{code_indent}    infer_meta_cache.Update({{{cache_inputs}}}, kernel_result.is_stride_kernel, *{out_name});
+{code_indent}  }}
+"""
         return f"""{meta_tensor_code}
 {code_indent}  phi::{infer_meta['func']}({param_code});
 """
@@ -1324,7 +1374,8 @@ PADDLE_API {self.get_return_type(inplace_flag=True)} {api_func_name}({self.get_d
 {code_indent}    }}"""
         return f"""
 {code_indent}  VLOG(6) << "{self.api} API kernel key: [" << kernel_backend << ", " << kernel_layout << ", "<< kernel_data_type << "]";
-{code_indent}  auto kernel_result = phi::KernelFactory::Instance().SelectKernelOrThrowError(
+{code_indent}  thread_local phi::KernelSelectionCache kernel_selection_cache;
+{code_indent}  auto kernel_result = kernel_selection_cache.SelectKernelOrThrowError(
 {code_indent}      "{kernel_name}", {{kernel_backend, kernel_layout, kernel_data_type}}, true);
 {code_indent}  const auto& kernel = kernel_result.kernel;
 {code_indent}  if (FLAGS_low_precision_op_list) {{
@@ -1341,7 +1392,7 @@ PADDLE_API {self.get_return_type(inplace_flag=True)} {api_func_name}({self.get_d
 {code_indent}  if(phi::RecordEvent::IsEnabled()){{
 {code_indent}    infer_shape_record_event = new phi::RecordEvent(\"{self.api} infer_meta\", phi::TracerEventType::OperatorInner, 1);
 {code_indent}  }}
-{self.gene_infer_meta(kernel_output_names, code_indent)}
+{self.gene_infer_meta(kernel_output_names, code_indent, self.use_infer_meta_cache(kernel_dispatch, inplace_flag))}
 {code_indent}  if(infer_shape_record_event != nullptr){{
 {code_indent}    delete infer_shape_record_event;
 {code_indent}  }}
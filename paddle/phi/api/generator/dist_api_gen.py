@@ -305,7 +305,8 @@ INFER_GLOBAL_SHAPE_TEMPLATE = """
 # 4. Select Kernel
 KERNEL_SELECTION_TEMPLATE = """
       VLOG(6) << "{} API dist branch: kernel key: [" << kernel_backend << ", " << kernel_layout << ", "<< kernel_data_type << "]";
-      auto kernel_result = phi::KernelFactory::Instance().SelectKernelOrThrowError(
+      thread_local phi::KernelSelectionCache kernel_selection_cache;
+      auto kernel_result = kernel_selection_cache.SelectKernelOrThrowError(
           "{}", {{kernel_backend, kernel_layout, kernel_data_type}});
       const auto& kernel = kernel_result.kernel;
       VLOG(6) << "{} kernel: " << kernel;
@@ -583,6 +584,8 @@ class DistForwardAPI(ForwardAPI):
             infer_meta['param'] = None
         if 'spmd_rule' not in infer_meta_config:
             infer_meta['spmd_rule'] = None
+        if 'cache' not in infer_meta_config:
+            infer_meta['cache'] = False
         # Operators like `reshape`, `expand_as` need to calculate local_shape
         # for their local `DenseTensor`, as the given shape in their attribute
         # is global_shape for `DistTensor`.
@@ -193,6 +193,40 @@ std::vector<phi::MetaTensor> MakeMetaTensor(
   return meta_tensors;
 }
 
+bool InferMetaCache::Lookup(
+    std::initializer_list<const phi::DenseTensor*> inputs,
+    bool is_stride_kernel,
+    phi::DenseTensor* out) const {
+  if (!valid_ || is_stride_kernel != is_stride_kernel_ ||
+      inputs.size() != input_metas_.size()) {
+    return false;
+  }
+  size_t i = 0;
+  for (auto* input : inputs) {
+    if (input == nullptr || !(input->meta() == input_metas_[i++])) {
+      return false;
+    }
+  }
+  out->set_meta(output_meta_);
+  return true;
+}
+
+void InferMetaCache::Update(
+    std::initializer_list<const phi::DenseTensor*> inputs,
+    bool is_stride_kernel,
+    const phi::DenseTensor& out) {
+  valid_ = false;
+  input_metas_.clear();
+  if (!out.meta().valid()) return;
+  for (auto* input : inputs) {
+    if (input == nullptr) return;
+    input_metas_.push_back(input->meta());
+  }
+  is_stride_kernel_ = is_stride_kernel;
+  output_meta_ = out.meta();
+  valid_ = true;
+}
+
 phi::DenseTensor* SetKernelOutput(Tensor* out) {
   if (out) {
     if (out->impl() == nullptr) {
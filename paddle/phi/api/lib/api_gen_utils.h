@@ -14,6 +14,9 @@ limitations under the License. */
 
 #pragma once
 
+#include <initializer_list>
+#include <vector>
+
 #include "paddle/phi/api/include/tensor.h"
 #include "paddle/phi/backends/all_context.h"
 #include "paddle/phi/core/compat/convert_utils.h"
@@ -90,6 +93,27 @@ std::vector<phi::MetaTensor> MakeMetaTensor(
 std::vector<phi::MetaTensor> MakeMetaTensor(
     const std::vector<const phi::TensorBase*>& tensors);
 
+// Remembers the output meta inferred from the input metas at the last call of
+// an api. The apis whose infer_meta is marked `cache : true` in the yaml only
+// depend on the metas of their dense inputs, so a call with the same input
+// metas can take the cached output meta instead of running the InferMeta.
+class InferMetaCache {
+ public:
+  bool Lookup(std::initializer_list<const phi::DenseTensor*> inputs,
+              bool is_stride_kernel,
+              phi::DenseTensor* out) const;
+
+  void Update(std::initializer_list<const phi::DenseTensor*> inputs,
+              bool is_stride_kernel,
+              const phi::DenseTensor& out);
+
+ private:
+  bool valid_{false};
+  bool is_stride_kernel_{false};
+  std::vector<phi::DenseTensorMeta> input_metas_;
+  phi::DenseTensorMeta output_meta_;
+};
+
 /* ------------------ for output ----------------------- */
 
 phi::DenseTensor* SetKernelOutput(Tensor* out);
@@ -34,6 +34,7 @@ limitations under the License. */
 #include "paddle/phi/kernels/transfer_layout_kernel.h"
 
 PHI_DECLARE_bool(use_stride_kernel);
+COMMON_DECLARE_bool(enable_reshard_cache);
 
 namespace paddle::experimental {
 
@@ -723,6 +724,29 @@ std::string ReshardDebugInfo(
   return sstream.str();
 }
 
+// With FLAGS_enable_reshard_cache, the same reshard of an unchanged input is
+// done once while its result is alive, e.g. the reshard of a weight in the
+// forward is reused by the backward which saved it.
+static std::shared_ptr<phi::distributed::DistTensor> ReshardWithCache(
+    phi::DeviceContext* dev_ctx,
+    phi::distributed::DistTensor* dist_tensor,
+    const phi::distributed::TensorDistAttr& dist_attr) {
+  if (FLAGS_enable_reshard_cache) {
+    auto cached = dist_tensor->GetReshardCache(dist_attr);
+    if (cached != nullptr) {
+      VLOG(4) << "Reuse the cached reshard result.";
+      return cached;
+    }
+  }
+  auto* func =
+      phi::distributed::ChooseProperReshardFunction(*dist_tensor, dist_attr);
+  auto out = func->Eval(dev_ctx, *dist_tensor, dist_attr);
+  if (FLAGS_enable_reshard_cache) {
+    dist_tensor->SetReshardCache(dist_attr, out);
+  }
+  return out;
+}
+
 std::shared_ptr<phi::distributed::DistTensor> ReshardApiInputToKernelInput(
     phi::DeviceContext* dev_ctx,
     const Tensor& tensor,
@@ -744,9 +768,7 @@ std::shared_ptr<phi::distributed::DistTensor> ReshardApiInputToKernelInput(
       auto tensor_name = (tensor.name().empty() ? "None" : tensor.name());
       VLOG(4) << "Reshard input: " << argument_name << "(" << tensor_name
               << ") " << ReshardDebugInfo(*dist_tensor, tensor_dist_attr);
-      auto* func = phi::distributed::ChooseProperReshardFunction(
-          *dist_tensor, tensor_dist_attr);
-      return func->Eval(dev_ctx, *dist_tensor, tensor_dist_attr);
+      return ReshardWithCache(dev_ctx, dist_tensor, tensor_dist_attr);
     }
     return std::static_pointer_cast<phi::distributed::DistTensor>(tensor_in);
   }
@@ -789,9 +811,7 @@ ReshardApiInputToKernelInput(phi::DeviceContext* dev_ctx,
             (tensors[i].name().empty() ? "None" : tensors[i].name());
         VLOG(4) << "Reshard input: " << argument_name << "(" << tensor_name
                 << ") " << ReshardDebugInfo(*dist_tensor, dist_attr);
-        auto* func = phi::distributed::ChooseProperReshardFunction(*dist_tensor,
-                                                                   dist_attr);
-        out.push_back(func->Eval(dev_ctx, *dist_tensor, dist_attr));
+        out.push_back(ReshardWithCache(dev_ctx, dist_tensor, dist_attr));
       } else {
         out.push_back(
             std::static_pointer_cast<phi::distributed::DistTensor>(tensor_in));
@@ -27,6 +27,10 @@ limitations under the License. */
 #include <unistd.h>
 #endif  // _WIN32
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 #ifdef PADDLE_WITH_XBYAK
 #include "xbyak/xbyak_util.h"
 #endif
@@ -197,4 +201,40 @@ bool MayIUse(const cpu_isa_t cpu_isa) {
 }
 #endif
 
+int GetCpuCount() {
+#ifdef __linux__
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+    return CPU_COUNT(&mask);
+  }
+#endif
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return static_cast<int>(info.dwNumberOfProcessors);
+#else
+  return static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+#endif
+}
+
+bool SetCurrentThreadAffinity(const std::vector<int>& cpus) {
+#ifdef __linux__
+  if (cpus.empty()) {
+    return false;
+  }
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for (int cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      return false;
+    }
+    CPU_SET(cpu, &mask);
+  }
+  return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#else
+  return false;
+#endif
+}
+
 }  // namespace phi::backends::cpu
@@ -16,6 +16,8 @@
 
 #include <stddef.h>
 
+#include <vector>
+
 #ifdef _WIN32
 #if defined(__AVX2__)
 #include <immintrin.h>  // avx2
@@ -92,6 +94,13 @@ typedef enum {
 
 // May I use some instruction
 TEST_API bool MayIUse(const cpu_isa_t cpu_isa);
+
+// The number of the cpus the process can run on.
+TEST_API int GetCpuCount();
+
+// Binds the calling thread to the cpus, returns false if it fails or the
+// platform does not support thread affinity.
+TEST_API bool SetCurrentThreadAffinity(const std::vector<int>& cpus);
 }  // namespace cpu
 }  // namespace backends
 }  // namespace phi
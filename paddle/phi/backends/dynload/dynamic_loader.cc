@@ -14,8 +14,10 @@ limitations under the License. */
 #include "paddle/phi/backends/dynload/dynamic_loader.h"
 #include <dirent.h>
 
+#include <chrono>
 #include <codecvt>
 #include <cstdlib>
+#include <mutex>
 #include <string>
 #include <vector>
 #include "paddle/phi/backends/dynload/cupti_lib_path.h"
@@ -170,6 +172,14 @@ static inline std::vector<std::string> split(
   return str_list;
 }
 
+static std::mutex s_dso_load_records_mutex;
+static std::vector<DsoLoadRecord> s_dso_load_records;
+
+std::vector<DsoLoadRecord> GetDsoLoadRecords() {
+  std::lock_guard<std::mutex> lock(s_dso_load_records_mutex);
+  return s_dso_load_records;
+}
+
 void SetPaddleLibPath(const std::string& py_site_pkg_path) {
   s_py_site_pkg_path.path = py_site_pkg_path;
   VLOG(3) << "Set paddle lib path : " << py_site_pkg_path;
@@ -288,6 +298,7 @@ static inline void* GetDsoHandleFromSearchPath(
     AddDllDirectory(search_path.c_str());
   }
 #endif
+  auto start = std::chrono::steady_clock::now();
   std::vector<std::string> dso_names = split(dso_name, ";");
   void* dso_handle = nullptr;
   for (auto const& dso : dso_names) {
@@ -306,6 +317,14 @@ static inline void* GetDsoHandleFromSearchPath(
     }
     if (nullptr != dso_handle) break;
   }
+  {
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    VLOG(3) << "Search " << dso_name << " in " << elapsed.count() << " ms";
+    std::lock_guard<std::mutex> lock(s_dso_load_records_mutex);
+    s_dso_load_records.push_back(
+        DsoLoadRecord{dso_name, dso_handle != nullptr, elapsed.count()});
+  }
 
   // 4. [If Failed for All dso_names] logging warning if exists
   if (nullptr == dso_handle && !warning_msg.empty()) {
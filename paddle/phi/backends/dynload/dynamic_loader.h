@@ -14,6 +14,7 @@ limitations under the License. */
 
 #pragma once
 #include <string>
+#include <vector>
 #include "paddle/utils/test_macros.h"
 namespace phi {
 namespace dynload {
@@ -53,5 +54,16 @@ void* GetAfsApiDsoHandle();
 
 void SetPaddleLibPath(const std::string&);
 
+// The loading of a third-party library, the libraries are loaded on the
+// first call of their functions.
+struct DsoLoadRecord {
+  std::string name;
+  bool loaded;
+  double elapsed_ms;
+};
+
+// Returns the libraries searched so far, in the loading order.
+std::vector<DsoLoadRecord> GetDsoLoadRecords();
+
 }  // namespace dynload
 }  // namespace phi
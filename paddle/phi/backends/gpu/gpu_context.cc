@@ -25,6 +25,7 @@ limitations under the License. */
 
 #include "glog/logging.h"
 #include "paddle/common/exception.h"
+#include "paddle/common/flags.h"
 #include "paddle/phi/backends/context_pool.h"
 #include "paddle/phi/backends/gpu/gpu_decls.h"
 #include "paddle/phi/backends/gpu/gpu_info.h"
@@ -57,6 +58,8 @@ limitations under the License. */
 
 #include "paddle/phi/core/enforce.h"
 
+COMMON_DECLARE_bool(reuse_dnn_workspace);
+
 namespace phi {
 
 namespace internal {
@@ -173,7 +176,7 @@ void DnnWorkspaceHandle::RunFuncSync(
   if (need_realloc && !use_cached_allocation) {
     void* workspace_ptr = nullptr;
     size_t size = ((required_workspace_bytes + 255) >> 8) << 8;
-    std::lock_guard<std::mutex> guard(*mtx_);
+    std::lock_guard<std::mutex> guard(mutex());
 #ifdef PADDLE_WITH_HIP
     auto status = hipMalloc(&workspace_ptr, size);
 #else
@@ -198,13 +201,13 @@ void DnnWorkspaceHandle::RunFuncSync(
   }
 }
 
-void DnnWorkspaceHandle::ResetWorkspace() { allocation_ = nullptr; }
+void DnnWorkspaceHandle::ResetWorkspace() { allocation() = nullptr; }
 
 void DnnWorkspaceHandle::ReallocWorkspace(size_t required_workspace_bytes) {
   if (required_workspace_bytes <= WorkspaceSize()) return;
   // reset allocation first before re-allocate to save memory
-  allocation_.reset();
-  allocation_ = allocator_->Allocate(required_workspace_bytes);
+  allocation().reset();
+  allocation() = allocator_->Allocate(required_workspace_bytes);
 }
 
 struct GPUContext::Impl {
@@ -308,6 +311,15 @@ struct GPUContext::Impl {
                             common::errors::InvalidArgument(
                                 "The device allocator for GPU context is "
                                 "nullptr. It must not be null."));
+    if (FLAGS_reuse_dnn_workspace) {
+      std::lock_guard<std::mutex> guard(shared_workspace_mtx_);
+      // The workspace of another stream may still be used by its kernels.
+      if (shared_workspace_ == nullptr ||
+          shared_workspace_->stream != stream()) {
+        shared_workspace_ = std::make_shared<DnnSharedWorkspace>(stream());
+      }
+      return DnnWorkspaceHandle(allocator_, shared_workspace_);
+    }
     return DnnWorkspaceHandle(allocator_, stream());
   }
 
@@ -809,6 +821,8 @@ struct GPUContext::Impl {
   sparseHandle_t sparse_handle_{nullptr};
   std::function<sparseHandle_t()> sparse_handle_creator_{nullptr};
   DnnWorkspaceHandle* workspace_{nullptr};
+  std::shared_ptr<DnnSharedWorkspace> shared_workspace_{nullptr};
+  std::mutex shared_workspace_mtx_;
 
   std::once_flag flag_sparse_;
   std::once_flag flag_blas_;
@@ -20,6 +20,7 @@ limitations under the License. */
 
 #include <array>
 #include <functional>
+#include <memory>
 #include <mutex>
 
 #include "paddle/phi/backends/gpu/forwards.h"
@@ -34,6 +35,18 @@ namespace phi {
 
 class CUDAStream;
 
+// The workspace shared by the handles of a GPUContext with
+// FLAGS_reuse_dnn_workspace, so that the kernels on its stream reuse one
+// allocation. The kernels run in the order of the stream, so the workspace
+// is free for the next kernel once the previous one is launched.
+struct DnnSharedWorkspace {
+  explicit DnnSharedWorkspace(gpuStream_t stream) : stream(stream) {}
+
+  Allocator::AllocationPtr allocation{nullptr};
+  gpuStream_t stream{nullptr};  // Not owned
+  std::mutex mtx;
+};
+
 class DnnWorkspaceHandle {
  public:
   inline DnnWorkspaceHandle(Allocator* allocator, gpuStream_t stream)
@@ -41,15 +54,19 @@ class DnnWorkspaceHandle {
     mtx_ = std::make_unique<std::mutex>();
   }
 
+  inline DnnWorkspaceHandle(Allocator* allocator,
+                            std::shared_ptr<DnnSharedWorkspace> shared)
+      : allocator_(allocator),
+        stream_(shared->stream),
+        shared_(std::move(shared)) {}
+
   inline void RunFunc(const std::function<void(void*)>& cudnn_func,
                       size_t required_workspace_bytes) {
+    std::lock_guard<std::mutex> guard(mutex());
     if (required_workspace_bytes > WorkspaceSize()) {
       ReallocWorkspace(required_workspace_bytes);
     }
-    {
-      std::lock_guard<std::mutex> guard(*mtx_);
-      cudnn_func(allocation_ ? allocation_->ptr() : nullptr);
-    }
+    cudnn_func(allocation() ? allocation()->ptr() : nullptr);
   }
 
   /*! \brief Thread which call RunFuncSync() would release gpu memory after
@@ -61,10 +78,10 @@ class DnnWorkspaceHandle {
                    bool use_cached_allocation = true);
 
   inline size_t WorkspaceSize() {
-    if (allocation_ == nullptr) {
+    if (allocation() == nullptr) {
       return 0;
     }
-    return allocation_->size();
+    return allocation()->size();
   }
 
   void ResetWorkspace();
@@ -75,10 +92,17 @@ class DnnWorkspaceHandle {
   DnnWorkspaceHandle& operator=(DnnWorkspaceHandle&&) = delete;
 
  private:
+  inline Allocator::AllocationPtr& allocation() {
+    return shared_ ? shared_->allocation : allocation_;
+  }
+
+  inline std::mutex& mutex() { return shared_ ? shared_->mtx : *mtx_; }
+
   Allocator::AllocationPtr allocation_{nullptr};
   Allocator* allocator_{nullptr};  // Not owned
   gpuStream_t stream_{nullptr};    // Not owned
   std::unique_ptr<std::mutex> mtx_;
+  std::shared_ptr<DnnSharedWorkspace> shared_{nullptr};
 };
 
 class PADDLE_API GPUContext : public DeviceContext,
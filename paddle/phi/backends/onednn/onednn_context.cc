@@ -14,6 +14,8 @@
 #ifdef PADDLE_WITH_DNNL
 #include "paddle/phi/backends/onednn/onednn_context.h"
 
+#include <list>
+
 #include "paddle/phi/common/place.h"
 #include "paddle/phi/core/enforce.h"
 #include "paddle/utils/flat_hash_map.h"
@@ -107,6 +109,8 @@ struct OneDNNContext::Impl {
       // objects allocated when using given executor
       if (ptr == nullptr) {
         p_blobmap_->clear();
+        shape_lru_.clear();
+        shape_lru_pos_.clear();
       } else {
         // Iterate through all shapes and release
         // for each shape and active executor all entries
@@ -155,8 +159,20 @@ struct OneDNNContext::Impl {
             << "\n";
   }
 
-  void RemoveShapeEntriesWithExecutor() const {
-    p_exec_items_->erase(p_exec_items_->begin());
+  void RemoveShapeEntriesWithExecutor(const std::string& shape) const {
+    p_exec_items_->erase(shape);
+  }
+
+  // Marks the input shape as the most recently used one of the cache clearing
+  // session, the least recently used shape is evicted first.
+  void TouchShape(const std::string& shape) const {
+    auto it = shape_lru_pos_.find(shape);
+    if (it != shape_lru_pos_.end()) {
+      shape_lru_.splice(shape_lru_.begin(), shape_lru_, it->second);
+    } else {
+      shape_lru_.push_front(shape);
+      shape_lru_pos_[shape] = shape_lru_.begin();
+    }
   }
 
   void BlockNextCacheClearing() {
@@ -202,27 +218,34 @@ struct OneDNNContext::Impl {
     }
 
     // Find KeyBlob for current input shape
-    auto key_it = sBlob->find(OneDNNContext::tls().cur_input_shape_str);
+    const auto& shape = OneDNNContext::tls().cur_input_shape_str;
+    bool cache_clearing =
+        (static_cast<size_t>(sid) ==
+         OneDNNContextThreadLocals::kMKLDNNSessionID_CacheClearing);
+    auto key_it = sBlob->find(shape);
 
     if (key_it == sBlob->end()) {
       // In cache clearing mode, cur_input_shape_cache_capacity defines
       // max pblob capacity
-      if ((static_cast<size_t>(sid) ==
-           OneDNNContextThreadLocals::kMKLDNNSessionID_CacheClearing) &&
-          !sBlob->empty() &&
-          (sBlob->size() >=
-           static_cast<size_t>(
-               OneDNNContext::tls().cur_input_shape_cache_capacity))) {
-        VLOG(2) << "sid=" << sid
-                << ", remove all blobs of shape: " << sBlob->begin()->first;
-        sBlob->erase(sBlob->begin()->first);
-        RemoveShapeEntriesWithExecutor();
+      while (cache_clearing && !shape_lru_.empty() &&
+             (sBlob->size() >=
+              static_cast<size_t>(
+                  OneDNNContext::tls().cur_input_shape_cache_capacity))) {
+        std::string evicted = shape_lru_.back();
+        VLOG(2) << "sid=" << sid << ", remove all blobs of shape: " << evicted;
+        shape_lru_pos_.erase(evicted);
+        shape_lru_.pop_back();
+        sBlob->erase(evicted);
+        RemoveShapeEntriesWithExecutor(evicted);
       }
       pBlob = std::make_shared<KeyBlob>();
-      (*sBlob)[OneDNNContext::tls().cur_input_shape_str] = pBlob;
+      (*sBlob)[shape] = pBlob;
     } else {
       pBlob = key_it->second;
     }
+    if (cache_clearing) {
+      TouchShape(shape);
+    }
 
     // Find Blob via name
     auto blob_it = pBlob->find(name);
@@ -278,6 +301,10 @@ struct OneDNNContext::Impl {
       return nullptr;
     }
     pBlob = sBlob_it->second;
+    if (static_cast<size_t>(sid) ==
+        OneDNNContextThreadLocals::kMKLDNNSessionID_CacheClearing) {
+      TouchShape(sBlob_it->first);
+    }
 
     // Find Blob via name
     auto key_it = pBlob->find(name);
@@ -362,6 +389,11 @@ struct OneDNNContext::Impl {
   // to erase
   std::shared_ptr<ExecShape> p_exec_items_;
   std::shared_ptr<std::mutex> p_mutex_;
+  // Input shapes of the cache clearing session from the most recently used to
+  // the least recently used one, guarded by p_mutex_
+  mutable std::list<std::string> shape_lru_;
+  mutable std::unordered_map<std::string, std::list<std::string>::iterator>
+      shape_lru_pos_;
   // 0 - clearing is allowed. x > 0 do not clear.
   unsigned int block_next_cache_clearing_ = 0;
 
@@ -140,7 +140,9 @@ bool XPUL3Planner::RunAutotune(
           << l3_global_ratio * 100 << " %";
 
   size_t block_l3_size =
-      std::accumulate(res.back().choices.begin(), res.back().choices.end(), 0);
+      std::accumulate(res.back().choices.begin(),
+                      res.back().choices.end(),
+                      static_cast<size_t>(0));
   size_t xdnn_ctx_l3_size = (l3_size - block_l3_size) / 64 * 64;
 
   VLOG(3) << "Block L3 Size : " << block_l3_size
@@ -325,6 +325,46 @@ void DistTensor::unsafe_set_skip_check_mesh(bool skip) {
   dist_attr_.set_skip_check_mesh(skip);
 }
 
+std::shared_ptr<DistTensor> DistTensor::GetReshardCache(
+    const TensorDistAttr& dist_attr) {
+  auto out = reshard_cache_.out.lock();
+  if (out == nullptr || reshard_cache_.dst_dist_attr != dist_attr ||
+      reshard_cache_.src_dist_attr != dist_attr_ ||
+      out->dist_attr_ != reshard_cache_.out_dist_attr) {
+    return nullptr;
+  }
+  const auto& src_holder = value_->Holder();
+  const auto& out_holder = out->value_->Holder();
+  if (src_holder == nullptr || out_holder == nullptr ||
+      reshard_cache_.src_holder.lock() != src_holder ||
+      reshard_cache_.out_holder.lock() != out_holder ||
+      reshard_cache_.src_version !=
+          value_->InplaceVersionCounter().CurrentVersion() ||
+      reshard_cache_.out_version !=
+          out->value_->InplaceVersionCounter().CurrentVersion()) {
+    return nullptr;
+  }
+  return out;
+}
+
+void DistTensor::SetReshardCache(const TensorDistAttr& dist_attr,
+                                 const std::shared_ptr<DistTensor>& out) {
+  reshard_cache_ = ReshardCache();
+  if (out == nullptr || value_->Holder() == nullptr ||
+      out->value_->Holder() == nullptr) {
+    return;
+  }
+  reshard_cache_.src_dist_attr = dist_attr_;
+  reshard_cache_.src_holder = value_->Holder();
+  reshard_cache_.src_version = value_->InplaceVersionCounter().CurrentVersion();
+  reshard_cache_.dst_dist_attr = dist_attr;
+  reshard_cache_.out_dist_attr = out->dist_attr_;
+  reshard_cache_.out_holder = out->value_->Holder();
+  reshard_cache_.out_version =
+      out->value_->InplaceVersionCounter().CurrentVersion();
+  reshard_cache_.out = out;
+}
+
 void DistTensor::clear() {
   if (value_) {
     value_->clear();
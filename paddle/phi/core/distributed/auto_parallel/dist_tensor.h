@@ -195,11 +195,36 @@ class DistTensor final
 
   bool skip_check_mesh() const { return dist_attr_.skip_check_mesh(); }
 
+  /// \brief Returns the result of resharding the current tensor to dist_attr
+  /// cached by SetReshardCache.
+  /// \return The resharded tensor, or nullptr if the result has been
+  /// released, or the current tensor or the result has changed since.
+  std::shared_ptr<DistTensor> GetReshardCache(const TensorDistAttr& dist_attr);
+
+  /// \brief Caches the result of resharding the current tensor to dist_attr,
+  /// without keeping the result alive.
+  /// \return void
+  void SetReshardCache(const TensorDistAttr& dist_attr,
+                       const std::shared_ptr<DistTensor>& out);
+
   void clear();
 
  private:
   friend class ReshardFunction;
 
+  // The last reshard of the tensor, and the holders and the inplace versions
+  // of the tensor and the result when it was cached.
+  struct ReshardCache {
+    TensorDistAttr src_dist_attr;
+    std::weak_ptr<phi::Allocation> src_holder;
+    uint32_t src_version{0};
+    TensorDistAttr dst_dist_attr;
+    TensorDistAttr out_dist_attr;
+    std::weak_ptr<phi::Allocation> out_holder;
+    uint32_t out_version{0};
+    std::weak_ptr<DistTensor> out;
+  };
+
   // The global dimensions(shape), will move to DistTensorMeta
   DDim global_dims_;
   // The distributed attributes, will remove in the future
@@ -210,6 +235,8 @@ class DistTensor final
   ProcessMesh process_mesh_;
 
   Placements placements_;
+
+  ReshardCache reshard_cache_;
 };
 
 }  // namespace distributed
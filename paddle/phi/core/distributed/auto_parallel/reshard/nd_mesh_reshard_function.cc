@@ -15,6 +15,7 @@
 #include "paddle/phi/core/distributed/auto_parallel/reshard/nd_mesh_reshard_function.h"
 
 #include "glog/logging.h"
+#include "paddle/common/flags.h"
 #include "paddle/phi/common/int_array.h"
 #include "paddle/phi/core/distributed/auto_parallel/dist_attr.h"
 #include "paddle/phi/core/distributed/auto_parallel/dist_tensor.h"
@@ -22,11 +23,15 @@
 #include "paddle/phi/core/distributed/auto_parallel/reshard/p_to_s_reshard_function.h"
 #include "paddle/phi/core/distributed/auto_parallel/reshard/r_to_p_reshard_function.h"
 #include "paddle/phi/core/distributed/auto_parallel/reshard/r_to_s_reshard_function.h"
+#include "paddle/phi/core/distributed/auto_parallel/reshard/reshard_function_registry.h"
+#include "paddle/phi/core/distributed/auto_parallel/reshard/reshard_planner.h"
 #include "paddle/phi/core/distributed/auto_parallel/reshard/reshard_utils.h"
 #include "paddle/phi/core/distributed/auto_parallel/reshard/s_to_r_reshard_function.h"
 #include "paddle/phi/core/distributed/auto_parallel/reshard/same_status_reshard_function.h"
 #include "paddle/phi/core/distributed/store/store_utils.h"
 
+COMMON_DECLARE_bool(enable_reshard_planner);
+
 namespace phi::distributed {
 
 namespace {
@@ -73,6 +78,23 @@ int64_t FindFirstDiffShardAxis(const TensorDistAttr& in_dist_attr,
   return axis;
 }
 
+// Returns the one dim dist attr on the sub mesh of the status.
+TensorDistAttr GetOneDimDistAttr(const DDim& dims,
+                                 const ProcessMesh& sub_mesh,
+                                 const MeshAxisStatus& status) {
+  TensorDistAttr dist_attr(common::vectorize(dims));
+  dist_attr.set_process_mesh(sub_mesh);
+  if (status.shard_axis != -1) {
+    std::vector<int64_t> dims_mapping = dist_attr.dims_mapping();
+    dims_mapping[status.shard_axis] = 0;
+    dist_attr.set_dims_mapping(dims_mapping);
+  }
+  if (status.partial) {
+    dist_attr.set_partial_status(std::vector<int64_t>{0}, status.reduce_type);
+  }
+  return dist_attr;
+}
+
 }  // namespace
 
 bool SameNdMeshReshardFunction::IsSuitable(
@@ -272,6 +294,87 @@ void SameNdMeshReshardFunction::Eval(phi::DeviceContext* dev_ctx,
   }
 }
 
+bool PlannedNdMeshReshardFunction::IsSuitable(
+    const DistTensor& in, const TensorDistAttr& out_dist_attr) {
+  RESHARD_SHORTCUT_IF_FALSE(FLAGS_enable_reshard_planner);
+  RESHARD_SHORTCUT_IF_FALSE(in.dist_attr().process_mesh() ==
+                            out_dist_attr.process_mesh());
+  RESHARD_SHORTCUT_IF_FALSE(out_dist_attr.process_mesh().ndim() > 1);
+  RESHARD_SHORTCUT_IF_FALSE(in.dist_attr() != out_dist_attr);
+
+  auto plan = ReshardPlanner::Instance().Plan(
+      in.dist_attr(), out_dist_attr, in.dims(), in.dtype());
+  RESHARD_SHORTCUT_IF_FALSE(plan != nullptr && !plan->steps.empty());
+
+  return true;
+}
+
+void PlannedNdMeshReshardFunction::Eval(DeviceContext* dev_ctx,
+                                        const DistTensor& in,
+                                        const TensorDistAttr& out_dist_attr,
+                                        DistTensor* out) {
+  VLOG(3) << "Call " << Name();
+  const auto& process_mesh = out_dist_attr.process_mesh();
+  auto plan = ReshardPlanner::Instance().Plan(
+      in.dist_attr(), out_dist_attr, in.dims(), in.dtype());
+  PADDLE_ENFORCE_NOT_NULL(
+      plan,
+      common::errors::InvalidArgument(
+          "Can not plan the reshard from %s to %s.",
+          in.dist_attr().to_string(),
+          out_dist_attr.to_string()));
+  VLOG(3) << "Reshard plan: " << plan->to_string();
+
+  // Backup out_dist_attr to to avoid overwriting the out's dist attr
+  auto out_dist_attr_orig = out_dist_attr;
+
+  SetValue(out, in.value());
+  SetDistProps(out, in.dims(), in.dist_attr());
+
+  for (const auto& step : plan->steps) {
+    int64_t mesh_axis = step.mesh_axis;
+    VLOG(3) << "Reshard mesh axis " << mesh_axis << " from "
+            << step.in.to_string() << " to " << step.out.to_string();
+    // 1. Calculate the dist_attr after this step
+    TensorDistAttr real_out_dist_attr(out->dist_attr());
+    if (real_out_dist_attr.is_partial(mesh_axis)) {
+      real_out_dist_attr.clean_partial_dims({mesh_axis});
+    }
+    std::vector<int64_t> real_dims_mapping = real_out_dist_attr.dims_mapping();
+    for (auto& dim : real_dims_mapping) {
+      if (dim == mesh_axis) {
+        dim = -1;
+      }
+    }
+    if (step.out.shard_axis != -1) {
+      real_dims_mapping[step.out.shard_axis] = mesh_axis;
+    }
+    real_out_dist_attr.set_dims_mapping(real_dims_mapping);
+    if (step.out.partial) {
+      real_out_dist_attr.set_partial_status(std::vector<int64_t>{mesh_axis},
+                                            step.out.reduce_type);
+    }
+
+    // 2. Calculate the one dim dist attrs on the sub mesh of the axis
+    ProcessMesh sub_mesh = GetSubProcessMesh(process_mesh, mesh_axis);
+    TensorDistAttr in_one_dim_dist_attr =
+        GetOneDimDistAttr(in.dims(), sub_mesh, step.in);
+    TensorDistAttr out_one_dim_dist_attr =
+        GetOneDimDistAttr(in.dims(), sub_mesh, step.out);
+
+    // 3. Reshard by the one dim reshard function
+    SetDistProps(out, in_one_dim_dist_attr);
+    DistTensor tmp_result;
+    auto* func = ChooseProperReshardFunction(*out, out_one_dim_dist_attr);
+    func->Eval(dev_ctx, *out, out_one_dim_dist_attr, &tmp_result);
+
+    // 4. Reset to the right dist attr
+    SetValue(out, tmp_result.value());
+    SetDistProps(out, real_out_dist_attr);
+  }
+  SetDistProps(out, out_dist_attr_orig);
+}
+
 bool CrossNdMeshReshardFunction::IsSuitable(
     const DistTensor& in, const TensorDistAttr& out_dist_attr) {
   const ProcessMesh& in_process_mesh = in.dist_attr().process_mesh();
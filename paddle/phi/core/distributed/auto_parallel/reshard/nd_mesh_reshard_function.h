@@ -32,6 +32,21 @@ class SameNdMeshReshardFunction final : public ReshardFunction {
   std::string Name() override { return "SameNdMeshReshard"; }
 };
 
+// Reshards on the same nd mesh by the plan of ReshardPlanner, which is only
+// suitable when FLAGS_enable_reshard_planner is set and a plan is found.
+class PlannedNdMeshReshardFunction final : public ReshardFunction {
+ public:
+  bool IsSuitable(const DistTensor& in,
+                  const TensorDistAttr& out_dist_attr) override;
+
+  void Eval(DeviceContext* dev_ctx,
+            const DistTensor& in,
+            const TensorDistAttr& out_dist_attr,
+            DistTensor* out) override;
+
+  std::string Name() override { return "PlannedNdMeshReshard"; }
+};
+
 class CrossNdMeshReshardFunction final : public ReshardFunction {
  public:
   bool IsSuitable(const DistTensor& in,
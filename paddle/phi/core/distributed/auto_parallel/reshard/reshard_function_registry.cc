@@ -73,6 +73,7 @@ REGISTER_RESHARD_FUNC(SToSReshardFunctionCrossMesh);
 REGISTER_RESHARD_FUNC(XToRShrinkReshardFunction);
 REGISTER_RESHARD_FUNC(RToXExpandReshardFunction);
 REGISTER_RESHARD_FUNC(SameStatusReshardFunction);
+REGISTER_RESHARD_FUNC(PlannedNdMeshReshardFunction);
 REGISTER_RESHARD_FUNC(SameNdMeshReshardFunction);
 REGISTER_RESHARD_FUNC(CrossNdMeshReshardFunction);
 REGISTER_RESHARD_FUNC(GlobalToSubMeshReshardFunction);
@@ -0,0 +1,292 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/distributed/auto_parallel/reshard/reshard_planner.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <sstream>
+#include <utility>
+
+#include "glog/logging.h"
+
+#include "paddle/common/flags.h"
+#include "paddle/phi/core/distributed/auto_parallel/dist_attr.h"
+#include "paddle/utils/string/split.h"
+
+COMMON_DECLARE_string(reshard_planner_mesh_axis_bandwidth);
+COMMON_DECLARE_double(reshard_planner_latency_us);
+
+namespace phi::distributed {
+
+namespace {
+
+constexpr double kDefaultBandwidthGBps = 100.0;
+// The number of the candidate status of every mesh axis: the input status,
+// replicated and the output status.
+constexpr int64_t kNumChoices = 3;
+constexpr int64_t kMaxPlanMeshDims = 8;
+
+double GetMeshAxisBandwidth(int64_t mesh_axis) {
+  auto items = paddle::string::Split(FLAGS_reshard_planner_mesh_axis_bandwidth,
+                                     ',');
+  if (mesh_axis < static_cast<int64_t>(items.size())) {
+    double bandwidth = std::stod(items[mesh_axis]);
+    if (bandwidth > 0) {
+      return bandwidth;
+    }
+  }
+  return kDefaultBandwidthGBps;
+}
+
+// Returns true if no tensor axis is sharded by more than one mesh axis.
+bool IsValidStatus(const std::vector<MeshAxisStatus>& status) {
+  for (size_t i = 0; i < status.size(); ++i) {
+    if (status[i].shard_axis == -1) {
+      continue;
+    }
+    for (size_t j = i + 1; j < status.size(); ++j) {
+      if (status[i].shard_axis == status[j].shard_axis) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Returns true if the one dim reshard functions could do the step directly.
+bool IsSupportedStep(const MeshAxisStatus& in,
+                     const MeshAxisStatus& out,
+                     const DDim& dims,
+                     int64_t mesh_axis_size) {
+  if (in.partial && out.partial) {
+    return false;
+  }
+  if (in.shard_axis != -1 && out.shard_axis != -1) {
+    return dims[in.shard_axis] % mesh_axis_size == 0 &&
+           dims[out.shard_axis] % mesh_axis_size == 0;
+  }
+  return true;
+}
+
+}  // namespace
+
+std::string MeshAxisStatus::to_string() const {
+  if (partial) {
+    int index = static_cast<int>(reduce_type);
+    return "P(" + std::string(ReduceTypeStrings[index]) + ")";
+  }
+  if (shard_axis != -1) {
+    return "S(" + std::to_string(shard_axis) + ")";
+  }
+  return "R";
+}
+
+std::string ReshardPlan::to_string() const {
+  std::ostringstream oss;
+  oss << "{cost: " << cost << "us, steps: [";
+  for (size_t i = 0; i < steps.size(); ++i) {
+    if (i != 0) {
+      oss << ", ";
+    }
+    oss << "mesh_axis " << steps[i].mesh_axis << ": "
+        << steps[i].in.to_string() << "->" << steps[i].out.to_string();
+  }
+  oss << "]}";
+  return oss.str();
+}
+
+ReshardPlanner& ReshardPlanner::Instance() {
+  static ReshardPlanner planner;
+  return planner;
+}
+
+std::vector<MeshAxisStatus> ReshardPlanner::GetMeshAxisStatus(
+    const TensorDistAttr& dist_attr) {
+  std::vector<MeshAxisStatus> status(dist_attr.process_mesh().ndim());
+  const auto& dims_mapping = dist_attr.dims_mapping();
+  for (size_t i = 0; i < dims_mapping.size(); ++i) {
+    if (dims_mapping[i] != -1) {
+      status[dims_mapping[i]].shard_axis = static_cast<int64_t>(i);
+    }
+  }
+  for (const auto& kv : dist_attr.partial_status()) {
+    status[kv.first].partial = true;
+    status[kv.first].reduce_type = kv.second;
+  }
+  return status;
+}
+
+double ReshardPlanner::StepCost(const ReshardStep& step,
+                                int64_t mesh_axis_size,
+                                double bytes) {
+  const auto& in = step.in;
+  const auto& out = step.out;
+  // Only takes the local slice or fills zeros.
+  if (in.is_replicated()) {
+    return 0;
+  }
+  double n = static_cast<double>(mesh_axis_size);
+  // GB/s is 1e3 bytes/us
+  double bytes_per_us = GetMeshAxisBandwidth(step.mesh_axis) * 1e3;
+  double latency = FLAGS_reshard_planner_latency_us;
+  if (in.partial) {
+    if (out.is_replicated()) {
+      // all reduce
+      return latency + 2 * (n - 1) / n * bytes / bytes_per_us;
+    }
+    // reduce scatter
+    return latency + (n - 1) / n * bytes / bytes_per_us;
+  }
+  if (out.shard_axis != -1) {
+    // all to all
+    return latency + (n - 1) / n * bytes / bytes_per_us;
+  }
+  // all gather, the partial output is made from the replicated one
+  return latency + (n - 1) * bytes / bytes_per_us;
+}
+
+std::shared_ptr<const ReshardPlan> ReshardPlanner::Plan(
+    const TensorDistAttr& in_dist_attr,
+    const TensorDistAttr& out_dist_attr,
+    const DDim& dims,
+    DataType dtype) {
+  std::string key = in_dist_attr.to_string() + "->" +
+                    out_dist_attr.to_string() + ":" + dims.to_str() + ":" +
+                    DataTypeToString(dtype);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = cache_.find(key);
+  if (iter != cache_.end()) {
+    return iter->second;
+  }
+  auto plan = Search(in_dist_attr, out_dist_attr, dims, dtype);
+  if (plan) {
+    VLOG(3) << "Reshard plan from " << in_dist_attr << " to " << out_dist_attr
+            << " with dims [" << dims << "]: " << plan->to_string();
+  }
+  cache_.emplace(key, plan);
+  return plan;
+}
+
+std::shared_ptr<const ReshardPlan> ReshardPlanner::Search(
+    const TensorDistAttr& in_dist_attr,
+    const TensorDistAttr& out_dist_attr,
+    const DDim& dims,
+    DataType dtype) {
+  const auto& process_mesh = out_dist_attr.process_mesh();
+  int64_t ndim = process_mesh.ndim();
+  if (in_dist_attr.process_mesh() != process_mesh || ndim > kMaxPlanMeshDims) {
+    return nullptr;
+  }
+  double total_bytes = static_cast<double>(SizeOf(dtype));
+  for (int i = 0; i < dims.size(); ++i) {
+    if (dims[i] < 0) {
+      return nullptr;
+    }
+    total_bytes *= static_cast<double>(dims[i]);
+  }
+
+  auto in_status = GetMeshAxisStatus(in_dist_attr);
+  auto out_status = GetMeshAxisStatus(out_dist_attr);
+  std::vector<std::vector<MeshAxisStatus>> candidates(ndim);
+  for (int64_t i = 0; i < ndim; ++i) {
+    candidates[i] = {in_status[i], MeshAxisStatus(), out_status[i]};
+  }
+
+  // The state is the choice of every mesh axis encoded in base kNumChoices.
+  int64_t num_states = 1;
+  for (int64_t i = 0; i < ndim; ++i) {
+    num_states *= kNumChoices;
+  }
+  auto decode = [&](int64_t state) {
+    std::vector<MeshAxisStatus> status(ndim);
+    for (int64_t i = 0; i < ndim; ++i) {
+      status[i] = candidates[i][state % kNumChoices];
+      state /= kNumChoices;
+    }
+    return status;
+  };
+
+  std::vector<double> dist(num_states, std::numeric_limits<double>::max());
+  std::vector<int64_t> prev_state(num_states, -1);
+  std::vector<ReshardStep> prev_step(num_states);
+  using Item = std::pair<double, int64_t>;
+  std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+  dist[0] = 0;
+  queue.emplace(0, 0);
+
+  int64_t goal = -1;
+  while (!queue.empty()) {
+    auto [cost, state] = queue.top();
+    queue.pop();
+    if (cost > dist[state]) {
+      continue;
+    }
+    auto status = decode(state);
+    if (status == out_status) {
+      goal = state;
+      break;
+    }
+    double local_bytes = total_bytes;
+    for (int64_t i = 0; i < ndim; ++i) {
+      if (status[i].shard_axis != -1) {
+        local_bytes /= static_cast<double>(process_mesh.dim_size(i));
+      }
+    }
+    int64_t base = 1;
+    for (int64_t i = 0; i < ndim; ++i, base *= kNumChoices) {
+      int64_t choice = (state / base) % kNumChoices;
+      // Never moves back to the input status.
+      for (int64_t next_choice = 1; next_choice < kNumChoices; ++next_choice) {
+        const auto& next = candidates[i][next_choice];
+        if (next_choice == choice || next == status[i]) {
+          continue;
+        }
+        int64_t mesh_axis_size = process_mesh.dim_size(i);
+        if (!IsSupportedStep(status[i], next, dims, mesh_axis_size)) {
+          continue;
+        }
+        auto next_status = status;
+        next_status[i] = next;
+        if (!IsValidStatus(next_status)) {
+          continue;
+        }
+        ReshardStep step{i, status[i], next};
+        int64_t next_state = state + (next_choice - choice) * base;
+        double next_cost = cost + StepCost(step, mesh_axis_size, local_bytes);
+        if (next_cost < dist[next_state]) {
+          dist[next_state] = next_cost;
+          prev_state[next_state] = state;
+          prev_step[next_state] = step;
+          queue.emplace(next_cost, next_state);
+        }
+      }
+    }
+  }
+
+  if (goal == -1) {
+    return nullptr;
+  }
+  auto plan = std::make_shared<ReshardPlan>();
+  plan->cost = dist[goal];
+  for (int64_t state = goal; state != 0; state = prev_state[state]) {
+    plan->steps.emplace_back(prev_step[state]);
+  }
+  std::reverse(plan->steps.begin(), plan->steps.end());
+  return plan;
+}
+
+}  // namespace phi::distributed
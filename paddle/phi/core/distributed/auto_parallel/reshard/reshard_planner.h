@@ -0,0 +1,104 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "paddle/phi/common/data_type.h"
+#include "paddle/phi/common/reduce_type.h"
+#include "paddle/phi/core/ddim.h"
+
+namespace phi {
+namespace distributed {
+
+class TensorDistAttr;
+
+// The status of a tensor on one axis of the process mesh.
+struct MeshAxisStatus {
+  // the tensor axis sharded on the mesh axis, -1 if not sharded
+  int64_t shard_axis = -1;
+  bool partial = false;
+  ReduceType reduce_type = ReduceType::kRedSum;
+
+  bool is_replicated() const { return shard_axis == -1 && !partial; }
+
+  bool operator==(const MeshAxisStatus& other) const {
+    return shard_axis == other.shard_axis && partial == other.partial &&
+           (!partial || reduce_type == other.reduce_type);
+  }
+  bool operator!=(const MeshAxisStatus& other) const {
+    return !(*this == other);
+  }
+
+  std::string to_string() const;
+};
+
+// Reshards the tensor on one mesh axis, which is done by the one dim
+// reshard function on the sub mesh of the axis.
+struct ReshardStep {
+  int64_t mesh_axis;
+  MeshAxisStatus in;
+  MeshAxisStatus out;
+};
+
+struct ReshardPlan {
+  std::vector<ReshardStep> steps;
+  // the estimated time in us
+  double cost = 0;
+
+  std::string to_string() const;
+};
+
+// Searches the cheapest sequence of one mesh axis reshards between two dist
+// attrs on the same nd mesh. Every mesh axis moves from its input status to
+// its output status either directly or through replicated, and the cost of
+// each step is estimated by the latency and the bandwidth of its mesh axis.
+class ReshardPlanner {
+ public:
+  static ReshardPlanner& Instance();
+
+  // Returns nullptr if the transform can not be planned, the plans are
+  // cached by the dist attrs, the shape and the dtype.
+  std::shared_ptr<const ReshardPlan> Plan(const TensorDistAttr& in_dist_attr,
+                                          const TensorDistAttr& out_dist_attr,
+                                          const DDim& dims,
+                                          DataType dtype);
+
+  // The estimated time in us of a step, where bytes is the local bytes of the
+  // tensor before the step.
+  static double StepCost(const ReshardStep& step,
+                         int64_t mesh_axis_size,
+                         double bytes);
+
+  static std::vector<MeshAxisStatus> GetMeshAxisStatus(
+      const TensorDistAttr& dist_attr);
+
+ private:
+  std::shared_ptr<const ReshardPlan> Search(
+      const TensorDistAttr& in_dist_attr,
+      const TensorDistAttr& out_dist_attr,
+      const DDim& dims,
+      DataType dtype);
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<const ReshardPlan>> cache_;
+};
+
+}  // namespace distributed
+}  // namespace phi
@@ -156,6 +156,72 @@ std::vector<int64_t> BalancedSplit(int64_t total_nums, int64_t num_of_pieces) {
   return result;
 }
 
+bool GetLocalShapeAndGlobalOffset(const DDim& global_dims,
+                                  const TensorDistAttr& dist_attr,
+                                  int64_t rank,
+                                  std::vector<int64_t>* local_shape,
+                                  std::vector<int64_t>* global_offset) {
+  const auto& process_mesh = dist_attr.process_mesh();
+  const auto& process_ids = process_mesh.process_ids();
+  auto iter = std::find(process_ids.begin(), process_ids.end(), rank);
+  if (iter == process_ids.end()) {
+    return false;
+  }
+  const auto& mesh_shape = process_mesh.shape();
+  std::vector<int64_t> coord(mesh_shape.size());
+  int64_t flat_idx_in_mesh = iter - process_ids.begin();
+  for (int64_t i = static_cast<int64_t>(mesh_shape.size()) - 1; i >= 0; --i) {
+    coord[i] = flat_idx_in_mesh % mesh_shape[i];
+    flat_idx_in_mesh /= mesh_shape[i];
+  }
+
+  *local_shape = common::vectorize(global_dims);
+  global_offset->assign(local_shape->size(), 0);
+  const auto& dims_mapping = dist_attr.dims_mapping();
+  for (size_t i = 0; i < dims_mapping.size() && i < local_shape->size(); ++i) {
+    int64_t mesh_axis = dims_mapping[i];
+    if (mesh_axis == -1) {
+      continue;
+    }
+    auto pieces = BalancedSplit((*local_shape)[i], mesh_shape[mesh_axis]);
+    for (int64_t j = 0; j < coord[mesh_axis]; ++j) {
+      (*global_offset)[i] += pieces[j];
+    }
+    (*local_shape)[i] = pieces[coord[mesh_axis]];
+  }
+  return true;
+}
+
+bool GetShardOverlap(const std::vector<int64_t>& offset,
+                     const std::vector<int64_t>& shape,
+                     const std::vector<int64_t>& other_offset,
+                     const std::vector<int64_t>& other_shape,
+                     std::vector<int64_t>* offset_in_box,
+                     std::vector<int64_t>* offset_in_other,
+                     std::vector<int64_t>* overlap_shape) {
+  PADDLE_ENFORCE_EQ(
+      offset.size() == shape.size() && other_offset.size() == shape.size() &&
+          other_shape.size() == shape.size(),
+      true,
+      common::errors::InvalidArgument(
+          "The offsets and shapes of the shards should have the same rank."));
+  offset_in_box->resize(shape.size());
+  offset_in_other->resize(shape.size());
+  overlap_shape->resize(shape.size());
+  for (size_t i = 0; i < shape.size(); ++i) {
+    int64_t begin = std::max(offset[i], other_offset[i]);
+    int64_t end = std::min(offset[i] + shape[i],
+                           other_offset[i] + other_shape[i]);
+    if (begin >= end) {
+      return false;
+    }
+    (*offset_in_box)[i] = begin - offset[i];
+    (*offset_in_other)[i] = begin - other_offset[i];
+    (*overlap_shape)[i] = end - begin;
+  }
+  return true;
+}
+
 bool IsCurRankInMesh(const ProcessMesh& process_mesh) {
   int64_t cur_global_rank = GetCurGlobalRank();
   const auto& process_ids = process_mesh.process_ids();
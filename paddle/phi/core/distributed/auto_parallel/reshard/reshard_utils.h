@@ -67,6 +67,29 @@ std::map<int, int64_t> GetSplitAxisWithDimsMapping(
 // {3, 3, 2, 2, 2}.
 std::vector<int64_t> BalancedSplit(int64_t total_nums, int64_t num_of_pieces);
 
+// Get the shape and the offset in the global tensor of the local shard of rank,
+// which follows the balanced split of the dims_mapping. Return false if rank is
+// not in the process mesh. For example, the global dims is [6, 4], the process
+// mesh is [[0, 1], [2, 3]] and the dims_mapping is [0, -1], the shard of rank 2
+// has the shape [3, 4] at the offset [3, 0].
+bool GetLocalShapeAndGlobalOffset(const DDim& global_dims,
+                                  const TensorDistAttr& dist_attr,
+                                  int64_t rank,
+                                  std::vector<int64_t>* local_shape,
+                                  std::vector<int64_t>* global_offset);
+
+// Get the overlap of two boxes of a global tensor given by their offsets and
+// shapes. Return false if they do not overlap. The overlap is given by its
+// offsets in both of the boxes and its shape, so that a shard saved by one
+// placement can be assigned to the shard of another one without a gather.
+bool GetShardOverlap(const std::vector<int64_t>& offset,
+                     const std::vector<int64_t>& shape,
+                     const std::vector<int64_t>& other_offset,
+                     const std::vector<int64_t>& other_shape,
+                     std::vector<int64_t>* offset_in_box,
+                     std::vector<int64_t>* offset_in_other,
+                     std::vector<int64_t>* overlap_shape);
+
 // Create a comm context of the input process_ids. Once the newly comm context
 // created, it will be cached in the global instance, and get from the global
 // cache later. If the input dev_ctx is GPU, then nccl comm context will be
@@ -0,0 +1,359 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/distributed/auto_parallel/strategy_planner.h"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <utility>
+
+#include "glog/logging.h"
+
+#include "paddle/phi/core/distributed/auto_parallel/dist_meta_tensor.h"
+#include "paddle/phi/core/distributed/auto_parallel/inferspmd_utils.h"
+#include "paddle/phi/core/distributed/auto_parallel/reshard/reshard_planner.h"
+#include "paddle/phi/core/distributed/auto_parallel/utils.h"
+#include "paddle/phi/core/enforce.h"
+
+namespace phi::distributed {
+
+namespace {
+
+// the relative improvement a plan should make to be taken
+constexpr double kMinImprovement = 1e-9;
+
+// The product of the sizes of the mesh axes sharding the tensor, or making
+// it partial if with_partial.
+int64_t NumShards(const TensorDistAttr& dist_attr, bool with_partial) {
+  const auto& process_mesh = dist_attr.process_mesh();
+  int64_t num_shards = 1;
+  for (int64_t mesh_axis : dist_attr.dims_mapping()) {
+    if (mesh_axis != -1) {
+      num_shards *= process_mesh.dim_size(mesh_axis);
+    }
+  }
+  if (with_partial) {
+    for (const auto& kv : dist_attr.partial_status()) {
+      num_shards *= process_mesh.dim_size(kv.first);
+    }
+  }
+  return num_shards;
+}
+
+double NumBytes(const StrategyTensor& tensor) {
+  double bytes = static_cast<double>(SizeOf(tensor.dtype));
+  for (int64_t dim : tensor.shape) {
+    bytes *= static_cast<double>(dim);
+  }
+  return bytes;
+}
+
+bool SameStatus(const TensorDistAttr& lhs, const TensorDistAttr& rhs) {
+  return lhs.dims_mapping() == rhs.dims_mapping() &&
+         lhs.partial_status() == rhs.partial_status();
+}
+
+// Checks the ids of the tensors in the ops and marks the produced ones.
+std::vector<bool> ProducedTensors(const StrategyGraph& graph) {
+  const int64_t num_tensors = static_cast<int64_t>(graph.tensors.size());
+  std::vector<bool> produced(num_tensors, false);
+  for (const auto& op : graph.ops) {
+    for (const auto* ids : {&op.inputs, &op.outputs}) {
+      for (int64_t id : *ids) {
+        PADDLE_ENFORCE_EQ(
+            id >= 0 && id < num_tensors,
+            true,
+            common::errors::InvalidArgument(
+                "The tensor id %d of op %s is out of the %d tensors.",
+                id,
+                op.type,
+                num_tensors));
+      }
+    }
+    for (int64_t id : op.outputs) {
+      produced[id] = true;
+    }
+  }
+  return produced;
+}
+
+bool BetterThan(const StrategyPlan& lhs, const StrategyPlan& rhs) {
+  if (lhs.excess_memory_bytes != rhs.excess_memory_bytes) {
+    return lhs.excess_memory_bytes < rhs.excess_memory_bytes;
+  }
+  return lhs.cost < rhs.cost * (1 - kMinImprovement);
+}
+
+}  // namespace
+
+std::string StrategyPlan::to_string(const StrategyGraph& graph) const {
+  std::ostringstream oss;
+  oss << "{cost: " << cost << "us, compute: " << compute_cost
+      << "us, reshard: " << reshard_cost << "us, memory: " << memory_bytes
+      << " bytes, dist_attrs: [";
+  for (size_t i = 0; i < dist_attrs.size(); ++i) {
+    if (i != 0) {
+      oss << ", ";
+    }
+    oss << graph.tensors[i].name << ": "
+        << auto_parallel::str_join(dist_attrs[i].dims_mapping());
+  }
+  oss << "]}";
+  return oss.str();
+}
+
+StrategyPlanner::StrategyPlanner(const ProcessMesh& process_mesh,
+                                 const StrategyPlannerOptions& options)
+    : process_mesh_(process_mesh), options_(options) {
+  PADDLE_ENFORCE_EQ(
+      process_mesh_.empty(),
+      false,
+      common::errors::InvalidArgument(
+          "The process mesh of StrategyPlanner should not be empty."));
+  PADDLE_ENFORCE_GT(options_.device_tflops,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The device_tflops of StrategyPlanner should be "
+                        "positive, but got %f.",
+                        options_.device_tflops));
+}
+
+std::vector<std::vector<int64_t>> StrategyPlanner::Candidates(
+    const std::vector<int64_t>& shape) const {
+  std::vector<std::vector<int64_t>> candidates;
+  std::vector<int64_t> dims_mapping(shape.size(), -1);
+  int64_t ndim = process_mesh_.ndim();
+  // assigns the mesh axes one by one to a tensor axis or to none
+  std::function<void(int64_t)> assign = [&](int64_t mesh_axis) {
+    if (mesh_axis == ndim) {
+      candidates.push_back(dims_mapping);
+      return;
+    }
+    assign(mesh_axis + 1);
+    int64_t mesh_axis_size = process_mesh_.dim_size(mesh_axis);
+    for (size_t i = 0; i < shape.size(); ++i) {
+      if (dims_mapping[i] != -1 || shape[i] <= 0 ||
+          shape[i] % mesh_axis_size != 0) {
+        continue;
+      }
+      dims_mapping[i] = mesh_axis;
+      assign(mesh_axis + 1);
+      dims_mapping[i] = -1;
+    }
+  };
+  assign(0);
+  return candidates;
+}
+
+StrategyPlan StrategyPlanner::Evaluate(
+    const StrategyGraph& graph,
+    const std::vector<std::vector<int64_t>>& dims_mappings) const {
+  const auto& tensors = graph.tensors;
+  PADDLE_ENFORCE_EQ(
+      dims_mappings.size(),
+      tensors.size(),
+      common::errors::InvalidArgument(
+          "The size of dims_mappings (%d) should be equal to the number of "
+          "tensors (%d).",
+          dims_mappings.size(),
+          tensors.size()));
+  StrategyPlan plan;
+  plan.dist_attrs.resize(tensors.size());
+  std::vector<bool> produced = ProducedTensors(graph);
+  std::vector<bool> defined(tensors.size(), false);
+  std::vector<bool> consumed(tensors.size(), false);
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    if (produced[i]) {
+      continue;
+    }
+    TensorDistAttr dist_attr(tensors[i].shape);
+    dist_attr.set_process_mesh(process_mesh_);
+    dist_attr.set_dims_mapping(dims_mappings[i]);
+    dist_attr.mark_annotated("process_mesh");
+    dist_attr.mark_annotated("dims_mapping");
+    plan.dist_attrs[i] = std::move(dist_attr);
+    defined[i] = true;
+  }
+
+  double compute_cost = 0;
+  double reshard_cost = 0;
+  auto reshard = [&](const TensorDistAttr& in,
+                     const TensorDistAttr& out,
+                     const StrategyTensor& tensor) {
+    if (SameStatus(in, out)) {
+      return true;
+    }
+    auto reshard_plan = ReshardPlanner::Instance().Plan(
+        in, out, common::make_ddim(tensor.shape), tensor.dtype);
+    if (!reshard_plan) {
+      return false;
+    }
+    reshard_cost += reshard_plan->cost;
+    return true;
+  };
+  // the plans could not be resharded are never taken
+  auto infeasible = [&plan]() {
+    plan.cost = std::numeric_limits<double>::infinity();
+    plan.excess_memory_bytes = std::numeric_limits<double>::infinity();
+    return plan;
+  };
+
+  for (const auto& op : graph.ops) {
+    PADDLE_ENFORCE_EQ(
+        SpmdRuleFactory::Instance().ContainsSpmdRule(op.type),
+        true,
+        common::errors::NotFound(
+            "The spmd rule of %s is not found for StrategyPlanner.", op.type));
+    InferSpmdContext ctx;
+    for (int64_t id : op.inputs) {
+      PADDLE_ENFORCE_EQ(defined[id],
+                        true,
+                        common::errors::InvalidArgument(
+                            "The input %s of op %s is used before it is "
+                            "produced, the ops of StrategyGraph should be in "
+                            "the topological order.",
+                            tensors[id].name,
+                            op.type));
+      ctx.EmplaceBackInput(DistMetaTensor(common::make_ddim(tensors[id].shape),
+                                          plan.dist_attrs[id]));
+      consumed[id] = true;
+    }
+    for (const auto& attr : op.attrs) {
+      ctx.EmplaceBackAttr(attr);
+    }
+    SpmdInfo spmd_info =
+        SpmdRuleFactory::Instance().GetSpmdRule(op.type).InferForward(ctx);
+    PADDLE_ENFORCE_EQ(
+        spmd_info.first.size() == op.inputs.size() &&
+            spmd_info.second.size() >= op.outputs.size(),
+        true,
+        common::errors::InvalidArgument(
+            "The spmd rule of %s returns %d inputs and %d outputs, but the op "
+            "has %d inputs and %d outputs.",
+            op.type,
+            spmd_info.first.size(),
+            spmd_info.second.size(),
+            op.inputs.size(),
+            op.outputs.size()));
+
+    for (size_t i = 0; i < op.inputs.size(); ++i) {
+      int64_t id = op.inputs[i];
+      const auto& required =
+          PADDLE_GET_CONST(TensorDistAttr, spmd_info.first[i]);
+      if (!reshard(plan.dist_attrs[id], required, tensors[id])) {
+        VLOG(6) << "StrategyPlanner could not reshard " << tensors[id].name
+                << " from " << plan.dist_attrs[id] << " to " << required;
+        return infeasible();
+      }
+    }
+    for (size_t i = 0; i < op.outputs.size(); ++i) {
+      int64_t id = op.outputs[i];
+      plan.dist_attrs[id] =
+          PADDLE_GET_CONST(TensorDistAttr, spmd_info.second[i]);
+      defined[id] = true;
+    }
+    if (!op.outputs.empty()) {
+      // the work of the op is split like its first output
+      int64_t num_shards =
+          NumShards(plan.dist_attrs[op.outputs.front()], true);
+      // 1 TFLOPS is 1e6 floating point operations per us
+      compute_cost +=
+          op.flops / num_shards / (options_.device_tflops * 1e6);
+    }
+  }
+
+  // the partial outputs of the graph are reduced at last
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    if (consumed[i] || !plan.dist_attrs[i].is_partial()) {
+      continue;
+    }
+    TensorDistAttr reduced = plan.dist_attrs[i];
+    reduced.clean_partial_status();
+    if (!reshard(plan.dist_attrs[i], reduced, tensors[i])) {
+      return infeasible();
+    }
+  }
+
+  double memory_bytes = 0;
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    double bytes =
+        NumBytes(tensors[i]) / NumShards(plan.dist_attrs[i], false);
+    if (tensors[i].is_parameter) {
+      bytes *= options_.parameter_memory_factor;
+    }
+    memory_bytes += bytes;
+  }
+
+  plan.compute_cost = compute_cost;
+  plan.reshard_cost = reshard_cost;
+  plan.cost = compute_cost + reshard_cost;
+  plan.memory_bytes = memory_bytes;
+  if (options_.memory_limit_bytes > 0) {
+    plan.excess_memory_bytes =
+        std::max(memory_bytes - options_.memory_limit_bytes, 0.0);
+  }
+  return plan;
+}
+
+StrategyPlan StrategyPlanner::Search(const StrategyGraph& graph) const {
+  const auto& tensors = graph.tensors;
+  std::vector<bool> produced = ProducedTensors(graph);
+
+  std::vector<std::vector<int64_t>> dims_mappings;
+  std::vector<size_t> planned;
+  std::vector<std::vector<std::vector<int64_t>>> candidates(tensors.size());
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    if (!tensors[i].dims_mapping.empty()) {
+      dims_mappings.push_back(tensors[i].dims_mapping);
+      continue;
+    }
+    dims_mappings.emplace_back(tensors[i].shape.size(), -1);
+    if (!produced[i]) {
+      planned.push_back(i);
+      candidates[i] = Candidates(tensors[i].shape);
+    }
+  }
+
+  StrategyPlan best = Evaluate(graph, dims_mappings);
+  for (int pass = 0; pass < options_.max_passes; ++pass) {
+    bool improved = false;
+    for (size_t id : planned) {
+      std::vector<int64_t> kept = dims_mappings[id];
+      for (const auto& candidate : candidates[id]) {
+        if (candidate == kept) {
+          continue;
+        }
+        dims_mappings[id] = candidate;
+        StrategyPlan plan = Evaluate(graph, dims_mappings);
+        if (BetterThan(plan, best)) {
+          best = std::move(plan);
+          kept = candidate;
+          improved = true;
+        }
+      }
+      dims_mappings[id] = kept;
+    }
+    VLOG(4) << "StrategyPlanner pass " << pass << ": "
+            << best.to_string(graph);
+    if (!improved) {
+      break;
+    }
+  }
+  VLOG(3) << "StrategyPlanner plans on " << process_mesh_ << ": "
+          << best.to_string(graph);
+  return best;
+}
+
+}  // namespace phi::distributed
@@ -0,0 +1,117 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "paddle/phi/common/data_type.h"
+#include "paddle/phi/core/attribute.h"
+#include "paddle/phi/core/distributed/auto_parallel/dist_attr.h"
+#include "paddle/phi/core/distributed/auto_parallel/process_mesh.h"
+
+namespace phi {
+namespace distributed {
+
+struct StrategyTensor {
+  std::string name;
+  std::vector<int64_t> shape;
+  DataType dtype = DataType::FLOAT32;
+  // the parameters take the memory of their gradients and optimizer states
+  bool is_parameter = false;
+  // the dims mapping of an input or a parameter annotated by the user, kept
+  // by the planner, empty if the planner is free to choose
+  std::vector<int64_t> dims_mapping;
+};
+
+struct StrategyOp {
+  // the name of the registered spmd rule, e.g. matmul
+  std::string type;
+  // the ids of the tensors in the graph
+  std::vector<int64_t> inputs;
+  std::vector<int64_t> outputs;
+  // the attributes in the order of the arguments of the spmd rule
+  std::vector<Attribute> attrs;
+  // the floating point operations of the op on the whole tensors
+  double flops = 0;
+};
+
+// The ops are in the topological order, and the tensors not produced by any
+// op, i.e. the parameters and the inputs, are the ones to be planned.
+struct StrategyGraph {
+  std::vector<StrategyTensor> tensors;
+  std::vector<StrategyOp> ops;
+};
+
+struct StrategyPlan {
+  // the dist attrs of all the tensors, the planned ones are annotated
+  std::vector<TensorDistAttr> dist_attrs;
+  // the estimated time in us
+  double compute_cost = 0;
+  double reshard_cost = 0;
+  double cost = std::numeric_limits<double>::infinity();
+  // the estimated bytes on each device
+  double memory_bytes = 0;
+  // the bytes over the memory limit
+  double excess_memory_bytes = 0;
+
+  std::string to_string(const StrategyGraph& graph) const;
+};
+
+struct StrategyPlannerOptions {
+  // the throughput of a device to estimate the compute cost
+  double device_tflops = 100.0;
+  // the bytes a device could hold, 0 if not limited
+  double memory_limit_bytes = 0;
+  // the bytes of a parameter with its gradient and optimizer states over the
+  // bytes of the parameter, e.g. 4 for adam
+  double parameter_memory_factor = 4.0;
+  // the passes over the planned tensors of the search
+  int max_passes = 4;
+};
+
+// Searches the dist attrs of the parameters and the inputs of a graph on a
+// process mesh. The dist attrs are propagated through the ops by their spmd
+// rules, and a plan is scored by the compute cost of the local shards and the
+// reshard cost of the inputs the rules ask, estimated by ReshardPlanner. The
+// plans over the memory limit are only taken if no plan fits.
+class StrategyPlanner {
+ public:
+  explicit StrategyPlanner(const ProcessMesh& process_mesh,
+                           const StrategyPlannerOptions& options = {});
+
+  // Starts from the annotated and replicated dims mappings, and changes the
+  // dims mapping of one planned tensor at a time while the plan improves.
+  StrategyPlan Search(const StrategyGraph& graph) const;
+
+  // Propagates the dims mappings of the tensors not produced by any op and
+  // scores the plan, the dims mappings of the other tensors are ignored.
+  StrategyPlan Evaluate(
+      const StrategyGraph& graph,
+      const std::vector<std::vector<int64_t>>& dims_mappings) const;
+
+  // The dims mappings of a tensor, where each mesh axis shards at most one
+  // tensor axis evenly.
+  std::vector<std::vector<int64_t>> Candidates(
+      const std::vector<int64_t>& shape) const;
+
+ private:
+  ProcessMesh process_mesh_;
+  StrategyPlannerOptions options_;
+};
+
+}  // namespace distributed
+}  // namespace phi
@@ -14,6 +14,10 @@
 
 #include "paddle/phi/core/distributed/collective/process_group.h"
 
+#include <numeric>
+
+#include "paddle/phi/core/tensor_utils.h"
+
 namespace phi::distributed {
 
 bool ProcessGroup::Task::IsCompleted() {
@@ -35,6 +39,67 @@ ProcessGroup::ProcessGroup(int rank, int size, int gid)
   global_rank_ = std::atoi(global_rank);
 }
 
+std::shared_ptr<ProcessGroup::Task> ProcessGroup::AllToAllWithSplits(
+    phi::DenseTensor* out_tensor,
+    const phi::DenseTensor& in_tensor,
+    const std::vector<int64_t>& in_size_each_rank,
+    std::vector<int64_t>* out_size_each_rank,
+    bool sync_op,
+    bool use_calc_stream) {
+  PADDLE_ENFORCE_EQ(
+      in_size_each_rank.size(),
+      static_cast<size_t>(size_),
+      common::errors::InvalidArgument(
+          "The length of in_size_each_rank (%d) should be equal to the world "
+          "size (%d).",
+          in_size_each_rank.size(),
+          size_));
+  PADDLE_ENFORCE_GE(in_tensor.dims().size(),
+                    1,
+                    common::errors::InvalidArgument(
+                        "The input of all_to_all should have at least one "
+                        "dim."));
+  int64_t in_rows = std::accumulate(
+      in_size_each_rank.begin(), in_size_each_rank.end(), int64_t(0));
+  PADDLE_ENFORCE_EQ(in_rows,
+                    in_tensor.dims()[0],
+                    common::errors::InvalidArgument(
+                        "The sum of in_size_each_rank (%d) should be equal to "
+                        "the rows of the input (%d).",
+                        in_rows,
+                        in_tensor.dims()[0]));
+
+  // The sizes are sent and read back on the calc stream, so they are in the
+  // order of the kernels producing the input.
+  auto* calc_ctx =
+      GetDeviceContext(in_tensor.place(), /*use_calc_stream*/ true);
+  phi::DenseTensor in_sizes, out_sizes;
+  phi::TensorFromVector(in_size_each_rank, *calc_ctx, &in_sizes);
+  out_sizes.Resize({size_});
+  calc_ctx->Alloc(&out_sizes, phi::DataType::INT64);
+  std::vector<int64_t> ones(size_, 1);
+  AllToAll(&out_sizes,
+           in_sizes,
+           ones,
+           ones,
+           /*sync_op*/ true,
+           /*use_calc_stream*/ true);
+  phi::TensorToVector(out_sizes, *calc_ctx, out_size_each_rank);
+  calc_ctx->Wait();
+
+  auto out_dims = in_tensor.dims();
+  out_dims[0] = std::accumulate(
+      out_size_each_rank->begin(), out_size_each_rank->end(), int64_t(0));
+  out_tensor->Resize(out_dims);
+  calc_ctx->Alloc(out_tensor, in_tensor.dtype());
+  return AllToAll(out_tensor,
+                  in_tensor,
+                  *out_size_each_rank,
+                  in_size_each_rank,
+                  sync_op,
+                  use_calc_stream);
+}
+
 // TODO(sunyilun): methods below will be removed later
 ProcessGroupIdMap& ProcessGroupIdMap::GetInstance() {
   static ProcessGroupIdMap instance;
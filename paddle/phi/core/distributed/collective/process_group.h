@@ -304,6 +304,17 @@ class ProcessGroup {
         GetBackendName()));
   }
 
+  // All to all with the sizes of the output unknown to the receivers, which
+  // are exchanged by a small all to all first. The output is resized to the
+  // received rows and allocated on the calc stream.
+  virtual std::shared_ptr<ProcessGroup::Task> AllToAllWithSplits(
+      phi::DenseTensor* out_tensor,
+      const phi::DenseTensor& in_tensor,
+      const std::vector<int64_t>& in_size_each_rank,
+      std::vector<int64_t>* out_size_each_rank,
+      bool sync_op,
+      bool use_calc_stream);
+
   virtual std::shared_ptr<ProcessGroup::Task> Broadcast(
       phi::DenseTensor* out_tensor UNUSED,
       const phi::DenseTensor& in_tensor UNUSED,
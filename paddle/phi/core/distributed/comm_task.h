@@ -79,6 +79,8 @@ class CommTask {
   int GetSize() { return size_; }
   int GetGid() { return gid_; }
   int64_t GetNumel() { return numel_; }
+  int64_t GetBytes() { return bytes_; }
+  void SetBytes(int64_t bytes) { bytes_ = bytes; }
   uint64_t GetSeq() { return seq_; }
   CommType GetCommType() { return comm_type_; }
   bool GetTraceUpdated() { return start_trace_updated_; }
@@ -149,6 +151,12 @@ class CommTask {
         common::errors::Unimplemented("%s is not implemented.", __func__));
     return;
   }
+  // the time of the completed kernel, negative if it is not measured
+  virtual float GetElapsedMs() {
+    PADDLE_THROW(
+        common::errors::Unimplemented("%s is not implemented.", __func__));
+    return -1;
+  }
 
  protected:
   std::string backend_;
@@ -160,6 +168,7 @@ class CommTask {
   int gid_;
   uint64_t seq_{0};
   int64_t numel_;
+  int64_t bytes_{0};
   ncclComm_t nccl_comm_;
   gpuStream_t nccl_stream_;
   CommType comm_type_;
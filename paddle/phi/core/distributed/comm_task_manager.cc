@@ -22,9 +22,13 @@
 
 #include "paddle/phi/core/distributed/comm_context_manager.h"
 
+#include <algorithm>
+#include <cmath>
 #include <future>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <vector>
 
 #include "gflags/gflags.h"
 #include "glog/logging.h"
@@ -112,6 +116,9 @@ void CommTaskManager::Stop() {
     comm_task_clear_loop_thread_.join();
   }
 
+  if (!latency_stats_.empty()) {
+    LOG(INFO) << "Comm latency stats: " << GetLatencyStats();
+  }
   LOG(INFO) << "CommTaskManager stopped.";
 }
 
@@ -181,6 +188,7 @@ void CommTaskManager::CommTaskLoop() {
       } else {
         if (task->IsStarted()) {
           if (task->IsCompleted()) {
+            RecordLatency(task);
             CommTaskClearEnqueue(task);
             iter = comm_task_list_.erase(iter);
           } else {
@@ -210,6 +218,7 @@ void CommTaskManager::CommTaskLoop() {
          iter != start_comm_task_map_.end();) {
       auto task = iter->second;
       if (task->IsCompleted()) {
+        RecordLatency(task);
         CommTaskClearEnqueue(task);
         UpdateLastCommTask(task);
         iter = start_comm_task_map_.erase(iter);
@@ -219,6 +228,8 @@ void CommTaskManager::CommTaskLoop() {
       }
     }
 
+    PublishGroupLatency();
+
     if (comm_task_list_.empty() && init_comm_task_map_.empty() &&
         start_comm_task_map_.empty()) {
       done = true;
@@ -275,4 +286,169 @@ bool CommTaskManager::IsTimeout() {
   return std::chrono::duration_cast<std::chrono::milliseconds>(
              current_timepoint - last_update_time_) >= timeout_;
 }
+
+static int HistogramBucket(double value, int bucket_num) {
+  if (value < 1) {
+    return 0;
+  }
+  return std::min(static_cast<int>(std::log2(value)), bucket_num - 1);
+}
+
+// the ratio of bus bandwidth to algorithm bandwidth, as nccl-tests reports
+static double BusBandwidthFactor(CommType comm_type, int nranks) {
+  if (nranks <= 1) {
+    return 1;
+  }
+  switch (comm_type) {
+    case CommType::ALLREDUCE:
+      return 2.0 * (nranks - 1) / nranks;
+    case CommType::ALLGATHER:
+    case CommType::REDUCE_SCATTER:
+    case CommType::ALLTOALL:
+      return static_cast<double>(nranks - 1) / nranks;
+    default:
+      return 1;
+  }
+}
+
+template <size_t N>
+static std::string JoinBuckets(const std::array<int64_t, N>& buckets) {
+  std::string str;
+  for (size_t i = 0; i < N; ++i) {
+    str += (i == 0 ? "" : ",") + std::to_string(buckets[i]);
+  }
+  return str;
+}
+
+static std::string GroupLatencyKey(const std::string& group_key,
+                                   int global_rank) {
+  return "comm_latency/" + group_key + "/" + std::to_string(global_rank);
+}
+
+void CommTaskManager::RecordLatency(std::shared_ptr<CommTask> task) {
+  float elapsed_ms = task->GetElapsedMs();
+  if (elapsed_ms < 0) {
+    return;
+  }
+  int64_t bytes = task->GetBytes();
+  double busbw_mbps = 0;
+  if (elapsed_ms > 0) {
+    busbw_mbps = bytes / (elapsed_ms * 1e3) *
+                 BusBandwidthFactor(task->GetCommType(), task->GetSize());
+  }
+  int bytes_log2 = bytes > 0 ? static_cast<int>(std::log2(bytes)) : 0;
+
+  std::lock_guard<std::mutex> lock(latency_stats_mutex_);
+  auto& stat = latency_stats_[std::make_pair(task->GetCommType(), bytes_log2)];
+  ++stat.count;
+  stat.total_ms += elapsed_ms;
+  stat.max_ms = std::max<double>(stat.max_ms, elapsed_ms);
+  ++stat.latency_buckets[HistogramBucket(elapsed_ms * 1e3, kHistogramBuckets)];
+  ++stat.busbw_buckets[HistogramBucket(busbw_mbps, kHistogramBuckets)];
+
+  auto& group = group_latency_[task->GroupKey()];
+  ++group.count;
+  group.total_ms += elapsed_ms;
+  group.global_rank = task->GetGlobalRank();
+  group.published = false;
+  if (group.store == nullptr) {
+    group.store = task->GetStore();
+  }
+}
+
+void CommTaskManager::PublishGroupLatency() {
+  std::vector<std::pair<std::string, GroupLatency>> groups;
+  {
+    std::lock_guard<std::mutex> lock(latency_stats_mutex_);
+    for (auto& iter : group_latency_) {
+      if (!iter.second.published && iter.second.store != nullptr) {
+        groups.emplace_back(iter.first, iter.second);
+        iter.second.published = true;
+      }
+    }
+  }
+  for (const auto& iter : groups) {
+    const auto& group = iter.second;
+    std::string value =
+        std::to_string(group.count) + "," + std::to_string(group.total_ms);
+    group.store->set(GroupLatencyKey(iter.first, group.global_rank),
+                     std::vector<uint8_t>(value.begin(), value.end()));
+  }
+}
+
+std::string CommTaskManager::GetLatencyStats() {
+  std::lock_guard<std::mutex> lock(latency_stats_mutex_);
+  std::ostringstream os;
+  os << "[";
+  for (auto iter = latency_stats_.begin(); iter != latency_stats_.end();
+       ++iter) {
+    const auto& stat = iter->second;
+    os << (iter == latency_stats_.begin() ? "" : ",") << "{\"op\":\""
+       << CommTypeToString(iter->first.first)
+       << "\",\"bytes_log2\":" << iter->first.second
+       << ",\"count\":" << stat.count
+       << ",\"mean_ms\":" << stat.total_ms / stat.count
+       << ",\"max_ms\":" << stat.max_ms << ",\"latency_us_log2_hist\":["
+       << JoinBuckets(stat.latency_buckets) << "],\"busbw_mbps_log2_hist\":["
+       << JoinBuckets(stat.busbw_buckets) << "]}";
+  }
+  os << "]";
+  return os.str();
+}
+
+std::string CommTaskManager::GetStragglerReport() {
+  PublishGroupLatency();
+  std::map<std::string, std::shared_ptr<Store>> group_stores;
+  {
+    std::lock_guard<std::mutex> lock(latency_stats_mutex_);
+    for (const auto& iter : group_latency_) {
+      if (iter.second.store != nullptr) {
+        group_stores.emplace(iter.first, iter.second.store);
+      }
+    }
+  }
+
+  std::ostringstream os;
+  os << "{";
+  for (auto iter = group_stores.begin(); iter != group_stores.end(); ++iter) {
+    const auto& group_key = iter->first;
+    auto global_ranks =
+        CommContextManager::GetInstance().GetGroupRanks(group_key);
+    int straggler = -1;
+    double min_mean_ms = 0;
+    os << (iter == group_stores.begin() ? "" : ",") << "\"" << group_key
+       << "\":{\"mean_ms\":{";
+    bool first = true;
+    for (int global_rank : global_ranks) {
+      auto key = GroupLatencyKey(group_key, global_rank);
+      if (!iter->second->check(key)) {
+        continue;
+      }
+      auto value = iter->second->get(key);
+      std::string str(value.begin(), value.end());
+      auto pos = str.find(',');
+      int64_t count = std::stoll(str.substr(0, pos));
+      double mean_ms = count > 0 ? std::stod(str.substr(pos + 1)) / count : 0;
+      if (straggler < 0 || mean_ms < min_mean_ms) {
+        straggler = global_rank;
+        min_mean_ms = mean_ms;
+      }
+      os << (first ? "" : ",") << "\"" << global_rank << "\":" << mean_ms;
+      first = false;
+    }
+    os << "},\"straggler\":" << straggler << "}";
+  }
+  os << "}";
+  return os.str();
+}
+
+void CommTaskManager::ResetLatencyStats() {
+  std::lock_guard<std::mutex> lock(latency_stats_mutex_);
+  latency_stats_.clear();
+  for (auto& iter : group_latency_) {
+    iter.second.count = 0;
+    iter.second.total_ms = 0;
+    iter.second.published = false;
+  }
+}
 }  // namespace phi::distributed
@@ -14,14 +14,18 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <iostream>
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
 #include <unordered_map>
+#include <utility>
 
 #include "paddle/common/macros.h"
 #include "paddle/phi/core/distributed/comm_context.h"
@@ -51,10 +55,38 @@ class CommTaskManager {
   void UpdateLastCommTask(std::shared_ptr<CommTask> comm_task);
   void SetTimeout(int64_t timeout);
 
+  // The latency and bus bandwidth histograms of the completed tasks by op
+  // and message size in json, collected with FLAGS_enable_comm_latency_stats.
+  std::string GetLatencyStats();
+  // The mean latency of every rank in each group in json. The rank with the
+  // lowest latency is the straggler, since the others wait for it inside
+  // the collective kernels.
+  std::string GetStragglerReport();
+  void ResetLatencyStats();
+
  private:
   void CommTaskLoop();
   void CommTaskClearLoop();
   bool IsTimeout();
+  void RecordLatency(std::shared_ptr<CommTask> task);
+  void PublishGroupLatency();
+
+  // bucket i counts [2^i, 2^(i+1)) us or MB/s, the last one is unbounded
+  static constexpr int kHistogramBuckets = 24;
+  struct LatencyStat {
+    int64_t count = 0;
+    double total_ms = 0;
+    double max_ms = 0;
+    std::array<int64_t, kHistogramBuckets> latency_buckets{};
+    std::array<int64_t, kHistogramBuckets> busbw_buckets{};
+  };
+  struct GroupLatency {
+    int64_t count = 0;
+    double total_ms = 0;
+    int global_rank = -1;
+    bool published = true;
+    std::shared_ptr<Store> store;
+  };
 
   static std::thread comm_task_loop_thread_;
   static std::thread comm_task_clear_loop_thread_;
@@ -83,6 +115,12 @@ class CommTaskManager {
   static std::chrono::time_point<std::chrono::steady_clock> last_update_time_;
   std::chrono::milliseconds timeout_;
   bool logged_ = false;
+
+  std::mutex latency_stats_mutex_;
+  // key: op and the log2 of message bytes
+  std::map<std::pair<CommType, int>, LatencyStat> latency_stats_;
+  // key: group key
+  std::map<std::string, GroupLatency> group_latency_;
 };
 
 }  // namespace distributed
@@ -21,14 +21,24 @@
 #include <gloo/broadcast.h>
 #include <gloo/gather.h>
 #include <gloo/reduce.h>
+#include <gloo/rendezvous/prefix_store.h>
 #include <gloo/scatter.h>
 #include <gloo/types.h>
 
+#include <algorithm>
+#include <exception>
+#include <string>
+#include <thread>
+
+#include "paddle/common/flags.h"
 #include "paddle/phi/common/data_type.h"
 #include "paddle/phi/core/dense_tensor.h"
 #include "paddle/phi/core/distributed/check/static_check.h"
 #include "paddle/phi/core/enforce.h"
 
+COMMON_DECLARE_int32(gloo_allreduce_channels);
+COMMON_DECLARE_int64(gloo_allreduce_chunk_bytes);
+
 namespace phi::distributed {
 
 GlooCommContext::GlooCommContext(
@@ -39,6 +49,16 @@ GlooCommContext::GlooCommContext(
     : CommContext(rank, size) {
   gloo_context_ = std::make_shared<gloo::rendezvous::Context>(rank, size);
   gloo_context_->connectFullMesh(*store, device);
+  channel_contexts_.push_back(gloo_context_);
+  // the store may not outlive the constructor, so all the channels connect
+  // here
+  for (int i = 1; i < FLAGS_gloo_allreduce_channels; ++i) {
+    gloo::rendezvous::PrefixStore channel_store(
+        "allreduce_channel_" + std::to_string(i), *store);
+    auto context = std::make_shared<gloo::rendezvous::Context>(rank, size);
+    context->connectFullMesh(channel_store, device);
+    channel_contexts_.push_back(context);
+  }
 }
 
 void GlooCommContext::Broadcast(phi::DenseTensor* out_tensor,
@@ -76,13 +96,72 @@ void GlooCommContext::AllGather(phi::DenseTensor* out_tensor,
   gloo::allgather(opts);
 }
 
+template <typename T>
+void GlooCommContext::ChunkedAllReduce(phi::DenseTensor* out_tensor,
+                                       const phi::DenseTensor& in_tensor,
+                                       int reduce_type,
+                                       uint32_t tag) {
+  T* in_data = reinterpret_cast<T*>(const_cast<void*>(in_tensor.data()));
+  T* out_data = reinterpret_cast<T*>(out_tensor->data());
+  const int64_t numel = in_tensor.numel();
+  const int64_t chunk_numel = std::max<int64_t>(
+      FLAGS_gloo_allreduce_chunk_bytes / static_cast<int64_t>(sizeof(T)), 1);
+  const int64_t num_chunks = (numel + chunk_numel - 1) / chunk_numel;
+  const int num_channels = static_cast<int>(
+      std::min<int64_t>(channel_contexts_.size(), num_chunks));
+
+  // channel c all-reduces the chunks c, c + num_channels, ... one after the
+  // other, on its own pairs
+  std::vector<std::exception_ptr> errors(num_channels);
+  auto run_channel = [&](int c) {
+    try {
+      for (int64_t i = c; i < num_chunks; i += num_channels) {
+        int64_t offset = i * chunk_numel;
+        size_t count =
+            static_cast<size_t>(std::min(chunk_numel, numel - offset));
+        gloo::AllreduceOptions opts(channel_contexts_[c]);
+        opts.setTag(tag);
+        opts.setInput(in_data + offset, count);
+        opts.setOutput(out_data + offset, count);
+        SetReduceFunc<T>(&opts, reduce_type);
+        gloo::allreduce(opts);
+      }
+    } catch (...) {
+      errors[c] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int c = 1; c < num_channels; ++c) {
+    threads.emplace_back(run_channel, c);
+  }
+  run_channel(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
 void GlooCommContext::AllReduce(phi::DenseTensor* out_tensor,
                                 const phi::DenseTensor& in_tensor,
                                 int reduce_type,
                                 uint32_t tag) {
+  const auto& dtype = in_tensor.dtype();
+  int64_t bytes =
+      in_tensor.numel() * static_cast<int64_t>(phi::SizeOf(dtype));
+  if (channel_contexts_.size() > 1 &&
+      bytes >= 2 * FLAGS_gloo_allreduce_chunk_bytes) {
+    VLOG(4) << "gloo all-reduce of " << bytes << " bytes over "
+            << channel_contexts_.size() << " channels";
+    GENERATE_FUNC(
+        dtype, ChunkedAllReduce, out_tensor, in_tensor, reduce_type, tag);
+    return;
+  }
   gloo::AllreduceOptions opts(gloo_context_);
   opts.setTag(tag);
-  const auto& dtype = in_tensor.dtype();
   GENERATE_FUNC(dtype, SetInput, &opts, in_tensor);
   GENERATE_FUNC(dtype, SetOutput, &opts, out_tensor);
   GENERATE_FUNC(dtype, SetReduceFunc, &opts, reduce_type);
@@ -18,6 +18,7 @@
 #include <gloo/transport/tcp/device.h>
 
 #include <memory>
+#include <vector>
 
 #include "paddle/common/macros.h"
 #include "paddle/phi/core/distributed/comm_context.h"
@@ -73,7 +74,18 @@ class GlooCommContext final : public CommContext {
  private:
   DISABLE_COPY_AND_ASSIGN(GlooCommContext);
 
+  // Splits the tensor into chunks and all-reduces them over all the channels
+  // in parallel.
+  template <typename T>
+  void ChunkedAllReduce(phi::DenseTensor* out_tensor,
+                        const phi::DenseTensor& in_tensor,
+                        int reduce_type,
+                        uint32_t tag);
+
   std::shared_ptr<gloo::rendezvous::Context> gloo_context_;
+  // The contexts of the channels of a large all-reduce, the first of which
+  // is gloo_context_.
+  std::vector<std::shared_ptr<gloo::rendezvous::Context>> channel_contexts_;
 };
 
 }  // namespace distributed
@@ -16,11 +16,14 @@
 
 #include "gflags/gflags.h"
 
+#include "paddle/common/flags.h"
 #include "paddle/phi/backends/gpu/gpu_info.h"
 #include "paddle/phi/core/distributed/comm_context_manager.h"
 #include "paddle/phi/core/distributed/nccl_tools.h"
 #include "paddle/phi/core/utils/data_type.h"
 
+COMMON_DECLARE_bool(enable_comm_latency_stats);
+
 namespace phi::distributed {
 
 NCCLCommTask::NCCLCommTask(const phi::Place& place,
@@ -56,6 +59,13 @@ NCCLCommTask::NCCLCommTask(const phi::Place& place,
   start_event_created_ = false;
   end_event_created_ = false;
   start_time_ = std::chrono::steady_clock::now();
+  if (FLAGS_enable_comm_latency_stats) {
+#ifdef PADDLE_WITH_CUDA
+    cuda_event_flags_ = cudaEventDefault;
+#else  // PADDLE_WITH_HIP
+    hip_event_flags_ = hipEventDefault;
+#endif
+  }
 }
 
 void NCCLCommTask::StartRecord() {
@@ -249,6 +259,28 @@ void NCCLCommTask::AbortComm() {
   return;
 }
 
+float NCCLCommTask::GetElapsedMs() {
+  float elapsed_ms = -1;
+  if (!start_event_created_ || !end_event_created_ || !IsCompleted()) {
+    return elapsed_ms;
+  }
+  backends::gpu::GPUDeviceGuard guard(place_.device);
+#ifdef PADDLE_WITH_CUDA
+  if (cuda_event_flags_ & cudaEventDisableTiming) {
+    return elapsed_ms;
+  }
+  CUDA_CHECK(
+      cudaEventElapsedTime(&elapsed_ms, nccl_start_event_, nccl_end_event_));
+#else  // PADDLE_WITH_HIP
+  if (hip_event_flags_ & hipEventDisableTiming) {
+    return elapsed_ms;
+  }
+  HIP_CHECK(
+      hipEventElapsedTime(&elapsed_ms, nccl_start_event_, nccl_end_event_));
+#endif
+  return elapsed_ms;
+}
+
 std::string NCCLCommTask::GetTraceMsg() {
   auto global_ranks =
       phi::distributed::CommContextManager::GetInstance().GetGroupRanks(
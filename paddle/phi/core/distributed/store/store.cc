@@ -42,4 +42,34 @@ void Store::set(const std::string& key, const std::vector<uint8_t>& value) {
       errors::InvalidArgument("Implement the set method in the subclass."));
 }
 
+std::vector<std::vector<uint8_t>> Store::multi_get(
+    const std::vector<std::string>& keys) {
+  std::vector<std::vector<uint8_t>> values;
+  for (const auto& key : keys) {
+    values.push_back(get(key));
+  }
+  return values;
+}
+
+void Store::multi_set(const std::vector<std::string>& keys,
+                      const std::vector<std::vector<uint8_t>>& values) {
+  PADDLE_ENFORCE_EQ(keys.size(),
+                    values.size(),
+                    errors::InvalidArgument(
+                        "The keys and values of multi_set should be of the "
+                        "same size, but got %d and %d.",
+                        keys.size(),
+                        values.size()));
+  for (size_t i = 0; i < keys.size(); ++i) {
+    set(keys[i], values[i]);
+  }
+}
+
+std::vector<uint8_t> Store::compare_set(const std::string& key,
+                                        const std::vector<uint8_t>& expected,
+                                        const std::vector<uint8_t>& desired) {
+  PADDLE_THROW(errors::InvalidArgument(
+      "Implement the compare_set method in the subclass."));
+}
+
 }  // namespace phi::distributed
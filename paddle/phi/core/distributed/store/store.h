@@ -33,6 +33,17 @@ class Store {
   virtual void wait(const std::string& key);
   virtual void set(const std::string& key, const std::vector<uint8_t>& value);
 
+  // Get the values of the keys by one request, waiting for all of them.
+  virtual std::vector<std::vector<uint8_t>> multi_get(
+      const std::vector<std::string>& keys);
+  virtual void multi_set(const std::vector<std::string>& keys,
+                         const std::vector<std::vector<uint8_t>>& values);
+  // Set the key to desired if its value is expected, or if it does not exist
+  // and expected is empty. Returns the value of the key after it.
+  virtual std::vector<uint8_t> compare_set(const std::string& key,
+                                           const std::vector<uint8_t>& expected,
+                                           const std::vector<uint8_t>& desired);
+
   virtual int timeout() { return _timeout; }
 
  protected:
@@ -14,9 +14,12 @@
 
 #include "paddle/phi/core/distributed/store/tcp_store.h"
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <thread>
+#include <unordered_set>
+#include <utility>
 
 #include "glog/logging.h"
 
@@ -78,10 +81,80 @@ void MasterDaemon::_do_set(SocketType socket) {
   VLOG(8) << "MasterDaemon::_do_set key(" << key << ") " << GetSockName(socket);
 
   auto value = tcputils::receive_vector<uint8_t>(socket);
-  _store[key] = value;
+  _set_value(key, std::move(value));
+}
+
+void MasterDaemon::_set_value(const std::string& key,
+                              std::vector<uint8_t> value) {
+  _store[key] = std::move(value);
   _notify_waiting_sockets(key);
 }
 
+void MasterDaemon::_reply_values(SocketType socket,
+                                 const std::vector<std::string>& keys) {
+  tcputils::send_value<size_t>(socket, keys.size());
+  for (const auto& key : keys) {
+    tcputils::send_vector<uint8_t>(socket, _store.at(key));
+  }
+}
+
+void MasterDaemon::_do_multi_get(SocketType socket) {
+  auto num_keys = tcputils::receive_value<size_t>(socket);
+  auto pending = std::make_shared<PendingGet>();
+  pending->socket = socket;
+  pending->num_missing = 0;
+  for (size_t i = 0; i < num_keys; ++i) {
+    pending->keys.emplace_back(tcputils::receive_string(socket));
+  }
+  VLOG(8) << "MasterDaemon::_do_multi_get " << num_keys << " keys "
+          << GetSockName(socket);
+
+  std::unordered_set<std::string> missing;
+  for (const auto& key : pending->keys) {
+    if (_store.find(key) == _store.end() && missing.insert(key).second) {
+      _pending_gets[key].emplace_back(pending);
+      ++pending->num_missing;
+    }
+  }
+  if (pending->num_missing == 0) {
+    _reply_values(socket, pending->keys);
+  }
+}
+
+void MasterDaemon::_do_multi_set(SocketType socket) {
+  auto num_keys = tcputils::receive_value<size_t>(socket);
+  VLOG(8) << "MasterDaemon::_do_multi_set " << num_keys << " keys "
+          << GetSockName(socket);
+  for (size_t i = 0; i < num_keys; ++i) {
+    std::string key = tcputils::receive_string(socket);
+    auto value = tcputils::receive_vector<uint8_t>(socket);
+    _set_value(key, std::move(value));
+  }
+}
+
+void MasterDaemon::_do_compare_set(SocketType socket) {
+  std::string key = tcputils::receive_string(socket);
+  auto expected = tcputils::receive_vector<uint8_t>(socket);
+  auto desired = tcputils::receive_vector<uint8_t>(socket);
+  VLOG(8) << "MasterDaemon::_do_compare_set key(" << key << ") "
+          << GetSockName(socket);
+
+  auto iter = _store.find(key);
+  if (iter == _store.end()) {
+    if (expected.empty()) {
+      _set_value(key, desired);
+      tcputils::send_vector<uint8_t>(socket, desired);
+    } else {
+      tcputils::send_vector<uint8_t>(socket, expected);
+    }
+  } else if (iter->second == expected) {
+    _set_value(key, desired);
+    tcputils::send_vector<uint8_t>(socket, desired);
+  } else {
+    tcputils::send_vector<uint8_t>(socket, iter->second);
+  }
+}
+
 void MasterDaemon::_notify_waiting_sockets(const std::string& key) {
   if (_waiting_sockets.find(key) != _waiting_sockets.end()) {
     for (auto waiting_socket : _waiting_sockets.at(key)) {
@@ -92,6 +165,55 @@ void MasterDaemon::_notify_waiting_sockets(const std::string& key) {
     }
     _waiting_sockets.erase(key);
   }
+  auto pending_iter = _pending_gets.find(key);
+  if (pending_iter != _pending_gets.end()) {
+    auto pendings = std::move(pending_iter->second);
+    _pending_gets.erase(pending_iter);
+    for (auto& pending : pendings) {
+      if (--pending->num_missing == 0) {
+        VLOG(7) << "TCPStore: reply the pending get of the socket: "
+                << GetSockName(pending->socket) << " as key: " << key
+                << " is ready.";
+        _reply_values(pending->socket, pending->keys);
+      }
+    }
+  }
+}
+
+void MasterDaemon::_remove_waiting_socket(SocketType socket) {
+  auto map_iter = _waiting_sockets.begin();
+  while (map_iter != _waiting_sockets.end()) {
+    auto vec_iter = map_iter->second.begin();
+    while (vec_iter != map_iter->second.end()) {
+      if (*vec_iter == socket) {
+        vec_iter = map_iter->second.erase(vec_iter);
+      } else {
+        ++vec_iter;
+      }
+    }
+    if (map_iter->second.empty()) {
+      map_iter = _waiting_sockets.erase(map_iter);
+    } else {
+      ++map_iter;
+    }
+  }
+
+  auto pending_iter = _pending_gets.begin();
+  while (pending_iter != _pending_gets.end()) {
+    auto& pendings = pending_iter->second;
+    pendings.erase(
+        std::remove_if(pendings.begin(),
+                       pendings.end(),
+                       [socket](const std::shared_ptr<PendingGet>& pending) {
+                         return pending->socket == socket;
+                       }),
+        pendings.end());
+    if (pendings.empty()) {
+      pending_iter = _pending_gets.erase(pending_iter);
+    } else {
+      ++pending_iter;
+    }
+  }
 }
 
 void MasterDaemon::_do_get(SocketType socket) {
@@ -209,27 +331,21 @@ void MasterDaemon::ProcessCommands(std::vector<struct pollfd>* p_fds) {
         case Command::WAIT:
           _do_wait(fds[i].fd);
           break;
+        case Command::MULTI_GET:
+          _do_multi_get(fds[i].fd);
+          break;
+        case Command::MULTI_SET:
+          _do_multi_set(fds[i].fd);
+          break;
+        case Command::COMPARE_SET:
+          _do_compare_set(fds[i].fd);
+          break;
         default:
           VLOG(8) << "Unknown command: " << static_cast<int>(command)
                   << " from addr info:" << GetSockName(fds[i].fd);
       }
     } catch (const std::exception& ex) {
-      auto map_iter = _waiting_sockets.begin();
-      while (map_iter != _waiting_sockets.end()) {
-        auto vec_iter = map_iter->second.begin();
-        while (vec_iter != map_iter->second.end()) {
-          if (*vec_iter == fds[i].fd) {
-            vec_iter = map_iter->second.erase(vec_iter);
-          } else {
-            ++vec_iter;
-          }
-        }
-        if (map_iter->second.empty()) {
-          map_iter = _waiting_sockets.erase(map_iter);
-        } else {
-          ++map_iter;
-        }
-      }
+      _remove_waiting_socket(fds[i].fd);
 
       tcputils::close_socket(fds[i].fd);
       fds.erase(fds.begin() + i);
@@ -333,6 +449,10 @@ void TCPClient::send_command_for_key(Command type, const std::string& key) {
   tcputils::send_string(_socket, key);
 }
 
+void TCPClient::send_string(const std::string& value) {
+  tcputils::send_string(_socket, value);
+}
+
 template <typename T>
 void TCPClient::send_value(const T& value) {
   tcputils::send_bytes<T>(_socket, &value, 1);
@@ -434,9 +554,54 @@ void TCPStore::set(const std::string& key, const std::vector<uint8_t>& value) {
 }
 
 std::vector<uint8_t> TCPStore::get(const std::string& key) {
-  wait(key);
-  _client->send_command_for_key(Command::GET, _key_prefix + key);
   VLOG(7) << "TCPStore get.";
+  // wait and get by one request
+  return multi_get({key}).front();
+}
+
+std::vector<std::vector<uint8_t>> TCPStore::multi_get(
+    const std::vector<std::string>& keys) {
+  VLOG(7) << "TCPStore multi_get " << keys.size() << " keys.";
+  _client->send_command_for_key(Command::MULTI_GET, "");
+  _client->send_value<size_t>(keys.size());
+  for (const auto& key : keys) {
+    _client->send_string(_key_prefix + key);
+  }
+  auto num_values = _client->receive_value<size_t>();
+  std::vector<std::vector<uint8_t>> values;
+  values.reserve(num_values);
+  for (size_t i = 0; i < num_values; ++i) {
+    values.emplace_back(_client->receive_vector<uint8_t>());
+  }
+  return values;
+}
+
+void TCPStore::multi_set(const std::vector<std::string>& keys,
+                         const std::vector<std::vector<uint8_t>>& values) {
+  PADDLE_ENFORCE_EQ(keys.size(),
+                    values.size(),
+                    common::errors::InvalidArgument(
+                        "The keys and values of multi_set should be of the "
+                        "same size, but got %d and %d.",
+                        keys.size(),
+                        values.size()));
+  VLOG(7) << "TCPStore multi_set " << keys.size() << " keys.";
+  _client->send_command_for_key(Command::MULTI_SET, "");
+  _client->send_value<size_t>(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    _client->send_string(_key_prefix + keys[i]);
+    _client->send_vector<uint8_t>(values[i]);
+  }
+}
+
+std::vector<uint8_t> TCPStore::compare_set(
+    const std::string& key,
+    const std::vector<uint8_t>& expected,
+    const std::vector<uint8_t>& desired) {
+  VLOG(7) << "TCPStore compare_set.";
+  _client->send_command_for_key(Command::COMPARE_SET, _key_prefix + key);
+  _client->send_vector<uint8_t>(expected);
+  _client->send_vector<uint8_t>(desired);
   return _client->receive_vector<uint8_t>();
 }
 
@@ -38,7 +38,17 @@ namespace phi {
 namespace distributed {
 
 enum class ReplyType { WAITING, STOP_WAIT, READY, NOT_READY };
-enum class Command { ADD, GET, CHECK, SET, WAIT, STOP };
+enum class Command {
+  ADD,
+  GET,
+  CHECK,
+  SET,
+  WAIT,
+  STOP,
+  MULTI_GET,
+  MULTI_SET,
+  COMPARE_SET
+};
 
 namespace detail {
 
@@ -61,7 +71,13 @@ class MasterDaemon {
   void _do_get(SocketType socket);
   void _do_check(SocketType socket);
   void _do_set(SocketType socket);
+  void _do_multi_get(SocketType socket);
+  void _do_multi_set(SocketType socket);
+  void _do_compare_set(SocketType socket);
+  void _set_value(const std::string& key, std::vector<uint8_t> value);
+  void _reply_values(SocketType socket, const std::vector<std::string>& keys);
   void _notify_waiting_sockets(const std::string&);
+  void _remove_waiting_socket(SocketType socket);
   SocketType _listen_socket;
   std::vector<SocketType> _sockets;
   std::unordered_map<std::string, std::vector<uint8_t>> _store;
@@ -71,6 +87,17 @@ class MasterDaemon {
   std::unordered_map<std::string, std::vector<SocketType>>
       _waiting_sockets;  // key -> list of waiting sockets
 
+  // A MULTI_GET waiting for its missing keys, replied with all the values at
+  // once when the last one is set, so that the waiters of a key need not come
+  // back to get it.
+  struct PendingGet {
+    SocketType socket;
+    std::vector<std::string> keys;
+    size_t num_missing;
+  };
+  std::unordered_map<std::string, std::vector<std::shared_ptr<PendingGet>>>
+      _pending_gets;  // key -> the pending gets missing it
+
   void InitControlFd();
   void CloseControlFd();
   void StopByControlFd();
@@ -99,6 +126,7 @@ class TCPClient {
                                             uint16_t port);
   ~TCPClient() { tcputils::close_socket(_socket); }
   void send_command_for_key(Command type, const std::string& key);
+  void send_string(const std::string& value);
 
   template <typename T>
   void send_value(const T& value);
@@ -134,6 +162,14 @@ class TCPStore : public Store {
   bool check(const std::string& key) override;
   void wait(const std::string& key) override;
   void set(const std::string& key, const std::vector<uint8_t>& value) override;
+  std::vector<std::vector<uint8_t>> multi_get(
+      const std::vector<std::string>& keys) override;
+  void multi_set(const std::vector<std::string>& keys,
+                 const std::vector<std::vector<uint8_t>>& values) override;
+  std::vector<uint8_t> compare_set(
+      const std::string& key,
+      const std::vector<uint8_t>& expected,
+      const std::vector<uint8_t>& desired) override;
 
  private:
   void waitWorkers();
@@ -15,6 +15,7 @@
 #include "paddle/phi/core/framework/dense_tensor_tostream.h"
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -22,6 +23,7 @@
 #include <utility>
 #include <vector>
 
+#include "paddle/common/flags.h"
 #include "paddle/phi/backends/context_pool.h"
 #include "paddle/phi/common/memory_utils.h"
 #include "paddle/phi/core/compat/convert_utils.h"
@@ -30,6 +32,8 @@
 #include "paddle/phi/core/tensor_utils.h"
 #include "paddle/phi/kernels/contiguous_kernel.h"
 
+COMMON_DECLARE_int64(tensor_stream_checksum_chunk_bytes);
+
 namespace phi {
 
 namespace proto = paddle::framework::proto;
@@ -94,6 +98,211 @@ phi::DenseTensor InnerTensorContiguous(const phi::DenseTensor& tensor) {
   return tensor;
 }
 
+namespace {
+
+// The data of a version 1 tensor is a sequence of chunks of chunk_bytes
+// bytes, the last one may be shorter, each followed by the uint32_t CRC-32 of
+// the chunk.
+constexpr uint32_t kChecksumVersion = 1;
+
+// The size of the host buffers between the device and the stream.
+constexpr size_t kDeviceBufSize = 1024 * 1024 * 64;  // 64MB
+
+uint32_t Crc32(uint32_t crc, const char* data, size_t size) {
+  static const std::array<uint32_t, 256> table = [] {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; ++k) {
+        c = (c & 1) ? 0xEDB88320U ^ (c >> 1) : c >> 1;
+      }
+      table[i] = c;
+    }
+    return table;
+  }();
+  crc = ~crc;
+  for (size_t i = 0; i < size; ++i) {
+    crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+// Writes the data of a tensor, with the checksum of each chunk if
+// chunk_bytes > 0.
+class TensorDataWriter {
+ public:
+  TensorDataWriter(std::ostream& os, uint64_t chunk_bytes)
+      : os_(os), chunk_bytes_(chunk_bytes) {}
+
+  void Write(const char* data, size_t size) {
+    if (chunk_bytes_ == 0) {
+      os_.write(data, static_cast<std::streamsize>(size));
+      return;
+    }
+    while (size != 0) {
+      size_t n = std::min<uint64_t>(size, chunk_bytes_ - filled_);
+      crc_ = Crc32(crc_, data, n);
+      os_.write(data, static_cast<std::streamsize>(n));
+      filled_ += n;
+      data += n;
+      size -= n;
+      if (filled_ == chunk_bytes_) {
+        EndChunk();
+      }
+    }
+  }
+
+  void Finish() {
+    if (filled_ != 0) {
+      EndChunk();
+    }
+  }
+
+ private:
+  void EndChunk() {
+    os_.write(reinterpret_cast<const char*>(&crc_), sizeof(crc_));
+    crc_ = 0;
+    filled_ = 0;
+  }
+
+  std::ostream& os_;
+  uint64_t chunk_bytes_;
+  uint64_t filled_{0};
+  uint32_t crc_{0};
+};
+
+// Reads the total bytes of the data of a tensor written by TensorDataWriter,
+// the checksum of each chunk is checked once the chunk is read.
+class TensorDataReader {
+ public:
+  TensorDataReader(std::istream& is, uint64_t chunk_bytes, uint64_t total)
+      : is_(is), chunk_bytes_(chunk_bytes), total_(total) {}
+
+  // Skips the first bytes of the data.
+  void Skip(uint64_t bytes) {
+    if (chunk_bytes_ == 0) {
+      is_.seekg(static_cast<std::streamoff>(bytes), is_.cur);  // NOLINT
+      offset_ = bytes;
+      return;
+    }
+    uint64_t chunks = bytes / chunk_bytes_;
+    is_.seekg(static_cast<std::streamoff>(chunks *  // NOLINT
+                                          (chunk_bytes_ + sizeof(uint32_t))),
+              is_.cur);
+    offset_ = chunks * chunk_bytes_;
+    // the head of the chunk is read to check the chunk
+    Discard(bytes - offset_);
+  }
+
+  void Read(char* data, size_t size) {
+    if (chunk_bytes_ == 0) {
+      is_.read(data, static_cast<std::streamsize>(size));  // NOLINT
+      offset_ += size;
+      return;
+    }
+    while (size != 0) {
+      uint64_t chunk_end =
+          std::min(total_, (offset_ / chunk_bytes_ + 1) * chunk_bytes_);
+      size_t n = std::min<uint64_t>(size, chunk_end - offset_);
+      is_.read(data, static_cast<std::streamsize>(n));  // NOLINT
+      crc_ = Crc32(crc_, data, n);
+      offset_ += n;
+      data += n;
+      size -= n;
+      if (offset_ == chunk_end) {
+        CheckChunk();
+      }
+    }
+  }
+
+  // Reads the rest of the chunk being read, if any, to check it.
+  void Finish() {
+    if (chunk_bytes_ != 0 && offset_ % chunk_bytes_ != 0 && offset_ < total_) {
+      Discard(std::min(total_, (offset_ / chunk_bytes_ + 1) * chunk_bytes_) -
+              offset_);
+    }
+  }
+
+ private:
+  void Discard(uint64_t bytes) {
+    std::vector<char> buf(std::min<uint64_t>(bytes, 1024 * 1024));
+    while (bytes != 0) {
+      size_t n = std::min<uint64_t>(bytes, buf.size());
+      Read(buf.data(), n);
+      bytes -= n;
+    }
+  }
+
+  void CheckChunk() {
+    uint32_t crc = 0;
+    is_.read(reinterpret_cast<char*>(&crc), sizeof(crc));
+    PADDLE_ENFORCE_EQ(
+        is_.good(),
+        true,
+        common::errors::Unavailable("Cannot read the tensor data of chunk %d.",
+                                    (offset_ - 1) / chunk_bytes_));
+    PADDLE_ENFORCE_EQ(crc,
+                      crc_,
+                      common::errors::InvalidArgument(
+                          "The checksum of chunk %d of the tensor data "
+                          "mismatches, the file may be damaged.",
+                          (offset_ - 1) / chunk_bytes_));
+    crc_ = 0;
+  }
+
+  std::istream& is_;
+  uint64_t chunk_bytes_;
+  uint64_t total_;
+  uint64_t offset_{0};
+  uint32_t crc_{0};
+};
+
+// Reads the version, the tensor description and the chunk size of version 1,
+// returns the chunk size, 0 for version 0.
+uint64_t TensorHeaderFromStream(std::istream& is,
+                                proto::VarType::TensorDesc* desc) {
+  uint32_t version = 0;
+  is.read(reinterpret_cast<char*>(&version), sizeof(version));
+  PADDLE_ENFORCE_EQ(
+      version == 0U || version == kChecksumVersion,
+      true,
+      common::errors::InvalidArgument(
+          "tensor version %u is not supported, Only version 0 and %u are "
+          "supported",
+          version,
+          kChecksumVersion));
+  {  // int32_t size
+     // proto buffer
+    int32_t size = -1;
+    is.read(reinterpret_cast<char*>(&size), sizeof(size));
+    PADDLE_ENFORCE_EQ(
+        is.good(),
+        true,
+        common::errors::Unavailable("Cannot read tensor desc size"));
+    PADDLE_ENFORCE_GE(size,
+                      0,
+                      common::errors::InvalidArgument(
+                          "phi::DenseTensor desc size should >= 0"));
+    std::unique_ptr<char[]> buf(new char[size]);  // NOLINT
+    is.read(reinterpret_cast<char*>(buf.get()), size);
+    PADDLE_ENFORCE_EQ(
+        desc->ParseFromArray(buf.get(), size),
+        true,
+        common::errors::InvalidArgument("Cannot parse tensor desc"));
+  }
+  uint64_t chunk_bytes = 0;
+  if (version == kChecksumVersion) {
+    is.read(reinterpret_cast<char*>(&chunk_bytes), sizeof(chunk_bytes));
+    PADDLE_ENFORCE_GT(chunk_bytes,
+                      0UL,
+                      common::errors::InvalidArgument(
+                          "The chunk size of the tensor data should be > 0"));
+  }
+  return chunk_bytes;
+}
+
+}  // namespace
+
 void TensorToStream(std::ostream& os,
                     const phi::DenseTensor& tensor,
                     const phi::DeviceContext& dev_ctx) {
@@ -104,8 +313,10 @@ void TensorToStream(std::ostream& os,
     return InnerTensorContiguous(tensor);
   };
   const phi::DenseTensor& contiguous_tensor = ensure_contiguous(tensor);
+  const uint64_t chunk_bytes =
+      std::max<int64_t>(FLAGS_tensor_stream_checksum_chunk_bytes, 0);
   {  // the 1st field, uint32_t version
-    constexpr uint32_t version = 0;
+    const uint32_t version = chunk_bytes > 0 ? kChecksumVersion : 0;
     os.write(reinterpret_cast<const char*>(&version), sizeof(version));
   }
   {  // the 2nd field, tensor description
@@ -123,6 +334,9 @@ void TensorToStream(std::ostream& os,
     auto out = desc.SerializeAsString();
     os.write(out.data(), size);
   }
+  if (chunk_bytes > 0) {  // the chunk size of version 1, uint64_t
+    os.write(reinterpret_cast<const char*>(&chunk_bytes), sizeof(chunk_bytes));
+  }
   {  // the 3rd field, tensor data
     uint64_t size =
         contiguous_tensor.numel() * phi::SizeOf(contiguous_tensor.dtype());
@@ -132,25 +346,43 @@ void TensorToStream(std::ostream& os,
                       (std::numeric_limits<std::streamsize>::max)(),
                       common::errors::ResourceExhausted(
                           "tensor size %d overflow when writing tensor", size));
+    TensorDataWriter writer(os, chunk_bytes);
     if (phi::is_gpu_place(contiguous_tensor.place())) {
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
-      constexpr size_t kBufSize = 1024 * 1024 * 64;  // 64MB
-      std::unique_ptr<char[]> buf(new char[kBufSize]);
+      // two pinned buffers, the copy of a chunk from the device overlaps the
+      // write of the previous chunk
       auto& gpu_dev_ctx = static_cast<const phi::GPUContext&>(dev_ctx);
-      phi::CPUPlace cpu;
+      phi::GPUPinnedPlace pinned;
+      size_t buf_size = std::min(kDeviceBufSize, static_cast<size_t>(size));
+      std::array<phi::Allocator::AllocationPtr, 2> bufs = {
+          phi::memory_utils::Alloc(pinned, buf_size),
+          phi::memory_utils::Alloc(pinned, buf_size)};
       uintptr_t data = reinterpret_cast<uintptr_t>(data_ptr);
-      while (size != 0) {
-        size_t size_to_write = std::min(kBufSize, static_cast<size_t>(size));
-        phi::memory_utils::Copy(cpu,
-                                buf.get(),
+      auto copy_chunk = [&](int idx, size_t size_to_copy) {
+        phi::memory_utils::Copy(pinned,
+                                bufs[idx]->ptr(),
                                 contiguous_tensor.place(),
                                 reinterpret_cast<const void*>(data),  // NOLINT
-                                size_to_write,
+                                size_to_copy,
                                 gpu_dev_ctx.stream());
+        data += size_to_copy;
+        size -= size_to_copy;
+      };
+      int cur = 0;
+      size_t size_to_write =
+          std::min(kDeviceBufSize, static_cast<size_t>(size));
+      if (size_to_write != 0) {
+        copy_chunk(cur, size_to_write);
+      }
+      while (size_to_write != 0) {
         gpu_dev_ctx.Wait();
-        os.write(buf.get(), size_to_write);
-        data += size_to_write;
-        size -= size_to_write;
+        size_t next = std::min(kDeviceBufSize, static_cast<size_t>(size));
+        if (next != 0) {
+          copy_chunk(cur ^ 1, next);
+        }
+        writer.Write(static_cast<const char*>(bufs[cur]->ptr()), size_to_write);
+        cur ^= 1;
+        size_to_write = next;
       }
 #else
       PADDLE_THROW(common::errors::Unimplemented(
@@ -158,20 +390,20 @@ void TensorToStream(std::ostream& os,
 #endif
     } else if (phi::is_xpu_place(contiguous_tensor.place())) {
 #ifdef PADDLE_WITH_XPU
-      constexpr size_t kBufSize = 1024 * 1024 * 64;  // 64MB
-      std::unique_ptr<char[]> buf(new char[kBufSize]);
+      std::unique_ptr<char[]> buf(new char[kDeviceBufSize]);
       auto& xpu_dev_ctx = static_cast<const phi::XPUContext&>(dev_ctx);
       phi::CPUPlace cpu;
       uintptr_t data = reinterpret_cast<uintptr_t>(data_ptr);
       while (size != 0) {
-        size_t size_to_write = std::min(kBufSize, static_cast<size_t>(size));
+        size_t size_to_write =
+            std::min(kDeviceBufSize, static_cast<size_t>(size));
         phi::memory_utils::Copy(cpu,
                                 buf.get(),
                                 contiguous_tensor.place(),
                                 reinterpret_cast<const void*>(data),
                                 size_to_write);
         xpu_dev_ctx.Wait();
-        os.write(buf.get(), size_to_write);
+        writer.Write(buf.get(), size_to_write);
         data += size_to_write;
         size -= size_to_write;
       }
@@ -181,14 +413,14 @@ void TensorToStream(std::ostream& os,
 #endif
     } else if (phi::is_custom_place(contiguous_tensor.place())) {
 #ifdef PADDLE_WITH_CUSTOM_DEVICE
-      constexpr size_t kBufSize = 1024 * 1024 * 64;     // 64MB
-      std::unique_ptr<char[]> buf(new char[kBufSize]);  // NOLINT
+      std::unique_ptr<char[]> buf(new char[kDeviceBufSize]);  // NOLINT
       auto& custom_device_context =
           static_cast<const phi::CustomContext&>(dev_ctx);
       phi::CPUPlace cpu;
       uintptr_t data = reinterpret_cast<uintptr_t>(data_ptr);
       while (size != 0) {
-        size_t size_to_write = std::min(kBufSize, static_cast<size_t>(size));
+        size_t size_to_write =
+            std::min(kDeviceBufSize, static_cast<size_t>(size));
         phi::memory_utils::Copy(cpu,
                                 buf.get(),
                                 contiguous_tensor.place(),
@@ -196,7 +428,7 @@ void TensorToStream(std::ostream& os,
                                 size_to_write,
                                 custom_device_context.stream());
         custom_device_context.Wait();
-        os.write(buf.get(), size_to_write);
+        writer.Write(buf.get(), size_to_write);
         data += size_to_write;
         size -= size_to_write;
       }
@@ -206,9 +438,9 @@ void TensorToStream(std::ostream& os,
           "CustomDevice"));
 #endif
     } else {
-      os.write(static_cast<const char*>(data_ptr),
-               static_cast<std::streamsize>(size));
+      writer.Write(static_cast<const char*>(data_ptr), size);
     }
+    writer.Finish();
   }
 }
 
@@ -230,145 +462,115 @@ struct DeserializedDataFunctor {
   phi::Place place_;
 };
 
+// Reads size bytes of data into the tensor resized already.
+static void TensorDataFromStream(TensorDataReader* reader,
+                                 phi::DenseTensor* tensor,
+                                 const phi::DeviceContext& dev_ctx,
+                                 proto::VarType::Type data_type,
+                                 size_t size) {
+  void* buf = nullptr;
+  phi::CPUContext ctx;
+  if (phi::is_gpu_place(dev_ctx.GetPlace())) {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    // read into two pinned buffers in turn, the read of a chunk overlaps the
+    // copy of the previous chunk to the device, so the tensor is never
+    // in host memory as a whole
+    auto& gpu_dev_ctx = static_cast<const phi::GPUContext&>(dev_ctx);
+    char* dst = static_cast<char*>(
+        dev_ctx.Alloc(tensor, phi::TransToPhiDataType(data_type)));
+    phi::GPUPinnedPlace pinned;
+    size_t buf_size = std::min(kDeviceBufSize, size);
+    std::array<phi::Allocator::AllocationPtr, 2> bufs = {
+        phi::memory_utils::Alloc(pinned, buf_size),
+        phi::memory_utils::Alloc(pinned, buf_size)};
+    int cur = 0;
+    while (size != 0) {
+      size_t size_to_read = std::min(kDeviceBufSize, size);
+      auto* host = static_cast<char*>(bufs[cur]->ptr());
+      reader->Read(host, size_to_read);
+      // the copy from this buffer two chunks ago is done
+      gpu_dev_ctx.Wait();
+      phi::memory_utils::Copy(dev_ctx.GetPlace(),
+                              dst,
+                              pinned,
+                              host,
+                              size_to_read,
+                              gpu_dev_ctx.stream());
+      dst += size_to_read;
+      size -= size_to_read;
+      cur ^= 1;
+    }
+    gpu_dev_ctx.Wait();
+#else
+    PADDLE_THROW(common::errors::Unimplemented(
+        "CUDAPlace is not supported when not compiled with CUDA"));
+#endif
+  } else if (phi::is_xpu_place(dev_ctx.GetPlace()) ||
+             phi::is_custom_place(dev_ctx.GetPlace())) {
+#if defined(PADDLE_WITH_XPU) || defined(PADDLE_WITH_CUSTOM_DEVICE)
+    phi::DenseTensor cpu_tensor;
+    cpu_tensor.Resize(tensor->dims());
+    VisitDataType(data_type,
+                  DeserializedDataFunctor(&buf, &cpu_tensor, ctx.GetPlace()));
+    reader->Read(static_cast<char*>(buf), size);
+    auto dst_place = dev_ctx.GetPlace();
+    phi::Copy(dev_ctx, cpu_tensor, dst_place, false, tensor);
+    if (phi::is_custom_place(dev_ctx.GetPlace())) {
+      dev_ctx.Wait();
+    }
+#else
+    if (phi::is_xpu_place(dev_ctx.GetPlace())) {
+      PADDLE_THROW(common::errors::Unimplemented(
+          "XPUPlace is not supported when not compiled with XPU"));
+    } else {
+      PADDLE_THROW(
+          common::errors::Unimplemented("CustomPlace is not supported when "
+                                        "not compiled with CustomDevice"));
+    }
+#endif
+  } else {
+    VisitDataType(data_type,
+                  DeserializedDataFunctor(&buf, tensor, ctx.GetPlace()));
+    reader->Read(static_cast<char*>(buf), size);
+  }
+}
+
 void TensorFromStream(std::istream& is,
                       phi::DenseTensor* tensor,
                       const phi::DeviceContext& dev_ctx,
                       const size_t& seek,
                       const std::vector<int64_t>& shape) {
-  uint32_t version = 0;
-  is.read(reinterpret_cast<char*>(&version), sizeof(version));
-
-  PADDLE_ENFORCE_EQ(
-      version,
-      0U,
-      common::errors::InvalidArgument(
-          "tensor version %u is not supported, Only version 0 is supported",
-          version));
-
   proto::VarType::TensorDesc desc;
-  {  // int32_t size
-    // proto buffer
-    int32_t size = 0;
-    is.read(reinterpret_cast<char*>(&size), sizeof(size));
-    std::unique_ptr<char[]> buf(new char[size]);  // NOLINT
-    is.read(reinterpret_cast<char*>(buf.get()), size);
-    PADDLE_ENFORCE_EQ(
-        desc.ParseFromArray(buf.get(), size),
-        true,
-        common::errors::InvalidArgument("Cannot parse tensor desc"));
-  }
+  uint64_t chunk_bytes = TensorHeaderFromStream(is, &desc);
   {  // read tensor
-    tensor->Resize(common::make_ddim(shape));
-    size_t seekg = seek * SizeOfType(desc.data_type());
-    is.seekg(seekg, is.cur);  // NOLINT
-
-    void* buf = nullptr;
-    phi::CPUContext ctx;
-    size_t size = tensor->numel() * SizeOfType(desc.data_type());
-    if (phi::is_gpu_place(dev_ctx.GetPlace()) ||
-        phi::is_xpu_place(dev_ctx.GetPlace()) ||
-        phi::is_custom_place(dev_ctx.GetPlace())) {
-#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP) || \
-    defined(PADDLE_WITH_XPU) || defined(PADDLE_WITH_CUSTOM_DEVICE)
-      phi::DenseTensor cpu_tensor;
-      cpu_tensor.Resize(common::make_ddim(shape));
-      VisitDataType(desc.data_type(),
-                    DeserializedDataFunctor(&buf, &cpu_tensor, ctx.GetPlace()));
-      is.read(static_cast<char*>(buf), size);  // NOLINT
-      auto dst_place = dev_ctx.GetPlace();
-      phi::Copy(dev_ctx, cpu_tensor, dst_place, false, tensor);
-      if (phi::is_custom_place(dev_ctx.GetPlace())) {
-        dev_ctx.Wait();
-      }
-#else
-      if (phi::is_gpu_place(dev_ctx.GetPlace())) {
-        PADDLE_THROW(common::errors::Unimplemented(
-            "CUDAPlace is not supported when not compiled with CUDA"));
-      } else if (phi::is_xpu_place(dev_ctx.GetPlace())) {
-        PADDLE_THROW(common::errors::Unimplemented(
-            "XPUPlace is not supported when not compiled with XPU"));
-      }
-#endif
-    } else {
-      VisitDataType(desc.data_type(),
-                    DeserializedDataFunctor(&buf, tensor, ctx.GetPlace()));
-      is.read(static_cast<char*>(buf), size);  // NOLINT
+    size_t type_size = SizeOfType(desc.data_type());
+    uint64_t total = type_size;
+    for (auto dim : desc.dims()) {
+      total *= dim;
     }
+    TensorDataReader reader(is, chunk_bytes, total);
+    reader.Skip(seek * type_size);
+
+    tensor->Resize(common::make_ddim(shape));
+    size_t size = tensor->numel() * type_size;
+    TensorDataFromStream(&reader, tensor, dev_ctx, desc.data_type(), size);
+    reader.Finish();
   }
 }
 
 void TensorFromStream(std::istream& is,
                       phi::DenseTensor* tensor,
                       const phi::DeviceContext& dev_ctx) {
-  uint32_t version = 0;
-  is.read(reinterpret_cast<char*>(&version), sizeof(version));
-  PADDLE_ENFORCE_EQ(
-      version,
-      0U,
-      common::errors::InvalidArgument(
-          "tensor version %u is not supported, Only version 0 is supported",
-          version));
   proto::VarType::TensorDesc desc;
-  {  // int32_t size
-     // proto buffer
-    int32_t size = -1;
-    is.read(reinterpret_cast<char*>(&size), sizeof(size));
-    PADDLE_ENFORCE_EQ(
-        is.good(),
-        true,
-        common::errors::Unavailable("Cannot read tensor desc size"));
-    PADDLE_ENFORCE_GE(size,
-                      0,
-                      common::errors::InvalidArgument(
-                          "phi::DenseTensor desc size should >= 0"));
-    std::unique_ptr<char[]> buf(new char[size]);  // NOLINT
-    is.read(reinterpret_cast<char*>(buf.get()), size);
-    PADDLE_ENFORCE_EQ(
-        desc.ParseFromArray(buf.get(), size),
-        true,
-        common::errors::InvalidArgument("Cannot parse tensor desc"));
-  }
+  uint64_t chunk_bytes = TensorHeaderFromStream(is, &desc);
   {  // read tensor
     std::vector<int64_t> dims;
     dims.reserve(static_cast<size_t>(desc.dims().size()));
     std::copy(desc.dims().begin(), desc.dims().end(), std::back_inserter(dims));
     tensor->Resize(common::make_ddim(dims));
-    void* buf = nullptr;
-    phi::CPUContext ctx;
     size_t size = tensor->numel() * SizeOfType(desc.data_type());
-    if (phi::is_gpu_place(dev_ctx.GetPlace()) ||
-        phi::is_xpu_place(dev_ctx.GetPlace()) ||
-        phi::is_custom_place(dev_ctx.GetPlace())) {
-#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP) || \
-    defined(PADDLE_WITH_XPU) || defined(PADDLE_WITH_CUSTOM_DEVICE)
-      phi::DenseTensor cpu_tensor;
-      cpu_tensor.Resize(common::make_ddim(dims));
-      VisitDataType(desc.data_type(),
-                    DeserializedDataFunctor(&buf, &cpu_tensor, ctx.GetPlace()));
-      is.read(static_cast<char*>(buf), size);  // NOLINT
-      auto dst_place = dev_ctx.GetPlace();
-      phi::Copy(dev_ctx, cpu_tensor, dst_place, false, tensor);
-      if (phi::is_custom_place(dev_ctx.GetPlace())) {
-        dev_ctx.Wait();
-      }
-#else
-      if (phi::is_gpu_place(dev_ctx.GetPlace())) {
-        PADDLE_THROW(common::errors::Unimplemented(
-            "CUDAPlace is not supported when not compiled with CUDA"));
-      } else if (phi::is_xpu_place(dev_ctx.GetPlace())) {
-        PADDLE_THROW(common::errors::Unimplemented(
-            "XPUPlace is not supported when not compiled with XPU"));
-      } else {
-        PADDLE_THROW(
-            common::errors::Unimplemented("CustomPlace is not supported when "
-                                          "not compiled with CustomDevice"));
-      }
-#endif
-    } else {
-      VisitDataType(desc.data_type(),
-                    DeserializedDataFunctor(&buf, tensor, ctx.GetPlace()));
-      is.read(static_cast<char*>(buf), size);  // NOLINT
-    }
+    TensorDataReader reader(is, chunk_bytes, size);
+    TensorDataFromStream(&reader, tensor, dev_ctx, desc.data_type(), size);
   }
 }
 
@@ -180,9 +180,13 @@ std::shared_ptr<std::mt19937_64> GetCPURandomEngine(uint64_t seed) {
 inline void Generator::print_state_info() {
   VLOG(4) << "Generator Random state "
           << "device id: " << state().device << ", seed: " << state().seed
-          << ", offset: " << state().offset << ", cpu_engine: " << cpu_engine();
+          << ", offset: " << offset_.load() << ", cpu_engine: " << cpu_engine();
 }
 
+inline void Generator::store_offset() { state().offset = offset_.load(); }
+
+inline void Generator::load_offset() { offset_.store(state().offset); }
+
 Generator::Generator() {
   auto seed = GetRandomSeed();
   current_index = states_.size();
@@ -203,32 +207,42 @@ Generator::Generator(uint64_t seed, int64_t device_id) {
   print_state_info();
 }
 
-phi::Generator::GeneratorState Generator::GetState() { return state(); }
+phi::Generator::GeneratorState Generator::GetState() {
+  std::lock_guard<std::shared_mutex> lock(mu_);
+  store_offset();
+  return state();
+}
 
 void Generator::SetState(const phi::Generator::GeneratorState& state) {
-  std::lock_guard<std::mutex> lock(mu_);
+  std::lock_guard<std::shared_mutex> lock(mu_);
   if (current_index < states_.size())
     states_[current_index] = state;
   else
     PADDLE_THROW(common::errors::NotFound("Generator index is not found"));
+  load_offset();
   print_state_info();
 }
 
 uint64_t Generator::GetStateIndex() { return current_index; }
 
 void Generator::SetStateIndex(uint64_t StateIndex) {
-  std::lock_guard<std::mutex> lock(mu_);
-  if (current_index < states_.size())
+  std::lock_guard<std::shared_mutex> lock(mu_);
+  if (current_index < states_.size()) {
+    store_offset();
     current_index = StateIndex;
-  else
+    load_offset();
+  } else {
     PADDLE_THROW(common::errors::NotFound("Generator index is not found"));
+  }
 }
 
 uint64_t Generator::RegisterStateIndex(const GeneratorState& state) {
-  std::lock_guard<std::mutex> lock(mu_);
+  std::lock_guard<std::shared_mutex> lock(mu_);
+  store_offset();
   auto new_index = states_.size();
   states_.push_back(state);
   current_index = new_index;
+  load_offset();
   return new_index;
 }
 
@@ -244,20 +258,24 @@ inline std::shared_ptr<std::mt19937_64> Generator::cpu_engine() {
 }
 
 uint64_t Generator::GetCurrentSeed() {
-  std::lock_guard<std::mutex> lock(mu_);
+  std::shared_lock<std::shared_mutex> lock(mu_);
   return state().seed;
 }
 
+uint64_t Generator::GetCurrentOffset() { return offset_.load(); }
+
 uint64_t Generator::Seed() {
-  std::lock_guard<std::mutex> lock(mu_);
+  std::lock_guard<std::shared_mutex> lock(mu_);
   uint64_t seed = GetRandomSeed();
   state().reset(seed);
+  load_offset();
   return seed;
 }
 
 void Generator::SetCurrentSeed(uint64_t seed) {
-  std::lock_guard<std::mutex> lock(mu_);
+  std::lock_guard<std::shared_mutex> lock(mu_);
   state().reset(seed);
+  load_offset();
 }
 
 std::shared_ptr<std::mt19937_64> Generator::GetCPUEngine() {
@@ -265,7 +283,7 @@ std::shared_ptr<std::mt19937_64> Generator::GetCPUEngine() {
 }
 
 uint64_t Generator::Random64() {
-  std::lock_guard<std::mutex> lock(mu_);
+  std::lock_guard<std::shared_mutex> lock(mu_);
   auto current_engine = cpu_engine();
   return (*current_engine)();
 }
@@ -273,10 +291,9 @@ uint64_t Generator::Random64() {
 std::pair<uint64_t, uint64_t> Generator::IncrementOffset(uint64_t increment) {
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP) || \
     defined(PADDLE_WITH_CUSTOM_DEVICE) || defined(PADDLE_WITH_XPU)
-  std::lock_guard<std::mutex> lock(mu_);
-  uint64_t offset = state().offset;
-  state().offset = offset + increment;
-  print_state_info();
+  std::shared_lock<std::shared_mutex> lock(mu_);
+  uint64_t offset = offset_.fetch_add(increment);
+  VLOG(4) << "Generator increment offset: " << offset << " + " << increment;
   return std::make_pair(state().seed, offset);
 #else
   PADDLE_THROW(common::errors::PermissionDenied(
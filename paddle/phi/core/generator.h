@@ -17,9 +17,11 @@ limitations under the License. */
 #include <atomic>
 #include <cstdint>
 #include <deque>
+#include <atomic>
 #include <memory>
 #include <mutex>  // NOLINT
 #include <random>
+#include <shared_mutex>
 #include <typeinfo>
 #include <utility>
 #include <vector>
@@ -122,7 +124,8 @@ class Generator {
   uint64_t Random64();
 
   // Increments the offset of the current generator state by a specified amount
-  // and returns the new seed and offset.
+  // and returns the new seed and offset. Concurrent increments only take the
+  // shared lock, so random ops on different streams do not serialize here.
   std::pair<uint64_t, uint64_t> IncrementOffset(uint64_t increment_offset);
 
  private:
@@ -132,10 +135,17 @@ class Generator {
   inline std::shared_ptr<std::mt19937_64> cpu_engine();
   // Outputs detailed information about the current generator state to the log.
   inline void print_state_info();
+  // Writes offset_ back to the current state, under the exclusive lock.
+  inline void store_offset();
+  // Reloads offset_ from the current state, under the exclusive lock.
+  inline void load_offset();
 
   size_t current_index = 0;
   std::vector<GeneratorState> states_;
-  mutable std::mutex mu_;
+  // The live offset of the current state, the offset kept in states_ is only
+  // up to date after store_offset().
+  std::atomic<uint64_t> offset_{0};
+  mutable std::shared_mutex mu_;
 };
 
 // The DefaultCPUGenerator is used in manual_seed()
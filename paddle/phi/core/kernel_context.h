@@ -15,7 +15,9 @@
 #pragma once
 
 #include <iterator>
+#include <memory>
 #include <utility>
+#include <vector>
 
 #include "paddle/phi/core/attribute.h"
 #include "paddle/phi/core/device_context.h"
@@ -102,6 +104,23 @@ class KernelContext {
     return v;
   }
 
+  // The same as InputsBetween, for the calls of the kernels. The vector is
+  // kept in the context when the range buffers are reused, so that a context
+  // run many times refreshes the pointers instead of allocating a vector per
+  // run, otherwise the inputs are put in *buffer.
+  template <typename TensorType>
+  const std::vector<const TensorType*>& InputsBetween(
+      size_t start, size_t end, std::vector<const TensorType*>* buffer) {
+    auto* v = reuse_range_buffers_
+                  ? RangeBufferAt<const TensorType*>(&input_buffers_, start)
+                  : buffer;
+    v->resize(end - start);
+    for (size_t i = start; i < end; ++i) {
+      (*v)[i - start] = static_cast<const TensorType*>(inputs_.at(i));
+    }
+    return *v;
+  }
+
   template <typename TensorType>
   paddle::optional<std::vector<const TensorType*>> OptionalInputsBetween(
       size_t start, size_t end) {
@@ -145,6 +164,28 @@ class KernelContext {
     return v;
   }
 
+  // The same as MutableOutputBetween, reusing the vectors as InputsBetween
+  // does.
+  template <typename TensorType>
+  const std::vector<TensorType*>& MutableOutputBetween(
+      size_t start, size_t end, std::vector<TensorType*>* buffer) {
+    auto* v = reuse_range_buffers_
+                  ? RangeBufferAt<TensorType*>(&output_buffers_, start)
+                  : buffer;
+    v->clear();
+    bool is_empty_vector = true;
+    for (size_t i = start; i < end; ++i) {
+      v->emplace_back(static_cast<TensorType*>(outputs_.at(i)));
+      if (outputs_.at(i) != nullptr) {
+        is_empty_vector = false;
+      }
+    }
+    if (is_empty_vector) {
+      v->clear();
+    }
+    return *v;
+  }
+
   template <typename AttrType>
   const AttrType& AttrAt(size_t idx) const;
   const Attribute& AttrAt(size_t idx) const;
@@ -158,9 +199,41 @@ class KernelContext {
     input_range_.clear();
     outputs_.clear();
     output_range_.clear();
+    input_buffers_.clear();
+    output_buffers_.clear();
   }
 
+  // For a context which is built once and run many times, e.g. the one of
+  // PhiKernelInstruction.
+  void SetReuseRangeBuffers(bool reuse) { reuse_range_buffers_ = reuse; }
+
  private:
+  // The vector of a vector input or output, keyed by the start of its range.
+  struct RangeBuffer {
+    const void* type = nullptr;
+    std::shared_ptr<void> data;
+  };
+
+  template <typename T>
+  static const void* RangeBufferType() {
+    static const char type = 0;
+    return &type;
+  }
+
+  template <typename T>
+  std::vector<T>* RangeBufferAt(std::vector<RangeBuffer>* buffers,
+                                size_t start) {
+    if (buffers->size() <= start) {
+      buffers->resize(start + 1);
+    }
+    auto& buffer = (*buffers)[start];
+    if (buffer.type != RangeBufferType<T>()) {
+      buffer.type = RangeBufferType<T>();
+      buffer.data = std::make_shared<std::vector<T>>();
+    }
+    return static_cast<std::vector<T>*>(buffer.data.get());
+  }
+
   DeviceContext* dev_ctx_;
 
   paddle::small_vector<const TensorBase*> inputs_;
@@ -170,6 +243,10 @@ class KernelContext {
   paddle::small_vector<std::pair<int, int>, kInputSmallVectorSize> input_range_;
   paddle::small_vector<std::pair<int, int>, kOutputSmallVectorSize>
       output_range_;
+
+  bool reuse_range_buffers_ = false;
+  std::vector<RangeBuffer> input_buffers_;
+  std::vector<RangeBuffer> output_buffers_;
 };
 
 }  // namespace phi
@@ -32,6 +32,11 @@ PHI_DEFINE_EXPORTED_bool(use_stride_kernel,
                          true,
                          "Whether to use stride kernel if op support stride.");
 
+PHI_DEFINE_EXPORTED_bool(
+    use_kernel_selection_cache,
+    true,
+    "Whether to cache the selected kernels at the call sites of the apis.");
+
 COMMON_DECLARE_int32(low_precision_op_list);
 COMMON_DECLARE_bool(enable_api_kernel_fallback);
 PD_DECLARE_bool(run_kp_kernel);
@@ -408,6 +413,49 @@ KernelResult KernelFactory::SelectKernelOrThrowError(
   return {kernel_iter->second, false, false};
 }
 
+KernelResult KernelSelectionCache::SelectKernelOrThrowError(
+    const std::string& kernel_name,
+    const KernelKey& kernel_key,
+    bool use_strided_kernel) {
+  auto& kernel_factory = KernelFactory::Instance();
+  if (!FLAGS_use_kernel_selection_cache) {
+    return kernel_factory.SelectKernelOrThrowError(
+        kernel_name, kernel_key, use_strided_kernel);
+  }
+  // The flags which change the result of the selection are a part of the key.
+  uint32_t mode = (FLAGS_use_stride_kernel && use_strided_kernel ? 1U : 0U) |
+                  (FLAGS_enable_api_kernel_fallback ? 2U : 0U);
+#if defined(PADDLE_WITH_XPU_KP)
+  mode |= FLAGS_run_kp_kernel ? 4U : 0U;
+#endif
+  uint64_t version = kernel_factory.version();
+  if (version != version_) {
+    size_ = 0;
+    next_ = 0;
+    version_ = version;
+  }
+  for (size_t i = 0; i < size_; ++i) {
+    const auto& entry = entries_[i];
+    if (entry.mode == mode && entry.kernel_key == kernel_key) {
+      return {*entry.kernel, entry.has_fallback_cpu, entry.is_stride_kernel};
+    }
+  }
+
+  auto result = kernel_factory.SelectKernelOrThrowError(
+      kernel_name, kernel_key, use_strided_kernel);
+  auto& entry = entries_[next_];
+  entry.kernel_key = kernel_key;
+  entry.mode = mode;
+  entry.kernel = &result.kernel;
+  entry.has_fallback_cpu = result.has_fallback_cpu;
+  entry.is_stride_kernel = result.is_stride_kernel;
+  next_ = (next_ + 1) % kCapacity;
+  if (size_ < kCapacity) {
+    ++size_;
+  }
+  return result;
+}
+
 const KernelArgsDef& KernelFactory::GetFirstKernelArgsDef(
     const std::string& kernel_name) const {
   auto iter = kernels_.find(kernel_name);
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <map>
 #include <ostream>
 #include <unordered_map>
@@ -317,7 +319,14 @@ class KernelFactory {
  public:
   static KernelFactory& Instance();
 
-  KernelNameMap& kernels() { return kernels_; }
+  // The mutable access may change the registered kernels, so the selection
+  // caches built before are invalidated.
+  KernelNameMap& kernels() {
+    version_.fetch_add(1, std::memory_order_relaxed);
+    return kernels_;
+  }
+
+  uint64_t version() const { return version_.load(std::memory_order_relaxed); }
 
   bool HasCompatiblePhiKernel(const std::string& op_type) const;
 
@@ -353,10 +362,42 @@ class KernelFactory {
 
   KernelNameMap kernels_;
 
+  std::atomic<uint64_t> version_{0};
+
   // Get the low precision kernel list of current module.
   std::map<const std::string, OpCount> low_precision_kernels_;
 };
 
+/**
+ * Note: The inline cache of SelectKernelOrThrowError for one call site which
+ *       always selects the same kernel name, such as the generated eager
+ *       apis. It keeps the last few kernel keys and the selected kernels, so
+ *       the string keyed lookups and the fallback checks are skipped once it
+ *       is warm. It is not thread safe, define it as thread_local.
+ */
+class KernelSelectionCache {
+ public:
+  KernelResult SelectKernelOrThrowError(const std::string& kernel_name,
+                                        const KernelKey& kernel_key,
+                                        bool use_strided_kernel = false);
+
+ private:
+  struct Entry {
+    KernelKey kernel_key;
+    uint32_t mode{0};
+    const Kernel* kernel{nullptr};
+    bool has_fallback_cpu{false};
+    bool is_stride_kernel{false};
+  };
+
+  static constexpr size_t kCapacity = 4;
+
+  std::array<Entry, kCapacity> entries_;
+  size_t size_{0};
+  size_t next_{0};
+  uint64_t version_{0};
+};
+
 inline std::ostream& operator<<(std::ostream& os, const KernelKey& kernel_key) {
   os << "(" << kernel_key.backend() << ", " << kernel_key.layout() << ", "
      << kernel_key.dtype() << ")";
@@ -119,8 +119,10 @@ namespace phi {
       static_assert(out_idx == 0,                                            \
                     "Kernel's Input should appear before Outputs.");         \
       const std::pair<int, int>& range = ctx->InputRangeAt(in_idx);          \
-      std::vector<const tensor_type*> arg =                                  \
-          ctx->InputsBetween<tensor_type>(range.first, range.second);        \
+      std::vector<const tensor_type*> buffer;                                \
+      const std::vector<const tensor_type*>& arg =                           \
+          ctx->InputsBetween<tensor_type>(                                   \
+              range.first, range.second, &buffer);                           \
       KernelCallHelper<Tail...>::                                            \
           template Compute<dev_ctx_idx, in_idx + 1, attr_idx, out_idx>(      \
               ctx, pargs..., arg);                                           \
@@ -214,8 +216,10 @@ namespace phi {
               typename... PreviousArgs>                                      \
     static void Compute(KernelContext* ctx, PreviousArgs&... pargs) {        \
       const std::pair<int, int>& range = ctx->OutputRangeAt(out_idx);        \
-      std::vector<tensor_type*> arg =                                        \
-          ctx->MutableOutputBetween<tensor_type>(range.first, range.second); \
+      std::vector<tensor_type*> buffer;                                      \
+      const std::vector<tensor_type*>& arg =                                 \
+          ctx->MutableOutputBetween<tensor_type>(                            \
+              range.first, range.second, &buffer);                           \
       KernelCallHelper<Tail...>::                                            \
           template Compute<dev_ctx_idx, in_idx, attr_idx, out_idx + 1>(      \
               ctx, pargs..., arg);                                           \
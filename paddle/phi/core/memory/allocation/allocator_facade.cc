@@ -26,6 +26,7 @@
 #include "paddle/phi/core/memory/allocation/cpu_allocator.h"
 #include "paddle/phi/core/memory/allocation/naive_best_fit_allocator.h"
 #include "paddle/phi/core/memory/allocation/retry_allocator.h"
+#include "paddle/phi/core/memory/allocation/size_class_cache_allocator.h"
 #include "paddle/phi/core/memory/allocation/stat_allocator.h"
 #include "paddle/phi/core/platform/device_context.h"
 
@@ -114,8 +115,12 @@ PHI_DEFINE_EXPORTED_bool(
 COMMON_DECLARE_string(allocator_strategy);
 COMMON_DECLARE_uint64(auto_growth_chunk_size_in_mb);
 COMMON_DECLARE_bool(use_auto_growth_pinned_allocator);
+COMMON_DECLARE_uint64(cuda_pinned_memory_pool_max_size_in_mb);
 COMMON_DECLARE_bool(use_cuda_malloc_async_allocator);
 COMMON_DECLARE_bool(auto_free_cudagraph_allocations_on_launch);
+COMMON_DECLARE_bool(use_size_class_cache_allocator);
+COMMON_DECLARE_uint64(size_class_cache_max_size_in_kb);
+COMMON_DECLARE_uint64(size_class_cache_thread_capacity);
 
 namespace paddle::memory::allocation {
 
@@ -251,6 +256,13 @@ class AllocatorFacadePrivate {
                                       allow_free_idle_chunk_);
         }
         auto_growth_allocators_ = allocators_;
+        if (!FLAGS_use_cuda_malloc_async_allocator) {
+          for (int dev_id = 0; dev_id < platform::GetGPUDeviceCount();
+               ++dev_id) {
+            phi::GPUPlace place(dev_id);
+            WrapSizeClassCacheAllocator(&allocators_[place], place);
+          }
+        }
 
         // Note(Ruibiao): For GPU multi-stream case without CUDA graph
         // capturing, the 'allocators_' map(place -> Allocator) hold the
@@ -289,6 +301,8 @@ class AllocatorFacadePrivate {
         for (int dev_id = 0; dev_id < platform::GetXPUDeviceCount(); ++dev_id) {
           InitAutoGrowthXPUAllocator(phi::XPUPlace(dev_id),
                                      allow_free_idle_chunk_);
+          WrapSizeClassCacheAllocator(&allocators_[phi::XPUPlace(dev_id)],
+                                      phi::XPUPlace(dev_id));
         }
         if (FLAGS_use_stream_safe_cuda_allocator) {
           WrapStreamSafeXPUAllocatorForDefault();
@@ -306,8 +320,9 @@ class AllocatorFacadePrivate {
         for (const auto& dev_type : device_types) {
           for (auto& dev_id :
                phi::DeviceManager::GetSelectedDeviceList(dev_type)) {
-            InitAutoGrowthCustomDeviceAllocator(
-                phi::CustomPlace(dev_type, dev_id), allow_free_idle_chunk);
+            phi::CustomPlace place(dev_type, dev_id);
+            InitAutoGrowthCustomDeviceAllocator(place, allow_free_idle_chunk);
+            WrapSizeClassCacheAllocator(&allocators_[place], place);
           }
         }
         if (FLAGS_use_stream_safe_cuda_allocator) {
@@ -840,13 +855,18 @@ class AllocatorFacadePrivate {
       auto chunk_size = FLAGS_auto_growth_chunk_size_in_mb << 20;
       VLOG(4) << "FLAGS_auto_growth_chunk_size_in_mb is "
               << FLAGS_auto_growth_chunk_size_in_mb;
-      auto pinned_allocator = std::make_shared<CPUPinnedAllocator>();
+      auto pinned_allocator = std::make_shared<CPUPinnedAllocator>(
+          FLAGS_cuda_pinned_memory_pool_max_size_in_mb << 20);
       allocators_[phi::GPUPinnedPlace()] =
           std::make_shared<AutoGrowthBestFitAllocator>(
               pinned_allocator,
               phi::backends::cpu::CUDAPinnedMinChunkSize(),
               chunk_size,
               allow_free_idle_chunk_);
+      // the fetches and the staging copies allocate the same few sizes over
+      // and over
+      WrapSizeClassCacheAllocator(&allocators_[phi::GPUPinnedPlace()],
+                                  phi::GPUPinnedPlace());
     } else {
       allocators_[phi::GPUPinnedPlace()] =
           std::make_shared<NaiveBestFitAllocator>(phi::GPUPinnedPlace());
@@ -910,6 +930,7 @@ class AllocatorFacadePrivate {
         VLOG(8) << "Init CUDA allocator for stream " << stream << " in place "
                 << p;
         InitAutoGrowthCUDAAllocator(p, stream);
+        WrapSizeClassCacheAllocator(&cuda_allocators_[p][stream], p);
         WrapStreamSafeCUDAAllocator(p, stream);
         WrapCUDARetryAllocator(p, stream, FLAGS_gpu_allocator_retry_time);
         WrapStatAllocator(p, stream);
@@ -1279,6 +1300,7 @@ class AllocatorFacadePrivate {
       VLOG(8) << "Init XPU allocator for stream " << stream << " in place "
               << p;
       InitAutoGrowthXPUAllocator(p, stream);
+      WrapSizeClassCacheAllocator(&xpu_allocators_[p][stream], p);
 
       WrapStreamSafeXPUAllocator(p, stream);
 
@@ -1389,6 +1411,7 @@ class AllocatorFacadePrivate {
       VLOG(8) << "Init StreamSafeCustomDeviceAllocator for stream " << stream
               << " in place " << p;
       InitAutoGrowthCustomDeviceAllocator(p, stream);
+      WrapSizeClassCacheAllocator(&custom_device_allocators_[p][stream], p);
       WrapStreamSafeCustomDeviceAllocator(p, stream);
     }
   }
@@ -1560,6 +1583,21 @@ class AllocatorFacadePrivate {
     }
   }
 
+  // Put per-thread size-class free lists in front of an auto_growth
+  // allocator. It sits below the stream safe allocator, so a block reaches
+  // the cache only after all streams using it are done.
+  void WrapSizeClassCacheAllocator(std::shared_ptr<Allocator>* allocator,
+                                   const phi::Place& place) {
+    if (!FLAGS_use_size_class_cache_allocator) {
+      return;
+    }
+    *allocator = std::make_shared<SizeClassCacheAllocator>(
+        *allocator,
+        place,
+        FLAGS_size_class_cache_max_size_in_kb << 10,
+        FLAGS_size_class_cache_thread_capacity);
+  }
+
   void WrapStatAllocator() {
     for (auto& pair : allocators_) {
       // Now memory stats is only supported for CPU, GPU, XPU and CustomDevice
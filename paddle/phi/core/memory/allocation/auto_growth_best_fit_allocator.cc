@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <mutex>  // NOLINT
+#include <sstream>
 #include <utility>
 
 #include "paddle/common/flags.h"
@@ -85,6 +86,42 @@ void AutoGrowthBestFitAllocator::DumpInfo() const {
               << std::endl;
   }
 }
+AutoGrowthBestFitAllocator::FragmentationInfo
+AutoGrowthBestFitAllocator::GetFragmentationInfo() {
+  std::lock_guard<SpinLock> guard(spinlock_);
+  FragmentationInfo info;
+  info.num_chunks = chunks_.size();
+  for (auto &chunk : chunks_) {
+    info.reserved_bytes += chunk.allocation_->size();
+  }
+  for (auto &pair : free_blocks_) {
+    size_t size = pair.first.first;
+    info.free_bytes += size;
+    ++info.num_free_blocks;
+    info.largest_free_block = std::max(info.largest_free_block, size);
+    int bucket = 0;
+    while ((size >> (bucket + 1)) > 0) {
+      ++bucket;
+    }
+    ++info.free_block_histogram[bucket];
+  }
+  return info;
+}
+
+std::string AutoGrowthBestFitAllocator::FragmentationReport() {
+  auto info = GetFragmentationInfo();
+  std::ostringstream os;
+  os << "chunks:" << info.num_chunks << " reserved:" << info.reserved_bytes
+     << " free:" << info.free_bytes << " free_blocks:" << info.num_free_blocks
+     << " largest_free_block:" << info.largest_free_block
+     << " fragmentation:" << info.Fragmentation() << "\n";
+  for (auto &pair : info.free_block_histogram) {
+    os << "  [" << (size_t{1} << pair.first) << ", "
+       << (size_t{1} << (pair.first + 1)) << "): " << pair.second << "\n";
+  }
+  return os.str();
+}
+
 phi::Allocation *AutoGrowthBestFitAllocator::AllocateImpl(
     size_t unaligned_size) {
   phi::RecordEvent record("AutoGrowthBestFitAllocator::Allocate",
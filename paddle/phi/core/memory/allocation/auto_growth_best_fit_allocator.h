@@ -18,6 +18,7 @@
 #include <map>
 #include <memory>
 #include <mutex>  // NOLINT
+#include <string>
 #include <utility>
 
 #include "paddle/phi/core/memory/allocation/allocator.h"
@@ -39,6 +40,29 @@ class AutoGrowthBestFitAllocator : public Allocator {
 
   void DumpInfo() const;
 
+  // The free blocks of the chunks, which are fragmented if the largest one is
+  // much less than all of them.
+  struct FragmentationInfo {
+    size_t num_chunks{0};
+    size_t reserved_bytes{0};
+    size_t free_bytes{0};
+    size_t num_free_blocks{0};
+    size_t largest_free_block{0};
+    // the number of the free blocks of the sizes in [2^i, 2^(i+1))
+    std::map<int, size_t> free_block_histogram;
+
+    // 1 - largest_free_block / free_bytes, 0 if not fragmented at all
+    double Fragmentation() const {
+      return free_bytes == 0 ? 0.
+                             : 1. - static_cast<double>(largest_free_block) /
+                                        static_cast<double>(free_bytes);
+    }
+  };
+
+  FragmentationInfo GetFragmentationInfo();
+
+  std::string FragmentationReport();
+
  protected:
   phi::Allocation *AllocateImpl(size_t size) override;
 
@@ -16,11 +16,19 @@
 
 #include <cstdlib>
 
+#include "glog/logging.h"
+#include "paddle/common/flags.h"
 #include "paddle/phi/core/enforce.h"
 #include "paddle/phi/core/memory/stats.h"
+#include "paddle/phi/core/os_info.h"
+
+COMMON_DECLARE_bool(numa_aware_placement);
 
 namespace paddle::memory::allocation {
 
+// the smaller allocations are left to the first touch of the pages
+constexpr size_t kNumaBindMinSize = 1UL << 20;
+
 bool CPUAllocator::IsAllocThreadSafe() const { return true; }
 
 void CPUAllocator::FreeImpl(phi::Allocation *allocation) {
@@ -47,6 +55,13 @@ phi::Allocation *CPUAllocator::AllocateImpl(size_t size) {
       common::errors::ResourceExhausted(
           "Fail to alloc memory of %ld size, error code is %d.", size, error));
 #endif
+  if (FLAGS_numa_aware_placement && size >= kNumaBindMinSize) {
+    // the memory reused from the other threads may be on the other nodes
+    int node = phi::GetCurrentThreadNumaNode();
+    if (node >= 0 && !phi::BindMemoryToNumaNode(p, size, node)) {
+      VLOG(4) << "Fail to bind " << size << " bytes to NUMA node " << node;
+    }
+  }
   HOST_MEMORY_STAT_UPDATE(Reserved, 0, size);
   return new Allocation(p, size, phi::CPUPlace());
 }
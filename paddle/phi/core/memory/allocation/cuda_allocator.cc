@@ -26,6 +26,7 @@
 #include <string>
 
 #include "paddle/phi/core/enforce.h"
+#include "paddle/phi/core/memory/allocation_recorder.h"
 #include "paddle/phi/core/platform/cuda_device_guard.h"
 #include "paddle/phi/core/platform/device/gpu/gpu_info.h"
 
@@ -68,6 +69,11 @@ phi::Allocation* CUDAAllocator::AllocateImpl(size_t size) {
         limit_size);
   }
 
+  auto& recorder = AllocationRecorder::Instance();
+  if (recorder.IsEnabled()) {
+    LOG(WARNING) << recorder.PeakReport(phi::Place(place_));
+  }
+
   PADDLE_THROW_BAD_ALLOC(common::errors::ResourceExhausted(
       "\n\nOut of memory error on GPU %d. "
       "Cannot allocate %s memory on GPU %d, %s memory has been allocated and "
@@ -25,10 +25,13 @@
 
 #include <string>
 
+#include "paddle/common/flags.h"
 #include "paddle/phi/core/enforce.h"
 #include "paddle/phi/core/platform/cuda_device_guard.h"
 #include "paddle/phi/core/platform/device/gpu/gpu_info.h"
 
+COMMON_DECLARE_uint64(cuda_managed_memory_prefetch_min_size_in_mb);
+
 namespace paddle {
 namespace memory {
 namespace allocation {
@@ -55,6 +58,17 @@ phi::Allocation* CUDAManagedAllocator::AllocateImpl(size_t size) {
                                             dev_id,
                                             /* malloc_managed_memory = */ true);
   if (LIKELY(result == gpuSuccess)) {
+#ifdef PADDLE_WITH_CUDA
+    if (FLAGS_cuda_managed_memory_prefetch_min_size_in_mb > 0 &&
+        platform::IsGPUManagedMemoryOversubscriptionSupported(dev_id)) {
+      // keep the pages on the GPU, and let the GPU map the evicted pages
+      // instead of faulting them back one by one
+      PADDLE_ENFORCE_GPU_SUCCESS(
+          cudaMemAdvise(ptr, size, cudaMemAdviseSetPreferredLocation, dev_id));
+      PADDLE_ENFORCE_GPU_SUCCESS(
+          cudaMemAdvise(ptr, size, cudaMemAdviseSetAccessedBy, dev_id));
+    }
+#endif
     return new Allocation(ptr, size, phi::Place(place_));
   }
 
@@ -132,17 +132,49 @@ void CUDAVirtualMemAllocator::FreeImpl(phi::Allocation* allocation) {
     cudaSetDevice(prev_id);
   }
 
+  ReturnVirtualRange(iter->first, iter->second.second);
   virtual_2_physical_map_.erase(iter);
 
   delete allocation;
 }
 
+void CUDAVirtualMemAllocator::ReturnVirtualRange(CUdeviceptr ptr,
+                                                 size_t size) {
+  auto next = free_virtual_ranges_.lower_bound(ptr);
+  if (next != free_virtual_ranges_.end() && ptr + size == next->first) {
+    size += next->second;
+    next = free_virtual_ranges_.erase(next);
+  }
+  if (next != free_virtual_ranges_.begin()) {
+    auto prev = std::prev(next);
+    if (prev->first + prev->second == ptr) {
+      ptr = prev->first;
+      size += prev->second;
+      free_virtual_ranges_.erase(prev);
+    }
+  }
+  if (ptr + size == virtual_mem_base_ + virtual_mem_alloced_offset_) {
+    virtual_mem_alloced_offset_ = ptr - virtual_mem_base_;
+  } else {
+    free_virtual_ranges_.emplace(ptr, size);
+  }
+}
+
 phi::Allocation* CUDAVirtualMemAllocator::AllocateImpl(size_t size) {
   size = AlignedSize(size, granularity_);
 
-  CUdeviceptr ptr = virtual_mem_base_ + virtual_mem_alloced_offset_;
+  // map into the lowest unmapped range that fits, so that the chunk may be
+  // adjacent to the others, or else grow the mapped ranges
+  auto range_it = free_virtual_ranges_.begin();
+  while (range_it != free_virtual_ranges_.end() && range_it->second < size) {
+    ++range_it;
+  }
+  bool from_free_range = range_it != free_virtual_ranges_.end();
+  CUdeviceptr ptr = from_free_range
+                        ? range_it->first
+                        : virtual_mem_base_ + virtual_mem_alloced_offset_;
 
-  if (ptr + size > virtual_mem_base_ + virtual_mem_size_) {
+  if (!from_free_range && ptr + size > virtual_mem_base_ + virtual_mem_size_) {
     PADDLE_THROW_BAD_ALLOC(common::errors::ResourceExhausted(
         "\n\nOut of memory error on GPU Virtual Memory %d. "
         "Cannot allocate %s memory on GPU Virtual Memory %d, %s memory has "
@@ -217,7 +249,15 @@ phi::Allocation* CUDAVirtualMemAllocator::AllocateImpl(size_t size) {
 
   virtual_2_physical_map_.emplace(ptr, std::make_pair(handle, size));
 
-  virtual_mem_alloced_offset_ += size;
+  if (from_free_range) {
+    size_t rest_size = range_it->second - size;
+    free_virtual_ranges_.erase(range_it);
+    if (rest_size > 0) {
+      free_virtual_ranges_.emplace(ptr + size, rest_size);
+    }
+  } else {
+    virtual_mem_alloced_offset_ += size;
+  }
 
   return new Allocation(
       reinterpret_cast<void*>(ptr), size, phi::Place(place_));  // NOLINT
@@ -20,6 +20,7 @@
 #include "paddle/phi/core/platform/cuda_device_guard.h"
 #endif
 
+#include <map>
 #include <mutex>  // NOLINT
 
 #include "paddle/phi/common/place.h"
@@ -43,6 +44,9 @@ class CUDAVirtualMemAllocator : public Allocator {
   phi::Allocation* AllocateImpl(size_t size) override;
 
  private:
+  // Return the unmapped virtual range to be mapped again.
+  void ReturnVirtualRange(CUdeviceptr ptr, size_t size);
+
   phi::GPUPlace place_;
 
   CUdeviceptr virtual_mem_base_;
@@ -55,6 +59,8 @@ class CUDAVirtualMemAllocator : public Allocator {
 
   std::map<CUdeviceptr, std::pair<CUmemGenericAllocationHandle, size_t>>
       virtual_2_physical_map_;
+  // the unmapped ranges below virtual_mem_alloced_offset_ by their address
+  std::map<CUdeviceptr, size_t> free_virtual_ranges_;
 };
 
 }  // namespace allocation
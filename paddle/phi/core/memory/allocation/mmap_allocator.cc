@@ -18,6 +18,7 @@
 
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <cstdlib>
 
 #include <atomic>
@@ -323,6 +324,45 @@ std::shared_ptr<MemoryMapReaderAllocation> RebuildMemoryMapReaderAllocation(
   return std::make_shared<MemoryMapReaderAllocation>(ptr, size, ipc_name);
 }
 
+MemoryMapFileAllocation::~MemoryMapFileAllocation() {
+  if (munmap(this->ptr(), this->size()) == -1) {
+    LOG(WARNING) << "could not unmap the memory mapped file "
+                 << this->file_path();
+  }
+  VLOG(3) << "~MemoryMapFileAllocation: " << this->file_path();
+}
+
+std::shared_ptr<MemoryMapFileAllocation> AllocateMemoryMapFileAllocation(
+    const std::string &file_path) {
+  int fd = open(file_path.c_str(), O_RDONLY);
+  PADDLE_ENFORCE_NE(
+      fd,
+      -1,
+      common::errors::Unavailable("File %s open failed", file_path.c_str()));
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) == -1) {
+    close(fd);
+    PADDLE_THROW(common::errors::Unavailable(
+        "Get the size of file %s failed", file_path.c_str()));
+  }
+  size_t size = static_cast<size_t>(file_stat.st_size);
+  if (size == 0) {
+    close(fd);
+    PADDLE_THROW(common::errors::InvalidArgument(
+        "Can not memory map an empty file %s", file_path.c_str()));
+  }
+  // MAP_PRIVATE with PROT_WRITE gives copy-on-write pages, writing to a
+  // mapped tensor never modifies the file.
+  void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  PADDLE_ENFORCE_NE(ptr,
+                    MAP_FAILED,
+                    common::errors::Unavailable(
+                        "Memory map file %s failed", file_path.c_str()));
+  VLOG(3) << "Memory map file " << file_path << ", size: " << size;
+  return std::make_shared<MemoryMapFileAllocation>(ptr, size, file_path);
+}
+
 MemoryMapFdSet &MemoryMapFdSet::Instance() {  // NOLINT
   static MemoryMapFdSet set;
   return set;
@@ -148,9 +148,31 @@ class MemoryMapReaderAllocation : public Allocation {
   int fd_ = -1;
 };
 
+/* MemoryMapFileAllocation maps a regular file in copy-on-write mode. The
+ * pages are backed by the page cache, so all processes mapping the same file
+ * share one physical copy unless a page is written. */
+class MemoryMapFileAllocation : public Allocation {
+ public:
+  explicit MemoryMapFileAllocation(void *ptr,
+                                   size_t size,
+                                   std::string file_path)
+      : Allocation(ptr, size, phi::CPUPlace()),
+        file_path_(std::move(file_path)) {}
+
+  inline const std::string &file_path() const { return file_path_; }
+
+  ~MemoryMapFileAllocation() override;
+
+ private:
+  std::string file_path_;
+};
+
 std::shared_ptr<MemoryMapWriterAllocation> AllocateMemoryMapWriterAllocation(
     size_t size);
 
+std::shared_ptr<MemoryMapFileAllocation> AllocateMemoryMapFileAllocation(
+    const std::string &file_path);
+
 std::shared_ptr<MemoryMapReaderAllocation> RebuildMemoryMapReaderAllocation(
     const std::string &ipc_name, size_t size);
 
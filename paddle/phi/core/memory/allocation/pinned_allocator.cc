@@ -14,8 +14,11 @@
 
 #include "paddle/phi/core/memory/allocation/pinned_allocator.h"
 
+#include "paddle/phi/core/enforce.h"
 #include "paddle/phi/core/memory/stats.h"
+#include "paddle/phi/core/platform/device/gpu/gpu_types.h"
 #include "paddle/phi/core/platform/profiler/mem_tracing.h"
+#include "paddle/utils/string/printf.h"
 namespace paddle::memory::allocation {
 bool CPUPinnedAllocator::IsAllocThreadSafe() const { return true; }
 void CPUPinnedAllocator::FreeImpl(phi::Allocation *allocation) {
@@ -25,6 +28,7 @@ void CPUPinnedAllocator::FreeImpl(phi::Allocation *allocation) {
   PADDLE_ENFORCE_GPU_SUCCESS(cudaFreeHost(allocation->ptr()));
 #endif
   VLOG(10) << "cudaFreeHost " << allocation->ptr();
+  reserved_size_ -= allocation->size();
   HOST_MEMORY_STAT_UPDATE(Reserved, 0, -allocation->size());
   platform::RecordMemEvent(allocation->ptr(),
                            allocation->place(),
@@ -33,12 +37,27 @@ void CPUPinnedAllocator::FreeImpl(phi::Allocation *allocation) {
   delete allocation;
 }
 phi::Allocation *CPUPinnedAllocator::AllocateImpl(size_t size) {
+  size_t reserved = reserved_size_.fetch_add(size) + size;
+  if (max_reserved_size_ > 0 && reserved > max_reserved_size_) {
+    reserved_size_ -= size;
+    PADDLE_THROW_BAD_ALLOC(common::errors::ResourceExhausted(
+        "Cannot allocate %s of CUDA pinned memory, %s has been reserved and "
+        "the limit is %s. Please increase "
+        "FLAGS_cuda_pinned_memory_pool_max_size_in_mb.",
+        string::HumanReadableSize(size),
+        string::HumanReadableSize(reserved - size),
+        string::HumanReadableSize(max_reserved_size_)));
+  }
   void *ptr;
 #ifdef PADDLE_WITH_HIP
-  PADDLE_ENFORCE_GPU_SUCCESS(hipHostMalloc(&ptr, size, hipHostMallocPortable));
+  auto result = hipHostMalloc(&ptr, size, hipHostMallocPortable);
 #else
-  PADDLE_ENFORCE_GPU_SUCCESS(cudaHostAlloc(&ptr, size, cudaHostAllocPortable));
+  auto result = cudaHostAlloc(&ptr, size, cudaHostAllocPortable);
 #endif
+  if (result != gpuSuccess) {
+    reserved_size_ -= size;
+  }
+  PADDLE_ENFORCE_GPU_SUCCESS(result);
   VLOG(10) << "cudaHostAlloc " << size << " " << ptr;
   HOST_MEMORY_STAT_UPDATE(Reserved, 0, size);
   platform::RecordMemEvent(ptr,
@@ -13,20 +13,32 @@
 // limitations under the License.
 
 #pragma once
+#include <atomic>
+
 #include "paddle/phi/core/memory/allocation/allocator.h"
 
 namespace paddle {
 namespace memory {
 namespace allocation {
 
-// Allocator uses `cudaHostAlloc`
+// Allocator uses `cudaHostAlloc`. When max_reserved_size is not 0, the
+// allocations beyond it throw BadAlloc, so that the allocator on top of it
+// frees its idle chunks and retries instead of pinning more host memory.
 class CPUPinnedAllocator : public Allocator {
  public:
+  CPUPinnedAllocator() = default;
+  explicit CPUPinnedAllocator(size_t max_reserved_size)
+      : max_reserved_size_(max_reserved_size) {}
+
   bool IsAllocThreadSafe() const override;
 
  protected:
   void FreeImpl(phi::Allocation *allocation) override;
   phi::Allocation *AllocateImpl(size_t size) override;
+
+ private:
+  size_t max_reserved_size_{0};
+  std::atomic<size_t> reserved_size_{0};
 };
 
 }  // namespace allocation
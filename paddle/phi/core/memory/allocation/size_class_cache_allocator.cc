@@ -0,0 +1,342 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/memory/allocation/size_class_cache_allocator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "paddle/phi/core/enforce.h"
+#include "paddle/phi/core/memory/allocation/spin_lock.h"
+#include "paddle/phi/core/memory/stats.h"
+
+namespace paddle::memory::allocation {
+
+namespace {
+
+constexpr size_t kMinClassSize = 256;
+constexpr size_t kClassNumPerPowerOfTwo = 4;
+// Hit and miss counters are flushed to the memory stats every this many
+// cached requests, since updating a stat is not cheap.
+constexpr int64_t kStatFlushInterval = 1024;
+
+void UpdateCacheStat(const phi::Place& place, int64_t hit, int64_t miss) {
+  if (hit == 0 && miss == 0) {
+    return;
+  }
+  if (phi::is_cpu_place(place) || phi::is_cuda_pinned_place(place)) {
+    HOST_MEMORY_STAT_UPDATE(SizeClassCacheHit, place.GetDeviceId(), hit);
+    HOST_MEMORY_STAT_UPDATE(SizeClassCacheMiss, place.GetDeviceId(), miss);
+  } else {
+    DEVICE_MEMORY_STAT_UPDATE(SizeClassCacheHit, place.GetDeviceId(), hit);
+    DEVICE_MEMORY_STAT_UPDATE(SizeClassCacheMiss, place.GetDeviceId(), miss);
+  }
+}
+
+uint64_t NextCentralCacheId() {
+  static std::atomic<uint64_t> next_id{0};
+  return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+struct SizeClassCacheAllocator::ThreadCache {
+  explicit ThreadCache(size_t class_num) : free_lists(class_num) {}
+
+  // Only contended when the central cache drains this thread cache, so the
+  // lock is almost always taken without spinning.
+  SpinLock lock;
+  std::vector<std::vector<phi::Allocation*>> free_lists;
+  int64_t hit_count{0};
+  int64_t miss_count{0};
+};
+
+struct SizeClassCacheAllocator::CentralCache {
+  CentralCache(std::shared_ptr<Allocator> underlying_allocator,
+               const phi::Place& place,
+               size_t class_num,
+               size_t capacity)
+      : id(NextCentralCacheId()),
+        underlying_allocator(std::move(underlying_allocator)),
+        place(place),
+        capacity(capacity),
+        free_lists(class_num) {}
+
+  ~CentralCache() { Drain(); }
+
+  // Moves at most `num` blocks of class `idx` to the end of `list`.
+  void Fetch(size_t idx, size_t num, std::vector<phi::Allocation*>* list) {
+    std::lock_guard<SpinLock> guard(lock);
+    auto& central_list = free_lists[idx];
+    size_t begin = central_list.size() - std::min(num, central_list.size());
+    list->insert(list->end(), central_list.begin() + begin, central_list.end());
+    central_list.resize(begin);
+  }
+
+  // Takes the blocks of `list` from position `begin`. Blocks beyond the
+  // capacity of the central list are freed to the underlying allocator.
+  void Return(size_t idx, size_t begin, std::vector<phi::Allocation*>* list) {
+    size_t origin = begin, end = list->size();
+    {
+      std::lock_guard<SpinLock> guard(lock);
+      auto& central_list = free_lists[idx];
+      size_t num = std::min(end - begin, capacity - central_list.size());
+      central_list.insert(central_list.end(),
+                          list->begin() + begin,
+                          list->begin() + begin + num);
+      begin += num;
+    }
+    for (size_t i = begin; i < end; ++i) {
+      underlying_allocator->Free((*list)[i]);
+    }
+    list->resize(origin);
+  }
+
+  void Register(const std::shared_ptr<ThreadCache>& thread_cache) {
+    std::lock_guard<std::mutex> guard(thread_caches_mutex);
+    thread_caches.insert(thread_cache);
+  }
+
+  // Called when the owner thread exits, all cached blocks go back to the
+  // central lists in bulk.
+  void Unregister(const std::shared_ptr<ThreadCache>& thread_cache) {
+    {
+      std::lock_guard<std::mutex> guard(thread_caches_mutex);
+      thread_caches.erase(thread_cache);
+    }
+    std::lock_guard<SpinLock> guard(thread_cache->lock);
+    for (size_t idx = 0; idx < thread_cache->free_lists.size(); ++idx) {
+      Return(idx, 0, &thread_cache->free_lists[idx]);
+    }
+    pending_hit_count += thread_cache->hit_count;
+    pending_miss_count += thread_cache->miss_count;
+  }
+
+  // Frees all cached blocks, including the ones held by thread caches.
+  uint64_t Drain() {
+    std::vector<phi::Allocation*> allocations;
+    int64_t hit = pending_hit_count.exchange(0);
+    int64_t miss = pending_miss_count.exchange(0);
+    {
+      std::lock_guard<std::mutex> guard(thread_caches_mutex);
+      for (auto& thread_cache : thread_caches) {
+        std::lock_guard<SpinLock> thread_guard(thread_cache->lock);
+        for (auto& list : thread_cache->free_lists) {
+          allocations.insert(allocations.end(), list.begin(), list.end());
+          list.clear();
+        }
+        hit += thread_cache->hit_count;
+        miss += thread_cache->miss_count;
+        thread_cache->hit_count = 0;
+        thread_cache->miss_count = 0;
+      }
+    }
+    {
+      std::lock_guard<SpinLock> guard(lock);
+      for (auto& list : free_lists) {
+        allocations.insert(allocations.end(), list.begin(), list.end());
+        list.clear();
+      }
+    }
+    uint64_t freed_size = 0;
+    for (auto* allocation : allocations) {
+      freed_size += allocation->size();
+      underlying_allocator->Free(allocation);
+    }
+    UpdateCacheStat(place, hit, miss);
+    return freed_size;
+  }
+
+  const uint64_t id;
+  std::shared_ptr<Allocator> underlying_allocator;
+  phi::Place place;
+  size_t capacity;
+
+  SpinLock lock;
+  std::vector<std::vector<phi::Allocation*>> free_lists;
+
+  std::mutex thread_caches_mutex;
+  std::unordered_set<std::shared_ptr<ThreadCache>> thread_caches;
+
+  std::atomic<int64_t> pending_hit_count{0};
+  std::atomic<int64_t> pending_miss_count{0};
+};
+
+// The thread caches owned by the current thread, keyed by the id of their
+// central cache. Ids are never reused, so an entry whose central cache has
+// been destroyed is simply never looked up again.
+struct SizeClassCacheAllocator::ThreadCacheMap {
+  ~ThreadCacheMap() {
+    for (auto& item : caches) {
+      auto central_cache = item.second.first.lock();
+      if (central_cache) {
+        central_cache->Unregister(item.second.second);
+      }
+    }
+  }
+
+  uint64_t last_id{static_cast<uint64_t>(-1)};
+  ThreadCache* last_cache{nullptr};
+  std::unordered_map<uint64_t,
+                     std::pair<std::weak_ptr<CentralCache>,
+                               std::shared_ptr<ThreadCache>>>
+      caches;
+};
+
+SizeClassCacheAllocator::SizeClassCacheAllocator(
+    std::shared_ptr<Allocator> underlying_allocator,
+    const phi::Place& place,
+    size_t max_cached_size,
+    size_t thread_cache_capacity)
+    : underlying_allocator_(std::move(underlying_allocator)),
+      place_(place),
+      thread_cache_capacity_(thread_cache_capacity) {
+  PADDLE_ENFORCE_NOT_NULL(
+      underlying_allocator_,
+      common::errors::InvalidArgument(
+          "Underlying allocator of SizeClassCacheAllocator is NULL"));
+  PADDLE_ENFORCE_GT(
+      thread_cache_capacity_,
+      1,
+      common::errors::InvalidArgument(
+          "The thread cache capacity of SizeClassCacheAllocator should be "
+          "greater than 1, but got %d.",
+          thread_cache_capacity_));
+  for (size_t base = kMinClassSize; base <= max_cached_size; base *= 2) {
+    for (size_t i = 0; i < kClassNumPerPowerOfTwo; ++i) {
+      size_t class_size = base + base / kClassNumPerPowerOfTwo * i;
+      if (class_size > max_cached_size) {
+        break;
+      }
+      class_sizes_.push_back(class_size);
+    }
+  }
+  // The central lists hold several thread caches worth of blocks, so that a
+  // producer thread and a consumer thread can exchange blocks without going
+  // to the underlying allocator.
+  central_cache_ = std::make_shared<CentralCache>(underlying_allocator_,
+                                                  place_,
+                                                  class_sizes_.size(),
+                                                  thread_cache_capacity_ * 4);
+  VLOG(4) << "Create SizeClassCacheAllocator on " << place_ << " with "
+          << class_sizes_.size() << " size classes up to " << max_cached_size
+          << " bytes";
+}
+
+size_t SizeClassCacheAllocator::AllocClassIndex(size_t size) const {
+  if (size == 0) {
+    return kNotCached;
+  }
+  auto iter = std::lower_bound(class_sizes_.begin(), class_sizes_.end(), size);
+  return iter == class_sizes_.end() ? kNotCached
+                                    : iter - class_sizes_.begin();
+}
+
+size_t SizeClassCacheAllocator::FreeClassIndex(size_t size) const {
+  // A block is filed under the largest class it can hold, the underlying
+  // allocator may return a block larger than the requested class size.
+  if (class_sizes_.empty() || size > class_sizes_.back()) {
+    return kNotCached;
+  }
+  auto iter = std::upper_bound(class_sizes_.begin(), class_sizes_.end(), size);
+  return iter == class_sizes_.begin() ? kNotCached
+                                      : iter - class_sizes_.begin() - 1;
+}
+
+size_t SizeClassCacheAllocator::RoundUp(size_t size) const {
+  size_t idx = AllocClassIndex(size);
+  return idx == kNotCached ? 0 : class_sizes_[idx];
+}
+
+SizeClassCacheAllocator::ThreadCache*
+SizeClassCacheAllocator::GetThreadCache() {
+  thread_local ThreadCacheMap thread_cache_map;
+  if (thread_cache_map.last_id == central_cache_->id) {
+    return thread_cache_map.last_cache;
+  }
+  auto& item = thread_cache_map.caches[central_cache_->id];
+  if (!item.second) {
+    item.first = central_cache_;
+    item.second = std::make_shared<ThreadCache>(class_sizes_.size());
+    central_cache_->Register(item.second);
+  }
+  thread_cache_map.last_id = central_cache_->id;
+  thread_cache_map.last_cache = item.second.get();
+  return thread_cache_map.last_cache;
+}
+
+phi::Allocation* SizeClassCacheAllocator::AllocateImpl(size_t size) {
+  size_t idx = AllocClassIndex(size);
+  if (idx == kNotCached) {
+    return underlying_allocator_->Allocate(size).release();
+  }
+
+  ThreadCache* thread_cache = GetThreadCache();
+  phi::Allocation* allocation = nullptr;
+  int64_t hit = 0, miss = 0;
+  {
+    std::lock_guard<SpinLock> guard(thread_cache->lock);
+    auto& list = thread_cache->free_lists[idx];
+    if (list.empty()) {
+      central_cache_->Fetch(idx, thread_cache_capacity_ / 2, &list);
+    }
+    if (!list.empty()) {
+      allocation = list.back();
+      list.pop_back();
+      ++thread_cache->hit_count;
+    } else {
+      ++thread_cache->miss_count;
+    }
+    if (thread_cache->hit_count + thread_cache->miss_count >=
+        kStatFlushInterval) {
+      std::swap(hit, thread_cache->hit_count);
+      std::swap(miss, thread_cache->miss_count);
+    }
+  }
+  UpdateCacheStat(place_, hit, miss);
+
+  if (allocation == nullptr) {
+    allocation = underlying_allocator_->Allocate(class_sizes_[idx]).release();
+  }
+  return allocation;
+}
+
+void SizeClassCacheAllocator::FreeImpl(phi::Allocation* allocation) {
+  size_t idx = FreeClassIndex(allocation->size());
+  if (idx == kNotCached) {
+    underlying_allocator_->Free(allocation);
+    return;
+  }
+
+  ThreadCache* thread_cache = GetThreadCache();
+  std::lock_guard<SpinLock> guard(thread_cache->lock);
+  auto& list = thread_cache->free_lists[idx];
+  list.push_back(allocation);
+  if (list.size() > thread_cache_capacity_) {
+    central_cache_->Return(idx, thread_cache_capacity_ / 2, &list);
+  }
+}
+
+uint64_t SizeClassCacheAllocator::ReleaseImpl(const phi::Place& place) {
+  uint64_t released_size = central_cache_->Drain();
+  VLOG(8) << "Release " << released_size
+          << " bytes cached by SizeClassCacheAllocator on " << place;
+  return underlying_allocator_->Release(place);
+}
+
+}  // namespace paddle::memory::allocation
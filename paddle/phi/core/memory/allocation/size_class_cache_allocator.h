@@ -0,0 +1,79 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "paddle/phi/core/memory/allocation/allocator.h"
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+/**
+ * SizeClassCacheAllocator keeps freed small blocks in per-thread free lists
+ * so that the hot path does not contend on the lock of the underlying
+ * allocator (e.g. AutoGrowthBestFitAllocator). Requests are rounded up to a
+ * size class (4 classes per power of two, from 256B to max_cached_size).
+ * Each thread owns a free list per class; when it runs dry it refills a batch
+ * from a central depot, and when it overflows it returns a batch to the
+ * depot. Blocks beyond the depot capacity are freed to the underlying
+ * allocator. Requests larger than max_cached_size bypass the cache.
+ *
+ * One instance is created per (place, stream) underlying allocator, so the
+ * cached blocks are never reused across streams.
+ */
+class SizeClassCacheAllocator : public Allocator {
+ public:
+  SizeClassCacheAllocator(std::shared_ptr<Allocator> underlying_allocator,
+                          const phi::Place& place,
+                          size_t max_cached_size,
+                          size_t thread_cache_capacity);
+
+  bool IsAllocThreadSafe() const override { return true; }
+
+  size_t SizeClassNum() const { return class_sizes_.size(); }
+
+  // Returns the size of the smallest class which can hold `size` bytes, or 0
+  // if `size` is not served by the cache.
+  size_t RoundUp(size_t size) const;
+
+ protected:
+  phi::Allocation* AllocateImpl(size_t size) override;
+  void FreeImpl(phi::Allocation* allocation) override;
+  uint64_t ReleaseImpl(const phi::Place& place) override;
+
+ private:
+  struct ThreadCache;
+  struct CentralCache;
+  struct ThreadCacheMap;
+
+  static constexpr size_t kNotCached = static_cast<size_t>(-1);
+
+  size_t AllocClassIndex(size_t size) const;
+  size_t FreeClassIndex(size_t size) const;
+  ThreadCache* GetThreadCache();
+
+  std::shared_ptr<Allocator> underlying_allocator_;
+  phi::Place place_;
+  size_t thread_cache_capacity_;
+  std::vector<size_t> class_sizes_;
+  std::shared_ptr<CentralCache> central_cache_;
+};
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
@@ -15,6 +15,7 @@
 #pragma once
 
 #include "paddle/phi/core/memory/allocation/allocator.h"
+#include "paddle/phi/core/memory/allocation_recorder.h"
 #include "paddle/phi/core/memory/stats.h"
 #include "paddle/phi/core/platform/profiler/mem_tracing.h"
 
@@ -43,6 +44,10 @@ class StatAllocator : public Allocator {
                              allocation->place(),
                              allocation->size(),
                              phi::TracerMemEventType::Free);
+    auto& recorder = AllocationRecorder::Instance();
+    if (UNLIKELY(recorder.IsEnabled())) {
+      recorder.RecordFree(allocation->ptr(), allocation->place());
+    }
     underlying_allocator_->Free(allocation);
   }
 
@@ -62,6 +67,10 @@ class StatAllocator : public Allocator {
                              allocation->place(),
                              allocation->size(),
                              phi::TracerMemEventType::Allocate);
+    auto& recorder = AllocationRecorder::Instance();
+    if (UNLIKELY(recorder.IsEnabled())) {
+      recorder.RecordAlloc(allocation->ptr(), allocation->size(), place);
+    }
     return allocation.release();
   }
 
@@ -14,9 +14,11 @@
 
 #include "paddle/phi/core/memory/allocation/virtual_memory_auto_growth_best_fit_allocator.h"
 
+#include <algorithm>
 #include <mutex>
 
 #include "paddle/phi/core/memory/allocation/aligned_allocator.h"
+#include "paddle/phi/core/memory/stats.h"
 
 namespace paddle {
 namespace memory {
@@ -164,7 +166,7 @@ void VirtualMemoryAutoGrowthBestFitAllocator::ExtendAndMerge(size_t size) {
                                block_it);
         } else {
           // do not merge
-          all_blocks_.emplace_back(ptr, size, true);
+          all_blocks_.emplace_front(ptr, size, true);
           free_blocks_.emplace(std::make_pair(size, ptr), all_blocks_.begin());
         }
       } else {
@@ -228,6 +230,65 @@ void VirtualMemoryAutoGrowthBestFitAllocator::ExtendAndMerge(size_t size) {
   }
 }
 
+uint64_t VirtualMemoryAutoGrowthBestFitAllocator::ReleaseImpl(
+    const phi::Place &place) {
+  std::lock_guard<SpinLock> guard(spinlock_);
+  uint64_t reclaimed = 0;
+  auto block_it = all_blocks_.begin();
+  while (block_it != all_blocks_.end()) {
+    if (!block_it->is_free_) {
+      ++block_it;
+      continue;
+    }
+    auto *begin = reinterpret_cast<uint8_t *>(block_it->ptr_);
+    auto *end = begin + block_it->size_;
+    // the free block is merged from the adjacent pieces of the chunks, so the
+    // chunks entirely in it are adjacent too
+    uint8_t *lo = end;
+    uint8_t *hi = begin;
+    for (auto it = allocations_.begin(); it != allocations_.end();) {
+      auto *ptr = reinterpret_cast<uint8_t *>((*it)->ptr());
+      size_t size = (*it)->size();
+      if (ptr >= begin && ptr + size <= end) {
+        lo = std::min(lo, ptr);
+        hi = std::max(hi, ptr + size);
+        reclaimed += size;
+        it = allocations_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    if (lo >= hi) {
+      ++block_it;
+      continue;
+    }
+
+    // keep the head and the tail of the free block out of the chunks
+    free_blocks_.erase(std::make_pair(block_it->size_, block_it->ptr_));
+    size_t head_size = lo - begin;
+    size_t tail_size = end - hi;
+    if (head_size > 0) {
+      auto head = all_blocks_.insert(block_it, Block(begin, head_size, true));
+      free_blocks_.emplace(std::make_pair(head_size, head->ptr_), head);
+    }
+    if (tail_size > 0) {
+      block_it->ptr_ = hi;
+      block_it->size_ = tail_size;
+      free_blocks_.emplace(std::make_pair(tail_size, block_it->ptr_),
+                           block_it);
+      ++block_it;
+    } else {
+      block_it = all_blocks_.erase(block_it);
+    }
+  }
+  if (reclaimed > 0) {
+    DEVICE_MEMORY_STAT_UPDATE(Reclaimed, place_.GetDeviceId(), reclaimed);
+    VLOG(3) << "VirtualMemoryAutoGrowthBestFitAllocator reclaims " << reclaimed
+            << " bytes on " << place_;
+  }
+  return reclaimed;
+}
+
 phi::Allocation *VirtualMemoryAutoGrowthBestFitAllocator::AllocFromFreeBlocks(
     size_t size) {
   auto iter = free_blocks_.lower_bound(std::make_pair(size, nullptr));
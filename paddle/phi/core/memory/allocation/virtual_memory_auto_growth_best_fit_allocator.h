@@ -65,6 +65,13 @@ class VirtualMemoryAutoGrowthBestFitAllocator : public Allocator {
 
   void FreeImpl(phi::Allocation *allocation) override;
 
+  // Compact at a safe point: the chunks lying entirely in the free blocks are
+  // returned to the underlying allocator, which unmaps their physical memory
+  // and keeps their virtual ranges to map the later chunks. The live blocks
+  // are never moved. Returns the reclaimed bytes, which are also added to the
+  // Reclaimed stat of the device.
+  uint64_t ReleaseImpl(const phi::Place &place) override;
+
  private:
   phi::Allocation *AllocFromFreeBlocks(size_t size);
   void ExtendAndMerge(size_t size);
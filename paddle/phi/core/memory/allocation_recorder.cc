@@ -0,0 +1,237 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/memory/allocation_recorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <utility>
+
+#include "glog/logging.h"
+#include "paddle/common/flags.h"
+
+PHI_DEFINE_EXPORTED_bool(
+    record_allocation_sites,
+    false,
+    "Record the allocations with their ops and variables from the start, "
+    "just used for debug.");
+
+namespace paddle::memory {
+
+namespace {
+
+thread_local const AllocationSite* current_site = nullptr;
+
+uint64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+AllocationRecorder& AllocationRecorder::Instance() {
+  static AllocationRecorder* instance = new AllocationRecorder();
+  return *instance;
+}
+
+AllocationRecorder::AllocationRecorder() {
+  if (FLAGS_record_allocation_sites) {
+    Enable();
+  }
+}
+
+void AllocationRecorder::Enable(size_t max_events) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_events_ = max_events;
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void AllocationRecorder::Disable() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  enabled_.store(false, std::memory_order_relaxed);
+  stack_provider_ = nullptr;
+  timeline_.clear();
+  live_.clear();
+  places_.clear();
+}
+
+void AllocationRecorder::SetStackProvider(
+    std::function<std::string()> provider) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stack_provider_ = std::move(provider);
+}
+
+void AllocationRecorder::RecordAlloc(const void* ptr,
+                                     size_t size,
+                                     const phi::Place& place) {
+  AllocationEvent event;
+  event.ptr = ptr;
+  event.size = static_cast<int64_t>(size);
+  event.place = place;
+  event.timestamp_ns = NowNs();
+  if (const AllocationSite* site = AllocationSiteGuard::Current()) {
+    event.site = *site;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!IsEnabled()) {
+    return;
+  }
+  if (stack_provider_ && event.site.stack.empty()) {
+    event.site.stack = stack_provider_();
+  }
+  if (max_events_ > 0) {
+    if (timeline_.size() == max_events_) {
+      timeline_.pop_front();
+    }
+    timeline_.push_back(event);
+  }
+  live_[ptr] = event;
+
+  auto& stats = places_[place];
+  stats.current += event.size;
+  if (stats.current > stats.peak) {
+    // a new peak, snapshot the live allocations of the place
+    stats.peak = stats.current;
+    stats.peak_snapshot.clear();
+    for (auto& pair : live_) {
+      if (pair.second.place == place) {
+        stats.peak_snapshot.push_back(pair.second);
+      }
+    }
+  }
+}
+
+void AllocationRecorder::RecordFree(const void* ptr,
+                                    const phi::Place& place) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!IsEnabled()) {
+    return;
+  }
+  auto iter = live_.find(ptr);
+  if (iter == live_.end()) {
+    // allocated before the recorder is enabled
+    return;
+  }
+  if (max_events_ > 0) {
+    AllocationEvent event = iter->second;
+    event.size = -event.size;
+    event.timestamp_ns = NowNs();
+    if (timeline_.size() == max_events_) {
+      timeline_.pop_front();
+    }
+    timeline_.push_back(std::move(event));
+  }
+  places_[place].current -= iter->second.size;
+  live_.erase(iter);
+}
+
+std::vector<AllocationEvent> AllocationRecorder::Timeline() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return std::vector<AllocationEvent>(timeline_.begin(), timeline_.end());
+}
+
+std::vector<AllocationEvent> AllocationRecorder::PeakSnapshot(
+    const phi::Place& place) const {
+  std::vector<AllocationEvent> snapshot;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = places_.find(place);
+    if (iter != places_.end()) {
+      snapshot = iter->second.peak_snapshot;
+    }
+  }
+  std::stable_sort(snapshot.begin(),
+                   snapshot.end(),
+                   [](const AllocationEvent& lhs, const AllocationEvent& rhs) {
+                     return lhs.size > rhs.size;
+                   });
+  return snapshot;
+}
+
+int64_t AllocationRecorder::PeakBytes(const phi::Place& place) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = places_.find(place);
+  return iter == places_.end() ? 0 : iter->second.peak;
+}
+
+std::string AllocationRecorder::PeakReport(const phi::Place& place) const {
+  auto snapshot = PeakSnapshot(place);
+  std::map<std::string, std::pair<int64_t, size_t>> ops;
+  for (auto& event : snapshot) {
+    const std::string& op =
+        event.site.op_name.empty() ? "<unknown>" : event.site.op_name;
+    ops[op].first += event.size;
+    ++ops[op].second;
+  }
+  std::vector<std::pair<std::string, std::pair<int64_t, size_t>>> sorted(
+      ops.begin(), ops.end());
+  std::stable_sort(sorted.begin(), sorted.end(), [](auto& lhs, auto& rhs) {
+    return lhs.second.first > rhs.second.first;
+  });
+
+  std::ostringstream os;
+  os << "The peak of " << place << " is " << PeakBytes(place) << " bytes in "
+     << snapshot.size() << " allocations:\n";
+  for (auto& pair : sorted) {
+    os << "  " << pair.first << ": " << pair.second.first << " bytes in "
+       << pair.second.second << " allocations\n";
+  }
+  size_t num_largest = std::min<size_t>(snapshot.size(), 10);
+  if (num_largest > 0) {
+    os << "The largest allocations:\n";
+  }
+  for (size_t i = 0; i < num_largest; ++i) {
+    const auto& event = snapshot[i];
+    os << "  " << event.size << " bytes at " << event.ptr << " by "
+       << (event.site.op_name.empty() ? "<unknown>" : event.site.op_name);
+    if (!event.site.var_name.empty()) {
+      os << " for " << event.site.var_name;
+    }
+    if (event.site.stream) {
+      os << " on stream " << event.site.stream;
+    }
+    os << "\n";
+    if (!event.site.stack.empty()) {
+      os << event.site.stack << "\n";
+    }
+  }
+  return os.str();
+}
+
+AllocationSiteGuard::AllocationSiteGuard(const std::string& op_name,
+                                         const std::string& var_name,
+                                         const void* stream) {
+  if (!AllocationRecorder::Instance().IsEnabled()) {
+    return;
+  }
+  active_ = true;
+  site_.op_name = op_name;
+  site_.var_name = var_name;
+  site_.stream = stream;
+  prev_ = current_site;
+  current_site = &site_;
+}
+
+AllocationSiteGuard::~AllocationSiteGuard() {
+  if (active_) {
+    current_site = prev_;
+  }
+}
+
+const AllocationSite* AllocationSiteGuard::Current() { return current_site; }
+
+}  // namespace paddle::memory
@@ -0,0 +1,126 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "paddle/common/macros.h"
+#include "paddle/phi/common/place.h"
+
+namespace paddle {
+namespace memory {
+
+// The site of the allocations, i.e. the op and the variable being run by the
+// thread, the stream and the python stack in the eager mode.
+struct AllocationSite {
+  std::string op_name;
+  std::string var_name;
+  const void* stream{nullptr};
+  std::string stack;
+};
+
+struct AllocationEvent {
+  const void* ptr{nullptr};
+  // positive for the allocation and negative for the free
+  int64_t size{0};
+  phi::Place place;
+  uint64_t timestamp_ns{0};
+  AllocationSite site;
+};
+
+// Record the allocations through StatAllocator with their sites. It keeps a
+// bounded timeline of the events, the live allocations, and a snapshot of the
+// live allocations of each place at the peak of its allocated bytes. It is
+// disabled by default, and costs an atomic load on each allocation then.
+class TEST_API AllocationRecorder {
+ public:
+  static AllocationRecorder& Instance();
+
+  bool IsEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  // Keep the latest max_events events in the timeline.
+  void Enable(size_t max_events = 1 << 16);
+
+  // Disable and clear the recorded allocations and the stack provider.
+  void Disable();
+
+  // Set the provider of the python stack of the allocation sites, called on
+  // each allocation while enabled.
+  void SetStackProvider(std::function<std::string()> provider);
+
+  void RecordAlloc(const void* ptr, size_t size, const phi::Place& place);
+
+  void RecordFree(const void* ptr, const phi::Place& place);
+
+  std::vector<AllocationEvent> Timeline() const;
+
+  // The live allocations of the place at its peak, the largest first.
+  std::vector<AllocationEvent> PeakSnapshot(const phi::Place& place) const;
+
+  int64_t PeakBytes(const phi::Place& place) const;
+
+  // The bytes of the peak snapshot of the place grouped by the op.
+  std::string PeakReport(const phi::Place& place) const;
+
+ private:
+  AllocationRecorder();
+
+  DISABLE_COPY_AND_ASSIGN(AllocationRecorder);
+
+  struct PlaceStats {
+    int64_t current{0};
+    int64_t peak{0};
+    std::vector<AllocationEvent> peak_snapshot;
+  };
+
+  std::atomic<bool> enabled_{false};
+  mutable std::mutex mutex_;
+  size_t max_events_{0};
+  std::function<std::string()> stack_provider_;
+  std::deque<AllocationEvent> timeline_;
+  std::unordered_map<const void*, AllocationEvent> live_;
+  std::map<phi::Place, PlaceStats> places_;
+};
+
+// Set the site of the allocations of the current thread in the scope.
+class TEST_API AllocationSiteGuard {
+ public:
+  explicit AllocationSiteGuard(const std::string& op_name,
+                               const std::string& var_name = "",
+                               const void* stream = nullptr);
+
+  ~AllocationSiteGuard();
+
+  // The site of the current thread, nullptr if there is none.
+  static const AllocationSite* Current();
+
+ private:
+  DISABLE_COPY_AND_ASSIGN(AllocationSiteGuard);
+
+  bool active_{false};
+  AllocationSite site_;
+  const AllocationSite* prev_{nullptr};
+};
+
+}  // namespace memory
+}  // namespace paddle
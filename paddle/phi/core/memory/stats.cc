@@ -175,9 +175,14 @@ void LogDeviceMemoryStats(const phi::Place& place, const std::string& op_name) {
 int RegisterAllStats() {
   DEVICE_MEMORY_STAT_REGISTER(Allocated);
   DEVICE_MEMORY_STAT_REGISTER(Reserved);
+  DEVICE_MEMORY_STAT_REGISTER(SizeClassCacheHit);
+  DEVICE_MEMORY_STAT_REGISTER(SizeClassCacheMiss);
+  DEVICE_MEMORY_STAT_REGISTER(Reclaimed);
 
   HOST_MEMORY_STAT_REGISTER(Allocated);
   HOST_MEMORY_STAT_REGISTER(Reserved);
+  HOST_MEMORY_STAT_REGISTER(SizeClassCacheHit);
+  HOST_MEMORY_STAT_REGISTER(SizeClassCacheMiss);
   return 0;
 }
 
@@ -15,6 +15,8 @@ limitations under the License. */
 #include "paddle/phi/core/mixed_vector.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <initializer_list>
 #include <memory>
 #include <mutex>  // NOLINT
@@ -22,13 +24,28 @@ limitations under the License. */
 #include <vector>
 
 #include "glog/logging.h"
+#include "paddle/common/flags.h"
 #include "paddle/phi/backends/context_pool.h"
 #include "paddle/phi/common/memory_utils.h"
 #include "paddle/utils/none.h"
 #include "paddle/utils/optional.h"
 
+COMMON_DECLARE_bool(mix_vector_async_copy);
+
 namespace phi {
 
+static std::atomic<int64_t> mix_vector_sync_count{0};
+
+int64_t GetMixVectorSyncCount() { return mix_vector_sync_count.load(); }
+
+void ResetMixVectorSyncCount() { mix_vector_sync_count = 0; }
+
+static void RecordMixVectorSync(const char *direction, size_t size) {
+  mix_vector_sync_count.fetch_add(1);
+  VLOG(3) << "MixVector waits for the copy of " << size << " bytes "
+          << direction;
+}
+
 template <typename T>
 void CopyToCPUHelper(std::vector<T> *cpu_,
                      phi::Allocator::AllocationPtr *gpu_,
@@ -47,6 +64,7 @@ void CopyToCPUHelper(std::vector<T> *cpu_,
                      *gpu_memory_size_,
                      stream);
   dev_ctx->Wait();
+  RecordMixVectorSync("to the CPU", *gpu_memory_size_);
 #endif
 }
 
@@ -63,6 +81,22 @@ void CopyCPUDataToCUDAHelper(std::vector<T> *cpu_,
   auto *dev_ctx = static_cast<phi::GPUContext *>(
       phi::DeviceContextPool::Instance().Get(place));
   auto stream = dev_ctx->stream();
+  if (FLAGS_mix_vector_async_copy && *gpu_memory_size_ > 0) {
+    // The data is staged in pinned memory, so the vector can change as soon
+    // as this returns. The staging is released once the stream passed the
+    // copy, and the kernels on the stream are ordered after it.
+    std::shared_ptr<phi::Allocation> staging =
+        memory_utils::Alloc(phi::GPUPinnedPlace(), *gpu_memory_size_);
+    std::memcpy(staging->ptr(), src, *gpu_memory_size_);
+    memory_utils::Copy(OptionalCUDAPlace(*gpu_).get(),
+                       dst,
+                       phi::GPUPinnedPlace(),
+                       staging->ptr(),
+                       *gpu_memory_size_,
+                       stream);
+    dev_ctx->AddStreamCallback([staging]() {});
+    return;
+  }
   memory_utils::Copy(OptionalCUDAPlace(*gpu_).get(),
                      dst,
                      phi::CPUPlace(),
@@ -70,6 +104,7 @@ void CopyCPUDataToCUDAHelper(std::vector<T> *cpu_,
                      *gpu_memory_size_,
                      stream);
   dev_ctx->Wait();
+  RecordMixVectorSync("to the GPU", *gpu_memory_size_);
 #endif
 }
 
@@ -28,6 +28,7 @@ limitations under the License. */
 #include "paddle/phi/core/enforce.h"
 #include "paddle/utils/none.h"
 #include "paddle/utils/optional.h"
+#include "paddle/utils/test_macros.h"
 
 namespace phi {
 
@@ -40,6 +41,13 @@ inline paddle::optional<phi::GPUPlace> OptionalCUDAPlace(
                          : paddle::optional<phi::GPUPlace>(gpu_->place());
 }
 
+// The number of the MixVector copies that waited for the device: the copies
+// back to the CPU, and the copies to the GPU unless FLAGS_mix_vector_async_copy
+// is set. Run with GLOG_vmodule=mixed_vector=3 to log each of them.
+TEST_API int64_t GetMixVectorSyncCount();
+
+TEST_API void ResetMixVectorSyncCount();
+
 // Vector<T> implements the std::vector interface, and can get Data or
 // MutableData from any place. The data will be synced implicitly inside.
 template <typename T>
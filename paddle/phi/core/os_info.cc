@@ -14,11 +14,15 @@ limitations under the License. */
 
 #include "paddle/phi/core/os_info.h"
 
+#include <algorithm>
+#include <fstream>
 #include <functional>
 #include <sstream>
 #include <thread>
 #include <vector>
 #if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
 #include <sys/syscall.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -62,6 +66,28 @@ InternalThreadId::InternalThreadId() {
   id_.cupti_tid = static_cast<uint32_t>(std::stoull(ss.str()));
 }
 
+thread_local int current_numa_node = -1;
+
+// Parses the cpu list of sysfs, e.g. 0-3,8-11
+std::vector<int> ParseCpuList(const std::string& list) {
+  std::vector<int> cpus;
+  std::stringstream ss(list);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    if (range.empty()) {
+      continue;
+    }
+    auto dash = range.find('-');
+    int first = std::stoi(range.substr(0, dash));
+    int last =
+        dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+    for (int cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
 }  // namespace internal
 
 uint64_t GetCurrentThreadSysId() {
@@ -126,4 +152,87 @@ uint32_t GetProcessId() {
 #endif
 }
 
+int GetNumaNodeCount() {
+  static const int count = [] {
+    int nodes = 0;
+#if defined(__linux__)
+    while (access(
+               ("/sys/devices/system/node/node" + std::to_string(nodes))
+                   .c_str(),
+               F_OK) == 0) {
+      ++nodes;
+    }
+#endif
+    return std::max(nodes, 1);
+  }();
+  return count;
+}
+
+std::vector<int> GetNumaNodeCpus(int node) {
+#if defined(__linux__)
+  std::ifstream fin("/sys/devices/system/node/node" + std::to_string(node) +
+                    "/cpulist");
+  std::string list;
+  if (fin && std::getline(fin, list)) {
+    return internal::ParseCpuList(list);
+  }
+#endif
+  return {};
+}
+
+bool BindCurrentThreadToNumaNode(int node) {
+#if defined(__linux__)
+  auto cpus = GetNumaNodeCpus(node);
+  if (cpus.empty()) {
+    return false;
+  }
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int cpu : cpus) {
+    CPU_SET(cpu, &cpu_set);
+  }
+  if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) != 0) {
+    return false;
+  }
+  internal::current_numa_node = node;
+  VLOG(4) << __func__ << " " << GetCurrentThreadName() << " to node " << node;
+  return true;
+#else
+  return false;
+#endif
+}
+
+int GetCurrentThreadNumaNode() { return internal::current_numa_node; }
+
+bool BindMemoryToNumaNode(void* ptr, size_t size, int node) {
+#if defined(__linux__) && defined(SYS_mbind)
+  // the values of numaif.h, which is not always installed
+  constexpr int kMpolBind = 2;
+  constexpr unsigned kMpolMfMove = 1 << 1;
+  constexpr int kMaxNodes = 1024;
+  constexpr int kBitsPerMask = 8 * sizeof(unsigned long);  // NOLINT
+  if (node < 0 || node >= kMaxNodes) {
+    return false;
+  }
+  const auto page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  auto addr = reinterpret_cast<uintptr_t>(ptr);
+  uintptr_t begin = (addr + page - 1) / page * page;
+  uintptr_t end = (addr + size) / page * page;
+  if (end <= begin) {
+    return false;
+  }
+  std::vector<unsigned long> mask(kMaxNodes / kBitsPerMask, 0);  // NOLINT
+  mask[node / kBitsPerMask] |= 1UL << (node % kBitsPerMask);
+  return syscall(SYS_mbind,
+                 begin,
+                 end - begin,
+                 kMpolBind,
+                 mask.data(),
+                 kMaxNodes,
+                 kMpolMfMove) == 0;
+#else
+  return false;
+#endif
+}
+
 }  // namespace phi
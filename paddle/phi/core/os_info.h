@@ -17,6 +17,7 @@ limitations under the License. */
 #include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #ifdef _POSIX_C_SOURCE
 #include <time.h>
 #endif
@@ -72,4 +73,21 @@ bool SetCurrentThreadName(const std::string& name);
 
 uint32_t GetProcessId();
 
+// The NUMA nodes of the host, 1 if unknown.
+int GetNumaNodeCount();
+
+// The cpus of a NUMA node, empty if unknown.
+std::vector<int> GetNumaNodeCpus(int node);
+
+// Binds the current thread to the cpus of a NUMA node.
+// Returns false on failure.
+bool BindCurrentThreadToNumaNode(int node);
+
+// Returns -1 if the current thread is not bound to a NUMA node.
+int GetCurrentThreadNumaNode();
+
+// Binds the whole pages in [ptr, ptr + size) to a NUMA node, and moves the
+// pages already touched. Returns false on failure.
+bool BindMemoryToNumaNode(void* ptr, size_t size, int node);
+
 }  // namespace phi
@@ -83,6 +83,9 @@ DECLARE_TYPE_FOR_GPU(dnnDropoutDescriptor_t,
                      miopenDropoutDescriptor_t);
 DECLARE_TYPE_FOR_GPU(dnnHandle_t, cudnnHandle_t, miopenHandle_t);
 DECLARE_TYPE_FOR_GPU(gpuIpcMemHandle_t, cudaIpcMemHandle_t, hipIpcMemHandle_t);
+DECLARE_TYPE_FOR_GPU(gpuIpcEventHandle_t,
+                     cudaIpcEventHandle_t,
+                     hipIpcEventHandle_t);
 DECLARE_TYPE_FOR_GPU(blasHandle_t, cublasHandle_t, rocblas_handle);
 DECLARE_TYPE_FOR_GPU(gpuStreamCaptureMode,
                      cudaStreamCaptureMode,
@@ -113,6 +116,9 @@ DECLARE_CONSTANT_FOR_GPU(gpuErrorCudartUnloading,
 DECLARE_CONSTANT_FOR_GPU(gpuEventDisableTiming,
                          cudaEventDisableTiming,
                          hipEventDisableTiming);
+DECLARE_CONSTANT_FOR_GPU(gpuEventInterprocess,
+                         cudaEventInterprocess,
+                         hipEventInterprocess);
 DECLARE_CONSTANT_FOR_GPU(gpuStreamNonBlocking,
                          cudaStreamNonBlocking,
                          hipStreamNonBlocking);
@@ -160,6 +166,18 @@ DECLARE_FUNCTION_FOR_GPU(gpuIpcOpenMemHandle,
 DECLARE_FUNCTION_FOR_GPU(gpuIpcCloseMemHandle,
                          cudaIpcCloseMemHandle,
                          hipIpcCloseMemHandle);
+DECLARE_FUNCTION_FOR_GPU(gpuIpcGetMemHandle,
+                         cudaIpcGetMemHandle,
+                         hipIpcGetMemHandle);
+DECLARE_FUNCTION_FOR_GPU(gpuIpcGetEventHandle,
+                         cudaIpcGetEventHandle,
+                         hipIpcGetEventHandle);
+DECLARE_FUNCTION_FOR_GPU(gpuIpcOpenEventHandle,
+                         cudaIpcOpenEventHandle,
+                         hipIpcOpenEventHandle);
+DECLARE_FUNCTION_FOR_GPU(gpuStreamWaitEvent,
+                         cudaStreamWaitEvent,
+                         hipStreamWaitEvent);
 
 #undef DECLARE_FUNCTION_FOR_GPU
 
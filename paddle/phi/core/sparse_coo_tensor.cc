@@ -26,6 +26,8 @@ SparseCooTensor::SparseCooTensor(SparseCooTensor&& other) noexcept {  // NOLINT
   this->non_zero_elements_ = other.non_zero_elements_;
   this->non_zero_indices_ = other.non_zero_indices_;
   this->coalesced_ = other.coalesced_;
+  this->csr_layout_ = other.csr_layout_;
+  this->subm_rulebooks_ = other.subm_rulebooks_;
   set_meta(other.meta());
 }
 
@@ -55,6 +57,8 @@ SparseCooTensor::SparseCooTensor(const SparseCooTensor& other) {  // NOLINT
   this->non_zero_indices_ = other.non_zero_indices_;
   this->non_zero_elements_ = other.non_zero_elements_;
   this->coalesced_ = other.coalesced_;
+  this->csr_layout_ = other.csr_layout_;
+  this->subm_rulebooks_ = other.subm_rulebooks_;
   set_meta(other.meta());
 }
 
@@ -63,6 +67,9 @@ SparseCooTensor& SparseCooTensor::operator=(const SparseCooTensor& other) {
     this->non_zero_elements_ = other.non_zero_elements_;
     this->non_zero_indices_ = other.non_zero_indices_;
     this->coalesced_ = other.coalesced_;
+    this->csr_layout_ = other.csr_layout_;
+    this->subm_rulebooks_ = other.subm_rulebooks_;
+  this->subm_rulebooks_ = other.subm_rulebooks_;
     set_meta(other.meta());
     return *this;
   }
@@ -151,6 +158,58 @@ void SparseCooTensor::SetMember(const DenseTensor& non_zero_indices,
   set_meta(meta);
 }
 
+const std::pair<DenseTensor, DenseTensor>* SparseCooTensor::SubmRulebook(
+    const std::string& key) const {
+  if (subm_rulebooks_ == nullptr ||
+      !subm_rulebooks_->indices.IsSharedBufferWith(non_zero_indices_) ||
+      !(subm_rulebooks_->indices.meta() == non_zero_indices_.meta())) {
+    return nullptr;
+  }
+  const auto& iter = subm_rulebooks_->rulebooks.find(key);
+  if (iter == subm_rulebooks_->rulebooks.end()) {
+    return nullptr;
+  }
+  return &iter->second;
+}
+
+void SparseCooTensor::SaveSubmRulebook(
+    const std::string& key,
+    const std::pair<DenseTensor, DenseTensor>& rulebook) const {
+  if (subm_rulebooks_ == nullptr ||
+      !subm_rulebooks_->indices.IsSharedBufferWith(non_zero_indices_) ||
+      !(subm_rulebooks_->indices.meta() == non_zero_indices_.meta())) {
+    subm_rulebooks_ = std::make_shared<SubmRulebookCache>();
+    subm_rulebooks_->indices = non_zero_indices_;
+  }
+  subm_rulebooks_->rulebooks[key] = rulebook;
+}
+
+void SparseCooTensor::ShareSubmRulebooks(const SparseCooTensor& other) {
+  if (other.subm_rulebooks_ != nullptr &&
+      other.subm_rulebooks_->indices.IsSharedBufferWith(non_zero_indices_) &&
+      other.subm_rulebooks_->indices.meta() == non_zero_indices_.meta()) {
+    subm_rulebooks_ = other.subm_rulebooks_;
+  }
+}
+
+const std::pair<DenseTensor, DenseTensor>* SparseCooTensor::CsrLayout()
+    const {
+  if (csr_layout_ == nullptr ||
+      !csr_layout_->indices.IsSharedBufferWith(non_zero_indices_) ||
+      !(csr_layout_->indices.meta() == non_zero_indices_.meta())) {
+    return nullptr;
+  }
+  return &csr_layout_->layout;
+}
+
+void SparseCooTensor::SetCsrLayout(const DenseTensor& crows,
+                                   const DenseTensor& cols) const {
+  auto cache = std::make_shared<CsrLayoutCache>();
+  cache->indices = non_zero_indices_;
+  cache->layout = std::make_pair(crows, cols);
+  csr_layout_ = cache;
+}
+
 int32_t SparseCooTensor::sparse_dim() const {
   return static_cast<int32_t>(non_zero_indices_.dims()[0]);
 }
@@ -286,6 +286,33 @@ class SparseCooTensor : public TensorBase,
     }
   }
 
+  /// \brief query the (rulebook, counter) of a submanifold conv saved by
+  /// SaveSubmRulebook, the key is the geometry of the conv.
+  /// \return nullptr if nothing is saved or the indices have been changed.
+  const std::pair<DenseTensor, DenseTensor>* SubmRulebook(
+      const std::string& key) const;
+
+  /// \brief save the (rulebook, counter) of a submanifold conv built on the
+  /// indices, which is reused by the following submanifold convs of the same
+  /// geometry without a user given key.
+  void SaveSubmRulebook(
+      const std::string& key,
+      const std::pair<DenseTensor, DenseTensor>& rulebook) const;
+
+  /// \brief share the rulebooks saved by other if this tensor shares the
+  /// indices of other, e.g. the output of a submanifold conv or of an
+  /// elementwise op.
+  void ShareSubmRulebooks(const SparseCooTensor& other);
+
+  /// \brief get the CSR layout (crows, cols) cached by SetCsrLayout, the
+  /// values of the CSR are the values of this tensor in the same order.
+  /// \return nullptr if nothing is cached or the indices have been changed.
+  const std::pair<DenseTensor, DenseTensor>* CsrLayout() const;
+
+  /// \brief cache the CSR layout converted from the indices, so the kernels
+  /// running on CSR, e.g. sparse matmul, only convert a tensor once.
+  void SetCsrLayout(const DenseTensor& crows, const DenseTensor& cols) const;
+
  private:
   friend class DenseTensorUtils;
 
@@ -310,6 +337,23 @@ class SparseCooTensor : public TensorBase,
   // Sparse conv will generate a kmap, which can be reused.
   std::shared_ptr<std::map<std::string, KmapCache>> kmaps_ = nullptr;
 
+  // The CSR layout converted from indices_, which are kept to tell whether
+  // the layout is still valid. It is shared by the shallow copies.
+  struct CsrLayoutCache {
+    DenseTensor indices;
+    std::pair<DenseTensor, DenseTensor> layout;
+  };
+  mutable std::shared_ptr<CsrLayoutCache> csr_layout_ = nullptr;
+
+  // The rulebooks of submanifold conv built on indices_, keyed by the
+  // geometry of conv. They are shared by the tensors sharing the indices, so
+  // the consecutive submanifold convs build the rulebook only once.
+  struct SubmRulebookCache {
+    DenseTensor indices;
+    std::map<std::string, std::pair<DenseTensor, DenseTensor>> rulebooks;
+  };
+  mutable std::shared_ptr<SubmRulebookCache> subm_rulebooks_ = nullptr;
+
   /* --------------------------- */
   /*   example: non zero element is scalar */
   /* --------------------------- */
@@ -18,6 +18,7 @@
 
 #include "glog/logging.h"
 #include "paddle/common/flags.h"
+#include "paddle/fluid/framework/new_executor/workqueue/run_queue.h"
 #include "paddle/phi/core/enforce.h"
 
 COMMON_DECLARE_int32(dist_threadpool_size);
@@ -51,11 +52,32 @@ void ThreadPool::Init() {
   }
 }
 
+struct ThreadPool::WorkerQueue {
+  paddle::framework::RunQueue<Task, 1024> queue;
+};
+
+namespace {
+// The pool and the id of the current thread if it is a worker of a pool.
+struct WorkerInfo {
+  const ThreadPool* pool = nullptr;
+  int thread_id = -1;
+};
+thread_local WorkerInfo worker_info;
+}  // namespace
+
 ThreadPool::ThreadPool(int num_threads) : running_(true) {
   threads_.resize(num_threads);
-  for (auto& thread : threads_) {
+  queues_.resize(num_threads);
+  for (auto& queue : queues_) {
+    queue = std::make_unique<WorkerQueue>();
+  }
+  for (int i = 0; i < num_threads; ++i) {
     // TODO(Yancey1989): binding the thread on the specify CPU number
-    thread = std::make_unique<std::thread>([this] { ThreadPool::TaskLoop(); });
+    threads_[i] = std::make_unique<std::thread>([this, i] {
+      worker_info.pool = this;
+      worker_info.thread_id = i;
+      ThreadPool::TaskLoop(i);
+    });
   }
 }
 
@@ -73,33 +95,84 @@ ThreadPool::~ThreadPool() {
   }
 }
 
-void ThreadPool::TaskLoop() {
-  while (true) {
-    Task task;
-
-    {
-      std::unique_lock<std::mutex> lock(mutex_);
-      scheduled_.wait(
-          lock, [this] { return !this->tasks_.empty() || !this->running_; });
-
-      if (!running_ && tasks_.empty()) {
-        return;
+void ThreadPool::Schedule(std::vector<Task>* tasks, int affinity) {
+  if (!running_) {
+    PADDLE_THROW(common::errors::Unavailable(
+        "Task is enqueued into stopped ThreadPool."));
+  }
+  const int num_queues = static_cast<int>(queues_.size());
+  std::vector<Task> overflow;
+  for (auto& task : *tasks) {
+    if (affinity < 0 && worker_info.pool == this) {
+      // a task of a worker goes to the front of its own queue
+      task = queues_[worker_info.thread_id]->queue.PushFront(std::move(task));
+    } else {
+      int index = affinity >= 0
+                      ? affinity % num_queues
+                      : static_cast<int>(next_queue_.fetch_add(
+                                             1, std::memory_order_relaxed) %
+                                         num_queues);
+      // try the other queues if the queue is full
+      for (int i = 0; i < num_queues && task.valid(); ++i) {
+        task = queues_[(index + i) % num_queues]->queue.PushBack(
+            std::move(task));
       }
-
-      if (tasks_.empty()) {
-        PADDLE_THROW(
-            common::errors::Unavailable("Current thread has no task to Run."));
+    }
+    if (task.valid()) {
+      overflow.emplace_back(std::move(task));
+    }
+  }
+  const int64_t num_pushed =
+      static_cast<int64_t>(tasks->size() - overflow.size());
+  if (num_pushed > 0) {
+    pending_.fetch_add(num_pushed);
+    // The sleeping threads check pending_ under the lock, so taking it here
+    // makes sure the notification is not lost.
+    if (num_sleeping_.load() > 0) {
+      { std::lock_guard<std::mutex> lock(mutex_); }
+      if (num_pushed == 1) {
+        scheduled_.notify_one();
+      } else {
+        scheduled_.notify_all();
       }
-
-      // pop a task from the task queue
-      task = std::move(tasks_.front());
-      tasks_.pop();
     }
-    // run the task
+  }
+  // all the queues are full, run the rest in the current thread
+  for (auto& task : overflow) {
     task();
   }
 }
 
+ThreadPool::Task ThreadPool::TakeTask(int thread_id) {
+  const int num_queues = static_cast<int>(queues_.size());
+  Task task = queues_[thread_id]->queue.PopFront();
+  for (int i = 1; i < num_queues && !task.valid(); ++i) {
+    task = queues_[(thread_id + i) % num_queues]->queue.PopBack();
+  }
+  return task;
+}
+
+void ThreadPool::TaskLoop(int thread_id) {
+  while (true) {
+    Task task = TakeTask(thread_id);
+    if (task.valid()) {
+      pending_.fetch_sub(1);
+      // run the task
+      task();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    num_sleeping_.fetch_add(1);
+    scheduled_.wait(lock,
+                    [this] { return pending_.load() > 0 || !this->running_; });
+    num_sleeping_.fetch_sub(1);
+    if (!running_ && pending_.load() <= 0) {
+      return;
+    }
+  }
+}
+
 std::unique_ptr<ThreadPool> ThreadPoolIO::io_threadpool_(nullptr);
 std::once_flag ThreadPoolIO::io_init_flag_;
 
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>  // NOLINT
 #include <functional>
 #include <future>  // NOLINT
@@ -46,8 +47,10 @@ struct ExceptionHandler {
   }
 };
 
-// ThreadPool maintains a queue of tasks, and runs them using a fixed
-// number of threads.
+// ThreadPool runs tasks using a fixed number of threads. Every thread owns a
+// RunQueue (the one of the new executor's work queue) that the tasks are
+// pushed to, and the threads out of tasks steal them from the others, so the
+// threads do not contend on a single queue lock.
 class ThreadPool {
  public:
   explicit ThreadPool(int num_threads);
@@ -62,17 +65,54 @@ class ThreadPool {
 
   // Run pushes a function to the task queue and returns a std::future
   // object. To wait for the completion of the task, call
-  // std::future::wait().
+  // std::future::wait(). The affinity is the thread preferred to run the
+  // task, -1 for any of them.
   template <typename Callback>
-  std::future<void> Run(Callback fn) {
-    auto f = this->RunAndGetException(fn);
+  std::future<void> Run(Callback fn, int affinity = -1) {
+    auto f = this->RunAndGetException(fn, affinity);
     return std::async(std::launch::deferred, ExceptionHandler(std::move(f)));
   }
 
   template <typename Callback>
   std::future<std::unique_ptr<common::enforce::EnforceNotMet>>
-  RunAndGetException(Callback fn) {
-    Task task([fn]() -> std::unique_ptr<common::enforce::EnforceNotMet> {
+  RunAndGetException(Callback fn, int affinity = -1) {
+    Task task = MakeTask(fn);
+    std::future<std::unique_ptr<common::enforce::EnforceNotMet>> f =
+        task.get_future();
+    std::vector<Task> tasks;
+    tasks.emplace_back(std::move(task));
+    Schedule(&tasks, affinity);
+    return f;
+  }
+
+  // RunBatch pushes all the functions at once, and wakes up the threads only
+  // once for them.
+  template <typename Callback>
+  std::vector<std::future<void>> RunBatch(const std::vector<Callback>& fns) {
+    std::vector<Task> tasks;
+    std::vector<std::future<void>> futures;
+    tasks.reserve(fns.size());
+    futures.reserve(fns.size());
+    for (const auto& fn : fns) {
+      tasks.emplace_back(MakeTask(fn));
+      futures.emplace_back(
+          std::async(std::launch::deferred,
+                     ExceptionHandler(tasks.back().get_future())));
+    }
+    Schedule(&tasks, -1);
+    return futures;
+  }
+
+  int NumThreads() const { return static_cast<int>(threads_.size()); }
+
+ private:
+  DISABLE_COPY_AND_ASSIGN(ThreadPool);
+
+  struct WorkerQueue;
+
+  template <typename Callback>
+  static Task MakeTask(Callback fn) {
+    return Task([fn]() -> std::unique_ptr<common::enforce::EnforceNotMet> {
       try {
         fn();
       } catch (common::enforce::EnforceNotMet& ex) {
@@ -87,26 +127,17 @@ class ThreadPool {
       }
       return nullptr;
     });
-    std::future<std::unique_ptr<common::enforce::EnforceNotMet>> f =
-        task.get_future();
-    {
-      std::unique_lock<std::mutex> lock(mutex_);
-      if (!running_) {
-        PADDLE_THROW(common::errors::Unavailable(
-            "Task is enqueued into stopped ThreadPool."));
-      }
-      tasks_.push(std::move(task));
-    }
-    scheduled_.notify_one();
-    return f;
   }
 
- private:
-  DISABLE_COPY_AND_ASSIGN(ThreadPool);
+  // Schedule pushes the tasks to the queues and wakes up the threads.
+  TEST_API void Schedule(std::vector<Task>* tasks, int affinity);
+
+  // Pops a task from the queue of the thread, or steals one from the others.
+  Task TakeTask(int thread_id);
 
   // The constructor starts threads to run TaskLoop, which retrieves
-  // and runs tasks from the queue.
-  void TaskLoop();
+  // and runs tasks from the queues.
+  void TaskLoop(int thread_id);
 
   // Init is called by GetInstance.
   static void Init();
@@ -116,10 +147,16 @@ class ThreadPool {
   static std::once_flag init_flag_;
 
   std::vector<std::unique_ptr<std::thread>> threads_;
-
-  std::queue<Task> tasks_;
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+
+  // The number of the tasks pushed and not taken yet, it may briefly be
+  // negative as a task is counted after it is pushed.
+  std::atomic<int64_t> pending_{0};
+  std::atomic<int> num_sleeping_{0};
+  std::atomic<unsigned> next_queue_{0};
+  std::atomic<bool> running_;
+  // Only guards the sleeping of the threads without tasks.
   std::mutex mutex_;
-  bool running_;
   std::condition_variable scheduled_;
 };
 
@@ -37,6 +37,60 @@ void ConvertWstrToStr(const std::wstring& src, std::string* res) {
   *res = kConverter.to_bytes(src);
 }
 
+VocabTrie::VocabTrie(
+    const std::unordered_map<std::wstring, std::int32_t>& vocab)
+    : ids_(2, -1) {
+  static const std::wstring kSuffixIndicator = L"##";
+  edges_.reserve(vocab.size() * 4);
+  for (const auto& item : vocab) {
+    const std::wstring& token = item.first;
+    Insert(kWordRoot, token.data(), token.size(), item.second);
+    if (token.size() > kSuffixIndicator.size() &&
+        token.compare(0, kSuffixIndicator.size(), kSuffixIndicator) == 0) {
+      Insert(kSuffixRoot,
+             token.data() + kSuffixIndicator.size(),
+             token.size() - kSuffixIndicator.size(),
+             item.second);
+    }
+  }
+}
+
+void VocabTrie::Insert(std::int32_t root,
+                       const wchar_t* token,
+                       size_t len,
+                       std::int32_t id) {
+  std::int32_t node = root;
+  for (size_t i = 0; i < len; ++i) {
+    auto ret = edges_.emplace(EdgeKey(node, token[i]),
+                              static_cast<std::int32_t>(ids_.size()));
+    if (ret.second) {
+      ids_.push_back(-1);
+    }
+    node = ret.first->second;
+  }
+  ids_[node] = id;
+}
+
+size_t VocabTrie::LongestMatch(const wchar_t* text,
+                               size_t len,
+                               bool is_suffix,
+                               std::int32_t* id) const {
+  std::int32_t node = is_suffix ? kSuffixRoot : kWordRoot;
+  size_t matched = 0;
+  for (size_t i = 0; i < len; ++i) {
+    auto it = edges_.find(EdgeKey(node, text[i]));
+    if (it == edges_.end()) {
+      break;
+    }
+    node = it->second;
+    if (ids_[node] >= 0) {
+      matched = i + 1;
+      *id = ids_[node];
+    }
+  }
+  return matched;
+}
+
 // Normalization Form Canonical Decomposition.
 void NFD(const std::string& s, std::string* ret) {
   *ret = "";
@@ -17,6 +17,7 @@
 #include <codecvt>
 #include <iostream>
 #include <locale>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -30,6 +31,44 @@ struct PhiVectorType<std::string> {
   const char* type_name = "PhiVectorString";
 };
 
+// A trie over the tokens of a Vocab, which finds the longest token at the
+// start of a text by one lookup per char instead of trying every substring.
+// Every token is under the word root, and the tokens starting with the
+// suffix indicator "##" are also under the suffix root without it, which are
+// the tokens to continue a word in WordPiece.
+class VocabTrie {
+ public:
+  explicit VocabTrie(
+      const std::unordered_map<std::wstring, std::int32_t>& vocab);
+
+  /// \brief Matches the longest token at the start of text[0, len).
+  /// \param is_suffix Whether to match the tokens continuing a word.
+  /// \param id The id of the matched token.
+  /// \return The length of the matched token, 0 if nothing is matched.
+  size_t LongestMatch(const wchar_t* text,
+                      size_t len,
+                      bool is_suffix,
+                      std::int32_t* id) const;
+
+ private:
+  void Insert(std::int32_t root,
+              const wchar_t* token,
+              size_t len,
+              std::int32_t id);
+
+  static std::uint64_t EdgeKey(std::int32_t node, wchar_t ch) {
+    return (static_cast<std::uint64_t>(node) << 32) |
+           static_cast<std::uint32_t>(ch);
+  }
+
+  static constexpr std::int32_t kWordRoot = 0;
+  static constexpr std::int32_t kSuffixRoot = 1;
+
+  std::unordered_map<std::uint64_t, std::int32_t> edges_;
+  // the id of the token ending at each node, -1 if there is none
+  std::vector<std::int32_t> ids_;
+};
+
 // Note(YuanRisheng): Vocab is mainly used for faster_tokenizer_op and we don't
 // recommend widely use it. Because faster_tokenizer_op may be deleted in the
 // future and this class will be deleted.
@@ -50,6 +89,7 @@ class Vocab : public phi::ExtendedTensor,
   Vocab& operator=(
       const std::unordered_map<std::wstring, std::int32_t>& other) {
     this->data_ = other;
+    std::atomic_store(&trie_, std::shared_ptr<const VocabTrie>());
     return *this;
   }
 
@@ -63,10 +103,25 @@ class Vocab : public phi::ExtendedTensor,
 
   size_t size() const { return data_.size(); }
 
-  void clear() { data_.clear(); }
+  void clear() {
+    data_.clear();
+    std::atomic_store(&trie_, std::shared_ptr<const VocabTrie>());
+  }
 
   void emplace(const std::wstring& key, std::int32_t value) {
     data_.emplace(key, value);
+    std::atomic_store(&trie_, std::shared_ptr<const VocabTrie>());
+  }
+
+  /// \brief Returns the trie of the tokens, which is built on the first call
+  /// and kept until the vocab is changed.
+  std::shared_ptr<const VocabTrie> trie() const {
+    auto trie = std::atomic_load(&trie_);
+    if (trie == nullptr) {
+      trie = std::make_shared<const VocabTrie>(data_);
+      std::atomic_store(&trie_, trie);
+    }
+    return trie;
   }
 
   std::int32_t at(const std::wstring& key) { return data_.at(key); }
@@ -101,6 +156,7 @@ class Vocab : public phi::ExtendedTensor,
 
  private:
   std::unordered_map<std::wstring, std::int32_t> data_;
+  mutable std::shared_ptr<const VocabTrie> trie_;
 };
 
 // Note(YuanRisheng): PhiVector is essentially a vector that only used for PHI
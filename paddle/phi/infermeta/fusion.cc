@@ -1356,6 +1356,57 @@ void FusedBiasDropoutResidualLnGradInferMeta(
   }
 }
 
+void FusedAllReduceResidualRmsNormInferMeta(const MetaTensor& x,
+                                              const MetaTensor& residual,
+                                              const MetaTensor& norm_weight,
+                                              const MetaTensor& norm_bias,
+                                              int ring_id,
+                                              float epsilon,
+                                              int begin_norm_axis,
+                                              int chunk_rows,
+                                              MetaTensor* out,
+                                              MetaTensor* residual_out) {
+  const auto& x_dims = x.dims();
+  PADDLE_ENFORCE_EQ(
+      x_dims,
+      residual.dims(),
+      common::errors::InvalidArgument(
+          "The shape of Input(Residual) of fused_allreduce_residual_rms_norm "
+          "should be the same as Input(X), but received [%s] and [%s].",
+          residual.dims(),
+          x_dims));
+  PADDLE_ENFORCE_EQ(
+      begin_norm_axis > 0 && begin_norm_axis < x_dims.size(),
+      true,
+      common::errors::InvalidArgument(
+          "The begin_norm_axis of fused_allreduce_residual_rms_norm should be "
+          "in range (0, %d), but received %d.",
+          x_dims.size(),
+          begin_norm_axis));
+  int64_t normalized_dims = 1;
+  for (int i = begin_norm_axis; i < x_dims.size(); ++i) {
+    normalized_dims *= x_dims[i];
+  }
+  PADDLE_ENFORCE_EQ(normalized_dims,
+                    norm_weight.dims()[0],
+                    common::errors::InvalidArgument(
+                        "The normalized size of Input(X) must equal to be "
+                        "the size of Weight, but received "
+                        "normalized size of Input(X) is [%d], received size "
+                        "of Weight is [%d]",
+                        normalized_dims,
+                        norm_weight.dims()[0]));
+
+  out->set_dims(x_dims);
+  out->set_dtype(x.dtype());
+  out->set_layout(x.layout());
+  out->share_lod(x);
+  residual_out->set_dims(x_dims);
+  residual_out->set_dtype(x.dtype());
+  residual_out->set_layout(x.layout());
+  residual_out->share_lod(x);
+}
+
 void FusedDotProductAttentionInferMeta(const MetaTensor& q,
                                        const MetaTensor& k,
                                        const MetaTensor& v,
@@ -4935,6 +4986,48 @@ void FusedSeqpoolCvmGradInferMeta(
   }
 }
 
+void FusedEmbeddingSeqPoolInferMeta(const std::vector<const MetaTensor*>& ids,
+                                    const MetaTensor& w,
+                                    const std::string& pooltype,
+                                    std::vector<MetaTensor*> out) {
+  PADDLE_ENFORCE_GE(
+      ids.size(),
+      1UL,
+      common::errors::InvalidArgument(
+          "Inputs(Ids) of FusedEmbeddingSeqPoolOp should not be empty."));
+  PADDLE_ENFORCE_EQ(
+      w.dims().size(),
+      2,
+      common::errors::InvalidArgument(
+          "The rank of Input(W) of FusedEmbeddingSeqPoolOp should be 2, but "
+          "received %d.",
+          w.dims().size()));
+  PADDLE_ENFORCE_EQ(
+      pooltype == "SUM" || pooltype == "AVERAGE" || pooltype == "SQRT",
+      true,
+      common::errors::InvalidArgument(
+          "The pooltype of FusedEmbeddingSeqPoolOp should be SUM, AVERAGE or "
+          "SQRT, but received %s.",
+          pooltype));
+  for (size_t i = 0; i < ids.size(); ++i) {
+    const auto& ids_dims = ids[i]->dims();
+    PADDLE_ENFORCE_EQ(
+        ids_dims.size() == 1 || (ids_dims.size() == 2 && ids_dims[1] == 1),
+        true,
+        common::errors::InvalidArgument(
+            "The ids of slot %d of FusedEmbeddingSeqPoolOp should be of the "
+            "shape [N] or [N, 1], but received [%s].",
+            i,
+            ids_dims));
+  }
+  // The batch size should be confirmed in Compute,
+  // since input lod is not accessible here.
+  for (size_t i = 0; i < out.size(); ++i) {
+    out[i]->set_dims(common::make_ddim({-1, w.dims()[1]}));
+    out[i]->set_dtype(w.dtype());
+  }
+}
+
 void FusionSeqpoolCvmConcatInferMeta(const std::vector<const MetaTensor*>& x,
                                      const MetaTensor& cvm,
                                      const std::string& pooltype,
@@ -945,6 +945,17 @@ void FusedBiasDropoutResidualLnGradInferMeta(
     MetaTensor* ln_scale_grad,
     MetaTensor* ln_bias_grad);
 
+void FusedAllReduceResidualRmsNormInferMeta(const MetaTensor& x,
+                                              const MetaTensor& residual,
+                                              const MetaTensor& norm_weight,
+                                              const MetaTensor& norm_bias,
+                                              int ring_id,
+                                              float epsilon,
+                                              int begin_norm_axis,
+                                              int chunk_rows,
+                                              MetaTensor* out,
+                                              MetaTensor* residual_out);
+
 void FusedDotProductAttentionInferMeta(const MetaTensor& q,
                                        const MetaTensor& k,
                                        const MetaTensor& v,
@@ -1192,6 +1203,11 @@ void FusedSeqpoolCvmGradInferMeta(
     MetaTensor* cvm_grad,
     MetaConfig config = MetaConfig());
 
+void FusedEmbeddingSeqPoolInferMeta(const std::vector<const MetaTensor*>& ids,
+                                    const MetaTensor& w,
+                                    const std::string& pooltype,
+                                    std::vector<MetaTensor*> out);
+
 void FusionSeqpoolConcatInferMeta(const std::vector<const MetaTensor*>& x,
                                   const std::string& pooltype,
                                   int axis,
@@ -5854,6 +5854,104 @@ void FusedAdamInferMeta(
   }
 }
 
+void FusedAdagradInferMeta(
+    const std::vector<const MetaTensor*>& params,
+    const std::vector<const MetaTensor*>& grads,
+    const MetaTensor& learning_rate,
+    const std::vector<const MetaTensor*>& moments,
+    const paddle::optional<std::vector<const MetaTensor*>>& master_params,
+    const MetaTensor& found_inf,
+    const MetaTensor& scale,
+    float epsilon,
+    int chunk_size,
+    bool multi_precision,
+    std::vector<MetaTensor*> params_out,
+    std::vector<MetaTensor*> moments_out,
+    std::vector<MetaTensor*> master_params_out) {
+  size_t in_size = params.size();
+  PADDLE_ENFORCE_EQ(
+      grads.size(),
+      in_size,
+      common::errors::InvalidArgument(
+          "The size of Input(Grads) must be equal to the size of "
+          "Input(Params), but got %d vs %d.",
+          grads.size(),
+          in_size));
+  PADDLE_ENFORCE_EQ(
+      moments.size(),
+      in_size,
+      common::errors::InvalidArgument(
+          "The size of Input(Moments) must be equal to the size of "
+          "Input(Params), but got %d vs %d.",
+          moments.size(),
+          in_size));
+  for (size_t i = 0; i < in_size; i++) {
+    params_out[i]->set_dims(params[i]->dims());
+    params_out[i]->set_dtype(params[i]->dtype());
+    moments_out[i]->set_dims(moments[i]->dims());
+    moments_out[i]->set_dtype(moments[i]->dtype());
+    if (master_params && !master_params_out.empty()) {
+      master_params_out[i]->set_dims(master_params.get()[i]->dims());
+      master_params_out[i]->set_dtype(master_params.get()[i]->dtype());
+    }
+  }
+}
+
+void FusedRmspropInferMeta(
+    const std::vector<const MetaTensor*>& params,
+    const std::vector<const MetaTensor*>& grads,
+    const MetaTensor& learning_rate,
+    const std::vector<const MetaTensor*>& mean_squares,
+    const std::vector<const MetaTensor*>& moments,
+    const paddle::optional<std::vector<const MetaTensor*>>& mean_grads,
+    const paddle::optional<std::vector<const MetaTensor*>>& master_params,
+    const MetaTensor& found_inf,
+    const MetaTensor& scale,
+    float epsilon,
+    float decay,
+    float momentum,
+    int chunk_size,
+    bool centered,
+    bool multi_precision,
+    std::vector<MetaTensor*> params_out,
+    std::vector<MetaTensor*> moments_out,
+    std::vector<MetaTensor*> mean_squares_out,
+    std::vector<MetaTensor*> mean_grads_out,
+    std::vector<MetaTensor*> master_params_out) {
+  size_t in_size = params.size();
+  PADDLE_ENFORCE_EQ(
+      grads.size(),
+      in_size,
+      common::errors::InvalidArgument(
+          "The size of Input(Grads) must be equal to the size of "
+          "Input(Params), but got %d vs %d.",
+          grads.size(),
+          in_size));
+  if (centered) {
+    PADDLE_ENFORCE_EQ(
+        mean_grads.is_initialized(),
+        true,
+        common::errors::InvalidArgument(
+            "Input(MeanGrads) must be provided when centered is true."));
+  }
+  for (size_t i = 0; i < in_size; i++) {
+    params_out[i]->set_dims(params[i]->dims());
+    params_out[i]->set_dtype(params[i]->dtype());
+    moments_out[i]->set_dims(moments[i]->dims());
+    moments_out[i]->set_dtype(moments[i]->dtype());
+    mean_squares_out[i]->set_dims(mean_squares[i]->dims());
+    mean_squares_out[i]->set_dtype(mean_squares[i]->dtype());
+    if (centered && !mean_grads_out.empty()) {
+      mean_grads_out[i]->set_dims(mean_grads.get()[i]->dims());
+      mean_grads_out[i]->set_dtype(mean_grads.get()[i]->dtype());
+    }
+    if (master_params && !master_params_out.empty()) {
+      master_params_out[i]->set_dims(master_params.get()[i]->dims());
+      master_params_out[i]->set_dtype(master_params.get()[i]->dtype());
+    }
+  }
+}
+
 void FusedConvInferMeta(const MetaTensor& input,
                         const MetaTensor& filter,
                         const MetaTensor& bias,
@@ -1148,6 +1148,43 @@ void FusedAdamInferMeta(
     std::vector<MetaTensor*> beta2_pows_out,
     std::vector<MetaTensor*> master_params_out);
 
+void FusedAdagradInferMeta(
+    const std::vector<const MetaTensor*>& params,
+    const std::vector<const MetaTensor*>& grads,
+    const MetaTensor& learning_rate,
+    const std::vector<const MetaTensor*>& moments,
+    const paddle::optional<std::vector<const MetaTensor*>>& master_params,
+    const MetaTensor& found_inf,
+    const MetaTensor& scale,
+    float epsilon,
+    int chunk_size,
+    bool multi_precision,
+    std::vector<MetaTensor*> params_out,
+    std::vector<MetaTensor*> moments_out,
+    std::vector<MetaTensor*> master_params_out);
+
+void FusedRmspropInferMeta(
+    const std::vector<const MetaTensor*>& params,
+    const std::vector<const MetaTensor*>& grads,
+    const MetaTensor& learning_rate,
+    const std::vector<const MetaTensor*>& mean_squares,
+    const std::vector<const MetaTensor*>& moments,
+    const paddle::optional<std::vector<const MetaTensor*>>& mean_grads,
+    const paddle::optional<std::vector<const MetaTensor*>>& master_params,
+    const MetaTensor& found_inf,
+    const MetaTensor& scale,
+    float epsilon,
+    float decay,
+    float momentum,
+    int chunk_size,
+    bool centered,
+    bool multi_precision,
+    std::vector<MetaTensor*> params_out,
+    std::vector<MetaTensor*> moments_out,
+    std::vector<MetaTensor*> mean_squares_out,
+    std::vector<MetaTensor*> mean_grads_out,
+    std::vector<MetaTensor*> master_params_out);
+
 void FusedConvInferMeta(const MetaTensor& input,
                         const MetaTensor& filter,
                         const MetaTensor& bias,
@@ -848,4 +848,107 @@ SpmdInfo FlashAttGradInferSpmd(const DistMetaTensor& q,
           {q_grad, k_grad, v_grad}};
 }
 
+
+// startend_row_indices: [batch_size, num_heads or 1, seq_len_kv, {1, 2, 4}],
+// the bounds of the masked rows of each key, which follow q along batch and
+// num_heads like attn_mask, and are never sharded along seq_len_kv.
+TensorDistAttr FlashMaskStartEndRowIndicesDistAttr(
+    const DistMetaTensor& startend_row_indices,
+    const TensorDistAttr& q_dist_attr_dst) {
+  auto startend_row_indices_shape =
+      common::vectorize(startend_row_indices.dims());
+  PADDLE_ENFORCE_EQ(startend_row_indices_shape.size(),
+                    4,
+                    common::errors::InvalidArgument(
+                        "The Tensor startend_row_indices's shape must be "
+                        "[batch_size, num_heads or 1, seq_len_kv, {1, 2, 4}], "
+                        "but its rank is [%d].",
+                        startend_row_indices_shape.size()));
+  const auto& q_dims_mapping = q_dist_attr_dst.dims_mapping();
+  int64_t num_heads_mesh_dim = q_dims_mapping[kNumHeadsDimIndex];
+  if (startend_row_indices_shape[1] == 1 ||
+      (num_heads_mesh_dim != -1 &&
+       startend_row_indices_shape[1] %
+               q_dist_attr_dst.process_mesh().dim_size(num_heads_mesh_dim) !=
+           0)) {
+    num_heads_mesh_dim = -1;
+  }
+  auto dst = CopyTensorDistAttrForOutput(startend_row_indices.dist_attr());
+  dst.set_dims_mapping({q_dims_mapping[0], num_heads_mesh_dim, -1, -1});
+  return dst;
+}
+
+SpmdInfo FlashMaskAttInferSpmd(const DistMetaTensor& q,
+                               const DistMetaTensor& k,
+                               const DistMetaTensor& v,
+                               const DistMetaTensor& startend_row_indices,
+                               const DistMetaTensor& fixed_seed_offset,
+                               float dropout,
+                               bool causal,
+                               bool return_softmax,
+                               bool is_test,
+                               const std::string& rng_name) {
+  SpmdInfo info = FlashAttInferSpmd(q,
+                                    k,
+                                    v,
+                                    fixed_seed_offset,
+                                    DistMetaTensor(),
+                                    dropout,
+                                    causal,
+                                    return_softmax,
+                                    is_test,
+                                    rng_name);
+  const auto& q_dist_attr_dst =
+      PADDLE_GET_CONST(TensorDistAttr, info.first[0]);
+  auto startend_row_indices_dist_attr_dst =
+      FlashMaskStartEndRowIndicesDistAttr(startend_row_indices,
+                                          q_dist_attr_dst);
+  VLOG(4) << "FlashMaskAttInferSpmd: startend_row_indices src_dist_attr: ["
+          << startend_row_indices.dist_attr().to_string()
+          << "] dst_dist_attr: ["
+          << startend_row_indices_dist_attr_dst.to_string() << "]";
+  return {{info.first[0],
+           info.first[1],
+           info.first[2],
+           startend_row_indices_dist_attr_dst,
+           info.first[3]},
+          info.second};
+}
+
+SpmdInfo FlashMaskAttGradInferSpmd(const DistMetaTensor& q,
+                                   const DistMetaTensor& k,
+                                   const DistMetaTensor& v,
+                                   const DistMetaTensor& startend_row_indices,
+                                   const DistMetaTensor& out,
+                                   const DistMetaTensor& softmax_lse,
+                                   const DistMetaTensor& seed_offset,
+                                   const DistMetaTensor& out_grad,
+                                   float dropout,
+                                   bool causal) {
+  SpmdInfo info = FlashAttGradInferSpmd(q,
+                                        k,
+                                        v,
+                                        out,
+                                        softmax_lse,
+                                        seed_offset,
+                                        DistMetaTensor(),
+                                        out_grad,
+                                        dropout,
+                                        causal);
+  const auto& q_dist_attr_dst =
+      PADDLE_GET_CONST(TensorDistAttr, info.first[0]);
+  auto startend_row_indices_dist_attr_dst =
+      FlashMaskStartEndRowIndicesDistAttr(startend_row_indices,
+                                          q_dist_attr_dst);
+  return {{info.first[0],
+           info.first[1],
+           info.first[2],
+           startend_row_indices_dist_attr_dst,
+           info.first[3],
+           info.first[4],
+           info.first[5],
+           info.first[7]},
+          info.second};
+}
+
 }  // namespace phi::distributed
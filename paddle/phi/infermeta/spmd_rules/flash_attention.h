@@ -68,5 +68,29 @@ SpmdInfo FlashAttGradInferSpmd(const DistMetaTensor& q,
                                float dropout = 0.0,
                                bool causal = false);
 
+// The rules of flashmask_attention, whose startend_row_indices takes the
+// place of attn_mask and is sharded like it along batch and num_heads.
+SpmdInfo FlashMaskAttInferSpmd(const DistMetaTensor& q,
+                               const DistMetaTensor& k,
+                               const DistMetaTensor& v,
+                               const DistMetaTensor& startend_row_indices,
+                               const DistMetaTensor& fixed_seed_offset,
+                               float dropout = 0.0,
+                               bool causal = false,
+                               bool return_softmax = false,
+                               bool is_test = false,
+                               const std::string& rng_name = "");
+
+SpmdInfo FlashMaskAttGradInferSpmd(const DistMetaTensor& q,
+                                   const DistMetaTensor& k,
+                                   const DistMetaTensor& v,
+                                   const DistMetaTensor& startend_row_indices,
+                                   const DistMetaTensor& out,
+                                   const DistMetaTensor& softmax_lse,
+                                   const DistMetaTensor& seed_offset,
+                                   const DistMetaTensor& out_grad,
+                                   float dropout = 0.0,
+                                   bool causal = false);
+
 }  // namespace distributed
 }  // namespace phi
@@ -23,6 +23,7 @@ limitations under the License. */
 #include "paddle/phi/core/enforce.h"
 #include "paddle/phi/infermeta/binary.h"
 #include "paddle/phi/kernels/funcs/common_shape.h"
+#include "paddle/phi/kernels/funcs/resized_crop_normalize.h"
 #include "paddle/phi/kernels/impl/box_coder.h"
 
 namespace phi {
@@ -1671,6 +1672,78 @@ void RankAttentionInferMeta(const MetaTensor& x,
   out->share_lod(x);
 }
 
+void ResizedCropNormalizeInferMeta(const MetaTensor& x,
+                                   const MetaTensor& boxes,
+                                   const MetaTensor& flips,
+                                   const std::vector<int>& size,
+                                   const std::vector<float>& mean,
+                                   const std::vector<float>& stddev,
+                                   MetaTensor* out) {
+  auto x_dims = x.dims();
+  auto boxes_dims = boxes.dims();
+  PADDLE_ENFORCE_EQ(x_dims.size(),
+                    4,
+                    common::errors::InvalidArgument(
+                        "The format of Input(x) in ResizedCropNormalizeOp is "
+                        "NCHW. And the rank of input must be 4. But received "
+                        "rank = %d",
+                        x_dims.size()));
+  PADDLE_ENFORCE_EQ(
+      boxes_dims.size() == 2 && boxes_dims[1] == 4,
+      true,
+      common::errors::InvalidArgument(
+          "The shape of Input(boxes) in ResizedCropNormalizeOp should be "
+          "[N, 4]. But received [%s]",
+          boxes_dims));
+  PADDLE_ENFORCE_EQ(flips.dims().size(),
+                    1,
+                    common::errors::InvalidArgument(
+                        "The rank of Input(flips) in ResizedCropNormalizeOp "
+                        "should be 1. But received rank = %d",
+                        flips.dims().size()));
+  PADDLE_ENFORCE_EQ(size.size() == 2 && size[0] > 0 && size[1] > 0,
+                    true,
+                    common::errors::InvalidArgument(
+                        "The 'size' attribute in ResizedCropNormalizeOp "
+                        "should be two positive integers [height, width]."));
+  int64_t channels = x_dims[1];
+  if (channels > 0) {
+    PADDLE_ENFORCE_LE(
+        channels,
+        funcs::kResizedCropMaxChannels,
+        common::errors::InvalidArgument(
+            "ResizedCropNormalizeOp supports images of at most %d channels, "
+            "but received %d.",
+            funcs::kResizedCropMaxChannels,
+            channels));
+    for (const auto* values : {&mean, &stddev}) {
+      bool valid = values->size() == 1 ||
+                   static_cast<int64_t>(values->size()) == channels;
+      PADDLE_ENFORCE_EQ(
+          valid,
+          true,
+          common::errors::InvalidArgument(
+              "The 'mean' and 'stddev' attributes in ResizedCropNormalizeOp "
+              "should have 1 or %d values, but received %d.",
+              channels,
+              values->size()));
+    }
+  }
+  if (x_dims[0] > 0 && boxes_dims[0] > 0) {
+    PADDLE_ENFORCE_EQ(x_dims[0],
+                      boxes_dims[0],
+                      common::errors::InvalidArgument(
+                          "The batch size of Input(x) and Input(boxes) in "
+                          "ResizedCropNormalizeOp should be equal, but "
+                          "received %d and %d.",
+                          x_dims[0],
+                          boxes_dims[0]));
+  }
+
+  out->set_dims(common::make_ddim({x_dims[0], x_dims[1], size[0], size[1]}));
+  out->set_dtype(DataType::FLOAT32);
+}
+
 void RoiAlignInferMeta(const MetaTensor& x,
                        const MetaTensor& boxes,
                        const MetaTensor& boxes_num,
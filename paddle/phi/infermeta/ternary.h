@@ -316,6 +316,14 @@ void RankAttentionInferMeta(const MetaTensor& x,
                             MetaTensor* out,
                             MetaTensor* ins_rank);
 
+void ResizedCropNormalizeInferMeta(const MetaTensor& x,
+                                   const MetaTensor& boxes,
+                                   const MetaTensor& flips,
+                                   const std::vector<int>& size,
+                                   const std::vector<float>& mean,
+                                   const std::vector<float>& stddev,
+                                   MetaTensor* out);
+
 void RoiAlignInferMeta(const MetaTensor& x,
                        const MetaTensor& boxes,
                        const MetaTensor& boxes_num,
@@ -14,12 +14,94 @@
 
 #include "paddle/phi/kernels/autotune/cache.h"
 
+#include <fstream>
 #include <iomanip>
+#include <sstream>
 
 #include "glog/logging.h"
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+#include "paddle/phi/backends/gpu/gpu_info.h"
+#endif
+#ifdef PADDLE_WITH_CUDA
+#include <cublas_api.h>
+#endif
 
 namespace phi::autotune {
 
+namespace {
+
+constexpr char kSignaturePrefix[] = "signature";
+constexpr char kAlgoPrefix[] = "algo";
+constexpr char kMatmulPrefix[] = "matmul";
+constexpr char kConvPrefix[] = "conv";
+constexpr char kGemmEpiloguePrefix[] = "gemm_epilogue";
+constexpr char kCudnnV8Prefix[] = "cudnn_v8";
+
+template <typename T>
+std::string JoinVector(const std::vector<T>& vec) {
+  std::ostringstream oss;
+  for (size_t i = 0; i < vec.size(); ++i) {
+    if (i != 0) {
+      oss << ",";
+    }
+    oss << vec[i];
+  }
+  return vec.empty() ? "-" : oss.str();
+}
+
+template <typename T>
+bool ParseVector(const std::string& str, std::vector<T>* vec) {
+  vec->clear();
+  if (str == "-") {
+    return true;
+  }
+  std::istringstream iss(str);
+  std::string item;
+  while (std::getline(iss, item, ',')) {
+    std::istringstream item_iss(item);
+    T value;
+    if (!(item_iss >> value)) {
+      return false;
+    }
+    vec->push_back(value);
+  }
+  return true;
+}
+
+#ifdef PADDLE_WITH_CUDNN_FRONTEND
+// The json plans hold spaces and line breaks, they are written in hex to keep
+// one entry per line.
+std::string HexEncode(const std::string& str) {
+  static const char kDigits[] = "0123456789abcdef";
+  std::string hex;
+  hex.reserve(str.size() * 2);
+  for (unsigned char c : str) {
+    hex.push_back(kDigits[c >> 4]);
+    hex.push_back(kDigits[c & 0xf]);
+  }
+  return hex;
+}
+
+bool HexDecode(const std::string& hex, std::string* str) {
+  if (hex.size() % 2 != 0) {
+    return false;
+  }
+  str->clear();
+  str->reserve(hex.size() / 2);
+  for (size_t i = 0; i < hex.size(); i += 2) {
+    int value = 0;
+    std::istringstream iss(hex.substr(i, 2));
+    if (!(iss >> std::hex >> value)) {
+      return false;
+    }
+    str->push_back(static_cast<char>(value));
+  }
+  return true;
+}
+#endif
+
+}  // namespace
+
 size_t TransposeKey(const std::vector<int64_t>& x_dims,
                     const std::vector<int32_t>& perm,
                     phi::DataType dtype) {
@@ -36,6 +118,12 @@ std::string AlgorithmTypeString(int64_t algo_type) {
   } else if (algo_type ==
              static_cast<int64_t>(AlgorithmType::kConvBackwardFilter)) {
     return "conv_backward_filter";
+  } else if (algo_type == static_cast<int64_t>(AlgorithmType::kReduceAny)) {
+    return "reduce_any";
+  } else if (algo_type == static_cast<int64_t>(AlgorithmType::kSparseMatmul)) {
+    return "sparse_matmul";
+  } else if (algo_type == static_cast<int64_t>(AlgorithmType::kGemmEpilogue)) {
+    return "gemm_epilogue";
   }
 #ifdef PADDLE_WITH_CUDNN_FRONTEND
   if (algo_type == static_cast<int64_t>(AlgorithmType::kConvForwardV8)) {
@@ -96,6 +184,17 @@ void AutoTuneCache::UpdateStatus() {
     cache_misses += v.second.CacheMisses();
   }
 
+  VLOG(4) << "AlgoType: " << std::setfill(' ') << std::setw(name_width)
+          << AlgorithmTypeString(
+                 static_cast<int64_t>(AlgorithmType::kGemmEpilogue))
+          << " Cache Size: " << gemm_epilogue_auto_tune_map_.Size()
+          << " Hits: " << gemm_epilogue_auto_tune_map_.CacheHits()
+          << " Misses: " << gemm_epilogue_auto_tune_map_.CacheMisses()
+          << " Hit Rate: " << gemm_epilogue_auto_tune_map_.CacheHitRate();
+  size += gemm_epilogue_auto_tune_map_.Size();
+  cache_hits += gemm_epilogue_auto_tune_map_.CacheHits();
+  cache_misses += gemm_epilogue_auto_tune_map_.CacheMisses();
+
 #ifdef PADDLE_WITH_CUDNN_FRONTEND
   for (auto& v : cudnn_v8_auto_tune_map_) {
     VLOG(4) << "AlgoType: " << std::setfill(' ') << std::setw(name_width)
@@ -115,4 +214,172 @@ void AutoTuneCache::UpdateStatus() {
   total_cache_misses_ = cache_misses;
 }
 
+std::string AutoTuneCache::EnvSignature() {
+  std::ostringstream oss;
+  oss << "autotune_v1";
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  int device_id = phi::backends::gpu::GetCurrentDeviceId();
+  oss << ";arch=" << phi::backends::gpu::GetGPUComputeCapability(device_id)
+      << ";runtime=" << phi::backends::gpu::GetGPURuntimeVersion(device_id)
+      << ";dnn=" << phi::backends::gpu::DnnVersion();
+#endif
+#ifdef PADDLE_WITH_CUDA
+  oss << ";cublas=" << CUBLAS_VERSION;
+#endif
+  return oss.str();
+}
+
+int64_t AutoTuneCache::Export(const std::string& path) {
+  std::ofstream fout(path);
+  PADDLE_ENFORCE_EQ(
+      fout.is_open(),
+      true,
+      common::errors::Unavailable(
+          "Failed to open %s to export the autotune cache.", path));
+  int64_t num_entries = 0;
+  fout << kSignaturePrefix << " " << EnvSignature() << "\n";
+  for (auto& v : auto_tune_map_) {
+    for (const auto& item : v.second.GetAll()) {
+      fout << kAlgoPrefix << " " << v.first << " " << item.first << " "
+           << item.second << "\n";
+      ++num_entries;
+    }
+  }
+  for (const auto& item : matmul_auto_tune_map_.GetAll()) {
+    fout << kMatmulPrefix << " " << item.first << " " << item.second << "\n";
+    ++num_entries;
+  }
+  for (auto& v : conv_auto_tune_map_) {
+    for (const auto& item : v.second.GetAll()) {
+      const auto& key = item.first;
+      const auto& result = item.second;
+      fout << kConvPrefix << " " << v.first << " " << JoinVector(key.x_dims)
+           << " " << JoinVector(key.w_dims) << " " << JoinVector(key.strides)
+           << " " << JoinVector(key.paddings) << " "
+           << JoinVector(key.dilations) << " " << static_cast<int>(key.dtype)
+           << " " << key.groups << " " << key.data_layout << " "
+           << result.algo << " " << result.workspace_size << " "
+           << result.exhaustive_search << "\n";
+      ++num_entries;
+    }
+  }
+  for (const auto& item : gemm_epilogue_auto_tune_map_.GetAll()) {
+    std::vector<uint64_t> words(item.second.begin(), item.second.end());
+    fout << kGemmEpiloguePrefix << " " << item.first << " "
+         << JoinVector(words) << "\n";
+    ++num_entries;
+  }
+#ifdef PADDLE_WITH_CUDNN_FRONTEND
+  for (auto& v : cudnn_v8_auto_tune_map_) {
+    for (const auto& item : v.second.GetSerializedPlans()) {
+      fout << kCudnnV8Prefix << " " << v.first << " " << JoinVector(item.first)
+           << " " << HexEncode(item.second) << "\n";
+      ++num_entries;
+    }
+  }
+#endif
+  VLOG(3) << "Export " << num_entries << " autotune entries to " << path;
+  return num_entries;
+}
+
+int64_t AutoTuneCache::Import(const std::string& path) {
+  std::ifstream fin(path);
+  if (!fin.is_open()) {
+    VLOG(3) << "The autotune cache file " << path << " does not exist.";
+    return 0;
+  }
+  std::string line;
+  std::string signature;
+  if (!std::getline(fin, line) ||
+      line.rfind(std::string(kSignaturePrefix) + " ", 0) != 0) {
+    LOG(WARNING) << "Skip the invalid autotune cache file " << path;
+    return 0;
+  }
+  signature = line.substr(sizeof(kSignaturePrefix));
+  if (signature != EnvSignature()) {
+    LOG(WARNING) << "Skip the autotune cache file " << path
+                 << " exported with " << signature << ", but the current is "
+                 << EnvSignature();
+    return 0;
+  }
+
+  int64_t num_entries = 0;
+  while (std::getline(fin, line)) {
+    std::istringstream iss(line);
+    std::string prefix;
+    iss >> prefix;
+    bool success = false;
+    if (prefix == kAlgoPrefix) {
+      int64_t algo_type;
+      size_t key;
+      int64_t algo;
+      if (iss >> algo_type >> key >> algo &&
+          auto_tune_map_.count(algo_type) != 0) {
+        auto_tune_map_[algo_type].Set(key, algo);
+        success = true;
+      }
+    } else if (prefix == kMatmulPrefix) {
+      size_t key;
+      int64_t algo;
+      if (iss >> key >> algo) {
+        matmul_auto_tune_map_.Set(key, algo);
+        success = true;
+      }
+    } else if (prefix == kConvPrefix) {
+      int64_t algo_type;
+      std::string x_dims, w_dims, strides, paddings, dilations;
+      int dtype;
+      ConvCacheKey key;
+      ConvAutoTuneResult result;
+      if (iss >> algo_type >> x_dims >> w_dims >> strides >> paddings >>
+              dilations >> dtype >> key.groups >> key.data_layout >>
+              result.algo >> result.workspace_size >>
+              result.exhaustive_search &&
+          conv_auto_tune_map_.count(algo_type) != 0 &&
+          ParseVector(x_dims, &key.x_dims) &&
+          ParseVector(w_dims, &key.w_dims) &&
+          ParseVector(strides, &key.strides) &&
+          ParseVector(paddings, &key.paddings) &&
+          ParseVector(dilations, &key.dilations)) {
+        key.dtype = static_cast<phi::DataType>(dtype);
+        conv_auto_tune_map_[algo_type].Set(key, result);
+        success = true;
+      }
+    } else if (prefix == kGemmEpiloguePrefix) {
+      size_t key;
+      std::string words_str;
+      std::vector<uint64_t> words;
+      BlasLtAlgo algo;
+      if (iss >> key >> words_str && ParseVector(words_str, &words) &&
+          words.size() == algo.size()) {
+        std::copy(words.begin(), words.end(), algo.begin());
+        gemm_epilogue_auto_tune_map_.Set(key, algo);
+        success = true;
+      }
+    }
+#ifdef PADDLE_WITH_CUDNN_FRONTEND
+    else if (prefix == kCudnnV8Prefix) {  // NOLINT
+      int64_t algo_type;
+      std::string feature_str, hex_plan, json_plan;
+      cudnn_frontend::feature_vector_t feature;
+      if (iss >> algo_type >> feature_str >> hex_plan &&
+          cudnn_v8_auto_tune_map_.count(algo_type) != 0 &&
+          ParseVector(feature_str, &feature) &&
+          HexDecode(hex_plan, &json_plan)) {
+        cudnn_v8_auto_tune_map_[algo_type].InsertSerializedPlan(feature,
+                                                                json_plan);
+        success = true;
+      }
+    }
+#endif
+    if (success) {
+      ++num_entries;
+    } else if (!line.empty()) {
+      LOG(WARNING) << "Skip the invalid autotune cache entry: " << line;
+    }
+  }
+  VLOG(3) << "Import " << num_entries << " autotune entries from " << path;
+  return num_entries;
+}
+
 }  // namespace phi::autotune
@@ -15,13 +15,18 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <numeric>
+#include <string>
 
 #include "paddle/phi/common/data_type.h"
 #include "paddle/phi/kernels/autotune/cache_base.h"
 #ifdef PADDLE_WITH_CUDNN_FRONTEND
 #include "paddle/phi/kernels/autotune/cache_cudnn_frontend.h"
 #endif
+
+COMMON_DECLARE_string(autotune_cache_file);
+
 namespace phi {
 namespace autotune {
 
@@ -50,7 +55,10 @@ enum class AlgorithmType {
   kGatherGemmScatterFP32TN = 8,
   kGatherGemmScatterFP32NT = 9,
 #if !defined(PADDLE_WITH_CUDNN_FRONTEND)
-  kAlgorithmCount = 10
+  kReduceAny = 10,
+  kSparseMatmul = 11,
+  kGemmEpilogue = 12,
+  kAlgorithmCount = 13
 #else
   kConvForwardV8 = 10,
   kConvBackwardDataV8 = 11,
@@ -63,7 +71,10 @@ enum class AlgorithmType {
   kBnActWgrad = 18,
   kPoolingForwardV8 = 19,
   kPoolingBackwardV8 = 20,
-  kAlgorithmCount = 21
+  kReduceAny = 21,
+  kSparseMatmul = 22,
+  kGemmEpilogue = 23,
+  kAlgorithmCount = 24
 #endif
 };
 
@@ -78,6 +89,11 @@ using ConvAlgorithmsTypeMap =
     std::unordered_map<int64_t, ConvAlgorithmsCacheMap>;
 
 using MatmulAlgorithmsCacheMap = MatmulAlgorithmsCache<size_t, int64_t>;
+
+// The opaque cublasLt/hipblasLt algorithm copied into plain words, so that it
+// can be exported to the cache file.
+using BlasLtAlgo = std::array<uint64_t, 8>;
+using BlasLtAlgorithmsCacheMap = AlgorithmsCache<size_t, BlasLtAlgo>;
 #ifdef PADDLE_WITH_CUDNN_FRONTEND
 using CudnnV8AlgorithmsTypeMap =
     std::unordered_map<int64_t, CudnnFrontendPlanCache>;
@@ -107,6 +123,10 @@ class AutoTuneCache {
 
   MatmulAlgorithmsCacheMap& GetMatmul() { return matmul_auto_tune_map_; }
 
+  BlasLtAlgorithmsCacheMap& GetGemmEpilogue() {
+    return gemm_epilogue_auto_tune_map_;
+  }
+
   ConvAlgorithmsCacheMap& GetConv(const AlgorithmType& algo_type) {
     return conv_auto_tune_map_[static_cast<int64_t>(algo_type)];
   }
@@ -142,6 +162,8 @@ class AutoTuneCache {
       v.second.Clean();
     }
 
+    gemm_epilogue_auto_tune_map_.Clean();
+
 #ifdef PADDLE_WITH_CUDNN_FRONTEND
     for (auto& v : cudnn_v8_auto_tune_map_) {
       v.second.Clean();
@@ -151,6 +173,20 @@ class AutoTuneCache {
 
   void UpdateStatus();
 
+  // The device arch and the library versions, the exported cache is only
+  // loaded when the signature is the same.
+  static std::string EnvSignature();
+
+  // Writes all the serializable algorithms to the file. The cudnn frontend
+  // plans are written in their json representation, and built again for the
+  // runtime handles when they are first looked up after Import.
+  int64_t Export(const std::string& path);
+
+  // Loads the algorithms exported by Export, returns the number of the loaded
+  // entries. Nothing is loaded if the file does not exist or the signature
+  // mismatches.
+  int64_t Import(const std::string& path);
+
   // The number of total config cached
   int64_t Size() const { return total_size_; }
 
@@ -173,6 +209,9 @@ class AutoTuneCache {
     for (int i = 1; i < static_cast<int>(AlgorithmType::kAlgorithmCount); ++i) {
       Register(static_cast<AlgorithmType>(i));
     }
+    if (!FLAGS_autotune_cache_file.empty()) {
+      Import(FLAGS_autotune_cache_file);
+    }
   }
 
   void Register(const AlgorithmType& algo_type) {
@@ -187,7 +226,7 @@ class AutoTuneCache {
       }
 #ifdef PADDLE_WITH_CUDNN_FRONTEND
     } else if (algo_type >= AlgorithmType::kConvForwardV8 &&
-               algo_type < AlgorithmType::kAlgorithmCount) {
+               algo_type <= AlgorithmType::kPoolingBackwardV8) {
       int64_t key = static_cast<int64_t>(algo_type);
       if (cudnn_v8_auto_tune_map_.find(key) == cudnn_v8_auto_tune_map_.end()) {
         CudnnFrontendPlanCache cache;
@@ -206,6 +245,7 @@ class AutoTuneCache {
   AlgorithmsTypeMap auto_tune_map_;
   ConvAlgorithmsTypeMap conv_auto_tune_map_;
   MatmulAlgorithmsCacheMap matmul_auto_tune_map_;
+  BlasLtAlgorithmsCacheMap gemm_epilogue_auto_tune_map_;
 #ifdef PADDLE_WITH_CUDNN_FRONTEND
   CudnnV8AlgorithmsTypeMap cudnn_v8_auto_tune_map_;
 #endif
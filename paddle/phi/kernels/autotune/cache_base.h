@@ -153,6 +153,12 @@ class AlgorithmsCache {
 
   int64_t Size() const { return hash_.size(); }
 
+  // Returns a copy of all the cached algorithms, used to export the cache.
+  std::unordered_map<KeyT, AlgorithmT, HashT, KeyEqualT> GetAll() {
+    std::lock_guard<std::mutex> lock(*cache_mutex_);
+    return hash_;
+  }
+
  protected:
   std::unordered_map<KeyT, AlgorithmT, HashT, KeyEqualT> hash_;
   std::shared_ptr<std::mutex> cache_mutex_;
@@ -61,6 +61,7 @@ class CudnnFrontendPlanCache {
     std::lock_guard<std::mutex> lock(*cache_mutex_);
     map_.clear();
     tracker_.clear();
+    serialized_plans_.clear();
     cache_hits_ = 0;
     cache_misses_ = 0;
   }
@@ -70,7 +71,9 @@ class CudnnFrontendPlanCache {
     bool ret = false;
     std::lock_guard<std::mutex> lock(*cache_mutex_);
     auto &local_map = map_[hasher(std::this_thread::get_id())];
-    if (local_map.count(GetExtendedFeature(feature, handle)) > 0) {
+    auto ext_feature = GetExtendedFeature(feature, handle);
+    if (local_map.count(ext_feature) > 0 ||
+        LoadSerializedPlan(feature, ext_feature, handle, &local_map)) {
       cache_hits_++;
       ret = true;
     } else {
@@ -128,6 +131,37 @@ class CudnnFrontendPlanCache {
     return cnt >= saturation_count_;
   }
 
+  // Returns the json representations of the cached plans, keyed by the
+  // feature vectors without the handle, so that they can be exported to
+  // the autotune cache file.
+  std::map<cudnn_frontend::feature_vector_t, std::string> GetSerializedPlans() {
+    std::lock_guard<std::mutex> lock(*cache_mutex_);
+    auto plans = serialized_plans_;
+#if CUDNN_VERSION >= 8400
+    for (auto &local_map : map_) {
+      for (auto &item : local_map.second) {
+        auto feature = item.first;
+        feature.pop_back();
+        try {
+          plans[feature] = item.second.getJsonRepresentation();
+        } catch (cudnn_frontend::cudnnException &e) {
+          VLOG(4) << "[cudnn_frontend] cache: Plan " << item.second.getTag()
+                  << " can not be serialized.";
+        }
+      }
+    }
+#endif
+    return plans;
+  }
+
+  // Adds a plan imported from the autotune cache file. It is built for the
+  // handle of the first lookup that hits it.
+  void InsertSerializedPlan(const cudnn_frontend::feature_vector_t &feature,
+                            const std::string &json_plan) {
+    std::lock_guard<std::mutex> lock(*cache_mutex_);
+    serialized_plans_[feature] = json_plan;
+  }
+
   bool FindPlan(const cudnn_frontend::OperationGraph &op_graph,
                 cudnnHandle_t handle) {
     return FindPlan(op_graph.getFeatureVector(), handle);
@@ -154,6 +188,38 @@ class CudnnFrontendPlanCache {
   }
 
  private:
+  using FeatureVectorToPlanMap =
+      std::map<cudnn_frontend::feature_vector_t, cudnn_frontend::ExecutionPlan>;
+
+  // Builds the imported plan of the feature for the handle, the caller holds
+  // the cache mutex.
+  bool LoadSerializedPlan(const cudnn_frontend::feature_vector_t &feature,
+                          const cudnn_frontend::feature_vector_t &ext_feature,
+                          cudnnHandle_t handle,
+                          FeatureVectorToPlanMap *local_map) {
+#if CUDNN_VERSION >= 8400
+    auto it = serialized_plans_.find(feature);
+    if (it == serialized_plans_.end()) {
+      return false;
+    }
+    try {
+      auto plan = cudnn_frontend::ExecutionPlanBuilder()
+                      .setHandle(handle)
+                      .loadFromJson(it->second)
+                      .build();
+      VLOG(4) << "[cudnn_frontend] cache: Load plan: " << plan.getTag();
+      local_map->insert(std::make_pair(ext_feature, std::move(plan)));
+      return true;
+    } catch (cudnn_frontend::cudnnException &e) {
+      VLOG(4) << "[cudnn_frontend] cache: Drop the plan which can not be "
+                 "built: "
+              << e.what();
+      serialized_plans_.erase(it);
+    }
+#endif
+    return false;
+  }
+
   cudnn_frontend::feature_vector_t GetExtendedFeature(
       cudnn_frontend::feature_vector_t feat, cudnnHandle_t handle) {
     int64_t val = 0;
@@ -161,9 +227,8 @@ class CudnnFrontendPlanCache {
     feat.push_back(val);
     return feat;
   }
-  using FeatureVectorToPlanMap =
-      std::map<cudnn_frontend::feature_vector_t, cudnn_frontend::ExecutionPlan>;
   std::map<std::size_t, FeatureVectorToPlanMap> map_;
+  std::map<cudnn_frontend::feature_vector_t, std::string> serialized_plans_;
   std::hash<std::thread::id> hasher;
 
   std::shared_ptr<std::mutex> cache_mutex_;
@@ -54,6 +54,11 @@ void AutoTuneStatus::Update() {
             << static_cast<int>(StepHitRate() * 100) << "%";
   } else {
     use_autotune_ = false;
+    // Export the tuned algorithms once the tuning range is finished.
+    if (current_steps_id_ + 1 == stop_step_id_ &&
+        !FLAGS_autotune_cache_file.empty()) {
+      AutoTuneCache::Instance().Export(FLAGS_autotune_cache_file);
+    }
     // Set a small tolerance to avoid performance degradation
     // due to large cache size under dynamic shape.
     // TODO(limingshu): Currently works for conv op only, this
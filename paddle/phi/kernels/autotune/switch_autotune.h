@@ -85,6 +85,9 @@ class AutoTuneStatus {
     previous_misses_ = 0;
     step_hit_rates_.clear();
     AutoTuneCache::Instance().Clean();
+    if (!FLAGS_autotune_cache_file.empty()) {
+      AutoTuneCache::Instance().Import(FLAGS_autotune_cache_file);
+    }
   }
 
   bool use_autotune_{false};
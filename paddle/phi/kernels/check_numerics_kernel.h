@@ -29,4 +29,10 @@ void CheckNumericsKernel(const Context& ctx,
                          DenseTensor* stats,
                          DenseTensor* values);
 
+// Sets *flag on the device when the tensor holds NAN or INF, without
+// printing or synchronizing, so that the flags of a whole step can be read
+// back at once. It is only implemented for the float types on GPU.
+template <typename T, typename Context>
+void MarkNanInf(const Context& ctx, const DenseTensor& tensor, int* flag);
+
 }  // namespace phi
@@ -0,0 +1,77 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/resized_crop_normalize_kernel.h"
+
+#include "paddle/phi/backends/cpu/cpu_context.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/funcs/resized_crop_normalize.h"
+
+namespace phi {
+
+template <typename T, typename Context>
+void ResizedCropNormalizeKernel(const Context& dev_ctx,
+                                const DenseTensor& x,
+                                const DenseTensor& boxes,
+                                const DenseTensor& flips,
+                                const std::vector<int>& size,
+                                const std::vector<float>& mean,
+                                const std::vector<float>& stddev,
+                                DenseTensor* out) {
+  const int batch = static_cast<int>(x.dims()[0]);
+  const int channels = static_cast<int>(x.dims()[1]);
+  const int height = static_cast<int>(x.dims()[2]);
+  const int width = static_cast<int>(x.dims()[3]);
+  const int out_h = size[0];
+  const int out_w = size[1];
+
+  const T* x_data = x.data<T>();
+  const int* boxes_data = boxes.data<int>();
+  const bool* flips_data = flips.data<bool>();
+  float* out_data = dev_ctx.template Alloc<float>(out);
+
+  for (int n = 0; n < batch; ++n) {
+    for (int c = 0; c < channels; ++c) {
+      const T* image = x_data + (n * channels + c) * height * width;
+      float m = mean.size() == 1 ? mean[0] : mean[c];
+      float s = stddev.size() == 1 ? stddev[0] : stddev[c];
+      for (int oy = 0; oy < out_h; ++oy) {
+        for (int ox = 0; ox < out_w; ++ox) {
+          *out_data++ = funcs::ResizedCropNormalizePixel(image,
+                                                         height,
+                                                         width,
+                                                         boxes_data + n * 4,
+                                                         flips_data[n],
+                                                         out_h,
+                                                         out_w,
+                                                         oy,
+                                                         ox,
+                                                         m,
+                                                         s);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace phi
+
+PD_REGISTER_KERNEL(resized_crop_normalize,
+                   CPU,
+                   ALL_LAYOUT,
+                   phi::ResizedCropNormalizeKernel,
+                   uint8_t,
+                   float) {
+  kernel->OutputAt(0).SetDataType(phi::DataType::FLOAT32);
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/weight_dequantize_kernel.h"
+
+#include "paddle/phi/backends/cpu/cpu_context.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/funcs/weight_only_cpu.h"
+
+namespace phi {
+
+// The weight is quantized by weight_quantize with arch 0 on cpu.
+template <typename T, typename Context>
+void WeightDequantizeKernel(const Context& dev_ctx,
+                            const DenseTensor& x,
+                            const DenseTensor& scale,
+                            const std::string& algo,
+                            DataType out_dtype,
+                            int32_t group_size,
+                            DenseTensor* out) {
+  const int bits = algo == "weight_only_int4" ? 4 : 8;
+  const int64_t k = x.dims()[1];
+  const int64_t n = x.dims()[0] * 8 / bits;
+
+  DenseTensor scale_float;
+  scale_float.Resize(scale.dims());
+  float* scale_data = dev_ctx.template Alloc<float>(&scale_float);
+  const T* scale_src = scale.data<T>();
+  for (int64_t i = 0; i < scale.numel(); ++i) {
+    scale_data[i] = static_cast<float>(scale_src[i]);
+  }
+
+  DenseTensor dequant_weight;
+  dequant_weight.Resize({n, k});
+  float* dequant_data = dev_ctx.template Alloc<float>(&dequant_weight);
+  funcs::WeightOnlyDequantize(
+      x.data<int8_t>(), scale_data, n, k, bits, group_size, dequant_data);
+
+  // out is [k, n] as the y of matmul
+  T* out_data = dev_ctx.template Alloc<T>(out);
+  for (int64_t i = 0; i < k; ++i) {
+    for (int64_t j = 0; j < n; ++j) {
+      out_data[i * n + j] = static_cast<T>(dequant_data[j * k + i]);
+    }
+  }
+}
+
+}  // namespace phi
+
+PD_REGISTER_KERNEL(weight_dequantize,
+                   CPU,
+                   ALL_LAYOUT,
+                   phi::WeightDequantizeKernel,
+                   float,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {}
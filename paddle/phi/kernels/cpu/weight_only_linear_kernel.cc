@@ -0,0 +1,141 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/weight_only_linear_kernel.h"
+
+#include <algorithm>
+#include <type_traits>
+
+#include "paddle/phi/backends/cpu/cpu_context.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/funcs/blas/blas.h"
+#include "paddle/phi/kernels/funcs/weight_only_cpu.h"
+
+namespace phi {
+
+// Up to these rows of x, i.e. the decoding of a few tokens, the int weight is
+// read once by the GEMV, which is bound by the bandwidth of the weight. The
+// larger ones dequantize the weight for the GEMM.
+constexpr int64_t kWeightOnlyGemvMaxRows = 16;
+
+template <typename T>
+const float* ToFloatData(const CPUContext& dev_ctx,
+                         const DenseTensor& x,
+                         DenseTensor* buffer) {
+  if (std::is_same<T, float>::value) {
+    return reinterpret_cast<const float*>(x.data<T>());
+  }
+  buffer->Resize({x.numel()});
+  float* data = dev_ctx.template Alloc<float>(buffer);
+  const T* x_data = x.data<T>();
+  for (int64_t i = 0; i < x.numel(); ++i) {
+    data[i] = static_cast<float>(x_data[i]);
+  }
+  return data;
+}
+
+template <typename T, typename Context>
+void WeightOnlyLinearKernel(const Context& dev_ctx,
+                            const DenseTensor& x,
+                            const DenseTensor& weight,
+                            const paddle::optional<DenseTensor>& bias,
+                            const DenseTensor& weight_scale,
+                            const std::string& weight_dtype,
+                            const int32_t arch,
+                            const int32_t group_size,
+                            DenseTensor* out) {
+  PADDLE_ENFORCE_EQ(
+      arch,
+      0,
+      common::errors::InvalidArgument(
+          "The weight of weight_only_linear on cpu should be quantized by "
+          "weight_quantize with arch 0, but got arch %d.",
+          arch));
+  const int bits = weight_dtype == "int4" ? 4 : 8;
+  const int64_t n =
+      group_size > 0 ? weight_scale.dims()[1] : weight_scale.dims()[0];
+  const int64_t k = weight.dims()[1];
+  const int64_t m = x.numel() / k;
+
+  DenseTensor x_buffer, scale_buffer, bias_buffer;
+  const float* x_data = ToFloatData<T>(dev_ctx, x, &x_buffer);
+  const float* scale_data =
+      ToFloatData<T>(dev_ctx, weight_scale, &scale_buffer);
+  const float* bias_data =
+      bias ? ToFloatData<T>(dev_ctx, bias.get(), &bias_buffer) : nullptr;
+  const int8_t* weight_data = weight.data<int8_t>();
+
+  T* out_data = dev_ctx.template Alloc<T>(out);
+  DenseTensor out_buffer;
+  float* out_float = nullptr;
+  if (std::is_same<T, float>::value) {
+    out_float = reinterpret_cast<float*>(out_data);
+  } else {
+    out_buffer.Resize({m * n});
+    out_float = dev_ctx.template Alloc<float>(&out_buffer);
+  }
+
+  if (m <= kWeightOnlyGemvMaxRows) {
+    funcs::WeightOnlyGemv(x_data,
+                          weight_data,
+                          scale_data,
+                          bias_data,
+                          m,
+                          n,
+                          k,
+                          bits,
+                          group_size,
+                          out_float);
+  } else {
+    DenseTensor dequant_weight;
+    dequant_weight.Resize({n, k});
+    float* dequant_data = dev_ctx.template Alloc<float>(&dequant_weight);
+    funcs::WeightOnlyDequantize(
+        weight_data, scale_data, n, k, bits, group_size, dequant_data);
+    auto blas = funcs::GetBlas<Context, float>(dev_ctx);
+    blas.GEMM(CblasNoTrans,
+              CblasTrans,
+              static_cast<int>(m),
+              static_cast<int>(n),
+              static_cast<int>(k),
+              1.f,
+              x_data,
+              dequant_data,
+              0.f,
+              out_float);
+    if (bias_data) {
+      for (int64_t i = 0; i < m; ++i) {
+        for (int64_t j = 0; j < n; ++j) {
+          out_float[i * n + j] += bias_data[j];
+        }
+      }
+    }
+  }
+
+  if (!std::is_same<T, float>::value) {
+    for (int64_t i = 0; i < m * n; ++i) {
+      out_data[i] = static_cast<T>(out_float[i]);
+    }
+  }
+}
+
+}  // namespace phi
+
+PD_REGISTER_KERNEL(weight_only_linear,
+                   CPU,
+                   ALL_LAYOUT,
+                   phi::WeightOnlyLinearKernel,
+                   float,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {}
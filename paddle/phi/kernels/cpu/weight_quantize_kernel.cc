@@ -36,11 +36,11 @@ void quant_compute(const DeviceContext& dev_ctx,
                    const int32_t group_size) {
 #ifndef PADDLE_WITH_HIP
   PADDLE_ENFORCE_EQ(
-      ((arch == 70) || (arch == 75) || (arch == 80) || (arch == 86) ||
-       (arch == 89) || (arch == 90)),
+      ((arch == 0) || (arch == 70) || (arch == 75) || (arch == 80) ||
+       (arch == 86) || (arch == 89) || (arch == 90)),
       true,
       common::errors::InvalidArgument(
-          "Currently, arch only support 70, 75, 80, 86, 89, 90."));
+          "Currently, arch only support 0 (cpu), 70, 75, 80, 86, 89, 90."));
 
 #endif
   const auto x_dims = x.dims();
@@ -62,8 +62,8 @@ void quant_compute(const DeviceContext& dev_ctx,
 #ifdef PADDLE_WITH_HIP
   x_int.Resize({static_cast<int64_t>(m), static_cast<int64_t>(n)});
 #else
-  if ((arch == 80) || (arch == 75) || (arch == 86) || (arch == 89) ||
-      (arch == 90)) {
+  if ((arch == 0) || (arch == 80) || (arch == 75) || (arch == 86) ||
+      (arch == 89) || (arch == 90)) {
     x_int.Resize({static_cast<int64_t>(m), static_cast<int64_t>(n)});
   } else {
     // phi::Copy may change tensor meta info, here we transpose the quanted
@@ -124,7 +124,16 @@ void quant_compute(const DeviceContext& dev_ctx,
       trans(dev_ctx, x_int_tmp, out, axis);
     }
 #else
-    if (arch == 70) {
+    if (arch == 0) {
+      // The layout of the cpu kernels: the int8 weight is [n, k], and the
+      // int4 weight is [n / 2, k] with the signed nibbles of the channels
+      // 2i and 2i + 1 in the low and high bits of the row i.
+      x_int.Resize({static_cast<int64_t>(m),
+                    static_cast<int64_t>(n * bits / 8)});
+      std::vector<int> axis = {1, 0};
+      funcs::Transpose<DeviceContext, int8_t, 2> trans;
+      trans(dev_ctx, x_int, out, axis);
+    } else if (arch == 70) {
       // Note(Zhengzekang): In sm70, we only need RowMajor layout, just add bias
       // to make it unsigned.
       add_bias_and_interleave_inplace<bits>(x_int_data, num);
@@ -182,5 +191,6 @@ PD_REGISTER_KERNEL(weight_quantize,
                    CPU,
                    ALL_LAYOUT,
                    phi::WeightQuantizeKernel,
+                   float,
                    phi::dtype::float16,
                    phi::dtype::bfloat16) {}
@@ -0,0 +1,122 @@
+/* Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include "paddle/phi/kernels/funcs/activation_compress_functor.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "paddle/phi/common/bfloat16.h"
+#include "paddle/phi/common/float16.h"
+
+namespace phi::funcs {
+
+template <typename Context, typename T>
+void PackBitMaskFunctor<Context, T>::operator()(const Context &ctx,
+                                                const DenseTensor &in,
+                                                DenseTensor *out) {
+  int64_t num = in.numel();
+  out->Resize(common::make_ddim({(num + 7) / 8}));
+  const T *in_data = in.data<T>();
+  uint8_t *out_data = ctx.template Alloc<uint8_t>(out);
+  std::fill(out_data, out_data + out->numel(), 0);
+  for (int64_t i = 0; i < num; ++i) {
+    if (static_cast<float>(in_data[i]) > 0) {
+      out_data[i / 8] |= static_cast<uint8_t>(1 << (i % 8));
+    }
+  }
+}
+
+template <typename Context, typename T>
+void UnpackBitMaskFunctor<Context, T>::operator()(const Context &ctx,
+                                                  const DenseTensor &in,
+                                                  DenseTensor *out) {
+  int64_t num = out->numel();
+  const uint8_t *in_data = in.data<uint8_t>();
+  T *out_data = ctx.template Alloc<T>(out);
+  for (int64_t i = 0; i < num; ++i) {
+    out_data[i] = static_cast<T>((in_data[i / 8] >> (i % 8)) & 1);
+  }
+}
+
+template <typename Context, typename T>
+void BlockQuantInt8Functor<Context, T>::operator()(const Context &ctx,
+                                                   const DenseTensor &in,
+                                                   DenseTensor *out,
+                                                   DenseTensor *scale) {
+  int64_t num = in.numel();
+  int64_t block_num =
+      (num + kActivationCompressBlock - 1) / kActivationCompressBlock;
+  out->Resize(common::make_ddim({num}));
+  scale->Resize(common::make_ddim({block_num}));
+  const T *in_data = in.data<T>();
+  int8_t *out_data = ctx.template Alloc<int8_t>(out);
+  float *scale_data = ctx.template Alloc<float>(scale);
+  for (int64_t block = 0; block < block_num; ++block) {
+    int64_t begin = block * kActivationCompressBlock;
+    int64_t end = std::min(begin + kActivationCompressBlock, num);
+    float max_abs = 0;
+    for (int64_t i = begin; i < end; ++i) {
+      max_abs = std::max(max_abs, std::fabs(static_cast<float>(in_data[i])));
+    }
+    float s = max_abs / 127;
+    scale_data[block] = s;
+    for (int64_t i = begin; i < end; ++i) {
+      float q = s == 0 ? 0 : std::round(static_cast<float>(in_data[i]) / s);
+      out_data[i] = static_cast<int8_t>(std::min(127.0f, std::max(-127.0f, q)));
+    }
+  }
+}
+
+template <typename Context, typename T>
+void BlockDequantInt8Functor<Context, T>::operator()(const Context &ctx,
+                                                     const DenseTensor &in,
+                                                     const DenseTensor &scale,
+                                                     DenseTensor *out) {
+  int64_t num = out->numel();
+  const int8_t *in_data = in.data<int8_t>();
+  const float *scale_data = scale.data<float>();
+  T *out_data = ctx.template Alloc<T>(out);
+  for (int64_t i = 0; i < num; ++i) {
+    out_data[i] = static_cast<T>(in_data[i] *
+                                 scale_data[i / kActivationCompressBlock]);
+  }
+}
+
+template class PackBitMaskFunctor<CPUContext, float>;
+template class PackBitMaskFunctor<CPUContext, double>;
+template class PackBitMaskFunctor<CPUContext, phi::dtype::float16>;
+template class PackBitMaskFunctor<CPUContext, phi::dtype::bfloat16>;
+template class PackBitMaskFunctor<CPUContext, uint8_t>;
+template class PackBitMaskFunctor<CPUContext, bool>;
+template class UnpackBitMaskFunctor<CPUContext, float>;
+template class UnpackBitMaskFunctor<CPUContext, double>;
+template class UnpackBitMaskFunctor<CPUContext, phi::dtype::float16>;
+template class UnpackBitMaskFunctor<CPUContext, phi::dtype::bfloat16>;
+template class UnpackBitMaskFunctor<CPUContext, uint8_t>;
+template class UnpackBitMaskFunctor<CPUContext, bool>;
+template class BlockQuantInt8Functor<CPUContext, float>;
+template class BlockQuantInt8Functor<CPUContext, double>;
+template class BlockQuantInt8Functor<CPUContext, phi::dtype::float16>;
+template class BlockQuantInt8Functor<CPUContext, phi::dtype::bfloat16>;
+template class BlockQuantInt8Functor<CPUContext, uint8_t>;
+template class BlockQuantInt8Functor<CPUContext, bool>;
+template class BlockDequantInt8Functor<CPUContext, float>;
+template class BlockDequantInt8Functor<CPUContext, double>;
+template class BlockDequantInt8Functor<CPUContext, phi::dtype::float16>;
+template class BlockDequantInt8Functor<CPUContext, phi::dtype::bfloat16>;
+template class BlockDequantInt8Functor<CPUContext, uint8_t>;
+template class BlockDequantInt8Functor<CPUContext, bool>;
+
+}  // namespace phi::funcs
@@ -0,0 +1,186 @@
+/* Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include "paddle/phi/kernels/funcs/activation_compress_functor.h"
+
+#include "paddle/phi/common/bfloat16.h"
+#include "paddle/phi/common/float16.h"
+
+namespace phi {
+namespace funcs {
+
+// one thread per byte of the mask
+template <typename T>
+__global__ void PackBitMaskKernel(const T *in,
+                                  const int64_t num,
+                                  uint8_t *out) {
+  int64_t byte = blockIdx.x * static_cast<int64_t>(blockDim.x) + threadIdx.x;
+  int64_t begin = byte * 8;
+  if (begin >= num) {
+    return;
+  }
+  uint8_t bits = 0;
+  for (int b = 0; b < 8 && begin + b < num; ++b) {
+    if (static_cast<float>(in[begin + b]) > 0) {
+      bits |= static_cast<uint8_t>(1 << b);
+    }
+  }
+  out[byte] = bits;
+}
+
+template <typename T>
+__global__ void UnpackBitMaskKernel(const uint8_t *in,
+                                    const int64_t num,
+                                    T *out) {
+  int64_t i = blockIdx.x * static_cast<int64_t>(blockDim.x) + threadIdx.x;
+  if (i < num) {
+    out[i] = static_cast<T>((in[i / 8] >> (i % 8)) & 1);
+  }
+}
+
+// one thread block per block of values, which finds the scale of the block
+// and quantizes it in one pass
+template <typename T>
+__global__ void BlockQuantInt8Kernel(const T *in,
+                                     const int64_t num,
+                                     int8_t *out,
+                                     float *scale) {
+  __shared__ float max_abs[kActivationCompressBlock];
+  int64_t i = blockIdx.x * kActivationCompressBlock + threadIdx.x;
+  float x = i < num ? static_cast<float>(in[i]) : 0.0f;
+  max_abs[threadIdx.x] = fabsf(x);
+  __syncthreads();
+  for (int stride = kActivationCompressBlock / 2; stride > 0; stride >>= 1) {
+    if (threadIdx.x < stride) {
+      max_abs[threadIdx.x] =
+          fmaxf(max_abs[threadIdx.x], max_abs[threadIdx.x + stride]);
+    }
+    __syncthreads();
+  }
+  float s = max_abs[0] / 127;
+  if (threadIdx.x == 0) {
+    scale[blockIdx.x] = s;
+  }
+  if (i < num) {
+    float q = s == 0 ? 0 : roundf(x / s);
+    out[i] = static_cast<int8_t>(fminf(127.0f, fmaxf(-127.0f, q)));
+  }
+}
+
+template <typename T>
+__global__ void BlockDequantInt8Kernel(const int8_t *in,
+                                       const float *scale,
+                                       const int64_t num,
+                                       T *out) {
+  int64_t i = blockIdx.x * static_cast<int64_t>(blockDim.x) + threadIdx.x;
+  if (i < num) {
+    out[i] = static_cast<T>(in[i] * scale[i / kActivationCompressBlock]);
+  }
+}
+
+template <typename Context, typename T>
+void PackBitMaskFunctor<Context, T>::operator()(const Context &ctx,
+                                                const DenseTensor &in,
+                                                DenseTensor *out) {
+  int64_t num = in.numel();
+  int64_t byte_num = (num + 7) / 8;
+  out->Resize(common::make_ddim({byte_num}));
+  uint8_t *out_data = ctx.template Alloc<uint8_t>(out);
+  if (byte_num == 0) {
+    return;
+  }
+  int block = 256;
+  int64_t grid = (byte_num + block - 1) / block;
+  PackBitMaskKernel<T>
+      <<<grid, block, 0, ctx.stream()>>>(in.data<T>(), num, out_data);
+}
+
+template <typename Context, typename T>
+void UnpackBitMaskFunctor<Context, T>::operator()(const Context &ctx,
+                                                  const DenseTensor &in,
+                                                  DenseTensor *out) {
+  int64_t num = out->numel();
+  T *out_data = ctx.template Alloc<T>(out);
+  if (num == 0) {
+    return;
+  }
+  int block = 1024;
+  int64_t grid = (num + block - 1) / block;
+  UnpackBitMaskKernel<T>
+      <<<grid, block, 0, ctx.stream()>>>(in.data<uint8_t>(), num, out_data);
+}
+
+template <typename Context, typename T>
+void BlockQuantInt8Functor<Context, T>::operator()(const Context &ctx,
+                                                   const DenseTensor &in,
+                                                   DenseTensor *out,
+                                                   DenseTensor *scale) {
+  int64_t num = in.numel();
+  int64_t block_num =
+      (num + kActivationCompressBlock - 1) / kActivationCompressBlock;
+  out->Resize(common::make_ddim({num}));
+  scale->Resize(common::make_ddim({block_num}));
+  int8_t *out_data = ctx.template Alloc<int8_t>(out);
+  float *scale_data = ctx.template Alloc<float>(scale);
+  if (num == 0) {
+    return;
+  }
+  BlockQuantInt8Kernel<T>
+      <<<block_num, kActivationCompressBlock, 0, ctx.stream()>>>(
+          in.data<T>(), num, out_data, scale_data);
+}
+
+template <typename Context, typename T>
+void BlockDequantInt8Functor<Context, T>::operator()(const Context &ctx,
+                                                     const DenseTensor &in,
+                                                     const DenseTensor &scale,
+                                                     DenseTensor *out) {
+  int64_t num = out->numel();
+  T *out_data = ctx.template Alloc<T>(out);
+  if (num == 0) {
+    return;
+  }
+  int block = 1024;
+  int64_t grid = (num + block - 1) / block;
+  BlockDequantInt8Kernel<T><<<grid, block, 0, ctx.stream()>>>(
+      in.data<int8_t>(), scale.data<float>(), num, out_data);
+}
+
+template class PackBitMaskFunctor<GPUContext, float>;
+template class PackBitMaskFunctor<GPUContext, double>;
+template class PackBitMaskFunctor<GPUContext, phi::dtype::float16>;
+template class PackBitMaskFunctor<GPUContext, phi::dtype::bfloat16>;
+template class PackBitMaskFunctor<GPUContext, uint8_t>;
+template class PackBitMaskFunctor<GPUContext, bool>;
+template class UnpackBitMaskFunctor<GPUContext, float>;
+template class UnpackBitMaskFunctor<GPUContext, double>;
+template class UnpackBitMaskFunctor<GPUContext, phi::dtype::float16>;
+template class UnpackBitMaskFunctor<GPUContext, phi::dtype::bfloat16>;
+template class UnpackBitMaskFunctor<GPUContext, uint8_t>;
+template class UnpackBitMaskFunctor<GPUContext, bool>;
+template class BlockQuantInt8Functor<GPUContext, float>;
+template class BlockQuantInt8Functor<GPUContext, double>;
+template class BlockQuantInt8Functor<GPUContext, phi::dtype::float16>;
+template class BlockQuantInt8Functor<GPUContext, phi::dtype::bfloat16>;
+template class BlockQuantInt8Functor<GPUContext, uint8_t>;
+template class BlockQuantInt8Functor<GPUContext, bool>;
+template class BlockDequantInt8Functor<GPUContext, float>;
+template class BlockDequantInt8Functor<GPUContext, double>;
+template class BlockDequantInt8Functor<GPUContext, phi::dtype::float16>;
+template class BlockDequantInt8Functor<GPUContext, phi::dtype::bfloat16>;
+template class BlockDequantInt8Functor<GPUContext, uint8_t>;
+template class BlockDequantInt8Functor<GPUContext, bool>;
+
+}  // namespace funcs
+}  // namespace phi
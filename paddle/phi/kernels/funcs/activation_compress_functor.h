@@ -0,0 +1,65 @@
+/* Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#pragma once
+
+#include "paddle/phi/backends/all_context.h"
+#include "paddle/phi/core/dense_tensor.h"
+
+namespace phi {
+namespace funcs {
+
+// The number of values sharing one scale in the int8 compression.
+constexpr int64_t kActivationCompressBlock = 256;
+
+// The compressed forms of the activations saved for the backward.
+
+// Packs whether each value of in is positive into the bits of out, the
+// value i at the bit i % 8 of the byte i / 8.
+template <typename Context, typename T>
+class PackBitMaskFunctor {
+ public:
+  void operator()(const Context &ctx, const DenseTensor &in, DenseTensor *out);
+};
+
+// Sets each value of out, already resized, to 1 or 0 by its bit in in.
+template <typename Context, typename T>
+class UnpackBitMaskFunctor {
+ public:
+  void operator()(const Context &ctx, const DenseTensor &in, DenseTensor *out);
+};
+
+// Quantizes each kActivationCompressBlock values of in to int8, with the
+// scale max(|x|) / 127 of the block.
+template <typename Context, typename T>
+class BlockQuantInt8Functor {
+ public:
+  void operator()(const Context &ctx,
+                  const DenseTensor &in,
+                  DenseTensor *out,
+                  DenseTensor *scale);
+};
+
+// out, already resized, = in * the scale of the block.
+template <typename Context, typename T>
+class BlockDequantInt8Functor {
+ public:
+  void operator()(const Context &ctx,
+                  const DenseTensor &in,
+                  const DenseTensor &scale,
+                  DenseTensor *out);
+};
+
+}  // namespace funcs
+}  // namespace phi
@@ -36,6 +36,7 @@ struct BroadcastTypeClassifier {
   int64_t numel{0};
   int broadcast_num{0};              // Not used for XPU
   bool all_elementwise{true};        // Not used for XPU
+  bool has_strided_input{false};     // Not used for XPU
   Array<bool, Arity> use_broadcast;  // Not used for XPU
   Array<kps::details::BroadcastConfig, Arity> configs;
   Array<const _ptr_ char *__restrict__, Arity> ins_data;
@@ -50,13 +51,16 @@ struct BroadcastTypeClassifier {
 #ifndef PADDLE_WITH_XPU_KP
     for (size_t i = 0; i < ins.size(); ++i) {
       bool is_same_dim = ins[i]->numel() == numel;
-      if (is_same_dim) {
+      // a non-contiguous input is read by its strides like a broadcast one
+      bool is_strided = !ins[i]->meta().is_contiguous();
+      if (is_same_dim && !is_strided) {
         use_broadcast[i] = false;
       } else {
         use_broadcast[i] = true;
         broadcast_num++;
       }
-      all_elementwise &= is_same_dim;
+      all_elementwise &= is_same_dim && !is_strided;
+      has_strided_input |= is_strided;
     }
 #endif
 
@@ -90,7 +94,9 @@ struct BroadcastTypeClassifier {
                                                dims_simplifier.in_dims[0],
                                                dims_simplifier.rank);
 #else
-    if (!all_elementwise) {
+    if (has_strided_input) {
+      InitStridedConfigs(ins, outs, axis);
+    } else if (!all_elementwise) {
       const auto dims_simplifier =
           BroadcastDimsSimplifier(ins, (*outs)[0]->dims(), axis);
       if (VLOG_IS_ON(6)) {
@@ -110,6 +116,37 @@ struct BroadcastTypeClassifier {
     }
 #endif
   }
+
+#ifndef PADDLE_WITH_XPU_KP
+  // The dims are not merged as the strides of the views may not allow it,
+  // the dims of an input are aligned to the output from axis if its rank is
+  // smaller, and the broadcast dims have the stride of 0.
+  void InitStridedConfigs(const std::vector<const DenseTensor *> &ins,
+                          std::vector<DenseTensor *> *outs,
+                          int axis) {
+    const auto &out_dims = (*outs)[0]->dims();
+    const int rank = out_dims.size();
+    // if data shape is[m, n], then you should set data_dim = {n, m}
+    std::vector<int64_t> reversed_out_dims(rank);
+    for (int d = 0; d < rank; ++d) {
+      reversed_out_dims[d] = out_dims[rank - 1 - d];
+    }
+    for (int i = 0; i < Arity; ++i) {
+      const auto &in_dims = ins[i]->dims();
+      const auto &in_strides = ins[i]->strides();
+      const int in_rank = in_dims.size();
+      const int offset = in_rank == rank ? 0 : axis;
+      std::vector<int64_t> reversed_strides(rank, 0);
+      for (int d = 0; d < in_rank; ++d) {
+        if (in_dims[d] != 1) {
+          reversed_strides[rank - 1 - (d + offset)] = in_strides[d];
+        }
+      }
+      configs[i] = kps::details::BroadcastConfig::FromStrides(
+          reversed_out_dims, reversed_strides, rank);
+    }
+  }
+#endif
 };
 
 // Common broadcast/elementwise Loader.
@@ -14,6 +14,8 @@ limitations under the License. */
 
 #pragma once
 
+#include <limits>
+
 #include "paddle/phi/backends/all_context.h"
 #include "paddle/phi/common/transform.h"
 #include "paddle/phi/core/dense_tensor.h"
@@ -441,6 +443,77 @@ void ElementwiseCompute(const CPUContext &dev_ctx,
   }
 }
 
+// Returns whether the inputs can be read by their strides in the GPU
+// BroadcastKernel, i.e. the elements they span and the output can be indexed
+// in 32 bits.
+inline bool IsBroadcastIndexableByStrides(
+    const std::vector<const DenseTensor *> &ins, const DenseTensor &out) {
+  if (out.numel() >= std::numeric_limits<int32_t>::max()) {
+    return false;
+  }
+  for (auto *in : ins) {
+    int64_t max_offset = 0;
+    for (int d = 0; d < in->dims().size(); ++d) {
+      max_offset += (in->dims()[d] - 1) * in->strides()[d];
+    }
+    if (max_offset >= std::numeric_limits<uint32_t>::max()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Computes the binary calculation on the inputs read by their strides, e.g.
+// the transposed or sliced views, without making them contiguous. The inputs
+// are aligned to the contiguous output from axis like ElementwiseCompute, and
+// either of them can be broadcast, so there is no need of XxxInverseFunctor.
+template <typename Functor, typename T, typename OutType = T>
+void StridedElementwiseCompute(const CPUContext &dev_ctx,
+                               const DenseTensor &x,
+                               const DenseTensor &y,
+                               Functor func,
+                               DenseTensor *z,
+                               int axis = -1) {
+  OutType *z_data = dev_ctx.Alloc<OutType>(z);
+  const auto &z_dims = z->dims();
+  const int rank = z_dims.size();
+  axis = (axis == -1 ? std::abs(x.dims().size() - y.dims().size()) : axis);
+  // the strides of an input for the dims of the output, 0 if broadcast
+  auto get_aligned_strides = [&](const DenseTensor &in) {
+    std::vector<int64_t> strides(rank, 0);
+    const int offset = in.dims().size() == rank ? 0 : axis;
+    for (int d = 0; d < in.dims().size(); ++d) {
+      if (in.dims()[d] != 1) {
+        strides[d + offset] = in.strides()[d];
+      }
+    }
+    return strides;
+  };
+  const auto x_strides = get_aligned_strides(x);
+  const auto y_strides = get_aligned_strides(y);
+  const T *x_data = x.data<T>();
+  const T *y_data = y.data<T>();
+
+  std::vector<int64_t> index(rank, 0);
+  int64_t x_offset = 0;
+  int64_t y_offset = 0;
+  const int64_t numel = z->numel();
+  for (int64_t i = 0; i < numel; ++i) {
+    z_data[i] = func(x_data[x_offset], y_data[y_offset]);
+    // step the last dim and carry to the previous dims
+    for (int d = rank - 1; d >= 0; --d) {
+      if (++index[d] < z_dims[d]) {
+        x_offset += x_strides[d];
+        y_offset += y_strides[d];
+        break;
+      }
+      x_offset -= (z_dims[d] - 1) * x_strides[d];
+      y_offset -= (z_dims[d] - 1) * y_strides[d];
+      index[d] = 0;
+    }
+  }
+}
+
 // for broadcast backwards
 static inline std::vector<int> GetReduceDim(const DDim &in,
                                             const DDim &out,
@@ -14,8 +14,18 @@
 
 #pragma once
 
+#ifdef PADDLE_WITH_HIP
+#include <hipcub/hipcub.hpp>
+namespace cub = hipcub;
+#else
+#include <cub/cub.cuh>
+#endif
+
 #include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/backends/gpu/gpu_helper.h"
+#include "paddle/phi/backends/gpu/gpu_launch_config.h"
 #include "paddle/phi/common/amp_type_traits.h"
+#include "paddle/phi/common/memory_utils.h"
 
 namespace phi {
 namespace funcs {
@@ -163,5 +173,184 @@ void LaunchEmbeddingGradDeterministicKernel(const GPUContext& ctx,
   }
 }
 
+// The sorted rows summed by one block of EmbeddingGradSortedChunkKernel.
+constexpr int64_t kEmbeddingGradRowsPerChunk = 32;
+
+// Whether the run of ids ending at end - 1 goes on after end.
+template <typename IdT>
+__device__ __forceinline__ bool EmbeddingGradRunContinues(
+    const IdT* sorted_ids, const int64_t end, const int64_t K) {
+  return end < K && sorted_ids[end] == sorted_ids[end - 1];
+}
+
+template <typename IndexT>
+__global__ void EmbeddingGradPositions(IndexT* positions, const IndexT K) {
+  CUDA_KERNEL_LOOP_TYPE(i, K, IndexT) { positions[i] = i; }
+}
+
+// Each block sums the rows of a chunk of the ids sorted with their positions,
+// one thread per feature, so that the rows of an id are summed in the order
+// of their positions and each row of the table is written once, without
+// atomics. The run of ids continued from the previous chunk is saved to head
+// and the run continued into the next chunk is saved to tail, for
+// EmbeddingGradMergeChunksKernel.
+template <typename T, typename MT, typename IdT>
+__global__ void EmbeddingGradSortedChunkKernel(T* table,
+                                               const T* output,
+                                               const IdT* sorted_ids,
+                                               const int64_t* sorted_pos,
+                                               MT* head,
+                                               MT* tail,
+                                               const int64_t N,
+                                               const int64_t K,
+                                               const int64_t D) {
+  const int64_t chunk = blockIdx.x;
+  const int64_t feature =
+      static_cast<int64_t>(blockIdx.y) * blockDim.x + threadIdx.x;
+  if (feature >= D) {
+    return;
+  }
+  const int64_t begin = chunk * kEmbeddingGradRowsPerChunk;
+  const int64_t end = min(begin + kEmbeddingGradRowsPerChunk, K);
+  const bool continued =
+      begin > 0 && sorted_ids[begin] == sorted_ids[begin - 1];
+  const bool continues = EmbeddingGradRunContinues(sorted_ids, end, K);
+
+  MT sum = static_cast<MT>(0);
+  for (int64_t i = begin; i < end; ++i) {
+    sum += static_cast<MT>(output[sorted_pos[i] * D + feature]);
+    if (i + 1 < end && sorted_ids[i + 1] == sorted_ids[i]) {
+      continue;
+    }
+    const auto id = static_cast<int64_t>(sorted_ids[i]);
+    if (continued && sorted_ids[i] == sorted_ids[begin]) {
+      head[chunk * D + feature] = sum;
+    } else if (continues && i + 1 == end) {
+      tail[chunk * D + feature] = sum;
+    } else if (id >= 0 && id < N) {
+      table[id * D + feature] = static_cast<T>(sum);
+    }
+    sum = static_cast<MT>(0);
+  }
+}
+
+// The chunk which opens a run continued into the next chunks adds the heads
+// of those chunks to its tail in order, and writes the row of the run.
+template <typename T, typename MT, typename IdT>
+__global__ void EmbeddingGradMergeChunksKernel(T* table,
+                                               const IdT* sorted_ids,
+                                               const MT* head,
+                                               const MT* tail,
+                                               const int64_t N,
+                                               const int64_t K,
+                                               const int64_t D) {
+  const int64_t chunk = blockIdx.x;
+  const int64_t feature =
+      static_cast<int64_t>(blockIdx.y) * blockDim.x + threadIdx.x;
+  if (feature >= D) {
+    return;
+  }
+  const int64_t begin = chunk * kEmbeddingGradRowsPerChunk;
+  int64_t end = min(begin + kEmbeddingGradRowsPerChunk, K);
+  if (!EmbeddingGradRunContinues(sorted_ids, end, K)) {
+    return;
+  }
+  const IdT id = sorted_ids[end - 1];
+  if (begin > 0 && sorted_ids[begin - 1] == id) {
+    // The whole chunk is in a run opened by a previous chunk.
+    return;
+  }
+  MT sum = tail[chunk * D + feature];
+  for (int64_t next = chunk + 1;; ++next) {
+    sum += head[next * D + feature];
+    end = min(end + kEmbeddingGradRowsPerChunk, K);
+    if (!EmbeddingGradRunContinues(sorted_ids, end, K)) {
+      break;
+    }
+  }
+  if (id >= 0 && id < N) {
+    table[static_cast<int64_t>(id) * D + feature] = static_cast<T>(sum);
+  }
+}
+
+// The deterministic embedding grad which sorts the ids and sums the rows of
+// each id as a segment, so that its cost does not grow with the repeats of
+// the ids. The table should be zeroed, the rows of the ids not in [0, N) are
+// skipped.
+template <typename T, typename IdT>
+void LaunchEmbeddingGradSortedKernel(const GPUContext& ctx,
+                                     const IdT* ids,
+                                     const T* d_out,
+                                     T* d_table,
+                                     int64_t N,
+                                     int64_t D,
+                                     int64_t K) {
+  using MT = typename dtype::MPTypeTrait<T>::Type;
+  if (K == 0 || D == 0) {
+    return;
+  }
+  auto stream = ctx.stream();
+  auto alloc = [&](size_t size) {
+    return phi::memory_utils::Alloc(
+        ctx.GetPlace(), size, phi::Stream(reinterpret_cast<StreamId>(stream)));
+  };
+  auto positions = alloc(2 * K * sizeof(int64_t));
+  auto sorted_ids = alloc(K * sizeof(IdT));
+  int64_t* pos_in = reinterpret_cast<int64_t*>(positions->ptr());
+  int64_t* pos_out = pos_in + K;
+  IdT* ids_out = reinterpret_cast<IdT*>(sorted_ids->ptr());
+
+  auto config = phi::backends::gpu::GetGpuLaunchConfig1D(ctx, K);
+  EmbeddingGradPositions<int64_t><<<config.block_per_grid.x,
+                                    config.thread_per_block.x,
+                                    0,
+                                    stream>>>(pos_in, K);
+
+  // The radix sort is stable and only needs the bits of the ids in [0, N).
+  int end_bit = 1;
+  while (end_bit < static_cast<int>(sizeof(IdT) * 8) &&
+         (static_cast<uint64_t>(1) << end_bit) < static_cast<uint64_t>(N)) {
+    ++end_bit;
+  }
+  size_t temp_size = 0;
+  PADDLE_ENFORCE_GPU_SUCCESS(
+      cub::DeviceRadixSort::SortPairs(nullptr,
+                                      temp_size,
+                                      ids,
+                                      ids_out,
+                                      pos_in,
+                                      pos_out,
+                                      K,
+                                      0,
+                                      end_bit,
+                                      stream));
+  auto temp_storage = alloc(temp_size);
+  PADDLE_ENFORCE_GPU_SUCCESS(
+      cub::DeviceRadixSort::SortPairs(temp_storage->ptr(),
+                                      temp_size,
+                                      ids,
+                                      ids_out,
+                                      pos_in,
+                                      pos_out,
+                                      K,
+                                      0,
+                                      end_bit,
+                                      stream));
+
+  const int64_t num_chunks =
+      (K + kEmbeddingGradRowsPerChunk - 1) / kEmbeddingGradRowsPerChunk;
+  auto partials = alloc(2 * num_chunks * D * sizeof(MT));
+  MT* head = reinterpret_cast<MT*>(partials->ptr());
+  MT* tail = head + num_chunks * D;
+  const int threads =
+      static_cast<int>(std::min<int64_t>(256, (D + 31) / 32 * 32));
+  dim3 grids(static_cast<unsigned int>(num_chunks),
+             static_cast<unsigned int>((D + threads - 1) / threads));
+  EmbeddingGradSortedChunkKernel<T, MT, IdT><<<grids, threads, 0, stream>>>(
+      d_table, d_out, ids_out, pos_out, head, tail, N, K, D);
+  EmbeddingGradMergeChunksKernel<T, MT, IdT><<<grids, threads, 0, stream>>>(
+      d_table, ids_out, head, tail, N, K, D);
+}
+
 }  // namespace funcs
 }  // namespace phi
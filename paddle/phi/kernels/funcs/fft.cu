@@ -18,6 +18,7 @@
 #include "paddle/phi/kernels/funcs/fft_cache.h"
 
 #include "paddle/common/ddim.h"
+#include "paddle/common/flags.h"
 #include "paddle/phi/backends/gpu/gpu_context.h"
 #include "paddle/phi/kernels/assign_kernel.h"
 #include "paddle/phi/kernels/complex_kernel.h"
@@ -25,6 +26,8 @@
 #include "paddle/phi/kernels/scale_kernel.h"
 #include "paddle/phi/kernels/transpose_kernel.h"
 
+COMMON_DECLARE_bool(fft_plan_batch_bucketing);
+
 namespace phi {
 namespace funcs {
 namespace detail {
@@ -106,6 +109,57 @@ inline bool use_cache(const int64_t* signal_size) {
 inline bool use_cache(const int64_t* signal_size) { return true; }
 #endif
 
+// The largest power of two not above the batch size
+static int64_t plan_batch_bucket(int64_t batch_size) {
+  int64_t bucket = 1;
+  while (bucket <= batch_size / 2) {
+    bucket *= 2;
+  }
+  return bucket;
+}
+
+// Runs the transform of the key on the data, with the plan from the cache of
+// the device, or with a temporary plan if the cache can not be used.
+static void exec_fft_plan(const phi::GPUContext& ctx,
+                          const FFTConfigKey& key,
+                          void* in_data,
+                          void* out_data,
+                          bool forward) {
+  int64_t device_id = ctx.GetPlace().GetDeviceId();
+  FFTConfig* config = nullptr;
+  std::unique_ptr<FFTConfig> config_ = nullptr;
+  bool using_cache = use_cache(key.sizes_);
+
+  if (using_cache) {
+    FFTConfigCache& plan_cache = get_fft_plan_cache(device_id);
+    std::unique_lock<std::mutex> guard(plan_cache.mutex, std::defer_lock);
+    guard.lock();
+    config = &(plan_cache.lookup(key));
+  } else {
+    config_ = std::make_unique<FFTConfig>(key);
+    config = config_.get();
+  }
+
+  // the workspace comes from the allocator, so it is shared by all the plans
+  const int64_t workspace_size = static_cast<int64_t>(config->workspace_size());
+  DenseTensor workspace_tensor = Empty<uint8_t>(ctx, {workspace_size});
+
+  // prepare cufft for execution
+#if defined(PADDLE_WITH_CUDA)
+  PADDLE_ENFORCE_GPU_SUCCESS(
+      phi::dynload::cufftSetStream(config->plan(), ctx.stream()));
+  PADDLE_ENFORCE_GPU_SUCCESS(
+      phi::dynload::cufftSetWorkArea(config->plan(), workspace_tensor.data()));
+#elif defined(PADDLE_WITH_HIP)
+  PADDLE_ENFORCE_GPU_SUCCESS(
+      phi::dynload::hipfftSetStream(config->plan(), ctx.stream()));
+  PADDLE_ENFORCE_GPU_SUCCESS(
+      phi::dynload::hipfftSetWorkArea(config->plan(), workspace_tensor.data()));
+#endif
+
+  exec_plan(*config, in_data, out_data, forward);
+}
+
 // up to 3d unnormalized fft transform (c2r, r2c, c2c)
 template <typename Ti, typename To>
 void exec_fft(const phi::GPUContext& ctx,
@@ -169,48 +223,44 @@ void exec_fft(const phi::GPUContext& ctx,
 
   FFTConfigKey key =
       create_fft_configkey(collapsed_input, collapsed_output, signal_ndim);
-  int64_t device_id = ctx.GetPlace().GetDeviceId();
-  FFTConfig* config = nullptr;
-  std::unique_ptr<FFTConfig> config_ = nullptr;
-  bool using_cache = use_cache(key.sizes_);
-
-  if (using_cache) {
-    FFTConfigCache& plan_cache = get_fft_plan_cache(device_id);
-    std::unique_lock<std::mutex> guard(plan_cache.mutex, std::defer_lock);
-    guard.lock();
-    config = &(plan_cache.lookup(key));
-  } else {
-    config_ = std::make_unique<FFTConfig>(key);
-    config = config_.get();
-  }
-
-  const int64_t workspace_size = static_cast<int64_t>(config->workspace_size());
-  DenseTensor workspace_tensor = Empty<uint8_t>(ctx, {workspace_size});
-
-  // prepare cufft for execution
-#if defined(PADDLE_WITH_CUDA)
-  PADDLE_ENFORCE_GPU_SUCCESS(
-      phi::dynload::cufftSetStream(config->plan(), ctx.stream()));
-  PADDLE_ENFORCE_GPU_SUCCESS(
-      phi::dynload::cufftSetWorkArea(config->plan(), workspace_tensor.data()));
-#elif defined(PADDLE_WITH_HIP)
-  PADDLE_ENFORCE_GPU_SUCCESS(
-      phi::dynload::hipfftSetStream(config->plan(), ctx.stream()));
-  PADDLE_ENFORCE_GPU_SUCCESS(
-      phi::dynload::hipfftSetWorkArea(config->plan(), workspace_tensor.data()));
-#endif
-
-  // execution of fft plan
-  const FFTTransformType fft_type = config->transform_type();
+  const FFTTransformType fft_type = key.fft_type_;
   if (fft_type == FFTTransformType::C2R && forward) {
     ConjKernel<Ti, phi::GPUContext>(ctx, collapsed_input, &collapsed_input);
-    exec_plan(*config, collapsed_input.data(), collapsed_output.data(), false);
-  } else if (fft_type == FFTTransformType::R2C && !forward) {
-    exec_plan(*config, collapsed_input.data(), collapsed_output.data(), true);
+  }
+  // NOTE: R2C is forward-only and C2R backward-only, the other directions
+  // are computed with the conj of the input or the output
+  const bool exec_forward = fft_type == FFTTransformType::C2R   ? false
+                            : fft_type == FFTTransformType::R2C ? true
+                                                                : forward;
+
+  // Every batch size needs a plan of its own. With the bucketing, the plans
+  // are made for the power-of-two batch sizes only and the batch is run as
+  // chunks of them, so that the varying batches reuse a few plans.
+  const int64_t num_signals = std::max<int64_t>(batch_size, 1);
+  const int64_t in_numel = collapsed_input.numel() / num_signals;
+  const int64_t out_numel = collapsed_output.numel() / num_signals;
+  Ti* in_data = collapsed_input.data<Ti>();
+  To* out_data = collapsed_output.data<To>();
+  int64_t offset = 0;
+  do {
+    int64_t chunk = batch_size - offset;
+    if (FLAGS_fft_plan_batch_bucketing) {
+      chunk = plan_batch_bucket(chunk);
+    }
+    FFTConfigKey chunk_key = key;
+    chunk_key.sizes_[0] = chunk;
+    chunk_key.input_shape_[0] = chunk;
+    chunk_key.output_shape_[0] = chunk;
+    exec_fft_plan(ctx,
+                  chunk_key,
+                  in_data + offset * in_numel,
+                  out_data + offset * out_numel,
+                  exec_forward);
+    offset += chunk;
+  } while (offset < batch_size);
+
+  if (fft_type == FFTTransformType::R2C && !forward) {
     ConjKernel<To, phi::GPUContext>(ctx, collapsed_output, &collapsed_output);
-  } else {
-    exec_plan(
-        *config, collapsed_input.data(), collapsed_output.data(), forward);
   }
 
   // resize for the collapsed output
@@ -227,6 +277,18 @@ void exec_fft(const phi::GPUContext& ctx,
 }
 }  // namespace detail
 
+FFTPlanCacheStats GetFFTPlanCacheStats(int64_t device_id) {
+  detail::FFTConfigCache& plan_cache = detail::get_fft_plan_cache(device_id);
+  std::lock_guard<std::mutex> guard(plan_cache.mutex);
+  FFTPlanCacheStats stats;
+  stats.size = plan_cache.size();
+  stats.max_size = plan_cache.max_size();
+  stats.hits = plan_cache.hits();
+  stats.misses = plan_cache.misses();
+  stats.evictions = plan_cache.evictions();
+  return stats;
+}
+
 template <typename Ti, typename To>
 struct FFTC2CFunctor<phi::GPUContext, Ti, To> {
   void operator()(const phi::GPUContext& ctx,
@@ -99,5 +99,18 @@ struct FFTC2RFunctor {
                   FFTNormMode normalization,
                   bool forward);
 };
+
+struct FFTPlanCacheStats {
+  size_t size = 0;
+  size_t max_size = 0;
+  size_t hits = 0;
+  size_t misses = 0;
+  size_t evictions = 0;
+};
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+// Returns the statistics of the cuFFT (hipFFT) plan cache of a device.
+FFTPlanCacheStats GetFFTPlanCacheStats(int64_t device_id);
+#endif
 }  // namespace funcs
 }  // namespace phi
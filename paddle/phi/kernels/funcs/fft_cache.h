@@ -71,12 +71,18 @@ class FFTConfigCache {
   FFTConfigCache(FFTConfigCache&& other) noexcept
       : _usage_list(std::move(other._usage_list)),
         _cache_map(std::move(other._cache_map)),
-        _max_size(other._max_size) {}
+        _max_size(other._max_size),
+        _hits(other._hits),
+        _misses(other._misses),
+        _evictions(other._evictions) {}
 
   FFTConfigCache& operator=(FFTConfigCache&& other) noexcept {
     _usage_list = std::move(other._usage_list);
     _cache_map = std::move(other._cache_map);
     _max_size = other._max_size;
+    _hits = other._hits;
+    _misses = other._misses;
+    _evictions = other._evictions;
     return *this;
   }
 
@@ -93,13 +99,16 @@ class FFTConfigCache {
     map_kkv_iter_t map_it = _cache_map.find(params);
     // Hit, put to list front
     if (map_it != _cache_map.end()) {
+      ++_hits;
       _usage_list.splice(_usage_list.begin(), _usage_list, map_it->second);
       return map_it->second->second;
     }
 
     // Miss
+    ++_misses;
     // remove if needed
     if (_usage_list.size() >= _max_size) {
+      ++_evictions;
       auto last = _usage_list.end();
       last--;
       _cache_map.erase(last->first);
@@ -128,6 +137,7 @@ class FFTConfigCache {
     if (cur_size > _max_size) {
       auto delete_it = _usage_list.end();
       for (size_t i = 0; i < cur_size - _max_size; i++) {
+        ++_evictions;
         delete_it--;
         _cache_map.erase(delete_it->first);
       }
@@ -139,6 +149,12 @@ class FFTConfigCache {
 
   size_t max_size() const noexcept { return _max_size; }
 
+  // The lookups served from the cache, the plans made on a miss and the plans
+  // dropped to keep the cache within its max size.
+  size_t hits() const noexcept { return _hits; }
+  size_t misses() const noexcept { return _misses; }
+  size_t evictions() const noexcept { return _evictions; }
+
   std::mutex mutex;
 
  private:
@@ -166,6 +182,9 @@ class FFTConfigCache {
   std::list<kv_t> _usage_list;
   map_t _cache_map;
   size_t _max_size;
+  size_t _hits = 0;
+  size_t _misses = 0;
+  size_t _evictions = 0;
 };
 
 static std::vector<std::unique_ptr<FFTConfigCache>> plan_caches;
@@ -16,6 +16,7 @@ limitations under the License. */
 #pragma once
 
 #include <algorithm>
+#include <cstring>
 #include <mutex>
 #include <unordered_map>
 
@@ -41,6 +42,7 @@ limitations under the License. */
 #include "paddle/phi/core/dense_tensor.h"
 #include "paddle/phi/core/enforce.h"
 #include "paddle/phi/core/scope_guard.h"
+#include "paddle/phi/kernels/autotune/cache.h"
 #include "paddle/utils/optional.h"
 #if defined(PADDLE_WITH_CUDA) && CUDA_VERSION >= 11060
 #include "paddle/phi/backends/dynload/cublasLt.h"
@@ -89,8 +91,6 @@ class GemmEpilogueAlgoCache {
                                         gpuStream_t stream,
                                         void* workspace,
                                         size_t workspace_size) {
-    if (search_times_ <= 0) return nullptr;
-
     int64_t seed = 0;
     std::hash<int64_t> hash_fn;
 
@@ -108,6 +108,22 @@ class GemmEpilogueAlgoCache {
       }
     }
 
+    // The algorithms tuned by other processes are taken from the autotune
+    // cache file, even if the search is disabled in this one.
+    auto& autotune_cache =
+        phi::autotune::AutoTuneCache::Instance().GetGemmEpilogue();
+    auto key = static_cast<size_t>(seed);
+    if (autotune_cache.Find(key)) {
+      auto words = autotune_cache.Get(key);
+      std::memcpy(&ret, words.data(), sizeof(ret));
+      std::lock_guard<std::mutex> lock(cache_mutex_);
+      auto& algo_in_map = map_[seed];
+      algo_in_map = ret;
+      return &algo_in_map;
+    }
+
+    if (search_times_ <= 0) return nullptr;
+
     GPU(blasLtMatmulPreference_t) preference;
     PADDLE_ENFORCE_GPU_SUCCESS(
         phi::dynload::GPU(blasLtMatmulPreferenceCreate)(&preference));
@@ -141,6 +157,25 @@ class GemmEpilogueAlgoCache {
     PADDLE_ENFORCE_GPU_SUCCESS(
         phi::dynload::GPU(blasLtMatmulPreferenceDestroy)(preference));
 
+    std::vector<GPU(blasLtMatmulAlgo_t)> candidates;
+    for (int algo_idx = 0; algo_idx < returned_results; ++algo_idx) {
+      candidates.push_back(heuristic_results[algo_idx].algo);
+    }
+#ifdef PADDLE_WITH_CUDA
+    for (int algo_idx = 0;
+         algo_idx < std::min(returned_results, splitk_algo_count_);
+         ++algo_idx) {
+      AppendSplitKVariants_(lt_handle,
+                            op_desc,
+                            a_desc,
+                            b_desc,
+                            c_desc,
+                            heuristic_results[algo_idx].algo,
+                            workspace_size,
+                            &candidates);
+    }
+#endif
+
     int best_algo_idx = -1;
     float best_algo_time = 0;
 
@@ -184,7 +219,8 @@ class GemmEpilogueAlgoCache {
     PADDLE_ENFORCE_GPU_SUCCESS(cudaEventCreate(&stop_event));
 #endif
 
-    for (int algo_idx = 0; algo_idx < returned_results; ++algo_idx) {
+    int num_candidates = static_cast<int>(candidates.size());
+    for (int algo_idx = 0; algo_idx < num_candidates; ++algo_idx) {
       float curr_time = 0;
       for (int check_idx = 0; check_idx < search_times_; check_idx++) {
         float time = 0;
@@ -204,7 +240,7 @@ class GemmEpilogueAlgoCache {
                                             c_desc,
                                             c,
                                             c_desc,
-                                            &heuristic_results[algo_idx].algo,
+                                            &candidates[algo_idx],
                                             workspace,
                                             workspace_size,
                                             stream);
@@ -240,10 +276,15 @@ class GemmEpilogueAlgoCache {
           common::errors::Unavailable("No GEMM epilogue algorithm support!"));
     }
 
-    ret = heuristic_results[best_algo_idx].algo;
+    ret = candidates[best_algo_idx];
 
     VLOG(4) << "Search time:" << search_times_ << ", hash-key (" << seed
-            << ") not found in GemmEpilogueAlgoCache";
+            << ") not found in GemmEpilogueAlgoCache, best of "
+            << num_candidates << " candidates: " << best_algo_idx;
+
+    phi::autotune::BlasLtAlgo words = {};
+    std::memcpy(words.data(), &ret, sizeof(ret));
+    autotune_cache.Set(key, words);
 
     std::lock_guard<std::mutex> lock(cache_mutex_);
     auto& algo_in_map = map_[seed];
@@ -256,11 +297,88 @@ class GemmEpilogueAlgoCache {
       : search_times_(search_times) {
     map_.clear();
   }
+  static_assert(sizeof(GPU(blasLtMatmulAlgo_t)) <=
+                    sizeof(phi::autotune::BlasLtAlgo),
+                "The blasLt algo does not fit the autotune cache.");
+
   std::unordered_map<int64_t, GPU(blasLtMatmulAlgo_t)> map_;
   int search_times_;
   const int requested_algo_count_ = 10;
+  // The number of the top heuristic algorithms whose split-K variants are
+  // also measured.
+  const int splitk_algo_count_ = 3;
   std::mutex cache_mutex_;
 
+#ifdef PADDLE_WITH_CUDA
+  void AppendSplitKVariants_(cublasLtHandle_t lt_handle,
+                             cublasLtMatmulDesc_t op_desc,
+                             cublasLtMatrixLayout_t a_desc,
+                             cublasLtMatrixLayout_t b_desc,
+                             cublasLtMatrixLayout_t c_desc,
+                             const cublasLtMatmulAlgo_t& algo,
+                             size_t workspace_size,
+                             std::vector<cublasLtMatmulAlgo_t>* candidates) {
+    size_t size_to_write;
+    int32_t splitk_support = 0;
+    uint32_t reduction_mask = 0;
+    PADDLE_ENFORCE_GPU_SUCCESS(phi::dynload::cublasLtMatmulAlgoCapGetAttribute(
+        &algo,
+        CUBLASLT_ALGO_CAP_SPLITK_SUPPORT,
+        &splitk_support,
+        sizeof(splitk_support),
+        &size_to_write));
+    PADDLE_ENFORCE_GPU_SUCCESS(phi::dynload::cublasLtMatmulAlgoCapGetAttribute(
+        &algo,
+        CUBLASLT_ALGO_CAP_REDUCTION_SCHEME_MASK,
+        &reduction_mask,
+        sizeof(reduction_mask),
+        &size_to_write));
+    if (!splitk_support || reduction_mask == 0) return;
+
+    uint32_t reduction_scheme = CUBLASLT_REDUCTION_SCHEME_NONE;
+    for (uint32_t scheme : {CUBLASLT_REDUCTION_SCHEME_COMPUTE_TYPE,
+                            CUBLASLT_REDUCTION_SCHEME_OUTPUT_TYPE,
+                            CUBLASLT_REDUCTION_SCHEME_INPLACE}) {
+      if (reduction_mask & scheme) {
+        reduction_scheme = scheme;
+        break;
+      }
+    }
+    if (reduction_scheme == CUBLASLT_REDUCTION_SCHEME_NONE) return;
+
+    for (int32_t splitk : {2, 4, 8, 16}) {
+      cublasLtMatmulAlgo_t variant = algo;
+      PADDLE_ENFORCE_GPU_SUCCESS(
+          phi::dynload::cublasLtMatmulAlgoConfigSetAttribute(
+              &variant,
+              CUBLASLT_ALGO_CONFIG_SPLITK_NUM,
+              &splitk,
+              sizeof(splitk)));
+      PADDLE_ENFORCE_GPU_SUCCESS(
+          phi::dynload::cublasLtMatmulAlgoConfigSetAttribute(
+              &variant,
+              CUBLASLT_ALGO_CONFIG_REDUCTION_SCHEME,
+              &reduction_scheme,
+              sizeof(reduction_scheme)));
+      // The variants which do not support the problem or need a larger
+      // workspace are skipped.
+      cublasLtMatmulHeuristicResult_t result;
+      auto status = phi::dynload::cublasLtMatmulAlgoCheck(lt_handle,
+                                                          op_desc,
+                                                          a_desc,
+                                                          b_desc,
+                                                          c_desc,
+                                                          c_desc,
+                                                          &variant,
+                                                          &result);
+      if (status == CUBLAS_STATUS_SUCCESS &&
+          result.workspaceSize <= workspace_size) {
+        candidates->push_back(variant);
+      }
+    }
+  }
+#endif
+
   void HashMatmulDesc_(GPU(blasLtMatmulDesc_t) desc,
                        int64_t* seed,
                        const std::hash<int64_t>& hash_fn) {
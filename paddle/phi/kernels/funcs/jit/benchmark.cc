@@ -426,6 +426,22 @@ void BenchKernelLayerNorm() {
   }
 }
 
+template <typename KernelTuple, typename PlaceType>
+void BenchKernelSoftmax() {
+  using T = typename KernelTuple::data_type;
+  for (int bs : {1, 2, 10}) {
+    for (int n : TestSizes()) {
+      phi::DenseTensor x, y;
+      x.Resize({bs, n});
+      y.Resize({bs, n});
+      RandomVec<T>(bs * n, x.mutable_data<T>(PlaceType()), -2.f, 2.f);
+      const T* x_data = x.data<T>();
+      T* y_data = y.mutable_data<T>(PlaceType());
+      BenchAllImpls<KernelTuple, PlaceType>(n, x_data, y_data, n, bs);
+    }
+  }
+}
+
 template <typename KernelTuple, typename PlaceType>
 void BenchKernelCRFDecoding() {
   using T = typename KernelTuple::data_type;
@@ -475,6 +491,7 @@ void BenchKernelVBroadcast() {
 #define BenchKernelVMul BenchKernelXYZN
 #define BenchKernelVAdd BenchKernelXYZN
 #define BenchKernelVAddRelu BenchKernelXYZN
+#define BenchKernelVAddGelu BenchKernelXYZN
 #define BenchKernelVSub BenchKernelXYZN
 
 #define BenchKernelVScal BenchKernelAXYN
@@ -506,6 +523,7 @@ using CPUPlace = phi::CPUPlace;
 BENCH_FP32_CPU(VMul);
 BENCH_FP32_CPU(VAdd);
 BENCH_FP32_CPU(VAddRelu);
+BENCH_FP32_CPU(VAddGelu);
 BENCH_FP32_CPU(VSub);
 
 // axyn
@@ -531,6 +549,7 @@ BENCH_FP32_CPU(GRUHtPart1);
 BENCH_FP32_CPU(GRUHtPart2);
 
 BENCH_FP32_CPU(LayerNorm);
+BENCH_FP32_CPU(Softmax);
 BENCH_FP32_CPU(CRFDecoding);
 
 BENCH_FP32_CPU(SeqPool);
@@ -37,7 +37,9 @@ const float ALIGN32_BEG exp_float_consts[] ALIGN32_END = {  // NOLINT
     REPEAT_8TIMES(CEPHES_EXP_P5),
     REPEAT_8TIMES(EXP_MAX_INPUT),
     REPEAT_8TIMES(SIGMOID_THRESHOLD_MAX),
-    REPEAT_8TIMES(SIGMOID_THRESHOLD_MIN)};
+    REPEAT_8TIMES(SIGMOID_THRESHOLD_MIN),
+    REPEAT_8TIMES(GELU_TANH_C0),
+    REPEAT_8TIMES(GELU_TANH_C1)};
 
 const int ALIGN32_BEG exp_int_0x7f[] ALIGN32_END = {  // NOLINT
     REPEAT_8TIMES(0x7f)};                             // NOLINT
@@ -78,6 +80,62 @@ void VActJitCode::genCode() {
   ret();
 }
 
+template <typename JMM>
+void VAddGeluJitCode::mainCode(int offset, int block) {
+  JMM jmm_x = JMM(0);
+  JMM jmm_y = JMM(1);
+  JMM jmm_tmp = JMM(2);
+  JMM jmm_dst = JMM(3);
+  // the rest of less than 4 floats use the registers of xmm
+  xmm_t xmm_x = xmm_t(0);
+  xmm_t xmm_y = xmm_t(1);
+  if (block >= XMM_FLOAT_BLOCK) {
+    vmovups(jmm_x, ptr[param1 + reg_offset + offset]);
+    vmovups(jmm_y, ptr[param2 + reg_offset + offset]);
+  } else if (block >= 2) {
+    vmovq(xmm_x, ptr[param1 + reg_offset + offset]);
+    vmovq(xmm_y, ptr[param2 + reg_offset + offset]);
+  } else {
+    vmovss(xmm_x, ptr[param1 + reg_offset + offset]);
+    vmovss(xmm_y, ptr[param2 + reg_offset + offset]);
+  }
+  vaddps(jmm_x, jmm_x, jmm_y);
+  gelu_jmm<JMM>(jmm_dst, jmm_x, jmm_tmp, reg_ptr_consts);
+  xmm_t xmm_dst = xmm_t(jmm_dst.getIdx());
+  if (block >= XMM_FLOAT_BLOCK) {
+    vmovups(ptr[param3 + reg_offset + offset], jmm_dst);
+  } else if (block >= 2) {
+    vmovq(ptr[param3 + reg_offset + offset], xmm_dst);
+  } else {
+    vmovss(ptr[param3 + reg_offset + offset], xmm_dst);
+  }
+}
+
+void VAddGeluJitCode::genCode() {
+  constexpr int block_size = sizeof(float) * YMM_FLOAT_BLOCK;
+  const int num_blocks = num_ / YMM_FLOAT_BLOCK;
+  mov(reg_ptr_consts, reinterpret_cast<size_t>(exp_float_consts));
+  xor_(reg_offset, reg_offset);
+  if (num_blocks > 0) {
+    // loop the blocks, since d is the hidden size of ffn
+    Label l_next_block;
+    L(l_next_block);
+    mainCode<ymm_t>(0, YMM_FLOAT_BLOCK);
+    add(reg_offset, block_size);
+    cmp(reg_offset, num_blocks * block_size);
+    jl(l_next_block, T_NEAR);
+  }
+  int offset = 0;
+  int rest = num_ % YMM_FLOAT_BLOCK;
+  while (rest > 0) {
+    int block = rest >= 4 ? 4 : (rest >= 2 ? 2 : 1);
+    mainCode<xmm_t>(offset, block);
+    offset += sizeof(float) * block;
+    rest -= block;
+  }
+  ret();
+}
+
 #define DECLARE_ACT_CREATOR(name)                                            \
   class name##Creator : public JitCodeCreator<int> {                         \
    public:                                                                   \
@@ -94,6 +152,7 @@ DECLARE_ACT_CREATOR(VIdentity);
 DECLARE_ACT_CREATOR(VExp);
 DECLARE_ACT_CREATOR(VSigmoid);
 DECLARE_ACT_CREATOR(VTanh);
+DECLARE_ACT_CREATOR(VAddGelu);
 
 // TODO(TJ): tuning use me
 bool VReluCreator::CanBeUsed(const int& d) const {
@@ -120,6 +179,10 @@ bool VTanhCreator::CanBeUsed(const int& d) const {
   return phi::backends::cpu::MayIUse(phi::backends::cpu::avx);
 }
 
+bool VAddGeluCreator::CanBeUsed(const int& d) const {
+  return phi::backends::cpu::MayIUse(phi::backends::cpu::avx);
+}
+
 size_t VReluCreator::CodeSize(const int& d) const {
   return 96 /* init size */ + (d / YMM_FLOAT_BLOCK + 3) * 4 /* instructions */ *
                                   8 /* average bytes for each instruction */;
@@ -145,6 +208,10 @@ size_t VTanhCreator::CodeSize(const int& d) const {
   return 96 + (d / YMM_FLOAT_BLOCK + 3) * 84 * 8;
 }
 
+size_t VAddGeluCreator::CodeSize(const int& d) const {
+  return 96 + (4 /* the ymm loop and the rest of xmm */) * 100 * 8;
+}
+
 #undef DECLARE_ACT_CREATOR
 
 }  // namespace phi::jit::gen
@@ -157,3 +224,4 @@ REGISTER_JITKERNEL_GEN(kVIdentity, gen::VIdentityCreator);
 REGISTER_JITKERNEL_GEN(kVExp, gen::VExpCreator);
 REGISTER_JITKERNEL_GEN(kVSigmoid, gen::VSigmoidCreator);
 REGISTER_JITKERNEL_GEN(kVTanh, gen::VTanhCreator);
+REGISTER_JITKERNEL_GEN(kVAddGelu, gen::VAddGeluCreator);
@@ -39,6 +39,8 @@ extern int g_tmp_mem[];
 #define CEPHES_EXP_P3 4.1665795894E-2
 #define CEPHES_EXP_P4 1.6666665459E-1
 #define CEPHES_EXP_P5 5.0000001201E-1
+#define GELU_TANH_C0 0.044715f
+#define GELU_TANH_C1 0.79788456f
 
 #define REPEAT_8TIMES(val) val, val, val, val, val, val, val, val
 
@@ -59,6 +61,8 @@ extern int g_tmp_mem[];
 #define OFFSET_EXP_MAX_INPUT 14 * YMM_FLOAT_BLOCK * sizeof(float)
 #define OFFSET_SIGMOID_MAX 15 * YMM_FLOAT_BLOCK * sizeof(float)
 #define OFFSET_SIGMOID_MIN 16 * YMM_FLOAT_BLOCK * sizeof(float)
+#define OFFSET_GELU_TANH_C0 17 * YMM_FLOAT_BLOCK * sizeof(float)
+#define OFFSET_GELU_TANH_C1 18 * YMM_FLOAT_BLOCK * sizeof(float)
 
 class VActFunc : public JitCode {
  public:
@@ -232,6 +236,30 @@ class VActFunc : public JitCode {
     pop(reg_ptr_global);
   }
 
+  // compute GELU with ymm, xmm, which needs reg_ptr_consts points to
+  // exp_float_consts
+  template <typename JMM>
+  void gelu_jmm(JMM& dst,  // NOLINT
+                JMM& src,  // NOLINT
+                JMM& tmp,  // NOLINT
+                reg64_t reg_ptr_consts,
+                int src_idx = 11,
+                int fx_idx = 12,
+                int fy_idx = 13,
+                int mask_idx = 14,
+                int tmp_idx = 15) {
+    // y = 0.5 * x * (1 + tanh(sqrt(2 / pi) * x * (1 + 0.044715 * x^2)))
+    vmulps(tmp, src, src);
+    vmulps(tmp, tmp, ptr[reg_ptr_consts + OFFSET_GELU_TANH_C0]);
+    vaddps(tmp, tmp, ptr[reg_ptr_consts + OFFSET_EXP_ONE]);
+    vmulps(tmp, tmp, src);
+    vmulps(tmp, tmp, ptr[reg_ptr_consts + OFFSET_GELU_TANH_C1]);
+    tanh_jmm<JMM>(dst, tmp, src_idx, fx_idx, fy_idx, mask_idx, tmp_idx);
+    vaddps(dst, dst, ptr[reg_ptr_consts + OFFSET_EXP_ONE]);
+    vmulps(dst, dst, src);
+    vmulps(dst, dst, ptr[reg_ptr_consts + OFFSET_EXP_0P5]);
+  }
+
   // compute IDENTITY with ymm, xmm
   template <typename JMM>
   void identity_jmm(JMM& dst, JMM& src, int zero_idx) {  // NOLINT
@@ -345,6 +373,30 @@ DECLARE_ACT_JITCODE(VTanh, operand_type::TANH);
 
 #undef DECLARE_ACT_JITCODE
 
+// z = gelu(x + y), the add of a bias and the gelu after the matmul of ffn
+class VAddGeluJitCode : public VActFunc {
+ public:
+  explicit VAddGeluJitCode(int d, size_t code_size, void* code_ptr = nullptr)
+      : VActFunc(code_size, code_ptr), num_(d) {
+    this->genCode();
+  }
+
+  DECLARE_JIT_CODE(VAddGeluJitCode);
+  void genCode() override;
+
+ protected:
+  // computes the block of ymm or the rest of xmm at offset of the params
+  template <typename JMM>
+  void mainCode(int offset, int block);
+
+  int num_;
+  reg64_t param1{abi_param1};
+  reg64_t param2{abi_param2};
+  reg64_t param3{abi_param3};
+  reg64_t reg_ptr_consts{r10};
+  reg64_t reg_offset{r11};
+};
+
 }  // namespace gen
 }  // namespace jit
 }  // namespace phi
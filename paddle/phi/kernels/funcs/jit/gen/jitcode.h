@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <cstring>
 #include <string>
 #include <type_traits>
 
@@ -103,6 +104,36 @@ class JitCode : public GenBase, public Xbyak::CodeGenerator {
   }
   void L(const char* label) { Xbyak::CodeGenerator::L(label); }
   void L(Xbyak::Label& label) { Xbyak::CodeGenerator::L(label); }  // NOLINT
+  // set all the floats of dst to value by tmp, with avx only
+  void broadcast_float(const Xbyak::Ymm& dst,
+                       float value,
+                       const Xbyak::Reg32& tmp) {
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(float));
+    Xbyak::Xmm xmm_dst(dst.getIdx());
+    mov(tmp, bits);
+    vmovd(xmm_dst, tmp);
+    vshufps(xmm_dst, xmm_dst, xmm_dst, 0);
+    vinsertf128(dst, dst, xmm_dst, 1);
+  }
+  // set all the floats of x to the sum (ADD) or max (MAX) of them
+  void reduce_ymm(const Xbyak::Ymm& x,
+                  const Xbyak::Ymm& tmp,
+                  operand_type type) {
+    auto reduce = [&](const Xbyak::Ymm& a, const Xbyak::Ymm& b) {
+      if (type == operand_type::MAX) {
+        vmaxps(a, a, b);
+      } else {
+        vaddps(a, a, b);
+      }
+    };
+    vperm2f128(tmp, x, x, 0x01);
+    reduce(x, tmp);
+    vshufps(tmp, x, x, 0x4E);
+    reduce(x, tmp);
+    vshufps(tmp, x, x, 0xB1);
+    reduce(x, tmp);
+  }
   // Enhanced vector extension
   Xbyak::Address EVEX_compress_addr(Xbyak::Reg64 base,
                                     int offt,
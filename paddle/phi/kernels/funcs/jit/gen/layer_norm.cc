@@ -0,0 +1,152 @@
+/* Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "paddle/phi/kernels/funcs/jit/gen/layer_norm.h"
+
+#include "paddle/phi/backends/cpu/cpu_info.h"
+#include "paddle/phi/kernels/funcs/jit/registry.h"
+
+namespace phi {
+namespace jit {
+namespace gen {
+
+void LayerNormJitCode::normCode(bool with_scale, bool with_bias) {
+  constexpr int block_size = sizeof(float) * YMM_FLOAT_BLOCK;
+  const int row_size = right_ * sizeof(float);
+  Label l_next_block;
+  xor_(reg_offset, reg_offset);
+  L(l_next_block);
+  {
+    vmovups(ymm_src, ptr[param_x + reg_offset]);
+    vsubps(ymm_src, ymm_src, ymm_mean);
+    vmulps(ymm_src, ymm_src, ymm_rstd);
+    if (with_scale) {
+      vmulps(ymm_src, ymm_src, ptr[param_scale + reg_offset]);
+    }
+    if (with_bias) {
+      vaddps(ymm_src, ymm_src, ptr[param_bias + reg_offset]);
+    }
+    vmovups(ptr[param_out + reg_offset], ymm_src);
+    add(reg_offset, block_size);
+    cmp(reg_offset, row_size);
+    jl(l_next_block, T_NEAR);
+  }
+}
+
+void LayerNormJitCode::genCode() {
+  constexpr int block_size = sizeof(float) * YMM_FLOAT_BLOCK;
+  const int row_size = right_ * sizeof(float);
+  Label l_next_row, l_norm_scale, l_norm_bias, l_norm, l_next, l_end;
+
+  // the epsilon at first, before xmm0 is used
+  xmm_t xmm_eps = xmm_t(ymm_eps.getIdx());
+  vshufps(xmm_eps, xmm0, xmm0, 0);
+  vinsertf128(ymm_eps, ymm_eps, xmm_eps, 1);
+  // the return address is on the top of the stack
+  mov(reg_height, dword[rsp + 8]);
+  test(reg_height, reg_height);
+  jle(l_end, T_NEAR);
+  broadcast_float(ymm_inv_right, 1.f / right_, eax);
+  broadcast_float(ymm_one, 1.f, eax);
+
+  L(l_next_row);
+  {
+    // mean
+    vxorps(ymm_sum, ymm_sum, ymm_sum);
+    xor_(reg_offset, reg_offset);
+    Label l_mean;
+    L(l_mean);
+    {
+      vaddps(ymm_sum, ymm_sum, ptr[param_x + reg_offset]);
+      add(reg_offset, block_size);
+      cmp(reg_offset, row_size);
+      jl(l_mean, T_NEAR);
+    }
+    reduce_ymm(ymm_sum, ymm_tmp, operand_type::ADD);
+    vmulps(ymm_mean, ymm_sum, ymm_inv_right);
+    vmovss(ptr[param_mean], xmm_t(ymm_mean.getIdx()));
+
+    // variance
+    vxorps(ymm_sum, ymm_sum, ymm_sum);
+    xor_(reg_offset, reg_offset);
+    Label l_var;
+    L(l_var);
+    {
+      vmovups(ymm_src, ptr[param_x + reg_offset]);
+      vsubps(ymm_src, ymm_src, ymm_mean);
+      vmulps(ymm_src, ymm_src, ymm_src);
+      vaddps(ymm_sum, ymm_sum, ymm_src);
+      add(reg_offset, block_size);
+      cmp(reg_offset, row_size);
+      jl(l_var, T_NEAR);
+    }
+    reduce_ymm(ymm_sum, ymm_tmp, operand_type::ADD);
+    vmulps(ymm_sum, ymm_sum, ymm_inv_right);
+    vmovss(ptr[param_var], xmm_t(ymm_sum.getIdx()));
+    vaddps(ymm_sum, ymm_sum, ymm_eps);
+    vsqrtps(ymm_sum, ymm_sum);
+    vdivps(ymm_rstd, ymm_one, ymm_sum);
+
+    // the scale and bias are checked at runtime
+    test(param_scale, param_scale);
+    jz(l_norm_bias, T_NEAR);
+    test(param_bias, param_bias);
+    jz(l_norm_scale, T_NEAR);
+    normCode(true, true);
+    jmp(l_next, T_NEAR);
+    L(l_norm_scale);
+    normCode(true, false);
+    jmp(l_next, T_NEAR);
+    L(l_norm_bias);
+    test(param_bias, param_bias);
+    jz(l_norm, T_NEAR);
+    normCode(false, true);
+    jmp(l_next, T_NEAR);
+    L(l_norm);
+    normCode(false, false);
+
+    L(l_next);
+    add(param_x, row_size);
+    add(param_out, row_size);
+    add(param_mean, sizeof(float));
+    add(param_var, sizeof(float));
+    dec(reg_height);
+    jnz(l_next_row, T_NEAR);
+  }
+  L(l_end);
+  ret();
+}
+
+class LayerNormCreator : public JitCodeCreator<int> {
+ public:
+  bool CanBeUsed(const int& right) const override {
+    return phi::backends::cpu::MayIUse(phi::backends::cpu::avx) &&
+           right > 0 && right % YMM_FLOAT_BLOCK == 0;
+  }
+  size_t CodeSize(const int& right) const override {
+    // the loops of mean, variance and the 4 kinds of norm
+    return 96 + (30 + 10 * 6) * 8;
+  }
+  std::unique_ptr<GenBase> CreateJitCode(const int& right) const override {
+    return make_unique<LayerNormJitCode>(right, CodeSize(right));
+  }
+};
+
+}  // namespace gen
+}  // namespace jit
+}  // namespace phi
+
+namespace gen = phi::jit::gen;
+
+REGISTER_JITKERNEL_GEN(kLayerNorm, gen::LayerNormCreator);
@@ -0,0 +1,68 @@
+/* Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <string>
+
+#include "glog/logging.h"
+#include "paddle/phi/kernels/funcs/jit/gen/jitcode.h"
+
+namespace phi {
+namespace jit {
+namespace gen {
+
+// The layer norm of each row of right floats, right should be a multiple of
+// 8, and the scale and bias could be nullptr.
+class LayerNormJitCode : public JitCode {
+ public:
+  explicit LayerNormJitCode(int right,
+                            size_t code_size = 256 * 1024,
+                            void* code_ptr = nullptr)
+      : JitCode(code_size, code_ptr), right_(right) {
+    this->genCode();
+  }
+
+  DECLARE_JIT_CODE(LayerNormJitCode);
+  void genCode() override;
+
+ private:
+  // out = (x - mean) * rstd * scale + bias of one row
+  void normCode(bool with_scale, bool with_bias);
+
+  int right_;
+  reg64_t param_x{abi_param1};
+  reg64_t param_out{abi_param2};
+  reg64_t param_mean{abi_param3};
+  reg64_t param_var{abi_param4};
+  reg64_t param_scale{abi_param5};
+  reg64_t param_bias{abi_param6};
+  // the height is the first param on the stack, the epsilon is in xmm0
+
+  reg32_t reg_height{r10d};
+  reg64_t reg_offset{r11};
+
+  ymm_t ymm_src = ymm_t(0);
+  ymm_t ymm_sum = ymm_t(1);
+  ymm_t ymm_mean = ymm_t(2);
+  ymm_t ymm_rstd = ymm_t(3);
+  ymm_t ymm_inv_right = ymm_t(4);
+  ymm_t ymm_eps = ymm_t(5);
+  ymm_t ymm_one = ymm_t(6);
+  ymm_t ymm_tmp = ymm_t(7);
+};
+
+}  // namespace gen
+}  // namespace jit
+}  // namespace phi
@@ -0,0 +1,154 @@
+/* Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "paddle/phi/kernels/funcs/jit/gen/softmax.h"
+
+#include "paddle/phi/backends/cpu/cpu_info.h"
+#include "paddle/phi/kernels/funcs/jit/registry.h"
+
+namespace phi {
+namespace jit {
+namespace gen {
+
+void SoftmaxJitCode::genCode() {
+  constexpr int block_size = sizeof(float) * YMM_FLOAT_BLOCK;
+  const int row_size = n_ * sizeof(float);
+  const int blocks_size = n_ / YMM_FLOAT_BLOCK * block_size;
+  const bool has_rest = blocks_size < row_size;
+  xmm_t xmm_src = xmm_t(ymm_src.getIdx());
+  xmm_t xmm_dst = xmm_t(ymm_dst.getIdx());
+  xmm_t xmm_max = xmm_t(ymm_max.getIdx());
+  xmm_t xmm_sum = xmm_t(ymm_sum.getIdx());
+  xmm_t xmm_low = xmm_t(ymm_low.getIdx());
+  Label l_next_row, l_end;
+
+  test(param_bs, param_bs);
+  jle(l_end, T_NEAR);
+  mov(reg_ptr_consts, reinterpret_cast<size_t>(exp_float_consts));
+  broadcast_float(ymm_low, -64.f, eax);
+
+  L(l_next_row);
+  {
+    // max of the row in all the floats of ymm_max, the rest of less than 8
+    // floats overlaps the last block
+    vmovups(ymm_max, ptr[param_x]);
+    mov(reg_offset, block_size);
+    Label l_max, l_max_end;
+    L(l_max);
+    {
+      cmp(reg_offset, blocks_size);
+      jge(l_max_end, T_NEAR);
+      vmaxps(ymm_max, ymm_max, ptr[param_x + reg_offset]);
+      add(reg_offset, block_size);
+      jmp(l_max, T_NEAR);
+    }
+    L(l_max_end);
+    if (has_rest) {
+      vmaxps(ymm_max, ymm_max, ptr[param_x + row_size - block_size]);
+    }
+    reduce_ymm(ymm_max, ymm_tmp, operand_type::MAX);
+
+    // y = exp(max(x - max, -64)), and the sum of y
+    vxorps(ymm_sum, ymm_sum, ymm_sum);
+    xor_(reg_offset, reg_offset);
+    Label l_exp;
+    L(l_exp);
+    {
+      vmovups(ymm_src, ptr[param_x + reg_offset]);
+      vsubps(ymm_src, ymm_src, ymm_max);
+      vmaxps(ymm_src, ymm_src, ymm_low);
+      exp_jmm<ymm_t>(ymm_dst, ymm_src, 11, 12, 13, 14, 15);
+      vmovups(ptr[param_y + reg_offset], ymm_dst);
+      vaddps(ymm_sum, ymm_sum, ymm_dst);
+      add(reg_offset, block_size);
+      cmp(reg_offset, blocks_size);
+      jl(l_exp, T_NEAR);
+    }
+    reduce_ymm(ymm_sum, ymm_tmp, operand_type::ADD);
+    if (has_rest) {
+      // one float at a time, which clears the upper floats of ymm_sum
+      Label l_exp_rest;
+      L(l_exp_rest);
+      {
+        vmovss(xmm_src, ptr[param_x + reg_offset]);
+        vsubss(xmm_src, xmm_src, xmm_max);
+        vmaxss(xmm_src, xmm_src, xmm_low);
+        exp_jmm<xmm_t>(xmm_dst, xmm_src, 11, 12, 13, 14, 15);
+        vmovss(ptr[param_y + reg_offset], xmm_dst);
+        vaddss(xmm_sum, xmm_sum, xmm_dst);
+        add(reg_offset, sizeof(float));
+        cmp(reg_offset, row_size);
+        jl(l_exp_rest, T_NEAR);
+      }
+      vshufps(xmm_sum, xmm_sum, xmm_sum, 0);
+      vinsertf128(ymm_sum, ymm_sum, xmm_sum, 1);
+    }
+    vmovaps(ymm_tmp, ptr[reg_ptr_consts + OFFSET_EXP_ONE]);
+    vdivps(ymm_sum, ymm_tmp, ymm_sum);
+
+    // y = y / sum
+    xor_(reg_offset, reg_offset);
+    Label l_scale;
+    L(l_scale);
+    {
+      vmulps(ymm_dst, ymm_sum, ptr[param_y + reg_offset]);
+      vmovups(ptr[param_y + reg_offset], ymm_dst);
+      add(reg_offset, block_size);
+      cmp(reg_offset, blocks_size);
+      jl(l_scale, T_NEAR);
+    }
+    if (has_rest) {
+      Label l_scale_rest;
+      L(l_scale_rest);
+      {
+        vmulss(xmm_dst, xmm_sum, ptr[param_y + reg_offset]);
+        vmovss(ptr[param_y + reg_offset], xmm_dst);
+        add(reg_offset, sizeof(float));
+        cmp(reg_offset, row_size);
+        jl(l_scale_rest, T_NEAR);
+      }
+    }
+
+    add(param_x, row_size);
+    add(param_y, row_size);
+    dec(param_bs);
+    jnz(l_next_row, T_NEAR);
+  }
+  L(l_end);
+  ret();
+}
+
+class SoftmaxCreator : public JitCodeCreator<int> {
+ public:
+  bool CanBeUsed(const int& n) const override {
+    return phi::backends::cpu::MayIUse(phi::backends::cpu::avx) &&
+           n >= YMM_FLOAT_BLOCK;
+  }
+  size_t CodeSize(const int& n) const override {
+    // the loops of max, exp and scale, and the exp of the rest, which are
+    // about 70 instructions
+    return 96 + (30 + 70 * 2) * 8;
+  }
+  std::unique_ptr<GenBase> CreateJitCode(const int& n) const override {
+    return make_unique<SoftmaxJitCode>(n, CodeSize(n));
+  }
+};
+
+}  // namespace gen
+}  // namespace jit
+}  // namespace phi
+
+namespace gen = phi::jit::gen;
+
+REGISTER_JITKERNEL_GEN(kSoftmax, gen::SoftmaxCreator);
@@ -0,0 +1,56 @@
+/* Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <string>
+
+#include "glog/logging.h"
+#include "paddle/phi/kernels/funcs/jit/gen/act.h"
+
+namespace phi {
+namespace jit {
+namespace gen {
+
+// The softmax of each row of n floats, n should not be less than 8.
+class SoftmaxJitCode : public VActFunc {
+ public:
+  explicit SoftmaxJitCode(int n, size_t code_size, void* code_ptr = nullptr)
+      : VActFunc(code_size, code_ptr), n_(n) {
+    this->genCode();
+  }
+
+  DECLARE_JIT_CODE(SoftmaxJitCode);
+  void genCode() override;
+
+ private:
+  int n_;
+  reg64_t param_x{abi_param1};
+  reg64_t param_y{abi_param2};
+  reg32_t param_bs{abi_param4};
+
+  reg64_t reg_ptr_consts{r10};
+  reg64_t reg_offset{r11};
+
+  ymm_t ymm_src = ymm_t(0);
+  ymm_t ymm_dst = ymm_t(1);
+  ymm_t ymm_max = ymm_t(2);
+  ymm_t ymm_sum = ymm_t(3);
+  ymm_t ymm_low = ymm_t(4);
+  ymm_t ymm_tmp = ymm_t(5);
+};
+
+}  // namespace gen
+}  // namespace jit
+}  // namespace phi
@@ -38,6 +38,7 @@ const char* to_string(KernelType kt) {
     ONE_CASE(kVSub);
     ONE_CASE(kVScal);
     ONE_CASE(kVAddBias);
+    ONE_CASE(kVAddGelu);
     ONE_CASE(kVRelu);
     ONE_CASE(kVBroadcast);
     ONE_CASE(kVCopy);
@@ -54,6 +55,7 @@ const char* to_string(KernelType kt) {
     ONE_CASE(kCRFDecoding);
     ONE_CASE(kLayerNorm);
     ONE_CASE(kSeqPool);
+    ONE_CASE(kSoftmax);
     ONE_CASE(kMatMul);
     ONE_CASE(kAdam);
     ONE_CASE(kAdamW);
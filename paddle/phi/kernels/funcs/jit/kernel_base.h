@@ -36,8 +36,10 @@ typedef enum {
   kLayerNorm,
   kMatMul,
   kSeqPool,
+  kSoftmax,
   kVAdd,
   kVAddBias,
+  kVAddGelu,
   kVAddRelu,
   kVBroadcast,
   kVCopy,
@@ -106,6 +108,7 @@ struct XRNSTuple {
 DECLARE_KERNELTUPLE(XYZNTuple, VMul);
 DECLARE_KERNELTUPLE(XYZNTuple, VAdd);
 DECLARE_KERNELTUPLE(XYZNTuple, VAddRelu);
+DECLARE_KERNELTUPLE(XYZNTuple, VAddGelu);
 DECLARE_KERNELTUPLE(XYZNTuple, VSub);
 
 DECLARE_KERNELTUPLE(AXYNTuple, VScal);
@@ -360,6 +363,15 @@ struct LayerNormTuple {
       T*, T*, T*, T*, const T*, const T*, int, const float, int);
 };
 
+// x, y, n, bs: the softmax of each row of the bs x n x
+template <typename T>
+struct SoftmaxTuple {
+  static constexpr KernelType kernel_type = kSoftmax;
+  typedef T data_type;
+  typedef int attr_type;
+  typedef void (*func_type)(const T*, T*, int, int);
+};
+
 // Just for adding to kernel pool without template
 class Kernel {
  public:
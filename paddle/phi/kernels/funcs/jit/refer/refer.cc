@@ -25,6 +25,7 @@ namespace refer = phi::jit::refer;
 REGISTER_REFER_KERNEL(VMul);
 REGISTER_REFER_KERNEL(VAdd);
 REGISTER_REFER_KERNEL(VAddRelu);
+REGISTER_REFER_KERNEL(VAddGelu);
 REGISTER_REFER_KERNEL(VSub);
 
 REGISTER_REFER_KERNEL(VScal);
@@ -47,6 +48,7 @@ REGISTER_REFER_KERNEL(GRUHtPart2);
 
 REGISTER_REFER_KERNEL(CRFDecoding);
 REGISTER_REFER_KERNEL(LayerNorm);
+REGISTER_REFER_KERNEL(Softmax);
 REGISTER_REFER_KERNEL(SeqPool);
 REGISTER_REFER_KERNEL(MatMul);
 REGISTER_REFER_KERNEL(EmbSeqPool);
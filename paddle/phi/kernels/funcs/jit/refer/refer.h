@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <string>
@@ -49,6 +50,17 @@ void VAddRelu(const T* x, const T* y, T* z, int n) {
   }
 }
 
+// z = gelu(x + y), by the tanh approximation of gelu
+template <typename T>
+void VAddGelu(const T* x, const T* y, T* z, int n) {
+  for (int i = 0; i < n; ++i) {
+    T u = x[i] + y[i];
+    T inner = static_cast<T>(0.79788456) * u *
+              (static_cast<T>(1) + static_cast<T>(0.044715) * u * u);
+    z[i] = static_cast<T>(0.5) * u * (static_cast<T>(1) + std::tanh(inner));
+  }
+}
+
 template <typename T>
 void VSub(const T* x, const T* y, T* z, int n) {
   for (int i = 0; i < n; ++i) {
@@ -353,6 +365,25 @@ void LayerNorm(T* x,
   }
 }
 
+// the exp of x - max(x) is clipped at -64 as the softmax functor of phi
+template <typename T>
+void Softmax(const T* x, T* y, int n, int bs) {
+  for (int i = 0; i < bs; ++i) {
+    T max = *std::max_element(x, x + n);
+    T sum = 0;
+    for (int j = 0; j < n; ++j) {
+      y[j] = std::exp(std::max(x[j] - max, static_cast<T>(-64)));
+      sum += y[j];
+    }
+    T scalar = static_cast<T>(1) / sum;
+    for (int j = 0; j < n; ++j) {
+      y[j] *= scalar;
+    }
+    x += n;
+    y += n;
+  }
+}
+
 template <typename T>
 void SeqPool(const T* x, T* y, const seq_pool_attr_t* attr) {
   for (int w = 0; w < attr->w; ++w) {
@@ -599,6 +630,7 @@ void AdamW(T beta1,
 DECLARE_REFER_KERNEL(VMul);
 DECLARE_REFER_KERNEL(VAdd);
 DECLARE_REFER_KERNEL(VAddRelu);
+DECLARE_REFER_KERNEL(VAddGelu);
 DECLARE_REFER_KERNEL(VSub);
 
 // const T* a, const T* x, T* y, int n
@@ -626,6 +658,7 @@ DECLARE_REFER_KERNEL(GRUHtPart2);
 // others
 DECLARE_REFER_KERNEL(CRFDecoding);
 DECLARE_REFER_KERNEL(LayerNorm);
+DECLARE_REFER_KERNEL(Softmax);
 DECLARE_REFER_KERNEL(SeqPool);
 DECLARE_REFER_KERNEL(MatMul);
 DECLARE_REFER_KERNEL(EmbSeqPool);
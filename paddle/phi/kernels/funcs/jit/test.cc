@@ -487,6 +487,50 @@ void TestKernelLayerNorm() {
   }
 }
 
+template <typename KernelTuple, typename PlaceType>
+void TestKernelSoftmax() {
+  using T = typename KernelTuple::data_type;
+  VLOG(10) << "Test JITKernel: " << jit::to_string(KernelTuple::kernel_type);
+  for (int bs : {1, 2, 10}) {
+    for (int n : TestSizes()) {
+      auto ref = jit::GetReferFunc<KernelTuple>();
+      EXPECT_TRUE(ref != nullptr);
+      std::vector<T> x(bs * n), yref(bs * n);
+      RandomVec<T>(bs * n, x.data(), -2.f, 2.f);
+      const T* x_data = x.data();
+      T* yref_data = yref.data();
+      std::vector<T> xinp(x.size());  // inplace test
+      std::copy(x.begin(), x.end(), xinp.begin());
+      ref(x_data, yref_data, n, bs);
+      T* xinp_data = xinp.data();
+      ref(xinp_data, xinp_data, n, bs);
+      ExpectEQ<T>(xinp_data, yref_data, x.size());
+
+      auto verifier = [](const typename KernelTuple::func_type tgt,
+                         const std::vector<T>& x,
+                         const std::vector<T>& yref,
+                         int n,
+                         int bs) {
+        EXPECT_TRUE(tgt != nullptr);
+        EXPECT_EQ(yref.size(), x.size());
+        EXPECT_EQ(x.size(), static_cast<size_t>(n * bs));
+        const T* x_data = x.data();
+        const T* yref_data = yref.data();
+        std::vector<T> ytgt(n * bs);
+        T* ytgt_data = ytgt.data();
+        // test normal
+        tgt(x_data, ytgt_data, n, bs);
+        ExpectEQ<T>(ytgt_data, yref_data, n * bs);
+        // test inplace x
+        std::copy(x.begin(), x.end(), ytgt.begin());
+        tgt(ytgt_data, ytgt_data, n, bs);
+        ExpectEQ<T>(ytgt_data, yref_data, n * bs);
+      };
+      TestAllImpls<KernelTuple, PlaceType>(n, verifier, x, yref, n, bs);
+    }
+  }
+}
+
 template <typename KernelTuple, typename PlaceType>
 void TestKernelCRFDecoding() {
   using T = typename KernelTuple::data_type;
@@ -1488,6 +1532,7 @@ TEST(JITKernel_key, sgd) {
 #define TestKernelVMul TestKernelXYZN
 #define TestKernelVAdd TestKernelXYZN
 #define TestKernelVAddRelu TestKernelXYZN
+#define TestKernelVAddGelu TestKernelXYZN
 #define TestKernelVSub TestKernelXYZN
 
 #define TestKernelVScal TestKernelAXYN
@@ -1517,6 +1562,7 @@ TEST(JITKernel_key, sgd) {
 TEST_CPU_KERNEL(VMul);
 TEST_CPU_KERNEL(VAdd);
 TEST_CPU_KERNEL(VAddRelu);
+TEST_CPU_KERNEL(VAddGelu);
 TEST_CPU_KERNEL(VSub);
 
 TEST_CPU_KERNEL(VScal);
@@ -1538,6 +1584,7 @@ TEST_CPU_KERNEL(GRUHtPart1);
 TEST_CPU_KERNEL(GRUHtPart2);
 
 TEST_CPU_KERNEL(LayerNorm);
+TEST_CPU_KERNEL(Softmax);
 TEST_CPU_KERNEL(CRFDecoding);
 
 TEST_CPU_KERNEL(SeqPool);
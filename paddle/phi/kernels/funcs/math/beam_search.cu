@@ -15,6 +15,7 @@
 #include "paddle/phi/kernels/funcs/math/beam_search.h"
 #include "paddle/phi/backends/gpu/gpu_device_function.h"
 #include "paddle/phi/backends/gpu/gpu_launch_config.h"
+#include "paddle/phi/common/memory_utils.h"
 
 namespace phi {
 namespace math {
@@ -379,6 +380,114 @@ __global__ void BeamSearchKernelSingle(int64_t* selected_ids,
                                                     num_used_threads);
 }
 
+// The kernels for the wide rows (e.g. the scores of a large vocabulary) or
+// many sequences, which do not fit one block. Each block selects the top beam
+// of one sequence into top_beams, then WriteBackWideKernel compacts them.
+__global__ void BeamSearchWideKernel(Triple* top_beams,
+                                     int* num_selected,
+                                     const int64_t* pre_ids,
+                                     const float* pre_scores,
+                                     const int64_t* ids,
+                                     const float* scores,
+                                     const size_t* seq_offsets,
+                                     const int seq_width,
+                                     int beam_size,
+                                     int end_id,
+                                     bool is_accumulated) {
+  extern __shared__ Triple top_beam_shared[];
+  const int seq_id = blockIdx.x;
+  const int seq_offset_start = static_cast<int>(seq_offsets[seq_id]);
+  const int seq_offset_end = static_cast<int>(seq_offsets[seq_id + 1]);
+
+  // The block size never exceeds 1024, so the thread id in the block is the
+  // thread id in the sequence.
+  int num_items = 0;
+  if (is_accumulated) {
+    num_items = SelectTopBeam<1024, true>(top_beam_shared,
+                                          pre_ids,
+                                          pre_scores,
+                                          ids,
+                                          scores,
+                                          seq_offset_start,
+                                          seq_offset_end,
+                                          seq_width,
+                                          beam_size,
+                                          end_id,
+                                          blockDim.x);
+  } else {
+    num_items = SelectTopBeam<1024, false>(top_beam_shared,
+                                           pre_ids,
+                                           pre_scores,
+                                           ids,
+                                           scores,
+                                           seq_offset_start,
+                                           seq_offset_end,
+                                           seq_width,
+                                           beam_size,
+                                           end_id,
+                                           blockDim.x);
+  }
+
+  if (threadIdx.x == 0) {
+    bool finish_flag =
+        PruneEndBeams(top_beam_shared, pre_ids, end_id, num_items);
+    Triple* top_beam = top_beams + seq_id * beam_size;
+    for (int i = 0; i < num_items; ++i) {
+      top_beam[i] = top_beam_shared[i];
+    }
+    num_selected[seq_id] = finish_flag ? 0 : num_items;
+  }
+}
+
+template <bool ReturnParentIdx>
+__global__ void WriteBackWideKernel(int64_t* selected_ids,
+                                    float* selected_scores,
+                                    int* parent_idx,
+                                    size_t* selected_offsets,
+                                    Triple* top_beams,
+                                    const int* num_selected,
+                                    const size_t* seq_offsets,
+                                    const int num_seqs,
+                                    int beam_size) {
+  // The outputs are few (num_seqs * beam_size), one thread writes them in
+  // the order of the sequences.
+  selected_offsets[0] = 0;
+  int selected_seq_start = 0;
+  for (int seq_id = 0; seq_id < num_seqs; ++seq_id) {
+    WriteBack<ReturnParentIdx>(selected_ids,
+                               selected_scores,
+                               parent_idx,
+                               selected_offsets,
+                               top_beams + seq_id * beam_size,
+                               static_cast<int>(seq_offsets[seq_id]),
+                               static_cast<int>(seq_offsets[seq_id + 1]),
+                               selected_seq_start,
+                               num_selected[seq_id]);
+    selected_seq_start += num_selected[seq_id];
+  }
+}
+
+// Returns the block size of BeamSearchWideKernel, each thread keeps its own
+// top beam in the shared memory.
+static inline int GetWideKernelThreads(const int seq_width, int beam_size) {
+  constexpr int kMaxSharedBytes = 48 * 1024;
+  constexpr int kMaxThreads = 512;
+  const int max_threads =
+      kMaxSharedBytes / static_cast<int>(sizeof(Triple) * beam_size);
+  PADDLE_ENFORCE_GE(max_threads,
+                    32,
+                    common::errors::Unimplemented(
+                        "The beam_size (%d) of beam_search is too large.",
+                        beam_size));
+  const int candidates_per_thread = 2 * beam_size;
+  int threads = 32;
+  while (threads * 2 <= std::min(max_threads, kMaxThreads) &&
+         threads * candidates_per_thread < seq_width) {
+    threads *= 2;
+  }
+  return threads;
+}
+
 static inline int GetNumUsedThreads(const int max_threads_per_seq,
                                     const int seq_width,
                                     int beam_size) {
@@ -450,7 +559,60 @@ class BeamSearchFunctor<phi::GPUContext, T> {
     phi::MixVector<size_t> mixv_abs(&abs_lod[level]);
     size_t* selected_offsets = mix_vector.CUDAMutableData(context.GetPlace());
 
-    if (num_seqs == 1) {
+    // The single block kernels keep beam_size triples per used thread in
+    // a shared buffer of at most 1024 triples, the others go to the wide
+    // kernels.
+    bool use_wide_kernel = num_seqs > 4 || beam_size * seq_width > 1024;
+    if (use_wide_kernel) {
+      const size_t* seq_offsets = mixv_abs.CUDAData(context.GetPlace());
+      auto top_beams = phi::memory_utils::Alloc(
+          context.GetPlace(),
+          num_seqs * beam_size * sizeof(Triple) + num_seqs * sizeof(int),
+          phi::Stream(reinterpret_cast<phi::StreamId>(context.stream())));
+      Triple* top_beams_data = reinterpret_cast<Triple*>(top_beams->ptr());
+      int* num_selected =
+          reinterpret_cast<int*>(top_beams_data + num_seqs * beam_size);
+      int threads = GetWideKernelThreads(static_cast<int>(seq_width),
+                                         static_cast<int>(beam_size));
+      BeamSearchWideKernel<<<num_seqs,
+                             threads,
+                             threads * beam_size * sizeof(Triple),
+                             context.stream()>>>(
+          top_beams_data,
+          num_selected,
+          pre_ids_data,
+          pre_scores_data,
+          ids_data,
+          scores_data,
+          seq_offsets,
+          static_cast<int>(seq_width),
+          static_cast<int>(beam_size),
+          end_id,
+          is_accumulated);
+      if (parent_idx_data) {
+        WriteBackWideKernel<true><<<1, 1, 0, context.stream()>>>(
+            selected_ids_data,
+            selected_scores_data,
+            parent_idx_data,
+            selected_offsets,
+            top_beams_data,
+            num_selected,
+            seq_offsets,
+            static_cast<int>(num_seqs),
+            static_cast<int>(beam_size));
+      } else {
+        WriteBackWideKernel<false><<<1, 1, 0, context.stream()>>>(
+            selected_ids_data,
+            selected_scores_data,
+            parent_idx_data,
+            selected_offsets,
+            top_beams_data,
+            num_selected,
+            seq_offsets,
+            static_cast<int>(num_seqs),
+            static_cast<int>(beam_size));
+      }
+    } else if (num_seqs == 1) {
       const int seq_length = static_cast<int>(abs_lod[level][1]);
       const int kMaxThreadsPerSeq = 1024;
       int num_used_threads = GetNumUsedThreads(kMaxThreadsPerSeq,
@@ -504,9 +666,6 @@ class BeamSearchFunctor<phi::GPUContext, T> {
                 is_accumulated,
                 num_used_threads));
       }
-    } else {
-      PADDLE_THROW(common::errors::Unimplemented(
-          "Not implemented other number of sequences yet."));
     }
 
     context.Wait();
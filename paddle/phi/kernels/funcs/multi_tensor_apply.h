@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include "glog/logging.h"
 #include "paddle/phi/backends/gpu/gpu_context.h"
 #include "paddle/phi/common/place.h"
 #include "paddle/phi/core/tensor_utils.h"
@@ -178,5 +179,21 @@ void LaunchMultiTensorApplyKernel(
   }
 }
 
+// Copies the inputs to the outputs which do not share the same tensor, so
+// that the multi tensor kernels could update the outputs in place.
+template <typename Context>
+void CopyTensorIfDifferent(const Context &dev_ctx,
+                           const std::vector<const DenseTensor *> &src,
+                           const std::vector<DenseTensor *> &dst,
+                           bool use_src_place = false) {
+  for (size_t i = 0; i < src.size(); ++i) {
+    if (src[i] != dst[i]) {
+      VLOG(10) << "Copy Tensor " << i;
+      phi::Place place = (use_src_place ? src[i]->place() : dev_ctx.GetPlace());
+      phi::Copy<Context>(dev_ctx, *(src[i]), place, false, dst[i]);
+    }
+  }
+}
+
 }  // namespace funcs
 }  // namespace phi
@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <numeric>
 #include <set>
 #include <vector>
@@ -37,6 +38,8 @@ namespace cub = hipcub;
 #include "paddle/phi/backends/gpu/gpu_device_function.h"
 #include "paddle/phi/backends/gpu/gpu_info.h"
 #include "paddle/phi/backends/gpu/gpu_launch_config.h"
+#include "paddle/phi/kernels/autotune/gpu_timer.h"
+#include "paddle/phi/kernels/autotune/switch_autotune.h"
 #endif
 
 #include "paddle/phi/kernels/cast_kernel.h"
@@ -283,6 +286,16 @@ struct ReduceConfig {
   }
 #endif  // PADDLE_WITH_XPU_KP
 
+#ifndef PADDLE_WITH_XPU_KP
+  // Overrides the split number of reduce_num (grid.y) chosen by
+  // SetBlockDimForReduceAny, it is used by the autotune of reduce any kernels.
+  void SetGridY(const KPDevice& dev_ctx, int grid_y) {
+    grid.y = grid_y;
+    phi::backends::gpu::LimitGridDim(dev_ctx, &grid);
+    should_reduce_again = grid.y > 1;
+  }
+#endif  // PADDLE_WITH_XPU_KP
+
   // If should_reduce_again, we need malloc temp space for temp data
   void SetOutputData(Ty* y_data,
                      const KPDevice& dev_ctx,
@@ -926,6 +939,95 @@ static void LaunchReduceKernel(const Tx* x_data,
 
 #if !defined(PADDLE_WITH_XPU_KP)
 
+// Picks the split number of reduce_num (grid.y) for the reduce any and reduce
+// last dim kernels. The heuristic of SetBlockDimForReduceAny could be far
+// from the best one for odd shapes, so when autotune is enabled several
+// candidates are measured and the fastest one is cached by the shape.
+template <typename Tx,
+          typename Ty,
+          typename MPType,
+          typename ReduceOp,
+          typename TransformOp>
+static void TuneReduceAnyGridY(const Tx* x_data,
+                               Ty* y_data,
+                               const ReduceOp& reducer,
+                               const TransformOp& transform,
+                               MPType init,
+                               const KPDevice& dev_ctx,
+                               bool is_mean,
+                               ReduceConfig<Ty, MPType>* config) {
+  auto& cache = phi::autotune::AutoTuneCache::Instance().Get(
+      phi::autotune::AlgorithmType::kReduceAny);
+  bool use_autotune = phi::autotune::AutoTuneStatus::Instance().UseAutoTune();
+  // Keep the default path free of any overhead.
+  if (!use_autotune && cache.Size() == 0) {
+    return;
+  }
+
+  size_t key = phi::autotune::GenKey(
+      config->reduce_num,
+      config->left_num,
+      config->reduce_last_dim,
+      static_cast<int>(config->x_dim.size()),
+      static_cast<int64_t>(phi::CppTypeToDataType<Tx>::Type()),
+      static_cast<int64_t>(phi::CppTypeToDataType<Ty>::Type()));
+  if (cache.Find(key)) {
+    config->SetGridY(dev_ctx, static_cast<int>(cache.Get(key)));
+    return;
+  }
+  if (!use_autotune) {
+    return;
+  }
+
+  int heuristic = static_cast<int>(config->grid.y);
+  std::set<int> candidates = {heuristic,
+                              1,
+                              heuristic * 2,
+                              std::max(heuristic / 2, 1),
+                              std::max(heuristic / 4, 1)};
+
+  // Regard 1st run as warmup, judge the compare result by the time cost
+  // of rest cycles.
+  constexpr int repeats = 6;
+  phi::GpuTimer timer;
+  auto stream = dev_ctx.stream();
+  int best_grid_y = heuristic;
+  float min_time = std::numeric_limits<float>::max();
+  for (int grid_y : candidates) {
+    auto trial_config = *config;
+    trial_config.SetGridY(dev_ctx, grid_y);
+    phi::DenseTensor tmp;
+    trial_config.SetOutputData(y_data, dev_ctx, &tmp);
+    float time_cost = 0;
+    for (int i = 0; i < repeats; ++i) {
+      timer.Start(stream);
+      LaunchReduceKernel<Tx, Ty, MPType, ReduceOp, TransformOp>(
+          x_data,
+          y_data,
+          reducer,
+          transform,
+          init,
+          stream,
+          trial_config,
+          is_mean);
+      timer.Stop(stream);
+      if (i > 0) {
+        time_cost += timer.ElapsedTime();
+      }
+    }
+    VLOG(3) << "reduce any with grid.y = " << trial_config.grid.y
+            << " costs " << time_cost / (repeats - 1) << " ms";
+    if (time_cost < min_time) {
+      min_time = time_cost;
+      best_grid_y = static_cast<int>(trial_config.grid.y);
+    }
+  }
+  VLOG(3) << "best grid.y of reduce any is " << best_grid_y
+          << ", the heuristic one is " << heuristic;
+  cache.Set(key, static_cast<int64_t>(best_grid_y));
+  config->SetGridY(dev_ctx, best_grid_y);
+}
+
 template <typename Tx,
           typename Ty,
           template <typename>
@@ -1091,11 +1193,25 @@ void ReduceKernel(const KPDevice& dev_ctx,
     return;
   }
 
-  config.SetOutputData(y_data, dev_ctx, &tmp);
   constexpr bool kIsTxFP16 = std::is_same<Tx, phi::dtype::float16>::value;
   constexpr bool kIsTxBF16 = std::is_same<Tx, phi::dtype::bfloat16>::value;
   bool use_cub_reduce = config.reduce_num == numel && !kIsTxFP16 && !kIsTxBF16;
 
+#ifndef PADDLE_WITH_XPU_KP
+  if (!use_cub_reduce && config.reduce_type != ReduceType::kReduceHigherDim) {
+    TuneReduceAnyGridY<Tx, Ty, MPType, ReduceOp<MPType>, TransformOp>(
+        x_data,
+        y_data,
+        ReduceOp<MPType>(),
+        transform,
+        ReduceOp<MPType>().initial(),
+        dev_ctx,
+        IsMean,
+        &config);
+  }
+#endif
+  config.SetOutputData(y_data, dev_ctx, &tmp);
+
 #ifndef PADDLE_WITH_XPU_KP
   if (use_cub_reduce) {
     CubTensorReduce<Tx, Ty, ReduceOp, TransformOp, IsMean>::apply(
@@ -0,0 +1,84 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "paddle/common/hostdevice.h"
+
+namespace phi {
+namespace funcs {
+
+// Images of at most kResizedCropMaxChannels channels are supported, so that
+// the per channel mean and stddev can be passed to the kernels by value.
+constexpr int kResizedCropMaxChannels = 4;
+
+struct ResizedCropNormalizeParam {
+  float mean[kResizedCropMaxChannels];
+  float stddev[kResizedCropMaxChannels];
+};
+
+HOSTDEVICE inline int ResizedCropClamp(int v, int hi) {
+  return v < 0 ? 0 : (v > hi ? hi : v);
+}
+
+// Computes the output pixel (oy, ox) of one channel, the source position
+// follows the half pixel convention of the bilinear interpolation with
+// align_corners=False, and is clamped into the box and the image.
+template <typename T>
+HOSTDEVICE inline float ResizedCropNormalizePixel(const T* image,
+                                                  int height,
+                                                  int width,
+                                                  const int* box,
+                                                  bool flip,
+                                                  int out_h,
+                                                  int out_w,
+                                                  int oy,
+                                                  int ox,
+                                                  float mean,
+                                                  float stddev) {
+  int top = box[0];
+  int left = box[1];
+  int box_h = box[2] > 1 ? box[2] : 1;
+  int box_w = box[3] > 1 ? box[3] : 1;
+  if (flip) {
+    ox = out_w - 1 - ox;
+  }
+
+  float src_y = (oy + 0.5f) * box_h / out_h - 0.5f;
+  float src_x = (ox + 0.5f) * box_w / out_w - 0.5f;
+  src_y = src_y < 0.f ? 0.f : (src_y > box_h - 1 ? box_h - 1 : src_y);
+  src_x = src_x < 0.f ? 0.f : (src_x > box_w - 1 ? box_w - 1 : src_x);
+  int y0 = static_cast<int>(src_y);
+  int x0 = static_cast<int>(src_x);
+  float ly = src_y - y0;
+  float lx = src_x - x0;
+  int y1 = y0 + 1 < box_h ? y0 + 1 : y0;
+  int x1 = x0 + 1 < box_w ? x0 + 1 : x0;
+
+  y0 = ResizedCropClamp(top + y0, height - 1);
+  y1 = ResizedCropClamp(top + y1, height - 1);
+  x0 = ResizedCropClamp(left + x0, width - 1);
+  x1 = ResizedCropClamp(left + x1, width - 1);
+
+  float v00 = static_cast<float>(image[y0 * width + x0]);
+  float v01 = static_cast<float>(image[y0 * width + x1]);
+  float v10 = static_cast<float>(image[y1 * width + x0]);
+  float v11 = static_cast<float>(image[y1 * width + x1]);
+  float value = (1.f - ly) * ((1.f - lx) * v00 + lx * v01) +
+                ly * ((1.f - lx) * v10 + lx * v11);
+  return (value - mean) / stddev;
+}
+
+}  // namespace funcs
+}  // namespace phi
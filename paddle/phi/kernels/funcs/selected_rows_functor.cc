@@ -16,7 +16,9 @@ limitations under the License. */
 
 #include <algorithm>
 #include <map>
+#include <numeric>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 #include "paddle/common/ddim.h"
@@ -415,6 +417,58 @@ template struct SelectedRowsAddToTensor<phi::XPUContext, float>;
 }  // namespace phi::funcs
 namespace phi::funcs::scatter {
 
+MergeRowGroups GroupMergeRows(const phi::Vector<int64_t>& rows,
+                              const bool sorted_result) {
+  MergeRowGroups groups;
+  std::unordered_map<int64_t, int64_t> row_to_id;
+  row_to_id.reserve(rows.size());
+  std::vector<int64_t> ids(rows.size());
+  for (size_t i = 0; i < rows.size(); ++i) {
+    auto ret = row_to_id.emplace(rows[i], groups.rows.size());
+    if (ret.second) {
+      groups.rows.push_back(rows[i]);
+    }
+    ids[i] = ret.first->second;
+  }
+
+  const size_t merged_num = groups.rows.size();
+  if (sorted_result) {
+    // only the unique rows are sorted, and the ids are remapped after them
+    std::vector<int64_t> order(merged_num);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int64_t a, int64_t b) {
+      return groups.rows[a] < groups.rows[b];
+    });
+    std::vector<int64_t> rank(merged_num);
+    std::vector<int64_t> sorted_rows(merged_num);
+    for (size_t i = 0; i < merged_num; ++i) {
+      rank[order[i]] = static_cast<int64_t>(i);
+      sorted_rows[i] = groups.rows[order[i]];
+    }
+    groups.rows.swap(sorted_rows);
+    for (auto& id : ids) {
+      id = rank[id];
+    }
+  }
+
+  // counting sort of the input rows by their merged ids, which keeps the
+  // input order in a group so the sums are deterministic
+  groups.offsets.assign(merged_num + 1, 0);
+  for (auto id : ids) {
+    ++groups.offsets[id + 1];
+  }
+  for (size_t i = 0; i < merged_num; ++i) {
+    groups.offsets[i + 1] += groups.offsets[i];
+  }
+  std::vector<int64_t> cursor(groups.offsets.begin(),
+                              groups.offsets.end() - 1);
+  groups.input_index.resize(rows.size());
+  for (size_t i = 0; i < ids.size(); ++i) {
+    groups.input_index[cursor[ids[i]]++] = static_cast<int64_t>(i);
+  }
+  return groups;
+}
+
 template <typename T, typename DeviceContext>
 typename std::enable_if<!std::is_integral<T>::value>::type elementwise_add_to(
     phi::funcs::BlasT<DeviceContext, T>* blas,
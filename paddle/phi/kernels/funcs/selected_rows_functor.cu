@@ -12,12 +12,12 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License. */
 
-#include <set>
 #include <vector>
 
 #include "glog/logging.h"
 
 #include "paddle/phi/backends/gpu/gpu_primitives.h"
+#include "paddle/phi/common/amp_type_traits.h"
 #include "paddle/phi/common/bfloat16.h"
 #include "paddle/phi/common/float16.h"
 #include "paddle/phi/kernels/funcs/math_function.h"
@@ -342,30 +342,33 @@ template struct SelectedRowsAddToTensor<phi::GPUContext,
 
 namespace scatter {
 
+// Each block writes a merged row by summing its input rows grouped by
+// GroupMergeRows, so neither atomics nor a zeroed out are needed even if a
+// row is duplicated many times.
 template <typename T, int block_size>
-__global__ void MergeAddKernel(const T* input,
-                               const int64_t* input_rows,
-                               T* out,
-                               const int64_t* out_rows,
-                               size_t out_rows_size,
-                               int64_t row_numel) {
-  const int ty = blockIdx.x;
-  int tid = threadIdx.x;
-  __shared__ size_t out_idx;
-
-  if (tid == 0) {
-    for (size_t i = 0; i < out_rows_size; i++) {
-      if (input_rows[ty] == out_rows[i]) {
-        out_idx = i;
-      }
-    }
+__global__ void MergeAddByGroupKernel(const T* input,
+                                      const int64_t* offsets,
+                                      const int64_t* input_index,
+                                      T* out,
+                                      int64_t row_numel) {
+  using MT = typename phi::dtype::MPTypeTrait<T>::Type;
+  const int64_t out_idx = blockIdx.x;
+  out += out_idx * row_numel;
+  for (int64_t index = threadIdx.x; index < row_numel; index += block_size) {
+    out[index] = static_cast<T>(MergedRowValue<T, MT>(
+        input, offsets, input_index, out_idx, row_numel, index));
   }
+}
 
-  __syncthreads();
-
-  input += ty * row_numel;
-  out += out_idx * row_numel;
-  for (int index = tid; index < row_numel; index += block_size) {
+// Adds each input row to the merged row of the given index.
+template <typename T, int block_size>
+__global__ void MergeAddByIndexKernel(const T* input,
+                                      const int64_t* out_index,
+                                      T* out,
+                                      int64_t row_numel) {
+  input += static_cast<int64_t>(blockIdx.x) * row_numel;
+  out += out_index[blockIdx.x] * row_numel;
+  for (int64_t index = threadIdx.x; index < row_numel; index += block_size) {
     phi::CudaAtomicAdd(out + index, input[index]);
   }
 }
@@ -376,7 +379,7 @@ struct MergeAddImpl {
                                const phi::SelectedRows& input,
                                const bool sorted_result = false) {
     phi::SelectedRows out;
-    (*this)(context, input, &out);
+    (*this)(context, input, &out, sorted_result);
     return out;
   }
 
@@ -384,45 +387,38 @@ struct MergeAddImpl {
                   const phi::SelectedRows& input,
                   phi::SelectedRows* output,
                   const bool sorted_result = false) {
-    phi::Vector<int64_t> input_rows(input.rows());
+    const phi::Vector<int64_t>& input_rows = input.rows();
     if (input_rows.size() == 0) {
       return;
     }
 
     phi::SelectedRows& out = *output;
-    std::set<int64_t> row_set(input_rows.begin(), input_rows.end());
-    std::vector<int64_t> merge_rows_cpu(row_set.begin(), row_set.end());
-    phi::Vector<int64_t> merge_rows(merge_rows_cpu);
+    // The rows are grouped by hashing on the host, and only the merged rows
+    // are sorted, as the merged rows on GPU are always sorted.
+    MergeRowGroups groups = GroupMergeRows(input_rows, true);
 
     auto input_width = input.value().dims()[1];
 
-    out.set_rows(merge_rows);
+    out.set_rows(groups.rows);
     out.set_height(input.height());
     DenseTensor* out_tensor = out.mutable_value();
     out_tensor->Resize(common::make_ddim(
-        {static_cast<int64_t>(merge_rows.size()), input_width}));
-    context.template Alloc<T>(out_tensor);
-
-    phi::funcs::SetConstant<DeviceContext, T> constant_functor;
-    constant_functor(context, out.mutable_value(), static_cast<T>(0));
-
-    auto* out_data = out.mutable_value()->data<T>();
+        {static_cast<int64_t>(groups.rows.size()), input_width}));
+    auto* out_data = context.template Alloc<T>(out_tensor);
     auto* input_data = input.value().data<T>();
 
     const int block_size = 256;
     dim3 threads(block_size, 1);
-    dim3 grid1(input_rows.size(), 1);
+    dim3 grid1(groups.rows.size(), 1);
 
-    phi::MixVector<int64_t> mix_vector_input(&input_rows);
-    phi::MixVector<int64_t> mix_vector_out(out.mutable_rows());
-    MergeAddKernel<T, 256><<<grid1, threads, 0, context.stream()>>>(
+    phi::MixVector<int64_t> mix_vector_offsets(&groups.offsets);
+    phi::MixVector<int64_t> mix_vector_index(&groups.input_index);
+    MergeAddByGroupKernel<T, 256><<<grid1, threads, 0, context.stream()>>>(
         input_data,
-        mix_vector_input.CUDAData(context.GetPlace()),
+        mix_vector_offsets.CUDAData(context.GetPlace()),
+        mix_vector_index.CUDAData(context.GetPlace()),
         out_data,
-        mix_vector_out.CUDAMutableData(context.GetPlace()),
-        out.rows().size(),
         input_width);
-    mix_vector_out.CopyToCPU();
   }
 
   void operator()(const DeviceContext& context,
@@ -447,7 +443,7 @@ struct MergeAddImpl {
     auto input_width = has_value_input->value().dims()[1];
     auto input_height = has_value_input->height();
     phi::SelectedRows& out = *output;
-    std::set<int64_t> merged_row_set;
+    phi::Vector<int64_t> all_rows;
     for (auto* input : inputs) {
       if (input->rows().size() == 0) {
         continue;
@@ -461,18 +457,24 @@ struct MergeAddImpl {
                         input->height(),
                         common::errors::InvalidArgument(
                             "All input should have same height."));
-      merged_row_set.insert(input->rows().begin(), input->rows().end());
+      all_rows.insert(
+          all_rows.end(), input->rows().begin(), input->rows().end());
+    }
+    MergeRowGroups groups = GroupMergeRows(all_rows, true);
+    // the merged index of each row of the inputs
+    phi::Vector<int64_t> out_index(all_rows.size());
+    for (size_t i = 0; i + 1 < groups.offsets.size(); ++i) {
+      for (int64_t k = groups.offsets[i]; k < groups.offsets[i + 1]; ++k) {
+        out_index[groups.input_index[k]] = static_cast<int64_t>(i);
+      }
     }
-    std::vector<int64_t> merge_rows_cpu(merged_row_set.begin(),
-                                        merged_row_set.end());
-    phi::Vector<int64_t> merge_rows(merge_rows_cpu);
 
-    out.set_rows(merge_rows);
+    out.set_rows(groups.rows);
     out.set_height(input_height);
 
     DenseTensor* out_tensor = out.mutable_value();
     out_tensor->Resize(common::make_ddim(
-        {static_cast<int64_t>(merge_rows.size()), input_width}));
+        {static_cast<int64_t>(groups.rows.size()), input_width}));
     context.template Alloc<T>(out_tensor);
 
     phi::funcs::SetConstant<DeviceContext, T> constant_functor;
@@ -483,24 +485,19 @@ struct MergeAddImpl {
     const int block_size = 256;
     dim3 threads(block_size, 1);
 
+    phi::MixVector<int64_t> mix_vector_index(&out_index);
+    const int64_t* out_index_data =
+        mix_vector_index.CUDAData(context.GetPlace());
+    int64_t row_offset = 0;
     for (auto* input : inputs) {
       if (input->rows().size() == 0) {
         continue;
       }
       auto* input_data = input->value().data<T>();
-      auto& input_rows = input->rows();
-      dim3 grid1(input_rows.size(), 1);
-
-      phi::MixVector<int64_t> mix_vector_input(&input_rows);
-      phi::MixVector<int64_t> mix_vector_out(out.mutable_rows());
-      MergeAddKernel<T, 256><<<grid1, threads, 0, context.stream()>>>(
-          input_data,
-          mix_vector_input.CUDAData(context.GetPlace()),
-          out_data,
-          mix_vector_out.CUDAMutableData(context.GetPlace()),
-          out.rows().size(),
-          input_width);
-      mix_vector_out.CopyToCPU();
+      dim3 grid1(input->rows().size(), 1);
+      MergeAddByIndexKernel<T, 256><<<grid1, threads, 0, context.stream()>>>(
+          input_data, out_index_data + row_offset, out_data, input_width);
+      row_offset += static_cast<int64_t>(input->rows().size());
     }
   }
 };
@@ -16,6 +16,7 @@ limitations under the License. */
 #include <map>
 #include <vector>
 
+#include "paddle/common/hostdevice.h"
 #include "paddle/phi/backends/all_context.h"
 #include "paddle/phi/core/mixed_vector.h"
 #include "paddle/phi/core/selected_rows.h"
@@ -77,6 +78,35 @@ struct SelectedRowsAddToTensor {
 };
 
 namespace scatter {
+// The duplicated rows of a SelectedRows grouped without sorting them, the
+// i-th merged row is rows[i] and the sum of the input rows
+// input_index[offsets[i]:offsets[i + 1]]. The rows are sorted only if
+// sorted_result, and otherwise they are in the order they first appear.
+struct MergeRowGroups {
+  std::vector<int64_t> rows;
+  std::vector<int64_t> offsets;
+  std::vector<int64_t> input_index;
+};
+
+MergeRowGroups GroupMergeRows(const phi::Vector<int64_t>& rows,
+                              const bool sorted_result = false);
+
+// Sums the input rows of the row_idx-th merged row of MergeRowGroups at the
+// col-th column, which lets the kernels consume the unmerged input directly.
+template <typename T, typename MT>
+HOSTDEVICE inline MT MergedRowValue(const T* input,
+                                    const int64_t* offsets,
+                                    const int64_t* input_index,
+                                    int64_t row_idx,
+                                    int64_t row_numel,
+                                    int64_t col) {
+  MT sum = static_cast<MT>(0);
+  for (int64_t k = offsets[row_idx]; k < offsets[row_idx + 1]; ++k) {
+    sum += static_cast<MT>(input[input_index[k] * row_numel + col]);
+  }
+  return sum;
+}
+
 // functors for manipulating SelectedRows data
 template <typename DeviceContext, typename T>
 struct MergeAdd {
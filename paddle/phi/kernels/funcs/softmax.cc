@@ -15,10 +15,22 @@ limitations under the License. */
 #include "paddle/phi/kernels/funcs/softmax.h"
 
 #include "paddle/phi/backends/cpu/cpu_context.h"
+#include "paddle/phi/kernels/funcs/jit/kernels.h"
 #include "paddle/phi/kernels/funcs/softmax_impl.h"
 
 namespace phi::funcs {
 
+template <typename T>
+void SoftmaxRowsByJit(const T* x, T* y, int n, int bs) {
+  auto softmax =
+      phi::jit::KernelFuncs<phi::jit::SoftmaxTuple<T>, phi::CPUPlace>::Cache()
+          .At(n);
+  softmax(x, y, n, bs);
+}
+
+template void SoftmaxRowsByJit<float>(const float*, float*, int, int);
+template void SoftmaxRowsByJit<double>(const double*, double*, int, int);
+
 template class SoftmaxFunctor<phi::CPUContext, float>;
 template class SoftmaxFunctor<phi::CPUContext, double>;
 template class SoftmaxGradFunctor<phi::CPUContext, float>;
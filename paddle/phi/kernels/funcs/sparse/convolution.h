@@ -14,6 +14,11 @@ limitations under the License. */
 
 #pragma once
 
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "paddle/common/ddim.h"
 #include "paddle/phi/core/kmap_cache.h"
 #include "paddle/phi/core/tensor_utils.h"
@@ -245,11 +250,59 @@ inline const int* GetCounterPtr(const SparseCooTensor& coo,
   return counter.data<int>();
 }
 
+// The rulebook of submanifold conv only depends on the indices and the
+// geometry of conv, so it is cached by the indices with this key if the
+// user does not give one. The channels, which are the last two dims of
+// kernel_sizes, are left out to share the rulebook between the layers.
+inline std::string SubmRulebookKey(const std::vector<int>& kernel_sizes,
+                                   const std::vector<int>& paddings,
+                                   const std::vector<int>& dilations,
+                                   const std::vector<int>& strides) {
+  const std::vector<int> spatial_sizes(kernel_sizes.begin(),
+                                       kernel_sizes.end() - 2);
+  std::ostringstream key;
+  key << "subm";
+  for (const auto* values :
+       {&spatial_sizes, &paddings, &dilations, &strides}) {
+    key << "_";
+    for (int value : *values) {
+      key << value << ",";
+    }
+  }
+  return key.str();
+}
+
+// The out of submanifold conv shares the indices of x, the rulebooks cached
+// by the indices are shared too.
+template <typename T, typename IntT, typename Context>
+inline const IntT* PrepareSubm(
+    const Context& dev_ctx,
+    const SparseCooTensor& x,
+    const std::pair<DenseTensor, DenseTensor>& indices_pairs,
+    const DDim& out_dims,
+    const int out_channels,
+    SparseCooTensor* out,
+    int* counter,
+    int* offsets,
+    int* rulebook_len) {
+  const DenseTensor& rulebook = indices_pairs.first;
+  const int counter_size = indices_pairs.second.numel();
+  memcpy(counter, indices_pairs.second.data<int>(), counter_size * sizeof(int));
+  *rulebook_len = rulebook.dims()[1];
+
+  DenseTensor out_values = phi::Empty<T>(dev_ctx, {x.nnz(), out_channels});
+  out->SetMember(x.non_zero_indices(), out_values, out_dims, false);
+  out->ShareSubmRulebooks(x);
+  PrefixSum<int>(counter, offsets, counter_size);
+  return rulebook.data<IntT>();
+}
+
 template <typename T, typename IntT, typename Context>
 inline const IntT* PrepareSubm(const Context& dev_ctx,
                                const SparseCooTensor& x,
                                const std::string& key,
                                const DDim& out_dims,
+                               const int out_channels,
                                SparseCooTensor* out,
                                int* counter,
                                int* offsets,
@@ -258,22 +311,16 @@ inline const IntT* PrepareSubm(const Context& dev_ctx,
   const auto* indices_pairs = x.IndicesPairs(key);
   if (indices_pairs != nullptr) {
     *need_product_rulebook = false;
-    const DenseTensor& rulebook = indices_pairs->first;
-    const int counter_size = indices_pairs->second.numel();
-    memcpy(
-        counter, indices_pairs->second.data<int>(), counter_size * sizeof(int));
     out->SetIndicesDict(x.GetIndicesDict());
-
-    *rulebook_len = rulebook.dims()[1];
-
-    DenseTensor out_indices =
-        phi::EmptyLike<IntT>(dev_ctx, x.non_zero_indices());
-    DenseTensor out_values = phi::EmptyLike<T>(dev_ctx, x.non_zero_elements());
-    phi::Copy(
-        dev_ctx, x.non_zero_indices(), dev_ctx.GetPlace(), false, &out_indices);
-    out->SetMember(out_indices, out_values, out_dims, false);
-    PrefixSum<int>(counter, offsets, counter_size);
-    return rulebook.data<IntT>();
+    return PrepareSubm<T, IntT, Context>(dev_ctx,
+                                         x,
+                                         *indices_pairs,
+                                         out_dims,
+                                         out_channels,
+                                         out,
+                                         counter,
+                                         offsets,
+                                         rulebook_len);
   }
   return nullptr;
 }
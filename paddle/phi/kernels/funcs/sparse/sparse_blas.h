@@ -36,6 +36,18 @@ class SparseBlas {
             T beta,
             phi::DenseTensor* mat_out) const;
 
+  // Runs SPMM with the given algorithm of the library instead of the default
+  // one, it is used by the autotune of sparse matmul.
+  template <typename T, typename TensorType>
+  void SPMM(bool transa,
+            bool transb,
+            T alpha,
+            const TensorType& mat_a,
+            const phi::DenseTensor& mat_b,
+            T beta,
+            phi::DenseTensor* mat_out,
+            int64_t algorithm) const;
+
   template <typename T, typename TensorType>
   void SPMV(bool transa,
             T alpha,
@@ -332,11 +332,32 @@ void SparseBlas<phi::GPUContext>::SPMM(bool transa,
                                        const phi::DenseTensor& mat_b,
                                        T beta,
                                        phi::DenseTensor* mat_out) const {
+  SPMM(transa,
+       transb,
+       alpha,
+       mat_a,
+       mat_b,
+       beta,
+       mat_out,
+       static_cast<int64_t>(GetSpMMAlgorithm(mat_a)));
+}
+
+template <>
+template <typename T, typename TensorType>
+void SparseBlas<phi::GPUContext>::SPMM(bool transa,
+                                       bool transb,
+                                       T alpha,
+                                       const TensorType& mat_a,
+                                       const phi::DenseTensor& mat_b,
+                                       T beta,
+                                       phi::DenseTensor* mat_out,
+                                       int64_t algorithm) const {
   auto a_descriptor = CuSparseSpMatDescriptor<T>(mat_a, dev_ctx_);
   auto b_descriptor = CuSparseDnMatDescriptor<T>(mat_b, dev_ctx_);
   auto out_descriptor = CuSparseDnMatDescriptor<T>(*mat_out, dev_ctx_);
 
   cudaDataType_t gpu_type = GetGpuDataType<T>();
+  auto spmm_algorithm = static_cast<cusparseSpMMAlg_t>(algorithm);
   size_t buffer_size = 0;
   dev_ctx_.CusparseCall([&](cusparseHandle_t handle) {
     phi::dynload::cusparseSpMM_bufferSize(handle,
@@ -348,7 +369,7 @@ void SparseBlas<phi::GPUContext>::SPMM(bool transa,
                                           &beta,
                                           out_descriptor.descriptor(),
                                           gpu_type,
-                                          GetSpMMAlgorithm(mat_a),
+                                          spmm_algorithm,
                                           &buffer_size);
   });
 
@@ -367,7 +388,7 @@ void SparseBlas<phi::GPUContext>::SPMM(bool transa,
                                &beta,
                                out_descriptor.descriptor(),
                                gpu_type,
-                               GetSpMMAlgorithm(mat_a),
+                               spmm_algorithm,
                                tmp_buffer_ptr);
   });
 }
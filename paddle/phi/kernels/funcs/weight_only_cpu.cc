@@ -0,0 +1,159 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/funcs/weight_only_cpu.h"
+
+#include <algorithm>
+
+namespace phi {
+namespace funcs {
+
+namespace {
+
+inline float LowInt4(int8_t packed) {
+  return static_cast<float>(
+      static_cast<int8_t>(static_cast<uint8_t>(packed) << 4) >> 4);
+}
+
+inline float HighInt4(int8_t packed) {
+  return static_cast<float>(packed >> 4);
+}
+
+// The rows of x for the weight row w of the channel j, k of each group are
+// accumulated in float before scaled.
+void GemvInt8Row(const float* x,
+                 const int8_t* w,
+                 const float* scale,
+                 const float* bias,
+                 int64_t m,
+                 int64_t n,
+                 int64_t k,
+                 int64_t group,
+                 int64_t j,
+                 float* out) {
+  for (int64_t r = 0; r < m; ++r) {
+    const float* x_row = x + r * k;
+    float acc = 0;
+    for (int64_t g = 0; g < k; g += group) {
+      const int64_t end = std::min(g + group, k);
+      float partial = 0;
+      for (int64_t i = g; i < end; ++i) {
+        partial += x_row[i] * static_cast<float>(w[i]);
+      }
+      acc += partial * scale[(g / group) * n + j];
+    }
+    out[r * n + j] = bias ? acc + bias[j] : acc;
+  }
+}
+
+// The weight row w holds the channels j and j + 1.
+void GemvInt4Row(const float* x,
+                 const int8_t* w,
+                 const float* scale,
+                 const float* bias,
+                 int64_t m,
+                 int64_t n,
+                 int64_t k,
+                 int64_t group,
+                 int64_t j,
+                 float* out) {
+  for (int64_t r = 0; r < m; ++r) {
+    const float* x_row = x + r * k;
+    float acc_low = 0, acc_high = 0;
+    for (int64_t g = 0; g < k; g += group) {
+      const int64_t end = std::min(g + group, k);
+      float partial_low = 0, partial_high = 0;
+      for (int64_t i = g; i < end; ++i) {
+        partial_low += x_row[i] * LowInt4(w[i]);
+        partial_high += x_row[i] * HighInt4(w[i]);
+      }
+      const float* group_scale = scale + (g / group) * n + j;
+      acc_low += partial_low * group_scale[0];
+      acc_high += partial_high * group_scale[1];
+    }
+    out[r * n + j] = bias ? acc_low + bias[j] : acc_low;
+    out[r * n + j + 1] = bias ? acc_high + bias[j + 1] : acc_high;
+  }
+}
+
+}  // namespace
+
+void WeightOnlyGemv(const float* x,
+                    const int8_t* weight,
+                    const float* scale,
+                    const float* bias,
+                    int64_t m,
+                    int64_t n,
+                    int64_t k,
+                    int bits,
+                    int group_size,
+                    float* out) {
+  const int64_t group = group_size > 0 ? group_size : k;
+  if (bits == 4) {
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+    for (int64_t row = 0; row < n / 2; ++row) {
+      GemvInt4Row(
+          x, weight + row * k, scale, bias, m, n, k, group, row * 2, out);
+    }
+  } else {
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+    for (int64_t row = 0; row < n; ++row) {
+      GemvInt8Row(x, weight + row * k, scale, bias, m, n, k, group, row, out);
+    }
+  }
+}
+
+void WeightOnlyDequantize(const int8_t* weight,
+                          const float* scale,
+                          int64_t n,
+                          int64_t k,
+                          int bits,
+                          int group_size,
+                          float* out) {
+  const int64_t group = group_size > 0 ? group_size : k;
+  if (bits == 4) {
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+    for (int64_t row = 0; row < n / 2; ++row) {
+      const int8_t* w = weight + row * k;
+      const int64_t j = row * 2;
+      float* out_low = out + j * k;
+      float* out_high = out_low + k;
+      for (int64_t i = 0; i < k; ++i) {
+        const float* group_scale = scale + (i / group) * n + j;
+        out_low[i] = LowInt4(w[i]) * group_scale[0];
+        out_high[i] = HighInt4(w[i]) * group_scale[1];
+      }
+    }
+  } else {
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+    for (int64_t j = 0; j < n; ++j) {
+      const int8_t* w = weight + j * k;
+      float* out_row = out + j * k;
+      for (int64_t i = 0; i < k; ++i) {
+        out_row[i] = static_cast<float>(w[i]) * scale[(i / group) * n + j];
+      }
+    }
+  }
+}
+
+}  // namespace funcs
+}  // namespace phi
@@ -0,0 +1,50 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+namespace phi {
+namespace funcs {
+
+// The weight-only quantized weight of the cpu kernels, made by
+// weight_quantize with arch 0: the int8 weight is [n, k], and the int4
+// weight is [n / 2, k] with the signed nibbles of the channels 2i and 2i + 1
+// in the low and high bits of the row i. The scale is [n] per channel, or
+// [k / group_size, n] group-wise.
+
+// out[m, n] = x[m, k] * dequant(weight)^T + bias, reading the weight once.
+void WeightOnlyGemv(const float* x,
+                    const int8_t* weight,
+                    const float* scale,
+                    const float* bias,
+                    int64_t m,
+                    int64_t n,
+                    int64_t k,
+                    int bits,
+                    int group_size,
+                    float* out);
+
+// out[n, k] = dequant(weight)
+void WeightOnlyDequantize(const int8_t* weight,
+                          const float* scale,
+                          int64_t n,
+                          int64_t k,
+                          int bits,
+                          int group_size,
+                          float* out);
+
+}  // namespace funcs
+}  // namespace phi
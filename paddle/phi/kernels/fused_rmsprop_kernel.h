@@ -0,0 +1,48 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "paddle/phi/core/dense_tensor.h"
+
+namespace phi {
+
+// Updates all the params by rmsprop in a few multi tensor apply launches.
+// The update is skipped on device if found_inf is true, and the grads are
+// divided by scale if it is given.
+template <typename T, typename Context>
+void FusedRmspropKernel(
+    const Context &dev_ctx,
+    const std::vector<const DenseTensor *> &params,
+    const std::vector<const DenseTensor *> &grads,
+    const DenseTensor &learning_rate,
+    const std::vector<const DenseTensor *> &mean_squares,
+    const std::vector<const DenseTensor *> &moments,
+    const paddle::optional<std::vector<const DenseTensor *>> &mean_grads,
+    const paddle::optional<std::vector<const DenseTensor *>> &master_params,
+    const paddle::optional<DenseTensor> &found_inf,
+    const paddle::optional<DenseTensor> &scale,
+    float epsilon,
+    float decay,
+    float momentum,
+    int chunk_size,
+    bool centered,
+    bool multi_precision,
+    std::vector<DenseTensor *> params_out,
+    std::vector<DenseTensor *> moments_out,
+    std::vector<DenseTensor *> mean_squares_out,
+    std::vector<DenseTensor *> mean_grads_out,
+    std::vector<DenseTensor *> master_params_out);
+
+}  // namespace phi
@@ -13,17 +13,90 @@
 // limitations under the License.
 
 #include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/funcs/jit/kernels.h"
 #include "paddle/phi/kernels/impl/fused_elemwise_activation_kernel_impl.h"
+
+namespace phi {
+namespace fusion {
+
+// out = gelu(x + y) with the fused jit kernel, when y is added to each row
+// of x, as the bias after the matmul of ffn
+template <typename T, typename Context>
+bool AddGeluByJit(const Context &dev_ctx,
+                  const DenseTensor &x,
+                  const DenseTensor &y,
+                  const std::vector<std::string> &functor_list,
+                  int axis,
+                  bool save_intermediate_out,
+                  DenseTensor *out) {
+  if (save_intermediate_out || functor_list.size() != 2 ||
+      functor_list[0] != "gelu" || functor_list[1] != "elementwise_add") {
+    return false;
+  }
+  const auto &x_dims = x.dims();
+  const auto &y_dims = y.dims();
+  int rank_diff = x_dims.size() - y_dims.size();
+  if (y.numel() == 0 || rank_diff < 0 || (axis != -1 && axis != rank_diff)) {
+    return false;
+  }
+  for (int i = 0; i < y_dims.size(); ++i) {
+    if (x_dims[rank_diff + i] != y_dims[i]) {
+      return false;
+    }
+  }
+  int n = static_cast<int>(y.numel());
+  int64_t rows = x.numel() / n;
+  auto add_gelu =
+      phi::jit::KernelFuncs<phi::jit::VAddGeluTuple<T>, phi::CPUPlace>::Cache()
+          .At(n);
+  const T *x_data = x.data<T>();
+  const T *y_data = y.data<T>();
+  T *out_data = dev_ctx.template Alloc<T>(out);
+  for (int64_t i = 0; i < rows; ++i) {
+    add_gelu(x_data + i * n, y_data, out_data + i * n, n);
+  }
+  return true;
+}
+
+template <typename T, typename Context>
+void FusedElemwiseActivationCPUKernel(
+    const Context &dev_ctx,
+    const DenseTensor &x,
+    const DenseTensor &y,
+    const std::vector<std::string> &functor_list,
+    int axis,
+    float scale,
+    bool save_intermediate_out,
+    DenseTensor *out,
+    DenseTensor *intermediate_out) {
+  if (AddGeluByJit<T, Context>(
+          dev_ctx, x, y, functor_list, axis, save_intermediate_out, out)) {
+    return;
+  }
+  FusedElemwiseActivationKernel<T, Context>(dev_ctx,
+                                            x,
+                                            y,
+                                            functor_list,
+                                            axis,
+                                            scale,
+                                            save_intermediate_out,
+                                            out,
+                                            intermediate_out);
+}
+
+}  // namespace fusion
+}  // namespace phi
+
 PD_REGISTER_KERNEL(fused_elemwise_activation,
                    CPU,
                    ALL_LAYOUT,
-                   phi::FusedElemwiseActivationKernel,
+                   phi::fusion::FusedElemwiseActivationCPUKernel,
                    float,
                    double) {}
 
 PD_REGISTER_KERNEL(fused_elemwise_add_activation,
                    CPU,
                    ALL_LAYOUT,
-                   phi::FusedElemwiseAddActivationKernel,
+                   phi::fusion::FusedElemwiseActivationCPUKernel,
                    float,
                    double) {}
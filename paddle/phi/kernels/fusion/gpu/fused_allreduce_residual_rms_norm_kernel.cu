@@ -0,0 +1,190 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "paddle/common/ddim.h"
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/empty_kernel.h"
+#include "paddle/phi/kernels/rms_norm_kernel.h"
+
+#if defined(PADDLE_WITH_NCCL)
+#include "paddle/phi/core/cuda_stream.h"
+#include "paddle/phi/core/distributed/nccl_comm_context.h"
+#endif
+
+namespace phi {
+namespace fusion {
+
+#if defined(PADDLE_WITH_NCCL)
+// Messages up to this size are reduced in one chunk, e.g. the hidden states
+// of a decode step, where splitting only adds the latency of more launches.
+constexpr int64_t kAllReduceOneChunkBytes = 1 << 20;
+// The number of chunks of the larger messages, so that the norm of a chunk
+// overlaps the all-reduce of the next one.
+constexpr int64_t kAllReduceMaxChunks = 4;
+
+// The side stream the chunks are reduced on and the events the compute
+// stream waits for, one set per device and thread.
+struct AllReduceOverlapResource {
+  std::unique_ptr<phi::CUDAStream> stream;
+  cudaEvent_t input_ready = nullptr;
+  std::vector<cudaEvent_t> chunk_done;
+};
+
+static AllReduceOverlapResource* GetAllReduceOverlapResource(
+    const phi::GPUContext& dev_ctx, size_t num_chunks) {
+  thread_local std::unordered_map<int, AllReduceOverlapResource> resources;
+  auto& res = resources[dev_ctx.GetPlace().GetDeviceId()];
+  if (res.stream == nullptr) {
+    res.stream = std::make_unique<phi::CUDAStream>(
+        dev_ctx.GetPlace(),
+        0,
+        phi::CUDAStream::StreamFlag::kStreamNonBlocking);
+    PADDLE_ENFORCE_GPU_SUCCESS(
+        cudaEventCreateWithFlags(&res.input_ready, cudaEventDisableTiming));
+  }
+  while (res.chunk_done.size() < num_chunks) {
+    cudaEvent_t event;
+    PADDLE_ENFORCE_GPU_SUCCESS(
+        cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+    res.chunk_done.push_back(event);
+  }
+  return &res;
+}
+#endif
+
+// All-reduce x across the ranks of ring_id, then out = rms_norm(x +
+// residual) and residual_out = x + residual. The rows are reduced in chunks
+// on a side stream, and the norm of each chunk runs on the compute stream as
+// soon as its chunk arrives.
+template <typename T, typename Context>
+void FusedAllReduceResidualRmsNormKernel(
+    const Context& dev_ctx,
+    const DenseTensor& x,
+    const DenseTensor& residual,
+    const DenseTensor& norm_weight,
+    const paddle::optional<DenseTensor>& norm_bias,
+    int ring_id,
+    float epsilon,
+    int begin_norm_axis,
+    int chunk_rows,
+    DenseTensor* out,
+    DenseTensor* residual_out) {
+#if defined(PADDLE_WITH_NCCL)
+  auto comm_ctx =
+      static_cast<distributed::NCCLCommContext*>(dev_ctx.GetCommContext());
+  PADDLE_ENFORCE_NE(
+      comm_ctx,
+      nullptr,
+      errors::Unavailable("NCCLCommContext is nullptr, collective op should "
+                          "has ring_id attr."));
+
+  const auto& x_dims = x.dims();
+  const int64_t rows =
+      common::product(common::slice_ddim(x_dims, 0, begin_norm_axis));
+  const int64_t cols = x.numel() / rows;
+  T* out_data = dev_ctx.template Alloc<T>(out);
+  T* residual_out_data = dev_ctx.template Alloc<T>(residual_out);
+  if (x.numel() == 0) {
+    return;
+  }
+
+  int64_t rows_per_chunk = chunk_rows;
+  if (rows_per_chunk <= 0) {
+    rows_per_chunk =
+        x.numel() * static_cast<int64_t>(sizeof(T)) <= kAllReduceOneChunkBytes
+            ? rows
+            : (rows + kAllReduceMaxChunks - 1) / kAllReduceMaxChunks;
+  }
+  rows_per_chunk = std::min(rows_per_chunk, rows);
+  const int64_t num_chunks = (rows + rows_per_chunk - 1) / rows_per_chunk;
+
+  DenseTensor x_2d = x;
+  x_2d.Resize({rows, cols});
+  DenseTensor reduced = phi::Empty<T, Context>(dev_ctx, {rows, cols});
+  const T* bias_data = norm_bias ? norm_bias->data<T>() : nullptr;
+  auto rms_norm_rows = [&](int64_t begin, int64_t end) {
+    const int64_t offset = begin * cols;
+    ResidualAddRmsNormWrapper<T, Context>(dev_ctx,
+                                          reduced.data<T>() + offset,
+                                          residual.data<T>() + offset,
+                                          nullptr,
+                                          norm_weight.data<T>(),
+                                          bias_data,
+                                          epsilon,
+                                          static_cast<int>(end - begin),
+                                          static_cast<int>(cols),
+                                          residual_out_data + offset,
+                                          out_data + offset);
+  };
+
+  gpuStream_t stream = dev_ctx.stream();
+  if (num_chunks == 1) {
+    comm_ctx->AllReduce(&reduced, x_2d, ncclSum, stream);
+    rms_norm_rows(0, rows);
+    return;
+  }
+
+  auto* res = GetAllReduceOverlapResource(dev_ctx, num_chunks);
+  gpuStream_t comm_stream = res->stream->raw_stream();
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaEventRecord(res->input_ready, stream));
+  PADDLE_ENFORCE_GPU_SUCCESS(
+      cudaStreamWaitEvent(comm_stream, res->input_ready, 0));
+  for (int64_t i = 0; i < num_chunks; ++i) {
+    int64_t begin = i * rows_per_chunk;
+    int64_t end = std::min(begin + rows_per_chunk, rows);
+    DenseTensor reduced_chunk = reduced.Slice(begin, end);
+    comm_ctx->AllReduce(
+        &reduced_chunk, x_2d.Slice(begin, end), ncclSum, comm_stream);
+    PADDLE_ENFORCE_GPU_SUCCESS(
+        cudaEventRecord(res->chunk_done[i], comm_stream));
+  }
+  for (int64_t i = 0; i < num_chunks; ++i) {
+    int64_t begin = i * rows_per_chunk;
+    int64_t end = std::min(begin + rows_per_chunk, rows);
+    PADDLE_ENFORCE_GPU_SUCCESS(
+        cudaStreamWaitEvent(stream, res->chunk_done[i], 0));
+    rms_norm_rows(begin, end);
+  }
+#else
+  PADDLE_THROW(common::errors::PreconditionNotMet(
+      "PaddlePaddle should compile with NCCL to use "
+      "fused_allreduce_residual_rms_norm."));
+#endif
+}
+
+}  // namespace fusion
+}  // namespace phi
+
+#if NCCL_VERSION_CODE >= 21000
+PD_REGISTER_KERNEL(fused_allreduce_residual_rms_norm,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::fusion::FusedAllReduceResidualRmsNormKernel,
+                   float,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {}
+#else
+PD_REGISTER_KERNEL(fused_allreduce_residual_rms_norm,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::fusion::FusedAllReduceResidualRmsNormKernel,
+                   float,
+                   phi::dtype::float16) {}
+#endif
@@ -0,0 +1,113 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "paddle/phi/backends/gpu/gpu_helper.h"
+#include "paddle/phi/backends/gpu/gpu_launch_config.h"
+#include "paddle/phi/backends/gpu/gpu_primitives.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/funcs/math_function.h"
+#include "paddle/phi/kernels/fusion/gpu/fused_embedding_seq_pool_utils.h"
+
+namespace phi {
+namespace fusion {
+
+// Each thread scatters one column of the grad of the pooled embedding of one
+// instance of one slot to the rows of its ids, for all the slots at once.
+template <typename T>
+__global__ void FusedEmbeddingSeqPoolBackward(const size_t N,
+                                              const int64_t* const* ids,
+                                              const size_t* offsets,
+                                              const T* const* out_grads,
+                                              T* w_grad,
+                                              const int batch_size,
+                                              const int64_t dim,
+                                              const EmbeddingSeqPoolType type) {
+  CUDA_KERNEL_LOOP_TYPE(i, N, size_t) {
+    size_t key = i / dim;
+    int64_t offset = i % dim;
+    size_t x = key / batch_size;  // slot id
+    size_t y = key % batch_size;  // ins id
+    const size_t* lod = offsets + x * (batch_size + 1);
+    size_t start = lod[y];
+    size_t end = lod[y + 1];
+
+    T val = out_grads[x][y * dim + offset] *
+            EmbeddingSeqPoolScale<T>(type, end - start);
+    for (size_t k = start; k < end; ++k) {
+      phi::CudaAtomicAdd(w_grad + ids[x][k] * dim + offset, val);
+    }
+  }
+}
+
+template <typename T, typename Context>
+void FusedEmbeddingSeqPoolGradKernel(
+    const Context& dev_ctx,
+    const std::vector<const DenseTensor*>& ids,
+    const DenseTensor& w,
+    const std::vector<const DenseTensor*>& out_grad,
+    const std::string& pooltype,
+    DenseTensor* w_grad) {
+  EmbeddingSeqPoolType type = GetEmbeddingSeqPoolType(pooltype);
+  const size_t slot_num = ids.size();
+  const int64_t dim = w.dims()[1];
+
+  w_grad->Resize(w.dims());
+  dev_ctx.template Alloc<T>(w_grad);
+  phi::funcs::SetConstant<Context, T>()(dev_ctx, w_grad, static_cast<T>(0));
+
+  EmbeddingSeqPoolSlots slots = CopyEmbeddingSeqPoolSlots(dev_ctx, ids);
+  size_t N = static_cast<size_t>(slots.batch_size) * slot_num * dim;
+  if (N == 0) {
+    return;
+  }
+  std::vector<const T*> out_grads_data(slot_num);
+  for (size_t i = 0; i < slot_num; ++i) {
+    out_grads_data[i] = out_grad[i]->data<T>();
+  }
+  auto out_grads_holder = phi::memory_utils::AllocShared(
+      dev_ctx.GetPlace(), slot_num * sizeof(T*));
+  phi::memory_utils::Copy(dev_ctx.GetPlace(),
+                          out_grads_holder->ptr(),
+                          phi::CPUPlace(),
+                          out_grads_data.data(),
+                          slot_num * sizeof(T*),
+                          dev_ctx.stream());
+
+  auto config = phi::backends::gpu::GetGpuLaunchConfig1D(dev_ctx, N);
+  FusedEmbeddingSeqPoolBackward<T><<<config.block_per_grid.x,
+                                     config.thread_per_block.x,
+                                     0,
+                                     dev_ctx.stream()>>>(
+      N,
+      slots.ids,
+      slots.offsets,
+      reinterpret_cast<const T* const*>(out_grads_holder->ptr()),
+      w_grad->data<T>(),
+      slots.batch_size,
+      dim,
+      type);
+}
+
+}  // namespace fusion
+}  // namespace phi
+
+PD_REGISTER_KERNEL(fused_embedding_seq_pool_grad,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::fusion::FusedEmbeddingSeqPoolGradKernel,
+                   float,
+                   double) {}
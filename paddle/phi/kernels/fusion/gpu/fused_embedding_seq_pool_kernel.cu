@@ -0,0 +1,107 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "paddle/phi/backends/gpu/gpu_helper.h"
+#include "paddle/phi/backends/gpu/gpu_launch_config.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/fusion/gpu/fused_embedding_seq_pool_utils.h"
+
+namespace phi {
+namespace fusion {
+
+// Each thread computes one column of the pooled embedding of one instance
+// of one slot.
+template <typename T>
+__global__ void FusedEmbeddingSeqPoolForward(const size_t N,
+                                             const int64_t* const* ids,
+                                             const size_t* offsets,
+                                             const T* w,
+                                             T** outs,
+                                             const int batch_size,
+                                             const int64_t dim,
+                                             const EmbeddingSeqPoolType type) {
+  CUDA_KERNEL_LOOP_TYPE(i, N, size_t) {
+    size_t key = i / dim;
+    int64_t offset = i % dim;
+    size_t x = key / batch_size;  // slot id
+    size_t y = key % batch_size;  // ins id
+    const size_t* lod = offsets + x * (batch_size + 1);
+    size_t start = lod[y];
+    size_t end = lod[y + 1];
+
+    T val = static_cast<T>(0);
+    for (size_t k = start; k < end; ++k) {
+      val += w[ids[x][k] * dim + offset];
+    }
+    outs[x][y * dim + offset] =
+        val * EmbeddingSeqPoolScale<T>(type, end - start);
+  }
+}
+
+template <typename T, typename Context>
+void FusedEmbeddingSeqPoolKernel(const Context& dev_ctx,
+                                 const std::vector<const DenseTensor*>& ids,
+                                 const DenseTensor& w,
+                                 const std::string& pooltype,
+                                 std::vector<DenseTensor*> out) {
+  EmbeddingSeqPoolType type = GetEmbeddingSeqPoolType(pooltype);
+  const size_t slot_num = ids.size();
+  const int64_t dim = w.dims()[1];
+  EmbeddingSeqPoolSlots slots = CopyEmbeddingSeqPoolSlots(dev_ctx, ids);
+
+  std::vector<T*> outs_data(slot_num);
+  for (size_t i = 0; i < slot_num; ++i) {
+    out[i]->Resize({slots.batch_size, dim});
+    outs_data[i] = dev_ctx.template Alloc<T>(out[i]);
+  }
+  size_t N = static_cast<size_t>(slots.batch_size) * slot_num * dim;
+  if (N == 0) {
+    return;
+  }
+  auto outs_holder =
+      phi::memory_utils::AllocShared(dev_ctx.GetPlace(), slot_num * sizeof(T*));
+  phi::memory_utils::Copy(dev_ctx.GetPlace(),
+                          outs_holder->ptr(),
+                          phi::CPUPlace(),
+                          outs_data.data(),
+                          slot_num * sizeof(T*),
+                          dev_ctx.stream());
+
+  auto config = phi::backends::gpu::GetGpuLaunchConfig1D(dev_ctx, N);
+  FusedEmbeddingSeqPoolForward<T><<<config.block_per_grid.x,
+                                    config.thread_per_block.x,
+                                    0,
+                                    dev_ctx.stream()>>>(
+      N,
+      slots.ids,
+      slots.offsets,
+      w.data<T>(),
+      reinterpret_cast<T**>(outs_holder->ptr()),
+      slots.batch_size,
+      dim,
+      type);
+}
+
+}  // namespace fusion
+}  // namespace phi
+
+PD_REGISTER_KERNEL(fused_embedding_seq_pool,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::fusion::FusedEmbeddingSeqPoolKernel,
+                   float,
+                   double) {}
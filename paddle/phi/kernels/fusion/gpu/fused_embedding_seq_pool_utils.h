@@ -0,0 +1,137 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/common/memory_utils.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/enforce.h"
+
+namespace phi {
+namespace fusion {
+
+enum class EmbeddingSeqPoolType { kSum = 0, kAverage = 1, kSqrt = 2 };
+
+static inline EmbeddingSeqPoolType GetEmbeddingSeqPoolType(
+    const std::string& pooltype) {
+  if (pooltype == "SUM") {
+    return EmbeddingSeqPoolType::kSum;
+  } else if (pooltype == "AVERAGE") {
+    return EmbeddingSeqPoolType::kAverage;
+  } else if (pooltype == "SQRT") {
+    return EmbeddingSeqPoolType::kSqrt;
+  }
+  PADDLE_THROW(common::errors::InvalidArgument(
+      "Unsupported pooltype of fused_embedding_seq_pool: %s. Only support "
+      "\"SUM\", \"AVERAGE\" and \"SQRT\".",
+      pooltype));
+}
+
+// The scale of the sum of a sequence of len ids.
+template <typename T>
+__device__ __forceinline__ T EmbeddingSeqPoolScale(EmbeddingSeqPoolType type,
+                                                   size_t len) {
+  if (len == 0 || type == EmbeddingSeqPoolType::kSum) {
+    return static_cast<T>(1);
+  }
+  if (type == EmbeddingSeqPoolType::kAverage) {
+    return static_cast<T>(1) / static_cast<T>(len);
+  }
+  return static_cast<T>(1) / sqrt(static_cast<T>(len));
+}
+
+// The slots on the device: the pointers to the ids of all the slots, and the
+// instance offsets of all the slots one after the other, batch_size + 1 per
+// slot, so that one kernel covers all the slots.
+struct EmbeddingSeqPoolSlots {
+  std::shared_ptr<phi::Allocation> holder;
+  const int64_t* const* ids = nullptr;
+  const size_t* offsets = nullptr;
+  int batch_size = 0;
+};
+
+// The instance offsets come from the lod of the ids, e.g. the slot offsets
+// of MiniBatchGpuPack, or one id per instance when the ids have no lod.
+static inline EmbeddingSeqPoolSlots CopyEmbeddingSeqPoolSlots(
+    const phi::GPUContext& dev_ctx,
+    const std::vector<const DenseTensor*>& ids) {
+  const size_t slot_num = ids.size();
+  EmbeddingSeqPoolSlots slots;
+  slots.batch_size = -1;
+  std::vector<const int64_t*> ids_data(slot_num);
+  std::vector<size_t> offsets;
+  for (size_t i = 0; i < slot_num; ++i) {
+    PADDLE_ENFORCE_EQ(
+        ids[i]->dtype(),
+        phi::DataType::INT64,
+        common::errors::InvalidArgument(
+            "The ids of fused_embedding_seq_pool should be int64, but the "
+            "ids of slot %d are %s.",
+            i,
+            ids[i]->dtype()));
+    int cur_batch_size = ids[i]->lod().empty()
+                             ? static_cast<int>(ids[i]->dims()[0])
+                             : static_cast<int>(ids[i]->lod()[0].size() - 1);
+    if (slots.batch_size == -1) {
+      slots.batch_size = cur_batch_size;
+    } else {
+      PADDLE_ENFORCE_EQ(slots.batch_size,
+                        cur_batch_size,
+                        common::errors::PreconditionNotMet(
+                            "The batch size of all slots should be same, "
+                            "please check, last batch_size is %d, current "
+                            "batch_size is %d",
+                            slots.batch_size,
+                            cur_batch_size));
+    }
+    if (ids[i]->lod().empty()) {
+      for (int j = 0; j <= cur_batch_size; ++j) {
+        offsets.push_back(j);
+      }
+    } else {
+      const auto& lod = ids[i]->lod()[0];
+      offsets.insert(offsets.end(), lod.begin(), lod.end());
+    }
+    ids_data[i] = ids[i]->data<int64_t>();
+  }
+
+  size_t ids_bytes = slot_num * sizeof(int64_t*);
+  size_t offsets_bytes = offsets.size() * sizeof(size_t);
+  slots.holder = phi::memory_utils::AllocShared(dev_ctx.GetPlace(),
+                                                ids_bytes + offsets_bytes);
+  char* ptr = reinterpret_cast<char*>(slots.holder->ptr());
+  phi::memory_utils::Copy(dev_ctx.GetPlace(),
+                          ptr,
+                          phi::CPUPlace(),
+                          ids_data.data(),
+                          ids_bytes,
+                          dev_ctx.stream());
+  phi::memory_utils::Copy(dev_ctx.GetPlace(),
+                          ptr + ids_bytes,
+                          phi::CPUPlace(),
+                          offsets.data(),
+                          offsets_bytes,
+                          dev_ctx.stream());
+  slots.ids = reinterpret_cast<const int64_t* const*>(ptr);
+  slots.offsets = reinterpret_cast<const size_t*>(ptr + ids_bytes);
+  return slots;
+}
+
+}  // namespace fusion
+}  // namespace phi
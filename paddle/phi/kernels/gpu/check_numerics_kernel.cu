@@ -500,6 +500,51 @@ void CheckNumericsKernel(const Context& ctx,
   }
 }
 
+// Each thread which finds a NAN or INF writes the same value, so that no
+// atomic is needed.
+template <typename T, typename MT>
+__global__ void MarkNanInfKernel(const T* value_ptr,
+                                 const int64_t numel,
+                                 int* flag) {
+  bool has_nan_inf = false;
+  int64_t stride = static_cast<int64_t>(blockDim.x) * gridDim.x;
+  for (int64_t i = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+       i < numel;
+       i += stride) {
+    MT value = static_cast<MT>(value_ptr[i]);
+    if (isnan(value) || isinf(value)) {
+      has_nan_inf = true;
+    }
+  }
+  if (has_nan_inf) {
+    *flag = 1;
+  }
+}
+
+template <typename T, typename Context>
+void MarkNanInf(const Context& ctx, const DenseTensor& tensor, int* flag) {
+  if (tensor.numel() <= 0) return;
+
+  using MT = typename phi::dtype::MPTypeTrait<T>::Type;
+  const size_t threads = 1024;
+  size_t blocks =
+      std::min(static_cast<size_t>(128),
+               static_cast<size_t>((tensor.numel() + threads - 1) / threads));
+  MarkNanInfKernel<T, MT><<<blocks, threads, 0, ctx.stream()>>>(
+      tensor.data<T>(), tensor.numel(), flag);
+}
+
+template void MarkNanInf<float, GPUContext>(const GPUContext& ctx,
+                                            const DenseTensor& tensor,
+                                            int* flag);
+template void MarkNanInf<double, GPUContext>(const GPUContext& ctx,
+                                             const DenseTensor& tensor,
+                                             int* flag);
+template void MarkNanInf<phi::dtype::float16, GPUContext>(
+    const GPUContext& ctx, const DenseTensor& tensor, int* flag);
+template void MarkNanInf<phi::dtype::bfloat16, GPUContext>(
+    const GPUContext& ctx, const DenseTensor& tensor, int* flag);
+
 }  // namespace phi
 
 PD_REGISTER_KERNEL(check_numerics,
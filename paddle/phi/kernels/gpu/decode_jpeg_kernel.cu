@@ -16,6 +16,8 @@
 
 #include "paddle/phi/kernels/decode_jpeg_kernel.h"
 
+#include <mutex>
+
 #include "paddle/phi/backends/dynload/nvjpeg.h"
 #include "paddle/phi/backends/gpu/gpu_context.h"
 #include "paddle/phi/backends/stream.h"
@@ -23,8 +25,11 @@
 
 namespace phi {
 
-static cudaStream_t nvjpeg_stream = nullptr;
+// NOTE: the handle and the state are shared by all the calls, and the mutex
+// serializes the calls since a state can't be used by several decodes at once.
 static nvjpegHandle_t nvjpeg_handle = nullptr;
+static nvjpegJpegState_t nvjpeg_state = nullptr;
+static std::mutex nvjpeg_mutex;
 
 void InitNvjpegImage(nvjpegImage_t* img) {
   for (int c = 0; c < NVJPEG_MAX_COMPONENT; c++) {
@@ -38,6 +43,7 @@ void DecodeJpegKernel(const Context& dev_ctx,
                       const DenseTensor& x,
                       const std::string& mode,
                       DenseTensor* out) {
+  std::lock_guard<std::mutex> guard(nvjpeg_mutex);
   // Create nvJPEG handle
   if (nvjpeg_handle == nullptr) {
     nvjpegStatus_t create_status =
@@ -49,14 +55,15 @@ void DecodeJpegKernel(const Context& dev_ctx,
         errors::Fatal("nvjpegCreateSimple failed: ", create_status));
   }
 
-  nvjpegJpegState_t nvjpeg_state;
-  nvjpegStatus_t state_status =
-      phi::dynload::nvjpegJpegStateCreate(nvjpeg_handle, &nvjpeg_state);
+  if (nvjpeg_state == nullptr) {
+    nvjpegStatus_t state_status =
+        phi::dynload::nvjpegJpegStateCreate(nvjpeg_handle, &nvjpeg_state);
 
-  PADDLE_ENFORCE_EQ(
-      state_status,
-      NVJPEG_STATUS_SUCCESS,
-      errors::Fatal("nvjpegJpegStateCreate failed: ", state_status));
+    PADDLE_ENFORCE_EQ(
+        state_status,
+        NVJPEG_STATUS_SUCCESS,
+        errors::Fatal("nvjpegJpegStateCreate failed: ", state_status));
+  }
 
   int components;
   nvjpegChromaSubsampling_t subsampling;
@@ -91,7 +98,6 @@ void DecodeJpegKernel(const Context& dev_ctx,
       output_format = NVJPEG_OUTPUT_RGB;
       output_components = 3;
     } else {
-      phi::dynload::nvjpegJpegStateDestroy(nvjpeg_state);
       PADDLE_THROW(errors::Fatal(
           "The provided mode is not supported for JPEG files on GPU"));
     }
@@ -102,7 +108,6 @@ void DecodeJpegKernel(const Context& dev_ctx,
     output_format = NVJPEG_OUTPUT_RGB;
     output_components = 3;
   } else {
-    phi::dynload::nvjpegJpegStateDestroy(nvjpeg_state);
     PADDLE_THROW(errors::Fatal(
         "The provided mode is not supported for JPEG files on GPU"));
   }
@@ -110,11 +115,6 @@ void DecodeJpegKernel(const Context& dev_ctx,
   nvjpegImage_t out_image;
   InitNvjpegImage(&out_image);
 
-  // create nvjpeg stream
-  if (nvjpeg_stream == nullptr) {
-    cudaStreamCreateWithFlags(&nvjpeg_stream, cudaStreamNonBlocking);
-  }
-
   int sz = widths[0] * heights[0];
 
   std::vector<int64_t> out_shape = {output_components, height, width};
@@ -133,7 +133,13 @@ void DecodeJpegKernel(const Context& dev_ctx,
                                                             x.numel(),
                                                             output_format,
                                                             &out_image,
-                                                            nvjpeg_stream);
+                                                            dev_ctx.stream());
+  // NOTE: decoding on the stream of the context orders the output before its
+  // consumers, and the decode of a data stage overlaps the training when the
+  // stage runs on its own stream.
+  PADDLE_ENFORCE_EQ(decode_status,
+                    NVJPEG_STATUS_SUCCESS,
+                    errors::Fatal("nvjpegDecode failed: ", decode_status));
 }
 }  // namespace phi
 
@@ -107,6 +107,9 @@ struct EmbeddingGradCUDAFunctor {
       if (FLAGS_embedding_deterministic == 1) {
         phi::funcs::LaunchEmbeddingGradDeterministicKernel<T, IdT>(
             dev_ctx_, ids, d_output, d_table, N, D, K);
+      } else if (FLAGS_embedding_deterministic == 3) {
+        phi::funcs::LaunchEmbeddingGradSortedKernel<T, IdT>(
+            dev_ctx_, ids, d_output, d_table, N, D, K);
       } else {
         const int gridx = 2 * dev_ctx_.GetSMCount();
         dim3 threads(128, 8);
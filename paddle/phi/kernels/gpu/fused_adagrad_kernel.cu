@@ -0,0 +1,178 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/fused_adagrad_kernel.h"
+#include <vector>
+#include "glog/logging.h"
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/common/amp_type_traits.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/funcs/multi_tensor_apply.h"
+
+namespace phi {
+
+template <typename T,
+          typename MT,
+          bool IsMultiPrecision,
+          int N,
+          int MaxTensorSize,
+          int MaxBlockSize>
+struct FusedAdagradFunctor {
+  __device__ __forceinline__ void operator()(
+      int chunk_size,
+      const funcs::TensorAndBlockInfo<N, MaxTensorSize, MaxBlockSize>& t_info,
+      const MT* learning_rate,
+      MT epsilon,
+      const bool* found_inf,
+      const float* scale) const {
+    if (found_inf != nullptr && *found_inf) {
+      return;
+    }
+    MT lr = *learning_rate;
+    MT inv_scale = scale != nullptr
+                       ? static_cast<MT>(1.0) / static_cast<MT>(*scale)
+                       : static_cast<MT>(1.0);
+    T* __restrict__ p_ptr;
+    const T* __restrict__ g_ptr;
+    MT* __restrict__ mom_ptr;
+    MT* __restrict__ mp_ptr;
+    int n;
+
+    {
+      int chunk_id, tensor_id;
+      t_info.GetChunkIdAndTensorId(&chunk_id, &tensor_id);
+
+      n = t_info.sizes[tensor_id];
+      int offset = chunk_id * chunk_size;
+      g_ptr = static_cast<const T*>(t_info.grads[tensor_id]) + offset;
+      p_ptr = static_cast<T*>(t_info.tensor_addrs[0][tensor_id]) + offset;
+      mom_ptr = static_cast<MT*>(t_info.tensor_addrs[1][tensor_id]) + offset;
+      mp_ptr = IsMultiPrecision
+                   ? static_cast<MT*>(t_info.tensor_addrs[2][tensor_id]) +
+                         offset
+                   : nullptr;
+
+      n -= offset;
+      if (n > chunk_size) {
+        n = chunk_size;
+      }
+    }
+
+    for (int idx = threadIdx.x; idx < n; idx += blockDim.x) {
+      MT g = static_cast<MT>(g_ptr[idx]) * inv_scale;
+      MT mom = mom_ptr[idx] + g * g;
+      MT p = IsMultiPrecision ? mp_ptr[idx] : static_cast<MT>(p_ptr[idx]);
+      p -= lr * g / (sqrt(mom) + epsilon);
+      mom_ptr[idx] = mom;
+      if (IsMultiPrecision) {
+        mp_ptr[idx] = p;
+      }
+      p_ptr[idx] = static_cast<T>(p);
+    }
+  }
+};
+
+template <typename T, typename Context>
+void FusedAdagradKernel(
+    const Context& dev_ctx,
+    const std::vector<const DenseTensor*>& params,
+    const std::vector<const DenseTensor*>& grads,
+    const DenseTensor& learning_rate,
+    const std::vector<const DenseTensor*>& moments,
+    const paddle::optional<std::vector<const DenseTensor*>>& master_params,
+    const paddle::optional<DenseTensor>& found_inf,
+    const paddle::optional<DenseTensor>& scale,
+    float epsilon,
+    int chunk_size,
+    bool multi_precision,
+    std::vector<DenseTensor*> params_out,
+    std::vector<DenseTensor*> moments_out,
+    std::vector<DenseTensor*> master_params_out) {
+  using MPDType = typename phi::dtype::MPTypeTrait<T>::Type;
+
+  funcs::CopyTensorIfDifferent(dev_ctx, params, params_out);
+  funcs::CopyTensorIfDifferent(dev_ctx, moments, moments_out);
+  if (master_params) {
+    funcs::CopyTensorIfDifferent(
+        dev_ctx, master_params.get(), master_params_out);
+  }
+
+  // found_inf and scale are read in the kernel to avoid the synchronization
+  const bool* found_inf_data =
+      found_inf.is_initialized() ? found_inf->data<bool>() : nullptr;
+  const float* scale_data =
+      scale.is_initialized() ? scale->data<float>() : nullptr;
+
+  std::vector<std::vector<DenseTensor*>> input_vector;
+  input_vector.reserve(3);
+  input_vector.push_back(params_out);
+  input_vector.push_back(moments_out);
+  if (multi_precision) {
+    input_vector.push_back(master_params_out);
+  }
+
+  VLOG(4) << "multi_precision: " << multi_precision;
+
+#define PD_LAUNCH_MULTI_TENSOR_APPLY_ADAGRAD_KERNEL(__multi_precision) \
+  do {                                                                 \
+    constexpr int kInputNum = __multi_precision ? 4 : 3;               \
+    constexpr int kMaxTensorSize = 60;                                 \
+    constexpr int kMaxBlockSize = 320;                                 \
+    constexpr int kBlockSize = 512;                                    \
+    FusedAdagradFunctor<T,                                             \
+                        MPDType,                                       \
+                        __multi_precision,                             \
+                        kInputNum,                                     \
+                        kMaxTensorSize,                                \
+                        kMaxBlockSize>                                 \
+        functor;                                                       \
+    funcs::LaunchMultiTensorApplyKernel<kInputNum,                     \
+                                        kMaxTensorSize,                \
+                                        kMaxBlockSize>(                \
+        dev_ctx,                                                       \
+        kBlockSize,                                                    \
+        chunk_size,                                                    \
+        input_vector,                                                  \
+        grads,                                                         \
+        functor,                                                       \
+        learning_rate.data<MPDType>(),                                 \
+        static_cast<MPDType>(epsilon),                                 \
+        found_inf_data,                                                \
+        scale_data);                                                   \
+  } while (0)
+
+  if (multi_precision) {
+    PD_LAUNCH_MULTI_TENSOR_APPLY_ADAGRAD_KERNEL(true);
+  } else {
+    PD_LAUNCH_MULTI_TENSOR_APPLY_ADAGRAD_KERNEL(false);
+  }
+#undef PD_LAUNCH_MULTI_TENSOR_APPLY_ADAGRAD_KERNEL
+}
+
+}  // namespace phi
+
+PD_REGISTER_KERNEL(fused_adagrad,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::FusedAdagradKernel,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16,
+                   float,
+                   double) {
+  kernel->InputAt(5).SetDataType(phi::DataType::BOOL);
+  kernel->InputAt(6).SetDataType(phi::DataType::FLOAT32);
+  kernel->OutputAt(1).SetDataType(phi::DataType::UNDEFINED);
+  kernel->OutputAt(2).SetDataType(phi::DataType::UNDEFINED);
+}
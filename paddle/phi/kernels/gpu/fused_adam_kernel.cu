@@ -279,20 +279,6 @@ __global__ void UpdateBetaPowGroup(
   }
 }
 
-template <typename Context>
-static void CopyTensorIfDifferent(const Context& dev_ctx,
-                                  const std::vector<const DenseTensor*>& src,
-                                  const std::vector<DenseTensor*>& dst,
-                                  bool use_src_place = false) {
-  for (size_t i = 0; i < src.size(); ++i) {
-    if (src[i] != dst[i]) {
-      VLOG(10) << "Copy Tensor " << i;
-      phi::Place place = (use_src_place ? src[i]->place() : dev_ctx.GetPlace());
-      phi::Copy<Context>(dev_ctx, *(src[i]), place, false, dst[i]);
-    }
-  }
-}
-
 template <typename T, typename TensorT>
 static int GetVecSizeFromTensors(const std::vector<TensorT*>& tensors,
                                  int vec_size = 4) {
@@ -358,16 +344,17 @@ void FusedAdamKernel(
 
   VLOG(4) << "use_global_beta_pow:" << use_global_beta_pow;
 
-  CopyTensorIfDifferent(dev_ctx, params, params_out);
-  CopyTensorIfDifferent(dev_ctx, moments1, moments1_out);
-  CopyTensorIfDifferent(dev_ctx, moments2, moments2_out);
+  funcs::CopyTensorIfDifferent(dev_ctx, params, params_out);
+  funcs::CopyTensorIfDifferent(dev_ctx, moments1, moments1_out);
+  funcs::CopyTensorIfDifferent(dev_ctx, moments2, moments2_out);
   if (amsgrad) {
-    CopyTensorIfDifferent(dev_ctx, moments2_max.get(), moments2_max_out);
+    funcs::CopyTensorIfDifferent(dev_ctx, moments2_max.get(), moments2_max_out);
   }
-  CopyTensorIfDifferent(dev_ctx, beta1_pows, beta1_pows_out, true);
-  CopyTensorIfDifferent(dev_ctx, beta2_pows, beta2_pows_out, true);
+  funcs::CopyTensorIfDifferent(dev_ctx, beta1_pows, beta1_pows_out, true);
+  funcs::CopyTensorIfDifferent(dev_ctx, beta2_pows, beta2_pows_out, true);
   if (master_params) {
-    CopyTensorIfDifferent(dev_ctx, master_params.get(), master_params_out);
+    funcs::CopyTensorIfDifferent(
+        dev_ctx, master_params.get(), master_params_out);
   }
 
   bool skip_update_value = false;
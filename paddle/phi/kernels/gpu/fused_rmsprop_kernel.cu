@@ -0,0 +1,237 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/fused_rmsprop_kernel.h"
+#include <vector>
+#include "glog/logging.h"
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/common/amp_type_traits.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/funcs/multi_tensor_apply.h"
+
+namespace phi {
+
+template <typename T,
+          typename MT,
+          bool IsMultiPrecision,
+          bool Centered,
+          int N,
+          int MaxTensorSize,
+          int MaxBlockSize>
+struct FusedRmspropFunctor {
+  __device__ __forceinline__ void operator()(
+      int chunk_size,
+      const funcs::TensorAndBlockInfo<N, MaxTensorSize, MaxBlockSize>& t_info,
+      const MT* learning_rate,
+      MT epsilon,
+      MT rho,
+      MT momentum,
+      const bool* found_inf,
+      const float* scale) const {
+    if (found_inf != nullptr && *found_inf) {
+      return;
+    }
+    MT lr = *learning_rate;
+    MT inv_scale = scale != nullptr
+                       ? static_cast<MT>(1.0) / static_cast<MT>(*scale)
+                       : static_cast<MT>(1.0);
+    T* __restrict__ p_ptr;
+    const T* __restrict__ g_ptr;
+    MT* __restrict__ ms_ptr;
+    MT* __restrict__ mom_ptr;
+    MT* __restrict__ mg_ptr;
+    MT* __restrict__ mp_ptr;
+    int n;
+
+    {
+      int chunk_id, tensor_id;
+      t_info.GetChunkIdAndTensorId(&chunk_id, &tensor_id);
+
+      n = t_info.sizes[tensor_id];
+      int offset = chunk_id * chunk_size;
+      g_ptr = static_cast<const T*>(t_info.grads[tensor_id]) + offset;
+      p_ptr = static_cast<T*>(t_info.tensor_addrs[0][tensor_id]) + offset;
+      ms_ptr = static_cast<MT*>(t_info.tensor_addrs[1][tensor_id]) + offset;
+      mom_ptr = static_cast<MT*>(t_info.tensor_addrs[2][tensor_id]) + offset;
+      mg_ptr = Centered
+                   ? static_cast<MT*>(t_info.tensor_addrs[3][tensor_id]) +
+                         offset
+                   : nullptr;
+      mp_ptr =
+          IsMultiPrecision
+              ? static_cast<MT*>(
+                    t_info.tensor_addrs[3 + (Centered ? 1 : 0)][tensor_id]) +
+                    offset
+              : nullptr;
+
+      n -= offset;
+      if (n > chunk_size) {
+        n = chunk_size;
+      }
+    }
+
+    MT l_rho = static_cast<MT>(1.0) - rho;
+    for (int idx = threadIdx.x; idx < n; idx += blockDim.x) {
+      MT g = static_cast<MT>(g_ptr[idx]) * inv_scale;
+      MT ms = rho * ms_ptr[idx] + l_rho * g * g;
+      MT denom;
+      if (Centered) {
+        MT mg = rho * mg_ptr[idx] + l_rho * g;
+        mg_ptr[idx] = mg;
+        denom = sqrt(ms - mg * mg + epsilon);
+      } else {
+        denom = sqrt(ms + epsilon);
+      }
+      MT mom = momentum * mom_ptr[idx] + lr * g / denom;
+      MT p = IsMultiPrecision ? mp_ptr[idx] : static_cast<MT>(p_ptr[idx]);
+      p -= mom;
+      ms_ptr[idx] = ms;
+      mom_ptr[idx] = mom;
+      if (IsMultiPrecision) {
+        mp_ptr[idx] = p;
+      }
+      p_ptr[idx] = static_cast<T>(p);
+    }
+  }
+};
+
+template <typename T, typename Context>
+void FusedRmspropKernel(
+    const Context& dev_ctx,
+    const std::vector<const DenseTensor*>& params,
+    const std::vector<const DenseTensor*>& grads,
+    const DenseTensor& learning_rate,
+    const std::vector<const DenseTensor*>& mean_squares,
+    const std::vector<const DenseTensor*>& moments,
+    const paddle::optional<std::vector<const DenseTensor*>>& mean_grads,
+    const paddle::optional<std::vector<const DenseTensor*>>& master_params,
+    const paddle::optional<DenseTensor>& found_inf,
+    const paddle::optional<DenseTensor>& scale,
+    float epsilon,
+    float decay,
+    float momentum,
+    int chunk_size,
+    bool centered,
+    bool multi_precision,
+    std::vector<DenseTensor*> params_out,
+    std::vector<DenseTensor*> moments_out,
+    std::vector<DenseTensor*> mean_squares_out,
+    std::vector<DenseTensor*> mean_grads_out,
+    std::vector<DenseTensor*> master_params_out) {
+  using MPDType = typename phi::dtype::MPTypeTrait<T>::Type;
+
+  funcs::CopyTensorIfDifferent(dev_ctx, params, params_out);
+  funcs::CopyTensorIfDifferent(dev_ctx, mean_squares, mean_squares_out);
+  funcs::CopyTensorIfDifferent(dev_ctx, moments, moments_out);
+  if (centered) {
+    PADDLE_ENFORCE_EQ(
+        mean_grads.is_initialized(),
+        true,
+        common::errors::InvalidArgument(
+            "Input(MeanGrads) must be provided when centered is true."));
+    funcs::CopyTensorIfDifferent(dev_ctx, mean_grads.get(), mean_grads_out);
+  }
+  if (master_params) {
+    funcs::CopyTensorIfDifferent(
+        dev_ctx, master_params.get(), master_params_out);
+  }
+
+  // found_inf and scale are read in the kernel to avoid the synchronization
+  const bool* found_inf_data =
+      found_inf.is_initialized() ? found_inf->data<bool>() : nullptr;
+  const float* scale_data =
+      scale.is_initialized() ? scale->data<float>() : nullptr;
+
+  std::vector<std::vector<DenseTensor*>> input_vector;
+  input_vector.reserve(5);
+  input_vector.push_back(params_out);
+  input_vector.push_back(mean_squares_out);
+  input_vector.push_back(moments_out);
+  if (centered) {
+    input_vector.push_back(mean_grads_out);
+  }
+  if (multi_precision) {
+    input_vector.push_back(master_params_out);
+  }
+
+  VLOG(4) << "centered: " << centered;
+  VLOG(4) << "multi_precision: " << multi_precision;
+
+#define PD_LAUNCH_MULTI_TENSOR_APPLY_RMSPROP_KERNEL(__multi_precision,  \
+                                                    __centered)         \
+  do {                                                                  \
+    constexpr int kInputNum =                                           \
+        (__multi_precision ? 5 : 4) + (__centered ? 1 : 0);             \
+    constexpr int kMaxTensorSize = kInputNum > 4 ? 48 : 60;             \
+    constexpr int kMaxBlockSize = 320;                                  \
+    constexpr int kBlockSize = 512;                                     \
+    FusedRmspropFunctor<T,                                              \
+                        MPDType,                                        \
+                        __multi_precision,                              \
+                        __centered,                                     \
+                        kInputNum,                                      \
+                        kMaxTensorSize,                                 \
+                        kMaxBlockSize>                                  \
+        functor;                                                        \
+    funcs::LaunchMultiTensorApplyKernel<kInputNum,                      \
+                                        kMaxTensorSize,                 \
+                                        kMaxBlockSize>(                 \
+        dev_ctx,                                                        \
+        kBlockSize,                                                     \
+        chunk_size,                                                     \
+        input_vector,                                                   \
+        grads,                                                          \
+        functor,                                                        \
+        learning_rate.data<MPDType>(),                                  \
+        static_cast<MPDType>(epsilon),                                  \
+        static_cast<MPDType>(decay),                                    \
+        static_cast<MPDType>(momentum),                                 \
+        found_inf_data,                                                 \
+        scale_data);                                                    \
+  } while (0)
+
+  if (multi_precision) {
+    if (centered) {
+      PD_LAUNCH_MULTI_TENSOR_APPLY_RMSPROP_KERNEL(true, true);
+    } else {
+      PD_LAUNCH_MULTI_TENSOR_APPLY_RMSPROP_KERNEL(true, false);
+    }
+  } else {
+    if (centered) {
+      PD_LAUNCH_MULTI_TENSOR_APPLY_RMSPROP_KERNEL(false, true);
+    } else {
+      PD_LAUNCH_MULTI_TENSOR_APPLY_RMSPROP_KERNEL(false, false);
+    }
+  }
+#undef PD_LAUNCH_MULTI_TENSOR_APPLY_RMSPROP_KERNEL
+}
+
+}  // namespace phi
+
+PD_REGISTER_KERNEL(fused_rmsprop,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::FusedRmspropKernel,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16,
+                   float,
+                   double) {
+  kernel->InputAt(7).SetDataType(phi::DataType::BOOL);
+  kernel->InputAt(8).SetDataType(phi::DataType::FLOAT32);
+  kernel->OutputAt(1).SetDataType(phi::DataType::UNDEFINED);
+  kernel->OutputAt(2).SetDataType(phi::DataType::UNDEFINED);
+  kernel->OutputAt(3).SetDataType(phi::DataType::UNDEFINED);
+  kernel->OutputAt(4).SetDataType(phi::DataType::UNDEFINED);
+}
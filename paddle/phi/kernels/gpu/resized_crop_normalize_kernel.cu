@@ -0,0 +1,105 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/resized_crop_normalize_kernel.h"
+
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/backends/gpu/gpu_launch_config.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/funcs/resized_crop_normalize.h"
+
+namespace phi {
+
+template <typename T>
+__global__ void ResizedCropNormalizeCUDAKernel(
+    const T* x,
+    const int* boxes,
+    const bool* flips,
+    int64_t numel,
+    int channels,
+    int height,
+    int width,
+    int out_h,
+    int out_w,
+    funcs::ResizedCropNormalizeParam param,
+    float* out) {
+  CUDA_KERNEL_LOOP_TYPE(idx, numel, int64_t) {
+    int ox = idx % out_w;
+    int oy = (idx / out_w) % out_h;
+    int c = (idx / out_w / out_h) % channels;
+    int n = idx / out_w / out_h / channels;
+    const T* image =
+        x + (static_cast<int64_t>(n) * channels + c) * height * width;
+    out[idx] = funcs::ResizedCropNormalizePixel(image,
+                                                height,
+                                                width,
+                                                boxes + n * 4,
+                                                flips[n],
+                                                out_h,
+                                                out_w,
+                                                oy,
+                                                ox,
+                                                param.mean[c],
+                                                param.stddev[c]);
+  }
+}
+
+template <typename T, typename Context>
+void ResizedCropNormalizeKernel(const Context& dev_ctx,
+                                const DenseTensor& x,
+                                const DenseTensor& boxes,
+                                const DenseTensor& flips,
+                                const std::vector<int>& size,
+                                const std::vector<float>& mean,
+                                const std::vector<float>& stddev,
+                                DenseTensor* out) {
+  const int channels = static_cast<int>(x.dims()[1]);
+  const int height = static_cast<int>(x.dims()[2]);
+  const int width = static_cast<int>(x.dims()[3]);
+  float* out_data = dev_ctx.template Alloc<float>(out);
+  int64_t numel = out->numel();
+  if (numel == 0) return;
+
+  funcs::ResizedCropNormalizeParam param;
+  for (int c = 0; c < channels; ++c) {
+    param.mean[c] = mean.size() == 1 ? mean[0] : mean[c];
+    param.stddev[c] = stddev.size() == 1 ? stddev[0] : stddev[c];
+  }
+
+  auto config = phi::backends::gpu::GetGpuLaunchConfig1D(dev_ctx, numel, 1);
+  ResizedCropNormalizeCUDAKernel<T>
+      <<<config.block_per_grid, config.thread_per_block, 0, dev_ctx.stream()>>>(
+          x.data<T>(),
+          boxes.data<int>(),
+          flips.data<bool>(),
+          numel,
+          channels,
+          height,
+          width,
+          size[0],
+          size[1],
+          param,
+          out_data);
+}
+
+}  // namespace phi
+
+PD_REGISTER_KERNEL(resized_crop_normalize,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::ResizedCropNormalizeKernel,
+                   uint8_t,
+                   float) {
+  kernel->OutputAt(0).SetDataType(phi::DataType::FLOAT32);
+}
@@ -14,17 +14,34 @@
 
 #include "paddle/phi/kernels/memcpy_kernel.h"
 
+#include <type_traits>
 #include <vector>
 
+#include "paddle/common/flags.h"
+#include "paddle/phi/backends/custom/custom_context.h"
 #include "paddle/phi/backends/gpu/gpu_context.h"
 #include "paddle/phi/common/place.h"
 #include "paddle/phi/core/kernel_registry.h"
 #include "paddle/phi/core/stream.h"
 
+COMMON_DECLARE_bool(custom_device_async_memcpy_d2h);
+
 namespace phi {
 
 static constexpr size_t WAIT_THRESHOLD = 64 * 1024;
 
+// The copy to host is left in flight when the caller orders its readers,
+// see FLAGS_custom_device_async_memcpy_d2h.
+template <typename Context>
+static bool SkipMemcpyD2HWait() {
+#ifdef PADDLE_WITH_CUSTOM_DEVICE
+  return std::is_same<Context, CustomContext>::value &&
+         FLAGS_custom_device_async_memcpy_d2h;
+#else
+  return false;
+#endif
+}
+
 template <typename Context>
 void MemcpyH2DKernel(const Context& dev_ctx,
                      const DenseTensor& x,
@@ -59,7 +76,7 @@ void MemcpyD2HKernel(const Context& dev_ctx,
       // NOTE(copy from Aurelius84): host <-> device memory copies of a memory
       // block of 64 KB or less are asynchronous. See
       // https://forums.developer.nvidia.com/t/host-device-memory-copies-up-to-64-kb-are-asynchronous/17907
-      if (x.memory_size() <= WAIT_THRESHOLD) {
+      if (x.memory_size() <= WAIT_THRESHOLD && !SkipMemcpyD2HWait<Context>()) {
         dev_ctx.Wait();
       }
       break;
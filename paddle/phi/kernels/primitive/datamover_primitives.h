@@ -108,6 +108,21 @@ struct BroadcastConfig {
     }
     rank = dim_size;
   }
+
+  // Reads the input by its own strides in elements, e.g. a transposed or
+  // sliced view, where the strides of the broadcast dims are 0. The strides
+  // are in the same reversed order as out_dims.
+  static BroadcastConfig FromStrides(const std::vector<int64_t>& out_dims,
+                                     const std::vector<int64_t>& in_strides,
+                                     int dim_size) {
+    BroadcastConfig config;
+    for (int i = 0; i < dim_size; ++i) {
+      config.divmoders[i] = FastDivMod(out_dims[i]);
+      config.strides[i] = static_cast<uint32_t>(in_strides[i]);
+    }
+    config.rank = dim_size;
+    return config;
+  }
 };
 
 template <typename T>
@@ -0,0 +1,36 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vector>
+
+#include "paddle/phi/core/dense_tensor.h"
+
+namespace phi {
+
+// Crops boxes[i] = (top, left, height, width) of the image x[i], resizes the
+// crop to size bilinearly, flips it horizontally if flips[i] is true, and
+// normalizes each channel c with (value - mean[c]) / stddev[c].
+template <typename T, typename Context>
+void ResizedCropNormalizeKernel(const Context& dev_ctx,
+                                const DenseTensor& x,
+                                const DenseTensor& boxes,
+                                const DenseTensor& flips,
+                                const std::vector<int>& size,
+                                const std::vector<float>& mean,
+                                const std::vector<float>& stddev,
+                                DenseTensor* out);
+
+}  // namespace phi
@@ -64,6 +64,8 @@ __global__ void SparseAdamWCUDAKernelREG(MT beta1,
                                          const MT* master_param,
                                          MT* master_param_out,
                                          const int64_t* rows_,
+                                         const int64_t* grad_offsets_,
+                                         const int64_t* grad_index_,
                                          int64_t row_numel,
                                          int64_t row_count,
                                          bool lazy_mode,
@@ -82,9 +84,19 @@ __global__ void SparseAdamWCUDAKernelREG(MT beta1,
       MT mom2 = static_cast<MT>(mom2_[id]);
 
       MT p = master_param ? master_param[id] : static_cast<MT>(param_[id]);
-      MT g = row_idx >= 0
-                 ? static_cast<MT>(grad_[row_idx * row_numel + id % row_numel])
-                 : static_cast<MT>(0);
+      MT g = static_cast<MT>(0);
+      if (row_idx >= 0) {
+        // The duplicated rows of grad are summed here if they are not merged.
+        g = grad_offsets_ ? phi::funcs::scatter::MergedRowValue<T, MT>(
+                                grad_,
+                                grad_offsets_,
+                                grad_index_,
+                                row_idx,
+                                row_numel,
+                                id % row_numel)
+                          : static_cast<MT>(
+                                grad_[row_idx * row_numel + id % row_numel]);
+      }
 
       p *= (static_cast<MT>(1.0) - lr * coeff);
 
@@ -237,10 +249,20 @@ void AdamwDenseParamSparseGradKernel(
     }
   }
 
+  const bool update_with_reg =
+      beta1_pow.place() == CPUPlace() && beta2_pow.place() == CPUPlace();
+  // The kernel with the beta pows in registers sums the duplicated rows of
+  // grad by itself, which saves merging them into a new SelectedRows.
+  const bool fuse_merge = !is_strict_sorted && update_with_reg;
+
   phi::SelectedRows tmp_grad_merge;
   const phi::SelectedRows* grad_merge_ptr;
-  if (is_strict_sorted) {
+  phi::funcs::scatter::MergeRowGroups grad_groups;
+  if (is_strict_sorted || fuse_merge) {
     grad_merge_ptr = &grad;
+    if (fuse_merge) {
+      grad_groups = phi::funcs::scatter::GroupMergeRows(grad.rows(), true);
+    }
   } else {
     // merge duplicated rows if any.
     // The rows of grad_merge have been sorted inside MergeAdd functor
@@ -251,12 +273,18 @@ void AdamwDenseParamSparseGradKernel(
   auto& grad_merge = *grad_merge_ptr;
   auto& grad_tensor = grad_merge.value();
   const T* grad_data = grad_tensor.template data<T>();
-  auto* grad_merge_rows = &grad_merge.rows();
+  auto* grad_merge_rows = fuse_merge ? &grad_groups.rows : &grad_merge.rows();
   phi::MixVector<int64_t> mixv_grad_merge_rows(grad_merge_rows);
   const int64_t* rows = mixv_grad_merge_rows.Data(dev_ctx.GetPlace());
   auto row_numel = grad_tensor.numel() / grad_merge.rows().size();
-
-  if (beta1_pow.place() == CPUPlace() && beta2_pow.place() == CPUPlace()) {
+  phi::MixVector<int64_t> mixv_grad_offsets(&grad_groups.offsets);
+  phi::MixVector<int64_t> mixv_grad_index(&grad_groups.input_index);
+  const int64_t* grad_offsets =
+      fuse_merge ? mixv_grad_offsets.Data(dev_ctx.GetPlace()) : nullptr;
+  const int64_t* grad_index =
+      fuse_merge ? mixv_grad_index.Data(dev_ctx.GetPlace()) : nullptr;
+
+  if (update_with_reg) {
     int threads = 512;
     int ndim = param.numel();
     int blocks = (ndim + threads - 1) / threads;
@@ -283,8 +311,10 @@ void AdamwDenseParamSparseGradKernel(
             master_in_data,
             master_out_data,
             rows,
+            grad_offsets,
+            grad_index,
             row_numel,
-            grad_merge.rows().size(),
+            grad_merge_rows->size(),
             lazy_mode,
             ndim,
             amsgrad);
@@ -93,6 +93,7 @@ void Conv3dCooCPUKernel(const CPUContext& dev_ctx,
         x,
         key,
         out_dims,
+        out_channels,
         out,
         h_counter_ptr,
         h_offsets_ptr,
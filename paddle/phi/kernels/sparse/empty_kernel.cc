@@ -30,6 +30,7 @@ void EmptyLikeCooKernel(const Context& dev_ctx,
   DenseTensor* out_values = out->mutable_values();
   out_values->Resize(x_values.dims());
   out->set_meta(x.meta());
+  out->ShareSubmRulebooks(x);
   dev_ctx.template Alloc<T>(out_values);
 }
 
@@ -740,13 +740,13 @@ int ProductRuleBook(const Context& dev_ctx,
   if (subm) {
     DenseTensor tmp_rulebook = phi::Empty(dev_ctx, std::move(rulebook_meta));
     IntT* rulebook_ptr = tmp_rulebook.data<IntT>();
-    DenseTensor out_indices = phi::EmptyLike<IntT>(dev_ctx, x.indices());
+    // the indices of out are the indices of x, which are shared to share
+    // the rulebooks cached by them
+    DenseTensor out_indices = x.indices();
     int tmpidx = is2D ? 3 : 4;
     DenseTensor out_values =
         phi::Empty<T>(dev_ctx, {x.nnz(), kernel_sizes[tmpidx]});
 
-    phi::Copy(dev_ctx, x.indices(), dev_ctx.GetPlace(), false, &out_indices);
-
     auto config =
         phi::backends::gpu::GetGpuLaunchConfig1D(dev_ctx, non_zero_num, 1);
     GetOutIndexTable1<IntT><<<config.block_per_grid,
@@ -135,17 +135,50 @@ void Conv3dCooGPUKernel(const GPUContext& dev_ctx,
   int rulebook_len = 0;
   const IntT* rulebook_ptr = nullptr;
   bool need_product_rulebook = true;
+  // Without a user given key, the rulebook of submanifold conv is cached by
+  // the indices of x and shared by the following submanifold convs of the
+  // same geometry.
+  const std::string subm_key =
+      subm && key.empty()
+          ? phi::funcs::sparse::SubmRulebookKey(
+                kernel_sizes, subm_paddings, dilations, subm_strides)
+          : "";
   if (subm && !key.empty()) {
     rulebook_ptr = phi::funcs::sparse::PrepareSubm<T, IntT, GPUContext>(
         dev_ctx,
         x,
         key,
         out_dims,
+        out_channels,
         out,
         h_counter.data<int>(),
         h_offsets.data<int>(),
         &rulebook_len,
         &need_product_rulebook);
+  } else if (!subm_key.empty()) {
+    const auto* indices_pairs = x.SubmRulebook(subm_key);
+    if (indices_pairs != nullptr) {
+      VLOG(6) << "reuse the rulebook of " << subm_key;
+      need_product_rulebook = false;
+      rulebook_ptr =
+          phi::funcs::sparse::PrepareSubm<T, IntT, GPUContext>(dev_ctx,
+                                                               x,
+                                                               *indices_pairs,
+                                                               out_dims,
+                                                               out_channels,
+                                                               out,
+                                                               h_counter_ptr,
+                                                               h_offsets_ptr,
+                                                               &rulebook_len);
+      phi::funcs::sparse::SaveToTable(dev_ctx,
+                                      x,
+                                      key,
+                                      indices_pairs->first,
+                                      indices_pairs->second,
+                                      out,
+                                      rulebook,
+                                      counter);
+    }
   }
 
   if (need_product_rulebook) {
@@ -170,6 +203,11 @@ void Conv3dCooGPUKernel(const GPUContext& dev_ctx,
 
     phi::funcs::sparse::SaveToTable(
         dev_ctx, x, key, tmp_rulebook, h_counter, out, rulebook, counter);
+    if (!subm_key.empty()) {
+      // h_counter is kept as it is from here, so it is cached without a copy
+      x.SaveSubmRulebook(subm_key, std::make_pair(tmp_rulebook, h_counter));
+      out->ShareSubmRulebooks(x);
+    }
   }
 
 #if defined(PADDLE_WITH_CUTLASS) && SPCONV_WITH_CUTLASS
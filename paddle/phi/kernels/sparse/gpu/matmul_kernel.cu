@@ -14,6 +14,10 @@ limitations under the License. */
 
 #include "paddle/phi/kernels/sparse/matmul_kernel.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
 #include <vector>
 
 #include "paddle/common/ddim.h"
@@ -24,6 +28,8 @@ limitations under the License. */
 #include "paddle/phi/core/sparse_coo_tensor.h"
 #include "paddle/phi/core/sparse_csr_tensor.h"
 #include "paddle/phi/core/tensor_utils.h"
+#include "paddle/phi/kernels/autotune/gpu_timer.h"
+#include "paddle/phi/kernels/autotune/switch_autotune.h"
 #include "paddle/phi/kernels/empty_kernel.h"
 #include "paddle/phi/kernels/funcs/math_function_impl.h"
 #include "paddle/phi/kernels/funcs/sparse/sparse_blas.h"
@@ -34,6 +40,235 @@ limitations under the License. */
 namespace phi {
 namespace sparse {
 
+#if defined(PADDLE_WITH_CUDA) && CUDA_VERSION >= 11000
+// The ways to run a 2-D sparse * dense matmul, which are chosen by the
+// autotune. A COO tensor runs on its own format or on the CSR converted from
+// it, which is cached by the tensor.
+enum class SpMMImpl : int64_t {
+  kCooDefault = 0,
+  kCsrAlg1 = 1,
+  kCsrAlg2 = 2,
+  kCsrRowSplit = 3,
+};
+
+// Each row of x is computed by blockDim.x threads along the columns of y,
+// which reads and writes the rows of y and out coalesced. It has no buffer
+// and no setup, and is faster than cuSPARSE for short rows and a narrow y.
+template <typename T, typename IntT>
+__global__ void CsrRowSplitSpMMKernel(const IntT* crows,
+                                      const IntT* cols,
+                                      const T* values,
+                                      const T* y,
+                                      const int64_t rows,
+                                      const int64_t n,
+                                      T* out) {
+  int64_t row = static_cast<int64_t>(blockIdx.x) * blockDim.y + threadIdx.y;
+  if (row >= rows) {
+    return;
+  }
+  const IntT begin = crows[row];
+  const IntT end = crows[row + 1];
+  for (int64_t j = static_cast<int64_t>(blockIdx.y) * blockDim.x + threadIdx.x;
+       j < n;
+       j += static_cast<int64_t>(gridDim.y) * blockDim.x) {
+    T sum = static_cast<T>(0);
+    for (IntT k = begin; k < end; ++k) {
+      sum += values[k] * y[static_cast<int64_t>(cols[k]) * n + j];
+    }
+    out[row * n + j] = sum;
+  }
+}
+
+template <typename T>
+void CsrRowSplitSpMM(const GPUContext& dev_ctx,
+                     const SparseCsrTensor& x,
+                     const DenseTensor& y,
+                     DenseTensor* out) {
+  const int64_t rows = x.dims()[0];
+  const int64_t n = y.dims()[1];
+  if (rows == 0 || n == 0) {
+    return;
+  }
+  constexpr int kThreadsX = 32;
+  constexpr int kRowsPerBlock = 8;
+  dim3 block(kThreadsX, kRowsPerBlock);
+  dim3 grid((rows + kRowsPerBlock - 1) / kRowsPerBlock,
+            std::min<int64_t>((n + kThreadsX - 1) / kThreadsX, 65535));
+  PD_VISIT_BASE_INTEGRAL_TYPES(
+      x.crows().dtype(), "CsrRowSplitSpMMKernel", ([&] {
+        CsrRowSplitSpMMKernel<T, data_t>
+            <<<grid, block, 0, dev_ctx.stream()>>>(x.crows().data<data_t>(),
+                                                   x.cols().data<data_t>(),
+                                                   x.values().data<T>(),
+                                                   y.data<T>(),
+                                                   rows,
+                                                   n,
+                                                   out->data<T>());
+      }));
+}
+
+inline DataType IndexDtype(const SparseCooTensor& x) {
+  return x.indices().dtype();
+}
+
+inline DataType IndexDtype(const SparseCsrTensor& x) {
+  return x.crows().dtype();
+}
+
+template <typename T>
+SparseCsrTensor CsrForSpMM(const GPUContext& dev_ctx,
+                           const SparseCsrTensor& x) {
+  return x;
+}
+
+// The values of the CSR converted from a COO are the values of the COO in
+// the same order, so only its crows and cols are cached by the COO tensor.
+template <typename T>
+SparseCsrTensor CsrForSpMM(const GPUContext& dev_ctx,
+                           const SparseCooTensor& x) {
+  const auto* layout = x.CsrLayout();
+  if (layout == nullptr) {
+    SparseCsrTensor csr;
+    CooToCsrKernel<T>(dev_ctx, x, &csr);
+    x.SetCsrLayout(csr.crows(), csr.cols());
+    layout = x.CsrLayout();
+  }
+  SparseCsrTensor csr;
+  csr.SetMember(layout->first, layout->second, x.values(), x.dims());
+  return csr;
+}
+
+template <typename T, typename TensorType>
+void RunSpMMImpl(const GPUContext& dev_ctx,
+                 SpMMImpl impl,
+                 const TensorType& x,
+                 const SparseCsrTensor& csr,
+                 const DenseTensor& y,
+                 DenseTensor* out) {
+  auto sparse_blas = phi::funcs::sparse::GetSparseBlas<GPUContext, T>(dev_ctx);
+  switch (impl) {
+    case SpMMImpl::kCooDefault:
+      sparse_blas.SPMM(false,
+                       false,
+                       static_cast<T>(1),
+                       x,
+                       y,
+                       static_cast<T>(0),
+                       out,
+                       static_cast<int64_t>(CUSPARSE_SPMM_ALG_DEFAULT));
+      break;
+    case SpMMImpl::kCsrAlg1:
+      sparse_blas.SPMM(false,
+                       false,
+                       static_cast<T>(1),
+                       csr,
+                       y,
+                       static_cast<T>(0),
+                       out,
+                       static_cast<int64_t>(CUSPARSE_SPMM_CSR_ALG1));
+      break;
+    case SpMMImpl::kCsrAlg2:
+      sparse_blas.SPMM(false,
+                       false,
+                       static_cast<T>(1),
+                       csr,
+                       y,
+                       static_cast<T>(0),
+                       out,
+                       static_cast<int64_t>(CUSPARSE_SPMM_CSR_ALG2));
+      break;
+    case SpMMImpl::kCsrRowSplit:
+      CsrRowSplitSpMM<T>(dev_ctx, csr, y, out);
+      break;
+  }
+}
+
+// Picks the format and the algorithm of a 2-D sparse * dense matmul by the
+// shape and the number of non zero elements, the cuSPARSE default could be
+// several times slower than the best one for very sparse or very dense rows.
+// Returns false if the autotune is off and nothing is cached, and then the
+// caller runs the default SPMM.
+template <typename T, typename TensorType>
+bool TuneAndRunSpMM(const GPUContext& dev_ctx,
+                    const TensorType& x,
+                    const DenseTensor& y,
+                    DenseTensor* out) {
+  auto& cache = phi::autotune::AutoTuneCache::Instance().Get(
+      phi::autotune::AlgorithmType::kSparseMatmul);
+  bool use_autotune = phi::autotune::AutoTuneStatus::Instance().UseAutoTune();
+  // Keep the default path free of any overhead.
+  if (!use_autotune && cache.Size() == 0) {
+    return false;
+  }
+
+  constexpr bool is_coo = std::is_same<TensorType, SparseCooTensor>::value;
+  const int64_t nnz = x.nnz();
+  // The log2 of nnz tells the sparsity with the shape of x, while the
+  // tensors of a slightly different nnz share the result.
+  const int nnz_level = static_cast<int>(std::log2(static_cast<double>(nnz)));
+  size_t key = phi::autotune::GenKey(
+      is_coo,
+      x.dims()[0],
+      x.dims()[1],
+      y.dims()[1],
+      nnz > 0 ? nnz_level + 1 : 0,
+      static_cast<int64_t>(x.dtype()),
+      static_cast<int64_t>(IndexDtype(x)));
+  if (cache.Find(key)) {
+    auto impl = static_cast<SpMMImpl>(cache.Get(key));
+    SparseCsrTensor csr;
+    if (impl != SpMMImpl::kCooDefault) {
+      csr = CsrForSpMM<T>(dev_ctx, x);
+    }
+    RunSpMMImpl<T>(dev_ctx, impl, x, csr, y, out);
+    return true;
+  }
+  if (!use_autotune) {
+    return false;
+  }
+
+  std::vector<SpMMImpl> candidates;
+  if (is_coo) {
+    candidates.push_back(SpMMImpl::kCooDefault);
+  }
+  candidates.push_back(SpMMImpl::kCsrAlg2);
+  candidates.push_back(SpMMImpl::kCsrAlg1);
+  candidates.push_back(SpMMImpl::kCsrRowSplit);
+  // The conversion is cached by the tensor, so it is not timed.
+  SparseCsrTensor csr = CsrForSpMM<T>(dev_ctx, x);
+
+  // Regard 1st run as warmup, judge the compare result by the time cost
+  // of rest cycles.
+  constexpr int repeats = 6;
+  phi::GpuTimer timer;
+  auto stream = dev_ctx.stream();
+  SpMMImpl best_impl = candidates[0];
+  float min_time = std::numeric_limits<float>::max();
+  for (auto impl : candidates) {
+    float time_cost = 0;
+    for (int i = 0; i < repeats; ++i) {
+      timer.Start(stream);
+      RunSpMMImpl<T>(dev_ctx, impl, x, csr, y, out);
+      timer.Stop(stream);
+      if (i > 0) {
+        time_cost += timer.ElapsedTime();
+      }
+    }
+    VLOG(3) << "sparse matmul with impl " << static_cast<int64_t>(impl)
+            << " costs " << time_cost / (repeats - 1) << " ms";
+    if (time_cost < min_time) {
+      min_time = time_cost;
+      best_impl = impl;
+    }
+  }
+  VLOG(3) << "best impl of sparse matmul is "
+          << static_cast<int64_t>(best_impl);
+  cache.Set(key, static_cast<int64_t>(best_impl));
+  // All the candidates write the whole out, so it holds the result already.
+  return true;
+}
+#endif
+
 template <typename T, typename Context, typename TensorType>
 void MatmulKernelImpl(const Context& dev_ctx,
                       const TensorType& x,
@@ -88,6 +323,12 @@ void MatmulKernelImpl(const Context& dev_ctx,
   set_zero(dev_ctx, out, static_cast<T>(0.0f));
 #endif
 
+#ifdef PADDLE_WITH_CUDA
+  if (x_ndims == 2 && TuneAndRunSpMM<T>(dev_ctx, x, y, out)) {
+    return;
+  }
+#endif
+
   auto sparse_blas = phi::funcs::sparse::GetSparseBlas<Context, T>(dev_ctx);
   sparse_blas.SPMM(
       false, false, static_cast<T>(1), x, y, static_cast<T>(0), out);
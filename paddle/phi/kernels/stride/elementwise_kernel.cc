@@ -0,0 +1,115 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/common/flags.h"
+#include "paddle/phi/backends/all_context.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/contiguous_kernel.h"
+#include "paddle/phi/kernels/elementwise_add_kernel.h"
+#include "paddle/phi/kernels/elementwise_divide_kernel.h"
+#include "paddle/phi/kernels/elementwise_multiply_kernel.h"
+#include "paddle/phi/kernels/elementwise_subtract_kernel.h"
+#include "paddle/phi/kernels/funcs/elementwise_base.h"
+#include "paddle/phi/kernels/funcs/elementwise_functor.h"
+
+COMMON_DECLARE_bool(use_stride_kernel);
+
+namespace phi {
+
+// The CPU kernel reads the inputs by their strides.
+template <typename T, typename Functor, typename Kernel>
+void ElementwiseStridedCompute(const CPUContext& dev_ctx,
+                               const DenseTensor& x,
+                               const DenseTensor& y,
+                               Functor func,
+                               Kernel kernel,
+                               DenseTensor* out) {
+  funcs::StridedElementwiseCompute<Functor, T>(dev_ctx, x, y, func, out);
+}
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+// The GPU BroadcastKernel reads the non-contiguous inputs by their strides
+// with the fast divmod of the output dims, unless they are too large for the
+// 32 bits index.
+template <typename T, typename Functor, typename Kernel>
+void ElementwiseStridedCompute(const GPUContext& dev_ctx,
+                               const DenseTensor& x,
+                               const DenseTensor& y,
+                               Functor func,
+                               Kernel kernel,
+                               DenseTensor* out) {
+  if (!funcs::IsBroadcastIndexableByStrides({&x, &y}, *out)) {
+    kernel(dev_ctx,
+           x.meta().is_contiguous() ? x : Contiguous<T, GPUContext>(dev_ctx, x),
+           y.meta().is_contiguous() ? y : Contiguous<T, GPUContext>(dev_ctx, y),
+           out);
+    return;
+  }
+  kernel(dev_ctx, x, y, out);
+}
+#endif
+
+#define DEFINE_ELEMENTWISE_STRIDED_KERNEL(name, functor)                   \
+  template <typename T, typename Context>                                  \
+  void name##StridedKernel(const Context& dev_ctx,                         \
+                           const DenseTensor& x,                           \
+                           const DenseTensor& y,                           \
+                           DenseTensor* out) {                             \
+    if (!FLAGS_use_stride_kernel) {                                        \
+      PADDLE_THROW(common::errors::Fatal(                                  \
+          "FLAGS_use_stride_kernel is closed. Strided kernel "             \
+          "be called, something wrong has happened!"));                    \
+    }                                                                      \
+    /* the output is contiguous, a strided one is copied back by the api */ \
+    out->set_strides(DenseTensorMeta::calc_strides(out->dims()));          \
+    if (x.meta().is_contiguous() && y.meta().is_contiguous()) {            \
+      name##Kernel<T, Context>(dev_ctx, x, y, out);                        \
+      return;                                                              \
+    }                                                                      \
+    ElementwiseStridedCompute<T>(                                          \
+        dev_ctx, x, y, functor<T>(), name##Kernel<T, Context>, out);       \
+  }
+
+DEFINE_ELEMENTWISE_STRIDED_KERNEL(Add, funcs::AddFunctor)
+DEFINE_ELEMENTWISE_STRIDED_KERNEL(Subtract, funcs::SubtractFunctor)
+DEFINE_ELEMENTWISE_STRIDED_KERNEL(Multiply, funcs::MultiplyFunctor)
+DEFINE_ELEMENTWISE_STRIDED_KERNEL(Divide, funcs::DivideFunctor)
+
+#undef DEFINE_ELEMENTWISE_STRIDED_KERNEL
+
+}  // namespace phi
+
+#define PD_REGISTER_ELEMENTWISE_STRIDED_KERNEL(name, backend, func) \
+  PD_REGISTER_KERNEL(name,                                           \
+                     backend,                                        \
+                     STRIDED,                                        \
+                     phi::func,                                      \
+                     float,                                          \
+                     double,                                         \
+                     int,                                            \
+                     int64_t,                                        \
+                     phi::dtype::float16,                            \
+                     phi::dtype::bfloat16) {}
+
+PD_REGISTER_ELEMENTWISE_STRIDED_KERNEL(add, CPU, AddStridedKernel)
+PD_REGISTER_ELEMENTWISE_STRIDED_KERNEL(subtract, CPU, SubtractStridedKernel)
+PD_REGISTER_ELEMENTWISE_STRIDED_KERNEL(multiply, CPU, MultiplyStridedKernel)
+PD_REGISTER_ELEMENTWISE_STRIDED_KERNEL(divide, CPU, DivideStridedKernel)
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+PD_REGISTER_ELEMENTWISE_STRIDED_KERNEL(add, GPU, AddStridedKernel)
+PD_REGISTER_ELEMENTWISE_STRIDED_KERNEL(subtract, GPU, SubtractStridedKernel)
+PD_REGISTER_ELEMENTWISE_STRIDED_KERNEL(multiply, GPU, MultiplyStridedKernel)
+PD_REGISTER_ELEMENTWISE_STRIDED_KERNEL(divide, GPU, DivideStridedKernel)
+#endif
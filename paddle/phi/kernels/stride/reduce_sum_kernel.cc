@@ -0,0 +1,170 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <numeric>
+
+#include "paddle/common/flags.h"
+#include "paddle/phi/backends/all_context.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/contiguous_kernel.h"
+#include "paddle/phi/kernels/reduce_sum_kernel.h"
+#include "paddle/phi/kernels/transpose_kernel.h"
+
+COMMON_DECLARE_bool(use_stride_kernel);
+
+namespace phi {
+
+// Gets the dims of x from the outermost to the innermost in the memory, and
+// returns whether x is a permutation of a contiguous tensor, e.g. a
+// transposed view, which can be reduced in place of its storage.
+static bool GetDenseDimsOrder(const DenseTensor& x, std::vector<int>* order) {
+  const int rank = x.dims().size();
+  order->resize(rank);
+  std::iota(order->begin(), order->end(), 0);
+  std::stable_sort(order->begin(), order->end(), [&x](int a, int b) {
+    return x.strides()[a] > x.strides()[b];
+  });
+  int64_t expected_stride = 1;
+  for (int k = rank - 1; k >= 0; --k) {
+    int d = (*order)[k];
+    if (x.dims()[d] != 1 && x.strides()[d] != expected_stride) {
+      return false;
+    }
+    expected_stride *= x.dims()[d];
+  }
+  return true;
+}
+
+template <typename T, typename Context>
+void SumStridedKernel(const Context& dev_ctx,
+                      const DenseTensor& x,
+                      const IntArray& dims,
+                      DataType out_dtype,
+                      bool keep_dim,
+                      DenseTensor* out) {
+  if (!FLAGS_use_stride_kernel) {
+    PADDLE_THROW(common::errors::Fatal(
+        "FLAGS_use_stride_kernel is closed. Strided kernel "
+        "be called, something wrong has happened!"));
+  }
+  out->set_strides(DenseTensorMeta::calc_strides(out->dims()));
+  if (x.meta().is_contiguous()) {
+    SumKernel<T, Context>(dev_ctx, x, dims, out_dtype, keep_dim, out);
+    return;
+  }
+
+  const int rank = x.dims().size();
+  std::vector<int> order;
+  bool is_dense = x.numel() > 0 && GetDenseDimsOrder(x, &order);
+
+  // the dims of the storage in the memory order and the reduced ones in it
+  std::vector<bool> is_reduced(rank, recompute_reduce_all(x, dims));
+  for (auto axis : dims.GetData()) {
+    is_reduced[axis < 0 ? axis + rank : axis] = true;
+  }
+  std::vector<int64_t> storage_dims(rank);
+  std::vector<int64_t> reduced_dims(rank);
+  std::vector<int64_t> storage_axes;
+  std::vector<int> position(rank);
+  // the kept dims are transposed back if they are not in the memory order
+  bool need_transpose = false;
+  int last_kept_dim = -1;
+  for (int k = 0; is_dense && k < rank; ++k) {
+    int d = order[k];
+    position[d] = k;
+    storage_dims[k] = x.dims()[d];
+    reduced_dims[k] = is_reduced[d] ? 1 : x.dims()[d];
+    if (is_reduced[d]) {
+      storage_axes.push_back(k);
+    } else if (x.dims()[d] != 1) {
+      need_transpose |= d < last_kept_dim;
+      last_kept_dim = d;
+    }
+  }
+
+  // a transpose of the output needs the dtype of x
+  if (!is_dense || (need_transpose && out->dtype() != x.dtype())) {
+    SumKernel<T, Context>(dev_ctx,
+                          Contiguous<T, Context>(dev_ctx, x),
+                          dims,
+                          out_dtype,
+                          keep_dim,
+                          out);
+    return;
+  }
+
+  DenseTensor storage;
+  storage.ShareDataWith(x);
+  storage.set_meta(DenseTensorMeta(
+      x.dtype(), common::make_ddim(storage_dims), x.layout(), x.offset()));
+  DenseTensor reduced;
+  reduced.set_meta(
+      DenseTensorMeta(out->dtype(), common::make_ddim(reduced_dims)));
+  SumRawKernel<T, Context>(dev_ctx,
+                           storage,
+                           IntArray(storage_axes),
+                           true,
+                           recompute_reduce_all(x, dims),
+                           out_dtype,
+                           &reduced);
+  if (!need_transpose) {
+    // the same elements in the same order, only the dims differ
+    out->ShareBufferWith(reduced);
+    return;
+  }
+
+  // the reduced output is much smaller than x, so it is transposed instead
+  std::vector<int> axis(rank);
+  std::vector<int64_t> transposed_dims(rank);
+  for (int d = 0; d < rank; ++d) {
+    axis[d] = position[d];
+    transposed_dims[d] = reduced_dims[position[d]];
+  }
+  DenseTensor transposed;
+  transposed.set_meta(
+      DenseTensorMeta(out->dtype(), common::make_ddim(transposed_dims)));
+  TransposeKernel<T, Context>(dev_ctx, reduced, axis, &transposed);
+  out->ShareBufferWith(transposed);
+}
+
+}  // namespace phi
+
+PD_REGISTER_KERNEL(sum,
+                   CPU,
+                   STRIDED,
+                   phi::SumStridedKernel,
+                   float,
+                   double,
+                   int,
+                   int64_t,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {
+  kernel->OutputAt(0).SetDataType(phi::DataType::UNDEFINED);
+}
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+PD_REGISTER_KERNEL(sum,
+                   GPU,
+                   STRIDED,
+                   phi::SumStridedKernel,
+                   float,
+                   double,
+                   int,
+                   int64_t,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {
+  kernel->OutputAt(0).SetDataType(phi::DataType::UNDEFINED);
+}
+#endif
@@ -0,0 +1,540 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// The benchmark of the CPU kernels of phi, for the kernels and shapes in the
+// sweep config, one case per line:
+//
+//   # kernel shape [shape ...] [attr=value ...]
+//   matmul 128x768 768x3072
+//   conv2d 1x64x56x56 64x64x3x3 stride=1 pad=1
+//   add 128x3072 3072
+//   sum 128x3072 axis=-1
+//   embedding 128 30522x768
+//   layer_norm 128x768
+//   softmax 12x128x128
+//
+// The results are written as JSON, one record per case, so that the runs of
+// the revisions can be compared to track the regressions.
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "glog/logging.h"
+#include "paddle/common/flags.h"
+#include "paddle/phi/api/profiler/device_tracer.h"
+#include "paddle/phi/backends/context_pool.h"
+#include "paddle/phi/backends/cpu/cpu_context.h"
+#include "paddle/phi/backends/cpu/cpu_info.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/enforce.h"
+#include "paddle/phi/core/meta_tensor.h"
+#include "paddle/phi/core/platform/cpu_helper.h"
+#include "paddle/phi/infermeta/binary.h"
+#include "paddle/phi/infermeta/ternary.h"
+#include "paddle/phi/infermeta/unary.h"
+#include "paddle/phi/kernels/conv_kernel.h"
+#include "paddle/phi/kernels/elementwise_add_kernel.h"
+#include "paddle/phi/kernels/embedding_kernel.h"
+#include "paddle/phi/kernels/layer_norm_kernel.h"
+#include "paddle/phi/kernels/matmul_kernel.h"
+#include "paddle/phi/kernels/reduce_sum_kernel.h"
+#include "paddle/phi/kernels/softmax_kernel.h"
+#ifdef PADDLE_WITH_DNNL
+#include "paddle/phi/backends/onednn/onednn_context.h"
+#include "paddle/phi/kernels/transfer_layout_kernel.h"
+#endif
+
+PD_DEFINE_string(config,
+                 "",
+                 "The file of the shape sweep, the built-in sweep if empty.");
+PD_DEFINE_string(output, "", "The JSON file of the results, stdout if empty.");
+PD_DEFINE_string(filter,
+                 "",
+                 "The comma separated kernels to run, all if empty.");
+PD_DEFINE_int32(burning, 10, "Burning times of each case.");
+PD_DEFINE_int32(repeat, 100, "Repeat times of each case.");
+PD_DEFINE_int32(threads, 1, "The number of threads of the kernels.");
+PD_DEFINE_string(cpus,
+                 "",
+                 "The comma separated cpus the threads are pinned to, thread "
+                 "i to the cpu i % size, not pinned if empty.");
+
+namespace phi {
+namespace tools {
+
+using DDim = common::DDim;
+
+struct BenchCase {
+  std::string line;
+  std::string kernel;
+  std::vector<std::vector<int64_t>> shapes;
+  std::map<std::string, std::string> attrs;
+
+  int Attr(const std::string& name, int default_value) const {
+    auto iter = attrs.find(name);
+    return iter == attrs.end() ? default_value : std::stoi(iter->second);
+  }
+};
+
+// Runs the kernel once with the inputs made from the case.
+using BenchFunc = std::function<void()>;
+using BenchCreator =
+    std::function<BenchFunc(const BenchCase&, const CPUContext&)>;
+
+const char* kDefaultSweep = R"(
+matmul 128x768 768x768
+matmul 128x768 768x3072
+matmul 128x3072 3072x768
+matmul 12x128x64 12x64x128
+conv2d 1x64x56x56 64x64x3x3 stride=1 pad=1
+conv2d 1x256x56x56 64x256x1x1
+conv2d 1x3x224x224 64x3x7x7 stride=2 pad=3
+add 128x768 128x768
+add 128x3072 3072
+add 32x64x56x56 32x64x56x56
+sum 128x3072 axis=-1
+sum 128x3072 axis=0
+sum 32x64x56x56 axis=1
+embedding 128 30522x768
+embedding 4096 100000x64
+layer_norm 128x768
+layer_norm 128x1024
+layer_norm 4096x4096
+softmax 128x1000
+softmax 12x128x128
+softmax 128x30522
+)";
+
+std::vector<std::string> Split(const std::string& str, char sep) {
+  std::vector<std::string> items;
+  std::stringstream ss(str);
+  std::string item;
+  while (std::getline(ss, item, sep)) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+std::vector<BenchCase> ParseSweep(std::istream& is) {
+  std::vector<BenchCase> cases;
+  std::string line;
+  while (std::getline(is, line)) {
+    line = line.substr(0, line.find('#'));
+    std::stringstream ss(line);
+    BenchCase bench_case;
+    std::string item;
+    while (ss >> item) {
+      if (bench_case.kernel.empty()) {
+        bench_case.kernel = item;
+      } else if (item.find('=') != std::string::npos) {
+        auto pos = item.find('=');
+        bench_case.attrs[item.substr(0, pos)] = item.substr(pos + 1);
+      } else {
+        std::vector<int64_t> shape;
+        for (auto& dim : Split(item, 'x')) {
+          shape.push_back(std::stoll(dim));
+        }
+        bench_case.shapes.push_back(shape);
+      }
+      bench_case.line += (bench_case.line.empty() ? "" : " ") + item;
+    }
+    if (!bench_case.kernel.empty()) {
+      cases.push_back(bench_case);
+    }
+  }
+  return cases;
+}
+
+void CheckShapes(const BenchCase& bench_case, size_t num) {
+  PADDLE_ENFORCE_EQ(bench_case.shapes.size(),
+                    num,
+                    common::errors::InvalidArgument(
+                        "The case `%s` should have %d shapes, but got %d.",
+                        bench_case.line,
+                        num,
+                        bench_case.shapes.size()));
+}
+
+DenseTensor RandomTensor(const CPUContext& dev_ctx,
+                         const std::vector<int64_t>& shape,
+                         float lower = -1.f,
+                         float upper = 1.f) {
+  DenseTensor tensor;
+  tensor.Resize(common::make_ddim(shape));
+  float* data = dev_ctx.Alloc<float>(&tensor);
+  std::mt19937 rng(100);
+  std::uniform_real_distribution<float> uniform_dist(lower, upper);
+  for (int64_t i = 0; i < tensor.numel(); ++i) {
+    data[i] = uniform_dist(rng);
+  }
+  return tensor;
+}
+
+BenchFunc CreateMatmul(const BenchCase& bench_case,
+                       const CPUContext& dev_ctx) {
+  CheckShapes(bench_case, 2);
+  auto x = RandomTensor(dev_ctx, bench_case.shapes[0]);
+  auto y = RandomTensor(dev_ctx, bench_case.shapes[1]);
+  auto out = std::make_shared<DenseTensor>();
+  MetaTensor meta_out(out.get());
+  MatmulInferMeta(MetaTensor(x), MetaTensor(y), false, false, &meta_out);
+  return [&dev_ctx, x, y, out]() {
+    MatmulKernel<float, CPUContext>(dev_ctx, x, y, false, false, out.get());
+  };
+}
+
+BenchFunc CreateConv2d(const BenchCase& bench_case,
+                       const CPUContext& dev_ctx) {
+  CheckShapes(bench_case, 2);
+  auto input = RandomTensor(dev_ctx, bench_case.shapes[0]);
+  auto filter = RandomTensor(dev_ctx, bench_case.shapes[1]);
+  int stride = bench_case.Attr("stride", 1);
+  int pad = bench_case.Attr("pad", 0);
+  int groups = bench_case.Attr("groups", 1);
+  std::vector<int> strides = {stride, stride};
+  std::vector<int> paddings = {pad, pad};
+  std::vector<int> dilations = {1, 1};
+  auto out = std::make_shared<DenseTensor>();
+  MetaTensor meta_out(out.get());
+  ConvInferMeta(MetaTensor(input),
+                MetaTensor(filter),
+                strides,
+                paddings,
+                "EXPLICIT",
+                dilations,
+                groups,
+                "NCHW",
+                &meta_out);
+#ifdef PADDLE_WITH_DNNL
+  // the CPU place gets the OneDNNContext from the pool, and the inputs are
+  // only tagged with the oneDNN layout outside of the timing
+  input = TransferLayout<CPUContext>(dev_ctx, input, DataLayout::ONEDNN);
+  filter = TransferLayout<CPUContext>(dev_ctx, filter, DataLayout::ONEDNN);
+  const auto& onednn_ctx = static_cast<const OneDNNContext&>(dev_ctx);
+  return [=, &onednn_ctx]() {
+    ConvKernel<float, OneDNNContext>(onednn_ctx,
+                                     input,
+                                     filter,
+                                     strides,
+                                     paddings,
+                                     "EXPLICIT",
+                                     dilations,
+                                     groups,
+                                     "NCHW",
+                                     out.get());
+  };
+#else
+  return [=, &dev_ctx]() {
+    ConvKernel<float, CPUContext>(dev_ctx,
+                                  input,
+                                  filter,
+                                  strides,
+                                  paddings,
+                                  "EXPLICIT",
+                                  dilations,
+                                  groups,
+                                  "NCHW",
+                                  out.get());
+  };
+#endif
+}
+
+BenchFunc CreateAdd(const BenchCase& bench_case, const CPUContext& dev_ctx) {
+  CheckShapes(bench_case, 2);
+  auto x = RandomTensor(dev_ctx, bench_case.shapes[0]);
+  auto y = RandomTensor(dev_ctx, bench_case.shapes[1]);
+  auto out = std::make_shared<DenseTensor>();
+  MetaTensor meta_out(out.get());
+  ElementwiseInferMeta(MetaTensor(x), MetaTensor(y), &meta_out);
+  return [&dev_ctx, x, y, out]() {
+    AddKernel<float, CPUContext>(dev_ctx, x, y, out.get());
+  };
+}
+
+BenchFunc CreateSum(const BenchCase& bench_case, const CPUContext& dev_ctx) {
+  CheckShapes(bench_case, 1);
+  auto x = RandomTensor(dev_ctx, bench_case.shapes[0]);
+  IntArray axis({bench_case.Attr("axis", -1)});
+  auto out = std::make_shared<DenseTensor>();
+  MetaTensor meta_out(out.get());
+  SumInferMeta(MetaTensor(x), axis, DataType::UNDEFINED, false, &meta_out);
+  return [&dev_ctx, x, axis, out]() {
+    SumKernel<float, CPUContext>(
+        dev_ctx, x, axis, DataType::UNDEFINED, false, out.get());
+  };
+}
+
+BenchFunc CreateEmbedding(const BenchCase& bench_case,
+                          const CPUContext& dev_ctx) {
+  CheckShapes(bench_case, 2);
+  auto weight = RandomTensor(dev_ctx, bench_case.shapes[1]);
+  DenseTensor ids;
+  ids.Resize(common::make_ddim(bench_case.shapes[0]));
+  int64_t* ids_data = dev_ctx.Alloc<int64_t>(&ids);
+  std::mt19937 rng(100);
+  std::uniform_int_distribution<int64_t> uniform_dist(0,
+                                                      weight.dims()[0] - 1);
+  for (int64_t i = 0; i < ids.numel(); ++i) {
+    ids_data[i] = uniform_dist(rng);
+  }
+  auto out = std::make_shared<DenseTensor>();
+  MetaTensor meta_out(out.get());
+  EmbeddingInferMeta(MetaTensor(ids), MetaTensor(weight), -1, &meta_out);
+  return [&dev_ctx, ids, weight, out]() {
+    EmbeddingKernel<float, CPUContext>(dev_ctx, ids, weight, -1, out.get());
+  };
+}
+
+BenchFunc CreateLayerNorm(const BenchCase& bench_case,
+                          const CPUContext& dev_ctx) {
+  CheckShapes(bench_case, 1);
+  auto x = RandomTensor(dev_ctx, bench_case.shapes[0]);
+  int begin_norm_axis = bench_case.Attr(
+      "begin_norm_axis", static_cast<int>(bench_case.shapes[0].size()) - 1);
+  DDim matrix = common::flatten_to_2d(x.dims(), begin_norm_axis);
+  auto scale = RandomTensor(dev_ctx, {matrix[1]});
+  auto bias = RandomTensor(dev_ctx, {matrix[1]});
+  auto out = std::make_shared<DenseTensor>();
+  auto mean = std::make_shared<DenseTensor>();
+  auto variance = std::make_shared<DenseTensor>();
+  MetaTensor meta_out(out.get());
+  MetaTensor meta_mean(mean.get());
+  MetaTensor meta_variance(variance.get());
+  LayerNormInferMeta(MetaTensor(x),
+                     MetaTensor(scale),
+                     MetaTensor(bias),
+                     1e-5,
+                     begin_norm_axis,
+                     &meta_out,
+                     &meta_mean,
+                     &meta_variance);
+  return [&dev_ctx, x, scale, bias, begin_norm_axis, out, mean, variance]() {
+    LayerNormKernel<float, CPUContext>(dev_ctx,
+                                       x,
+                                       scale,
+                                       bias,
+                                       1e-5,
+                                       begin_norm_axis,
+                                       out.get(),
+                                       mean.get(),
+                                       variance.get());
+  };
+}
+
+BenchFunc CreateSoftmax(const BenchCase& bench_case,
+                        const CPUContext& dev_ctx) {
+  CheckShapes(bench_case, 1);
+  auto x = RandomTensor(dev_ctx, bench_case.shapes[0], -10.f, 10.f);
+  int axis = bench_case.Attr("axis", -1);
+  auto out = std::make_shared<DenseTensor>();
+  MetaTensor meta_out(out.get());
+  SoftmaxInferMeta(MetaTensor(x), axis, &meta_out);
+  return [&dev_ctx, x, axis, out]() {
+    SoftmaxKernel<float, CPUContext>(dev_ctx, x, axis, out.get());
+  };
+}
+
+const std::map<std::string, BenchCreator>& AllBenchCreators() {
+  static const std::map<std::string, BenchCreator> creators = {
+      {"matmul", CreateMatmul},
+      {"conv2d", CreateConv2d},
+      {"add", CreateAdd},
+      {"sum", CreateSum},
+      {"embedding", CreateEmbedding},
+      {"layer_norm", CreateLayerNorm},
+      {"softmax", CreateSoftmax},
+  };
+  return creators;
+}
+
+struct BenchResult {
+  std::string kernel;
+  std::string line;
+  double avg_us = 0;
+  double min_us = 0;
+  double median_us = 0;
+};
+
+BenchResult RunCase(const BenchCase& bench_case, const BenchFunc& func) {
+  for (int i = 0; i < FLAGS_burning; ++i) {
+    func();
+  }
+  std::vector<double> times;
+  times.reserve(FLAGS_repeat);
+  for (int i = 0; i < FLAGS_repeat; ++i) {
+    double start = static_cast<double>(phi::PosixInNsec()) * 1e-3;
+    func();
+    double end = static_cast<double>(phi::PosixInNsec()) * 1e-3;
+    times.push_back(end - start);
+  }
+  BenchResult result;
+  result.kernel = bench_case.kernel;
+  result.line = bench_case.line;
+  if (!times.empty()) {
+    std::sort(times.begin(), times.end());
+    double total = 0;
+    for (double t : times) {
+      total += t;
+    }
+    result.avg_us = total / times.size();
+    result.min_us = times.front();
+    result.median_us = times[times.size() / 2];
+  }
+  return result;
+}
+
+// Pins the main thread and the OpenMP threads of the kernels.
+std::vector<int> PinThreads() {
+  std::vector<int> cpus;
+  for (auto& cpu : Split(FLAGS_cpus, ',')) {
+    cpus.push_back(std::stoi(cpu));
+  }
+  if (cpus.empty()) {
+    return cpus;
+  }
+  if (!backends::cpu::SetCurrentThreadAffinity({cpus[0]})) {
+    LOG(WARNING) << "Failed to pin the threads to the cpus " << FLAGS_cpus;
+    return {};
+  }
+#ifdef _OPENMP
+#pragma omp parallel num_threads(FLAGS_threads)
+  {
+    int cpu = cpus[omp_get_thread_num() % cpus.size()];
+    backends::cpu::SetCurrentThreadAffinity({cpu});
+  }
+#endif
+  return cpus;
+}
+
+std::string BestIsa() {
+  using backends::cpu::MayIUse;
+  if (MayIUse(backends::cpu::avx512_bf16)) return "avx512_bf16";
+  if (MayIUse(backends::cpu::avx512_core_vnni)) return "avx512_core_vnni";
+  if (MayIUse(backends::cpu::avx512_core)) return "avx512_core";
+  if (MayIUse(backends::cpu::avx512f)) return "avx512f";
+  if (MayIUse(backends::cpu::avx2)) return "avx2";
+  if (MayIUse(backends::cpu::avx)) return "avx";
+  if (MayIUse(backends::cpu::sse42)) return "sse42";
+  return "isa_any";
+}
+
+std::string JsonString(const std::string& str) {
+  std::string out = "\"";
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+    }
+    out += c;
+  }
+  return out + "\"";
+}
+
+void WriteJson(const std::vector<BenchResult>& results,
+               const std::vector<int>& cpus,
+               std::ostream& os) {
+  os << "{\n";
+  os << "  \"isa\": " << JsonString(BestIsa()) << ",\n";
+  os << "  \"cpu_count\": " << backends::cpu::GetCpuCount() << ",\n";
+  os << "  \"threads\": " << FLAGS_threads << ",\n";
+  os << "  \"cpus\": [";
+  for (size_t i = 0; i < cpus.size(); ++i) {
+    os << (i == 0 ? "" : ", ") << cpus[i];
+  }
+  os << "],\n";
+  os << "  \"burning\": " << FLAGS_burning << ",\n";
+  os << "  \"repeat\": " << FLAGS_repeat << ",\n";
+#ifdef PADDLE_WITH_DNNL
+  os << "  \"onednn\": true,\n";
+#else
+  os << "  \"onednn\": false,\n";
+#endif
+  os << "  \"results\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const auto& r = results[i];
+    os << (i == 0 ? "\n" : ",\n") << "    {\"kernel\": " << JsonString(r.kernel)
+       << ", \"case\": " << JsonString(r.line) << ", \"avg_us\": " << r.avg_us
+       << ", \"median_us\": " << r.median_us << ", \"min_us\": " << r.min_us
+       << "}";
+  }
+  os << "\n  ]\n}\n";
+}
+
+int Run() {
+  std::vector<BenchCase> cases;
+  if (FLAGS_config.empty()) {
+    std::istringstream is(kDefaultSweep);
+    cases = ParseSweep(is);
+  } else {
+    std::ifstream is(FLAGS_config);
+    PADDLE_ENFORCE_EQ(is.is_open(),
+                      true,
+                      common::errors::NotFound("Cannot open the config %s.",
+                                               FLAGS_config));
+    cases = ParseSweep(is);
+  }
+  auto filter = Split(FLAGS_filter, ',');
+
+  paddle::platform::SetNumThreads(FLAGS_threads);
+  auto cpus = PinThreads();
+  const auto& dev_ctx = *static_cast<const CPUContext*>(
+      DeviceContextPool::Instance().Get(CPUPlace()));
+
+  std::vector<BenchResult> results;
+  for (const auto& bench_case : cases) {
+    if (!filter.empty() && std::find(filter.begin(),
+                                     filter.end(),
+                                     bench_case.kernel) == filter.end()) {
+      continue;
+    }
+    auto iter = AllBenchCreators().find(bench_case.kernel);
+    if (iter == AllBenchCreators().end()) {
+      PADDLE_THROW(common::errors::Unimplemented(
+          "The kernel of the case `%s` is not supported.", bench_case.line));
+    }
+    results.push_back(RunCase(bench_case, iter->second(bench_case, dev_ctx)));
+    LOG(INFO) << bench_case.line << " takes " << results.back().avg_us
+              << " us";
+  }
+
+  if (FLAGS_output.empty()) {
+    WriteJson(results, cpus, std::cout);
+  } else {
+    std::ofstream os(FLAGS_output);
+    WriteJson(results, cpus, os);
+  }
+  return 0;
+}
+
+}  // namespace tools
+}  // namespace phi
+
+int main(int argc, char* argv[]) {
+  paddle::flags::ParseCommandLineFlags(&argc, &argv);
+  google::InitGoogleLogging(argv[0]);
+  return phi::tools::Run();
+}
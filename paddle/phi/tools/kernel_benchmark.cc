@@ -0,0 +1,569 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// The benchmark of any kernel registered in the KernelFactory, for the cases
+// of a JSON list:
+//
+//   [
+//     {"kernel": "matmul", "dtype": "float16",
+//      "inputs": ["4096x4096", "4096x4096"], "outputs": ["4096x4096"],
+//      "attrs": [false, false], "flops": 137438953472},
+//     {"kernel": "embedding", "dtype": "float32",
+//      "inputs": [{"shape": "4096", "dtype": "int64", "high": 30522},
+//                 "30522x768"],
+//      "outputs": ["4096x768"], "attrs": [-1]},
+//     {"kernel": "layer_norm", "dtype": "float32",
+//      "inputs": ["128x768", null, null], "outputs": ["128x768", "128", "128"],
+//      "attrs": [1e-5, 1]}
+//   ]
+//
+// The inputs, outputs and attrs follow the order of the args of the kernel,
+// i.e. the args of its op in phi/ops/yaml. A null input is an absent optional
+// input, a list of shapes is a vector input, and a null output is left to the
+// kernel to resize. The outputs should have the shapes their InferMeta gives,
+// as the kernels expect them to be resized before running.
+//
+// The results are written as JSON, with the bandwidth, the FLOPs and the
+// efficiency against the roofline of --peak_gbps and --peak_tflops. With
+// --baseline, the results of an earlier run are compared to, and the exit code
+// is 1 if a case is slower than --max_regression of the baseline, to gate the
+// performance in CI.
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "glog/logging.h"
+#include "paddle/common/flags.h"
+#include "paddle/phi/api/profiler/device_tracer.h"
+#include "paddle/phi/backends/context_pool.h"
+#include "paddle/phi/backends/cpu/cpu_context.h"
+#include "paddle/phi/common/bfloat16.h"
+#include "paddle/phi/common/float16.h"
+#include "paddle/phi/common/place.h"
+#include "paddle/phi/core/compat/convert_utils.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/enforce.h"
+#include "paddle/phi/core/kernel_context.h"
+#include "paddle/phi/core/kernel_factory.h"
+#include "paddle/phi/core/tensor_utils.h"
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+#include "paddle/phi/kernels/autotune/gpu_timer.h"
+#endif
+
+PD_DEFINE_string(config, "", "The JSON file of the cases.");
+PD_DEFINE_string(output, "", "The JSON file of the results, stdout if empty.");
+PD_DEFINE_string(filter,
+                 "",
+                 "The comma separated kernels to run, all if empty.");
+PD_DEFINE_string(device, "cpu", "The device to run on, cpu or gpu:<id>.");
+PD_DEFINE_int32(burning, 10, "Burning times of each case.");
+PD_DEFINE_int32(repeat, 100, "Repeat times of each case.");
+PD_DEFINE_double(peak_gbps,
+                 0,
+                 "The peak memory bandwidth in GB/s of the device, for the "
+                 "roofline, not used if 0.");
+PD_DEFINE_double(peak_tflops,
+                 0,
+                 "The peak TFLOPS of the device for the dtype of the cases, "
+                 "for the roofline, not used if 0.");
+PD_DEFINE_string(baseline,
+                 "",
+                 "The JSON results of an earlier run to compare to.");
+PD_DEFINE_double(max_regression,
+                 0.05,
+                 "The most a case may be slower than the baseline, as a ratio "
+                 "of the median time of the baseline.");
+
+namespace phi {
+namespace tools {
+
+using json = nlohmann::json;
+
+struct BenchInput {
+  std::vector<int64_t> shape;
+  DataType dtype = DataType::UNDEFINED;
+  double low = 0;
+  double high = 0;
+};
+
+std::vector<std::string> Split(const std::string& str, char sep) {
+  std::vector<std::string> items;
+  std::stringstream ss(str);
+  std::string item;
+  while (std::getline(ss, item, sep)) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+std::vector<int64_t> ParseShape(const std::string& str) {
+  std::vector<int64_t> shape;
+  for (auto& dim : Split(str, 'x')) {
+    shape.push_back(std::stoll(dim));
+  }
+  return shape;
+}
+
+std::string CaseName(const json& bench_case) {
+  std::string name = bench_case.value("name", "");
+  return name.empty() ? bench_case.dump() : name;
+}
+
+Place ParsePlace(const std::string& device) {
+  if (device == "cpu") {
+    return CPUPlace();
+  }
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (device.rfind("gpu", 0) == 0) {
+    auto pos = device.find(':');
+    int id = pos == std::string::npos ? 0 : std::stoi(device.substr(pos + 1));
+    return GPUPlace(id);
+  }
+#endif
+  PADDLE_THROW(common::errors::InvalidArgument(
+      "The device should be cpu or gpu:<id>, but got %s.", device));
+}
+
+BenchInput ParseInput(const json& input, DataType dtype) {
+  BenchInput bench_input;
+  bench_input.dtype = dtype;
+  if (input.is_string()) {
+    bench_input.shape = ParseShape(input.get<std::string>());
+  } else {
+    bench_input.shape = ParseShape(input.at("shape").get<std::string>());
+    if (input.contains("dtype")) {
+      bench_input.dtype =
+          StringToDataType(input.at("dtype").get<std::string>());
+    }
+    bench_input.low = input.value("low", 0.0);
+    bench_input.high = input.value("high", 0.0);
+  }
+  if (bench_input.low == 0 && bench_input.high == 0) {
+    bool is_float = bench_input.dtype == DataType::FLOAT32 ||
+                    bench_input.dtype == DataType::FLOAT64 ||
+                    bench_input.dtype == DataType::FLOAT16 ||
+                    bench_input.dtype == DataType::BFLOAT16;
+    bench_input.low = is_float ? -1 : 0;
+    bench_input.high = is_float ? 1 : 2;
+  }
+  return bench_input;
+}
+
+template <typename T>
+void FillUniform(DenseTensor* tensor,
+                 double low,
+                 double high,
+                 std::mt19937* rng) {
+  T* data = tensor->data<T>();
+  bool is_int = std::is_integral<T>::value;
+  std::uniform_real_distribution<double> dist(low, high);
+  for (int64_t i = 0; i < tensor->numel(); ++i) {
+    double value = dist(*rng);
+    data[i] =
+        static_cast<T>(static_cast<float>(is_int ? std::floor(value) : value));
+  }
+}
+
+// The input is filled on the CPU with the uniform values in [low, high), the
+// integers are rounded down, then copied to the device.
+DenseTensor RandomTensor(const DeviceContext& dev_ctx,
+                         const BenchInput& input) {
+  const auto& cpu_ctx = *static_cast<const CPUContext*>(
+      DeviceContextPool::Instance().Get(CPUPlace()));
+  DenseTensor cpu_tensor;
+  cpu_tensor.Resize(common::make_ddim(input.shape));
+  cpu_ctx.Alloc(&cpu_tensor, input.dtype);
+  std::mt19937 rng(100);
+  switch (input.dtype) {
+    case DataType::FLOAT32:
+      FillUniform<float>(&cpu_tensor, input.low, input.high, &rng);
+      break;
+    case DataType::FLOAT64:
+      FillUniform<double>(&cpu_tensor, input.low, input.high, &rng);
+      break;
+    case DataType::FLOAT16:
+      FillUniform<dtype::float16>(&cpu_tensor, input.low, input.high, &rng);
+      break;
+    case DataType::BFLOAT16:
+      FillUniform<dtype::bfloat16>(&cpu_tensor, input.low, input.high, &rng);
+      break;
+    case DataType::INT32:
+      FillUniform<int32_t>(&cpu_tensor, input.low, input.high, &rng);
+      break;
+    case DataType::INT64:
+      FillUniform<int64_t>(&cpu_tensor, input.low, input.high, &rng);
+      break;
+    case DataType::UINT8:
+      FillUniform<uint8_t>(&cpu_tensor, input.low, input.high, &rng);
+      break;
+    case DataType::BOOL:
+      FillUniform<bool>(&cpu_tensor, input.low, input.high, &rng);
+      break;
+    default:
+      PADDLE_THROW(common::errors::Unimplemented(
+          "The inputs of %s are not supported.", input.dtype));
+  }
+  if (dev_ctx.GetPlace().GetType() == AllocationType::CPU) {
+    return cpu_tensor;
+  }
+  DenseTensor tensor;
+  Copy(dev_ctx, cpu_tensor, dev_ctx.GetPlace(), true, &tensor);
+  return tensor;
+}
+
+Attribute ParseAttr(const json& value, AttributeType type) {
+  switch (type) {
+    case AttributeType::BOOL:
+      return value.get<bool>();
+    case AttributeType::INT32:
+      return value.get<int>();
+    case AttributeType::INT64:
+      return value.get<int64_t>();
+    case AttributeType::FLOAT32:
+      return value.get<float>();
+    case AttributeType::FLOAT64:
+      return value.get<double>();
+    case AttributeType::STRING:
+      return value.get<std::string>();
+    case AttributeType::BOOLS:
+      return value.get<std::vector<bool>>();
+    case AttributeType::INT32S:
+      return value.get<std::vector<int>>();
+    case AttributeType::INT64S:
+      return value.get<std::vector<int64_t>>();
+    case AttributeType::FLOAT32S:
+      return value.get<std::vector<float>>();
+    case AttributeType::FLOAT64S:
+      return value.get<std::vector<double>>();
+    case AttributeType::STRINGS:
+      return value.get<std::vector<std::string>>();
+    case AttributeType::SCALAR:
+      if (value.is_boolean()) {
+        return Scalar(value.get<bool>());
+      } else if (value.is_number_integer()) {
+        return Scalar(value.get<int64_t>());
+      }
+      return Scalar(value.get<double>());
+    case AttributeType::INT_ARRAY:
+      return IntArray(value.get<std::vector<int64_t>>());
+    case AttributeType::DATA_TYPE:
+      return value.is_null() ? DataType::UNDEFINED
+                             : StringToDataType(value.get<std::string>());
+    case AttributeType::DATA_LAYOUT:
+      return common::StringToDataLayout(value.get<std::string>());
+    default:
+      PADDLE_THROW(common::errors::Unimplemented(
+          "The attribute %s of type %d is not supported.",
+          value.dump(),
+          static_cast<int>(type)));
+  }
+}
+
+// The tensors and the KernelContext of a case, which live during its runs.
+struct BenchRunner {
+  std::vector<std::unique_ptr<DenseTensor>> inputs;
+  std::vector<std::unique_ptr<DenseTensor>> outputs;
+  KernelContext ctx;
+  const Kernel* kernel = nullptr;
+
+  int64_t Bytes() const {
+    int64_t bytes = 0;
+    for (const auto& tensors : {&inputs, &outputs}) {
+      for (const auto& tensor : *tensors) {
+        if (tensor->initialized()) {
+          bytes += tensor->numel() * SizeOf(tensor->dtype());
+        }
+      }
+    }
+    return bytes;
+  }
+};
+
+void CreateRunner(const json& bench_case,
+                  DeviceContext* dev_ctx,
+                  BenchRunner* runner) {
+  std::string name = bench_case.at("kernel").get<std::string>();
+  DataType dtype = StringToDataType(bench_case.value("dtype", "float32"));
+  const auto& place = dev_ctx->GetPlace();
+  auto backend = TransToPhiBackend(place);
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (backend == Backend::GPU) {
+    backend = Backend::GPUDNN;
+  }
+#endif
+  const Kernel& kernel = KernelFactory::Instance().SelectKernelWithGPUDNN(
+      name, KernelKey(backend, DataLayout::ALL_LAYOUT, dtype));
+  PADDLE_ENFORCE_EQ(kernel.IsValid(),
+                    true,
+                    common::errors::NotFound(
+                        "The %s kernel of %s is not registered on %s.",
+                        dtype,
+                        name,
+                        place));
+  runner->kernel = &kernel;
+  const auto& args_def = kernel.args_def();
+  auto inputs = bench_case.value("inputs", json::array());
+  auto outputs = bench_case.value("outputs", json::array());
+  auto attrs = bench_case.value("attrs", json::array());
+  auto check_size = [&](const char* arg, size_t num, size_t expected) {
+    PADDLE_ENFORCE_EQ(num,
+                      expected,
+                      common::errors::InvalidArgument(
+                          "The %s kernel has %d %s, but the case %s has %d.",
+                          name,
+                          expected,
+                          arg,
+                          CaseName(bench_case),
+                          num));
+  };
+  check_size("inputs", inputs.size(), args_def.input_defs().size());
+  check_size("outputs", outputs.size(), args_def.output_defs().size());
+  check_size("attrs", attrs.size(), args_def.attribute_defs().size());
+
+  runner->ctx.SetDeviceContext(dev_ctx);
+  auto new_input = [&](const json& input) {
+    runner->inputs.push_back(std::make_unique<DenseTensor>(
+        RandomTensor(*dev_ctx, ParseInput(input, dtype))));
+    return runner->inputs.back().get();
+  };
+  for (const auto& input : inputs) {
+    if (input.is_null()) {
+      runner->ctx.EmplaceBackInput(nullptr);
+    } else if (input.is_array()) {
+      paddle::small_vector<const TensorBase*> tensors;
+      for (const auto& item : input) {
+        tensors.push_back(new_input(item));
+      }
+      runner->ctx.EmplaceBackInputs(std::move(tensors));
+    } else {
+      runner->ctx.EmplaceBackInput(new_input(input));
+    }
+  }
+  for (const auto& output : outputs) {
+    runner->outputs.push_back(std::make_unique<DenseTensor>());
+    if (!output.is_null()) {
+      runner->outputs.back()->Resize(
+          common::make_ddim(ParseShape(output.get<std::string>())));
+    }
+    runner->ctx.EmplaceBackOutput(runner->outputs.back().get());
+  }
+  for (size_t i = 0; i < attrs.size(); ++i) {
+    runner->ctx.EmplaceBackAttr(
+        ParseAttr(attrs[i], args_def.attribute_defs()[i].type_index));
+  }
+}
+
+struct BenchResult {
+  std::string kernel;
+  std::string name;
+  double avg_us = 0;
+  double min_us = 0;
+  double median_us = 0;
+  int64_t bytes = 0;
+  double flops = 0;
+};
+
+BenchResult RunCase(const json& bench_case, DeviceContext* dev_ctx) {
+  BenchRunner runner;
+  CreateRunner(bench_case, dev_ctx, &runner);
+  auto run = [&]() { (*runner.kernel)(&runner.ctx); };
+  for (int i = 0; i < FLAGS_burning; ++i) {
+    run();
+  }
+  dev_ctx->Wait();
+
+  std::vector<double> times;
+  times.reserve(FLAGS_repeat);
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (dev_ctx->GetPlace().GetType() == AllocationType::GPU) {
+    auto stream = static_cast<GPUContext*>(dev_ctx)->stream();
+    GpuTimer timer;
+    for (int i = 0; i < FLAGS_repeat; ++i) {
+      timer.Start(stream);
+      run();
+      timer.Stop(stream);
+      times.push_back(timer.ElapsedTime() * 1e3);
+    }
+  }
+#endif
+  if (dev_ctx->GetPlace().GetType() == AllocationType::CPU) {
+    for (int i = 0; i < FLAGS_repeat; ++i) {
+      double start = static_cast<double>(phi::PosixInNsec()) * 1e-3;
+      run();
+      double end = static_cast<double>(phi::PosixInNsec()) * 1e-3;
+      times.push_back(end - start);
+    }
+  }
+
+  BenchResult result;
+  result.kernel = bench_case.at("kernel").get<std::string>();
+  result.name = CaseName(bench_case);
+  result.bytes = runner.Bytes();
+  result.flops = bench_case.value("flops", 0.0);
+  if (!times.empty()) {
+    std::sort(times.begin(), times.end());
+    double total = 0;
+    for (double t : times) {
+      total += t;
+    }
+    result.avg_us = total / times.size();
+    result.min_us = times.front();
+    result.median_us = times[times.size() / 2];
+  }
+  return result;
+}
+
+// The achieved GB/s and TFLOPS of the median time, and the ratio of the
+// roofline time, i.e. the longer of moving the bytes at the peak bandwidth
+// and computing the FLOPs at the peak TFLOPS, to the median time.
+json RooflineJson(const BenchResult& r) {
+  json roofline;
+  if (r.median_us <= 0) {
+    return roofline;
+  }
+  double gbps = r.bytes / (r.median_us * 1e3);
+  double tflops = r.flops / (r.median_us * 1e6);
+  roofline["gbps"] = gbps;
+  if (r.flops > 0) {
+    roofline["tflops"] = tflops;
+  }
+  double bound_us = 0;
+  if (FLAGS_peak_gbps > 0) {
+    bound_us = std::max(bound_us, r.bytes / (FLAGS_peak_gbps * 1e3));
+  }
+  if (FLAGS_peak_tflops > 0 && r.flops > 0) {
+    bound_us = std::max(bound_us, r.flops / (FLAGS_peak_tflops * 1e6));
+  }
+  if (bound_us > 0) {
+    roofline["efficiency"] = bound_us / r.median_us;
+  }
+  return roofline;
+}
+
+// Returns the cases slower than the baseline by more than --max_regression.
+std::vector<std::string> CompareBaseline(
+    const std::vector<BenchResult>& results) {
+  std::ifstream is(FLAGS_baseline);
+  PADDLE_ENFORCE_EQ(
+      is.is_open(),
+      true,
+      common::errors::NotFound("Cannot open the baseline %s.", FLAGS_baseline));
+  json baseline = json::parse(is);
+  std::map<std::string, double> baseline_us;
+  for (const auto& r : baseline.at("results")) {
+    baseline_us[r.at("case").get<std::string>()] =
+        r.at("median_us").get<double>();
+  }
+  std::vector<std::string> regressions;
+  for (const auto& r : results) {
+    auto iter = baseline_us.find(r.name);
+    if (iter == baseline_us.end() || iter->second <= 0) {
+      continue;
+    }
+    double ratio = r.median_us / iter->second;
+    LOG(INFO) << r.name << " takes " << r.median_us << " us, "
+              << iter->second << " us in the baseline";
+    if (ratio > 1 + FLAGS_max_regression) {
+      regressions.push_back(r.name);
+      LOG(WARNING) << "Regression of " << (ratio - 1) * 100
+                   << "% in the case " << r.name;
+    }
+  }
+  return regressions;
+}
+
+void WriteJson(const std::vector<BenchResult>& results,
+               const std::vector<std::string>& regressions,
+               std::ostream& os) {
+  json out;
+  out["device"] = FLAGS_device;
+  out["burning"] = FLAGS_burning;
+  out["repeat"] = FLAGS_repeat;
+  out["peak_gbps"] = FLAGS_peak_gbps;
+  out["peak_tflops"] = FLAGS_peak_tflops;
+  out["results"] = json::array();
+  for (const auto& r : results) {
+    json record;
+    record["kernel"] = r.kernel;
+    record["case"] = r.name;
+    record["avg_us"] = r.avg_us;
+    record["median_us"] = r.median_us;
+    record["min_us"] = r.min_us;
+    record["bytes"] = r.bytes;
+    record["roofline"] = RooflineJson(r);
+    out["results"].push_back(record);
+  }
+  if (!FLAGS_baseline.empty()) {
+    out["baseline"] = FLAGS_baseline;
+    out["regressions"] = regressions;
+  }
+  os << out.dump(2) << std::endl;
+}
+
+int Run() {
+  std::ifstream is(FLAGS_config);
+  PADDLE_ENFORCE_EQ(
+      is.is_open(),
+      true,
+      common::errors::NotFound("Cannot open the config %s.", FLAGS_config));
+  json cases = json::parse(is);
+  auto filter = Split(FLAGS_filter, ',');
+  auto* dev_ctx = DeviceContextPool::Instance().Get(ParsePlace(FLAGS_device));
+
+  std::vector<BenchResult> results;
+  for (const auto& bench_case : cases) {
+    std::string kernel = bench_case.at("kernel").get<std::string>();
+    if (!filter.empty() &&
+        std::find(filter.begin(), filter.end(), kernel) == filter.end()) {
+      continue;
+    }
+    results.push_back(RunCase(bench_case, dev_ctx));
+    LOG(INFO) << results.back().name << " takes " << results.back().median_us
+              << " us";
+  }
+
+  std::vector<std::string> regressions;
+  if (!FLAGS_baseline.empty()) {
+    regressions = CompareBaseline(results);
+  }
+  if (FLAGS_output.empty()) {
+    WriteJson(results, regressions, std::cout);
+  } else {
+    std::ofstream os(FLAGS_output);
+    WriteJson(results, regressions, os);
+  }
+  return regressions.empty() ? 0 : 1;
+}
+
+}  // namespace tools
+}  // namespace phi
+
+int main(int argc, char* argv[]) {
+  paddle::flags::ParseCommandLineFlags(&argc, &argv);
+  google::InitGoogleLogging(argv[0]);
+  return phi::tools::Run();
+}
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <functional>
 #include <list>
 
 #include "paddle/phi/common/complex.h"
@@ -139,6 +140,11 @@ class Builder {
 
   IR_API Operation *Insert(Operation *op);
 
+  /// Set the function called with each operation inserted by the builder.
+  void set_insert_listener(const std::function<void(Operation *)> &listener) {
+    insert_listener_ = listener;
+  }
+
   /// Create an operation of specific op type at the current insertion point.
   template <typename OpTy, typename... Args>
   OpTy Build(Args &&...args);
@@ -183,6 +189,8 @@ class Builder {
   // bw, opt region.
   int op_role_ = -1;
   int chunk_id_ = -1;
+
+  std::function<void(Operation *)> insert_listener_;
 };
 
 template <typename OpTy, typename... Args>
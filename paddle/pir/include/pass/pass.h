@@ -215,6 +215,9 @@ class IR_API PatternRewritePass : public Pass {
   FrozenRewritePatternSet patterns_;
 
   GreedyRewriteConfig config_;
+
+  // For running the consecutive ones by one driver.
+  friend class detail::PassAdaptor;
 };
 
 }  // namespace pir
@@ -119,11 +119,35 @@ class IR_API PassManager {
     value_replaced_hook_ = hook;
   }
 
+  // Run the pipeline over the nested ops isolated from above, i.e. using only
+  // the values defined in themselves, by num_threads threads. Each thread
+  // runs its own passes created from the PassRegistry, so it takes effect
+  // only if all the passes are registered and there is no instrumentation.
+  // The default is FLAGS_pir_pass_num_threads.
+  void EnableMultiThreading(size_t num_threads) { num_threads_ = num_threads; }
+
+  size_t num_threads() const { return num_threads_; }
+
+  // Run the consecutive PatternRewritePasses with only the op specific
+  // patterns by one incremental rewrite driver over their merged patterns,
+  // the patterns of the former passes are tried first on each op. It takes
+  // effect only if there is no instrumentation. The default is
+  // FLAGS_pir_fuse_pattern_rewrite_passes.
+  void EnablePatternRewriteFusion(bool enable) {
+    fuse_pattern_rewrite_ = enable;
+  }
+
+  bool pattern_rewrite_fusion() const { return fuse_pattern_rewrite_; }
+
  private:
   bool Initialize(IrContext *context);
 
   bool Run(Operation *op);
 
+  // The pass manager with the same passes for another thread, nullptr if
+  // some pass is not registered.
+  std::unique_ptr<PassManager> ClonePipeline() const;
+
  private:
   IrContext *context_;
 
@@ -133,6 +157,10 @@ class IR_API PassManager {
 
   bool disable_log_{false};
 
+  size_t num_threads_{1};
+
+  bool fuse_pattern_rewrite_{false};
+
   std::vector<std::unique_ptr<Pass>> passes_;
 
   std::unique_ptr<Pass> pass_adaptor_;
@@ -49,6 +49,11 @@ class IR_API FrozenRewritePatternSet {
       const std::vector<std::string>& disabled_pattern_labels = {},
       const std::vector<std::string>& enabled_pattern_labels = {});
 
+  /// Merge the op specific patterns of `sets` by their order, the patterns are
+  /// still owned by `sets`, which is shared by the merged one.
+  explicit FrozenRewritePatternSet(
+      const std::vector<FrozenRewritePatternSet>& sets);
+
   /// Return the op specific native patterns held by this list.
   const OpSpecificNativePatternListT& op_specific_native_patterns() const {
     return impl_->op_specific_native_pattern_map_;
@@ -66,6 +71,8 @@ class IR_API FrozenRewritePatternSet {
     NativePatternListT op_specific_native_patterns_;
 
     NativePatternListT match_any_op_native_patterns_;
+
+    std::vector<std::shared_ptr<Impl>> merged_impls_;
   };
 
   std::shared_ptr<Impl> impl_;
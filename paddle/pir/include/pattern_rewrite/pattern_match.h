@@ -291,7 +291,10 @@ class RewriterBase : public Builder {
                     std::function<bool(OpOperand&)> functor);
 
  protected:
-  explicit RewriterBase(IrContext* ctx) : Builder(ctx) {}
+  explicit RewriterBase(IrContext* ctx) : Builder(ctx) {
+    set_insert_listener(
+        [this](Operation* op) { NotifyOperationInserted(op); });
+  }
 
   virtual ~RewriterBase();
 
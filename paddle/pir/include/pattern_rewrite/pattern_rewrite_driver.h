@@ -14,8 +14,11 @@
 
 #pragma once
 
+#include <functional>
+
 #include "paddle/pir/include/core/dll_decl.h"
 #include "paddle/pir/include/core/region.h"
+#include "paddle/pir/include/pattern_rewrite/pattern_match.h"
 
 namespace pir {
 
@@ -62,6 +65,15 @@ class IR_API GreedyRewriteConfig {
   // Hook function for replacing the value.
   VALUE_REPLACED_HOOK_FUNC value_replaced_hook = nullptr;
 
+  /// Scan the region only in the first iteration. The ops inserted or updated
+  /// by the rewrites are added to the worklist as they change, and the later
+  /// iterations revisit only the ops changed in the last iteration and their
+  /// users, instead of the whole region.
+  bool incremental = false;
+
+  /// Order the patterns of the same op, the default is by their benefits.
+  std::function<PatternBenefit(const Pattern&)> cost_model = nullptr;
+
   static constexpr int64_t kNoLimit = -1;
 };
 
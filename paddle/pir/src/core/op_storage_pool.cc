@@ -0,0 +1,117 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/pir/src/core/op_storage_pool.h"
+
+#include <array>
+#include <mutex>
+#include <vector>
+
+#include "paddle/common/enforce.h"
+#include "paddle/common/flags.h"
+#include "paddle/pir/include/core/utils.h"
+
+COMMON_DECLARE_bool(pir_operation_storage_pool);
+
+namespace pir {
+namespace detail {
+
+namespace {
+
+constexpr size_t kAlignment = 16;
+constexpr size_t kMaxPooledSize = 1024;
+constexpr size_t kSlabSize = 64 * 1024;
+constexpr size_t kNumSizeClasses = kMaxPooledSize / kAlignment;
+
+size_t SizeClassOf(size_t size) { return (size + kAlignment - 1) / kAlignment; }
+
+class Pool {
+ public:
+  void *Allocate(size_t size) {
+    size_t size_class = SizeClassOf(size);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (FreeNode *node = free_lists_[size_class - 1]) {
+      free_lists_[size_class - 1] = node->next;
+      return node;
+    }
+    size_t bytes = size_class * kAlignment;
+    if (slab_left_ < bytes) {
+      slab_ = static_cast<char *>(aligned_malloc(kSlabSize, kAlignment));
+      if (slab_ == nullptr) {
+        slab_left_ = 0;
+        return nullptr;
+      }
+      slabs_.push_back(slab_);
+      slab_left_ = kSlabSize;
+    }
+    void *ptr = slab_;
+    slab_ += bytes;
+    slab_left_ -= bytes;
+    return ptr;
+  }
+
+  void Deallocate(void *ptr, size_t size) {
+    auto *node = static_cast<FreeNode *>(ptr);
+    size_t size_class = SizeClassOf(size);
+    std::lock_guard<std::mutex> lock(mutex_);
+    node->next = free_lists_[size_class - 1];
+    free_lists_[size_class - 1] = node;
+  }
+
+ private:
+  struct FreeNode {
+    FreeNode *next;
+  };
+
+  std::mutex mutex_;
+  std::array<FreeNode *, kNumSizeClasses> free_lists_{};
+  std::vector<char *> slabs_;
+  char *slab_{nullptr};
+  size_t slab_left_{0};
+};
+
+// Never destroyed, for the operations destroyed at exit.
+Pool &GlobalPool() {
+  static Pool *pool = new Pool();
+  return *pool;
+}
+
+bool IsPooled(size_t size) {
+  // read once, the storage allocated should be deallocated in the same way
+  static const bool enabled = FLAGS_pir_operation_storage_pool;
+  return enabled && size > 0 && size <= kMaxPooledSize;
+}
+
+}  // namespace
+
+void *OpStoragePool::Allocate(size_t size) {
+  void *ptr = IsPooled(size) ? GlobalPool().Allocate(size)
+                             : aligned_malloc(size, 8);
+  PADDLE_ENFORCE_NOT_NULL(
+      ptr,
+      common::errors::ResourceExhausted(
+          "Failed to allocate %d bytes for the operation.", size));
+  return ptr;
+}
+
+void OpStoragePool::Deallocate(void *ptr, size_t size) {
+  if (IsPooled(size)) {
+    GlobalPool().Deallocate(ptr, size);
+  } else {
+    aligned_free(ptr);
+  }
+}
+
+}  // namespace detail
+}  // namespace pir
@@ -0,0 +1,40 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+
+#include "paddle/pir/include/core/dll_decl.h"
+
+namespace pir {
+namespace detail {
+///
+/// \brief The storage of the operations, i.e. their results, operands and
+/// regions. The small ones are carved from the slabs and recycled by the free
+/// lists of their sizes, the others are allocated by aligned_malloc. The
+/// slabs are kept for the process, since the operations may outlive or move
+/// between the programs.
+///
+class IR_API OpStoragePool {
+ public:
+  /// The storage aligned by 8 bytes.
+  static void *Allocate(size_t size);
+
+  /// The size should be the same as the one allocated.
+  static void Deallocate(void *ptr, size_t size);
+};
+
+}  // namespace detail
+}  // namespace pir
@@ -26,6 +26,7 @@
 #include "paddle/pir/include/core/utils.h"
 #include "paddle/pir/src/core/block_operand_impl.h"
 #include "paddle/pir/src/core/op_result_impl.h"
+#include "paddle/pir/src/core/op_storage_pool.h"
 
 namespace pir {
 using detail::OpInlineResultImpl;
@@ -78,7 +79,7 @@ Operation *Operation::Create(const std::vector<Value> &inputs,
                      region_mem_size + block_operand_size;
   // 2. Malloc memory.
   char *base_ptr =
-      reinterpret_cast<char *>(detail::aligned_malloc(base_size, 8));
+      reinterpret_cast<char *>(detail::OpStoragePool::Allocate(base_size));
 
   auto name = op_info ? op_info.name() : "";
   VLOG(10) << "Create Operation [" << name
@@ -241,10 +242,14 @@ void Operation::Destroy() {
                 sizeof(detail::OpInlineResultImpl) * OUTLINE_RESULT_IDX
           : sizeof(detail::OpInlineResultImpl) * num_results_;
   void *aligned_ptr = reinterpret_cast<char *>(this) - result_mem_size;
+  size_t base_size = result_mem_size + sizeof(Operation) +
+                     sizeof(detail::OpOperandImpl) * num_operands_ +
+                     sizeof(Region) * num_regions_ +
+                     sizeof(detail::BlockOperandImpl) * num_successors_;
 
   VLOG(10) << "Destroy Operation [" << name() << "]: {ptr = " << aligned_ptr
-           << ", size = " << result_mem_size << "} done.";
-  detail::aligned_free(aligned_ptr);
+           << ", size = " << base_size << "} done.";
+  detail::OpStoragePool::Deallocate(aligned_ptr, base_size);
 }
 
 IrContext *Operation::ir_context() const { return info_.ir_context(); }
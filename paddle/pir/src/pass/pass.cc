@@ -14,6 +14,17 @@
 
 #include <glog/logging.h>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "paddle/pir/include/core/block_argument.h"
 #include "paddle/pir/include/core/ir_context.h"
 #include "paddle/pir/include/core/operation.h"
 #include "paddle/pir/include/core/program.h"
@@ -22,13 +33,62 @@
 #include "paddle/pir/include/pass/pass.h"
 #include "paddle/pir/include/pass/pass_instrumentation.h"
 #include "paddle/pir/include/pass/pass_manager.h"
+#include "paddle/pir/include/pass/pass_registry.h"
 #include "paddle/pir/include/pattern_rewrite/pattern_match.h"
 #include "paddle/pir/src/pass/pass_adaptor.h"
 
 #include "paddle/common/enforce.h"
+#include "paddle/common/flags.h"
+
+COMMON_DECLARE_int32(pir_pass_num_threads);
+COMMON_DECLARE_bool(pir_fuse_pattern_rewrite_passes);
 
 namespace pir {
 
+namespace {
+
+// Whether the ops in the regions of op use only the values defined in op, so
+// that the passes over op do not change the use lists of the values outside.
+bool IsIsolatedFromAbove(Operation* op) {
+  std::unordered_set<const Operation*> ops;
+  std::unordered_set<const Block*> blocks;
+  op->Walk([&](Operation* nested) {
+    if (nested == op) return;
+    ops.insert(nested);
+    for (size_t i = 0; i < nested->num_regions(); ++i) {
+      for (auto& block : nested->region(i)) {
+        blocks.insert(&block);
+      }
+    }
+  });
+  for (size_t i = 0; i < op->num_regions(); ++i) {
+    for (auto& block : op->region(i)) {
+      blocks.insert(&block);
+    }
+  }
+  bool isolated = true;
+  op->Walk([&](Operation* nested) {
+    if (nested == op || !isolated) return;
+    for (uint32_t i = 0; i < nested->num_operands(); ++i) {
+      Value value = nested->operand_source(i);
+      if (!value) continue;
+      if (Operation* def = value.defining_op()) {
+        isolated = ops.count(def) > 0;
+      } else if (auto arg = value.dyn_cast<BlockArgument>()) {
+        isolated = blocks.count(arg.owner()) > 0;
+      }
+      if (!isolated) return;
+    }
+  });
+  return isolated;
+}
+
+// Set in the threads running the pipelines concurrently, whose nested ops run
+// on the same thread.
+thread_local bool in_parallel_pipeline = false;
+
+}  // namespace
+
 //===----------------------------------------------------------------------===//
 // Pass
 //===----------------------------------------------------------------------===//
@@ -109,20 +169,127 @@ void detail::PassAdaptor::RunImpl(Operation* op,
                                   uint8_t opt_level,
                                   bool verify) {
   auto last_am = analysis_manager();
+  const bool parallel = pm_->num_threads() > 1 && !in_parallel_pipeline &&
+                        last_am.GetPassInstrumentor() == nullptr;
 
+  // the isolated ops with regions run after the others of the block
+  std::vector<Operation*> isolated_ops;
   for (size_t i = 0; i < op->num_regions(); ++i) {
     auto& region = op->region(i);
     for (auto& block : region) {
       for (auto& op : block) {
+        if (parallel && op.num_regions() > 0 && IsIsolatedFromAbove(&op)) {
+          isolated_ops.push_back(&op);
+          continue;
+        }
         AnalysisManagerHolder am(&op, last_am.GetPassInstrumentor());
         if (!RunPipeline(*pm_, &op, am, opt_level, verify))
           return SignalPassFailure();
       }
     }
   }
+  if (!RunParallel(isolated_ops, opt_level, verify)) {
+    return SignalPassFailure();
+  }
   return;
 }
 
+bool detail::PassAdaptor::RunParallel(const std::vector<Operation*>& ops,
+                                      uint8_t opt_level,
+                                      bool verify) {
+  size_t num_threads = std::min(pm_->num_threads(), ops.size());
+  std::vector<std::unique_ptr<PassManager>> pms;
+  for (size_t i = 1; i < num_threads; ++i) {
+    auto pm = pm_->ClonePipeline();
+    if (!pm) {
+      VLOG(4) << "Run the pipelines sequentially for some pass is not "
+                 "registered.";
+      pms.clear();
+      break;
+    }
+    pms.push_back(std::move(pm));
+  }
+
+  std::atomic<size_t> next{0};
+  std::atomic<bool> failed{false};
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto worker = [&](const PassManager& pm) {
+    in_parallel_pipeline = true;
+    try {
+      for (size_t i = next++; i < ops.size() && !failed; i = next++) {
+        AnalysisManagerHolder am(ops[i], nullptr);
+        if (!RunPipeline(pm, ops[i], am, opt_level, verify)) {
+          failed = true;
+        }
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (!error) error = std::current_exception();
+      failed = true;
+    }
+    in_parallel_pipeline = false;
+  };
+
+  VLOG(4) << "Run the pipelines over " << ops.size() << " ops by "
+          << pms.size() + 1 << " threads.";
+  std::vector<std::thread> threads;
+  for (auto& pm : pms) {
+    threads.emplace_back(worker, std::cref(*pm));
+  }
+  // the passes of pm_ run on this thread, the nested adaptor of pm_ is not
+  // shared with the others
+  worker(*pm_);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return !failed;
+}
+
+void detail::PassAdaptor::RunPatternRewrites(
+    const std::vector<PatternRewritePass*>& passes, Operation* op) {
+  std::vector<FrozenRewritePatternSet> sets;
+  // the patterns of the former passes rank higher than the latter ones
+  std::unordered_map<const Pattern*, uint32_t> ranks;
+  GreedyRewriteConfig config = passes.front()->InitializeConfig();
+  for (size_t i = 0; i < passes.size(); ++i) {
+    sets.push_back(passes[i]->patterns_);
+    for (const auto& it : passes[i]->patterns_.op_specific_native_patterns()) {
+      for (const auto* pattern : it.second) {
+        ranks.emplace(pattern, static_cast<uint32_t>(passes.size() - i));
+      }
+    }
+    int64_t max_iterations = passes[i]->InitializeConfig().max_iterations;
+    if (max_iterations == GreedyRewriteConfig::kNoLimit ||
+        config.max_iterations == GreedyRewriteConfig::kNoLimit) {
+      config.max_iterations = GreedyRewriteConfig::kNoLimit;
+    } else {
+      config.max_iterations = std::max(config.max_iterations, max_iterations);
+    }
+  }
+  config.incremental = true;
+  config.cost_model = [&ranks](const Pattern& pattern) {
+    return PatternBenefit((ranks.at(&pattern) << 16) +
+                          std::min(pattern.benefit().benefit(), 0xffffu));
+  };
+  if (passes.front()->Has(Pass::kValueReplaceHookAttr)) {
+    config.value_replaced_hook =
+        passes.front()->Get<VALUE_REPLACED_HOOK_FUNC>(
+            Pass::kValueReplaceHookAttr);
+  }
+
+  VLOG(4) << "Run " << passes.size() << " PatternRewritePasses from "
+          << passes.front()->name() << " by one driver";
+  FrozenRewritePatternSet patterns(sets);
+  auto [_, num_rewrites] = ApplyPatternsGreedily(op, patterns, config);
+  for (auto* pass : passes) {
+    pass->AddStatistics(num_rewrites);
+  }
+}
+
 bool detail::PassAdaptor::RunPipeline(const PassManager& pm,
                                       Operation* op,
                                       AnalysisManager am,
@@ -133,13 +300,36 @@ bool detail::PassAdaptor::RunPipeline(const PassManager& pm,
     instrumentor->RunBeforePipeline(op);
   }
 
-  for (auto& pass : pm.passes()) {
-    if (pass->CanApplyOn(op)) {
-      if (!RunPass(pass.get(), op, am, opt_level, verify)) {
+  const bool fuse = pm.fuse_pattern_rewrite_ && !instrumentor;
+  std::vector<PatternRewritePass*> pattern_passes;
+  auto RunPatternPasses = [&]() {
+    if (pattern_passes.size() == 1) {
+      if (!RunPass(pattern_passes.front(), op, am, opt_level, verify)) {
         return false;
       }
+    } else if (pattern_passes.size() > 1) {
+      RunPatternRewrites(pattern_passes, op);
+      if (verify) pir::Verify(op, true);
+    }
+    pattern_passes.clear();
+    return true;
+  };
+  for (auto& pass : pm.passes()) {
+    if (!pass->CanApplyOn(op) || opt_level < pass->pass_info().opt_level) {
+      continue;
+    }
+    auto* pattern_pass = dynamic_cast<PatternRewritePass*>(pass.get());
+    if (fuse && pattern_pass &&
+        pattern_pass->patterns_.match_any_op_native_patterns().empty()) {
+      pattern_passes.push_back(pattern_pass);
+      continue;
+    }
+    if (!RunPatternPasses()) return false;
+    if (!RunPass(pass.get(), op, am, opt_level, verify)) {
+      return false;
     }
   }
+  if (!RunPatternPasses()) return false;
 
   if (instrumentor) {
     instrumentor->RunAfterPipeline(op);
@@ -185,7 +375,10 @@ bool detail::PassAdaptor::RunPass(Pass* pass,
 // PassManager
 //----------------------------------------------------------------------------------------------//
 PassManager::PassManager(IrContext* context, uint8_t opt_level)
-    : context_(context), opt_level_(opt_level) {
+    : context_(context),
+      opt_level_(opt_level),
+      num_threads_(std::max(FLAGS_pir_pass_num_threads, 1)),
+      fuse_pattern_rewrite_(FLAGS_pir_fuse_pattern_rewrite_passes) {
   pass_adaptor_ = std::make_unique<detail::PassAdaptor>(this);
 }
 
@@ -215,6 +408,31 @@ bool PassManager::Initialize(IrContext* context) {
   return true;
 }
 
+std::unique_ptr<PassManager> PassManager::ClonePipeline() const {
+  auto pm = std::make_unique<PassManager>(context_, opt_level_);
+  pm->verify_ = verify_;
+  pm->fuse_pattern_rewrite_ = fuse_pattern_rewrite_;
+  pm->value_replaced_hook_ = value_replaced_hook_;
+  for (auto& pass : passes_) {
+    if (!PassRegistry::Instance().Has(pass->name())) {
+      return nullptr;
+    }
+    auto clone = PassRegistry::Instance().Get(pass->name());
+    // the attributes are owned by the original passes, which outlive the
+    // clones
+    for (auto& attr : pass->attrs_) {
+      if (attr.first != Pass::kValueReplaceHookAttr) {
+        clone->attrs_[attr.first] = attr.second;
+      }
+    }
+    pm->AddPass(std::move(clone));
+  }
+  if (!pm->Initialize(context_)) {
+    return nullptr;
+  }
+  return pm;
+}
+
 void PassManager::AddInstrumentation(std::unique_ptr<PassInstrumentation> pi) {
   if (!instrumentor_) instrumentor_ = std::make_unique<PassInstrumentor>();
 
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "paddle/pir/include/pass/pass.h"
 
 namespace pir {
@@ -34,12 +36,22 @@ class PassAdaptor final : public Pass {
  private:
   void RunImpl(Operation* op, uint8_t opt_level, bool verify);
 
+  // Run the pipelines over the ops concurrently, returns false if some
+  // pipeline fails.
+  bool RunParallel(const std::vector<Operation*>& ops,
+                   uint8_t opt_level,
+                   bool verify);
+
   static bool RunPass(Pass* pass,
                       Operation* op,
                       AnalysisManager am,
                       uint8_t opt_level,
                       bool verify);
 
+  // Run the patterns of the passes by one driver over op.
+  static void RunPatternRewrites(const std::vector<PatternRewritePass*>& passes,
+                                 Operation* op);
+
   static bool RunPipeline(const PassManager& pm,
                           Operation* op,
                           AnalysisManager am,
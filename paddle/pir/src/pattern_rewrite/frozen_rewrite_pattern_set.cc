@@ -20,6 +20,7 @@
 #include <set>
 #include <string>
 
+#include "paddle/common/enforce.h"
 #include "paddle/pir/include/core/op_info.h"
 
 namespace pir {
@@ -97,4 +98,20 @@ FrozenRewritePatternSet::FrozenRewritePatternSet(
   }
 }
 
+FrozenRewritePatternSet::FrozenRewritePatternSet(
+    const std::vector<FrozenRewritePatternSet>& sets)
+    : impl_(std::make_shared<Impl>()) {
+  for (const auto& set : sets) {
+    PADDLE_ENFORCE_EQ(set.match_any_op_native_patterns().empty(),
+                      true,
+                      common::errors::InvalidArgument(
+                          "Only the op specific patterns can be merged."));
+    for (const auto& it : set.op_specific_native_patterns()) {
+      auto& patterns = impl_->op_specific_native_pattern_map_[it.first];
+      patterns.insert(patterns.end(), it.second.begin(), it.second.end());
+    }
+    impl_->merged_impls_.push_back(set.impl_);
+  }
+}
+
 }  // namespace pir
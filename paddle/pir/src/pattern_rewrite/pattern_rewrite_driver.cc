@@ -45,7 +45,11 @@ class GreedyPatternRewriteDriver : public pir::PatternRewriter {
         region_(*config.region),
         matcher_(patterns) {
     worklist_.reserve(128);
-    matcher_.ApplyDefaultCostModel();
+    if (config.cost_model) {
+      matcher_.ApplyCostModel(config.cost_model);
+    } else {
+      matcher_.ApplyDefaultCostModel();
+    }
     if (config.strict_mode != pir::GreedyRewriteStrictness::AnyOp) {
       for (auto& block : region_) {
         for (auto& op_item : block) {
@@ -71,11 +75,16 @@ class GreedyPatternRewriteDriver : public pir::PatternRewriter {
       worklist_.clear();
       worklist_map_.clear();
 
-      for (auto& block_item : region_) {
-        for (auto& op_item : block_item) {
-          worklist_.push_back(&op_item);
+      if (config_.incremental && iteration > 1) {
+        CollectChangedOps();
+      } else {
+        for (auto& block_item : region_) {
+          for (auto& op_item : block_item) {
+            worklist_.push_back(&op_item);
+          }
         }
       }
+      changed_ops_.clear();
       if (config_.use_top_down_traversal) {
         // Reverse the list so out pop-back loop process them in-order.
         std::reverse(worklist_.begin(), worklist_.end());
@@ -93,6 +102,32 @@ class GreedyPatternRewriteDriver : public pir::PatternRewriter {
   }
 
  private:
+  /// The worklist of the incremental iteration, the ops changed in the last
+  /// iteration and their users in the region by the order of the region.
+  void CollectChangedOps() {
+    std::unordered_set<pir::Operation*> ops;
+    for (auto& block_item : region_) {
+      for (auto& op_item : block_item) {
+        if (!changed_ops_.count(&op_item)) continue;
+        ops.insert(&op_item);
+        for (uint32_t i = 0; i < op_item.num_results(); ++i) {
+          auto result = op_item.result(i);
+          for (auto it = result.use_begin(); it != result.use_end(); ++it) {
+            ops.insert(it->owner());
+          }
+        }
+      }
+    }
+    for (auto& block_item : region_) {
+      for (auto& op_item : block_item) {
+        if (ops.count(&op_item)) {
+          worklist_.push_back(&op_item);
+        }
+      }
+    }
+    VLOG(6) << "Revisit " << worklist_.size() << " changed ops";
+  }
+
   /// Process ops until the worklist is empty or `config.max_num_rewrites`
   /// is reached. Return `true` if any IR was changed.
   int64_t ProcessWorklist() {
@@ -151,9 +186,12 @@ class GreedyPatternRewriteDriver : public pir::PatternRewriter {
     if (config_.strict_mode != pir::GreedyRewriteStrictness::AnyOp) {
       strict_mode_filtered_ops_.erase(op);
     }
+    changed_ops_.erase(op);
   }
 
   void NotifyOperationInserted(pir::Operation* op) override {
+    // the full scans of the next iterations visit the new ops otherwise
+    if (!config_.incremental) return;
     if (config_.strict_mode == pir::GreedyRewriteStrictness::ExistingAndNewOps)
       strict_mode_filtered_ops_.insert(op);
     AddToWorklist(op);
@@ -169,6 +207,7 @@ class GreedyPatternRewriteDriver : public pir::PatternRewriter {
   void AddToWorklist(pir::Operation* op) {
     if (config_.strict_mode == pir::GreedyRewriteStrictness::AnyOp ||
         strict_mode_filtered_ops_.count(op)) {
+      if (config_.incremental) changed_ops_.insert(op);
       if (worklist_map_.count(op)) return;
 
       worklist_map_[op] = worklist_.size();
@@ -212,6 +251,8 @@ class GreedyPatternRewriteDriver : public pir::PatternRewriter {
  private:
   std::vector<pir::Operation*> worklist_;
   std::unordered_map<pir::Operation*, unsigned> worklist_map_;
+  // the ops inserted or updated in the iteration, for the incremental one
+  std::unordered_set<pir::Operation*> changed_ops_;
   pir::GreedyRewriteConfig config_;
   std::unordered_set<pir::Operation*> strict_mode_filtered_ops_;
   pir::Region& region_;
@@ -722,4 +722,6 @@ def disable_tensor_checker() -> None:
             >>> #      return _C_ops.elementwise_pow(x, y)
 
     """
+    # report the outputs checked with FLAGS_check_nan_inf_lazy
+    paddle.base.core.flush_nan_inf_check()
     paddle.set_flags({"FLAGS_check_nan_inf": 0})
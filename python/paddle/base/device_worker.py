@@ -626,11 +626,15 @@ class Section(DeviceWorker):
         # then runs Backward phase for all microbatches.
         # 1F1B scheduler, which runs forward phase and backward phase alternatively
         # after startup phase.
-        assert schedule_mode_str in ["F-then-B", "1F1B"], (
-            "The schedule mode " "for pipeline must be one of F-then-B or 1F1B"
+        # Interleaved-1F1B scheduler, which runs 1F1B over the model chunks
+        # of each stage marked by the chunk_id attr of the ops.
+        schedule_modes = ["F-then-B", "1F1B", "Interleaved-1F1B"]
+        assert schedule_mode_str in schedule_modes, (
+            "The schedule mode for pipeline must be one of F-then-B, 1F1B or "
+            "Interleaved-1F1B"
         )
-        schedule_mode = 0 if schedule_mode_str == "F-then-B" else 1
-        section_param.schedule_mode = schedule_mode
+        section_param.schedule_mode = schedule_modes.index(schedule_mode_str)
+        section_param.num_model_chunks = pipeline_opt.get("num_model_chunks", 1)
         cfg = section_param.section_config
         program = pipeline_opt["section_program"]
         cfg.program_desc.ParseFromString(
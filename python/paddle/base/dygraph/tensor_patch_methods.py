@@ -1400,15 +1400,21 @@ def monkey_patch_tensor():
             "version": 2,
         }
 
-    def __dlpack__(self, stream=None):
+    def __dlpack__(self, stream=None, *, max_version=None, copy=None):
         """
         Creates a DLPack capsule of the current tensor to be exported to other libraries.
         Args:
             stream (int | None): An optional Python integer representing a pointer
-                                to a CUDA stream. Synchronizes the tensor with this
-                                stream before exporting.
+                                to a CUDA stream of the consumer. The consumer stream
+                                waits the work queued on the current stream of the
+                                tensor with an event, without synchronizing the device.
                                 If None or -1, no synchronization is performed.
-                                If 0, the default stream is used.
+                                If 1 or 2, the legacy or per-thread default stream is used.
+            max_version (tuple[int, int] | None): The max DLPack version supported by
+                                the consumer. Only the unversioned capsule is exported,
+                                which the protocol allows for any version.
+            copy (bool | None): If True, the tensor is copied before exporting.
+                                Otherwise the capsule shares the memory of the tensor.
         """
 
         if self.is_sparse():
@@ -1423,15 +1429,15 @@ def monkey_patch_tensor():
                 "If gradients aren't required, use tensor.detach() to get a tensor without gradient."
             )
 
-        if stream is not None:
-            if self.place.is_gpu_place():
-                current_stream = paddle.device.cuda.current_stream()
-                if stream != current_stream:
-                    event = paddle.device.cuda.Event()
-                    event.record(current_stream)
-                    current_stream.synchronize()
+        x = self.clone() if copy else self
+        dense = x.value().get_tensor()
+        if stream is not None and stream != -1 and x.place.is_gpu_place():
+            current_stream = paddle.device.cuda.current_stream(
+                x.place.gpu_device_id()
+            )
+            return dense._to_dlpack(stream, current_stream.cuda_stream)
 
-        return paddle.to_dlpack(self)
+        return dense._to_dlpack()
 
     if not hasattr(core, "eager"):
         return
@@ -14,7 +14,7 @@
 
 import logging
 import os
-from collections import deque
+from collections import OrderedDict, deque
 from enum import Enum
 
 import paddle
@@ -498,3 +498,117 @@ class CUDAGraphedLayer(paddle.nn.Layer):
 
     def is_cuda_graph_step(self):
         return self.context.is_cuda_graph_step()
+
+
+def _signature_of(x):
+    # The signature of a tensor is its meta, the other leaves are captured as
+    # constants into the graph, so their values are a part of the signature.
+    if isinstance(x, paddle.Tensor):
+        return (
+            'tensor',
+            tuple(x.shape),
+            str(x.dtype),
+            str(x.place),
+            x.stop_gradient,
+        )
+    if isinstance(x, (list, tuple)):
+        return (type(x).__name__, tuple(_signature_of(item) for item in x))
+    if isinstance(x, dict):
+        return (
+            'dict',
+            tuple((key, _signature_of(value)) for key, value in x.items()),
+        )
+    hash(x)
+    return (type(x).__name__, x)
+
+
+def input_signature(args, kwargs):
+    """Returns the hashable signature of the inputs, or None if some leaves of
+    the inputs are not hashable."""
+    try:
+        return (_signature_of(args), _signature_of(kwargs))
+    except TypeError:
+        return None
+
+
+class CUDAGraphedFunction:
+    """
+    CUDAGraphedFunction: Captures the eager ops of a function into CUDA Graphs
+    and replays them for the later calls with the same input signature.
+
+    For the small models whose eager execution is bound by the host overhead,
+    the python code, the InferMeta, the kernel selection and the launches are
+    all skipped in the replay. The signature consists of the shape, dtype,
+    place and stop_gradient of the input tensors and the values of the other
+    inputs, and every signature owns a graph with its own memory pool so that
+    the buffers are stable.
+
+    Usage:
+        graphed_step = CUDAGraphedFunction(step)
+        for x in data:
+            y = graphed_step(x)
+
+    Parameters:
+    - function (callable): The function to be captured.
+    - num_warmup_steps (int): The number of eager calls of each signature
+      before the capture. Default is 1.
+    - max_num_graphs (int): The maximum number of the cached graphs, the least
+      recently used one is released when it is exceeded. Default is 8.
+
+    Notes:
+    - The function runs under paddle.no_grad(), use CUDAGraphedLayer for the
+      training with autograd.
+    - The replay returns the same output tensors of the capture, they are
+      overwritten by the next replay of the same signature.
+    - The restrictions of CUDAGraphedLayer also apply.
+    """
+
+    def __init__(self, function, num_warmup_steps=1, max_num_graphs=8):
+        assert num_warmup_steps >= 0 and max_num_graphs > 0
+        self.function = function
+        self.num_warmup_steps = num_warmup_steps
+        self.max_num_graphs = max_num_graphs
+        # signature -> [number of eager calls, CUDAGraphWithStaticInputOutput]
+        self.graphs = OrderedDict()
+
+    def __call__(self, *args, **kwargs):
+        key = input_signature(args, kwargs)
+        with paddle.no_grad():
+            if key is None or debug_cudagraphedlayer_fallback_to_default:
+                return self.function(*args, **kwargs)
+
+            entry = self.graphs.get(key)
+            if entry is None:
+                entry = [0, None]
+                self.graphs[key] = entry
+                self._evict()
+            else:
+                self.graphs.move_to_end(key)
+
+            if entry[1] is not None:
+                debug_print(f"[CUDAGraph] Function Step (Graph) {key}")
+                return entry[1].replay(*args, **kwargs)
+
+            if entry[0] < self.num_warmup_steps:
+                debug_print(f"[CUDAGraph] Function Step (Default) {key}")
+                entry[0] += 1
+                return self.function(*args, **kwargs)
+
+            debug_print(f"[CUDAGraph] Function Step (Record) {key}")
+            entry[1] = CUDAGraphWithStaticInputOutput(self.num_warmup_steps)
+            return entry[1].record(self.function, *args, **kwargs)
+
+    def _evict(self):
+        while len(self.graphs) > self.max_num_graphs:
+            _, (_, graph) = self.graphs.popitem(last=False)
+            if graph is not None:
+                graph.graph.reset()
+
+    def num_graphs(self):
+        return sum(1 for _, graph in self.graphs.values() if graph is not None)
+
+    def reset(self):
+        for _, graph in self.graphs.values():
+            if graph is not None:
+                graph.graph.reset()
+        self.graphs.clear()
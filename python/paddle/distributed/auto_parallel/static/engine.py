@@ -71,6 +71,7 @@ from .pir_pass import (
     check_chunk_id,
     complete_chunk_id,
     fuse_attention_ffn_qkv_pass,
+    fuse_grad_all_reduce_pass,
     pipeline_pass,
     remove_unuseful_comm_op_pass,
 )
@@ -872,10 +873,8 @@ class Engine:
         # Part 4: Optimization Pass
         # NOTE Only those Optimization Pass that related to Parallelism (need dist attr) should be placed here and all the Pass should be Optional.
 
-        # TODO(xxxx) Step 4.1 DP Optimization Pass
-        if self._strategy.dp_optimization.enable:
-            # dist_program = apply_dp_optimization_pass(dist_program)
-            pass
+        # Step 4.1 DP Optimization Pass, which runs on the dense program, see
+        # fuse_grad_all_reduce_pass below.
 
         # TODO(xxxx) Step 4.2 SP Optimization Pass
         if self._strategy.sp_optimization.enable:
@@ -918,6 +917,21 @@ class Engine:
         paddle.base.libpaddle.pir.apply_dist2dense_pass(dense_program)
         remove_unuseful_comm_op_pass(dense_program)
 
+        # the gradients are all-reduced when they are written, so the fusion
+        # does not apply to gradient merge and pipeline, which all-reduce the
+        # accumulated gradients
+        if (
+            mode == "train"
+            and self._strategy.dp_optimization.enable
+            and self._strategy.dp_optimization.fuse_all_reduce_ops
+            and not self._strategy.gradient_merge.enable
+            and not self._strategy.pipeline.enable
+        ):
+            fuse_grad_all_reduce_pass(
+                dense_program,
+                self._strategy.dp_optimization.fuse_grad_size_in_MB,
+            )
+
         if core._enable_dist_prim_all():
             logging.info("apply decompose in auto parallel")
             with decomp.prim_guard():
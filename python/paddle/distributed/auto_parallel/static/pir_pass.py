@@ -17,9 +17,12 @@ import logging
 import re
 from dataclasses import dataclass
 
+import numpy as np
+
 import paddle
 import paddle.distributed as dist
 from paddle import pir
+from paddle.base import core
 from paddle.autograd.backward_utils import ValueDict
 from paddle.base.framework import EagerParamBase, pir_op_role_guard
 from paddle.base.log_helper import get_logger
@@ -685,6 +688,114 @@ def remove_unuseful_comm_op_pass(program):
             op.erase()
 
 
+def _grad_all_reduce_bucket_key(op, op_index):
+    # the all_reduce of a gradient produced by a backward op of the block
+    if op.name() != "pd_op.all_reduce":
+        return None
+    grad = op.operand_source(0)
+    grad_op = grad.get_defining_op()
+    if (
+        grad_op is None
+        or grad_op.id() not in op_index
+        or grad_op.op_role != int(OpRole.Backward)
+        or grad_op.name().endswith("_")
+        or not grad.has_one_use()
+        or not grad.is_dense_tensor_type()
+        or -1 in grad.shape
+    ):
+        return None
+    return (op.int_attr("ring_id"), op.int_attr("reduce_type"), grad.dtype)
+
+
+def fuse_grad_all_reduce_pass(program, fuse_grad_size_in_MB=32):
+    """
+    Fuses the all_reduce of the gradients of the dense program into buckets of
+    about fuse_grad_size_in_MB. The gradients of a bucket are views of one
+    persistable buffer, which the backward ops write into directly, so that no
+    gradient is copied. The bucket is all-reduced once right after the last
+    backward op writing one of its gradients, and the optimizer reads the
+    views of the reduced buffer.
+    """
+    block = program.global_block()
+    op_index = {op.id(): i for i, op in enumerate(block.ops)}
+    candidates = []
+    for op in block.ops:
+        key = _grad_all_reduce_bucket_key(op, op_index)
+        if key is not None:
+            grad_op = op.operand_source(0).get_defining_op()
+            candidates.append((op_index[grad_op.id()], key, op))
+    candidates.sort(key=lambda item: item[0])
+
+    # the buckets in the order their gradients are written
+    bucket_bytes = fuse_grad_size_in_MB * 1024 * 1024
+    buckets = []
+    open_buckets = {}
+    for _, key, op in candidates:
+        dtype = key[2]
+        grad = op.operand_source(0)
+        bucket = open_buckets.setdefault(key, {"ops": [], "bytes": 0})
+        bucket["ops"].append(op)
+        bucket["bytes"] += int(np.prod(grad.shape)) * core.size_of_dtype(dtype)
+        if bucket["bytes"] >= bucket_bytes:
+            buckets.append(open_buckets.pop(key))
+    buckets.extend(open_buckets.values())
+
+    place = paddle.base.libpaddle.Place()
+    place.set_place(paddle.framework._current_expected_place())
+    num_buckets = 0
+    num_fused_ops = 0
+    for bucket in buckets:
+        if len(bucket["ops"]) < 2:
+            continue
+        all_reduce_ops = bucket["ops"]
+        grads = [op.operand_source(0) for op in all_reduce_ops]
+        grad_ops = [grad.get_defining_op() for grad in grads]
+        ring_id = all_reduce_ops[0].int_attr("ring_id")
+        reduce_type = all_reduce_ops[0].int_attr("reduce_type")
+        dtype = grads[0].dtype
+        # align the views to 256 bytes, as the tensor fusion of sharding does
+        align_numel = max(256 // core.size_of_dtype(dtype), 1)
+        ranges = []
+        begin = 0
+        for grad in grads:
+            size = int(np.prod(grad.shape))
+            ranges.append((begin, begin + size))
+            begin += (size + align_numel - 1) // align_numel * align_numel
+
+        with pir_op_role_guard(int(OpRole.Backward)):
+            pir.set_insertion_point(grad_ops[0])
+            fused_grad = paddle._C_ops.empty([begin], dtype, place)
+            fused_grad.persistable = True
+            for grad, grad_op, (start, end) in zip(grads, grad_ops, ranges):
+                pir.set_insertion_point(grad_op)
+                grad_buffer = paddle._C_ops.view_shape(
+                    paddle._C_ops.view_slice(fused_grad, start, end),
+                    grad.shape,
+                )
+                pir.set_insertion_point_after(grad_op)
+                paddle._C_ops.share_var([grad, grad_buffer])
+
+            pir.set_insertion_point_after(grad_ops[-1])
+            ready_grad = paddle._C_ops.depend(fused_grad, grads)
+            reduced_grad = paddle._C_ops.all_reduce(
+                ready_grad, ring_id, reduce_type
+            )
+            for op, grad, (start, end) in zip(all_reduce_ops, grads, ranges):
+                reduced_view = paddle._C_ops.view_shape(
+                    paddle._C_ops.view_slice(reduced_grad, start, end),
+                    grad.shape,
+                )
+                op.result(0).replace_all_uses_with(reduced_view)
+                op.erase()
+        num_buckets += 1
+        num_fused_ops += len(all_reduce_ops)
+    pir.reset_insertion_point_to_end()
+    _logger.info(
+        f"fuse_grad_all_reduce_pass fused {num_fused_ops} all_reduce ops "
+        f"into {num_buckets} buckets."
+    )
+
+
 # In sequence_parallel, we need to transpose hidden_states
 # from [bs, seq, hidden] to [seq, bs, hidden] to perform
 # split and allgather at dim 0.
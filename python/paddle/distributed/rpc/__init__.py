@@ -18,6 +18,7 @@ from paddle.distributed.rpc.rpc import (
     get_worker_info,
     init_rpc,
     rpc_async,
+    rpc_async_batch,
     rpc_sync,
     shutdown,
 )
@@ -26,6 +27,7 @@ __all__ = [
     "init_rpc",
     "shutdown",
     "rpc_async",
+    "rpc_async_batch",
     "rpc_sync",
     "get_worker_info",
     "get_all_worker_infos",
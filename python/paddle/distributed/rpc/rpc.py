@@ -253,13 +253,70 @@ def rpc_async(
     return _invoke_rpc(to, fn, args, kwargs, timeout)
 
 
+def rpc_async_batch(
+    to: str,
+    calls: list[
+        tuple[
+            Callable[..., Any], tuple[Any, ...] | None, dict[str, Any] | None
+        ]
+    ],
+    timeout: int = _DEFAULT_RPC_TIMEOUT,
+) -> list[_FutureWrapper[Any]]:
+    """
+    Make non-blocking RPC calls to run the functions on worker ``to`` in one request,
+    which saves the round trips of many small calls. Attention: Users must use this API in a secure network environment.
+
+    Args:
+        to (str): name of the destination worker.
+        calls (list): the ``(fn, args, kwargs)`` tuples of the calls, where ``args``
+                      and ``kwargs`` could be None.
+        timeout (int, optional): timeout in seconds to use for the whole batch. A value
+                                 less than or equal to 0 indicates an infinite timeout.
+                                 The default value is -1.
+
+    Returns:
+        Returns a list of :class:`FutureWrapper` objects in the order of the calls.
+        A failed call raises an error when its future is waited, and doesn't fail
+        the other calls.
+
+    Examples:
+        .. code-block:: python
+
+            >>> # doctest: +REQUIRES(env:DISTRIBUTED)
+            >>> import paddle.distributed.rpc as rpc
+
+            >>> def add(a, b):
+            ...     return a + b
+
+            >>> rpc.init_rpc("worker0", rank=0, world_size=1,
+            ...         master_endpoint="127.0.0.1:8003")
+
+            >>> futs = rpc.rpc_async_batch("worker0", [(add, (2, 3), None), (add, (4, 5), None)])
+            >>> print([fut.wait() for fut in futs])
+            [5, 9]
+
+            >>> rpc.shutdown()
+
+    """
+    serial_objs = [
+        _serialize(
+            PythonFunc(fn, args if args else (), kwargs if kwargs else {})
+        )
+        for fn, args, kwargs in calls
+    ]
+    return core.invoke_rpc_batch(to, serial_objs, _timeout_ms(timeout))
+
+
+def _timeout_ms(timeout):
+    timeout_ms = timeout * 1000
+    return _MAX_RPC_TIMEOUT_MS if timeout_ms <= 0 else timeout_ms
+
+
 def _invoke_rpc(to, fn, args, kwargs, timeout):
     args = args if args else ()
     kwargs = kwargs if kwargs else {}
     serial_obj = _serialize(PythonFunc(fn, args, kwargs))
-    timeout_ms = timeout * 1000
-    timeout_ms = _MAX_RPC_TIMEOUT_MS if timeout_ms <= 0 else timeout_ms
-    future = core.invoke_rpc(to, serial_obj, timeout_ms)
+    future = core.invoke_rpc(to, serial_obj, _timeout_ms(timeout))
     return future
 
 
@@ -27,6 +27,7 @@ if TYPE_CHECKING:
     class _Kernel(TypedDict):
         enable: bool
         tuning_range: list[int] | tuple[int, int]
+        cache_file: NotRequired[str]
 
     class _Layout(TypedDict):
         enable: bool
@@ -41,7 +42,7 @@ if TYPE_CHECKING:
         dataloader: NotRequired[_Dataloader]
 
 
-__all__ = ['set_config']
+__all__ = ['set_config', 'export_kernel_cache', 'load_kernel_cache']
 
 
 def set_config(config: _ConfigKernel | str | None = None) -> None:
@@ -54,6 +55,9 @@ def set_config(config: _ConfigKernel | str | None = None) -> None:
 
     - enable(bool): Whether to enable kernel tuning.
     - tuning_range(list): Start and end iteration for auto-tuning. Default: [1, 10].
+    - cache_file(str): The file to load the tuned algorithms from when tuning is
+      enabled, and to export them to after the tuning range. The file is only
+      loaded on the same device arch and library versions. Default: "".
 
     2. layout: When it is enabled, the best data layout such as NCHW or NHWC will be
     determined based on the device and data type. When the origin layout setting is
@@ -123,6 +127,17 @@ def set_config(config: _ConfigKernel | str | None = None) -> None:
 
     if "kernel" in config_dict:
         kernel_config = config_dict["kernel"]
+        # The cache file is loaded when the kernel tuning is enabled.
+        if "cache_file" in kernel_config:
+            if isinstance(kernel_config['cache_file'], str):
+                paddle.set_flags(
+                    {'FLAGS_autotune_cache_file': kernel_config['cache_file']}
+                )
+            else:
+                warnings.warn(
+                    "The auto-tuning configuration of the kernel is incorrect."
+                    "The `cache_file` should be str. Use default parameter instead."
+                )
         if "enable" in kernel_config:
             if isinstance(kernel_config['enable'], bool):
                 if kernel_config['enable']:
@@ -179,3 +194,50 @@ def set_config(config: _ConfigKernel | str | None = None) -> None:
                     "The `tuning_steps` should be int. Use default parameter instead."
                 )
                 paddle.io.reader.set_autotune_config(use_autotune)
+
+
+def export_kernel_cache(path: str) -> int:
+    r"""
+    Export the algorithms selected by kernel auto-tuning to a file, so that
+    they could be loaded by other processes on the same device arch and library
+    versions to skip the tuning.
+
+    Args:
+        path (str): The path of the exported file.
+
+    Returns:
+        int, the number of the exported algorithms.
+
+    Examples:
+        .. code-block:: python
+
+            >>> import paddle
+            >>> num = paddle.incubate.autotune.export_kernel_cache('autotune_cache.txt')
+    """
+    return core.export_autotune_cache(path)
+
+
+def load_kernel_cache(path: str) -> int:
+    r"""
+    Load the algorithms exported by ``export_kernel_cache``. Nothing is loaded
+    if the file does not exist or was exported on a different device arch or
+    library versions.
+
+    Note:
+        Enabling or disabling kernel auto-tuning cleans the cache, so load the
+        cache after ``set_config``, or set ``cache_file`` in the kernel
+        configuration instead.
+
+    Args:
+        path (str): The path of the exported file.
+
+    Returns:
+        int, the number of the loaded algorithms.
+
+    Examples:
+        .. code-block:: python
+
+            >>> import paddle
+            >>> num = paddle.incubate.autotune.load_kernel_cache('autotune_cache.txt')
+    """
+    return core.import_autotune_cache(path)
@@ -19,6 +19,7 @@ from .nn import (  # noqa: F401
     batch_fc,
     correlation,
     fused_bn_add_act,
+    fused_embedding_seq_pool,
     fused_seqpool_cvm,
     partial_concat,
     partial_sum,
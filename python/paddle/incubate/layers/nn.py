@@ -129,6 +129,73 @@ def fused_seqpool_cvm(
     return outs
 
 
+def fused_embedding_seq_pool(
+    input: list[Tensor],
+    weight: Tensor,
+    pool_type: Literal['sum', 'average', 'sqrt'] = 'sum',
+) -> list[Tensor]:
+    """
+    This OP is the fusion of the embedding lookup and sequence_pool of all the
+    slots, with one GPU kernel for all the slots in the forward and one in the
+    backward, which accumulates the grad of ``weight`` over all the slots.
+
+    **Note:** The Op only runs on GPU.
+
+    Args:
+        input(list[Tensor]): The int64 ids of the slots, each a DenseTensor
+            of the shape ``[N, 1]`` with 1-level lod, whose sequences are the
+            instances of the batch.
+        weight(Tensor): The embedding table of the shape ``[rows, dim]``,
+            e.g. the pulled values of the slots.
+        pool_type(str, optional): ``'sum'``, ``'average'`` or ``'sqrt'``.
+            Default: ``'sum'``.
+
+    Returns:
+        list[Tensor]: The pooled embeddings of the shape ``[batch_size, dim]``
+        of the slots.
+
+    Examples:
+        .. code-block:: python
+
+            >>> import paddle
+            >>> paddle.enable_static()
+
+            >>> data = paddle.static.data(name='x', shape=[-1, 1], dtype='int64', lod_level=1)
+            >>> data2 = paddle.static.data(name='y', shape=[-1, 1], dtype='int64', lod_level=1)
+            >>> weight = paddle.static.create_parameter(shape=[100, 8], dtype='float32')
+            >>> outs = paddle.incubate.layers.fused_embedding_seq_pool([data, data2], weight, 'average')
+    """
+    pool_type = pool_type.upper()
+    if pool_type not in ['SUM', 'AVERAGE', 'SQRT']:
+        raise ValueError(
+            "fused_embedding_seq_pool only supports sum, average and sqrt "
+            "pooling, and your type is: " + pool_type
+        )
+    check_type(input, 'input', list, 'fused_embedding_seq_pool')
+    for _input in input:
+        check_variable_and_dtype(
+            _input, 'input', ['int64'], 'fused_embedding_seq_pool'
+        )
+    check_variable_and_dtype(
+        weight, 'weight', ['float32', 'float64'], 'fused_embedding_seq_pool'
+    )
+    if in_pir_mode():
+        return _C_ops.fused_embedding_seq_pool(input, weight, pool_type)
+
+    helper = LayerHelper('fused_embedding_seq_pool', **locals())
+    outs = [
+        helper.create_variable_for_type_inference(weight.dtype)
+        for i in range(len(input))
+    ]
+    helper.append_op(
+        type="fused_embedding_seq_pool",
+        inputs={"ids": input, "w": weight},
+        outputs={"out": outs},
+        attrs={"pooltype": pool_type},
+    )
+    return outs
+
+
 def search_pyramid_hash(
     input: Tensor,
     num_emb: int,
@@ -25,6 +25,7 @@ from .fused_dot_product_attention import (
 from .fused_dropout_add import fused_dropout_add
 from .fused_gate_attention import fused_gate_attention  # noqa: F401
 from .fused_layer_norm import fused_layer_norm
+from .fused_linear_cross_entropy import fused_linear_cross_entropy
 from .fused_matmul_bias import (
     fused_linear,
     fused_linear_activation,
@@ -40,6 +41,13 @@ from .fused_transformer import (
     fused_multi_transformer,
 )
 from .masked_multihead_attention import masked_multihead_attention
+from .packed_sequence import (
+    PackedSequence,
+    pack_sequence,
+    packed_attention,
+    packed_pool,
+    unpack_sequence,
+)
 from .swiglu import swiglu
 from .variable_length_memory_efficient_attention import (
     variable_length_memory_efficient_attention,
@@ -64,4 +72,10 @@ __all__ = [
     "blha_get_max_len",
     "block_multihead_attention",
     "swiglu",
+    "fused_linear_cross_entropy",
+    "PackedSequence",
+    "pack_sequence",
+    "unpack_sequence",
+    "packed_attention",
+    "packed_pool",
 ]
@@ -0,0 +1,203 @@
+# Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+from __future__ import annotations
+
+from typing import TYPE_CHECKING
+
+import paddle
+from paddle.autograd import PyLayer
+from paddle.framework import in_dynamic_mode
+
+if TYPE_CHECKING:
+    from paddle import Tensor
+
+
+def _chunk_logits(x, weight, bias, start, end):
+    logits = paddle.matmul(x, weight[:, start:end])
+    if bias is not None:
+        logits = logits + bias[start:end]
+    return logits.astype('float32')
+
+
+def _chunk_target(label, start, end):
+    # the positions of the labels in the chunk, and whether they are in it
+    in_chunk = paddle.logical_and(label >= start, label < end)
+    index = paddle.clip(label - start, 0, end - start - 1)
+    return in_chunk, index
+
+
+class FusedLinearCrossEntropy(PyLayer):
+    @staticmethod
+    def forward(ctx, x, weight, label, bias, ignore_index, reduction, chunk):
+        num_tokens = x.shape[0]
+        vocab_size = weight.shape[1]
+        # the log-sum-exp over the vocab is accumulated online, chunk by chunk
+        max_logit = paddle.full([num_tokens], float('-inf'), 'float32')
+        sum_exp = paddle.zeros([num_tokens], 'float32')
+        target_logit = paddle.zeros([num_tokens], 'float32')
+        for start in range(0, vocab_size, chunk):
+            end = min(start + chunk, vocab_size)
+            logits = _chunk_logits(x, weight, bias, start, end)
+            new_max = paddle.maximum(max_logit, logits.max(axis=1))
+            sum_exp = sum_exp * paddle.exp(max_logit - new_max) + paddle.exp(
+                logits - new_max.unsqueeze(1)
+            ).sum(axis=1)
+            max_logit = new_max
+            in_chunk, index = _chunk_target(label, start, end)
+            picked = paddle.take_along_axis(
+                logits, index.unsqueeze(1), axis=1
+            ).squeeze(1)
+            target_logit = target_logit + paddle.where(
+                in_chunk, picked, paddle.zeros_like(picked)
+            )
+        lse = max_logit + paddle.log(sum_exp)
+
+        valid = (label != ignore_index).astype('float32')
+        loss = (lse - target_logit) * valid
+        num_valid = paddle.clip(valid.sum(), min=1.0)
+
+        ctx.args = (ignore_index, reduction, chunk, bias is not None)
+        ctx.save_for_backward(x, weight, label, bias, lse, valid, num_valid)
+        if reduction == 'mean':
+            return loss.sum() / num_valid
+        if reduction == 'sum':
+            return loss.sum()
+        return loss
+
+    @staticmethod
+    def backward(ctx, grad):
+        x, weight, label, bias, lse, valid, num_valid = ctx.saved_tensor()
+        _, reduction, chunk, has_bias = ctx.args
+        vocab_size = weight.shape[1]
+
+        scale = grad.astype('float32') * valid
+        if reduction == 'mean':
+            scale = scale / num_valid
+        scale = scale.unsqueeze(1)
+
+        # the grads of the logits are rebuilt chunk by chunk from the lse
+        grad_x = paddle.zeros(x.shape, 'float32')
+        grad_weights = []
+        grad_biases = []
+        for start in range(0, vocab_size, chunk):
+            end = min(start + chunk, vocab_size)
+            logits = _chunk_logits(x, weight, bias, start, end)
+            grad_logits = paddle.exp(logits - lse.unsqueeze(1))
+            in_chunk, index = _chunk_target(label, start, end)
+            grad_logits = grad_logits - paddle.nn.functional.one_hot(
+                index, end - start
+            ) * in_chunk.astype('float32').unsqueeze(1)
+            grad_logits = (grad_logits * scale).astype(x.dtype)
+            grad_x = grad_x + paddle.matmul(
+                grad_logits, weight[:, start:end], transpose_y=True
+            ).astype('float32')
+            grad_weights.append(
+                paddle.matmul(x, grad_logits, transpose_x=True).astype(
+                    weight.dtype
+                )
+            )
+            if has_bias:
+                grad_biases.append(grad_logits.sum(axis=0).astype(bias.dtype))
+
+        grad_x = grad_x.astype(x.dtype)
+        grad_weight = paddle.concat(grad_weights, axis=1)
+        if has_bias:
+            return grad_x, grad_weight, None, paddle.concat(grad_biases)
+        return grad_x, grad_weight, None
+
+
+def fused_linear_cross_entropy(
+    x: Tensor,
+    weight: Tensor,
+    label: Tensor,
+    bias: Tensor | None = None,
+    ignore_index: int = -100,
+    reduction: str = 'mean',
+    chunk_size: int = 8192,
+    name: str | None = None,
+) -> Tensor:
+    """
+    Computes the softmax cross entropy of the linear projection
+    ``x @ weight + bias`` against the hard labels, chunk by chunk over the
+    vocab dimension, so that the full ``[tokens, vocab]`` logits and their
+    grad are never stored. The forward accumulates the log-sum-exp online
+    over the chunks, and the backward recomputes the logits of each chunk.
+
+    Args:
+        x (Tensor): The hidden states, with the shape ``[..., hidden]``.
+        weight (Tensor): The projection weight, with the shape
+            ``[hidden, vocab]``.
+        label (Tensor): The int64 labels, with the shape of ``x`` without
+            the last dim, or ending with 1.
+        bias (Tensor, optional): The projection bias, with the shape
+            ``[vocab]``. Default: None.
+        ignore_index (int, optional): The label whose loss is 0 and which is
+            excluded from the mean. Default: -100.
+        reduction (str, optional): ``'mean'``, ``'sum'`` or ``'none'``.
+            Default: ``'mean'``.
+        chunk_size (int, optional): The number of the vocab columns computed
+            at once. Default: 8192.
+        name (str, optional): For details, please refer to
+            :ref:`api_guide_Name`. Generally, no setting is required.
+            Default: None.
+
+    Returns:
+        Tensor: The float32 loss, a scalar unless ``reduction`` is
+        ``'none'``, in which case it has the shape of the tokens.
+
+    Examples:
+        .. code-block:: python
+
+            >>> import paddle
+            >>> import paddle.incubate.nn.functional as F
+            >>> x = paddle.randn([8, 16])
+            >>> weight = paddle.randn([16, 100])
+            >>> label = paddle.randint(0, 100, [8])
+            >>> loss = F.fused_linear_cross_entropy(x, weight, label, chunk_size=32)
+            >>> print(loss.shape)
+            []
+    """
+    assert reduction in [
+        'mean',
+        'sum',
+        'none',
+    ], f"The reduction should be mean, sum or none, but got {reduction}."
+    hidden_size = x.shape[-1]
+    token_shape = x.shape[:-1]
+    x_2d = x.reshape([-1, hidden_size])
+    label_1d = label.reshape([-1]).astype('int64')
+
+    if not in_dynamic_mode():
+        # The static graph keeps the plain composition.
+        logits = paddle.nn.functional.linear(x_2d, weight, bias).astype(
+            'float32'
+        )
+        loss = paddle.nn.functional.cross_entropy(
+            logits,
+            label_1d.unsqueeze(1),
+            ignore_index=ignore_index,
+            reduction=reduction,
+        )
+        return loss.reshape(token_shape) if reduction == 'none' else loss
+
+    loss = FusedLinearCrossEntropy.apply(
+        x_2d,
+        weight,
+        label_1d,
+        bias,
+        ignore_index,
+        reduction,
+        max(int(chunk_size), 1),
+    )
+    return loss.reshape(token_shape) if reduction == 'none' else loss
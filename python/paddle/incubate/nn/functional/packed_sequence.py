@@ -0,0 +1,203 @@
+# Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+from __future__ import annotations
+
+from typing import TYPE_CHECKING, NamedTuple
+
+import paddle
+
+if TYPE_CHECKING:
+    from paddle import Tensor
+
+
+class PackedSequence(NamedTuple):
+    """
+    The tokens of a padded batch without the padding.
+
+    Attributes:
+        data (Tensor): The valid tokens of all the sequences, one after the
+            other, with the shape ``[total_tokens, ...]``.
+        cu_seqlens (Tensor): The int32 offsets of the sequences in ``data``,
+            with the shape ``[batch_size + 1]``.
+        max_seqlen (int): The length of the longest sequence.
+        indices (Tensor): The int64 positions of the tokens of ``data`` in
+            the flattened ``[batch_size * padded_len]`` batch.
+        batch_size (int): The number of the sequences.
+        padded_len (int): The padded length of the batch.
+    """
+
+    data: Tensor
+    cu_seqlens: Tensor
+    max_seqlen: int
+    indices: Tensor
+    batch_size: int
+    padded_len: int
+
+
+def pack_sequence(x: Tensor, seq_lens: Tensor) -> PackedSequence:
+    """
+    Removes the padding of a batch of sequences. The token-wise layers, such
+    as embedding, linear and layer_norm, can run on ``PackedSequence.data``
+    directly, and only compute the valid tokens.
+
+    Args:
+        x (Tensor): The padded batch, with the shape
+            ``[batch_size, padded_len, ...]``.
+        seq_lens (Tensor): The lengths of the sequences, with the shape
+            ``[batch_size]``.
+
+    Returns:
+        PackedSequence: The packed tokens and their offsets.
+
+    Examples:
+        .. code-block:: python
+
+            >>> import paddle
+            >>> import paddle.incubate.nn.functional as F
+            >>> x = paddle.rand([2, 4, 8])
+            >>> packed = F.pack_sequence(x, paddle.to_tensor([3, 1]))
+            >>> print(packed.data.shape)
+            [4, 8]
+            >>> print(packed.cu_seqlens.numpy())
+            [0 3 4]
+    """
+    batch_size, padded_len = x.shape[0], x.shape[1]
+    seq_lens = seq_lens.astype('int64')
+    mask = paddle.arange(padded_len, dtype='int64').unsqueeze(
+        0
+    ) < seq_lens.unsqueeze(1)
+    indices = paddle.nonzero(mask.flatten()).flatten()
+    tokens = x.reshape([batch_size * padded_len, *x.shape[2:]])
+    data = paddle.gather(tokens, indices)
+    cu_seqlens = paddle.concat(
+        [paddle.zeros([1], 'int64'), paddle.cumsum(seq_lens)]
+    ).astype('int32')
+    max_seqlen = int(seq_lens.max()) if batch_size > 0 else 0
+    return PackedSequence(
+        data, cu_seqlens, max_seqlen, indices, batch_size, padded_len
+    )
+
+
+def unpack_sequence(
+    data: Tensor, packed: PackedSequence, padding_value: float = 0.0
+) -> Tensor:
+    """
+    Puts the packed tokens back into the padded batch they were packed from.
+
+    Args:
+        data (Tensor): The packed tokens, with the shape
+            ``[total_tokens, ...]``, e.g. the output of a layer run on
+            ``packed.data``.
+        packed (PackedSequence): The packing ``data`` follows.
+        padding_value (float, optional): The value of the padding.
+            Default: 0.0.
+
+    Returns:
+        Tensor: The padded batch, with the shape
+        ``[batch_size, padded_len, ...]``.
+    """
+    feature_shape = data.shape[1:]
+    batch = paddle.full(
+        [packed.batch_size * packed.padded_len, *feature_shape],
+        padding_value,
+        data.dtype,
+    )
+    batch = paddle.scatter(batch, packed.indices, data, overwrite=True)
+    return batch.reshape([packed.batch_size, packed.padded_len, *feature_shape])
+
+
+def packed_attention(
+    query: Tensor,
+    key: Tensor,
+    value: Tensor,
+    packed: PackedSequence,
+    scale: float | None = None,
+    dropout: float = 0.0,
+    causal: bool = False,
+    training: bool = True,
+) -> Tensor:
+    """
+    The self attention over each packed sequence, with the varlen flash
+    attention, so that no padded token is attended to or computed.
+
+    Args:
+        query (Tensor): The packed queries, with the shape
+            ``[total_tokens, num_heads, head_dim]``, in float16 or
+            bfloat16.
+        key (Tensor): The packed keys, with the shape of ``query``.
+        value (Tensor): The packed values, with the shape of ``query``.
+        packed (PackedSequence): The packing of the tokens.
+        scale (float, optional): The scale of ``QK^T``. Default: None, for
+            ``1 / sqrt(head_dim)``.
+        dropout (float, optional): The dropout ratio. Default: 0.0.
+        causal (bool, optional): Whether to use the causal mask.
+            Default: False.
+        training (bool, optional): Whether it is in training. Default: True.
+
+    Returns:
+        Tensor: The packed attention output, with the shape of ``query``.
+    """
+    if scale is None:
+        scale = query.shape[-1] ** -0.5
+    out, _ = paddle.nn.functional.flash_attention.flash_attn_unpadded(
+        query,
+        key,
+        value,
+        packed.cu_seqlens,
+        packed.cu_seqlens,
+        packed.max_seqlen,
+        packed.max_seqlen,
+        scale,
+        dropout=dropout,
+        causal=causal,
+        training=training,
+    )
+    return out
+
+
+def packed_pool(
+    data: Tensor, packed: PackedSequence, pool_type: str = 'mean'
+) -> Tensor:
+    """
+    Pools the packed tokens of each sequence.
+
+    Args:
+        data (Tensor): The packed tokens, with the shape
+            ``[total_tokens, ...]``.
+        packed (PackedSequence): The packing of the tokens.
+        pool_type (str, optional): ``'mean'``, ``'sum'``, ``'max'`` or
+            ``'min'``. Default: ``'mean'``.
+
+    Returns:
+        Tensor: The pooled sequences, with the shape ``[batch_size, ...]``.
+    """
+    assert pool_type in [
+        'mean',
+        'sum',
+        'max',
+        'min',
+    ], f"The pool_type should be mean, sum, max or min, but got {pool_type}."
+    seq_lens = (packed.cu_seqlens[1:] - packed.cu_seqlens[:-1]).astype('int64')
+    segment_ids = paddle.repeat_interleave(
+        paddle.arange(packed.batch_size, dtype='int64'), seq_lens
+    )
+    pool = getattr(paddle.geometric, f"segment_{pool_type}")
+    out = pool(data, segment_ids)
+    # the empty sequences at the end have no segment
+    if out.shape[0] < packed.batch_size:
+        rest = paddle.zeros(
+            [packed.batch_size - out.shape[0], *out.shape[1:]], out.dtype
+        )
+        out = paddle.concat([out, rest])
+    return out
@@ -159,3 +159,116 @@ def async_offload_with_offset(
     return async_loader.offload_with_offset(
         dst_tensor, src_tensor, dst_offset, src_offset, offload_size
     )
+
+
+class LayerwiseOffloader:
+    """
+    Keeps the parameters of a list of layers in pinned host memory, and swaps
+    each layer's parameters onto the GPU only around its forward.
+
+    Before layer ``i`` runs, the reloads of the next ``prefetch_depth`` layers
+    are issued on the AsyncLoad stream, so that their host to device copies
+    overlap with the computation of layer ``i``. After layer ``i`` runs, its
+    device copies are released. The layers are expected to run in the given
+    order, and the prefetch wraps around to the first layers for the next
+    forward. Only the forward is supported, the layers must be run with
+    gradients disabled.
+
+    Args:
+        layers (list[paddle.nn.Layer]): The layers, in the order they run.
+        prefetch_depth (int, optional): The number of layers reloaded ahead
+            of the running one. Default: 1.
+
+    Examples:
+        .. code-block:: python
+
+            >>> # doctest: +REQUIRES(env:GPU)
+            >>> import paddle
+            >>> from paddle.incubate.tensor.manipulation import LayerwiseOffloader
+            >>> model = paddle.nn.Sequential(
+            ...     *[paddle.nn.Linear(64, 64) for _ in range(4)]
+            ... )
+            >>> offloader = LayerwiseOffloader(list(model), prefetch_depth=1)
+            >>> with paddle.no_grad():
+            ...     out = model(paddle.randn([8, 64]))
+            >>> offloader.remove()
+    """
+
+    def __init__(self, layers, prefetch_depth=1):
+        self._layers = list(layers)
+        assert len(self._layers) > 0, "The layers should not be empty."
+        self._depth = min(max(int(prefetch_depth), 1), len(self._layers) - 1)
+        self._loader = create_async_load()
+        # per layer, the (param, host copy) pairs
+        self._host_params = []
+        # layer index -> the (param, device copy, task) of its reload
+        self._pending = {}
+        self._hooks = []
+
+        offloads = []
+        for layer in self._layers:
+            pairs = []
+            for param in layer.parameters():
+                host_param, task = async_offload(param, self._loader)
+                pairs.append((param, host_param))
+                offloads.append(task)
+            self._host_params.append(pairs)
+        for task in offloads:
+            task.cpu_wait()
+        for pairs in self._host_params:
+            for param, _ in pairs:
+                param._clear_data()
+
+        for i, layer in enumerate(self._layers):
+            self._hooks.append(
+                layer.register_forward_pre_hook(self._make_pre_hook(i))
+            )
+            self._hooks.append(
+                layer.register_forward_post_hook(self._make_post_hook(i))
+            )
+
+    def _reload(self, index):
+        if index in self._pending:
+            return
+        reloads = []
+        for param, host_param in self._host_params[index]:
+            device_param, task = async_reload(host_param, self._loader)
+            reloads.append((param, device_param, task))
+        self._pending[index] = reloads
+
+    def _make_pre_hook(self, index):
+        def pre_hook(layer, inputs):
+            assert (
+                not paddle.is_grad_enabled()
+            ), "LayerwiseOffloader only supports the forward without grad."
+            num_layers = len(self._layers)
+            for i in range(index, index + self._depth + 1):
+                self._reload(i % num_layers)
+            for param, device_param, task in self._pending.pop(index):
+                # the calc stream waits for the copy, not the host
+                task.cuda_wait()
+                device_param._share_buffer_to(param)
+
+        return pre_hook
+
+    def _make_post_hook(self, index):
+        def post_hook(layer, inputs, outputs):
+            # the allocator of the calc stream keeps the memory until the
+            # kernels of this layer finished
+            for param, _ in self._host_params[index]:
+                param._clear_data()
+
+        return post_hook
+
+    def remove(self):
+        """Removes the hooks and loads all the parameters back to the GPU."""
+        for hook in self._hooks:
+            hook.remove()
+        self._hooks = []
+        for i in range(len(self._layers)):
+            self._reload(i)
+        for reloads in self._pending.values():
+            for param, device_param, task in reloads:
+                task.cuda_wait()
+                device_param._share_buffer_to(param)
+        self._pending = {}
@@ -393,9 +393,19 @@ def _worker_loop(
                 batch, structure = _flatten_batch(batch)
                 if use_shared_memory:
 
+                    use_file_descriptor = core.globals()[
+                        "FLAGS_dataloader_use_file_descriptor"
+                    ]
+
                     def numpy2lodtensor(arr):
                         lodtensor = core.DenseTensor()
-                        lodtensor.set(arr, core.CPUPlace())
+                        # NOTE: share the memory of the array and copy it to
+                        # the shared memory here once, the pickling of the
+                        # queue reuses the shared memory instead of copying
+                        # the tensor again.
+                        lodtensor.set(arr, core.CPUPlace(), True)
+                        if arr.size > 0:
+                            lodtensor._share_filename(use_file_descriptor)
                         return lodtensor
 
                     tensor_list = [
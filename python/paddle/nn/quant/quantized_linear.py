@@ -74,7 +74,7 @@ def weight_quantize(
         x (Tensor): The input Tensor to be quantized, the data type is float16 or bfloat16.
         algo (str): The algo that is x will be apply, must be one of 'weight_only_int8',
             'weight_only_int4' and 'llm.int8', default: 'weight_only_int8'.
-        arch (int): The compute arch for target device. For example, A100 is 80, v100 is 70, if you do not assign arch, we will get arch from your device, default: None.
+        arch (int): The compute arch for target device. For example, A100 is 80, v100 is 70, and 0 is the layout of the cpu kernels. If you do not assign arch, we will get arch from your device, default: None.
         group_size (int): The group size for weight quantization. -1 stands for default per-channel mode. Currently only support 64 or 128.
 
     Returns:
@@ -100,13 +100,14 @@ def weight_quantize(
 
     if is_compiled_with_cuda():
         assert (
-            arch == 70
+            arch == 0
+            or arch == 70
             or arch == 75
             or arch == 80
             or arch == 86
             or arch == 89
             or arch == 90
-        ), f"Currently weight_quantize only support SM70/75/80/86/89/90. but got {arch} "
+        ), f"Currently weight_quantize only support 0 (cpu) and SM70/75/80/86/89/90. but got {arch} "
 
     assert (
         group_size == -1 or group_size == 64 or group_size == 128
@@ -143,10 +144,10 @@ def weight_dequantize(
         scale (Tensor): The scale Tensor which is the output of weight_quantize, the data type is float32.
         algo (str): The algo that is x will be apply, must be one of 'weight_only_int8',
             'weight_only_int4' and 'llm.int8', default: 'weight_only_int8'.
-        out_dtype (str|np.dtype): The output Tensor's data type, must be one of 'float16' and 'bfloat16', default: 'float16'.
+        out_dtype (str|np.dtype): The output Tensor's data type, must be one of 'float16', 'bfloat16' and 'float32' (cpu), default: 'float16'.
 
     Returns:
-        out (Tensor): The Tensor which is the dequantitative results, the data type is float16 or bfloat16, the shape is transposition of x.
+        out (Tensor): The Tensor which is the dequantitative results, the data type is float16, bfloat16 or float32 (cpu), the shape is transposition of x.
 
     Examples:
         .. code-block:: python
@@ -165,7 +166,10 @@ def weight_dequantize(
     ), f"Currently group_size only support -1/64/128. but got {group_size} "
 
     check_dtype(
-        out_dtype, 'out_dtype', ['float16', 'bfloat16'], 'weight_dequantize'
+        out_dtype,
+        'out_dtype',
+        ['float16', 'bfloat16', 'float32'],
+        'weight_dequantize',
     )
     out_dtype = convert_np_dtype_to_dtype_(out_dtype)
     if in_dynamic_or_pir_mode():
@@ -234,13 +238,14 @@ def weight_only_linear(
 
     if is_compiled_with_cuda():
         assert (
-            arch == 70
+            arch == 0
+            or arch == 70
             or arch == 75
             or arch == 80
             or arch == 86
             or arch == 89
             or arch == 90
-        ), f"Currently weight_quantize only support SM70/75/80/86/89/90. but got {arch} "
+        ), f"Currently weight_quantize only support 0 (cpu) and SM70/75/80/86/89/90. but got {arch} "
     assert (
         group_size == -1 or group_size == 64 or group_size == 128
     ), f"Currently weight_quantize only support group size of -1, 64 or 128. but got {group_size} "
@@ -55,6 +55,7 @@ __all__ = [
     'generate_proposals',
     'read_file',
     'decode_jpeg',
+    'resized_crop_normalize',
     'roi_pool',
     'RoIPool',
     'psroi_pool',
@@ -1438,6 +1439,86 @@ def decode_jpeg(
         return out
 
 
+def resized_crop_normalize(
+    x: Tensor,
+    boxes: Tensor,
+    size: Size2,
+    mean: float | Sequence[float],
+    std: float | Sequence[float],
+    flips: Tensor | None = None,
+    name: str | None = None,
+) -> Tensor:
+    """
+    Crops a box of each image in a batch, resizes the crop bilinearly, flips
+    it horizontally optionally, and normalizes each channel in one kernel,
+    which is the usual augmentation of the training images after
+    ``paddle.vision.ops.decode_jpeg`` .
+
+    Each output element is computed as ``(crop_resize(x)[c] - mean[c]) / std[c]``,
+    where the bilinear interpolation follows ``align_corners=False``.
+
+    Args:
+        x (Tensor): The images with shape (N, C, H, W), C should be no more
+            than 4. The data type can be uint8 or float32.
+        boxes (Tensor): The crop boxes of the images with shape (N, 4) and
+            data type int32, given as [[top, left, height, width], ...].
+        size (int|Tuple(int, int)): The output size (H, W). If int, H and W
+            are both equal to size.
+        mean (float|Sequence[float]): The mean of each channel, in the range
+            of the pixel values of x.
+        std (float|Sequence[float]): The standard deviation of each channel,
+            in the range of the pixel values of x.
+        flips (Tensor|None, optional): A bool tensor with shape (N,), the
+            images whose flags are True are flipped horizontally. Default:
+            None, which means no image is flipped.
+        name (str, optional): The default value is None. Normally there is no
+            need for user to set this property. For more information, please
+            refer to :ref:`api_guide_Name`.
+
+    Returns:
+        Tensor: The float32 images with shape (N, C, size[0], size[1]).
+
+    Examples:
+        .. code-block:: python
+
+            >>> import paddle
+            >>> x = paddle.randint(0, 255, [2, 3, 32, 48]).astype('uint8')
+            >>> boxes = paddle.to_tensor([[0, 0, 32, 32], [4, 8, 24, 36]], dtype='int32')
+            >>> flips = paddle.to_tensor([False, True])
+            >>> out = paddle.vision.ops.resized_crop_normalize(
+            ...     x, boxes, 16, [123.7, 116.3, 103.5], [58.4, 57.1, 57.4], flips)
+            >>> print(out.shape)
+            [2, 3, 16, 16]
+    """
+    if isinstance(size, int):
+        size = [size, size]
+    size = [int(s) for s in size]
+    mean = [float(mean)] if isinstance(mean, (int, float)) else list(mean)
+    std = [float(std)] if isinstance(std, (int, float)) else list(std)
+    if flips is None:
+        flips = paddle.zeros([boxes.shape[0]], dtype='bool')
+
+    if in_dynamic_or_pir_mode():
+        return _C_ops.resized_crop_normalize(x, boxes, flips, size, mean, std)
+    else:
+        check_variable_and_dtype(
+            x, 'x', ['uint8', 'float32'], 'resized_crop_normalize'
+        )
+        check_variable_and_dtype(
+            boxes, 'boxes', ['int32'], 'resized_crop_normalize'
+        )
+        helper = LayerHelper("resized_crop_normalize", **locals())
+        out = helper.create_variable_for_type_inference('float32')
+        helper.append_op(
+            type="resized_crop_normalize",
+            inputs={'x': x, 'boxes': boxes, 'flips': flips},
+            attrs={"size": size, "mean": mean, "stddev": std},
+            outputs={"out": out},
+        )
+
+        return out
+
+
 def psroi_pool(
     x: Tensor,
     boxes: Tensor,
@@ -0,0 +1,108 @@
+# Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+import random
+
+import numpy as np
+from mlp_demo import DPDemoNet
+
+import paddle
+import paddle.distributed as dist
+from paddle import nn
+from paddle.io import DataLoader
+
+BATCH_SIZE = 4
+IMAGE_SIZE = 16
+CLASS_NUM = 8
+
+
+class RandomDataset(paddle.io.Dataset):
+    def __init__(self, images, labels, num_samples):
+        self.images = images
+        self.labels = labels
+        self.num_samples = num_samples
+
+    def __getitem__(self, idx):
+        return {"image": self.images[idx], "label": self.labels[idx]}
+
+    def __len__(self):
+        return self.num_samples
+
+
+class TestFuseGradAllReducePass:
+    def __init__(self):
+        self._seed = eval(os.getenv("seed"))
+        self.mesh = dist.ProcessMesh([0, 1], dim_names=["x"])
+
+    def set_random_seed(self, seed):
+        random.seed(seed)
+        np.random.seed(seed)
+        paddle.seed(seed)
+
+    def create_data_loader(self):
+        images = np.random.rand(BATCH_SIZE, IMAGE_SIZE).astype('float32')
+        labels = np.random.rand(BATCH_SIZE, CLASS_NUM).astype('float32')
+        dataset = RandomDataset(images, labels, BATCH_SIZE)
+        return DataLoader(dataset, batch_size=BATCH_SIZE)
+
+    def run_dy2static(self, use_pass):
+        paddle.disable_static()
+        self.set_random_seed(self._seed)
+        data_loader = self.create_data_loader()
+        layer = DPDemoNet(self.mesh)
+        opt = paddle.optimizer.Adam(
+            learning_rate=0.01, parameters=layer.parameters()
+        )
+        dist_loader = dist.shard_dataloader(
+            dataloader=data_loader,
+            meshes=[self.mesh],
+            input_keys=["image", "label"],
+            shard_dims=['x'],
+        )
+        strategy = dist.Strategy()
+        strategy._dp_optimization.enable = use_pass
+        dist_model = dist.to_static(
+            layer, dist_loader, nn.MSELoss(), opt, strategy=strategy
+        )
+        dist_model.train()
+        losses = []
+        for _ in range(3):
+            for data in dist_loader():
+                losses.append(dist_model(data["image"], data["label"]))
+
+        dense_program = dist_model._engine._pir_dense_main_progs["train"]
+        num_all_reduce = len(
+            [
+                op
+                for op in dense_program.global_block().ops
+                if op.name() == "pd_op.all_reduce"
+            ]
+        )
+        return np.array(losses), num_all_reduce
+
+    def test_dp_demo_net(self):
+        paddle.base.set_flags({'FLAGS_enable_pir_api': 1})
+        losses, num_all_reduce = self.run_dy2static(False)
+        fused_losses, fused_num_all_reduce = self.run_dy2static(True)
+        # the all_reduce of the two weight gradients are fused into one
+        np.testing.assert_equal(fused_num_all_reduce, num_all_reduce - 1)
+        np.testing.assert_allclose(fused_losses, losses, rtol=1e-6)
+
+    def run_test_case(self):
+        self.test_dp_demo_net()
+
+
+if __name__ == '__main__':
+    TestFuseGradAllReducePass().run_test_case()
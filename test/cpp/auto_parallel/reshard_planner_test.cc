@@ -0,0 +1,121 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/distributed/auto_parallel/reshard/reshard_planner.h"
+
+#include "gtest/gtest.h"
+#include "paddle/phi/core/distributed/auto_parallel/dist_attr.h"
+#include "paddle/phi/core/distributed/auto_parallel/reshard/reshard_utils.h"
+
+namespace phi {
+namespace distributed {
+namespace auto_parallel {
+
+TensorDistAttr MakeDistAttr(const std::vector<int64_t>& dims_mapping) {
+  ProcessMesh mesh({2, 2}, {0, 1, 2, 3}, {"x", "y"});
+  TensorDistAttr dist_attr(std::vector<int64_t>{8, 8});
+  dist_attr.set_process_mesh(mesh);
+  dist_attr.set_dims_mapping(dims_mapping);
+  return dist_attr;
+}
+
+// Replays the steps of the plan on the status of the input.
+std::vector<MeshAxisStatus> Replay(const ReshardPlan& plan,
+                                   const TensorDistAttr& in_dist_attr) {
+  auto status = ReshardPlanner::GetMeshAxisStatus(in_dist_attr);
+  for (const auto& step : plan.steps) {
+    EXPECT_EQ(status[step.mesh_axis], step.in);
+    status[step.mesh_axis] = step.out;
+  }
+  return status;
+}
+
+TEST(ReshardPlanner, SwapShardAxes) {
+  auto in = MakeDistAttr({0, 1});
+  auto out = MakeDistAttr({1, 0});
+  auto plan = ReshardPlanner::Instance().Plan(
+      in, out, common::make_ddim({8, 8}), DataType::FLOAT32);
+  ASSERT_NE(plan, nullptr);
+  EXPECT_FALSE(plan->steps.empty());
+  EXPECT_GT(plan->cost, 0);
+  EXPECT_EQ(Replay(*plan, in), ReshardPlanner::GetMeshAxisStatus(out));
+
+  auto cached_plan = ReshardPlanner::Instance().Plan(
+      in, out, common::make_ddim({8, 8}), DataType::FLOAT32);
+  EXPECT_EQ(plan.get(), cached_plan.get());
+}
+
+TEST(ReshardPlanner, PartialToShard) {
+  auto in = MakeDistAttr({-1, -1});
+  in.set_partial_status(std::vector<int64_t>{0});
+  auto out = MakeDistAttr({0, -1});
+  auto plan = ReshardPlanner::Instance().Plan(
+      in, out, common::make_ddim({8, 8}), DataType::FLOAT32);
+  ASSERT_NE(plan, nullptr);
+  // reduce scatter is cheaper than all reduce and then slice
+  ASSERT_EQ(plan->steps.size(), 1UL);
+  EXPECT_TRUE(plan->steps[0].in.partial);
+  EXPECT_EQ(plan->steps[0].out.shard_axis, 0);
+  EXPECT_EQ(Replay(*plan, in), ReshardPlanner::GetMeshAxisStatus(out));
+}
+
+TEST(ReshardPlanner, PartialToPartial) {
+  auto in = MakeDistAttr({-1, -1});
+  in.set_partial_status(std::vector<int64_t>{1});
+  auto out = MakeDistAttr({-1, -1});
+  out.set_partial_status(std::vector<int64_t>{1}, ReduceType::kRedMax);
+  auto plan = ReshardPlanner::Instance().Plan(
+      in, out, common::make_ddim({8, 8}), DataType::FLOAT32);
+  ASSERT_NE(plan, nullptr);
+  // the reduce type can only be changed through replicated
+  ASSERT_EQ(plan->steps.size(), 2UL);
+  EXPECT_TRUE(plan->steps[0].out.is_replicated());
+  EXPECT_EQ(Replay(*plan, in), ReshardPlanner::GetMeshAxisStatus(out));
+}
+
+TEST(ReshardUtils, ShardOverlap) {
+  // the shard of rank 2 saved by [0, -1], and loaded by [-1, 0]
+  std::vector<int64_t> saved_shape, saved_offset, shape, offset;
+  EXPECT_TRUE(GetLocalShapeAndGlobalOffset(common::make_ddim({6, 4}),
+                                           MakeDistAttr({0, -1}),
+                                           2,
+                                           &saved_shape,
+                                           &saved_offset));
+  EXPECT_EQ(saved_shape, std::vector<int64_t>({3, 4}));
+  EXPECT_EQ(saved_offset, std::vector<int64_t>({3, 0}));
+  EXPECT_TRUE(GetLocalShapeAndGlobalOffset(
+      common::make_ddim({6, 4}), MakeDistAttr({-1, 0}), 1, &shape, &offset));
+  EXPECT_EQ(shape, std::vector<int64_t>({6, 2}));
+  EXPECT_EQ(offset, std::vector<int64_t>({0, 0}));
+  EXPECT_FALSE(GetLocalShapeAndGlobalOffset(
+      common::make_ddim({6, 4}), MakeDistAttr({-1, 0}), 4, &shape, &offset));
+
+  std::vector<int64_t> in_saved, in_loaded, overlap;
+  EXPECT_TRUE(GetShardOverlap(saved_offset,
+                              saved_shape,
+                              {0, 0},
+                              {6, 2},
+                              &in_saved,
+                              &in_loaded,
+                              &overlap));
+  EXPECT_EQ(in_saved, std::vector<int64_t>({0, 0}));
+  EXPECT_EQ(in_loaded, std::vector<int64_t>({3, 0}));
+  EXPECT_EQ(overlap, std::vector<int64_t>({3, 2}));
+  EXPECT_FALSE(GetShardOverlap(
+      {0, 0}, {3, 4}, {3, 0}, {3, 4}, &in_saved, &in_loaded, &overlap));
+}
+
+}  // namespace auto_parallel
+}  // namespace distributed
+}  // namespace phi
@@ -0,0 +1,91 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/distributed/auto_parallel/strategy_planner.h"
+
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+namespace phi {
+namespace distributed {
+namespace auto_parallel {
+
+// out = matmul(x, w) with x [64, 1024] and the parameter w [1024, 1024]
+StrategyGraph MakeMatmulGraph() {
+  StrategyGraph graph;
+  graph.tensors.push_back({"x", {64, 1024}, DataType::FLOAT32, false, {}});
+  graph.tensors.push_back({"w", {1024, 1024}, DataType::FLOAT32, true, {}});
+  graph.tensors.push_back({"out", {64, 1024}, DataType::FLOAT32, false, {}});
+  StrategyOp matmul;
+  matmul.type = "matmul";
+  matmul.inputs = {0, 1};
+  matmul.outputs = {2};
+  matmul.attrs = {/*trans_x=*/false, /*trans_y=*/false};
+  matmul.flops = 2.0 * 64 * 1024 * 1024;
+  graph.ops.push_back(matmul);
+  return graph;
+}
+
+TEST(StrategyPlanner, Candidates) {
+  ProcessMesh mesh({2, 2}, {0, 1, 2, 3}, {"x", "y"});
+  StrategyPlanner planner(mesh);
+  EXPECT_EQ(planner.Candidates({8, 8}).size(), 7UL);
+  auto candidates = planner.Candidates({8, 3});
+  EXPECT_EQ(candidates.size(), 3UL);
+  for (const auto& dims_mapping : candidates) {
+    EXPECT_EQ(dims_mapping[1], -1);
+  }
+}
+
+TEST(StrategyPlanner, DataParallel) {
+  ProcessMesh mesh({4}, {0, 1, 2, 3}, {"x"});
+  StrategyPlanner planner(mesh);
+  auto graph = MakeMatmulGraph();
+  auto plan = planner.Search(graph);
+  ASSERT_EQ(plan.dist_attrs.size(), 3UL);
+  EXPECT_EQ(plan.dist_attrs[0].dims_mapping(), std::vector<int64_t>({0, -1}));
+  EXPECT_EQ(plan.dist_attrs[1].dims_mapping(),
+            std::vector<int64_t>({-1, -1}));
+  EXPECT_EQ(plan.dist_attrs[2].dims_mapping(), std::vector<int64_t>({0, -1}));
+  EXPECT_TRUE(plan.dist_attrs[0].is_annotated("dims_mapping"));
+  EXPECT_EQ(plan.reshard_cost, 0);
+
+  auto replicated = planner.Evaluate(graph, {{-1, -1}, {-1, -1}, {-1, -1}});
+  EXPECT_LT(plan.cost, replicated.cost);
+  EXPECT_LT(plan.memory_bytes, replicated.memory_bytes);
+}
+
+TEST(StrategyPlanner, MemoryLimit) {
+  ProcessMesh mesh({4}, {0, 1, 2, 3}, {"x"});
+  StrategyPlannerOptions options;
+  options.memory_limit_bytes = 8 << 20;
+  StrategyPlanner planner(mesh, options);
+  auto graph = MakeMatmulGraph();
+  // the annotated dims mapping is kept
+  graph.tensors[0].dims_mapping = {-1, -1};
+  auto plan = planner.Search(graph);
+  ASSERT_EQ(plan.dist_attrs.size(), 3UL);
+  EXPECT_EQ(plan.dist_attrs[0].dims_mapping(),
+            std::vector<int64_t>({-1, -1}));
+  const auto& w_dims_mapping = plan.dist_attrs[1].dims_mapping();
+  EXPECT_NE(std::find(w_dims_mapping.begin(), w_dims_mapping.end(), 0),
+            w_dims_mapping.end());
+  EXPECT_EQ(plan.excess_memory_bytes, 0);
+  EXPECT_LE(plan.memory_bytes, options.memory_limit_bytes);
+}
+
+}  // namespace auto_parallel
+}  // namespace distributed
+}  // namespace phi
@@ -16,8 +16,17 @@
 
 #include "glog/logging.h"
 #include "gtest/gtest.h"
+#include "paddle/common/flags.h"
 #include "paddle/fluid/eager/utils.h"
+#include "paddle/phi/backends/context_pool.h"
 #include "test/cpp/eager/data_structure_tests/grad_node_test.h"
+#include "test/cpp/eager/test_utils.h"
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/backends/gpu/gpu_info.h"
+#endif
+
+COMMON_DECLARE_int64(eager_offload_saved_tensor_min_bytes);
 
 TEST(TensorWrapper, Basic) {
   VLOG(6) << "Test Full reserved";
@@ -106,3 +115,48 @@ TEST(TensorWrapper, Basic) {
       common::errors::Fatal(
           "Variable `tw2` should not be initialized after recover"));
 }
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+TEST(TensorWrapper, Offload) {
+  eager_test::InitEnv(phi::GPUPlace(0));
+  FLAGS_eager_offload_saved_tensor_min_bytes = 1 << 20;
+  const int64_t numel = 1 << 18;
+  std::vector<float> values(numel);
+  for (int64_t i = 0; i < numel; i++) {
+    values[i] = static_cast<float>(i % 1000);
+  }
+
+  std::vector<egr::TensorWrapper> wrappers;
+  wrappers.reserve(8);
+  for (int i = 0; i < 8; i++) {
+    paddle::Tensor tensor;
+    auto dense_tensor = std::make_shared<phi::DenseTensor>();
+    dense_tensor->Resize(common::make_ddim({numel}));
+    float* data = dense_tensor->mutable_data<float>(phi::GPUPlace(0));
+    phi::backends::gpu::GpuMemcpySync(data,
+                                      values.data(),
+                                      numel * sizeof(float),
+                                      phi::gpuMemcpyHostToDevice);
+    tensor.set_impl(dense_tensor);
+    wrappers.emplace_back(tensor);
+    // the wrapper does not hold the device memory of the saved tensor
+    ASSERT_NE(wrappers.back().get_intermediate_tensor().impl().get(),
+              dense_tensor.get());
+  }
+
+  auto* dev_ctx = static_cast<phi::GPUContext*>(
+      phi::DeviceContextPool::Instance().Get(phi::GPUPlace(0)));
+  for (auto iter = wrappers.rbegin(); iter != wrappers.rend(); ++iter) {
+    paddle::Tensor recovered = iter->recover();
+    auto* dense_tensor = static_cast<phi::DenseTensor*>(recovered.impl().get());
+    std::vector<float> result(numel);
+    dev_ctx->Wait();
+    phi::backends::gpu::GpuMemcpySync(result.data(),
+                                      dense_tensor->data<float>(),
+                                      numel * sizeof(float),
+                                      phi::gpuMemcpyDeviceToHost);
+    ASSERT_EQ(result, values);
+  }
+  FLAGS_eager_offload_saved_tensor_min_bytes = 0;
+}
+#endif
@@ -18,6 +18,7 @@
 
 #include "glog/logging.h"
 #include "gtest/gtest.h"
+#include "paddle/common/flags.h"
 #include "paddle/fluid/eager/accumulation/accumulation_node.h"
 #include "paddle/fluid/eager/api/all.h"
 #include "paddle/fluid/eager/api/generated/eager_generated/backwards/scale_node.h"
@@ -31,6 +32,8 @@
 PD_DECLARE_KERNEL(full, CPU, ALL_LAYOUT);
 PD_DECLARE_KERNEL(add, CPU, ALL_LAYOUT);
 
+COMMON_DECLARE_int32(eager_backward_thread_num);
+
 namespace egr {
 
 TEST(Backward, SingleNodeEmptyGrad) {
@@ -342,4 +345,61 @@ TEST(Backward, WithAccumulation) {
   eager_test::CompareGradTensorWithValue<float>(leaf_tensor, 2500.0);
 }
 
+
+TEST(Backward, ParallelTowers) {
+  eager_test::InitEnv(phi::CPUPlace());
+  FLAGS_eager_backward_thread_num = 4;
+
+  // tower i: target i -> scale(i + 1) -> scale(2) -> the shared leaf
+  const int tower_num = 8;
+  phi::DDim ddim = common::make_ddim({4, 16, 16, 32});
+  std::vector<paddle::Tensor> target_tensors;
+  paddle::Tensor leaf_tensor;
+  {
+    AutogradMeta* leaf_meta = EagerUtils::autograd_meta(&leaf_tensor);
+    auto acc_node_ptr = std::make_shared<egr::GradNodeAccumulation>(leaf_meta);
+    leaf_meta->SetGradNode(
+        std::dynamic_pointer_cast<GradNodeBase>(acc_node_ptr));
+    leaf_meta->SetSingleOutRankWithSlot(0, 0);
+    leaf_meta->SetStopGradient(false);
+
+    for (int i = 0; i < tower_num; i++) {
+      target_tensors.emplace_back(
+          eager_test::CreateTensorWithValue(ddim,
+                                            phi::CPUPlace(),
+                                            phi::DataType::FLOAT32,
+                                            phi::DataLayout::NCHW,
+                                            1.0 /*value*/,
+                                            false /*is_leaf*/));
+      auto head_ptr = std::make_shared<GradNodeScale>(1, 1);
+      head_ptr->SetAttributes_scale(i + 1.0 /*scale*/);
+      head_ptr->SetDefaultGradInOutMeta();
+      auto tail_ptr = std::make_shared<GradNodeScale>(1, 1);
+      tail_ptr->SetAttributes_scale(2.0 /*scale*/);
+      tail_ptr->SetDefaultGradInOutMeta();
+
+      AutogradMeta* target_meta =
+          EagerUtils::autograd_meta(&(target_tensors[i]));
+      target_meta->SetGradNode(
+          std::dynamic_pointer_cast<GradNodeBase>(head_ptr));
+      target_meta->SetSingleOutRankWithSlot(0, 0);
+      target_meta->SetStopGradient(false);
+
+      auto tmp_tensor = paddle::Tensor();
+      auto* tmp_meta = EagerUtils::autograd_meta(&tmp_tensor);
+      tmp_meta->SetStopGradient(false);
+      tmp_meta->SetSingleOutRankWithSlot(0, 0);
+      tmp_meta->SetGradNode(tail_ptr);
+      head_ptr->SetGradOutMeta(tmp_tensor, 0);
+      tail_ptr->SetGradOutMeta(leaf_tensor, 0);
+    }
+  }
+
+  Backward(target_tensors, {});
+  FLAGS_eager_backward_thread_num = 0;
+
+  // 2 * (1 + 2 + ... + 8)
+  eager_test::CompareGradTensorWithValue<float>(leaf_tensor, 72.0);
+}
+
 }  // namespace egr
@@ -0,0 +1,156 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/ring_channel.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "glog/logging.h"
+#include "paddle/fluid/framework/channel.h"
+
+namespace framework = paddle::framework;
+
+// Runs half of the threads as writers and the other half as readers, each
+// moving blocks of records through the channel. Returns the elapsed seconds.
+template <class Channel>
+double RunChannel(Channel* channel, int thread_num, int64_t record_num) {
+  constexpr size_t kBlockSize = 64;
+  int writer_num = std::max(thread_num / 2, 1);
+  int reader_num = std::max(thread_num - writer_num, 1);
+  int64_t records_per_writer = record_num / writer_num;
+  std::atomic<int64_t> sum(0);
+  std::atomic<int64_t> count(0);
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> readers;
+  for (int i = 0; i < reader_num; ++i) {
+    readers.emplace_back([&]() {
+      std::vector<int64_t> block(kBlockSize);
+      int64_t local_sum = 0;
+      int64_t local_count = 0;
+      size_t n = 0;
+      while ((n = channel->Read(kBlockSize, block.data())) != 0) {
+        for (size_t j = 0; j < n; ++j) {
+          local_sum += block[j];
+        }
+        local_count += static_cast<int64_t>(n);
+      }
+      sum += local_sum;
+      count += local_count;
+    });
+  }
+  std::vector<std::thread> writers;
+  for (int i = 0; i < writer_num; ++i) {
+    writers.emplace_back([&, i]() {
+      std::vector<int64_t> block;
+      for (int64_t j = 0; j < records_per_writer; ++j) {
+        block.push_back(i * records_per_writer + j);
+        if (block.size() == kBlockSize || j + 1 == records_per_writer) {
+          EXPECT_EQ(channel->Write(block.size(), block.data()), block.size());
+          block.clear();
+        }
+      }
+    });
+  }
+  for (auto& t : writers) {
+    t.join();
+  }
+  channel->Close();
+  for (auto& t : readers) {
+    t.join();
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+  int64_t total = records_per_writer * writer_num;
+  EXPECT_EQ(count.load(), total);
+  EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+  return seconds;
+}
+
+TEST(RingChannel, CapacityAndBlockSize) {
+  framework::RingChannelObject<int> channel(100);
+  EXPECT_EQ(channel.Capacity(), 128UL);
+  channel.SetBlockSize(16);
+  EXPECT_EQ(channel.BlockSize(), 16UL);
+  EXPECT_TRUE(channel.Empty());
+}
+
+TEST(RingChannel, ReadWriteAndClose) {
+  framework::RingChannelObject<int> channel(8);
+  std::vector<int> in = {1, 2, 3, 4, 5};
+  EXPECT_EQ(channel.Write(in), 5UL);
+  EXPECT_EQ(channel.Size(), 5UL);
+  EXPECT_TRUE(channel.Put(6));
+
+  std::vector<int> out;
+  EXPECT_EQ(channel.ReadOnce(out, 4), 4UL);
+  EXPECT_EQ(out, std::vector<int>({1, 2, 3, 4}));
+
+  channel.Close();
+  EXPECT_FALSE(channel.Put(7));
+  EXPECT_EQ(channel.ReadAll(out), 2UL);
+  EXPECT_EQ(out, std::vector<int>({5, 6}));
+  int val = 0;
+  EXPECT_FALSE(channel.Get(val));
+
+  channel.Open();
+  EXPECT_TRUE(channel.Put(8));
+  EXPECT_TRUE(channel.Get(val));
+  EXPECT_EQ(val, 8);
+}
+
+TEST(RingChannel, WrapAround) {
+  framework::RingChannelObject<int> channel(4);
+  std::thread writer([&channel]() {
+    std::vector<int> in(1000);
+    for (int i = 0; i < 1000; ++i) {
+      in[i] = i;
+    }
+    EXPECT_EQ(channel.WriteMove(in.size(), in.data()), in.size());
+    channel.Close();
+  });
+  std::vector<int> out;
+  EXPECT_EQ(channel.ReadAll(out), 1000UL);
+  writer.join();
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(out[i], i);
+  }
+}
+
+// Compares the throughput with ChannelObject on the same workload.
+TEST(RingChannel, Benchmark) {
+  constexpr int64_t kRecordNum = 1 << 20;
+  constexpr size_t kCapacity = 1 << 14;
+  for (int thread_num : {8, 16, 32, 64, 96}) {
+    auto channel = framework::MakeChannel<int64_t>();
+    channel->SetCapacity(kCapacity);
+    double channel_seconds = RunChannel(channel.get(), thread_num, kRecordNum);
+
+    auto ring = framework::MakeRingChannel<int64_t>(kCapacity);
+    double ring_seconds = RunChannel(ring.get(), thread_num, kRecordNum);
+
+    LOG(INFO) << "threads: " << thread_num
+              << ", ChannelObject: " << kRecordNum / channel_seconds
+              << " records/s, RingChannelObject: " << kRecordNum / ring_seconds
+              << " records/s";
+  }
+}
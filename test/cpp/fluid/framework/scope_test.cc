@@ -77,3 +77,22 @@ TEST(Scope, GetAllNames) {
 
   EXPECT_STREQ("a", str.c_str());
 }
+
+TEST(Scope, Freeze) {
+  Scope s;
+  Scope& ss = s.NewScope();
+  Variable* v = s.Var("a");
+  s.Freeze();
+
+  EXPECT_TRUE(s.IsFrozen());
+  EXPECT_EQ(v, s.Var("a"));
+  EXPECT_EQ(v, s.FindVar("a"));
+  EXPECT_EQ(v, ss.FindVar("a"));
+  EXPECT_EQ(nullptr, s.FindVar("b"));
+  EXPECT_ANY_THROW(s.Var("b"));
+  EXPECT_ANY_THROW(s.EraseVars({"a"}));
+  EXPECT_NE(nullptr, ss.Var("b"));
+
+  s.Unfreeze();
+  EXPECT_NE(nullptr, s.Var("b"));
+}
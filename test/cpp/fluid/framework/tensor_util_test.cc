@@ -16,8 +16,12 @@
 #include <array>
 #include <cmath>
 
+#include "paddle/common/flags.h"
 #include "paddle/fluid/framework/tensor_util.h"
 #include "paddle/fluid/operators/isfinite_op.h"
+
+COMMON_DECLARE_int64(tensor_stream_checksum_chunk_bytes);
+
 namespace paddle {
 namespace framework {
 
@@ -519,5 +523,49 @@ TEST(Tensor, FromAndToStream) {
 #endif
 }
 
+TEST(Tensor, FromAndToStreamWithChecksum) {
+  phi::DenseTensor src_tensor;
+  std::array<int, 6> array = {1, 2, 3, 4, 5, 6};
+  src_tensor.Resize({2, 3});
+  int* src_ptr = src_tensor.mutable_data<int>(phi::CPUPlace());
+  for (int i = 0; i < 6; ++i) {
+    src_ptr[i] = array[i];
+  }
+  phi::CPUContext cpu_ctx((phi::CPUPlace()));
+  std::ostringstream oss;
+  // 3 chunks of 10, 10 and 4 bytes
+  FLAGS_tensor_stream_checksum_chunk_bytes = 10;
+  phi::TensorToStream(oss, src_tensor, cpu_ctx);
+  FLAGS_tensor_stream_checksum_chunk_bytes = 0;
+  {
+    phi::DenseTensor dst_tensor;
+    std::istringstream iss(oss.str());
+    phi::TensorFromStream(iss, &dst_tensor, cpu_ctx);
+    int* dst_ptr = dst_tensor.data<int>();
+    for (int i = 0; i < 6; ++i) {
+      EXPECT_EQ(dst_ptr[i], array[i]);
+    }
+    EXPECT_EQ(dst_tensor.dims(), src_tensor.dims());
+  }
+  {
+    // the read starts in the middle of the 2nd chunk
+    phi::DenseTensor dst_tensor;
+    std::istringstream iss(oss.str());
+    phi::TensorFromStream(iss, &dst_tensor, cpu_ctx, 3, {2});
+    int* dst_ptr = dst_tensor.data<int>();
+    EXPECT_EQ(dst_ptr[0], array[3]);
+    EXPECT_EQ(dst_ptr[1], array[4]);
+  }
+  {
+    // damage the last element, ahead of the checksum of the last chunk
+    std::string damaged = oss.str();
+    damaged[damaged.size() - sizeof(uint32_t) - 1] ^= 1;
+    phi::DenseTensor dst_tensor;
+    std::istringstream iss(damaged);
+    EXPECT_THROW(phi::TensorFromStream(iss, &dst_tensor, cpu_ctx),
+                 common::EnforceNotMet);
+  }
+}
+
 }  // namespace framework
 }  // namespace paddle
@@ -62,3 +62,41 @@ TEST(ThreadPool, ConcurrentRun) {
   }
   EXPECT_EQ(sum, ((n + 1) * n) / 2);
 }
+
+TEST(ThreadPool, RunBatch) {
+  phi::ThreadPool pool(4);
+  std::atomic<int> sum(0);
+  std::vector<std::function<void()>> fns;
+  for (int i = 1; i <= 100; ++i) {
+    fns.emplace_back([&sum, i]() { sum.fetch_add(i); });
+  }
+  auto fs = pool.RunBatch(fns);
+  for (auto& f : fs) {
+    f.wait();
+  }
+  EXPECT_EQ(sum, 5050);
+}
+
+TEST(ThreadPool, NestedRunWithAffinity) {
+  phi::ThreadPool pool(4);
+  std::atomic<int> sum(0);
+  std::vector<std::future<void>> fs;
+  for (int i = 0; i < 8; ++i) {
+    fs.push_back(pool.Run(
+        [&pool, &sum]() {
+          // the workers push to their own queues, the others steal them
+          std::vector<std::future<void>> inner;
+          for (int j = 0; j < 16; ++j) {
+            inner.push_back(pool.Run([&sum]() { sum.fetch_add(1); }));
+          }
+        },
+        i));
+  }
+  for (auto& f : fs) {
+    f.wait();
+  }
+  while (sum.load() < 8 * 16) {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(sum, 8 * 16);
+}
@@ -431,6 +431,26 @@ TEST(selected_rows_functor, cpu_merge_add_multi_noduplicated) {
   }
 }
 
+TEST(selected_rows_functor, group_merge_rows) {
+  phi::Vector<int64_t> rows{5, 2, 5, 3, 5, 2};
+
+  auto groups = phi::funcs::scatter::GroupMergeRows(rows);
+  std::vector<int64_t> ret_rows{5, 2, 3};
+  std::vector<int64_t> ret_offsets{0, 3, 5, 6};
+  std::vector<int64_t> ret_index{0, 2, 4, 1, 5, 3};
+  EXPECT_EQ(groups.rows, ret_rows);
+  EXPECT_EQ(groups.offsets, ret_offsets);
+  EXPECT_EQ(groups.input_index, ret_index);
+
+  auto sorted_groups = phi::funcs::scatter::GroupMergeRows(rows, true);
+  std::vector<int64_t> ret_sorted_rows{2, 3, 5};
+  std::vector<int64_t> ret_sorted_offsets{0, 2, 3, 6};
+  std::vector<int64_t> ret_sorted_index{1, 5, 3, 0, 2, 4};
+  EXPECT_EQ(sorted_groups.rows, ret_sorted_rows);
+  EXPECT_EQ(sorted_groups.offsets, ret_sorted_offsets);
+  EXPECT_EQ(sorted_groups.input_index, ret_sorted_index);
+}
+
 TEST(selected_rows_functor, cpu_sum_to) {
   phi::CPUPlace cpu_place;
   phi::CPUContext ctx(cpu_place);
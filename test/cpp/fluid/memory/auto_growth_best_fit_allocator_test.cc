@@ -171,6 +171,38 @@ TEST(test_auto_growth_allocator, test_free_when_no_cache_hit) {
   TestFreeWhenNoCacheHit(true);
 }
 
+TEST(test_auto_growth_allocator, test_fragmentation_info) {
+  FLAGS_free_idle_chunk = false;
+  FLAGS_free_when_no_cache_hit = false;
+  size_t alignment = 256;
+  auto recorded_allocator = std::make_shared<RecordedAllocator>();
+  auto underlying_allocator =
+      std::make_shared<AlignedAllocator>(recorded_allocator, alignment);
+  auto ag_allocator = std::make_shared<AutoGrowthBestFitAllocator>(
+      underlying_allocator, alignment, /*chunk_size=*/8192);
+
+  // free every other block of a chunk, so the free memory is fragmented
+  std::vector<phi::Allocator::AllocationPtr> allocations;
+  for (size_t i = 0; i < 8; ++i) {
+    allocations.emplace_back(ag_allocator->Allocate(1024));
+  }
+  for (size_t i = 0; i < allocations.size(); i += 2) {
+    allocations[i].reset();
+  }
+  auto info = ag_allocator->GetFragmentationInfo();
+  ASSERT_EQ(info.num_chunks, 1UL);
+  ASSERT_EQ(info.num_free_blocks, 4UL);
+  ASSERT_EQ(info.free_bytes, 4UL * 1024);
+  ASSERT_EQ(info.largest_free_block, 1024UL);
+  ASSERT_EQ(info.free_block_histogram.at(10), 4UL);
+  ASSERT_DOUBLE_EQ(info.Fragmentation(), 0.75);
+
+  allocations.clear();
+  info = ag_allocator->GetFragmentationInfo();
+  ASSERT_EQ(info.num_free_blocks, 1UL);
+  ASSERT_DOUBLE_EQ(info.Fragmentation(), 0.);
+}
+
 }  // namespace allocation
 }  // namespace memory
 }  // namespace paddle
@@ -16,6 +16,10 @@
 
 #include "paddle/phi/core/memory/allocation/mmap_allocator.h"
 
+#include <cstdio>
+#include <fstream>
+#include <string>
+
 #include "gtest/gtest.h"
 
 namespace paddle {
@@ -46,6 +50,33 @@ TEST(MemoryMapAllocation, test_allocation_base) {
   }
 }
 
+TEST(MemoryMapFileAllocation, test_copy_on_write) {
+  std::string file_path =
+      "mmap_file_allocation_test_" + std::to_string(getpid()) + ".bin";
+  {
+    std::ofstream fout(file_path, std::ios::binary);
+    for (int32_t i = 0; i < 1024; ++i) {
+      fout.write(reinterpret_cast<const char*>(&i), sizeof(i));
+    }
+  }
+
+  auto holder = AllocateMemoryMapFileAllocation(file_path);
+  ASSERT_EQ(holder->size(), 1024 * sizeof(int32_t));
+  auto* ptr = static_cast<int32_t*>(holder->ptr());
+  for (int32_t i = 0; i < 1024; ++i) {
+    ASSERT_EQ(ptr[i], i);
+  }
+
+  // Writing to the mapping does not change the file.
+  ptr[0] = -1;
+  auto another_holder = AllocateMemoryMapFileAllocation(file_path);
+  ASSERT_EQ(static_cast<int32_t*>(another_holder->ptr())[0], 0);
+
+  holder.reset();
+  another_holder.reset();
+  std::remove(file_path.c_str());
+}
+
 }  // namespace allocation
 }  // namespace memory
 }  // namespace paddle
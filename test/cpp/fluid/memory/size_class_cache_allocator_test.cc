@@ -0,0 +1,172 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/memory/allocation/size_class_cache_allocator.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+class CountingAllocator : public Allocator {
+ public:
+  bool IsAllocThreadSafe() const override { return true; }
+
+  size_t GetAllocCount() const { return alloc_count_; }
+
+  size_t GetFreeCount() const { return free_count_; }
+
+ protected:
+  void FreeImpl(phi::Allocation *allocation) override {
+    delete[] static_cast<uint8_t *>(allocation->ptr());
+    ++free_count_;
+    delete allocation;
+  }
+
+  phi::Allocation *AllocateImpl(size_t size) override {
+    ++alloc_count_;
+    return new Allocation(new uint8_t[size], size, phi::CPUPlace());
+  }
+
+ private:
+  std::atomic<size_t> alloc_count_{0};
+  std::atomic<size_t> free_count_{0};
+};
+
+TEST(SizeClassCacheAllocator, round_up) {
+  auto underlying = std::make_shared<CountingAllocator>();
+  SizeClassCacheAllocator allocator(underlying, phi::CPUPlace(), 4096, 8);
+
+  // 256, 320, 384, 448, 512, ..., 3584, 4096
+  EXPECT_EQ(allocator.SizeClassNum(), 17UL);
+  EXPECT_EQ(allocator.RoundUp(0), 0UL);
+  EXPECT_EQ(allocator.RoundUp(1), 256UL);
+  EXPECT_EQ(allocator.RoundUp(256), 256UL);
+  EXPECT_EQ(allocator.RoundUp(257), 320UL);
+  EXPECT_EQ(allocator.RoundUp(1100), 1280UL);
+  EXPECT_EQ(allocator.RoundUp(4096), 4096UL);
+  EXPECT_EQ(allocator.RoundUp(4097), 0UL);
+}
+
+TEST(SizeClassCacheAllocator, reuse_in_same_thread) {
+  auto underlying = std::make_shared<CountingAllocator>();
+  auto allocator = std::make_shared<SizeClassCacheAllocator>(
+      underlying, phi::CPUPlace(), 4096, 8);
+
+  void *ptr = nullptr;
+  {
+    auto allocation = allocator->Allocate(1000);
+    EXPECT_EQ(allocation->size(), 1024UL);
+    ptr = allocation->ptr();
+  }
+  {
+    auto allocation = allocator->Allocate(900);
+    EXPECT_EQ(allocation->ptr(), ptr);
+  }
+  EXPECT_EQ(underlying->GetAllocCount(), 1UL);
+  EXPECT_EQ(underlying->GetFreeCount(), 0UL);
+
+  // Large requests are not cached.
+  allocator->Allocate(8192);
+  EXPECT_EQ(underlying->GetAllocCount(), 2UL);
+  EXPECT_EQ(underlying->GetFreeCount(), 1UL);
+
+  allocator->Release(phi::CPUPlace());
+  EXPECT_EQ(underlying->GetFreeCount(), 2UL);
+}
+
+TEST(SizeClassCacheAllocator, overflow_to_underlying) {
+  constexpr size_t kCapacity = 4;
+  auto underlying = std::make_shared<CountingAllocator>();
+  auto allocator = std::make_shared<SizeClassCacheAllocator>(
+      underlying, phi::CPUPlace(), 4096, kCapacity);
+
+  // The thread cache keeps kCapacity blocks and the central cache keeps
+  // kCapacity * 4 blocks, the rest go back to the underlying allocator.
+  constexpr size_t kNum = 64;
+  {
+    std::vector<phi::Allocator::AllocationPtr> allocations;
+    for (size_t i = 0; i < kNum; ++i) {
+      allocations.emplace_back(allocator->Allocate(512));
+    }
+  }
+  EXPECT_EQ(underlying->GetAllocCount(), kNum);
+  EXPECT_GE(underlying->GetFreeCount(), kNum - kCapacity * 5);
+
+  allocator->Release(phi::CPUPlace());
+  EXPECT_EQ(underlying->GetFreeCount(), kNum);
+}
+
+TEST(SizeClassCacheAllocator, return_on_thread_exit) {
+  auto underlying = std::make_shared<CountingAllocator>();
+  auto allocator = std::make_shared<SizeClassCacheAllocator>(
+      underlying, phi::CPUPlace(), 4096, 8);
+
+  constexpr size_t kNum = 4;
+  std::thread producer([&allocator] {
+    std::vector<phi::Allocator::AllocationPtr> allocations;
+    for (size_t i = 0; i < kNum; ++i) {
+      allocations.emplace_back(allocator->Allocate(2048));
+    }
+  });
+  producer.join();
+  EXPECT_EQ(underlying->GetAllocCount(), kNum);
+  EXPECT_EQ(underlying->GetFreeCount(), 0UL);
+
+  // Blocks freed by the exited thread are reused by this thread.
+  {
+    std::vector<phi::Allocator::AllocationPtr> allocations;
+    for (size_t i = 0; i < kNum; ++i) {
+      allocations.emplace_back(allocator->Allocate(2048));
+    }
+  }
+  EXPECT_EQ(underlying->GetAllocCount(), kNum);
+
+  allocator.reset();
+  EXPECT_EQ(underlying->GetFreeCount(), kNum);
+}
+
+TEST(SizeClassCacheAllocator, multi_thread) {
+  auto underlying = std::make_shared<CountingAllocator>();
+  auto allocator = std::make_shared<SizeClassCacheAllocator>(
+      underlying, phi::CPUPlace(), 1 << 20, 16);
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 8; ++t) {
+    threads.emplace_back([&allocator, t] {
+      for (size_t i = 0; i < 1000; ++i) {
+        size_t size = 256 * ((i + t) % 32 + 1);
+        auto allocation = allocator->Allocate(size);
+        ASSERT_GE(allocation->size(), size);
+        memset(allocation->ptr(), 0, size);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  allocator->Release(phi::CPUPlace());
+  EXPECT_EQ(underlying->GetFreeCount(), underlying->GetAllocCount());
+}
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
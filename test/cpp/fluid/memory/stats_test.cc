@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "paddle/phi/core/memory/allocation_recorder.h"
 
 namespace paddle {
 namespace memory {
@@ -197,5 +198,42 @@ TEST_F(StatsTest, HostReservedTest) {
   RunTests();
 }
 
+TEST(AllocationRecorderTest, PeakSnapshot) {
+  auto& recorder = AllocationRecorder::Instance();
+  recorder.Enable(/*max_events=*/4);
+  phi::Place place = phi::CPUPlace();
+  int buffers[4];
+  {
+    AllocationSiteGuard guard("pd_op.matmul", "out");
+    recorder.RecordAlloc(&buffers[0], 100, place);
+    recorder.RecordAlloc(&buffers[1], 300, place);
+  }
+  recorder.RecordFree(&buffers[0], place);
+  {
+    AllocationSiteGuard guard("pd_op.relu");
+    recorder.RecordAlloc(&buffers[2], 50, place);
+  }
+  // allocated before the recorder is enabled
+  recorder.RecordFree(&buffers[3], place);
+
+  EXPECT_EQ(recorder.PeakBytes(place), 400);
+  auto snapshot = recorder.PeakSnapshot(place);
+  ASSERT_EQ(snapshot.size(), 2UL);
+  EXPECT_EQ(snapshot[0].ptr, &buffers[1]);
+  EXPECT_EQ(snapshot[0].size, 300);
+  EXPECT_EQ(snapshot[0].site.op_name, "pd_op.matmul");
+  EXPECT_EQ(snapshot[0].site.var_name, "out");
+  EXPECT_EQ(snapshot[1].ptr, &buffers[0]);
+
+  auto timeline = recorder.Timeline();
+  ASSERT_EQ(timeline.size(), 4UL);
+  EXPECT_EQ(timeline[2].size, -100);
+  EXPECT_EQ(timeline[3].site.op_name, "pd_op.relu");
+  EXPECT_EQ(AllocationSiteGuard::Current(), nullptr);
+
+  recorder.Disable();
+  EXPECT_EQ(recorder.PeakBytes(place), 0);
+}
+
 }  // namespace memory
 }  // namespace paddle
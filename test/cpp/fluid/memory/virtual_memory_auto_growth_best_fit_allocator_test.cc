@@ -0,0 +1,80 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/memory/allocation/virtual_memory_auto_growth_best_fit_allocator.h"
+
+#include "gtest/gtest.h"
+#include "paddle/phi/core/memory/stats.h"
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+// Hand out the increasing addresses like the virtual memory ranges, which are
+// never accessed.
+class VirtualRangeAllocator : public Allocator {
+ public:
+  size_t AllocatedSize() const { return allocated_size_; }
+
+ protected:
+  phi::Allocation *AllocateImpl(size_t size) override {
+    auto *ptr = reinterpret_cast<void *>(next_address_);
+    next_address_ += size;
+    allocated_size_ += size;
+    return new Allocation(ptr, size, phi::CPUPlace());
+  }
+
+  void FreeImpl(phi::Allocation *allocation) override {
+    allocated_size_ -= allocation->size();
+    delete allocation;
+  }
+
+ private:
+  uintptr_t next_address_{uintptr_t{1} << 32};
+  size_t allocated_size_{0};
+};
+
+TEST(test_virtual_memory_auto_growth_allocator, test_release) {
+  size_t alignment = 4096;
+  auto range_allocator = std::make_shared<VirtualRangeAllocator>();
+  auto allocator = std::make_shared<VirtualMemoryAutoGrowthBestFitAllocator>(
+      range_allocator, alignment, phi::GPUPlace(0));
+  int64_t reclaimed_before = DEVICE_MEMORY_STAT_CURRENT_VALUE(Reclaimed, 0);
+
+  auto small = allocator->Allocate(2 * alignment);
+  auto large = allocator->Allocate(4 * alignment);
+  // the aligned allocator pads each chunk by the alignment
+  ASSERT_EQ(range_allocator->AllocatedSize(), 8 * alignment);
+  ASSERT_EQ(allocator->Release(phi::GPUPlace(0)), 0UL);
+
+  // the chunk of the large one is free while the small one is alive
+  large.reset();
+  ASSERT_EQ(allocator->Release(phi::GPUPlace(0)), 5 * alignment);
+  ASSERT_EQ(range_allocator->AllocatedSize(), 3 * alignment);
+  ASSERT_EQ(allocator->Release(phi::GPUPlace(0)), 0UL);
+
+  // the released chunk is allocated again on demand
+  large = allocator->Allocate(4 * alignment);
+  ASSERT_EQ(range_allocator->AllocatedSize(), 8 * alignment);
+  small.reset();
+  large.reset();
+  ASSERT_EQ(allocator->Release(phi::GPUPlace(0)), 8 * alignment);
+  ASSERT_EQ(range_allocator->AllocatedSize(), 0UL);
+  ASSERT_EQ(DEVICE_MEMORY_STAT_CURRENT_VALUE(Reclaimed, 0) - reclaimed_before,
+            static_cast<int64_t>(13 * alignment));
+}
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
@@ -39,3 +39,20 @@ TEST(ThreadInfo, TestThreadNameUtils) {
   EXPECT_EQ("MainThread", names[GetCurrentThreadStdId()]);
   EXPECT_EQ("MainThread", GetCurrentThreadName());
 }
+
+TEST(ThreadInfo, TestNumaUtils) {
+  int num_nodes = phi::GetNumaNodeCount();
+  EXPECT_GE(num_nodes, 1);
+  EXPECT_EQ(-1, phi::GetCurrentThreadNumaNode());
+  std::thread thr([num_nodes]() {
+    int node = num_nodes - 1;
+    if (phi::BindCurrentThreadToNumaNode(node)) {
+      EXPECT_EQ(node, phi::GetCurrentThreadNumaNode());
+      EXPECT_FALSE(phi::GetNumaNodeCpus(node).empty());
+    } else {
+      EXPECT_EQ(-1, phi::GetCurrentThreadNumaNode());
+    }
+  });
+  thr.join();
+  EXPECT_EQ(-1, phi::GetCurrentThreadNumaNode());
+}
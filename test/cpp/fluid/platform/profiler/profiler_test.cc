@@ -141,3 +141,47 @@ TEST(ProfilerTest, TestHostTracerForMem) {
   auto profiler_result = profiler->Stop();
   auto nodetree = profiler_result->GetNodeTrees();
 }
+
+TEST(ProfilerTest, TestSamplingProfiler) {
+  using paddle::platform::RecordInstantEvent;
+  using paddle::platform::SamplingProfiler;
+  using paddle::platform::SamplingProfilerOptions;
+  using phi::TracerEventType;
+  SamplingProfilerOptions options;
+  options.profiler_options.trace_level = 2;
+  options.profiler_options.trace_switch = 1;
+  options.sample_every = 3;
+  options.max_samples = 2;
+  SamplingProfiler profiler(options);
+  const char* names[] = {"TestSamplingProfiler_step0",
+                         "TestSamplingProfiler_step1",
+                         "TestSamplingProfiler_step2",
+                         "TestSamplingProfiler_step3",
+                         "TestSamplingProfiler_step4",
+                         "TestSamplingProfiler_step5",
+                         "TestSamplingProfiler_step6"};
+  for (int step = 0; step < 7; ++step) {
+    EXPECT_EQ(profiler.StepBegin(), step % 3 == 0);
+    RecordInstantEvent(names[step], TracerEventType::UserDefined, 1);
+    profiler.StepEnd();
+  }
+  EXPECT_EQ(profiler.num_steps(), 7u);
+  EXPECT_EQ(profiler.num_sampled_steps(), 3u);
+
+  // only the latest two of the sampled steps 0, 3 and 6 are kept
+  auto samples = profiler.TakeSamples();
+  ASSERT_EQ(samples.size(), 2u);
+  std::set<std::string> host_events;
+  for (const auto& sample : samples) {
+    for (const auto& pair : sample->GetNodeTrees()->Traverse(true)) {
+      for (const auto evt : pair.second) {
+        host_events.insert(evt->Name());
+      }
+    }
+  }
+  EXPECT_EQ(host_events.count("TestSamplingProfiler_step0"), 0u);
+  EXPECT_EQ(host_events.count("TestSamplingProfiler_step1"), 0u);
+  EXPECT_EQ(host_events.count("TestSamplingProfiler_step3"), 1u);
+  EXPECT_EQ(host_events.count("TestSamplingProfiler_step6"), 1u);
+  EXPECT_TRUE(profiler.TakeSamples().empty());
+}
@@ -66,6 +66,53 @@ void predictor_run() {
 
 TEST(PD_PredictorRun, predictor_run) { predictor_run(); }
 
+TEST(PD_PredictorRunWithBuffers, predictor_run_with_buffers) {
+  std::string model_dir = FLAGS_infer_model;
+  std::string prog_file = model_dir + "/model";
+  std::string params_file = model_dir + "/params";
+  PD_Config *config = PD_ConfigCreate();
+  PD_ConfigDisableGpu(config);
+  PD_ConfigSetModel(config, prog_file.c_str(), params_file.c_str());
+  PD_Predictor *predictor = PD_PredictorCreate(config);
+  size_t output_num = PD_PredictorGetOutputNum(predictor);
+
+  std::array<int32_t, 4> shape = {1, 3, 318, 318};
+  std::vector<float> input(1 * 3 * 318 * 318, 0.f);
+  const void *input_data[] = {input.data()};
+  PD_DataType input_dtypes[] = {PD_DATA_FLOAT32};
+  size_t input_ranks[] = {shape.size()};
+  const int32_t *input_shapes[] = {shape.data()};
+
+  // resnet50 outputs the scores of 1000 classes
+  std::vector<std::vector<float>> outputs(output_num,
+                                          std::vector<float>(1000));
+  std::vector<void *> output_data;
+  std::vector<size_t> output_bytes;
+  for (auto &output : outputs) {
+    output_data.push_back(output.data());
+    output_bytes.push_back(output.size() * sizeof(float));
+  }
+  std::vector<size_t> output_numels(output_num);
+
+  // the second run reuses the cached handles
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_TRUE(PD_PredictorRunWithBuffers(predictor,
+                                           1,
+                                           input_data,
+                                           input_dtypes,
+                                           input_ranks,
+                                           input_shapes,
+                                           output_num,
+                                           output_data.data(),
+                                           output_bytes.data(),
+                                           output_numels.data()));
+    for (size_t index = 0; index < output_num; ++index) {
+      EXPECT_EQ(output_numels[index], 1000u);
+    }
+  }
+  PD_PredictorDestroy(predictor);
+}
+
 #ifdef PADDLE_WITH_DNNL
 TEST(PD_Config, profile_mkldnn) {
   std::string model_dir = FLAGS_infer_model;
@@ -95,4 +95,49 @@ TEST(PredictorPool, basic) {
   }
 }
 
+TEST(PagedKVCache, reserve_and_release) {
+  services::PagedKVCache cache(
+      2, 8, 16, 2, 32, DataType::FLOAT32, PlaceType::kCPU);
+  ASSERT_EQ(cache.NumFreeBlocks(), 8);
+  ASSERT_TRUE(cache.Reserve(0, 20));
+  ASSERT_TRUE(cache.Reserve(1, 16));
+  ASSERT_EQ(cache.NumFreeBlocks(), 5);
+  // the tokens of the decoding step use the reserved blocks first
+  ASSERT_TRUE(cache.Reserve(1, 17));
+  ASSERT_TRUE(cache.Reserve(0, 32));
+  ASSERT_EQ(cache.NumFreeBlocks(), 4);
+
+  int max_blocks_per_seq = 0;
+  auto tables = cache.BlockTables({1, 0}, &max_blocks_per_seq);
+  ASSERT_EQ(max_blocks_per_seq, 2);
+  std::vector<int> expected = {2, 3, 0, 1};
+  ASSERT_EQ(tables, expected);
+
+  // nothing is reserved if the pool is short of blocks
+  ASSERT_FALSE(cache.Reserve(2, 16 * 5));
+  ASSERT_EQ(cache.NumFreeBlocks(), 4);
+
+  cache.Release(0);
+  ASSERT_EQ(cache.NumFreeBlocks(), 6);
+  ASSERT_TRUE(cache.Reserve(2, 16 * 6));
+  ASSERT_EQ(cache.NumFreeBlocks(), 0);
+  tables = cache.BlockTables({2, 1}, &max_blocks_per_seq);
+  ASSERT_EQ(max_blocks_per_seq, 6);
+  expected = {0, 1, 4, 5, 6, 7, 2, 3, -1, -1, -1, -1};
+  ASSERT_EQ(tables, expected);
+
+  // the empty slots of a batch
+  tables = cache.BlockTables({-1, 1}, &max_blocks_per_seq);
+  ASSERT_EQ(max_blocks_per_seq, 2);
+  expected = {-1, -1, 2, 3};
+  ASSERT_EQ(tables, expected);
+
+  // the rejected draft tokens return their blocks
+  cache.Truncate(2, 40);
+  ASSERT_EQ(cache.NumFreeBlocks(), 3);
+  tables = cache.BlockTables({2}, &max_blocks_per_seq);
+  expected = {0, 1, 4};
+  ASSERT_EQ(tables, expected);
+}
+
 }  // namespace paddle_infer
@@ -0,0 +1,61 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/new_executor/interpreter/static_memory_planner.h"
+
+#include <gtest/gtest.h>
+
+namespace paddle {
+namespace framework {
+namespace interpreter {
+
+// The ops form a chain: op0 -> op1 -> op2 -> op3
+static bool ChainHappensBefore(size_t prior_op_idx, size_t posterior_op_idx) {
+  return prior_op_idx < posterior_op_idx;
+}
+
+TEST(StaticMemoryPlanner, ReuseDeadBlocks) {
+  // var0 = op0(), var1 = op1(var0), var2 = op2(var1), var3 = op3(var2)
+  std::vector<StaticMemoryRequest> requests = {
+      {0, 1024, 0, {1}}, {1, 1024, 1, {2}}, {2, 512, 2, {3}}, {3, 256, 3, {3}}};
+  StaticMemoryPlan plan = PlanStaticMemory(requests, ChainHappensBefore, 256);
+
+  // var2 reuses the memory of var0, and var3 is placed right after var2
+  EXPECT_EQ(plan.arena_size, 2048UL);
+  EXPECT_EQ(plan.offsets.at(0), 0UL);
+  EXPECT_EQ(plan.offsets.at(1), 1024UL);
+  EXPECT_EQ(plan.offsets.at(2), 0UL);
+  EXPECT_EQ(plan.offsets.at(3), 512UL);
+}
+
+TEST(StaticMemoryPlanner, ConcurrentBlocks) {
+  // op1 and op2 are independent, their outputs can not share memory
+  auto happens_before = [](size_t prior_op_idx, size_t posterior_op_idx) {
+    return prior_op_idx != posterior_op_idx &&
+           (prior_op_idx == 0 || posterior_op_idx == 3);
+  };
+  std::vector<StaticMemoryRequest> requests = {
+      {0, 100, 1, {3}}, {1, 100, 2, {3}}, {2, 300, 3, {3}}};
+  StaticMemoryPlan plan = PlanStaticMemory(requests, happens_before, 64);
+
+  EXPECT_EQ(plan.offsets.at(2), 0UL);
+  EXPECT_NE(plan.offsets.at(0), plan.offsets.at(1));
+  EXPECT_EQ(plan.offsets.at(0) % 64, 0UL);
+  EXPECT_EQ(plan.offsets.at(1) % 64, 0UL);
+  EXPECT_GE(plan.arena_size, 512UL);
+}
+
+}  // namespace interpreter
+}  // namespace framework
+}  // namespace paddle
@@ -0,0 +1,56 @@
+/* Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "paddle/phi/api/include/api.h"
+#include "paddle/phi/api/include/tensor.h"
+#include "paddle/phi/core/kernel_registry.h"
+
+PD_DECLARE_KERNEL(full, CPU, ALL_LAYOUT);
+PD_DECLARE_KERNEL(add, CPU, ALL_LAYOUT);
+
+namespace paddle {
+namespace tests {
+
+void CheckAdd(const std::vector<int64_t>& x_shape,
+              const std::vector<int64_t>& y_shape,
+              const std::vector<int64_t>& out_shape) {
+  auto x = paddle::experimental::full(x_shape, 1, phi::DataType::FLOAT32);
+  auto y = paddle::experimental::full(y_shape, 2, phi::DataType::FLOAT32);
+  auto out = paddle::experimental::add(x, y);
+
+  ASSERT_EQ(out.dims(), common::make_ddim(out_shape));
+  ASSERT_EQ(out.type(), phi::DataType::FLOAT32);
+  ASSERT_EQ(out.layout(), phi::DataLayout::NCHW);
+  for (int64_t i = 0; i < out.numel(); ++i) {
+    ASSERT_NEAR(out.data<float>()[i], 3.0, 1e-6);
+  }
+}
+
+TEST(API, infer_meta_cache) {
+  // the second call reuses the output meta of the first one
+  CheckAdd({4, 3}, {4, 3}, {4, 3});
+  CheckAdd({4, 3}, {4, 3}, {4, 3});
+  // changed input metas run the InferMeta again
+  CheckAdd({2, 1}, {2, 5}, {2, 5});
+  CheckAdd({4, 3}, {3}, {4, 3});
+  CheckAdd({4, 3}, {4, 3}, {4, 3});
+}
+
+}  // namespace tests
+}  // namespace paddle
@@ -48,6 +48,26 @@ TEST(KernelFactory, SelectedKernelMap) {
   }
 }
 
+TEST(KernelSelectionCache, SelectKernel) {
+  phi::KernelKey kernel_key(
+      phi::Backend::CPU, phi::DataLayout::ALL_LAYOUT, phi::DataType::FLOAT32);
+  auto expected = phi::KernelFactory::Instance().SelectKernelOrThrowError(
+      "scale", kernel_key);
+  phi::KernelSelectionCache cache;
+  auto result = cache.SelectKernelOrThrowError("scale", kernel_key);
+  EXPECT_EQ(&result.kernel, &expected.kernel);
+  auto cached_result = cache.SelectKernelOrThrowError("scale", kernel_key);
+  EXPECT_EQ(&cached_result.kernel, &expected.kernel);
+  EXPECT_EQ(cached_result.has_fallback_cpu, expected.has_fallback_cpu);
+
+  phi::KernelKey fp64_kernel_key(
+      phi::Backend::CPU, phi::DataLayout::ALL_LAYOUT, phi::DataType::FLOAT64);
+  auto fp64_result = cache.SelectKernelOrThrowError("scale", fp64_kernel_key);
+  EXPECT_NE(&fp64_result.kernel, &result.kernel);
+  EXPECT_EQ(fp64_result.kernel.args_def().input_defs().at(0).dtype,
+            phi::DataType::FLOAT64);
+}
+
 template <typename T, typename Context>
 void TestKernel(const Context& dev_ctx,
                 const DenseTensor& x,
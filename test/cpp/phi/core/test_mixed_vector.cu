@@ -23,11 +23,14 @@
 
 #include "glog/logging.h"
 #include "gtest/gtest.h"
+#include "paddle/common/flags.h"
 #include "paddle/phi/backends/context_pool.h"
 #include "paddle/phi/backends/gpu/gpu_info.h"
 #include "paddle/phi/common/place.h"
 #include "paddle/phi/core/mixed_vector.h"
 
+COMMON_DECLARE_bool(mix_vector_async_copy);
+
 template <typename T>
 using vec = phi::MixVector<T>;
 using gpuStream_t = phi::gpuStream_t;
@@ -109,3 +112,32 @@ TEST(mixed_vector, MultiGPU) {
     ASSERT_EQ(tmp[i], i * 100);
   }
 }
+
+TEST(mixed_vector, AsyncCopy) {
+  std::vector<int> x;
+  for (int i = 0; i < 10; ++i) {
+    x.push_back(i);
+  }
+  FLAGS_mix_vector_async_copy = true;
+  phi::ResetMixVectorSyncCount();
+  vec<int> tmp(&x);
+  phi::GPUPlace gpu(0);
+
+#ifdef PADDLE_WITH_HIP
+  hipLaunchKernelGGL(multiply_10,
+                     dim3(1),
+                     dim3(1),
+                     0,
+                     GetCUDAStream(gpu),
+                     tmp.MutableData(gpu));
+#else
+  multiply_10<<<1, 1, 0, GetCUDAStream(gpu)>>>(tmp.MutableData(gpu));
+#endif
+  // the copy to the GPU does not wait, the copy back does
+  ASSERT_EQ(phi::GetMixVectorSyncCount(), 0);
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(tmp[i], i * 10);
+  }
+  ASSERT_EQ(phi::GetMixVectorSyncCount(), 1);
+  FLAGS_mix_vector_async_copy = false;
+}
@@ -0,0 +1,91 @@
+/* Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <cmath>
+#include <random>
+
+#include "gtest/gtest.h"
+#include "paddle/phi/backends/context_pool.h"
+#include "paddle/phi/kernels/funcs/activation_compress_functor.h"
+
+namespace phi {
+namespace tests {
+
+TEST(activation_compress_functor, bit_mask) {
+  auto* dev_ctx = static_cast<phi::CPUContext*>(
+      phi::DeviceContextPool::Instance().GetByPlace(phi::CPUPlace()));
+  // not a multiple of 8
+  const int64_t num = 1001;
+  phi::DenseTensor in;
+  in.Resize({num});
+  float* in_data = dev_ctx->template Alloc<float>(&in);
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> distrib(-1, 1);
+  for (int64_t i = 0; i < num; ++i) {
+    in_data[i] = i % 3 == 0 ? 0 : distrib(rng);
+  }
+  in_data[1] = NAN;
+
+  phi::DenseTensor mask;
+  phi::funcs::PackBitMaskFunctor<phi::CPUContext, float>()(
+      *dev_ctx, in, &mask);
+  ASSERT_EQ(mask.numel(), (num + 7) / 8);
+
+  phi::DenseTensor out;
+  out.Resize({num});
+  phi::funcs::UnpackBitMaskFunctor<phi::CPUContext, float>()(
+      *dev_ctx, mask, &out);
+  const float* out_data = out.data<float>();
+  for (int64_t i = 0; i < num; ++i) {
+    ASSERT_EQ(out_data[i], in_data[i] > 0 ? 1.0f : 0.0f);
+  }
+}
+
+TEST(activation_compress_functor, block_int8) {
+  auto* dev_ctx = static_cast<phi::CPUContext*>(
+      phi::DeviceContextPool::Instance().GetByPlace(phi::CPUPlace()));
+  const int64_t num = 3 * phi::funcs::kActivationCompressBlock + 17;
+  phi::DenseTensor in;
+  in.Resize({num});
+  float* in_data = dev_ctx->template Alloc<float>(&in);
+  std::mt19937 rng(0);
+  std::normal_distribution<float> distrib(0, 3);
+  for (int64_t i = 0; i < num; ++i) {
+    in_data[i] = distrib(rng);
+  }
+  // a block of zeros
+  for (int64_t i = 0; i < phi::funcs::kActivationCompressBlock; ++i) {
+    in_data[phi::funcs::kActivationCompressBlock + i] = 0;
+  }
+
+  phi::DenseTensor quant, scale;
+  phi::funcs::BlockQuantInt8Functor<phi::CPUContext, float>()(
+      *dev_ctx, in, &quant, &scale);
+  ASSERT_EQ(quant.numel(), num);
+  ASSERT_EQ(scale.numel(), 4);
+
+  phi::DenseTensor out;
+  out.Resize({num});
+  phi::funcs::BlockDequantInt8Functor<phi::CPUContext, float>()(
+      *dev_ctx, quant, scale, &out);
+  const float* out_data = out.data<float>();
+  const float* scale_data = scale.data<float>();
+  for (int64_t i = 0; i < num; ++i) {
+    float s = scale_data[i / phi::funcs::kActivationCompressBlock];
+    ASSERT_LE(std::fabs(out_data[i] - in_data[i]), s / 2 + 1e-6);
+  }
+}
+
+}  // namespace tests
+}  // namespace phi
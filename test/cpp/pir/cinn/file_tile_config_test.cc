@@ -111,6 +111,8 @@ TEST(ConfigSearcher, TestReduceDemo) {
   tile_config.spatial_inner_num = 9;
   tile_config.warp_num = 14;
   tile_config.tree_reduce_num = 512;
+  tile_config.grid_reduce_num = 4;
+  tile_config.reduce_method = cinn::ir::BlockReduceMethod();
   // Use kTestFileDir in this test.
   const std::string prev_flag = FLAGS_cinn_tile_config_filename_label;
   const std::string kTestFileDir = "./tile_file_test/";
@@ -164,6 +166,14 @@ TEST(ConfigSearcher, TestReduceDemo) {
                       tile_config.tree_reduce_num,
                       ::common::errors::InvalidArgument(
                           "GetConfigs function gets wrong tree_reduce_num"));
+    PADDLE_ENFORCE_EQ(it.second.grid_reduce_num,
+                      tile_config.grid_reduce_num,
+                      ::common::errors::InvalidArgument(
+                          "GetConfigs function gets wrong grid_reduce_num"));
+    PADDLE_ENFORCE_EQ(it.second.reduce_method.index(),
+                      tile_config.reduce_method.index(),
+                      ::common::errors::InvalidArgument(
+                          "GetConfigs function gets wrong reduce_method"));
   }
   // Restore the previous flag
   FLAGS_cinn_tile_config_filename_label = prev_flag;
@@ -154,3 +154,22 @@ TEST(op_result_test, exception) {
   op2->Destroy();
   op->Destroy();
 }
+
+TEST(op_storage_test, reuse) {
+  pir::IrContext *ctx = pir::IrContext::Instance();
+  std::vector<pir::Type> output_types = {pir::Float32Type::get(ctx)};
+  pir::Operation *op1 = pir::Operation::Create({}, {}, output_types, nullptr);
+  pir::Operation *op2 =
+      pir::Operation::Create({op1->result(0)}, {}, output_types, nullptr);
+  pir::Operation *released = op2;
+  op2->Destroy();
+
+  // the storage of the same size is recycled
+  pir::Operation *op3 =
+      pir::Operation::Create({op1->result(0)}, {}, output_types, nullptr);
+  EXPECT_EQ(op3, released);
+  EXPECT_TRUE(op1->result(0).HasOneUse());
+  EXPECT_EQ(op3->operand_source(0), op1->result(0));
+  op3->Destroy();
+  op1->Destroy();
+}
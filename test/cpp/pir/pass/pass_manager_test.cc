@@ -13,11 +13,13 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include "glog/logging.h"
 
 // NOTE(zhangbo9674): File pd_op.h is generated by op_gen.py, see details in
 // paddle/fluid/pir/dialect/CMakeLists.txt.
 #include "paddle/common/errors.h"
+#include "paddle/fluid/pir/dialect/operator/ir/control_flow_op.h"
 #include "paddle/fluid/pir/dialect/operator/interface/op_yaml_info.h"
 #include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
 #include "paddle/fluid/pir/dialect/operator/ir/op_type.h"
@@ -33,7 +35,10 @@
 #include "paddle/pir/include/core/op_base.h"
 #include "paddle/pir/include/core/operation.h"
 #include "paddle/pir/include/pass/pass.h"
+#include "paddle/pir/include/dialect/control_flow/ir/cf_dialect.h"
+#include "paddle/pir/include/dialect/control_flow/ir/cf_op.h"
 #include "paddle/pir/include/pass/pass_manager.h"
+#include "paddle/pir/include/pass/pass_registry.h"
 #include "test/cpp/pir/tools/macros_utils.h"
 
 #ifndef _WIN32
@@ -312,3 +317,47 @@ TEST(pass_manager, PassManager) {
       true,
       common::errors::InvalidArgument("Program not run. Expected run."));
 }
+
+std::atomic<int> num_if_ops{0};
+
+class CountIfOpPass : public pir::Pass {
+ public:
+  CountIfOpPass() : pir::Pass("count_if_op_pass", 1) {}
+
+  void Run(pir::Operation *op) override {
+    if (op->isa<paddle::dialect::IfOp>()) {
+      ++num_if_ops;
+    }
+  }
+};
+
+REGISTER_IR_PASS(count_if_op_pass, CountIfOpPass);
+
+TEST(pass_manager, MultiThreading) {
+  pir::IrContext *ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  ctx->GetOrRegisterDialect<pir::ControlFlowDialect>();
+  pir::Program program(ctx);
+  pir::Builder builder = pir::Builder(ctx, program.block());
+  auto cond = builder
+                  .Build<paddle::dialect::FullOp>(
+                      std::vector<int64_t>{1}, true, phi::DataType::BOOL)
+                  .out();
+  // the if ops use only the values defined in their blocks
+  for (int i = 0; i < 8; ++i) {
+    auto if_op = builder.Build<paddle::dialect::IfOp>(
+        cond, std::vector<pir::Type>{});
+    for (pir::Block *block : {&if_op.true_block(), &if_op.false_block()}) {
+      builder.SetInsertionPointToStart(block);
+      builder.Build<paddle::dialect::FullOp>(std::vector<int64_t>{2}, 1.0);
+      builder.Build<pir::YieldOp>(std::vector<pir::Value>{});
+    }
+    builder.SetInsertionPointToBlockEnd(program.block());
+  }
+
+  pir::PassManager pm(ctx);
+  pm.EnableMultiThreading(4);
+  pm.AddPass(pir::PassRegistry::Instance().Get("count_if_op_pass"));
+  EXPECT_TRUE(pm.Run(&program));
+  EXPECT_EQ(num_if_ops, 8);
+}
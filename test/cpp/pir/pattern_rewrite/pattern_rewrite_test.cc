@@ -431,6 +431,31 @@ TEST(pattern_rewrite, Patterns) {
   EXPECT_EQ(program.block()->size(), 17u);
 }
 
+TEST(pattern_rewrite, PatternRewriteFusion) {
+  pir::IrContext *ctx = pir::IrContext::Instance();
+
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  ctx->GetOrRegisterDialect<pir::BuiltinDialect>();
+
+  auto RunPasses = [ctx](bool fuse) {
+    pir::Program program(ctx);
+    pir::Builder builder = pir::Builder(ctx, program.block());
+    BuildProgram(builder);
+
+    pir::PassManager pm(ctx);
+    pm.EnablePatternRewriteFusion(fuse);
+    pm.AddPass(std::make_unique<TestPass>());
+    pm.AddPass(pir::CreateConv2dBnFusePass());
+    pm.AddPass(pir::CreateDeadCodeEliminationPass());
+    EXPECT_TRUE(pm.Run(&program));
+    return program.block()->size();
+  };
+
+  size_t num_ops = RunPasses(false);
+  EXPECT_LT(num_ops, 27u);
+  EXPECT_EQ(RunPasses(true), num_ops);
+}
+
 void BuildConstantFoldingProgram(pir::Program *program,
                                  pir::IrContext *ctx,
                                  paddle::framework::Scope *scope) {
@@ -60,3 +60,86 @@ TEST(SaveTest, uncompelteted_parameter) {
   EXPECT_EQ(new_op.attribute("stop_gradient").isa<pir::ArrayAttribute>(), true);
   EXPECT_EQ(new_op.attribute("trainable").isa<pir::ArrayAttribute>(), true);
 }
+
+TEST(SaveTest, binary_program) {
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  ctx->GetOrRegisterDialect<pir::BuiltinDialect>();
+  pir::Program program(ctx);
+  pir::Builder builder = pir::Builder(ctx, program.block());
+  paddle::dialect::FullOp full_op1 =
+      builder.Build<paddle::dialect::FullOp>(std::vector<int64_t>{64, 64}, 1.5);
+  builder.Build<paddle::dialect::ReluOp>(full_op1.out());
+
+  pir::WriteModule(program,
+                   "./test_binary_program",
+                   /*pir_version*/ 0,
+                   true,
+                   false,
+                   true,
+                   /*binary*/ true);
+
+  pir::Program new_program(ctx);
+  EXPECT_TRUE(pir::ReadModule(
+      "./test_binary_program", &new_program, /*pir_version*/ 0));
+  EXPECT_EQ(new_program.block()->size(), program.block()->size());
+  EXPECT_TRUE(new_program.block()->back().isa<paddle::dialect::ReluOp>());
+}
+
+TEST(SaveTest, async_save_combine) {
+  phi::CPUPlace place;
+  std::vector<phi::DenseTensor> tensors(3);
+  std::vector<const phi::DenseTensor*> x;
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    tensors[i].Resize({static_cast<int64_t>(i + 1), 4});
+    float* data = tensors[i].mutable_data<float>(place);
+    for (int64_t j = 0; j < tensors[i].numel(); ++j) {
+      data[j] = static_cast<float>(i * 10 + j);
+    }
+    x.push_back(&tensors[i]);
+  }
+  auto saved = pir::SaveCombineFunctionAsync(
+      x, {"a", "b", "c"}, "./test_async_params", true, false, 2);
+  // the snapshot is taken, the tensors can be updated while saving
+  tensors[0].data<float>()[0] = -1.f;
+  saved.get();
+
+  std::vector<phi::DenseTensor> loaded(3);
+  std::vector<phi::DenseTensor*> out;
+  for (auto& tensor : loaded) {
+    out.push_back(&tensor);
+  }
+  pir::LoadCombineFunction(
+      "./test_async_params", {"a", "b", "c"}, &out, false, place);
+  for (size_t i = 0; i < loaded.size(); ++i) {
+    EXPECT_EQ(loaded[i].numel(), tensors[i].numel());
+    for (int64_t j = 0; j < loaded[i].numel(); ++j) {
+      EXPECT_EQ(loaded[i].data<float>()[j], static_cast<float>(i * 10 + j));
+    }
+  }
+}
+
+TEST(SaveTest, load_slice) {
+  phi::CPUPlace place;
+  phi::DenseTensor tensor;
+  tensor.Resize({4, 3, 2});
+  float* data = tensor.mutable_data<float>(place);
+  for (int64_t i = 0; i < tensor.numel(); ++i) {
+    data[i] = static_cast<float>(i);
+  }
+  pir::SaveFunction(tensor, "x", "./test_slice_param", true, false);
+
+  phi::DenseTensor out;
+  pir::LoadSliceFunction("./test_slice_param",
+                         {4, 3, 2},
+                         {1, 1, 0},
+                         {2, 2, 2},
+                         false,
+                         &out,
+                         place);
+  ASSERT_EQ(out.numel(), 8);
+  std::vector<float> expected = {8, 9, 10, 11, 14, 15, 16, 17};
+  for (int64_t i = 0; i < out.numel(); ++i) {
+    EXPECT_EQ(out.data<float>()[i], expected[i]);
+  }
+}
@@ -200,6 +200,31 @@ TEST(AnalysisPredictor, CollectShapeRangeInfo) {
   // ASSERT_EQ(min_shape.size(), 14u);
 }
 
+TEST(AnalysisPredictor, CollectActivationAmax) {
+  AnalysisConfig config;
+  config.SetModel(FLAGS_dirname);
+  config.DisableGpu();
+  config.CollectActivationAmax(FLAGS_dirname + "/activation_amax.txt");
+  {
+    auto predictor = CreatePaddlePredictor<AnalysisConfig>(config);
+    std::vector<int64_t> input_data{0, 1, 2, 3};
+    for (auto name : {"firstw", "secondw", "thirdw", "forthw"}) {
+      auto w = predictor->GetInputTensor(name);
+      w->Reshape({4, 1});
+      w->copy_from_cpu(input_data.data());
+    }
+    ASSERT_TRUE(predictor->ZeroCopyRun());
+  }
+
+  std::map<std::string, float> amax;
+  inference::DeserializeActivationAmax(FLAGS_dirname + "/activation_amax.txt",
+                                       &amax);
+  ASSERT_FALSE(amax.empty());
+  for (auto const &it : amax) {
+    ASSERT_GE(it.second, 0.f) << it.first;
+  }
+}
+
 TEST(AnalysisPredictor, Clone) {
   AnalysisConfig config;
   config.SetModel(FLAGS_dirname);
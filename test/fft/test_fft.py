@@ -1934,5 +1934,37 @@ class TestIfftShift(unittest.TestCase):
             )
 
 
+
+@unittest.skipIf(
+    not paddle.is_compiled_with_cuda(), "the plan bucketing is for cufft"
+)
+class TestFftPlanBatchBucketing(unittest.TestCase):
+    def run_ffts(self, batches):
+        results = []
+        with paddle.base.dygraph.guard(paddle.CUDAPlace(0)):
+            for batch in batches:
+                x = np.random.randn(batch, 40).astype('float32')
+                out = paddle.fft.rfft(paddle.to_tensor(x)).numpy()
+                back = paddle.fft.irfft(paddle.to_tensor(out), n=40).numpy()
+                results.append((x, scipy.fft.rfft(x), out, back))
+        return results
+
+    def test_bucketing(self):
+        paddle.set_flags({'FLAGS_fft_plan_batch_bucketing': True})
+        try:
+            self.run_ffts([1])
+            misses = paddle.base.core.fft_plan_cache_stats(0)['misses']
+            # the batches of 9..15 run as 8 + 4 + 2 + 1, with the same plans
+            results = self.run_ffts(range(9, 16))
+            stats = paddle.base.core.fft_plan_cache_stats(0)
+        finally:
+            paddle.set_flags({'FLAGS_fft_plan_batch_bucketing': False})
+        for x, expected, out, back in results:
+            np.testing.assert_allclose(out, expected, rtol=1e-5, atol=1e-4)
+            np.testing.assert_allclose(back, x, rtol=1e-5, atol=1e-5)
+        self.assertLessEqual(stats['misses'] - misses, 6)
+        self.assertGreater(stats['hits'], 0)
+
+
 if __name__ == '__main__':
     unittest.main()
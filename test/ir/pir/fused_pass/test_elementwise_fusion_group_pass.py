@@ -0,0 +1,81 @@
+# Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import numpy as np
+from pass_test import PassTest
+
+import paddle
+from paddle.base import core
+
+paddle.enable_static()
+
+
+@unittest.skipIf(
+    not core.is_compiled_with_cuda(),
+    "core is not compiled with CUDA",
+)
+class TestElementwiseFusionGroupPass(PassTest):
+    r"""
+    The chain multiply -> add -> relu -> tanh -> multiply of the same shape
+    is fused into one fusion_group op, which also outputs the relu result
+    fetched outside the chain.
+    """
+
+    def is_program_valid(self, program=None):
+        return True
+
+    def build_ir_program(self):
+        with paddle.pir_utils.IrGuard():
+            main_prog = paddle.static.Program()
+            start_prog = paddle.static.Program()
+            with paddle.pir.core.program_guard(main_prog, start_prog):
+                x = paddle.static.data(
+                    name='x', shape=[32, 64], dtype='float32'
+                )
+                y = paddle.static.data(
+                    name='y', shape=[32, 64], dtype='float32'
+                )
+                hidden = paddle.nn.functional.relu(paddle.multiply(x, y) + y)
+                out = paddle.multiply(paddle.tanh(hidden), x)
+                out = paddle.assign(out)
+                hidden = paddle.assign(hidden)
+                self.pass_attr_list = [{'elementwise_fusion_group_pass': {}}]
+                self.feeds = {
+                    "x": np.random.random((32, 64)).astype("float32"),
+                    "y": np.random.random((32, 64)).astype("float32"),
+                }
+                self.fetch_list = [out, hidden]
+                self.valid_op_map = {
+                    "pd_op.fusion_group": 1,
+                    "pd_op.multiply": 0,
+                    "pd_op.add": 0,
+                    "pd_op.relu": 0,
+                    "pd_op.tanh": 0,
+                }
+                return [main_prog, start_prog]
+
+    def sample_program(self):
+        yield self.build_ir_program(), False
+
+    def setUp(self):
+        self.places.append(paddle.CUDAPlace(0))
+
+    def test_check_output(self):
+        self.check_pass_correct()
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,128 @@
+# Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import numpy as np
+from pass_test import PassTest
+
+import paddle
+from paddle.nn.quant import weight_dequantize, weight_quantize
+from paddle.pir.core import create_parameter
+
+np.random.seed(2024)
+
+
+class TestWeightOnlyLinearCpuPass_Dequantize(PassTest):
+    def setUp(self):
+        self.places.append(paddle.CPUPlace())
+        self.pass_attr_list = [{'weight_only_linear_cpu_pass': {}}]
+        self.valid_op_map = {
+            "pd_op.weight_only_linear": 1,
+            "pd_op.weight_dequantize": 0,
+            "pd_op.matmul": 0,
+            "pd_op.add": 0,
+        }
+
+    def sample_program(self):
+        for algo in ["weight_only_int8", "weight_only_int4"]:
+            # the decoding rows run the gemv, and the others the gemm
+            for x_shape in [[2, 4, 1024], [2, 64, 1024]]:
+                rand_value = 0.001 * np.random.random([1024, 512]).astype(
+                    "float32"
+                )
+                with paddle.pir_utils.IrGuard():
+                    start_prog = paddle.static.Program()
+                    main_prog = paddle.static.Program()
+                    with paddle.pir.core.program_guard(main_prog, start_prog):
+                        x = paddle.static.data(
+                            name='x', shape=x_shape, dtype="float32"
+                        )
+                        w = create_parameter(
+                            shape=[1024, 512],
+                            dtype="float32",
+                            initializer=paddle.nn.initializer.Assign(
+                                rand_value
+                            ),
+                        )
+                        bias = paddle.static.data(
+                            name="bias", shape=[512], dtype="float32"
+                        )
+                        quanted_w, w_scale = weight_quantize(
+                            w, algo=algo, arch=0
+                        )
+                        w_dequant = weight_dequantize(
+                            quanted_w, w_scale, algo=algo, out_dtype="float32"
+                        )
+                        out = paddle.add(paddle.matmul(x, w_dequant), bias)
+                        out = paddle.assign(out)
+                        self.feeds = {
+                            "x": 0.01
+                            * np.random.random(x_shape).astype("float32"),
+                            "bias": 0.01
+                            * np.random.random([512]).astype("float32"),
+                        }
+                        self.fetch_list = [out]
+                        yield [main_prog, start_prog], False
+
+    def test_check_output(self):
+        self.check_pass_correct(1e-4, 1e-4)
+
+
+class TestWeightOnlyLinearCpuPass_Quantize(PassTest):
+    def setUp(self):
+        self.places.append(paddle.CPUPlace())
+        self.pass_attr_list = [
+            {
+                'weight_only_linear_cpu_pass': {
+                    "weight_only_algo": "weight_only_int8"
+                }
+            }
+        ]
+        self.valid_op_map = {
+            "pd_op.weight_only_linear": 1,
+            "pd_op.weight_quantize": 1,
+            "pd_op.matmul": 0,
+        }
+
+    def sample_program(self):
+        for x_shape in [[2, 4, 1024], [2, 64, 1024]]:
+            rand_value = 0.001 * np.random.random([1024, 512]).astype(
+                "float32"
+            )
+            with paddle.pir_utils.IrGuard():
+                start_prog = paddle.static.Program()
+                main_prog = paddle.static.Program()
+                with paddle.pir.core.program_guard(main_prog, start_prog):
+                    x = paddle.static.data(
+                        name='x', shape=x_shape, dtype="float32"
+                    )
+                    w = create_parameter(
+                        shape=[1024, 512],
+                        dtype="float32",
+                        initializer=paddle.nn.initializer.Assign(rand_value),
+                    )
+                    out = paddle.assign(paddle.matmul(x, w))
+                    self.feeds = {
+                        "x": 0.01 * np.random.random(x_shape).astype("float32"),
+                    }
+                    self.fetch_list = [out]
+                    yield [main_prog, start_prog], False
+
+    def test_check_output(self):
+        self.check_pass_correct(1e-3, 1e-3)
+
+
+if __name__ == "__main__":
+    unittest.main()
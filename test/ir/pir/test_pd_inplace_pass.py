@@ -72,5 +72,36 @@ class TestInputsHasBeenInplaced(unittest.TestCase):
                 )
 
 
+class TestBufferReuse(unittest.TestCase):
+    def run_program(self, buffer_reuse):
+        paddle.set_flags({'FLAGS_ir_inplace_buffer_reuse': buffer_reuse})
+        new_scope = paddle.static.Scope()
+        main_program = paddle.static.Program()
+        with paddle.static.scope_guard(new_scope):
+            with paddle.static.program_guard(main_program):
+                x = paddle.static.data('x', [4, 8], dtype='float32')
+                y = paddle.static.data('y', [8], dtype='float32')
+                z = paddle.nn.functional.gelu(x * 2.0)
+                z = paddle.maximum(paddle.nn.functional.silu(z), y)
+                out = paddle.nn.functional.softplus(z) + 1.0
+
+                exe = paddle.static.Executor(paddle.CPUPlace())
+                np.random.seed(2024)
+                x_feed = np.random.random([4, 8]).astype('float32')
+                y_feed = np.random.random([8]).astype('float32')
+                (out_data,) = exe.run(
+                    feed={"x": x_feed, "y": y_feed}, fetch_list=[out]
+                )
+        return out_data
+
+    def test_buffer_reuse(self):
+        try:
+            expected = self.run_program(False)
+            actual = self.run_program(True)
+        finally:
+            paddle.set_flags({'FLAGS_ir_inplace_buffer_reuse': False})
+        np.testing.assert_allclose(expected, actual, rtol=1e-6)
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -19,6 +19,7 @@ import numpy as np
 
 import paddle
 from paddle.incubate.tensor.manipulation import (
+    LayerwiseOffloader,
     async_offload,
     async_offload_with_offset,
     async_reload,
@@ -92,6 +93,21 @@ class TestSaveLoadLargeParameters(unittest.TestCase):
             data2.numpy(),
         )
 
+    def test_layerwise_offloader(self):
+        model = paddle.nn.Sequential(
+            *[paddle.nn.Linear(16, 16) for _ in range(4)]
+        )
+        x = paddle.randn([4, 16])
+        with paddle.no_grad():
+            expected = model(x).numpy()
+            offloader = LayerwiseOffloader(list(model), prefetch_depth=2)
+            for _ in range(2):
+                np.testing.assert_allclose(
+                    model(x).numpy(), expected, rtol=1e-6
+                )
+            offloader.remove()
+            np.testing.assert_allclose(model(x).numpy(), expected, rtol=1e-6)
+
 
 if __name__ == '__main__':
     unittest.main()
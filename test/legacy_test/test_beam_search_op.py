@@ -299,5 +299,72 @@ class BeamSearchOpTester6(BeamSearchOpTester):
         self.output_parent_idx = np.array([0, 1, 2, 3])
 
 
+@unittest.skipIf(
+    not core.is_compiled_with_cuda(), "core is not compiled with CUDA"
+)
+class BeamSearchOpWideTester(unittest.TestCase):
+    """the wide rows and many sequences go to the wide gpu kernels"""
+
+    def setUp(self):
+        self.num_seqs = 6
+        self.beam_size = 4
+        self.width = 4096
+        np.random.seed(2024)
+        num_rows = self.num_seqs * self.beam_size
+        self.lod = [
+            list(range(0, num_rows + 1, self.beam_size)),
+            list(range(num_rows + 1)),
+        ]
+        self.pre_ids = np.random.randint(1, 10, [num_rows, 1]).astype('int64')
+        self.pre_scores = np.random.random([num_rows, 1]).astype('float32')
+        # distinct scores, so that the selection has no ties
+        self.scores = (
+            np.random.permutation(num_rows * self.width)
+            .reshape([num_rows, self.width])
+            .astype('float32')
+            / (num_rows * self.width)
+        )
+        self.ids = np.tile(np.arange(self.width, dtype='int64'), [num_rows, 1])
+
+    def run_op(self, place):
+        scope = core.Scope()
+        create_tensor(scope, 'pre_ids', self.pre_ids)
+        create_tensor(scope, 'pre_scores', self.pre_scores)
+        create_tensor(scope, 'ids', self.ids).set_lod(self.lod)
+        create_tensor(scope, 'scores', self.scores).set_lod(self.lod)
+        for name in ['selected_ids', 'selected_scores', 'parent_idx']:
+            scope.var(name).get_tensor()
+        op = Operator(
+            'beam_search',
+            pre_ids='pre_ids',
+            pre_scores='pre_scores',
+            ids='ids',
+            scores='scores',
+            selected_ids='selected_ids',
+            selected_scores='selected_scores',
+            parent_idx='parent_idx',
+            level=0,
+            beam_size=self.beam_size,
+            end_id=0,
+            is_accumulated=True,
+        )
+        op.run(scope, place)
+        selected_ids = scope.find_var('selected_ids').get_tensor()
+        return (
+            np.array(selected_ids),
+            np.array(scope.find_var('selected_scores').get_tensor()),
+            np.array(scope.find_var('parent_idx').get_tensor()),
+            selected_ids.lod(),
+        )
+
+    def test_run(self):
+        expected = self.run_op(core.CPUPlace())
+        actual = self.run_op(core.CUDAPlace(0))
+        np.testing.assert_array_equal(actual[0], expected[0])
+        np.testing.assert_allclose(actual[1], expected[1], rtol=1e-05)
+        np.testing.assert_array_equal(actual[2], expected[2])
+        self.assertEqual(actual[3], expected[3])
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -18,7 +18,10 @@ import numpy as np
 
 import paddle
 from paddle import nn
-from paddle.device.cuda.cuda_graphed_layer import CUDAGraphedLayer
+from paddle.device.cuda.cuda_graphed_layer import (
+    CUDAGraphedFunction,
+    CUDAGraphedLayer,
+)
 
 seed = 102
 
@@ -86,5 +89,41 @@ class TestSimpleModel(unittest.TestCase):
         )
 
 
+@unittest.skipIf(
+    not paddle.is_compiled_with_cuda() or float(paddle.version.cuda()) < 11.0,
+    "only support cuda >= 11.0",
+)
+class TestCUDAGraphedFunction(unittest.TestCase):
+    def test_function(self):
+        model = Model(10, 20)
+
+        def step(x, scale):
+            return model(x) * scale
+
+        graphed_step = CUDAGraphedFunction(step)
+        for shape in [[3, 10], [5, 10], [3, 10], [5, 10], [3, 10]]:
+            for scale in [1.0, 2.0]:
+                x = paddle.randn(shape, dtype='float32')
+                expected = step(x, scale).numpy()
+                np.testing.assert_array_equal(
+                    graphed_step(x, scale).numpy(), expected
+                )
+        self.assertEqual(graphed_step.num_graphs(), 4)
+
+        graphed_step.reset()
+        self.assertEqual(graphed_step.num_graphs(), 0)
+
+    def test_evict(self):
+        graphed_step = CUDAGraphedFunction(
+            lambda x: x * 2, num_warmup_steps=0, max_num_graphs=2
+        )
+        for n in range(1, 5):
+            x = paddle.randn([n, 4], dtype='float32')
+            np.testing.assert_array_equal(
+                graphed_step(x).numpy(), x.numpy() * 2
+            )
+        self.assertEqual(graphed_step.num_graphs(), 2)
+
+
 if __name__ == "__main__":
     unittest.main()
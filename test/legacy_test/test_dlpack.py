@@ -325,6 +325,22 @@ class TestDLPack(unittest.TestCase):
                     np.testing.assert_array_equal(x.numpy(), y1.numpy())
                     np.testing.assert_array_equal(x.numpy(), y2.numpy())
 
+    def test_dlpack_stream_exchange(self):
+        with dygraph_guard():
+            if not paddle.is_compiled_with_cuda():
+                return
+            x = paddle.rand([64, 64]).to(device=base.CUDAPlace(0))
+            stream = paddle.device.cuda.Stream()
+            for consumer in [None, -1, 1, stream.cuda_stream]:
+                capsule = x.__dlpack__(stream=consumer)
+                y = paddle.from_dlpack(capsule)
+                self.assertEqual(x.data_ptr(), y.data_ptr())
+                np.testing.assert_array_equal(x.numpy(), y.numpy())
+
+            y = paddle.from_dlpack(x.__dlpack__(stream=1, copy=True))
+            self.assertNotEqual(x.data_ptr(), y.data_ptr())
+            np.testing.assert_array_equal(x.numpy(), y.numpy())
+
 
 from paddle.utils.dlpack import DLDeviceType
 
@@ -0,0 +1,123 @@
+# Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import numpy as np
+
+import paddle
+from paddle import base
+from paddle.base import core
+
+
+def embedding_seq_pool_ref(ids, lens, weight, pool_type):
+    outs = []
+    start = 0
+    for n in lens:
+        rows = weight[ids[start : start + n, 0]]
+        pooled = rows.sum(axis=0)
+        if n > 0 and pool_type == 'average':
+            pooled = pooled / n
+        elif n > 0 and pool_type == 'sqrt':
+            pooled = pooled / np.sqrt(n)
+        outs.append(pooled)
+        start += n
+    return np.stack(outs)
+
+
+@unittest.skipIf(
+    not core.is_compiled_with_cuda(),
+    "core is not compiled with CUDA",
+)
+class TestFusedEmbeddingSeqPoolOp(unittest.TestCase):
+    def setUp(self):
+        np.random.seed(2024)
+        self.rows = 20
+        self.dim = 8
+        # an empty sequence in the second slot
+        self.lens = [[3, 1, 2], [2, 0, 4]]
+        self.ids = [
+            np.random.randint(0, self.rows, [sum(lens), 1]).astype('int64')
+            for lens in self.lens
+        ]
+        self.weight = np.random.random([self.rows, self.dim]).astype(
+            'float32'
+        )
+
+    def check(self, pool_type):
+        place = paddle.CUDAPlace(0)
+        with paddle.pir_utils.OldIrGuard():
+            main_prog = paddle.static.Program()
+            start_prog = paddle.static.Program()
+            with paddle.static.program_guard(main_prog, start_prog):
+                inputs = [
+                    paddle.static.data(
+                        name=f'ids_{i}',
+                        shape=[-1, 1],
+                        dtype='int64',
+                        lod_level=1,
+                    )
+                    for i in range(len(self.lens))
+                ]
+                weight = paddle.static.create_parameter(
+                    shape=[self.rows, self.dim],
+                    dtype='float32',
+                    default_initializer=paddle.nn.initializer.Assign(
+                        self.weight
+                    ),
+                )
+                outs = paddle.incubate.layers.fused_embedding_seq_pool(
+                    inputs, weight, pool_type
+                )
+                loss = paddle.add_n([out.sum() for out in outs])
+                (weight_grad,) = paddle.static.gradients(loss, [weight])
+
+            exe = paddle.static.Executor(place)
+            exe.run(start_prog)
+            feed = {
+                f'ids_{i}': base.create_lod_tensor(ids, [lens], place)
+                for i, (ids, lens) in enumerate(zip(self.ids, self.lens))
+            }
+            results = exe.run(
+                main_prog, feed=feed, fetch_list=[*outs, weight_grad]
+            )
+
+        expected_grad = np.zeros_like(self.weight)
+        for i, (ids, lens) in enumerate(zip(self.ids, self.lens)):
+            np.testing.assert_allclose(
+                results[i],
+                embedding_seq_pool_ref(ids, lens, self.weight, pool_type),
+                rtol=1e-5,
+            )
+            start = 0
+            for n in lens:
+                scale = {'sum': 1.0, 'average': 1.0 / max(n, 1)}.get(
+                    pool_type, 1.0 / np.sqrt(max(n, 1))
+                )
+                np.add.at(expected_grad, ids[start : start + n, 0], scale)
+                start += n
+        np.testing.assert_allclose(results[-1], expected_grad, rtol=1e-5)
+
+    def test_sum(self):
+        self.check('sum')
+
+    def test_average(self):
+        self.check('average')
+
+    def test_sqrt(self):
+        self.check('sqrt')
+
+
+if __name__ == '__main__':
+    unittest.main()
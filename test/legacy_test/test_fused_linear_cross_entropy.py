@@ -0,0 +1,93 @@
+# Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import numpy as np
+
+import paddle
+import paddle.nn.functional as F
+from paddle.incubate.nn.functional import fused_linear_cross_entropy
+
+
+class TestFusedLinearCrossEntropy(unittest.TestCase):
+    def setUp(self):
+        np.random.seed(2024)
+        self.num_tokens = 12
+        self.hidden_size = 16
+        # the vocab is not a multiple of the chunk size
+        self.vocab_size = 75
+        self.chunk_size = 32
+        self.ignore_index = -100
+
+    def make_inputs(self, use_bias):
+        x = np.random.random([self.num_tokens, self.hidden_size]) - 0.5
+        weight = np.random.random([self.hidden_size, self.vocab_size]) - 0.5
+        bias = np.random.random([self.vocab_size]) - 0.5 if use_bias else None
+        label = np.random.randint(0, self.vocab_size, [self.num_tokens])
+        label[::5] = self.ignore_index
+        return x.astype('float32'), weight.astype('float32'), bias, label
+
+    def run_loss(self, fused, inputs, reduction):
+        x, weight, bias, label = inputs
+        x = paddle.to_tensor(x, stop_gradient=False)
+        weight = paddle.to_tensor(weight, stop_gradient=False)
+        if bias is not None:
+            bias = paddle.to_tensor(bias.astype('float32'), stop_gradient=False)
+        label = paddle.to_tensor(label, dtype='int64')
+        if fused:
+            loss = fused_linear_cross_entropy(
+                x,
+                weight,
+                label,
+                bias,
+                ignore_index=self.ignore_index,
+                reduction=reduction,
+                chunk_size=self.chunk_size,
+            )
+        else:
+            loss = F.cross_entropy(
+                F.linear(x, weight, bias),
+                label.unsqueeze(1),
+                ignore_index=self.ignore_index,
+                reduction=reduction,
+            ).reshape([-1] if reduction == 'none' else [])
+        loss.sum().backward()
+        grads = [x.grad.numpy(), weight.grad.numpy()]
+        if bias is not None:
+            grads.append(bias.grad.numpy())
+        return loss.numpy(), grads
+
+    def check(self, reduction, use_bias):
+        inputs = self.make_inputs(use_bias)
+        expected_loss, expected_grads = self.run_loss(False, inputs, reduction)
+        loss, grads = self.run_loss(True, inputs, reduction)
+        np.testing.assert_allclose(loss, expected_loss, rtol=1e-5, atol=1e-6)
+        for grad, expected_grad in zip(grads, expected_grads):
+            np.testing.assert_allclose(
+                grad, expected_grad, rtol=1e-5, atol=1e-6
+            )
+
+    def test_mean(self):
+        self.check('mean', use_bias=False)
+
+    def test_sum_with_bias(self):
+        self.check('sum', use_bias=True)
+
+    def test_none(self):
+        self.check('none', use_bias=True)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,182 @@
+# Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import numpy as np
+
+import paddle
+from paddle import _C_ops
+
+SHAPES = [[2, 3], [1000], [70000], [3, 4, 5]]
+
+
+def gen_inputs(shapes, num_states):
+    np.random.seed(10)
+    params = [np.random.random(s).astype('float32') for s in shapes]
+    grads = [np.random.random(s).astype('float32') for s in shapes]
+    states = [
+        [np.random.random(s).astype('float32') for s in shapes]
+        for _ in range(num_states)
+    ]
+    return params, grads, states
+
+
+def ref_adagrad(param, grad, moment, lr, epsilon):
+    moment = moment + grad * grad
+    param = param - lr * grad / (np.sqrt(moment) + epsilon)
+    return param, moment
+
+
+def ref_rmsprop(
+    param, grad, mean_square, moment, mean_grad, lr, epsilon, rho, momentum
+):
+    mean_square = rho * mean_square + (1 - rho) * grad * grad
+    if mean_grad is not None:
+        mean_grad = rho * mean_grad + (1 - rho) * grad
+        denom = np.sqrt(mean_square - mean_grad * mean_grad + epsilon)
+    else:
+        denom = np.sqrt(mean_square + epsilon)
+    moment = momentum * moment + lr * grad / denom
+    return param - moment, mean_square, moment, mean_grad
+
+
+@unittest.skipIf(
+    not paddle.is_compiled_with_cuda(), "core is not compiled with CUDA"
+)
+class TestFusedAdagradOp(unittest.TestCase):
+    def setUp(self):
+        paddle.disable_static()
+        paddle.set_device('gpu')
+        self.lr = 0.01
+        self.epsilon = 1e-6
+
+    def run_fused(self, params, grads, moments, found_inf=None, scale=None):
+        param_vars = [paddle.to_tensor(p) for p in params]
+        moment_vars = [paddle.to_tensor(m) for m in moments]
+        _C_ops.fused_adagrad_(
+            param_vars,
+            [paddle.to_tensor(g) for g in grads],
+            paddle.to_tensor(np.array([self.lr], dtype='float32')),
+            moment_vars,
+            None,
+            found_inf,
+            scale,
+            self.epsilon,
+            4096,
+            False,
+        )
+        return [p.numpy() for p in param_vars], [
+            m.numpy() for m in moment_vars
+        ]
+
+    def test_update(self):
+        params, grads, (moments,) = gen_inputs(SHAPES, 1)
+        scale = 4.0
+        out_params, out_moments = self.run_fused(
+            params,
+            [g * scale for g in grads],
+            moments,
+            found_inf=paddle.to_tensor(False),
+            scale=paddle.to_tensor(np.array([scale], dtype='float32')),
+        )
+        for i in range(len(SHAPES)):
+            ref_param, ref_moment = ref_adagrad(
+                params[i], grads[i], moments[i], self.lr, self.epsilon
+            )
+            np.testing.assert_allclose(out_params[i], ref_param, rtol=1e-5)
+            np.testing.assert_allclose(out_moments[i], ref_moment, rtol=1e-5)
+
+    def test_found_inf(self):
+        params, grads, (moments,) = gen_inputs(SHAPES, 1)
+        out_params, out_moments = self.run_fused(
+            params, grads, moments, found_inf=paddle.to_tensor(True)
+        )
+        for i in range(len(SHAPES)):
+            np.testing.assert_array_equal(out_params[i], params[i])
+            np.testing.assert_array_equal(out_moments[i], moments[i])
+
+
+@unittest.skipIf(
+    not paddle.is_compiled_with_cuda(), "core is not compiled with CUDA"
+)
+class TestFusedRmspropOp(unittest.TestCase):
+    def setUp(self):
+        paddle.disable_static()
+        paddle.set_device('gpu')
+        self.lr = 0.01
+        self.epsilon = 1e-6
+        self.rho = 0.9
+        self.momentum = 0.5
+
+    def check(self, centered):
+        params, grads, (mean_squares, moments, mean_grads) = gen_inputs(
+            SHAPES, 3
+        )
+        # keep mean_square - mean_grad^2 positive
+        mean_squares = [ms + 1 for ms in mean_squares]
+        param_vars = [paddle.to_tensor(p) for p in params]
+        ms_vars = [paddle.to_tensor(ms) for ms in mean_squares]
+        mom_vars = [paddle.to_tensor(m) for m in moments]
+        mg_vars = (
+            [paddle.to_tensor(mg) for mg in mean_grads] if centered else None
+        )
+        _C_ops.fused_rmsprop_(
+            param_vars,
+            [paddle.to_tensor(g) for g in grads],
+            paddle.to_tensor(np.array([self.lr], dtype='float32')),
+            ms_vars,
+            mom_vars,
+            mg_vars,
+            None,
+            None,
+            None,
+            self.epsilon,
+            self.rho,
+            self.momentum,
+            4096,
+            centered,
+            False,
+        )
+        for i in range(len(SHAPES)):
+            ref_param, ref_ms, ref_mom, ref_mg = ref_rmsprop(
+                params[i],
+                grads[i],
+                mean_squares[i],
+                moments[i],
+                mean_grads[i] if centered else None,
+                self.lr,
+                self.epsilon,
+                self.rho,
+                self.momentum,
+            )
+            np.testing.assert_allclose(
+                param_vars[i].numpy(), ref_param, rtol=1e-5
+            )
+            np.testing.assert_allclose(ms_vars[i].numpy(), ref_ms, rtol=1e-5)
+            np.testing.assert_allclose(mom_vars[i].numpy(), ref_mom, rtol=1e-5)
+            if centered:
+                np.testing.assert_allclose(
+                    mg_vars[i].numpy(), ref_mg, rtol=1e-5
+                )
+
+    def test_uncentered(self):
+        self.check(centered=False)
+
+    def test_centered(self):
+        self.check(centered=True)
+
+
+if __name__ == '__main__':
+    unittest.main()
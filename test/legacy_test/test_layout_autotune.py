@@ -18,6 +18,8 @@ import tempfile
 import unittest
 import warnings
 
+import numpy as np
+
 import paddle
 import paddle.nn.functional as F
 
@@ -182,6 +184,26 @@ class LayoutAutoTune(unittest.TestCase):
         self.assertEqual(conv_out.shape, [1, 8, 14, 12])
         self.assertEqual(out.shape, [1, 8, 17, 13])
 
+    def test_region_plan(self):
+        conv = paddle.nn.Conv2D(3, 8, (3, 3))
+        data = paddle.rand([1, 3, 16, 14])
+        paddle.set_flags({'FLAGS_layout_autotune_region_gain': 0.5})
+        try:
+            outs = []
+            for _ in range(2):
+                with paddle.amp.auto_cast(level="O2"):
+                    conv_out = conv(data)
+                    # the region of conv transposes more than it computes,
+                    # so it is only tuned on the traced first run
+                    out = paddle.transpose(conv_out, perm=[0, 3, 1, 2])
+                self.assertEqual(conv_out.shape, [1, 8, 14, 12])
+                self.assertEqual(out.shape, [1, 12, 8, 14])
+                outs.append(out.astype('float32').numpy())
+        finally:
+            paddle.set_flags({'FLAGS_layout_autotune_region_gain': 0.0})
+        np.testing.assert_allclose(outs[0], outs[1], rtol=1e-3, atol=1e-3)
+
+
 
 class TestAutoTuneAPI(unittest.TestCase):
     def test_set_config_warnings(self):
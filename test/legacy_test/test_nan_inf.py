@@ -277,6 +277,33 @@ class TestNanInfCheckResult(TestNanInfBase):
             )
 
 
+@unittest.skipIf(
+    not paddle.base.core.is_compiled_with_cuda(),
+    "core is not compiled with CUDA",
+)
+class TestNanInfLazyCheck(TestNanInfBase):
+    def test_lazy_check(self):
+        paddle.device.set_device("gpu:0")
+        paddle.set_flags(
+            {
+                "FLAGS_check_nan_inf": 1,
+                "FLAGS_check_nan_inf_level": 0,
+                "FLAGS_check_nan_inf_lazy": 1,
+            }
+        )
+        x = paddle.to_tensor(np.array([1.0, -1.0, 0.0], dtype="float32"))
+        # the op does not raise, the flags are read back at the flush
+        out = paddle.log(x)
+        with self.assertRaisesRegex(Exception, "NAN or INF"):
+            paddle.base.core.flush_nan_inf_check()
+        # the flags are reset by the flush
+        out = paddle.exp(paddle.to_tensor([1.0, 2.0]))
+        paddle.base.core.flush_nan_inf_check()
+        paddle.set_flags(
+            {"FLAGS_check_nan_inf": 0, "FLAGS_check_nan_inf_lazy": 0}
+        )
+
+
 class TestCheckNumericsAPI(TestNanInfBase):
     def test_eager(self):
         shape = [8, 8]
@@ -0,0 +1,73 @@
+# Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import numpy as np
+
+import paddle
+import paddle.incubate.nn.functional as F
+
+
+class TestPackedSequence(unittest.TestCase):
+    def setUp(self):
+        np.random.seed(2024)
+        self.seq_lens = np.array([5, 2, 7, 1], dtype='int64')
+        self.x = np.random.random([4, 7, 6]).astype('float32')
+
+    def test_pack_unpack(self):
+        packed = F.pack_sequence(
+            paddle.to_tensor(self.x), paddle.to_tensor(self.seq_lens)
+        )
+        expected = np.concatenate(
+            [self.x[i, :n] for i, n in enumerate(self.seq_lens)]
+        )
+        np.testing.assert_allclose(packed.data.numpy(), expected)
+        np.testing.assert_array_equal(
+            packed.cu_seqlens.numpy(), [0, 5, 7, 14, 15]
+        )
+        self.assertEqual(packed.max_seqlen, 7)
+
+        # a token-wise layer only runs on the valid tokens
+        linear = paddle.nn.Linear(6, 3)
+        out = F.unpack_sequence(linear(packed.data), packed)
+        self.assertEqual(out.shape, [4, 7, 3])
+        padded_out = linear(paddle.to_tensor(self.x)).numpy()
+        for i, n in enumerate(self.seq_lens):
+            np.testing.assert_allclose(
+                out.numpy()[i, :n], padded_out[i, :n], rtol=1e-5
+            )
+            np.testing.assert_array_equal(out.numpy()[i, n:], 0)
+
+    def test_pool(self):
+        packed = F.pack_sequence(
+            paddle.to_tensor(self.x), paddle.to_tensor(self.seq_lens)
+        )
+        for pool_type, pool in [
+            ('mean', np.mean),
+            ('sum', np.sum),
+            ('max', np.max),
+        ]:
+            out = F.packed_pool(packed.data, packed, pool_type)
+            expected = np.stack(
+                [
+                    pool(self.x[i, :n], axis=0)
+                    for i, n in enumerate(self.seq_lens)
+                ]
+            )
+            np.testing.assert_allclose(out.numpy(), expected, rtol=1e-5)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,88 @@
+# Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import numpy as np
+
+import paddle
+from paddle.device.cuda.graphs import is_cuda_graph_supported
+
+
+def build_program():
+    main = paddle.static.Program()
+    startup = paddle.static.Program()
+    with paddle.static.program_guard(main, startup):
+        x = paddle.static.data(shape=[4, 8], dtype='float32', name='x')
+        y = paddle.nn.functional.relu(paddle.matmul(x, x, transpose_y=True))
+        pred = paddle.mean(y) > 1.0
+        z = paddle.static.nn.cond(pred, lambda: y * 2.0, lambda: y - 1.0)
+
+        i = paddle.full(shape=[1], fill_value=0, dtype='int64')
+        limit = paddle.full(shape=[1], fill_value=3, dtype='int64')
+
+        def body(i, z):
+            return [i + 1, paddle.tanh(z) + 0.5]
+
+        _, out = paddle.static.nn.while_loop(
+            lambda i, z: i < limit, body, [i, z]
+        )
+        out = paddle.sum(out * 3.0)
+    return main, startup, out
+
+
+@unittest.skipIf(
+    not paddle.is_compiled_with_cuda() or not is_cuda_graph_supported(),
+    "only support cuda graph",
+)
+class TestPirCUDAGraphSegments(unittest.TestCase):
+    def run_program(self, use_segments):
+        paddle.set_flags(
+            {
+                'FLAGS_enable_pir_in_executor_trace_run': True,
+                'FLAGS_new_executor_use_cuda_graph': use_segments,
+                'FLAGS_new_executor_segmented_cuda_graph': use_segments,
+            }
+        )
+        main, startup, out = build_program()
+        exe = paddle.static.Executor(paddle.CUDAPlace(0))
+        exe.run(startup)
+        np.random.seed(2024)
+        results = []
+        for step in range(6):
+            # the branch taken changes with the scale of the inputs
+            x = np.random.random([4, 8]).astype('float32') * (step % 3)
+            results.append(exe.run(main, feed={'x': x}, fetch_list=[out])[0])
+        return results
+
+    def test_segments(self):
+        paddle.enable_static()
+        try:
+            expected = self.run_program(False)
+            actual = self.run_program(True)
+        finally:
+            paddle.set_flags(
+                {
+                    'FLAGS_enable_pir_in_executor_trace_run': False,
+                    'FLAGS_new_executor_use_cuda_graph': False,
+                    'FLAGS_new_executor_segmented_cuda_graph': False,
+                }
+            )
+            paddle.disable_static()
+        for e, a in zip(expected, actual):
+            np.testing.assert_allclose(e, a, rtol=1e-5)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,103 @@
+# Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import numpy as np
+
+import paddle
+
+
+def resized_crop_normalize_ref(x, boxes, flips, size, mean, std):
+    n, c, h, w = x.shape
+    out_h, out_w = size
+    out = np.zeros([n, c, out_h, out_w], dtype='float32')
+    for i in range(n):
+        top, left, box_h, box_w = boxes[i]
+        for oy in range(out_h):
+            sy = min(max((oy + 0.5) * box_h / out_h - 0.5, 0), box_h - 1)
+            y0 = int(sy)
+            y1 = min(y0 + 1, box_h - 1)
+            ly = sy - y0
+            for ox in range(out_w):
+                fx = out_w - 1 - ox if flips[i] else ox
+                sx = min(max((fx + 0.5) * box_w / out_w - 0.5, 0), box_w - 1)
+                x0 = int(sx)
+                x1 = min(x0 + 1, box_w - 1)
+                lx = sx - x0
+                img = x[i].astype('float32')
+                v = (1 - ly) * (
+                    (1 - lx) * img[:, top + y0, left + x0]
+                    + lx * img[:, top + y0, left + x1]
+                ) + ly * (
+                    (1 - lx) * img[:, top + y1, left + x0]
+                    + lx * img[:, top + y1, left + x1]
+                )
+                out[i, :, oy, ox] = (v - mean) / std
+    return out
+
+
+class TestResizedCropNormalize(unittest.TestCase):
+    def setUp(self):
+        np.random.seed(2024)
+        self.x = np.random.randint(0, 255, [3, 3, 20, 30]).astype('uint8')
+        self.boxes = np.array(
+            [[0, 0, 20, 30], [2, 5, 12, 16], [7, 3, 9, 20]], dtype='int32'
+        )
+        self.flips = np.array([False, True, True])
+        self.size = [8, 10]
+        self.mean = np.array([123.7, 116.3, 103.5], dtype='float32')
+        self.std = np.array([58.4, 57.1, 57.4], dtype='float32')
+        self.places = [paddle.CPUPlace()]
+        if paddle.is_compiled_with_cuda():
+            self.places.append(paddle.CUDAPlace(0))
+
+    def test_dygraph(self):
+        expected = resized_crop_normalize_ref(
+            self.x, self.boxes, self.flips, self.size, self.mean, self.std
+        )
+        for place in self.places:
+            paddle.disable_static(place)
+            out = paddle.vision.ops.resized_crop_normalize(
+                paddle.to_tensor(self.x),
+                paddle.to_tensor(self.boxes),
+                self.size,
+                self.mean.tolist(),
+                self.std.tolist(),
+                paddle.to_tensor(self.flips),
+            )
+            np.testing.assert_allclose(
+                out.numpy(), expected, rtol=1e-5, atol=1e-5
+            )
+
+    def test_no_flip(self):
+        expected = resized_crop_normalize_ref(
+            self.x, self.boxes, [False] * 3, [6, 6], 127.5, 127.5
+        )
+        for place in self.places:
+            paddle.disable_static(place)
+            out = paddle.vision.ops.resized_crop_normalize(
+                paddle.to_tensor(self.x),
+                paddle.to_tensor(self.boxes),
+                6,
+                127.5,
+                127.5,
+            )
+            np.testing.assert_allclose(
+                out.numpy(), expected, rtol=1e-5, atol=1e-5
+            )
+
+
+if __name__ == '__main__':
+    unittest.main()
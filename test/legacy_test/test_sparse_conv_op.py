@@ -133,6 +133,39 @@ class TestSparseConv(unittest.TestCase):
             sparse_x.indices().numpy(), y.indices().numpy()
         )
 
+    def test_subm_conv3d_shared_rulebook(self):
+        indices = [[0, 0, 0, 0], [0, 0, 0, 0], [0, 0, 1, 2], [1, 3, 2, 3]]
+        values = [[1], [2], [3], [4]]
+        indices = paddle.to_tensor(indices, dtype='int32')
+        values = paddle.to_tensor(values, dtype='float32')
+        dense_shape = [1, 1, 3, 4, 1]
+        sparse_x = paddle.sparse.sparse_coo_tensor(
+            indices, values, dense_shape, stop_gradient=True
+        )
+        weight1 = paddle.randn((1, 3, 3, 1, 4), dtype='float32')
+        weight2 = paddle.randn((1, 3, 3, 4, 4), dtype='float32')
+        # the second conv reuses the rulebook built by the first one
+        y1 = paddle.sparse.nn.functional.subm_conv3d(sparse_x, weight1)
+        y2 = paddle.sparse.nn.functional.subm_conv3d(
+            paddle.sparse.nn.functional.relu(y1), weight2
+        )
+
+        fresh_y1 = paddle.sparse.sparse_coo_tensor(
+            y1.indices().clone(),
+            y1.values().clone(),
+            y1.shape,
+            stop_gradient=True,
+        )
+        expected = paddle.sparse.nn.functional.subm_conv3d(
+            paddle.sparse.nn.functional.relu(fresh_y1), weight2
+        )
+        np.testing.assert_array_equal(
+            sparse_x.indices().numpy(), y2.indices().numpy()
+        )
+        np.testing.assert_allclose(
+            expected.values().numpy(), y2.values().numpy(), rtol=1e-05
+        )
+
     def test_Conv2D(self):
         # (3, non_zero_num), 3-D:(N, H, W)
         indices = [[0, 0, 0, 0], [0, 0, 1, 2], [1, 3, 2, 3]]
@@ -87,6 +87,22 @@ class TestMatmulSparseDense(unittest.TestCase):
         self.check_result([16, 12], [12, 10], 'coo')
         self.check_result([16, 12], [12, 10], 'csr')
 
+    @unittest.skipIf(
+        not paddle.is_compiled_with_cuda() or get_cuda_version() < 11000,
+        "only support cuda>=11.0",
+    )
+    def test_matmul_2d_autotune(self):
+        paddle.incubate.autotune.set_config(
+            config={"kernel": {"enable": True, "tuning_range": [0, 3]}}
+        )
+        for _ in range(3):
+            self.check_result([64, 48], [48, 40], 'coo')
+            self.check_result([64, 48], [48, 40], 'csr')
+            self.check_result([64, 48], [48, 1], 'coo')
+        paddle.incubate.autotune.set_config(
+            config={"kernel": {"enable": False}}
+        )
+
     @unittest.skipIf(
         not paddle.is_compiled_with_cuda() or get_cuda_version() < 11080,
         "only support cuda>=11.8",
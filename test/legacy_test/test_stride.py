@@ -703,6 +703,54 @@ class TestStride(unittest.TestCase):
 
         self.assertTrue(np.allclose(out_c.numpy(), np_out))
 
+    def call_elementwise(self):
+        x_np = np.random.random(size=[2, 3, 4]).astype('float32')
+        y_np = np.random.random(size=[3, 4]).astype('float32') + 1.0
+        x = paddle.to_tensor(x_np)
+        y = paddle.to_tensor(y_np)
+
+        x_t = paddle.transpose(x, perm=[0, 2, 1])
+        y_t = paddle.transpose(y, perm=[1, 0])[:, 1:3]
+        x_np_t = x_np.transpose(0, 2, 1)
+        y_np_t = y_np.transpose(1, 0)[:, 1:3]
+        self.assertFalse(x_t.is_contiguous())
+        self.assertFalse(y_t.is_contiguous())
+
+        x_s = x_t[:, :, 1:3]
+        x_np_s = x_np_t[:, :, 1:3]
+        np.testing.assert_allclose(
+            paddle.add(x_s, y_t).numpy(), x_np_s + y_np_t, rtol=1e-6
+        )
+        np.testing.assert_allclose(
+            paddle.subtract(x_s, y_t).numpy(), x_np_s - y_np_t, rtol=1e-6
+        )
+        np.testing.assert_allclose(
+            paddle.multiply(y_t, x_s).numpy(), y_np_t * x_np_s, rtol=1e-6
+        )
+        out = paddle.divide(x_t, paddle.to_tensor(y_np[:, 0]))
+        np.testing.assert_allclose(out.numpy(), x_np_t / y_np[:, 0], rtol=1e-6)
+        self.assertTrue(out.is_contiguous())
+
+    def call_reduce_sum(self):
+        x_np = np.random.random(size=[2, 3, 4]).astype('float32')
+        x = paddle.to_tensor(x_np)
+
+        x_t = paddle.transpose(x, perm=[2, 0, 1])
+        x_np_t = x_np.transpose(2, 0, 1)
+        for axis in [None, 0, 1, 2, [0, 2], [1, 2]]:
+            for keepdim in [False, True]:
+                out = paddle.sum(x_t, axis=axis, keepdim=keepdim)
+                np_axis = tuple(axis) if isinstance(axis, list) else axis
+                out_np = np.sum(x_np_t, axis=np_axis, keepdims=keepdim)
+                np.testing.assert_allclose(out.numpy(), out_np, rtol=1e-5)
+                self.assertTrue(out.is_contiguous())
+
+        x_s = x[:, 1:, :]
+        out = paddle.sum(x_s, axis=1)
+        np.testing.assert_allclose(
+            out.numpy(), np.sum(x_np[:, 1:, :], axis=1), rtol=1e-5
+        )
+
     def call_stride(self):
         self.call_transpose()
         self.call_diagonal()
@@ -733,6 +781,8 @@ class TestStride(unittest.TestCase):
         self.call_view7()
         self.call_view_as()
         self.call_unfold()
+        self.call_elementwise()
+        self.call_reduce_sum()
 
 
 class TestStrideCPU(TestStride):
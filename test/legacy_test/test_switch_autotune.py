@@ -197,5 +197,36 @@ class TestAutoTuneAPI(unittest.TestCase):
         )
 
 
+class TestAutoTuneCacheFile(unittest.TestCase):
+    def test_export_and_load(self):
+        paddle.disable_static()
+        paddle.incubate.autotune.set_config(
+            config={"kernel": {"enable": True, "tuning_range": [1, 2]}}
+        )
+        x_var = paddle.uniform((1, 1, 8, 8), dtype='float32', min=-1.0, max=1.0)
+        net = SimpleNet()
+        for i in range(3):
+            train_dygraph(net, x_var)
+
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            path = os.path.join(tmp_dir, "autotune_cache.txt")
+            num_exported = paddle.incubate.autotune.export_kernel_cache(path)
+
+            paddle.incubate.autotune.set_config(
+                config={"kernel": {"enable": False}}
+            )
+            self.assertEqual(paddle.base.core.autotune_status()["cache_size"], 0)
+            num_loaded = paddle.incubate.autotune.load_kernel_cache(path)
+            self.assertEqual(num_loaded, num_exported)
+
+            missing = os.path.join(tmp_dir, "missing.txt")
+            self.assertEqual(
+                paddle.incubate.autotune.load_kernel_cache(missing), 0
+            )
+        paddle.incubate.autotune.set_config(
+            config={"kernel": {"enable": False}}
+        )
+
+
 if __name__ == '__main__':
     unittest.main()
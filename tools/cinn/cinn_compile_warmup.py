@@ -0,0 +1,107 @@
+# Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""
+Compiles the CINN fusion groups of a saved PIR program ahead of deployment.
+
+The program is run once for every given set of input shapes, so that all its
+fusion groups are lowered and compiled by the PirCompiler, and the compiled
+kernels are written to the compile cache directory. The production processes
+started with the same FLAGS_cinn_compile_cache_dir then load the kernels from
+there instead of compiling them on the request path.
+
+Example:
+
+    python cinn_compile_warmup.py \\
+        --model_file model.json --params_file model.pdiparams \\
+        --cache_dir /data/cinn_cache \\
+        --shapes "x:1,3,224,224" --shapes "x:8,3,224,224"
+"""
+
+import argparse
+import os
+import time
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument(
+        '--model_file', type=str, required=True, help='The saved PIR program.'
+    )
+    parser.add_argument(
+        '--params_file', type=str, required=True, help='The saved parameters.'
+    )
+    parser.add_argument(
+        '--cache_dir',
+        type=str,
+        required=True,
+        help='The directory to store the compiled kernels in.',
+    )
+    parser.add_argument(
+        '--shapes',
+        type=str,
+        action='append',
+        required=True,
+        help='A set of input shapes, in the format name:d0,d1;name:d0,d1. '
+        'It can be given several times.',
+    )
+    parser.add_argument(
+        '--dtype', type=str, default='float32', help='The input data type.'
+    )
+    parser.add_argument('--gpu_id', type=int, default=0, help='The gpu id.')
+    return parser.parse_args()
+
+
+def parse_shapes(spec):
+    shapes = {}
+    for item in spec.split(';'):
+        name, dims = item.split(':')
+        shapes[name.strip()] = [int(d) for d in dims.split(',')]
+    return shapes
+
+
+def main():
+    args = parse_args()
+    # The cinn flags are read from the environment when paddle is loaded.
+    os.environ['FLAGS_cinn_compile_cache_dir'] = args.cache_dir
+    os.environ['FLAGS_cinn_report_compile_time'] = '1'
+    os.makedirs(args.cache_dir, exist_ok=True)
+
+    import numpy as np
+
+    import paddle
+    from paddle import inference
+
+    config = inference.Config(args.model_file, args.params_file)
+    if paddle.is_compiled_with_cuda():
+        config.enable_use_gpu(256, args.gpu_id)
+    config.enable_new_ir()
+    config.enable_new_executor()
+    config.enable_cinn()
+    predictor = inference.create_predictor(config)
+
+    for spec in args.shapes:
+        shapes = parse_shapes(spec)
+        for name in predictor.get_input_names():
+            if name not in shapes:
+                raise ValueError(f"The shape of input {name} is not given.")
+            handle = predictor.get_input_handle(name)
+            handle.reshape(shapes[name])
+            handle.copy_from_cpu(np.ones(shapes[name], dtype=args.dtype))
+        start = time.time()
+        predictor.run()
+        print(f"Warmed up {spec} in {time.time() - start:.3f} s")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,125 @@
+# Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""
+Builds the cudnn frontend execution plans of a list of convolutions ahead of
+deployment.
+
+Every convolution of the shapes file is run once with the cudnn frontend, so
+that its execution plan is built and cached, then all the plans are exported
+to the autotune cache file. The production processes started with the same
+FLAGS_autotune_cache_file load the plans from there instead of querying the
+heuristics and building the plans on the request path. The plans already in
+the cache file are kept.
+
+Each line of the shapes file describes one convolution, in the format
+``x_shape w_shape stride padding dilation groups dtype``, e.g.
+
+    1,3,224,224 64,3,7,7 2 3 1 1 float16
+
+Example:
+
+    python cudnn_plan_prewarm.py \\
+        --shapes_file conv_shapes.txt --cache_file /data/autotune_cache.txt
+"""
+
+import argparse
+import os
+import time
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument(
+        '--shapes_file',
+        type=str,
+        required=True,
+        help='The file of the convolutions to build the plans for.',
+    )
+    parser.add_argument(
+        '--cache_file',
+        type=str,
+        required=True,
+        help='The autotune cache file to export the plans to.',
+    )
+    parser.add_argument(
+        '--data_format', type=str, default='NCHW', help='NCHW or NHWC.'
+    )
+    parser.add_argument('--gpu_id', type=int, default=0, help='The gpu id.')
+    return parser.parse_args()
+
+
+def parse_dims(spec):
+    return [int(d) for d in spec.split(',')]
+
+
+def parse_shapes_file(path):
+    convs = []
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line or line.startswith('#'):
+                continue
+            items = line.split()
+            if len(items) != 7:
+                raise ValueError(f"Invalid convolution: {line}")
+            convs.append(
+                {
+                    'x_shape': parse_dims(items[0]),
+                    'w_shape': parse_dims(items[1]),
+                    'stride': parse_dims(items[2]),
+                    'padding': parse_dims(items[3]),
+                    'dilation': parse_dims(items[4]),
+                    'groups': int(items[5]),
+                    'dtype': items[6],
+                }
+            )
+    return convs
+
+
+def main():
+    args = parse_args()
+    # The flags are read from the environment when paddle is loaded, the
+    # existing cache file is imported by the autotune cache on creation.
+    os.environ['FLAGS_enable_cudnn_frontend'] = '1'
+    os.environ['FLAGS_autotune_cache_file'] = args.cache_file
+
+    import paddle
+    from paddle.base import core
+
+    paddle.set_device(f'gpu:{args.gpu_id}')
+    with paddle.no_grad():
+        for conv in parse_shapes_file(args.shapes_file):
+            x = paddle.ones(conv['x_shape'], dtype=conv['dtype'])
+            w = paddle.ones(conv['w_shape'], dtype=conv['dtype'])
+            start = time.time()
+            paddle.nn.functional.conv2d(
+                x,
+                w,
+                stride=conv['stride'],
+                padding=conv['padding'],
+                dilation=conv['dilation'],
+                groups=conv['groups'],
+                data_format=args.data_format,
+            )
+            paddle.device.synchronize()
+            print(
+                f"Built the plan of x {conv['x_shape']} w {conv['w_shape']} "
+                f"in {time.time() - start:.3f} s"
+            )
+    num_entries = core.export_autotune_cache(args.cache_file)
+    print(f"Exported {num_entries} autotune entries to {args.cache_file}")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,80 @@
+# Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""
+Measures the per-call overhead of the hot eager Tensor methods and
+properties on small tensors, where the python binding dominates the cost.
+
+Example:
+
+    python eager_binding_benchmark.py --device cpu --number 100000
+"""
+
+import argparse
+import timeit
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument(
+        '--device', type=str, default='cpu', help='The device to run on.'
+    )
+    parser.add_argument(
+        '--number',
+        type=int,
+        default=100000,
+        help='The number of calls of each case per repeat.',
+    )
+    parser.add_argument(
+        '--repeat', type=int, default=5, help='The number of repeats.'
+    )
+    return parser.parse_args()
+
+
+def build_cases(x, y):
+    return {
+        'shape': lambda: x.shape,
+        'dtype': lambda: x.dtype,
+        'stop_gradient': lambda: x.stop_gradient,
+        'numpy': lambda: x.numpy(),
+        '__getitem__ int': lambda: x[0],
+        '__getitem__ slice': lambda: x[1:3],
+        'x + y': lambda: x + y,
+        'x + 1.0': lambda: x + 1.0,
+        'x - y': lambda: x - y,
+        'x * y': lambda: x * y,
+        'x / y': lambda: x / y,
+        'x > y': lambda: x > y,
+        'x == y': lambda: x == y,
+    }
+
+
+def main():
+    args = parse_args()
+
+    import paddle
+
+    paddle.set_device(args.device)
+    x = paddle.rand([4, 4])
+    y = paddle.rand([4, 4])
+    print(f"{'case':<20}{'us/call':>12}")
+    for name, case in build_cases(x, y).items():
+        # the best repeat is the least disturbed one
+        best = min(timeit.repeat(case, number=args.number, repeat=args.repeat))
+        print(f"{name:<20}{best / args.number * 1e6:>12.3f}")
+    if args.device != 'cpu':
+        paddle.device.synchronize()
+
+
+if __name__ == '__main__':
+    main()